@@ -0,0 +1,200 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "Containers/BlockStorage3D.h"
+
+using namespace std;
+using namespace openphase;
+
+const int    BlockSize = 8;                                                     ///< Number of coarse cells per block edge
+const int    MaxLevel = 2;                                                      ///< Refinement levels around the interface
+const int    RegridInterval = 10;                                               ///< Time steps between two adaptations
+const double Mobility = 1.0;                                                    ///< Interface mobility (coarse units)
+const double Sigma = 1.0;                                                       ///< Interface energy (coarse units)
+const double Diffusivity = 4.0;                                                 ///< Thermal diffusivity (coarse units)
+const double Latent = 0.5;                                                      ///< Temperature rise per unit of solidified phase
+const double Undercooling = 0.3;                                                ///< Initial undercooling of the melt
+const double Beta = 2.0;                                                        ///< Driving force per unit undercooling
+
+struct RunResult
+{
+    double time = 0.0;                                                          ///< Wall clock time [s]
+    double updates = 0.0;                                                       ///< Cell updates
+    double solid = 0.0;                                                         ///< Solid fraction at the end
+    double enthalpyDrift = 0.0;                                                 ///< Change of T - Latent*Phi relative to the latent heat of the solid
+    size_t cells = 0;                                                           ///< Cells at the end
+};
+
+/* Explicit update of the double obstacle phase field (solid = 1) driven by
+   the undercooling and of the temperature with latent heat release on one
+   block. The Laplacians use the grid spacing of the block level. */
+void UpdateBlock(BlockStorage3D<double>::Block& Phi, BlockStorage3D<double>::Block& T,
+                 const int dX, const int dY, const int dZ, const double Eta,
+                 const double dt, vector<double>& Buffer)
+{
+    const double h = 1.0/double(1 << Phi.Level);
+    const double Prefactor = Pi*Pi/(Eta*Eta);
+    const long int Nx = Phi.Data.sizeX();
+    const long int Ny = Phi.Data.sizeY();
+    const long int Nz = Phi.Data.sizeZ();
+    Buffer.resize(2*Nx*Ny*Nz);
+
+    for(long int i = 0; i < Nx; i++)
+    for(long int j = 0; j < Ny; j++)
+    for(long int k = 0; k < Nz; k++)
+    {
+        const double phi = Phi.Data(i,j,k);
+        /* Neighbours along inactive directions are the cell itself */
+        double lapPhi = -6.0*phi;
+        double lapT   = -6.0*T.Data(i,j,k);
+        lapPhi += Phi.Data(i-dX,j,k) + Phi.Data(i+dX,j,k) + Phi.Data(i,j-dY,k) +
+                  Phi.Data(i,j+dY,k) + Phi.Data(i,j,k-dZ) + Phi.Data(i,j,k+dZ);
+        lapT   += T.Data(i-dX,j,k) + T.Data(i+dX,j,k) + T.Data(i,j-dY,k) +
+                  T.Data(i,j+dY,k) + T.Data(i,j,k-dZ) + T.Data(i,j,k+dZ);
+
+        double dPhi = 0.0;
+        if(lapPhi != 0.0 or (phi > 0.0 and phi < 1.0))
+        {
+            const double dG = -Beta*T.Data(i,j,k);
+            dPhi = Mobility*(Sigma*(lapPhi/(h*h) + Prefactor*(phi - 0.5)) +
+                             Pi/Eta*sqrt(max(phi*(1.0 - phi), 0.0))*dG)*dt;
+            dPhi = min(max(phi + dPhi, 0.0), 1.0) - phi;
+        }
+        const size_t n = (i*Ny + j)*Nz + k;
+        Buffer[2*n]   = phi + dPhi;
+        Buffer[2*n+1] = T.Data(i,j,k) + Diffusivity*lapT/(h*h)*dt + Latent*dPhi;
+    }
+    for(long int i = 0; i < Nx; i++)
+    for(long int j = 0; j < Ny; j++)
+    for(long int k = 0; k < Nz; k++)
+    {
+        const size_t n = (i*Ny + j)*Nz + k;
+        Phi.Data(i,j,k) = Buffer[2*n];
+        T.Data(i,j,k)   = Buffer[2*n+1];
+    }
+}
+
+/* Growth of a circular (spherical) seed into the undercooled melt. With
+   "adaptive" the blocks are refined to MaxLevel around the interface only,
+   otherwise the whole domain is kept at MaxLevel. */
+RunResult Run(const GridParameters& Grid, const int nSteps, const double iWidth,
+              const bool adaptive)
+{
+    const double Eta = iWidth/double(1 << MaxLevel);
+    const double h = 1.0/double(1 << MaxLevel);
+    const double dt = 0.1*h*h/max(Mobility*Sigma, Diffusivity);
+    const double R0 = 0.15*Grid.Nx;
+
+    Storage3D<double,0> CoarsePhi;
+    Storage3D<double,0> CoarseT;
+    CoarsePhi.Allocate(Grid, 1);
+    CoarseT.Allocate(Grid, 1);
+    for(long int i = 0; i < CoarsePhi.sizeX(); i++)
+    for(long int j = 0; j < CoarsePhi.sizeY(); j++)
+    for(long int k = 0; k < CoarsePhi.sizeZ(); k++)
+    {
+        const double r = sqrt(Grid.dNx*(i + 0.5 - 0.5*Grid.Nx)*(i + 0.5 - 0.5*Grid.Nx) +
+                              Grid.dNy*(j + 0.5 - 0.5*Grid.Ny)*(j + 0.5 - 0.5*Grid.Ny) +
+                              Grid.dNz*(k + 0.5 - 0.5*Grid.Nz)*(k + 0.5 - 0.5*Grid.Nz));
+        CoarsePhi(i,j,k) = (r < R0) ? 1.0 : 0.0;
+        CoarseT(i,j,k) = -Undercooling;
+    }
+
+    BlockStorage3D<double> Phi;
+    BlockStorage3D<double> T;
+    for(BlockStorage3D<double>* F : {&Phi, &T})
+    {
+        F->Initialize(Grid, BlockSize, MaxLevel, 1, {true, true, true});
+        F->Set(CoarsePhi);
+    }
+    T.Set(CoarseT);
+
+    auto Interface = [](const double phi){return phi > 0.0 and phi < 1.0;};
+    auto Regrid = [&]()
+    {
+        /* The sharp initial seed has no interface cells yet, the blocks
+        around a jump of the phase field are refined as well */
+        vector<int> Target = adaptive ? Phi.Tag(Interface, MaxLevel)
+                                      : vector<int>(Phi.NumberOfBlocks(), MaxLevel);
+        Phi.SetGhostCells();
+        if(adaptive)
+        for(size_t n = 0; n < Phi.NumberOfBlocks(); n++)
+        {
+            const auto& B = Phi[n];
+            for(long int i = -Grid.dNx; i < B.Data.sizeX() + Grid.dNx and not Target[n]; i++)
+            for(long int j = -Grid.dNy; j < B.Data.sizeY() + Grid.dNy and not Target[n]; j++)
+            for(long int k = -Grid.dNz; k < B.Data.sizeZ() + Grid.dNz and not Target[n]; k++)
+            {
+                if(B.Data(i,j,k) != B.Data(0,0,0)) Target[n] = MaxLevel;
+            }
+        }
+        Phi.Adapt(Target);
+        T.Adapt(Target);
+    };
+    Regrid();
+
+    const double Enthalpy0 = T.Integral() - Latent*Phi.Integral();
+    vector<vector<double>> Buffers(omp_get_max_threads());
+
+    RunResult Result;
+    myclock_t start = mygettime();
+    for(int step = 0; step < nSteps; step++)
+    {
+        if(step > 0 and step % RegridInterval == 0) Regrid();
+        Phi.SetGhostCells();
+        T.SetGhostCells();
+        #pragma omp parallel for schedule(dynamic)
+        for(size_t n = 0; n < Phi.NumberOfBlocks(); n++)
+        {
+            UpdateBlock(Phi[n], T[n], Grid.dNx, Grid.dNy, Grid.dNz, Eta, dt,
+                        Buffers[omp_get_thread_num()]);
+        }
+        Result.updates += Phi.NumberOfCells();
+    }
+    Result.time = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+    Result.solid = Phi.Integral()/double(Grid.Nx*Grid.Ny*Grid.Nz);
+    Result.enthalpyDrift = (T.Integral() - Latent*Phi.Integral() - Enthalpy0)/
+                           max(Latent*Phi.Integral(), DBL_MIN);
+    Result.cells = Phi.NumberOfCells();
+    return Result;
+}
+
+void WriteResult(const string& Name, const RunResult& Result, const RunResult& Reference)
+{
+    ConsoleOutput::WriteLineInsert(Name);
+    ConsoleOutput::WriteStandard("Cells", Result.cells);
+    ConsoleOutput::WriteStandard("Cell updates", Result.updates);
+    ConsoleOutput::WriteStandard("Time [s]", Result.time);
+    ConsoleOutput::WriteStandard("MLUPS", Result.updates/std::max(Result.time, DBL_MIN)*1.0e-6);
+    ConsoleOutput::WriteStandard("Solid fraction", Result.solid);
+    ConsoleOutput::WriteStandard("Solid fraction deviation from uniform grid", std::abs(Result.solid/Reference.solid - 1.0));
+    ConsoleOutput::WriteStandard("Relative enthalpy change", Result.enthalpyDrift);
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                    OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl              RTC(OPSettings);
+
+    const GridParameters& Grid = OPSettings.Grid;
+    const int nSteps = RTC.nSteps;
+
+    const RunResult Uniform  = Run(Grid, nSteps, Grid.iWidth, false);
+    const RunResult Adaptive = Run(Grid, nSteps, Grid.iWidth, true);
+
+    WriteResult("Uniform grid at the finest level", Uniform, Uniform);
+    WriteResult("Refined around the interface", Adaptive, Uniform);
+    ConsoleOutput::WriteLine();
+    ConsoleOutput::WriteStandard("Cell fraction of the adaptive grid", double(Adaptive.cells)/double(Uniform.cells));
+    ConsoleOutput::WriteStandard("Speedup of the adaptive grid", Uniform.time/std::max(Adaptive.time, DBL_MIN));
+    ConsoleOutput::WriteLine();
+
+    if(std::abs(Adaptive.solid/Uniform.solid - 1.0) > 0.01)
+    {
+        ConsoleOutput::WriteWarning("The adaptive grid deviates from the uniform grid", "AdaptivePhaseField", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include "BoundaryConditions.h"
+
+using namespace std;
+using namespace openphase;
+
+const std::array<BoundaryConditionTypes,5> Types = {
+    BoundaryConditionTypes::Periodic,
+    BoundaryConditionTypes::NoFlux,
+    BoundaryConditionTypes::Free,
+    BoundaryConditionTypes::Fixed,
+    BoundaryConditionTypes::Mirror};
+
+/* Cell (a,p,q) of the storage with "a" along the direction "dir" */
+template<class T>
+inline T& At(Storage3D<T,0>& Field, const int dir, const long int a, const long int p, const long int q)
+{
+    switch(dir)
+    {
+        case 0:  return Field(a, p, q);
+        case 1:  return Field(p, a, q);
+        default: return Field(p, q, a);
+    }
+}
+
+/* Boundary conditions along "dir" with the cell-wise formulas of the previous
+implementation of SetXLocal(), SetYLocal() and SetZLocal() */
+template<class T>
+void ReferenceLocal(Storage3D<T,0>& Field, const int dir,
+                    const BoundaryConditionTypes BC0, const BoundaryConditionTypes BCN)
+{
+    const std::array<long int,3> Size = {Field.sizeX(), Field.sizeY(), Field.sizeZ()};
+    const std::array<long int,3> Bcells = {Field.BcellsX(), Field.BcellsY(), Field.BcellsZ()};
+    const int dirP = (dir == 0) ? 1 : 0;
+    const int dirQ = (dir == 2) ? 1 : 2;
+    const long int N = Size[dir];
+    if(Bcells[dir] == 0) return;
+
+    for(long int p = -Bcells[dirP]; p < Size[dirP] + Bcells[dirP]; p++)
+    for(long int q = -Bcells[dirQ]; q < Size[dirQ] + Bcells[dirQ]; q++)
+    {
+        auto F = [&](const long int a) -> T& { return At(Field, dir, a, p, q); };
+
+        if(BC0 == BoundaryConditionTypes::Periodic or
+           BCN == BoundaryConditionTypes::Periodic)
+        {
+            for(long int a = -Bcells[dir]; a < 0; a++)
+            {
+                F(a) = F((N + a)%N);
+                F(N - a - 1) = F((-a - 1)%N);
+            }
+            continue;
+        }
+        for(long int a = -Bcells[dir]; a < 0; a++)
+        {
+            switch(BC0)
+            {
+                case BoundaryConditionTypes::NoFlux: F(a) = F((-a - 1)%N); break;
+                case BoundaryConditionTypes::Mirror: F(a) = F((-a)%N); break;
+                case BoundaryConditionTypes::Free:   F(a) = F(0) + (F(1%N) - F(0)) * a; break;
+                default: break;
+            }
+        }
+        for(long int a = -Bcells[dir]; a < 0; a++)
+        {
+            const long int a0 = N - 1;
+            switch(BCN)
+            {
+                case BoundaryConditionTypes::NoFlux: F(N - a - 1) = F((N + a)%N); break;
+                case BoundaryConditionTypes::Mirror: F(N - a - 1) = F((N + a - 1)%N); break;
+                case BoundaryConditionTypes::Free:   F(a0 - a) = F(a0) + (F(a0) - F((a0 - 1)%N))*(-a); break;
+                default: break;
+            }
+        }
+    }
+}
+
+inline double TestValue(const long int i, const long int j, const long int k, double)
+{
+    return std::sin(0.37*i + 1.3) + 0.5*std::cos(0.71*j - 0.2) + 0.25*std::sin(1.13*k + 0.4);
+}
+
+inline dVector3 TestValue(const long int i, const long int j, const long int k, dVector3)
+{
+    return dVector3{TestValue(i,j,k,0.0), TestValue(j,k,i,0.0), TestValue(k,i,j,0.0)};
+}
+
+/* Fills the interior with a smooth field and the halo with a marker, so that
+halo cells which are not set by the boundary conditions compare equal too */
+template<class T>
+void Fill(Storage3D<T,0>& Field)
+{
+    for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
+    for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
+    for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
+    {
+        const bool Interior = i >= 0 and i < Field.sizeX() and
+                              j >= 0 and j < Field.sizeY() and
+                              k >= 0 and k < Field.sizeZ();
+        Field(i,j,k) = Interior ? TestValue(i,j,k,T()) : TestValue(-7,-7,-7,T());
+    }
+}
+
+template<class T>
+bool Identical(Storage3D<T,0>& A, Storage3D<T,0>& B)
+{
+    for(long int i = -A.BcellsX(); i < A.sizeX() + A.BcellsX(); i++)
+    for(long int j = -A.BcellsY(); j < A.sizeY() + A.BcellsY(); j++)
+    for(long int k = -A.BcellsZ(); k < A.sizeZ() + A.BcellsZ(); k++)
+    {
+        if(std::memcmp(&A(i,j,k), &B(i,j,k), sizeof(T)) != 0) return false;
+    }
+    return true;
+}
+
+/* Compares SetX()/SetY()/SetZ(), SetLocal(), SetAll() and SetLocalTeam() with
+1, 3 and 8 threads bitwise with the cell-wise reference, returns the number of
+mismatches */
+template<class T>
+int Check(const BoundaryConditions& BC, const std::array<long int,3> N,
+          const std::array<long int,3> dN, const long int Bcells, const std::string& Name)
+{
+    Storage3D<T,0> Reference(N[0], N[1], N[2], dN[0], dN[1], dN[2], Bcells);
+    Storage3D<T,0> Field(N[0], N[1], N[2], dN[0], dN[1], dN[2], Bcells);
+
+    Fill(Reference);
+    ReferenceLocal(Reference, 0, BC.BC0X, BC.BCNX);
+    ReferenceLocal(Reference, 1, BC.BC0Y, BC.BCNY);
+    ReferenceLocal(Reference, 2, BC.BC0Z, BC.BCNZ);
+
+    int Mismatches = 0;
+    auto Compare = [&](const std::string& Method)
+    {
+        if(not Identical(Field, Reference))
+        {
+            ConsoleOutput::WriteWarning(Method + " differs from the cell-wise reference for " + Name,
+                                        "BoundaryConditionsTest", "Check()");
+            Mismatches++;
+        }
+    };
+
+    Fill(Field);
+    BC.SetX(Field);
+    BC.SetY(Field);
+    BC.SetZ(Field);
+    Compare("SetX(), SetY(), SetZ()");
+
+    Fill(Field);
+    BC.SetLocal(Field);
+    Compare("SetLocal()");
+
+    Fill(Field);
+    BC.SetAll(Field);
+    Compare("SetAll()");
+
+    for(const int nThreads : {1, 3, 8})
+    {
+        Fill(Field);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThreads)
+#endif
+        {
+            BC.SetLocalTeam(Field);
+        }
+        Compare("SetLocalTeam() with " + std::to_string(nThreads) + " threads");
+    }
+
+    return Mismatches;
+}
+
+std::string Name(const BoundaryConditionTypes BC)
+{
+    switch(BC)
+    {
+        case BoundaryConditionTypes::Periodic: return "Periodic";
+        case BoundaryConditionTypes::NoFlux:   return "NoFlux";
+        case BoundaryConditionTypes::Free:     return "Free";
+        case BoundaryConditionTypes::Fixed:    return "Fixed";
+        case BoundaryConditionTypes::Mirror:   return "Mirror";
+        default:                               return "Other";
+    }
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    /* Each direction runs through all 25 pairs of lower and upper boundary
+    conditions while the other two directions run through the 5 symmetric
+    ones. The second grid has three halo layers on four interior cells along
+    z, the 2D grid has no halo along z. */
+    struct GridCase
+    {
+        std::array<long int,3> N;
+        std::array<long int,3> dN;
+        long int Bcells;
+    };
+    const std::vector<GridCase> Grids = {
+        {{7, 6, 5}, {1, 1, 1}, 2},
+        {{6, 5, 4}, {1, 1, 1}, 3},
+        {{8, 6, 1}, {1, 1, 0}, 1}};
+
+    BoundaryConditions BC;
+    int nCombinations = 0;
+    int Mismatches = 0;
+    for(const GridCase& Grid : Grids)
+    for(int dir = 0; dir < 3; dir++)
+    for(const auto BC0 : Types)
+    for(const auto BCN : Types)
+    for(const auto BCP : Types)
+    for(const auto BCQ : Types)
+    {
+        std::array<BoundaryConditionTypes,6> Set;
+        Set[2*dir] = BC0;
+        Set[2*dir + 1] = BCN;
+        Set[2*((dir + 1)%3)] = Set[2*((dir + 1)%3) + 1] = BCP;
+        Set[2*((dir + 2)%3)] = Set[2*((dir + 2)%3) + 1] = BCQ;
+        BC.BC0X = Set[0]; BC.BCNX = Set[1];
+        BC.BC0Y = Set[2]; BC.BCNY = Set[3];
+        BC.BC0Z = Set[4]; BC.BCNZ = Set[5];
+
+        std::string Combination = "X " + Name(Set[0]) + "/" + Name(Set[1])
+                               + " Y " + Name(Set[2]) + "/" + Name(Set[3])
+                               + " Z " + Name(Set[4]) + "/" + Name(Set[5])
+                               + " Bcells " + std::to_string(Grid.Bcells);
+
+        Mismatches += Check<double>  (BC, Grid.N, Grid.dN, Grid.Bcells, "double, " + Combination);
+        Mismatches += Check<dVector3>(BC, Grid.N, Grid.dN, Grid.Bcells, "dVector3, " + Combination);
+        nCombinations++;
+    }
+
+    ConsoleOutput::WriteLineInsert("Boundary conditions against the cell-wise reference");
+    ConsoleOutput::WriteStandard("Combinations", nCombinations);
+    ConsoleOutput::WriteStandard("Mismatches", Mismatches);
+    ConsoleOutput::WriteLine();
+
+    if(Mismatches != 0)
+    {
+        ConsoleOutput::WriteWarning("Boundary conditions differ from the cell-wise reference", "BoundaryConditionsTest", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,236 @@
+#include "Includes.h"
+#include "FileInterface.h"
+#include "Containers/NodeAB.h"
+#include "Containers/NodeIP.h"
+#include "Containers/NodePF.h"
+#include "Containers/Storage3D.h"
+#include <chrono>
+#include <functional>
+
+using namespace std;
+using namespace openphase;
+
+/* Field index of the n-th entry of a node: the entries of neighboring cells
+   overlap partially, as at grain boundaries */
+inline size_t FieldIndex(const long int i, const size_t n)
+{
+    return 5*n + (i % 3);
+}
+
+/* Calls Sweep() nRepetitions times, returns the best time per cell in ns. The
+   results are summed up to keep the calls alive. */
+double Time(const int nRepetitions, const size_t nCells,
+            const function<double()>& Sweep, double& CheckSum)
+{
+    double best = DBL_MAX;
+    double sum = 0.0;
+    for(int r = 0; r < nRepetitions; r++)
+    {
+        auto start = chrono::steady_clock::now();
+        sum += Sweep();
+        auto end = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double,nano>(end - start).count());
+    }
+    CheckSum += sum;
+    return best/nCells;
+}
+
+void Report(const string Name, const string Entries, const double TimePerCell,
+            const double BytesPerCell = 0.0)
+{
+    cout << setw(28) << left << Name << right
+         << setw(8)  << Entries
+         << setw(14) << setprecision(4) << TimePerCell << " ns";
+    if(BytesPerCell > 0.0)
+    {
+        cout << setw(12) << setprecision(4) << BytesPerCell/TimePerCell << " GB/s";
+    }
+    cout << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    string InputFileName = DefaultInputFileName;
+    if (argc > 1) InputFileName = argv[1];
+
+    fstream inpF(InputFileName, ios::in);
+    stringstream inp;
+    inp << inpF.rdbuf();
+    inpF.close();
+    const int  moduleLocation = FileInterface::FindModuleLocation(inp, "ContainerKernels");
+    const long N              = FileInterface::ReadParameterI(inp, moduleLocation, string("N"));
+    const long Bcells         = FileInterface::ReadParameterI(inp, moduleLocation, string("Bcells"));
+    const int  nRepetitions   = FileInterface::ReadParameterI(inp, moduleLocation, string("nRepetitions"));
+
+    /* The kernels run on one thread to isolate the container costs, only
+       Remesh() uses its internal OpenMP loop */
+    omp_set_num_threads(1);
+
+    const size_t nCells = N*N*N;
+    double CheckSum = 0.0;
+
+    cout << "Best time per cell of " << nRepetitions << " sweeps over "
+         << N << "^3 cells with " << Bcells << " boundary cells" << endl;
+    cout << setw(28) << left << "Kernel" << right
+         << setw(8)  << "entries"
+         << setw(17) << "time" << endl;
+
+    /* Seven point stencil on a scalar field, the indexing of Storage3D with
+       boundary cells */
+    {
+        Storage3D<double,0> Scalar;
+        Storage3D<double,0> Result;
+        Scalar.Allocate(N, N, N, 1, 1, 1, Bcells);
+        Result.Allocate(N, N, N, 1, 1, 1, Bcells);
+        STORAGE_LOOP_BEGIN(i,j,k,Scalar,Bcells)
+        {
+            Scalar(i,j,k) = double(i + 2*j + 3*k);
+        }
+        STORAGE_LOOP_END
+        const double t = Time(nRepetitions, nCells, [&]()
+        {
+            STORAGE_LOOP_BEGIN(i,j,k,Result,0)
+            {
+                Result(i,j,k) = Scalar(i-1,j,k) + Scalar(i+1,j,k)
+                              + Scalar(i,j-1,k) + Scalar(i,j+1,k)
+                              + Scalar(i,j,k-1) + Scalar(i,j,k+1)
+                              - 6.0*Scalar(i,j,k);
+            }
+            STORAGE_LOOP_END
+            return Result(N/2,N/2,N/2);
+        }, CheckSum);
+        Report("Storage3D::operator()", "-", t, 2*sizeof(double));
+    }
+
+    for(const size_t nEntries : {2, 3, 6, 12})
+    {
+        const string Entries = to_string(nEntries);
+
+        Storage3D<NodePF,0> Fields;
+        Storage3D<NodeIP,0> Properties;
+        Storage3D<NodeAB<double,double>,0> Pairs;
+        Fields.Allocate(N, N, N, 1, 1, 1, Bcells);
+        Properties.Allocate(N, N, N, 1, 1, 1, Bcells);
+        Pairs.Allocate(N, N, N, 1, 1, 1, Bcells);
+
+        const double tSet = Time(nRepetitions, nCells, [&]()
+        {
+            STORAGE_LOOP_BEGIN(i,j,k,Fields,Bcells)
+            {
+                Fields(i,j,k).clear();
+                for(size_t n = 0; n < nEntries; n++)
+                {
+                    Fields(i,j,k).set_value(FieldIndex(i,n), 1.0/nEntries);
+                }
+            }
+            STORAGE_LOOP_END
+            return Fields(0,0,0).get_value(FieldIndex(0,0));
+        }, CheckSum);
+        Report("NodePF::set_value", Entries, tSet);
+
+        const double tAdd = Time(nRepetitions, nCells, [&]()
+        {
+            STORAGE_LOOP_BEGIN(i,j,k,Fields,0)
+            {
+                for(size_t n = 0; n < nEntries; n++)
+                {
+                    Fields(i,j,k).add_value(FieldIndex(i,n), 1.0e-3);
+                }
+            }
+            STORAGE_LOOP_END
+            return Fields(0,0,0).get_value(FieldIndex(0,0));
+        }, CheckSum);
+        Report("NodePF::add_value", Entries, tAdd);
+
+        const double tDerivatives = Time(nRepetitions, nCells, [&]()
+        {
+            double sum = 0.0;
+            STORAGE_LOOP_BEGIN(i,j,k,Fields,0)
+            {
+                for(size_t n = 0; n < nEntries; n++)
+                {
+                    const pair<double,dVector3> d = Fields(i,j,k).get_derivatives(FieldIndex(i,n));
+                    sum += d.first + d.second[0];
+                }
+            }
+            STORAGE_LOOP_END
+            return sum;
+        }, CheckSum);
+        Report("NodePF::get_derivatives", Entries, tDerivatives);
+
+        STORAGE_LOOP_BEGIN(i,j,k,Properties,Bcells)
+        {
+            for(size_t n = 0; n < nEntries; n++)
+            for(size_t m = n + 1; m < nEntries; m++)
+            {
+                Properties(i,j,k).set_energy(FieldIndex(i,n), FieldIndex(i,m), 0.24 + 0.01*n);
+                Pairs(i,j,k).set_sym1(FieldIndex(i,n), FieldIndex(i,m), 1.0 + m);
+            }
+        }
+        STORAGE_LOOP_END
+
+        const double tEnergy = Time(nRepetitions, nCells, [&]()
+        {
+            double sum = 0.0;
+            STORAGE_LOOP_BEGIN(i,j,k,Properties,0)
+            {
+                for(size_t n = 0; n < nEntries; n++)
+                for(size_t m = n + 1; m < nEntries; m++)
+                {
+                    sum += Properties(i,j,k).get_energy(FieldIndex(i,m), FieldIndex(i,n));
+                }
+            }
+            STORAGE_LOOP_END
+            return sum;
+        }, CheckSum);
+        Report("NodeIP::get_energy (pairs)", Entries, tEnergy);
+
+        const double tSym = Time(nRepetitions, nCells, [&]()
+        {
+            double sum = 0.0;
+            STORAGE_LOOP_BEGIN(i,j,k,Pairs,0)
+            {
+                for(size_t n = 0; n < nEntries; n++)
+                for(size_t m = n + 1; m < nEntries; m++)
+                {
+                    sum += Pairs(i,j,k).get_sym1(FieldIndex(i,m), FieldIndex(i,n));
+                }
+            }
+            STORAGE_LOOP_END
+            return sum;
+        }, CheckSum);
+        Report("NodeAB::get_sym1 (pairs)", Entries, tSym);
+
+        /* Whole domain packed and unpacked as for the MPI halo exchange and
+           the checkpoints */
+        vector<double> buffer;
+        const vector<long int> window = {0, N, 0, N, 0, N};
+        const double tPack = Time(nRepetitions, nCells, [&]()
+        {
+            buffer.clear();
+            Fields.pack(buffer, window);
+            return double(buffer.size());
+        }, CheckSum);
+        Report("Storage3D<NodePF>::pack", Entries, tPack, sizeof(double)*buffer.size()/nCells);
+
+        const double tUnpack = Time(nRepetitions, nCells, [&]()
+        {
+            Fields.unpack(buffer, window);
+            return Fields(N/2,N/2,N/2).get_value(FieldIndex(N/2,0));
+        }, CheckSum);
+        Report("Storage3D<NodePF>::unpack", Entries, tUnpack, sizeof(double)*buffer.size()/nCells);
+
+        /* Refinement by 3/2 and back, the time is given per original cell */
+        const long NR = N + N/2;
+        const double tRemesh = Time(max(1, nRepetitions/10), nCells, [&]()
+        {
+            Fields.Remesh(NR, NR, NR);
+            Fields.Remesh(N, N, N);
+            return Fields(N/2,N/2,N/2).get_value(FieldIndex(N/2,0));
+        }, CheckSum);
+        Report("Storage3D<NodePF>::Remesh", Entries, tRemesh);
+    }
+
+    cout << "Check sum: " << CheckSum << endl;
+    return EXIT_SUCCESS;
+}
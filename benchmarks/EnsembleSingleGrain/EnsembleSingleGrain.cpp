@@ -0,0 +1,110 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "InterfaceProperties.h"
+#include "DoubleObstacle.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "DrivingForce.h"
+#include "ConsoleOutput.h"
+#include "Tools/Ensemble.h"
+
+using namespace std;
+using namespace openphase;
+
+/* One shrinking grain of the SingleGrain benchmark. The cases differ in the
+   interface mobility, the ratio of the simulated and the analytic squared
+   radius after the last time step is stored in the shared vector Ratios. */
+class ShrinkingGrain
+{
+ public:
+    ShrinkingGrain(const size_t locIndex, const string& InputFileName,
+                   vector<double>& locRatios) :
+        Index(locIndex),
+        OPSettings(InputFileName),
+        RTC(OPSettings, InputFileName),
+        Phi(OPSettings, InputFileName),
+        DO(OPSettings, InputFileName),
+        IP(OPSettings, InputFileName),
+        BC(OPSettings, InputFileName),
+        DF(OPSettings, InputFileName),
+        Ratios(locRatios)
+    {
+        Initializations::Single(Phi, 0, BC);
+        GrainIndex = Initializations::Sphere(Phi, 1, OPSettings.Grid.Nx*0.4,
+        (OPSettings.Grid.Nx)/2.0, (OPSettings.Grid.Ny)/2.0, (OPSettings.Grid.Nz)/2.0, BC);
+    }
+
+    void Run(void)
+    {
+        const double R0 = exp(log(0.75/Pi*Phi.FieldsProperties[GrainIndex].Volume)/3.0);
+        for(RTC.tStep = RTC.tStart; RTC.tStep <= RTC.nSteps; RTC.IncrementTimeStep())
+        {
+            DF.Clear();
+            IP.Set(Phi, BC);
+            DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+            Phi.NormalizeIncrements(BC, RTC.dt);
+            Phi.MergeIncrements(BC, RTC.dt);
+        }
+        const double dx = OPSettings.Grid.dx;
+        const double Radius = exp(log(0.75/Pi*Phi.FieldsProperties[GrainIndex].Volume)/3.0);
+        const double RadiusTheor = R0*R0 - 4.0*IP.InterfaceMobility(0,1).MaxMobility*
+                                   IP.InterfaceEnergy(0,1).MaxEnergy*(RTC.nSteps+1)*
+                                   RTC.dt/dx/dx;
+        Ratios[Index] = (RadiusTheor > 0.0) ? Radius*Radius/RadiusTheor : 0.0;
+    }
+
+ private:
+    size_t              Index;
+    int                 GrainIndex = 0;
+    Settings            OPSettings;
+    RunTimeControl      RTC;
+    PhaseField          Phi;
+    DoubleObstacle      DO;
+    InterfaceProperties IP;
+    BoundaryConditions  BC;
+    DrivingForce        DF;
+    vector<double>&     Ratios;
+};
+
+int main(int argc, char *argv[])
+{
+    const int TeamSize = (argc > 1) ? atoi(argv[1]) : 1;
+    const size_t nCases = (argc > 2) ? atoi(argv[2]) : 16;
+
+    ifstream inp(DefaultInputFileName);
+    stringstream BaseInput;
+    BaseInput << inp.rdbuf();
+
+    /* The interface mobility varies from 0.5e-9 to 1.5e-9 */
+    vector<string> InputFileNames;
+    for(size_t n = 0; n < nCases; n++)
+    {
+        const string CaseDir = "Case_" + to_string(n) + dirSeparator;
+        stringstream Mobility;
+        Mobility << 0.5e-9 + 1.0e-9*n/max<size_t>(nCases - 1, 1);
+        InputFileNames.push_back(Ensemble::WriteCase(CaseDir,
+            Ensemble::Variant(BaseInput.str(), {{"Mu_0_1", Mobility.str()},
+                                                {"Settings/VTKDir",  CaseDir + "VTK"},
+                                                {"Settings/RAWDir",  CaseDir + "RawData"},
+                                                {"Settings/DATADir", CaseDir + "TextData"}})));
+    }
+
+    ConsoleOutput::OutputVerbosity = VerbosityLevels::Warning;
+    vector<double> Ratios(nCases, 0.0);
+    myclock_t start = mygettime();
+    vector<Ensemble::Result> Results = Ensemble::Run<ShrinkingGrain>(InputFileNames, TeamSize, Ratios);
+    const double WallTime = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+    ConsoleOutput::OutputVerbosity = VerbosityLevels::Normal;
+
+    Ensemble::Report(Results);
+    for(size_t n = 0; n < nCases; n++)
+    {
+        ConsoleOutput::WriteStandard("Case " + to_string(n) + " R^2 ratio", Ratios[n]);
+    }
+    ConsoleOutput::WriteStandard("Ensemble wall time [s]", WallTime);
+    ConsoleOutput::WriteStandard("Cases per second", nCases/WallTime);
+
+    for(const auto& res : Results) if(!res.Success) return 1;
+    return 0;
+}
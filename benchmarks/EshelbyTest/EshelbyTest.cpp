@@ -7,6 +7,7 @@
 #include "PhaseField.h"
 #include "RunTimeControl.h"
 #include "Settings.h"
+#include "Tools/TimeInfo.h"
 
 using namespace std;
 using namespace openphase;
@@ -23,6 +24,7 @@ int main(int argc, char *argv[])
     ElasticitySolverSpectral    ES(OPSettings);
 
     DrivingForce                dG(OPSettings);
+    TimeInfo                    Timer(OPSettings, "Execution Time Statistics");
 
     double centerx = (OPSettings.Grid.dNx > 0) ? (OPSettings.Grid.Nx+1)/2.0 : 0;
     double centery = (OPSettings.Grid.dNy > 0) ? (OPSettings.Grid.Ny+1)/2.0 : 0;
@@ -33,12 +35,17 @@ int main(int argc, char *argv[])
     Initializations::Single(Phi, 0, BC);
     Initializations::Sphere(Phi, 1, iRadius, centerx, centery, centerz, BC);
     ConsoleOutput::WriteStandard("Initial Microstructure", "Set");
+    Timer.SetStart();
     EP.SetEffectiveProperties(Phi);
+    Timer.SetTimeStamp("Effective properties");
     ConsoleOutput::WriteStandard("Grains Properties", "Set");
 
     ConsoleOutput::WriteStandard("Calculation", "Started");
 
     int niterations = ES.Solve(EP, BC, RTC.dt);
+    Timer.SetTimeStamp("Spectral elasticity solver");
+    Timer.WriteJSON(OPSettings.TextDir + "TimeInfo.json");
+    Timer.WritePerformance(OPSettings.TextDir + "Performance.dat", OPSettings.Grid.TotalNumberOfCells());
 
     //EP.CalculateDrivingForce(Phi,dG);
     //dG.Average(Phi,OPSettings);
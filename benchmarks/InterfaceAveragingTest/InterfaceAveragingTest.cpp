@@ -0,0 +1,118 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "InterfaceProperties.h"
+#include "DoubleObstacle.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "DrivingForce.h"
+#include "InterfaceRegularization.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Synthetic raw values for all pairs of phase fields in the interface cells */
+void FillRaw(Storage3D<NodeDF,0>& Storage, const PhaseField& Phi)
+{
+    STORAGE_LOOP_BEGIN(i,j,k,Storage,0)
+    {
+        Storage(i,j,k).clear();
+        if(Phi.Fields(i,j,k).interface())
+        for(auto alpha  = Phi.Fields(i,j,k).cbegin();
+                 alpha != Phi.Fields(i,j,k).cend(); ++alpha)
+        for(auto  beta  = alpha + 1;
+                  beta != Phi.Fields(i,j,k).cend(); ++beta)
+        {
+            const double a = alpha->index;
+            const double b = beta->index;
+            Storage(i,j,k).add_raw(alpha->index, beta->index,
+                std::sin(0.31*i + 0.7*a)*std::cos(0.23*k + 1.1*b) + 0.1*(a + 1.0)*(b + 2.0));
+        }
+    }
+    STORAGE_LOOP_END
+}
+
+/* Sum, sum of squares and a position weighted sum of the averaged values,
+written with full precision, any change of a single value changes them */
+void WriteChecksums(ofstream& File, const std::string& Name,
+                    const Storage3D<NodeDF,0>& Storage)
+{
+    double Sum = 0.0;
+    double Squares = 0.0;
+    double Weighted = 0.0;
+    long int Entries = 0;
+    long int Cell = 0;
+    STORAGE_LOOP_BEGIN(i,j,k,Storage,0)
+    {
+        for(auto it  = Storage(i,j,k).cbegin();
+                 it != Storage(i,j,k).cend(); ++it)
+        {
+            const double Value = it->average;
+            Sum      += Value;
+            Squares  += Value*Value;
+            Weighted += Value*(1 + Cell%97)*(1 + it->indexA + 3*it->indexB);
+            Entries++;
+        }
+        Cell++;
+    }
+    STORAGE_LOOP_END
+
+    File << setprecision(17)
+         << Name << "_Entries "  << Entries  << "\n"
+         << Name << "_Sum "      << Sum      << "\n"
+         << Name << "_Squares "  << Squares  << "\n"
+         << Name << "_Weighted " << Weighted << "\n";
+
+    ConsoleOutput::WriteStandard(Name + " entries", Entries);
+    ConsoleOutput::WriteStandard(Name + " sum", Sum);
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                        OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl                  RTC(OPSettings);
+    PhaseField                      Phi(OPSettings);
+    DoubleObstacle                  DO(OPSettings);
+    InterfaceProperties             IP(OPSettings);
+    BoundaryConditions              BC(OPSettings);
+    DrivingForce                    DF(OPSettings);
+    InterfaceRegularization         IR(OPSettings);
+
+    /* Three grains meeting in a triple junction, relaxed to smooth profiles */
+    Initializations::Young3(Phi, 0, 1, 2, 3, BC);
+
+    for(RTC.TimeStep = RTC.StartTimeStep; RTC.TimeStep <= RTC.MaxTimeStep; RTC.IncrementTimeStep())
+    {
+        DF.Clear();
+        IP.Set(Phi, BC);
+        DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+        Phi.NormalizeIncrements(BC, RTC.dt);
+        Phi.MergeIncrements(BC, RTC.dt);
+    }
+
+    ofstream File("Checksums.dat");
+    ConsoleOutput::WriteLineInsert("Interface averaging checksums");
+
+    const std::vector<std::pair<AveragingWeightsModes,std::string>> Modes = {
+        {AveragingWeightsModes::Range,       "DrivingForce_Range"},
+        {AveragingWeightsModes::PhaseFields, "DrivingForce_PhaseFields"},
+        {AveragingWeightsModes::Counter,     "DrivingForce_Counter"}};
+
+    for(const auto& Mode : Modes)
+    {
+        DF.WeightsMode = Mode.first;
+        FillRaw(DF.Force, Phi);
+        DF.Average(Phi, BC);
+        WriteChecksums(File, Mode.second, DF.Force);
+    }
+
+    FillRaw(IR.Curvature, Phi);
+    IR.Average(Phi, BC);
+    WriteChecksums(File, "Curvature", IR.Curvature);
+
+    ConsoleOutput::WriteLine();
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "FluidDynamics/LBBlockGrid.h"
+
+using namespace std;
+using namespace openphase;
+
+const double tau = 0.8;                                                         ///< BGK relaxation time of the coarse grid (lattice units)
+const double Acceleration = 1.0e-6;                                             ///< Driving body force per unit mass (coarse lattice units)
+const int    BlockSize = 8;                                                     ///< Number of cells per block edge
+
+struct RunResult
+{
+    double time = 0.0;                                                          ///< Wall clock time [s]
+    double updates = 0.0;                                                       ///< Fluid cell updates
+    double massDrift = 0.0;                                                     ///< Relative change of the total mass
+    double drag = 0.0;                                                          ///< Force on the sphere in flow direction (coarse units)
+    double velocity = 0.0;                                                      ///< Flow velocity in front of the sphere (coarse units)
+};
+
+/* Duct flow (periodic in x, walls in y and z) around a sphere in the center.
+   The grid has "refine" times the resolution of the coarse grid if
+   "maxlevel" is zero, otherwise it is refined around the sphere. */
+RunResult Run(const GridParameters& Grid, const int nSteps, const int refine,
+              const int maxlevel)
+{
+    const double R  = 0.25*Grid.Ny;
+    const double cx = 0.5*Grid.Nx;
+    const double cy = 0.5*Grid.Ny;
+    const double cz = 0.5*Grid.Nz;
+    auto Sphere = [&](double x, double y, double z)
+    {
+        x /= refine; y /= refine; z /= refine;
+        return (x-cx)*(x-cx) + (y-cy)*(y-cy) + (z-cz)*(z-cz) < R*R;
+    };
+
+    LBBlockGrid Fluid;
+    Fluid.Initialize(refine*Grid.Nx, refine*Grid.Ny, refine*Grid.Nz, BlockSize,
+                     maxlevel, refine*(tau - 0.5) + 0.5,
+                     dVector3{Acceleration/refine, 0.0, 0.0}, {true, false, false},
+                     Sphere);
+    Fluid.SetEquilibrium(1.0, dVector3{0.0, 0.0, 0.0});
+
+    RunResult Result;
+    const double Mass0 = Fluid.Mass();
+    myclock_t start = mygettime();
+    for(int step = 0; step < nSteps*refine; step++)
+    {
+        Fluid.Step();
+    }
+    Result.time = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+    Result.updates = double(nSteps)*refine*Fluid.CellUpdates();
+    Result.massDrift = (Fluid.Mass() - Mass0)/Mass0;
+    Result.drag = Fluid.ObstacleForce()[0]/(refine*refine);
+
+    dVector3 u;
+    Fluid.Velocity(refine*(cx - 2.0*R), refine*cy, refine*cz, u);
+    Result.velocity = u[0];
+    return Result;
+}
+
+/* Plane Poiseuille flow between two obstacle plates in z direction (all
+   boundaries periodic), driven by the body force. With "maxlevel" 1 the blocks
+   next to the plates are refined, so the profile crosses two refinement
+   interfaces. Returns the largest deviation of the velocity, averaged over
+   each coarse cell, from the analytic profile relative to its maximum. */
+double RunChannel(const int maxlevel)
+{
+    const long int Width = 4;                                                   ///< Cells in x and y direction
+    const long int Nz = 32;                                                     ///< Cells across the channel including one plate cell on each side
+    const int nSteps = 6000;                                                    ///< Enough to reach the steady state
+    const double tauChannel = 1.0;
+    const double Gravity = 1.0e-6;
+
+    LBBlockGrid Fluid;
+    Fluid.Initialize(Width, Width, Nz, Width, maxlevel, tauChannel,
+                     dVector3{Gravity, 0.0, 0.0}, {true, true, true},
+                     [&](double, double, double z){return z < 1.0 or z > Nz - 1.0;});
+    Fluid.SetEquilibrium(1.0, dVector3{0.0, 0.0, 0.0});
+    for(int step = 0; step < nSteps; step++)
+    {
+        Fluid.Step();
+    }
+
+    /* Halfway bounce back puts the walls at z = 1 and z = Nz - 1 */
+    const double nu = (tauChannel - 0.5)/3.0;
+    const double H = Nz - 2.0;
+    const double uMax = Gravity*H*H/(8.0*nu);
+    double maxDeviation = 0.0;
+    for(long int k = 1; k < Nz - 1; k++)
+    {
+        dVector3 uLow;
+        dVector3 uHigh;
+        Fluid.Velocity(0.5*Width, 0.5*Width, k + 0.25, uLow);
+        Fluid.Velocity(0.5*Width, 0.5*Width, k + 0.75, uHigh);
+        const double z = k + 0.5;
+        const double uAnalytic = Gravity/(2.0*nu)*(z - 1.0)*(Nz - 1.0 - z);
+        maxDeviation = std::max(maxDeviation, std::abs(0.5*(uLow[0] + uHigh[0]) - uAnalytic)/uMax);
+    }
+    return maxDeviation;
+}
+
+void WriteResult(const string& Name, const RunResult& Result, const RunResult& Reference)
+{
+    ConsoleOutput::WriteLineInsert(Name);
+    ConsoleOutput::WriteStandard("Cell updates", Result.updates);
+    ConsoleOutput::WriteStandard("Time [s]", Result.time);
+    ConsoleOutput::WriteStandard("MLUPS", Result.updates/std::max(Result.time, DBL_MIN)*1.0e-6);
+    ConsoleOutput::WriteStandard("Relative mass change", Result.massDrift);
+    ConsoleOutput::WriteStandard("Drag force", Result.drag);
+    ConsoleOutput::WriteStandard("Drag deviation from fine grid", std::abs(Result.drag/Reference.drag - 1.0));
+    ConsoleOutput::WriteStandard("Velocity deviation from fine grid", std::abs(Result.velocity/Reference.velocity - 1.0));
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                    OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl              RTC(OPSettings);
+
+    const GridParameters& Grid = OPSettings.Grid;
+    if(Grid.Active() != 3)
+    {
+        ConsoleOutput::WriteExit("The benchmark requires a three-dimensional grid", "LBBlockRefinement", "main()");
+        return EXIT_FAILURE;
+    }
+    const int nSteps = RTC.nSteps;
+
+    const RunResult Coarse  = Run(Grid, nSteps, 1, 0);
+    const RunResult Refined = Run(Grid, nSteps, 1, 1);
+    const RunResult Fine    = Run(Grid, nSteps, 2, 0);
+
+    WriteResult("Uniform coarse grid", Coarse, Fine);
+    WriteResult("Refined around the sphere", Refined, Fine);
+    WriteResult("Uniform fine grid", Fine, Fine);
+    ConsoleOutput::WriteLine();
+    ConsoleOutput::WriteStandard("Speedup of the refined grid", Fine.time/std::max(Refined.time, DBL_MIN));
+    ConsoleOutput::WriteLine();
+
+    const double ChannelUniform = RunChannel(0);
+    const double ChannelRefined = RunChannel(1);
+    ConsoleOutput::WriteLineInsert("Poiseuille flow");
+    ConsoleOutput::WriteStandard("Profile deviation (uniform)", ChannelUniform);
+    ConsoleOutput::WriteStandard("Profile deviation (refined)", ChannelRefined);
+    ConsoleOutput::WriteLine();
+
+    const double CoarseDrag  = std::abs(Coarse.drag/Fine.drag - 1.0);
+    const double RefinedDrag = std::abs(Refined.drag/Fine.drag - 1.0);
+    if(ChannelUniform > 1.0e-2 or ChannelRefined > 1.0e-2)
+    {
+        ConsoleOutput::WriteWarning("Velocity profile deviates from the analytic Poiseuille profile", "LBBlockRefinement", "main()");
+        return EXIT_FAILURE;
+    }
+    if(RefinedDrag > CoarseDrag)
+    {
+        ConsoleOutput::WriteWarning("Refined grid is not closer to the fine grid than the coarse grid", "LBBlockRefinement", "main()");
+        return EXIT_FAILURE;
+    }
+
+    if(std::abs(Refined.massDrift) > 1.0e-9)
+    {
+        ConsoleOutput::WriteWarning("Mass is not conserved across the refinement interface", "LBBlockRefinement", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -235,7 +235,7 @@ void LocalLBM::InitializeSphere(const double Radius, const int i0, const int j0,
         const int kk = k - k0;
         const double rr = sqrt(ii*ii + jj*jj + kk*kk);
 
-        DensityWetting(i,j,k,{0}) = std::max((0.5*(loc_rho+VaporDensity[0]/dRho) -0.5*(loc_rho-VaporDensity[0]/dRho)*tanh(2.*(rr-Radius)/(D)))*dRho, DensityWetting(i,j,k,{0}));
+        DensityWetting(i,j,k,{0}) = std::max<double>((0.5*(loc_rho+VaporDensity[0]/dRho) -0.5*(loc_rho-VaporDensity[0]/dRho)*tanh(2.*(rr-Radius)/(D)))*dRho, DensityWetting(i,j,k,{0}));
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 }
@@ -0,0 +1,221 @@
+/*
+ *   This file is a part of the OpenPhase software project.
+ *   For more details visit www.openphase.de
+ *
+ *   Created:    2025
+ *
+ *   Authors:    Raphael Schiedung
+ *
+ *   Copyright (c) 2009-2025 Interdisciplinary Centre for Advanced Materials
+ *                 Simulation (ICAMS). Ruhr-Universitaet Bochum. Germany
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "BoundaryConditions.h"
+#include "BuildInfo.h"
+#include "FluidDynamics/FlowSolverLBM.h"
+#include "ConsoleOutput.h"
+#include "Initializations.h"
+#include "PhaseField.h"
+#include "RunTimeControl.h"
+#include "Settings.h"
+#include "Velocities.h"
+
+using namespace openphase;
+
+struct PerformanceResult
+{
+    int    Size = 0;                                                            ///< Edge length of the cubic system
+    double Cells = 0.0;                                                         ///< Number of lattice cells
+    int    Steps = 0;                                                           ///< Number of timed steps
+    int    Threads = 1;                                                         ///< Number of OpenMP threads
+    int    Ranks = 1;                                                           ///< Number of MPI ranks
+    double Time = 0.0;                                                          ///< Wall clock time of the timed steps [s]
+    double MLUPS = 0.0;                                                         ///< Million lattice updates per second
+    double BytesPerCell = 0.0;                                                  ///< Memory held by the flow solver per cell
+    double BytesPerCellStep = 0.0;                                              ///< Modeled population traffic per cell and time step
+    double Bandwidth = 0.0;                                                     ///< Effective memory bandwidth [GB/s]
+    LBKernelTimes Kernels;                                                      ///< Time spent in the steps of FlowSolverLBM::Solve()
+};
+
+/* Runs the flow around a resting solid sphere in a periodic cube of edge
+   length Size and measures the performance of FlowSolverLBM::Solve() */
+PerformanceResult Run(Settings& OPSettings, const int Size, const int nSteps,
+                      const int nWarmUp, const double Radius)
+{
+    OPSettings.Grid.SetDimensions(Size, Size, Size);
+
+    BoundaryConditions BC    (OPSettings);
+    PhaseField         Phase (OPSettings);
+    Velocities         Vel   (OPSettings);
+    FlowSolverLBM      LB    (OPSettings, 1.0);
+
+    Initializations::Single(Phase, 0, BC);
+    const size_t solid = Initializations::Sphere(Phase, 1, Radius*Size,
+                                                 Size/2, Size/2, Size/2, BC);
+    Phase.FieldsProperties[solid].Mobile = false;
+    LB.SetUniformVelocity(BC, {0.0, 0.0, 0.0});
+    LB.FinalizeInitialiation(Phase, Vel, BC);
+
+    for(int step = 0; step < nWarmUp; step++)
+    {
+        Phase.ClearGrainsForcesAndAccelerations();
+        LB.Solve(Phase, Vel, BC);
+    }
+
+    LB.KernelTimes.Reset();
+    const double start = LBKernelTimes::Now();
+    for(int step = 0; step < nSteps; step++)
+    {
+        Phase.ClearGrainsForcesAndAccelerations();
+        LB.Solve(Phase, Vel, BC);
+    }
+
+    PerformanceResult Result;
+    Result.Size    = Size;
+    Result.Cells   = double(OPSettings.Grid.TotalNumberOfCells());
+    Result.Steps   = nSteps;
+    Result.Threads = omp_get_max_threads();
+    Result.Time    = LBKernelTimes::Now() - start;
+    Result.Kernels = LB.KernelTimes;
+#ifdef MPI_PARALLEL
+    Result.Ranks = MPI_SIZE;
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &Result.Time, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    Result.MLUPS = Result.Cells*nSteps/std::max(Result.Time, DBL_MIN)*1.0e-6;
+    Result.BytesPerCell = double(LB.AllocatedMemory())*Result.Ranks/Result.Cells;
+    /* Streaming and collision are separate sweeps, each reads and writes all
+    populations once */
+    Result.BytesPerCellStep = 4.0*LB.N_Fluid_Comp*sizeof(lbnode_t);
+    Result.Bandwidth = Result.MLUPS*Result.BytesPerCellStep*1.0e-3;
+    return Result;
+}
+
+void WriteCSV(const std::string FileName, const std::vector<PerformanceResult>& Results)
+{
+    std::ofstream file(FileName, std::ios::out);
+    file << "Size,Cells,Steps,Threads,Ranks,Time,MLUPS,BytesPerCell,BytesPerCellStep,"
+         << "Bandwidth,ObstacleDetection,Propagation,Forces,Collision,Velocities\n";
+    for(const PerformanceResult& R : Results)
+    {
+        const double n = std::max<size_t>(R.Kernels.Steps, 1);
+        file << R.Size << "," << R.Cells << "," << R.Steps << "," << R.Threads << ","
+             << R.Ranks << "," << R.Time << "," << R.MLUPS << "," << R.BytesPerCell << ","
+             << R.BytesPerCellStep << "," << R.Bandwidth << ","
+             << R.Kernels.ObstacleDetection/n << "," << R.Kernels.Propagation/n << ","
+             << R.Kernels.Forces/n << "," << R.Kernels.Collision/n << ","
+             << R.Kernels.Velocities/n << "\n";
+    }
+}
+
+void WriteJSON(const std::string FileName, const std::vector<PerformanceResult>& Results)
+{
+    json Output;
+    Output["benchmark"] = "LBMPerformance";
+    Output["commit"]    = GIT_COMMIT_SHA;
+    Output["runs"]      = json::array();
+    for(const PerformanceResult& R : Results)
+    {
+        const double n = std::max<size_t>(R.Kernels.Steps, 1);
+        json Run;
+        Run["size"]                = R.Size;
+        Run["cells"]               = R.Cells;
+        Run["steps"]               = R.Steps;
+        Run["threads"]             = R.Threads;
+        Run["ranks"]               = R.Ranks;
+        Run["time"]                = R.Time;
+        Run["mlups"]               = R.MLUPS;
+        Run["bytes_per_cell"]      = R.BytesPerCell;
+        Run["bytes_per_cell_step"] = R.BytesPerCellStep;
+        Run["bandwidth_gbs"]       = R.Bandwidth;
+        Run["kernels"]["obstacle_detection"] = R.Kernels.ObstacleDetection/n;
+        Run["kernels"]["propagation"]        = R.Kernels.Propagation/n;
+        Run["kernels"]["forces"]             = R.Kernels.Forces/n;
+        Run["kernels"]["collision"]          = R.Kernels.Collision/n;
+        Run["kernels"]["velocities"]         = R.Kernels.Velocities/n;
+        Output["runs"].push_back(Run);
+    }
+    std::ofstream file(FileName, std::ios::out);
+    file << Output.dump(4) << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef MPI_PARALLEL
+    int provided = 0;
+    OP_MPI_Init_thread(&argc, &argv, OP_MPI_THREAD_FUNNELED, &provided);
+    OP_MPI_Comm_rank(OP_MPI_COMM_WORLD, &MPI_RANK);
+    OP_MPI_Comm_size(OP_MPI_COMM_WORLD, &MPI_SIZE);
+    {
+#endif
+
+    Settings OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl RTC(OPSettings);
+
+    // Read benchmark specific input parameters
+    ConsoleOutput::WriteBlankLine();
+    ConsoleOutput::WriteLineInsert("LBMPerformance");
+    ConsoleOutput::WriteStandard("Source", DefaultInputFileName);
+    std::fstream inpF(DefaultInputFileName, std::ios::in);
+    std::stringstream inp;
+    inp << inpF.rdbuf();
+    inpF.close();
+    int moduleLocation = FileInterface::FindModuleLocation(inp, "LBMPerformance");
+    const std::vector<std::string> Sizes = FileInterface::ReadParameterVS(inp, moduleLocation, "Sizes");
+    const int         nWarmUp = FileInterface::ReadParameterI(inp, moduleLocation, "WarmUp", false, 5);
+    const double      Radius  = FileInterface::ReadParameterD(inp, moduleLocation, "Radius", false, 0.25);
+    const std::string Output  = FileInterface::ReadParameterF(inp, moduleLocation, "Output", false, "LBMPerformance");
+    ConsoleOutput::WriteLine();
+
+    std::vector<PerformanceResult> Results;
+    for(const std::string& Size : Sizes)
+    {
+        Results.push_back(Run(OPSettings, std::stoi(Size), RTC.nSteps, nWarmUp, Radius));
+        const PerformanceResult& R = Results.back();
+        const double n = std::max<size_t>(R.Kernels.Steps, 1);
+
+        ConsoleOutput::WriteLineInsert("System size " + Size + "^3");
+        ConsoleOutput::WriteStandard("Time steps", R.Steps);
+        ConsoleOutput::WriteStandard("Threads x ranks", std::to_string(R.Threads) + " x " + std::to_string(R.Ranks));
+        ConsoleOutput::WriteStandard("MLUPS", R.MLUPS);
+        ConsoleOutput::WriteStandard("Memory [bytes/cell]", R.BytesPerCell);
+        ConsoleOutput::WriteStandard("Population traffic [bytes/cell/step]", R.BytesPerCellStep);
+        ConsoleOutput::WriteStandard("Effective bandwidth [GB/s]", R.Bandwidth);
+        ConsoleOutput::WriteStandard("Obstacle detection [s/step]", R.Kernels.ObstacleDetection/n);
+        ConsoleOutput::WriteStandard("Propagation [s/step]", R.Kernels.Propagation/n);
+        ConsoleOutput::WriteStandard("Forces [s/step]", R.Kernels.Forces/n);
+        ConsoleOutput::WriteStandard("Collision [s/step]", R.Kernels.Collision/n);
+        ConsoleOutput::WriteStandard("Velocities [s/step]", R.Kernels.Velocities/n);
+        ConsoleOutput::WriteLine();
+    }
+
+#ifdef MPI_PARALLEL
+    if(MPI_RANK == 0)
+#endif
+    {
+        WriteCSV (OPSettings.TextDir + Output + ".csv",  Results);
+        WriteJSON(OPSettings.TextDir + Output + ".json", Results);
+        ConsoleOutput::WriteStandard("Results", OPSettings.TextDir + Output + ".csv/.json");
+    }
+
+#ifdef MPI_PARALLEL
+    }
+    OP_MPI_Finalize();
+#endif
+    return 0;
+}
@@ -0,0 +1,331 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "FluidDynamics/D3Q27.h"
+#include "FluidDynamics/LBPopulationsSoA.h"
+
+using namespace std;
+using namespace openphase;
+
+const double tau = 0.8;                                                         ///< BGK relaxation time (lattice units)
+
+/* Periodic wrap of a cell index into the interior */
+inline long int Wrap(const long int i, const long int N)
+{
+    return (i + N) % N;
+}
+
+/* BGK collision of the populations of one cell */
+template<class Lattice>
+inline void CollideBGK(double f[Lattice::Q])
+{
+    double rho = 0.0;
+    double ux = 0.0, uy = 0.0, uz = 0.0;
+    for(int q = 0; q < Lattice::Q; q++)
+    {
+        rho += f[q];
+        ux  += Lattice::c[q][0]*f[q];
+        uy  += Lattice::c[q][1]*f[q];
+        uz  += Lattice::c[q][2]*f[q];
+    }
+    ux /= rho; uy /= rho; uz /= rho;
+    const double u2 = ux*ux + uy*uy + uz*uz;
+    for(int q = 0; q < Lattice::Q; q++)
+    {
+        const double cu = Lattice::c[q][0]*ux + Lattice::c[q][1]*uy + Lattice::c[q][2]*uz;
+        const double feq = Lattice::w[q]*rho*(1.0 + 3.0*cu + 4.5*cu*cu - 1.5*u2);
+        f[q] += (feq - f[q])/tau;
+    }
+}
+
+/* Equilibrium populations of a shear wave u_x(y) */
+template<class Lattice>
+D3Q27 InitialPopulations(const long int j, const long int Ny)
+{
+    const double ux = 0.05*std::sin(2.0*Pi*j/Ny);
+    D3Q27 locPopulations;
+    for(int q = 0; q < Lattice::Q; q++)
+    {
+        const double cu = Lattice::c[q][0]*ux;
+        locPopulations(Lattice::c[q][0], Lattice::c[q][1], Lattice::c[q][2]) =
+            Lattice::w[q]*(1.0 + 3.0*cu + 4.5*cu*cu - 1.5*ux*ux);
+    }
+    return locPopulations;
+}
+
+/* Node-wise layout (Storage3D<D3Q27,1>): pull streaming into the second
+   storage, collision in place */
+double RunAoS(const GridParameters& Grid, const int nSteps, Storage3D<D3Q27,1>& Result)
+{
+    Storage3D<D3Q27,1> Populations[2];
+    Populations[0].Allocate(Grid, {1}, 1);
+    Populations[1].Allocate(Grid, {1}, 1);
+    STORAGE_LOOP_BEGIN(i,j,k,Populations[0],0)
+    {
+        Populations[0](i,j,k,{0}) = InitialPopulations<D3Q27Lattice>(j, Grid.Ny);
+    }
+    STORAGE_LOOP_END
+
+    myclock_t start = mygettime();
+    int src = 0;
+    for(int step = 0; step < nSteps; step++)
+    {
+        Storage3D<D3Q27,1>& Old = Populations[src];
+        Storage3D<D3Q27,1>& New = Populations[1-src];
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Old,1,)
+        {
+            if (i < 0 or i >= Grid.Nx or j < 0 or j >= Grid.Ny or k < 0 or k >= Grid.Nz)
+            {
+                Old(i,j,k,{0}) = Old(Wrap(i,Grid.Nx),Wrap(j,Grid.Ny),Wrap(k,Grid.Nz),{0});
+            }
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,New,0,)
+        {
+            double f[27];
+            for(int q = 0; q < 27; q++)
+            {
+                const int x = D3Q27Lattice::c[q][0];
+                const int y = D3Q27Lattice::c[q][1];
+                const int z = D3Q27Lattice::c[q][2];
+                f[q] = Old(i-x,j-y,k-z,{0})(x,y,z);
+            }
+            CollideBGK<D3Q27Lattice>(f);
+            double* locPopulations = New(i,j,k,{0}).data();
+            for(int q = 0; q < 27; q++) locPopulations[q] = f[q];
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+        src = 1-src;
+    }
+    double time = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+
+    Result.Allocate(Grid, {1}, 1);
+    STORAGE_LOOP_BEGIN(i,j,k,Result,0)
+    {
+        Result(i,j,k,{0}) = Populations[src](i,j,k,{0});
+    }
+    STORAGE_LOOP_END
+    return time;
+}
+
+/* Direction-wise layout (LBPopulationsSoA): in-place streaming by shifting the
+   direction arrays, collision vectorized over the cells */
+template<class Lattice>
+double RunSoA(const GridParameters& Grid, const int nSteps, LBPopulationsSoA<Lattice>& Populations)
+{
+    const int Q = Lattice::Q;
+    Populations.Allocate(Grid, 1, 1);
+    for(long int i = 0; i < Grid.Nx; i++)
+    for(long int j = 0; j < Grid.Ny; j++)
+    for(long int k = 0; k < Grid.Nz; k++)
+    {
+        Populations.Set(i,j,k,0,InitialPopulations<Lattice>(j, Grid.Ny));
+    }
+
+    double* f[Q];
+    for(int q = 0; q < Q; q++) f[q] = Populations.data(0, q);
+
+    myclock_t start = mygettime();
+    for(int step = 0; step < nSteps; step++)
+    {
+        #pragma omp parallel for collapse(2) schedule(static)
+        for(long int i = -1; i <= Grid.Nx; i++)
+        for(long int j = -1; j <= Grid.Ny; j++)
+        for(long int k = -1; k <= Grid.Nz; k++)
+        if (i < 0 or i >= Grid.Nx or j < 0 or j >= Grid.Ny or k < 0 or k >= Grid.Nz)
+        {
+            const size_t dst = Populations.Index(i,j,k);
+            const size_t src = Populations.Index(Wrap(i,Grid.Nx),Wrap(j,Grid.Ny),Wrap(k,Grid.Nz));
+            for(int q = 0; q < Q; q++) f[q][dst] = f[q][src];
+        }
+
+        Populations.Stream();
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for(long int i = 0; i < Grid.Nx; i++)
+        for(long int j = 0; j < Grid.Ny; j++)
+        {
+            const size_t begin = Populations.Index(i,j,0);
+            #pragma omp simd
+            for(size_t idx = begin; idx < begin + Grid.Nz; idx++)
+            {
+                double locf[Q];
+                for(int q = 0; q < Q; q++) locf[q] = f[q][idx];
+                CollideBGK<Lattice>(locf);
+                for(int q = 0; q < Q; q++) f[q][idx] = locf[q];
+            }
+        }
+    }
+    return double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+}
+
+/* Populations stored as plain float, counterpart of D3Q27Shifted which stores
+   the deviations from the lattice weights */
+struct D3Q27Float
+{
+    std::array<float,27> storage;
+
+    D3Q27Float& operator=(const D3Q27& rhs)
+    {
+        for(int q = 0; q < 27; q++) storage[q] = rhs.const_data()[q];
+        return *this;
+    }
+    operator D3Q27() const
+    {
+        D3Q27 locPopulations;
+        for(int q = 0; q < 27; q++) locPopulations.data()[q] = storage[q];
+        return locPopulations;
+    }
+};
+
+/* Amplitude of a low Mach number shear wave u_x(y) = u0*sin(2*Pi*y/Ny) after
+   nSteps time steps, with the populations stored as "Node" between the steps.
+   The wave only depends on y, a single cell in x and z direction suffices. */
+template<class Node>
+double ShearWaveAmplitude(const long int Ny, const int nSteps, const double u0)
+{
+    std::vector<Node> Populations(Ny);
+    std::vector<Node> PopulationsTMP(Ny);
+    for(long int j = 0; j < Ny; j++)
+    {
+        const double ux = u0*std::sin(2.0*Pi*j/Ny);
+        D3Q27 locPopulations;
+        for(int q = 0; q < 27; q++)
+        {
+            const double cu = D3Q27Lattice::c[q][0]*ux;
+            locPopulations.data()[q] = D3Q27Lattice::w[q]*(1.0 + 3.0*cu + 4.5*cu*cu - 1.5*ux*ux);
+        }
+        Populations[j] = locPopulations;
+    }
+
+    for(int step = 0; step < nSteps; step++)
+    {
+        for(long int j = 0; j < Ny; j++)
+        {
+            double f[27];
+            for(int q = 0; q < 27; q++)
+            {
+                const D3Q27 Source = Populations[Wrap(j - D3Q27Lattice::c[q][1], Ny)];
+                f[q] = Source.const_data()[q];
+            }
+            CollideBGK<D3Q27Lattice>(f);
+            D3Q27 locPopulations;
+            for(int q = 0; q < 27; q++) locPopulations.data()[q] = f[q];
+            PopulationsTMP[j] = locPopulations;
+        }
+        std::swap(Populations, PopulationsTMP);
+    }
+
+    double Amplitude = 0.0;
+    for(long int j = 0; j < Ny; j++)
+    {
+        const D3Q27 locPopulations = Populations[j];
+        double rho = 0.0;
+        double jx = 0.0;
+        for(int q = 0; q < 27; q++)
+        {
+            rho += locPopulations.const_data()[q];
+            jx  += D3Q27Lattice::c[q][0]*locPopulations.const_data()[q];
+        }
+        Amplitude += 2.0/Ny*jx/rho*std::sin(2.0*Pi*j/Ny);
+    }
+    return Amplitude;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                    OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl              RTC(OPSettings);
+
+    const GridParameters& Grid = OPSettings.Grid;
+    if(Grid.Active() != 3)
+    {
+        ConsoleOutput::WriteExit("The benchmark requires a three-dimensional grid", "LBMPopulationLayout", "main()");
+        return EXIT_FAILURE;
+    }
+    const int nSteps = RTC.nSteps;
+    const double nCells = double(Grid.Nx)*Grid.Ny*Grid.Nz;
+
+    Storage3D<D3Q27,1> ResultAoS;
+    D3Q27SoA           ResultSoA;
+    const double timeAoS = RunAoS(Grid, nSteps, ResultAoS);
+    const double timeSoA = RunSoA(Grid, nSteps, ResultSoA);
+
+    // Reduced lattices (no reference, throughput and memory only)
+    D3Q19SoA ResultD3Q19;
+    D3Q15SoA ResultD3Q15;
+    const double timeD3Q19 = RunSoA(Grid, nSteps, ResultD3Q19);
+    const double timeD3Q15 = RunSoA(Grid, nSteps, ResultD3Q15);
+
+    double maxDeviation = 0.0;
+    STORAGE_LOOP_BEGIN(i,j,k,ResultAoS,0)
+    {
+        const D3Q27 Difference = ResultAoS(i,j,k,{0}) - ResultSoA.Get(i,j,k,0);
+        for(int q = 0; q < 27; q++)
+        {
+            maxDeviation = std::max(maxDeviation, std::abs(Difference.const_data()[q]));
+        }
+    }
+    STORAGE_LOOP_END
+
+    const double MLUPSAoS = nSteps*nCells/std::max(timeAoS, DBL_MIN)*1.0e-6;
+    const double MLUPSSoA = nSteps*nCells/std::max(timeSoA, DBL_MIN)*1.0e-6;
+    const double MLUPSD3Q19 = nSteps*nCells/std::max(timeD3Q19, DBL_MIN)*1.0e-6;
+    const double MLUPSD3Q15 = nSteps*nCells/std::max(timeD3Q15, DBL_MIN)*1.0e-6;
+
+    ConsoleOutput::WriteLineInsert("D3Q27 population layout");
+    ConsoleOutput::WriteStandard("Cells", nCells);
+    ConsoleOutput::WriteStandard("Time steps", nSteps);
+    ConsoleOutput::WriteStandard("Node-wise (AoS) [MLUPS]", MLUPSAoS);
+    ConsoleOutput::WriteStandard("Direction-wise (SoA) [MLUPS]", MLUPSSoA);
+    ConsoleOutput::WriteStandard("Speedup", MLUPSSoA/std::max(MLUPSAoS, DBL_MIN));
+    ConsoleOutput::WriteStandard("Node-wise (AoS) [bytes/cell]", 2.0*27*sizeof(double));
+    ConsoleOutput::WriteStandard("Direction-wise (SoA) [bytes/cell]", double(ResultSoA.AllocatedMemory())/nCells);
+    ConsoleOutput::WriteStandard("Max deviation", maxDeviation);
+    ConsoleOutput::WriteLineInsert("Reduced lattices (direction-wise)");
+    ConsoleOutput::WriteStandard("D3Q19 [MLUPS]", MLUPSD3Q19);
+    ConsoleOutput::WriteStandard("D3Q15 [MLUPS]", MLUPSD3Q15);
+    ConsoleOutput::WriteStandard("D3Q19 [bytes/cell]", double(ResultD3Q19.AllocatedMemory())/nCells);
+    ConsoleOutput::WriteStandard("D3Q15 [bytes/cell]", double(ResultD3Q15.AllocatedMemory())/nCells);
+
+    /* Storage precision (SETTINGS="single-populations"): the decay of a shear
+    wave at u0 = 1e-3 over 2000 time steps with the populations stored in
+    double, as float deviations from the lattice weights (D3Q27Shifted) and as
+    plain float. The velocity signal is four orders of magnitude below the
+    populations, plain float storage loses it in the round-off. */
+    const long int NyWave = 32;
+    const int nStepsWave = 2000;
+    const double u0 = 1.0e-3;
+    const double AmplitudeDouble  = ShearWaveAmplitude<D3Q27>(NyWave, nStepsWave, u0);
+    const double AmplitudeShifted = ShearWaveAmplitude<D3Q27Shifted>(NyWave, nStepsWave, u0);
+    const double AmplitudeFloat   = ShearWaveAmplitude<D3Q27Float>(NyWave, nStepsWave, u0);
+    const double nu = (tau - 0.5)/3.0;
+    const double k2 = 4.0*Pi*Pi/(NyWave*NyWave);
+    const double AmplitudeAnalytic = u0*std::exp(-nu*k2*nStepsWave);
+    const double ShiftedDeviation = std::abs(AmplitudeShifted/AmplitudeDouble - 1.0);
+    const double FloatDeviation   = std::abs(AmplitudeFloat/AmplitudeDouble - 1.0);
+
+    ConsoleOutput::WriteLineInsert("Population storage precision (shear wave)");
+    ConsoleOutput::WriteStandard("Analytic amplitude", AmplitudeAnalytic);
+    ConsoleOutput::WriteStandard("Double amplitude", AmplitudeDouble);
+    ConsoleOutput::WriteStandard("Shifted float amplitude", AmplitudeShifted);
+    ConsoleOutput::WriteStandard("Plain float amplitude", AmplitudeFloat);
+    ConsoleOutput::WriteStandard("Shifted float deviation", ShiftedDeviation);
+    ConsoleOutput::WriteStandard("Plain float deviation", FloatDeviation);
+    ConsoleOutput::WriteLine();
+
+    if(maxDeviation > 1.0e-12)
+    {
+        ConsoleOutput::WriteWarning("Population layouts produce different results", "LBMPopulationLayout", "main()");
+        return EXIT_FAILURE;
+    }
+    if(std::abs(AmplitudeDouble/AmplitudeAnalytic - 1.0) > 5.0e-2 or ShiftedDeviation > 1.0e-5)
+    {
+        ConsoleOutput::WriteWarning("Shifted single precision populations do not reproduce the shear wave decay", "LBMPopulationLayout", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
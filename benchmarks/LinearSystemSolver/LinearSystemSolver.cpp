@@ -1,5 +1,6 @@
 #include "Includes.h"
 #include "NumericalMethods/SystemOfLinearEquationsSolvers.h"
+#include "NumericalMethods/Preconditioners.h"
 #include "BoundaryConditions.h"
 #include "Settings.h"
 #include "Tools/TimeInfo.h"
@@ -166,12 +167,44 @@ int main(int argc, char *argv[])
     size_t iBiconjugateGradient = op::SystemOfLinearEquationsSolvers::BiconjugateGradient(A,xBiconjugateGradient,b,MaxResidual);
     Timer.SetTimeStamp("Biconjugate Gradient Method");
 
-    //TODO write new BiCGStab solver the implemented fails!
-    //auto xBiCGstab = x;
-    //BiCGStab::BiCGstab_Jacobi(A,xBiCGstab,b,5,MaxResidual);
-    //Timer.SetTimeStamp("xBiCGstab Method");
+    // Same solvers on the compressed row format
+    op::ConsoleOutput::Write("Convert matrix to compressed row format");
+    const op::SparseMatrixCompressedRow Acompressed(A);
+    Timer.SetTimeStamp("Compressed Row Conversion");
+
+    op::ConsoleOutput::Write("Calculate result with Conjugate Gradient Method (compressed row)");
+    auto xConjugateGradientCompressed = x;
+    size_t iConjugateGradientCompressed = op::SystemOfLinearEquationsSolvers::ConjugateGradient(Acompressed,xConjugateGradientCompressed,b,MaxResidual);
+    Timer.SetTimeStamp("Conjugate Gradient Method (compressed row)");
+
+    op::ConsoleOutput::Write("Calculate result with Biconjugate Gradient Method (compressed row)");
+    auto xBiconjugateGradientCompressed = x;
+    size_t iBiconjugateGradientCompressed = op::SystemOfLinearEquationsSolvers::BiconjugateGradient(Acompressed,xBiconjugateGradientCompressed,b,MaxResidual);
+    Timer.SetTimeStamp("Biconjugate Gradient Method (compressed row)");
+
+    namespace solvers = op::SystemOfLinearEquationsSolvers;
+
+    op::ConsoleOutput::Write("Calculate result with BiCGStab Method (Jacobi)");
+    auto xBiCGStabJacobi = x;
+    size_t iBiCGStabJacobi = solvers::BiCGStab(Acompressed, solvers::JacobiPreconditioner(Acompressed),
+                                               xBiCGStabJacobi, b, MaxResidual, N);
+    Timer.SetTimeStamp("BiCGStab Method (Jacobi)");
+
+    op::ConsoleOutput::Write("Calculate result with BiCGStab Method (ILU0)");
+    auto xBiCGStabILU0 = x;
+    size_t iBiCGStabILU0 = solvers::BiCGStab(Acompressed, solvers::ILU0Preconditioner(Acompressed),
+                                             xBiCGStabILU0, b, MaxResidual, N);
+    Timer.SetTimeStamp("BiCGStab Method (ILU0)");
+
+    op::ConsoleOutput::Write("Calculate result with BiCGStab Method (SSOR)");
+    auto xBiCGStabSSOR = x;
+    size_t iBiCGStabSSOR = solvers::BiCGStab(Acompressed, solvers::SSORPreconditioner(Acompressed, 1.2),
+                                             xBiCGStabSSOR, b, MaxResidual, N);
+    Timer.SetTimeStamp("BiCGStab Method (SSOR)");
 
     Timer.PrintWallClockSummary();
+    Timer.WriteJSON(OPSettings.TextDir + "TimeInfo.json");
+    Timer.WritePerformance(OPSettings.TextDir + "Performance.dat", OPSettings.Grid.TotalNumberOfCells());
 
     auto write_to_file = [&]<class T>(std::string name, T x)
     {
@@ -204,12 +237,22 @@ int main(int argc, char *argv[])
     const double DiffGradientDescent     = write_to_file("GradientDescent"      , xGradientDescent);
     const double DiffConjugateGradient   = write_to_file("ConjugateGradient"   , xConjugateGradient);
     const double DiffBiconjugateGradient = write_to_file("BiconjugateGradient" , xBiconjugateGradient);
+    const double DiffConjugateGradientCompressed   = write_to_file("ConjugateGradientCompressed"   , xConjugateGradientCompressed);
+    const double DiffBiconjugateGradientCompressed = write_to_file("BiconjugateGradientCompressed" , xBiconjugateGradientCompressed);
+    const double DiffBiCGStabJacobi      = write_to_file("BiCGStabJacobi"      , xBiCGStabJacobi);
+    const double DiffBiCGStabILU0        = write_to_file("BiCGStabILU0"        , xBiCGStabILU0);
+    const double DiffBiCGStabSSOR        = write_to_file("BiCGStabSSOR"        , xBiCGStabSSOR);
 
     if (DoJacobi)         op::ConsoleOutput::Write("Iterations of Jacobi"               , iJacobi);
     if (DoGaussSeidel)    op::ConsoleOutput::Write("Iterations of Gauss-Seidel"         , iGaussSeidel);
     if (DoGradientDecent) op::ConsoleOutput::Write("Iterations of Gradient Descent"     , iGradientDescent);
     op::ConsoleOutput::Write("Iterations of Conjugate Gradient"   , iConjugateGradient);
     op::ConsoleOutput::Write("Iterations of Biconjugate Gradient" , iBiconjugateGradient);
+    op::ConsoleOutput::Write("Iterations of Conjugate Gradient (compressed row)"   , iConjugateGradientCompressed);
+    op::ConsoleOutput::Write("Iterations of Biconjugate Gradient (compressed row)" , iBiconjugateGradientCompressed);
+    op::ConsoleOutput::Write("Iterations of BiCGStab (Jacobi)"    , iBiCGStabJacobi);
+    op::ConsoleOutput::Write("Iterations of BiCGStab (ILU0)"      , iBiCGStabILU0);
+    op::ConsoleOutput::Write("Iterations of BiCGStab (SSOR)"      , iBiCGStabSSOR);
     op::ConsoleOutput::Write("");
     if (DoGauss)          op::ConsoleOutput::Write("Max Error of Gauss"                , DiffGauss);
     if (DoJacobi)         op::ConsoleOutput::Write("Max Error of Jacobi"               , DiffJacobi);
@@ -217,6 +260,11 @@ int main(int argc, char *argv[])
     if (DoGradientDecent) op::ConsoleOutput::Write("Max Error of Gradient Descent"     , DiffGradientDescent);
     op::ConsoleOutput::Write("Max Error of Conjugate Gradient"   , DiffConjugateGradient);
     op::ConsoleOutput::Write("Max Error of Biconjugate Gradient" , DiffBiconjugateGradient);
+    op::ConsoleOutput::Write("Max Error of Conjugate Gradient (compressed row)"   , DiffConjugateGradientCompressed);
+    op::ConsoleOutput::Write("Max Error of Biconjugate Gradient (compressed row)" , DiffBiconjugateGradientCompressed);
+    op::ConsoleOutput::Write("Max Error of BiCGStab (Jacobi)"    , DiffBiCGStabJacobi);
+    op::ConsoleOutput::Write("Max Error of BiCGStab (ILU0)"      , DiffBiCGStabILU0);
+    op::ConsoleOutput::Write("Max Error of BiCGStab (SSOR)"      , DiffBiCGStabSSOR);
 
     std::ofstream os("Results.sim");
     os << std::scientific << std::setprecision(16);
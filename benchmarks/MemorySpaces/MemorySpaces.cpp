@@ -0,0 +1,121 @@
+#include "Includes.h"
+
+using namespace std;
+using namespace openphase;
+
+inline double Value(const long int i, const long int j, const long int k, const size_t n = 0)
+{
+    return 1.0 + i + 10.0*j + 100.0*k + 1000.0*n;
+}
+
+/* Allocate, fill, copy, synchronize and reallocate storages of scalar and
+vector values in the memory space "Space", returns the number of failed
+checks. Without an offload device the target constructs of the mirrored
+space operate on the host, so all spaces have to give the same results. */
+template<class Space>
+int RoundTrip(const std::string& Name)
+{
+    int Failed = 0;
+    auto Check = [&](const bool Condition, const std::string& What)
+    {
+        if(not Condition)
+        {
+            ConsoleOutput::WriteWarning(Name + ": " + What, "MemorySpaces", "RoundTrip()");
+            Failed++;
+        }
+    };
+
+    Storage3D<double,0,Space> Scalar;
+    Scalar.Allocate(8, 6, 4, 1, 1, 1, 1);
+    STORAGE_LOOP_BEGIN(i,j,k,Scalar,Scalar.Bcells())
+    {
+        Scalar(i,j,k) = Value(i,j,k);
+    }
+    STORAGE_LOOP_END
+    Scalar.mark_host_modified();
+
+    Scalar.sync_to_device();
+    Check(Scalar.memory_state() == MemoryStates::Synchronized, "state after sync_to_device()");
+    Scalar.mark_device_modified();
+    Check(Scalar.memory_state() == MemoryStates::DeviceModified, "state after mark_device_modified()");
+    Scalar.sync_to_host();
+    Check(Scalar.memory_state() == MemoryStates::Synchronized, "state after sync_to_host()");
+
+    Storage3D<double,0,Space> ScalarCopy(Scalar);
+    Storage3D<double,0,Space> ScalarAssigned;
+    ScalarAssigned = Scalar;
+    bool Equal = true;
+    STORAGE_LOOP_BEGIN(i,j,k,Scalar,Scalar.Bcells())
+    {
+        Equal = Equal and ScalarCopy(i,j,k) == Value(i,j,k)
+                      and ScalarAssigned(i,j,k) == Value(i,j,k);
+    }
+    STORAGE_LOOP_END
+    Check(Equal, "scalar copies differ");
+
+    /* A reallocated buffer is mapped anew on the next synchronization */
+    Scalar.Reallocate(10, 6, 4);
+    Check(Scalar.sizeX() == 10 and Scalar.sizeY() == 6 and Scalar.sizeZ() == 4, "scalar sizes after Reallocate()");
+    Scalar.set_to_value(2.0);
+    Scalar.mark_host_modified();
+    Scalar.sync_to_device();
+    Check(Scalar.memory_state() == MemoryStates::Synchronized, "state after Reallocate() and sync_to_device()");
+    Check(Scalar(9,5,3) == 2.0, "scalar value after Reallocate()");
+
+    Storage3D<double,1,Space> Vector;
+    Vector.Allocate(8, 6, 4, 1, 1, 1, {3}, 1);
+    STORAGE_LOOP_BEGIN(i,j,k,Vector,Vector.Bcells())
+    {
+        for(size_t n = 0; n < 3; n++) Vector(i,j,k)({n}) = Value(i,j,k,n);
+    }
+    STORAGE_LOOP_END
+    Vector.mark_host_modified();
+    Vector.sync_to_device();
+    Vector.mark_device_modified();
+    Vector.sync_to_host();
+    Check(Vector.memory_state() == MemoryStates::Synchronized, "vector state after the round trip");
+
+    /* The copy constructor of vector storages copies the interior only */
+    Storage3D<double,1,Space> VectorCopy(Vector);
+    Storage3D<double,1,Space> VectorAssigned;
+    VectorAssigned = Vector;
+    Equal = true;
+    STORAGE_LOOP_BEGIN(i,j,k,Vector,0)
+    {
+        for(size_t n = 0; n < 3; n++)
+        {
+            Equal = Equal and VectorCopy(i,j,k)({n}) == Value(i,j,k,n)
+                          and VectorAssigned(i,j,k)({n}) == Value(i,j,k,n);
+        }
+    }
+    STORAGE_LOOP_END
+    Check(Equal, "vector copies differ");
+
+    Vector.Reallocate(4, 6, 8);
+    Check(Vector.sizeX() == 4 and Vector.sizeZ() == 8 and Vector(3,5,7).size() == 3, "vector sizes after Reallocate()");
+    Vector.mark_host_modified();
+    Vector.sync_to_device();
+    Check(Vector.memory_state() == MemoryStates::Synchronized, "vector state after Reallocate() and sync_to_device()");
+
+    ConsoleOutput::WriteStandard(Name, Failed == 0 ? "OK" : "FAILED");
+    return Failed;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    ConsoleOutput::WriteLineInsert("Storage3D memory spaces");
+    int Failed = 0;
+    Failed += RoundTrip<HostSpace>("HostSpace");
+    Failed += RoundTrip<PinnedHostSpace>("PinnedHostSpace");
+    Failed += RoundTrip<DeviceSpace>("DeviceSpace");
+    Failed += RoundTrip<ManagedSpace>("ManagedSpace");
+    ConsoleOutput::WriteLine();
+
+    if(Failed != 0)
+    {
+        ConsoleOutput::WriteWarning("Storage round trip failed in at least one memory space", "MemorySpaces", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
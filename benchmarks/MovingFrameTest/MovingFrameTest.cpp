@@ -0,0 +1,126 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "InterfaceProperties.h"
+#include "DoubleObstacle.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "DrivingForce.h"
+#include "UserDrivingForce.h"
+#include "MovingFrame.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Fraction of the thermodynamic phase "phase" summed over each plane normal
+to the X axis, scanned over the whole domain */
+vector<double> PlaneSums(const PhaseField& Phi, const size_t phase)
+{
+    vector<double> Sums(Phi.Fields.sizeX(), 0.0);
+    STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0)
+    {
+        for(auto it  = Phi.Fields(i,j,k).cbegin();
+                 it != Phi.Fields(i,j,k).cend(); ++it)
+        if(Phi.FieldsProperties[it->index].Phase == phase)
+        {
+            Sums[i] += it->value;
+        }
+    }
+    STORAGE_LOOP_END
+    return Sums;
+}
+
+/* Farthest plane holding at least half a cell of the phase, -1 if none */
+long int ScannedFront(const vector<double>& Sums)
+{
+    long int position = -1;
+    for(size_t p = 0; p < Sums.size(); p++)
+    if(Sums[p] >= 0.5)
+    {
+        position = p;
+    }
+    return position;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                        OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl                  RTC(OPSettings);
+    PhaseField                      Phi(OPSettings);
+    DoubleObstacle                  DO(OPSettings);
+    InterfaceProperties             IP(OPSettings);
+    BoundaryConditions              BC(OPSettings);
+    DrivingForce                    DF(OPSettings);
+    MovingFrame                     Frame(OPSettings);
+
+    const size_t Liquid = 0;
+    const size_t Solid  = 1;
+    const double dG     = 2.5e5;                                                // Moves the front by about 0.05 cells per time step
+
+    /* Solid on the left of a planar front at x = 16 growing into the liquid */
+    const size_t LiquidIdx = Initializations::Single(Phi, Liquid, BC);
+    const size_t SolidIdx  = Initializations::SectionalPlane(Phi, Solid,
+                                 {16.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, BC);
+    Frame.Register(Phi, BC);
+
+    int Mismatches = 0;
+    int Moves = 0;
+    for(RTC.TimeStep = RTC.StartTimeStep; RTC.TimeStep <= RTC.MaxTimeStep; RTC.IncrementTimeStep())
+    {
+        DF.Clear();
+        IP.Set(Phi, BC);
+        DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+        UserDrivingForce::SetDrivingForce(Phi, DF, SolidIdx, LiquidIdx, dG);
+        DF.Average(Phi, BC);
+        DF.MergePhaseFieldIncrements(Phi, IP);
+        Phi.NormalizeIncrements(BC, RTC.dt);
+        Phi.MergeIncrements(BC, RTC.dt);
+
+        /* The tracked front has to agree with a full scan of the domain */
+        const vector<double> Before = PlaneSums(Phi, Solid);
+        const bool Triggered = Frame.Triggered(Phi);
+        if(Phi.FrontPosition() != ScannedFront(Before) or
+           Triggered != (ScannedFront(Before) >= long(Frame.trigger_position)))
+        {
+            ConsoleOutput::WriteWarning("Tracked front " + to_string(Phi.FrontPosition())
+                                      + " differs from the scanned front " + to_string(ScannedFront(Before))
+                                      + " in time step " + to_string(RTC.TimeStep),
+                                        "MovingFrameTest", "main()");
+            Mismatches++;
+        }
+
+        /* A move shifts the content by one cell against the moving direction */
+        if(Frame.Apply(Phi))
+        {
+            Moves++;
+            const vector<double> After = PlaneSums(Phi, Solid);
+            for(size_t p = 0; p + 1 < After.size(); p++)
+            if(std::abs(After[p] - Before[p+1]) > 1.0e-12)
+            {
+                ConsoleOutput::WriteWarning("Plane " + to_string(p) + " was not shifted in time step "
+                                          + to_string(RTC.TimeStep), "MovingFrameTest", "main()");
+                Mismatches++;
+                break;
+            }
+        }
+    }
+
+    const long int Front = ScannedFront(PlaneSums(Phi, Solid));
+    ConsoleOutput::WriteLineInsert("Moving frame");
+    ConsoleOutput::WriteStandard("Frame moves", Moves);
+    ConsoleOutput::WriteStandard("Final front position", Front);
+    ConsoleOutput::WriteStandard("Mismatches", Mismatches);
+    ConsoleOutput::WriteLine();
+
+    /* The frame has to keep the front at the trigger position */
+    if(Mismatches != 0 or Moves == 0 or
+       std::abs(Front - long(Frame.trigger_position)) > 1)
+    {
+        ConsoleOutput::WriteWarning("Moving frame check failed", "MovingFrameTest", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -28,6 +28,9 @@ int main(int argc, char *argv[])
 
     cout << "Entering the Time Loop!!!" << endl;
 
+    // Interface energy history, used by run.sh for the regression check
+    ofstream EnergyFile("Energy.dat");
+
     for(RTC.TimeStep = RTC.StartTimeStep; RTC.TimeStep <= RTC.MaxTimeStep; RTC.IncrementTimeStep())
     {
         DF.Clear();
@@ -49,7 +52,26 @@ int main(int argc, char *argv[])
             std::string message  = ConsoleOutput::GetStandard("Interface energy density", I_En);
                         message += ConsoleOutput::GetStandard("Interface energy", DO.Energy(Phi, IP));
             ConsoleOutput::WriteTimeStep(RTC, message);
+            EnergyFile << RTC.TimeStep << " " << setprecision(10) << I_En << endl;
         }
     } //end of time loop
+
+    // Derivatives throughput: run-time sized stencil loops vs. fixed size kernels
+    const int nSweeps = 20;
+    const double nCells = double(OPSettings.Grid.Nx)*OPSettings.Grid.Ny*OPSettings.Grid.Nz;
+    double cellsPerSecond[2] = {0.0, 0.0};
+    for(int fixed = 0; fixed < 2; fixed++)
+    {
+        Phi.FixedStencilKernels = fixed;
+        myclock_t start = mygettime();
+        for(int n = 0; n < nSweeps; n++) Phi.Finalize(BC);
+        double time = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+        cellsPerSecond[fixed] = nSweeps*nCells/std::max(time, DBL_MIN);
+    }
+    ConsoleOutput::WriteLineInsert("Phase-field derivatives throughput");
+    ConsoleOutput::WriteStandard("Run-time stencil [cells/s]", cellsPerSecond[0]);
+    ConsoleOutput::WriteStandard("Fixed stencil [cells/s]", cellsPerSecond[1]);
+    ConsoleOutput::WriteStandard("Speedup", cellsPerSecond[1]/std::max(cellsPerSecond[0], DBL_MIN));
+    ConsoleOutput::WriteLine();
     return 0;
 }
@@ -7,6 +7,7 @@
 #include "Initializations.h"
 #include "BoundaryConditions.h"
 #include "DrivingForce.h"
+#include "Tools/TimeInfo.h"
 
 using namespace std;
 using namespace openphase;
@@ -23,6 +24,7 @@ int main(int argc, char *argv[])
     InterfaceProperties         IP(OPSettings);
     BoundaryConditions          BC(OPSettings);
     DrivingForce                DF(OPSettings);
+    TimeInfo                    Timer(OPSettings, "Execution Time Statistics");
 
     Initializations::Young4(Phi, 0, 1, 2, 3, BC);
 
@@ -34,11 +36,17 @@ int main(int argc, char *argv[])
 
     for(RTC.tStep = RTC.tStart; RTC.tStep <= RTC.nSteps; RTC.IncrementTimeStep())
     {
+        Timer.SetStart();
         DF.Clear();
+        Timer.SetTimeStamp("Clear driving forces");
         IP.Set(Phi, BC);
+        Timer.SetTimeStamp("Set IPs");
         DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+        Timer.SetTimeStamp("Phase-field increments");
         Phi.NormalizeIncrements(BC, RTC.dt);
+        Timer.SetTimeStamp("Normalize increments");
         Phi.MergeIncrements(BC, RTC.dt);
+        Timer.SetTimeStamp("Merge increments");
 
         // Keeping the quadruple junction in the center of the simulation box
         double x2 = 0;
@@ -79,12 +87,14 @@ int main(int argc, char *argv[])
         {
             Phi.MoveFrame(dx, dy, dz, BC);
         }
+        Timer.SetTimeStamp("Moving frame");
 
         if (RTC.WriteVTK())
         {
            //  Output to file
            Phi.WriteVTK(OPSettings, RTC.tStep);
         }
+        Timer.SetTimeStamp("Write VTK files");
 
         if (RTC.WriteToScreen())
         {
@@ -97,6 +107,27 @@ int main(int argc, char *argv[])
             Phi.PrintPointStatistics(x1,y1,z1);
             Phi.PrintPointStatistics(int(x2),int(y2),int(z2));
         }
+        Timer.SetTimeStamp("Output to screen");
     } //end of time loop
+    Timer.WriteJSON(OPSettings.TextDir + "TimeInfo.json");
+    Timer.WritePerformance(OPSettings.TextDir + "Performance.dat", OPSettings.Grid.TotalNumberOfCells());
+
+    // Derivatives throughput: run-time sized stencil loops vs. fixed size kernels
+    const int nSweeps = 20;
+    const double nCells = double(OPSettings.Grid.Nx)*OPSettings.Grid.Ny*OPSettings.Grid.Nz;
+    double cellsPerSecond[2] = {0.0, 0.0};
+    for(int fixed = 0; fixed < 2; fixed++)
+    {
+        Phi.FixedStencilKernels = fixed;
+        myclock_t start = mygettime();
+        for(int n = 0; n < nSweeps; n++) Phi.Finalize(BC);
+        double time = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+        cellsPerSecond[fixed] = nSweeps*nCells/std::max(time, DBL_MIN);
+    }
+    ConsoleOutput::WriteLineInsert("Phase-field derivatives throughput");
+    ConsoleOutput::WriteStandard("Run-time stencil [cells/s]", cellsPerSecond[0]);
+    ConsoleOutput::WriteStandard("Fixed stencil [cells/s]", cellsPerSecond[1]);
+    ConsoleOutput::WriteStandard("Speedup", cellsPerSecond[1]/std::max(cellsPerSecond[0], DBL_MIN));
+    ConsoleOutput::WriteLine();
     return 0;
 }
@@ -0,0 +1,327 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Phase-field overlap counting as it was implemented before the thread-local
+   accumulation: every update of the overlap matrix enters a critical section */
+Matrix<int> OverlapCritical(const PhaseField& Phi)
+{
+    Matrix<int> Overlap;
+    int numberOfGrains = Phi.FieldsProperties.size();
+    Overlap.Allocate(numberOfGrains, numberOfGrains);
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0,)
+    {
+        if (Phi.Fields(i,j,k).interface())
+        for (auto it  = Phi.Fields(i,j,k).cbegin();
+                  it != Phi.Fields(i,j,k).cend(); ++it)
+        for (auto jt = it+1; jt < Phi.Fields(i,j,k).cend(); ++jt)
+        {
+            #ifdef _OPENMP
+            #pragma omp critical
+            #endif
+            {
+                Overlap.add(it->index, jt->index, 1);
+            }
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return Overlap;
+}
+
+bool Equal(const Matrix<int>& A, const Matrix<int>& B)
+{
+    if(A.sizeN() != B.sizeN() or A.sizeM() != B.sizeM()) return false;
+    for(size_t n = 0; n < A.sizeN(); n++)
+    for(size_t m = 0; m < A.sizeM(); m++)
+    {
+        if(A(n,m) != B(n,m)) return false;
+    }
+    return true;
+}
+
+/* Force and torque contribution of a phase field in an interface cell, a
+   stand-in for the drag and bounce back force densities of FlowSolverLBM */
+inline void GrainForceContribution(const long int i, const long int j,
+        const long int k, const double value, dVector3& Force, dVector3& Torque)
+{
+    const dVector3 pos {double(i), double(j), double(k)};
+    Force  = dVector3{1.0, 0.5, 0.25}*value*(1.0 - value);
+    Torque = pos.cross(Force);
+}
+
+/* Grain force accumulation as it was implemented in FlowSolverLBM and
+   InteractionSolidSolid before: every update enters a critical section */
+Tensor<dVector3,2> GrainForcesCritical(const PhaseField& Phi)
+{
+    Tensor<dVector3,2> GrainForces({Phi.FieldsProperties.size(),2});
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0,)
+    {
+        if (Phi.Fields(i,j,k).interface())
+        for (auto it  = Phi.Fields(i,j,k).cbegin();
+                  it != Phi.Fields(i,j,k).cend(); ++it)
+        {
+            dVector3 Force;
+            dVector3 Torque;
+            GrainForceContribution(i,j,k,it->value,Force,Torque);
+            #ifdef _OPENMP
+            #pragma omp critical
+            #endif
+            {
+                GrainForces({it->index,0}) += Force;
+                GrainForces({it->index,1}) += Torque;
+            }
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return GrainForces;
+}
+
+/* Grain force accumulation into per-thread grain-indexed buffers, reduced
+   once after the loop (as in FlowSolverLBM::AddGrainForces) */
+Tensor<dVector3,2> GrainForcesThreadLocal(const PhaseField& Phi)
+{
+    ThreadLocalAccumulator<Tensor<dVector3,2>> locGrainForces(
+            Tensor<dVector3,2>({Phi.FieldsProperties.size(),2}));
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0,)
+    {
+        if (Phi.Fields(i,j,k).interface())
+        for (auto it  = Phi.Fields(i,j,k).cbegin();
+                  it != Phi.Fields(i,j,k).cend(); ++it)
+        {
+            dVector3 Force;
+            dVector3 Torque;
+            GrainForceContribution(i,j,k,it->value,Force,Torque);
+            locGrainForces.Local()({it->index,0}) += Force;
+            locGrainForces.Local()({it->index,1}) += Torque;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return locGrainForces.SumElementwise();
+}
+
+double MaxRelativeDeviation(const Tensor<dVector3,2>& A, const Tensor<dVector3,2>& B)
+{
+    double deviation = 0.0;
+    for(size_t n = 0; n < A.size(); n++)
+    {
+        deviation = std::max(deviation, (A[n] - B[n]).abs()/std::max(A[n].abs(), 1.0));
+    }
+    return deviation;
+}
+
+/* Grain volumes as in PhaseField::ScanGrainsVolume(), accumulated per thread
+   in T, which is double or ReproducibleSum */
+template<class T>
+std::vector<double> GrainVolumes(const PhaseField& Phi)
+{
+    const size_t size = Phi.FieldsProperties.size();
+    ThreadLocalAccumulator<std::vector<T>> locVolume(std::vector<T>(size, T()));
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0,)
+    {
+        for (auto it  = Phi.Fields(i,j,k).cbegin();
+                  it != Phi.Fields(i,j,k).cend(); ++it)
+        {
+            locVolume.Local()[it->index] += it->value;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    const std::vector<T> Volume = locVolume.SumElementwise();
+    std::vector<double> result(size);
+    for(size_t idx = 0; idx < size; idx++)
+    {
+        result[idx] = double(Volume[idx]);
+    }
+    return result;
+}
+
+/* Global sum over the interface cells, a stand-in for the interface energy
+   and the residual norms of the conjugate gradient solvers */
+template<class T>
+double InterfaceSum(const PhaseField& Phi)
+{
+    ThreadLocalAccumulator<T> locSum((T()));
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0,)
+    {
+        if (Phi.Fields(i,j,k).interface())
+        for (auto it  = Phi.Fields(i,j,k).cbegin();
+                  it != Phi.Fields(i,j,k).cend(); ++it)
+        {
+            locSum.Local() += it->value*(1.0 - it->value)*(1.0 + 1.0e-3*i);
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return double(locSum.Sum());
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                    OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl              RTC(OPSettings);
+    BoundaryConditions          BC(OPSettings);
+    PhaseField                  Phi(OPSettings);
+
+    const size_t nGrains = 200;
+    Initializations::VoronoiTessellation(Phi, BC, nGrains, 0);
+
+    const int maxThreads = omp_get_max_threads();
+    const int nSweeps = 10;
+    bool passed = true;
+    double timeCriticalSerial = 0.0;
+    double timeLocalSerial = 0.0;
+
+    ConsoleOutput::WriteLineInsert("Phase-field overlap: omp critical vs. thread-local accumulation");
+    for(int nThreads = 1; nThreads <= maxThreads; nThreads *= 2)
+    {
+        omp_set_num_threads(nThreads);
+
+        myclock_t start = mygettime();
+        Matrix<int> Reference;
+        for(int n = 0; n < nSweeps; n++) Reference = OverlapCritical(Phi);
+        double timeCritical = double(mygettime() - start)/OP_CLOCKS_PER_SEC/nSweeps;
+
+        start = mygettime();
+        Matrix<int> Overlap;
+        for(int n = 0; n < nSweeps; n++) Overlap = Phi.GetPhaseFieldOverlap(0,0);
+        double timeLocal = double(mygettime() - start)/OP_CLOCKS_PER_SEC/nSweeps;
+
+        if(nThreads == 1)
+        {
+            timeCriticalSerial = timeCritical;
+            timeLocalSerial = timeLocal;
+        }
+        passed = Equal(Reference, Overlap) and passed;
+
+        ConsoleOutput::WriteStandard("Threads", nThreads);
+        ConsoleOutput::WriteStandard("omp critical [s/sweep]", timeCritical);
+        ConsoleOutput::WriteStandard("omp critical scaling", timeCriticalSerial/std::max(timeCritical, DBL_MIN));
+        ConsoleOutput::WriteStandard("Thread-local [s/sweep]", timeLocal);
+        ConsoleOutput::WriteStandard("Thread-local scaling", timeLocalSerial/std::max(timeLocal, DBL_MIN));
+        ConsoleOutput::WriteStandard("Speedup", timeCritical/std::max(timeLocal, DBL_MIN));
+        ConsoleOutput::WriteLine();
+    }
+    omp_set_num_threads(maxThreads);
+
+    if(not passed)
+    {
+        ConsoleOutput::WriteWarning("Thread-local and critical overlap counting produce different results", "OMPReductionScaling", "main()");
+        return EXIT_FAILURE;
+    }
+
+    // Grain force and torque accumulation of a particle-laden setup
+    const size_t nParticles = 2000;
+    PhaseField Particles(OPSettings);
+    Initializations::VoronoiTessellation(Particles, BC, nParticles, 0);
+
+    double maxDeviation = 0.0;
+    ConsoleOutput::WriteLineInsert("Grain forces: omp critical vs. thread-local accumulation");
+    ConsoleOutput::WriteStandard("Grains", Particles.FieldsProperties.size());
+    for(int nThreads = 1; nThreads <= maxThreads; nThreads *= 2)
+    {
+        omp_set_num_threads(nThreads);
+
+        myclock_t start = mygettime();
+        Tensor<dVector3,2> Reference;
+        for(int n = 0; n < nSweeps; n++) Reference = GrainForcesCritical(Particles);
+        double timeCritical = double(mygettime() - start)/OP_CLOCKS_PER_SEC/nSweeps;
+
+        start = mygettime();
+        Tensor<dVector3,2> GrainForces;
+        for(int n = 0; n < nSweeps; n++) GrainForces = GrainForcesThreadLocal(Particles);
+        double timeLocal = double(mygettime() - start)/OP_CLOCKS_PER_SEC/nSweeps;
+
+        if(nThreads == 1)
+        {
+            timeCriticalSerial = timeCritical;
+            timeLocalSerial = timeLocal;
+        }
+        maxDeviation = std::max(maxDeviation, MaxRelativeDeviation(Reference, GrainForces));
+
+        ConsoleOutput::WriteStandard("Threads", nThreads);
+        ConsoleOutput::WriteStandard("omp critical [s/sweep]", timeCritical);
+        ConsoleOutput::WriteStandard("omp critical scaling", timeCriticalSerial/std::max(timeCritical, DBL_MIN));
+        ConsoleOutput::WriteStandard("Thread-local [s/sweep]", timeLocal);
+        ConsoleOutput::WriteStandard("Thread-local scaling", timeLocalSerial/std::max(timeLocal, DBL_MIN));
+        ConsoleOutput::WriteStandard("Speedup", timeCritical/std::max(timeLocal, DBL_MIN));
+        ConsoleOutput::WriteLine();
+    }
+    omp_set_num_threads(maxThreads);
+
+    if(maxDeviation > 1.0e-10)
+    {
+        ConsoleOutput::WriteWarning("Thread-local and critical grain force accumulation produce different results", "OMPReductionScaling", "main()");
+        return EXIT_FAILURE;
+    }
+
+    // Overhead of the reproducible summation (DETERMINISTIC_REDUCTIONS)
+    std::vector<double> ReferenceVolumes;
+    double ReferenceSum = 0.0;
+    bool reproducible = true;
+    maxDeviation = 0.0;
+    ConsoleOutput::WriteLineInsert("Grain volumes and global sums: double vs. ReproducibleSum");
+    ConsoleOutput::WriteStandard("Grains", Particles.FieldsProperties.size());
+    for(int nThreads = 1; nThreads <= maxThreads; nThreads *= 2)
+    {
+        omp_set_num_threads(nThreads);
+
+        myclock_t start = mygettime();
+        std::vector<double> Volumes;
+        double Sum = 0.0;
+        for(int n = 0; n < nSweeps; n++)
+        {
+            Volumes = GrainVolumes<double>(Particles);
+            Sum = InterfaceSum<double>(Particles);
+        }
+        double timeDouble = double(mygettime() - start)/OP_CLOCKS_PER_SEC/nSweeps;
+
+        start = mygettime();
+        std::vector<double> ExactVolumes;
+        double ExactSum = 0.0;
+        for(int n = 0; n < nSweeps; n++)
+        {
+            ExactVolumes = GrainVolumes<ReproducibleSum>(Particles);
+            ExactSum = InterfaceSum<ReproducibleSum>(Particles);
+        }
+        double timeExact = double(mygettime() - start)/OP_CLOCKS_PER_SEC/nSweeps;
+
+        if(nThreads == 1)
+        {
+            ReferenceVolumes = ExactVolumes;
+            ReferenceSum = ExactSum;
+        }
+        // The reproducible results have to be bitwise identical for all thread counts
+        reproducible = ExactVolumes == ReferenceVolumes and ExactSum == ReferenceSum and reproducible;
+        maxDeviation = std::max(maxDeviation, std::abs(Sum - ExactSum)/std::max(std::abs(ExactSum), 1.0));
+        for(size_t idx = 0; idx < Volumes.size(); idx++)
+        {
+            maxDeviation = std::max(maxDeviation, std::abs(Volumes[idx] - ExactVolumes[idx])/std::max(ExactVolumes[idx], 1.0));
+        }
+
+        ConsoleOutput::WriteStandard("Threads", nThreads);
+        ConsoleOutput::WriteStandard("double [s/sweep]", timeDouble);
+        ConsoleOutput::WriteStandard("ReproducibleSum [s/sweep]", timeExact);
+        ConsoleOutput::WriteStandard("Overhead", timeExact/std::max(timeDouble, DBL_MIN));
+        ConsoleOutput::WriteLine();
+    }
+    omp_set_num_threads(maxThreads);
+
+    if(not reproducible)
+    {
+        ConsoleOutput::WriteWarning("ReproducibleSum results differ between thread counts", "OMPReductionScaling", "main()");
+        return EXIT_FAILURE;
+    }
+    if(maxDeviation > 1.0e-10)
+    {
+        ConsoleOutput::WriteWarning("ReproducibleSum and double summation produce different results", "OMPReductionScaling", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+#   This file is part of the OpenPhase (R) software library.
+#
+#  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+#                Universitaetsstrasse 150, D-44801 Bochum, Germany
+#            AND 2018-2025 OpenPhase Solutions GmbH,
+#                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Performance mode of the OpenPhase benchmarks.
+
+Runs each benchmark at several system sizes and thread counts in a scratch
+directory and collects the results in one JSON file:
+
+    {
+      "schema": "openphase-perf/1",
+      "date": ..., "host": {...}, "build": {"commit": ...},
+      "runs": [
+        {"case": "SingleGrain", "scale": 1.0, "grid": [51, 51, 51],
+         "cells": 132651, "threads": 4, "steps": 100, "status": "ok",
+         "wall_s": ..., "loop_s": ..., "loop_steps": 101,
+         "cell_updates_per_s": ...,
+         "peak_rss_bytes": ...,
+         "modules": {"Set IPs": {"calls": 101, "per_step_s": ...}, ...}},
+        ...
+      ]
+    }
+
+The grid size of each case is its ProjectInput.opi size scaled by --scales
+in every direction with more than one cell. The output to disk and screen is
+moved beyond the last time step. The module times are taken from the
+TimeInfo sections the benchmark writes to TextData/TimeInfo.json: loop_s is
+their sum, loop_steps the number of time loop passes (sections calls) and
+cell_updates_per_s = cells*loop_steps/loop_s. Without sections the wall time
+of the whole process and the requested steps are used. The peak memory is
+the maximum resident set size of the benchmark process.
+
+Usage (from the benchmarks directory of a Makefile build, or through the
+perf_benchmarks target of a cmake build with ENABLE_PERF_BENCHMARKS=ON):
+
+    ./PerfBenchmarks.py --scales 0.5,1 --threads 1,4 --output perf.json
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+# Benchmarks of the performance mode: time steps of a run and whether the
+# benchmark uses the OpenMP threads given in the input
+CASES = {
+    "SingleGrain":        {"steps": 100, "threaded": True},
+    "MultiJunction3D":    {"steps": 50,  "threaded": True},
+    "SolidificationAlCu": {"steps": 200, "threaded": True},
+    "EshelbyTest":        {"steps": 1,   "threaded": True},
+    "LinearSystemSolver": {"steps": 1,   "threaded": False},
+}
+
+INPUT_FILE = "ProjectInput.opi"
+TIMEINFO_FILE = os.path.join("TextData", "TimeInfo.json")
+
+
+def parse_list(text, kind):
+    return [kind(item) for item in text.split(",") if item]
+
+
+def set_parameter(text, key, value):
+    """Replaces the value of $key in the input file text"""
+    pattern = re.compile(r"^(\$" + re.escape(key) + r"\b[^:\n]*:\s*)(\S+)", re.M)
+    return pattern.subn(lambda m: m.group(1) + str(value), text, count=1)
+
+
+def get_parameter(text, key):
+    match = re.search(r"^\$" + re.escape(key) + r"\b[^:\n]*:\s*(\S+)", text, re.M)
+    return match.group(1) if match else None
+
+
+def prepare_input(text, scale, threads, steps):
+    """Input file of one run and its grid size"""
+    grid = []
+    for key in ("Nx", "Ny", "Nz"):
+        size = int(get_parameter(text, key) or 1)
+        if size > 1:
+            size = max(2, int(round(size*scale)))
+            text, _ = set_parameter(text, key, size)
+        grid.append(max(size, 1))
+    text, has_steps = set_parameter(text, "nSteps", steps)
+    for key in ("FTime", "STime", "tRstrt"):
+        text, _ = set_parameter(text, key, steps + 1)
+    text, _ = set_parameter(text, "nOMP", threads)
+    return text, grid, has_steps
+
+
+def find_executable(build_dir, case):
+    for candidate in (os.path.join(build_dir, case, case),
+                      os.path.join(build_dir, case, case + ".exe")):
+        if os.path.isfile(candidate) and os.access(candidate, os.X_OK):
+            return os.path.abspath(candidate)
+    return None
+
+
+def run_case(case, setup, scale, threads, args):
+    source = os.path.join(args.build_dir, case)
+    executable = find_executable(args.build_dir, case)
+    steps = args.steps if args.steps else setup["steps"]
+    run = {"case": case, "scale": scale, "threads": threads, "steps": steps}
+    if executable is None or not os.path.isfile(os.path.join(source, INPUT_FILE)):
+        run["status"] = "missing"
+        return run
+
+    workdir = os.path.join(args.work_dir, "%s_s%g_t%d" % (case, scale, threads))
+    shutil.rmtree(workdir, ignore_errors=True)
+    os.makedirs(workdir)
+    for name in os.listdir(source):
+        path = os.path.join(source, name)
+        if os.path.isfile(path) and os.path.abspath(path) != executable:
+            shutil.copy(path, workdir)
+
+    with open(os.path.join(source, INPUT_FILE)) as inp:
+        text, grid, has_steps = prepare_input(inp.read(), scale, threads, steps)
+    with open(os.path.join(workdir, INPUT_FILE), "w") as out:
+        out.write(text)
+    if not has_steps:
+        run["steps"] = steps = 1
+    run["grid"] = grid
+    run["cells"] = grid[0]*grid[1]*grid[2]
+
+    env = dict(os.environ, OMP_NUM_THREADS=str(threads))
+    with open(os.path.join(workdir, "stdout.log"), "w") as log:
+        start = time.perf_counter()
+        process = subprocess.Popen([executable], cwd=workdir, env=env,
+                                   stdout=log, stderr=subprocess.STDOUT)
+        _, status, usage = os.wait4(process.pid, 0)
+        process.returncode = os.waitstatus_to_exitcode(status)
+        run["wall_s"] = time.perf_counter() - start
+    # ru_maxrss is given in kilobytes on Linux and in bytes on macOS
+    run["peak_rss_bytes"] = usage.ru_maxrss*(1 if sys.platform == "darwin" else 1024)
+    run["status"] = "ok" if process.returncode == 0 else "failed (%d)" % process.returncode
+
+    timeinfo = os.path.join(workdir, TIMEINFO_FILE)
+    loop = run["wall_s"]
+    loop_steps = steps
+    if os.path.isfile(timeinfo):
+        with open(timeinfo) as inp:
+            entries = json.load(inp)["entries"]
+        sections = [entry for entry in entries if entry["kind"] == "section" and entry["calls"]]
+        run["modules"] = {entry["name"]: {"calls": entry["calls"],
+                                          "per_step_s": entry["total"]/entry["calls"]}
+                          for entry in sections}
+        if sections:
+            loop = sum(entry["total"] for entry in sections)
+            loop_steps = max(entry["calls"] for entry in sections)
+    run["loop_s"] = loop
+    run["loop_steps"] = loop_steps
+    run["cell_updates_per_s"] = run["cells"]*loop_steps/loop if loop > 0 else 0.0
+
+    if not args.keep:
+        shutil.rmtree(workdir, ignore_errors=True)
+    return run
+
+
+def git_commit(directory):
+    try:
+        return subprocess.check_output(["git", "rev-parse", "HEAD"], cwd=directory,
+                                       stderr=subprocess.DEVNULL, text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="Throughput mode of the OpenPhase benchmarks")
+    parser.add_argument("--build-dir", default=here,
+                        help="directory with the <Case>/<Case> executables and input files")
+    parser.add_argument("--cases", default=",".join(CASES),
+                        help="comma separated benchmarks (default: %(default)s)")
+    parser.add_argument("--scales", default="0.5,1",
+                        help="comma separated grid size factors (default: %(default)s)")
+    parser.add_argument("--threads", default="1,%d" % (os.cpu_count() or 1),
+                        help="comma separated OpenMP thread counts (default: %(default)s)")
+    parser.add_argument("--steps", type=int, default=0,
+                        help="time steps of every run (default: per benchmark)")
+    parser.add_argument("--work-dir", default=os.path.join(tempfile.gettempdir(), "OpenPhasePerfRuns"),
+                        help="scratch directory of the runs (default: %(default)s)")
+    parser.add_argument("--output", default="PerfBenchmarks.json",
+                        help="result file (default: %(default)s)")
+    parser.add_argument("--keep", action="store_true", help="keep the run directories")
+    args = parser.parse_args()
+
+    results = {
+        "schema": "openphase-perf/1",
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "host": {"name": platform.node(), "machine": platform.machine(),
+                 "processor": platform.processor(), "cpus": os.cpu_count()},
+        "build": {"commit": git_commit(here), "directory": os.path.abspath(args.build_dir)},
+        "runs": [],
+    }
+    for case in parse_list(args.cases, str):
+        if case not in CASES:
+            sys.exit("Unknown benchmark \"%s\", available: %s" % (case, ", ".join(CASES)))
+        setup = CASES[case]
+        threads_list = parse_list(args.threads, int) if setup["threaded"] else [1]
+        for scale in parse_list(args.scales, float):
+            for threads in threads_list:
+                run = run_case(case, setup, scale, threads, args)
+                results["runs"].append(run)
+                if run["status"] == "ok":
+                    print("%-20s scale %-5g threads %-3d %12.4e cell updates/s %10.1f MB"
+                          % (case, scale, threads, run["cell_updates_per_s"],
+                             run["peak_rss_bytes"]/2.0**20))
+                else:
+                    print("%-20s scale %-5g threads %-3d %s" % (case, scale, threads, run["status"]))
+
+    with open(args.output, "w") as out:
+        json.dump(results, out, indent=2)
+    print("Results written to %s" % args.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,151 @@
+#!/bin/bash
+#   This file is part of the OpenPhase (R) software library.
+#
+#  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+#                Universitaetsstrasse 150, D-44801 Bochum, Germany
+#            AND 2018-2025 OpenPhase Solutions GmbH,
+#                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Performance regression check of a benchmark, the speed counterpart of the
+# compare.sh scripts. The benchmark writes its metrics to
+# TextData/Performance.dat (TimeInfo::WritePerformance()), this script
+# compares them with the reference values in Performance.ref of the same
+# directory. The references are stored per hardware tag and per run
+# configuration (ranks, threads, cells), a run is only compared with the
+# references of its own configuration:
+#
+#   # tag  ranks threads cells  metric  reference  tolerance
+#   node42 1     8       132651 cell_updates_per_s 2.5e+07 0.15
+#
+# Metrics ending in _per_s are throughputs (higher is better), all others
+# are costs (lower is better). A deviation beyond the relative tolerance in
+# the bad direction fails the check (exit status 1), one in the good
+# direction is flagged as a hint to update the reference.
+#
+# Usage (in the benchmark directory after running the benchmark):
+#
+#   ../PerfCompare.sh                compare with the reference
+#   ../PerfCompare.sh --update       store the metrics of this run as reference
+#
+# Options: --tag TAG (default: $OP_PERF_TAG or the short host name),
+#          --tolerance REL (tolerance of new references, default: 0.15),
+#          a directory other than the current one as last argument.
+
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+NC='\033[0m' # No Color
+
+TAG=${OP_PERF_TAG:-$(hostname -s)}
+TOLERANCE=0.15
+UPDATE=0
+DIR=.
+METRICS="cell_updates_per_s steps_per_s peak_rss_mb"
+
+while [ $# -gt 0 ]
+do
+    case $1 in
+        --update)    UPDATE=1 ;;
+        --tag)       TAG=$2; shift ;;
+        --tolerance) TOLERANCE=$2; shift ;;
+        -h|--help)   sed -n '22,45p' "$0" | cut -c3-; exit 0 ;;
+        *)           DIR=$1 ;;
+    esac
+    shift
+done
+
+RESULTS=$DIR/TextData/Performance.dat
+REFERENCE=$DIR/Performance.ref
+LOG=$DIR/PerfCompare.log
+
+if [ ! -f "$RESULTS" ]
+then
+    echo -e "PERFORMANCE: ${RED}FAILED${NC} ($RESULTS not found, run the benchmark first)"
+    exit 1
+fi
+
+value() { awk -v key="$1" '$1 == key {print $2}' "$RESULTS"; }
+RANKS=$(value ranks)
+THREADS=$(value threads)
+CELLS=$(value cells)
+CONFIG="$TAG $RANKS $THREADS $CELLS"
+
+if [ $UPDATE -eq 1 ]
+then
+    # Keep the references of other tags and configurations and the tolerance
+    # of already stored metrics
+    touch "$REFERENCE"
+    awk -v config="$CONFIG" -v metrics="$METRICS" -v tol="$TOLERANCE" '
+        FNR == NR {values[$1] = $2; next}
+        /^#/ || NF < 7 {print; next}
+        $1" "$2" "$3" "$4 == config {tolerance[$5] = $7; next}
+        {print}
+        END {
+            n = split(metrics, names, " ")
+            for(i = 1; i <= n; i++)
+            if(names[i] in values)
+            {
+                t = (names[i] in tolerance) ? tolerance[names[i]] : tol
+                print config, names[i], values[names[i]], t
+            }
+        }' "$RESULTS" "$REFERENCE" > "$REFERENCE.new"
+    if ! grep -q '^#' "$REFERENCE.new"
+    then
+        { echo "# tag ranks threads cells metric reference tolerance"; cat "$REFERENCE.new"; } > "$REFERENCE.tmp"
+        mv "$REFERENCE.tmp" "$REFERENCE.new"
+    fi
+    mv "$REFERENCE.new" "$REFERENCE"
+    echo "PERFORMANCE: reference of \"$CONFIG\" stored in $REFERENCE"
+    exit 0
+fi
+
+if [ ! -f "$REFERENCE" ] || ! awk -v config="$CONFIG" '$1" "$2" "$3" "$4 == config {found = 1} END {exit !found}' "$REFERENCE"
+then
+    echo -e "PERFORMANCE: ${YELLOW}NO REFERENCE${NC} for tag, ranks, threads, cells \"$CONFIG\", store one with --update"
+    exit 0
+fi
+
+awk -v config="$CONFIG" '
+    FNR == NR {values[$1] = $2; next}
+    /^#/ || $1" "$2" "$3" "$4 != config {next}
+    {
+        metric = $5; ref = $6; tol = $7
+        if(!(metric in values)) {print metric, ref, "-", tol, "MISSING"; next}
+        x = values[metric]
+        ratio = (ref != 0) ? x/ref : 1.0
+        if(metric !~ /_per_s$/) ratio = (x != 0) ? ref/x : 1.0
+        if(ratio < 1.0 - tol) state = "REGRESSION"
+        else if(ratio > 1.0 + tol) state = "IMPROVED"
+        else state = "OK"
+        printf "%s %s %s %s %.3f %s\n", metric, ref, x, tol, ratio, state
+    }' "$RESULTS" "$REFERENCE" > "$LOG"
+
+if grep -q -E "REGRESSION|MISSING" "$LOG"
+then
+    echo -e "PERFORMANCE: ${RED}FAILED${NC}"
+    echo "PERFORMANCE: FAILED" >> "$LOG"
+    grep -E "REGRESSION|MISSING" "$LOG"
+    exit 1
+fi
+echo -e "PERFORMANCE: ${GREEN}OK${NC}"
+echo "PERFORMANCE: OK" >> "$LOG"
+if grep -q IMPROVED "$LOG"
+then
+    echo -e "${YELLOW}WARNING: ${NC}Better than the reference beyond the tolerance, consider --update:"
+    echo "WARNING: Better than the reference beyond the tolerance, consider --update:" >> "$LOG"
+    grep IMPROVED "$LOG"
+fi
+exit 0
@@ -0,0 +1,122 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "InterfaceProperties.h"
+#include "DoubleObstacle.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "DrivingForce.h"
+#include "Temperature.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Relaxes the phase fields from the time step RTC.StartTimeStep to
+RTC.MaxTimeStep, the checkpoints are written before the time steps they
+belong to, so that a restart continues with the same time step */
+void Relax(Settings& OPSettings, RunTimeControl& RTC, PhaseField& Phi,
+           const BoundaryConditions& BC, bool WriteCheckpoints)
+{
+    DoubleObstacle                  DO(OPSettings);
+    InterfaceProperties             IP(OPSettings);
+    DrivingForce                    DF(OPSettings);
+
+    for(RTC.TimeStep = RTC.StartTimeStep; RTC.TimeStep <= RTC.MaxTimeStep; RTC.IncrementTimeStep())
+    {
+        if(WriteCheckpoints and RTC.WriteRawData())
+        {
+            OPSettings.WriteAll(RTC.TimeStep);
+        }
+        DF.Clear();
+        IP.Set(Phi, BC);
+        DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+        Phi.NormalizeIncrements(BC, RTC.dt);
+        Phi.MergeIncrements(BC, RTC.dt);
+    }
+}
+
+/* Compares the phase fields of all cells bitwise, returns the number of
+differing cells */
+int Compare(const PhaseField& Reference, const PhaseField& Phi)
+{
+    int Differences = 0;
+    STORAGE_LOOP_BEGIN(i,j,k,Reference.Fields,0)
+    {
+        bool equal = Reference.Fields(i,j,k).size() == Phi.Fields(i,j,k).size();
+        for(auto it  = Reference.Fields(i,j,k).cbegin();
+                 it != Reference.Fields(i,j,k).cend(); ++it)
+        {
+            equal = equal and Phi.Fields(i,j,k).get_value(it->index) == it->value;
+        }
+        if(not equal) Differences++;
+    }
+    STORAGE_LOOP_END
+    return Differences;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    int Failed = 0;
+    auto Check = [&](const bool Condition, const std::string& What)
+    {
+        if(not Condition)
+        {
+            ConsoleOutput::WriteWarning(What, "RestoreCheckpoint", "main()");
+            Failed++;
+        }
+    };
+
+    /* Continuous run of a relaxing triple junction, writing checkpoints */
+    Settings                        OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl                  RTC(OPSettings);
+    PhaseField                      Phi(OPSettings);
+    BoundaryConditions              BC(OPSettings);
+    Temperature                     Tx(OPSettings);
+
+    Check(not RTC.RestoreCheckpoint(OPSettings, BC), "Restored without the restart switch");
+
+    Initializations::Young3(Phi, 0, 1, 2, 3, BC);
+    Tx.SetInitial(BC);
+    Relax(OPSettings, RTC, Phi, BC, true);
+
+    /* Restart from the checkpoint in the middle of the run into fresh objects */
+    Settings                        RestartSettings;
+    RestartSettings.ReadInput();
+
+    RunTimeControl                  RestartRTC(RestartSettings);
+    PhaseField                      RestartPhi(RestartSettings);
+    BoundaryConditions              RestartBC(RestartSettings);
+    Temperature                     RestartTx(RestartSettings);
+
+    RestartRTC.RestartSwitch = true;
+    RestartRTC.StartTimeStep = RTC.CheckpointInterval;
+    Check(RestartRTC.StartTimeStep < RestartRTC.MaxTimeStep, "Checkpoint interval has to be shorter than the run");
+    Check(RestartRTC.RestoreCheckpoint(RestartSettings, RestartBC), "Checkpoint was not restored");
+    Relax(RestartSettings, RestartRTC, RestartPhi, RestartBC, false);
+
+    /* The continued run has to reproduce the continuous one */
+    const int Differences = Compare(Phi, RestartPhi);
+    Check(Differences == 0, "Restarted phase fields differ from the continuous run");
+    Check(RestartPhi.FieldsProperties.size() == Phi.FieldsProperties.size(), "Number of grains differs");
+
+    int TemperatureDifferences = 0;
+    STORAGE_LOOP_BEGIN(i,j,k,Tx.Tx,0)
+    {
+        if(RestartTx.Tx(i,j,k) != Tx.Tx(i,j,k)) TemperatureDifferences++;
+    }
+    STORAGE_LOOP_END
+    Check(TemperatureDifferences == 0, "Restored temperature differs");
+
+    ConsoleOutput::WriteLineInsert("Restore checkpoint");
+    ConsoleOutput::WriteStandard("Restart time step", RestartRTC.StartTimeStep);
+    ConsoleOutput::WriteStandard("Last time step", RestartRTC.MaxTimeStep);
+    ConsoleOutput::WriteStandard("Differing phase field cells", Differences);
+    ConsoleOutput::WriteStandard("Differing temperature cells", TemperatureDifferences);
+    ConsoleOutput::WriteStandard("Failed checks", Failed);
+    ConsoleOutput::WriteLine();
+
+    return (Failed == 0) ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,278 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "DoubleObstacle.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "InterfaceProperties.h"
+#include "DrivingForce.h"
+#include "FileInterface.h"
+#include "Tools/TimeInfo.h"
+#ifdef MPI_PARALLEL
+#include "FFTWPlanner.h"
+#include "PencilFFT.h"
+#include "fftw3.h"
+#endif
+
+using namespace std;
+using namespace openphase;
+
+/* Work of one rank: position in the MPI Cartesian grid, local domain and the
+   time spent in the time loop */
+enum WorkEntries {CartX, CartY, CartZ, OffsetX, OffsetY, OffsetZ, SizeX, SizeY, SizeZ,
+                  InterfaceCells, LoopTime, Nentries};
+
+/* Collects the work of all ranks on every rank, prints it on rank 0 and writes
+   it to FileName as JSON */
+void ReportWorkDistribution(const array<double,Nentries>& Local, const string FileName)
+{
+    int Nranks = 1;
+    int Rank = 0;
+    string Decomposition = "none";
+    vector<double> All(Local.begin(), Local.end());
+#ifdef MPI_PARALLEL
+    Nranks = MPI_SIZE;
+    Decomposition = (MPI_3D_DECOMPOSITION) ? "3D" : "1D";
+    Rank = MPI_RANK;
+    All.resize(Nranks*Nentries);
+    OP_MPI_Allgather(Local.data(), Nentries, OP_MPI_DOUBLE,
+                     All.data(), Nentries, OP_MPI_DOUBLE, OP_MPI_COMM_WORLD);
+#endif
+    if(Rank != 0) return;
+
+    double CellsMax = 0.0;
+    double CellsSum = 0.0;
+    double InterfaceMax = 0.0;
+    double InterfaceSum = 0.0;
+    double TimeMax = 0.0;
+    double TimeSum = 0.0;
+    ConsoleOutput::WriteLine("=");
+    ConsoleOutput::WriteSimple("Work distribution: rank (cart) offset size cells interface cells loop time [s]");
+    ConsoleOutput::WriteLine("-");
+    for(int r = 0; r < Nranks; r++)
+    {
+        const double* W = All.data() + r*Nentries;
+        const double Cells = W[SizeX]*W[SizeY]*W[SizeZ];
+        CellsMax = max(CellsMax, Cells);
+        CellsSum += Cells;
+        InterfaceMax = max(InterfaceMax, W[InterfaceCells]);
+        InterfaceSum += W[InterfaceCells];
+        TimeMax = max(TimeMax, W[LoopTime]);
+        TimeSum += W[LoopTime];
+
+        stringstream line;
+        line << setw(5) << r << " (" << W[CartX] << "," << W[CartY] << "," << W[CartZ] << ") "
+             << W[OffsetX] << "," << W[OffsetY] << "," << W[OffsetZ] << " "
+             << W[SizeX] << "x" << W[SizeY] << "x" << W[SizeZ] << " "
+             << Cells << " " << W[InterfaceCells] << " " << W[LoopTime];
+        ConsoleOutput::WriteSimple(line.str());
+    }
+    ConsoleOutput::WriteLine("-");
+    /* Imbalance: maximum over the ranks divided by the mean, 1 is perfectly
+       balanced */
+    ConsoleOutput::WriteStandard("Cells imbalance", CellsMax*Nranks/max(CellsSum, 1.0));
+    ConsoleOutput::WriteStandard("Interface cells imbalance", InterfaceMax*Nranks/max(InterfaceSum, 1.0));
+    ConsoleOutput::WriteStandard("Loop time imbalance", TimeMax*Nranks/max(TimeSum, DBL_MIN));
+    ConsoleOutput::WriteLine("=");
+
+    ofstream out(FileName);
+    if(!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be created", "ScalingNormalGG", "ReportWorkDistribution()");
+        return;
+    }
+    out << setprecision(9);
+    out << "{\n  \"ranks\": " << Nranks << ",\n  \"threads\": " << omp_get_max_threads()
+        << ",\n  \"decomposition\": \"" << Decomposition << "\""
+        << ",\n  \"work\": [";
+    for(int r = 0; r < Nranks; r++)
+    {
+        const double* W = All.data() + r*Nentries;
+        out << ((r) ? ",\n" : "\n")
+            << "    {\"rank\": " << r
+            << ", \"cart\": [" << W[CartX] << ", " << W[CartY] << ", " << W[CartZ] << "]"
+            << ", \"offset\": [" << W[OffsetX] << ", " << W[OffsetY] << ", " << W[OffsetZ] << "]"
+            << ", \"size\": [" << W[SizeX] << ", " << W[SizeY] << ", " << W[SizeZ] << "]"
+            << ", \"cells\": " << W[SizeX]*W[SizeY]*W[SizeZ]
+            << ", \"interface_cells\": " << W[InterfaceCells]
+            << ", \"loop_s\": " << W[LoopTime] << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+#ifdef MPI_PARALLEL
+    int provided = 0;
+    OP_MPI_Init_thread(&argc, &argv, OP_MPI_THREAD_FUNNELED, &provided);
+    OP_MPI_Comm_rank(OP_MPI_COMM_WORLD, &MPI_RANK);
+    OP_MPI_Comm_size(OP_MPI_COMM_WORLD, &MPI_SIZE);
+    {
+#endif
+    string InputFileName = DefaultInputFileName;
+    if(argc > 1) InputFileName = argv[1];
+
+    Settings                    OPSettings;
+    OPSettings.ReadInput(InputFileName);
+
+    RunTimeControl              RTC(OPSettings, InputFileName);
+    PhaseField                  Phi(OPSettings, InputFileName);
+    DoubleObstacle              DO(OPSettings, InputFileName);
+    InterfaceProperties         IP(OPSettings, InputFileName);
+    BoundaryConditions          BC(OPSettings, InputFileName);
+    DrivingForce                dG(OPSettings, InputFileName);
+    TimeInfo                    Timer(OPSettings, "Execution Time Statistics");
+
+    fstream inpF(InputFileName, ios::in);
+    stringstream inp;
+    inp << inpF.rdbuf();
+    inpF.close();
+    const int    moduleLocation = FileInterface::FindModuleLocation(inp, "ScalingNormalGG");
+    const double CellsPerGrain  = FileInterface::ReadParameterD(inp, moduleLocation, string("CellsPerGrain"));
+    const int    nFFTComponents = FileInterface::ReadParameterI(inp, moduleLocation, string("nFFTComponents"), false, 0);
+
+    const GridParameters& Grid = OPSettings.Grid;
+    const size_t nGrains = max(1.0, double(Grid.TotalNx)*Grid.TotalNy*Grid.TotalNz/CellsPerGrain);
+    Initializations::VoronoiTessellation(Phi, BC, nGrains, 0);
+
+    /* The distributed transforms of the spectral solvers are timed on the
+       bricks of the MPI 3D decomposition, the data is the phase-field
+       maximum of each cell */
+    bool FFTEnabled = false;
+#ifdef MPI_PARALLEL
+    GridParameters FFTGrid = Grid;
+    FFTGrid.Nz2 = FFTGrid.Nz/2 + 1;
+    PencilFFT Transforms;
+    double* FFTData = nullptr;
+    size_t FFTSize = 0;
+    if(nFFTComponents > 0 and MPI_3D_DECOMPOSITION)
+    {
+        FFTSize = PencilFFT::LocalSize(FFTGrid);
+        FFTData = (double *)fftw_malloc(sizeof(double)*FFTSize*nFFTComponents);
+        Transforms.Initialize(FFTGrid, nFFTComponents, FFTData, FFTWPlanner::Flags());
+        FFTEnabled = true;
+    }
+#endif
+    if(nFFTComponents > 0 and !FFTEnabled)
+    {
+        ConsoleOutput::WriteWarning("The distributed transforms require the MPI 3D decomposition and are skipped",
+                                    "ScalingNormalGG", "main()");
+    }
+
+    ConsoleOutput::WriteStandard("Grains", nGrains);
+    cout << "Entering the Time Loop!!!" << endl;
+
+    const myclock_t LoopStart = mygettime();
+    for(RTC.tStep = RTC.tStart; RTC.tStep <= RTC.nSteps; RTC.IncrementTimeStep())
+    {
+        Timer.SetStart();
+        IP.Set(Phi, BC);
+        Timer.SetTimeStamp("Set IPs");
+        dG.Clear();
+        DO.CalculateCurvatureDrivingForce(Phi, IP, dG);
+        dG.Average(Phi, BC);
+        Timer.SetTimeStamp("Curvature driving force");
+        DO.CalculatePhaseFieldIncrements(Phi, IP, dG);
+        Timer.SetTimeStamp("Phase-field increments");
+        Phi.NormalizeIncrements(BC, RTC.dt);
+        Timer.SetTimeStamp("Normalize increments");
+        Phi.MergeIncrements(BC, RTC.dt);
+        Timer.SetTimeStamp("Merge increments");
+
+#ifdef MPI_PARALLEL
+        if(FFTEnabled)
+        {
+            TimeInfo::Region Guard("Spectral transforms");
+            for(int n = 0; n < nFFTComponents; n++)
+            {
+                double* Component = FFTData + n*FFTSize;
+                OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0,)
+                {
+                    Component[k + 2*FFTGrid.Nz2*(j + FFTGrid.Ny*i)] = Phi.Fields(i,j,k).get_max().value;
+                }
+                OMP_PARALLEL_STORAGE_LOOP_END
+            }
+            Transforms.Forward();
+            Transforms.Backward();
+        }
+        Timer.SetTimeStamp("Spectral transforms");
+#endif
+
+        if (RTC.WriteToScreen())
+        {
+            const double I_En = DO.AverageEnergyDensity(Phi, IP);
+            const string message = ConsoleOutput::GetStandard("Interface energy density [J/m^3]", I_En);
+            ConsoleOutput::WriteTimeStep(RTC, message);
+            Timer.WriteLoadImbalance(OPSettings.TextDir + "LoadImbalance.dat", RTC.tStep);
+        }
+        Timer.SetTimeStamp("Output to screen");
+    } //end of time loop
+
+    array<double,Nentries> Work{};
+    Work[LoopTime] = double(mygettime() - LoopStart)/OP_CLOCKS_PER_SEC;
+    Work[OffsetX]  = Grid.OffsetX;
+    Work[OffsetY]  = Grid.OffsetY;
+    Work[OffsetZ]  = Grid.OffsetZ;
+    Work[SizeX]    = Grid.Nx;
+    Work[SizeY]    = Grid.Ny;
+    Work[SizeZ]    = Grid.Nz;
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
+    {
+        Work[CartX] = MPI_CART_RANK[0];
+        Work[CartY] = MPI_CART_RANK[1];
+        Work[CartZ] = MPI_CART_RANK[2];
+    }
+    else
+    {
+        Work[CartX] = MPI_RANK;
+    }
+#endif
+    double nInterface = 0.0;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0,reduction(+:nInterface))
+    {
+        if(Phi.Fields(i,j,k).interface()) nInterface += 1.0;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    Work[InterfaceCells] = nInterface;
+
+    Timer.PrintFullSummary();
+    Timer.WriteJSON(OPSettings.TextDir + "TimeInfo.json");
+    Timer.WritePerformance(OPSettings.TextDir + "Performance.dat", OPSettings.Grid.TotalNumberOfCells());
+    ReportWorkDistribution(Work, OPSettings.TextDir + "WorkDistribution.json");
+
+#ifdef MPI_PARALLEL
+    if(FFTEnabled)
+    {
+        Transforms.Free();
+        fftw_free(FFTData);
+    }
+    }
+    OP_MPI_Finalize();
+#endif
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,338 @@
+#!/usr/bin/env python3
+#   This file is part of the OpenPhase (R) software library.
+#
+#  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+#                Universitaetsstrasse 150, D-44801 Bochum, Germany
+#            AND 2018-2025 OpenPhase Solutions GmbH,
+#                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""MPI + OpenMP scaling study of OpenPhase.
+
+Runs the ScalingNormalGG benchmark (normal grain growth) over a matrix of MPI
+ranks and OpenMP threads and prints the parallel efficiency tables:
+
+  strong  the global grid (--size) is fixed, the efficiency of P = ranks*threads
+          cores is T0*P0/(T*P) relative to the smallest run
+  weak    --size is the grid of one rank, the global grid grows with the
+          ranks, the efficiency is T0/T relative to the smallest number of
+          ranks with the same number of threads
+
+T is the time loop wall time of the slowest rank. With the default 3D
+decomposition the ranks are factorized into the most cubic Ncx x Ncy x Ncz
+grid ($MPI3D of @GridParameters), in weak mode each rank holds a --size
+brick. With --decomposition 1d the grid is split along X only.
+
+Every run writes TextData/TimeInfo.json (TimeInfo sections, regions and the
+halo exchange and FFT transpose communication, see Tools/TimeInfo.h) and
+TextData/WorkDistribution.json (local domain, interface cells and loop time
+of each rank), which are collected in one JSON file:
+
+    {
+      "schema": "openphase-scaling/1", "mode": "weak", "size": [64, 64, 64],
+      "runs": [
+        {"ranks": 8, "threads": 2, "cart": [2, 2, 2], "grid": [128, 128, 128],
+         "status": "ok", "wall_s": ..., "loop_s": ..., "efficiency": ...,
+         "halo_s": ..., "halo_bytes": ..., "fft_s": ..., "fft_bytes": ...,
+         "sections": {...}, "regions": {...}, "communication": {...},
+         "imbalance": {"cells": ..., "interface_cells": ..., "loop": ...},
+         "work": [...]},
+        ...
+      ]
+    }
+
+The communication times are the maximum over the ranks, the bytes the sum.
+
+Usage (from the benchmarks directory of an MPI build, or through the
+scaling_study target of a cmake build with ENABLE_PERF_BENCHMARKS=ON):
+
+    ./ScalingStudy.py --mode weak --size 64 --ranks 1,2,4,8 --threads 1,4
+    ./ScalingStudy.py --mode strong --size 256 --ranks 1,8,64 --threads 1,8 \\
+        --launcher "srun -n {ranks} -c {threads}"
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+CASE = "ScalingNormalGG"
+INPUT_FILE = "ProjectInput.opi"
+TIMEINFO_FILE = os.path.join("TextData", "TimeInfo.json")
+WORK_FILE = os.path.join("TextData", "WorkDistribution.json")
+
+
+def parse_list(text, kind):
+    return [kind(item) for item in text.split(",") if item]
+
+
+def parse_size(text):
+    size = parse_list(text, int)
+    if len(size) == 1:
+        size *= 3
+    if len(size) != 3 or min(size) < 1:
+        sys.exit("--size takes one or three positive integers, got \"%s\"" % text)
+    return size
+
+
+def set_parameter(text, key, value):
+    """Replaces the value of $key in the input file text"""
+    pattern = re.compile(r"^(\$" + re.escape(key) + r"\b[^:\n]*:\s*)(\S+)", re.M)
+    text, count = pattern.subn(lambda m: m.group(1) + str(value), text, count=1)
+    if count == 0:
+        sys.exit("Parameter $%s not found in %s" % (key, INPUT_FILE))
+    return text
+
+
+def cartesian_grid(ranks, size):
+    """Factorization of ranks into Ncx*Ncy*Ncz with the smallest block
+    surface for the grid size, the most cubic blocks"""
+    best = None
+    for ncx in range(1, ranks + 1):
+        if ranks % ncx:
+            continue
+        for ncy in range(1, ranks//ncx + 1):
+            if (ranks//ncx) % ncy:
+                continue
+            ncz = ranks//(ncx*ncy)
+            block = [size[0]/ncx, size[1]/ncy, size[2]/ncz]
+            surface = block[0]*block[1] + block[1]*block[2] + block[0]*block[2]
+            if best is None or surface < best[0] - 1e-9:
+                best = (surface, [ncx, ncy, ncz])
+    return best[1]
+
+
+def decompose(mode, decomposition, ranks, size):
+    """MPI block grid and global grid size of a run"""
+    if decomposition == "1d":
+        cart = [ranks, 1, 1]
+    elif mode == "weak":
+        cart = cartesian_grid(ranks, [1, 1, 1])
+    else:
+        cart = cartesian_grid(ranks, size)
+    if mode == "weak":
+        grid = [size[d]*cart[d] for d in range(3)]
+    else:
+        grid = list(size)
+    return cart, grid
+
+
+def prepare_input(text, grid, cart, decomposition, threads, steps):
+    for key, value in zip(("Nx", "Ny", "Nz"), grid):
+        text = set_parameter(text, key, value)
+    text = set_parameter(text, "MPI3D", "Yes" if decomposition == "3d" else "No")
+    for key, value in zip(("Ncx", "Ncy", "Ncz"), cart):
+        text = set_parameter(text, key, value if decomposition == "3d" else 1)
+    text = set_parameter(text, "nSteps", steps)
+    text = set_parameter(text, "STime", steps)
+    for key in ("FTime", "tRstrt"):
+        text = set_parameter(text, key, steps + 1)
+    return set_parameter(text, "nOMP", threads)
+
+
+def find_executable(build_dir):
+    for candidate in (os.path.join(build_dir, CASE, CASE),
+                      os.path.join(build_dir, CASE, CASE + ".exe")):
+        if os.path.isfile(candidate) and os.access(candidate, os.X_OK):
+            return os.path.abspath(candidate)
+    return None
+
+
+def collect(run, workdir):
+    """Adds the TimeInfo entries and the work distribution of a run"""
+    timeinfo = os.path.join(workdir, TIMEINFO_FILE)
+    if os.path.isfile(timeinfo):
+        with open(timeinfo) as inp:
+            entries = json.load(inp)["entries"]
+        for kind, key in (("section", "sections"), ("region", "regions"),
+                          ("communication", "communication")):
+            run[key] = {entry["name"]: {"calls": entry["calls"],
+                                        "rank_min_s": entry["rank_min"],
+                                        "rank_mean_s": entry["rank_mean"],
+                                        "rank_max_s": entry["rank_max"],
+                                        "bytes": entry.get("bytes", 0)}
+                        for entry in entries if entry["kind"] == kind}
+        for prefix, key in (("Halo exchange", "halo"), ("FFT", "fft")):
+            selected = [entry for name, entry in run["communication"].items()
+                        if name.startswith(prefix)]
+            run[key + "_s"] = sum(entry["rank_max_s"] for entry in selected)
+            run[key + "_bytes"] = sum(entry["bytes"] for entry in selected)
+
+    work = os.path.join(workdir, WORK_FILE)
+    if os.path.isfile(work):
+        with open(work) as inp:
+            ranks = json.load(inp)["work"]
+        run["work"] = ranks
+        loops = [rank["loop_s"] for rank in ranks]
+        run["loop_s"] = max(loops)
+        run["imbalance"] = {}
+        for key, name in (("cells", "cells"), ("interface_cells", "interface_cells"),
+                          ("loop", "loop_s")):
+            values = [rank[name] for rank in ranks]
+            mean = sum(values)/len(values)
+            run["imbalance"][key] = max(values)/mean if mean > 0 else 1.0
+
+
+def run_case(ranks, threads, args, size, executable):
+    cart, grid = decompose(args.mode, args.decomposition, ranks, size)
+    run = {"ranks": ranks, "threads": threads, "cores": ranks*threads,
+           "cart": cart, "grid": grid, "cells": grid[0]*grid[1]*grid[2]}
+    if args.decomposition == "3d" and any(grid[d] < 2*cart[d] for d in range(3)):
+        run["status"] = "too small"
+        return run
+
+    source = os.path.join(args.build_dir, CASE)
+    workdir = os.path.join(args.work_dir, "%s_%s_r%d_t%d" % (CASE, args.mode, ranks, threads))
+    shutil.rmtree(workdir, ignore_errors=True)
+    os.makedirs(workdir)
+    with open(os.path.join(source, INPUT_FILE)) as inp:
+        text = prepare_input(inp.read(), grid, cart, args.decomposition, threads, args.steps)
+    with open(os.path.join(workdir, INPUT_FILE), "w") as out:
+        out.write(text)
+
+    command = shlex.split(args.launcher.format(ranks=ranks, threads=threads)) + [executable]
+    env = dict(os.environ, OMP_NUM_THREADS=str(threads))
+    with open(os.path.join(workdir, "stdout.log"), "w") as log:
+        start = time.perf_counter()
+        returncode = subprocess.call(command, cwd=workdir, env=env,
+                                     stdout=log, stderr=subprocess.STDOUT)
+        run["wall_s"] = time.perf_counter() - start
+    run["status"] = "ok" if returncode == 0 else "failed (%d)" % returncode
+    if returncode == 0:
+        collect(run, workdir)
+        run.setdefault("loop_s", run["wall_s"])
+    if not args.keep:
+        shutil.rmtree(workdir, ignore_errors=True)
+    return run
+
+
+def add_efficiencies(runs, mode):
+    ok = [run for run in runs if run["status"] == "ok"]
+    if mode == "strong":
+        if ok:
+            base = min(ok, key=lambda run: (run["cores"], run["loop_s"]))
+            for run in ok:
+                run["speedup"] = base["loop_s"]/run["loop_s"]
+                run["efficiency"] = base["loop_s"]*base["cores"]/(run["loop_s"]*run["cores"])
+    else:
+        for threads in sorted(set(run["threads"] for run in ok)):
+            column = [run for run in ok if run["threads"] == threads]
+            base = min(column, key=lambda run: run["ranks"])
+            for run in column:
+                run["efficiency"] = base["loop_s"]/run["loop_s"]
+
+
+def print_table(title, runs, ranks_list, threads_list, value, fmt):
+    print("\n" + title)
+    print("%8s" % "ranks" + "".join("%12s" % ("%d thr" % t) for t in threads_list))
+    for ranks in ranks_list:
+        line = "%8d" % ranks
+        for threads in threads_list:
+            run = next((r for r in runs if r["ranks"] == ranks and r["threads"] == threads), None)
+            if run is None or run["status"] != "ok":
+                line += "%12s" % ("-" if run is None else run["status"][:11])
+            else:
+                result = value(run)
+                line += "%12s" % ("n/a" if result is None else fmt % result)
+        print(line)
+
+
+def git_commit(directory):
+    try:
+        return subprocess.check_output(["git", "rev-parse", "HEAD"], cwd=directory,
+                                       stderr=subprocess.DEVNULL, text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="MPI + OpenMP scaling study of OpenPhase")
+    parser.add_argument("--build-dir", default=here,
+                        help="directory with %s/%s and its input file" % (CASE, CASE))
+    parser.add_argument("--mode", choices=("weak", "strong"), default="weak",
+                        help="weak: --size per rank, strong: global --size (default: %(default)s)")
+    parser.add_argument("--size", default="64",
+                        help="grid size N or Nx,Ny,Nz (default: %(default)s)")
+    parser.add_argument("--ranks", default="1,2,4,8",
+                        help="comma separated MPI rank counts (default: %(default)s)")
+    parser.add_argument("--threads", default="1",
+                        help="comma separated OpenMP thread counts (default: %(default)s)")
+    parser.add_argument("--decomposition", choices=("3d", "1d"), default="3d",
+                        help="MPI domain decomposition (default: %(default)s)")
+    parser.add_argument("--launcher", default="mpirun -np {ranks}",
+                        help="MPI launcher, {ranks} and {threads} are replaced (default: %(default)s)")
+    parser.add_argument("--steps", type=int, default=20,
+                        help="time steps of every run (default: %(default)s)")
+    parser.add_argument("--work-dir", default=os.path.join(tempfile.gettempdir(), "OpenPhaseScalingRuns"),
+                        help="scratch directory of the runs (default: %(default)s)")
+    parser.add_argument("--output", default="ScalingStudy.json",
+                        help="result file (default: %(default)s)")
+    parser.add_argument("--keep", action="store_true", help="keep the run directories")
+    args = parser.parse_args()
+
+    size = parse_size(args.size)
+    ranks_list = parse_list(args.ranks, int)
+    threads_list = parse_list(args.threads, int)
+    executable = find_executable(args.build_dir)
+    if executable is None or not os.path.isfile(os.path.join(args.build_dir, CASE, INPUT_FILE)):
+        sys.exit("%s not found in %s, build it first" % (CASE, os.path.abspath(args.build_dir)))
+
+    results = {
+        "schema": "openphase-scaling/1",
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "host": {"name": platform.node(), "machine": platform.machine(),
+                 "processor": platform.processor(), "cpus": os.cpu_count()},
+        "build": {"commit": git_commit(here), "directory": os.path.abspath(args.build_dir)},
+        "mode": args.mode, "size": size, "decomposition": args.decomposition,
+        "steps": args.steps, "launcher": args.launcher,
+        "runs": [],
+    }
+    for ranks in ranks_list:
+        for threads in threads_list:
+            run = run_case(ranks, threads, args, size, executable)
+            results["runs"].append(run)
+            print("ranks %-4d threads %-3d grid %-16s %s" % (ranks, threads,
+                  "x".join(str(n) for n in run["grid"]),
+                  "%.4e s" % run["loop_s"] if run["status"] == "ok" else run["status"]))
+    add_efficiencies(results["runs"], args.mode)
+
+    runs = results["runs"]
+    print_table("Time loop wall time, slowest rank [s]", runs, ranks_list, threads_list,
+                lambda run: run["loop_s"], "%.4e")
+    print_table("Parallel efficiency (%s scaling)" % args.mode, runs, ranks_list, threads_list,
+                lambda run: run.get("efficiency"), "%.3f")
+    print_table("Halo exchange share of the time loop", runs, ranks_list, threads_list,
+                lambda run: run["halo_s"]/run["loop_s"] if "halo_s" in run else None, "%.3f")
+    print_table("FFT transpose share of the time loop", runs, ranks_list, threads_list,
+                lambda run: run["fft_s"]/run["loop_s"] if "fft_s" in run else None, "%.3f")
+    print_table("Load imbalance, interface cells max/mean", runs, ranks_list, threads_list,
+                lambda run: run["imbalance"]["interface_cells"] if "imbalance" in run else None, "%.3f")
+
+    with open(args.output, "w") as out:
+        json.dump(results, out, indent=2)
+    print("\nResults written to %s" % args.output)
+
+
+if __name__ == "__main__":
+    main()
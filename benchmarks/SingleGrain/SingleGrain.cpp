@@ -23,6 +23,7 @@ int main()
     InterfaceProperties         IP(OPSettings);
     BoundaryConditions          BC(OPSettings);
     DrivingForce                DF(OPSettings);
+    TimeInfo                    Timer(OPSettings, "Execution Time Statistics");
 
     // Initialize phase-fields
     Initializations::Single(Phi, 0, BC);
@@ -45,11 +46,17 @@ int main()
 
     for(RTC.tStep = RTC.tStart; RTC.tStep <= RTC.nSteps; RTC.IncrementTimeStep())
     {
+        Timer.SetStart();
         DF.Clear();
+        Timer.SetTimeStamp("Clear driving forces");
         IP.Set(Phi, BC);
+        Timer.SetTimeStamp("Set IPs");
         DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+        Timer.SetTimeStamp("Phase-field increments");
         Phi.NormalizeIncrements(BC, RTC.dt);
+        Timer.SetTimeStamp("Normalize increments");
         Phi.MergeIncrements(BC, RTC.dt);
+        Timer.SetTimeStamp("Merge increments");
 
         if (RTC.WriteVTK())
         {
@@ -74,6 +81,7 @@ int main()
                                                                         RTC.dt/dx/dx));};
             CSVParser::WriteData("R_2_graph.dat", datat);
         }
+        Timer.SetTimeStamp("Write VTK files");
 
         if (RTC.WriteToScreen())
         {
@@ -81,7 +89,11 @@ int main()
             std::string message  = ConsoleOutput::GetStandard("Interface energy density", I_En);
                         message += ConsoleOutput::GetStandard("Interface energy", DO.Energy(Phi, IP));
             ConsoleOutput::WriteTimeStep(RTC.tStep, RTC.nSteps, message);
+            if(NodeMemoryPool::Enabled()) NodeMemoryPool::PrintStatistics(RTC.tStep);
         }
+        Timer.SetTimeStamp("Output to screen");
     }
+    Timer.WriteJSON(OPSettings.TextDir + "TimeInfo.json");
+    Timer.WritePerformance(OPSettings.TextDir + "Performance.dat", OPSettings.Grid.TotalNumberOfCells());
     return 0;
 }
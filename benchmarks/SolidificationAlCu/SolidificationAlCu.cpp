@@ -256,6 +256,8 @@ int main(int argc, char *argv[])
             Timer.PrintWallClockSummary();
         }
     } //end time loop
+    Timer.WriteJSON(OPSettings.TextDir + "TimeInfo.json");
+    Timer.WritePerformance(OPSettings.TextDir + "Performance.dat", OPSettings.Grid.TotalNumberOfCells());
 #ifdef MPI_PARALLEL
     }
     OP_MPI_Finalize();
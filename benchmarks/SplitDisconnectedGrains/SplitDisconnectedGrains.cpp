@@ -0,0 +1,191 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "InterfaceProperties.h"
+#include "DoubleObstacle.h"
+#include "PhaseField.h"
+#include "BoundaryConditions.h"
+#include "DrivingForce.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Sets the cells of the box [x0,x1) x [z0,z1) to the phase field "index", the
+box is wrapped around the periodic boundaries */
+void Box(PhaseField& Phi, const size_t index,
+         const long int x0, const long int x1, const long int z0, const long int z1)
+{
+    for(long int x = x0; x < x1; x++)
+    for(long int z = z0; z < z1; z++)
+    {
+        const long int i = (x + Phi.Grid.Nx)%Phi.Grid.Nx;
+        const long int k = (z + Phi.Grid.Nz)%Phi.Grid.Nz;
+        Phi.Fields(i,0,k).clear();
+        Phi.Fields(i,0,k).set_value(index, 1.0);
+    }
+}
+
+/* Phase field with the largest value in each cell */
+Storage3D<long int,0> Majority(const PhaseField& Phi)
+{
+    Storage3D<long int,0> Result(Phi.Grid, 0);
+    STORAGE_LOOP_BEGIN(i,j,k,Result,0)
+    {
+        double Max = -1.0;
+        for(auto it  = Phi.Fields(i,j,k).cbegin();
+                 it != Phi.Fields(i,j,k).cend(); ++it)
+        if(it->value > Max)
+        {
+            Max = it->value;
+            Result(i,j,k) = it->index;
+        }
+    }
+    STORAGE_LOOP_END
+    return Result;
+}
+
+/* Number of face-connected parts of each grain in the periodic XZ plane,
+found by flood filling the majority phase fields */
+vector<size_t> Parts(const PhaseField& Phi)
+{
+    const Storage3D<long int,0> Grain = Majority(Phi);
+    const long int Nx = Phi.Grid.Nx;
+    const long int Nz = Phi.Grid.Nz;
+    vector<size_t> Result(Phi.FieldsProperties.size(), 0);
+    vector<bool> Visited(Nx*Nz, false);
+    for(long int start = 0; start < Nx*Nz; start++)
+    if(not Visited[start])
+    {
+        const long int index = Grain(start/Nz, 0, start%Nz);
+        Result[index]++;
+        vector<long int> Stack(1, start);
+        Visited[start] = true;
+        while(not Stack.empty())
+        {
+            const long int cell = Stack.back();
+            Stack.pop_back();
+            const long int i = cell/Nz;
+            const long int k = cell%Nz;
+            for(const auto& [di,dk] : {pair{1,0}, pair{-1,0}, pair{0,1}, pair{0,-1}})
+            {
+                const long int ii = (i + di + Nx)%Nx;
+                const long int kk = (k + dk + Nz)%Nz;
+                const long int next = ii*Nz + kk;
+                if(not Visited[next] and Grain(ii,0,kk) == index)
+                {
+                    Visited[next] = true;
+                    Stack.push_back(next);
+                }
+            }
+        }
+    }
+    return Result;
+}
+
+/* Total fraction of each grain */
+vector<double> Volumes(const PhaseField& Phi)
+{
+    vector<double> Result(Phi.FieldsProperties.size(), 0.0);
+    STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0)
+    {
+        for(auto it  = Phi.Fields(i,j,k).cbegin();
+                 it != Phi.Fields(i,j,k).cend(); ++it)
+        {
+            Result[it->index] += it->value;
+        }
+    }
+    STORAGE_LOOP_END
+    return Result;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                        OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl                  RTC(OPSettings);
+    PhaseField                      Phi(OPSettings);
+    DoubleObstacle                  DO(OPSettings);
+    InterfaceProperties             IP(OPSettings);
+    BoundaryConditions              BC(OPSettings);
+    DrivingForce                    DF(OPSettings);
+
+    /* Grain A of the precipitate phase consists of four parts, one of them
+    wraps around the periodic boundary along X. Grain B is connected. */
+    const size_t Matrix = Phi.AddGrainInfo(0);
+    const size_t A      = Phi.AddGrainInfo(1);
+    const size_t B      = Phi.AddGrainInfo(1);
+    STORAGE_LOOP_BEGIN(i,j,k,Phi.Fields,0)
+    {
+        Phi.Fields(i,j,k).clear();
+        Phi.Fields(i,j,k).set_value(Matrix, 1.0);
+    }
+    STORAGE_LOOP_END
+    Box(Phi, A,   4, 18,  4, 18);                                               // Largest part, keeps the index
+    Box(Phi, A,  26, 36,  4, 14);
+    Box(Phi, A,  24, 30, 30, 36);
+    Box(Phi, A,  -5,  5, 30, 36);                                               // Wraps around the boundary
+    Box(Phi, B,   6, 16, 26, 40);
+    Phi.FinalizeInitialization(BC);
+
+    /* Diffuse interfaces, so that minority phase fields are renamed too */
+    for(RTC.TimeStep = RTC.StartTimeStep; RTC.TimeStep <= RTC.MaxTimeStep; RTC.IncrementTimeStep())
+    {
+        DF.Clear();
+        IP.Set(Phi, BC);
+        DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+        Phi.NormalizeIncrements(BC, RTC.dt);
+        Phi.MergeIncrements(BC, RTC.dt);
+    }
+
+    const vector<size_t> PartsBefore   = Parts(Phi);
+    const vector<double> VolumesBefore = Volumes(Phi);
+    const size_t GrainsBefore = Phi.FieldsProperties.size();
+
+    const size_t Nsplit = Phi.SplitDisconnectedGrains(BC);
+
+    const vector<size_t> PartsAfter   = Parts(Phi);
+    const vector<double> VolumesAfter = Volumes(Phi);
+
+    int Failed = 0;
+    auto Check = [&](const bool Condition, const std::string& What)
+    {
+        if(not Condition)
+        {
+            ConsoleOutput::WriteWarning(What, "SplitDisconnectedGrains", "main()");
+            Failed++;
+        }
+    };
+
+    Check(PartsBefore[A] == 4 and PartsBefore[B] == 1, "Unexpected initial grain parts");
+    Check(Nsplit == 3, "Three grain parts have to be split off");
+    Check(Phi.FieldsProperties.size() == GrainsBefore + Nsplit, "Number of grains does not match the split parts");
+
+    /* Every grain is connected afterwards, the new ones belong to the phase of
+    grain A and together with A hold its former volume */
+    double VolumeA = VolumesAfter[A];
+    for(size_t n = 0; n < PartsAfter.size(); n++)
+    {
+        Check(PartsAfter[n] <= 1, "Grain " + to_string(n) + " is still disconnected");
+    }
+    for(size_t n = GrainsBefore; n < Phi.FieldsProperties.size(); n++)
+    {
+        Check(Phi.FieldsProperties[n].Phase == 1, "New grain " + to_string(n) + " has the wrong phase");
+        Check(VolumesAfter[n] > 0.0, "New grain " + to_string(n) + " is empty");
+        VolumeA += VolumesAfter[n];
+    }
+    Check(std::abs(VolumeA - VolumesBefore[A]) < 1.0e-9*VolumesBefore[A], "Volume of grain A is not conserved");
+    Check(VolumesAfter[B] == VolumesBefore[B] and VolumesAfter[Matrix] == VolumesBefore[Matrix],
+          "Connected grains have changed");
+    Check(Phi.SplitDisconnectedGrains(BC) == 0, "A second call splits again");
+
+    ConsoleOutput::WriteLineInsert("Split disconnected grains");
+    ConsoleOutput::WriteStandard("Parts of grain A", PartsBefore[A]);
+    ConsoleOutput::WriteStandard("New grains", Nsplit);
+    ConsoleOutput::WriteStandard("Volume of grain A before", VolumesBefore[A]);
+    ConsoleOutput::WriteStandard("Volume of its parts after", VolumeA);
+    ConsoleOutput::WriteStandard("Failed checks", Failed);
+    ConsoleOutput::WriteLine();
+
+    return (Failed == 0) ? 0 : EXIT_FAILURE;
+}
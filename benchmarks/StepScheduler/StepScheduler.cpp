@@ -0,0 +1,143 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "InterfaceProperties.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "Tools/StepScheduler.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Explicit diffusion sub-steps of a scalar field with zero flux boundaries, a
+   stand-in for the temperature and composition updates of a coupled run */
+void Diffuse(Storage3D<double,0>& U, Storage3D<double,0>& Tmp, const int nSub)
+{
+    const long int Nx = U.sizeX();
+    const long int Ny = U.sizeY();
+    const long int Nz = U.sizeZ();
+    for(int n = 0; n < nSub; n++)
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,U,0,)
+        {
+            double laplacian = -6.0*U(i,j,k);
+            laplacian += U(max(i-1,0L),j,k) + U(min(i+1,Nx-1),j,k);
+            laplacian += U(i,max(j-1,0L),k) + U(i,min(j+1,Ny-1),k);
+            laplacian += U(i,j,max(k-1,0L)) + U(i,j,min(k+1,Nz-1));
+            Tmp(i,j,k) = U(i,j,k) + 0.1*laplacian;
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,U,0,)
+        {
+            U(i,j,k) = Tmp(i,j,k);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
+}
+
+/* Coupling of both fields, depends on both diffusion stages */
+void Couple(const Storage3D<double,0>& A, const Storage3D<double,0>& B,
+            Storage3D<double,0>& C)
+{
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,C,0,)
+    {
+        C(i,j,k) = A(i,j,k)*B(i,j,k) + 0.5*C(i,j,k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+struct Fields
+{
+    Storage3D<double,0> A, B, C, TmpA, TmpB;
+
+    explicit Fields(const GridParameters& Grid)
+    {
+        for(auto* U : {&A, &B, &C, &TmpA, &TmpB}) U->Allocate(Grid, 0);
+        STORAGE_LOOP_BEGIN(i,j,k,A,0)
+        {
+            A(i,j,k) = (i < A.sizeX()/2) ? 1.0 : 0.0;
+            B(i,j,k) = (j < B.sizeY()/3) ? 1.0 : 0.0;
+            C(i,j,k) = 0.0;
+        }
+        STORAGE_LOOP_END
+    }
+};
+
+/* Registers the stages of a step: interface properties and the two diffusion
+   updates are independent, the coupling reads both diffusion results */
+void AddStages(StepScheduler& Step, Fields& F, PhaseField& Phi,
+               InterfaceProperties& IP, BoundaryConditions& BC)
+{
+    const size_t IPSet = Step.AddStage("Interface properties", [&]{IP.Set(Phi, BC);},
+                  {&Phi, &BC}, {&IP}, 2.0);
+    const size_t DiffusionA = Step.AddStage("Diffusion A", [&]{Diffuse(F.A, F.TmpA, 1);},
+                  {}, {&F.A, &F.TmpA}, 1.0);
+    const size_t DiffusionB = Step.AddStage("Diffusion B", [&]{Diffuse(F.B, F.TmpB, 3);},
+                  {}, {&F.B, &F.TmpB}, 3.0);
+    Step.StencilReads(IPSet, {&Phi});
+    Step.StencilReads(DiffusionA, {&F.A});
+    Step.StencilReads(DiffusionB, {&F.B});
+    Step.AddStage("Coupling", [&]{Couple(F.A, F.B, F.C);},
+                  {&F.A, &F.B}, {&F.C}, 1.0);
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                    OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl              RTC(OPSettings);
+    BoundaryConditions          BC(OPSettings);
+    PhaseField                  Phi(OPSettings);
+    InterfaceProperties         IP(OPSettings);
+
+    Initializations::Single(Phi, 0, BC);
+    Initializations::Sphere(Phi, 1, OPSettings.Grid.Nx*0.4,
+    (OPSettings.Grid.Nx)/2.0, (OPSettings.Grid.Ny)/2.0, (OPSettings.Grid.Nz)/2.0, BC);
+
+    Fields Reference(OPSettings.Grid);
+    Fields Concurrent(OPSettings.Grid);
+
+    StepScheduler SequentialStep;
+    SequentialStep.Sequential = true;
+    AddStages(SequentialStep, Reference, Phi, IP, BC);
+
+    StepScheduler ConcurrentStep;
+    AddStages(ConcurrentStep, Concurrent, Phi, IP, BC);
+
+    const int nSteps = RTC.nSteps - RTC.tStart + 1;
+    myclock_t start = mygettime();
+    for(int n = 0; n < nSteps; n++) SequentialStep.Run();
+    double timeSequential = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+
+    start = mygettime();
+    for(int n = 0; n < nSteps; n++) ConcurrentStep.Run();
+    double timeConcurrent = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+
+    double maxDeviation = 0.0;
+    STORAGE_LOOP_BEGIN(i,j,k,Reference.C,0)
+    {
+        maxDeviation = max(maxDeviation, abs(Reference.A(i,j,k) - Concurrent.A(i,j,k)));
+        maxDeviation = max(maxDeviation, abs(Reference.B(i,j,k) - Concurrent.B(i,j,k)));
+        maxDeviation = max(maxDeviation, abs(Reference.C(i,j,k) - Concurrent.C(i,j,k)));
+    }
+    STORAGE_LOOP_END
+
+    ConcurrentStep.Report();
+    ConsoleOutput::WriteLineInsert("Sequential vs. concurrent stages");
+    ConsoleOutput::WriteStandard("Levels", ConcurrentStep.NumberOfLevels());
+    ConsoleOutput::WriteStandard("Sequential [s/step]", timeSequential/nSteps);
+    ConsoleOutput::WriteStandard("Concurrent [s/step]", timeConcurrent/nSteps);
+    ConsoleOutput::WriteStandard("Speedup", timeSequential/max(timeConcurrent, DBL_MIN));
+    ConsoleOutput::WriteStandard("Max deviation", maxDeviation);
+    ConsoleOutput::WriteLine();
+
+    if(maxDeviation != 0.0)
+    {
+        ConsoleOutput::WriteWarning("Concurrent and sequential stages produce different results", "StepScheduler", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "FluidDynamics/D3Q27.h"
+#include "FluidDynamics/LBLattices.h"
+#include "Containers/BrickStorage3D.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Loops over the cells of either storage layout in its memory order, so that
+   the kernels below can be written once for both layouts */
+template<class T, class Function>
+void CellLoop(const Storage3D<T,0>& Field, const long int bcells, Function&& Body)
+{
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Field,bcells,)
+    {
+        Body(i,j,k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+template<class T, size_t Brick, class Function>
+void CellLoop(const BrickStorage3D<T,Brick>& Field, const long int bcells, Function&& Body)
+{
+    Field.ParallelBrickLoop(bcells, Body);
+}
+
+/* Phase-field Laplacian kernel (see TiledStorageLoop benchmark) */
+template<class NodeStorage, class ResultStorage>
+double LaplacianSweep(const NodeStorage& Fields, const LaplacianStencil& LStencil,
+                      ResultStorage& Result)
+{
+    myclock_t start = mygettime();
+    CellLoop(Result, 0, [&](long int i, long int j, long int k)
+    {
+        double value = 0.0;
+        for (auto ls = LStencil.cbegin(); ls != LStencil.cend(); ls++)
+        for (auto it  = Fields(i + ls->di, j + ls->dj, k + ls->dk).cbegin();
+                  it != Fields(i + ls->di, j + ls->dj, k + ls->dk).cend(); ++it)
+        {
+            value += ls->weight * it->value * (it->index + 1);
+        }
+        Result(i,j,k) = value;
+    });
+    return double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+}
+
+inline long int Wrap(const long int i, const long int N)
+{
+    return (i + N) % N;
+}
+
+/* BGK collision of the populations of one cell */
+inline void CollideBGK(double f[27])
+{
+    double rho = 0.0;
+    double ux = 0.0, uy = 0.0, uz = 0.0;
+    for(int q = 0; q < 27; q++)
+    {
+        rho += f[q];
+        ux  += D3Q27Lattice::c[q][0]*f[q];
+        uy  += D3Q27Lattice::c[q][1]*f[q];
+        uz  += D3Q27Lattice::c[q][2]*f[q];
+    }
+    ux /= rho; uy /= rho; uz /= rho;
+    const double u2 = ux*ux + uy*uy + uz*uz;
+    for(int q = 0; q < 27; q++)
+    {
+        const double cu = D3Q27Lattice::c[q][0]*ux + D3Q27Lattice::c[q][1]*uy + D3Q27Lattice::c[q][2]*uz;
+        const double feq = D3Q27Lattice::w[q]*rho*(1.0 + 3.0*cu + 4.5*cu*cu - 1.5*u2);
+        f[q] += (feq - f[q])/0.8;
+    }
+}
+
+/* Periodic D3Q27 BGK collide-and-stream (see LBMPopulationLayout benchmark)
+   with node-wise populations as in FlowSolverLBM. Populations are pulled from
+   the neighbors into the second storage and collided there. */
+template<class PopulationStorage>
+double RunLBM(const GridParameters& Grid, const int nSteps, PopulationStorage Populations[2])
+{
+    Populations[0].Allocate(Grid, 1);
+    Populations[1].Allocate(Grid, 1);
+    CellLoop(Populations[0], 0, [&](long int i, long int j, long int k)
+    {
+        const double ux = 0.05*std::sin(2.0*Pi*j/Grid.Ny);
+        D3Q27& locPopulations = Populations[0](i,j,k);
+        for(int q = 0; q < 27; q++)
+        {
+            const double cu = D3Q27Lattice::c[q][0]*ux;
+            locPopulations(D3Q27Lattice::c[q][0], D3Q27Lattice::c[q][1], D3Q27Lattice::c[q][2]) =
+                D3Q27Lattice::w[q]*(1.0 + 3.0*cu + 4.5*cu*cu - 1.5*ux*ux);
+        }
+    });
+
+    myclock_t start = mygettime();
+    for(int step = 0; step < nSteps; step++)
+    {
+        PopulationStorage& Old = Populations[step%2];
+        PopulationStorage& New = Populations[1 - step%2];
+        CellLoop(Old, 1, [&](long int i, long int j, long int k)
+        {
+            if (i < 0 or i >= Grid.Nx or j < 0 or j >= Grid.Ny or k < 0 or k >= Grid.Nz)
+            {
+                Old(i,j,k) = Old(Wrap(i,Grid.Nx),Wrap(j,Grid.Ny),Wrap(k,Grid.Nz));
+            }
+        });
+        CellLoop(New, 0, [&](long int i, long int j, long int k)
+        {
+            double f[27];
+            for(int q = 0; q < 27; q++)
+            {
+                const int x = D3Q27Lattice::c[q][0];
+                const int y = D3Q27Lattice::c[q][1];
+                const int z = D3Q27Lattice::c[q][2];
+                f[q] = Old(i-x,j-y,k-z)(x,y,z);
+            }
+            CollideBGK(f);
+            double* locPopulations = New(i,j,k).data();
+            for(int q = 0; q < 27; q++) locPopulations[q] = f[q];
+        });
+    }
+    return double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+}
+
+/* Largest difference between the interior cells of two storages */
+template<class StorageA, class StorageB, class Function>
+double MaxDeviation(const GridParameters& Grid, const StorageA& A, const StorageB& B,
+                    Function&& Difference)
+{
+    double maxDeviation = 0.0;
+    for(long int i = 0; i < Grid.Nx; i++)
+    for(long int j = 0; j < Grid.Ny; j++)
+    for(long int k = 0; k < Grid.Nz; k++)
+    {
+        maxDeviation = std::max(maxDeviation, Difference(A(i,j,k), B(i,j,k)));
+    }
+    return maxDeviation;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                    OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl              RTC(OPSettings);
+    BoundaryConditions          BC(OPSettings);
+
+    const GridParameters& Grid = OPSettings.Grid;
+    if(Grid.Active() != 3)
+    {
+        ConsoleOutput::WriteExit("The benchmark requires a three-dimensional grid", "StorageLayout", "main()");
+        return EXIT_FAILURE;
+    }
+    const double nCells = double(Grid.Nx)*Grid.Ny*Grid.Nz;
+    const double tolerance = 1.0e-12;
+    bool passed = true;
+
+    // Phase-field Laplacian on the quadruple junction of the MultiJunction3D benchmark
+    {
+        PhaseField Phi(OPSettings);
+        Initializations::Young4(Phi, 0, 1, 2, 3, BC);
+
+        BrickStorage3D<NodePF,4> Fields4;
+        BrickStorage3D<NodePF,8> Fields8;
+        Fields4.CopyFrom(Phi.Fields);
+        Fields8.CopyFrom(Phi.Fields);
+
+        Storage3D<double,0>      Result;
+        BrickStorage3D<double,4> Result4;
+        BrickStorage3D<double,8> Result8;
+        Result.Allocate(Grid, 0);
+        Result4.Allocate(Grid, 0);
+        Result8.Allocate(Grid, 0);
+
+        const int nSweeps = 20;
+        double time[3] = {0.0, 0.0, 0.0};
+        for(int n = 0; n < nSweeps; n++)
+        {
+            time[0] += LaplacianSweep(Phi.Fields, Phi.LStencil, Result);
+            time[1] += LaplacianSweep(Fields4, Phi.LStencil, Result4);
+            time[2] += LaplacianSweep(Fields8, Phi.LStencil, Result8);
+        }
+        auto difference = [](const double a, const double b){return std::abs(a - b);};
+        const double maxDeviation = std::max(MaxDeviation(Grid, Result, Result4, difference),
+                                             MaxDeviation(Grid, Result, Result8, difference));
+        passed = (maxDeviation <= tolerance) and passed;
+
+        ConsoleOutput::WriteLineInsert("Phase-field Laplacian (MultiJunction3D)");
+        ConsoleOutput::WriteStandard("Row-major [cells/s]", nSweeps*nCells/std::max(time[0], DBL_MIN));
+        ConsoleOutput::WriteStandard("Bricks 4^3 [cells/s]", nSweeps*nCells/std::max(time[1], DBL_MIN));
+        ConsoleOutput::WriteStandard("Bricks 8^3 [cells/s]", nSweeps*nCells/std::max(time[2], DBL_MIN));
+        ConsoleOutput::WriteStandard("Max deviation", maxDeviation);
+    }
+
+    // Lattice Boltzmann collide-and-stream
+    {
+        const int nSteps = RTC.nSteps;
+        Storage3D<D3Q27,0>      Populations[2];
+        BrickStorage3D<D3Q27,4> Populations4[2];
+        BrickStorage3D<D3Q27,8> Populations8[2];
+        const double time  = RunLBM(Grid, nSteps, Populations);
+        const double time4 = RunLBM(Grid, nSteps, Populations4);
+        const double time8 = RunLBM(Grid, nSteps, Populations8);
+
+        auto difference = [](const D3Q27& a, const D3Q27& b)
+        {
+            double locDeviation = 0.0;
+            for(int q = 0; q < 27; q++)
+            {
+                locDeviation = std::max(locDeviation, std::abs(a.const_data()[q] - b.const_data()[q]));
+            }
+            return locDeviation;
+        };
+        const int last = nSteps%2;
+        const double maxDeviation = std::max(MaxDeviation(Grid, Populations[last], Populations4[last], difference),
+                                             MaxDeviation(Grid, Populations[last], Populations8[last], difference));
+        passed = (maxDeviation <= tolerance) and passed;
+
+        ConsoleOutput::WriteLineInsert("D3Q27 collide-and-stream");
+        ConsoleOutput::WriteStandard("Row-major [MLUPS]", nSteps*nCells/std::max(time, DBL_MIN)*1.0e-6);
+        ConsoleOutput::WriteStandard("Bricks 4^3 [MLUPS]", nSteps*nCells/std::max(time4, DBL_MIN)*1.0e-6);
+        ConsoleOutput::WriteStandard("Bricks 8^3 [MLUPS]", nSteps*nCells/std::max(time8, DBL_MIN)*1.0e-6);
+        ConsoleOutput::WriteStandard("Max deviation", maxDeviation);
+        ConsoleOutput::WriteLine();
+    }
+
+    if(not passed)
+    {
+        ConsoleOutput::WriteWarning("Storage layouts produce different results", "StorageLayout", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
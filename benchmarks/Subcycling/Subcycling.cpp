@@ -0,0 +1,113 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+
+using namespace std;
+using namespace openphase;
+
+const double Diffusivity = 1.0e-9;                                              ///< Diffusion coefficient [m^2/s]
+const double SourceRate  = 1.0;                                                 ///< Growth rate of the source [1/s^2]
+
+/* One explicit (forward Euler) diffusion substep on a periodic grid along x */
+void Diffuse(Storage3D<double,0>& U, Storage3D<double,0>& Tmp,
+             const Storage3D<double,0>& Source, const double dx, const double sub_dt)
+{
+    const long int Nx = U.sizeX();
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,U,0,)
+    {
+        const double laplacian = (U((i+Nx-1)%Nx,j,k) - 2.0*U(i,j,k) + U((i+1)%Nx,j,k))/(dx*dx);
+        Tmp(i,j,k) = U(i,j,k) + sub_dt*(Diffusivity*laplacian + Source(i,j,k));
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,U,0,)
+    {
+        U(i,j,k) = Tmp(i,j,k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                    OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl              RTC(OPSettings);
+
+    const GridParameters& Grid = OPSettings.Grid;
+    if(Grid.Active() != 1 or Grid.Nx < 3)
+    {
+        ConsoleOutput::WriteExit("The benchmark requires a one-dimensional grid along x", "Subcycling", "main()");
+        return EXIT_FAILURE;
+    }
+    const long int Nx = Grid.Nx;
+    const double dx = Grid.dx;
+    const double dtStable = dx*dx/(2.0*Diffusivity);
+
+    Storage3D<double,0> U, Tmp, Source, SourceStart, SourceEnd;
+    for(auto* Field : {&U, &Tmp, &Source, &SourceStart, &SourceEnd}) Field->Allocate(Grid, 0);
+    STORAGE_LOOP_BEGIN(i,j,k,U,0)
+    {
+        U(i,j,k) = std::sin(2.0*Pi*i/Nx);
+    }
+    STORAGE_LOOP_END
+
+    /* The source a*t is known at the start and the end of each global time
+    step, the substeps take it from InterpolateCoupling() */
+    long int nSubsteps = 0;
+    int Substeps = 0;
+    double Time = 0.0;
+    for(RTC.tStep = RTC.tStart; RTC.tStep <= RTC.nSteps; RTC.IncrementTimeStep())
+    {
+        SourceStart.set_to_value(SourceRate*Time);
+        SourceEnd.set_to_value(SourceRate*(Time + RTC.dt));
+
+        Substeps = RTC.SetModuleTimeStep("Diffusion", dtStable);
+        RTC.Subcycle("Diffusion", [&](double sub_dt, double theta)
+        {
+            RTC.InterpolateCoupling(Source, SourceStart, SourceEnd, theta);
+            Diffuse(U, Tmp, Source, dx, sub_dt);
+            nSubsteps++;
+        });
+        Time += RTC.dt;
+    }
+
+    double Amplitude = 0.0;
+    double Mean = 0.0;
+    STORAGE_LOOP_BEGIN(i,j,k,U,0)
+    {
+        Amplitude += 2.0/Nx*U(i,j,k)*std::sin(2.0*Pi*i/Nx);
+        Mean += U(i,j,k)/Nx;
+    }
+    STORAGE_LOOP_END
+
+    /* Exact results of the discrete scheme: damping by the amplification
+    factor of the sine mode in every substep, and the left Riemann sum of the
+    source over all substeps for the mean value */
+    const double h = RTC.dt/Substeps;
+    const double r = Diffusivity*h/(dx*dx);
+    const double Gain = 1.0 - 4.0*r*std::pow(std::sin(Pi/Nx), 2);
+    const double AmplitudeExact = std::pow(Gain, double(nSubsteps));
+    const double MeanExact = SourceRate*h*h*double(nSubsteps)*double(nSubsteps - 1)/2.0;
+    const double AmplitudeDeviation = std::abs(Amplitude/AmplitudeExact - 1.0);
+    const double MeanDeviation = std::abs(Mean/MeanExact - 1.0);
+
+    ConsoleOutput::WriteLineInsert("Subcycled explicit diffusion");
+    ConsoleOutput::WriteStandard("Global time step", RTC.dt);
+    ConsoleOutput::WriteStandard("Stable time step", dtStable);
+    ConsoleOutput::WriteStandard("Substeps per time step", Substeps);
+    ConsoleOutput::WriteStandard("Total substeps", double(nSubsteps));
+    ConsoleOutput::WriteStandard("Amplitude", Amplitude);
+    ConsoleOutput::WriteStandard("Amplitude (exact)", AmplitudeExact);
+    ConsoleOutput::WriteStandard("Mean value", Mean);
+    ConsoleOutput::WriteStandard("Mean value (exact)", MeanExact);
+    ConsoleOutput::WriteLine();
+
+    if(Substeps != int(std::ceil(RTC.dt/dtStable - 1.0e-9)) or
+       AmplitudeDeviation > 1.0e-10 or MeanDeviation > 1.0e-10)
+    {
+        ConsoleOutput::WriteWarning("Subcycled solution differs from the exact solution of the scheme", "Subcycling", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
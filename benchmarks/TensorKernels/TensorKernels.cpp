@@ -0,0 +1,198 @@
+#include "Includes.h"
+#include "FileInterface.h"
+#include <chrono>
+#include <functional>
+#include <random>
+
+using namespace std;
+using namespace openphase;
+
+/* Generic loop forms of the kernels as they were implemented before */
+
+vStress ReferenceProduct(const dMatrix6x6& C, const vStrain& e)
+{
+    vStress s;
+    for(int i = 0; i < 6; i++)
+    for(int j = 0; j < 6; j++)
+    {
+        s[i] += C(i,j)*e[j];
+    }
+    return s;
+}
+
+dMatrix6x6 ReferenceProduct(const dMatrix6x6& A, const dMatrix6x6& B)
+{
+    dMatrix6x6 C;
+    for(int i = 0; i < 6; i++)
+    for(int j = 0; j < 6; j++)
+    for(int k = 0; k < 6; k++)
+    {
+        C(i,j) += A(i,k)*B(k,j);
+    }
+    return C;
+}
+
+dMatrix3x3 ReferenceProduct(const dMatrix3x3& A, const dMatrix3x3& B)
+{
+    dMatrix3x3 C;
+    for(int i = 0; i < 3; i++)
+    for(int j = 0; j < 3; j++)
+    for(int k = 0; k < 3; k++)
+    {
+        C(i,j) += A(i,k)*B(k,j);
+    }
+    return C;
+}
+
+dMatrix3x3 ReferenceInverse(const dMatrix3x3& A)
+{
+    const double detInv = 1.0/A.determinant();
+    dMatrix3x3 Inv;
+    for(int i = 0; i < 3; i++)
+    for(int j = 0; j < 3; j++)
+    {
+        const int j1 = (j+1)%3, j2 = (j+2)%3;
+        const int i1 = (i+1)%3, i2 = (i+2)%3;
+        Inv(i,j) = (A(j1,i1)*A(j2,i2) - A(j1,i2)*A(j2,i1))*detInv;
+    }
+    return Inv;
+}
+
+dMatrix6x6 ReferenceRotation(const dMatrix6x6& C, const dMatrix3x3& R)
+{
+    double Out[3][3][3][3];
+    for(int m = 0; m < 3; m++)
+    for(int n = 0; n < 3; n++)
+    for(int p = 0; p < 3; p++)
+    for(int q = 0; q < 3; q++)
+    {
+        Out[m][n][p][q] = 0.0;
+        for(int i = 0; i < 3; i++)
+        for(int j = 0; j < 3; j++)
+        for(int k = 0; k < 3; k++)
+        for(int l = 0; l < 3; l++)
+        {
+            Out[m][n][p][q] += R(m,i)*R(n,j)*C.tensor(i,j,k,l)*R(p,k)*R(q,l);
+        }
+    }
+    const int VoigtIndex[6][2] = {{0,0},{1,1},{2,2},{1,2},{0,2},{0,1}};
+    dMatrix6x6 OUT;
+    for(int m = 0; m < 6; m++)
+    for(int n = 0; n < 6; n++)
+    {
+        OUT(m,n) = Out[VoigtIndex[m][0]][VoigtIndex[m][1]]
+                      [VoigtIndex[n][0]][VoigtIndex[n][1]];
+    }
+    return OUT;
+}
+
+/* Calls Kernel(s) for all samples nRepetitions times, returns the time per
+   call in ns. The results are summed up to keep the calls alive. */
+double Time(const size_t nSamples, const int nRepetitions,
+            const function<double(size_t)>& Kernel, double& CheckSum)
+{
+    auto start = chrono::steady_clock::now();
+    double sum = 0.0;
+    for(int r = 0; r < nRepetitions; r++)
+    for(size_t s = 0; s < nSamples; s++)
+    {
+        sum += Kernel(s);
+    }
+    auto end = chrono::steady_clock::now();
+    CheckSum = sum;
+    return chrono::duration<double,nano>(end - start).count()/(nSamples*nRepetitions);
+}
+
+bool Report(const string Name, const size_t nSamples, const int nRepetitions,
+            const function<double(size_t)>& Reference,
+            const function<double(size_t)>& Specialized)
+{
+    double CheckSumReference   = 0.0;
+    double CheckSumSpecialized = 0.0;
+    const double tReference   = Time(nSamples, nRepetitions, Reference,   CheckSumReference);
+    const double tSpecialized = Time(nSamples, nRepetitions, Specialized, CheckSumSpecialized);
+
+    const bool agree = fabs(CheckSumReference - CheckSumSpecialized) <=
+                       1.0e-10*max(1.0, fabs(CheckSumReference));
+
+    cout << setw(24) << left << Name << right
+         << setw(14) << tReference   << " ns"
+         << setw(14) << tSpecialized << " ns"
+         << setw(10) << tReference/tSpecialized
+         << (agree ? "" : "   results differ!") << endl;
+    return agree;
+}
+
+int main(int argc, char *argv[])
+{
+    string InputFileName = DefaultInputFileName;
+    if (argc > 1) InputFileName = argv[1];
+
+    fstream inpF(InputFileName, ios::in);
+    stringstream inp;
+    inp << inpF.rdbuf();
+    inpF.close();
+    const int    moduleLocation = FileInterface::FindModuleLocation(inp, "TensorKernels");
+    const size_t nSamples       = FileInterface::ReadParameterI(inp, moduleLocation, string("nSamples"));
+    const int    nRepetitions   = FileInterface::ReadParameterI(inp, moduleLocation, string("nRepetitions"));
+
+    /* Random operands, the rotations are built from random Euler angles */
+    mt19937 generator(0);
+    uniform_real_distribution<double> random(-1.0, 1.0);
+
+    vector<dMatrix6x6> C(nSamples);
+    vector<dMatrix3x3> A(nSamples);
+    vector<dMatrix3x3> R(nSamples);
+    vector<vStrain>    E(nSamples);
+    for(size_t s = 0; s < nSamples; s++)
+    {
+        for(int i = 0; i < 6; i++)
+        for(int j = 0; j < 6; j++)
+        {
+            C[s](i,j) = random(generator);
+        }
+        for(int i = 0; i < 3; i++)
+        for(int j = 0; j < 3; j++)
+        {
+            A[s](i,j) = random(generator);
+        }
+        A[s] += dMatrix3x3::UnitTensor()*3.0;
+        for(int i = 0; i < 6; i++)
+        {
+            E[s][i] = random(generator);
+        }
+        const double a = Pi*random(generator);
+        const double b = Pi*random(generator);
+        const double c = Pi*random(generator);
+        dMatrix3x3 Rz1{cos(a), -sin(a), 0.0, sin(a), cos(a), 0.0, 0.0, 0.0, 1.0};
+        dMatrix3x3 Rx {1.0, 0.0, 0.0, 0.0, cos(b), -sin(b), 0.0, sin(b), cos(b)};
+        dMatrix3x3 Rz2{cos(c), -sin(c), 0.0, sin(c), cos(c), 0.0, 0.0, 0.0, 1.0};
+        R[s] = Rz1*Rx*Rz2;
+    }
+
+    cout << "Time per call for " << nSamples << " operands and "
+         << nRepetitions << " repetitions" << endl;
+    cout << setw(24) << left << "Kernel" << right
+         << setw(17) << "reference"
+         << setw(17) << "specialized"
+         << setw(10) << "speedup" << endl;
+
+    bool agree = true;
+    agree &= Report("dMatrix6x6*vStrain", nSamples, nRepetitions,
+        [&](size_t s){return ReferenceProduct(C[s],E[s])[s%6];},
+        [&](size_t s){return (C[s]*E[s])[s%6];});
+    agree &= Report("dMatrix6x6*dMatrix6x6", nSamples, nRepetitions,
+        [&](size_t s){return ReferenceProduct(C[s],C[nSamples-1-s])(s%6,(s/6)%6);},
+        [&](size_t s){return (C[s]*C[nSamples-1-s])(s%6,(s/6)%6);});
+    agree &= Report("dMatrix3x3*dMatrix3x3", nSamples, nRepetitions,
+        [&](size_t s){return ReferenceProduct(A[s],R[s])(s%3,(s/3)%3);},
+        [&](size_t s){return (A[s]*R[s])(s%3,(s/3)%3);});
+    agree &= Report("dMatrix3x3::inverted", nSamples, nRepetitions,
+        [&](size_t s){return ReferenceInverse(A[s])(s%3,(s/3)%3);},
+        [&](size_t s){return A[s].inverted()(s%3,(s/3)%3);});
+    agree &= Report("dMatrix6x6::rotated", nSamples, max(1, nRepetitions/100),
+        [&](size_t s){return ReferenceRotation(C[s],R[s])(s%6,(s/6)%6);},
+        [&](size_t s){return C[s].rotated(R[s])(s%6,(s/6)%6);});
+
+    return agree ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,137 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "InterfaceProperties.h"
+#include "DoubleObstacle.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "DrivingForce.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Sum of the phase-field Laplacians in each cell, evaluated with the standard
+   loop macro */
+double LaplacianSweep(const PhaseField& Phi, Storage3D<double,0>& Result)
+{
+    myclock_t start = mygettime();
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Result,0,)
+    {
+        double value = 0.0;
+        for (auto ls = Phi.LStencil.cbegin(); ls != Phi.LStencil.cend(); ls++)
+        for (auto it  = Phi.Fields(i + ls->di, j + ls->dj, k + ls->dk).cbegin();
+                  it != Phi.Fields(i + ls->di, j + ls->dj, k + ls->dk).cend(); ++it)
+        {
+            value += ls->weight * it->value * (it->index + 1);
+        }
+        Result(i,j,k) = value;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+}
+
+/* Same kernel evaluated with the cache-blocked loop macro */
+double TiledLaplacianSweep(const PhaseField& Phi, Storage3D<double,0>& Result)
+{
+    myclock_t start = mygettime();
+    OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i,j,k,Result,0,)
+    {
+        double value = 0.0;
+        for (auto ls = Phi.LStencil.cbegin(); ls != Phi.LStencil.cend(); ls++)
+        for (auto it  = Phi.Fields(i + ls->di, j + ls->dj, k + ls->dk).cbegin();
+                  it != Phi.Fields(i + ls->di, j + ls->dj, k + ls->dk).cend(); ++it)
+        {
+            value += ls->weight * it->value * (it->index + 1);
+        }
+        Result(i,j,k) = value;
+    }
+    OMP_PARALLEL_TILED_STORAGE_LOOP_END
+    return double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+}
+
+/* Runs both kernels and a few time steps on a given microstructure,
+   returns false if the loop variants produce different results */
+bool Compare(const std::string Name, Settings& OPSettings, RunTimeControl& RTC,
+             PhaseField& Phi, BoundaryConditions& BC)
+{
+    DoubleObstacle      DO(OPSettings);
+    InterfaceProperties IP(OPSettings);
+    DrivingForce        DF(OPSettings);
+
+    Storage3D<double,0> Standard;
+    Storage3D<double,0> Tiled;
+    Standard.Allocate(OPSettings.Grid, 0);
+    Tiled.Allocate(OPSettings.Grid, 0);
+
+    const int nSweeps = 20;
+    double timeStandard = 0.0;
+    double timeTiled = 0.0;
+    for(int n = 0; n < nSweeps; n++)
+    {
+        timeStandard += LaplacianSweep(Phi, Standard);
+        timeTiled    += TiledLaplacianSweep(Phi, Tiled);
+    }
+
+    double maxDeviation = 0.0;
+    STORAGE_LOOP_BEGIN(i,j,k,Standard,0)
+    {
+        maxDeviation = std::max(maxDeviation, std::abs(Standard(i,j,k) - Tiled(i,j,k)));
+    }
+    STORAGE_LOOP_END
+
+    myclock_t start = mygettime();
+    for(RTC.tStep = RTC.tStart; RTC.tStep <= RTC.nSteps; RTC.IncrementTimeStep())
+    {
+        DF.Clear();
+        IP.Set(Phi, BC);
+        DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+        Phi.NormalizeIncrements(BC, RTC.dt);
+        Phi.MergeIncrements(BC, RTC.dt);
+    }
+    double timeSteps = double(mygettime() - start)/OP_CLOCKS_PER_SEC;
+
+    ConsoleOutput::WriteLineInsert(Name);
+    ConsoleOutput::WriteStandard("Standard loop [s/sweep]", timeStandard/nSweeps);
+    ConsoleOutput::WriteStandard("Tiled loop [s/sweep]", timeTiled/nSweeps);
+    ConsoleOutput::WriteStandard("Speedup", timeStandard/std::max(timeTiled, DBL_MIN));
+    ConsoleOutput::WriteStandard("Max deviation", maxDeviation);
+    ConsoleOutput::WriteStandard("Time step (tiled) [s/step]", timeSteps/(RTC.nSteps - RTC.tStart + 1));
+    ConsoleOutput::WriteLine();
+
+    return maxDeviation == 0.0;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                    OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl              RTC(OPSettings);
+    BoundaryConditions          BC(OPSettings);
+
+    bool passed = true;
+
+    // Single grain setup (see SingleGrain benchmark)
+    {
+        PhaseField Phi(OPSettings);
+        Initializations::Single(Phi, 0, BC);
+        Initializations::Sphere(Phi, 1, OPSettings.Grid.Nx*0.4,
+        (OPSettings.Grid.Nx)/2.0, (OPSettings.Grid.Ny)/2.0, (OPSettings.Grid.Nz)/2.0, BC);
+        passed = Compare("SingleGrain", OPSettings, RTC, Phi, BC) and passed;
+    }
+
+    // Quadruple junction setup (see MultiJunction3D benchmark)
+    {
+        PhaseField Phi(OPSettings);
+        Initializations::Young4(Phi, 0, 1, 2, 3, BC);
+        passed = Compare("MultiJunction3D", OPSettings, RTC, Phi, BC) and passed;
+    }
+
+    if(not passed)
+    {
+        ConsoleOutput::WriteWarning("Tiled and standard storage loops produce different results", "TiledStorageLoop", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
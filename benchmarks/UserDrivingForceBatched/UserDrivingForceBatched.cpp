@@ -0,0 +1,167 @@
+#include "Settings.h"
+#include "RunTimeControl.h"
+#include "InterfaceProperties.h"
+#include "DoubleObstacle.h"
+#include "PhaseField.h"
+#include "Initializations.h"
+#include "BoundaryConditions.h"
+#include "DrivingForce.h"
+#include "Temperature.h"
+#include "UserDrivingForce.h"
+
+using namespace std;
+using namespace openphase;
+
+/* Driving force law of a pair of phases, as given in ProjectInput.opi for
+the phase pairs (n,m) with n < m */
+struct PairLaw
+{
+    UserDrivingForceModes Mode;
+    double Value;
+    double LatentHeat;
+    double Teq;
+};
+
+const size_t Nphases = 4;
+const PairLaw Laws[Nphases][Nphases] = {
+    {{}, {UserDrivingForceModes::Value,   1.0e5, 0.0,    1.0},
+         {UserDrivingForceModes::Formula, 0.0,   2.0e8,  1010.0},
+         {UserDrivingForceModes::Formula, 0.0,   1.5e8,  995.0}},
+    {{}, {},
+         {UserDrivingForceModes::Formula, 0.0,  -3.0e7,  1020.0},
+         {UserDrivingForceModes::Value,  -4.0e4, 0.0,    1.0}},
+    {{}, {}, {},
+         {UserDrivingForceModes::None,    0.0,   0.0,    1.0}},
+    {{}, {}, {}, {}}};
+
+/* The user thermodynamics of a tile: the same formula as
+UserDrivingForce::SetDrivingForce() with temperature, antisymmetric in the
+phase pair */
+void Kernel(UserDrivingForceTile& Tile)
+{
+    for(size_t n = 0; n < Tile.Size; n++)
+    {
+        const size_t a = Tile.PhaseA[n];
+        const size_t b = Tile.PhaseB[n];
+        if(a == b) continue;
+
+        const PairLaw& Law = Laws[min(a,b)][max(a,b)];
+        const double Sign = (a < b) ? 1.0 : -1.0;
+        switch(Law.Mode)
+        {
+            case UserDrivingForceModes::Value:
+            {
+                Tile.dG[n] = Sign*Law.Value;
+                break;
+            }
+            case UserDrivingForceModes::Formula:
+            {
+                Tile.dG[n] = (Sign*Law.LatentHeat)*(Tile.T[n] - Law.Teq)/Law.Teq;
+                break;
+            }
+            case UserDrivingForceModes::None:
+            default:
+            {
+                break;
+            }
+        }
+    }
+}
+
+/* Compares the raw driving forces of all pairs in all cells bitwise, returns
+the number of differing cells. Pairs which are present in only one of the
+storages have to be zero. */
+int Compare(const Storage3D<NodeDF,0>& Reference, const Storage3D<NodeDF,0>& Force,
+            size_t& Entries)
+{
+    int Differences = 0;
+    Entries = 0;
+    STORAGE_LOOP_BEGIN(i,j,k,Reference,0)
+    {
+        bool equal = true;
+        for(auto it  = Reference(i,j,k).cbegin();
+                 it != Reference(i,j,k).cend(); ++it)
+        {
+            equal = equal and Force(i,j,k).get_raw(it->indexA, it->indexB) == it->raw;
+            Entries++;
+        }
+        for(auto it  = Force(i,j,k).cbegin();
+                 it != Force(i,j,k).cend(); ++it)
+        {
+            equal = equal and Reference(i,j,k).get_raw(it->indexA, it->indexB) == it->raw;
+        }
+        if(not equal) Differences++;
+    }
+    STORAGE_LOOP_END
+    return Differences;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    Settings                        OPSettings;
+    OPSettings.ReadInput();
+
+    RunTimeControl                  RTC(OPSettings);
+    PhaseField                      Phi(OPSettings);
+    DoubleObstacle                  DO(OPSettings);
+    InterfaceProperties             IP(OPSettings);
+    BoundaryConditions              BC(OPSettings);
+    DrivingForce                    DF(OPSettings);
+    Temperature                     Tx(OPSettings);
+    UserDrivingForce                UDF(OPSettings);
+
+    /* Three grains of different phases meeting a fourth one in a triple
+    junction, relaxed to diffuse interfaces, in a temperature gradient */
+    Initializations::Young3(Phi, 0, 1, 2, 3, BC);
+    Tx.SetInitial(BC);
+
+    for(RTC.TimeStep = RTC.StartTimeStep; RTC.TimeStep <= RTC.MaxTimeStep; RTC.IncrementTimeStep())
+    {
+        DF.Clear();
+        IP.Set(Phi, BC);
+        DO.CalculatePhaseFieldIncrements(Phi, IP, DF);
+        Phi.NormalizeIncrements(BC, RTC.dt);
+        Phi.MergeIncrements(BC, RTC.dt);
+    }
+
+    /* Cell by cell reference */
+    DF.Clear();
+    UDF.SetDrivingForce(Phi, DF, Tx);
+    const Storage3D<NodeDF,0> Reference(DF.Force);
+
+    ConsoleOutput::WriteLineInsert("Batched user driving force");
+    int Differences = 0;
+    size_t Entries = 0;
+
+    /* Runtime registered kernel with the tile size of the input, the last
+    tile is only partially filled */
+    DF.Clear();
+    UDF.BatchKernel = Kernel;
+    UDF.SetDrivingForceBatched(Phi, DF, &Tx);
+    const int RuntimeDifferences = Compare(Reference, DF.Force, Entries);
+    ConsoleOutput::WriteStandard("Interface cells", Phi.InterfaceCells.size());
+    ConsoleOutput::WriteStandard("Phase pair entries", Entries);
+    ConsoleOutput::WriteStandard("Tiles of " + to_string(UDF.BatchTileCells) + " cells",
+                                 (Phi.InterfaceCells.size() + UDF.BatchTileCells - 1)/UDF.BatchTileCells);
+    ConsoleOutput::WriteStandard("Differing cells (BatchKernel)", RuntimeDifferences);
+    Differences += RuntimeDifferences;
+
+    /* Compile-time kernel with the default tile size */
+    DF.Clear();
+    UDF.BatchTileCells = 256;
+    UDF.SetDrivingForceBatched(Phi, DF, &Tx, nullptr,
+        [](UserDrivingForceTile& Tile){Kernel(Tile);});
+    const int TemplateDifferences = Compare(Reference, DF.Force, Entries);
+    ConsoleOutput::WriteStandard("Differing cells (inlined kernel)", TemplateDifferences);
+    Differences += TemplateDifferences;
+    ConsoleOutput::WriteLine();
+
+    if(Differences != 0 or Entries == 0)
+    {
+        ConsoleOutput::WriteWarning("Batched driving forces differ from SetDrivingForce()",
+                                    "UserDrivingForceBatched", "main()");
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "Includes.h"
+#include "FileInterface.h"
+#include <chrono>
+#include <functional>
+#include <random>
+
+using namespace std;
+using namespace openphase;
+
+/* Runs Kernel(s) for all operands nRepetitions times, returns the time per call
+in nanoseconds */
+double Time(const size_t nSamples, const int nRepetitions,
+            const function<void(size_t)>& Kernel)
+{
+    auto start = chrono::steady_clock::now();
+    for(int r = 0; r < nRepetitions; r++)
+    for(size_t s = 0; s < nSamples; s++)
+    {
+        Kernel(s);
+    }
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double,nano>(end - start).count()/(nSamples*nRepetitions);
+}
+
+/* Times the eager and the lazy form of an update and compares the results,
+both write into their own result containers */
+template<class V>
+bool Report(const string Name, const size_t nSamples, const int nRepetitions,
+            const vector<V>& ResultEager, const vector<V>& ResultLazy,
+            const function<void(size_t)>& Eager,
+            const function<void(size_t)>& Lazy)
+{
+    const double tEager = Time(nSamples, nRepetitions, Eager);
+    const double tLazy  = Time(nSamples, nRepetitions, Lazy);
+
+    double maxDeviation = 0.0;
+    double maxValue = 0.0;
+    for(size_t s = 0; s < nSamples; s++)
+    for(size_t i = 0; i < ResultEager[s].size(); i++)
+    {
+        maxDeviation = max(maxDeviation, fabs(ResultEager[s][i] - ResultLazy[s][i]));
+        maxValue = max(maxValue, fabs(ResultEager[s][i]));
+    }
+    const bool agree = maxDeviation <= 1.0e-12*max(1.0, maxValue);
+
+    cout << setw(32) << left << Name << right
+         << setw(12) << tEager << " ns"
+         << setw(12) << tLazy  << " ns"
+         << setw(10) << tEager/tLazy
+         << (agree ? "" : "   results differ!") << endl;
+    return agree;
+}
+
+/*********** <<< The Main >>> ***********/
+int main(int argc, char *argv[])
+{
+    string InputFileName = DefaultInputFileName;
+    if (argc > 1) InputFileName = argv[1];
+
+    fstream inpF(InputFileName, ios::in);
+    stringstream inp;
+    inp << inpF.rdbuf();
+    inpF.close();
+    const int    moduleLocation = FileInterface::FindModuleLocation(inp, "VectorExpressions");
+    const size_t nSamples       = FileInterface::ReadParameterI(inp, moduleLocation, string("nSamples"));
+    const size_t nElements      = FileInterface::ReadParameterI(inp, moduleLocation, string("nElements"));
+    const int    nRepetitions   = FileInterface::ReadParameterI(inp, moduleLocation, string("nRepetitions"));
+
+    mt19937 generator(0);
+    uniform_real_distribution<double> random(-1.0, 1.0);
+
+    vector<dVectorN> P(nSamples, dVectorN(nElements));
+    vector<dVectorN> Q(nSamples, dVectorN(nElements));
+    vector<Tensor<double,1>> TP(nSamples, Tensor<double,1>({nElements}));
+    vector<Tensor<double,1>> TQ(nSamples, Tensor<double,1>({nElements}));
+    vector<double> a(nSamples);
+    for(size_t s = 0; s < nSamples; s++)
+    {
+        for(size_t i = 0; i < nElements; i++)
+        {
+            P[s][i] = TP[s][i] = random(generator);
+            Q[s][i] = TQ[s][i] = random(generator);
+        }
+        a[s] = random(generator);
+    }
+    const double b = 0.75;
+    const double c = 1.25;
+
+    vector<dVectorN> EagerN(P);
+    vector<dVectorN> LazyN(P);
+    vector<Tensor<double,1>> EagerT(TP);
+    vector<Tensor<double,1>> LazyT(TP);
+
+    cout << "Time per update of " << nElements << " elements for " << nSamples
+         << " operands and " << nRepetitions << " repetitions" << endl;
+    cout << setw(32) << left << "Update" << right
+         << setw(15) << "eager"
+         << setw(15) << "lazy"
+         << setw(10) << "speedup" << endl;
+
+    bool agree = true;
+    agree &= Report("dVectorN R = (P - Q*a)*b*c", nSamples, nRepetitions, EagerN, LazyN,
+        [&](size_t s){EagerN[s] = (P[s] - Q[s]*a[s])*b*c;},
+        [&](size_t s){LazyN[s] = (lazy(P[s]) - lazy(Q[s])*a[s])*b*c;});
+    agree &= Report("dVectorN R += (P + Q)*0.5", nSamples, nRepetitions, EagerN, LazyN,
+        [&](size_t s){EagerN[s] += (P[s] + Q[s])*0.5;},
+        [&](size_t s){LazyN[s] += (lazy(P[s]) + Q[s])*0.5;});
+    /* The eager Tensor::operator-() evaluates rhs - lhs, the tensor update
+    is therefore timed with a sum */
+    agree &= Report("Tensor<double,1> R = (P + Q*a)*b", nSamples, nRepetitions, EagerT, LazyT,
+        [&](size_t s){EagerT[s] = (TP[s] + TQ[s]*a[s])*b;},
+        [&](size_t s){LazyT[s] = (lazy(TP[s]) + lazy(TQ[s])*a[s])*b;});
+
+    return agree ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -47,6 +47,9 @@ int main(int argc, char *argv[])
     Initializations::Sphere(Phi, 2, 23, 50, 0, 50, BC);
     cout << "Entering the Time Loop!!!" << endl;
 
+    // Interface energy history, used by run.sh for the regression check
+    ofstream EnergyFile("Energy.dat");
+
     for(RTC.tStep = RTC.tStart; RTC.tStep <= RTC.nSteps; RTC.IncrementTimeStep())
     {
         IP.Set(Phi,BC);
@@ -66,6 +69,7 @@ int main(int argc, char *argv[])
             double I_En = DO.AverageEnergyDensity(Phi, IP);
             std::string message  = ConsoleOutput::GetStandard("Interface energy density", to_string(I_En));
             ConsoleOutput::WriteTimeStep(RTC, message);
+            EnergyFile << RTC.tStep << " " << setprecision(10) << I_En << endl;
         }
     } //end of time loop
     return 0;
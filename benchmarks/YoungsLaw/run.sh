@@ -0,0 +1,10 @@
+#!/bin/bash
+./YoungsLaw
+if [ $? == 0 ] #checks if the command executed before was executed successfully.
+then
+echo $(wc -l < Energy.dat) > Results.sim
+# Relative tolerance of 0.1% of the interface energy density
+awk '{ v = $2; if (v < 0.0) v = -v; print "TimeStep" $1 " " $2 " " v*0.001 }' Energy.dat >> Results.sim
+else
+echo "running benchmark YoungsLaw failed"
+fi
@@ -23,9 +23,11 @@
 #include "BoundaryConditions.h"
 #include "InterfaceProperties.h"
 #include "H5Interface.h"
+#include "AsyncOutput.h"
 #include "Tools/TimeInfo.h"
 #include "Tools/MicrostructureAnalysis.h"
 #include "DrivingForce.h"
+#include "PhaseFieldDevice.h"
 #include <cstdlib>
 #include "ConsoleOutput.h"
 
@@ -57,6 +59,10 @@ int main(int argc, char *argv[])
 
     OPSettings.ReadInput(InputFile);
 
+    // VTK, HDF5 visualization and raw data output is written by a background
+    // thread while the time loop continues
+    AsyncOutput::Start();
+
     RunTimeControl              RTC(OPSettings, InputFile);
     PhaseField                  Phi(OPSettings, InputFile);
     DoubleObstacle              DO(OPSettings, InputFile);
@@ -64,9 +70,12 @@ int main(int argc, char *argv[])
     BoundaryConditions          BC(OPSettings, InputFile);
     DrivingForce                dG(OPSettings, InputFile);
     TimeInfo                    Timer(OPSettings, "Execution Time Statistics");
+    PhaseFieldDevice            Device;
+    Device.ReadInput(InputFile);
     
     // Initialize HDF5 output
     H5Interface                 H5;
+    H5.ReadInput(InputFile);
     H5.OpenFile("", "NormalGG_output.h5");
     // WriteSimulationSettings may fail if existing HDF5 structure is incompatible
     try {
@@ -84,29 +93,58 @@ int main(int argc, char *argv[])
     size_t GrainsPhase = 0;
     Initializations::VoronoiTessellation(Phi, BC, number_of_grains, GrainsPhase);
 
-    
+    // Keep the phase fields on the device if $Offload is enabled in the
+    // @PhaseField section and the setup is covered by the device kernels
+    if (Device.Offload)
+    {
+        IP.Set(Phi, BC);
+        Device.Initialize(Phi, IP, BC);
+    }
+
 
     std::cerr << "Starting..." << std::endl;
     for(RTC.tStep = RTC.tStart; RTC.tStep <= RTC.nSteps; RTC.IncrementTimeStep())
     {
         Timer.SetStart();
-        IP.Set(Phi, BC);
-        Timer.SetTimeStamp("IP.Set()");
-        // prepare/apply any thermodynamic driving force acting on interfaces
-        dG.Clear();
-        // Compute curvature-driven contribution by default. To use elastic
-        // driving force instead, configure @ElasticProperties and call
-        // ElasticProperties::CalculateDrivingForce(...) here.
-        DO.CalculateCurvatureDrivingForce(Phi, IP, dG);
-        dG.Average(Phi, BC);
-
-        // Merge driving force into phase-field increments
-        DO.CalculatePhaseFieldIncrements(Phi, IP, dG);
-        Timer.SetTimeStamp("CalculatePhaseFieldIncrements");
-        Phi.NormalizeIncrements(BC, RTC.dt);
-        Timer.SetTimeStamp("NormalizeIncrements");
-        Phi.MergeIncrements(BC, RTC.dt);
-        Timer.SetTimeStamp("MergeIncrements");
+        if (Device.IsAllocated())
+        {
+            // Double obstacle step without the additional averaged driving
+            // force, the phase fields are downloaded only for the output
+            Device.Step(RTC.dt);
+            Timer.SetTimeStamp("Device Step");
+            if (RTC.WriteVTK() or RTC.WriteRawData() or RTC.WriteToScreen() or
+                (RTC.tStep % hdf5Freq) == 0)
+            {
+                Device.CopyToHost(Phi, BC);
+                IP.Set(Phi, BC);
+                Timer.SetTimeStamp("Device CopyToHost");
+            }
+        }
+        else
+        {
+            IP.Set(Phi, BC);
+            Timer.SetTimeStamp("IP.Set()");
+            // prepare/apply any thermodynamic driving force acting on interfaces
+            dG.Clear();
+            // Compute curvature-driven contribution by default. To use elastic
+            // driving force instead, configure @ElasticProperties and call
+            // ElasticProperties::CalculateDrivingForce(...) here.
+            DO.CalculateCurvatureDrivingForce(Phi, IP, dG);
+            dG.Average(Phi, BC);
+
+            // Merge driving force into phase-field increments
+            DO.CalculatePhaseFieldIncrements(Phi, IP, dG);
+            Timer.SetTimeStamp("CalculatePhaseFieldIncrements");
+            Phi.NormalizeIncrements(BC, RTC.dt);
+            Timer.SetTimeStamp("NormalizeIncrements");
+            if (RTC.AdaptiveTimeStep)
+            {
+                RTC.SetTimeStepLimit(IP.ReportMaximumTimeStep(), "InterfaceProperties");
+                RTC.SetTimeStepLimit(Phi.ReportMaximumTimeStep(), "PhaseField");
+            }
+            Phi.MergeIncrements(BC, RTC.dt);
+            Timer.SetTimeStamp("MergeIncrements");
+        }
 
         /// Output to VTK file
         if (RTC.WriteVTK())
@@ -137,17 +175,17 @@ int main(int argc, char *argv[])
             }
 
             // write grain statistics (HDF5)
-            MicrostructureAnalysis::WriteGrainsStatistics(Phi, RTC.tStep, "NormalGG_output.h5");
+            MicrostructureAnalysis::WriteGrainsStatistics(Phi, RTC.tStep, H5);
 
             // Write HDF5 visualization data (for post-processing)
             std::vector<H5Interface::Field_t> FieldsToWrite;
-            FieldsToWrite.push_back(H5Interface::Field_t("PhaseField", 
-                [&Phi](int i, int j, int k) -> std::any {
-                    return Phi.Fields(i,j,k).get_max().value;
+            FieldsToWrite.push_back(H5Interface::Field_t::FromStorage("PhaseField", Phi.Fields,
+                [](const NodePF& locPF) {
+                    return locPF.get_max().value;
                 }));
-            FieldsToWrite.push_back(H5Interface::Field_t("GrainIndex", 
-                [&Phi](int i, int j, int k) -> std::any {
-                    return (double)Phi.Fields(i,j,k).get_max().index;
+            FieldsToWrite.push_back(H5Interface::Field_t::FromStorage("GrainIndex", Phi.Fields,
+                [](const NodePF& locPF) {
+                    return (double)locPF.get_max().index;
                 }));
                         if (OPSettings.WriteDrivingForceH5)
                         {
@@ -188,6 +226,8 @@ int main(int argc, char *argv[])
             Timer.PrintWallClockSummary();
         }
     }
+    // Wait for the pending output
+    AsyncOutput::Stop();
 #ifdef MPI_PARALLEL
     }
     OP_MPI_Finalize ();
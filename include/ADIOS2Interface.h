@@ -0,0 +1,104 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef ADIOS2INTERFACE_H
+#define ADIOS2INTERFACE_H
+
+#include <memory>
+#include <string>
+#include "OutputField.h"
+#include "Settings.h"
+
+namespace openphase
+{
+
+/* ADIOS2 counterpart of H5Interface with the same call sites, the output
+object of a simulation can be swapped without touching the time loop:
+
+    ADIOS2Interface Output;                                                     // instead of H5Interface
+    Output.ReadInput(InputFile);
+    Output.OpenFile("", "NormalGG_output.bp");
+    Output.WriteVisualization(RTC.tStep, OPSettings, FieldsToWrite, 1);
+    Output.WriteCheckPoint(RTC.tStep, "PhaseField", Data);
+
+Every rank writes its own block, no collective hyperslab selection is
+needed. Each call is one ADIOS2 step holding the time step index
+(/Step/TimeStep) and the written variables:
+
+    /Visualization/<Field>                   float, global (Nz, Ny, Nx[, Ncomp])
+    /CheckPoints/<name>/<tStep>[/<leaf>]     double, one local block per rank
+
+The engine and its aggregation are configured by the optional
+@ADIOS2Interface input module. BP5 drains the buffered steps to disk in the
+background (AsyncWrite), SST streams them to a concurrently running analysis
+job. scripts/OpenPhaseADIOS2ToH5.py converts the BP output into the layout of
+H5Interface (/Visualization/<Field>/<tStep>, /CheckPoints/... with the
+RankSizes attribute) for the downstream tools.
+
+    $Engine        ADIOS2 engine (BP5, BP4, SST, ...)           BP5
+    $Aggregators   Number of aggregators (0: engine default)    0
+    $AsyncWrite    Background draining of the BP5 buffers       Yes
+    $Config        ADIOS2 XML configuration file (optional)
+*/
+
+class OP_EXPORTS ADIOS2Interface
+{
+ public:
+    static constexpr auto thisclassname = "ADIOS2Interface";                    ///< Object's implementation class name
+
+    typedef OutputField Field_t;                                                ///< Short hand for a field's name and function which will be written to file
+
+    ADIOS2Interface();
+    ~ADIOS2Interface();
+
+    void ReadInput(const std::string InputFileName);                            ///< Reads the engine settings from the input file
+    void ReadInput(std::stringstream& inp);                                     ///< Reads the engine settings from the input stream
+    void OpenFile(const std::string InputFileName, const std::string OutputFileName);///< Opens the output (collective), InputFileName is the BP file checkpoints are read from
+    void CloseFile(void);                                                       ///< Writes the pending steps and closes the output (collective)
+
+    void WriteVisualization(int tStep,
+        const Settings& locSettings,
+        std::vector<Field_t> ListOfFields,
+        const int resolution);                                                  ///< Writes the fields of the local domain as one step (collective)
+    void WriteCheckPoint(int tStep, std::string name, std::vector<double>& data,
+                         const std::string leaf = "");                          ///< Writes data to /CheckPoints/name/tStep[/leaf], one block per rank (collective)
+    void ReadCheckPoint(int tStep, std::string name, std::vector<double>& data);///< Reads the block of this rank from /CheckPoints/name/tStep
+
+    std::string Engine;                                                         ///< ADIOS2 engine
+    int Aggregators;                                                            ///< Number of aggregators, 0 for the engine default
+    bool AsyncWrite;                                                            ///< Background draining of the BP5 buffers
+    std::string Config;                                                         ///< ADIOS2 XML configuration file
+
+    std::string ADIOS2InputFileName;
+    std::string ADIOS2OutputFileName;
+
+ private:
+    struct Handles;                                                             ///< ADIOS2 objects, defined in the implementation
+    std::unique_ptr<Handles> ADIOS2;
+};
+
+}// namespace openphase
+#endif
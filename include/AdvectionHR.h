@@ -69,6 +69,13 @@ class OP_EXPORTS AdvectionHR : OPObject
             const BoundaryConditions& BC,
             const double dt) const;                                             ///< single-time step compressible advection method
 
+    template<bool compressible = true, class... FieldPairs>
+    void AdvectFields(
+            const Velocities& Vel,
+            const BoundaryConditions& BC,
+            const double dt,
+            FieldPairs... Fields) const;                                        ///< single-time step advection of several fields in one traversal, each field given as std::tie(Field, FieldDot)
+
    template<bool compressible = true, class T, size_t Rank>
    void CalculateAdvectionIncrements(
             const Storage3D<T, Rank>& Field,
@@ -138,6 +145,18 @@ class OP_EXPORTS AdvectionHR : OPObject
             const double dx,
             double (*Limiter)(const double, const double));                                    ///<< Calculates local advection in one direction in calling of AdvectionKernel adequate to data type T
 
+    template<bool compressible, class T, size_t Rank>
+    static void CalculacteLocalAdvectionIncrements(
+            const int i, const int j, const int k,
+            const Storage3D<T, Rank>& Field,
+            Storage3D<T, Rank>& FieldDot,
+            const double v, const double vp, const double vm,
+            int& CFL,
+            const size_t direction,
+            const double dt,
+            const double dx,
+            double (*Limiter)(const double, const double));                     ///<< Same as above with the velocities v(i), v(i+1) and v(i-1) along direction already loaded
+
     template<bool compressible, class T, size_t Rank>
     static void CalculateAdvection(
             Storage3D<T, Rank>& Field,
@@ -249,6 +268,25 @@ void AdvectionHR::CalculacteLocalAdvectionIncrements(
     const double vp = vel(i+ii,j+jj,k+kk)[direction];
     const double vm = vel(i-ii,j-jj,k-kk)[direction];
 
+    CalculacteLocalAdvectionIncrements<compressible>(i,j,k,Field,FieldDot,v,vp,vm,CFL,direction,dt,dx,Limiter);
+}
+
+template<bool compressible, class T, size_t Rank>
+void AdvectionHR::CalculacteLocalAdvectionIncrements(
+        const int i, const int j, const int k,
+        const Storage3D<T, Rank>& Field,
+        Storage3D<T, Rank>& FieldDot,
+        const double v, const double vp, const double vm,
+        int& CFL,
+        const size_t direction,
+        const double dt,
+        const double dx,
+        double (*Limiter)(const double, const double))
+{
+    const int ii = (direction == 0) ? 1 : 0;
+    const int jj = (direction == 1) ? 1 : 0;
+    const int kk = (direction == 2) ? 1 : 0;
+
     const auto& q   = Field(i     ,j     ,k     );
     const auto& qp  = Field(i+  ii,j+  jj,k+  kk);
     const auto& qm  = Field(i-  ii,j-  jj,k-  kk);
@@ -380,6 +418,73 @@ void AdvectionHR::AdvectField(
     OMP_PARALLEL_STORAGE_LOOP_END
 }
 
+template<bool compressible, class... FieldPairs>
+void AdvectionHR::AdvectFields(
+        const Velocities& Vel,
+        const BoundaryConditions& BC,
+        const double dt,
+        FieldPairs... Fields) const
+{
+    /* Fused version of AdvectField() for several fields advected with the
+    same velocity, e.g. Adv.AdvectFields(Vel, BC, dt, std::tie(Stresses,
+    StressesDot), std::tie(Rotations, RotationsDot)). The increments of all
+    fields in all directions are calculated in one traversal, which loads the
+    velocities once per cell, and added in a second one. The fields may have
+    different types but need the same local size. */
+    static_assert(sizeof...(FieldPairs) > 0, "AdvectFields() needs at least one field");
+
+    const auto& Reference = std::get<0>(std::get<0>(std::tie(Fields...)));
+    auto Check = [&Reference](const auto& Pair)
+    {
+        const auto& Field = std::get<0>(Pair);
+        if (Field.Bcells() < 2)
+        {
+            ConsoleOutput::WriteExit("Number of Bcells needs to be 2 or higher.", "AdvectionHR", "AdvectFields");
+            OP_Exit(EXIT_FAILURE);
+        }
+        if (Field.sizeX() != Reference.sizeX() or Field.sizeY() != Reference.sizeY() or Field.sizeZ() != Reference.sizeZ())
+        {
+            ConsoleOutput::WriteExit("All advected fields need the same size.", "AdvectionHR", "AdvectFields");
+            OP_Exit(EXIT_FAILURE);
+        }
+    };
+    (Check(Fields), ...);
+
+    const Storage3D<dVector3, 0>& vel = Vel.Average;
+    const double dx = Vel.Grid.dx;
+    const bool Active[3] = {Vel.Grid.dNx != 0, Vel.Grid.dNy != 0, Vel.Grid.dNz != 0};
+
+    int CFL = 0;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Reference,0,reduction(+:CFL))
+    {
+        for (size_t direction = 0; direction < 3; direction++)
+        if (Active[direction])
+        {
+            const int ii = (direction == 0) ? 1 : 0;
+            const int jj = (direction == 1) ? 1 : 0;
+            const int kk = (direction == 2) ? 1 : 0;
+
+            const double v  = vel(i   ,j    ,k  )[direction];
+            const double vp = vel(i+ii,j+jj,k+kk)[direction];
+            const double vm = vel(i-ii,j-jj,k-kk)[direction];
+
+            (CalculacteLocalAdvectionIncrements<compressible>(i,j,k,std::get<0>(Fields),std::get<1>(Fields),v,vp,vm,CFL,direction,dt,dx,Limiter), ...);
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    auto Update = [dt](const int i, const int j, const int k, auto& Pair)
+    {
+        std::get<0>(Pair)(i,j,k) += std::get<1>(Pair)(i,j,k)*dt;
+        std::get<1>(Pair)(i,j,k) *= 0;
+    };
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Reference,0,)
+    {
+        (Update(i,j,k,Fields), ...);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
 template<bool compressible, class T, size_t Rank>
 void AdvectionHR::CalculateAdvection(
         Storage3D<T, Rank>& Field,
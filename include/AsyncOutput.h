@@ -0,0 +1,116 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef ASYNCOUTPUT_H
+#define ASYNCOUTPUT_H
+
+#include "Includes.h"
+#include <any>
+
+namespace openphase
+{
+
+/* Background output service. The output routines (VTK::Write(),
+VTK::WriteCompressed(), H5Interface::WriteVisualization() and the raw data
+writers using WriteFile()) take a snapshot of the data into a staging buffer
+and submit the formatting, compression and disk I/O as a task to dedicated
+I/O threads, the time loop continues meanwhile. The staged memory is limited,
+Submit() blocks until enough of the earlier tasks are finished. Without
+Start() all output is written immediately by the calling thread.
+
+    AsyncOutput::Start(2);                                                      // two I/O threads
+    ...                                                                         // time loop with output
+    AsyncOutput::Flush();                                                       // barrier, e.g. at a checkpoint
+    ...
+    AsyncOutput::Stop();                                                        // finishes all pending output
+
+In MPI parallel mode the VTK and parallel HDF5 output is written with
+collective MPI calls and stays synchronous, raw data files are per rank and
+are written in the background. */
+
+class OP_EXPORTS AsyncOutput                                                    ///< Asynchronous output service
+{
+ public:
+    static constexpr auto thisclassname = "AsyncOutput";                        ///< Object's implementation class name
+    static constexpr size_t DefaultMemoryLimit = size_t(1) << 30;               ///< Default limit of the staged memory in bytes
+
+    static void Start(const size_t nThreads = 1,
+                      const size_t MemoryLimit = DefaultMemoryLimit);           ///< Starts the I/O threads
+    static void Stop(void);                                                     ///< Writes all pending output and stops the I/O threads
+    static void Flush(void);                                                    ///< Waits until all submitted output is written (no effect on the I/O threads)
+    static bool Active(void);                                                   ///< True if output is deferred (false on the I/O threads)
+    static void Submit(std::function<void()> Task, const size_t Bytes);         ///< Executes Task in the background, Bytes is its staged memory
+    static void WriteFile(const std::string& FileName, std::string&& Data);     ///< Writes Data to FileName in the background
+
+    template<class field_t>
+    static bool Snapshot(std::vector<field_t>& ListOfFields,
+                         const long int Nx, const long int Ny, const long int Nz,
+                         size_t& Bytes)                                         ///< Replaces the field functions by their tabulated values
+    {
+        /* Returns false if a field returns a type which can not be staged,
+        the output then has to be written synchronously */
+        std::vector<field_t> StagedFields = ListOfFields;
+        Bytes = 0;
+        for(auto& Field : StagedFields)
+        {
+            if(not (SnapshotAs<int>       (Field, Nx, Ny, Nz, Bytes) or
+                    SnapshotAs<size_t>    (Field, Nx, Ny, Nz, Bytes) or
+                    SnapshotAs<double>    (Field, Nx, Ny, Nz, Bytes) or
+                    SnapshotAs<dVector3>  (Field, Nx, Ny, Nz, Bytes) or
+                    SnapshotAs<dVector6>  (Field, Nx, Ny, Nz, Bytes) or
+                    SnapshotAs<vStrain>   (Field, Nx, Ny, Nz, Bytes) or
+                    SnapshotAs<vStress>   (Field, Nx, Ny, Nz, Bytes) or
+                    SnapshotAs<dMatrix3x3>(Field, Nx, Ny, Nz, Bytes) or
+                    SnapshotAs<dMatrix6x6>(Field, Nx, Ny, Nz, Bytes)))
+            {
+                return false;
+            }
+        }
+        ListOfFields = std::move(StagedFields);
+        return true;
+    }
+
+ private:
+    template<class T, class field_t>
+    static bool SnapshotAs(field_t& Field,
+                           const long int Nx, const long int Ny, const long int Nz,
+                           size_t& Bytes)
+    {
+        if(Field.ValueType() != typeid(T)) return false;
+
+        auto Values = std::make_shared<const std::vector<T>>(Field.template Values<T>(Nx, Ny, Nz));
+        Bytes += Values->size()*sizeof(T);
+        Field = field_t::Typed(Field.Name, [Values, Nx, Ny](const int i, const int j, const int k)
+        {
+            return (*Values)[(k*Ny + j)*Nx + i];
+        });
+        return true;
+    }
+    static void Worker(void);                                                   ///< Main loop of the I/O threads
+};
+
+}// namespace openphase
+#endif
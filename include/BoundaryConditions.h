@@ -29,6 +29,7 @@
 #define BOUNDARYCONDITIONS_H
 
 #include "Includes.h"
+#include "Tools/TimeInfo.h"
 
 namespace openphase
 {
@@ -45,6 +46,12 @@ enum class BoundaryConditionTypes
     MPIcomm,                                                                    ///< Adjacent boundaries communication between neighboring blocks in MPI parallel mode
 };
 
+enum class HaloThreadingModes                                                   ///< Threading of the halo exchange in ExchangeAndApply()
+{
+    Master,                                                                     ///< The exchange is done between the OpenMP parallel loops
+    Overlap,                                                                    ///< One OpenMP thread exchanges the halo while the others update the interior
+};
+
 class OP_EXPORTS BoundaryConditions : public OPObject
 {
  public:
@@ -64,6 +71,12 @@ class OP_EXPORTS BoundaryConditions : public OPObject
     void SetY(Storage3D<T, Num>& loc3Dstorage) const;                           /// Set boundary conditions for standard values storage along Y boundaries
     template< class T, size_t Num >
     void SetZ(Storage3D<T, Num>& loc3Dstorage) const;                           /// Set boundary conditions for standard values storage along Z boundaries
+    template< class T, size_t Num >
+    void SetLocal(Storage3D<T, Num>& loc3Dstorage) const;                       /// Set the boundary conditions which need no MPI communication along all boundaries, MPI halos are left unchanged
+    template< class T, size_t Num >
+    void SetAll(Storage3D<T, Num>& loc3Dstorage) const;                         /// Same as SetX(), SetY() and SetZ(), copies all halo layers in a single parallel region if no MPI exchange is needed
+    template< class T, size_t Num >
+    void SetLocalTeam(Storage3D<T, Num>& loc3Dstorage) const;                   /// Same as SetLocal(), has to be called by all threads of an enclosing parallel region
 
     template< class T>
     void SetXVector(Storage3D<T, 0>& loc3Dstorage) const;                       /// Set boundary conditions for vector values storage along X boundaries
@@ -113,6 +126,56 @@ class OP_EXPORTS BoundaryConditions : public OPObject
     void SetYFlags(Storage3D<T, Num>& loc3Dstorage) const;                      /// Set boundary conditions for storage of flags along Y boundaries
     template< class T, size_t Num >
     void SetZFlags(Storage3D<T, Num>& loc3Dstorage) const;                      /// Set boundary conditions for storage of flags along Z boundaries
+
+    /* Split-phase boundary conditions: BeginExchange() starts the MPI halo
+    exchange along X and returns immediately, EndExchange() waits for it and
+    sets the remaining boundary conditions in all directions. The result is the
+    same as calling SetX(), SetY() and SetZ(). Between the two calls the cells
+    which do not read the boundary cells can be updated, but the storage must
+    not be reallocated and, for storages of arithmetic values which are sent
+    directly from the storage memory, the outermost "Bcells" layers of the
+    interior must not be modified. Only one split-phase exchange can be in
+    flight per BoundaryConditions object. Without MPI BeginExchange() does
+    nothing. */
+    template< class T, size_t Num >
+    void BeginExchange(Storage3D<T, Num>& loc3Dstorage) const;                  /// Starts the halo exchange of standard values storage along X boundaries
+    template< class T, size_t Num >
+    void EndExchange(Storage3D<T, Num>& loc3Dstorage) const;                    /// Completes the halo exchange and sets boundary conditions along all boundaries
+    template< class T>
+    void BeginExchangeVector(Storage3D<T, 1>& loc3Dstorage) const;              /// Starts the halo exchange of vector values storage along X boundaries
+    template< class T>
+    void EndExchangeVector(Storage3D<T, 1>& loc3Dstorage) const;                /// Completes the halo exchange and sets boundary conditions along all boundaries
+
+    /* Split-phase exchange of lattice Boltzmann populations before streaming.
+    Same as BeginExchangeVector() and EndExchangeVector(), but across process
+    boundaries only the populations which stream into the neighbor process are
+    sent (9 of 27 per cell and face, edges and corners are forwarded by the
+    successive X, Y and Z exchanges). The remaining populations in the halo are
+    not updated. Other storages are exchanged completely. */
+    template< class T>
+    void BeginExchangePopulations(Storage3D<T, 1>& loc3Dstorage) const;         /// Starts the streaming halo exchange of populations along X boundaries
+    template< class T>
+    void EndExchangePopulations(Storage3D<T, 1>& loc3Dstorage) const;           /// Completes the streaming halo exchange and sets boundary conditions along all boundaries
+
+    /* Sets the boundary conditions of the storage like SetX(), SetY() and
+    SetZ() and calls function(i,j,k) for every cell of the storage loop with
+    "bcells" boundary cells. Cells at least "reach" cells away from the storage
+    boundaries are processed while the halo is exchanged, the remaining ones
+    afterwards, the same restrictions as for BeginExchange() apply. With
+    HaloThreading == Master (default) the exchange is done by the calling
+    thread between two OpenMP parallel loops. With HaloThreading == Overlap
+    ($HaloThreading OVERLAP) all work is done in a single parallel region: one
+    thread exchanges the halo and joins the interior loop afterwards, the other
+    threads update the interior in the meantime, so the communication is
+    overlapped with the computation also if the MPI library only progresses
+    inside MPI calls. The exchanging thread is the master thread, as required
+    by MPI_THREAD_FUNNELED, or the first free thread if MPI provides
+    MPI_THREAD_MULTIPLE. Boundary conditions which are set by OpenMP loops run
+    on the exchanging thread only. Without MPI both modes are the same. */
+    template< class T, size_t Num, class Function >
+    void ExchangeAndApply(Storage3D<T, Num>& loc3Dstorage, const int reach,
+                          const long int bcells, Function&& function) const;    /// Exchanges the halo and applies function(i,j,k) to the cells of the storage loop with bcells boundary cells, overlapping both
+
     void Initialize(Settings& Settings, std::string ObjectNameSuffix = "") override;/// Initializes the class's variables
     void ReadInput(std::string InputFileName) override;                         /// Read boundary conditions
     void ReadInput(std::stringstream& inp) override;
@@ -130,6 +193,8 @@ class OP_EXPORTS BoundaryConditions : public OPObject
     BoundaryConditionTypes BC0Z;
     BoundaryConditionTypes BCNZ;
 
+    HaloThreadingModes HaloThreading;                                           ///< Threading of the halo exchange in ExchangeAndApply()
+
 #ifdef MPI_PARALLEL
     bool Setup_MPI();                                                           /// Setting up 1D MPI domain decomposition along a single X dimension
     bool Setup_MPIX();                                                          /// Setting up 3D MPI domain decomposition along X dimension
@@ -139,6 +204,11 @@ class OP_EXPORTS BoundaryConditions : public OPObject
     bool MPIperiodicX;
     bool MPIperiodicY;
     bool MPIperiodicZ;
+    bool HaloThreadMultiple;                                                    ///< MPI provides MPI_THREAD_MULTIPLE, any thread may exchange the halo
+
+    bool HaloNeighbors(const int direction, const bool decomposition3D,
+                       int& LeftProcess, int& RightProcess,
+                       bool& exchangeLeft, bool& exchangeRight) const;          ///< Neighbor processes along "direction", returns false if there are none
 
     template<typename A> void Communicate(A& storage) const;
     template<typename A> void CommunicateX(A& storage) const;
@@ -147,10 +217,229 @@ class OP_EXPORTS BoundaryConditions : public OPObject
 #endif
 
     BoundaryConditionTypes TranslateBoundaryConditions(std::string Key);        ///< Translates input string into the valid boundary condition designation
+    HaloThreadingModes TranslateHaloThreading(std::string Key);                 ///< Translates input string into the halo exchange threading mode
  protected:
  private:
+    template< class T, size_t Num >
+    void SetXLocal(Storage3D<T, Num>& loc3Dstorage) const;                      /// Set non-communicating boundary conditions for standard values storage along X boundaries
+    template< class T, size_t Num >
+    void SetYLocal(Storage3D<T, Num>& loc3Dstorage) const;                      /// Set non-communicating boundary conditions for standard values storage along Y boundaries
+    template< class T, size_t Num >
+    void SetZLocal(Storage3D<T, Num>& loc3Dstorage) const;                      /// Set non-communicating boundary conditions for standard values storage along Z boundaries
+    template< class T>
+    void SetXVectorLocal(Storage3D<T, 1>& loc3Dstorage) const;                  /// Set non-communicating boundary conditions for vector values storage along X boundaries
+    template< class T>
+    void SetYVectorLocal(Storage3D<T, 1>& loc3Dstorage) const;                  /// Set non-communicating boundary conditions for vector values storage along Y boundaries
+    template< class T>
+    void SetZVectorLocal(Storage3D<T, 1>& loc3Dstorage) const;                  /// Set non-communicating boundary conditions for vector values storage along Z boundaries
+
+    bool HaloLayers(const BoundaryConditionTypes BC0,
+                    const BoundaryConditionTypes BCN,
+                    const long int size, const long int bcells,
+                    std::vector<std::array<long int,2>>& Layers) const;         /// Destination and source positions of the halo layers set by copying (periodic, no-flux and mirror), returns true if a free boundary remains to be set
+    template< class T, size_t Num >
+    static void CopyLayersX(Storage3D<T, Num>& Field,
+                            const std::vector<std::array<long int,2>>& Layers); /// Copies the X halo layers, to be called inside a parallel region
+    template< class T, size_t Num >
+    static void CopyLayersY(Storage3D<T, Num>& Field,
+                            const std::vector<std::array<long int,2>>& Layers); /// Copies the Y halo layers, to be called inside a parallel region
+    template< class T, size_t Num >
+    static void CopyLayersZ(Storage3D<T, Num>& Field,
+                            const std::vector<std::array<long int,2>>& Layers); /// Copies the Z halo layers, to be called inside a parallel region
+
+#ifdef MPI_PARALLEL
+    bool ExchangesX(void) const;                                                ///< False for periodic X boundaries, which are set locally without halo exchange
+    bool ExchangesY(void) const;                                                ///< False for periodic Y boundaries, which are set locally without halo exchange
+    bool ExchangesZ(void) const;                                                ///< False for periodic Z boundaries, which are set locally without halo exchange
+
+    template<typename A>
+    void ExchangeHalo(A& storage, const int direction,
+                      const int LeftProcess, const int RightProcess,
+                      const bool exchangeLeft, const bool exchangeRight,
+                      const bool streaming = false) const;                      ///< Exchanges the halo along "direction" with the neighboring processes
+    template<typename A>
+    void BeginHalo(A& storage, const int direction,
+                   const int LeftProcess, const int RightProcess,
+                   const bool exchangeLeft, const bool exchangeRight,
+                   const bool streaming = false) const;                         ///< Starts the nonblocking halo exchange along "direction", "streaming" sends only the populations streaming into the neighbors
+    template<typename A>
+    void EndHalo(A& storage, const int direction) const;                        ///< Waits for the halo exchange started by BeginHalo() and unpacks the received halo
+
+    static void* BeginHaloDirect(const void* storage, void* data, const OP_MPI_Datatype type,
+                      const std::array<int,4>& sizes, const std::array<int,3>& halo,
+                      const int direction,
+                      const int LeftProcess, const int RightProcess,
+                      const bool exchangeLeft, const bool exchangeRight);       ///< Starts the zero-copy halo exchange of "storage" (the plan key) using cached subarray datatypes and persistent requests bound to "data", returns the exchange plan
+    static void EndHaloDirect(void* plan);                                      ///< Waits for the requests of the exchange plan returned by BeginHaloDirect()
+    static void SetupSharedHalo(const double MegaBytes);                        ///< Allocates the node shared memory window for intra-node halo exchange (collective, once)
+
+    template<typename A>
+    static std::vector<long int> HaloWindow(const A& storage, const int direction,
+                                            const long int lower,
+                                            const long int upper);              ///< Packing window spanning [lower, upper) along "direction" and the full storage otherwise
+
+    struct HaloExchangeState                                                    ///< Buffers and requests of the halo exchange along a single direction
+    {
+        std::vector<double> SendLeft;                                           ///< Packing buffers, reused between the exchanges
+        std::vector<double> SendRight;
+        std::vector<double> RecvLeft;
+        std::vector<double> RecvRight;
+
+        int SendLeftSize  = 0;                                                  ///< Buffer sizes sent to and received from the neighbors
+        int SendRightSize = 0;
+        int RecvLeftSize  = 0;
+        int RecvRightSize = 0;
+
+        void* RequestSendLeft      = nullptr;
+        void* RequestSendLeftSize  = nullptr;
+        void* RequestSendRight     = nullptr;
+        void* RequestSendRightSize = nullptr;
+        void* RequestRecvLeft      = nullptr;
+        void* RequestRecvLeftSize  = nullptr;
+        void* RequestRecvRight     = nullptr;
+        void* RequestRecvRightSize = nullptr;
+
+        int  LeftProcess   = 0;
+        int  RightProcess  = 0;
+        bool ExchangeLeft  = false;
+        bool ExchangeRight = false;
+        bool Streaming     = false;                                             ///< Only the populations streaming into the neighbors are exchanged
+
+        const void* Storage = nullptr;                                          ///< Storage which is being exchanged, nullptr if no exchange is in flight
+        void* Plan = nullptr;                                                   ///< Exchange plan of the direct exchange
+    };
+    mutable std::array<HaloExchangeState,3> HaloExchanges;                      ///< Halo exchange state of each direction
+#endif
+};
+
+#ifdef MPI_PARALLEL
+/* Storages of arithmetic values are exchanged directly from and into the
+storage memory using MPI derived datatypes. All other storages are packed into
+buffers of doubles using the pack()/unpack() methods of the stored type. */
+
+template<class T>
+struct HaloMPIDatatype                                                          ///< MPI datatype of the storage values, if they can be exchanged directly
+{
+    static constexpr bool Direct = false;
+};
+template<>
+struct HaloMPIDatatype<double>
+{
+    static constexpr bool Direct = true;
+    static constexpr OP_MPI_Datatype Type = OP_MPI_DOUBLE;
+};
+template<>
+struct HaloMPIDatatype<float>
+{
+    static constexpr bool Direct = true;
+    static constexpr OP_MPI_Datatype Type = OP_MPI_FLOAT;
+};
+template<>
+struct HaloMPIDatatype<int>
+{
+    static constexpr bool Direct = true;
+    static constexpr OP_MPI_Datatype Type = OP_MPI_INT;
+};
+template<>
+struct HaloMPIDatatype<long int>
+{
+    static constexpr bool Direct = true;
+    static constexpr OP_MPI_Datatype Type = OP_MPI_LONG;
+};
+template<>
+struct HaloMPIDatatype<unsigned long int>
+{
+    static constexpr bool Direct = true;
+    static constexpr OP_MPI_Datatype Type = OP_MPI_UNSIGNED_LONG;
+};
+
+template<class A>
+struct HaloStorage                                                              ///< Memory layout access for the direct halo exchange
+{
+    static constexpr bool Direct = false;
+};
+template<class T, size_t Rank>
+struct HaloStorage<Storage3D<T,Rank>>
+{
+    typedef T Value;
+    static constexpr bool Direct = HaloMPIDatatype<T>::Direct;
+    static void* Data(Storage3D<T,Rank>& storage)
+    {
+        return &storage(-storage.BcellsX(),-storage.BcellsY(),-storage.BcellsZ())[0];
+    }
+    static int Components(const Storage3D<T,Rank>& storage)
+    {
+        return storage(0,0,0).size();
+    }
+};
+template<class T>
+struct HaloStorage<Storage3D<T,0>>
+{
+    typedef T Value;
+    static constexpr bool Direct = HaloMPIDatatype<T>::Direct;
+    static void* Data(Storage3D<T,0>& storage)
+    {
+        return &storage(-storage.BcellsX(),-storage.BcellsY(),-storage.BcellsZ());
+    }
+    static int Components(const Storage3D<T,0>&)
+    {
+        return 1;
+    }
+};
 
+/* Populations which provide packFace(buffer, direction, sign) and the matching
+unpackFace() can be exchanged before streaming by sending only the populations
+which cross the process boundary: to the left neighbor the ones moving in the
+negative "direction", to the right neighbor the ones moving in the positive
+"direction". */
+template<class A, class = void>
+struct HaloPopulations                                                          ///< Direction-aware packing of lattice Boltzmann populations
+{
+    static constexpr bool Minimal = false;
+    static void pack(A& storage, std::vector<double>& buffer,
+                     const std::vector<long int>& window, const int, const int)
+    {
+        storage.pack(buffer, window);
+    }
+    static void unpack(A& storage, std::vector<double>& buffer,
+                       const std::vector<long int>& window, const int, const int)
+    {
+        storage.unpack(buffer, window);
+    }
 };
+template<class T>
+struct HaloPopulations<Storage3D<T,1>, std::void_t<decltype(std::declval<T&>().packFace(
+                       std::declval<std::vector<double>&>(), 0, 0))>>
+{
+    static constexpr bool Minimal = true;
+    static void pack(Storage3D<T,1>& storage, std::vector<double>& buffer,
+                     const std::vector<long int>& window,
+                     const int direction, const int sign)
+    {
+        buffer.clear();
+        for (long int i = window[0]; i < window[1]; ++i)
+        for (long int j = window[2]; j < window[3]; ++j)
+        for (long int k = window[4]; k < window[5]; ++k)
+        for (size_t n = 0; n < storage(i,j,k).size(); ++n)
+        {
+            storage(i,j,k)[n].packFace(buffer, direction, sign);
+        }
+    }
+    static void unpack(Storage3D<T,1>& storage, std::vector<double>& buffer,
+                       const std::vector<long int>& window,
+                       const int direction, const int sign)
+    {
+        size_t it = 0;
+        for (long int i = window[0]; i < window[1]; ++i)
+        for (long int j = window[2]; j < window[3]; ++j)
+        for (long int k = window[4]; k < window[5]; ++k)
+        for (size_t n = 0; n < storage(i,j,k).size(); ++n)
+        {
+            storage(i,j,k)[n].unpackFace(buffer, it, direction, sign);
+        }
+    }
+};
+#endif
 
 inline long int BoundaryConditions::Index(const long int x, const long int y, const long int z,
                                           const long int Nx, const long int Ny, const long int Nz,
@@ -693,52 +982,38 @@ void BoundaryConditions::SetZFlags(Storage3D<T, Num> &Field) const
 template< class T, size_t Num >
 void BoundaryConditions::SetX(Storage3D<T, Num> &Field) const
 {
-    if(Field.BcellsX())
+    SetXLocal(Field);
+#ifdef MPI_PARALLEL
+    if(Field.BcellsX() and ExchangesX())
     {
-        if(BC0X == BoundaryConditionTypes::Periodic or
-           BCNX == BoundaryConditionTypes::Periodic)
+        if(MPI_3D_DECOMPOSITION)
         {
+            CommunicateX(Field);
+        }
+        else
+        {
+            Communicate(Field);
+        }
+    }
+#endif
+}
+template< class T, size_t Num >
+void BoundaryConditions::SetXLocal(Storage3D<T, Num> &Field) const
+{
+    if(Field.BcellsX())
+    {
+        std::vector<std::array<long int,2>> Layers;
+        const bool Free = HaloLayers(BC0X, BCNX, Field.sizeX(), Field.BcellsX(), Layers);
 #ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
+#pragma omp parallel
 #endif
-            for(long int i = -Field.BcellsX(); i < 0; i++)
-            for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-            for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-            {
-                Field(i, j, k) = Field((Field.sizeX() + i)%Field.sizeX(), j, k);
-                Field(Field.sizeX() - i - 1, j, k) = Field((- i - 1)%Field.sizeX(), j, k);
-            }
-            return;
+        {
+            CopyLayersX(Field, Layers);
         }
+        if(not Free) return;
 
         switch (BC0X)
         {
-            case BoundaryConditionTypes::NoFlux:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < 0; i++)
-                for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-                for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-                {
-                    Field(i, j, k) = Field((-i - 1)%Field.sizeX(), j, k);
-                }
-                break;
-            }
-            case BoundaryConditionTypes::Mirror:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < 0; i++)
-                for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-                for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-                {
-                    Field(i, j, k) = Field((-i)%Field.sizeX(), j, k);
-                }
-                break;
-            }
             case BoundaryConditionTypes::Free:
             {
 #ifdef _OPENMP
@@ -753,7 +1028,6 @@ void BoundaryConditions::SetX(Storage3D<T, Num> &Field) const
                 }
                 break;
             }
-            case BoundaryConditionTypes::Fixed: [[fallthrough]];
             default:
             {
                 break;
@@ -762,32 +1036,6 @@ void BoundaryConditions::SetX(Storage3D<T, Num> &Field) const
 
         switch (BCNX)
         {
-            case BoundaryConditionTypes::NoFlux:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < 0; i++)
-                for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-                for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-                {
-                    Field(Field.sizeX() - i - 1, j, k) = Field((Field.sizeX() + i)%Field.sizeX(), j, k);
-                }
-                break;
-            }
-            case BoundaryConditionTypes::Mirror:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < 0; i++)
-                for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-                for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-                {
-                    Field(Field.sizeX() - i - 1, j, k) = Field((Field.sizeX() + i - 1)%Field.sizeX(), j, k);
-                }
-                break;
-            }
             case BoundaryConditionTypes::Free:
             {
 #ifdef _OPENMP
@@ -803,73 +1051,41 @@ void BoundaryConditions::SetX(Storage3D<T, Num> &Field) const
                 }
                 break;
             }
-            case BoundaryConditionTypes::Fixed: [[fallthrough]];
             default:
             {
                 break;
             }
         }
-#ifdef MPI_PARALLEL
-        if(MPI_3D_DECOMPOSITION)
-        {
-            CommunicateX(Field);
-        }
-        else
-        {
-            Communicate(Field);
-        }
-#endif
     }
 }
 template< class T, size_t Num >
 void BoundaryConditions::SetY(Storage3D<T, Num> &Field) const
+{
+    SetYLocal(Field);
+#ifdef MPI_PARALLEL
+    if(Field.BcellsY() and ExchangesY() and MPI_3D_DECOMPOSITION)
+    {
+        CommunicateY(Field);
+    }
+#endif
+}
+template< class T, size_t Num >
+void BoundaryConditions::SetYLocal(Storage3D<T, Num> &Field) const
 {
     if(Field.BcellsY())
     {
-        if(BC0Y == BoundaryConditionTypes::Periodic or
-           BCNY == BoundaryConditionTypes::Periodic)
-        {
+        std::vector<std::array<long int,2>> Layers;
+        const bool Free = HaloLayers(BC0Y, BCNY, Field.sizeY(), Field.BcellsY(), Layers);
 #ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
+#pragma omp parallel
 #endif
-            for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-            for(long int j = -Field.BcellsY(); j < 0; j++)
-            for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-            {
-                Field(i, j, k) = Field(i, (Field.sizeY() + j)%Field.sizeY(), k);
-                Field(i, Field.sizeY() - j - 1, k) = Field(i, (-j - 1)%Field.sizeY(), k);
-            }
-            return;
+        {
+            CopyLayersY(Field, Layers);
         }
+        if(not Free) return;
 
         switch (BC0Y)
         {
-            case BoundaryConditionTypes::NoFlux:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-                for(long int j = -Field.BcellsY(); j < 0; j++)
-                for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-                {
-                    Field(i, j, k) = Field(i, (-j - 1)%Field.sizeY(), k);
-                }
-                break;
-            }
-            case BoundaryConditionTypes::Mirror:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-                for(long int j = -Field.BcellsY(); j < 0; j++)
-                for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-                {
-                    Field(i, j, k) = Field(i, (-j)%Field.sizeY(), k);
-                }
-                break;
-            }
             case BoundaryConditionTypes::Free:
             {
 #ifdef _OPENMP
@@ -884,7 +1100,6 @@ void BoundaryConditions::SetY(Storage3D<T, Num> &Field) const
                 }
                 break;
             }
-            case BoundaryConditionTypes::Fixed: [[fallthrough]];
             default:
             {
                 break;
@@ -893,32 +1108,6 @@ void BoundaryConditions::SetY(Storage3D<T, Num> &Field) const
 
         switch (BCNY)
         {
-            case BoundaryConditionTypes::NoFlux:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-                for(long int j = -Field.BcellsY(); j < 0; j++)
-                for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-                {
-                    Field(i, Field.sizeY() - j - 1, k) = Field(i, (Field.sizeY() + j)%Field.sizeY(), k);
-                }
-                break;
-            }
-            case BoundaryConditionTypes::Mirror:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-                for(long int j = -Field.BcellsY(); j < 0; j++)
-                for(long int k = -Field.BcellsZ(); k < Field.sizeZ() + Field.BcellsZ(); k++)
-                {
-                    Field(i, Field.sizeY() - j - 1, k) = Field(i, (Field.sizeY() + j - 1)%Field.sizeY(), k);
-                }
-                break;
-            }
             case BoundaryConditionTypes::Free:
             {
 #ifdef _OPENMP
@@ -934,69 +1123,41 @@ void BoundaryConditions::SetY(Storage3D<T, Num> &Field) const
                 }
                 break;
             }
-            case BoundaryConditionTypes::Fixed: [[fallthrough]];
             default:
             {
                 break;
             }
         }
-#ifdef MPI_PARALLEL
-        if(MPI_3D_DECOMPOSITION)
-        {
-            CommunicateY(Field);
-        }
-#endif
     }
 }
 template< class T, size_t Num >
 void BoundaryConditions::SetZ(Storage3D<T, Num> &Field) const
+{
+    SetZLocal(Field);
+#ifdef MPI_PARALLEL
+    if(Field.BcellsZ() and ExchangesZ() and MPI_3D_DECOMPOSITION)
+    {
+        CommunicateZ(Field);
+    }
+#endif
+}
+template< class T, size_t Num >
+void BoundaryConditions::SetZLocal(Storage3D<T, Num> &Field) const
 {
     if(Field.BcellsZ())
     {
-        if(BC0Z == BoundaryConditionTypes::Periodic or
-           BCNZ == BoundaryConditionTypes::Periodic)
-        {
+        std::vector<std::array<long int,2>> Layers;
+        const bool Free = HaloLayers(BC0Z, BCNZ, Field.sizeZ(), Field.BcellsZ(), Layers);
 #ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
+#pragma omp parallel
 #endif
-            for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-            for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-            for(long int k = -Field.BcellsZ(); k < 0; k++)
-            {
-                Field(i, j, k) = Field(i, j, (Field.sizeZ() + k)%Field.sizeZ());
-                Field(i, j, Field.sizeZ() - k - 1) = Field(i, j, (-k - 1)%Field.sizeZ());
-            }
-            return;
+        {
+            CopyLayersZ(Field, Layers);
         }
+        if(not Free) return;
 
         switch (BC0Z)
         {
-            case BoundaryConditionTypes::NoFlux:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-                for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-                for(long int k = -Field.BcellsZ(); k < 0; k++)
-                {
-                    Field(i, j, k) = Field(i, j, (-k - 1)%Field.sizeZ());
-                }
-                break;
-            }
-            case BoundaryConditionTypes::Mirror:
-            {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-                for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-                for(long int k = -Field.BcellsZ(); k < 0; k++)
-                {
-                    Field(i, j, k) = Field(i, j, (-k)%Field.sizeZ());
-                }
-                break;
-            }
             case BoundaryConditionTypes::Free:
             {
 #ifdef _OPENMP
@@ -1011,7 +1172,6 @@ void BoundaryConditions::SetZ(Storage3D<T, Num> &Field) const
                 }
                 break;
             }
-            case BoundaryConditionTypes::Fixed: [[fallthrough]];
             default:
             {
                 break;
@@ -1020,7 +1180,7 @@ void BoundaryConditions::SetZ(Storage3D<T, Num> &Field) const
 
         switch (BCNZ)
         {
-            case BoundaryConditionTypes::NoFlux:
+            case BoundaryConditionTypes::Free:
             {
 #ifdef _OPENMP
 #pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
@@ -1029,50 +1189,149 @@ void BoundaryConditions::SetZ(Storage3D<T, Num> &Field) const
                 for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
                 for(long int k = -Field.BcellsZ(); k < 0; k++)
                 {
-                    Field(i, j, Field.sizeZ() - k - 1) = Field(i, j, (Field.sizeZ() + k)%Field.sizeZ());
+                    const long int k0 = Field.sizeZ() - 1;
+                    Field(i, j, k0 - k) = Field(i, j, k0)
+                        +(Field(i, j, k0) - Field(i, j, (k0-1)%Field.sizeZ()))*(-k);
                 }
                 break;
             }
-            case BoundaryConditionTypes::Mirror:
+            default:
             {
-#ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
-#endif
-                for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-                for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-                for(long int k = -Field.BcellsZ(); k < 0; k++)
-                {
-                    Field(i, j, Field.sizeZ() - k - 1) = Field(i, j, (Field.sizeZ() + k - 1)%Field.sizeZ());
-                }
                 break;
             }
-            case BoundaryConditionTypes::Free:
-            {
+        }
+    }
+}
+
+template< class T, size_t Num >
+void BoundaryConditions::SetLocal(Storage3D<T, Num>& loc3Dstorage) const
+{
+    std::vector<std::array<long int,2>> LayersX;
+    std::vector<std::array<long int,2>> LayersY;
+    std::vector<std::array<long int,2>> LayersZ;
+
+    if(HaloLayers(BC0X, BCNX, loc3Dstorage.sizeX(), loc3Dstorage.BcellsX(), LayersX) or
+       HaloLayers(BC0Y, BCNY, loc3Dstorage.sizeY(), loc3Dstorage.BcellsY(), LayersY) or
+       HaloLayers(BC0Z, BCNZ, loc3Dstorage.sizeZ(), loc3Dstorage.BcellsZ(), LayersZ))
+    {
+        SetXLocal(loc3Dstorage);
+        SetYLocal(loc3Dstorage);
+        SetZLocal(loc3Dstorage);
+        return;
+    }
+
+    /* All halo layers are copies, they are set in a single parallel region.
+    The implicit barriers of the work-sharing loops keep the order X, Y, Z,
+    so the edges and corners are set as by the three separate calls. */
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        CopyLayersX(loc3Dstorage, LayersX);
+        CopyLayersY(loc3Dstorage, LayersY);
+        CopyLayersZ(loc3Dstorage, LayersZ);
+    }
+}
+
+template< class T, size_t Num >
+void BoundaryConditions::SetLocalTeam(Storage3D<T, Num>& loc3Dstorage) const
+{
+    std::vector<std::array<long int,2>> LayersX;
+    std::vector<std::array<long int,2>> LayersY;
+    std::vector<std::array<long int,2>> LayersZ;
+
+    if(HaloLayers(BC0X, BCNX, loc3Dstorage.sizeX(), loc3Dstorage.BcellsX(), LayersX) or
+       HaloLayers(BC0Y, BCNY, loc3Dstorage.sizeY(), loc3Dstorage.BcellsY(), LayersY) or
+       HaloLayers(BC0Z, BCNZ, loc3Dstorage.sizeZ(), loc3Dstorage.BcellsZ(), LayersZ))
+    {
+        /* Free boundaries are set cell by cell, the parallel loops of the
+        per direction methods are nested here and run on a single thread */
+#ifdef _OPENMP
+#pragma omp single
+#endif
+        {
+            SetXLocal(loc3Dstorage);
+            SetYLocal(loc3Dstorage);
+            SetZLocal(loc3Dstorage);
+        }
+        return;
+    }
+    CopyLayersX(loc3Dstorage, LayersX);
+    CopyLayersY(loc3Dstorage, LayersY);
+    CopyLayersZ(loc3Dstorage, LayersZ);
+}
+
+template< class T, size_t Num >
+void BoundaryConditions::SetAll(Storage3D<T, Num>& loc3Dstorage) const
+{
+#ifdef MPI_PARALLEL
+    if((loc3Dstorage.BcellsX() and ExchangesX()) or
+       (MPI_3D_DECOMPOSITION and loc3Dstorage.BcellsY() and ExchangesY()) or
+       (MPI_3D_DECOMPOSITION and loc3Dstorage.BcellsZ() and ExchangesZ()))
+    {
+        SetX(loc3Dstorage);
+        SetY(loc3Dstorage);
+        SetZ(loc3Dstorage);
+        return;
+    }
+#endif
+    SetLocal(loc3Dstorage);
+}
+
+template< class T, size_t Num >
+void BoundaryConditions::CopyLayersX(Storage3D<T, Num>& Field,
+                                     const std::vector<std::array<long int,2>>& Layers)
+{
+    /* X layers consist of contiguous k-rows, which are copied as a whole */
+    const long int Nlayers = Layers.size();
+    const long int RowSize = Field.sizeZ() + 2*Field.BcellsZ();
+#ifdef _OPENMP
+#pragma omp for collapse(2) schedule(static)
+#endif
+    for(long int n = 0; n < Nlayers; n++)
+    for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
+    {
+        const auto* Source = &Field(Layers[n][1], j, -Field.BcellsZ());
+        std::copy(Source, Source + RowSize, &Field(Layers[n][0], j, -Field.BcellsZ()));
+    }
+}
+
+template< class T, size_t Num >
+void BoundaryConditions::CopyLayersY(Storage3D<T, Num>& Field,
+                                     const std::vector<std::array<long int,2>>& Layers)
+{
+    /* Y layers consist of contiguous k-rows, which are copied as a whole */
+    const long int Nlayers = Layers.size();
+    const long int RowSize = Field.sizeZ() + 2*Field.BcellsZ();
 #ifdef _OPENMP
-#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
+#pragma omp for collapse(2) schedule(static)
 #endif
-                for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
-                for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
-                for(long int k = -Field.BcellsZ(); k < 0; k++)
-                {
-                    const long int k0 = Field.sizeZ() - 1;
-                    Field(i, j, k0 - k) = Field(i, j, k0)
-                        +(Field(i, j, k0) - Field(i, j, (k0-1)%Field.sizeZ()))*(-k);
-                }
-                break;
-            }
-            case BoundaryConditionTypes::Fixed: [[fallthrough]];
-            default:
-            {
-                break;
-            }
-        }
-#ifdef MPI_PARALLEL
-        if(MPI_3D_DECOMPOSITION)
+    for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
+    for(long int n = 0; n < Nlayers; n++)
+    {
+        const auto* Source = &Field(i, Layers[n][1], -Field.BcellsZ());
+        std::copy(Source, Source + RowSize, &Field(i, Layers[n][0], -Field.BcellsZ()));
+    }
+}
+
+template< class T, size_t Num >
+void BoundaryConditions::CopyLayersZ(Storage3D<T, Num>& Field,
+                                     const std::vector<std::array<long int,2>>& Layers)
+{
+    if(Layers.empty()) return;
+
+    const long int Nlayers = Layers.size();
+#ifdef _OPENMP
+#pragma omp for collapse(2) schedule(static)
+#endif
+    for(long int i = -Field.BcellsX(); i < Field.sizeX() + Field.BcellsX(); i++)
+    for(long int j = -Field.BcellsY(); j < Field.sizeY() + Field.BcellsY(); j++)
+    {
+        auto* Row = &Field(i, j, 0);
+        for(long int n = 0; n < Nlayers; n++)
         {
-            CommunicateZ(Field);
+            Row[Layers[n][0]] = Row[Layers[n][1]];
         }
-#endif
     }
 }
 
@@ -1236,6 +1495,24 @@ void BoundaryConditions::SetXVector(Storage3D<T, 0> &Field) const
 
 template< class T>
 void BoundaryConditions::SetXVector(Storage3D<T, 1> &Field) const
+{
+    SetXVectorLocal(Field);
+#ifdef MPI_PARALLEL
+    if(Field.BcellsX() and ExchangesX())
+    {
+        if(MPI_3D_DECOMPOSITION)
+        {
+            CommunicateX(Field);
+        }
+        else
+        {
+            Communicate(Field);
+        }
+    }
+#endif
+}
+template< class T>
+void BoundaryConditions::SetXVectorLocal(Storage3D<T, 1> &Field) const
 {
     if(Field.BcellsX())
     {
@@ -1359,16 +1636,6 @@ void BoundaryConditions::SetXVector(Storage3D<T, 1> &Field) const
                 break;
             }
         }
-#ifdef MPI_PARALLEL
-        if(MPI_3D_DECOMPOSITION)
-        {
-            CommunicateX(Field);
-        }
-        else
-        {
-            Communicate(Field);
-        }
-#endif
     }
 }
 template< class T>
@@ -1789,6 +2056,17 @@ void BoundaryConditions::SetYVector(Storage3D<T, 0> &Field) const
 
 template< class T>
 void BoundaryConditions::SetYVector(Storage3D<T, 1> &Field) const
+{
+    SetYVectorLocal(Field);
+#ifdef MPI_PARALLEL
+    if(Field.BcellsY() and ExchangesY() and MPI_3D_DECOMPOSITION)
+    {
+        CommunicateY(Field);
+    }
+#endif
+}
+template< class T>
+void BoundaryConditions::SetYVectorLocal(Storage3D<T, 1> &Field) const
 {
     if(Field.BcellsY())
     {
@@ -1910,12 +2188,6 @@ void BoundaryConditions::SetYVector(Storage3D<T, 1> &Field) const
                 break;
             }
         }
-#ifdef MPI_PARALLEL
-        if(MPI_3D_DECOMPOSITION)
-        {
-            CommunicateY(Field);
-        }
-#endif
     }
 }
 template< class T>
@@ -2326,8 +2598,19 @@ void BoundaryConditions::SetZVector(Storage3D<T, 0> &Field) const
     }
 }
 
-template< class T >
+template< class T>
 void BoundaryConditions::SetZVector(Storage3D<T, 1> &Field) const
+{
+    SetZVectorLocal(Field);
+#ifdef MPI_PARALLEL
+    if(Field.BcellsZ() and ExchangesZ() and MPI_3D_DECOMPOSITION)
+    {
+        CommunicateZ(Field);
+    }
+#endif
+}
+template< class T>
+void BoundaryConditions::SetZVectorLocal(Storage3D<T, 1> &Field) const
 {
     if(Field.BcellsZ())
     {
@@ -2449,12 +2732,6 @@ void BoundaryConditions::SetZVector(Storage3D<T, 1> &Field) const
                 break;
             }
         }
-#ifdef MPI_PARALLEL
-        if(MPI_3D_DECOMPOSITION)
-        {
-            CommunicateZ(Field);
-        }
-#endif
     }
 }
 
@@ -2743,474 +3020,471 @@ void BoundaryConditions::SetZVector(Storage3D<T, 3> &Field) const
     }
 }
 
-#ifdef MPI_PARALLEL
-template<typename A>
-inline void BoundaryConditions::Communicate([[maybe_unused]] A& storage) const
+template< class T, size_t Num >
+void BoundaryConditions::BeginExchange([[maybe_unused]] Storage3D<T, Num>& Field) const
 {
-    std::vector<double> sleft;
-    std::vector<double> rleft;
-    std::vector<double> sright;
-    std::vector<double> rright;
-    void* request_sleft = create_request();
-    void* request_sleft_size = create_request();
-    void* request_sright = create_request();
-    void* request_sright_size = create_request();
-    void* request_rleft = create_request();
-    void* request_rleft_size = create_request();
-    void* request_rright = create_request();
-    void* request_rright_size = create_request();
-
-    int sleft_size;
-    int sright_size;
-    const int RightProcess = (((MPI_RANK+1)%MPI_SIZE)+MPI_SIZE)%MPI_SIZE;
-    const int LeftProcess  = (((MPI_RANK-1)%MPI_SIZE)+MPI_SIZE)%MPI_SIZE;
-
-    const int LeftSizeTag  = 0; // used to identify data stream
-    const int LeftDataTag  = 2; // used to identify data stream
-    const int RightSizeTag = 4; // used to identify data stream
-    const int RightDataTag = 8; // used to identify data stream
-
-    if(MPI_RANK > 0 or MPIperiodicX)
-    {
-        std::vector<long int> window(6);
-        window[0] = 0;
-        window[1] = storage.BcellsX();
-        window[2] = -storage.BcellsY();
-        window[3] = storage.sizeY()+storage.BcellsY();
-        window[4] = -storage.BcellsZ();
-        window[5] = storage.sizeZ()+storage.BcellsZ();
-        sleft = storage.pack(window);
-        sleft_size = sleft.size();
-        OP_MPI_Isend(&sleft_size , 1 , OP_MPI_INT , LeftProcess , RightSizeTag, OP_MPI_COMM_WORLD ,  request_sleft_size);
-        OP_MPI_Isend(sleft.data() , sleft_size , OP_MPI_DOUBLE , LeftProcess , RightDataTag , OP_MPI_COMM_WORLD,  request_sleft);
-    }
-    if(MPI_RANK < MPI_SIZE-1 or MPIperiodicX)
-    {
-        std::vector<long int> window(6);
-        window[0] = storage.sizeX()-storage.BcellsX();
-        window[1] = storage.sizeX();
-        window[2] = -storage.BcellsY();
-        window[3] = storage.sizeY()+storage.BcellsY();
-        window[4] = -storage.BcellsZ();
-        window[5] = storage.sizeZ()+storage.BcellsZ();
-        sright = storage.pack(window);
-        sright_size = sright.size();
-        OP_MPI_Isend(&sright_size , 1 , OP_MPI_INT , RightProcess , LeftSizeTag, OP_MPI_COMM_WORLD , request_sright_size);
-        OP_MPI_Isend(sright.data() , sright_size , OP_MPI_DOUBLE , RightProcess , LeftDataTag, OP_MPI_COMM_WORLD , request_sright);
-    }
-    if(MPI_RANK > 0 or MPIperiodicX)
-    {
-        long int size = 0;
-        OP_MPI_Irecv(&size, 1, OP_MPI_INT, LeftProcess, LeftSizeTag, OP_MPI_COMM_WORLD, request_rleft_size);
-        OP_MPI_Wait(request_rleft_size, OP_MPI_STATUS_IGNORE);
-        rleft.resize(size);
-        OP_MPI_Irecv(rleft.data(), size, OP_MPI_DOUBLE, LeftProcess, LeftDataTag, OP_MPI_COMM_WORLD, request_rleft);
-        OP_MPI_Wait(request_rleft, OP_MPI_STATUS_IGNORE);
-        std::vector<long int> window(6);
-        window[0] = -storage.BcellsX();
-        window[1] = 0;
-        window[2] = -storage.BcellsY();
-        window[3] = storage.sizeY()+storage.BcellsY();
-        window[4] = -storage.BcellsZ();
-        window[5] = storage.sizeZ()+storage.BcellsZ();
-        storage.unpack(rleft,window);
-    }
-    if (MPI_RANK < MPI_SIZE-1 or MPIperiodicX)
-    {
-        long int size = 0;
-        OP_MPI_Irecv(&size, 1, OP_MPI_INT, RightProcess, RightSizeTag, OP_MPI_COMM_WORLD,  request_rright_size);
-        OP_MPI_Wait(request_rright_size, OP_MPI_STATUS_IGNORE);
-        rright.resize(size);
-        OP_MPI_Irecv(rright.data(), size, OP_MPI_DOUBLE, RightProcess, RightDataTag, OP_MPI_COMM_WORLD, request_rright);
-        OP_MPI_Wait(request_rright, OP_MPI_STATUS_IGNORE);
-        std::vector<long int> window(6);
-        window[0] = storage.sizeX();
-        window[1] = storage.sizeX()+storage.BcellsX();
-        window[2] = -storage.BcellsY();
-        window[3] = storage.sizeY()+storage.BcellsY();
-        window[4] = -storage.BcellsZ();
-        window[5] = storage.sizeZ()+storage.BcellsZ();
-        storage.unpack(rright,window);
-    }
-    if (MPI_RANK > 0 or MPIperiodicX)
-    {
-        OP_MPI_Wait(request_sleft, OP_MPI_STATUS_IGNORE);
-        OP_MPI_Wait(request_sleft_size, OP_MPI_STATUS_IGNORE);
-    }
-    if (MPI_RANK < MPI_SIZE-1 or MPIperiodicX)
-    {
-        OP_MPI_Wait(request_sright, OP_MPI_STATUS_IGNORE);
-        OP_MPI_Wait(request_sright_size, OP_MPI_STATUS_IGNORE);
-    }
-    free_request(request_sleft);
-    free_request(request_sleft_size);
-    free_request(request_sright);
-    free_request(request_sright_size);
-    free_request(request_rleft);
-    free_request(request_rleft_size);
-    free_request(request_rright);
-    free_request(request_rright_size);
+#ifdef MPI_PARALLEL
+    int LeftProcess;
+    int RightProcess;
+    bool exchangeLeft;
+    bool exchangeRight;
+    if(Field.BcellsX() and ExchangesX() and
+       HaloNeighbors(0, MPI_3D_DECOMPOSITION, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
+    {
+        BeginHalo(Field, 0, LeftProcess, RightProcess, exchangeLeft, exchangeRight);
+    }
+#endif
 }
 
-template<typename A>
-inline void BoundaryConditions::CommunicateX([[maybe_unused]] A& storage) const
+template< class T, size_t Num >
+void BoundaryConditions::EndExchange(Storage3D<T, Num>& Field) const
 {
-    if(MPI_CART_SIZE[0] > 1)
+#ifdef MPI_PARALLEL
+    if(HaloExchanges[0].Storage == &Field)
     {
-        std::vector<double> sleft;
-        std::vector<double> rleft;
-        std::vector<double> sright;
-        std::vector<double> rright;
-        void* request_sleft = create_request();
-        void* request_sleft_size = create_request();
-        void* request_sright = create_request();
-        void* request_sright_size = create_request();
-        void* request_rleft = create_request();
-        void* request_rleft_size = create_request();
-        void* request_rright = create_request();
-        void* request_rright_size = create_request();
-
-        int sleft_size;
-        int sright_size;
-        int RightProcess = MPI_CART_RANK[2] + MPI_CART_RANK[1] * MPI_CART_SIZE[2] + (MPI_CART_RANK[0] + 1) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
-        int LeftProcess  = MPI_CART_RANK[2] + MPI_CART_RANK[1] * MPI_CART_SIZE[2] + (MPI_CART_RANK[0] - 1) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
+        EndHalo(Field, 0);
+    }
+#endif
+    SetXLocal(Field);
+    SetY(Field);
+    SetZ(Field);
+}
 
-        if(MPI_CART_RANK[0] >= MPI_CART_SIZE[0]-1)
+template< class T, size_t Num, class Function >
+void BoundaryConditions::ExchangeAndApply(Storage3D<T, Num>& Field, const int reach,
+                                          const long int bcells, Function&& function) const
+{
+#if defined(MPI_PARALLEL) && defined(_OPENMP)
+    if(HaloThreading == HaloThreadingModes::Overlap and omp_get_max_threads() > 1 and not omp_in_parallel())
+    {
+        if(bcells > Field.Bcells())
         {
-            RightProcess = MPI_CART_RANK[2] + MPI_CART_RANK[1] * MPI_CART_SIZE[2];
+            ConsoleOutput::WriteExit("Boundary too small, bcells needed " + std::to_string(bcells),
+                                     thisclassname, "ExchangeAndApply()");
+            OP_Exit(EXIT_FAILURE);
         }
-        if(MPI_CART_RANK[0] <= 0)
+        const long int reachX = Field.dNx()*(long int)reach;
+        const long int reachY = Field.dNy()*(long int)reach;
+        const long int reachZ = Field.dNz()*(long int)reach;
+        const long int sizeX  = Field.sizeX();
+        const long int sizeY  = Field.sizeY();
+        const long int sizeZ  = Field.sizeZ();
+        const long int lowerX = -std::min(Field.BcellsX(), bcells);
+        const long int lowerY = -std::min(Field.BcellsY(), bcells);
+        const long int lowerZ = -std::min(Field.BcellsZ(), bcells);
+        const long int upperX = sizeX - lowerX;
+        const long int upperY = sizeY - lowerY;
+        const long int upperZ = sizeZ - lowerZ;
+        const bool anyThread  = HaloThreadMultiple;
+
+        #pragma omp parallel
         {
-            LeftProcess  = MPI_CART_RANK[2] + MPI_CART_RANK[1] * MPI_CART_SIZE[2] + (MPI_CART_SIZE[0] - 1) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
+            /* The exchanging thread does not wait at the end of the single or
+            master block, it joins the dynamically scheduled interior loop
+            after the exchange and takes the remaining rows */
+            if(anyThread)
+            {
+                #pragma omp single nowait
+                {
+                    BeginExchange(Field);
+                    EndExchange(Field);
+                }
+            }
+            else
+            {
+                #pragma omp master
+                {
+                    BeginExchange(Field);
+                    EndExchange(Field);
+                }
+            }
+
+            #pragma omp for collapse(2) schedule(dynamic,1) nowait
+            for (long int i = reachX; i < sizeX - reachX; ++i)
+            for (long int j = reachY; j < sizeY - reachY; ++j)
+            for (long int k = reachZ; k < sizeZ - reachZ; ++k)
+            {
+                function(i,j,k);
+            }
+
+            // The halo is complete and the interior is updated
+            #pragma omp barrier
+
+            #pragma omp for collapse(2) schedule(dynamic,1)
+            for (long int i = lowerX; i < upperX; ++i)
+            for (long int j = lowerY; j < upperY; ++j)
+            {
+                const bool inside = i >= reachX and i < sizeX - reachX and
+                                    j >= reachY and j < sizeY - reachY and
+                                    reachZ < sizeZ - reachZ;
+                for (long int k = lowerZ; k < upperZ; ++k)
+                {
+                    if(inside and k == reachZ)
+                    {
+                        k = sizeZ - reachZ - 1;
+                        continue;
+                    }
+                    function(i,j,k);
+                }
+            }
         }
+        return;
+    }
+#endif
+    BeginExchange(Field);
+    OMP_PARALLEL_STORAGE_LOOP_INTERIOR_BEGIN(i, j, k, Field, reach,)
+    {
+        function(i,j,k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_INTERIOR_END
 
-        const int LeftSizeTag  = 0; // used to identify data stream
-        const int LeftDataTag  = 2; // used to identify data stream
-        const int RightSizeTag = 4; // used to identify data stream
-        const int RightDataTag = 8; // used to identify data stream
+    EndExchange(Field);
 
-        if (MPI_CART_RANK[0] > 0 or MPIperiodicX)
-        {
-            std::vector<long int> window(6);
-            window[0] = 0;
-            window[1] = storage.BcellsX();
-            window[2] = -storage.BcellsY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = -storage.BcellsZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            sleft = storage.pack(window);
-            sleft_size = sleft.size();
-            OP_MPI_Isend(&sleft_size , 1 , OP_MPI_INT , LeftProcess , RightSizeTag, OP_MPI_COMM_WORLD , request_sleft_size);
-            OP_MPI_Isend(sleft.data() , sleft_size , OP_MPI_DOUBLE , LeftProcess , RightDataTag, OP_MPI_COMM_WORLD , request_sleft);
-        }
-        if (MPI_CART_RANK[0] < MPI_CART_SIZE[0]-1 or MPIperiodicX)
-        {
-            std::vector<long int> window(6);
-            window[0] = storage.sizeX()-storage.BcellsX();
-            window[1] = storage.sizeX();
-            window[2] = -storage.BcellsY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = -storage.BcellsZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            sright = storage.pack(window);
-            sright_size = sright.size();
-            OP_MPI_Isend(&sright_size , 1 , OP_MPI_INT , RightProcess , LeftSizeTag, OP_MPI_COMM_WORLD , request_sright_size);
-            OP_MPI_Isend(sright.data() , sright_size , OP_MPI_DOUBLE , RightProcess , LeftDataTag, OP_MPI_COMM_WORLD , request_sright);
-        }
-        if (MPI_CART_RANK[0] > 0 or MPIperiodicX)
-        {
-            long int size = 0;
-            OP_MPI_Irecv(&size, 1, OP_MPI_INT, LeftProcess, LeftSizeTag, OP_MPI_COMM_WORLD, request_rleft_size);
-            OP_MPI_Wait(request_rleft_size, OP_MPI_STATUS_IGNORE);
-            rleft.resize(size);
-            OP_MPI_Irecv(rleft.data(), size, OP_MPI_DOUBLE, LeftProcess, LeftDataTag, OP_MPI_COMM_WORLD, request_rleft);
-            OP_MPI_Wait(request_rleft, OP_MPI_STATUS_IGNORE);
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = 0;
-            window[2] = -storage.BcellsY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = -storage.BcellsZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            storage.unpack(rleft,window);
-        }
-        if (MPI_CART_RANK[0] < MPI_CART_SIZE[0]-1 or MPIperiodicX)
-        {
-            long int size = 0;
-            OP_MPI_Irecv(&size, 1, OP_MPI_INT, RightProcess, RightSizeTag, OP_MPI_COMM_WORLD, request_rright_size);
-            OP_MPI_Wait(request_rright_size, OP_MPI_STATUS_IGNORE);
-            rright.resize(size);
-            OP_MPI_Irecv(rright.data(), size, OP_MPI_DOUBLE, RightProcess, RightDataTag, OP_MPI_COMM_WORLD, request_rright);
-            OP_MPI_Wait(request_rright, OP_MPI_STATUS_IGNORE);
-            std::vector<long int> window(6);
-            window[0] = storage.sizeX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = -storage.BcellsY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = -storage.BcellsZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            storage.unpack(rright,window);
-        }
-        if (MPI_CART_RANK[0] > 0 or MPIperiodicX)
-        {
-            OP_MPI_Wait(request_sleft, OP_MPI_STATUS_IGNORE);
-            OP_MPI_Wait(request_sleft_size, OP_MPI_STATUS_IGNORE);
-        }
-        if (MPI_CART_RANK[0] < MPI_CART_SIZE[0]-1 or MPIperiodicX)
-        {
-            OP_MPI_Wait(request_sright, OP_MPI_STATUS_IGNORE);
-            OP_MPI_Wait(request_sright_size, OP_MPI_STATUS_IGNORE);
-        }
-        free_request(request_sleft);
-        free_request(request_sleft_size);
-        free_request(request_sright);
-        free_request(request_sright_size);
-        free_request(request_rleft);
-        free_request(request_rleft_size);
-        free_request(request_rright);
-        free_request(request_rright_size);
+    OMP_PARALLEL_STORAGE_LOOP_SHELL_BEGIN(i, j, k, Field, bcells, reach,)
+    {
+        function(i,j,k);
     }
+    OMP_PARALLEL_STORAGE_LOOP_SHELL_END
 }
 
-template<typename A>
-inline void BoundaryConditions::CommunicateY([[maybe_unused]] A& storage) const
+template< class T>
+void BoundaryConditions::BeginExchangeVector([[maybe_unused]] Storage3D<T, 1>& Field) const
 {
-    if(MPI_CART_SIZE[1]>1)
+#ifdef MPI_PARALLEL
+    int LeftProcess;
+    int RightProcess;
+    bool exchangeLeft;
+    bool exchangeRight;
+    if(Field.BcellsX() and ExchangesX() and
+       HaloNeighbors(0, MPI_3D_DECOMPOSITION, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
     {
-        std::vector<double> sleft;
-        std::vector<double> rleft;
-        std::vector<double> sright;
-        std::vector<double> rright;
-        void* request_sleft = create_request();
-        void* request_sleft_size = create_request();
-        void* request_sright = create_request();
-        void* request_sright_size = create_request();
-        void* request_rleft = create_request();
-        void* request_rleft_size = create_request();
-        void* request_rright = create_request();
-        void* request_rright_size = create_request();
+        BeginHalo(Field, 0, LeftProcess, RightProcess, exchangeLeft, exchangeRight);
+    }
+#endif
+}
 
-        int sleft_size;
-        int sright_size;
+template< class T>
+void BoundaryConditions::EndExchangeVector(Storage3D<T, 1>& Field) const
+{
+#ifdef MPI_PARALLEL
+    if(HaloExchanges[0].Storage == &Field)
+    {
+        EndHalo(Field, 0);
+    }
+#endif
+    SetXVectorLocal(Field);
+    SetYVector(Field);
+    SetZVector(Field);
+}
 
-        int RightProcess = MPI_CART_RANK[2] + (MPI_CART_RANK[1] + 1) * MPI_CART_SIZE[2] + (MPI_CART_RANK[0]) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
-        int LeftProcess  = MPI_CART_RANK[2] + (MPI_CART_RANK[1] - 1) * MPI_CART_SIZE[2] + (MPI_CART_RANK[0]) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
+template< class T>
+void BoundaryConditions::BeginExchangePopulations([[maybe_unused]] Storage3D<T, 1>& Field) const
+{
+#ifdef MPI_PARALLEL
+    int LeftProcess;
+    int RightProcess;
+    bool exchangeLeft;
+    bool exchangeRight;
+    if(Field.BcellsX() and ExchangesX() and
+       HaloNeighbors(0, MPI_3D_DECOMPOSITION, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
+    {
+        BeginHalo(Field, 0, LeftProcess, RightProcess, exchangeLeft, exchangeRight, true);
+    }
+#endif
+}
 
-        if(MPI_CART_RANK[1] >= MPI_CART_SIZE[1]-1)
-        {
-            RightProcess = MPI_CART_RANK[2] + (MPI_CART_RANK[0]) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
-        }
-        if(MPI_CART_RANK[1] <= 0 )
-        {
-            LeftProcess  = MPI_CART_RANK[2] + (MPI_CART_SIZE[1] - 1) * MPI_CART_SIZE[2] + (MPI_CART_RANK[0]) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
-        }
+template< class T>
+void BoundaryConditions::EndExchangePopulations(Storage3D<T, 1>& Field) const
+{
+#ifdef MPI_PARALLEL
+    if(HaloExchanges[0].Storage == &Field)
+    {
+        EndHalo(Field, 0);
+    }
+#endif
+    SetXVectorLocal(Field);
+    SetYVectorLocal(Field);
+#ifdef MPI_PARALLEL
+    int LeftProcess;
+    int RightProcess;
+    bool exchangeLeft;
+    bool exchangeRight;
+    if(Field.BcellsY() and ExchangesY() and MPI_3D_DECOMPOSITION and
+       HaloNeighbors(1, true, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
+    {
+        ExchangeHalo(Field, 1, LeftProcess, RightProcess, exchangeLeft, exchangeRight, true);
+    }
+#endif
+    SetZVectorLocal(Field);
+#ifdef MPI_PARALLEL
+    if(Field.BcellsZ() and ExchangesZ() and MPI_3D_DECOMPOSITION and
+       HaloNeighbors(2, true, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
+    {
+        ExchangeHalo(Field, 2, LeftProcess, RightProcess, exchangeLeft, exchangeRight, true);
+    }
+#endif
+}
+
+#ifdef MPI_PARALLEL
+template<typename A>
+inline std::vector<long int> BoundaryConditions::HaloWindow(const A& storage,
+        const int direction, const long int lower, const long int upper)
+{
+    std::vector<long int> window(6);
+    window[0] = -storage.BcellsX();
+    window[1] = storage.sizeX()+storage.BcellsX();
+    window[2] = -storage.BcellsY();
+    window[3] = storage.sizeY()+storage.BcellsY();
+    window[4] = -storage.BcellsZ();
+    window[5] = storage.sizeZ()+storage.BcellsZ();
+    window[2*direction]   = lower;
+    window[2*direction+1] = upper;
+    return window;
+}
+
+inline bool BoundaryConditions::ExchangesX(void) const
+{
+    return BC0X != BoundaryConditionTypes::Periodic and
+           BCNX != BoundaryConditionTypes::Periodic;
+}
+
+inline bool BoundaryConditions::ExchangesY(void) const
+{
+    return BC0Y != BoundaryConditionTypes::Periodic and
+           BCNY != BoundaryConditionTypes::Periodic;
+}
+
+inline bool BoundaryConditions::ExchangesZ(void) const
+{
+    return BC0Z != BoundaryConditionTypes::Periodic and
+           BCNZ != BoundaryConditionTypes::Periodic;
+}
+
+template<typename A>
+inline void BoundaryConditions::ExchangeHalo(A& storage,
+        const int direction, const int LeftProcess, const int RightProcess,
+        const bool exchangeLeft, const bool exchangeRight,
+        const bool streaming) const
+{
+    BeginHalo(storage, direction, LeftProcess, RightProcess, exchangeLeft, exchangeRight, streaming);
+    EndHalo(storage, direction);
+}
 
+template<typename A>
+inline void BoundaryConditions::BeginHalo([[maybe_unused]] A& storage,
+        const int direction, const int LeftProcess, const int RightProcess,
+        const bool exchangeLeft, const bool exchangeRight,
+        const bool streaming) const
+{
+    HaloExchangeState& state = HaloExchanges[direction];
+    if(state.Storage != nullptr)
+    {
+        std::cerr << "ERROR: BoundaryConditions::BeginHalo()\n"
+                  << "A halo exchange along direction " << direction
+                  << " is already in flight!\n"
+                  << "Terminating!!!\n";
+        OP_Exit(EXIT_FAILURE);
+    }
+    state.Storage       = &storage;
+    state.LeftProcess   = LeftProcess;
+    state.RightProcess  = RightProcess;
+    state.ExchangeLeft  = exchangeLeft;
+    state.ExchangeRight = exchangeRight;
+    state.Streaming     = streaming and HaloPopulations<A>::Minimal;
+
+    TimeInfo::Communication Timer("Halo exchange: pack and send");
+    const long int size[3] = {storage.sizeX(), storage.sizeY(), storage.sizeZ()};
+    const long int halo[3] = {storage.BcellsX(), storage.BcellsY(), storage.BcellsZ()};
+
+    if constexpr (HaloStorage<A>::Direct)
+    {
+        if(halo[direction] == 0) return;
+
+        const std::array<int,4> sizes = {int(size[0] + 2*halo[0]),
+                                         int(size[1] + 2*halo[1]),
+                                         int(size[2] + 2*halo[2]),
+                                         HaloStorage<A>::Components(storage)};
+        const std::array<int,3> bcells = {int(halo[0]), int(halo[1]), int(halo[2])};
+        Timer.Bytes = double(sizes[0])*sizes[1]*sizes[2]/sizes[direction]*halo[direction]*sizes[3]
+                    *sizeof(typename HaloStorage<A>::Value)*(int(exchangeLeft) + int(exchangeRight));
+
+        state.Plan = BeginHaloDirect(&storage, HaloStorage<A>::Data(storage),
+                           HaloMPIDatatype<typename HaloStorage<A>::Value>::Type,
+                           sizes, bcells, direction, LeftProcess, RightProcess,
+                           exchangeLeft, exchangeRight);
+    }
+    else
+    {
         const int LeftSizeTag  = 0; // used to identify data stream
-        const int LeftDataTag  = 2; // used to identify data stream
         const int RightSizeTag = 4; // used to identify data stream
+        const int LeftDataTag  = 2; // used to identify data stream
         const int RightDataTag = 8; // used to identify data stream
 
-        if (MPI_CART_RANK[1] > 0 or MPIperiodicY)
-        {
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = 0;
-            window[3] = storage.BcellsY();
-            window[4] = -storage.BcellsZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            sleft = storage.pack(window);
-            sleft_size = sleft.size();
-            OP_MPI_Isend(&sleft_size , 1 , OP_MPI_INT , LeftProcess , RightSizeTag, OP_MPI_COMM_WORLD , request_sleft_size);
-            OP_MPI_Isend(sleft.data() , sleft_size , OP_MPI_DOUBLE , LeftProcess , RightDataTag , OP_MPI_COMM_WORLD, request_sleft);
-        }
-        if (MPI_CART_RANK[1] < MPI_CART_SIZE[1]-1 or MPIperiodicY)
-        {
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = storage.sizeY()-storage.BcellsY();
-            window[3] = storage.sizeY();
-            window[4] = -storage.BcellsZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            sright = storage.pack(window);
-            sright_size = sright.size();
-            OP_MPI_Isend(&sright_size , 1 , OP_MPI_INT , RightProcess , LeftSizeTag, OP_MPI_COMM_WORLD , request_sright_size);
-            OP_MPI_Isend(sright.data() , sright_size , OP_MPI_DOUBLE , RightProcess , LeftDataTag, OP_MPI_COMM_WORLD , request_sright);
-        }
-        if (MPI_CART_RANK[1] > 0 or MPIperiodicY)
-        {
-            long int size = 0;
-            OP_MPI_Irecv(&size, 1, OP_MPI_INT, LeftProcess, LeftSizeTag, OP_MPI_COMM_WORLD, request_rleft_size);
-            OP_MPI_Wait(request_rleft_size, OP_MPI_STATUS_IGNORE);
-            rleft.resize(size);
-            OP_MPI_Irecv(rleft.data(), size, OP_MPI_DOUBLE, LeftProcess, LeftDataTag, OP_MPI_COMM_WORLD, request_rleft);
-            OP_MPI_Wait(request_rleft, OP_MPI_STATUS_IGNORE);
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = -storage.BcellsY();
-            window[3] = 0;
-            window[4] = -storage.BcellsZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            storage.unpack(rleft,window);
-        }
-        if (MPI_CART_RANK[1] < MPI_CART_SIZE[1]-1 or MPIperiodicY)
-        {
-            long int size = 0;
-            OP_MPI_Irecv(&size, 1, OP_MPI_INT, RightProcess, RightSizeTag, OP_MPI_COMM_WORLD, request_rright_size);
-            OP_MPI_Wait(request_rright_size, OP_MPI_STATUS_IGNORE);
-            rright.resize(size);
-            OP_MPI_Irecv(rright.data(), size, OP_MPI_DOUBLE, RightProcess, RightDataTag, OP_MPI_COMM_WORLD, request_rright);
-            OP_MPI_Wait(request_rright, OP_MPI_STATUS_IGNORE);
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = storage.sizeY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = -storage.BcellsZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            storage.unpack(rright,window);
-        }
-        if (MPI_CART_RANK[1] > 0 or MPIperiodicY)
-        {
-            OP_MPI_Wait(request_sleft, OP_MPI_STATUS_IGNORE);
-            OP_MPI_Wait(request_sleft_size, OP_MPI_STATUS_IGNORE);
-        }
-        if (MPI_CART_RANK[1] < MPI_CART_SIZE[1]-1 or MPIperiodicY)
-        {
-            OP_MPI_Wait(request_sright, OP_MPI_STATUS_IGNORE);
-            OP_MPI_Wait(request_sright_size, OP_MPI_STATUS_IGNORE);
-        }
-        free_request(request_sleft);
-        free_request(request_sleft_size);
-        free_request(request_sright);
-        free_request(request_sright_size);
-        free_request(request_rleft);
-        free_request(request_rleft_size);
-        free_request(request_rright);
-        free_request(request_rright_size);
+        if(exchangeLeft)
+        {
+            state.RequestSendLeft     = create_request();
+            state.RequestSendLeftSize = create_request();
+            state.RequestRecvLeftSize = create_request();
+
+            const std::vector<long int> window = HaloWindow(storage, direction, 0, halo[direction]);
+            if(state.Streaming) HaloPopulations<A>::pack(storage, state.SendLeft, window, direction, -1);
+            else storage.pack(state.SendLeft, window);
+            state.SendLeftSize = state.SendLeft.size();
+            OP_MPI_Isend(&state.SendLeftSize , 1 , OP_MPI_INT , LeftProcess , RightSizeTag, OP_MPI_COMM_WORLD , state.RequestSendLeftSize);
+            OP_MPI_Isend(state.SendLeft.data() , state.SendLeftSize , OP_MPI_DOUBLE , LeftProcess , RightDataTag, OP_MPI_COMM_WORLD , state.RequestSendLeft);
+            OP_MPI_Irecv(&state.RecvLeftSize, 1, OP_MPI_INT, LeftProcess, LeftSizeTag, OP_MPI_COMM_WORLD, state.RequestRecvLeftSize);
+        }
+        if(exchangeRight)
+        {
+            state.RequestSendRight     = create_request();
+            state.RequestSendRightSize = create_request();
+            state.RequestRecvRightSize = create_request();
+
+            const std::vector<long int> window = HaloWindow(storage, direction, size[direction]-halo[direction], size[direction]);
+            if(state.Streaming) HaloPopulations<A>::pack(storage, state.SendRight, window, direction, 1);
+            else storage.pack(state.SendRight, window);
+            state.SendRightSize = state.SendRight.size();
+            OP_MPI_Isend(&state.SendRightSize , 1 , OP_MPI_INT , RightProcess , LeftSizeTag, OP_MPI_COMM_WORLD , state.RequestSendRightSize);
+            OP_MPI_Isend(state.SendRight.data() , state.SendRightSize , OP_MPI_DOUBLE , RightProcess , LeftDataTag, OP_MPI_COMM_WORLD , state.RequestSendRight);
+            OP_MPI_Irecv(&state.RecvRightSize, 1, OP_MPI_INT, RightProcess, RightSizeTag, OP_MPI_COMM_WORLD, state.RequestRecvRightSize);
+        }
+        Timer.Bytes = double(state.SendLeftSize*exchangeLeft + state.SendRightSize*exchangeRight)*sizeof(double);
     }
 }
 
 template<typename A>
-inline void BoundaryConditions::CommunicateZ([[maybe_unused]] A& storage) const
+inline void BoundaryConditions::EndHalo([[maybe_unused]] A& storage,
+        const int direction) const
 {
-    if(MPI_CART_SIZE[2] > 1)
+    HaloExchangeState& state = HaloExchanges[direction];
+    if(state.Storage != &storage)
     {
-        std::vector<double> sleft;
-        std::vector<double> rleft;
-        std::vector<double> sright;
-        std::vector<double> rright;
-        void* request_sleft = create_request();
-        void* request_sleft_size = create_request();
-        void* request_sright = create_request();
-        void* request_sright_size = create_request();
-        void* request_rleft = create_request();
-        void* request_rleft_size = create_request();
-        void* request_rright = create_request();
-        void* request_rright_size = create_request();
+        std::cerr << "ERROR: BoundaryConditions::EndHalo()\n"
+                  << "No halo exchange of this storage along direction "
+                  << direction << " is in flight!\n"
+                  << "Terminating!!!\n";
+        OP_Exit(EXIT_FAILURE);
+    }
+    state.Storage = nullptr;
 
-        int sleft_size;
-        int sright_size;
+    TimeInfo::Communication Timer("Halo exchange: wait and unpack");
+    if constexpr (HaloStorage<A>::Direct)
+    {
+        if(state.Plan != nullptr)
+        {
+            EndHaloDirect(state.Plan);
+            state.Plan = nullptr;
+        }
+    }
+    else
+    {
+        const long int size = (direction == 0) ? storage.sizeX() : ((direction == 1) ? storage.sizeY() : storage.sizeZ());
+        const long int halo = (direction == 0) ? storage.BcellsX() : ((direction == 1) ? storage.BcellsY() : storage.BcellsZ());
 
-        int RightProcess = MPI_CART_RANK[2] +1 + MPI_CART_RANK[1] * MPI_CART_SIZE[2] + (MPI_CART_RANK[0]) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
-        int LeftProcess  = MPI_CART_RANK[2] -1 + MPI_CART_RANK[1] * MPI_CART_SIZE[2] + (MPI_CART_RANK[0]) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
+        const int LeftDataTag  = 2; // used to identify data stream
+        const int RightDataTag = 8; // used to identify data stream
 
-        if(MPI_CART_RANK[2] >= MPI_CART_SIZE[2]-1)
+        if(state.ExchangeLeft)
+        {
+            state.RequestRecvLeft = create_request();
+            OP_MPI_Wait(state.RequestRecvLeftSize, OP_MPI_STATUS_IGNORE);
+            state.RecvLeft.resize(state.RecvLeftSize);
+            OP_MPI_Irecv(state.RecvLeft.data(), state.RecvLeftSize, OP_MPI_DOUBLE, state.LeftProcess, LeftDataTag, OP_MPI_COMM_WORLD, state.RequestRecvLeft);
+        }
+        if(state.ExchangeRight)
+        {
+            state.RequestRecvRight = create_request();
+            OP_MPI_Wait(state.RequestRecvRightSize, OP_MPI_STATUS_IGNORE);
+            state.RecvRight.resize(state.RecvRightSize);
+            OP_MPI_Irecv(state.RecvRight.data(), state.RecvRightSize, OP_MPI_DOUBLE, state.RightProcess, RightDataTag, OP_MPI_COMM_WORLD, state.RequestRecvRight);
+        }
+        if(state.ExchangeLeft)
+        {
+            OP_MPI_Wait(state.RequestRecvLeft, OP_MPI_STATUS_IGNORE);
+            const std::vector<long int> window = HaloWindow(storage, direction, -halo, 0);
+            if(state.Streaming) HaloPopulations<A>::unpack(storage, state.RecvLeft, window, direction, 1);
+            else storage.unpack(state.RecvLeft, window);
+        }
+        if(state.ExchangeRight)
+        {
+            OP_MPI_Wait(state.RequestRecvRight, OP_MPI_STATUS_IGNORE);
+            const std::vector<long int> window = HaloWindow(storage, direction, size, size+halo);
+            if(state.Streaming) HaloPopulations<A>::unpack(storage, state.RecvRight, window, direction, -1);
+            else storage.unpack(state.RecvRight, window);
+        }
+        if(state.ExchangeLeft)
+        {
+            OP_MPI_Wait(state.RequestSendLeft, OP_MPI_STATUS_IGNORE);
+            OP_MPI_Wait(state.RequestSendLeftSize, OP_MPI_STATUS_IGNORE);
+        }
+        if(state.ExchangeRight)
         {
-            RightProcess =  MPI_CART_RANK[1] * MPI_CART_SIZE[2] + (MPI_CART_RANK[0]) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
+            OP_MPI_Wait(state.RequestSendRight, OP_MPI_STATUS_IGNORE);
+            OP_MPI_Wait(state.RequestSendRightSize, OP_MPI_STATUS_IGNORE);
         }
-        if(MPI_CART_RANK[2] <= 0)
+        for(void** request : {&state.RequestSendLeft,  &state.RequestSendLeftSize,
+                              &state.RequestSendRight, &state.RequestSendRightSize,
+                              &state.RequestRecvLeft,  &state.RequestRecvLeftSize,
+                              &state.RequestRecvRight, &state.RequestRecvRightSize})
         {
-            LeftProcess = MPI_CART_SIZE[2] - 1 + MPI_CART_RANK[1] * MPI_CART_SIZE[2] + (MPI_CART_RANK[0]) * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
+            if(*request != nullptr)
+            {
+                free_request(*request);
+                *request = nullptr;
+            }
         }
+    }
+}
 
-        const int LeftSizeTag  = 0; // used to identify data stream
-        const int LeftDataTag  = 2; // used to identify data stream
-        const int RightSizeTag = 4; // used to identify data stream
-        const int RightDataTag = 8; // used to identify data stream
+template<typename A>
+inline void BoundaryConditions::Communicate([[maybe_unused]] A& storage) const
+{
+    int LeftProcess;
+    int RightProcess;
+    bool exchangeLeft;
+    bool exchangeRight;
+    if(HaloNeighbors(0, false, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
+    {
+        ExchangeHalo(storage, 0, LeftProcess, RightProcess, exchangeLeft, exchangeRight);
+    }
+}
+
+template<typename A>
+inline void BoundaryConditions::CommunicateX([[maybe_unused]] A& storage) const
+{
+    int LeftProcess;
+    int RightProcess;
+    bool exchangeLeft;
+    bool exchangeRight;
+    if(HaloNeighbors(0, true, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
+    {
+        ExchangeHalo(storage, 0, LeftProcess, RightProcess, exchangeLeft, exchangeRight);
+    }
+}
+
+template<typename A>
+inline void BoundaryConditions::CommunicateY([[maybe_unused]] A& storage) const
+{
+    int LeftProcess;
+    int RightProcess;
+    bool exchangeLeft;
+    bool exchangeRight;
+    if(HaloNeighbors(1, true, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
+    {
+        ExchangeHalo(storage, 1, LeftProcess, RightProcess, exchangeLeft, exchangeRight);
+    }
+}
 
-        if(MPI_CART_RANK[2] > 0 or MPIperiodicZ)
-        {
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = -storage.BcellsY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = 0;
-            window[5] = storage.BcellsZ();
-            sleft = storage.pack(window);
-            sleft_size = sleft.size();
-            OP_MPI_Isend(&sleft_size , 1 , OP_MPI_INT , LeftProcess , RightSizeTag, OP_MPI_COMM_WORLD , request_sleft_size);
-            OP_MPI_Isend(sleft.data() , sleft_size , OP_MPI_DOUBLE , LeftProcess , RightDataTag, OP_MPI_COMM_WORLD , request_sleft);
-        }
-        if (MPI_CART_RANK[2] < MPI_CART_SIZE[2]-1 or MPIperiodicZ)
-        {
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = -storage.BcellsY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = storage.sizeZ()-storage.BcellsZ();
-            window[5] = storage.sizeZ();
-            sright = storage.pack(window);
-            sright_size = sright.size();
-            OP_MPI_Isend(&sright_size , 1 , OP_MPI_INT , RightProcess , LeftSizeTag, OP_MPI_COMM_WORLD , request_sright_size);
-            OP_MPI_Isend(sright.data() , sright_size , OP_MPI_DOUBLE , RightProcess , LeftDataTag, OP_MPI_COMM_WORLD , request_sright);
-        }
-        if (MPI_CART_RANK[2] > 0 or MPIperiodicZ)
-        {
-            long int size = 0;
-            OP_MPI_Irecv(&size, 1, OP_MPI_INT, LeftProcess, LeftSizeTag, OP_MPI_COMM_WORLD, request_rleft_size);
-            OP_MPI_Wait(request_rleft_size, OP_MPI_STATUS_IGNORE);
-            rleft.resize(size);
-            OP_MPI_Irecv(rleft.data(), size, OP_MPI_DOUBLE, LeftProcess, LeftDataTag, OP_MPI_COMM_WORLD, request_rleft);
-            OP_MPI_Wait(request_rleft, OP_MPI_STATUS_IGNORE);
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = -storage.BcellsY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = -storage.BcellsZ();
-            window[5] = 0;
-            storage.unpack(rleft,window);
-        }
-        if (MPI_CART_RANK[2] < MPI_CART_SIZE[2]-1 or MPIperiodicZ)
-        {
-            long int size = 0;
-            OP_MPI_Irecv(&size, 1, OP_MPI_INT, RightProcess, RightSizeTag, OP_MPI_COMM_WORLD, request_rright_size);
-            OP_MPI_Wait(request_rright_size, OP_MPI_STATUS_IGNORE);
-            rright.resize(size);
-            OP_MPI_Irecv(rright.data(), size, OP_MPI_DOUBLE, RightProcess, RightDataTag, OP_MPI_COMM_WORLD, request_rright);
-            OP_MPI_Wait(request_rright, OP_MPI_STATUS_IGNORE);
-            std::vector<long int> window(6);
-            window[0] = -storage.BcellsX();
-            window[1] = storage.sizeX()+storage.BcellsX();
-            window[2] = -storage.BcellsY();
-            window[3] = storage.sizeY()+storage.BcellsY();
-            window[4] = storage.sizeZ();
-            window[5] = storage.sizeZ()+storage.BcellsZ();
-            storage.unpack(rright,window);
-        }
-        if (MPI_CART_RANK[2] > 0 or MPIperiodicZ)
-        {
-            OP_MPI_Wait(request_sleft, OP_MPI_STATUS_IGNORE);
-            OP_MPI_Wait(request_sleft_size, OP_MPI_STATUS_IGNORE);
-        }
-        if (MPI_CART_RANK[2] < MPI_CART_SIZE[2]-1 or MPIperiodicZ)
-        {
-            OP_MPI_Wait(request_sright, OP_MPI_STATUS_IGNORE);
-            OP_MPI_Wait(request_sright_size, OP_MPI_STATUS_IGNORE);
-        }
-        free_request(request_sleft);
-        free_request(request_sleft_size);
-        free_request(request_sright);
-        free_request(request_sright_size);
-        free_request(request_rleft);
-        free_request(request_rleft_size);
-        free_request(request_rright);
-        free_request(request_rright_size);
+template<typename A>
+inline void BoundaryConditions::CommunicateZ([[maybe_unused]] A& storage) const
+{
+    int LeftProcess;
+    int RightProcess;
+    bool exchangeLeft;
+    bool exchangeRight;
+    if(HaloNeighbors(2, true, LeftProcess, RightProcess, exchangeLeft, exchangeRight))
+    {
+        ExchangeHalo(storage, 2, LeftProcess, RightProcess, exchangeLeft, exchangeRight);
     }
 }
 
@@ -1,5 +1,5 @@
 #ifndef BUILD_INFO_H
 #define BUILD_INFO_H
-#define GIT_COMMIT_SHA "0b5b68ba3b41f0268804e19156755a00cf68fe4e"
-#define BUILD_TIME "Thu Dec 18 17:51:08 CET 2025"
+#define GIT_COMMIT_SHA "5f5612416f764b2c903941967fa1119aa603614b"
+#define BUILD_TIME "Thu Oct 15 02:26:09 UTC 2026"
 #endif
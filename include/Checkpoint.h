@@ -0,0 +1,69 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+class Settings;
+class BoundaryConditions;
+
+/* Unified checkpoint of all objects registered for reading in Settings
+(Settings::AddForReading()). Objects which are checkpointable serialize
+themselves with WriteCheckpoint() into a single file per time step (and per
+rank in MPI parallel mode) "Checkpoint_<tStep>.opc" instead of writing one
+file each; the remaining objects write their own raw files as before.
+
+Write() serializes the objects in parallel, Read() maps the file and
+deserializes the objects in parallel with ReadCheckpoint(), followed by
+FinalizeRead() of each object in the order of registration, which may
+communicate. Usage:
+
+    OPSettings.WriteAll(tStep);         // writes the checkpoint
+    OPSettings.ReadAll(BC, tStep);      // restores it, or reads the individual raw files
+
+File layout: "OPCHKPT1", uint64 number of entries, then for each entry
+uint64 name length, the object name, uint64 offset from the beginning of the
+file and uint64 size in bytes, followed by the data of the entries. */
+
+class OP_EXPORTS Checkpoint                                                     ///< Single-file checkpoint of all readable objects
+{
+ public:
+    static constexpr auto thisclassname = "Checkpoint";                         ///< Object's implementation class name
+
+    static bool Write(const Settings& locSettings, const int tStep);            ///< Writes all registered objects
+    static bool Read(const Settings& locSettings,
+                     const BoundaryConditions& BC, const int tStep);            ///< Restores all registered objects
+    static bool Exists(const Settings& locSettings, const int tStep);           ///< True if a unified checkpoint of time step tStep exists
+    static std::string FileName(const std::string& Directory, const int tStep); ///< Name of the checkpoint file of time step tStep
+};
+
+}// namespace openphase
+#endif
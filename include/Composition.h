@@ -168,10 +168,12 @@ class OP_EXPORTS Composition : public OPObject
 
     void Remesh(int newNx, int newNy, int newNz,
                 const BoundaryConditions& BC) override;                         ///< Remesh the storage while keeping the data
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
 
     void SetInitialMoleFractions(PhaseField& Phi);
 
-    void CalculateTotalMoleFractions(PhaseField& Phase);                        ///< Calculates total mole fractions from the phase mole fractions
+    void CalculateTotalMoleFractions(PhaseField& Phase);                        ///< Calculates total mole fractions from the phase mole fractions and their domain average
     void WriteVTK(Settings& locSettings,
                   const int tStep,
                   const int precision=16) const;                                ///< Writes composition in VTK format (.vts file)
@@ -182,12 +184,15 @@ class OP_EXPORTS Composition : public OPObject
     bool Write(const Settings& locSettings, const int tStep) const override;    ///< Writes raw composition into a file
     bool Read(const Settings& locSettings,
               const BoundaryConditions& BC, const int tStep = -1) override;     ///< Reads raw composition from a file
+    void WriteCheckpoint(std::ostream& out) const override;                     ///< Writes raw composition into a unified checkpoint
+    bool ReadCheckpoint(std::istream& inp) override;                            ///< Reads raw composition from a unified checkpoint
+    void FinalizeRead(const BoundaryConditions& BC) override;                   ///< Updates initial totals, averages and boundary conditions after reading
     void WriteH5(H5Interface& H5, const int tStep);
     bool ReadH5(H5Interface& H5, const int tStep);
 
     void SetBoundaryConditions(const BoundaryConditions& BC) override;          ///< Sets the boundary conditions
-    void SetLimitsBoundaryConditions(const BoundaryConditions& BC);             ///< Sets the boundary conditions for limits
     void SetTotalLimitsBoundaryConditions(const BoundaryConditions& BC);        ///< Sets the boundary conditions for limits
+    void AllocateTotalLimits(void);                                             ///< Allocates NormTotal on first use
 
     void MoveFrame(const int dx, const int dy, const int dz,
                    const BoundaryConditions& BC) override;                      ///< Shifts the data in the storage by dx, dy and dz (they should be 0, -1 or +1) in x, y or z direction correspondingly.
@@ -206,6 +211,7 @@ class OP_EXPORTS Composition : public OPObject
     size_t Ncomp;                                                               ///< Number of chemical components
 
     GridParameters Grid;                                                        ///< Simulation grid parameters
+    double CheckpointTolerance = 0.0;                                           ///< Relative error bound of the compressed raw data, see Settings::CheckpointTolerance
 
     double AtomicWeightMixture;                                                 ///< Atomic weight of the Mixture or Composition
 
@@ -218,20 +224,19 @@ class OP_EXPORTS Composition : public OPObject
 
     Storage3D<double, 1> MassFractionsTotal;                                    ///< Total mass fractions
     Storage3D<double, 1> MassFractionsTotalOld;                                 ///< Total mass fractions for previous timestep
-    Tensor<   double, 1> MolecularWeight;                                       ///< Molecular weight of components
+    Tensor<   double, 1> MolecularWeight;                                       ///< Molecular weight of components in g/mol (from the periodic table)
+    Tensor<   double, 1> MolarVolume;                                           ///< Molar volume of components in m^3/mol (from the periodic table)
 
     Storage3D<double, 2> MoleFractions;                                         ///< Mole fractions for each phase
     Storage3D<double, 1> MoleFractionsTotal;                                    ///< Total mole fractions
 
     Storage3D<double, 2> MoleFractionsDotIn;                                    ///< Phase composition incoming increments storage
-    Storage3D<double, 2> MoleFractionsDotOut;                                   ///< Phase composition outgoing increments storage
     Storage3D<double, 1> MoleFractionsTotalDot;                                 ///< Total composition increments storage
 
-    Storage3D<   int, 0> Limiting;                                              ///< Storage for the limiting of the composition increments
-
-    Storage3D<double, 2> NormIn;                                                ///< Storage for the normalization of incoming phase composition
-    Storage3D<double, 2> NormOut;                                               ///< Storage for the normalization of outgoing phase composition
-    Storage3D<double, 1> NormTotal;                                             ///< Storage for the normalization of total composition
+    /* Normalization of the total composition increments, 1 in cells which
+    are not limited. Cells to be limited are those with a norm below 1 in their
+    neighborhood, no separate flag storage is kept. */
+    Storage3D<double, 1> NormTotal;                                             ///< Storage for the normalization of total composition, allocated on first use
 
     Tensor<double, 2> Initial;                                                  ///< Initial composition of components in all phases
     Tensor<double, 2> MoleFractionsAverage;                                     ///< Average composition of components in all phases
@@ -248,6 +253,7 @@ class OP_EXPORTS Composition : public OPObject
     void CalculateMoleFractionsTotalAverage(void);
     void CalculateMoleFractionsAverage(PhaseField& Phase);
     void CalculateTotalMolarVolume(void);
+    void SetMoleFractionsTotalAverage(const Tensor<double, 1>& LocalSum);       ///< Sets MoleFractionsTotalAverage from the sum of the local total mole fractions
 
     std::vector<Element> Component;                                             ///< List of all chemical components present in the phases
     std::vector<ThermodynamicPhase> Phase;                                      ///< Phases considered in the simulation
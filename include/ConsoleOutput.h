@@ -72,11 +72,25 @@ class OP_EXPORTS ConsoleOutput
     inline static std::ofstream LogFile;                                        ///< Log file stream
     inline static bool LogEnabled = false;                                      ///< Whether logging is enabled
     inline static std::streambuf* CoutBuf = nullptr;                            ///< backup of cout rdbuf when redirecting
+    inline static double LogFlushInterval = 1.0;                                ///< Minimum time in seconds between two flushes of the log file
+    // Warning aggregation: identical warnings (same instance, method and
+    // message) are counted in a per-thread buffer. With AggregateWarnings all
+    // warnings are held back and printed as a summary of all threads and MPI
+    // ranks by FlushWarnings(). Otherwise each distinct warning is printed at
+    // most WarningRateLimit times by each thread between two flushes, the
+    // suppressed repetitions are summarized by FlushWarnings().
+    inline static bool AggregateWarnings = false;                               ///< Hold back warnings and print per step summaries from rank 0
+    inline static size_t WarningRateLimit = 10;                                 ///< Immediate prints of identical warnings per thread between two flushes, 0 disables the limit
 
     /// Initialize logging to file. If filename is empty, logging is disabled.
     static void InitLogFile(const std::string& filename, VerbosityLevels consoleVerbosity = VerbosityLevels::Warning);
     static void CloseLogFile();
     static void WriteToLog(const std::string& message);
+    /// Prints the summary of the buffered warnings and clears the buffers.
+    /// Has to be called outside of OpenMP parallel regions and, if
+    /// AggregateWarnings is set, by all MPI ranks. It is called by
+    /// WriteTimeStep(RTC, ...).
+    static void FlushWarnings(void);
 
     /// Return white space for positive values to align positive and negative
     /// numbers vertically
@@ -36,6 +36,7 @@
 #include "Containers/dMatrix6x6.h"
 #include "Containers/dVector.h"
 #include "Containers/dVectorN.h"
+#include "Containers/VectorExpressions.h"
 #include "Containers/dMatrixNxN.h"
 #include "Containers/MatrixVectorOperators.h"
 #include "Containers/Matrix.h"
@@ -45,19 +46,26 @@
 #include "Containers/Storage.h"
 #include "Containers/Storage1D.h"
 #include "Containers/Storage3D.h"
+#include "Containers/BrickStorage3D.h"
 #include "Containers/NodeVectorN.h"
 #include "Containers/NodeVn.h"
 #include "Containers/NodeA.h"
+#include "Containers/SparseVectorStorage.h"
 #include "Containers/NodeAB.h"
 #include "Containers/NodeDF.h"
 #include "Containers/NodePF.h"
+#include "Containers/FlatStoragePF.h"
+#include "Containers/OccupancyMap.h"
 #include "Containers/NodeIP.h"
 #include "Containers/SparseMatrix.h"
 #include "Containers/GradientStencil.h"
 #include "Containers/LaplacianStencil.h"
+#include "Containers/FixedStencils.h"
+#include "Containers/StencilKernels.h"
 #include "Containers/OMPReductions.h"
 #include "Containers/TypeTraits.h"
 #include "Containers/Table.h"
+#include "Containers/InterpolationTable.h"
 #include "Containers/EquilibriumData.h"
 
 #endif
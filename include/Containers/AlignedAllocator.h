@@ -0,0 +1,116 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef OP_SIMD_ALIGNMENT
+#define OP_SIMD_ALIGNMENT 64                                                    ///< Alignment of numerical storage data in bytes (cache line and AVX-512 register size)
+#endif
+
+namespace openphase
+{
+
+template<class T, size_t Alignment = OP_SIMD_ALIGNMENT>
+class AlignedAllocator                                                          ///< STL allocator returning memory aligned to "Alignment" bytes
+{
+ public:
+    typedef T value_type;
+
+    template<class U>
+    struct rebind
+    {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() noexcept {};
+    template<class U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {};
+
+    T* allocate(const size_t n)
+    {
+        return static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* ptr, const size_t) noexcept
+    {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+#ifdef NUMA_FIRST_TOUCH
+    /* Default construction leaves numerical values uninitialized, the memory
+    is not touched until ResizeStorage() writes it in parallel */
+    template<class U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible<U>::value)
+    {
+        ::new(static_cast<void*>(ptr)) U;
+    }
+    template<class U, class... Args>
+    void construct(U* ptr, Args&&... args)
+    {
+        ::new(static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+    }
+#endif
+
+    template<class U> bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {return true;};
+    template<class U> bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {return false;};
+};
+
+template<class T>
+using StorageVector = std::vector<T, typename std::conditional<
+        std::is_arithmetic<T>::value and not std::is_same<T, bool>::value,
+        AlignedAllocator<T>, std::allocator<T>>::type>;                         ///< Data vector of the storages: aligned for numerical types, standard otherwise
+
+template<class T, class Allocator>
+void ResizeStorage(std::vector<T, Allocator>& Data, const size_t Size)          ///< Resizes a storage data vector, with NUMA_FIRST_TOUCH numerical data is reallocated and zeroed in parallel
+{
+#ifdef NUMA_FIRST_TOUCH
+    if constexpr (std::is_arithmetic<T>::value and not std::is_same<T, bool>::value)
+    {
+        /* Linux maps a page to the NUMA node of the thread writing it first.
+        The static partition of the elements matches the one of the storage
+        loops (OMP_STORAGE_SCHEDULE in Macros.h), the previous content is
+        dropped as the layout changes with the size anyway */
+        if(Size == Data.size()) return;
+        std::vector<T, Allocator> Fresh;
+        Fresh.resize(Size);
+        #pragma omp parallel for schedule(static)
+        for(size_t n = 0; n < Size; n++)
+        {
+            Fresh[n] = T();
+        }
+        Data.swap(Fresh);
+        return;
+    }
+#endif
+    Data.resize(Size);
+}
+
+}// namespace openphase
+#endif
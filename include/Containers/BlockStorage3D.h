@@ -0,0 +1,440 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef BLOCKSTORAGE3D_H
+#define BLOCKSTORAGE3D_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include "Globals.h"
+#include "GridParameters.h"
+#include "Storage3D.h"
+
+namespace openphase
+{
+
+template <class T>
+class BlockStorage3D                                                            ///< Block-structured adaptive storage: one Storage3D per root block, refined per block
+{
+    /* The coarse grid (GridParameters Nx, Ny, Nz) is divided into root blocks
+    of BlockSize^d cells. Each root block is covered by one uniform block of
+    refinement level 0 ... MaxLevel with (BlockSize*2^Level)^d cells and its
+    own ghost cells, so memory and work scale with the number of refined
+    blocks. Neighbouring blocks differ by at most one level (Balance()).
+    Refinement uses a minmod-limited linear prolongation (piecewise constant
+    for non-arithmetic types) and coarsening averages the children, both
+    conserve the block integral exactly and keep the values within the range
+    of the neighbouring coarse values. Ghost cells are sampled from the
+    neighbouring blocks at the level of the receiving block: copied on the
+    same level, injected from coarser and averaged from finer blocks.
+    Fields coupled to each other are kept in separate BlockStorage3D objects
+    adapted with the same target levels. */
+ public:
+    enum class Prolongations                                                    ///< Interpolation used for refinement
+    {
+        Constant,                                                               ///< Piecewise constant injection
+        Linear                                                                  ///< Minmod-limited linear interpolation (arithmetic types only)
+    };
+
+    struct Block                                                                ///< Leaf block covering one root block
+    {
+        long int X = 0;                                                         ///< Root block position in x direction
+        long int Y = 0;                                                         ///< Root block position in y direction
+        long int Z = 0;                                                         ///< Root block position in z direction
+        int Level = 0;                                                          ///< Refinement level
+        Storage3D<T,0> Data;                                                    ///< Block data with ghost cells
+    };
+
+    void Initialize(const GridParameters& Grid, const long int blockSize,
+                    const int maxLevel, const long int ghostCells,
+                    const std::array<bool,3> periodic)                          ///< Creates level 0 blocks over the coarse grid
+    {
+        dX = Grid.dNx;
+        dY = Grid.dNy;
+        dZ = Grid.dNz;
+        BlockSize = blockSize;
+        MaxLevel = maxLevel;
+        Ghost = ghostCells;
+        Periodic = periodic;
+        Dimensions = dX + dY + dZ;
+
+        if(BlockSize < 1 or Ghost < 1 or MaxLevel < 0 or
+           (dX and Grid.Nx % BlockSize) or (dY and Grid.Ny % BlockSize) or
+           (dZ and Grid.Nz % BlockSize))
+        {
+            std::cerr << "ERROR: BlockStorage3D::Initialize()\n"
+                      << "The grid size has to be a multiple of the block size,"
+                      << " at least one ghost cell is needed!\n"
+                      << "Terminating!!!\n";
+            OP_Exit(EXIT_FAILURE);
+        }
+        NBx = dX ? Grid.Nx/BlockSize : 1;
+        NBy = dY ? Grid.Ny/BlockSize : 1;
+        NBz = dZ ? Grid.Nz/BlockSize : 1;
+
+        Blocks.clear();
+        Blocks.resize(NBx*NBy*NBz);
+        for(long int x = 0; x < NBx; x++)
+        for(long int y = 0; y < NBy; y++)
+        for(long int z = 0; z < NBz; z++)
+        {
+            Block& B = Blocks[Root(x,y,z)];
+            B.X = x;
+            B.Y = y;
+            B.Z = z;
+            B.Level = 0;
+            B.Data = Storage3D<T,0>(Cells(0,dX), Cells(0,dY), Cells(0,dZ), dX, dY, dZ, Ghost);
+        }
+    }
+
+    void Set(const Storage3D<T,0>& Coarse)                                      ///< Sets all blocks to the values of a coarse grid field, refined blocks by injection
+    {
+        #pragma omp parallel for schedule(dynamic)
+        for(size_t n = 0; n < Blocks.size(); n++)
+        {
+            Block& B = Blocks[n];
+            const int s = B.Level;
+            for(long int i = 0; i < B.Data.sizeX(); i++)
+            for(long int j = 0; j < B.Data.sizeY(); j++)
+            for(long int k = 0; k < B.Data.sizeZ(); k++)
+            {
+                B.Data(i,j,k) = Coarse(B.X*BlockSize*dX + (i >> s),
+                                       B.Y*BlockSize*dY + (j >> s),
+                                       B.Z*BlockSize*dZ + (k >> s));
+            }
+        }
+    }
+
+    void Restrict(Storage3D<T,0>& Coarse) const                                 ///< Writes the averages of the blocks to a coarse grid field
+    {
+        #pragma omp parallel for schedule(dynamic)
+        for(size_t n = 0; n < Blocks.size(); n++)
+        {
+            const Block& B = Blocks[n];
+            for(long int i = 0; i < Cells(0,dX); i++)
+            for(long int j = 0; j < Cells(0,dY); j++)
+            for(long int k = 0; k < Cells(0,dZ); k++)
+            {
+                Coarse(B.X*BlockSize*dX + i, B.Y*BlockSize*dY + j, B.Z*BlockSize*dZ + k) =
+                        Average(B, B.Level, i, j, k);
+            }
+        }
+    }
+
+    template<class Predicate>
+    std::vector<int> Tag(Predicate&& Condition, const int Level,
+                         const long int Buffer = 1) const                       ///< Target levels: Level for blocks with a cell fulfilling Condition(value) and their Buffer block neighbourhood, 0 elsewhere
+    {
+        std::vector<int> Tagged(Blocks.size(), 0);
+        #pragma omp parallel for schedule(dynamic)
+        for(size_t n = 0; n < Blocks.size(); n++)
+        {
+            const Block& B = Blocks[n];
+            bool found = false;
+            for(long int i = 0; i < B.Data.sizeX() and not found; i++)
+            for(long int j = 0; j < B.Data.sizeY() and not found; j++)
+            for(long int k = 0; k < B.Data.sizeZ() and not found; k++)
+            {
+                found = Condition(B.Data(i,j,k));
+            }
+            Tagged[n] = found;
+        }
+        std::vector<int> Target(Blocks.size(), 0);
+        for(size_t n = 0; n < Blocks.size(); n++)
+        if(Tagged[n])
+        {
+            ForNeighbours(n, Buffer, [&](const size_t m){Target[m] = std::min(Level, MaxLevel);});
+        }
+        return Target;
+    }
+
+    void Balance(std::vector<int>& Target) const                                ///< Raises target levels until neighbouring blocks differ by at most one level
+    {
+        bool changed = true;
+        while(changed)
+        {
+            changed = false;
+            for(size_t n = 0; n < Blocks.size(); n++)
+            {
+                ForNeighbours(n, 1, [&](const size_t m)
+                {
+                    if(Target[m] < Target[n] - 1)
+                    {
+                        Target[m] = Target[n] - 1;
+                        changed = true;
+                    }
+                });
+            }
+        }
+    }
+
+    void Adapt(std::vector<int> Target)                                         ///< Refines and coarsens the blocks to the (balanced) target levels
+    {
+        Balance(Target);
+        SetGhostCells();
+        for(size_t n = 0; n < Blocks.size(); n++)
+        {
+            Target[n] = std::max(0, std::min(Target[n], MaxLevel));
+            while(Blocks[n].Level < Target[n])
+            {
+                Refine(n);
+            }
+            while(Blocks[n].Level > Target[n])
+            {
+                Coarsen(n);
+            }
+        }
+        SetGhostCells();
+    }
+
+    void SetGhostCells(void)                                                    ///< Fills the ghost cells of all blocks from their neighbours
+    {
+        #pragma omp parallel for schedule(dynamic)
+        for(size_t n = 0; n < Blocks.size(); n++)
+        {
+            SetGhostCells(n);
+        }
+    }
+
+    T Value(const int Level, long int I, long int J, long int K) const          ///< Value at cell (I,J,K) of the uniform grid of the given level, periodic or zero gradient outside
+    {
+        I = Wrap(I, dX ? (NBx*BlockSize) << Level : 1, Periodic[0]);
+        J = Wrap(J, dY ? (NBy*BlockSize) << Level : 1, Periodic[1]);
+        K = Wrap(K, dZ ? (NBz*BlockSize) << Level : 1, Periodic[2]);
+
+        const long int nX = Cells(Level,dX);
+        const long int nY = Cells(Level,dY);
+        const long int nZ = Cells(Level,dZ);
+        const Block& B = Blocks[Root(I/nX, J/nY, K/nZ)];
+        I -= B.X*nX;
+        J -= B.Y*nY;
+        K -= B.Z*nZ;
+
+        if(B.Level >= Level)
+        {
+            return Average(B, Level, I, J, K);
+        }
+        const int s = Level - B.Level;
+        return B.Data(I >> s*dX, J >> s*dY, K >> s*dZ);
+    }
+
+    double Integral(void) const                                                 ///< Sum of the values weighted by the cell volume in units of coarse cells (arithmetic types)
+    {
+        double Sum = 0.0;
+        for(const Block& B : Blocks)
+        {
+            double locSum = 0.0;
+            for(long int i = 0; i < B.Data.sizeX(); i++)
+            for(long int j = 0; j < B.Data.sizeY(); j++)
+            for(long int k = 0; k < B.Data.sizeZ(); k++)
+            {
+                locSum += B.Data(i,j,k);
+            }
+            Sum += locSum/double(1l << (B.Level*Dimensions));
+        }
+        return Sum;
+    }
+
+    size_t NumberOfBlocks(void) const
+    {
+        return Blocks.size();
+    }
+    Block& operator[](const size_t n)
+    {
+        return Blocks[n];
+    }
+    const Block& operator[](const size_t n) const
+    {
+        return Blocks[n];
+    }
+    size_t NumberOfCells(void) const                                            ///< Number of cells of all blocks, without ghost cells
+    {
+        size_t Sum = 0;
+        for(const Block& B : Blocks)
+        {
+            Sum += B.Data.sizeX()*B.Data.sizeY()*B.Data.sizeZ();
+        }
+        return Sum;
+    }
+    size_t NumberOfUniformCells(void) const                                     ///< Number of cells of a uniform grid at MaxLevel
+    {
+        return Blocks.size()*Cells(MaxLevel,dX)*Cells(MaxLevel,dY)*Cells(MaxLevel,dZ);
+    }
+    int Levels(void) const
+    {
+        return MaxLevel;
+    }
+
+    Prolongations Prolongation = Prolongations::Linear;                         ///< Interpolation used for refinement
+
+ private:
+    std::vector<Block> Blocks;                                                  ///< Leaf blocks, one per root block
+    long int NBx = 0;                                                           ///< Number of root blocks in x direction
+    long int NBy = 0;                                                           ///< Number of root blocks in y direction
+    long int NBz = 0;                                                           ///< Number of root blocks in z direction
+    long int BlockSize = 0;                                                     ///< Root block size in coarse cells
+    long int Ghost = 0;                                                         ///< Ghost cells of the blocks
+    int MaxLevel = 0;                                                           ///< Highest refinement level
+    int dX = 0;                                                                 ///< Active x dimension (0 or 1)
+    int dY = 0;                                                                 ///< Active y dimension (0 or 1)
+    int dZ = 0;                                                                 ///< Active z dimension (0 or 1)
+    int Dimensions = 0;                                                         ///< Number of active dimensions
+    std::array<bool,3> Periodic = {true, true, true};                           ///< Periodic (true) or zero gradient (false) boundaries
+
+    size_t Root(const long int x, const long int y, const long int z) const
+    {
+        return (x*NBy + y)*NBz + z;
+    }
+    long int Cells(const int Level, const int active) const                     ///< Block size at the given level along a direction
+    {
+        return active ? BlockSize << Level : 1;
+    }
+    static long int Wrap(const long int I, const long int N, const bool periodic)
+    {
+        if(periodic) return ((I % N) + N) % N;
+        return std::min(std::max(I, 0l), N - 1);
+    }
+
+    template<class Function>
+    void ForNeighbours(const size_t n, const long int Range, Function&& Body) const ///< Calls Body(m) for the blocks within Range root blocks of block n (including n)
+    {
+        const Block& B = Blocks[n];
+        for(long int x = -Range*dX; x <= Range*dX; x++)
+        for(long int y = -Range*dY; y <= Range*dY; y++)
+        for(long int z = -Range*dZ; z <= Range*dZ; z++)
+        {
+            long int bx = B.X + x;
+            long int by = B.Y + y;
+            long int bz = B.Z + z;
+            if(not Periodic[0] and (bx < 0 or bx >= NBx)) continue;
+            if(not Periodic[1] and (by < 0 or by >= NBy)) continue;
+            if(not Periodic[2] and (bz < 0 or bz >= NBz)) continue;
+            Body(Root((bx + NBx) % NBx, (by + NBy) % NBy, (bz + NBz) % NBz));
+        }
+    }
+
+    T Average(const Block& B, const int Level, const long int I,
+              const long int J, const long int K) const                         ///< Value of cell (I,J,K) of block B at a level not finer than B.Level
+    {
+        const int s = B.Level - Level;
+        if(s == 0) return B.Data(I,J,K);
+
+        const long int n = 1l << s;
+        T Sum = T();
+        for(long int i = 0; i < (dX ? n : 1); i++)
+        for(long int j = 0; j < (dY ? n : 1); j++)
+        for(long int k = 0; k < (dZ ? n : 1); k++)
+        {
+            Sum += B.Data((I << s*dX) + i, (J << s*dY) + j, (K << s*dZ) + k);
+        }
+        return Sum*(1.0/double(1l << (s*Dimensions)));
+    }
+
+    void SetGhostCells(const size_t n)
+    {
+        Block& B = Blocks[n];
+        const long int nX = B.Data.sizeX();
+        const long int nY = B.Data.sizeY();
+        const long int nZ = B.Data.sizeZ();
+        const long int gX = Ghost*dX;
+        const long int gY = Ghost*dY;
+        const long int gZ = Ghost*dZ;
+        for(long int i = -gX; i < nX + gX; i++)
+        for(long int j = -gY; j < nY + gY; j++)
+        for(long int k = -gZ; k < nZ + gZ; k++)
+        if(i < 0 or i >= nX or j < 0 or j >= nY or k < 0 or k >= nZ)
+        {
+            B.Data(i,j,k) = Value(B.Level, B.X*nX*dX + i, B.Y*nY*dY + j, B.Z*nZ*dZ + k);
+        }
+    }
+
+    static double MinMod(const double a, const double b)
+    {
+        if(a*b <= 0.0) return 0.0;
+        return (std::fabs(a) < std::fabs(b)) ? a : b;
+    }
+
+    void Refine(const size_t n)                                                 ///< Prolongation of block n by one level, needs its ghost cells
+    {
+        Block& B = Blocks[n];
+        const int Level = B.Level + 1;
+        Storage3D<T,0> Fine(Cells(Level,dX), Cells(Level,dY), Cells(Level,dZ), dX, dY, dZ, Ghost);
+
+        #pragma omp parallel for collapse(3)
+        for(long int i = 0; i < Fine.sizeX(); i++)
+        for(long int j = 0; j < Fine.sizeY(); j++)
+        for(long int k = 0; k < Fine.sizeZ(); k++)
+        {
+            const long int ci = i >> dX;
+            const long int cj = j >> dY;
+            const long int ck = k >> dZ;
+            T value = B.Data(ci,cj,ck);
+            if constexpr (std::is_arithmetic<T>::value)
+            if(Prolongation == Prolongations::Linear)
+            {
+                /* Offsets of +-1/4 coarse cells average to zero over the
+                children, the limited slopes keep the values bounded */
+                const double c = B.Data(ci,cj,ck);
+                if(dX) value += 0.25*((i & 1) ? 1.0 : -1.0)*
+                        MinMod(B.Data(ci+1,cj,ck) - c, c - B.Data(ci-1,cj,ck));
+                if(dY) value += 0.25*((j & 1) ? 1.0 : -1.0)*
+                        MinMod(B.Data(ci,cj+1,ck) - c, c - B.Data(ci,cj-1,ck));
+                if(dZ) value += 0.25*((k & 1) ? 1.0 : -1.0)*
+                        MinMod(B.Data(ci,cj,ck+1) - c, c - B.Data(ci,cj,ck-1));
+            }
+            Fine(i,j,k) = value;
+        }
+        B.Data = Fine;
+        B.Level = Level;
+        SetGhostCells(n);
+    }
+
+    void Coarsen(const size_t n)                                                ///< Restriction of block n by one level
+    {
+        Block& B = Blocks[n];
+        const int Level = B.Level - 1;
+        Storage3D<T,0> Coarse(Cells(Level,dX), Cells(Level,dY), Cells(Level,dZ), dX, dY, dZ, Ghost);
+
+        #pragma omp parallel for collapse(3)
+        for(long int i = 0; i < Coarse.sizeX(); i++)
+        for(long int j = 0; j < Coarse.sizeY(); j++)
+        for(long int k = 0; k < Coarse.sizeZ(); k++)
+        {
+            Coarse(i,j,k) = Average(B, Level, i, j, k);
+        }
+        B.Data = Coarse;
+        B.Level = Level;
+        SetGhostCells(n);
+    }
+};
+
+}// namespace openphase
+#endif
@@ -0,0 +1,251 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef BRICKSTORAGE3D_H
+#define BRICKSTORAGE3D_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+#include "AlignedAllocator.h"
+#include "GridParameters.h"
+#include "Storage3D.h"
+
+namespace openphase
+{
+
+template <class T, size_t Brick = 4>
+class BrickStorage3D                                                            ///< 3D storage of cell values in cubic bricks of Brick^3 cells
+{
+    /* Storage3D keeps the cells in row-major (x,y,z) order, the neighbors of
+    a cell in x and y direction are therefore one row or one plane apart. For
+    large 3D grids a stencil touches three distant planes, which costs cache
+    lines and TLB entries. Here the grid (including the boundary cells) is
+    divided into bricks of Brick cells per active dimension. The cells of a
+    brick are contiguous in memory and the bricks are stored in (x,y,z) order,
+    so most neighbors of a cell are within the same few kilobytes.
+
+    The storage provides the same cell access and size queries as
+    Storage3D<T,0> (operator()(x,y,z), sizeX(), Bcells(), BcellsX(), ...), so
+    the storage loop macros and kernels templated on the storage type work
+    with both layouts. The layout is chosen per storage by its type.
+    ParallelBrickLoop() walks the cells in memory order. Cells are not
+    contiguous along z, code using row pointers (e.g. StencilKernels) or
+    Storage3D specific methods (boundary conditions, MPI packing, file output)
+    has to work on a Storage3D copy, see CopyFrom() and CopyTo().*/
+ public:
+    static_assert(Brick > 0 and (Brick & (Brick - 1)) == 0,
+                  "BrickStorage3D: the brick size has to be a power of two");
+
+    void Allocate(const long int nx, const long int ny, const long int nz,
+                  const long int dnx, const long int dny, const long int dnz,
+                  const long int bc)                                            ///< Allocates nx*ny*nz cells with bc boundary cells in active directions
+    {
+        Size_X = nx;
+        Size_Y = ny;
+        Size_Z = nz;
+
+        DX = dnx;
+        DY = dny;
+        DZ = dnz;
+
+        b_cells = bc;
+
+        ShiftX = (DX and Brick > 1) ? Log2(Brick) : 0;
+        ShiftY = (DY and Brick > 1) ? Log2(Brick) : 0;
+        ShiftZ = (DZ and Brick > 1) ? Log2(Brick) : 0;
+        MaskX = (size_t(1) << ShiftX) - 1;
+        MaskY = (size_t(1) << ShiftY) - 1;
+        MaskZ = (size_t(1) << ShiftZ) - 1;
+
+        Bricks_X = (Size_X + 2*b_cells*DX + MaskX) >> ShiftX;
+        Bricks_Y = (Size_Y + 2*b_cells*DY + MaskY) >> ShiftY;
+        Bricks_Z = (Size_Z + 2*b_cells*DZ + MaskZ) >> ShiftZ;
+
+        ResizeStorage(locData, (Bricks_X*Bricks_Y*Bricks_Z) << (ShiftX + ShiftY + ShiftZ));
+    }
+    void Allocate(const GridParameters& Dimensions, const long int bc)          ///< Same local sizes as Storage3D::Allocate(Dimensions, bc)
+    {
+        Allocate(Dimensions.Nx*Dimensions.dNx + 1 - Dimensions.dNx,
+                 Dimensions.Ny*Dimensions.dNy + 1 - Dimensions.dNy,
+                 Dimensions.Nz*Dimensions.dNz + 1 - Dimensions.dNz,
+                 Dimensions.dNx, Dimensions.dNy, Dimensions.dNz, bc);
+    }
+    template<class Space>
+    void Allocate(const Storage3D<T,0,Space>& Field)                            ///< Same sizes and boundary cells as Field
+    {
+        Allocate(Field.sizeX(), Field.sizeY(), Field.sizeZ(),
+                 Field.dNx(), Field.dNy(), Field.dNz(), Field.Bcells());
+    }
+    bool IsAllocated() const
+    {
+        return not locData.empty();
+    }
+    bool IsNotAllocated() const
+    {
+        return locData.empty();
+    }
+
+    T& operator()(const long int x, const long int y, const long int z)
+    {
+        return locData[Index(x,y,z)];
+    }
+    T const& operator()(const long int x, const long int y, const long int z) const
+    {
+        return locData[Index(x,y,z)];
+    }
+
+    long int sizeX() const {return Size_X;}
+    long int sizeY() const {return Size_Y;}
+    long int sizeZ() const {return Size_Z;}
+    long int dNx() const {return DX;}
+    long int dNy() const {return DY;}
+    long int dNz() const {return DZ;}
+    long int Bcells() const {return b_cells;}
+    long int BcellsX() const {return b_cells*DX;}
+    long int BcellsY() const {return b_cells*DY;}
+    long int BcellsZ() const {return b_cells*DZ;}
+
+    size_t Bricks() const {return Bricks_X*Bricks_Y*Bricks_Z;}                  ///< Number of bricks including the partially used ones at the upper ends
+    size_t AllocatedMemory() const                                              ///< Memory held by the storage in bytes
+    {
+        return locData.capacity()*sizeof(T);
+    }
+    T* data() {return locData.data();}
+    const T* data() const {return locData.data();}
+
+    size_t Index(const long int x, const long int y, const long int z) const    ///< Position of cell (x,y,z) in the data buffer
+    {
+        assert(x >= -b_cells*DX and x < Size_X + b_cells*DX && "Access beyond storage range");
+        assert(y >= -b_cells*DY and y < Size_Y + b_cells*DY && "Access beyond storage range");
+        assert(z >= -b_cells*DZ and z < Size_Z + b_cells*DZ && "Access beyond storage range");
+
+        const size_t xs = x + b_cells*DX;
+        const size_t ys = y + b_cells*DY;
+        const size_t zs = z + b_cells*DZ;
+        const size_t brick = ((xs >> ShiftX)*Bricks_Y + (ys >> ShiftY))*Bricks_Z + (zs >> ShiftZ);
+        const size_t cell  = ((((xs & MaskX) << ShiftY) + (ys & MaskY)) << ShiftZ) + (zs & MaskZ);
+        return (brick << (ShiftX + ShiftY + ShiftZ)) + cell;
+    }
+
+    template<class Function>
+    void ParallelBrickLoop(const long int bcells, Function&& Body) const        ///< Calls Body(x,y,z) for all cells within "bcells" of the interior in memory order, the bricks are distributed over the OpenMP threads
+    {
+        const long int bX = b_cells*DX;
+        const long int bY = b_cells*DY;
+        const long int bZ = b_cells*DZ;
+        const long int lowerX = -std::min(bX, bcells);
+        const long int lowerY = -std::min(bY, bcells);
+        const long int lowerZ = -std::min(bZ, bcells);
+        const long int upperX = Size_X + std::min(bX, bcells);
+        const long int upperY = Size_Y + std::min(bY, bcells);
+        const long int upperZ = Size_Z + std::min(bZ, bcells);
+        const long int EdgeX = long(1) << ShiftX;
+        const long int EdgeY = long(1) << ShiftY;
+        const long int EdgeZ = long(1) << ShiftZ;
+        const long int NBx = Bricks_X;
+        const long int NBy = Bricks_Y;
+        const long int NBz = Bricks_Z;
+
+        #pragma omp parallel for collapse(3) schedule(static)
+        for(long int bx = 0; bx < NBx; bx++)
+        for(long int by = 0; by < NBy; by++)
+        for(long int bz = 0; bz < NBz; bz++)
+        {
+            const long int x0 = std::max(lowerX, bx*EdgeX - bX);
+            const long int y0 = std::max(lowerY, by*EdgeY - bY);
+            const long int z0 = std::max(lowerZ, bz*EdgeZ - bZ);
+            const long int x1 = std::min(upperX, (bx + 1)*EdgeX - bX);
+            const long int y1 = std::min(upperY, (by + 1)*EdgeY - bY);
+            const long int z1 = std::min(upperZ, (bz + 1)*EdgeZ - bZ);
+            for(long int x = x0; x < x1; x++)
+            for(long int y = y0; y < y1; y++)
+            for(long int z = z0; z < z1; z++)
+            {
+                Body(x,y,z);
+            }
+        }
+    }
+
+    template<class Space>
+    void CopyFrom(const Storage3D<T,0,Space>& Field)                            ///< Copies all cells including the boundary cells, allocates the storage if needed
+    {
+        if(IsNotAllocated() or Size_X != Field.sizeX() or Size_Y != Field.sizeY()
+           or Size_Z != Field.sizeZ() or b_cells != Field.Bcells())
+        {
+            Allocate(Field);
+        }
+        ParallelBrickLoop(b_cells, [&](long int x, long int y, long int z)
+        {
+            (*this)(x,y,z) = Field(x,y,z);
+        });
+    }
+    template<class Space>
+    void CopyTo(Storage3D<T,0,Space>& Field) const                              ///< Copies all cells including the boundary cells into an allocated storage of the same size
+    {
+        assert(Field.sizeX() == Size_X and Field.sizeY() == Size_Y and
+               Field.sizeZ() == Size_Z and Field.Bcells() == b_cells &&
+               "BrickStorage3D::CopyTo(): storage sizes do not match");
+        ParallelBrickLoop(b_cells, [&](long int x, long int y, long int z)
+        {
+            Field(x,y,z) = (*this)(x,y,z);
+        });
+    }
+
+ protected:
+ private:
+    static constexpr size_t Log2(const size_t n)
+    {
+        return (n > 1) ? 1 + Log2(n/2) : 0;
+    }
+
+    long int Size_X = 0;
+    long int Size_Y = 0;
+    long int Size_Z = 0;
+
+    long int DX = 0;
+    long int DY = 0;
+    long int DZ = 0;
+
+    long int b_cells = 0;
+
+    size_t ShiftX = 0;                                                          ///< log2 of the brick edge in x, 0 for inactive directions
+    size_t ShiftY = 0;                                                          ///< log2 of the brick edge in y, 0 for inactive directions
+    size_t ShiftZ = 0;                                                          ///< log2 of the brick edge in z, 0 for inactive directions
+    size_t MaskX = 0;
+    size_t MaskY = 0;
+    size_t MaskZ = 0;
+
+    size_t Bricks_X = 0;
+    size_t Bricks_Y = 0;
+    size_t Bricks_Z = 0;
+
+    StorageVector<T> locData;
+};
+
+}// namespace openphase
+#endif
@@ -0,0 +1,324 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+/*
+ * Compile-time variants of the Laplacian and gradient stencils. The elements
+ * of FixedLaplacianStencil and FixedGradientStencil are generated at compile
+ * time from the stencil tables in LaplacianStencil.h and GradientStencil.h for
+ * a given set of active dimensions. ForEach() unrolls the loop over the
+ * elements, so that offsets and weights become immediate constants and a
+ * stencil application compiles to straight-line multiply-add code.
+ *
+ * The weights are not scaled by the grid spacing, the result has to be
+ * multiplied by 1/dx^2 (Laplacian) or 1/dx (gradient) by the caller.
+ *
+ * FixedStencils::Laplacian(), Gradient() and LaplacianAndGradient() select the
+ * stencils matching the run-time choice (stencil type and active dimensions)
+ * once and call the given function with default constructed stencil objects:
+ *
+ *     FixedStencils::Laplacian(Type, Grid, [&](auto Stencil)
+ *     {
+ *         Kernel<decltype(Stencil)>(...);
+ *     });
+ */
+
+#ifndef FIXEDSTENCILS_H
+#define FIXEDSTENCILS_H
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "GridParameters.h"
+#include "LaplacianStencil.h"
+#include "GradientStencil.h"
+
+namespace openphase
+{
+
+template<const double (&Table)[3][3][3], int dNx, int dNy, int dNz>
+constexpr size_t FixedStencilSize(void)                                         ///< Number of nonzero table elements within the active dimensions
+{
+    size_t n = 0;
+    for(int x = -dNx; x <= dNx; ++x)
+    for(int y = -dNy; y <= dNy; ++y)
+    for(int z = -dNz; z <= dNz; ++z)
+    if(Table[x+1][y+1][z+1] != 0.0)
+    {
+        n++;
+    }
+    return n;
+}
+
+template<const double (&Table)[3][3][3], int dNx, int dNy, int dNz, size_t Size>
+constexpr std::array<LaplacianStencil::LaplacianStencilEntry, Size>
+FixedLaplacianStencilElements(void)                                             ///< Same elements as LaplacianStencil::Set() with dx = 1
+{
+    std::array<LaplacianStencil::LaplacianStencilEntry, Size> elements{};
+    size_t n = 0;
+    for(int x = -dNx; x <= dNx; ++x)
+    for(int y = -dNy; y <= dNy; ++y)
+    for(int z = -dNz; z <= dNz; ++z)
+    if(Table[x+1][y+1][z+1] != 0.0)
+    {
+        elements[n++] = {x, y, z, Table[x+1][y+1][z+1]};
+    }
+    return elements;
+}
+
+template<const double (&Table)[3][3][3], int dNx, int dNy, int dNz, size_t Size>
+constexpr std::array<GradientStencil::GradientStencilEntry, Size>
+FixedGradientStencilElements(void)                                              ///< Same elements as GradientStencil::Set() with dx = 1
+{
+    std::array<GradientStencil::GradientStencilEntry, Size> elements{};
+    size_t n = 0;
+    for(int x = -dNx; x <= dNx; ++x)
+    for(int y = -dNy; y <= dNy; ++y)
+    for(int z = -dNz; z <= dNz; ++z)
+    if(Table[x+1][y+1][z+1] != 0.0)
+    {
+        elements[n++] = {x, y, z, x*Table[x+1][y+1][z+1],
+                                  y*Table[x+1][y+1][z+1],
+                                  z*Table[x+1][y+1][z+1]};
+    }
+    return elements;
+}
+
+template<const double (&Table)[3][3][3], int dNx, int dNy, int dNz>
+class FixedLaplacianStencil                                                     ///< Laplacian stencil with compile-time elements, weights for dx = 1
+{
+ public:
+    typedef LaplacianStencil::LaplacianStencilEntry Entry;
+    static constexpr size_t Size = FixedStencilSize<Table, dNx, dNy, dNz>();    ///< Number of stencil elements
+    static constexpr std::array<Entry, Size> Elements =
+        FixedLaplacianStencilElements<Table, dNx, dNy, dNz, Size>();            ///< Stencil elements
+
+    template<class Function>
+    static inline void ForEach(Function&& f)                                    ///< Calls f(element, n) for all elements, the loop is unrolled
+    {
+        ForEach(f, std::make_index_sequence<Size>());
+    }
+ private:
+    template<class Function, size_t... n>
+    static inline void ForEach(Function& f, std::index_sequence<n...>)
+    {
+        (f(Elements[n], n), ...);
+    }
+};
+
+template<const double (&Table)[3][3][3], int dNx, int dNy, int dNz>
+class FixedGradientStencil                                                      ///< Gradient stencil with compile-time elements, weights for dx = 1
+{
+ public:
+    typedef GradientStencil::GradientStencilEntry Entry;
+    static constexpr size_t Size = FixedStencilSize<Table, dNx, dNy, dNz>();    ///< Number of stencil elements
+    static constexpr std::array<Entry, Size> Elements =
+        FixedGradientStencilElements<Table, dNx, dNy, dNz, Size>();             ///< Stencil elements
+
+    template<class Function>
+    static inline void ForEach(Function&& f)                                    ///< Calls f(element, n) for all elements, the loop is unrolled
+    {
+        ForEach(f, std::make_index_sequence<Size>());
+    }
+ private:
+    template<class Function, size_t... n>
+    static inline void ForEach(Function& f, std::index_sequence<n...>)
+    {
+        (f(Elements[n], n), ...);
+    }
+};
+
+class FixedStencils                                                             ///< Selects the compile-time stencils matching the run-time stencil choice
+{
+ public:
+    template<class Function>
+    static bool Laplacian(const LaplacianStencils Type,
+                          const GridParameters& Grid, Function&& f)             ///< Calls f(LaplacianStencil), returns false if no dimension is active
+    {
+        return SelectDimensions(Grid, [&](auto Dimensions)
+        {
+            typedef decltype(Dimensions) D;
+            SelectLaplacian<D::dNx, D::dNy, D::dNz>(Type, f);
+        });
+    }
+
+    template<class Function>
+    static bool Gradient(const GradientStencils Type,
+                         const GridParameters& Grid, Function&& f)              ///< Calls f(GradientStencil), returns false if no dimension is active
+    {
+        return SelectDimensions(Grid, [&](auto Dimensions)
+        {
+            typedef decltype(Dimensions) D;
+            SelectGradient<D::dNx, D::dNy, D::dNz>(Type, f);
+        });
+    }
+
+    template<class Function>
+    static bool LaplacianAndGradient(const LaplacianStencils LType,
+                                     const GradientStencils GType,
+                                     const GridParameters& Grid, Function&& f)  ///< Calls f(LaplacianStencil, GradientStencil), returns false if no dimension is active
+    {
+        return SelectDimensions(Grid, [&](auto Dimensions)
+        {
+            typedef decltype(Dimensions) D;
+            auto withLaplacian = [&](auto LStencil)
+            {
+                auto withGradient = [&](auto GStencil)
+                {
+                    f(LStencil, GStencil);
+                };
+                SelectGradient<D::dNx, D::dNy, D::dNz>(GType, withGradient);
+            };
+            SelectLaplacian<D::dNx, D::dNy, D::dNz>(LType, withLaplacian);
+        });
+    }
+
+ private:
+    template<int X, int Y, int Z>
+    struct ActiveDimensions                                                     ///< Compile-time copy of the stencil steps
+    {
+        static constexpr int dNx = X;
+        static constexpr int dNy = Y;
+        static constexpr int dNz = Z;
+    };
+
+    template<class Function>
+    static bool SelectDimensions(const GridParameters& Grid, Function&& f)
+    {
+        const int pattern = 4*Grid.dNx + 2*Grid.dNy + Grid.dNz;
+        switch(pattern)
+        {
+            case 1: f(ActiveDimensions<0,0,1>()); return true;
+            case 2: f(ActiveDimensions<0,1,0>()); return true;
+            case 3: f(ActiveDimensions<0,1,1>()); return true;
+            case 4: f(ActiveDimensions<1,0,0>()); return true;
+            case 5: f(ActiveDimensions<1,0,1>()); return true;
+            case 6: f(ActiveDimensions<1,1,0>()); return true;
+            case 7: f(ActiveDimensions<1,1,1>()); return true;
+            default: return false;
+        }
+    }
+
+    template<int dNx, int dNy, int dNz, class Function>
+    static void SelectLaplacian(const LaplacianStencils Type, Function& f)      ///< Same stencil choice as in PhaseField::SetStencils()
+    {
+        constexpr int active = dNx + dNy + dNz;
+        if constexpr (active == 1)
+        {
+            f(FixedLaplacianStencil<LaplacianStencil1D_3, dNx, dNy, dNz>());
+        }
+        else if constexpr (active == 2)
+        {
+            switch(Type)
+            {
+                case LaplacianStencils::Simple:
+                {
+                    f(FixedLaplacianStencil<LaplacianStencil2D_5, dNx, dNy, dNz>());
+                    break;
+                }
+                case LaplacianStencils::Isotropic:
+                {
+                    f(FixedLaplacianStencil<LaplacianStencil2D_9, dNx, dNy, dNz>());
+                    break;
+                }
+                case LaplacianStencils::LB:
+                {
+                    f(FixedLaplacianStencil<LaplacianStencil2D_LB, dNx, dNy, dNz>());
+                    break;
+                }
+            }
+        }
+        else
+        {
+            switch(Type)
+            {
+                case LaplacianStencils::Simple:
+                {
+                    f(FixedLaplacianStencil<LaplacianStencil3D_7, dNx, dNy, dNz>());
+                    break;
+                }
+                case LaplacianStencils::Isotropic:
+                {
+                    f(FixedLaplacianStencil<LaplacianStencil3D_27a, dNx, dNy, dNz>());
+                    break;
+                }
+                case LaplacianStencils::LB:
+                {
+                    f(FixedLaplacianStencil<LaplacianStencil3D_LB, dNx, dNy, dNz>());
+                    break;
+                }
+            }
+        }
+    }
+
+    template<int dNx, int dNy, int dNz, class Function>
+    static void SelectGradient(const GradientStencils Type, Function& f)        ///< Same stencil choice as in PhaseField::SetStencils()
+    {
+        constexpr int active = dNx + dNy + dNz;
+        if constexpr (active == 1)
+        {
+            f(FixedGradientStencil<GradientStencil1D, dNx, dNy, dNz>());
+        }
+        else
+        {
+            switch(Type)
+            {
+                case GradientStencils::Simple:
+                {
+                    f(FixedGradientStencil<GradientStencil1D, dNx, dNy, dNz>());
+                    break;
+                }
+                case GradientStencils::Isotropic:
+                {
+                    if constexpr (active == 2)
+                    {
+                        f(FixedGradientStencil<GradientStencil2D, dNx, dNy, dNz>());
+                    }
+                    else
+                    {
+                        f(FixedGradientStencil<GradientStencil3D, dNx, dNy, dNz>());
+                    }
+                    break;
+                }
+                case GradientStencils::LB:
+                {
+                    if constexpr (active == 2)
+                    {
+                        f(FixedGradientStencil<GradientStencil2D_LB, dNx, dNy, dNz>());
+                    }
+                    else
+                    {
+                        f(FixedGradientStencil<GradientStencil3D_LB, dNx, dNy, dNz>());
+                    }
+                    break;
+                }
+            }
+        }
+    }
+};
+
+}// namespace openphase
+#endif
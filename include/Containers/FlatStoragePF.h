@@ -0,0 +1,238 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef FLATSTORAGEPF_H
+#define FLATSTORAGEPF_H
+
+#include <vector>
+
+#include "Globals.h"
+#include "NodePF.h"
+#include "Storage3D.h"
+
+namespace openphase
+{
+/********************************* Declaration *******************************/
+
+struct FlatPhaseFieldEntry                                                      ///< Compact phase-field entry stored in the flat storage
+{
+    size_t index;                                                               ///< Phase-field index
+    double value;                                                               ///< Phase-field value
+};
+
+class NodePFView                                                                ///< Read-only view of a single grid cell in the flat storage. Mimics the constant part of the NodePF interface.
+{
+ public:
+    typedef const FlatPhaseFieldEntry* citerator;                               ///< Constant iterator over the cell entries
+
+    NodePFView(const FlatPhaseFieldEntry* first, const size_t count, const int locFlag) :
+        Begin(first),
+        Count(count),
+        flag(locFlag)
+    {
+
+    }
+
+    citerator cbegin() const {return Begin;};                                   ///< Constant iterator to the first entry of the cell
+    citerator cend()   const {return Begin + Count;};                           ///< Constant iterator past the last entry of the cell
+    citerator begin()  const {return Begin;};                                   ///< Same as cbegin(), allows range based loops
+    citerator end()    const {return Begin + Count;};                           ///< Same as cend(), allows range based loops
+    size_t    size()   const {return Count;};                                   ///< Number of phase fields in the cell
+
+    bool   present(const size_t idx) const;                                     ///< Returns true if the phase-field with a given index is present in the cell
+    double get_value(const size_t idx) const;                                   ///< Returns value of the phase field with a given index, 0.0 if not present
+    int    majority_index(void) const;                                          ///< Returns the index of the phase field with the largest value
+
+    bool   interface(void) const {return flag == 2;};                           ///< Returns true if flag == 2
+    bool   interface_halo(void) const {return flag == 1;};                      ///< Returns true if flag == 1
+    bool   wide_interface(void) const {return flag != 0;};                      ///< Returns true if flag != 0
+    bool   bulk(void) const {return flag != 2;};                                ///< Returns true if flag != 2
+
+ private:
+    const FlatPhaseFieldEntry* Begin;                                           ///< First entry of the cell
+    size_t Count;                                                               ///< Number of entries in the cell
+ public:
+    const int flag;                                                             ///< Interface flag of the cell (see NodePF::flag)
+};
+
+class FlatStoragePF                                                             ///< Flat (CSR-like) snapshot of a phase-field storage: per cell offset into one contiguous entry array
+{
+ public:
+    FlatStoragePF()
+    {
+        Size_Y_BC = 0;
+        Size_Z_BC = 0;
+        b_cells_X = 0;
+        b_cells_Y = 0;
+        b_cells_Z = 0;
+    }
+
+    void Rebuild(const Storage3D<NodePF,0>& Fields);                            ///< Rebuilds the flat storage from the NodePF storage, including boundary cells
+
+    NodePFView operator()(const long int x, const long int y, const long int z) const///< Returns read-only view of a grid cell
+    {
+        const size_t idx = Index(x,y,z);
+        return NodePFView(Entries.data() + Offsets[idx], Offsets[idx+1] - Offsets[idx], Flags[idx]);
+    }
+
+    NodePFView operator[](const size_t idx) const                               ///< Returns read-only view of a grid cell using linear index of the source storage
+    {
+        return NodePFView(Entries.data() + Offsets[idx], Offsets[idx+1] - Offsets[idx], Flags[idx]);
+    }
+
+    bool   IsAllocated() const {return not Offsets.empty();};                   ///< True if the storage has been built at least once
+    size_t tot_size()    const {return Flags.size();};                          ///< Number of cells including boundary cells
+    size_t NumberOfEntries() const {return Entries.size();};                    ///< Total number of stored phase-field entries
+    size_t AllocatedMemory() const                                              ///< Memory held by the flat storage in bytes
+    {
+        return Offsets.capacity()*sizeof(size_t) +
+               Flags.capacity()*sizeof(int) +
+               Entries.capacity()*sizeof(FlatPhaseFieldEntry);
+    }
+
+ private:
+    long int Size_Y_BC;
+    long int Size_Z_BC;
+    long int b_cells_X;
+    long int b_cells_Y;
+    long int b_cells_Z;
+
+    std::vector<size_t> Offsets;                                                ///< Offsets of the first entry of each cell, size is number of cells + 1
+    std::vector<int> Flags;                                                     ///< Interface flags of all cells
+    std::vector<FlatPhaseFieldEntry> Entries;                                   ///< Contiguous storage of all phase-field entries
+
+    size_t Index(const long int x, const long int y, const long int z) const    ///< Same linear index as used by Storage3D<NodePF,0>
+    {
+        return ((Size_Y_BC*(x + b_cells_X) + y + b_cells_Y)*Size_Z_BC + z + b_cells_Z);
+    }
+};
+
+/******************************* Implementation ******************************/
+
+inline bool NodePFView::present(const size_t idx) const
+{
+    for(auto it = cbegin(); it != cend(); ++it)
+    {
+        if(it->index == idx) return true;
+    }
+    return false;
+}
+
+inline double NodePFView::get_value(const size_t idx) const
+{
+    for(auto it = cbegin(); it != cend(); ++it)
+    {
+        if(it->index == idx) return it->value;
+    }
+    return 0.0;
+}
+
+inline int NodePFView::majority_index(void) const
+{
+    double max_value = 0.0;
+    int max_index = 0;
+    for(auto it = cbegin(); it != cend(); ++it)
+    if(it->value > max_value)
+    {
+        max_value = it->value;
+        max_index = it->index;
+    }
+    return max_index;
+}
+
+inline void FlatStoragePF::Rebuild(const Storage3D<NodePF,0>& Fields)
+{
+    b_cells_X = Fields.BcellsX();
+    b_cells_Y = Fields.BcellsY();
+    b_cells_Z = Fields.BcellsZ();
+    Size_Y_BC = Fields.sizeY() + 2*b_cells_Y;
+    Size_Z_BC = Fields.sizeZ() + 2*b_cells_Z;
+
+    const long int Ncells = Fields.tot_size();
+
+    Offsets.resize(Ncells + 1);
+    Flags.resize(Ncells);
+
+    // Count entries per cell
+    #pragma omp parallel for schedule(static)
+    for(long int idx = 0; idx < Ncells; idx++)
+    {
+        Offsets[idx+1] = Fields[idx].size();
+        Flags[idx]     = Fields[idx].flag;
+    }
+
+    // Exclusive prefix sum of the entry counts (two pass, blocked per thread)
+    Offsets[0] = 0;
+    int Nthreads = omp_get_max_threads();
+    std::vector<size_t> BlockSums(Nthreads + 1, 0);
+    #pragma omp parallel num_threads(Nthreads)
+    {
+        const int  thread = omp_get_thread_num();
+        const int  nth    = omp_get_num_threads();
+        const long int chunk  = (Ncells + nth - 1)/nth;
+        const long int first  = std::min(Ncells, thread*chunk);
+        const long int last   = std::min(Ncells, first + chunk);
+
+        size_t sum = 0;
+        for(long int idx = first; idx < last; idx++)
+        {
+            sum += Offsets[idx+1];
+            Offsets[idx+1] = sum;
+        }
+        BlockSums[thread + 1] = sum;
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for(int t = 0; t < nth; t++) BlockSums[t+1] += BlockSums[t];
+        }
+
+        const size_t shift = BlockSums[thread];
+        if(shift)
+        for(long int idx = first; idx < last; idx++)
+        {
+            Offsets[idx+1] += shift;
+        }
+    }
+
+    Entries.resize(Offsets[Ncells]);
+
+    // Copy entries
+    #pragma omp parallel for schedule(static)
+    for(long int idx = 0; idx < Ncells; idx++)
+    {
+        size_t pos = Offsets[idx];
+        for(auto it = Fields[idx].cbegin(); it != Fields[idx].cend(); ++it)
+        {
+            Entries[pos].index = it->index;
+            Entries[pos].value = it->value;
+            pos++;
+        }
+    }
+}
+
+}//namespace openphase
+#endif
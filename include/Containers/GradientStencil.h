@@ -43,79 +43,79 @@ enum class GradientStencils
 // Gradient stencils have no negative coefficients which should be multiplied
 // by (-1) manually at the point of use.
 
-const double GradientStencil1D[3][3][3] = {{{ 0.0, 0.0, 0.0},
-                                            { 0.0, 0.5, 0.0},
-                                            { 0.0, 0.0, 0.0}},
+constexpr double GradientStencil1D[3][3][3] = {{{ 0.0, 0.0, 0.0},
+                                                { 0.0, 0.5, 0.0},
+                                                { 0.0, 0.0, 0.0}},
 
-                                           {{ 0.0, 0.5, 0.0},
-                                            { 0.5, 0.0, 0.5},
-                                            { 0.0, 0.5, 0.0}},
+                                               {{ 0.0, 0.5, 0.0},
+                                                { 0.5, 0.0, 0.5},
+                                                { 0.0, 0.5, 0.0}},
 
-                                           {{ 0.0, 0.0, 0.0},
-                                            { 0.0, 0.5, 0.0},
-                                            { 0.0, 0.0, 0.0}}};                 ///< 2 point simple 1D/2D/3D Gradient stencil (standard finite differences)
+                                               {{ 0.0, 0.0, 0.0},
+                                                { 0.0, 0.5, 0.0},
+                                                { 0.0, 0.0, 0.0}}};             ///< 2 point simple 1D/2D/3D Gradient stencil (standard finite differences)
 
-const double GradientStencil2D[3][3][3] = {{{      0.0, 0.25/3.0,      0.0},
-                                            { 0.25/3.0,  1.0/3.0, 0.25/3.0},
-                                            {      0.0, 0.25/3.0,      0.0}},
+constexpr double GradientStencil2D[3][3][3] = {{{      0.0, 0.25/3.0,      0.0},
+                                                { 0.25/3.0,  1.0/3.0, 0.25/3.0},
+                                                {      0.0, 0.25/3.0,      0.0}},
 
-                                           {{ 0.25/3.0,  1.0/3.0, 0.25/3.0},
-                                            {  1.0/3.0,      0.0,  1.0/3.0},
-                                            { 0.25/3.0,  1.0/3.0, 0.25/3.0}},
+                                               {{ 0.25/3.0,  1.0/3.0, 0.25/3.0},
+                                                {  1.0/3.0,      0.0,  1.0/3.0},
+                                                { 0.25/3.0,  1.0/3.0, 0.25/3.0}},
 
-                                           {{      0.0, 0.25/3.0,      0.0},
-                                            { 0.25/3.0,  1.0/3.0, 0.25/3.0},
-                                            {      0.0, 0.25/3.0,      0.0}}};  ///< 8 point 2D Gradient stencil from "M.Alfaraj, Y. Wang and Y. Luo, Geophysical prospecting 62 (2014) 507-517"
+                                               {{      0.0, 0.25/3.0,      0.0},
+                                                { 0.25/3.0,  1.0/3.0, 0.25/3.0},
+                                                {      0.0, 0.25/3.0,      0.0}}};///< 8 point 2D Gradient stencil from "M.Alfaraj, Y. Wang and Y. Luo, Geophysical prospecting 62 (2014) 507-517"
 
-const double GradientStencil2D_2[3][3][3] = {{{   0.0, 0.125,   0.0},
-                                              { 0.125,  0.25, 0.125},
-                                              {   0.0, 0.125,   0.0}},
+constexpr double GradientStencil2D_2[3][3][3] = {{{   0.0, 0.125,   0.0},
+                                                  { 0.125,  0.25, 0.125},
+                                                  {   0.0, 0.125,   0.0}},
 
-                                             {{ 0.125,  0.25, 0.125},
-                                              {  0.25,   0.0,  0.25},
-                                              { 0.125,  0.25, 0.125}},
+                                                 {{ 0.125,  0.25, 0.125},
+                                                  {  0.25,   0.0,  0.25},
+                                                  { 0.125,  0.25, 0.125}},
 
-                                             {{   0.0, 0.125,   0.0},
-                                              { 0.125,  0.25, 0.125},
-                                              {   0.0, 0.125,   0.0}}};         ///< 8 point 2D Gradient stencil by Sobel
+                                                 {{   0.0, 0.125,   0.0},
+                                                  { 0.125,  0.25, 0.125},
+                                                  {   0.0, 0.125,   0.0}}};     ///< 8 point 2D Gradient stencil by Sobel
 
-const double GradientStencil3D[3][3][3] = {{{ 0.085/4.64, 0.245/4.64, 0.085/4.64},
-                                            { 0.245/4.64,   1.0/4.64, 0.245/4.64},
-                                            { 0.085/4.64, 0.245/4.64, 0.085/4.64}},
+constexpr double GradientStencil3D[3][3][3] = {{{ 0.085/4.64, 0.245/4.64, 0.085/4.64},
+                                                { 0.245/4.64,   1.0/4.64, 0.245/4.64},
+                                                { 0.085/4.64, 0.245/4.64, 0.085/4.64}},
 
-                                           {{ 0.245/4.64, 1.0/4.64, 0.245/4.64},
-                                            {   1.0/4.64,      0.0,   1.0/4.64},
-                                            { 0.245/4.64, 1.0/4.64, 0.245/4.64}},
+                                               {{ 0.245/4.64, 1.0/4.64, 0.245/4.64},
+                                                {   1.0/4.64,      0.0,   1.0/4.64},
+                                                { 0.245/4.64, 1.0/4.64, 0.245/4.64}},
 
-                                           {{ 0.085/4.64, 0.245/4.64, 0.085/4.64},
-                                            { 0.245/4.64,   1.0/4.64, 0.245/4.64},
-                                            { 0.085/4.64, 0.245/4.64, 0.085/4.64}}};///< 27 point 3D Gradient stencil from "M.Alfaraj, Y. Wang and Y. Luo, Geophysical prospecting 62 (2014) 507-517"
+                                               {{ 0.085/4.64, 0.245/4.64, 0.085/4.64},
+                                                { 0.245/4.64,   1.0/4.64, 0.245/4.64},
+                                                { 0.085/4.64, 0.245/4.64, 0.085/4.64}}};///< 27 point 3D Gradient stencil from "M.Alfaraj, Y. Wang and Y. Luo, Geophysical prospecting 62 (2014) 507-517"
 
 /// Gradient stencils based on lattice Boltzmann stencils
 
-const double GradientStencil2D_LB[3][3][3] = {{{     0.0, 1.0/12.0,      0.0},
-                                               {1.0/12.0, 1.0/3.0,  1.0/12.0},
-                                               {     0.0, 1.0/12.0,      0.0}},
+constexpr double GradientStencil2D_LB[3][3][3] = {{{     0.0, 1.0/12.0,      0.0},
+                                                   {1.0/12.0, 1.0/3.0,  1.0/12.0},
+                                                   {     0.0, 1.0/12.0,      0.0}},
 
-                                              {{1.0/12.0,   1.0/3.0, 1.0/12.0},
-                                               {1.0/3.0,        0.0, 1.0/3.0},
-                                               {1.0/12.0,   1.0/3.0, 1.0/12.0}},
+                                                  {{1.0/12.0,   1.0/3.0, 1.0/12.0},
+                                                   {1.0/3.0,        0.0, 1.0/3.0},
+                                                   {1.0/12.0,   1.0/3.0, 1.0/12.0}},
 
-                                               {{     0.0, 1.0/12.0,      0.0},
-                                                {1.0/12.0, 1.0/3.0,  1.0/12.0},
-                                                {     0.0, 1.0/12.0,      0.0}}};///< Isotropic gradient stencil based on D2Q9 lattice Boltzmann stencil. It is the same as the 8 point 2D Gradient stencil from "M.Alfaraj, Y. Wang and Y. Luo, Geophysical prospecting 62 (2014) 507-517"
+                                                   {{     0.0, 1.0/12.0,      0.0},
+                                                    {1.0/12.0, 1.0/3.0,  1.0/12.0},
+                                                    {     0.0, 1.0/12.0,      0.0}}};///< Isotropic gradient stencil based on D2Q9 lattice Boltzmann stencil. It is the same as the 8 point 2D Gradient stencil from "M.Alfaraj, Y. Wang and Y. Luo, Geophysical prospecting 62 (2014) 507-517"
 
-const double GradientStencil3D_LB[3][3][3] = {{{1.0/72.0, 1.0/18.0, 1.0/72.0},
-                                               {1.0/18.0, 2.0/9.0,  1.0/18.0},
-                                               {1.0/72.0, 1.0/18.0, 1.0/72.0}},
+constexpr double GradientStencil3D_LB[3][3][3] = {{{1.0/72.0, 1.0/18.0, 1.0/72.0},
+                                                   {1.0/18.0, 2.0/9.0,  1.0/18.0},
+                                                   {1.0/72.0, 1.0/18.0, 1.0/72.0}},
 
-                                              {{1.0/18.0, 2.0/9.0, 1.0/18.0},
-                                               {2.0/9.0,      0.0, 2.0/9.0},
-                                               {1.0/18.0, 2.0/9.0, 1.0/18.0}},
+                                                  {{1.0/18.0, 2.0/9.0, 1.0/18.0},
+                                                   {2.0/9.0,      0.0, 2.0/9.0},
+                                                   {1.0/18.0, 2.0/9.0, 1.0/18.0}},
 
-                                              {{1.0/72.0, 1.0/18.0, 1.0/72.0},
-                                               {1.0/18.0, 2.0/9.0,  1.0/18.0},
-                                               {1.0/72.0, 1.0/18.0, 1.0/72.0}}};///< Isotropic gradient stencil based on D3Q27 lattice Boltzmann stencil. It is very close to the 27 point 2D Gradient stencil from "M.Alfaraj, Y. Wang and Y. Luo, Geophysical prospecting 62 (2014) 507-517"
+                                                  {{1.0/72.0, 1.0/18.0, 1.0/72.0},
+                                                   {1.0/18.0, 2.0/9.0,  1.0/18.0},
+                                                   {1.0/72.0, 1.0/18.0, 1.0/72.0}}};///< Isotropic gradient stencil based on D3Q27 lattice Boltzmann stencil. It is very close to the 27 point 2D Gradient stencil from "M.Alfaraj, Y. Wang and Y. Luo, Geophysical prospecting 62 (2014) 507-517"
 
 class GradientStencil                                                           ///< Gradient stencil class (uses user specified stencil as the basis). Allows replacing the loop over array elements by the iterator which is beneficial for compact stencils
 {
@@ -0,0 +1,168 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+/*
+ * Piecewise linear interpolation table y(x) for tabulated property data, e.g.
+ * temperature dependent mobilities or conductivities read from a CSV file.
+ * If the abscissae are equidistant the interval is found in O(1) by scaling,
+ * otherwise by a binary search which first tries the interval of the previous
+ * lookup (passed in by the caller), since neighboring cells usually query
+ * nearby values. Queries outside of the tabulated range return the first or
+ * the last value.
+ */
+
+#ifndef INTERPOLATIONTABLE_H
+#define INTERPOLATIONTABLE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace openphase
+{
+
+class InterpolationTable                                                        ///< Piecewise linear table with uniform-grid and cached-bracket lookups
+{
+ public:
+    bool Set(const std::vector<double>& x, const std::vector<double>& y)        ///< Sets the table, returns false if x is not strictly increasing
+    {
+        assert(x.size() == y.size() && "Abscissae and values differ in size");
+
+        X = x;
+        Y = y;
+        Slope.assign(X.size(), 0.0);
+        Uniform = false;
+        for(size_t n = 1; n < X.size(); n++)
+        {
+            if(not (X[n] > X[n-1]))
+            {
+                clear();
+                return false;
+            }
+            Slope[n-1] = (Y[n] - Y[n-1])/(X[n] - X[n-1]);
+        }
+        if(X.size() > 1)
+        {
+            const double dx = (X.back() - X.front())/double(X.size() - 1);
+            Uniform = true;
+            for(size_t n = 1; n < X.size() - 1; n++)
+            if(std::fabs(X[n] - (X.front() + n*dx)) > 1.0e-10*(X.back() - X.front()))
+            {
+                Uniform = false;
+                break;
+            }
+            InvDx = 1.0/dx;
+        }
+        return true;
+    }
+    void clear(void)
+    {
+        X.clear();
+        Y.clear();
+        Slope.clear();
+        Uniform = false;
+    }
+    bool empty(void) const
+    {
+        return X.empty();
+    }
+    size_t size(void) const
+    {
+        return X.size();
+    }
+    bool IsUniform(void) const
+    {
+        return Uniform;
+    }
+    double operator()(const double x) const                                     ///< Interpolated value at x
+    {
+        size_t bracket = 0;
+        return operator()(x, bracket);
+    }
+    double operator()(const double x, size_t& bracket) const                    ///< Interpolated value at x, bracket is the interval of the previous lookup on input and of this one on output
+    {
+        assert(not empty() && "Interpolation table is empty");
+
+        if(not (x > X.front())) return Y.front();
+        if(not (x < X.back()))  return Y.back();
+
+        bracket = Interval(x, bracket);
+        return Y[bracket] + Slope[bracket]*(x - X[bracket]);
+    }
+    void Evaluate(const double* x, double* y, const size_t N) const             ///< Interpolated values y[n] at x[n] for n < N
+    {
+        assert(not empty() && "Interpolation table is empty");
+
+        if(Uniform)
+        {
+            const double* locX = X.data();
+            const double* locY = Y.data();
+            const double* locSlope = Slope.data();
+            const double x0 = X.front();
+            const double x1 = X.back();
+            const long int last = X.size() - 2;
+            #pragma omp simd
+            for(size_t n = 0; n < N; n++)
+            {
+                const double locx = std::min(std::max(x[n], x0), x1);
+                const long int i = std::min(std::max(long((locx - x0)*InvDx), 0l), last);
+                y[n] = locY[i] + locSlope[i]*(locx - locX[i]);
+            }
+        }
+        else
+        {
+            size_t bracket = 0;
+            for(size_t n = 0; n < N; n++)
+            {
+                y[n] = operator()(x[n], bracket);
+            }
+        }
+    }
+
+ private:
+    std::vector<double> X;                                                      ///< Abscissae, strictly increasing
+    std::vector<double> Y;                                                      ///< Tabulated values
+    std::vector<double> Slope;                                                  ///< Slopes of the intervals
+    double InvDx = 0.0;                                                         ///< Inverse spacing of uniform abscissae
+    bool Uniform = false;                                                       ///< Abscissae are equidistant
+
+    size_t Interval(const double x, const size_t bracket) const                 ///< Interval n with X[n] <= x < X[n+1], for X.front() < x < X.back()
+    {
+        if(Uniform)
+        {
+            return std::min(size_t((x - X.front())*InvDx), X.size() - 2);
+        }
+        if(bracket < X.size() - 1 and X[bracket] <= x)
+        {
+            if(x < X[bracket+1]) return bracket;
+            if(bracket + 2 < X.size() and x < X[bracket+2]) return bracket + 1;
+        }
+        return std::upper_bound(X.begin(), X.end(), x) - X.begin() - 1;
+    }
+};
+
+}// namespace openphase
+#endif
@@ -45,115 +45,115 @@ enum class LaplacianStencils
 // but should only be used with inactive dimensions suppressed.
 
 /// Standard Laplacian stencils
-const double LaplacianStencil1D_3[3][3][3] = {{{0.0,   0.0,   0.0},
-                                               {0.0,   1.0,   0.0},
-                                               {0.0,   0.0,   0.0}},
+constexpr double LaplacianStencil1D_3[3][3][3] = {{{0.0,   0.0,   0.0},
+                                                   {0.0,   1.0,   0.0},
+                                                   {0.0,   0.0,   0.0}},
 
-                                              {{0.0,   1.0,   0.0},
-                                               {1.0,  -2.0,   1.0},
-                                               {0.0,   1.0,   0.0}},
+                                                  {{0.0,   1.0,   0.0},
+                                                   {1.0,  -2.0,   1.0},
+                                                   {0.0,   1.0,   0.0}},
 
-                                              {{0.0,   0.0,   0.0},
-                                               {0.0,   1.0,   0.0},
-                                               {0.0,   0.0,   0.0}}};           ///< 3 point 1D Laplacian stencil
+                                                  {{0.0,   0.0,   0.0},
+                                                   {0.0,   1.0,   0.0},
+                                                   {0.0,   0.0,   0.0}}};       ///< 3 point 1D Laplacian stencil
 
-const double LaplacianStencil2D_5[3][3][3] = {{{0.0,   0.0,   0.0},
-                                               {0.0,   1.0,   0.0},
-                                               {0.0,   0.0,   0.0}},
+constexpr double LaplacianStencil2D_5[3][3][3] = {{{0.0,   0.0,   0.0},
+                                                   {0.0,   1.0,   0.0},
+                                                   {0.0,   0.0,   0.0}},
 
-                                              {{0.0,   1.0,   0.0},
-                                               {1.0,  -4.0,   1.0},
-                                               {0.0,   1.0,   0.0}},
+                                                  {{0.0,   1.0,   0.0},
+                                                   {1.0,  -4.0,   1.0},
+                                                   {0.0,   1.0,   0.0}},
 
-                                              {{0.0,   0.0,   0.0},
-                                               {0.0,   1.0,   0.0},
-                                               {0.0,   0.0,   0.0}}};           ///< 5 point simple 2D Laplacian stencil
+                                                  {{0.0,   0.0,   0.0},
+                                                   {0.0,   1.0,   0.0},
+                                                   {0.0,   0.0,   0.0}}};       ///< 5 point simple 2D Laplacian stencil
 
-const double LaplacianStencil3D_7[3][3][3] = {{{0.0,   0.0,  0.0},
-                                               {0.0,   1.0,  0.0},
-                                               {0.0,   0.0,  0.0}},
+constexpr double LaplacianStencil3D_7[3][3][3] = {{{0.0,   0.0,  0.0},
+                                                   {0.0,   1.0,  0.0},
+                                                   {0.0,   0.0,  0.0}},
 
-                                              {{0.0,   1.0,  0.0},
-                                               {1.0,  -6.0,  1.0},
-                                               {0.0,   1.0,  0.0}},
+                                                  {{0.0,   1.0,  0.0},
+                                                   {1.0,  -6.0,  1.0},
+                                                   {0.0,   1.0,  0.0}},
 
-                                              {{0.0,   0.0,  0.0},
-                                               {0.0,   1.0,  0.0},
-                                               {0.0,   0.0,  0.0}}};            ///< 7 point simple 3D Laplacian stencil
+                                                  {{0.0,   0.0,  0.0},
+                                                   {0.0,   1.0,  0.0},
+                                                   {0.0,   0.0,  0.0}}};        ///< 7 point simple 3D Laplacian stencil
 
 ///Isotropic Laplacian stencils
-const double LaplacianStencil2D_9[3][3][3] = {{{    0.0,   1.0/6.0,     0.0},
-                                               {1.0/6.0,   2.0/3.0, 1.0/6.0},
-                                               {    0.0,   1.0/6.0,     0.0}},
+constexpr double LaplacianStencil2D_9[3][3][3] = {{{    0.0,   1.0/6.0,     0.0},
+                                                   {1.0/6.0,   2.0/3.0, 1.0/6.0},
+                                                   {    0.0,   1.0/6.0,     0.0}},
 
-                                              {{1.0/6.0,   2.0/3.0, 1.0/6.0},
-                                               {2.0/3.0, -10.0/3.0, 2.0/3.0},
-                                               {1.0/6.0,   2.0/3.0, 1.0/6.0}},
+                                                  {{1.0/6.0,   2.0/3.0, 1.0/6.0},
+                                                   {2.0/3.0, -10.0/3.0, 2.0/3.0},
+                                                   {1.0/6.0,   2.0/3.0, 1.0/6.0}},
 
-                                              {{    0.0,   1.0/6.0,     0.0},
-                                               {1.0/6.0,   2.0/3.0, 1.0/6.0},
-                                               {    0.0,   1.0/6.0,     0.0}}}; ///< 9 point 2D Laplacian stencil by Dave Hale
+                                                  {{    0.0,   1.0/6.0,     0.0},
+                                                   {1.0/6.0,   2.0/3.0, 1.0/6.0},
+                                                   {    0.0,   1.0/6.0,     0.0}}};///< 9 point 2D Laplacian stencil by Dave Hale
 
-const double LaplacianStencil3D_19[3][3][3] = {{{     0.0,   1.0/6.0,      0.0},
-                                                { 1.0/6.0,   1.0/3.0,  1.0/6.0},
-                                                {     0.0,   1.0/6.0,      0.0}},
+constexpr double LaplacianStencil3D_19[3][3][3] = {{{     0.0,   1.0/6.0,      0.0},
+                                                    { 1.0/6.0,   1.0/3.0,  1.0/6.0},
+                                                    {     0.0,   1.0/6.0,      0.0}},
 
-                                               {{ 1.0/6.0,   1.0/3.0,  1.0/6.0},
-                                                { 1.0/3.0,      -4.0,  1.0/3.0},
-                                                { 1.0/6.0,   1.0/3.0,  1.0/6.0}},
+                                                   {{ 1.0/6.0,   1.0/3.0,  1.0/6.0},
+                                                    { 1.0/3.0,      -4.0,  1.0/3.0},
+                                                    { 1.0/6.0,   1.0/3.0,  1.0/6.0}},
 
-                                               {{     0.0,   1.0/6.0,      0.0},
-                                                { 1.0/6.0,   1.0/3.0,  1.0/6.0},
-                                                {     0.0,   1.0/6.0,      0.0}}};///< 19 point 3D Laplacian stencil from Patra and Karttunnen paper
+                                                   {{     0.0,   1.0/6.0,      0.0},
+                                                    { 1.0/6.0,   1.0/3.0,  1.0/6.0},
+                                                    {     0.0,   1.0/6.0,      0.0}}};///< 19 point 3D Laplacian stencil from Patra and Karttunnen paper
 
-const double LaplacianStencil3D_27a[3][3][3] = {{{1.0/30.0,   1.0/10.0, 1.0/30.0},
-                                                 {1.0/10.0,   7.0/15.0, 1.0/10.0},
-                                                 {1.0/30.0,   1.0/10.0, 1.0/30.0}},
+constexpr double LaplacianStencil3D_27a[3][3][3] = {{{1.0/30.0,   1.0/10.0, 1.0/30.0},
+                                                     {1.0/10.0,   7.0/15.0, 1.0/10.0},
+                                                     {1.0/30.0,   1.0/10.0, 1.0/30.0}},
 
-                                                {{1.0/10.0,   7.0/15.0, 1.0/10.0},
-                                                 {7.0/15.0, -64.0/15.0, 7.0/15.0},
-                                                 {1.0/10.0,   7.0/15.0, 1.0/10.0}},
+                                                    {{1.0/10.0,   7.0/15.0, 1.0/10.0},
+                                                     {7.0/15.0, -64.0/15.0, 7.0/15.0},
+                                                     {1.0/10.0,   7.0/15.0, 1.0/10.0}},
 
-                                                {{1.0/30.0,   1.0/10.0, 1.0/30.0},
-                                                 {1.0/10.0,   7.0/15.0, 1.0/10.0},
-                                                 {1.0/30.0,   1.0/10.0, 1.0/30.0}}};///< 27 point 3D Laplacian stencil by Spotz and Carey (1995)
+                                                    {{1.0/30.0,   1.0/10.0, 1.0/30.0},
+                                                     {1.0/10.0,   7.0/15.0, 1.0/10.0},
+                                                     {1.0/30.0,   1.0/10.0, 1.0/30.0}}};///< 27 point 3D Laplacian stencil by Spotz and Carey (1995)
 
-const double LaplacianStencil3D_27b[3][3][3] = {{{1.0/48.0,   1.0/8.0, 1.0/48.0},
-                                                 {1.0/8.0,   5.0/12.0, 1.0/8.0},
-                                                 {1.0/48.0,   1.0/8.0, 1.0/48.0}},
+constexpr double LaplacianStencil3D_27b[3][3][3] = {{{1.0/48.0,   1.0/8.0, 1.0/48.0},
+                                                     {1.0/8.0,   5.0/12.0, 1.0/8.0},
+                                                     {1.0/48.0,   1.0/8.0, 1.0/48.0}},
 
-                                                {{1.0/8.0,   5.0/12.0, 1.0/8.0},
-                                                 {5.0/12.0, -25.0/6.0, 5.0/12.0},
-                                                 {1.0/8.0,   5.0/12.0, 1.0/8.0}},
+                                                    {{1.0/8.0,   5.0/12.0, 1.0/8.0},
+                                                     {5.0/12.0, -25.0/6.0, 5.0/12.0},
+                                                     {1.0/8.0,   5.0/12.0, 1.0/8.0}},
 
-                                                {{1.0/48.0,   1.0/8.0, 1.0/48.0},
-                                                 { 1.0/8.0,  5.0/12.0, 1.0/8.0},
-                                                 {1.0/48.0,   1.0/8.0, 1.0/48.0}}};///< 27 point 3D Laplacian stencil by Dave Hale
+                                                    {{1.0/48.0,   1.0/8.0, 1.0/48.0},
+                                                     { 1.0/8.0,  5.0/12.0, 1.0/8.0},
+                                                     {1.0/48.0,   1.0/8.0, 1.0/48.0}}};///< 27 point 3D Laplacian stencil by Dave Hale
 
 ///Laplacian stencils based on lattice Boltzmann stencils
-const double LaplacianStencil2D_LB[3][3][3] = {{{    0.0, 1.0/6.0,      0.0},
-                                                {1.0/6.0, 2.0/3.0,  1.0/6.0},
-                                                {    0.0, 1.0/6.0,      0.0}},
+constexpr double LaplacianStencil2D_LB[3][3][3] = {{{    0.0, 1.0/6.0,      0.0},
+                                                    {1.0/6.0, 2.0/3.0,  1.0/6.0},
+                                                    {    0.0, 1.0/6.0,      0.0}},
 
-                                               {{1.0/6.0,   2.0/3.0, 1.0/6.0},
-                                                {2.0/3.0, -10.0/3.0, 2.0/3.0},
-                                                {1.0/6.0,   2.0/3.0, 1.0/6.0}},
+                                                   {{1.0/6.0,   2.0/3.0, 1.0/6.0},
+                                                    {2.0/3.0, -10.0/3.0, 2.0/3.0},
+                                                    {1.0/6.0,   2.0/3.0, 1.0/6.0}},
 
-                                               {{    0.0, 1.0/6.0,     0.0},
-                                                {1.0/6.0, 2.0/3.0, 1.0/6.0},
-                                                {    0.0, 1.0/6.0,     0.0}}};  ///< Laplacian stencil based on D2Q9 lattice Boltzmann stencil. It is the same as 2D stencil by Dave Hale
+                                                   {{    0.0, 1.0/6.0,     0.0},
+                                                    {1.0/6.0, 2.0/3.0, 1.0/6.0},
+                                                    {    0.0, 1.0/6.0,     0.0}}};///< Laplacian stencil based on D2Q9 lattice Boltzmann stencil. It is the same as 2D stencil by Dave Hale
 
-const double LaplacianStencil3D_LB[3][3][3] = {{{1.0/36.0, 1.0/9.0, 1.0/36.0},
-                                                {1.0/9.0,  4.0/9.0, 1.0/9.0 },
-                                                {1.0/36.0, 1.0/9.0, 1.0/36.0}},
+constexpr double LaplacianStencil3D_LB[3][3][3] = {{{1.0/36.0, 1.0/9.0, 1.0/36.0},
+                                                    {1.0/9.0,  4.0/9.0, 1.0/9.0 },
+                                                    {1.0/36.0, 1.0/9.0, 1.0/36.0}},
 
-                                               {{1.0/9.0,   4.0/9.0, 1.0/9.0},
-                                                {4.0/9.0, -38.0/9.0, 4.0/9.0},
-                                                {1.0/9.0,   4.0/9.0, 1.0/9.0}},
+                                                   {{1.0/9.0,   4.0/9.0, 1.0/9.0},
+                                                    {4.0/9.0, -38.0/9.0, 4.0/9.0},
+                                                    {1.0/9.0,   4.0/9.0, 1.0/9.0}},
 
-                                               {{1.0/36.0, 1.0/9.0, 1.0/36.0},
-                                                {1.0/9.0,  4.0/9.0, 1.0/9.0 },
-                                                {1.0/36.0, 1.0/9.0, 1.0/36.0}}};///< Laplacian stencil based on D3Q27 lattice Boltzmann stencil
+                                                   {{1.0/36.0, 1.0/9.0, 1.0/36.0},
+                                                    {1.0/9.0,  4.0/9.0, 1.0/9.0 },
+                                                    {1.0/36.0, 1.0/9.0, 1.0/36.0}}};///< Laplacian stencil based on D3Q27 lattice Boltzmann stencil
 
 class LaplacianStencil                                                          ///< Diffusion stencil class (uses user specified Laplacian stencil as the basis). Allows replacing the loop over Laplacian elements by the iterator which is beneficial for compact stencils
 {
@@ -254,10 +254,18 @@ extern inline std::vector<dVector3> Col(const dMatrix3x3& Mat)
 extern inline vStrain operator*(const dMatrix6x6& locCompliance, const vStress& locStress)
 {
     vStrain locStrain;
+    const double* M = locCompliance.data();
+    const double* v = locStress.data();
+    double* out = locStrain.data();
     for(int i = 0; i < 6; i++)
-    for(int j = 0; j < 6; j++)
     {
-        locStrain[i] += locCompliance(i,j)*locStress[j];
+        double sum = 0.0;
+        #pragma omp simd reduction(+:sum)
+        for(int j = 0; j < 6; j++)
+        {
+            sum += M[6*i+j]*v[j];
+        }
+        out[i] = sum;
     }
     return locStrain;
 }
@@ -265,10 +273,18 @@ extern inline vStrain operator*(const dMatrix6x6& locCompliance, const vStress&
 extern inline vStress operator*(const dMatrix6x6& locStiffness, const vStrain& locStrain)
 {
     vStress locStress;
+    const double* M = locStiffness.data();
+    const double* v = locStrain.data();
+    double* out = locStress.data();
     for(int i = 0; i < 6; i++)
-    for(int j = 0; j < 6; j++)
     {
-        locStress[i] += locStiffness(i,j)*locStrain[j];
+        double sum = 0.0;
+        #pragma omp simd reduction(+:sum)
+        for(int j = 0; j < 6; j++)
+        {
+            sum += M[6*i+j]*v[j];
+        }
+        out[i] = sum;
     }
     return locStress;
 }
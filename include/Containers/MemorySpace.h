@@ -0,0 +1,228 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef MEMORYSPACE_H
+#define MEMORYSPACE_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <omp.h>
+
+#include "AlignedAllocator.h"
+
+namespace openphase
+{
+
+template<class T>
+class PinnedAllocator                                                           ///< STL allocator returning page-locked host memory (OpenMP pinned allocator), aligned host memory if pinning is not available
+{
+ public:
+    typedef T value_type;
+
+    template<class U>
+    struct rebind
+    {
+        typedef PinnedAllocator<U> other;
+    };
+
+    PinnedAllocator() noexcept {};
+    template<class U> PinnedAllocator(const PinnedAllocator<U>&) noexcept {};
+
+    T* allocate(const size_t n)
+    {
+        void* ptr = omp_alloc(n*sizeof(T), Handle());
+        if(ptr == nullptr)
+        {
+            /* omp_atv_default_mem_fb: the pinned allocator falls back to
+            the default one, a null pointer means out of memory */
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+    void deallocate(T* ptr, const size_t) noexcept
+    {
+        omp_free(ptr, Handle());
+    }
+
+    template<class U> bool operator==(const PinnedAllocator<U>&) const noexcept {return true;};
+    template<class U> bool operator!=(const PinnedAllocator<U>&) const noexcept {return false;};
+
+ private:
+    static omp_allocator_handle_t Handle(void)                                  ///< Pinned allocator shared by all instances, created on first use
+    {
+        static const omp_allocator_handle_t Pinned = []()
+        {
+            const omp_alloctrait_t Traits[3] = {{omp_atk_pinned, omp_atv_true},
+                                                {omp_atk_alignment, OP_SIMD_ALIGNMENT},
+                                                {omp_atk_fallback, omp_atv_default_mem_fb}};
+            return omp_init_allocator(omp_default_mem_space, 3, Traits);
+        }();
+        return Pinned;
+    }
+};
+
+/* Memory spaces of the storage data, selected by the last template parameter
+of Storage3D. All spaces keep the data addressable from the host so that the
+existing host code (boundary conditions, MPI packing, output) works on any
+storage. "Mirrored" spaces additionally keep a device copy in the OpenMP
+target data environment, moved explicitly with sync_to_device() and
+sync_to_host(). */
+
+struct HostSpace                                                                ///< Host memory (default)
+{
+    template<class T> using Vector = StorageVector<T>;
+    static constexpr bool Mirrored = false;
+};
+
+struct PinnedHostSpace                                                          ///< Page-locked host memory for faster host-device and MPI transfers
+{
+    template<class T> using Vector = std::vector<T, PinnedAllocator<T>>;
+    static constexpr bool Mirrored = false;
+};
+
+struct DeviceSpace                                                              ///< Device memory with a host mirror, synchronized explicitly
+{
+    template<class T> using Vector = StorageVector<T>;
+    static constexpr bool Mirrored = true;
+};
+
+struct ManagedSpace                                                             ///< Unified (managed) memory addressed by host and device directly, requires "#pragma omp requires unified_shared_memory" in the application
+{
+    template<class T> using Vector = StorageVector<T>;
+    static constexpr bool Mirrored = false;
+};
+
+enum class MemoryStates                                                         ///< Which copy of the storage data is up to date
+{
+    Synchronized,                                                               ///< Host and device copies are identical
+    HostModified,                                                               ///< Host copy is newer, sync_to_device() is needed before device access
+    DeviceModified                                                              ///< Device copy is newer, sync_to_host() is needed before host access
+};
+
+template<class T, class Space>
+class MemoryMirror                                                              ///< Device copy of a storage data buffer and its dirty state
+{
+    /* The device copy is associated with the address and size of the host
+    buffer. A reallocated buffer (Allocate(), Remesh(), etc.) is detected on
+    the next sync_to_device() and mapped anew, so the storages do not need to
+    notify the mirror about every reallocation. Host writes through the
+    element accessors are not tracked, mark_host_modified() has to be called
+    after them (and mark_device_modified() after device kernels). */
+ public:
+    MemoryMirror() = default;
+    MemoryMirror(const MemoryMirror&)                                           ///< Copies do not share the device copy
+    {
+    }
+    MemoryMirror& operator=(const MemoryMirror&)
+    {
+        Release();
+        return *this;
+    }
+    ~MemoryMirror()
+    {
+        Release();
+    }
+
+    void ToDevice(T* Data, const size_t Size)                                   ///< Maps or updates the device copy if the host copy is newer
+    {
+        if constexpr (Space::Mirrored)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "DeviceSpace requires trivially copyable value types");
+            if(Data != Mapped or Size != MappedSize)
+            {
+                Release();
+                if(Size == 0) return;
+                #pragma omp target enter data map(to: Data[0:Size])
+                Mapped = Data;
+                MappedSize = Size;
+            }
+            else if(State == MemoryStates::HostModified)
+            {
+                #pragma omp target update to(Data[0:Size])
+            }
+            else if(State == MemoryStates::DeviceModified)
+            {
+                return;
+            }
+        }
+        State = MemoryStates::Synchronized;
+    }
+    void ToHost(T* Data, const size_t Size)                                     ///< Updates the host copy if the device copy is newer
+    {
+        if constexpr (Space::Mirrored)
+        {
+            if(State == MemoryStates::DeviceModified and Data == Mapped and Size == MappedSize)
+            {
+                #pragma omp target update from(Data[0:Size])
+            }
+            else if(State == MemoryStates::HostModified)
+            {
+                return;
+            }
+        }
+        State = MemoryStates::Synchronized;
+    }
+    void MarkHostModified(void)
+    {
+        State = MemoryStates::HostModified;
+    }
+    void MarkDeviceModified(void)
+    {
+        State = MemoryStates::DeviceModified;
+    }
+    MemoryStates GetState(void) const
+    {
+        return State;
+    }
+    void Release(void)                                                          ///< Removes the device copy, the host copy is not updated
+    {
+        if constexpr (Space::Mirrored)
+        {
+            if(Mapped != nullptr)
+            {
+                /* Only the address is used to find the mapping, the host
+                buffer may already be freed */
+                T* Data = Mapped;
+                const size_t Size = MappedSize;
+                #pragma omp target exit data map(delete: Data[0:Size])
+                Mapped = nullptr;
+                MappedSize = 0;
+            }
+        }
+        State = MemoryStates::HostModified;
+    }
+
+ private:
+    T* Mapped = nullptr;                                                        ///< Host address of the mapped buffer
+    size_t MappedSize = 0;                                                      ///< Number of mapped elements
+    MemoryStates State = MemoryStates::HostModified;                            ///< Dirty state of the copies
+};
+
+}// namespace openphase
+#endif
@@ -29,6 +29,7 @@
 #define NODEA_H
 
 #include <vector>
+#include "NodeAllocator.h"
 #include <iostream>
 #include <cmath>
 
@@ -97,13 +98,18 @@ class NodeA
     void    add_values         (const NodeA<T>& value);                         ///< Adds values of two nodes.
     void    add_existing_values(const NodeA<T>& value);                         ///< Adds only values existing in two nodes simultaneously.
 
-    typedef typename std::vector<SingleIndexFieldEntry<T>>::iterator iterator;  ///< Iterator over storage vector.
-    typedef typename std::vector<SingleIndexFieldEntry<T>>::const_iterator citerator; ///< Constant iterator over storage vector.
+    NodeA<T> Xreflected(void) const;                                            ///< Node with all vector values reflected at the x plane
+    NodeA<T> Yreflected(void) const;                                            ///< Node with all vector values reflected at the y plane
+    NodeA<T> Zreflected(void) const;                                            ///< Node with all vector values reflected at the z plane
+
+    typedef typename NodeVector<SingleIndexFieldEntry<T>>::iterator iterator;   ///< Iterator over storage vector.
+    typedef typename NodeVector<SingleIndexFieldEntry<T>>::const_iterator citerator;  ///< Constant iterator over storage vector.
     iterator  begin() {return Fields.begin();};                                 ///< Iterator to the begin of storage vector.
     iterator  end()   {return Fields.end();};                                   ///< Iterator to the end of storage vector.
     citerator cbegin() const {return Fields.cbegin();};                         ///< Constant iterator to the begin of storage vector.
     citerator cend()   const {return Fields.cend();};                           ///< Constant iterator to the end of storage vector.
     size_t    size() const {return Fields.size();};                             ///< Returns the size of storage.
+    size_t    allocated_memory() const {return Fields.capacity()*sizeof(SingleIndexFieldEntry<T>);};///< Returns the dynamically allocated memory in bytes.
     size_t    capacity() const {return Fields.capacity();};                     ///< Returns the size of storage.
     iterator  erase(iterator it) {return Fields.erase(it);};                    ///< Erase a single record pointed by iterator it.
     SingleIndexFieldEntry<T>& front(void) {return Fields.front();};             ///< Reference to the first FieldEntry.
@@ -116,7 +122,7 @@ class NodeA
 
  protected:
  private:
-    std::vector<SingleIndexFieldEntry<T>> Fields;                               ///< Storage vector.
+    NodeVector<SingleIndexFieldEntry<T>> Fields;                                ///< Storage vector.
 };
 
 /******************************* Implementation ******************************/
@@ -264,6 +270,39 @@ inline void NodeA<T>::add_existing_values(const NodeA<T>& n)
     }
 }
 
+template<class T>
+inline NodeA<T> NodeA<T>::Xreflected(void) const
+{
+    NodeA result = *this;
+    for(auto i = result.begin(); i < result.end(); ++i)
+    {
+        i->value = i->value.Xreflected();
+    }
+    return result;
+}
+
+template<class T>
+inline NodeA<T> NodeA<T>::Yreflected(void) const
+{
+    NodeA result = *this;
+    for(auto i = result.begin(); i < result.end(); ++i)
+    {
+        i->value = i->value.Yreflected();
+    }
+    return result;
+}
+
+template<class T>
+inline NodeA<T> NodeA<T>::Zreflected(void) const
+{
+    NodeA result = *this;
+    for(auto i = result.begin(); i < result.end(); ++i)
+    {
+        i->value = i->value.Zreflected();
+    }
+    return result;
+}
+
 template<>
 inline void NodeA<double>::pack(std::vector<double>& buffer)
 {
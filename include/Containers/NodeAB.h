@@ -29,6 +29,7 @@
 #define NODEAB_H
 
 #include <vector>
+#include "NodeAllocator.h"
 #include <iostream>
 
 namespace openphase
@@ -155,8 +156,9 @@ class NodeAB
 
     void      clear() {Fields.clear();};                                        ///< Empties the field storage. Sets flag to 0.
     size_t    size() const {return Fields.size();};                             ///< Returns the size of storage.
-    typedef typename std::vector<DoubleIndexFieldEntry<T1,T2>>::iterator iterator;  ///< Iterator over storage vector
-    typedef typename std::vector<DoubleIndexFieldEntry<T1,T2>>::const_iterator citerator; ///< Constant iterator over storage vector
+    size_t    allocated_memory() const {return Fields.capacity()*sizeof(DoubleIndexFieldEntry<T1,T2>);};///< Returns the dynamically allocated memory in bytes.
+    typedef typename NodeVector<DoubleIndexFieldEntry<T1,T2>>::iterator iterator;   ///< Iterator over storage vector
+    typedef typename NodeVector<DoubleIndexFieldEntry<T1,T2>>::const_iterator citerator;  ///< Constant iterator over storage vector
     iterator  begin() {return Fields.begin();};                                 ///< Iterator to the begin of storage vector
     iterator  end()   {return Fields.end();};                                   ///< Iterator to the end of storage vector
     citerator cbegin() const {return Fields.cbegin();};                         ///< Constant iterator to the begin of storage vector
@@ -173,7 +175,7 @@ class NodeAB
 
  protected:
  private:
-    std::vector<DoubleIndexFieldEntry<T1,T2>> Fields;                           ///< Fields storage vector.
+    NodeVector<DoubleIndexFieldEntry<T1,T2>> Fields;                            ///< Fields storage vector.
 };
 
 /********************************* Implementation *****************************/
@@ -0,0 +1,106 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+/*
+ * Pooled allocator for the node containers (NodeA, NodeAB, NodeDF, NodeIP,
+ * NodePF). It is enabled by compiling with -DNODE_POOL (SETTINGS="node-pool"
+ * in the Makefile build or -DENABLE_NODE_POOL=ON in the CMake build).
+ * Each thread keeps its own free lists of fixed size blocks which are carved
+ * from large slabs, so the small vectors in the nodes are recycled without
+ * going through the global heap. Without NODE_POOL the node containers use
+ * std::vector with the standard allocator. NodeDF and NodeIP store their
+ * entries in a SmallVector (SmallVector.h), only entries exceeding its inline
+ * capacity are allocated through the pool.
+ */
+
+#ifndef NODEALLOCATOR_H
+#define NODEALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "Globals.h"
+
+namespace openphase
+{
+
+struct NodePoolStatistics                                                       ///< Allocation counters of the node memory pool (summed over all threads)
+{
+    size_t PoolAllocations   = 0;                                               ///< Number of allocations served from the free lists
+    size_t PoolDeallocations = 0;                                               ///< Number of blocks returned to the free lists
+    size_t HeapAllocations   = 0;                                               ///< Number of heap allocations (slabs and blocks too large for the pool)
+    size_t ReservedBytes     = 0;                                               ///< Memory reserved by the pool slabs in bytes
+};
+
+class OP_EXPORTS NodeMemoryPool                                                 ///< Per-thread slab/free list memory pool for the node containers
+{
+ public:
+    static constexpr size_t BlockGranularity = 16;                              ///< Block sizes are multiples of this value (also the block alignment)
+    static constexpr size_t MaxBlockSize     = 2048;                            ///< Larger requests are forwarded to the global heap
+    static constexpr size_t SlabSize         = 64*1024;                         ///< Size of a single slab carved into blocks
+    static constexpr size_t NumberOfClasses  = MaxBlockSize/BlockGranularity;   ///< Number of block size classes
+
+    static void* Allocate(const size_t bytes);                                  ///< Returns a block of at least "bytes" size
+    static void  Deallocate(void* ptr, const size_t bytes);                     ///< Returns a block to the calling thread's free list
+
+    static bool Enabled();                                                      ///< True if the library is compiled with NODE_POOL
+    static NodePoolStatistics GetStatistics();                                  ///< Returns accumulated counters of all threads
+    static void PrintStatistics(const int tStep);                               ///< Prints the allocation counts since the previous call
+};
+
+#ifdef NODE_POOL
+template<class T>
+class NodeAllocator                                                             ///< Stateless STL allocator forwarding to the NodeMemoryPool
+{
+ public:
+    typedef T value_type;
+
+    NodeAllocator() noexcept {};
+    template<class U> NodeAllocator(const NodeAllocator<U>&) noexcept {};
+
+    T* allocate(const size_t n)
+    {
+        return static_cast<T*>(NodeMemoryPool::Allocate(n*sizeof(T)));
+    }
+    void deallocate(T* ptr, const size_t n) noexcept
+    {
+        NodeMemoryPool::Deallocate(ptr, n*sizeof(T));
+    }
+
+    template<class U> bool operator==(const NodeAllocator<U>&) const noexcept {return true;};
+    template<class U> bool operator!=(const NodeAllocator<U>&) const noexcept {return false;};
+};
+
+template<class T>
+using NodeVector = std::vector<T, NodeAllocator<T>>;                            ///< Storage vector type of the node containers
+#else
+template<class T>
+using NodeVector = std::vector<T>;                                              ///< Storage vector type of the node containers
+#endif
+
+}// namespace openphase
+#endif
@@ -28,7 +28,10 @@
 #ifndef NODEDF_H
 #define NODEDF_H
 
+#include <algorithm>
 #include <vector>
+#include "SmallVector.h"
+#include "PhaseFieldPrecision.h"
 #include <iostream>
 
 namespace openphase
@@ -39,10 +42,10 @@ struct DrivingForceEntry
 {
     size_t indexA;                                                              ///< First index.
     size_t indexB;                                                              ///< Second index.
-    double raw;                                                                 ///< Raw driving force value.
-    double tmp;                                                                 ///< Intermediary driving force value.
-    double average;                                                             ///< Average driving force value.
-    double weight;                                                              ///< Driving force weight.
+    pf_real_t raw;                                                              ///< Raw driving force value.
+    pf_real_t tmp;                                                              ///< Intermediary driving force value.
+    pf_real_t average;                                                          ///< Average driving force value.
+    pf_real_t weight;                                                           ///< Driving force weight.
 
     DrivingForceEntry() :                                                       ///< Default constructor.
         indexA(0),
@@ -54,36 +57,17 @@ struct DrivingForceEntry
     {
 
     }
-    DrivingForceEntry(const DrivingForceEntry& entry) :                         ///< Copy constructor.
-        indexA(entry.indexA),
-        indexB(entry.indexB),
-        raw(entry.raw),
-        tmp(entry.tmp),
-        average(entry.average),
-        weight(entry.weight)
-    {
-
-    }
-    DrivingForceEntry& operator=(const DrivingForceEntry& entry)                ///< Assignment operator.
-    {
-        indexA  = entry.indexA;
-        indexB  = entry.indexB;
-        raw     = entry.raw;
-        tmp     = entry.tmp;
-        average = entry.average;
-        weight  = entry.weight;
-        return *this;
-    }
+    DrivingForceEntry(const DrivingForceEntry& entry) = default;                ///< Copy constructor.
+    DrivingForceEntry& operator=(const DrivingForceEntry& entry) = default;     ///< Assignment operator.
 };
 
 /**********************************************************/
 class NodeDF                                                                    ///< Stores driving forces at a grid point. Provides access and manipulation methods for the stored entries.
 {
  public:
-    NodeDF() :                                                                  ///< Constructor used to allocate space for at least 3 fields.
-        Fields(0)
+    NodeDF()                                                                    ///< Constructor, up to OP_NODE_INLINE_CAPACITY entries are stored without heap allocation.
     {
-        Fields.reserve(3);
+
     }
     NodeDF(const NodeDF& n) :                                                   ///< Copy constructor.
         Fields(n.Fields)
@@ -124,8 +108,10 @@ class NodeDF
 
     void    clear() {Fields.clear();};                                          ///< Empties the field storage.
     size_t  size() const {return Fields.size();};                               ///< Returns the size of storage.
-    typedef std::vector<DrivingForceEntry>::iterator iterator;                  ///< Iterator over storage vector
-    typedef std::vector<DrivingForceEntry>::const_iterator citerator;           ///< Constant iterator over storage vector
+    size_t  allocated_memory() const {return Fields.on_heap() ? Fields.capacity()*sizeof(DrivingForceEntry) : 0;};///< Returns the dynamically allocated memory in bytes (inline entries are not counted).
+    typedef SmallVector<DrivingForceEntry, OP_NODE_INLINE_CAPACITY> StorageType;///< Storage vector type
+    typedef StorageType::iterator iterator;                                     ///< Iterator over storage vector
+    typedef StorageType::const_iterator citerator;                              ///< Constant iterator over storage vector
     iterator  begin() {return Fields.begin();};                                 ///< Iterator to the begin of storage vector
     iterator  end()   {return Fields.end();};                                   ///< Iterator to the end of storage vector
     citerator cbegin() const {return Fields.cbegin();};                         ///< Constant iterator to the begin of storage vector
@@ -141,9 +127,47 @@ class NodeDF
 
  protected:
  private:
-    std::vector<DrivingForceEntry> Fields;                                      ///< DrivingForceEntry storage vector.
+    StorageType Fields;                                                         ///< Fields storage vector, sorted by the index pair (min(indexA,indexB), max(indexA,indexB)).
+
+    static bool less_pair(const DrivingForceEntry& entry,
+                          const size_t lo, const size_t hi);                    ///< True if the sorted index pair of the entry precedes (lo,hi)
+    iterator  lower_bound(const size_t n, const size_t m);                      ///< First entry which does not precede the pair (n,m)
+    citerator lower_bound(const size_t n, const size_t m) const;                ///< First entry which does not precede the pair (n,m)
+    void      sort();                                                           ///< Restores the entry order after reading unsorted data
 };
 
+inline bool NodeDF::less_pair(const DrivingForceEntry& entry,
+                              const size_t lo, const size_t hi)
+{
+    const size_t locLo = std::min(entry.indexA, entry.indexB);
+    return locLo < lo or (locLo == lo and std::max(entry.indexA, entry.indexB) < hi);
+}
+
+inline NodeDF::iterator NodeDF::lower_bound(const size_t n, const size_t m)
+{
+    const size_t lo = std::min(n,m);
+    const size_t hi = std::max(n,m);
+    auto i = Fields.begin();
+    while (i < Fields.end() and less_pair(*i, lo, hi)) ++i;
+    return i;
+}
+
+inline NodeDF::citerator NodeDF::lower_bound(const size_t n, const size_t m) const
+{
+    const size_t lo = std::min(n,m);
+    const size_t hi = std::max(n,m);
+    auto i = Fields.cbegin();
+    while (i < Fields.cend() and less_pair(*i, lo, hi)) ++i;
+    return i;
+}
+
+inline void NodeDF::sort()
+{
+    std::sort(Fields.begin(), Fields.end(),
+              [](const DrivingForceEntry& a, const DrivingForceEntry& b)
+              {return less_pair(a, std::min(b.indexA, b.indexB), std::max(b.indexA, b.indexB));});
+}
+
 /***************************************************************/
 
 inline NodeDF NodeDF::operator+(const NodeDF& n) const
@@ -228,13 +252,13 @@ inline NodeDF& NodeDF::operator=(const NodeDF& n)
 
 inline void NodeDF::set_raw(const size_t n, const size_t m, const double value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and i->indexA == n and i->indexB == m)
     {
         i->raw = value;
         return;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         i->raw = -value;
         return;
@@ -248,18 +272,18 @@ inline void NodeDF::set_raw(const size_t n, const size_t m, const double value)
     NewEntry.average = 0.0;
     NewEntry.weight  = 0.0;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::set_tmp(const size_t n, const size_t m, const double value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and i->indexA == n and i->indexB == m)
     {
         i->tmp = value;
         return;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         i->tmp = -value;
         return;
@@ -273,18 +297,18 @@ inline void NodeDF::set_tmp(const size_t n, const size_t m, const double value)
     NewEntry.average = 0.0;
     NewEntry.weight  = 0.0;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::set_average(const size_t n, const size_t m, const double value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and i->indexA == n and i->indexB == m)
     {
         i->average = value;
         return;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         i->average = -value;
         return;
@@ -298,14 +322,14 @@ inline void NodeDF::set_average(const size_t n, const size_t m, const double val
     NewEntry.average = value;
     NewEntry.weight  = 0.0;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::set_weight(const size_t n, const size_t m, const double value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n))
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and ((i->indexA == n and i->indexB == m) or
+                              (i->indexA == m and i->indexB == n)))
     {
         i->weight = value;
         return;
@@ -319,7 +343,7 @@ inline void NodeDF::set_weight(const size_t n, const size_t m, const double valu
     NewEntry.average = 0.0;
     NewEntry.weight  = value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::set_all(const size_t n, const size_t m, const double raw_value,
@@ -327,8 +351,8 @@ inline void NodeDF::set_all(const size_t n, const size_t m, const double raw_val
                                                             const double avg_value,
                                                             const double wgt_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and i->indexA == n and i->indexB == m)
     {
         i->raw     = raw_value;
         i->tmp     = tmp_value;
@@ -336,7 +360,7 @@ inline void NodeDF::set_all(const size_t n, const size_t m, const double raw_val
         i->weight  = wgt_value;
         return;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         i->raw     = -raw_value;
         i->tmp     = -tmp_value;
@@ -353,17 +377,17 @@ inline void NodeDF::set_all(const size_t n, const size_t m, const double raw_val
     NewEntry.average = avg_value;
     NewEntry.weight  = wgt_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline double NodeDF::get_raw(const size_t n, const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.cend() and i->indexA == n and i->indexB == m)
     {
         return i->raw;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         return -i->raw;
     }
@@ -372,12 +396,12 @@ inline double NodeDF::get_raw(const size_t n, const size_t m) const
 
 inline double NodeDF::get_tmp(const size_t n, const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.cend() and i->indexA == n and i->indexB == m)
     {
         return i->tmp;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         return -i->tmp;
     }
@@ -386,12 +410,12 @@ inline double NodeDF::get_tmp(const size_t n, const size_t m) const
 
 inline double NodeDF::get_average(const size_t n, const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.cend() and i->indexA == n and i->indexB == m)
     {
         return i->average;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         return -i->average;
     }
@@ -400,9 +424,9 @@ inline double NodeDF::get_average(const size_t n, const size_t m) const
 
 inline double NodeDF::get_weight(const size_t n, const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n))
+    auto i = lower_bound(n, m);
+    if (i < Fields.cend() and ((i->indexA == n and i->indexB == m) or
+                               (i->indexA == m and i->indexB == n)))
     {
         return i->weight;
     }
@@ -411,13 +435,13 @@ inline double NodeDF::get_weight(const size_t n, const size_t m) const
 
 inline void NodeDF::add_raw(const size_t n, const size_t m, const double value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and i->indexA == n and i->indexB == m)
     {
         i->raw += value;
         return;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         i->raw += -value;
         return;
@@ -431,18 +455,18 @@ inline void NodeDF::add_raw(const size_t n, const size_t m, const double value)
     NewEntry.average = 0.0;
     NewEntry.weight  = 0.0;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::add_tmp(const size_t n, const size_t m, const double value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and i->indexA == n and i->indexB == m)
     {
         i->tmp += value;
         return;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         i->tmp += -value;
         return;
@@ -456,18 +480,18 @@ inline void NodeDF::add_tmp(const size_t n, const size_t m, const double value)
     NewEntry.average = 0.0;
     NewEntry.weight  = 0.0;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::add_average(const size_t n, const size_t m, const double value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and i->indexA == n and i->indexB == m)
     {
         i->average += value;
         return;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         i->average += -value;
         return;
@@ -481,14 +505,14 @@ inline void NodeDF::add_average(const size_t n, const size_t m, const double val
     NewEntry.average = value;
     NewEntry.weight  = 0.0;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::add_weight(const size_t n, const size_t m, const double value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n))
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and ((i->indexA == n and i->indexB == m) or
+                              (i->indexA == m and i->indexB == n)))
     {
         i->weight += value;
         return;
@@ -502,7 +526,7 @@ inline void NodeDF::add_weight(const size_t n, const size_t m, const double valu
     NewEntry.average = 0.0;
     NewEntry.weight  = value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::add_all(const size_t n, const size_t m, const double raw_value,
@@ -510,8 +534,8 @@ inline void NodeDF::add_all(const size_t n, const size_t m, const double raw_val
                                                             const double avg_value,
                                                             const double wgt_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if (i->indexA == n and i->indexB == m)
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and i->indexA == n and i->indexB == m)
     {
         i->raw     += raw_value;
         i->tmp     += tmp_value;
@@ -519,7 +543,7 @@ inline void NodeDF::add_all(const size_t n, const size_t m, const double raw_val
         i->weight  += wgt_value;
         return;
     }
-    else if(i->indexA == m and i->indexB == n)
+    else if (i < Fields.end() and i->indexA == m and i->indexB == n)
     {
         i->raw     += -raw_value;
         i->tmp     += -tmp_value;
@@ -536,7 +560,7 @@ inline void NodeDF::add_all(const size_t n, const size_t m, const double raw_val
     NewEntry.average = avg_value;
     NewEntry.weight  = wgt_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeDF::pack(std::vector<double>& buffer)
@@ -567,6 +591,7 @@ inline void NodeDF::unpack(std::vector<double>& buffer, size_t& it)
         Fields[i].average = buffer[it]; ++it;
         Fields[i].weight  = buffer[it]; ++it;
     }
+    sort();
 }
 
 inline void NodeDF::Read(std::istream& inp)
@@ -579,11 +604,14 @@ inline void NodeDF::Read(std::istream& inp)
     {
         inp.read(reinterpret_cast<char*>(&Field.indexA ), sizeof(size_t));
         inp.read(reinterpret_cast<char*>(&Field.indexB ), sizeof(size_t));
-        inp.read(reinterpret_cast<char*>(&Field.raw    ), sizeof(double));
-        inp.read(reinterpret_cast<char*>(&Field.tmp    ), sizeof(double));
-        inp.read(reinterpret_cast<char*>(&Field.average), sizeof(double));
-        inp.read(reinterpret_cast<char*>(&Field.weight ), sizeof(double));
-    }
+        double values[4] = {};                                                  // Files store double precision independent of pf_real_t
+        inp.read(reinterpret_cast<char*>(values), 4*sizeof(double));
+        Field.raw     = values[0];
+        Field.tmp     = values[1];
+        Field.average = values[2];
+        Field.weight  = values[3];
+    }
+    sort();
 }
 
 inline void NodeDF::Write(std::ostream& outp) const
@@ -595,10 +623,8 @@ inline void NodeDF::Write(std::ostream& outp) const
     {
         outp.write(reinterpret_cast<const char*>(&Field.indexA ), sizeof(size_t));
         outp.write(reinterpret_cast<const char*>(&Field.indexB ), sizeof(size_t));
-        outp.write(reinterpret_cast<const char*>(&Field.raw    ), sizeof(double));
-        outp.write(reinterpret_cast<const char*>(&Field.tmp    ), sizeof(double));
-        outp.write(reinterpret_cast<const char*>(&Field.average), sizeof(double));
-        outp.write(reinterpret_cast<const char*>(&Field.weight ), sizeof(double));
+        const double values[4] = {Field.raw, Field.tmp, Field.average, Field.weight};
+        outp.write(reinterpret_cast<const char*>(values), 4*sizeof(double));
     }
 }
 
@@ -28,7 +28,10 @@
 #ifndef NODEIP_H
 #define NODEIP_H
 
+#include <algorithm>
 #include <vector>
+#include "SmallVector.h"
+#include "PhaseFieldPrecision.h"
 #include <iostream>
 
 namespace openphase
@@ -39,9 +42,9 @@ struct InterfacePropertiesFieldEntry
 {
     size_t indexA;                                                              ///< First index.
     size_t indexB;                                                              ///< Second index.
-    double energy;                                                              ///< Energy value.
-    double stiffness;                                                           ///< Stiffness value.
-    double mobility;                                                            ///< Mobility value.
+    pf_real_t energy;                                                           ///< Energy value.
+    pf_real_t stiffness;                                                        ///< Stiffness value.
+    pf_real_t mobility;                                                         ///< Mobility value.
 
     InterfacePropertiesFieldEntry() :                                           ///< Default constructor.
         indexA(0),
@@ -52,33 +55,17 @@ struct InterfacePropertiesFieldEntry
     {
 
     }
-    InterfacePropertiesFieldEntry(const InterfacePropertiesFieldEntry& entry) : ///< Copy constructor.
-        indexA(entry.indexA),
-        indexB(entry.indexB),
-        energy(entry.energy),
-        stiffness(entry.stiffness),
-        mobility(entry.mobility)
-    {
-
-    }
-    InterfacePropertiesFieldEntry& operator=(const InterfacePropertiesFieldEntry& entry)///< Copy operator.
-    {
-        indexA    = entry.indexA;
-        indexB    = entry.indexB;
-        energy    = entry.energy;
-        stiffness = entry.stiffness;
-        mobility  = entry.mobility;
-        return *this;
-    }
+    InterfacePropertiesFieldEntry(const InterfacePropertiesFieldEntry& entry) = default;///< Copy constructor.
+    InterfacePropertiesFieldEntry& operator=(const InterfacePropertiesFieldEntry& entry) = default;///< Copy operator.
 };
 
 /**********************************************************/
 class NodeIP                                                                    ///< Stores the interface properties with two indices and two values at a grid point. Provides access and manipulation methods for the stored field entries.
 {
  public:
-    NodeIP()                                                                    ///< Constructor used to allocate space for at least 3 fields.
+    NodeIP()                                                                    ///< Constructor, up to OP_NODE_INLINE_CAPACITY entries are stored without heap allocation.
     {
-        Fields.reserve(3);
+
     }
     NodeIP(const NodeIP& n) :                                                   ///< Copy constructor.
         Fields(n.Fields)
@@ -163,8 +150,10 @@ class NodeIP
 
     void    clear() {Fields.clear();};                                          ///< Empties the field storage. Sets flag to 0.
     size_t  size() const {return Fields.size();};                               ///< Returns the size of storage.
-    typedef std::vector<InterfacePropertiesFieldEntry>::iterator iterator;      ///< Iterator over storage vector
-    typedef std::vector<InterfacePropertiesFieldEntry>::const_iterator citerator;///< Constant iterator over storage vector
+    size_t  allocated_memory() const {return Fields.on_heap() ? Fields.capacity()*sizeof(InterfacePropertiesFieldEntry) : 0;};///< Returns the dynamically allocated memory in bytes (inline entries are not counted).
+    typedef SmallVector<InterfacePropertiesFieldEntry, OP_NODE_INLINE_CAPACITY> StorageType;///< Storage vector type
+    typedef StorageType::iterator iterator;                                     ///< Iterator over storage vector
+    typedef StorageType::const_iterator citerator;                              ///< Constant iterator over storage vector
     iterator  begin() {return Fields.begin();};                                 ///< Iterator to the begin of storage vector
     iterator  end()   {return Fields.end();};                                   ///< Iterator to the end of storage vector
     citerator cbegin() const {return Fields.cbegin();};                         ///< Constant iterator to the begin of storage vector
@@ -180,9 +169,57 @@ class NodeIP
 
  protected:
  private:
-    std::vector<InterfacePropertiesFieldEntry> Fields;                          ///< Fields storage vector.
+    StorageType Fields;                                                         ///< Fields storage vector, sorted by the index pair (min(indexA,indexB), max(indexA,indexB)).
+
+    static bool less_pair(const InterfacePropertiesFieldEntry& entry,
+                          const size_t lo, const size_t hi);                    ///< True if the sorted index pair of the entry precedes (lo,hi)
+    static bool same_pair(const InterfacePropertiesFieldEntry& entry,
+                          const size_t n, const size_t m);                      ///< True if the entry stores the pair (n,m) in any order
+    iterator  lower_bound(const size_t n, const size_t m);                      ///< First entry which does not precede the pair (n,m)
+    citerator find(const size_t n, const size_t m) const;                       ///< Entry of the pair (n,m) or cend() if it does not exist
+    void      sort();                                                           ///< Restores the entry order after reading unsorted data
 };
 
+inline bool NodeIP::less_pair(const InterfacePropertiesFieldEntry& entry,
+                              const size_t lo, const size_t hi)
+{
+    const size_t locLo = std::min(entry.indexA, entry.indexB);
+    return locLo < lo or (locLo == lo and std::max(entry.indexA, entry.indexB) < hi);
+}
+
+inline bool NodeIP::same_pair(const InterfacePropertiesFieldEntry& entry,
+                              const size_t n, const size_t m)
+{
+    return (entry.indexA == n and entry.indexB == m) or
+           (entry.indexA == m and entry.indexB == n);
+}
+
+inline NodeIP::iterator NodeIP::lower_bound(const size_t n, const size_t m)
+{
+    const size_t lo = std::min(n,m);
+    const size_t hi = std::max(n,m);
+    auto i = Fields.begin();
+    while (i < Fields.end() and less_pair(*i, lo, hi)) ++i;
+    return i;
+}
+
+inline NodeIP::citerator NodeIP::find(const size_t n, const size_t m) const
+{
+    const size_t lo = std::min(n,m);
+    const size_t hi = std::max(n,m);
+    auto i = Fields.cbegin();
+    while (i < Fields.cend() and less_pair(*i, lo, hi)) ++i;
+    if (i < Fields.cend() and same_pair(*i, n, m)) return i;
+    return Fields.cend();
+}
+
+inline void NodeIP::sort()
+{
+    std::sort(Fields.begin(), Fields.end(),
+              [](const InterfacePropertiesFieldEntry& a, const InterfacePropertiesFieldEntry& b)
+              {return less_pair(a, std::min(b.indexA, b.indexB), std::max(b.indexA, b.indexB));});
+}
+
 /***************************************************************/
 
 inline NodeIP NodeIP::operator+(const NodeIP& n) const
@@ -265,9 +302,8 @@ inline NodeIP& NodeIP::operator=(const NodeIP& n)
 inline void NodeIP::set_energy(const size_t n, const size_t m,
                                const double en_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->energy = en_value;
         return;
@@ -278,15 +314,14 @@ inline void NodeIP::set_energy(const size_t n, const size_t m,
     NewEntry.indexB = m;
     NewEntry.energy = en_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::set_stiffness(const size_t n, const size_t m,
                                   const double st_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->stiffness = st_value;
         return;
@@ -297,15 +332,14 @@ inline void NodeIP::set_stiffness(const size_t n, const size_t m,
     NewEntry.indexB = m;
     NewEntry.stiffness = st_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::set_mobility(const size_t n, const size_t m,
                                  const double mob_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->mobility = mob_value;
         return;
@@ -316,15 +350,14 @@ inline void NodeIP::set_mobility(const size_t n, const size_t m,
     NewEntry.indexB = m;
     NewEntry.mobility = mob_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::add_energy(const size_t n, const size_t m,
                                const double en_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->energy += en_value;
         return;
@@ -335,15 +368,14 @@ inline void NodeIP::add_energy(const size_t n, const size_t m,
     NewEntry.indexB = m;
     NewEntry.energy = en_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::add_stiffness(const size_t n, const size_t m,
                                   const double st_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->stiffness += st_value;
         return;
@@ -354,15 +386,14 @@ inline void NodeIP::add_stiffness(const size_t n, const size_t m,
     NewEntry.indexB = m;
     NewEntry.stiffness = st_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::add_mobility(const size_t n, const size_t m,
                                  const double mob_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->mobility += mob_value;
         return;
@@ -373,14 +404,13 @@ inline void NodeIP::add_mobility(const size_t n, const size_t m,
     NewEntry.indexB = m;
     NewEntry.mobility = mob_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline double NodeIP::get_energy(const size_t n, const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = find(n, m);
+    if (i < Fields.cend())
     {
         return i->energy;
     }
@@ -389,9 +419,8 @@ inline double NodeIP::get_energy(const size_t n, const size_t m) const
 
 inline double NodeIP::get_stiffness(const size_t n, const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = find(n, m);
+    if (i < Fields.cend())
     {
         return i->stiffness;
     }
@@ -400,9 +429,8 @@ inline double NodeIP::get_stiffness(const size_t n, const size_t m) const
 
 inline double NodeIP::get_mobility(const size_t n, const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = find(n, m);
+    if (i < Fields.cend())
     {
         return i->mobility;
     }
@@ -413,9 +441,8 @@ inline void NodeIP::set_energy_and_mobility(const size_t n, const size_t m,
                                             const double en_value,
                                             const double mob_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->energy = en_value;
         i->mobility = mob_value;
@@ -428,16 +455,15 @@ inline void NodeIP::set_energy_and_mobility(const size_t n, const size_t m,
     NewEntry.energy = en_value;
     NewEntry.mobility = mob_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::set_stiffness_and_mobility(const size_t n, const size_t m,
                                                const double st_value,
                                                const double mob_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->stiffness = st_value;
         i->mobility = mob_value;
@@ -450,16 +476,15 @@ inline void NodeIP::set_stiffness_and_mobility(const size_t n, const size_t m,
     NewEntry.stiffness = st_value;
     NewEntry.mobility = mob_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::set_energy_and_stiffness(const size_t n, const size_t m,
                                              const double en_value,
                                              const double st_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->energy = en_value;
         i->stiffness = st_value;
@@ -472,7 +497,7 @@ inline void NodeIP::set_energy_and_stiffness(const size_t n, const size_t m,
     NewEntry.energy = en_value;
     NewEntry.stiffness = st_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::set_energy_stiffness_and_mobility(const size_t n, const size_t m,
@@ -480,9 +505,8 @@ inline void NodeIP::set_energy_stiffness_and_mobility(const size_t n, const size
                                                       const double st_value,
                                                       const double mob_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->energy = en_value;
         i->stiffness = st_value;
@@ -497,16 +521,15 @@ inline void NodeIP::set_energy_stiffness_and_mobility(const size_t n, const size
     NewEntry.stiffness = st_value;
     NewEntry.mobility = mob_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::add_energy_and_mobility(const size_t n, const size_t m,
                                             const double en_value,
                                             const double mob_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->energy += en_value;
         i->mobility += mob_value;
@@ -519,16 +542,15 @@ inline void NodeIP::add_energy_and_mobility(const size_t n, const size_t m,
     NewEntry.energy = en_value;
     NewEntry.mobility = mob_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::add_stiffness_and_mobility(const size_t n, const size_t m,
                                                const double st_value,
                                                const double mob_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->stiffness += st_value;
         i->mobility += mob_value;
@@ -541,16 +563,15 @@ inline void NodeIP::add_stiffness_and_mobility(const size_t n, const size_t m,
     NewEntry.stiffness = st_value;
     NewEntry.mobility = mob_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::add_energy_and_stiffness(const size_t n, const size_t m,
                                              const double en_value,
                                              const double st_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->energy += en_value;
         i->stiffness += st_value;
@@ -563,7 +584,7 @@ inline void NodeIP::add_energy_and_stiffness(const size_t n, const size_t m,
     NewEntry.energy = en_value;
     NewEntry.stiffness = st_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline void NodeIP::add_energy_stiffness_and_mobility(const size_t n, const size_t m,
@@ -571,9 +592,8 @@ inline void NodeIP::add_energy_stiffness_and_mobility(const size_t n, const size
                                                       const double st_value,
                                                       const double mob_value)
 {
-    for (auto i = Fields.begin(); i < Fields.end(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = lower_bound(n, m);
+    if (i < Fields.end() and same_pair(*i, n, m))
     {
         i->energy += en_value;
         i->stiffness += st_value;
@@ -588,15 +608,14 @@ inline void NodeIP::add_energy_stiffness_and_mobility(const size_t n, const size
     NewEntry.stiffness = st_value;
     NewEntry.mobility = mob_value;
 
-    Fields.push_back(NewEntry);
+    Fields.insert(i, NewEntry);
 }
 
 inline std::pair<double,double> NodeIP::get_energy_and_mobility(const size_t n,
                                                                 const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = find(n, m);
+    if (i < Fields.cend())
     {
         return std::pair<double,double>(i->energy, i->mobility);
     }
@@ -606,9 +625,8 @@ inline std::pair<double,double> NodeIP::get_energy_and_mobility(const size_t n,
 inline std::pair<double,double> NodeIP::get_stiffness_and_mobility(const size_t n,
                                                                    const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = find(n, m);
+    if (i < Fields.cend())
     {
         return std::pair<double,double>(i->stiffness, i->mobility);
     }
@@ -618,9 +636,8 @@ inline std::pair<double,double> NodeIP::get_stiffness_and_mobility(const size_t
 inline std::pair<double,double> NodeIP::get_energy_and_stiffness(const size_t n,
                                                                  const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = find(n, m);
+    if (i < Fields.cend())
     {
         return std::pair<double,double>(i->energy, i->stiffness);
     }
@@ -630,9 +647,8 @@ inline std::pair<double,double> NodeIP::get_energy_and_stiffness(const size_t n,
 inline InterfacePropertiesFieldEntry NodeIP::get_entry(const size_t n,
                                                               const size_t m) const
 {
-    for (auto i = Fields.cbegin(); i < Fields.cend(); ++i)
-    if ((i->indexA == n and i->indexB == m) or
-        (i->indexA == m and i->indexB == n) )
+    auto i = find(n, m);
+    if (i < Fields.cend())
     {
         return *i;
     }
@@ -753,6 +769,7 @@ inline void NodeIP::unpack(std::vector<double>& buffer, size_t& it)
         Fields[i].stiffness = buffer[it]; ++it;
         Fields[i].mobility = buffer[it]; ++it;
     }
+    sort();
 }
 
 inline void NodeIP::read(std::istream& inp)
@@ -765,10 +782,13 @@ inline void NodeIP::read(std::istream& inp)
     {
         inp.read(reinterpret_cast<char*>(&Field.indexA), sizeof(size_t));
         inp.read(reinterpret_cast<char*>(&Field.indexB), sizeof(size_t));
-        inp.read(reinterpret_cast<char*>(&Field.energy), sizeof(double));
-        inp.read(reinterpret_cast<char*>(&Field.stiffness), sizeof(double));
-        inp.read(reinterpret_cast<char*>(&Field.mobility), sizeof(double));
+        double values[3] = {};                                                  // Files store double precision independent of pf_real_t
+        inp.read(reinterpret_cast<char*>(values), 3*sizeof(double));
+        Field.energy    = values[0];
+        Field.stiffness = values[1];
+        Field.mobility  = values[2];
     }
+    sort();
 }
 
 inline void NodeIP::write(std::ostream& outp) const
@@ -780,9 +800,8 @@ inline void NodeIP::write(std::ostream& outp) const
     {
         outp.write(reinterpret_cast<const char*>(&Field.indexA), sizeof(size_t));
         outp.write(reinterpret_cast<const char*>(&Field.indexB), sizeof(size_t));
-        outp.write(reinterpret_cast<const char*>(&Field.energy), sizeof(double));
-        outp.write(reinterpret_cast<const char*>(&Field.stiffness), sizeof(double));
-        outp.write(reinterpret_cast<const char*>(&Field.mobility), sizeof(double));
+        const double values[3] = {Field.energy, Field.stiffness, Field.mobility};
+        outp.write(reinterpret_cast<const char*>(values), 3*sizeof(double));
     }
 }
 
@@ -28,10 +28,13 @@
 #ifndef NODEPF_H
 #define NODEPF_H
 
+#include <algorithm>
 #include <vector>
 #include <utility>
 
 #include "dVector3.h"
+#include "NodeAllocator.h"
+#include "PhaseFieldPrecision.h"
 
 namespace openphase
 {
@@ -40,15 +43,15 @@ namespace openphase
 struct PhaseFieldEntry                                                          ///< Structure for storing individual phase-fields. Used in the NodePF class as a storage unit.
 {
     size_t index;                                                               ///< Phase-field index.
-    double value;                                                               ///< Phase-field value.
-    double laplacian;                                                           ///< Phase-field Laplacian.
-    dVector3 gradient;                                                          ///< Phase-field gradient.
+    pf_real_t value;                                                            ///< Phase-field value.
+    pf_real_t laplacian;                                                        ///< Phase-field Laplacian.
+    pf_vector_t gradient;                                                       ///< Phase-field gradient.
 
     PhaseFieldEntry() :                                                         ///< Default constructor.
     index(0),
     value(0.0),
     laplacian(0.0),
-    gradient(dVector3::ZeroVector())
+    gradient(pf_vector_t::ZeroVector())
     {
 
     }
@@ -97,6 +100,13 @@ class NodePF
         flag  = 0;
     };
 
+    void compact()                                                              ///< Releases unused storage capacity and the temporary storage
+    {
+        tmpFields.clear();
+        tmpFields.shrink_to_fit();
+        Fields.shrink_to_fit();
+    };
+
     int     finalize(void);                                                     ///< Adjusts phase-field values to (0, 1] interval.
     int     majority_index(void) const;                                         ///< Calculates and returns majority phase-field index
 
@@ -108,6 +118,7 @@ class NodePF
     NodePF& operator+=(const NodePF& n);                                        ///< Plus-equal operator. Takes as input another NodePF type entry.
     NodePF& operator-=(const NodePF& n);                                        ///< Minus-equal operator. Takes as input another NodePF type entry.
     NodePF& operator*=(const double n);                                         ///< Multiply all fields by a number.
+    void    add_weighted(const NodePF& n, const double weight);                 ///< Same as += n*weight without the temporary node.
 
     bool    present(const size_t idx) const;                                    ///< Returns true if the phase-field with a given index is present in the node, false otherwise.
 
@@ -153,8 +164,8 @@ class NodePF
     bool    wide_interface(void) const;                                         ///< Returns true if flag != 0
     bool    bulk(void) const;                                                   ///< Returns true if flag != 2
 
-    typedef std::vector<PhaseFieldEntry>::iterator iterator;                    ///< Iterator over storage vector.
-    typedef std::vector<PhaseFieldEntry>::const_iterator citerator;             ///< Constant iterator over storage vector.
+    typedef NodeVector<PhaseFieldEntry>::iterator iterator;                     ///< Iterator over storage vector.
+    typedef NodeVector<PhaseFieldEntry>::const_iterator citerator;              ///< Constant iterator over storage vector.
 
     iterator  begin() {return Fields.begin();};                                 ///< Iterator to the begin of storage vector.
     iterator  end()   {return Fields.end();};                                   ///< Iterator to the end of storage vector.
@@ -162,6 +173,7 @@ class NodePF
     citerator cend()   const {return Fields.cend();};                           ///< Constant iterator to the end of storage vector.
 
     size_t    size() const {return Fields.size();};                             ///< Returns the size of storage.
+    size_t    allocated_memory() const {return (Fields.capacity() + tmpFields.capacity())*sizeof(PhaseFieldEntry);};///< Returns the dynamically allocated memory in bytes.
     size_t    capacity() const {return Fields.capacity();};                     ///< Returns the capacity of storage.
     iterator  erase(iterator it) {return Fields.erase(it);};                    ///< Erase a single record pointed by iterator it.
     PhaseFieldEntry& front(void) {return Fields.front();};                      ///< Reference to the first FieldEntry.
@@ -175,8 +187,8 @@ class NodePF
     int flag;                                                                   ///< Interface flag: 1 if node is near the interface, 2 if it is in the interface and 0 if it is in the bulk.
  protected:
  private:
-    std::vector<PhaseFieldEntry> Fields;                                        ///< Stores phase fields and their derivatives.
-    std::vector<PhaseFieldEntry> tmpFields;                                     ///< Stores temporary phase fields.
+    NodeVector<PhaseFieldEntry> Fields;                                         ///< Stores phase fields and their derivatives.
+    NodeVector<PhaseFieldEntry> tmpFields;                                      ///< Stores temporary phase fields.
 };
 
 /******************************* Implementation ******************************/
@@ -498,6 +510,15 @@ inline NodePF& NodePF::operator+=(const NodePF& n)
     return *this;
 }
 
+inline void NodePF::add_weighted(const NodePF& n, const double weight)
+{
+    for (auto i = n.cbegin(); i < n.cend(); ++i)
+    {
+        add_all(i->index, i->value*weight, i->laplacian*weight, i->gradient*weight);
+    }
+    flag = std::max(flag, n.flag);
+}
+
 inline NodePF& NodePF::operator-=(const NodePF& n)
 {
     for (auto i = n.cbegin(); i < n.cend(); ++i)
@@ -751,15 +772,23 @@ inline void NodePF::unpack(std::vector<double>& buffer, size_t& it)
 inline void NodePF::read(std::istream& inp)
 {
     size_t size = 0;
-    flag = 0;
     inp.read(reinterpret_cast<char*>(&size), sizeof(size_t));
     Fields.resize(size);
-    if(size > 1) flag = 2;
     for(auto &Field : Fields)
     {
+        double value = 0.0;                                                     // Files store double precision independent of pf_real_t
         inp.read(reinterpret_cast<char*>(&Field.index), sizeof(size_t));
-        inp.read(reinterpret_cast<char*>(&Field.value), sizeof(double));
+        inp.read(reinterpret_cast<char*>(&value), sizeof(double));
+        Field.value = value;
+    }
+    /* Entries without a value only carried derivatives next to the interface,
+    they are recalculated after reading and must not mark the node as interface */
+    if(Fields.size() > 1)
+    {
+        Fields.erase(std::remove_if(Fields.begin(), Fields.end(),
+            [](const PhaseFieldEntry& Field){return Field.value == 0.0;}), Fields.end());
     }
+    flag = (Fields.size() > 1) ? 2 : 0;
 }
 
 inline void NodePF::write(std::ostream& outp) const
@@ -769,8 +798,9 @@ inline void NodePF::write(std::ostream& outp) const
 
     for(auto &Field : Fields)
     {
+        const double value = Field.value;
         outp.write(reinterpret_cast<const char*>(&Field.index), sizeof(size_t));
-        outp.write(reinterpret_cast<const char*>(&Field.value), sizeof(double));
+        outp.write(reinterpret_cast<const char*>(&value), sizeof(double));
     }
 }
 
@@ -112,6 +112,7 @@ public:
 
     void   clear(){VectorFields.clear();};                                      ///< Empties the vector fields.
     size_t  size() const {return VectorFields.size();};                         ///< Returns the size of vector fields.
+    size_t  allocated_memory() const {return VectorFields.capacity()*sizeof(VecEntry);};///< Returns the dynamically allocated memory in bytes.
     void read(std::istream& inp);                                               ///< Reads NodeVectorN content from the input stream.
     void write(std::ostream& outp) const;                                       ///< Writes NodeVectorN content to the output stream.
 
@@ -66,6 +66,7 @@ class NodeVn
 
     void   clear(){VectorVnFields.clear();};                                    /// Empties the vector fields.
     size_t  size() const {return VectorVnFields.size();};                        /// Returns the size of vector fields.
+    size_t  allocated_memory() const {return VectorVnFields.capacity()*sizeof(VectorVnEntry<N>);};/// Returns the dynamically allocated memory in bytes.
     typedef typename std::vector<VectorVnEntry<N>>::iterator iterator;          /// Iterator over the vector fields
     typedef typename std::vector<VectorVnEntry<N>>::const_iterator citerator;   /// Constant iterator over the vector fields
     iterator begin() {return VectorVnFields.begin();};                          /// Iterator to the begin of vector fields
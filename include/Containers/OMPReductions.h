@@ -27,8 +27,303 @@
 #ifndef OMPREDUCTIONS_H
 #define OMPREDUCTIONS_H
 
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "Globals.h"
+#include "Containers/dVector3.h"
+
 namespace openphase
 {
+/* Thread-local accumulation for reductions which do not fit into a reduction
+clause, e.g. contributions computed in per-cell methods called from a parallel
+storage loop, or reductions over Tensor and Matrix types without a declared
+reduction. Each thread accumulates into its own copy, the copies are combined
+in thread order after the parallel region. The copies are kept in separate
+cache lines to avoid false sharing. Note that every thread holds a full copy,
+i.e. the memory used is omp_get_max_threads() times the size of T.
+
+Usage:
+    ThreadLocalAccumulator<Matrix<int>> locOverlap(Overlap); // Overlap is zero
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
+    {
+        locOverlap.Local().add(n, m, 1);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    Overlap = locOverlap.Sum();
+*/
+template<class T>
+class ThreadLocalAccumulator                                                    ///< Per-thread copies of an accumulator, replaces omp critical sections around accumulations
+{
+ public:
+    ThreadLocalAccumulator(){};
+    explicit ThreadLocalAccumulator(const T& zero)
+    {
+        Reset(zero);
+    }
+    void Reset(const T& zero)                                                   ///< Sets the copies of all threads to "zero" (e.g. an allocated zero Tensor), has to be called outside of parallel regions
+    {
+        Slots.assign(omp_get_max_threads(), Slot{zero});
+    }
+    T& Local(void)                                                              ///< Copy of the calling thread
+    {
+        return Slots[omp_get_thread_num()].value;
+    }
+    size_t size(void) const                                                     ///< Number of thread copies
+    {
+        return Slots.size();
+    }
+    const T& operator[](const size_t thread) const                              ///< Copy of a given thread
+    {
+        return Slots[thread].value;
+    }
+    std::vector<T> Values(void) const                                           ///< Copies of all threads in thread order
+    {
+        std::vector<T> result;
+        result.reserve(Slots.size());
+        for(auto& slot : Slots) result.push_back(slot.value);
+        return result;
+    }
+    T Sum(void) const                                                           ///< Sum of all copies (in thread order) using T::operator+=
+    {
+        T result = Slots[0].value;
+        for(size_t n = 1; n < Slots.size(); n++)
+        {
+            result += Slots[n].value;
+        }
+        return result;
+    }
+    T SumElementwise(void) const                                                ///< Same as Sum() for containers with size() and operator[] (e.g. Tensor), the elements are summed in parallel, has to be called outside of parallel regions
+    {
+        /* With many threads and large copies (e.g. forces of thousands of
+        grains) the serial Sum() becomes the bottleneck. The elements are
+        independent, each is summed over the threads in thread order, so the
+        result is identical to Sum().*/
+        T result = Slots[0].value;
+        const long int size = result.size();
+        #pragma omp parallel for schedule(static)
+        for(long int e = 0; e < size; e++)
+        {
+            for(size_t n = 1; n < Slots.size(); n++)
+            {
+                result[e] += Slots[n].value[e];
+            }
+        }
+        return result;
+    }
+ private:
+    struct alignas(64) Slot                                                     ///< Thread copy, aligned to a cache line
+    {
+        T value;
+    };
+    std::vector<Slot> Slots;
+};
+
+/* Order independent (reproducible) summation. Floating point addition is not
+associative, sums accumulated in OpenMP chunks, per thread copies or MPI
+reductions change in the last bits with the number of threads, the schedule
+and the domain decomposition. A ReproducibleSum converts every summand exactly
+into a fixed point number with a resolution of 2^-160 (about 7e-49) and stores
+it as 32 bit digits in 64 bit integers. Integer addition is associative, the
+accumulated digits do not depend on the order of the summands and the
+conversion back to double is bitwise reproducible. The digits are only
+normalized (carries propagated) every 2^30 additions and before the
+conversion, an addition costs a frexp() and three integer additions. Summands
+smaller than the resolution are truncated. Summands above 2^64 and non-finite
+values are added to an ordinary double which is not reproducible, Overflow()
+reports its use. Partial sums of different threads or ranks are combined
+with operator+= or, across MPI ranks, with ReductionBatch::Sum() which reduces
+the digits exactly.
+
+Usage:
+    sum_real_t Energy = 0.0;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Field,0,reduction(ReproducibleSUM:Energy))
+    {
+        Energy += Field(i,j,k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return double(Energy);
+
+sum_real_t and sum_vector3_t are ReproducibleSum and ReproducibleVector3 if
+compiled with -DDETERMINISTIC_REDUCTIONS (SETTINGS="deterministic" in the
+Makefile build or -DENABLE_DETERMINISTIC_REDUCTIONS=ON in the CMake build) and
+double and dVector3 otherwise. The overhead of the deterministic mode is
+measured by benchmarks/OMPReductionScaling.*/
+class ReproducibleSum                                                           ///< Exact fixed point accumulator with an order independent result
+{
+ public:
+    static constexpr int NumDigits = 8;                                         ///< Number of 32 bit digits
+    static constexpr int MinExponent = -160;                                    ///< Binary exponent of the lowest bit
+    static constexpr int MaxExponent = 64;                                      ///< Summands with |value| >= 2^MaxExponent go to the fallback
+
+    ReproducibleSum()
+    {
+        clear();
+    }
+    ReproducibleSum(const double value)
+    {
+        clear();
+        *this += value;
+    }
+    void clear(void)                                                            ///< Sets the sum to zero
+    {
+        Digits.fill(0);
+        Fallback = 0.0;
+        Count = 0;
+    }
+    ReproducibleSum& operator+=(const double value)
+    {
+        if(value == 0.0) return *this;
+
+        int exponent = 0;
+        const double mantissa = std::frexp(value, &exponent);                   // value = mantissa*2^exponent, 0.5 <= |mantissa| < 1
+        if(not std::isfinite(value) or exponent > MaxExponent)
+        {
+            Fallback += value;
+            return *this;
+        }
+        /* Integer mantissa of 53 bits, its lowest bit is at "shift" bits
+        above the lowest bit of the accumulator */
+        const int64_t integer = static_cast<int64_t>(std::ldexp(mantissa, 53));
+        uint64_t magnitude = integer < 0 ? -integer : integer;
+        int shift = exponent - 53 - MinExponent;
+        if(shift < 0)
+        {
+            if(shift <= -53) return *this;
+            magnitude >>= -shift;
+            shift = 0;
+        }
+        const int digit  = shift/32;
+        const int offset = shift%32;
+        const uint64_t upper = magnitude >> (32 - offset);
+        const int64_t part[3] = {int64_t((magnitude << offset) & DigitMask),
+                                 int64_t(upper & DigitMask),
+                                 int64_t(upper >> 32)};
+        if(integer < 0)
+        {
+            Digits[digit  ] -= part[0];
+            Digits[digit+1] -= part[1];
+            Digits[digit+2] -= part[2];
+        }
+        else
+        {
+            Digits[digit  ] += part[0];
+            Digits[digit+1] += part[1];
+            Digits[digit+2] += part[2];
+        }
+        if(++Count >= MaxCount) Normalize();
+        return *this;
+    }
+    ReproducibleSum& operator-=(const double value)
+    {
+        return *this += -value;
+    }
+    ReproducibleSum& operator+=(const ReproducibleSum& rhs)
+    {
+        for(int n = 0; n < NumDigits; n++)
+        {
+            Digits[n] += rhs.Digits[n];
+        }
+        Fallback += rhs.Fallback;
+        Count += rhs.Count + 1;
+        if(Count >= MaxCount) Normalize();
+        return *this;
+    }
+    explicit operator double() const                                            ///< Sum rounded to double, bitwise reproducible unless Overflow()
+    {
+        ReproducibleSum tmp(*this);
+        tmp.Normalize();
+        /* After normalization all digits but the highest are in [0, 2^32),
+        the magnitude is converted from the highest digit down */
+        const bool negative = tmp.Digits[NumDigits-1] < 0;
+        if(negative)
+        {
+            for(int n = 0; n < NumDigits; n++) tmp.Digits[n] = -tmp.Digits[n];
+            tmp.Normalize();
+        }
+        double result = 0.0;
+        for(int n = NumDigits-1; n >= 0; n--)
+        {
+            result += std::ldexp(double(tmp.Digits[n]), 32*n + MinExponent);
+        }
+        return (negative ? -result : result) + Fallback;
+    }
+    bool Overflow(void) const                                                   ///< True if summands outside of the fixed point range have been added
+    {
+        return Fallback != 0.0;
+    }
+    void Normalize(void)                                                        ///< Propagates the carries, all digits but the highest are in [0, 2^32) afterwards
+    {
+        for(int n = 0; n < NumDigits-1; n++)
+        {
+            const int64_t low = Digits[n] & DigitMask;
+            const int64_t carry = (Digits[n] - low)/DigitBase;
+            Digits[n]    = low;
+            Digits[n+1] += carry;
+        }
+        Count = 0;
+    }
+
+ private:
+    friend class ReductionBatch;
+    static constexpr int64_t DigitBase = int64_t(1) << 32;
+    static constexpr int64_t DigitMask = DigitBase - 1;
+    static constexpr uint32_t MaxCount = uint32_t(1) << 30;                     ///< Additions between normalizations, keeps the digits below 2^63
+
+    std::array<int64_t, NumDigits> Digits;                                      ///< Signed 32 bit digits, the lowest first
+    double   Fallback;                                                          ///< Sum of the summands outside of the fixed point range
+    uint32_t Count;                                                             ///< Additions since the last normalization
+};
+
+class ReproducibleVector3                                                       ///< Order independent accumulator of dVector3 summands, e.g. grain forces and torques
+{
+ public:
+    ReproducibleVector3(){};
+    ReproducibleVector3(const dVector3& value)
+    {
+        *this += value;
+    }
+    ReproducibleVector3& operator+=(const dVector3& value)
+    {
+        for(int n = 0; n < 3; n++) Components[n] += value[n];
+        return *this;
+    }
+    ReproducibleVector3& operator-=(const dVector3& value)
+    {
+        for(int n = 0; n < 3; n++) Components[n] -= value[n];
+        return *this;
+    }
+    ReproducibleVector3& operator+=(const ReproducibleVector3& rhs)
+    {
+        for(int n = 0; n < 3; n++) Components[n] += rhs.Components[n];
+        return *this;
+    }
+    explicit operator dVector3() const                                          ///< Sum rounded to double
+    {
+        return dVector3{double(Components[0]), double(Components[1]), double(Components[2])};
+    }
+    bool Overflow(void) const                                                   ///< True if a component has used the non-reproducible fallback
+    {
+        return Components[0].Overflow() or Components[1].Overflow() or Components[2].Overflow();
+    }
+ private:
+    ReproducibleSum Components[3];
+};
+
+#ifdef DETERMINISTIC_REDUCTIONS
+typedef ReproducibleSum     sum_real_t;
+typedef ReproducibleVector3 sum_vector3_t;
+#else
+typedef double   sum_real_t;
+typedef dVector3 sum_vector3_t;
+#endif
+
 #ifdef _OPENMP
     #pragma omp declare reduction (TensorD1Sum: Tensor<double, 1> : omp_out += omp_in) initializer (omp_priv = omp_orig)
     #pragma omp declare reduction (TensorD2Sum: Tensor<double, 2> : omp_out += omp_in) initializer (omp_priv = omp_orig)
@@ -48,6 +343,8 @@ namespace openphase
     #pragma omp declare reduction (dMatrix6x6SUM: dMatrix6x6 : omp_out += omp_in) initializer (omp_priv = omp_orig)
 
     #pragma omp declare reduction (dVectorNSUM: dVectorN : omp_out += omp_in) initializer (omp_priv = omp_orig)
+
+    #pragma omp declare reduction (ReproducibleSUM: sum_real_t : omp_out += omp_in) initializer (omp_priv = sum_real_t())
 #endif
 }
 
@@ -0,0 +1,140 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef OCCUPANCYMAP_H
+#define OCCUPANCYMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace openphase
+{
+
+enum class OccupancyStates : char                                               ///< Content of a block of the occupancy map
+{
+    Bulk,                                                                       ///< Single solid grain, no interface cells
+    Fluid,                                                                      ///< Single fluid (liquid or gas) grain, no interface cells
+    Interface                                                                   ///< Contains interface cells (nonzero phase-field flag)
+};
+
+class OccupancyMap                                                              ///< Coarse map of the interior cells in blocks of BlockSize^d cells
+{
+    /* Built by PhaseField::Finalize() from the interface cell list, used by
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN to skip the blocks without
+    interface cells. A map which does not match the size of the storage (not
+    built, disabled, double resolution, remeshed grid) skips nothing. */
+ public:
+    void Resize(const long int sizeX, const long int sizeY, const long int sizeZ,
+                const long int blockSize)                                       ///< Sets the storage size and the block size, all blocks become Interface blocks
+    {
+        SizeX = sizeX;
+        SizeY = sizeY;
+        SizeZ = sizeZ;
+        Size = blockSize;
+        NBx = (SizeX + Size - 1)/Size;
+        NBy = (SizeY + Size - 1)/Size;
+        NBz = (SizeZ + Size - 1)/Size;
+        States.assign(NBx*NBy*NBz, OccupancyStates::Interface);
+        Grains.assign(NBx*NBy*NBz, 0);
+    }
+    void Clear(void)                                                            ///< Disables the map
+    {
+        SizeX = SizeY = SizeZ = 0;
+        NBx = NBy = NBz = 0;
+        States.clear();
+        Grains.clear();
+    }
+    bool Matches(const long int sizeX, const long int sizeY, const long int sizeZ) const ///< True if the map is built for a storage of this size
+    {
+        return not States.empty() and sizeX == SizeX and sizeY == SizeY and sizeZ == SizeZ;
+    }
+
+    long int BlockSize(void) const
+    {
+        return Size;
+    }
+    long int LoopBlockSize(void) const                                          ///< Block size used by the occupied storage loops, also if the map is disabled
+    {
+        return States.empty() ? DefaultBlockSize : Size;
+    }
+    long int BlocksX(void) const {return NBx;};
+    long int BlocksY(void) const {return NBy;};
+    long int BlocksZ(void) const {return NBz;};
+    size_t Block(const long int bx, const long int by, const long int bz) const
+    {
+        return (bx*NBy + by)*NBz + bz;
+    }
+
+    OccupancyStates& State(const long int bx, const long int by, const long int bz)
+    {
+        return States[Block(bx,by,bz)];
+    }
+    OccupancyStates State(const long int bx, const long int by, const long int bz) const
+    {
+        return States[Block(bx,by,bz)];
+    }
+    OccupancyStates StateOfCell(const long int i, const long int j, const long int k) const
+    {
+        return States[Block(i/Size, j/Size, k/Size)];
+    }
+    size_t& Grain(const long int bx, const long int by, const long int bz)      ///< Phase-field index of a bulk or fluid block
+    {
+        return Grains[Block(bx,by,bz)];
+    }
+    size_t Grain(const long int bx, const long int by, const long int bz) const
+    {
+        return Grains[Block(bx,by,bz)];
+    }
+    bool Skip(const long int bx, const long int by, const long int bz) const    ///< True if the block contains no interface cells
+    {
+        return States[Block(bx,by,bz)] != OccupancyStates::Interface;
+    }
+    size_t Count(const OccupancyStates state) const                             ///< Number of blocks in the given state
+    {
+        return std::count(States.begin(), States.end(), state);
+    }
+    size_t NumberOfBlocks(void) const
+    {
+        return States.size();
+    }
+
+    static constexpr long int DefaultBlockSize = 8;                             ///< Default block edge length
+
+ private:
+    long int SizeX = 0;                                                         ///< Storage size in x direction
+    long int SizeY = 0;                                                         ///< Storage size in y direction
+    long int SizeZ = 0;                                                         ///< Storage size in z direction
+    long int Size = DefaultBlockSize;                                           ///< Block edge length
+    long int NBx = 0;                                                           ///< Number of blocks in x direction
+    long int NBy = 0;                                                           ///< Number of blocks in y direction
+    long int NBz = 0;                                                           ///< Number of blocks in z direction
+    std::vector<OccupancyStates> States;                                        ///< State of every block
+    std::vector<size_t> Grains;                                                 ///< Phase-field index of the bulk and fluid blocks
+};
+
+}// namespace openphase
+#endif
@@ -0,0 +1,166 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef PHASEFIELDPRECISION_H
+#define PHASEFIELDPRECISION_H
+
+#include "dVector3.h"
+
+namespace openphase
+{
+
+/* Storage precision of the phase-field entries and of the matching driving
+force and interface property entries. Compiling with
+-DSINGLE_PRECISION_PHASE_FIELDS (SETTINGS="single-phasefields" in the Makefile
+build or -DENABLE_SINGLE_PRECISION_PHASE_FIELDS=ON in the CMake build) stores
+the values, Laplacians and gradients in single precision, which roughly halves
+the size of a phase-field entry. The node interfaces (set_*, add_*, get_*)
+keep double precision arguments and results, arithmetic on the stored values
+is carried out in double precision and the accumulated quantities, like grain
+volumes, stay double precision. */
+
+class fVector3                                                                  ///< Single precision storage of a 3D vector, arithmetic is done in double precision via dVector3
+{
+ public:
+    fVector3()
+    {
+        set_to_zero();
+    }
+    fVector3(const dVector3& vec)
+    {
+        storage[0] = vec[0];
+        storage[1] = vec[1];
+        storage[2] = vec[2];
+    }
+    fVector3& operator=(const dVector3& vec)
+    {
+        storage[0] = vec[0];
+        storage[1] = vec[1];
+        storage[2] = vec[2];
+        return *this;
+    }
+    operator dVector3() const
+    {
+        return dVector3({storage[0], storage[1], storage[2]});
+    }
+
+    float& operator[](const size_t i)
+    {
+        assert(i < 3 && "Access beyond storage range");
+        return storage[i];
+    }
+    float const& operator[](const size_t i) const
+    {
+        assert(i < 3 && "Access beyond storage range");
+        return storage[i];
+    }
+
+    void set_to_zero(void)
+    {
+        storage[0] = 0.0f;
+        storage[1] = 0.0f;
+        storage[2] = 0.0f;
+    }
+    static fVector3 ZeroVector(void)
+    {
+        return fVector3();
+    }
+
+    fVector3& operator+=(const dVector3& rhs)
+    {
+        return *this = dVector3(*this) + rhs;
+    }
+    fVector3& operator-=(const dVector3& rhs)
+    {
+        return *this = dVector3(*this) - rhs;
+    }
+    fVector3& operator*=(const double m)
+    {
+        return *this = dVector3(*this)*m;
+    }
+
+    dVector3 operator+(const dVector3& rhs) const
+    {
+        return dVector3(*this) + rhs;
+    }
+    dVector3 operator-(const dVector3& rhs) const
+    {
+        return dVector3(*this) - rhs;
+    }
+    dVector3 operator*(const double m) const
+    {
+        return dVector3(*this)*m;
+    }
+    dVector3 operator/(const double m) const
+    {
+        return dVector3(*this)/m;
+    }
+    double operator*(const dVector3& rhs) const
+    {
+        return dVector3(*this)*rhs;
+    }
+
+    double abs(void) const
+    {
+        return dVector3(*this).abs();
+    }
+    double length(void) const
+    {
+        return abs();
+    }
+    dVector3 normalized(void) const
+    {
+        return dVector3(*this).normalized();
+    }
+    dVector3 cross(const dVector3& rhs) const
+    {
+        return dVector3(*this).cross(rhs);
+    }
+    dMatrix3x3 dyadic(const dVector3& rhs) const
+    {
+        return dVector3(*this).dyadic(rhs);
+    }
+
+    constexpr size_t size(void) const
+    {
+        return 3u;
+    }
+
+ protected:
+ private:
+    float storage[3];
+};
+
+#ifdef SINGLE_PRECISION_PHASE_FIELDS
+typedef float    pf_real_t;                                                     ///< Storage type of the phase-field values and Laplacians
+typedef fVector3 pf_vector_t;                                                   ///< Storage type of the phase-field gradients
+#else
+typedef double   pf_real_t;
+typedef dVector3 pf_vector_t;
+#endif
+
+}// namespace openphase
+#endif
@@ -0,0 +1,217 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+/*
+ * Vector with inline storage for a small number of elements. Up to
+ * "InlineCapacity" elements are stored inside the object itself, only larger
+ * sizes are allocated from the NodeMemoryPool (which forwards to the global
+ * heap if the library is compiled without NODE_POOL). The element type has to
+ * be trivially copyable, elements are moved with memcpy.
+ * The default inline capacity of the node containers is set by
+ * OP_NODE_INLINE_CAPACITY, e.g. -DOP_NODE_INLINE_CAPACITY=6.
+ */
+
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "NodeAllocator.h"
+
+#ifndef OP_NODE_INLINE_CAPACITY
+#define OP_NODE_INLINE_CAPACITY 4                                               ///< Number of entries stored inline in NodeIP and NodeDF
+#endif
+
+namespace openphase
+{
+
+template<class T, size_t InlineCapacity>
+class SmallVector                                                               ///< Vector storing up to InlineCapacity elements without heap allocation
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SmallVector requires a trivially copyable element type");
+    static_assert(InlineCapacity > 0, "SmallVector requires a nonzero inline capacity");
+ public:
+    typedef T        value_type;
+    typedef T*       iterator;
+    typedef const T* const_iterator;
+
+    SmallVector() noexcept :
+        Data(InlineData()),
+        Size(0),
+        Capacity(InlineCapacity)
+    {
+
+    }
+    SmallVector(const SmallVector& other) : SmallVector()
+    {
+        *this = other;
+    }
+    SmallVector(SmallVector&& other) noexcept : SmallVector()
+    {
+        *this = std::move(other);
+    }
+    ~SmallVector()
+    {
+        Release();
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if(this != &other)
+        {
+            Size = 0;
+            reserve(other.Size);
+            std::memcpy(static_cast<void*>(Data), other.Data, other.Size*sizeof(T));
+            Size = other.Size;
+        }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& other) noexcept
+    {
+        if(this != &other)
+        {
+            if(other.on_heap())
+            {
+                Release();
+                Data     = other.Data;
+                Size     = other.Size;
+                Capacity = other.Capacity;
+                other.Data     = other.InlineData();
+                other.Capacity = InlineCapacity;
+            }
+            else
+            {
+                // Inline elements always fit into the destination
+                std::memcpy(static_cast<void*>(Data), other.Data, other.Size*sizeof(T));
+                Size = other.Size;
+            }
+            other.Size = 0;
+        }
+        return *this;
+    }
+
+    size_t size()     const {return Size;};                                     ///< Number of stored elements
+    size_t capacity() const {return Capacity;};                                 ///< Number of elements which can be stored without reallocation
+    bool   empty()    const {return Size == 0;};                                ///< True if no element is stored
+    bool   on_heap()  const {return Data != InlineData();};                     ///< True if the elements are stored outside of the inline buffer
+
+    iterator       begin()        {return Data;};
+    iterator       end()          {return Data + Size;};
+    const_iterator begin()  const {return Data;};
+    const_iterator end()    const {return Data + Size;};
+    const_iterator cbegin() const {return Data;};
+    const_iterator cend()   const {return Data + Size;};
+
+    T&       operator[](const size_t n)       {return Data[n];};
+    const T& operator[](const size_t n) const {return Data[n];};
+    T&       front()       {return Data[0];};
+    const T& front() const {return Data[0];};
+    T&       back()        {return Data[Size-1];};
+    const T& back()  const {return Data[Size-1];};
+    T*       data()        {return Data;};
+    const T* data()  const {return Data;};
+
+    void clear() {Size = 0;};                                                   ///< Removes all elements, keeps the capacity
+
+    void reserve(const size_t n)                                                ///< Ensures capacity for at least n elements
+    {
+        if(n > Capacity) Grow(n);
+    }
+    void resize(const size_t n)                                                 ///< Resizes the vector, new elements are default constructed
+    {
+        reserve(n);
+        for(size_t i = Size; i < n; i++)
+        {
+            new (Data + i) T();
+        }
+        Size = n;
+    }
+    void push_back(const T& value)                                              ///< Appends a copy of value
+    {
+        if(Size == Capacity)
+        {
+            const T copy = value; // value may refer to an element of this vector
+            Grow(2*Capacity);
+            Data[Size++] = copy;
+            return;
+        }
+        Data[Size++] = value;
+    }
+    void pop_back() {Size--;};                                                  ///< Removes the last element
+
+    iterator insert(const_iterator pos, const T& value)                         ///< Inserts a copy of value before pos, returns iterator to the new element
+    {
+        const size_t n = pos - Data;
+        const T copy = value;
+        if(Size == Capacity) Grow(2*Capacity);
+        std::memmove(static_cast<void*>(Data + n + 1), Data + n, (Size - n)*sizeof(T));
+        Data[n] = copy;
+        Size++;
+        return Data + n;
+    }
+    iterator erase(const_iterator pos)                                          ///< Removes the element at pos, returns iterator to the following element
+    {
+        const size_t n = pos - Data;
+        std::memmove(static_cast<void*>(Data + n), Data + n + 1, (Size - n - 1)*sizeof(T));
+        Size--;
+        return Data + n;
+    }
+
+ private:
+    T* Data;                                                                    ///< Points to the inline buffer or to the heap storage
+    unsigned int Size;                                                          ///< Number of stored elements
+    unsigned int Capacity;                                                      ///< Capacity of the current storage
+    alignas(T) unsigned char Inline[InlineCapacity*sizeof(T)];                  ///< Inline element storage
+
+    T* InlineData() {return reinterpret_cast<T*>(Inline);};
+    const T* InlineData() const {return reinterpret_cast<const T*>(Inline);};
+
+    void Grow(const size_t n)
+    {
+        T* newData = static_cast<T*>(NodeMemoryPool::Allocate(n*sizeof(T)));
+        std::memcpy(static_cast<void*>(newData), Data, Size*sizeof(T));
+        Release();
+        Data     = newData;
+        Capacity = n;
+    }
+    void Release()
+    {
+        if(on_heap())
+        {
+            NodeMemoryPool::Deallocate(Data, Capacity*sizeof(T));
+            Data     = InlineData();
+            Capacity = InlineCapacity;
+        }
+    }
+};
+
+}// namespace openphase
+#endif
@@ -67,9 +67,11 @@ protected:
 };
 
 struct SparseMatrixCSC;
+struct SparseMatrixCompressedRow;
 struct OP_EXPORTS SparseMatrixCSR: public SparseMatrix                                     ///< Compressed sparse row
 {
     friend SparseMatrixCSC;
+    friend SparseMatrixCompressedRow;
 
     SparseMatrixCSR(){};
     SparseMatrixCSR(const size_t n): SparseMatrix(n){};                         ///< Allocates n rows
@@ -152,15 +154,63 @@ struct OP_EXPORTS SparseMatrixCSC: public SparseMatrix
     void SwapRows(const size_t i, const size_t j);                              ///< Swaps rows i and j
 };
 
-// NOTE commented class because it does not work
-//class BiCGStab
-//{
-//public:
-//    typedef SparseMatrix Matrix;
-//    typedef std::vector<double> Vector;
-//
-//    static void BiCGstab_Jacobi(const Matrix& A, const Vector& b, Vector& x, const size_t l, const double TOL);
-//};
+struct OP_EXPORTS SparseMatrixCompressedRow                                     ///< Compressed sparse row matrix in three contiguous arrays
+{
+    /* SparseMatrixCSR keeps a separate entry vector per row, which is
+    convenient for assembling and pivoting but scatters the matrix over the
+    heap and needs a linear search for every element access. Once the
+    structure is final the matrix can be converted into this format: the
+    column indices and values of all rows are stored one after another
+    (sorted by column), RowStart[i] points to the first entry of row i. The
+    matrix-vector product streams through memory and is OpenMP parallel over
+    the rows, element access uses a binary search. The sparsity pattern is
+    fixed, only existing values can be changed. */
+    SparseMatrixCompressedRow(){};
+    explicit SparseMatrixCompressedRow(const SparseMatrixCSR& A){Assign(A);};   ///< Converts A
+
+    void Assign(const SparseMatrixCSR& A);                                      ///< Converts A, zero entries are dropped
+
+    double  operator()(const size_t i, const size_t j) const;                   ///< returns matrix element ij
+    template<class Vector> Vector operator*(const Vector& vector) const         ///< Multiplies matrix by vector
+    {
+        Vector tmp(size,0);
+        Multiply(vector, tmp);
+        return tmp;
+    }
+    template<class Vector> void Multiply(const Vector& vector, Vector& result) const///< result = A*vector
+    {
+        const size_t* locRowStart = RowStart.data();
+        const size_t* locColumn   = Column.data();
+        const double* locValue    = Value.data();
+
+        #pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < size; ++i)
+        {
+            double sum = 0.0;
+            #pragma omp simd reduction(+:sum)
+            for (size_t n = locRowStart[i]; n < locRowStart[i+1]; ++n)
+            {
+                sum += locValue[n]*vector[locColumn[n]];
+            }
+            result[i] = sum;
+        }
+    }
+
+    std::vector<double> Diagonal() const;                                       ///< Returns the diagonal elements
+    SparseMatrixCompressedRow transposed() const;                               ///< Returns Transposed Matrix
+    void DivideRowBy(size_t i, double scalar);                                  ///< Divides row i by scalar
+    size_t Rows() const {return size;};                                         ///< Number of rows
+    size_t NonZeros() const {return Value.size();};                             ///< Number of stored entries
+    const std::vector<size_t>& RowStarts() const {return RowStart;};            ///< First entry of each row
+    const std::vector<size_t>& Columns() const {return Column;};                ///< Column index of each entry
+    const std::vector<double>& Values() const {return Value;};                  ///< Value of each entry
+
+ protected:
+    size_t size = 0;                                                            ///< Number of rows
+    std::vector<size_t> RowStart;                                               ///< First entry of each row, RowStart[size] is the number of entries
+    std::vector<size_t> Column;                                                 ///< Column index of each entry
+    std::vector<double> Value;                                                  ///< Value of each entry
+};
 
 }// namespace openphase
 #endif
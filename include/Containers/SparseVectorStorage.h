@@ -0,0 +1,149 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef SPARSEVECTORSTORAGE_H
+#define SPARSEVECTORSTORAGE_H
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "dVector3.h"
+#include "NodeA.h"
+#include "Storage3D.h"
+
+namespace openphase
+{
+/* Packing of the vector entries for the halo exchange and the migration */
+template<>
+inline void NodeA<dVector3>::pack(std::vector<double>& buffer)
+{
+    buffer.push_back(Fields.size());
+    for(auto it = Fields.begin(); it != Fields.end();++it)
+    {
+        buffer.push_back(it->index);
+        buffer.push_back(it->value[0]);
+        buffer.push_back(it->value[1]);
+        buffer.push_back(it->value[2]);
+    }
+}
+template<>
+inline void NodeA<dVector3>::unpack(std::vector<double>& buffer, size_t& it)
+{
+    clear();
+    size_t size = buffer[it]; ++it;
+    Fields.resize(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        Fields[i].index    = buffer[it]; ++it;
+        Fields[i].value[0] = buffer[it]; ++it;
+        Fields[i].value[1] = buffer[it]; ++it;
+        Fields[i].value[2] = buffer[it]; ++it;
+    }
+}
+
+/********************************* Declaration *******************************/
+
+/* Node-sparse replacement of Storage3D<dVector3,1>: every cell keeps only the
+entries which have been written, keyed by their index (e.g. the thermodynamic
+phase). The indexed access of the dense storage is kept, Field(i,j,k,{n})
+returns a reference to the entry and inserts a zero entry if it is missing,
+the constant access returns zero for missing entries. Reading through a
+non-constant object inserts entries as well, reads of neighbouring cells in
+parallel loops therefore have to use get() or a constant reference. Cells
+hold only a few entries, the lookup is a short linear search. */
+
+class SparseVectorStorage : public Storage3D<NodeA<dVector3>,0>                 ///< Storage of dVector3 values per index, only present entries are stored
+{
+ public:
+    using Storage3D<NodeA<dVector3>,0>::operator();
+    using Storage3D<NodeA<dVector3>,0>::Allocate;
+
+    void Allocate(const GridParameters& Dimensions,
+                  const std::array<size_t,1> Size, const size_t Bcells)        ///< Same signature as the dense storage, the number of indices is not needed
+    {
+        (void) Size; //unused
+        Storage3D<NodeA<dVector3>,0>::Allocate(Dimensions, Bcells);
+    }
+
+    dVector3& operator()(const long int x, const long int y, const long int z,
+                         const std::array<size_t,1> Position);                 ///< Reference to the entry, inserts a zero entry if missing
+    const dVector3& operator()(const long int x, const long int y, const long int z,
+                               const std::array<size_t,1> Position) const;     ///< Entry value, zero if missing
+    const dVector3& get(const long int x, const long int y, const long int z,
+                        const size_t n) const                                   ///< Entry value, zero if missing. Never inserts
+    {
+        return (*this)(x, y, z, {n});
+    }
+    void erase_absent(const long int x, const long int y, const long int z,
+                      const std::vector<size_t>& Present);                      ///< Removes the entries whose index is not listed in Present
+};
+
+/******************************* Implementation ******************************/
+
+inline dVector3& SparseVectorStorage::operator()(const long int x, const long int y,
+        const long int z, const std::array<size_t,1> Position)
+{
+    NodeA<dVector3>& locNode = Storage3D<NodeA<dVector3>,0>::operator()(x, y, z);
+    for(auto it = locNode.begin(); it != locNode.end(); ++it)
+    {
+        if(it->index == Position[0]) return it->value;
+    }
+    locNode.set_value(Position[0], dVector3::ZeroVector());
+    return (locNode.end() - 1)->value;
+}
+
+inline const dVector3& SparseVectorStorage::operator()(const long int x, const long int y,
+        const long int z, const std::array<size_t,1> Position) const
+{
+    static const dVector3 Zero = dVector3::ZeroVector();
+    const NodeA<dVector3>& locNode = Storage3D<NodeA<dVector3>,0>::operator()(x, y, z);
+    for(auto it = locNode.cbegin(); it != locNode.cend(); ++it)
+    {
+        if(it->index == Position[0]) return it->value;
+    }
+    return Zero;
+}
+
+inline void SparseVectorStorage::erase_absent(const long int x, const long int y,
+        const long int z, const std::vector<size_t>& Present)
+{
+    NodeA<dVector3>& locNode = Storage3D<NodeA<dVector3>,0>::operator()(x, y, z);
+    for(auto it = locNode.begin(); it != locNode.end(); )
+    {
+        if(std::find(Present.begin(), Present.end(), it->index) == Present.end())
+        {
+            it = locNode.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+}//namespace openphase
+#endif
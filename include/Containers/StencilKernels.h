@@ -0,0 +1,435 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+/*
+ * Vectorized stencil kernels for scalar (double) storages. The kernels process
+ * the grid in contiguous z-rows: for every stencil element the offset into the
+ * storage is computed once, and the row update is a unit stride loop which the
+ * compiler turns into SIMD instructions (#pragma omp simd). The rows of
+ * different (x,y) positions are distributed over the OpenMP threads.
+ */
+
+#ifndef STENCILKERNELS_H
+#define STENCILKERNELS_H
+
+#include <array>
+#include <vector>
+
+#include "Globals.h"
+#include "Storage3D.h"
+#include "LaplacianStencil.h"
+#include "GradientStencil.h"
+#include "FixedStencils.h"
+#include "dVector3.h"
+
+namespace openphase
+{
+
+class StencilKernels                                                            ///< Row-wise vectorized Laplacian and gradient kernels
+{
+ public:
+    static void Laplacian(const Storage3D<double,0>& Field,
+                          const LaplacianStencil& LStencil,
+                          Storage3D<double,0>& Result,
+                          const long int bcells = 0);                           ///< Result = Laplacian of Field in the interior plus "bcells" boundary cells
+
+    static void Laplacian(const Storage3D<double,0>& Field,
+                          const LaplacianStencil& LStencil,
+                          Storage3D<double,0>& Result,
+                          const Storage3D<double,0>& Mask,
+                          const long int bcells = 0);                           ///< Same as above, but only cells with nonzero Mask are updated
+
+    static void Gradient(const Storage3D<double,0>& Field,
+                         const GradientStencil& GStencil,
+                         Storage3D<dVector3,0>& Result,
+                         const long int bcells = 0);                            ///< Result = gradient of Field in the interior plus "bcells" boundary cells
+
+    template<class Stencil>
+    static void Laplacian(const Storage3D<double,0>& Field,
+                          Storage3D<double,0>& Result,
+                          const double dx,
+                          const long int bcells = 0);                           ///< Same as above with a FixedLaplacianStencil and grid spacing dx
+
+    template<class Stencil>
+    static void Laplacian(const Storage3D<double,0>& Field,
+                          Storage3D<double,0>& Result,
+                          const Storage3D<double,0>& Mask,
+                          const double dx,
+                          const long int bcells = 0);                           ///< Same as above with a FixedLaplacianStencil and grid spacing dx
+
+    template<class Stencil>
+    static void Gradient(const Storage3D<double,0>& Field,
+                         Storage3D<dVector3,0>& Result,
+                         const double dx,
+                         const long int bcells = 0);                            ///< Same as above with a FixedGradientStencil and grid spacing dx
+
+ private:
+    struct RowRange                                                             ///< Loop bounds of the row-wise kernels
+    {
+        long int lowerX;
+        long int upperX;
+        long int lowerY;
+        long int upperY;
+        long int lowerZ;
+        long int upperZ;
+    };
+
+    template<class T>
+    static RowRange Range(const Storage3D<T,0>& Field, const long int bcells)  ///< Same loop bounds as in STORAGE_LOOP_BEGIN
+    {
+        RowRange range;
+        range.lowerX = -std::min(Field.BcellsX(), bcells);
+        range.lowerY = -std::min(Field.BcellsY(), bcells);
+        range.lowerZ = -std::min(Field.BcellsZ(), bcells);
+        range.upperX = Field.sizeX() + std::min(Field.BcellsX(), bcells);
+        range.upperY = Field.sizeY() + std::min(Field.BcellsY(), bcells);
+        range.upperZ = Field.sizeZ() + std::min(Field.BcellsZ(), bcells);
+        return range;
+    }
+
+    template<class Stencil>
+    static std::vector<long int> Offsets(const Storage3D<double,0>& Field,
+                                         const Stencil& locStencil)             ///< Linear storage offsets of the stencil elements
+    {
+        std::vector<long int> offsets;
+        offsets.reserve(locStencil.size());
+        const double* center = &Field(0,0,0);
+        for(auto st = locStencil.cbegin(); st != locStencil.cend(); ++st)
+        {
+            offsets.push_back(&Field(st->di, st->dj, st->dk) - center);
+        }
+        return offsets;
+    }
+
+    template<class Stencil>
+    static std::array<long int, Stencil::Size> FixedOffsets(
+                                         const Storage3D<double,0>& Field)      ///< Linear storage offsets of the fixed stencil elements
+    {
+        std::array<long int, Stencil::Size> offsets{};
+        const double* center = &Field(0,0,0);
+        Stencil::ForEach([&](const typename Stencil::Entry& st, const size_t n)
+        {
+            offsets[n] = &Field(st.di, st.dj, st.dk) - center;
+        });
+        return offsets;
+    }
+};
+
+inline void StencilKernels::Laplacian(const Storage3D<double,0>& Field,
+                                      const LaplacianStencil& LStencil,
+                                      Storage3D<double,0>& Result,
+                                      const long int bcells)
+{
+    const RowRange range = Range(Result, bcells);
+    const std::vector<long int> offsets = Offsets(Field, LStencil);
+    std::vector<double> weights;
+    for(auto ls = LStencil.cbegin(); ls != LStencil.cend(); ++ls)
+    {
+        weights.push_back(ls->weight);
+    }
+    const size_t nElements = weights.size();
+    const long int nz = range.upperZ - range.lowerZ;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for(long int i = range.lowerX; i < range.upperX; ++i)
+    for(long int j = range.lowerY; j < range.upperY; ++j)
+    {
+        const double* src = &Field(i, j, range.lowerZ);
+        double* dst = &Result(i, j, range.lowerZ);
+
+        #pragma omp simd
+        for(long int k = 0; k < nz; ++k)
+        {
+            dst[k] = 0.0;
+        }
+        for(size_t n = 0; n < nElements; ++n)
+        {
+            const double  weight = weights[n];
+            const double* locSrc = src + offsets[n];
+
+            #pragma omp simd
+            for(long int k = 0; k < nz; ++k)
+            {
+                dst[k] += weight*locSrc[k];
+            }
+        }
+    }
+}
+
+inline void StencilKernels::Laplacian(const Storage3D<double,0>& Field,
+                                      const LaplacianStencil& LStencil,
+                                      Storage3D<double,0>& Result,
+                                      const Storage3D<double,0>& Mask,
+                                      const long int bcells)
+{
+    const RowRange range = Range(Result, bcells);
+    const std::vector<long int> offsets = Offsets(Field, LStencil);
+    std::vector<double> weights;
+    for(auto ls = LStencil.cbegin(); ls != LStencil.cend(); ++ls)
+    {
+        weights.push_back(ls->weight);
+    }
+    const size_t nElements = weights.size();
+    const long int nz = range.upperZ - range.lowerZ;
+
+    #pragma omp parallel
+    {
+        std::vector<double> row(nz);
+        double* buffer = row.data();
+
+        #pragma omp for collapse(2) schedule(static)
+        for(long int i = range.lowerX; i < range.upperX; ++i)
+        for(long int j = range.lowerY; j < range.upperY; ++j)
+        {
+            const double* src  = &Field(i, j, range.lowerZ);
+            const double* mask = &Mask(i, j, range.lowerZ);
+            double* dst = &Result(i, j, range.lowerZ);
+
+            #pragma omp simd
+            for(long int k = 0; k < nz; ++k)
+            {
+                buffer[k] = 0.0;
+            }
+            for(size_t n = 0; n < nElements; ++n)
+            {
+                const double  weight = weights[n];
+                const double* locSrc = src + offsets[n];
+
+                #pragma omp simd
+                for(long int k = 0; k < nz; ++k)
+                {
+                    buffer[k] += weight*locSrc[k];
+                }
+            }
+            #pragma omp simd
+            for(long int k = 0; k < nz; ++k)
+            {
+                dst[k] = (mask[k] != 0.0) ? buffer[k] : dst[k];
+            }
+        }
+    }
+}
+
+inline void StencilKernels::Gradient(const Storage3D<double,0>& Field,
+                                     const GradientStencil& GStencil,
+                                     Storage3D<dVector3,0>& Result,
+                                     const long int bcells)
+{
+    const RowRange range = Range(Result, bcells);
+    const std::vector<long int> offsets = Offsets(Field, GStencil);
+    std::vector<double> weightsX;
+    std::vector<double> weightsY;
+    std::vector<double> weightsZ;
+    for(auto gs = GStencil.cbegin(); gs != GStencil.cend(); ++gs)
+    {
+        weightsX.push_back(gs->weightX);
+        weightsY.push_back(gs->weightY);
+        weightsZ.push_back(gs->weightZ);
+    }
+    const size_t nElements = weightsX.size();
+    const long int nz = range.upperZ - range.lowerZ;
+
+    #pragma omp parallel
+    {
+        std::vector<double> rowX(nz);
+        std::vector<double> rowY(nz);
+        std::vector<double> rowZ(nz);
+        double* bufferX = rowX.data();
+        double* bufferY = rowY.data();
+        double* bufferZ = rowZ.data();
+
+        #pragma omp for collapse(2) schedule(static)
+        for(long int i = range.lowerX; i < range.upperX; ++i)
+        for(long int j = range.lowerY; j < range.upperY; ++j)
+        {
+            const double* src = &Field(i, j, range.lowerZ);
+
+            #pragma omp simd
+            for(long int k = 0; k < nz; ++k)
+            {
+                bufferX[k] = 0.0;
+                bufferY[k] = 0.0;
+                bufferZ[k] = 0.0;
+            }
+            for(size_t n = 0; n < nElements; ++n)
+            {
+                const double  wX = weightsX[n];
+                const double  wY = weightsY[n];
+                const double  wZ = weightsZ[n];
+                const double* locSrc = src + offsets[n];
+
+                #pragma omp simd
+                for(long int k = 0; k < nz; ++k)
+                {
+                    bufferX[k] += wX*locSrc[k];
+                    bufferY[k] += wY*locSrc[k];
+                    bufferZ[k] += wZ*locSrc[k];
+                }
+            }
+            for(long int k = 0; k < nz; ++k)
+            {
+                Result(i, j, range.lowerZ + k) = dVector3{bufferX[k], bufferY[k], bufferZ[k]};
+            }
+        }
+    }
+}
+
+/* The fixed stencil kernels accumulate all stencil elements of a cell in a
+register, the unrolled element loop contains the weights as constants. The
+grid spacing is applied once to the sum. The row pointers of the stencil
+elements are set up once per row.*/
+
+template<class Stencil>
+inline void StencilKernels::Laplacian(const Storage3D<double,0>& Field,
+                                      Storage3D<double,0>& Result,
+                                      const double dx,
+                                      const long int bcells)
+{
+    const RowRange range = Range(Result, bcells);
+    const std::array<long int, Stencil::Size> offsets = FixedOffsets<Stencil>(Field);
+    const double scale = 1.0/(dx*dx);
+    const long int nz = range.upperZ - range.lowerZ;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for(long int i = range.lowerX; i < range.upperX; ++i)
+    for(long int j = range.lowerY; j < range.upperY; ++j)
+    {
+        const double* src = &Field(i, j, range.lowerZ);
+        double* dst = &Result(i, j, range.lowerZ);
+        std::array<const double*, Stencil::Size> rows;
+        for(size_t n = 0; n < Stencil::Size; ++n)
+        {
+            rows[n] = src + offsets[n];
+        }
+
+        #pragma omp simd
+        for(long int k = 0; k < nz; ++k)
+        {
+            double sum = 0.0;
+            Stencil::ForEach([&](const typename Stencil::Entry& st, const size_t n)
+            {
+                sum += st.weight*rows[n][k];
+            });
+            dst[k] = scale*sum;
+        }
+    }
+}
+
+template<class Stencil>
+inline void StencilKernels::Laplacian(const Storage3D<double,0>& Field,
+                                      Storage3D<double,0>& Result,
+                                      const Storage3D<double,0>& Mask,
+                                      const double dx,
+                                      const long int bcells)
+{
+    const RowRange range = Range(Result, bcells);
+    const std::array<long int, Stencil::Size> offsets = FixedOffsets<Stencil>(Field);
+    const double scale = 1.0/(dx*dx);
+    const long int nz = range.upperZ - range.lowerZ;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for(long int i = range.lowerX; i < range.upperX; ++i)
+    for(long int j = range.lowerY; j < range.upperY; ++j)
+    {
+        const double* src  = &Field(i, j, range.lowerZ);
+        const double* mask = &Mask(i, j, range.lowerZ);
+        double* dst = &Result(i, j, range.lowerZ);
+        std::array<const double*, Stencil::Size> rows;
+        for(size_t n = 0; n < Stencil::Size; ++n)
+        {
+            rows[n] = src + offsets[n];
+        }
+
+        #pragma omp simd
+        for(long int k = 0; k < nz; ++k)
+        {
+            double sum = 0.0;
+            Stencil::ForEach([&](const typename Stencil::Entry& st, const size_t n)
+            {
+                sum += st.weight*rows[n][k];
+            });
+            dst[k] = (mask[k] != 0.0) ? scale*sum : dst[k];
+        }
+    }
+}
+
+template<class Stencil>
+inline void StencilKernels::Gradient(const Storage3D<double,0>& Field,
+                                     Storage3D<dVector3,0>& Result,
+                                     const double dx,
+                                     const long int bcells)
+{
+    const RowRange range = Range(Result, bcells);
+    const std::array<long int, Stencil::Size> offsets = FixedOffsets<Stencil>(Field);
+    const double scale = 1.0/dx;
+    const long int nz = range.upperZ - range.lowerZ;
+
+    #pragma omp parallel
+    {
+        std::vector<double> rowX(nz);
+        std::vector<double> rowY(nz);
+        std::vector<double> rowZ(nz);
+        double* bufferX = rowX.data();
+        double* bufferY = rowY.data();
+        double* bufferZ = rowZ.data();
+
+        #pragma omp for collapse(2) schedule(static)
+        for(long int i = range.lowerX; i < range.upperX; ++i)
+        for(long int j = range.lowerY; j < range.upperY; ++j)
+        {
+            const double* src = &Field(i, j, range.lowerZ);
+            std::array<const double*, Stencil::Size> rows;
+            for(size_t n = 0; n < Stencil::Size; ++n)
+            {
+                rows[n] = src + offsets[n];
+            }
+
+            #pragma omp simd
+            for(long int k = 0; k < nz; ++k)
+            {
+                double sumX = 0.0;
+                double sumY = 0.0;
+                double sumZ = 0.0;
+                Stencil::ForEach([&](const typename Stencil::Entry& st, const size_t n)
+                {
+                    sumX += st.weightX*rows[n][k];
+                    sumY += st.weightY*rows[n][k];
+                    sumZ += st.weightZ*rows[n][k];
+                });
+                bufferX[k] = scale*sumX;
+                bufferY[k] = scale*sumY;
+                bufferZ[k] = scale*sumZ;
+            }
+            for(long int k = 0; k < nz; ++k)
+            {
+                Result(i, j, range.lowerZ + k) = dVector3{bufferX[k], bufferY[k], bufferZ[k]};
+            }
+        }
+    }
+}
+
+}// namespace openphase
+#endif
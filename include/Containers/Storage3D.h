@@ -39,6 +39,8 @@
 #include <vector>
 
 #include "Macros.h"
+#include "AlignedAllocator.h"
+#include "MemorySpace.h"
 #include "Tensor.h"
 #include "GridParameters.h"
 #include "TypeTraits.h"
@@ -136,7 +138,7 @@ template <typename A, typename T>
 class PackCallerTensor3D<A, T, typename std::enable_if<!std::is_class<T>::value && std::is_standard_layout<T>::value && std::is_trivial<T>::value>::type>
 {
  public:
-    static T pack(A& self, std::vector<double>& buffer, std::vector<long int> window)
+    static T pack(A& self, std::vector<double>& buffer, const std::vector<long int>& window)
     {
         buffer.clear();
         for (long int i = window[0]; i < window[1]; ++i)
@@ -150,7 +152,7 @@ class PackCallerTensor3D<A, T, typename std::enable_if<!std::is_class<T>::value
         }
         return T();
     }
-    static T unpack(A& self, std::vector<double>& buffer, std::vector<long int> window)
+    static T unpack(A& self, std::vector<double>& buffer, const std::vector<long int>& window)
     {
         size_t it = 0;
         for (long int i = window[0]; i < window[1]; ++i)
@@ -170,7 +172,7 @@ template <typename A, typename T>
 class PackCallerTensor3D<A, T, typename std::enable_if<std::is_class<T>::value && has_pack<T>::value>::type>
 {
  public:
-    static T pack(A& self, std::vector<double>& buffer, std::vector<long int> window)
+    static T pack(A& self, std::vector<double>& buffer, const std::vector<long int>& window)
     {
         buffer.clear();
         for (long int i = window[0]; i < window[1]; ++i)
@@ -184,7 +186,7 @@ class PackCallerTensor3D<A, T, typename std::enable_if<std::is_class<T>::value &
         }
         return T();
     }
-    static T unpack(A& self, std::vector<double>& buffer, std::vector<long int> window)
+    static T unpack(A& self, std::vector<double>& buffer, const std::vector<long int>& window)
     {
         size_t  it = 0;
         for (long int i = window[0]; i < window[1]; ++i)
@@ -216,7 +218,7 @@ template <typename A, typename T>
 class PackCaller3D<A, T, typename std::enable_if<!std::is_class<T>::value && std::is_standard_layout<T>::value && std::is_trivial<T>::value>::type>
 {
  public:
-    static T pack(A& self, std::vector<double>& buffer, std::vector<long int> window)
+    static T pack(A& self, std::vector<double>& buffer, const std::vector<long int>& window)
     {
         buffer.clear();
         for (long int i = window[0]; i < window[1]; ++i)
@@ -227,7 +229,7 @@ class PackCaller3D<A, T, typename std::enable_if<!std::is_class<T>::value && std
         }
         return T();
     }
-    static T unpack(A& self, std::vector<double>& buffer, std::vector<long int> window)
+    static T unpack(A& self, std::vector<double>& buffer, const std::vector<long int>& window)
     {
         size_t it = 0;
         for (long int i = window[0]; i < window[1]; ++i)
@@ -244,7 +246,7 @@ template <typename A, typename T>
 class PackCaller3D<A, T, typename std::enable_if<std::is_class<T>::value && has_pack<T>::value>::type>
 {
  public:
-    static T pack(A& self, std::vector<double>& buffer, std::vector<long int> window)
+    static T pack(A& self, std::vector<double>& buffer, const std::vector<long int>& window)
     {
         buffer.clear();
         for (long int i = window[0]; i < window[1]; ++i)
@@ -255,7 +257,7 @@ class PackCaller3D<A, T, typename std::enable_if<std::is_class<T>::value && has_
         }
         return T();
     }
-    static T unpack(A& self, std::vector<double>& buffer, std::vector<long int> window)
+    static T unpack(A& self, std::vector<double>& buffer, const std::vector<long int>& window)
     {
         size_t  it = 0;
         for (long int i = window[0]; i < window[1]; ++i)
@@ -281,12 +283,12 @@ class PackCaller3D<A, T, typename std::enable_if<std::is_class<T>::value && !has
     }
 };
 
-template <class T, size_t Rank>
+template <class T, size_t Rank, class Space = HostSpace>
 class Storage3D                                                                 /// 3D storage template class of vector values. Can handle any type of values
 {
  public:
-    friend class ClearCaller3D< Storage3D<T, Rank> , T>;
-    friend class PackCallerTensor3D< Storage3D<T, Rank> , T>;
+    friend class ClearCaller3D< Storage3D<T,Rank,Space> , T>;
+    friend class PackCallerTensor3D< Storage3D<T,Rank,Space> , T>;
     Storage3D()
     {
         DX = 0;
@@ -312,6 +314,7 @@ class Storage3D
         Size_Z_BC = 0;
         Size_D    = 0;
 
+        Origin = 0;
         locTensors.resize(0);
         locData.resize(0);
     }
@@ -352,7 +355,8 @@ class Storage3D
             Size_D *= TensorDimensions[n];
         }
 
-        locData.resize(Size*Size_D);
+        Origin = 0;
+        ResizeStorage(locData, Size*Size_D);
 
         locTensors.resize(Size);
 
@@ -397,7 +401,8 @@ class Storage3D
             Size_D *= TensorDimensions[n];
         }
 
-        locData.resize(Size*Size_D);
+        Origin = 0;
+        ResizeStorage(locData, Size*Size_D);
         locTensors.resize(Size);
 
         for(size_t i = 0; i < Size; i++)
@@ -406,7 +411,7 @@ class Storage3D
         }
     }
 
-    Storage3D(const Storage3D<T,Rank>& Field)
+    Storage3D(const Storage3D<T,Rank,Space>& Field)
     {
         if (this != &Field)
         {
@@ -443,7 +448,8 @@ class Storage3D
                     Size_D *= TensorDimensions[n];
                 }
 
-                locData.resize(Size*Size_D);
+                Origin = 0;
+                ResizeStorage(locData, Size*Size_D);
                 locTensors.resize(Size);
 
                 for(size_t i = 0; i < Size; i++)
@@ -461,6 +467,7 @@ class Storage3D
             }
             else
             {
+                Origin = 0;
                 locData.resize(0);
                 locTensors.resize(0);
             }
@@ -469,14 +476,14 @@ class Storage3D
 
     Tensor<T, Rank>& operator()(const long int x, const long int y, const long int z)
     {
-        assert(Index(x,y,z) < size_t(Size_X_BC*Size_Y_BC*Size_Z_BC) && "Access beyond storage range");
+        assert(Index(x,y,z) < locTensors.size() && "Access beyond storage range");
         return locTensors[Index(x,y,z)];
     }
 
     Tensor<T, Rank> const& operator()(const long int x, const long int y,
             const long int z) const
     {
-        assert(Index(x,y,z) < size_t(Size_X_BC*Size_Y_BC*Size_Z_BC) && "Access beyond storage range");
+        assert(Index(x,y,z) < locTensors.size() && "Access beyond storage range");
         return locTensors[Index(x,y,z)];
     }
 
@@ -523,13 +530,13 @@ class Storage3D
     Tensor<T, Rank>& operator[](const size_t idx)
     {
         assert(idx < size_t(Size_X_BC*Size_Y_BC*Size_Z_BC) && "Access beyond storage range");
-        return locTensors[idx];
+        return locTensors[Origin + idx];
     }
 
     Tensor<T, Rank>const& operator[](const size_t idx) const
     {
         assert(idx < size_t(Size_X_BC*Size_Y_BC*Size_Z_BC) && "Access beyond storage range");
-        return locTensors[idx];
+        return locTensors[Origin + idx];
     }
 
     void Allocate(const long int nx, const long int ny, const long int nz,
@@ -568,7 +575,8 @@ class Storage3D
             Size_D *= TensorDimensions[n];
         }
 
-        locData.resize(Size*Size_D);
+        Origin = 0;
+        ResizeStorage(locData, Size*Size_D);
         locTensors.resize(Size);
 
         for(size_t i = 0; i < Size; i++)
@@ -620,7 +628,8 @@ class Storage3D
             Size_D *= TensorDimensions[n];
         }
 
-        locData.resize(Size*Size_D);
+        Origin = 0;
+        ResizeStorage(locData, Size*Size_D);
         locTensors.resize(Size);
 
         for(size_t i = 0; i < Size; i++)
@@ -629,7 +638,7 @@ class Storage3D
         }
     }
 
-    void Allocate(const Storage3D<T,Rank>& Field)
+    void Allocate(const Storage3D<T,Rank,Space>& Field)
     {
         if(locTensors.size() != 0)
         {
@@ -675,7 +684,8 @@ class Storage3D
                     Size_D *= TensorDimensions[n];
                 }
 
-                locData.resize(Size*Size_D);
+                Origin = 0;
+                ResizeStorage(locData, Size*Size_D);
                 locTensors.resize(Size);
 
                 for(size_t i = 0; i < Size; i++)
@@ -686,7 +696,7 @@ class Storage3D
         }
     }
 
-    void AllocateCopy(const Storage3D<T,Rank>& Field)
+    void AllocateCopy(const Storage3D<T,Rank,Space>& Field)
     {
         if(locTensors.size() != 0)
         {
@@ -733,7 +743,8 @@ class Storage3D
                     Size_D *= TensorDimensions[n];
                 }
 
-                locData.resize(Size*Size_D);
+                Origin = 0;
+                ResizeStorage(locData, Size*Size_D);
                 locTensors.resize(Size);
 
                 for(size_t i = 0; i < Size; i++)
@@ -752,7 +763,7 @@ class Storage3D
         }
     }
 
-    Storage3D<T,Rank>& operator=(const Storage3D<T,Rank>& Field)
+    Storage3D<T,Rank,Space>& operator=(const Storage3D<T,Rank,Space>& Field)
     {
         if (this != &Field)
         {
@@ -789,7 +800,8 @@ class Storage3D
                     Size_D *= TensorDimensions[n];
                 }
 
-                locData.resize(Size*Size_D);
+                Origin = 0;
+                ResizeStorage(locData, Size*Size_D);
                 locTensors.resize(Size);
 
                 for(size_t i = 0; i < Size; i++)
@@ -831,7 +843,8 @@ class Storage3D
         locTensors.clear();
         locTensors.resize(Size);
         locData.clear();
-        locData.resize(Size*Size_D);
+        Origin = 0;
+        ResizeStorage(locData, Size*Size_D);
 
         for(size_t i = 0; i < Size; i++)
         {
@@ -862,9 +875,11 @@ class Storage3D
 
         size_t new_size = (nx + 2*b_cells*DX)*(ny + 2*b_cells*DY)*(nz + 2*b_cells*DZ);
 
-        std::vector<T> tempData(new_size*Size_D);
+        DataVector tempData;
+        ResizeStorage(tempData, new_size*Size_D);
         std::vector<Tensor<T, Rank>> tempTensors(new_size);
 
+        #pragma omp parallel for schedule(static)
         for(size_t i = 0; i < new_size; i++)
         {
             tempTensors[i].Assign(&tempData[i*Size_D],TensorDimensions);
@@ -908,15 +923,76 @@ class Storage3D
         Size_Y_BC = Size_Y + 2*b_cells*DY;
         Size_Z_BC = Size_Z + 2*b_cells*DZ;
 
-        locTensors.clear();
-        locTensors.resize(new_size);
+        /* Moving keeps the data buffer, the tensors stay assigned to it */
+        Origin = 0;
+        locData    = std::move(tempData);
+        locTensors = std::move(tempTensors);
+    }
+
+    void Shift(const long int dx, const long int dy, const long int dz,
+               const size_t Reserve = 16)                                       ///< Moves the content by (dx,dy,dz) cells: (x,y,z) takes the value of (x+dx,y+dy,z+dz), boundary cells keep their values
+    {
+        /* Instead of copying the cells, the window of the storage within the
+        data buffer is moved by the linear offset of (dx,dy,dz). Only the
+        boundary cells are saved and restored. The buffer holds slack for
+        Reserve such moves, once it is used up the window is moved back to the
+        opposite end of the buffer. */
+        if(std::abs(dx*DX) > b_cells or std::abs(dy*DY) > b_cells or std::abs(dz*DZ) > b_cells)
+        {
+            std::cerr << "ERROR: Storage3D<" << typeid(T).name() << ", " <<  Rank
+                      << ">::Shift(): Shift exceeds the number of boundary cells!\n"
+                      << "Terminating!!!\n";
+            OP_Exit(EXIT_FAILURE);
+        }
+        const long int Step = ((dx*DX)*Size_Y_BC + dy*DY)*Size_Z_BC + dz*DZ;
+        if(Step == 0 or locTensors.size() == 0) return;
 
-        locData = tempData;
+        std::vector<T> Boundary;
+        BoundaryCellsLoop([&](const size_t idx)
+        {
+            Boundary.insert(Boundary.end(), &locData[idx*Size_D], &locData[idx*Size_D] + Size_D);
+        });
 
-        for(size_t i = 0; i < new_size; i++)
+        const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
+        const long int NewOrigin = long(Origin) + Step;
+        if(NewOrigin < 0 or NewOrigin + Size > locTensors.size())
         {
-            locTensors[i].Assign(&locData[i*Size_D],TensorDimensions);
+            const size_t Capacity = std::max(locTensors.size(), Size + std::max(Reserve, size_t(1))*std::abs(Step));
+            const size_t Target = (Step > 0) ? 0 : Capacity - Size;
+            if(Capacity != locTensors.size())
+            {
+                DataVector tempData;
+                ResizeStorage(tempData, Capacity*Size_D);
+                std::vector<Tensor<T, Rank>> tempTensors(Capacity);
+                for(size_t i = 0; i < Capacity; i++)
+                {
+                    tempTensors[i].Assign(&tempData[i*Size_D],TensorDimensions);
+                }
+                std::move(locData.begin() + Origin*Size_D, locData.begin() + (Origin + Size)*Size_D,
+                          tempData.begin() + Target*Size_D);
+                locData    = std::move(tempData);
+                locTensors = std::move(tempTensors);
+            }
+            else if(Target < Origin)
+            {
+                std::move(locData.begin() + Origin*Size_D, locData.begin() + (Origin + Size)*Size_D,
+                          locData.begin() + Target*Size_D);
+            }
+            else
+            {
+                std::move_backward(locData.begin() + Origin*Size_D, locData.begin() + (Origin + Size)*Size_D,
+                                   locData.begin() + (Target + Size)*Size_D);
+            }
+            Origin = Target;
         }
+        Origin += Step;
+
+        auto it = Boundary.begin();
+        BoundaryCellsLoop([&](const size_t idx)
+        {
+            std::move(it, it + Size_D, &locData[idx*Size_D]);
+            it += Size_D;
+        });
     }
 
     ~Storage3D()
@@ -933,23 +1009,52 @@ class Storage3D
         else return locData;
     }
 
+    typedef Space MemorySpace;                                                  ///< Memory space of the storage data
+
+    void sync_to_device(void)                                                   ///< Makes the device copy current (no-op for host memory spaces)
+    {
+        Mirror.ToDevice(locData.data(), locData.size());
+    }
+    void sync_to_host(void)                                                     ///< Makes the host copy current (no-op for host memory spaces)
+    {
+        Mirror.ToHost(locData.data(), locData.size());
+    }
+    void mark_host_modified(void)                                               ///< To be called after writing the data on the host
+    {
+        Mirror.MarkHostModified();
+    }
+    void mark_device_modified(void)                                             ///< To be called after writing the data on the device
+    {
+        Mirror.MarkDeviceModified();
+    }
+    MemoryStates memory_state(void) const                                       ///< Dirty state of the host and device copies
+    {
+        return Mirror.GetState();
+    }
+
     void Clear(void)
     {
-        ClearCaller3D< Storage3D<T, Rank>, T> K;
+        ClearCaller3D< Storage3D<T,Rank,Space>, T> K;
         K.call(*this);
     }
 
-    std::vector<double> pack(std::vector<long int> window)
+    std::vector<double> pack(const std::vector<long int>& window)
     {
         std::vector<double> buffer;
-        PackCallerTensor3D< Storage3D<T,Rank>, T> K;
+        PackCallerTensor3D< Storage3D<T,Rank,Space>, T> K;
         K.pack(*this, buffer, window);
         return buffer;
     }
 
-    void unpack(std::vector<double>& buffer, std::vector<long int> window)
+    void pack(std::vector<double>& buffer, const std::vector<long int>& window)///< Packs into an existing buffer, reusing its capacity
+    {
+        PackCallerTensor3D< Storage3D<T,Rank,Space>, T> K;
+        K.pack(*this, buffer, window);
+    }
+
+    void unpack(std::vector<double>& buffer, const std::vector<long int>& window)
     {
-        PackCallerTensor3D< Storage3D<T,Rank>, T> K;
+        PackCallerTensor3D< Storage3D<T,Rank,Space>, T> K;
         K.unpack(*this, buffer, window);
     }
 
@@ -963,7 +1068,7 @@ class Storage3D
         window[3] = Size_Y;
         window[4] = 0;
         window[5] = Size_Z;
-        PackCallerTensor3D< Storage3D<T,Rank>, T> K;
+        PackCallerTensor3D< Storage3D<T,Rank,Space>, T> K;
         K.pack(*this, buffer, window);
         return buffer;
     }
@@ -976,7 +1081,7 @@ class Storage3D
         window[3] = Size_Y;
         window[4] = 0;
         window[5] = Size_Z;
-        PackCallerTensor3D< Storage3D<T,Rank>, T> K;
+        PackCallerTensor3D< Storage3D<T,Rank,Space>, T> K;
         K.unpack(*this, buffer, window);
     }
     void WriteToFile(std::string FileName)
@@ -995,7 +1100,7 @@ class Storage3D
             window[3] = j;
             window[4] = k;
             window[5] = k;
-            PackCallerTensor3D< Storage3D<T,Rank>, T> K;
+            PackCallerTensor3D< Storage3D<T,Rank,Space>, T> K;
             K.pack(*this, buffer, window);
             for (long int i = 0; i < buffer.size(); ++i)
             {
@@ -1020,7 +1125,7 @@ class Storage3D
                 const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
                 for(size_t idx = 0; idx < Size; idx++)
                 {
-                    locTensors[idx] = val;
+                    locTensors[Origin + idx] = val;
                 }
             }
             else
@@ -1095,6 +1200,11 @@ class Storage3D
         return DX + DY + DZ;
     }
 
+    const std::array<size_t, Rank>& Dimensions() const                          ///< Dimensions of the tensor stored in each cell
+    {
+        return TensorDimensions;
+    }
+
     bool InLimits(const long int x, const long int y, const long int z)
     {
         if (x < -b_cells*DX) return false;
@@ -1112,6 +1222,17 @@ class Storage3D
 
         Reallocate(Size_X, Size_Y, Size_Z);
     }
+
+    size_t AllocatedMemory() const                                              ///< Memory held by the storage in bytes, including dynamically allocated node entries
+    {
+        size_t bytes = locData.capacity()*sizeof(T) +
+                       locTensors.capacity()*sizeof(Tensor<T, Rank>);
+        if constexpr (has_allocated_memory<T>::value)
+        {
+            for(const T& value : locData) bytes += value.allocated_memory();
+        }
+        return bytes;
+    }
  protected:
     long int Size_X;
     long int Size_Y;
@@ -1136,9 +1257,13 @@ class Storage3D
     long int DY;
     long int DZ;
 
+    typedef typename Space::template Vector<T> DataVector;                      ///< Data vector type of the memory space
+
     std::array<size_t, Rank> TensorDimensions;
     std::vector<Tensor<T, Rank>> locTensors;
-    std::vector<T> locData;
+    DataVector locData;
+    MemoryMirror<T, Space> Mirror;                                              ///< Device copy of locData
+    size_t Origin;                                                              ///< Position of the first cell within the data buffer, moved by Shift()
 
  private:
     size_t Index(const long int x, const long int y, const long int z) const
@@ -1150,7 +1275,26 @@ class Storage3D
         assert(y >= - b_cells*DY && "Access beyond storage range");
         assert(z >= - b_cells*DZ && "Access beyond storage range");
 
-        return (((x + b_cells*DX)*Size_Y_BC + y + b_cells*DY)*Size_Z_BC + z + b_cells*DZ);
+        return Origin + (((x + b_cells*DX)*Size_Y_BC + y + b_cells*DY)*Size_Z_BC + z + b_cells*DZ);
+    }
+
+    template<class Function>
+    void BoundaryCellsLoop(Function&& Body) const                               ///< Calls Body(Index(x,y,z)) for all boundary cells in a fixed order
+    {
+        const long int bX = b_cells*DX;
+        const long int bY = b_cells*DY;
+        const long int bZ = b_cells*DZ;
+        for(long int x = -bX; x < Size_X + bX; x++)
+        for(long int y = -bY; y < Size_Y + bY; y++)
+        if(x < 0 or x >= Size_X or y < 0 or y >= Size_Y)
+        {
+            for(long int z = -bZ; z < Size_Z + bZ; z++) Body(Index(x,y,z));
+        }
+        else
+        {
+            for(long int z = -bZ; z < 0; z++) Body(Index(x,y,z));
+            for(long int z = Size_Z; z < Size_Z + bZ; z++) Body(Index(x,y,z));
+        }
     }
 
     size_t IndexT(const std::array<size_t,Rank> position) const
@@ -1173,12 +1317,12 @@ class Storage3D
     }
 };
 
-template <class T>
-class Storage3D<T,0>                                                            /// 3D storage template class specification for Rank == 0. Can handle any type of numerical values
+template <class T, class Space>
+class Storage3D<T,0,Space>                                                      /// 3D storage template class specification for Rank == 0. Can handle any type of numerical values
 {
  public:
-    friend class ClearCaller3D< Storage3D<T,0>, T>;
-    friend class PackCaller3D< Storage3D<T,0>, T>;
+    friend class ClearCaller3D< Storage3D<T,0,Space>, T>;
+    friend class PackCaller3D< Storage3D<T,0,Space>, T>;
 
     Storage3D()
     {
@@ -1203,9 +1347,11 @@ class Storage3D<T,0>
         Offset_X = 0;
         Offset_Y = 0;
         Offset_Z = 0;
+
+        Origin = 0;
     }
 
-    Storage3D(const Storage3D<T,0>& Field)
+    Storage3D(const Storage3D<T,0,Space>& Field)
     {
         if (this != &Field)
         {
@@ -1234,7 +1380,8 @@ class Storage3D<T,0>
                 Size_Z_BC = Size_Z + 2*b_cells*DZ;
                 const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
 
-                locData.resize(Size);
+                Origin = 0;
+                ResizeStorage(locData, Size);
 
                 OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Field,b_cells,)
                 {
@@ -1244,6 +1391,7 @@ class Storage3D<T,0>
             }
             else
             {
+                Origin = 0;
                 locData.resize(0);
             }
         }
@@ -1276,7 +1424,8 @@ class Storage3D<T,0>
         Size_Z_BC = Size_Z + 2*b_cells*DZ;
         size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
 
-        locData.resize(Size);
+        Origin = 0;
+        ResizeStorage(locData, Size);
     }
 
     Storage3D(const GridParameters Dimensions,
@@ -1305,10 +1454,11 @@ class Storage3D<T,0>
         Size_Z_BC = Size_Z + 2*b_cells*DZ;
         size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
 
-        locData.resize(Size);
+        Origin = 0;
+        ResizeStorage(locData, Size);
     }
 
-    void Allocate(const Storage3D<T,0>& Field)
+    void Allocate(const Storage3D<T,0,Space>& Field)
     {
         if(locData.size() != 0)
         {
@@ -1345,12 +1495,13 @@ class Storage3D<T,0>
                 Size_Z_BC = Size_Z + 2*b_cells*DZ;
                 const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
 
-                locData.resize(Size);
+                Origin = 0;
+                ResizeStorage(locData, Size);
             }
         }
     }
 
-    void AllocateCopy(const Storage3D<T,0>& Field)
+    void AllocateCopy(const Storage3D<T,0,Space>& Field)
     {
         if(locData.size() != 0)
         {
@@ -1387,7 +1538,8 @@ class Storage3D<T,0>
                 Size_Z_BC = Size_Z + 2*b_cells*DZ;
                 const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
 
-                locData.resize(Size);
+                Origin = 0;
+                ResizeStorage(locData, Size);
 
                 OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Field,b_cells,)
                 {
@@ -1397,6 +1549,7 @@ class Storage3D<T,0>
             }
             else
             {
+                Origin = 0;
                 locData.resize(0);
             }
         }
@@ -1404,13 +1557,13 @@ class Storage3D<T,0>
 
     T& operator()(const long int x, const long int y, const long int z)
     {
-        assert(Index(x,y,z) < size_t(Size_X_BC*Size_Y_BC*Size_Z_BC) && "Access beyond storage range");
+        assert(Index(x,y,z) < locData.size() && "Access beyond storage range");
         return locData[Index(x,y,z)];
     }
 
     T const& operator()(const long int x, const long int y, const long int z) const
     {
-        assert(Index(x,y,z) < size_t(Size_X_BC*Size_Y_BC*Size_Z_BC) && "Access beyond storage range");
+        assert(Index(x,y,z) < locData.size() && "Access beyond storage range");
         return locData[Index(x,y,z)];
     }
 
@@ -1441,13 +1594,13 @@ class Storage3D<T,0>
     T& operator[](size_t idx)
     {
         assert(idx < size_t(Size_X_BC*Size_Y_BC*Size_Z_BC) && "Access beyond storage range");
-        return locData[idx];
+        return locData[Origin + idx];
     }
 
     T const& operator[](const size_t idx) const
     {
         assert(idx < size_t(Size_X_BC*Size_Y_BC*Size_Z_BC) && "Access beyond storage range");
-        return locData[idx];
+        return locData[Origin + idx];
     }
 
     size_t Allocate(const long int nx, const long int ny, const long int nz,
@@ -1487,7 +1640,8 @@ class Storage3D<T,0>
         const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
         const size_t AllocatedMemory = sizeof(T)*Size;
 
-        locData.resize(Size);
+        Origin = 0;
+        ResizeStorage(locData, Size);
         return AllocatedMemory;
     }
 
@@ -1519,7 +1673,8 @@ class Storage3D<T,0>
         const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
         const size_t AllocatedMemory = sizeof(T)*Size;
 
-        locData.resize(Size);
+        Origin = 0;
+        ResizeStorage(locData, Size);
         return AllocatedMemory;
     }
 
@@ -1534,7 +1689,8 @@ class Storage3D<T,0>
         Size_Z_BC = Size_Z + 2*b_cells*DZ;
         const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
 
-        locData.resize(Size);
+        Origin = 0;
+        ResizeStorage(locData, Size);
     }
 
     bool IsNotAllocated() const
@@ -1563,7 +1719,8 @@ class Storage3D<T,0>
         long int ny = nY*DY + 1 - DY;
         long int nz = nZ*DZ + 1 - DZ;
 
-        std::vector<T> tempArray((nx + 2*b_cells*DX)*(ny + 2*b_cells*DY)*(nz + 2*b_cells*DZ));
+        DataVector tempArray;
+        ResizeStorage(tempArray, (nx + 2*b_cells*DX)*(ny + 2*b_cells*DY)*(nz + 2*b_cells*DZ));
 
         double Xscale = double(Size_X)/double(nx);
         double Yscale = double(Size_Y)/double(ny);
@@ -1582,19 +1739,18 @@ class Storage3D<T,0>
             double dy = (y*Yscale - y0)*DY;
             double dz = (z*Zscale - z0)*DZ;
 
-            T tmpData = locData[Index(x0,y0,z0)]*((1.0 - dx)*(1.0 - dy)*(1.0 - dz));
+            T& tmpData = tempArray[(((x + b_cells*DX)*(ny + 2*b_cells*DY) + y + b_cells*DY)*(nz + 2*b_cells*DZ) + z + b_cells*DZ)];
+            tmpData = locData[Index(x0,y0,z0)]*((1.0 - dx)*(1.0 - dy)*(1.0 - dz));
 
-            if(DX) tmpData += locData[Index(x0+1,y0,z0)]*(dx*(1.0- dy)*(1.0 - dz));
-            if(DY) tmpData += locData[Index(x0,y0+1,z0)]*((1.0 - dx)*dy*(1.0 - dz));
-            if(DZ) tmpData += locData[Index(x0,y0,z0+1)]*((1.0 - dx)*(1.0 - dy)*dz);
+            if(DX) AddWeighted(tmpData, locData[Index(x0+1,y0,z0)], dx*(1.0- dy)*(1.0 - dz));
+            if(DY) AddWeighted(tmpData, locData[Index(x0,y0+1,z0)], (1.0 - dx)*dy*(1.0 - dz));
+            if(DZ) AddWeighted(tmpData, locData[Index(x0,y0,z0+1)], (1.0 - dx)*(1.0 - dy)*dz);
 
-            if(DX and DY) tmpData += locData[Index(x0+1,y0+1,z0)]*(dx*dy*(1.0 - dz));
-            if(DX and DZ) tmpData += locData[Index(x0+1,y0,z0+1)]*(dx*(1.0 - dy)*dz);
-            if(DY and DZ) tmpData += locData[Index(x0,y0+1,z0+1)]*((1.0 - dx)*dy*dz);
+            if(DX and DY) AddWeighted(tmpData, locData[Index(x0+1,y0+1,z0)], dx*dy*(1.0 - dz));
+            if(DX and DZ) AddWeighted(tmpData, locData[Index(x0+1,y0,z0+1)], dx*(1.0 - dy)*dz);
+            if(DY and DZ) AddWeighted(tmpData, locData[Index(x0,y0+1,z0+1)], (1.0 - dx)*dy*dz);
 
-            if(DX and DY and DZ) tmpData += locData[Index(x0+1,y0+1,z0+1)]*(dx*dy*dz);
-
-            tempArray[(((x + b_cells*DX)*(ny + 2*b_cells*DY) + y + b_cells*DY)*(nz + 2*b_cells*DZ) + z + b_cells*DZ)] = tmpData;
+            if(DX and DY and DZ) AddWeighted(tmpData, locData[Index(x0+1,y0+1,z0+1)], dx*dy*dz);
         }
 
         Size_X = nx;
@@ -1605,7 +1761,64 @@ class Storage3D<T,0>
         Size_Y_BC = Size_Y + 2*b_cells*DY;
         Size_Z_BC = Size_Z + 2*b_cells*DZ;
 
-        locData = tempArray;
+        Origin = 0;
+        locData = std::move(tempArray);
+    }
+
+    void Shift(const long int dx, const long int dy, const long int dz,
+               const size_t Reserve = 16)                                       ///< Moves the content by (dx,dy,dz) cells: (x,y,z) takes the value of (x+dx,y+dy,z+dz), boundary cells keep their values
+    {
+        /* Moves the window of the storage within the data buffer instead of
+        copying the cells, see Storage3D<T,Rank>::Shift() */
+        if(std::abs(dx*DX) > b_cells or std::abs(dy*DY) > b_cells or std::abs(dz*DZ) > b_cells)
+        {
+            std::cerr << "ERROR: Storage3D<" << typeid(T).name()
+                      << ", 0>::Shift(): Shift exceeds the number of boundary cells!\n"
+                      << "Terminating!!!\n";
+            OP_Exit(EXIT_FAILURE);
+        }
+        const long int Step = ((dx*DX)*Size_Y_BC + dy*DY)*Size_Z_BC + dz*DZ;
+        if(Step == 0 or locData.size() == 0) return;
+
+        std::vector<T> Boundary;
+        BoundaryCellsLoop([&](const size_t idx)
+        {
+            Boundary.push_back(locData[idx]);
+        });
+
+        const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
+        const long int NewOrigin = long(Origin) + Step;
+        if(NewOrigin < 0 or NewOrigin + Size > locData.size())
+        {
+            const size_t Capacity = std::max(locData.size(), Size + std::max(Reserve, size_t(1))*std::abs(Step));
+            const size_t Target = (Step > 0) ? 0 : Capacity - Size;
+            if(Capacity != locData.size())
+            {
+                DataVector tempArray;
+                ResizeStorage(tempArray, Capacity);
+                std::move(locData.begin() + Origin, locData.begin() + Origin + Size,
+                          tempArray.begin() + Target);
+                locData = std::move(tempArray);
+            }
+            else if(Target < Origin)
+            {
+                std::move(locData.begin() + Origin, locData.begin() + Origin + Size,
+                          locData.begin() + Target);
+            }
+            else
+            {
+                std::move_backward(locData.begin() + Origin, locData.begin() + Origin + Size,
+                                   locData.begin() + Target + Size);
+            }
+            Origin = Target;
+        }
+        Origin += Step;
+
+        auto it = Boundary.begin();
+        BoundaryCellsLoop([&](const size_t idx)
+        {
+            locData[idx] = std::move(*it++);
+        });
     }
 
     bool rotate(const long int newdimx, const long int newdimy, const long int newdimz)
@@ -1637,7 +1850,8 @@ class Storage3D<T,0>
         // newdimx == 0; newdimy == 1; newdimz == 2
         if (newdimx == 0 and newdimy == 1 and newdimz == 2) return false;
 
-        std::vector<T> tempArray((Size_X + 2*b_cells*DX)*(Size_Y + 2*b_cells*DY)*(Size_Z + 2*b_cells*DZ));
+        DataVector tempArray;
+        ResizeStorage(tempArray, (Size_X + 2*b_cells*DX)*(Size_Y + 2*b_cells*DY)*(Size_Z + 2*b_cells*DZ));
 
         // dimx == 0; dimy == 2; dimz == 1 (rotates around positive x)
         if (newdimx == 0 and newdimy == 2 and newdimz == 1)
@@ -1681,7 +1895,8 @@ class Storage3D<T,0>
         Size_Y_BC = Size_Y + 2*b_cells*DY;
         Size_Z_BC = Size_Z + 2*b_cells*DZ;
 
-        locData = tempArray;
+        Origin = 0;
+        locData = std::move(tempArray);
 
         return true;
     }
@@ -1691,7 +1906,7 @@ class Storage3D<T,0>
 
     }
 
-    Storage3D<T,0>& operator=(const Storage3D<T,0>& locStorage3D)
+    Storage3D<T,0,Space>& operator=(const Storage3D<T,0,Space>& locStorage3D)
     {
         if(locData.size() != 0 and locStorage3D.IsAllocated())
         {
@@ -1732,7 +1947,8 @@ class Storage3D<T,0>
                     Size_Z_BC = Size_Z + 2*b_cells*DZ;
                     const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
 
-                    locData.resize(Size);
+                    Origin = 0;
+                    ResizeStorage(locData, Size);
 
                     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,locStorage3D,b_cells,)
                     {
@@ -1759,23 +1975,29 @@ class Storage3D<T,0>
             }
             else
             {
-                ClearCaller3D< Storage3D<T,0> ,T> K;
+                ClearCaller3D< Storage3D<T,0,Space> ,T> K;
                 K.call(*this);
             }
         }
     }
 
-    std::vector<double> pack(std::vector<long int> window)
+    std::vector<double> pack(const std::vector<long int>& window)
     {
         std::vector<double> buffer;
-        PackCaller3D< Storage3D<T,0>, T> K;
+        PackCaller3D< Storage3D<T,0,Space>, T> K;
         K.pack(*this, buffer, window);
         return buffer;
     }
 
-    void unpack(std::vector<double>& buffer, std::vector<long int> window)
+    void pack(std::vector<double>& buffer, const std::vector<long int>& window)///< Packs into an existing buffer, reusing its capacity
     {
-        PackCaller3D< Storage3D<T,0>, T> K;
+        PackCaller3D< Storage3D<T,0,Space>, T> K;
+        K.pack(*this, buffer, window);
+    }
+
+    void unpack(std::vector<double>& buffer, const std::vector<long int>& window)
+    {
+        PackCaller3D< Storage3D<T,0,Space>, T> K;
         K.unpack(*this, buffer, window);
     }
     
@@ -1795,7 +2017,7 @@ class Storage3D<T,0>
             window[3] = j+1;
             window[4] = k;
             window[5] = k+1;
-            PackCaller3D< Storage3D<T,0>, T> K;
+            PackCaller3D< Storage3D<T,0,Space>, T> K;
             K.pack(*this, buffer, window);
             for (size_t i = 0; i < buffer.size(); ++i)
             {
@@ -1817,7 +2039,7 @@ class Storage3D<T,0>
         window[3] = Size_Y;
         window[4] = 0;
         window[5] = Size_Z;
-        PackCaller3D< Storage3D<T,0>, T> K;
+        PackCaller3D< Storage3D<T,0,Space>, T> K;
         K.pack(*this, buffer, window);
         return buffer;
     }
@@ -1831,7 +2053,7 @@ class Storage3D<T,0>
         window[3] = Size_Y;
         window[4] = 0;
         window[5] = Size_Z;
-        PackCaller3D< Storage3D<T,0>, T> K;
+        PackCaller3D< Storage3D<T,0,Space>, T> K;
         K.unpack(*this, buffer, window);
     }
 
@@ -1842,7 +2064,7 @@ class Storage3D<T,0>
             const size_t Size = Size_X_BC*Size_Y_BC*Size_Z_BC;
             for(size_t idx = 0; idx < Size; idx++)
             {
-                locData[idx] = val;
+                locData[Origin + idx] = val;
             }
         }
         else
@@ -1856,12 +2078,35 @@ class Storage3D<T,0>
 
     T* data(void)
     {
-        return locData.data();
+        return locData.data() + Origin;
     }
 
     T* data(void) const
     {
-        return locData.data();
+        return locData.data() + Origin;
+    }
+
+    typedef Space MemorySpace;                                                  ///< Memory space of the storage data
+
+    void sync_to_device(void)                                                   ///< Makes the device copy current (no-op for host memory spaces)
+    {
+        Mirror.ToDevice(locData.data(), locData.size());
+    }
+    void sync_to_host(void)                                                     ///< Makes the host copy current (no-op for host memory spaces)
+    {
+        Mirror.ToHost(locData.data(), locData.size());
+    }
+    void mark_host_modified(void)                                               ///< To be called after writing the data on the host
+    {
+        Mirror.MarkHostModified();
+    }
+    void mark_device_modified(void)                                             ///< To be called after writing the data on the device
+    {
+        Mirror.MarkDeviceModified();
+    }
+    MemoryStates memory_state(void) const                                       ///< Dirty state of the host and device copies
+    {
+        return Mirror.GetState();
     }
 
     long int sizeX() const
@@ -1926,6 +2171,16 @@ class Storage3D<T,0>
         Reallocate(Size_X, Size_Y, Size_Z);
     }
 
+    size_t AllocatedMemory() const                                              ///< Memory held by the storage in bytes, including dynamically allocated node entries
+    {
+        size_t bytes = locData.capacity()*sizeof(T);
+        if constexpr (has_allocated_memory<T>::value)
+        {
+            for(const T& value : locData) bytes += value.allocated_memory();
+        }
+        return bytes;
+    }
+
     ////NOTE: Method is currently not used in OpenPhase and the << operator is
     ////not defined for all OpenPhase file types (Matrix3x3)!
     /*std::string print(void) const
@@ -2049,7 +2304,11 @@ class Storage3D<T,0>
     long int DY;
     long int DZ;
 
-    std::vector<T> locData;
+    typedef typename Space::template Vector<T> DataVector;                      ///< Data vector type of the memory space
+
+    DataVector locData;
+    MemoryMirror<T, Space> Mirror;                                              ///< Device copy of locData
+    size_t Origin;                                                              ///< Position of the first cell within the data buffer, moved by Shift()
 
     size_t Index(const long int x, const long int y, const long int z) const
     {
@@ -2060,7 +2319,38 @@ class Storage3D<T,0>
         assert(y >= - b_cells*DY && "Access beyond storage range");
         assert(z >= - b_cells*DZ && "Access beyond storage range");
 
-        return ((Size_Y_BC*(x + b_cells*DX) + y + b_cells*DY)*Size_Z_BC + z + b_cells*DZ);
+        return Origin + ((Size_Y_BC*(x + b_cells*DX) + y + b_cells*DY)*Size_Z_BC + z + b_cells*DZ);
+    }
+
+    template<class Function>
+    void BoundaryCellsLoop(Function&& Body) const                               ///< Calls Body(Index(x,y,z)) for all boundary cells in a fixed order
+    {
+        const long int bX = b_cells*DX;
+        const long int bY = b_cells*DY;
+        const long int bZ = b_cells*DZ;
+        for(long int x = -bX; x < Size_X + bX; x++)
+        for(long int y = -bY; y < Size_Y + bY; y++)
+        if(x < 0 or x >= Size_X or y < 0 or y >= Size_Y)
+        {
+            for(long int z = -bZ; z < Size_Z + bZ; z++) Body(Index(x,y,z));
+        }
+        else
+        {
+            for(long int z = -bZ; z < 0; z++) Body(Index(x,y,z));
+            for(long int z = Size_Z; z < Size_Z + bZ; z++) Body(Index(x,y,z));
+        }
+    }
+
+    static void AddWeighted(T& Sum, const T& Value, const double Weight)        ///< Sum += Value*Weight, without the temporary node for node types
+    {
+        if constexpr (has_add_weighted<T>::value)
+        {
+            Sum.add_weighted(Value, Weight);
+        }
+        else
+        {
+            Sum += Value*Weight;
+        }
     }
 };
 
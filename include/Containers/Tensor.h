@@ -42,6 +42,7 @@
 #include <vector>
 
 #include "Globals.h"
+#include "VectorExpressions.h"
 
 namespace openphase
 {
@@ -340,6 +341,27 @@ class Tensor
         }
         return *this;
     }
+    template<class E>
+    Tensor<T, Rank>& operator=(const VectorExpression<E>& expr)                 ///< Evaluates a lazy expression into the allocated tensor
+    {
+        CheckExpressionSize(expr.size(), "assignment");
+        AssignExpression(*this, expr);
+        return *this;
+    }
+    template<class E>
+    Tensor<T, Rank>& operator+=(const VectorExpression<E>& expr)
+    {
+        CheckExpressionSize(expr.size(), "+=");
+        AddExpression(*this, expr);
+        return *this;
+    }
+    template<class E>
+    Tensor<T, Rank>& operator-=(const VectorExpression<E>& expr)
+    {
+        CheckExpressionSize(expr.size(), "-=");
+        SubtractExpression(*this, expr);
+        return *this;
+    }
     template<typename T2>
     Tensor<T, Rank>& operator+=(const Tensor<T2, Rank>& locTensor)
     {
@@ -568,6 +590,18 @@ class Tensor
                 return locIndex;
         }
     }
+    void CheckExpressionSize(const size_t size, const std::string operation) const
+    {
+        if(not (allocated or assigned) or size != totSize)
+        {
+            std::stringstream message;
+            message << "ERROR: Tensor<T," << Rank
+                    << ">: Different tensor size in " << operation
+                    << " of an expression! The tensor has to be allocated.\n";
+            std::cerr << message.str();
+            OP_Exit(EXIT_FAILURE);
+        }
+    }
 };
 
 }// namespace openphase
@@ -97,6 +97,38 @@ public:
     };
 };
 
+template <typename T>
+class has_allocated_memory
+{
+    typedef char one;
+    typedef long two;
+
+    template <typename C> static one test( decltype(&C::allocated_memory) ) ;
+    template <typename C> static two test(...);
+
+public:
+    enum
+    {
+        value = sizeof(test<T>(0)) == sizeof(char)
+    };
+};
+
+template <typename T>
+class has_add_weighted
+{
+    typedef char one;
+    typedef long two;
+
+    template <typename C> static one test( decltype(&C::add_weighted) ) ;
+    template <typename C> static two test(...);
+
+public:
+    enum
+    {
+        value = sizeof(test<T>(0)) == sizeof(char)
+    };
+};
+
 template <typename T>
 class has_pack
 {
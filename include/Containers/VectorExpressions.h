@@ -0,0 +1,285 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef VECTOREXPRESSIONS_H
+#define VECTOREXPRESSIONS_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace openphase
+{
+
+/* Expression templates for the element-wise arithmetic of the dynamically
+sized containers dVectorN and Tensor<double,Rank>. Their regular operators
+return a heap allocated temporary for every intermediate result. Wrapping one
+operand with lazy() turns the whole compound expression into a light-weight
+expression object instead, which is evaluated in a single loop without
+temporaries when it is assigned to a container:
+
+    Result  = lazy(A) - lazy(B)*mu*factor;                              // one loop, no allocation
+    Result += (lazy(A) + B)*0.5;
+
+Once an expression is started, further containers can be used directly, while
+a plain container product like B*mu is still evaluated eagerly by the regular
+operators. Expressions keep references to their operands and have to be evaluated within
+the same statement, they should not be stored with auto. The fixed size
+containers (dVector3, dVector6, ...) are allocated on the stack and their
+operators are inlined by the compiler, they can still be used as operands. */
+
+template<class E>
+class VectorExpression                                                          ///< Base class of all expression nodes
+{
+ public:
+    const E& self(void) const
+    {
+        return static_cast<const E&>(*this);
+    }
+    size_t size(void) const                                                     ///< Number of elements
+    {
+        return self().size();
+    }
+    double operator[](const size_t i) const                                     ///< Evaluates element i
+    {
+        return self()[i];
+    }
+};
+
+template<class V>
+class VectorTerminal : public VectorExpression<VectorTerminal<V>>               ///< Reference to a container
+{
+ public:
+    explicit VectorTerminal(const V& vec) : Vec(vec){};
+    size_t size(void) const
+    {
+        return Vec.size();
+    }
+    double operator[](const size_t i) const
+    {
+        return Vec[i];
+    }
+ private:
+    const V& Vec;
+};
+
+template<class L, class R, class Op>
+class VectorBinary : public VectorExpression<VectorBinary<L,R,Op>>              ///< Element-wise operation of two expressions
+{
+ public:
+    VectorBinary(const L& lhs, const R& rhs) : Lhs(lhs), Rhs(rhs)
+    {
+        assert(lhs.size() == rhs.size() && "VectorExpression: Sizes of the operands are not equal");
+    };
+    size_t size(void) const
+    {
+        return Lhs.size();
+    }
+    double operator[](const size_t i) const
+    {
+        return Op::apply(Lhs[i], Rhs[i]);
+    }
+ private:
+    const L Lhs;
+    const R Rhs;
+};
+
+template<class E, class Op>
+class VectorScalar : public VectorExpression<VectorScalar<E,Op>>                ///< Operation of an expression and a scalar
+{
+ public:
+    VectorScalar(const E& expr, const double scalar) : Expr(expr), Scalar(scalar){};
+    size_t size(void) const
+    {
+        return Expr.size();
+    }
+    double operator[](const size_t i) const
+    {
+        return Op::apply(Expr[i], Scalar);
+    }
+ private:
+    const E Expr;
+    const double Scalar;
+};
+
+namespace VectorOperations
+{
+    struct Add      {static double apply(const double a, const double b) {return a + b;}};
+    struct Subtract {static double apply(const double a, const double b) {return a - b;}};
+    struct Multiply {static double apply(const double a, const double b) {return a * b;}};
+    struct Divide   {static double apply(const double a, const double b) {return a / b;}};
+    struct RSubtract{static double apply(const double a, const double b) {return b - a;}};
+    struct RDivide  {static double apply(const double a, const double b) {return b / a;}};
+}// namespace VectorOperations
+
+/* Containers which can be mixed with expressions without lazy(), the plain
+container arithmetic is left unchanged. */
+
+class dVectorN;
+class dVector3;
+class dVector6;
+template <class T, size_t Rank> class Tensor;
+
+template<class T> struct IsLazyContainer                     : std::false_type {};
+template<>        struct IsLazyContainer<dVectorN>           : std::true_type  {};
+template<>        struct IsLazyContainer<dVector3>           : std::true_type  {};
+template<>        struct IsLazyContainer<dVector6>           : std::true_type  {};
+template<size_t R>struct IsLazyContainer<Tensor<double,R>>   : std::true_type  {};
+
+template<class V>
+inline VectorTerminal<V> lazy(const V& vec)                                     ///< Starts a lazily evaluated expression
+{
+    static_assert(IsLazyContainer<V>::value, "lazy(): unsupported container type");
+    return VectorTerminal<V>(vec);
+}
+
+template<class T, class Enable = void>
+struct AsExpression                                                             ///< Converts an operand into an expression node
+{
+    typedef T type;
+    static const T& get(const T& x) {return x;}
+};
+template<class T>
+struct AsExpression<T, typename std::enable_if<IsLazyContainer<T>::value>::type>
+{
+    typedef VectorTerminal<T> type;
+    static type get(const T& x) {return type(x);}
+};
+
+template<class T>
+struct IsVectorExpression : std::is_base_of<VectorExpression<T>, T> {};
+
+/* Binary operators are enabled if one operand is an expression and the other
+one an expression or a supported container. */
+template<class L, class R>
+struct EnableVectorBinary : std::enable_if<
+    (IsVectorExpression<L>::value and (IsVectorExpression<R>::value or IsLazyContainer<R>::value)) or
+    (IsVectorExpression<R>::value and IsLazyContainer<L>::value)> {};
+
+#define OP_VECTOR_EXPRESSION_BINARY(OPERATOR, OPERATION)                        \
+template<class L, class R, class = typename EnableVectorBinary<L,R>::type>      \
+inline VectorBinary<typename AsExpression<L>::type,                             \
+                    typename AsExpression<R>::type, VectorOperations::OPERATION>\
+operator OPERATOR(const L& lhs, const R& rhs)                                   \
+{                                                                               \
+    return {AsExpression<L>::get(lhs), AsExpression<R>::get(rhs)};              \
+}
+
+OP_VECTOR_EXPRESSION_BINARY(+, Add)
+OP_VECTOR_EXPRESSION_BINARY(-, Subtract)
+OP_VECTOR_EXPRESSION_BINARY(*, Multiply)
+OP_VECTOR_EXPRESSION_BINARY(/, Divide)
+#undef OP_VECTOR_EXPRESSION_BINARY
+
+template<class E>
+inline VectorScalar<E, VectorOperations::Multiply> operator*(const VectorExpression<E>& expr, const double scalar)
+{
+    return {expr.self(), scalar};
+}
+template<class E>
+inline VectorScalar<E, VectorOperations::Multiply> operator*(const double scalar, const VectorExpression<E>& expr)
+{
+    return {expr.self(), scalar};
+}
+template<class E>
+inline VectorScalar<E, VectorOperations::Divide> operator/(const VectorExpression<E>& expr, const double scalar)
+{
+    return {expr.self(), scalar};
+}
+template<class E>
+inline VectorScalar<E, VectorOperations::RDivide> operator/(const double scalar, const VectorExpression<E>& expr)
+{
+    return {expr.self(), scalar};
+}
+template<class E>
+inline VectorScalar<E, VectorOperations::Add> operator+(const VectorExpression<E>& expr, const double scalar)
+{
+    return {expr.self(), scalar};
+}
+template<class E>
+inline VectorScalar<E, VectorOperations::Add> operator+(const double scalar, const VectorExpression<E>& expr)
+{
+    return {expr.self(), scalar};
+}
+template<class E>
+inline VectorScalar<E, VectorOperations::Subtract> operator-(const VectorExpression<E>& expr, const double scalar)
+{
+    return {expr.self(), scalar};
+}
+template<class E>
+inline VectorScalar<E, VectorOperations::RSubtract> operator-(const double scalar, const VectorExpression<E>& expr)
+{
+    return {expr.self(), scalar};
+}
+template<class E>
+inline VectorScalar<E, VectorOperations::Multiply> operator-(const VectorExpression<E>& expr)
+{
+    return {expr.self(), -1.0};
+}
+
+/* Evaluation into a container with operator[], the element i of an
+expression depends on the element i of its operands only, the target may
+therefore appear in the expression itself. */
+
+template<class V, class E>
+inline void AssignExpression(V& target, const VectorExpression<E>& expr)
+{
+    const E& e = expr.self();
+    const size_t size = e.size();
+    assert(target.size() == size && "VectorExpression: Size of the target is not equal");
+    #pragma omp simd
+    for(size_t i = 0; i < size; i++)
+    {
+        target[i] = e[i];
+    }
+}
+template<class V, class E>
+inline void AddExpression(V& target, const VectorExpression<E>& expr)
+{
+    const E& e = expr.self();
+    const size_t size = e.size();
+    assert(target.size() == size && "VectorExpression: Size of the target is not equal");
+    #pragma omp simd
+    for(size_t i = 0; i < size; i++)
+    {
+        target[i] += e[i];
+    }
+}
+template<class V, class E>
+inline void SubtractExpression(V& target, const VectorExpression<E>& expr)
+{
+    const E& e = expr.self();
+    const size_t size = e.size();
+    assert(target.size() == size && "VectorExpression: Size of the target is not equal");
+    #pragma omp simd
+    for(size_t i = 0; i < size; i++)
+    {
+        target[i] -= e[i];
+    }
+}
+
+}// namespace openphase
+#endif
@@ -179,11 +179,17 @@ class OP_EXPORTS dMatrix3x3
     dMatrix3x3 operator*(const dMatrix3x3& rhs) const
     {
         dMatrix3x3 tmp;
+        const double* A = storage.data();
+        const double* B = rhs.storage.data();
+        double* C = tmp.storage.data();
         for(int i = 0; i < 3; i++)
-        for(int j = 0; j < 3; j++)
-        for(int k = 0; k < 3; k++)
         {
-            tmp(i,j) += storage[idx(i,k)]*rhs(k,j);
+            const double a0 = A[3*i];
+            const double a1 = A[3*i+1];
+            const double a2 = A[3*i+2];
+            C[3*i  ] = a0*B[0] + a1*B[3] + a2*B[6];
+            C[3*i+1] = a0*B[1] + a1*B[4] + a2*B[7];
+            C[3*i+2] = a0*B[2] + a1*B[5] + a2*B[8];
         }
         return tmp;
     }
@@ -302,48 +308,22 @@ class OP_EXPORTS dMatrix3x3
     }
     dMatrix3x3& invert(void)
     {
-        dMatrix3x3 tmp;
-
-        double detInv = determinant();
-
-        if(detInv != 0.0)
-        {
-            detInv = 1.0/detInv;
-        }
-        else
-        {
-            std::cerr << "dMatrix3x3: Can Not Compute Inverse Matrix.\n"
-                      << this->print() << "Matrix is Singular !!!\n";
-            OP_Exit(EXIT_FAILURE);
-        }
-
-        tmp(0,0) = (storage[idx(1,1)]*storage[idx(2,2)] -
-                    storage[idx(1,2)]*storage[idx(2,1)])*detInv;
-        tmp(1,0) =-(storage[idx(1,0)]*storage[idx(2,2)] -
-                    storage[idx(1,2)]*storage[idx(2,0)])*detInv;
-        tmp(2,0) = (storage[idx(1,0)]*storage[idx(2,1)] -
-                    storage[idx(1,1)]*storage[idx(2,0)])*detInv;
-        tmp(0,1) =-(storage[idx(0,1)]*storage[idx(2,2)] -
-                    storage[idx(0,2)]*storage[idx(2,1)])*detInv;
-        tmp(1,1) = (storage[idx(0,0)]*storage[idx(2,2)] -
-                    storage[idx(0,2)]*storage[idx(2,0)])*detInv;
-        tmp(2,1) =-(storage[idx(0,0)]*storage[idx(2,1)] -
-                    storage[idx(0,1)]*storage[idx(2,0)])*detInv;
-        tmp(0,2) = (storage[idx(0,1)]*storage[idx(1,2)] -
-                    storage[idx(1,1)]*storage[idx(0,2)])*detInv;
-        tmp(1,2) =-(storage[idx(0,0)]*storage[idx(1,2)] -
-                    storage[idx(0,2)]*storage[idx(1,0)])*detInv;
-        tmp(2,2) = (storage[idx(0,0)]*storage[idx(1,1)] -
-                    storage[idx(0,1)]*storage[idx(1,0)])*detInv;
-
-        memmove(storage.data(), tmp.data(), 9*sizeof(double));
+        *this = inverted();
         return *this;
     }
     dMatrix3x3 inverted(void) const
     {
+        /* The determinant is expanded along the first row, reusing the
+        cofactors of the adjugate. */
+        const double* A = storage.data();
         dMatrix3x3 tmp;
+        double* Inv = tmp.storage.data();
+
+        Inv[0] = A[4]*A[8] - A[5]*A[7];
+        Inv[3] = A[5]*A[6] - A[3]*A[8];
+        Inv[6] = A[3]*A[7] - A[4]*A[6];
 
-        double detInv = determinant();
+        double detInv = A[0]*Inv[0] + A[1]*Inv[3] + A[2]*Inv[6];
 
         if(detInv != 0.0)
         {
@@ -356,25 +336,17 @@ class OP_EXPORTS dMatrix3x3
             OP_Exit(EXIT_FAILURE);
         }
 
-        tmp(0,0) = (storage[idx(1,1)]*storage[idx(2,2)] -
-                    storage[idx(1,2)]*storage[idx(2,1)])*detInv;
-        tmp(1,0) =-(storage[idx(1,0)]*storage[idx(2,2)] -
-                    storage[idx(1,2)]*storage[idx(2,0)])*detInv;
-        tmp(2,0) = (storage[idx(1,0)]*storage[idx(2,1)] -
-                    storage[idx(1,1)]*storage[idx(2,0)])*detInv;
-        tmp(0,1) =-(storage[idx(0,1)]*storage[idx(2,2)] -
-                    storage[idx(0,2)]*storage[idx(2,1)])*detInv;
-        tmp(1,1) = (storage[idx(0,0)]*storage[idx(2,2)] -
-                    storage[idx(0,2)]*storage[idx(2,0)])*detInv;
-        tmp(2,1) =-(storage[idx(0,0)]*storage[idx(2,1)] -
-                    storage[idx(0,1)]*storage[idx(2,0)])*detInv;
-        tmp(0,2) = (storage[idx(0,1)]*storage[idx(1,2)] -
-                    storage[idx(1,1)]*storage[idx(0,2)])*detInv;
-        tmp(1,2) =-(storage[idx(0,0)]*storage[idx(1,2)] -
-                    storage[idx(0,2)]*storage[idx(1,0)])*detInv;
-        tmp(2,2) = (storage[idx(0,0)]*storage[idx(1,1)] -
-                    storage[idx(0,1)]*storage[idx(1,0)])*detInv;
+        Inv[1] = A[2]*A[7] - A[1]*A[8];
+        Inv[4] = A[0]*A[8] - A[2]*A[6];
+        Inv[7] = A[1]*A[6] - A[0]*A[7];
+        Inv[2] = A[1]*A[5] - A[2]*A[4];
+        Inv[5] = A[2]*A[3] - A[0]*A[5];
+        Inv[8] = A[0]*A[4] - A[1]*A[3];
 
+        for(int n = 0; n < 9; n++)
+        {
+            Inv[n] *= detInv;
+        }
         return tmp;
     }
     dMatrix3x3& transpose(void)
@@ -594,7 +566,7 @@ class OP_EXPORTS dMatrix3x3
         }
         return out;
     }
-    void read(std::stringstream& inp)
+    void read(std::istream& inp)
     {
         for(int i = 0; i < 3; i++)
         for(int j = 0; j < 3; j++)
@@ -187,12 +187,15 @@ class dMatrix6x6
     dMatrix6x6 operator*(const dMatrix6x6& rhs) const
     {
         dMatrix6x6 tmp;
-        tmp.set_to_zero();
         for(int i = 0; i < 6; i++)
-        for(int j = 0; j < 6; j++)
         for(int k = 0; k < 6; k++)
         {
-            tmp(i,j) += storage[i][k]*rhs(k,j);
+            const double a = storage[i][k];
+            #pragma omp simd
+            for(int j = 0; j < 6; j++)
+            {
+                tmp.storage[i][j] += a*rhs.storage[k][j];
+            }
         }
         return tmp;
     };
@@ -522,79 +525,59 @@ class dMatrix6x6
         return tmp;
     };
 
-    dMatrix6x6& rotate(const dMatrix3x3& RotationMatrix)
+    static dMatrix6x6 RotationOperator(const dMatrix3x3& R)                    ///< Voigt form M of the rotation R, C' = M*C*M^T for tensors stored by tensor()
     {
-        double Out[3][3][3][3];
-
-        for(int m = 0; m < 3; m++)
-        for(int n = 0; n < 3; n++)
-        for(int p = 0; p < 3; p++)
-        for(int q = 0; q < 3; q++)
+        /* M(I,J) = R(m,i)*R(n,j) + R(m,j)*R(n,i) with (m,n) = Voigt(I) and
+        (i,j) = Voigt(J), the second term only for the off-diagonal J. This
+        replaces the four fold summation over the full 3x3x3x3 tensor. */
+        const int VoigtIndex[6][2] = {{0,0},{1,1},{2,2},{1,2},{0,2},{0,1}};
+        dMatrix6x6 M;
+        for(int I = 0; I < 6; I++)
         {
-            Out[m][n][p][q] = 0.0;
-
-            for(int i = 0; i < 3; i++)
-            for(int j = 0; j < 3; j++)
-            for(int k = 0; k < 3; k++)
-            for(int l = 0; l < 3; l++)
+            const int m = VoigtIndex[I][0];
+            const int n = VoigtIndex[I][1];
+            for(int J = 0; J < 3; J++)
             {
-                  // active rotation
-                Out[m][n][p][q] += RotationMatrix(m,i)*
-                                   RotationMatrix(n,j)*
-                                   tensor(i,j,k,l)*
-                                   RotationMatrix(p,k)*
-                                   RotationMatrix(q,l);
+                M.storage[I][J] = R(m,J)*R(n,J);
+            }
+            for(int J = 3; J < 6; J++)
+            {
+                const int i = VoigtIndex[J][0];
+                const int j = VoigtIndex[J][1];
+                M.storage[I][J] = R(m,i)*R(n,j) + R(m,j)*R(n,i);
             }
         }
-        int VoigtIndex[6][2] = {{0,0},{1,1},{2,2},{1,2},{0,2},{0,1}};
-        for(int m = 0; m < 6; m++)
-        for(int n = 0; n < 6; n++)
-        {
-            int i = VoigtIndex[m][0];
-            int j = VoigtIndex[m][1];
-            int k = VoigtIndex[n][0];
-            int l = VoigtIndex[n][1];
-
-            storage[m][n] = Out[i][j][k][l];
-        }
+        return M;
+    };
+    dMatrix6x6& rotate(const dMatrix3x3& RotationMatrix)
+    {
+        *this = rotated(RotationMatrix);
         return *this;
     };
-    dMatrix6x6 rotated(const dMatrix3x3& RotationMatrix)
+    dMatrix6x6 rotated(const dMatrix3x3& RotationMatrix) const
     {
-        double Out[3][3][3][3];
-
-        for(int m = 0; m < 3; m++)
-        for(int n = 0; n < 3; n++)
-        for(int p = 0; p < 3; p++)
-        for(int q = 0; q < 3; q++)
+        // active rotation
+        return transformed(RotationOperator(RotationMatrix));
+    };
+    dMatrix6x6& transform(const dMatrix6x6& M)                                  ///< Rotation with a precomputed RotationOperator() M
+    {
+        *this = transformed(M);
+        return *this;
+    };
+    dMatrix6x6 transformed(const dMatrix6x6& M) const                           ///< Returns M*C*M^T
+    {
+        const dMatrix6x6 MC = M*(*this);
+        dMatrix6x6 OUT;
+        for(int i = 0; i < 6; i++)
+        for(int j = 0; j < 6; j++)
         {
-            Out[m][n][p][q] = 0.0;
-
-            for(int i = 0; i < 3; i++)
-            for(int j = 0; j < 3; j++)
-            for(int k = 0; k < 3; k++)
-            for(int l = 0; l < 3; l++)
+            double sum = 0.0;
+            #pragma omp simd reduction(+:sum)
+            for(int k = 0; k < 6; k++)
             {
-                // active rotation
-                Out[m][n][p][q] += RotationMatrix(m,i)*
-                                   RotationMatrix(n,j)*
-                                   tensor(i,j,k,l)*
-                                   RotationMatrix(p,k)*
-                                   RotationMatrix(q,l);
+                sum += MC.storage[i][k]*M.storage[j][k];
             }
-        }
-        dMatrix6x6 OUT;
-        int VoigtIndex[6][2] = {{0,0},{1,1},{2,2},{1,2},{0,2},{0,1}};
-
-        for(int m = 0; m < 6; m++)
-        for(int n = 0; n < 6; n++)
-        {
-            int i = VoigtIndex[m][0];
-            int j = VoigtIndex[m][1];
-            int k = VoigtIndex[n][0];
-            int l = VoigtIndex[n][1];
-
-            OUT(m,n) = Out[i][j][k][l];
+            OUT.storage[i][j] = sum;
         }
         return OUT;
     };
@@ -672,7 +655,7 @@ class dMatrix6x6
         }
         return out;
     };
-    void read(std::stringstream& inp)
+    void read(std::istream& inp)
     {
         for(int i = 0; i < 6; i++)
         for(int j = 0; j < 6; j++)
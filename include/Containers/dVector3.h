@@ -449,7 +449,7 @@ class dVector3
         }
     }
 
-    void read(std::stringstream& inp)
+    void read(std::istream& inp)
     {
         for(int i = 0; i < 3; i++)
         {
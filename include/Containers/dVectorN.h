@@ -39,6 +39,8 @@
 #include <numeric>
 #include <vector>
 
+#include "VectorExpressions.h"
+
 namespace openphase
 {
 
@@ -60,6 +62,11 @@ class dVectorN
     dVectorN(const std::vector<double>& vec) : storage(vec)
     {
     };
+    template<class E>
+    dVectorN(const VectorExpression<E>& expr): storage(expr.size())             ///< Evaluates a lazy expression
+    {
+        AssignExpression(*this, expr);
+    };
     dVectorN(std::initializer_list<double> vecinit)
     {
         storage.resize(vecinit.size());
@@ -261,6 +268,25 @@ class dVectorN
         storage = rhs.storage;
         return *this;
     };
+    template<class E>
+    dVectorN& operator=(const VectorExpression<E>& expr)
+    {
+        if(storage.size() != expr.size()) storage.resize(expr.size());
+        AssignExpression(*this, expr);
+        return *this;
+    };
+    template<class E>
+    dVectorN& operator+=(const VectorExpression<E>& expr)
+    {
+        AddExpression(*this, expr);
+        return *this;
+    };
+    template<class E>
+    dVectorN& operator-=(const VectorExpression<E>& expr)
+    {
+        SubtractExpression(*this, expr);
+        return *this;
+    };
     [[nodiscard]]
     dVectorN operator*(const double m) const
     {
@@ -346,7 +346,7 @@ class iVector3
         }
     }
 
-    void read(std::stringstream& inp)
+    void read(std::istream& inp)
     {
         for(int i = 0; i < 3; i++)
         {
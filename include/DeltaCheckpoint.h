@@ -0,0 +1,107 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef DELTACHECKPOINT_H
+#define DELTACHECKPOINT_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Incremental raw data checkpoints. The domain is split into cubic blocks of
+BlockSize cells, each block is serialized separately and its hash is kept.
+A checkpoint file "<Prefix><tStep>.delta" stores only the blocks which changed
+since the previous checkpoint and the time step of that checkpoint, every
+FullInterval-th checkpoint stores all blocks. Read() restores any written
+time step by applying the chain of checkpoints starting from the last full
+one, scripts/OpenPhaseCheckpoint.py merges a chain into a full checkpoint
+offline. The block contents are opaque, the owning class provides the
+serialization of a block:
+
+    Checkpoints.Initialize(Grid.Nx, Grid.Ny, Grid.Nz, 16, 10);
+    Checkpoints.Write(Directory, Prefix, tStep,
+        [this](std::ostream& out, const DeltaCheckpoint::Block_t& B)
+        {
+            for(long int i = B.x0; i < B.x1; i++)
+            for(long int j = B.y0; j < B.y1; j++)
+            for(long int k = B.z0; k < B.z1; k++) Fields(i,j,k).write(out);
+        });
+
+File layout: "OPDELTA1", int32 previous time step (-1 for a full checkpoint),
+int32 Nx, Ny, Nz, BlockSize, uint64 number of blocks, then for each block
+uint64 block index, uint64 length in bytes and the block data. */
+
+class OP_EXPORTS DeltaCheckpoint                                                ///< Incremental checkpoints of block-wise serialized 3D data
+{
+ public:
+    static constexpr auto thisclassname = "DeltaCheckpoint";                    ///< Object's implementation class name
+
+    struct Block_t                                                              ///< Cell range [x0,x1) x [y0,y1) x [z0,z1) of a block
+    {
+        long int x0, x1;
+        long int y0, y1;
+        long int z0, z1;
+    };
+    typedef std::function<void(std::ostream&, const Block_t&)> BlockWriter_t;   ///< Serializes the cells of a block
+    typedef std::function<void(std::istream&, const Block_t&)> BlockReader_t;   ///< Deserializes the cells of a block
+
+    void Initialize(const long int Nx, const long int Ny, const long int Nz,
+                    const long int BlockSize, const int FullInterval);          ///< Sets the domain and block size, resets the history if they change
+    bool Active(void) const                                                     ///< True if incremental checkpoints are enabled
+    {
+        return FullInterval > 0;
+    }
+    bool Write(const std::string& Directory, const std::string& Prefix,
+               const int tStep, const BlockWriter_t& WriteBlock);               ///< Writes the blocks changed since the previous checkpoint
+    bool Read(const std::string& Directory, const std::string& Prefix,
+              const int tStep, const BlockReader_t& ReadBlock);                 ///< Restores time step tStep from the chain of checkpoints
+    static std::string Prefix(const std::string& Name);                         ///< File name prefix "<Name>_", with the MPI rank in MPI parallel mode
+    static std::string FileName(const std::string& Directory,
+                                const std::string& Prefix, const int tStep);    ///< Name of the checkpoint file of time step tStep
+
+ private:
+    Block_t Block(const size_t idx) const;                                      ///< Cell range of block idx
+    size_t  nBlocks(void) const
+    {
+        return nBlocksX*nBlocksY*nBlocksZ;
+    }
+
+    long int Nx = 0;
+    long int Ny = 0;
+    long int Nz = 0;
+    long int BlockSize = 16;                                                    ///< Edge length of the blocks in cells
+    long int nBlocksX = 0;
+    long int nBlocksY = 0;
+    long int nBlocksZ = 0;
+    int FullInterval = 0;                                                       ///< Every FullInterval-th checkpoint stores all blocks, 0 disables incremental checkpoints
+    int Count = 0;                                                              ///< Number of checkpoints since the last full one
+    int PreviousStep = -1;                                                      ///< Time step of the previous checkpoint
+    std::vector<uint64_t> Hashes;                                               ///< Hashes of the blocks at the previous checkpoint
+};
+
+}// namespace openphase
+#endif
@@ -30,6 +30,7 @@
 #include "Includes.h"
 #include "PhaseField.h"
 #include "BoundaryConditions.h"
+#include "InterfaceAveraging.h"
 
 namespace openphase
 {
@@ -43,13 +44,6 @@ class Temperature;
 class ThermodynamicPropertiesEQP;
 class ThermodynamicPropertiesEQP;
 
-enum class AveragingWeightsModes
-{
-    Range,
-    PhaseFields,
-    Counter
-};
-
 /***************************************************************/
 class OP_EXPORTS DrivingForce : public OPObject                                 ///< The driving force module. Provides the storage and manipulation methods.
 {
@@ -64,6 +58,8 @@ class OP_EXPORTS DrivingForce : public OPObject
     void ReadInput(const std::string InputFileName) override;                   ///< Reads driving force settings
     void ReadInput(std::stringstream& inp) override;                            ///< Reads driving force settings
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override;///< Remeshes the storage while keeping the data
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
 
     void Clear(void);                                                           ///< Deletes driving forces in the storage. Needs to be called at the end/beginning of each time step!
 
@@ -130,9 +126,7 @@ class OP_EXPORTS DrivingForce : public OPObject
     double maxPsi;
 
     void SkipAverage(const PhaseField& Phase);                                  ///< Sets local average driving force to its raw value
-    void SetWeights(const PhaseField& Phase);                                   ///< Sets local averaging weights
-    void CollectAverage(const PhaseField& Phase);                               ///< First part of Average
-    void DistributeAverage(const PhaseField& Phase);                            ///< Second part of Average
+    InterfaceAveraging Averager;                                                ///< Averaging stencil and stages shared with InterfaceRegularization
 
     void MergePhaseFieldIncrementsSR(PhaseField& Phase, InterfaceProperties& IP);///< Merges the driving force into the phase field increments.
     void MergePhaseFieldIncrementsDR(PhaseField& Phase, InterfaceProperties& IP);///< Merges the driving force into the phase field increments.
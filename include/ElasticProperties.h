@@ -30,6 +30,7 @@
 #include "Includes.h"
 #include "SymmetryVariants.h"
 #include "Tools.h"
+#include <unordered_map>
 
 namespace openphase
 {
@@ -77,6 +78,7 @@ class OP_EXPORTS ElasticProperties : public OPObject
     void ReadInput(const std::string InputFileName) override;                   ///< Reads elastic properties from the input file
     void ReadInput(std::stringstream& inp) override;                            ///< Reads elastic properties from the input stream
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override;///< Remeshes the elasticity storages
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
 
     void SetBoundaryConditions(const BoundaryConditions& BC)  override;         ///< Sets boundary conditions for strains, stresses and displacements
     void SetBoundaryConditionsPlastic(const BoundaryConditions& BC);            ///< Sets boundary conditions Plastic
@@ -156,6 +158,11 @@ class OP_EXPORTS ElasticProperties : public OPObject
     void SetStressesRX(PhaseField& Phase,
                        BoundaryConditions& BC, std::vector<int> targetPhases);
     ElasticProperties& operator= (const ElasticProperties& rhs);
+    void ResetGrainsProperties(void)                                            ///< Makes the next grain properties update recalculate all grains, needed after changing the phase properties
+    {
+        GrainsPropertiesKeys.clear();
+        VariantsProperties.clear();
+    }
 
     // Parameters and storages
     vStress AverageStress;                                                      ///< Average stress calculated by the spectral solver.
@@ -195,8 +202,8 @@ class OP_EXPORTS ElasticProperties : public OPObject
 
     Storage3D<dMatrix6x6,0> EffectiveElasticConstants;                          ///< Storage for effective elastic constants
 
-    Storage3D<NodeA<dMatrix6x6>,0> ElasticConstants;                            ///< Storage for elastic constants for each phase field in each grid point
-    Storage3D<NodeA<dMatrix3x3>,0> TransformationStretches;                     ///< Storage for transformation stretches for each phase field in each grid point
+    Storage3D<NodeA<dMatrix6x6>,0> ElasticConstants;                            ///< Storage for elastic constants for each phase field in each grid point (only with thermo- or chemo-mechanical coupling)
+    Storage3D<NodeA<dMatrix3x3>,0> TransformationStretches;                     ///< Storage for transformation stretches for each phase field in each grid point (only with thermo- or chemo-mechanical coupling)
 
     Storage3D<dVector3,0>   ForceDensity;                                       ///< Force density storage
     Storage3D<dVector3,0>   Displacements;                                      ///< Displacements storage
@@ -240,6 +247,7 @@ class OP_EXPORTS ElasticProperties : public OPObject
             
     ElasticityModels ElasticityModel;                                           ///< Elasticity model selector
     StrainModels     StrainModel;                                               ///< Strain model selector
+    double JumpCacheTolerance;                                                  ///< Normal bucket size and relative stiffness tolerance of the acoustic tensor cache of the Rank1 models, 0 disables the cache
 
  protected:
  private:
@@ -267,6 +275,45 @@ class OP_EXPORTS ElasticProperties : public OPObject
 
     void SetGrainsProperties(const PhaseField& Phase);                          ///< Sets elastic properties for each grain according to its phase and orientation
 
+    /* Phase, variant and orientation of each grain at the last update of its
+    properties. SetGrainsProperties() only updates grains for which they have
+    changed, e.g. new nuclei or rotated grains, after a restart the grains are
+    set up once from the restored grains properties. */
+    std::vector<std::array<double,6>> GrainsPropertiesKeys;                     ///< {phase, variant, orientation} of each grain at its last update, phase is -1 if not set
+
+    /* Phase properties rotated into the frame of each symmetry variant. All
+    grains of a variant share them, a grain only applies its own orientation.
+    The table is built on the first grain properties update after reading
+    the input or ResetGrainsProperties(). */
+    struct VariantProperties
+    {
+        dMatrix3x3 TransformationStretches;                                     ///< Transformation stretches of the variant
+        dMatrix6x6 ElasticConstants;                                            ///< Elastic constants of the variant
+        dMatrix3x3 Alpha;                                                       ///< Thermal expansion coefficients of the variant
+        dMatrix6x6 Gamma;                                                       ///< Temperature dependence of the elastic constants of the variant
+        std::vector<dMatrix3x3> Lambda;                                         ///< Composition dependence of the transformation stretches for each component
+        std::vector<dMatrix6x6> Kappa;                                          ///< Composition dependence of the elastic constants for each component
+    };
+    std::vector<std::vector<VariantProperties>> VariantsProperties;             ///< Variant rotated phase properties, indexed by phase and variant
+    void SetVariantsProperties(void);                                           ///< Builds VariantsProperties from the phase properties and Variants
+
+    /* Without thermo- or chemo-mechanical coupling the elastic constants and
+    transformation stretches of a phase field are the same in all grid points
+    and are taken from GrainElasticConstants and GrainTransformationStretches
+    directly, the per grid point storages are not allocated. */
+    bool LocalGrainProperties(void) const                                       ///< True if the grain properties are modified locally
+    {
+        return ThermoMechanicalCoupling or ChemoMechanicalCoupling;
+    }
+    dMatrix6x6 LocalElasticConstants(const int i, const int j, const int k, const size_t alpha) const ///< Elastic constants of phase field alpha in grid point (i,j,k)
+    {
+        return LocalGrainProperties() ? ElasticConstants(i,j,k).get_value(alpha) : GrainElasticConstants[alpha];
+    }
+    dMatrix3x3 LocalTransformationStretches(const int i, const int j, const int k, const size_t alpha) const ///< Transformation stretches of phase field alpha in grid point (i,j,k)
+    {
+        return LocalGrainProperties() ? TransformationStretches(i,j,k).get_value(alpha) : GrainTransformationStretches[alpha];
+    }
+
     void SetBaseTransformationStretches(const PhaseField& Phase);               ///< Sets effective transformation stretches base values
     void AddThermalExpansion(const PhaseField& Phase, const Temperature& Tx);   ///< Calculates thermal expansion contribution to the transformation stretches
     void AddVegardsExpansion(const PhaseField& Phase, const Composition& Cx);   ///< Calculates Vegard's expansion contribution to the transformation stretches
@@ -282,6 +329,53 @@ class OP_EXPORTS ElasticProperties : public OPObject
     void ApplyLocalRotationsToElasticConstants(void);                           ///< Applies local rotations to elastic constants
 
     void CalculateDeformationJumps(const PhaseField& Phase);                    ///< Calculates deformation jumps from the Hadamard jump condition for all phase-field pairs
+
+    /* The deformation jumps are only calculated and stored in the interior
+    interface cells (JumpCells, taken from PhaseField::InterfaceCells). The
+    values of the previous call are cleared in the previous JumpCells only,
+    or in the whole domain if they are unknown (first call, remeshing).*/
+    std::vector<iVector3> JumpCells;                                            ///< Interior interface cells of the last deformation jumps calculation
+    bool JumpCellsValid = false;                                                ///< False if the jumps storages have to be cleared in the whole domain
+    void UpdateJumpCells(const PhaseField& Phase);                              ///< Clears the previous jumps and collects the current JumpCells
+
+    /* The acoustic tensor of a pair is (1 - phi_a)*C_a.project(n) +
+    (1 - phi_b)*C_b.project(n). The projected grain stiffnesses only depend on
+    the grain pair and the interface normal and are cached per thread for
+    normal buckets of edge JumpCacheTolerance. The caches are cleared if the
+    grain elastic constants change by more than JumpCacheTolerance relative
+    to the ones they were built with. Not used with locally varying elastic
+    constants (thermo- or chemo-mechanical coupling).*/
+    struct AcousticTensorKey                                                    ///< Grain pair and normal bucket
+    {
+        size_t alpha;
+        size_t beta;
+        std::array<long int,3> bucket;
+        bool operator==(const AcousticTensorKey& rhs) const
+        {
+            return alpha == rhs.alpha and beta == rhs.beta and bucket == rhs.bucket;
+        }
+    };
+    struct AcousticTensorKeyHash
+    {
+        size_t operator()(const AcousticTensorKey& key) const
+        {
+            size_t seed = key.alpha*0x9E3779B97F4A7C15ull ^ key.beta;
+            for(const long int b : key.bucket)
+            {
+                seed ^= std::hash<long int>()(b) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+    struct AcousticTensors                                                      ///< Grain stiffnesses projected onto the bucket normal
+    {
+        dMatrix3x3 Alpha;
+        dMatrix3x3 Beta;
+    };
+    static constexpr size_t MaxAcousticTensorCacheSize = 1 << 16;               ///< Entries per thread before the cache is cleared
+    std::vector<std::unordered_map<AcousticTensorKey, AcousticTensors, AcousticTensorKeyHash>> AcousticTensorCaches; ///< Per thread caches of the projected grain stiffnesses
+    std::vector<dMatrix6x6> AcousticTensorStiffness;                            ///< Grain elastic constants the caches were built with
+    void ValidateAcousticTensorCaches(void);                                    ///< Clears the caches if the grain elastic constants or the number of threads have changed
     void CalculateNonlocalJumpContribution(const PhaseField& Phase);            ///< Calculates non-local deformation jump contribution to the driving force
 };
 }// namespace openphase
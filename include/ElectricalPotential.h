@@ -29,6 +29,7 @@
 
 #include "fftw3.h"
 #include "Includes.h"
+#include "WaveVectors.h"
 
 namespace openphase
 {
@@ -58,6 +59,7 @@ class ElectricalPotential : public OPObject
                         const std::string InputFileName = DefaultInputFileName);
 
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override;                            /// allocating memory and reading parameters from the Settings object
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;                   /// reading the input parameters
     void ReadInput(std::stringstream& inp) override;                            /// reading the input parameters
     void QXYZ(void);                                                            /// generates the wave vector, copied from the spectral solver
@@ -82,7 +84,7 @@ class ElectricalPotential : public OPObject
 //        Storage3D<double>   Rho;                                              /// Storage for the charge density
 
     ///objects for Fourier methode
-    double*                 Q[3];                                               /// Wave vector
+    WaveVectors             Q;                                                  /// Wave vector
     double*                 RHS;                                                /// right hand side of the Poisson equation
     std::complex<double>*   ftRHS;                                              /// fourier transormed RHS
     double*                 rlPotential;                                        /// fourier transformed electrical potential
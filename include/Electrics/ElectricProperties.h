@@ -43,6 +43,7 @@ class OP_EXPORTS ElectricProperties : public OPObject
     ElectricProperties(Settings& locSettings,
          const std::string InputFileName = DefaultInputFileName);               ///< Constructs and initializes class
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override;                            ///< Allocates memory
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;                   ///< Reads the initial parameters for the interface diffusion
 	void ReadInput(std::stringstream& inp) override;                            ///< Reads the initial parameters for the interface diffusion
     void SetBoundaryConditions(const BoundaryConditions& BC) override;          ///< Sets boundary conditions for stored fields properties
@@ -29,6 +29,7 @@
 
 #include "Electrics/ElectricSolver.h"
 #include "fftw3.h"
+#include "WaveVectors.h"
 
 namespace openphase
 {
@@ -55,6 +56,7 @@ class OP_EXPORTS ElectricSolverSpectral : public ElectricSolver
     fftw_complex* freq;
     fftw_plan ForwardPlan;
     fftw_plan BackwardPlan;
+    WaveVectors Q;                                                              ///< Wave vectors of the local reciprocal space block
 
     size_t rlidx(long int i, long int j, long int k)
     {
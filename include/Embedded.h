@@ -0,0 +1,103 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef EMBEDDED_H
+#define EMBEDDED_H
+
+#include "Includes.h"
+#include "OutputField.h"
+
+namespace openphase
+{
+
+/* File-free operation for using OpenPhase as a sub-solver of another code.
+Input files can be provided from memory: SetInput() registers the content of
+an input file (OpenPhase input text or JSON) under its file name, all modules
+reading that file name through FileInterface::OpenInput() get the registered
+text instead of accessing the file system. Enable() switches to the embedded
+mode, in which no files are read or written by the library:
+
+    Embedded::Enable();
+    Embedded::SetInput(DefaultInputFileName, InputText);                        // or SetJSON() with a json object
+    Embedded::SetFieldSink([&](const std::string& Name,
+                               const std::vector<OutputField>& Fields,
+                               long int Nx, long int Ny, long int Nz){...});    // visualization output
+    Embedded::SetFileSink([&](const std::string& Name,
+                              const std::string& Data, bool Append){...});      // text output
+    Settings OPSettings(DefaultInputFileName);
+    ...
+
+In embedded mode
+  - input files which are not registered are reported as missing,
+  - the output directories are not created,
+  - VTK output (Write(), WriteCompressed(), WriteAppended() and the distorted
+    variants) hands the list of fields with the local grid size to the field
+    sink, the values are obtained with Field.Values<T>(Nx, Ny, Nz),
+  - CSVParser output and raw data written with AsyncOutput::WriteFile() are
+    passed to the file sink, with Append = true for appended lines,
+  - RunTimeControl::WriteRawData() returns false, the checkpoints of the
+    time loop are skipped.
+Output without a sink is discarded. The sinks are called from the thread
+writing the output and have to be thread safe if several simulations run
+concurrently (see Tools/Ensemble.h). Checkpoint, restart and HDF5 or ADIOS2
+output requested explicitly by the user code still access the file system. */
+
+class OP_EXPORTS Embedded                                                       ///< In-memory input and output of the library
+{
+ public:
+    static constexpr auto thisclassname = "Embedded";                           ///< Object's implementation class name
+
+    typedef std::function<void(const std::string& FileName,
+                               const std::vector<OutputField>& Fields,
+                               const long int Nx, const long int Ny,
+                               const long int Nz)> FieldSink_t;                 ///< Receiver of the visualization output
+    typedef std::function<void(const std::string& FileName,
+                               const std::string& Data,
+                               const bool Append)> FileSink_t;                  ///< Receiver of the text and raw data output
+
+    static void Enable(void);                                                   ///< Switches to the embedded mode without file system access
+    static void Disable(void);                                                  ///< Switches back to file based input and output
+    static bool Active(void);                                                   ///< True in embedded mode
+
+    static void SetInput(const std::string& FileName, const std::string& Text); ///< Registers the content of input file FileName
+    static void SetJSON(const std::string& FileName, const json& Data);         ///< Registers a JSON input file
+    static void RemoveInput(const std::string& FileName);                       ///< Removes a registered input file
+    static void ClearInputs(void);                                              ///< Removes all registered input files
+    static bool GetInput(const std::string& FileName, std::string& Text);       ///< Copies the registered content of FileName, returns false if not registered
+
+    static void SetFieldSink(FieldSink_t Sink);                                 ///< Sets the receiver of the visualization output
+    static void SetFileSink(FileSink_t Sink);                                   ///< Sets the receiver of the text and raw data output
+
+    static bool WriteFields(const std::string& FileName,
+                            const std::vector<OutputField>& Fields,
+                            const long int Nx, const long int Ny,
+                            const long int Nz);                                 ///< Passes visualization output to the field sink, returns false if not in embedded mode
+    static bool WriteFile(const std::string& FileName, const std::string& Data,
+                          const bool Append = false);                           ///< Passes file output to the file sink, returns false if not in embedded mode
+};
+
+}// namespace openphase
+#endif
@@ -71,6 +71,7 @@ class OP_EXPORTS EquilibriumPartitionDiffusionBinary : public OPObject
     void ReadInput(std::stringstream& inp) override;                            ///<  Reads input parameters from a file
     void Remesh(int newNx, int newNy, int newNz,
                 const BoundaryConditions& BC) override;                         ///<  Remesh the storage while keeping the data
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
 
     void CalculateDrivingForce(PhaseField& Phase,
                                Composition& Cx,
@@ -115,6 +116,8 @@ class OP_EXPORTS EquilibriumPartitionDiffusionBinary : public OPObject
     Tensor<double, 2> Slope;                                                    ///<  Pairwise liquidus slopes for a linear phase diagram
     Tensor<double, 2> Tcross;                                                   ///<  Pairwise temperatures of the liquidus-solidus or solvus lines intersections for a linear phase diagram
     Tensor<double, 2> Ccross;                                                   ///<  Pairwise concentrations of the liquidus-solidus or solvus lines intersections for a linear phase diagram
+    Tensor<double, 2> InvSlope;                                                 ///<  Inverse pairwise slopes (zero for vanishing slopes), set by SetPhaseDiagramTables()
+    Tensor<double, 2> Partitioning;                                             ///<  Pairwise partitioning coefficients, set by SetPhaseDiagramTables()
 
     std::vector<double> Entropy;                                                ///<  Entropies of different phases. Their differences are used in the driving force
 
@@ -132,12 +135,14 @@ class OP_EXPORTS EquilibriumPartitionDiffusionBinary : public OPObject
                                            int i, int j, int k);                ///<  Distributes the total concentrations into concentrations in each phase for a given point
     double EquilibriumComposition(size_t n, size_t m, double Temp);             ///<  Returns equilibrium composition for phase {n} in {n,m} phase pair
     double PartitioningCoefficient(size_t n, size_t m);                         ///<  Returns partitioning coefficient for phases {n,m}
+    void SetPhaseDiagramTables(void);                                           ///<  Precomputes the inverse slopes and partitioning coefficients of the linear phase diagram
 
     void CalculatePhaseConcentrations(PhaseField& Phase,
                                       Composition& Cx,
                                       Temperature& Tx);                         ///<  Distributes the total concentrations into concentrations in each phase
     void CalculateDiffusionIncrements(PhaseField& Phase,
-                                      Composition& Cx);                         ///<  Calculates Fick's diffusion composition increments
+                                      Composition& Cx,
+                                      const long int Reach = 0);                ///<  Calculates Fick's diffusion composition increments in the interior and Reach halo layers
     void CalculateChemicalPotentialContribution(PhaseField& Phase,
                                                 Composition& Cx,
                                                 Temperature& Tx);               ///<  Calculates diffusion due to externally supplied chemical potential contribution
@@ -147,7 +152,8 @@ class OP_EXPORTS EquilibriumPartitionDiffusionBinary : public OPObject
     void LimitDiffusionIncrements(PhaseField& Phase,
                                   Composition& Cx,
                                   Temperature& Tx);                             ///<  Limits Fick's diffusion concentration increments
-    void ApplyIncrements(PhaseField& Phase, Composition& Cx, double dt);        ///<  Apply the limited increments
+    void ApplyIncrements(PhaseField& Phase, Composition& Cx, double dt,
+                         const long int Reach = 0);                             ///<  Apply the limited increments in the interior and Reach halo layers
     void Solve1Dextension(Composition& Cx,
                           Temperature& Tx,
                           Composition1Dextension& CxExt,
@@ -0,0 +1,115 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef FFTBACKEND_H
+#define FFTBACKEND_H
+
+#ifdef MPI_PARALLEL
+#include "mpi_wrapper.h"
+#else
+#include "fftw3.h"
+#endif
+#ifdef CUFFT
+#include <cufft.h>
+#endif
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Precision of the spectral solver transforms. Compiling with
+-DSINGLE_PRECISION_FFT (SETTINGS="single-fft" in the Makefile build or
+-DENABLE_SINGLE_PRECISION_FFT=ON in the CMake build) transforms in single
+precision (fftwf or cuFFT R2C/C2R), halving the memory and bandwidth of the
+FFT arrays. Only supported in the serial build. */
+#ifdef SINGLE_PRECISION_FFT
+#ifdef MPI_PARALLEL
+#error "SINGLE_PRECISION_FFT is not supported in the MPI parallel build"
+#endif
+typedef float      fft_real;
+typedef fftwf_plan fft_plan;
+#else
+typedef double     fft_real;
+typedef fftw_plan  fft_plan;
+#endif
+
+class OP_EXPORTS FFTBackend                                                     ///< Batched 3D real to complex FFTs on the host (FFTW) or on the GPU (cuFFT)
+{
+    /* Transforms nComponents arrays stored one after another, each of
+    ComponentSize fft_real values in the padded in-place layout of FFTW: real index
+    "k + 2*Nz2*(j + Ny*i)", complex index "k + Nz2*(j + Ny*i)" with
+    Nz2 = Nz/2 + 1. The FFTW backend transforms the host array directly. The
+    cuFFT backend (compiled with -DCUFFT) keeps a copy of the arrays in
+    device memory: CopyToDevice() and CopyToHost() move components between
+    host and device, Forward() and Backward() transform the device arrays.
+    Data() returns the array the transforms work on, reciprocal space kernels
+    access it in OpenMP target regions (is_device_ptr) if OnDevice is true.
+    With FFTW the copies do nothing and Data() is the host array, so the
+    calling code is the same for both backends.*/
+ public:
+    FFTBackend(){};
+    ~FFTBackend(void);
+    FFTBackend(const FFTBackend&) = delete;
+    FFTBackend& operator=(const FFTBackend&) = delete;
+
+#ifdef CUFFT
+    static constexpr bool OnDevice = true;                                      ///< Transforms and reciprocal space data reside on the GPU
+#else
+    static constexpr bool OnDevice = false;                                     ///< Transforms and reciprocal space data reside on the host
+#endif
+
+    void Initialize(const int Nx, const int Ny, const int Nz,
+                    const size_t nComponents, const size_t ComponentSize,
+                    fft_real* HostData, const unsigned int flags);              ///< Creates the transforms of nComponents arrays of ComponentSize values stored in HostData
+    void Free(void);                                                            ///< Destroys the transforms and frees the device arrays
+
+    void Forward(void);                                                         ///< Real to complex transforms of all components
+    void Backward(void);                                                        ///< Complex to real transforms of all components (not normalized)
+    void CopyToDevice(const size_t first, const size_t count);                  ///< Copies components [first, first + count) to the device
+    void CopyToHost(const size_t first, const size_t count);                    ///< Copies components [first, first + count) to the host
+
+    fft_real* Data(void) const                                                    ///< Array the transforms work on (device memory with cuFFT)
+    {
+        return DeviceData;
+    }
+
+ private:
+    size_t nComp = 0;                                                           ///< Number of transformed components
+    size_t CompSize = 0;                                                        ///< Number of values per component
+    fft_real* HostData = nullptr;                                               ///< User array in host memory
+    fft_real* DeviceData = nullptr;                                             ///< Transformed array (HostData with FFTW)
+#ifdef CUFFT
+    cufftHandle ForwardPlan = 0;                                                ///< Batched D2Z (R2C) plan
+    cufftHandle BackwardPlan = 0;                                               ///< Batched Z2D (C2R) plan
+    bool Planned = false;                                                       ///< True if the cuFFT plans exist
+#else
+    fft_plan ForwardPlan = nullptr;                                             ///< Batched r2c plan
+    fft_plan BackwardPlan = nullptr;                                            ///< Batched c2r plan
+#endif
+};
+
+}// namespace openphase
+#endif
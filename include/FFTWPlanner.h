@@ -0,0 +1,97 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef FFTWPLANNER_H
+#define FFTWPLANNER_H
+
+#ifdef MPI_PARALLEL
+#include "mpi_wrapper.h"
+#else
+#include "fftw3.h"
+#endif
+#include "Includes.h"
+
+namespace openphase
+{
+
+class OP_EXPORTS FFTWPlanner                                                    ///< Planning rigor and wisdom persistence of the FFTW plans
+{
+    /* All FFTW plans of the spectral solvers are created with the flags
+    returned by Flags(). "Estimate" (default) plans instantly, "Measure",
+    "Patient" and "Exhaustive" time candidate algorithms and find faster plans
+    at the cost of a longer planning. The measured planning results (wisdom)
+    can be stored in WisdomDir: ImportWisdom() before and ExportWisdom() after
+    creating the plans make the expensive planning a one-time cost per
+    machine. The wisdom files are keyed by the global grid size, the number of
+    OpenMP threads and the number of MPI processes. In MPI parallel mode both
+    calls are collective: rank 0 reads and writes the file, the wisdom is
+    broadcast to and gathered from all ranks. Planning with measurement
+    overwrites the arrays passed to the planner, plans have to be created
+    before the arrays are filled. PlanR2C() and PlanC2R() hand out shared
+    serial plans: solvers of the same grid size borrow the same arrays from
+    the FFTWorkspace pool, so a plan for the same size and arrays is created
+    (and measured) only once and reference counted like the arrays.*/
+ public:
+    static void ReadInput(std::stringstream& inp, const int moduleLocation);    ///< Reads "FFTWPlanner" and "FFTWWisdomDir" from the Settings input
+    static void SetRigor(const std::string rigor);                              ///< Sets planning rigor: Estimate, Measure, Patient or Exhaustive
+    static void SetWisdomDir(const std::string dir);                            ///< Sets the wisdom directory, empty disables wisdom files
+
+    static unsigned int Flags(void);                                            ///< FFTW planner flags of the selected rigor
+    static void ImportWisdom(const long int Nx, const long int Ny,
+                             const long int Nz);                                ///< Loads the wisdom for the given global grid size, if present
+    static void ExportWisdom(const long int Nx, const long int Ny,
+                             const long int Nz);                                ///< Stores the accumulated wisdom for the given global grid size
+
+    static fftw_plan PlanR2C(const int Nx, const int Ny, const int Nz,
+                             double* in, fftw_complex* out);                    ///< Shared serial 3D r2c plan of the given arrays, created on the first request
+    static fftw_plan PlanC2R(const int Nx, const int Ny, const int Nz,
+                             fftw_complex* in, double* out);                    ///< Shared serial 3D c2r plan of the given arrays, created on the first request
+    static void ReleasePlan(fftw_plan plan);                                    ///< Returns a shared plan, destroys it if it is not used anymore
+
+    inline static std::string Rigor = "Estimate";                               ///< Planning rigor
+    inline static std::string WisdomDir = "";                                   ///< Directory of the wisdom files, empty if disabled
+
+ private:
+    static std::string WisdomFileName(const long int Nx, const long int Ny,
+                                      const long int Nz);                       ///< Wisdom file name for the current grid size, threads and MPI layout
+
+    struct SharedPlan                                                           ///< Plan held by the cache
+    {
+        fftw_plan    Plan;                                                      ///< FFTW plan
+        int          Sign;                                                      ///< FFTW_FORWARD (r2c) or FFTW_BACKWARD (c2r)
+        int          N[3];                                                      ///< Transform size
+        const void*  In;                                                        ///< Input array
+        const void*  Out;                                                       ///< Output array
+        unsigned int PlanFlags;                                                 ///< Planner flags the plan was created with
+        int          Users;                                                     ///< Number of solvers holding the plan
+    };
+    static SharedPlan* FindPlan(const int Sign, const int Nx, const int Ny,
+                                const int Nz, const void* in, const void* out); ///< Cached plan matching the request, nullptr if none
+    inline static std::vector<SharedPlan> Plans;                                ///< All shared plans
+};
+
+}// namespace openphase
+#endif
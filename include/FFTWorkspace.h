@@ -0,0 +1,68 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef FFTWORKSPACE_H
+#define FFTWORKSPACE_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+class OP_EXPORTS FFTWorkspace                                                   ///< Process-wide pool of FFT work arrays shared between the spectral solvers
+{
+    /* The spectral solvers keep their real and reciprocal space arrays only
+    as scratch memory during a single solve, nothing is kept in them from one
+    call to the next. Instead of allocating them per solver, the arrays are
+    borrowed from this pool: Acquire() returns an existing array of the
+    requested slot if it is large enough, otherwise a new one is allocated
+    (SIMD aligned by fftw_malloc). Solvers running one after another thus
+    share the same memory. Arrays of different slots never overlap, a solver
+    requesting several arrays at once uses a different slot for each. The
+    arrays are reference counted and freed by the last Release(). FFTW plans
+    may be created on the borrowed arrays, the addresses stay fixed while the
+    arrays are held. Note that planning with measurement overwrites the
+    arrays, and solvers sharing an array must not be called concurrently.
+    Initializing the solvers with the largest arrays first maximizes the
+    sharing. */
+ public:
+    static double* Acquire(const size_t nDoubles, const int slot);              ///< Borrows an array of at least nDoubles doubles from the given slot
+    static void Release(double* data);                                          ///< Returns a borrowed array, frees it if it is not used anymore
+    static size_t AllocatedMemory(void);                                        ///< Memory held by the pool in bytes
+
+ private:
+    struct Buffer                                                               ///< Array held by the pool
+    {
+        double* Data;                                                           ///< Array memory
+        size_t  Size;                                                           ///< Number of doubles
+        int     Slot;                                                           ///< Slot the array belongs to
+        int     Users;                                                          ///< Number of solvers holding the array
+    };
+    inline static std::vector<Buffer> Buffers;                                  ///< All arrays of the pool
+};
+
+}// namespace openphase
+#endif
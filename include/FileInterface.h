@@ -58,9 +58,19 @@ class OP_EXPORTS FileInterface
                                     int Index,
                                     std::string FileExtension);                 ///< Creates full filename string using the location directory, name base, running index and file extension
 
+    static void WriteRows(const std::string& FileName,
+                          const std::string& Header,
+                          const size_t Nrows,
+                          const std::function<void(std::ostream&,
+                                                   const size_t)>& Row);        ///< Writes Header followed by Nrows rows, the rows are formatted concurrently in contiguous chunks and written in order
+
+    static std::stringstream OpenInput(const std::string& FileName);            ///< Content of an input file, registered in memory (see Embedded.h) or read from disk, fail state set if missing
+
     // Methods to read input parameters from OpenPhase input files.
     // They search for $KEY in the entire file using the following syntax:
     // $KEY    commment    :   value
+    // The input text is parsed once into an index of its modules and keys,
+    // which is shared by all calls reading the same text.
 
     static bool ParameterPresent(const std::stringstream& Inp,                  ///< Checks if Key is present in the specified module, returns true if parameter is found and false otherwise
                                  const int location, std::string Key);
@@ -295,6 +295,40 @@ class OP_EXPORTS D3Q27
         }
     };
 
+    /// Appends the 9 populations with the velocity component "sign" (-1 or 1)
+    /// along "direction" (0, 1, 2 for x, y, z) to a data buffer. Only these
+    /// populations cross the corresponding domain face during streaming.
+    void packFace(std::vector<double>& buffer, const int direction, const int sign)
+    {
+        for (int a = -1; a <= 1; ++a)
+        for (int b = -1; b <= 1; ++b)
+        {
+            buffer.push_back(storage[FaceIndex(direction, sign, a, b)]);
+        }
+    };
+
+    /// Extracts the populations packed by packFace()
+    void unpackFace(std::vector<double>& buffer, size_t& it, const int direction, const int sign)
+    {
+        for (int a = -1; a <= 1; ++a)
+        for (int b = -1; b <= 1; ++b)
+        {
+            storage[FaceIndex(direction, sign, a, b)] = buffer[it];
+            ++it;
+        }
+    };
+
+    static size_t FaceIndex(const int direction, const int sign,
+                            const int a, const int b)                           ///< Index of the population (sign, a, b) with "sign" along "direction"
+    {
+        switch (direction)
+        {
+            case 0:  return 13 + 9*sign + 3*a + b;
+            case 1:  return 13 + 9*a + 3*sign + b;
+            default: return 13 + 9*a + 3*b + sign;
+        }
+    };
+
  protected:
     std::array<double, 27> storage;
 
@@ -307,5 +341,265 @@ class OP_EXPORTS D3Q27
     }
 };
 
+class OP_EXPORTS D3Q27Shifted                                                   ///< Single precision populations storage relative to the lattice weights
+{
+    /* Stores the deviation f - w*rho0 of each population from the lattice
+    weight w (rho0 = 1 in lattice units) as float. In the low Mach number
+    regime the populations stay close to w*rho0, so the stored deviations keep
+    most of the precision of double populations at half of the memory and
+    bandwidth. The node only stores the populations: reading converts to
+    double and all arithmetic is done in D3Q27. The weights (shifts) are set
+    once by the flow solver with SetShift().*/
+ public:
+    class Reference                                                             ///< Writable access to a single population
+    {
+     public:
+        Reference(float& value, const double shift) : Value(value), Shift(shift){};
+        operator double() const
+        {
+            return double(Value) + Shift;
+        };
+        Reference& operator=(const double value)
+        {
+            Value = value - Shift;
+            return *this;
+        };
+        Reference& operator=(const Reference& rhs)
+        {
+            return *this = double(rhs);
+        };
+        Reference& operator+=(const double value)
+        {
+            Value = double(Value) + value;
+            return *this;
+        };
+        Reference& operator-=(const double value)
+        {
+            Value = double(Value) - value;
+            return *this;
+        };
+        Reference& operator*=(const double value)
+        {
+            return *this = double(*this) * value;
+        };
+        Reference& operator/=(const double value)
+        {
+            return *this = double(*this) / value;
+        };
+     private:
+        float& Value;
+        const double Shift;
+    };
+
+    D3Q27Shifted()
+    {
+        set_to_zero();
+    };
+
+    D3Q27Shifted(const D3Q27& rhs)
+    {
+        *this = rhs;
+    };
+
+    D3Q27Shifted& operator=(const D3Q27& rhs)
+    {
+        for (int i = 0; i < 27; ++i)
+        {
+            storage[i] = rhs.const_data()[i] - Shift[i];
+        }
+        return *this;
+    };
+
+    operator D3Q27() const
+    {
+        D3Q27 locPopulations;
+        for (int i = 0; i < 27; ++i)
+        {
+            locPopulations.data()[i] = double(storage[i]) + Shift[i];
+        }
+        return locPopulations;
+    };
+
+    Reference operator()(int x, int y, int z)
+    {
+        assert(std::abs(x) < 2);
+        assert(std::abs(y) < 2);
+        assert(std::abs(z) < 2);
+
+        return Reference(storage[idx(x,y,z)], Shift[idx(x,y,z)]);
+    };
+
+    double operator()(int x, int y, int z) const
+    {
+        assert(std::abs(x) < 2);
+        assert(std::abs(y) < 2);
+        assert(std::abs(z) < 2);
+
+        return double(storage[idx(x,y,z)]) + Shift[idx(x,y,z)];
+    };
+
+    void set_to_zero()
+    {
+        for (int i = 0; i < 27; ++i)
+        {
+            storage[i] = -Shift[i];
+        }
+    };
+
+    D3Q27 operator* (const double value) const
+    {
+        return D3Q27(*this) * value;
+    };
+
+    D3Q27Shifted& operator*=(const double value)
+    {
+        return *this = D3Q27(*this) * value;
+    };
+
+    D3Q27 operator/ (const double value) const
+    {
+        return D3Q27(*this) / value;
+    };
+
+    D3Q27Shifted& operator/=(const double value)
+    {
+        return *this = D3Q27(*this) / value;
+    };
+
+    D3Q27 operator+ (const D3Q27& rhs) const
+    {
+        return D3Q27(*this) + rhs;
+    };
+
+    D3Q27Shifted& operator+=(const D3Q27& rhs)
+    {
+        // The shift cancels, only the deviation is updated
+        for (int i = 0; i < 27; ++i)
+        {
+            storage[i] = double(storage[i]) + rhs.const_data()[i];
+        }
+        return *this;
+    };
+
+    D3Q27 operator- (const D3Q27& rhs) const
+    {
+        return D3Q27(*this) - rhs;
+    };
+
+    D3Q27Shifted& operator-=(const D3Q27& rhs)
+    {
+        for (int i = 0; i < 27; ++i)
+        {
+            storage[i] = double(storage[i]) - rhs.const_data()[i];
+        }
+        return *this;
+    };
+
+    float* data()                                                               ///< Stored deviations, increments can be applied directly
+    {
+        return storage.data();
+    };
+
+    D3Q27 inverted(void) const
+    {
+        return D3Q27(*this).inverted();
+    };
+
+    D3Q27 inverted(int x, int y, int z) const
+    {
+        return D3Q27(*this).inverted(x,y,z);
+    };
+
+    D3Q27 Xreflected(void) const
+    {
+        return D3Q27(*this).Xreflected();
+    };
+
+    D3Q27 Yreflected(void) const
+    {
+        return D3Q27(*this).Yreflected();
+    };
+
+    D3Q27 Zreflected(void) const
+    {
+        return D3Q27(*this).Zreflected();
+    };
+
+    /// Appends the (unshifted) populations to a data buffer, e.g. for
+    /// MPI-node communication
+    void pack(std::vector<double>& buffer)
+    {
+        for (int i = 0; i < 27; ++i)
+        {
+            buffer.push_back(double(storage[i]) + Shift[i]);
+        }
+    };
+
+    /// Extracts populations from a data buffer
+    void unpack(std::vector<double>& buffer, size_t& it)
+    {
+        for (int i = 0; i < 27; ++i)
+        {
+            storage[i] = buffer[it] - Shift[i];
+            ++it;
+        }
+    };
+
+    /// Appends the (unshifted) populations crossing a domain face, see
+    /// D3Q27::packFace()
+    void packFace(std::vector<double>& buffer, const int direction, const int sign)
+    {
+        for (int a = -1; a <= 1; ++a)
+        for (int b = -1; b <= 1; ++b)
+        {
+            const size_t i = D3Q27::FaceIndex(direction, sign, a, b);
+            buffer.push_back(double(storage[i]) + Shift[i]);
+        }
+    };
+
+    /// Extracts the populations packed by packFace()
+    void unpackFace(std::vector<double>& buffer, size_t& it, const int direction, const int sign)
+    {
+        for (int a = -1; a <= 1; ++a)
+        for (int b = -1; b <= 1; ++b)
+        {
+            const size_t i = D3Q27::FaceIndex(direction, sign, a, b);
+            storage[i] = buffer[it] - Shift[i];
+            ++it;
+        }
+    };
+
+    static void SetShift(const double weights[3][3][3])                         ///< Sets the shifts to the lattice weights (call before populations are stored)
+    {
+        for (int x = -1; x <= 1; x++)
+        for (int y = -1; y <= 1; y++)
+        for (int z = -1; z <= 1; z++)
+        {
+            Shift[13 + 9*x + 3*y + z] = weights[x+1][y+1][z+1];
+        }
+    };
+
+ protected:
+    std::array<float, 27> storage;
+
+ private:
+    size_t idx(int x, int y, int z) const
+    {
+        size_t index = 13 + 9*x + 3*y + z;
+        assert(index < 27);
+        return index;
+    }
+    inline static double Shift[27] = {
+        1.0/216.0, 1.0/54.0, 1.0/216.0, 1.0/54.0, 2.0/27.0, 1.0/54.0, 1.0/216.0, 1.0/54.0, 1.0/216.0,
+        1.0/54.0,  2.0/27.0, 1.0/54.0,  2.0/27.0, 8.0/27.0, 2.0/27.0, 1.0/54.0,  2.0/27.0, 1.0/54.0,
+        1.0/216.0, 1.0/54.0, 1.0/216.0, 1.0/54.0, 2.0/27.0, 1.0/54.0, 1.0/216.0, 1.0/54.0, 1.0/216.0};   ///< Subtracted values (D3Q27 weights by default)
+};
+
+#ifdef SINGLE_PRECISION_POPULATIONS
+typedef D3Q27Shifted lbnode_t;                                                  ///< Populations storage of the flow solver
+#else
+typedef D3Q27        lbnode_t;
+#endif
+
 } //namespace openphase
 #endif
@@ -30,6 +30,7 @@
 
 #include "Includes.h"
 #include "FluidDynamics/D3Q27.h"
+#include "FluidDynamics/LBDeviceSolver.h"
 
 namespace openphase
 {
@@ -45,6 +46,29 @@ class Settings;
 class Temperature;
 class Velocities;
 
+struct LBKernelTimes                                                            ///< Wall clock times accumulated by FlowSolverLBM::Solve() [s]
+{
+    double ObstacleDetection = 0.0;                                             ///< Obstacle detection and obstacle nodes
+    double Propagation       = 0.0;                                             ///< Streaming, bounce back and moments
+    double Forces            = 0.0;                                             ///< Density boundary conditions and force densities
+    double Collision         = 0.0;                                             ///< Collision and moments
+    double Velocities        = 0.0;                                             ///< Macroscopic boundary conditions and fluid velocities
+    size_t Steps = 0;                                                           ///< Number of time steps
+
+    double Total(void) const
+    {
+        return ObstacleDetection + Propagation + Forces + Collision + Velocities;
+    }
+    void Reset(void)
+    {
+        *this = LBKernelTimes();
+    }
+    static double Now(void)
+    {
+        return double(mygettime())/OP_CLOCKS_PER_SEC;
+    }
+};
+
 class OP_EXPORTS FlowSolverLBM : public OPObject                                ///< Calculation of fluid flow and advective solute transport
 {
 public:
@@ -56,6 +80,8 @@ public:
     void ReadInput(std::stringstream& inp) override;                            ///< Reads input parameters from a stringstream
     void Remesh(int newNx, int newNy, int newNz,
                 const BoundaryConditions& BC) override;
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
 
     static D3Q27 EquilibriumDistribution(double lbDensity,
             const double weights[3][3][3], dVector3 lbMomentum = {0.0,0.0,0.0});
@@ -70,7 +96,7 @@ public:
     double BounceBack(const int i, const int j, const int k,
             const int ii, const int jj, const int kk, const size_t n,
             PhaseField& Phase, const BoundaryConditions& BC,
-            double& lbDensityChange); 
+            double& lbDensityChange, Tensor<sum_vector3_t,2>& GrainForces);     ///< BounceBack at Solid Interfaces, adds force ({n,0}) and torque ({n,1}) of grain n to GrainForces
     double SecondOrderBounceBack(const int i, const int j, const int k,
             const int ii, const int jj, const int kk, const size_t n,
             PhaseField& Phase, const BoundaryConditions& BC,
@@ -94,17 +120,23 @@ public:
     void CalculateFluidVelocities(Velocities& Vel, const PhaseField& Phase,
             const BoundaryConditions& BC) const;                                ///< Calculates Fluid velocities
     void CalculateForceDrag(const int i, const int j, const int k,
-            PhaseField& Phase, const Velocities& Vel);                          ///< Force contribution of surface drag
+            PhaseField& Phase, const Velocities& Vel,
+            Tensor<sum_vector3_t,2>& GrainForces);                              ///< Force contribution of surface drag, adds force ({n,0}) and torque ({n,1}) of grain n to GrainForces
     void CalculateForceGravity(PhaseField& Phase);                              ///< Force contribution of Gravitation
     void CalculateForceGravity(PhaseField& Phase, const Composition& Cx);       ///< Force contribution of Gravitation considering liquid composition
     void CalculateForceTwoPhase(const int i, const int j, const int k,
-            PhaseField& Phase);                                                 ///< Force contribution according to Benzi
+            PhaseField& Phase, Tensor<sum_vector3_t,2>& GrainForces);           ///< Force contribution according to Benzi, adds force ({n,0}) and torque ({n,1}) of grain n to GrainForces
     double CalculateLocalIncomingSolidDensityChange(PhaseField& Phase, int i, int j, int k);
     void AcountForAndLimitPhaseTransformation(PhaseField& Phase, int tStep);    ///< Add/Removes fluid mass according to phase changes
     void Collision();                                                           ///< Processes the collisions. Adjusts center of mass properties of colliding particles
     void DetectObstaclesAdvection(const PhaseField& Phase,
             const Velocities &Vel, const BoundaryConditions& BC);               ///< Detects Obstacles (Detects change of obstacles for advection)
     void DetectObstacles(const PhaseField& Phase);                              ///< Detects Obstacles
+    void SynchronizePopulations(void);                                          ///< Copies the device populations to lbPopulations (call before modifying lbPopulations outside of Solve with Offload)
+    void InvalidateFluidNodes(void)                                             ///< Marks the fluid cell list for rebuild (call if Obstacle is changed from outside)
+    {
+        FluidNodesValid = false;
+    }
     void EnforceMassConservation(void);                                         ///< Enforces fluid mass conservation for advectional problems
     void EnforceTotalMassConservation(PhaseField& Phase);                       ///< Enforces total mass conservation (solid and fluid)
     void EnforceSolidMomentum(PhaseField& Phase, const dVector3 value);         ///< Enforces solid momentum conservation
@@ -136,6 +168,7 @@ public:
     bool LocalObstacle(const int i, const int j, const int k,
             const PhaseField& Phase) const;                                     ///< Returns true if obstacle has been detected at (i,j,k)
     void Update_dt(double _dt);                                                 ///< Calculates one time step of the Navier-Stokes solver
+    void AllocateThermalCompressibility(void);                                  ///< Allocates the thermal compressibility storages on first use
     void SetInitialPopulationsTC(BoundaryConditions& BC , Velocities& Vel);     ///< Initializing the populations when thermal compressibility considered
     void CollisionTC(Velocities& Vel);
     void CalculateHydrodynamicPressureAndMomentum(Velocities& Vel);
@@ -165,19 +198,20 @@ public:
     double FluidDensity(const int i, const int j, const int k) const;          ///< Returns local fluid mass density summed over all components
     double Density(const PhaseField& Phase, const int i, const int j, const int k) const; ///< Returns local mass density including solids
 
-    Storage3D< D3Q27,    1 > lbPopulations;                                     ///< Populations (discretized particle distribution functions) PDF)
-    Storage3D< D3Q27,    1 > lbPopulationsTMP;                                  ///< Temporary array for Populations PDF propagation
+    Storage3D< lbnode_t, 1 > lbPopulations;                                     ///< Populations (discretized particle distribution functions) PDF)
+    Storage3D< lbnode_t, 1 > lbPopulationsTMP;                                  ///< Temporary array for Populations PDF propagation (not allocated with in place streaming unless needed)
     Storage3D< int,      0 > Obstacle;                                          ///< 1 if Node is solid
     Storage3D< int,      0 > ObstacleAppeared;                                  ///< True if obstacle node appeared
     Storage3D< int,      0 > ObstacleChangedDensity;                            ///< True if nearby obstacle changed local density
     Storage3D< int,      0 > ObstacleVanished;                                  ///< True if obstacle node vanished
     Storage3D< dVector3, 1 > ForceDensity;                                      ///< Force density
     Storage3D< dVector3, 1 > MomentumDensity;                                   ///< Momentum density
-    Storage3D< double,   1 > DensityWetting;                                    ///< Fluid density / Solid wetting parameter
-    Storage3D< double,   1 > nut;                                               ///< kinematic viscosity in lattice units when thermal compressibility considered
-    Storage3D< double,   1 > HydroPressure;                                     ///< Hydrolic Pressure for each lattice when thermal compressibility considered
-    Storage3D< double,   1 > DivVel;                                            ///< Divergence of velocity when thermal compressibility considered
-    Storage3D< dVector3, 1 > GradRho;                                           ///< Gradient of density when thermal compressibility considered
+    Storage3D< real_t,   1 > DensityWetting;                                    ///< Fluid density / Solid wetting parameter (single precision with SINGLE_PRECISION_STORAGE)
+    Storage3D< double,   1 > nut;                                               ///< kinematic viscosity in lattice units when thermal compressibility considered, allocated on first use
+    Storage3D< double,   1 > HydroPressure;                                     ///< Hydrolic Pressure for each lattice when thermal compressibility considered, allocated on first use
+    Storage3D< double,   1 > DivVel;                                            ///< Divergence of velocity when thermal compressibility considered, allocated on first use
+    Storage3D< dVector3, 1 > GradRho;                                           ///< Gradient of density when thermal compressibility considered, allocated on first use
+    Storage3D< double,   1 > InteractionPotential;                              ///< Two phase interaction potential (Benzi psi or Kupershtokh Phi) of DensityWetting, set in ApplyForces() and allocated on first use
 
     bool Do_Benzi;                                                              ///< Set to "true" if Benzi force should be calculated
     bool Do_BounceBack;                                                         ///< Set to "true" for the fluid bounce back at the interface (not energy conserving with mobile solids)
@@ -191,7 +225,12 @@ public:
     bool Do_TwoPhase;                                                           ///< Set to "true" if two phase flow should be calculated
     bool Do_ThermalComp;                                                        ///< Set to "true" if thermal compressibility considered
     bool Do_DI;                                                        			///< Set to "true" if the interface considered diffuse
+    bool InPlaceStreaming;                                                      ///< Set to "true" to stream the populations in place (lbPopulationsTMP is only allocated on demand)
+    bool Offload;                                                               ///< Set to "true" to keep the populations on the device (OpenMP target offload), requires periodic boundaries and no grain bounce back
+    bool SparseFluidNodes;                                                      ///< Set to "true" to visit only the listed fluid cells in collision and propagation (pays off for large solid fractions)
+    std::string Lattice;                                                        ///< Velocity set of 3D simulations: D3Q27 (default), D3Q19 or D3Q15 (zero weights on D3Q27 nodes, same storage)
     bool ObstaclesChanged;                                                      ///< True if an obstacle changed
+    LBKernelTimes KernelTimes;                                                  ///< Time spent in the steps of Solve()
 
     bool GradRho_Upwind; 
     bool GradRho_Central; 
@@ -256,6 +295,38 @@ public:
     std::vector<std::vector<double>> lbGK;                                      ///< Parameter for Kupershtohk
 
 protected:
+private:
+    void StreamPopulations(const long int i, const long int j, const long int k,
+            PhaseField& Phase, const BoundaryConditions& BC,
+            Tensor<sum_vector3_t,2>& GrainForces);                              ///< Streams the populations of all fluid components into cell (i,j,k)
+    void PropagationInPlace(PhaseField& Phase, const BoundaryConditions& BC,
+            const bool CalculateMoments);                                       ///< Propagates Populations in place using two plane buffers, optionally updates density and momentum in the same sweep
+    double BounceBack(const int i, const int j, const int k,
+            const int ii, const int jj, const int kk, const size_t n,
+            const D3Q27& Populations, PhaseField& Phase,
+            double& lbDensityChange, Tensor<sum_vector3_t,2>& GrainForces);     ///< BounceBack using the given pre-streaming populations of cell (i,j,k)
+    void CalculateDensityAndMomentum(const long int i, const long int j,
+            const long int k);                                                  ///< Calculates Density and momentum of cell (i,j,k) from lbPopulations
+    void AllocateTemporaryPopulations(void);                                    ///< Allocates lbPopulationsTMP if it was omitted for in place streaming
+    void CalculateInteractionPotential(void);                                   ///< Evaluates the two phase interaction potential once per cell for CalculateForceTwoPhase()
+    void PropagationSparse(PhaseField& Phase, const BoundaryConditions& BC);    ///< Propagates Populations of the listed fluid cells only
+    void CollisionCell(const long int i, const long int j, const long int k);   ///< Applies the body force collision to cell (i,j,k)
+    void UpdateFluidNodes(void);                                                ///< Rebuilds the fluid cell list if the obstacles changed
+    uint32_t BounceBackMask(const long int i, const long int j,
+            const long int k) const;                                            ///< Bit 13+9*ii+3*jj+kk is set if population (ii,jj,kk) of cell (i,j,k) is streamed from an obstacle
+    bool OffloadSupported(const BoundaryConditions& BC) const;                  ///< Checks if the device kernels cover the selected model
+    void InitializeOffload(const BoundaryConditions& BC);                       ///< Allocates the device arrays and uploads populations and obstacles
+    void PropagationOffload(const BoundaryConditions& BC);                      ///< Propagates Populations on the device and updates density and momentum
+    void CollisionOffload(void);                                                ///< Collision on the device, updates density and momentum
+    LBDeviceSolver Device;                                                      ///< Device resident populations for Offload
+    std::vector<iVector3> FluidNodes;                                           ///< Interior fluid cells in storage order
+    std::vector<uint32_t> FluidNodesBounceBack;                                 ///< Bounce back directions of the listed fluid cells
+    std::vector<size_t> FluidNodesPlaneBegin;                                   ///< Position of the first listed fluid cell of each x-plane
+    bool FluidNodesValid = false;                                               ///< True if the fluid cell list matches Obstacle
+    static Tensor<sum_vector3_t,2> GrainForcesTensor(const PhaseField& Phase);  ///< Zero force ({n,0}) and torque ({n,1}) contributions of all grains
+    static void AddGrainForces(PhaseField& Phase,
+            const ThreadLocalAccumulator<Tensor<sum_vector3_t,2>>& GrainForces); ///< Adds the accumulated force and torque contributions to the grains
+    void SetMacroscopicBoundaryConditions(const BoundaryConditions& BC);        ///< Sets boundary conditions for the densities and momenta only
 };
 
 inline double FlowSolverLBM::FluidDensity(const int i, const int j, const int k,
@@ -75,15 +75,32 @@ class OP_EXPORTS InteractionSolidSolid: public OPObject
     std::vector<std::vector<double>> elastic;
     std::vector<AggregateStates> PhaseAggregateStates;                          ///< Aggregate states of all phases
 
+    struct Contacts_t                                                           ///< Result of the grain level broad phase
+    {
+        std::vector<double> Radius;                                             ///< Bounding sphere radius of each grain around its center of mass in grid cells, negative if not applicable
+        std::vector<std::vector<size_t>> Partners;                              ///< Sorted indices of the grains whose bounding spheres are closer than the cutoff
+        bool empty() const
+        {
+            for(auto& P : Partners) if(not P.empty()) return false;
+            return true;
+        }
+    };
+
+    Contacts_t BroadPhase(const PhaseField& Phase,
+            const BoundaryConditions& BC) const;                                ///< Finds the grain pairs which can interact using bounding spheres sorted into a spatial hash (collective)
+
     void CalculateLocal(const int i, const int j, const int k,
-            PhaseField& Phase,
+            const PhaseField& Phase,
             const BoundaryConditions& BC,
-            const double dt) const;                                             ///< Calculates the solid-solid interaction at the point (i,j,k)
+            const Contacts_t& Contacts,
+            const double dt,
+            Tensor<sum_vector3_t,2>& GrainForces) const;                        ///< Calculates the solid-solid interaction at the point (i,j,k), adds force ({n,0}) and torque ({n,1}) of grain n to GrainForces
 
     void CalculateLocalWang(const int i, const int j, const int k,
-            PhaseField& Phase,
+            const PhaseField& Phase,
             const BoundaryConditions& BC,
-            const std::function<double(int,int,int)>& MassDensity) const;       ///< Calculates the solid-solid interaction at the point (i,j,k) for the Wang model
+            const std::function<double(int,int,int)>& MassDensity,
+            Tensor<sum_vector3_t,2>& GrainForces) const;                        ///< Calculates the solid-solid interaction at the point (i,j,k) for the Wang model, adds force ({n,0}) and torque ({n,1}) of grain n to GrainForces
 
     static bool applicable(const Grain& grain)
     {
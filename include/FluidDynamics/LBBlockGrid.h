@@ -0,0 +1,147 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo; Raphael Schiedung
+ *
+ */
+
+#ifndef LBBLOCKGRID_H
+#define LBBLOCKGRID_H
+
+#include "Includes.h"
+#include "FluidDynamics/D3Q27.h"
+
+namespace openphase
+{
+
+class OP_EXPORTS LBBlockGrid                                                    ///< Block-structured, locally refined D3Q27 lattice Boltzmann grid
+{
+    /* The domain is divided into cubic blocks of BlockSize^3 cells. Blocks
+    close to obstacles are replaced by 2^3 child blocks with half the grid
+    spacing and half the time step (acoustic scaling), recursively up to
+    MaxLevel. Every block keeps its populations in its own Storage3D. During
+    one time step of level l, level l+1 performs two sub-steps.
+
+    The coupling of two levels is volumetric: populations are densities, a
+    coarse cell is the union of its eight children. The coarse cells next to
+    a refined block (margin cells) are mirrored at the fine level by ghost
+    cells, which carry populations but do not collide. After the coarse
+    collision the ghost cells receive the populations of their parent
+    (explosion), the fine level streams through the ghost cells twice, and the
+    margin cells are set to the average of their children (coalescence). Each
+    population thus moves as a parcel of mass, which makes the exchange
+    between the levels exactly mass conserving. The interface is first order
+    accurate, the non-equilibrium parts are not rescaled.
+
+    Lengths, times, densities and forces are given in lattice units of the
+    coarsest level (level 0). The relaxation time of level l is
+    2^l*(tau - 1/2) + 1/2, which keeps the kinematic viscosity constant.
+    Blocks are refined if an obstacle is found within two cells around them,
+    and only if all 26 neighbor blocks exist at the same level, so each
+    refined region is surrounded by at least one block of the next coarser
+    level. Only three-dimensional domains are supported.*/
+ public:
+    void Initialize(const long int nx, const long int ny, const long int nz,
+                    const int blocksize, const int maxlevel, const double tau,
+                    const dVector3 acceleration, const std::array<bool,3> periodic,
+                    const std::function<bool(double,double,double)>& IsObstacle); ///< Builds the block hierarchy, "IsObstacle" is evaluated at cell centers in level 0 units
+    void SetEquilibrium(const double rho, const dVector3 u);                    ///< Sets all populations to the equilibrium distribution
+
+    void Step(void);                                                            ///< Advances all levels by one level 0 time step
+
+    double Mass(void) const;                                                    ///< Total mass of the fluid (level 0 units)
+    dVector3 ObstacleForce(void) const                                          ///< Force on the obstacles during the last time step (level 0 units)
+    {
+        return Force;
+    }
+    bool Velocity(const double x, const double y, const double z,
+                  dVector3& u) const;                                           ///< Velocity at the given point taken from the finest level present there
+    size_t CellUpdates(void) const;                                             ///< Fluid cell updates per level 0 time step
+    size_t FluidCells(const int level) const;                                   ///< Number of fluid cells of the given level
+    int Levels(void) const
+    {
+        return Level.size();
+    }
+
+ private:
+    enum BlockStates
+    {
+        Absent  = -1,                                                           ///< Region belongs to a coarser level
+        Refined = -2,                                                           ///< Region is covered by the next finer level
+        Outside = -3                                                            ///< Position outside a non-periodic domain
+    };
+    enum CellFlags
+    {
+        ObstacleCell = 1,                                                       ///< Solid cell (halfway bounce back)
+        MarginCell   = 2,                                                       ///< Fluid cell next to the next finer level, updated by coalescence
+        TrackedCell  = 4                                                        ///< Ghost cell mirroring a margin cell of the next coarser level
+    };
+
+    struct Block
+    {
+        long int X0 = 0;                                                        ///< First cell in x direction (level cells)
+        long int Y0 = 0;                                                        ///< First cell in y direction (level cells)
+        long int Z0 = 0;                                                        ///< First cell in z direction (level cells)
+        bool Ghost = false;                                                     ///< Block holds ghost cells of a coarser level
+        Storage3D<D3Q27,0> Populations[2];                                      ///< Current and streaming target populations
+        Storage3D<int,0> Flags;                                                 ///< CellFlags of every cell
+    };
+
+    struct GridLevel
+    {
+        long int Nx = 0;                                                        ///< Number of cells in x direction
+        long int Ny = 0;                                                        ///< Number of cells in y direction
+        long int Nz = 0;                                                        ///< Number of cells in z direction
+        long int NBx = 0;                                                       ///< Number of blocks in x direction
+        long int NBy = 0;                                                       ///< Number of blocks in y direction
+        long int NBz = 0;                                                       ///< Number of blocks in z direction
+        double tau = 1.0;                                                       ///< Relaxation time
+        dVector3 Acceleration;                                                  ///< Body force per unit mass (level units)
+        double Volume = 1.0;                                                    ///< Cell volume in level 0 units
+        int Current = 0;                                                        ///< Index of the current population storage
+        std::vector<int> BlockMap;                                              ///< Block index or BlockStates of every block position
+        std::vector<Block> Blocks;                                              ///< Fluid blocks and ghost blocks
+    };
+
+    int BlockSize = 0;                                                          ///< Number of cells per block edge
+    std::array<bool,3> Periodic = {true, true, true};                           ///< Periodic boundaries, otherwise walls
+    std::vector<GridLevel> Level;                                               ///< Levels, 0 is the coarsest
+    dVector3 Force;                                                             ///< Force on the obstacles during the last time step
+
+    int Locate(const int l, long int& X, long int& Y, long int& Z) const;       ///< Wraps the cell position, returns its block index or BlockStates
+    void BuildLevel(const int l,
+                    const std::function<bool(double,double,double)>& IsObstacle); ///< Sets the cell flags of level l
+    bool ObstacleNearBlock(const int l, const long int bx, const long int by,
+                    const long int bz,
+                    const std::function<bool(double,double,double)>& IsObstacle) const; ///< Refinement criterion of a block of level l
+
+    void Advance(const int l, const int substep);                               ///< Collision, sub-steps of finer levels, streaming and coalescence of level l
+    void Collide(const int l);
+    void Explode(const int l);                                                  ///< Copies margin cells of level l to the ghost cells of level l+1
+    void Stream(const int l, const int substep);
+    void Coalesce(const int l);                                                 ///< Averages the ghost cells of level l+1 into the margin cells of level l
+    double CoarseParcel(const int l, long int X, long int Y, long int Z,
+                        const int q, const int substep) const;                  ///< Population of an untracked position of level l taken from level l-1
+};
+
+} //namespace openphase
+#endif
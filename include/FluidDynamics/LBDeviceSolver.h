@@ -0,0 +1,95 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo; Raphael Schiedung
+ *
+ */
+
+#ifndef LBDEVICESOLVER_H
+#define LBDEVICESOLVER_H
+
+#include "Includes.h"
+#include "FluidDynamics/D3Q27.h"
+
+namespace openphase
+{
+
+class OP_EXPORTS LBDeviceSolver                                                 ///< Device resident populations and lattice Boltzmann kernels (OpenMP target offload)
+{
+    /* The populations of all interior cells are kept in device memory as one
+    array per direction and fluid component (cell index (i*Ny + j)*Nz + k).
+    Propagation, bounce back, collision and the moment calculation run as
+    OpenMP target regions on these arrays, only the force density is copied
+    to the device and the density and momentum are copied back per time step.
+    The kernels assume periodic boundaries in all directions and resting
+    obstacles (no-slip halfway bounce back without grain forces).
+    Without offload support of the compiler the target regions are executed
+    on the host.*/
+ public:
+    LBDeviceSolver(void){};
+    ~LBDeviceSolver(void);
+    LBDeviceSolver(const LBDeviceSolver&) = delete;
+    LBDeviceSolver& operator=(const LBDeviceSolver&) = delete;
+
+    void Allocate(const GridParameters& Grid, const size_t ncomp,
+                  const double weights[3][3][3]);                               ///< Allocates the device arrays for the interior cells of Grid
+    void Release(void);                                                         ///< Frees the device arrays
+    bool IsAllocated(void) const
+    {
+        return Ncells != 0;
+    }
+
+    void CopyPopulationsToDevice(const Storage3D<lbnode_t,1>& Populations);     ///< Uploads the populations of the interior cells
+    void CopyPopulationsToHost(Storage3D<lbnode_t,1>& Populations) const;       ///< Downloads the populations of the interior cells
+    void CopyObstacleToDevice(const Storage3D<int,0>& Obstacle);                ///< Uploads the obstacle flags
+    void CopyForceDensityToDevice(const Storage3D<dVector3,1>& ForceDensity,
+                                  const double df);                             ///< Uploads the force density in lattice units
+    void CopyMomentsToHost(Storage3D<real_t,1>& Density,
+            Storage3D<dVector3,1>& Momentum, const Storage3D<int,0>& Obstacle,
+            const double dRho, const double dm);                                ///< Downloads density and momentum of the fluid cells in physical units
+
+    void Propagate(void);                                                       ///< Pull streaming with bounce back at obstacles
+    void CalculateMoments(const bool FixPopulations);                           ///< Density and momentum of all cells, optionally resets nonpositive populations to equilibrium
+    void CollisionGuo(const std::vector<double>& tau);                          ///< BGK collision with Guo forcing
+    void CollisionED(const std::vector<double>& tau, const double ForceScale);  ///< BGK collision with exact difference forcing, force increment of the momentum is ForceScale*F
+
+ private:
+    long int Nx = 0;                                                            ///< Number of interior cells in x direction
+    long int Ny = 0;                                                            ///< Number of interior cells in y direction
+    long int Nz = 0;                                                            ///< Number of interior cells in z direction
+    int dNx = 0;                                                                ///< Active x dimension (0 or 1)
+    int dNy = 0;                                                                ///< Active y dimension (0 or 1)
+    int dNz = 0;                                                                ///< Active z dimension (0 or 1)
+    size_t Ncomp = 0;                                                           ///< Number of fluid components
+    size_t Ncells = 0;                                                          ///< Number of interior cells
+    double Weights[27] = {};                                                    ///< Lattice weights, direction q = 9*(x+1) + 3*(y+1) + (z+1)
+
+    double* Populations = nullptr;                                              ///< Populations, index (n*27 + q)*Ncells + cell
+    double* PopulationsTMP = nullptr;                                           ///< Streaming target
+    double* Density = nullptr;                                                  ///< Density in lattice units, index n*Ncells + cell
+    double* Momentum = nullptr;                                                 ///< Momentum density in lattice units, index (n*3 + d)*Ncells + cell
+    double* Force = nullptr;                                                    ///< Force density in lattice units, index (n*3 + d)*Ncells + cell
+    int* Obstacle = nullptr;                                                    ///< Obstacle flags
+};
+
+} //namespace openphase
+#endif
@@ -0,0 +1,101 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2012
+ *   Main contributors :   Oleg Shchyglo; Raphael Schiedung
+ *
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo; Raphael Schiedung
+ *
+ */
+
+#ifndef LBLATTICES_H
+#define LBLATTICES_H
+
+#include <array>
+
+namespace openphase
+{
+
+/* Compile-time descriptors of the three-dimensional lattice Boltzmann
+lattices. Each descriptor provides the number of discrete velocities Q, the
+velocities c[q] and the weights w[q]. Directions are ordered lexicographically
+in (x,y,z) as in D3Q27, so that the rest population comes first for the
+reduced lattices and D3Q27Lattice matches the D3Q27 node storage. Index[]
+maps the D3Q27 position 13 + 9*x + 3*y + z of a velocity to its lattice index
+(-1 if the velocity is not part of the lattice).*/
+
+struct D3Q27Lattice                                                             ///< Full 27 velocity lattice
+{
+    static constexpr int Q = 27;
+    static constexpr int c[Q][3] = {
+        {-1,-1,-1},{-1,-1, 0},{-1,-1, 1},{-1, 0,-1},{-1, 0, 0},{-1, 0, 1},{-1, 1,-1},{-1, 1, 0},{-1, 1, 1},
+        { 0,-1,-1},{ 0,-1, 0},{ 0,-1, 1},{ 0, 0,-1},{ 0, 0, 0},{ 0, 0, 1},{ 0, 1,-1},{ 0, 1, 0},{ 0, 1, 1},
+        { 1,-1,-1},{ 1,-1, 0},{ 1,-1, 1},{ 1, 0,-1},{ 1, 0, 0},{ 1, 0, 1},{ 1, 1,-1},{ 1, 1, 0},{ 1, 1, 1}};
+    static constexpr double w[Q] = {
+        1.0/216.0, 1.0/54.0, 1.0/216.0, 1.0/54.0, 2.0/27.0, 1.0/54.0, 1.0/216.0, 1.0/54.0, 1.0/216.0,
+        1.0/54.0,  2.0/27.0, 1.0/54.0,  2.0/27.0, 8.0/27.0, 2.0/27.0, 1.0/54.0,  2.0/27.0, 1.0/54.0,
+        1.0/216.0, 1.0/54.0, 1.0/216.0, 1.0/54.0, 2.0/27.0, 1.0/54.0, 1.0/216.0, 1.0/54.0, 1.0/216.0};
+    static constexpr int Index[27] = {
+         0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26};
+};
+
+struct D3Q19Lattice                                                             ///< Rest, face and edge velocities (no corners)
+{
+    static constexpr int Q = 19;
+    static constexpr int c[Q][3] = {
+                   {-1,-1, 0},            {-1, 0,-1},{-1, 0, 0},{-1, 0, 1},            {-1, 1, 0},
+        { 0,-1,-1},{ 0,-1, 0},{ 0,-1, 1},{ 0, 0,-1},{ 0, 0, 0},{ 0, 0, 1},{ 0, 1,-1},{ 0, 1, 0},{ 0, 1, 1},
+                   { 1,-1, 0},            { 1, 0,-1},{ 1, 0, 0},{ 1, 0, 1},            { 1, 1, 0}};
+    static constexpr double w[Q] = {
+                   1.0/36.0,           1.0/36.0, 1.0/18.0, 1.0/36.0,           1.0/36.0,
+        1.0/36.0,  1.0/18.0, 1.0/36.0, 1.0/18.0, 1.0/3.0,  1.0/18.0, 1.0/36.0, 1.0/18.0, 1.0/36.0,
+                   1.0/36.0,           1.0/36.0, 1.0/18.0, 1.0/36.0,           1.0/36.0};
+    static constexpr int Index[27] = {
+        -1, 0,-1, 1, 2, 3,-1, 4,-1, 5, 6, 7, 8, 9,10,11,12,13,-1,14,-1,15,16,17,-1,18,-1};
+};
+
+struct D3Q15Lattice                                                             ///< Rest, face and corner velocities (no edges)
+{
+    static constexpr int Q = 15;
+    static constexpr int c[Q][3] = {
+        {-1,-1,-1},{-1,-1, 1},{-1, 0, 0},{-1, 1,-1},{-1, 1, 1},
+        { 0,-1, 0},{ 0, 0,-1},{ 0, 0, 0},{ 0, 0, 1},{ 0, 1, 0},
+        { 1,-1,-1},{ 1,-1, 1},{ 1, 0, 0},{ 1, 1,-1},{ 1, 1, 1}};
+    static constexpr double w[Q] = {
+        1.0/72.0, 1.0/72.0, 1.0/9.0, 1.0/72.0, 1.0/72.0,
+        1.0/9.0,  1.0/9.0,  2.0/9.0, 1.0/9.0,  1.0/9.0,
+        1.0/72.0, 1.0/72.0, 1.0/9.0, 1.0/72.0, 1.0/72.0};
+    static constexpr int Index[27] = {
+         0,-1, 1,-1, 2,-1, 3,-1, 4,-1, 5,-1, 6, 7, 8,-1, 9,-1,10,-1,11,-1,12,-1,13,-1,14};
+};
+
+template<class Lattice>
+void SetLatticeWeights(double weights[3][3][3])                                 ///< Sets weights[x+1][y+1][z+1] of all lattice velocities (others are left unchanged)
+{
+    for(int q = 0; q < Lattice::Q; q++)
+    {
+        weights[Lattice::c[q][0]+1][Lattice::c[q][1]+1][Lattice::c[q][2]+1] = Lattice::w[q];
+    }
+}
+
+} //namespace openphase
+#endif
@@ -0,0 +1,226 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2012
+ *   Main contributors :   Oleg Shchyglo; Raphael Schiedung
+ *
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo; Raphael Schiedung
+ *
+ */
+
+#ifndef LBPOPULATIONSSOA_H
+#define LBPOPULATIONSSOA_H
+
+#include "Includes.h"
+#include "GridParameters.h"
+#include "FluidDynamics/D3Q27.h"
+#include "FluidDynamics/LBLattices.h"
+
+namespace openphase
+{
+
+template<class Lattice>
+class LBPopulationsSoA                                                          ///< Lattice Boltzmann populations of all cells stored as structure of arrays
+{
+    /* Storage3D<D3Q27,1> keeps the 27 populations of a node next to each other
+    (array of structures), so a sweep over one direction accesses memory with
+    a stride of 27 doubles. Here each direction of each fluid component is a
+    separate contiguous array over all cells (including boundary cells), with
+    the same cell ordering as Storage3D. Every array starts at an
+    OP_SIMD_ALIGNMENT aligned address, so loops over the cells of one
+    direction vectorize, and streaming along a direction reduces to a shift of
+    the whole array. The lattice (D3Q27Lattice, D3Q19Lattice or D3Q15Lattice
+    from LBLattices.h) is a template parameter, only its Q directions are
+    stored. FlowSolverLBM does not use this storage, its forcing, bounce back,
+    halo exchange and raw data I/O address whole D3Q27 nodes; the layout is
+    exercised by the LBMPopulationLayout benchmark only.*/
+ public:
+    void Allocate(const GridParameters& Grid, const size_t ncomp,
+                  const long int bcells)                                        ///< Allocates the populations of "ncomp" fluid components for the given grid
+    {
+        Allocate(Grid.Nx, Grid.Ny, Grid.Nz, bcells*Grid.dNx, bcells*Grid.dNy,
+                 bcells*Grid.dNz, ncomp);
+    }
+    void Allocate(const long int nx, const long int ny, const long int nz,
+                  const long int bx, const long int by, const long int bz,
+                  const size_t ncomp)                                           ///< Allocates the populations for nx*ny*nz cells with bx, by, bz boundary cells
+    {
+        Size_X = nx; Size_Y = ny; Size_Z = nz;
+        BcellsX = bx; BcellsY = by; BcellsZ = bz;
+        Size_X_BC = nx + 2*bx;
+        Size_Y_BC = ny + 2*by;
+        Size_Z_BC = nz + 2*bz;
+        Ncomp = ncomp;
+
+        const size_t Pad = OP_SIMD_ALIGNMENT/sizeof(double);
+        Ncells = Size_X_BC*Size_Y_BC*Size_Z_BC;
+        Stride = ((Ncells + Pad - 1)/Pad)*Pad;
+        Data.assign(Stride*Lattice::Q*Ncomp, 0.0);
+    }
+    bool IsAllocated(void) const
+    {
+        return Data.size() != 0;
+    }
+    size_t AllocatedMemory(void) const                                          ///< Memory held by the storage in bytes
+    {
+        return Data.capacity()*sizeof(double);
+    }
+
+    size_t Index(const long int i, const long int j, const long int k) const    ///< Position of cell (i,j,k) within each direction array
+    {
+        assert(i >= -BcellsX and i < Size_X + BcellsX && "Access beyond storage range");
+        assert(j >= -BcellsY and j < Size_Y + BcellsY && "Access beyond storage range");
+        assert(k >= -BcellsZ and k < Size_Z + BcellsZ && "Access beyond storage range");
+        return ((i + BcellsX)*Size_Y_BC + j + BcellsY)*Size_Z_BC + k + BcellsZ;
+    }
+    long int Offset(const int x, const int y, const int z) const                ///< Index distance between a cell and its neighbor in direction (x,y,z)
+    {
+        return (x*Size_Y_BC + y)*Size_Z_BC + z;
+    }
+    double* data(const size_t n, const int x, const int y, const int z)         ///< Direction array (x,y,z) of fluid component n
+    {
+        return Data.data() + (n*Lattice::Q + Direction(x,y,z))*Stride;
+    }
+    const double* data(const size_t n, const int x, const int y, const int z) const
+    {
+        return Data.data() + (n*Lattice::Q + Direction(x,y,z))*Stride;
+    }
+    double* data(const size_t n, const int q)                                   ///< Direction array q (lattice numbering) of fluid component n
+    {
+        return Data.data() + (n*Lattice::Q + q)*Stride;
+    }
+    const double* data(const size_t n, const int q) const
+    {
+        return Data.data() + (n*Lattice::Q + q)*Stride;
+    }
+
+    double& operator()(const long int i, const long int j, const long int k,
+                       const size_t n, const int x, const int y, const int z)   ///< Population (x,y,z) of fluid component n in cell (i,j,k)
+    {
+        return data(n,x,y,z)[Index(i,j,k)];
+    }
+    double operator()(const long int i, const long int j, const long int k,
+                      const size_t n, const int x, const int y, const int z) const
+    {
+        return data(n,x,y,z)[Index(i,j,k)];
+    }
+
+    D3Q27 Get(const long int i, const long int j, const long int k,
+              const size_t n) const                                             ///< Gathers the populations of cell (i,j,k), directions not in the lattice are zero
+    {
+        D3Q27 locPopulations;
+        const size_t idx = Index(i,j,k);
+        for(int q = 0; q < Lattice::Q; q++)
+        {
+            locPopulations(Lattice::c[q][0], Lattice::c[q][1], Lattice::c[q][2]) = data(n,q)[idx];
+        }
+        return locPopulations;
+    }
+    void Set(const long int i, const long int j, const long int k,
+             const size_t n, const D3Q27& locPopulations)                       ///< Scatters the populations of cell (i,j,k), directions not in the lattice are dropped
+    {
+        const size_t idx = Index(i,j,k);
+        for(int q = 0; q < Lattice::Q; q++)
+        {
+            data(n,q)[idx] = locPopulations(Lattice::c[q][0], Lattice::c[q][1], Lattice::c[q][2]);
+        }
+    }
+
+    void Import(const Storage3D<D3Q27,1>& Populations)                          ///< Copies populations (including boundary cells) from the node-wise layout
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Populations,Populations.Bcells(),)
+        for (size_t n = 0; n < Ncomp; ++n)
+        {
+            Set(i,j,k,n,Populations(i,j,k,{n}));
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
+    void Export(Storage3D<D3Q27,1>& Populations) const                          ///< Copies populations (including boundary cells) into the node-wise layout
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Populations,Populations.Bcells(),)
+        for (size_t n = 0; n < Ncomp; ++n)
+        {
+            Populations(i,j,k,{n}) = Get(i,j,k,n);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
+
+    void Stream(void)                                                           ///< Streams all populations in place, requires up to date boundary cells
+    {
+        /* Population (x,y,z) arriving in cell idx comes from idx - Offset(x,y,z),
+        so each direction array is shifted by its offset. Values shifted out
+        of the array only belong to boundary cells, which have to be set again
+        afterwards. Directions are independent and processed in parallel.*/
+        #pragma omp parallel for collapse(2) schedule(dynamic,1)
+        for (size_t n = 0; n < Ncomp; ++n)
+        for (int q = 0; q < Lattice::Q; ++q)
+        {
+            const long int shift = Offset(Lattice::c[q][0], Lattice::c[q][1], Lattice::c[q][2]);
+            double* f = data(n,q);
+            if (shift > 0)
+            {
+                std::memmove(f + shift, f, (Ncells - shift)*sizeof(double));
+            }
+            else if (shift < 0)
+            {
+                std::memmove(f, f - shift, (Ncells + shift)*sizeof(double));
+            }
+        }
+    }
+
+    long int sizeX(void) const {return Size_X;};
+    long int sizeY(void) const {return Size_Y;};
+    long int sizeZ(void) const {return Size_Z;};
+    long int bcellsX(void) const {return BcellsX;};
+    long int bcellsY(void) const {return BcellsY;};
+    long int bcellsZ(void) const {return BcellsZ;};
+    size_t NumberOfComponents(void) const {return Ncomp;};
+
+ private:
+    static int Direction(const int x, const int y, const int z)                 ///< Lattice index of direction (x,y,z)
+    {
+        assert(std::abs(x) < 2 and std::abs(y) < 2 and std::abs(z) < 2);
+        assert(Lattice::Index[13 + 9*x + 3*y + z] >= 0 && "Direction is not part of the lattice");
+        return Lattice::Index[13 + 9*x + 3*y + z];
+    }
+
+    long int Size_X = 0;                                                        ///< Number of cells in x direction
+    long int Size_Y = 0;                                                        ///< Number of cells in y direction
+    long int Size_Z = 0;                                                        ///< Number of cells in z direction
+    long int BcellsX = 0;                                                       ///< Number of boundary cells in x direction
+    long int BcellsY = 0;                                                       ///< Number of boundary cells in y direction
+    long int BcellsZ = 0;                                                       ///< Number of boundary cells in z direction
+    long int Size_X_BC = 0;                                                     ///< Number of cells in x direction including boundary cells
+    long int Size_Y_BC = 0;                                                     ///< Number of cells in y direction including boundary cells
+    long int Size_Z_BC = 0;                                                     ///< Number of cells in z direction including boundary cells
+    size_t Ncells = 0;                                                          ///< Number of cells including boundary cells
+    size_t Stride = 0;                                                          ///< Padded length of one direction array
+    size_t Ncomp = 0;                                                           ///< Number of fluid components
+    StorageVector<double> Data;                                                 ///< Direction arrays of all components
+};
+
+typedef LBPopulationsSoA<D3Q27Lattice> D3Q27SoA;
+typedef LBPopulationsSoA<D3Q19Lattice> D3Q19SoA;
+typedef LBPopulationsSoA<D3Q15Lattice> D3Q15SoA;
+
+} //namespace openphase
+#endif
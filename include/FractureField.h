@@ -107,6 +107,7 @@ class FractureField : public OPObject
                 const double tStep) override;                                            ///< Advects phase-fields
     
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override; ///< Changes the mesh size while keeping the data.
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void SetBoundaryConditions(const BoundaryConditions& BC) override;                   ///< Set boundary conditions
 
     bool Read(const Settings& locSettings,const BoundaryConditions& BC, 
@@ -149,8 +150,8 @@ class FractureField : public OPObject
     Storage3D<double, 0> Flag;                                                           /// Storage for flags indicating the state of the fracture field
     Storage3D<dVector3, 0> DisplacementsOLD;                                             /// Storage for the Old displacements for the Advection
     Storage3D<double, 0> SurfaceEnergy;                                                     ///< Storage for the crack tip values
-    Storage3D<double, 0> TestOutput;                                                     ///< Storage for the crack tip values
-    Storage3D<double, 0> TestOutput2;                                                     ///< Storage for the crack tip values
+    Storage3D<double, 0> TestOutput;                                                     ///< Storage for the crack tip values, allocated on first use in debug builds
+    Storage3D<double, 0> TestOutput2;                                                     ///< Storage for the crack tip values, allocated on first use in debug builds
     
     FractureField& operator= (const FractureField& rhs);
 
@@ -162,6 +163,8 @@ class FractureField : public OPObject
     GridParameters Grid;
     double PFcutOff;                                                               ///< Cut-off value for the Fracture Field for creating a PhaseField
     void MergeIncrements(const BoundaryConditions& BC, const double dt);                 ///< Merges the increments into the phase fields
+    void SetCrackBand(void);                                                    ///< Rebuilds the crack band cell lists from the current flags (only needed if Flag is modified outside of this class)
+    bool CrackBand;                                                             ///< Restricts the solver to the cells around the crack instead of sweeping the whole grid
   protected:
   private:
     void Clear();                                                                        ///< Clears the phase field storage
@@ -175,6 +178,36 @@ class FractureField : public OPObject
     };
     void CalculateCrackTip();
 
+    /* Crack band: the cells with nonzero flag (crack cells and their
+    neighbours) or nonzero fracture field, rebuilt by Finalize() if CrackBand
+    is set. Increments, Laplacians and merging of the increments loop over
+    these lists only. BandValid is reset by every method which sets flags or
+    moves the fracture field outside of the band.*/
+    std::vector<iVector3> BandCells;                                            ///< Interior cells of the crack band in storage order
+    std::vector<iVector3> BandBoundaryCells;                                    ///< Boundary cells of the crack band in storage order
+    bool BandValid;                                                             ///< True if the band cell lists are up to date
+
+    template<class Function>
+    void ForEachCrackCell(Function f)                                           ///< Calls f(i,j,k) for the interior cells of the crack band, or for all interior cells if there is no valid band
+    {
+        if (CrackBand and BandValid)
+        {
+            OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i, j, k, BandCells, )
+            {
+                f(i, j, k);
+            }
+            OMP_PARALLEL_CELL_LIST_LOOP_END
+        }
+        else
+        {
+            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, 0, )
+            {
+                f(i, j, k);
+            }
+            OMP_PARALLEL_STORAGE_LOOP_END
+        }
+    }
+
     double iWidth;                                                              ///< Interface width in grid points
     double RefVolume;                                                           ///< Reference volume for the nucleation
     double Xi;                                                                  ///< hydrogen degrading coefficient for fracture energy
@@ -31,6 +31,7 @@
 #include <string>
 #include <complex>
 #include <iostream>
+#include <vector>
 
 #ifndef _OPENMP
     // overloading several OpenMP methods used in OpenPhase for serial operation
@@ -83,8 +84,13 @@
     extern int MPI_CART_RANK[3];                                                ///< Cartesian coordinates of the current process if using MPI 3D domain decomposition
     extern int MPI_CART_SIZE[3];                                                ///< Number of processes used in each direction if using MPI 3D domain decomposition
     extern bool MPI_3D_DECOMPOSITION;                                           ///< "true" if MPI should decompose in 3 dimensions
+    extern bool MPI_CART_NODE_AWARE;                                            ///< "true" if the ranks of a node should form compact blocks of the MPI 3D domain decomposition
+    extern std::vector<int> MPI_CART_PROCESS;                                   ///< Rank of the process at each position of the MPI 3D domain decomposition (row-major), empty for the row-major order of the ranks
+    extern std::vector<int> MPI_CART_CUTS[3];                                   ///< Cut planes of the MPI 3D domain decomposition in each direction (MPI_CART_SIZE + 1 global coordinates, empty for equal boxes), see LoadBalancer.h
 #endif
 
+extern int OMP_TILE_SIZE[3];                                                    ///< Tile sizes used by OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN (0 selects the default tile size)
+
 namespace openphase
 {
 
@@ -111,6 +117,7 @@ inline void OP_Exit(int exit_code)
 #endif
 }
 static constexpr int EXIT_H5_ERROR = 5;                                         ///< OpenPhase not compiled for HDF5 support
+static constexpr int EXIT_ADIOS2_ERROR = 6;                                     ///< OpenPhase not compiled for ADIOS2 support
 static constexpr int EXIT_NUCMODE_ERROR = 16;
 static constexpr int EXIT_CONTROLMODE_ERROR = 10;
 static constexpr int EXIT_LATENTHEATMODE_ERROR = 13;
@@ -123,6 +130,17 @@ static constexpr int EXIT_LATENTHEATMODE_ERROR = 13;
 
 static constexpr double Pi = 3.14159265358979323846;                            ///< Pi constant value
 
+/* Value type of bandwidth-bound storages which do not require double
+precision. Compiling with -DSINGLE_PRECISION_STORAGE (SETTINGS="single-storage"
+in the Makefile build or -DENABLE_SINGLE_PRECISION_STORAGE=ON in the CMake
+build) stores them as float, halving their memory footprint and bandwidth.
+Computations and accumulators using these values stay in double precision. */
+#ifdef SINGLE_PRECISION_STORAGE
+typedef float  real_t;
+#else
+typedef double real_t;
+#endif
+
 const std::complex< double > I(0.0, 1.0);                                       ///< sqrt(-1) declaration
 
 // Special keywords
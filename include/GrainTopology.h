@@ -0,0 +1,113 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef GRAINTOPOLOGY_H
+#define GRAINTOPOLOGY_H
+
+#include "Includes.h"
+#include <unordered_map>
+
+namespace openphase
+{
+
+/* Grain neighbour graph maintained during time stepping. The local contacts
+count the interior cells with exactly two phase fields for each pair of grains,
+the same cells MicrostructureAnalysis::GrainGraph() counts after a full scan.
+During merging the owning PhaseField subtracts the pairs of each interface cell
+before and adds them after the update:
+
+    Topology.BeginIncrements();
+    ... Topology.AddCell(Fields(i,j,k), -1); merge; Topology.AddCell(Fields(i,j,k), +1);
+    Topology.ApplyIncrements();
+
+Only the pairs whose local count appears or vanishes are recorded as events,
+Synchronize() exchanges them between the MPI ranks and updates the global
+adjacency lists, its cost is proportional to the number of topological changes
+since the last call. A full Scan() replaces the incremental update if the phase
+fields were modified otherwise (e.g. nucleation, combining of phase fields). */
+
+class OP_EXPORTS GrainTopology                                                  ///< Incrementally updated neighbour graph of the grains
+{
+ public:
+    static constexpr auto thisclassname = "GrainTopology";                      ///< Object's implementation class name
+
+    static uint64_t Key(const size_t alpha, const size_t beta)                  ///< Key of the unordered grain pair (alpha, beta)
+    {
+        return (uint64_t(std::min(alpha, beta)) << 32) | uint64_t(std::max(alpha, beta));
+    }
+
+    void Scan(const Storage3D<NodePF,0>& Fields);                               ///< Rebuilds the local contacts from the interior cells, the next Synchronize() rebuilds the global graph
+    void Clear(void);                                                           ///< Invalidates the local contacts, the next update has to be a Scan()
+    bool Valid(void) const                                                      ///< True if the local contacts can be updated incrementally
+    {
+        return Scanned;
+    }
+    void BeginIncrements(void);                                                 ///< Resets the per-thread contact changes, has to be called outside of parallel regions
+    bool Pending(void) const                                                    ///< True if contact changes have to be applied in ApplyIncrements()
+    {
+        return IncrementsPending;
+    }
+    void AddCell(const NodePF& locPF, const long int sign)                      ///< Adds sign times the grain pair of a two-grain cell to the contact changes of the calling thread
+    {
+        if(locPF.size() != 2) return;
+        const uint64_t key = Key(locPF.cbegin()->index, (locPF.cbegin()+1)->index);
+        Increments.Local()[key] += sign;
+    }
+    void ApplyIncrements(void);                                                 ///< Adds the contact changes to the local contacts and records the appearing and vanishing pairs
+    bool Check(const Storage3D<NodePF,0>& Fields);                              ///< Compares the local contacts with a full scan and replaces them by it, returns false on deviation
+    void Synchronize(void);                                                     ///< Updates the global graph from the recorded events of all MPI ranks (collective)
+
+    size_t NumberOfNeighbours(const size_t idx) const                           ///< Number of neighbours of grain idx in the global graph
+    {
+        return (idx < Neighbours.size()) ? Neighbours[idx].size() : 0;
+    }
+    const std::vector<size_t>& NeighboursOf(const size_t idx) const;            ///< Sorted neighbours of grain idx in the global graph
+    size_t NumberOfGrains(void) const                                           ///< Size of the global graph (largest grain index + 1)
+    {
+        return Neighbours.size();
+    }
+    void Edges(std::vector<size_t>& Row, std::vector<size_t>& Col) const;       ///< Pairs (Row[n] < Col[n]) of the global graph in ascending order
+    size_t NumberOfEvents(void) const                                           ///< Number of local topological changes since the last Synchronize()
+    {
+        return Events.size();
+    }
+
+ private:
+    std::unordered_map<uint64_t, long int> LocalContacts;                       ///< Number of two-grain interior cells of each grain pair in the local domain
+    ThreadLocalAccumulator<std::unordered_map<uint64_t, long int>> Increments;  ///< Contact changes of the current merge step accumulated per thread
+    std::vector<std::pair<uint64_t, int>> Events;                               ///< Local pairs which appeared (+1) or vanished (-1) since the last Synchronize()
+    std::unordered_map<uint64_t, int> PairRanks;                                ///< Number of MPI ranks which have a contact of each grain pair
+    std::vector<std::vector<size_t>> Neighbours;                                ///< Sorted adjacency lists of the global graph
+    bool Scanned = false;                                                       ///< True if LocalContacts are valid
+    bool IncrementsPending = false;                                             ///< True if Increments have to be added in ApplyIncrements()
+    bool Rebuild = true;                                                        ///< True if the global graph has to be rebuilt from LocalContacts
+
+    void Connect(const uint64_t key);                                           ///< Adds the edge of a grain pair to the adjacency lists
+    void Disconnect(const uint64_t key);                                        ///< Removes the edge of a grain pair from the adjacency lists
+};
+
+}// namespace openphase
+#endif
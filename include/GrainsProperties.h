@@ -30,6 +30,7 @@
 #include "Includes.h"
 #include "Settings.h"
 #include "H5Interface.h"
+#include "Tools/MisorientationCache.h"
 
 namespace openphase
 {
@@ -82,7 +83,7 @@ class Grain
     bool is_gas()    const {return State == AggregateStates::Gas;};
     bool is_fluid()  const {return State != AggregateStates::Solid;};
 
-    void Read(std::ifstream& inp)                                               ///< Reads grains info from a given file stream
+    void Read(std::istream& inp)                                                ///< Reads grains info from a given file stream
     {
         inp.read(reinterpret_cast<char*>(&Exist        ), sizeof(bool));
         inp.read(reinterpret_cast<char*>(&Mobile       ), sizeof(bool));
@@ -398,6 +399,51 @@ class Grain
     {
         return Exist;
     };
+
+    /* Rotations derived from Orientation for the per-cell code. They are
+    recomputed by UpdateRotations() only if the orientation has changed since
+    the previous call, which has to happen outside of parallel regions. */
+    void UpdateRotations(void) const                                            ///< Updates the cached rotations if the orientation has changed
+    {
+        if(not RotationsUpToDate())
+        {
+            const dMatrix3x3 R = Quaternion(Orientation).RotationMatrix;
+            CachedRotationMatrix  = R;
+            CachedRotationMatrixT = R.transposed();
+            CachedVoigtRotation   = dMatrix6x6::RotationOperator(R);
+            for(size_t i = 0; i < 4; i++) CachedOrientation[i] = Orientation[i];
+        }
+    }
+    bool RotationsUpToDate(void) const                                          ///< True if the cached rotations match the orientation
+    {
+        for(size_t i = 0; i < 4; i++)
+        if(CachedOrientation[i] != Orientation[i])
+        {
+            return false;
+        }
+        return true;
+    }
+    const dMatrix3x3& RotationMatrix(void) const                                ///< Cached rotation matrix of the orientation
+    {
+        assert(RotationsUpToDate() && "Grain: outdated rotations, call UpdateRotations()");
+        return CachedRotationMatrix;
+    }
+    const dMatrix3x3& RotationMatrixTransposed(void) const                      ///< Cached transposed (inverse) rotation matrix
+    {
+        assert(RotationsUpToDate() && "Grain: outdated rotations, call UpdateRotations()");
+        return CachedRotationMatrixT;
+    }
+    const dMatrix6x6& VoigtRotation(void) const                                 ///< Cached rotation operator of 6x6 Voigt tensors, see dMatrix6x6::RotationOperator()
+    {
+        assert(RotationsUpToDate() && "Grain: outdated rotations, call UpdateRotations()");
+        return CachedVoigtRotation;
+    }
+
+ private:
+    mutable std::array<double,4> CachedOrientation{{NAN, NAN, NAN, NAN}};       ///< Orientation of the cached rotations, NAN forces the first update
+    mutable dMatrix3x3 CachedRotationMatrix;                                    ///< Rotation matrix of CachedOrientation
+    mutable dMatrix3x3 CachedRotationMatrixT;                                   ///< Transposed rotation matrix of CachedOrientation
+    mutable dMatrix6x6 CachedVoigtRotation;                                     ///< Voigt rotation operator of CachedOrientation
 };
 
 class GrainsProperties
@@ -417,6 +463,8 @@ class GrainsProperties
         {
             GrainsStorage[idx].Clear();
         }
+        FreeIndicesValid = false;
+        Misorientations.Clear();
     }
     void Reallocate(const size_t size)
     {
@@ -430,6 +478,7 @@ class GrainsProperties
         {
             GrainsStorage[idx].Clear();
         }
+        FreeIndicesValid = false;
     }
     Grain& operator[](const size_t index)
     {
@@ -444,12 +493,20 @@ class GrainsProperties
     GrainsProperties& operator=(const GrainsProperties& rhs)
     {
         GrainsStorage   = rhs.GrainsStorage;
+        FreeIndicesValid = false;
         return *this;
     }
     size_t size() const
     {
         return GrainsStorage.size();
     }
+    MisorientationCache::Entry Misorientation(const size_t indexA,
+                                              const size_t indexB) const        ///< Cubic disorientation of two grains, cached per grain pair
+    {
+        assert (indexA < GrainsStorage.size() and indexB < GrainsStorage.size());
+        return Misorientations.Get(indexA, GrainsStorage[indexA].Orientation,
+                                   indexB, GrainsStorage[indexB].Orientation);
+    }
     double GrainRadius(const Grain& grain, int dim = 3) const
     {
         switch (dim)
@@ -707,9 +764,17 @@ class GrainsProperties
     }
     size_t add_grain(const size_t PhaseIndex)
     {
-        for(size_t i = 0; i != GrainsStorage.size(); i++)
-        if(not GrainsStorage[i].Exist)
+        if(not FreeIndicesValid)
+        {
+            UpdateFreeIndices();
+        }
+        while(not FreeIndices.empty())
         {
+            // The smallest free index is reused first
+            const size_t i = FreeIndices.back();
+            FreeIndices.pop_back();
+            if(i >= GrainsStorage.size() or GrainsStorage[i].Exist) continue;
+
             GrainsStorage[i].Clear();
             GrainsStorage[i].Exist = true;
             GrainsStorage[i].Phase = PhaseIndex;
@@ -728,6 +793,48 @@ class GrainsProperties
         GrainsStorage.push_back(locGrain);
         return GrainsStorage.size() - 1;
     }
+    void UpdateFreeIndices(void)                                                ///< Collects the indices of vanished grains for reuse in add_grain()
+    {
+        FreeIndices.clear();
+        for(size_t idx = GrainsStorage.size(); idx-- > 0;)
+        if(not GrainsStorage[idx].Exist)
+        {
+            FreeIndices.push_back(idx);
+        }
+        FreeIndicesValid = true;
+    }
+    size_t NumberOfFreeIndices(void)                                            ///< Number of vanished grain indices available for reuse
+    {
+        if(not FreeIndicesValid)
+        {
+            UpdateFreeIndices();
+        }
+        return FreeIndices.size();
+    }
+    std::vector<size_t> Compact(void)                                           ///< Removes vanished grains and shifts the remaining ones to the front. Returns the new index of each old index (SIZE_MAX for removed grains)
+    {
+        std::vector<size_t> NewIndex(GrainsStorage.size(), SIZE_MAX);
+        size_t count = 0;
+        for(size_t idx = 0; idx < GrainsStorage.size(); idx++)
+        if(GrainsStorage[idx].Exist)
+        {
+            NewIndex[idx] = count;
+            if(count != idx)
+            {
+                GrainsStorage[count] = GrainsStorage[idx];
+            }
+            count++;
+        }
+        GrainsStorage.resize(count);
+        for(auto& grain : GrainsStorage)
+        if(grain.Parent < NewIndex.size())
+        {
+            grain.Parent = (NewIndex[grain.Parent] != SIZE_MAX) ? NewIndex[grain.Parent] : 0;
+        }
+        FreeIndices.clear();
+        FreeIndicesValid = true;
+        return NewIndex;
+    }
     bool PhasePresent(size_t pIndex) const
     {
         for(size_t idx = 0; idx < GrainsStorage.size(); idx++)
@@ -778,6 +885,15 @@ class GrainsProperties
             return false;
         };
 
+        Write(outp);
+        outp.close();
+#ifdef MPI_PARALLEL
+        }
+#endif
+        return true;
+    }
+    void Write(std::ostream& outp) const                                        ///< Writes all grains to a given stream
+    {
         const size_t size = GrainsStorage.size();
         outp.write(reinterpret_cast<const char*>(&size), sizeof(size_t));
 
@@ -785,11 +901,6 @@ class GrainsProperties
         {
             GrainsStorage[n].Write(outp);
         }
-        outp.close();
-#ifdef MPI_PARALLEL
-        }
-#endif
-        return true;
     }
     bool Write(const Settings& OPSettings, const int tStep) const
     {
@@ -806,8 +917,16 @@ class GrainsProperties
             return false;
         }
 
+        Read(inp);
+        inp.close();
+        ConsoleOutput::WriteStandard(thisclassname, "Binary input loaded");
+        return true;
+    }
+    bool Read(std::istream& inp)                                                ///< Reads all grains from a given stream
+    {
         size_t size = 0;
         inp.read(reinterpret_cast<char*>(&size), sizeof(size_t));
+        if(!inp) return false;
 
         if(GrainsStorage.size() != size)
         {
@@ -818,10 +937,8 @@ class GrainsProperties
         {
             GrainsStorage[n].Read(inp);
         }
-
-        inp.close();
-        ConsoleOutput::WriteStandard(thisclassname, "Binary input loaded");
-        return true;
+        FreeIndicesValid = false;
+        return bool(inp);
     }
     bool Read(const Settings& OPSettings, const int tStep)
     {
@@ -936,11 +1053,22 @@ class GrainsProperties
         {
              GrainsStorage[i].ReadH5(data,n);
         }
+        FreeIndicesValid = false;
     }
 
     void Clear()
     {
         GrainsStorage.clear();
+        FreeIndices.clear();
+        FreeIndicesValid = true;
+    }
+
+    void UpdateRotations(void) const                                            ///< Updates the cached rotations of all grains with changed orientation
+    {
+        for(auto it = GrainsStorage.begin(); it != GrainsStorage.end(); ++it)
+        {
+            it->UpdateRotations();
+        }
     }
 
     void ResetGrowthConstraintsViolations()
@@ -951,10 +1079,19 @@ class GrainsProperties
         }
     }
 
+    size_t AllocatedMemory() const                                              ///< Memory held by the grains storage [bytes]
+    {
+        return GrainsStorage.capacity()*sizeof(Grain) +
+               FreeIndices.capacity()*sizeof(size_t);
+    }
+
     std::string thisclassname = "GrainsProperties";
 
  private:
     std::vector < Grain > GrainsStorage;
+    std::vector < size_t > FreeIndices;                                         ///< Indices of vanished grains in descending order, the smallest one is reused first
+    bool FreeIndicesValid = false;                                              ///< False if FreeIndices has to be rebuilt before use
+    MisorientationCache Misorientations;                                        ///< Disorientations of grain pairs, validated against the orientations
 };
 
 }// namespace openphase
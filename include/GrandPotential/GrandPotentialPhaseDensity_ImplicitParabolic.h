@@ -68,6 +68,21 @@ struct GrandPotentialPhaseDensity_ImplicitParabolic: GrandPotentialPhaseDensity_
         const double& c0   = C0[comp];
         double c    = c0;//DBL_EPSILON;
 
+        // Exact hit returns the stored root, otherwise the Newton iteration
+        // starts from the root of the same chemical potential bucket
+        MemoEntry* Entry = nullptr;
+        if (UseMemo)
+        {
+            const long long Bucket = std::llround(mu/MemoResolution);
+            Entry = &Memo[omp_get_thread_num()][comp*MemoSize + MemoSlot(Bucket)];
+            if (Entry->Bucket == Bucket)
+            {
+                if (Entry->ChemicalPotential == mu) return Entry->Concentration;
+                c = Entry->Concentration;
+            }
+            Entry->Bucket = Bucket;
+        }
+
         auto f  = [&eps, &c0, &mu, &zeta](double c) { return eps*(c - c0) - mu  - zeta/c/c; };
         auto df = [&eps, &zeta]          (double c) { return eps + 2*zeta/c/c/c; };
         try
@@ -78,6 +93,11 @@ struct GrandPotentialPhaseDensity_ImplicitParabolic: GrandPotentialPhaseDensity_
         {
             ConsoleOutput::WriteWarning(ecep.what(),thisclassname,"PhaseConcentration");
         }
+        if (Entry)
+        {
+            Entry->ChemicalPotential = mu;
+            Entry->Concentration     = c;
+        }
         return c;
     }
     double PhaseSusceptibility (double Temperature, double ChemicalPotential, size_t comp) const override
@@ -98,6 +118,29 @@ struct GrandPotentialPhaseDensity_ImplicitParabolic: GrandPotentialPhaseDensity_
     double precision;
     size_t MaxIterations;
     std::vector<double> Zeta;                                                   ///< Energy parameter to prevent negative concentration
+
+    /* Memo of the phase concentration roots, a direct mapped table per thread
+    and component keyed by the chemical potential bucket of width
+    MemoResolution. Bulk cells at constant chemical potential hit the stored
+    root exactly, all other calls start the Newton iteration from the root of
+    their bucket and converge in one or two iterations. */
+    struct MemoEntry
+    {
+        long long Bucket = std::numeric_limits<long long>::min();               ///< Chemical potential bucket of the entry
+        double ChemicalPotential = 0.0;                                         ///< Chemical potential of the stored root
+        double Concentration = 0.0;                                             ///< Stored root
+    };
+    size_t MemoSlot(long long Bucket) const                                     ///< Table slot of a bucket (splitmix64 hash)
+    {
+        unsigned long long x = Bucket + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30))*0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27))*0x94D049BB133111EBull;
+        return (x ^ (x >> 31)) & (MemoSize - 1);
+    }
+    bool   UseMemo = false;                                                     ///< True if the roots are memoized
+    double MemoResolution = 1.0;                                                ///< Width of the chemical potential buckets
+    size_t MemoSize = 0;                                                        ///< Number of table entries per component (power of two)
+    mutable std::vector<std::vector<MemoEntry>> Memo;                           ///< Tables of each thread
 };
 }// namespace openphase
 #endif
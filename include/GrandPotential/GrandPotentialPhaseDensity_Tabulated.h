@@ -0,0 +1,181 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef GRANDPOTENTIALPHASEDENSITY_TABULATED_H
+#define GRANDPOTENTIALPHASEDENSITY_TABULATED_H
+
+#include "GrandPotential/GrandPotentialPhaseDensity.h"
+
+namespace openphase
+{
+class Settings;
+
+/* Tabulation layer for the grand potential phase densities. The wrapped model
+is evaluated once on a uniform (mu, T) grid per component, at run time the
+concentration is interpolated by cubic Hermite polynomials in mu, whose
+slopes are the tabulated susceptibilities, the susceptibility by monotone
+(Fritsch-Carlson limited) cubic polynomials and both by cubic Hermite
+polynomials with centered difference slopes in T. The pressure is
+tabulated for single component phases only (Hermite in mu with the
+concentration as slope), for several components it is not separable in
+general and evaluated by the model. After the tables are built, the
+interpolation error is checked against the model at the midpoints between
+the nodes. The grid is refined up to TAB_REFINE times while the relative error
+exceeds TAB_TOL, if it still does the tabulation is disabled with a warning
+and the model is evaluated directly. Queries outside of the tabulated range
+and the gravity dependent functions always use the model. Input (module
+@GrandPotentialDensity, p is the phase index, El the element name):
+
+    $TABULATE_p          Tabulate the density of phase p             No
+    $TAB_MUMIN_p_El      Lower chemical potential bound              required
+    $TAB_MUMAX_p_El      Upper chemical potential bound              required
+    $TAB_TMIN_p          Lower temperature bound                     0
+    $TAB_TMAX_p          Upper temperature bound                     TAB_TMIN_p
+    $TAB_NMU_p           Initial number of mu nodes                  256
+    $TAB_NT_p            Initial number of T nodes (1 if TMIN = TMAX) 16
+    $TAB_TOL_p           Relative interpolation error bound          1e-6
+    $TAB_REFINE_p        Maximum number of grid refinements          4  */
+
+struct GrandPotentialPhaseDensity_Tabulated: GrandPotentialPhaseDensity         ///< Interpolation tables of another grand potential density
+{
+    GrandPotentialPhaseDensity_Tabulated(size_t PhaseIdxInp,
+                                         GrandPotentialPhaseDensity* ModelInp):
+        GrandPotentialPhaseDensity(PhaseIdxInp), Model(ModelInp){};
+
+    void Initialize(Settings& locSettings) override;                            ///< Initializes the wrapped model
+    void ReadInput(std::stringstream& InputFile, int moduleLocation) override;  ///< Reads the wrapped model and the table parameters, builds the tables
+
+    double PhasePressure (double Temperature, const Tensor<double,1>& ChemicalPotential) const override
+    {
+        double value = 0.0;
+        if(Active and Ncomp == 1 and
+           Interpolate(Pressure[0], Concentration[0], 0, Temperature, ChemicalPotential({0}), value))
+        {
+            return value;
+        }
+        return Model->PhasePressure(Temperature, ChemicalPotential);
+    }
+    double PhaseConcentration  (double Temperature, double ChemicalPotential, size_t comp) const override
+    {
+        double value = 0.0;
+        if(Active and Interpolate(Concentration[comp], Susceptibility[comp], comp, Temperature, ChemicalPotential, value))
+        {
+            return value;
+        }
+        return Model->PhaseConcentration(Temperature, ChemicalPotential, comp);
+    }
+    double PhaseSusceptibility (double Temperature, double ChemicalPotential, size_t comp) const override
+    {
+        double value = 0.0;
+        if(Active and Interpolate(Susceptibility[comp], SusceptibilitySlope[comp], comp, Temperature, ChemicalPotential, value))
+        {
+            return value;
+        }
+        return Model->PhaseSusceptibility(Temperature, ChemicalPotential, comp);
+    }
+
+    double PhasePressure       (double height, double Temperature, const Tensor<double,1>& ChemicalPotential) const override {return Model->PhasePressure      (height, Temperature, ChemicalPotential);}; ///< Not tabulated
+    double PhaseConcentration  (double height, double Temperature, double ChemicalPotential, size_t comp)     const override {return Model->PhaseConcentration (height, Temperature, ChemicalPotential, comp);}; ///< Not tabulated
+    double PhaseSusceptibility (double height, double Temperature, double ChemicalPotential, size_t comp)     const override {return Model->PhaseSusceptibility(height, Temperature, ChemicalPotential, comp);}; ///< Not tabulated
+
+    bool   Active = false;                                                      ///< True if the tables are used
+    double MaxError = 0.0;                                                      ///< Largest relative interpolation error found in the check
+
+    static constexpr auto thisclassname = "GrandPotentialPhaseDensity_Tabulated";
+
+ protected:
+    GrandPotentialPhaseDensity* Model;                                          ///< Tabulated model
+
+    std::vector<double> MuMin;                                                  ///< Lower chemical potential bound of each component
+    std::vector<double> MuMax;                                                  ///< Upper chemical potential bound of each component
+    std::vector<double> dMu;                                                    ///< Chemical potential spacing of each component
+    size_t NMu = 0;                                                             ///< Number of chemical potential nodes
+    double TMin = 0.0;                                                          ///< Lower temperature bound
+    double TMax = 0.0;                                                          ///< Upper temperature bound
+    double dT = 0.0;                                                            ///< Temperature spacing, 0 for a single temperature
+    size_t NT = 1;                                                              ///< Number of temperature nodes
+
+    std::vector<std::vector<double>> Pressure;                                  ///< Pressure at [nT*NMu + nMu] (single component only)
+    std::vector<std::vector<double>> Concentration;                             ///< Concentration of each component
+    std::vector<std::vector<double>> Susceptibility;                            ///< Susceptibility of each component
+    std::vector<std::vector<double>> SusceptibilitySlope;                       ///< Monotone slopes of the susceptibility with respect to mu
+
+    void Build(void);                                                           ///< Fills the tables for the current number of nodes
+    void Check(double& ErrorMu, double& ErrorT) const;                          ///< Largest relative interpolation errors at the midpoints between the nodes in mu and in T
+
+    bool Interpolate(const std::vector<double>& Value,
+                     const std::vector<double>& Slope, const size_t comp,
+                     const double T, const double mu, double& result) const     ///< Hermite interpolation in mu and T, false outside of the table
+    {
+        const double x = (mu - MuMin[comp])/dMu[comp];
+        if(not (x >= 0.0 and x <= double(NMu - 1))) return false;
+
+        double y = 0.0;
+        if(NT > 1)
+        {
+            y = (T - TMin)/dT;
+            if(not (y >= 0.0 and y <= double(NT - 1))) return false;
+        }
+
+        const size_t nMu = std::min(size_t(x), NMu - 2);
+        const size_t nT  = (NT > 1) ? std::min(size_t(y), NT - 2) : 0;
+        const double s   = x - nMu;
+        const double t   = y - nT;
+
+        const double h00 = (1.0 + 2.0*s)*(1.0 - s)*(1.0 - s);
+        const double h10 = s*(1.0 - s)*(1.0 - s)*dMu[comp];
+        const double h01 = s*s*(3.0 - 2.0*s);
+        const double h11 = s*s*(s - 1.0)*dMu[comp];
+
+        auto Hermite = [&](const size_t row)
+        {
+            const size_t n = row*NMu + nMu;
+            return h00*Value[n] + h10*Slope[n] + h01*Value[n+1] + h11*Slope[n+1];
+        };
+        const double v0 = Hermite(nT);
+        if(NT == 1)
+        {
+            result = v0;
+            return true;
+        }
+        /* Centered slopes, second order one sided ones at the ends */
+        const double v1 = Hermite(nT + 1);
+        const double vm = (nT > 0)      ? Hermite(nT - 1) : 0.0;
+        const double v2 = (nT + 2 < NT) ? Hermite(nT + 2) : 0.0;
+        double m0 = v1 - v0;
+        double m1 = v1 - v0;
+        if(NT > 2)
+        {
+            m0 = (nT > 0)      ? 0.5*(v1 - vm) : 0.5*(-3.0*v0 + 4.0*v1 - v2);
+            m1 = (nT + 2 < NT) ? 0.5*(v2 - v0) : 0.5*( 3.0*v1 - 4.0*v0 + vm);
+        }
+        result = (1.0 + 2.0*t)*(1.0 - t)*(1.0 - t)*v0 + t*(1.0 - t)*(1.0 - t)*m0
+               + t*t*(3.0 - 2.0*t)*v1 + t*t*(t - 1.0)*m1;
+        return true;
+    }
+};
+}// namespace openphase
+#endif
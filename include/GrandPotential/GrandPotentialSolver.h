@@ -47,6 +47,7 @@ class OP_EXPORTS GrandPotentialSolver : public OPObject
     GrandPotentialSolver(Settings& locSettings, const std::string InputFileName);///<  Initializes global settings
 
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override;                            ///<  Initializes global settings
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;                   ///<  Reads input parameters from a file
     void ReadInput(std::stringstream& inp) override;                            ///< Reads input data from the user specified input file
 
@@ -104,24 +105,47 @@ class OP_EXPORTS GrandPotentialSolver : public OPObject
 
  protected:
  private:
-    void CaclulateLocalDiffusionFlux       (long i, long j, long k, dVector3 locVelocity, const PhaseField& Phase, const Temperature& Temp);  ///< Calculates local diffusion flux
-    void MergeLocalIncrements              (long i, long j, long k, double dt); ///< Merge local chemical potential increments
     void MergeLocalIncrements1             (long i, long j, long k, double dt); ///< Merge local chemical potential increments
     void MergeLocalIncrements2             (long i, long j, long k, double dt); ///< Merge local chemical potential increments
     void CalculateLocalConcentrations      (long i, long j, long k,              const PhaseField& Phase, const GrandPotentialDensity& omega); ///< Calculates local concentration and phase concentration
     void CalculateLocalConcentrations      (long i, long j, long k, size_t comp, const PhaseField& Phase, const GrandPotentialDensity& omega); ///< calculates local concentration and phase concentration
-    void CalculateLocalIncrements          (long i, long j, long k, const PhaseField& Phase, const GrandPotentialDensity& omega, double dt); ///< Calculates local chemical potential increments
     void CalculateLocalIncrements1         (long i, long j, long k, const PhaseField& Phase, const GrandPotentialDensity& omega, double dt); ///< Calculates local chemical potential increments
     void CalculateLocalIncrements2         (long i, long j, long k, const PhaseField& Phase, const GrandPotentialDensity& omega, double dt); ///< Calculates local chemical potential increments
     void CalculateLocalPhaseFieldIncrements(long i, long j, long k, PhaseField& Phase, const GrandPotentialDensity& omega, const InterfaceProperties& IP); ///< Calculates local driving force
     void MergeLocalIncrements2Implicit     (long i, long j, long k, PhaseField& Phase, const GrandPotentialDensity& omega, const InterfaceProperties& IP, double dt); ///< Merge local chemical potential increments
 
+    static constexpr size_t RootFindingBatchSize = 8;                           ///< Number of cells solved in lockstep by the semi-implicit single component update
+    typedef std::array<std::array<long int,3>,RootFindingBatchSize> CellBatch;  ///< Coordinates (i,j,k) of a batch of cells
+    void MergeLocalIncrements2ImplicitBatch(const CellBatch& Cells, size_t Size, PhaseField& Phase, const GrandPotentialDensity& omega, const InterfaceProperties& IP, double dt); ///< Merge local chemical potential increments of a batch of cells (single component only)
+
+    struct RowScratch                                                           ///< Per thread buffers of the row sweeps, component-major [comp*Size + m]
+    {
+        std::vector<double> Mobility;                                           ///< Mobility of each component
+        std::vector<double> ConcentrationDot;                                   ///< Concentration change due to diffusion and advection
+        std::vector<double> InverseSusceptibility;                              ///< Inverse susceptibility of each component
+        std::vector<double> PhaseConcentrationDot;                              ///< Concentration change due to phase-transformation
+        void resize(size_t Size, size_t Ncomp)
+        {
+            Mobility             .resize(Size*Ncomp);
+            ConcentrationDot     .resize(Size*Ncomp);
+            InverseSusceptibility.resize(Size*Ncomp);
+            PhaseConcentrationDot.resize(Size*Ncomp);
+        }
+    };
+    template<class RowKernel>
+    void RowSweep(long int bcells, RowKernel&& Kernel) const;                   ///< Calls Kernel(i,j,kBegin,kEnd,Scratch) for each z row of the storage loop range with bcells
+    void CalculateRowFluxAndPhaseFieldIncrements(long i, long j, long kBegin, long kEnd, PhaseField& Phase, const GrandPotentialDensity& omega, const InterfaceProperties& IP, const Temperature& Temp, RowScratch& Scratch); ///< Calculates diffusion flux and driving forces of a z row
+    void SolveExplicitRow(long i, long j, long kBegin, long kEnd, const PhaseField& Phase, const GrandPotentialDensity& omega, double dt, bool UpdateConcentrations, RowScratch& Scratch); ///< Calculates and merges the chemical potential increments of a z row
+
     void SetBoundaryConditions(const BoundaryConditions& BC) override;
     void EnforceConservationOfTOC(const PhaseField& Phase, const GrandPotentialDensity& omega);
 
     void SolveExplicit(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const InterfaceProperties& IP, const Temperature& Temp, double dt); ///< Solves diffusion equation
     void SolveImplicit(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const InterfaceProperties& IP, const Temperature& Temp, double dt); ///< Solves diffusion equation
+    void SolveGlobalImplicit(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const InterfaceProperties& IP, const Temperature& Temp, double dt); ///< Solves diffusion equation with implicit Euler method and conjugate gradient method
+    bool GlobalImplicitApplicable(const PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const Temperature& Temp) const; ///< Checks if SolveGlobalImplicit() can be used
 
+    bool ConcentrationsUpdated = false;                                         ///< Concentrations have been updated by the explicit sweep of the current step
     double dt_max = 0.0;                                                        ///< Maximum time step
     double dt_max_old = 0.0;                                                    ///< Maximum time step
 
@@ -143,13 +167,21 @@ class OP_EXPORTS GrandPotentialSolver : public OPObject
     Storage3D< double,   1> ChemicalPotentialOld;                               ///< Old Chemical potential before time step
     Storage3D< double,   1> ChemicalPotentialDot;                               ///< Change of chemical with time
     Storage3D< double,   1> ChemicalPotentialDot2;                              ///< Change of chemical with time
+    Storage3D< double,   1> ChemicalPotentialCorrection;                        ///< Implicit correction of the previous time step, warm start of the root finding
     Storage3D< dVector3, 1> DiffusionFlux;                                      ///< Stores local diffusion flux
 
+    Storage3D< double,   0> ImplicitCapacity;                                   ///< Susceptibility divided by time step of the global implicit solver
+    Storage3D< double,   0> ImplicitMobility;                                   ///< Mobility of the component solved by the global implicit solver
+    Storage3D< double,   0> ImplicitResidual;                                   ///< Conjugate gradient residual
+    Storage3D< double,   0> ImplicitDirection;                                  ///< Conjugate gradient search direction
+    Storage3D< double,   0> ImplicitProduct;                                    ///< Operator applied to the search direction
+
     double InitialPressure;
     Tensor<double, 2> CInitial;                                                 ///< Initial molar concentration
     bool ConserveTOC;                                                           ///< Enforce conservation of  total amount of components
     bool UseInitialPressure;                                                    ///< Set initial constants pressure
     bool UseImplicitSolver;                                                     ///< True if implicit Euler method is used
+    bool UseGlobalImplicitSolver;                                               ///< True if diffusion is solved with implicit Euler method on the whole grid
     double ChemicalPotentialAccuracy;                                           ///< The implicit solver will iterate until the residual is smaller than MaxResidual;
     double TOCAccuracy;                                                         ///< Accuracy of conservation of total amount of components
     size_t MaxIterations;                                                       ///< Maximum number of implicit solver iterations
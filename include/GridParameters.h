@@ -56,6 +56,7 @@ class OP_EXPORTS GridParameters
     GridParameters DoubleResolution(void) const;                                ///< Returns grid parameters in double resolution
 
     void SetDimensions(int total_nx, int total_ny, int total_nz);               ///< Sets grid parameters
+    void ApplyCutPlanes(void);                                                  ///< Sets the local domain from the cut planes MPI_CART_CUTS if they match the total size (MPI 3D decomposition)
 
     int Active(void) const                                                      ///< Indicates dimensionality, e.g. 1D, 2D or 3D
     {
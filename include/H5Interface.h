@@ -29,8 +29,14 @@
 
 #ifdef H5OP
 #include "../HighFive/include/highfive/H5Easy.hpp"
+#if defined(MPI_PARALLEL) && defined(H5_HAVE_PARALLEL)
+#define H5OP_PARALLEL                                                           ///< Collective MPI-IO output into one shared file
 #endif
+#endif
+#include <memory>
 #include <string>
+#include "AsyncOutput.h"
+#include "OutputField.h"
 #include "Settings.h"
 
 namespace openphase
@@ -41,16 +47,59 @@ class OP_EXPORTS H5Interface
 public:
     static constexpr auto thisclassname = "H5Interface";                        ///< Object's implementation class name
 
-    struct Field_t                                                              ///< Short hand for a field's name and function which will be written to file
+    typedef OutputField Field_t;                                                ///< Short hand for a field's name and function which will be written to file
+    /* The output file stays open between the calls and is closed with
+    CloseFile() or by the destructor. With an active AsyncOutput service the
+    visualization output is written in the background, the other methods
+    wait for it to finish since HDF5 calls are not thread safe. With a parallel HDF5 library in MPI
+    runs the file is opened with the MPI-IO driver by all ranks, checkpoints
+    and visualization fields are written collectively into one global
+    dataset, each rank writing its own hyperslab. */
+    ~H5Interface();
+    enum class Compressions                                                     ///< Compression filters of the visualization datasets
     {
-        std::string Name;
-        std::function<std::any(const int, const int, const int)> Function;
-
-        Field_t(const std::string& inp_Name,
-                const std::function<std::any(const int, const int, const int)>& inp_Function) :
-            Name(inp_Name), Function(inp_Function) {};
+        None,                                                                   ///< Uncompressed
+        GZIP,                                                                   ///< Deflate, always available
+        SZIP,                                                                   ///< SZIP, if built into the HDF5 library
+        ZSTD,                                                                   ///< Zstandard, HDF5 filter plugin 32015
+        BLOSC,                                                                  ///< Blosc, HDF5 filter plugin 32001
+        ZFP,                                                                    ///< Lossy ZFP in fixed accuracy mode, HDF5 filter plugin 32013
+        SZ                                                                      ///< Lossy SZ with an absolute error bound, HDF5 filter plugin 32017
+    };
+    struct Compression_t                                                        ///< Compression settings of a dataset
+    {
+        Compressions Filter = Compressions::None;
+        int  Level   = 4;                                                       ///< Compression level (GZIP 1-9, ZSTD 1-22, BLOSC 1-9)
+        bool Shuffle = true;                                                    ///< Byte shuffling before the compression
+        double Tolerance = 1.0e-6;                                              ///< Absolute error bound of the lossy filters (ZFP, SZ)
     };
+    /* Visualization fields are stored as chunked datasets with the grid
+    dimensions (Nz, Ny, Nx[, Ncomp]), which allows reading sub-volumes. By
+    default the chunks tile the MPI subdomains, their edge length is the
+    largest divisor of the subdomain size not exceeding 64 cells. Compression
+    and chunk sizes are read from the optional @H5Interface input module:
+
+    $Compression         Default filter (None, GZIP, SZIP, ZSTD, BLOSC,
+                         ZFP, SZ)                                       : GZIP
+    $CompressionLevel    Compression level                              : 4
+    $Shuffle             Byte shuffling                                 : Yes
+    $CompressionTolerance Error bound of ZFP and SZ                     : 1.0e-4
+    $Compression_<Field> Filter of the field <Field>                    : ZSTD
+    $CompressionTolerance_<Field> Error bound of the field <Field>      : 1.0e-3
+    $ChunkSizeX          Chunk size in X direction (0: automatic)       : 0
+    $CheckpointCompression Filter of the checkpoint datasets            : ZFP
+    $CheckpointTolerance Error bound of the checkpoint datasets         : 1.0e-8
+
+    ZFP and SZ are lossy, the values read back differ from the written ones
+    by at most the (absolute) error bound. Checkpoint datasets are only
+    compressed lossily if their writer marks them as floating point field
+    data (WriteCheckPoint() with Lossy = true, e.g. composition and
+    temperature), all other checkpoint datasets, e.g. the phase-field
+    indices, use GZIP instead. */
+    void ReadInput(const std::string InputFileName);                            ///< Reads the dataset layout from the input file
+    void ReadInput(std::stringstream& inp);                                     ///< Reads the dataset layout from the input stream
     void OpenFile(const std::string InputFileName, const std::string OutputFileName);
+    void CloseFile(void);                                                       ///< Flushes and closes the output file
     void WriteSimulationSettings(const std::string InputFileName);
     void WriteOPID(const std::string InputFileName);
     void getProjectInput(std::stringstream& data);
@@ -61,10 +110,12 @@ public:
         const int resolution);
 
     //template <class T>
-    void WriteCheckPoint(int tStep, std::string name, std::vector<double>& data)
+    void WriteCheckPoint(int tStep, std::string name, std::vector<double>& data,
+                         const std::string leaf = "", const bool Lossy = false) ///< Writes data to /CheckPoints/name/tStep, or to /CheckPoints/name/tStep/leaf if leaf is given, Lossy allows lossy compression of floating point field data
     {
         #ifdef H5OP
-        H5Easy::File file(H5OutputFileName, H5Easy::File::OpenOrCreate);
+        AsyncOutput::Flush();
+        H5Easy::File& file = OutputFile();
         if (!file.exist("/CheckPoints")) {
             // Create the HDF5 group path:
             file.createGroup("/CheckPoints");
@@ -76,7 +127,34 @@ public:
         }
         std::stringstream check2;
         check2 << "/CheckPoints/" << name << "/" << tStep;
-        H5Easy::DataSet ds = H5Easy::dump(file, check2.str(), data, H5Easy::DumpMode::Overwrite);
+        if (!leaf.empty()) {
+            if (!file.exist(check2.str())) {
+                file.createGroup(check2.str());
+            }
+            check2 << "/" << leaf;
+        }
+        #ifdef H5OP_PARALLEL
+        /* Data of all ranks is stored consecutively, the sizes of the
+        individual contributions are kept to read them back per rank */
+        std::vector<size_t> RankSizes = GatherSizes(data.size());
+        size_t offset = 0;
+        size_t total  = 0;
+        for(int rank = 0; rank < MPI_SIZE; rank++)
+        {
+            if(rank < MPI_RANK) offset += RankSizes[rank];
+            total += RankSizes[rank];
+        }
+        H5Easy::DataSet ds = WriteSlab(file, check2.str(), data.data(),
+                                       {total}, {offset}, {data.size()},
+                                       CheckpointProperties(Lossy, total));
+        if (ds.hasAttribute("RankSizes")) ds.deleteAttribute("RankSizes");
+        ds.createAttribute("RankSizes", RankSizes);
+        #else
+        H5Easy::DataSet ds = (CheckpointCompression.Filter == Compressions::None or data.empty()) ?
+                             H5Easy::dump(file, check2.str(), data, H5Easy::DumpMode::Overwrite) :
+                             WriteSlab(file, check2.str(), data.data(), {data.size()}, {0}, {data.size()},
+                                       CheckpointProperties(Lossy, data.size()));
+        #endif
 
         size_t el = ds.getElementCount();
         // NOTE: suppress verbose HDF5 write confirmations to avoid
@@ -137,7 +215,8 @@ public:
     void ReadCheckPoint(int tStep, std::string name, std::vector<double>& data)
     {
         #ifdef H5OP
-        H5Easy::File file(H5InputFileName, H5Easy::File::OpenOrCreate);
+        AsyncOutput::Flush();
+        H5Easy::File file = InputFile();
         if (!file.exist("/CheckPoints")) {
             ConsoleOutput::WriteExit("/CheckPoints not found.", "H5", "ReadCheckPoint()");
             OP_Exit(EXIT_FAILURE);
@@ -154,6 +233,24 @@ public:
             ConsoleOutput::WriteExit(check2.str()+" not found.", "H5", "ReadCheckPoint()");
             OP_Exit(EXIT_FAILURE);
         }
+        #ifdef H5OP_PARALLEL
+        H5Easy::DataSet ds = file.getDataSet(check2.str());
+        if (ds.hasAttribute("RankSizes"))
+        {
+            std::vector<size_t> RankSizes = ds.getAttribute("RankSizes").read<std::vector<size_t>>();
+            if (RankSizes.size() != size_t(MPI_SIZE))
+            {
+                ConsoleOutput::WriteExit(check2.str() + " was written by " + std::to_string(RankSizes.size())
+                                         + " MPI ranks, restart requires the same number of ranks.", "H5", "ReadCheckPoint()");
+                OP_Exit(EXIT_FAILURE);
+            }
+            size_t offset = 0;
+            for(int rank = 0; rank < MPI_RANK; rank++) offset += RankSizes[rank];
+            data.resize(RankSizes[MPI_RANK]);
+            ds.select({offset}, {data.size()}).read_raw(data.data(), HighFive::AtomicType<double>());
+            return;
+        }
+        #endif
         data = H5Easy::load<std::vector<double> >(file, check2.str());
         #else
         ConsoleOutput::WriteExit("OpenPhase is not compiled with HDF5 support, use: make Settings=\"H5\"",thisclassname,"ReadCheckPoint()");
@@ -167,7 +264,7 @@ public:
             Funktion_t Function)
     {
         #ifdef H5OP
-        H5Easy::File file(H5OutputFileName, H5Easy::File::OpenOrCreate);
+        H5Easy::File& file = OutputFile();
         std::vector<float> vdata;
         for(int k = 0; k < Nz; ++k)
         for(int j = 0; j < Ny; ++j)
@@ -187,7 +284,24 @@ public:
             file.createGroup("/Visualization/"+Name);
         }
         //H5Easy::dump(file, "/PhaseField", data);
-        H5Easy::DataSet ds = H5Easy::dump(file,"/Visualization/"+Name+"/"+std::to_string(tStep), vdata, H5Easy::DumpMode::Overwrite);
+        const size_t Ncomp = (Nx*Ny*Nz > 0) ? vdata.size()/(Nx*Ny*Nz) : 0;
+        #ifdef H5OP_PARALLEL
+        std::vector<size_t> dims   = {size_t(Subdomain.TotalNz), size_t(Subdomain.TotalNy), size_t(Subdomain.TotalNx)};
+        std::vector<size_t> offset = {size_t(Subdomain.OffsetZ), size_t(Subdomain.OffsetY), size_t(Subdomain.OffsetX)};
+        #else
+        std::vector<size_t> dims   = {size_t(Nz), size_t(Ny), size_t(Nx)};
+        std::vector<size_t> offset = {0, 0, 0};
+        #endif
+        std::vector<size_t> count  = {size_t(Nz), size_t(Ny), size_t(Nx)};
+        if (Ncomp > 1)
+        {
+            dims.push_back(Ncomp);
+            offset.push_back(0);
+            count.push_back(Ncomp);
+        }
+        H5Easy::DataSet ds = WriteSlab(file, "/Visualization/"+Name+"/"+std::to_string(tStep),
+                                       vdata.data(), dims, offset, count,
+                                       DatasetProperties(Name, count));
 
         size_t el = ds.getElementCount();
 
@@ -211,79 +325,88 @@ public:
         for (auto Field : ListOfFields)
         {
             // 所有标量类型统一转为 float 存储，避免 any_cast 类型不匹配
-            if (Field.Function(0,0,0).type() == typeid(int))
+            if (Field.ValueType() == typeid(int))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field](int i,int j,int k){
+                const std::vector<int> Values = Field.template Values<int>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){
                     std::vector<float> data;
-                    data.push_back(static_cast<float>(std::any_cast<int>(Field.Function(i,j,k))));
+                    data.push_back(static_cast<float>(Values[(k*Ny + j)*Nx + i]));
                     return data;
                 });
             }
-            else if (Field.Function(0,0,0).type() == typeid(size_t))
+            else if (Field.ValueType() == typeid(size_t))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field](int i,int j,int k){
+                const std::vector<size_t> Values = Field.template Values<size_t>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){
                     std::vector<float> data;
-                    data.push_back(static_cast<float>(std::any_cast<size_t>(Field.Function(i,j,k))));
+                    data.push_back(static_cast<float>(Values[(k*Ny + j)*Nx + i]));
                     return data;
                 });
             }
-            else if (Field.Function(0,0,0).type() == typeid(double))
+            else if (Field.ValueType() == typeid(double))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field](int i,int j,int k){
+                const std::vector<double> Values = Field.template Values<double>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){
                     std::vector<float> data;
-                    data.push_back(static_cast<float>(std::any_cast<double>(Field.Function(i,j,k))));
+                    data.push_back(static_cast<float>(Values[(k*Ny + j)*Nx + i]));
                     return data;
                 });
             }
-            else if (Field.Function(0,0,0).type() == typeid(dVector3))
+            else if (Field.ValueType() == typeid(dVector3))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){
-                    auto vec = std::any_cast<dVector3>(Field.Function(i,j,k)).writeBinary();
+                const std::vector<dVector3> Values = Field.template Values<dVector3>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){
+                    auto vec = Values[(k*Ny + j)*Nx + i].writeBinary();
                     std::vector<float> data(vec.size());
                     for (size_t idx = 0; idx < vec.size(); ++idx) data[idx] = static_cast<float>(vec[idx]);
                     return data;
                 });
             }
-            else if (Field.Function(0,0,0).type() == typeid(dVector6))
+            else if (Field.ValueType() == typeid(dVector6))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){
-                    auto vec = std::any_cast<dVector6>(Field.Function(i,j,k)).writeBinary();
+                const std::vector<dVector6> Values = Field.template Values<dVector6>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){
+                    auto vec = Values[(k*Ny + j)*Nx + i].writeBinary();
                     std::vector<float> data(vec.size());
                     for (size_t idx = 0; idx < vec.size(); ++idx) data[idx] = static_cast<float>(vec[idx]);
                     return data;
                 });
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStrain))
+            else if (Field.ValueType() == typeid(vStrain))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){
-                    auto vec = std::any_cast<vStrain>(Field.Function(i,j,k)).writeBinary();
+                const std::vector<vStrain> Values = Field.template Values<vStrain>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){
+                    auto vec = Values[(k*Ny + j)*Nx + i].writeBinary();
                     std::vector<float> data(vec.size());
                     for (size_t idx = 0; idx < vec.size(); ++idx) data[idx] = static_cast<float>(vec[idx]);
                     return data;
                 });
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStress))
+            else if (Field.ValueType() == typeid(vStress))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){
-                    auto vec = std::any_cast<vStress>(Field.Function(i,j,k)).writeBinary();
+                const std::vector<vStress> Values = Field.template Values<vStress>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){
+                    auto vec = Values[(k*Ny + j)*Nx + i].writeBinary();
                     std::vector<float> data(vec.size());
                     for (size_t idx = 0; idx < vec.size(); ++idx) data[idx] = static_cast<float>(vec[idx]);
                     return data;
                 });
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix3x3))
+            else if (Field.ValueType() == typeid(dMatrix3x3))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){
-                    auto vec = std::any_cast<dMatrix3x3>(Field.Function(i,j,k)).writeBinary();
+                const std::vector<dMatrix3x3> Values = Field.template Values<dMatrix3x3>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){
+                    auto vec = Values[(k*Ny + j)*Nx + i].writeBinary();
                     std::vector<float> data(vec.size());
                     for (size_t idx = 0; idx < vec.size(); ++idx) data[idx] = static_cast<float>(vec[idx]);
                     return data;
                 });
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix6x6))
+            else if (Field.ValueType() == typeid(dMatrix6x6))
             {
-                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){
-                    auto vec = std::any_cast<dMatrix6x6>(Field.Function(i,j,k)).writeBinary();
+                const std::vector<dMatrix6x6> Values = Field.template Values<dMatrix6x6>(Nx,Ny,Nz);
+                ForEach(tStep,Field.Name,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){
+                    auto vec = Values[(k*Ny + j)*Nx + i].writeBinary();
                     std::vector<float> data(vec.size());
                     for (size_t idx = 0; idx < vec.size(); ++idx) data[idx] = static_cast<float>(vec[idx]);
                     return data;
@@ -298,6 +421,68 @@ public:
 
 std::string H5InputFileName;
 std::string H5OutputFileName;
+
+ private:
+    void WriteVisualizationXDMF(int tStep,
+        const std::vector<Field_t>& ListOfFields,
+        const long int Nx, const long int Ny, const long int Nz,
+        const std::string& Suffix = "",
+        const std::string& Origin = "0 0 0",
+        const std::string& Spacing = "0.1 0.1 0.1");                            ///< Appends the time step to the XDMF description "<output file><Suffix>.xdmf"
+    void WriteVisualizationRegions(int tStep, const Settings& locSettings,
+        const std::vector<Field_t>& ListOfFields, const int resolution);        ///< Writes each of Settings::OutputRegions instead of the whole domain
+    struct Subdomain_t                                                          ///< Position of the local domain in the written visualization grid
+    {
+        long int TotalNx = 0;
+        long int TotalNy = 0;
+        long int TotalNz = 0;
+        long int OffsetX = 0;
+        long int OffsetY = 0;
+        long int OffsetZ = 0;
+    };
+    Subdomain_t Subdomain;                                                      ///< Set by WriteVisualization()
+    #ifdef H5OP
+    std::shared_ptr<H5Easy::File> OutputFileHandle;                             ///< Output file, kept open between the calls
+    H5Easy::File& OutputFile(void);                                             ///< Opens the output file on first use
+    H5Easy::File InputFile(void) const;                                         ///< Opens the input file
+    void WriteInputLines(const std::string InputFileName,
+                         const std::string path, const std::string what,
+                         const std::string method);                             ///< Stores the lines of a text file as a string dataset
+    #endif
+    Compression_t DefaultCompression;                                           ///< Compression of the visualization datasets
+    std::map<std::string, Compression_t> FieldCompression;                      ///< Compression of individual fields
+    Compression_t CheckpointCompression;                                        ///< Compression of the checkpoint datasets
+    long int ChunkSize[3] = {0, 0, 0};                                          ///< Chunk sizes in X, Y and Z direction (0: automatic)
+    #ifdef H5OP
+    HighFive::DataSetCreateProps DatasetProperties(const std::string& Name,
+                              const std::vector<size_t>& count) const;          ///< Chunking and compression of a visualization dataset
+    HighFive::DataSetCreateProps CheckpointProperties(const bool Lossy,
+                                                      const size_t size) const; ///< Chunking and compression of a checkpoint dataset of size values
+    template <class T>
+    H5Easy::DataSet WriteSlab(H5Easy::File& file, const std::string& path,
+                              const T* data,
+                              const std::vector<size_t>& dims,
+                              const std::vector<size_t>& offset,
+                              const std::vector<size_t>& count,
+                              const HighFive::DataSetCreateProps& props = HighFive::DataSetCreateProps())///< Writes the local hyperslab into a global dataset, collectively in parallel mode
+    {
+        if (file.exist(path))
+        {
+            if (file.getDataSet(path).getDimensions() != dims) file.unlink(path);
+        }
+        H5Easy::DataSet ds = file.exist(path) ? file.getDataSet(path) :
+                             file.createDataSet<T>(path, HighFive::DataSpace(dims), props);
+        HighFive::DataTransferProps xfer;
+        #ifdef H5OP_PARALLEL
+        xfer.add(HighFive::UseCollectiveIO{});
+        #endif
+        ds.select(offset, count).write_raw(data, HighFive::AtomicType<T>(), xfer);
+        return ds;
+    }
+    #endif
+    #ifdef H5OP_PARALLEL
+    std::vector<size_t> GatherSizes(const size_t size) const;                   ///< Local sizes of all ranks
+    #endif
 };
 
 }
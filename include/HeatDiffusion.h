@@ -31,6 +31,7 @@
 #include "Includes.h"
 #include "BoundaryConditions.h"
 #include "Temperature.h"
+#include "NumericalMethods/Multigrid.h"
 
 namespace openphase
 {
@@ -41,6 +42,14 @@ class Temperature;
 class BoundaryConditions;
 class Composition;
 
+enum class ImplicitSolverTypes                                                  ///< Solvers of the implicit heat diffusion time step
+{
+    Jacobi,                                                                     ///< Jacobi iterations
+    Multigrid,                                                                  ///< Geometric multigrid V-cycles
+    ConjugateGradient,                                                          ///< Matrix-free Jacobi preconditioned conjugate gradient
+    ADI                                                                         ///< Alternating direction implicit line solves, one factorized step per time step
+};
+
 class OP_EXPORTS HeatDiffusion : public OPObject                                ///< Heat equation solver class
 {
  public:
@@ -55,6 +64,8 @@ class OP_EXPORTS HeatDiffusion : public OPObject
     void ReadInput(const std::string FileName) override;                        ///< Reads input parameters
     void ReadInput(std::stringstream& inp) override;                            ///< Reads input parameters
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override; ///< Changes system size while keeping the data
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void SetEffectiveProperties(const PhaseField& Phase,
                                 const Temperature& Tx);                         ///< Set effective thermal properties
 
@@ -63,6 +74,8 @@ class OP_EXPORTS HeatDiffusion : public OPObject
 
     int  SolveImplicit(const PhaseField& Phase, const BoundaryConditions& BC,   ///< Implicit Solver
                        Temperature& Tx, const double dt);
+    int  SolveExplicit(const PhaseField& Phase, const BoundaryConditions& BC,
+                       Temperature& Tx, const double dt);                       ///< Explicit solver with block-local time stepping, returns the number of substeps of the finest blocks
 
     double MaxThermalConductivity;                                              ///< Maximum thermal conductivity in the system
 
@@ -75,12 +88,21 @@ class OP_EXPORTS HeatDiffusion : public OPObject
 
     Storage3D<double,0> TxOld;                                                  ///< Temporary temperature storage for the iterative solver
     Storage3D<double,0> dTx;                                                    ///< Temperature increments
+    Multigrid MultigridSolver;                                                  ///< Multigrid solver of the implicit time step
+    Storage3D<double,0> ResidualCG;                                             ///< Residual of the conjugate gradient solver
+    Storage3D<double,0> DirectionCG;                                            ///< Search direction of the conjugate gradient solver
+    Storage3D<double,0> ProductCG;                                              ///< Operator applied to the search direction
+    Storage3D<double,0> ScratchADI;                                             ///< Modified upper diagonal of the ADI line solves
 
     double Tolerance;                                                           ///< Solver convergence tolerance
     int MaxIterations;                                                          ///< Maximum number of implicit solver iterations
     int SolverCallsInterval;                                                    ///< Solve heat diffusion only on SolverCallsInterval (in time steps)
     int SolverCallsCounter;                                                     ///< Counts solver calls
     bool VerboseIterations;                                                     ///< If true enables iterations statistics output to console
+    ImplicitSolverTypes ImplicitSolver;                                         ///< Solver of the implicit time step, Jacobi unless selected otherwise by $ImplicitSolver
+    int LTSBlockSize;                                                           ///< Edge length of the local time stepping blocks in grid cells
+    int LTSMaxLevel;                                                            ///< Maximum time level, a block does at most 2^LTSMaxLevel substeps
+    int LTSSourceSubsteps;                                                      ///< Minimum number of substeps of the blocks at active heat sources
 
     GridParameters Grid;                                                        ///< Simulation grid parameters
 
@@ -88,10 +110,34 @@ class OP_EXPORTS HeatDiffusion : public OPObject
 
  protected:
  private:
+    TemperatureSubscription PropertyCache;                                      ///< Cells whose phase set or temperature changed since the last SetEffectiveProperties() call
     void Perform1DIteration(Temperature& Tx,
                             Temperature1Dextension& TxExt,
                             BoundaryConditionTypes extBC,
                             double& residual, double dt);                       ///< Performs solver iteration in the 1D temperature field extension
+    bool ConjugateGradientApplicable(const BoundaryConditions& BC) const;       ///< Checks that the scaled operator is symmetric positive definite
+    int  SolveConjugateGradient(Temperature& Tx, const BoundaryConditions& BC,
+                                double dt, double MaxResidual,
+                                int IterationsLimit, double& residual);         ///< Solves the implicit time step for the current boundary values, returns the number of iterations
+    bool ADIApplicable(const BoundaryConditions& BC) const;                     ///< Checks that the ADI line solves are supported by the boundary conditions and properties
+    void SolveADI(Temperature& Tx, const BoundaryConditions& BC, double dt);    ///< Performs one factorized alternating direction implicit step in delta form
+    void SolveLines(const int direction, const Temperature& Tx,
+                    const BoundaryConditions& BC, double dt);                   ///< Solves (RhoCp - dt*Lambda*d2/dx2) x = dTx along all lines in "direction", x is stored in dTx
+
+    struct TimeSteppingBlock                                                    ///< Part of a local time stepping block on this process
+    {
+        long int Begin[3];                                                      ///< First local cell of the block in each direction
+        long int End[3];                                                        ///< Local cell past the block in each direction
+        size_t Index;                                                           ///< Index of the block in the global block grid
+        int Level;                                                              ///< Time level, the block does 2^Level substeps per time step
+        int FaceLevel[6];                                                       ///< Time level of the faces (x0, xN, y0, yN, z0, zN), the finer level of the two adjacent blocks
+    };
+    std::vector<TimeSteppingBlock> LocalBlocks;                                 ///< Local time stepping blocks intersecting the local domain
+    std::vector<int> BlockLevels;                                               ///< Time levels of the global block grid
+    int NumBlocks[3];                                                           ///< Number of blocks of the global block grid in each direction
+    long int NeighborBlock(const BoundaryConditions& BC, const size_t Index,
+                           const int face) const;                               ///< Global index of the block across face, -1 at non-periodic domain boundaries
+    int  SetBlockLevels(const BoundaryConditions& BC, double dt);               ///< Sets the time levels of the blocks, returns the finest level
 
 };
 
@@ -0,0 +1,139 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef INSITU_H
+#define INSITU_H
+
+#include "Includes.h"
+#include "OutputField.h"
+
+namespace openphase
+{
+class Settings;
+class RunTimeControl;
+
+/* In-situ analysis and visualization adaptor. Instead of writing files for
+post-processing, the fields of the local subdomain are handed to an in-situ
+or in-transit backend every Interval time steps. Fields are registered once,
+either as output field lists (the VTK::Field_t / H5Interface::Field_t lists
+of the file writers) or as views of POD storages:
+
+    InSitu Adaptor(OPSettings, InputFile);
+    Adaptor.Register({VTK::Field_t::FromStorage("Interfaces", Phi.Fields,
+        [](const NodePF& locPF){return double(locPF.interface());})});
+    Adaptor.RegisterView("Temperature", Tx.Tx);
+    for(...)                                                                    // time loop
+    {
+        ...
+        Adaptor.Execute(OPSettings, RTC);
+    }
+    Adaptor.Finalize();
+
+Views are passed without copying where the backend accepts the storage layout
+(x slowest, z fastest, boundary cells around the local box). Output fields
+are tabulated into buffers which are kept between the calls. The backends are
+compiled in with SETTINGS="... adios2" or "... catalyst" (CMake
+ENABLE_ADIOS2, ENABLE_CATALYST):
+
+    ADIOS2    One step per call on the configured engine (SST or DataMan for
+              in-transit analysis, BP5 for files). Global arrays, the local
+              box is the selection. Views have the dimensions (Nx, Ny, Nz)
+              and are put directly from the storage, the memory selection
+              skips the boundary cells. Output fields have the dimensions
+              (Nz, Ny, Nx) as in the HDF5 output.
+    Catalyst  ParaView Catalyst 2, the local box as a Conduit Blueprint
+              uniform mesh passed to catalyst_execute(). Blueprint expects x
+              fastest, views are therefore tabulated like the output fields,
+              the buffers are handed over with set_external().
+
+Input (module @InSitu, optional):
+
+    $Backend   None, ADIOS2 or Catalyst                         None
+    $Interval  Time steps between the calls                     1
+    $Engine    ADIOS2 engine                                    SST
+    $Stream    ADIOS2 stream name                               OpenPhase
+    $Config    ADIOS2 XML configuration file (optional)
+    $Scripts   Catalyst Python scripts, separated by spaces               */
+
+class OP_EXPORTS InSitu
+{
+ public:
+    static constexpr auto thisclassname = "InSitu";                             ///< Object's implementation class name
+
+    enum class Backends                                                         ///< In-situ backends
+    {
+        None,                                                                   ///< No in-situ processing
+        ADIOS2,                                                                 ///< ADIOS2 engine (in-transit or file)
+        Catalyst                                                                ///< ParaView Catalyst 2
+    };
+
+    InSitu();
+    InSitu(const Settings& locSettings, const std::string InputFileName = DefaultInputFileName);
+    ~InSitu();
+
+    void ReadInput(const std::string InputFileName);                            ///< Reads the backend settings from the input file
+    void ReadInput(std::stringstream& inp);                                     ///< Reads the backend settings from the input stream
+    void Initialize(const Settings& locSettings);                               ///< Starts the backend (collective)
+
+    void Register(const std::vector<OutputField>& ListOfFields);                ///< Adds output fields, tabulated at each call
+    void RegisterView(const std::string& Name, const Storage3D<double,0>& Field);///< Adds a scalar storage view
+    void RegisterView(const std::string& Name, const Storage3D<dVector3,0>& Field);///< Adds a vector storage view, three components per cell
+    void RegisterView(const std::string& Name, const Storage3D<double,1>& Field);///< Adds a storage view with one component per tensor index
+
+    bool Execute(const Settings& locSettings, const RunTimeControl& RTC);       ///< Hands the registered fields to the backend if due (collective), returns true if executed
+    void Finalize(void);                                                        ///< Closes the backend (collective)
+
+    Backends Backend;                                                           ///< Selected backend
+    int Interval;                                                               ///< Time steps between the calls
+    std::string Engine;                                                         ///< ADIOS2 engine
+    std::string Stream;                                                         ///< ADIOS2 stream name
+    std::string Config;                                                         ///< ADIOS2 XML configuration file
+    std::vector<std::string> Scripts;                                           ///< Catalyst Python scripts
+
+    struct View                                                                 ///< Layout of a registered storage, queried at each call since the storage may be reallocated
+    {
+        std::string Name;
+        size_t Components;                                                      ///< Number of doubles per cell
+        std::function<const double*(void)> Data;                                ///< First value of the padded memory, cell (-Bcells,-Bcells,-Bcells)
+        std::function<std::array<long int,3>(void)> Size;                       ///< Local box without the boundary cells
+        std::function<std::array<long int,3>(void)> Bcells;                     ///< Boundary cells in each direction
+    };
+
+ private:
+    struct BackendState;                                                        ///< Backend objects, defined with the backend
+    std::unique_ptr<BackendState> State;
+    std::vector<OutputField> Fields;                                            ///< Registered output fields
+    std::vector<View> Views;                                                    ///< Registered storage views
+    std::map<std::string, std::vector<double>> Buffers;                         ///< Tabulated values, kept between the calls
+    bool Active;                                                                ///< Backend has been initialized
+
+    size_t Tabulate(const OutputField& Field, const long int Nx,
+                    const long int Ny, const long int Nz);                      ///< Values of an output field as doubles in Buffers, x fastest, returns the number of components (0 if the type is not supported)
+    size_t Tabulate(const View& locView);                                       ///< Interior values of a view in Buffers, x fastest, returns the number of components
+};
+
+}// namespace openphase
+#endif
@@ -56,7 +56,8 @@ class OP_EXPORTS Initializations// : public OPObject
             double probabilityPhase1, int offset = 0, int seed = 1);            ///< Populates spherical grains of two different phases on a regular grid with grid spacing "distance" and local random "offset" of each sphere
     static void RandomNuclei(PhaseField& Phase, const Settings& locSettings,
             size_t phaseIndex, size_t Nparticles, bool randomOrientation = true,
-            bool randomVariants = false, std::string onPlane = "No", int seed = 1);
+            bool randomVariants = false, std::string onPlane = "No",
+            int seed = 1);                                                      ///< Plants up to Nparticles non-overlapping nuclei at random free cells
     static size_t Ellipsoid(PhaseField& Phase, size_t PhaseIndex,
             double RadiusX, double RadiusY, double RadiusZ,
             double x0, double y0, double z0, BoundaryConditions& BC);                     ///< Initializes a spherical grain
@@ -70,6 +71,15 @@ class OP_EXPORTS Initializations// : public OPObject
     static size_t Sphere(PhaseField& Phase, const size_t PhaseIndex,
             const double Radius, double x0, double y0, double z0,
             const BoundaryConditions& BC, const bool Finalize = true);                                        ///< Initializes a spherical grain
+    struct SphereShape                                                          ///< Sphere of the Spheres() batch initializer
+    {
+        size_t PhaseIndex;                                                      ///< Thermodynamic phase of the grain
+        double Radius;                                                          ///< Radius in grid cells
+        dVector3 Center;                                                        ///< Center in global grid coordinates
+    };
+    static std::vector<size_t> Spheres(PhaseField& Phase,
+            const std::vector<SphereShape>& Shapes,
+            const BoundaryConditions& BC, const bool Finalize = true);          ///< Initializes a batch of spherical grains in the given order, finalizes the phase-field once
     static std::vector<size_t> Fractional(PhaseField& Phase,
             size_t MajorityPhaseIndex, size_t MinorityPhaseIndex,
             double MinorityPhaseLayerThickness, BoundaryConditions& BC);                                             ///< ?? TODO
@@ -142,7 +152,7 @@ class OP_EXPORTS Initializations// : public OPObject
             PhaseField& Phase, ElasticProperties& EP, Orientations& OR,
             BoundaryConditions& BC);                     ///< Reads microstructure from EBSD result files
     static void VoronoiTessellation(PhaseField& Phase, BoundaryConditions& BC,
-            const size_t seedpoints, const size_t matrixphase);                 ///< Creates Voronoi grain structures using the algorithm based on coordination shells.
+            const size_t seedpoints, const size_t matrixphase);                 ///< Creates Voronoi grain structures by assigning each cell to its nearest seed (coordination shell order on ties).
     static void TripleJunction(PhaseField& Phase, size_t PhaseIndex,
                 BoundaryConditions& BC);
     static std::vector<size_t> Young3(PhaseField& Phase, size_t alpha,
@@ -158,7 +168,8 @@ class OP_EXPORTS Initializations// : public OPObject
     static void Read(PhaseField& Phase, std::string FileInputName,
             BoundaryConditions& BC);
     static void ReadCSV(PhaseField& Phase, BoundaryConditions& BC,
-            std::filesystem::path FilePath, char Separator = ',');
+            std::filesystem::path FilePath, char Separator = ',',
+            bool BinaryCache = false);                                          ///< Reads rows i,j,k,phase,grain in parallel; with BinaryCache uses or writes "<FilePath>.bin" for faster later reads
 
     /// Calculates global coordinates from local mpi coordinates
     template<typename T>
@@ -198,6 +209,62 @@ class OP_EXPORTS Initializations// : public OPObject
         return true;
     }
 
+    /// Collects the local cells of a global box [Begin, End] along each direction: wraps periodic directions, clips to this rank and lists each cell once
+    static void BoxCells(std::vector<long int> (&Cells)[3],
+            const std::array<long int,3>& Begin, const std::array<long int,3>& End,
+            const std::array<long int,3>& Size,
+            const GridParameters& Dimensions, const BoundaryConditions& BC);
+
+    /// Loops over the cells of field on this rank inside the global box [Begin, End] and executes func(i,j,k) with local (i,j,k)
+    /// Exits loop when func(i,j,k) returns true and returns true in this case (on this rank only)
+    template <class T, size_t Rank>
+    static bool loop_box(Storage3D<T,Rank>& field,
+            const std::function<bool(long int, long int, long int)>& func,
+            const std::array<long int,3>& Begin, const std::array<long int,3>& End,
+            const GridParameters& Dimensions, const BoundaryConditions& BC)
+    {
+        std::vector<long int> Cells[3];
+        BoxCells(Cells, Begin, End, {field.sizeX(), field.sizeY(), field.sizeZ()}, Dimensions, BC);
+
+        const long int Nx = Cells[0].size();
+        const long int Ny = Cells[1].size();
+        const long int Nz = Cells[2].size();
+
+        int exit_loop = 0; // is used to exit loop if a certain condition is met e.g. the presence of an existing phase
+        #pragma omp parallel for collapse(3) shared(exit_loop)
+        for (long int ii = 0; ii < Nx; ++ii)
+        for (long int jj = 0; jj < Ny; ++jj)
+        for (long int kk = 0; kk < Nz; ++kk)
+        {
+            int exit_now;
+            #pragma omp atomic read
+            exit_now = exit_loop;
+            if (exit_now) continue;
+
+            if (func(Cells[0][ii], Cells[1][jj], Cells[2][kk]))
+            {
+                #pragma omp atomic write
+                exit_loop = 1;
+            }
+        }
+        return exit_loop;
+    }
+
+    /// Global box of the cells within radius of (x0,y0,z0), a single cell in inactive directions
+    template <class T, size_t Rank>
+    static void sphere_box(const Storage3D<T,Rank>& field,
+            const double x0, const double y0, const double z0, const double radius,
+            std::array<long int,3>& Begin, std::array<long int,3>& End)
+    {
+        const double pos0[3] = {x0, y0, z0};
+        const bool active[3] = {field.dNx() != 0, field.dNy() != 0, field.dNz() != 0};
+        for (int d = 0; d < 3; d++)
+        {
+            Begin[d] = active[d] ? std::floor(pos0[d] - radius) : std::round(pos0[d]);
+            End[d]   = active[d] ? std::ceil (pos0[d] + radius) : std::round(pos0[d]);
+        }
+    }
+
     /// Loops over all points (i,j,k) of a sphere with radius at (x0,y0,z0) and executes func(i,j,k,radius)
     template <class T, size_t Rank>
     static void loop_sphere(Storage3D<T,Rank>& field,
@@ -208,51 +275,25 @@ class OP_EXPORTS Initializations// : public OPObject
         // <<< It is safe to put sphere with its center coordinates outside
         // <<< of the simulation domain and its radius bigger than system
         // <<< dimensions thus not need for assertion.
-        //assert(x0 >= 0);
-        //assert(y0 >= 0);
-        //assert(z0 >= 0);
-        //assert(x0 < locSettings.TotalNx);
-        //assert(y0 < locSettings.TotalNy);
-        //assert(z0 < locSettings.TotalNz);
-        //assert(radius < std::max(locSettings.TotalNx,std::max(locSettings.TotalNy,locSettings.TotalNz)));
 
         dVector3 pos0 ({double(x0),double(y0),double(z0)});
-        const long int iRadius = std::ceil(radius);
-        const long int ii_min = (field.dNx() != 0 and field.sizeX() > 1) ? -std::min(iRadius,field.sizeX()) : 0;
-        const long int ii_max = (field.dNx() != 0 and field.sizeX() > 1) ?  std::min(iRadius,field.sizeX()) : 0;
-        const long int jj_min = (field.dNy() != 0 and field.sizeY() > 1) ? -std::min(iRadius,field.sizeY()) : 0;
-        const long int jj_max = (field.dNy() != 0 and field.sizeY() > 1) ?  std::min(iRadius,field.sizeY()) : 0;
-        const long int kk_min = (field.dNz() != 0 and field.sizeZ() > 1) ? -std::min(iRadius,field.sizeZ()) : 0;
-        const long int kk_max = (field.dNz() != 0 and field.sizeZ() > 1) ?  std::min(iRadius,field.sizeZ()) : 0;
+        std::array<long int,3> Begin;
+        std::array<long int,3> End;
+        sphere_box(field, x0, y0, z0, radius, Begin, End);
 
-        std::vector<std::array<long int,3>> list;
-
-        #pragma omp parallel for collapse(3) //NOTE has crashes MPI calculation in older version of loop!
-        for (long int ii = ii_min; ii <= ii_max; ++ii)
-        for (long int jj = jj_min; jj <= jj_max; ++jj)
-        for (long int kk = kk_min; kk <= kk_max; ++kk)
+        auto visit = [&](long int i, long int j, long int k)
         {
-            // Calculate global coordinates (i,j,k)
-            long int i = std::round(x0 + ii);
-            long int j = std::round(y0 + jj);
-            long int k = std::round(z0 + kk);
-
-            ApplyPeriodicBoundaryConditionsOnCoordinates(i,j,k,BC,Dimensions);
-            if(not CoordinatesInBoundaries(i,j,k,field,Dimensions)) continue;
-
-            // Calculate distance between (i,j,k) and (x0,y0,z0)
-            dVector3 pos ({double(i),double(j),double(k)});
-            double rad = Tools::Distance<dVector3>(pos, pos0, Dimensions.TotalNx, Dimensions.TotalNy, Dimensions.TotalNz, BC).abs();
-            if (rad > radius) continue;
-
-            // Convert global coordinates to local block coordinates
+            // Calculate distance between (i,j,k) and (x0,y0,z0) in global coordinates
 #ifdef MPI_PARALLEL
-            i -= Dimensions.OffsetX;
-            j -= Dimensions.OffsetY;
-            k -= Dimensions.OffsetZ;
+            dVector3 pos ({double(i + Dimensions.OffsetX),double(j + Dimensions.OffsetY),double(k + Dimensions.OffsetZ)});
+#else
+            dVector3 pos ({double(i),double(j),double(k)});
 #endif
-            func(i,j,k,rad);
-        }
+            double rad = Tools::Distance<dVector3>(pos, pos0, Dimensions.TotalNx, Dimensions.TotalNy, Dimensions.TotalNz, BC).abs();
+            if (rad <= radius) func(i,j,k,rad);
+            return false;
+        };
+        loop_box(field, visit, Begin, End, Dimensions, BC);
     }
 
     /// Loops over all points (i,j,k) of a sphere with radius at (x0,y0,z0) and executes func(i,j,k,radius)
@@ -272,42 +313,23 @@ class OP_EXPORTS Initializations// : public OPObject
         assert(radius < std::max(Dimensions.TotalNx,std::max(Dimensions.TotalNy,Dimensions.TotalNz)));
 
         dVector3 pos0 ({double(x0),double(y0),double(z0)});
-        const long int iRadius = std::ceil(radius);
-        const long int ii_min = (field.dNx() != 0) ? -iRadius : 0;
-        const long int ii_max = (field.dNx() != 0) ?  iRadius : 0;
-        const long int jj_min = (field.dNy() != 0) ? -iRadius : 0;
-        const long int jj_max = (field.dNy() != 0) ?  iRadius : 0;
-        const long int kk_min = (field.dNz() != 0) ? -iRadius : 0;
-        const long int kk_max = (field.dNz() != 0) ?  iRadius : 0;
+        std::array<long int,3> Begin;
+        std::array<long int,3> End;
+        sphere_box(field, x0, y0, z0, radius, Begin, End);
 
-        int loc_exit_loop = 0; // is used to exit loop if a certain condition is met e.g. the presence of an existing phase
-        #pragma omp parallel for shared(loc_exit_loop) collapse(3) //NOTE has crashes MPI calculation in older version of loop!
-        for (long int ii = ii_min; ii <= ii_max; ++ii)
-        for (long int jj = jj_min; jj <= jj_max; ++jj)
-        for (long int kk = kk_min; kk <= kk_max; ++kk)
+        auto visit = [&](long int i, long int j, long int k)
         {
-            if (loc_exit_loop) continue;
-            // Calculate global coordinates (i,j,k)
-            long int i = std::round(x0 + ii);
-            long int j = std::round(y0 + jj);
-            long int k = std::round(z0 + kk);
-
-            ApplyPeriodicBoundaryConditionsOnCoordinates(i,j,k,BC,Dimensions);
-            if(not CoordinatesInBoundaries(i,j,k,field,Dimensions)) continue;
-
-            // Calculate distance between (i,j,k) and (x0,y0,z0)
+            // Calculate distance between (i,j,k) and (x0,y0,z0) in global coordinates
+#ifdef MPI_PARALLEL
+            dVector3 pos ({double(i + Dimensions.OffsetX),double(j + Dimensions.OffsetY),double(k + Dimensions.OffsetZ)});
+#else
             dVector3 pos ({double(i),double(j),double(k)});
+#endif
             double rad = Tools::Distance<dVector3>(pos, pos0, Dimensions.TotalNx, Dimensions.TotalNy, Dimensions.TotalNz, BC).abs();
-            if (rad > radius) continue;
+            return (rad <= radius) and func(i,j,k,rad);
+        };
+        int loc_exit_loop = loop_box(field, visit, Begin, End, Dimensions, BC);
 
-            // Convert global coordinates to local block coordinates
-#ifdef MPI_PARALLEL
-            i -= Dimensions.OffsetX;
-            j -= Dimensions.OffsetY;
-            k -= Dimensions.OffsetZ;
-#endif
-            if (func(i,j,k,rad)) loc_exit_loop++;
-        }
         int exit_loop = 0;
 #ifdef MPI_PARALLEL
         OP_MPI_Allreduce(&loc_exit_loop, &exit_loop, 1, OP_MPI_INT, OP_MPI_SUM, OP_MPI_COMM_WORLD);
@@ -0,0 +1,106 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef INTERFACEAVERAGING_H
+#define INTERFACEAVERAGING_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+class GrainsProperties;
+
+enum class AveragingWeightsModes                                                ///< Weights of the neighbour values in the interface averaging
+{
+    Range,                                                                      ///< Distance weight Range - |offset|
+    PhaseFields,                                                                ///< Phase-field weight sqrt(phi_alpha*phi_beta) of the neighbour
+    Counter,                                                                    ///< Equal weights
+    RangePhaseFields                                                            ///< Product of the distance and the phase-field weights
+};
+
+struct AveragingRules                                                           ///< Settings of a consumer of InterfaceAveraging
+{
+    AveragingWeightsModes CollectWeights;                                       ///< Weights used by Collect()
+    AveragingWeightsModes DistributeWeights;                                    ///< Weights used by Distribute()
+    double PhiThreshold;                                                        ///< Outlines the inner part of the interface
+    double MinWeight;                                                           ///< Neighbour weights (and pair weights in Distribute()) have to exceed this value
+    bool ScaleThreshold;                                                        ///< If true, the threshold is scaled by the volume ratios of the pair
+    bool InterfaceNeighbours;                                                   ///< If true, only neighbours with interface flag contribute
+    bool SeedsCollectRaw;                                                       ///< If true, Collect() sets tmp = raw for seed pairs below the threshold
+    bool EmptyCollectRaw;                                                       ///< If true, Collect() sets tmp = raw if no neighbour contributes
+};
+
+class OP_EXPORTS InterfaceAveraging                                             ///< Two-stage averaging of pair-wise NodeDF values across the interface band
+{
+    /* Shared by DrivingForce and InterfaceRegularization. The averaging
+    stencil is built once, all stages loop over a cell list (the interface
+    band of the phase field) instead of the whole storage. Collect() writes
+    the weighted average of the raw values of the neighbours to tmp,
+    Distribute() averages tmp of the inner interface cells to average. The
+    boundary conditions of the values have to be set between the stages. */
+ public:
+    void Initialize(const GridParameters& Grid, const int Range);               ///< Builds the averaging stencil
+    void SetWeights(Storage3D<NodeDF, 0>& Values,
+                    const Storage3D<NodePF, 0>& Fields,
+                    const std::vector<iVector3>& Cells) const;                  ///< Sets the pair weights sqrt(phi_alpha*phi_beta)
+    void Collect(Storage3D<NodeDF, 0>& Values,
+                 const Storage3D<NodePF, 0>& Fields,
+                 const std::vector<iVector3>& Cells,
+                 const GrainsProperties& Grains,
+                 const AveragingRules& Rules) const;                            ///< First stage, averages raw into tmp
+    void Distribute(Storage3D<NodeDF, 0>& Values,
+                    const Storage3D<NodePF, 0>& Fields,
+                    const std::vector<iVector3>& Cells,
+                    const GrainsProperties& Grains,
+                    const AveragingRules& Rules) const;                         ///< Second stage, averages tmp into average
+
+    int Range = 0;                                                              ///< Radius of the averaging sphere
+
+ private:
+    struct Offset                                                               ///< Neighbour within the averaging range
+    {
+        int di;                                                                 ///< Offset in x direction
+        int dj;                                                                 ///< Offset in y direction
+        int dk;                                                                 ///< Offset in z direction
+        double weight;                                                          ///< Distance weight Range - |offset|
+    };
+    std::vector<Offset> Stencil;                                                ///< Offsets with positive distance weight
+    int Xrange = 0;                                                             ///< Stencil extent in x direction
+    int Yrange = 0;                                                             ///< Stencil extent in y direction
+    int Zrange = 0;                                                             ///< Stencil extent in z direction
+
+    bool Reachable(const Storage3D<NodeDF, 0>& Values,
+                   const long int i, const long int j, const long int k) const  ///< True if the stencil around (i,j,k) stays within the storage
+    {
+        return i - Xrange >= -Values.BcellsX() and i + Xrange < Values.sizeX() + Values.BcellsX() and
+               j - Yrange >= -Values.BcellsY() and j + Yrange < Values.sizeY() + Values.BcellsY() and
+               k - Zrange >= -Values.BcellsZ() and k + Zrange < Values.sizeZ() + Values.BcellsZ();
+    }
+};
+
+} // namespace openphase
+#endif
@@ -42,6 +42,7 @@ class OP_EXPORTS InterfaceDiffusion : public OPObject
     InterfaceDiffusion(Settings& locSetting,
                        const std::string InputFileName = DefaultInputFileName); ///< Constructor, initializes the class form input file
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override; ///< Initializes, just to indicate that module has been created.
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;                   ///< Reads the initial parameters for the interface diffusion
 	void ReadInput(std::stringstream& inp) override;                            ///< Reads the initial parameters for the interface diffusion
     void CalculatePhaseFieldIncrements(PhaseField& Phase,
@@ -72,6 +73,7 @@ class InterfaceDiffusionAnisotropic : public InterfaceDiffusion
     InterfaceDiffusionAnisotropic(Settings& locSetting,
             const std::string InputFileName = DefaultInputFileName);            ///< Constructor that initialises the class form input file
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override;                            ///< Initializes, just to indicate that module has been created.
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;                   ///< Reads the initial parameters for the interface diffusion
 
     void CalculatePhaseFieldIncrements(PhaseField& Phase,
@@ -32,6 +32,7 @@
 #include "InterfaceProperties/InterfaceMobilityModel.h"
 #include "Thermodynamics/Element.h"
 #include "Thermodynamics/ThermodynamicPhase.h"
+#include "Temperature.h"
 
 #include <set>
 
@@ -43,6 +44,7 @@ class Settings;
 class Temperature;
 class DoubleObstacle;
 class DrivingForce;
+class PhaseFieldDevice;
 enum class TripleJunctionModels                                                 ///< Models for triple junction term calculation
 {
     Model,                                                                      ///< Factorised sum of pair interface energies
@@ -54,6 +56,7 @@ class OP_EXPORTS InterfaceProperties : public OPObject
 {
     friend DoubleObstacle;
     friend DrivingForce;
+    friend PhaseFieldDevice;
 
  public:
 
@@ -68,6 +71,8 @@ class OP_EXPORTS InterfaceProperties : public OPObject
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override; ///< Initializes all variables, allocates storages
     void Remesh(int newNx, int newNy, int newNz,
                 const BoundaryConditions& BC) override;                         ///< Remeshes/reallocates the storage
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;                   ///< Reads input from a file
     void ReadInput(std::stringstream& inp) override;                            ///< Reads input from a stringstream
     void ReadJSON(const std::string InputFileName);
@@ -132,7 +137,24 @@ class OP_EXPORTS InterfaceProperties : public OPObject
 
     bool   FullAnisotropy;                                                      ///< True if full interface energy anisotropy model is used, false otherwise
 
-    void SetSR(const PhaseField& Phase);                                        ///< Sets both, interface energy and mobility
+    std::vector<iVector3> SetCells;                                             ///< Cells with properties set in the last SetSR() call, cleared in the next call
+    std::vector<iVector3> SetCellsDR;                                           ///< Cells with properties set in the last SetDR() call, cleared in the next call
+
+    bool   IncrementalSet;                                                      ///< If true, SetSR() reuses the properties of cells whose phase fields and interface normals did not change significantly
+    double IncrementalSetTolerance;                                             ///< Cosine of the maximum rotation angle of the interface normals for which the properties are reused
+    Storage3D< NodeA<dVector3>, 0 > PropertiesNormals;                          ///< Interface normals of the phase fields at the last evaluation of the properties in each cell (IncrementalSet only)
+    TemperatureSubscription ThermalCache;                                       ///< Cells whose temperature changed since their thermally scaled mobilities were set (IncrementalSet only)
+    void TabulateInterfaceEnergy(const size_t alpha, const size_t beta,
+                                 const double Tolerance);                       ///< Switches the interface energy model of a phase pair to the tabulated mode
+    void ReadMobilityTable(const size_t alpha, const size_t beta,
+                           std::string FileName);                               ///< Reads the tabulated thermal mobility factor of a phase pair from a CSV file (columns: temperature, factor)
+    bool ReusePropertiesSR(const PhaseField& Phase,
+                           const long int i, const long int j, const long int k) const;///< True if the properties of cell (i,j,k) from the previous SetSR() call are still valid
+    void StorePropertiesNormalsSR(const PhaseField& Phase,
+                                  const long int i, const long int j, const long int k);///< Stores the interface normals used to evaluate the properties of cell (i,j,k)
+
+    void SetSR(const PhaseField& Phase, const bool incremental = false,
+               const Temperature* Tx = nullptr);                                ///< Sets both, interface energy and mobility, reuses unchanged cells if incremental and IncrementalSet are true, applies the thermal effect on the mobility if Tx is given
     void SetDR(const PhaseField& Phase);                                        ///< Sets both, interface energy and mobility
 
     void SetMobilityThermalEffectSR(const PhaseField& Phase,
@@ -306,9 +306,13 @@ class InterfaceEnergyModel
     };
 
     double CalculateDisorientation(Quaternion& OrientationA, Quaternion& OrientationB)
+    {
+        return CalculateDisorientation(Tools::getDisorientationCubic(OrientationA, OrientationB));
+    }
+
+    double CalculateDisorientation(const double misorientation)                 ///< Read-Shockley energy of a given disorientation angle
     {
         double constant = 0.85;                                                 // Shear Modulus*Burgers vector/4*Pi*(1-v)
-        double misorientation = Tools::getDisorientationCubic(OrientationA, OrientationB);
         double locEnergy = 0.0;
 
         if (misorientation <= 0.349066)
@@ -323,6 +327,14 @@ class InterfaceEnergyModel
     }
 
     double Calculate(dVector3& locNormal)                                       ///< Calculate anisotropic interface energy
+    {
+        if(TableSize)
+        {
+            return Interpolate(locNormal);
+        }
+        return Evaluate(locNormal);
+    }
+    double Evaluate(const dVector3& locNormal) const                            ///< Evaluates the analytic anisotropy function
     {
         double locEnergy = 0.0;
         switch(Model)
@@ -472,6 +484,105 @@ class InterfaceEnergyModel
         return locEnergy;
     };
 
+    /* Tabulated mode: the energy is stored on a cube-sphere grid (gnomonic
+    projection of the unit sphere onto the six faces of a cube, TableSize
+    intervals per face edge) and interpolated bilinearly on the face which the
+    normal points to. Only the smooth cubic and hexagonal models are tabulated,
+    the faceted models have kinks which are not resolved by the interpolation.*/
+    bool Tabulate(const double Tolerance, const size_t MaxTableSize = 512)     ///< Tabulates the energy, the table is refined until the relative interpolation error is below Tolerance. Returns false if the model is not tabulated
+    {
+        if(Model != InterfaceEnergyModels::Cubic and
+           Model != InterfaceEnergyModels::CubicFull and
+           Model != InterfaceEnergyModels::HexBoettger and
+           Model != InterfaceEnergyModels::HexSun and
+           Model != InterfaceEnergyModels::HexYang)
+        {
+            TableSize = 0;
+            EnergyTable.clear();
+            return false;
+        }
+
+        for(size_t locSize = 16; locSize <= MaxTableSize; locSize *= 2)
+        {
+            TableSize = locSize;
+            const size_t nodes = TableSize + 1;
+            EnergyTable.resize(6*nodes*nodes);
+            for(size_t face = 0; face < 6; face++)
+            for(size_t a = 0; a < nodes; a++)
+            for(size_t b = 0; b < nodes; b++)
+            {
+                const double u = -1.0 + 2.0*a/TableSize;
+                const double v = -1.0 + 2.0*b/TableSize;
+                EnergyTable[(face*nodes + a)*nodes + b] = Evaluate(FaceNormal(face, u, v));
+            }
+
+            // The bilinear interpolation error is largest in the cell centers
+            TableError = 0.0;
+            for(size_t face = 0; face < 6; face++)
+            for(size_t a = 0; a < TableSize; a++)
+            for(size_t b = 0; b < TableSize; b++)
+            {
+                const double u = -1.0 + (2.0*a + 1.0)/TableSize;
+                const double v = -1.0 + (2.0*b + 1.0)/TableSize;
+                const dVector3 locNormal = FaceNormal(face, u, v);
+                const double exact = Evaluate(locNormal);
+                const double error = std::fabs(Interpolate(locNormal) - exact)/std::max(std::fabs(exact), DBL_MIN);
+                TableError = std::max(TableError, error);
+            }
+            if(TableError <= Tolerance) break;
+        }
+        if(TableError > Tolerance)
+        {
+            std::stringstream message;
+            message << "Tabulation error " << TableError << " exceeds the tolerance " << Tolerance
+                    << " with the maximum table size " << TableSize;
+            ConsoleOutput::WriteWarning(message.str(), "InterfaceEnergyModel", "Tabulate()");
+        }
+        return true;
+    }
+    double Interpolate(const dVector3& locNormal) const                         ///< Interpolates the tabulated energy
+    {
+        const double ax = std::fabs(locNormal[0]);
+        const double ay = std::fabs(locNormal[1]);
+        const double az = std::fabs(locNormal[2]);
+
+        size_t face = 0;
+        double u = 0.0;
+        double v = 0.0;
+        if(ax >= ay and ax >= az)
+        {
+            if(ax <= DBL_MIN) return Evaluate(locNormal);
+            face = (locNormal[0] > 0.0) ? 0 : 1;
+            u = locNormal[1]/ax;
+            v = locNormal[2]/ax;
+        }
+        else if(ay >= az)
+        {
+            face = (locNormal[1] > 0.0) ? 2 : 3;
+            u = locNormal[2]/ay;
+            v = locNormal[0]/ay;
+        }
+        else
+        {
+            face = (locNormal[2] > 0.0) ? 4 : 5;
+            u = locNormal[0]/az;
+            v = locNormal[1]/az;
+        }
+
+        const size_t nodes = TableSize + 1;
+        const double x = 0.5*(u + 1.0)*TableSize;
+        const double y = 0.5*(v + 1.0)*TableSize;
+        const size_t a = std::min(size_t(x), TableSize - 1);
+        const size_t b = std::min(size_t(y), TableSize - 1);
+        const double wx = x - a;
+        const double wy = y - b;
+
+        const double* row0 = &EnergyTable[(face*nodes + a)*nodes + b];
+        const double* row1 = row0 + nodes;
+        return (1.0 - wx)*((1.0 - wy)*row0[0] + wy*row0[1]) +
+                      wx *((1.0 - wy)*row1[0] + wy*row1[1]);
+    }
+
     dVector3 Derivative(const dVector3& locNormal) const
     {
         switch(Model)
@@ -523,6 +634,10 @@ class InterfaceEnergyModel
     std::vector<double> FacetEpsilon;                                           ///< Interface energy anisotropy parameter for a facet family
     std::vector<double> FacetPower;                                             ///< Experimental interface energy anisotropy parameter
 
+    size_t TableSize = 0;                                                       ///< Number of intervals per cube face edge of the energy table (0 - no table)
+    double TableError = 0.0;                                                    ///< Maximum relative interpolation error of the energy table
+    std::vector<double> EnergyTable;                                            ///< Tabulated energy on the cube-sphere grid
+
     double Energy;                                                              ///< Interface energy
     double MaxEnergy;                                                           ///< Maximum interface energy for a phase pair
     double MinEnergy;                                                           ///< Minimum interface energy for a phase pair
@@ -531,6 +646,22 @@ class InterfaceEnergyModel
     double Epsilon2;                                                            ///< Interface energy anisotropy parameter
     double Epsilon3;                                                            ///< Interface energy anisotropy parameter
     double Epsilon4;                                                            ///< Interface energy anisotropy parameter
+
+ private:
+    static dVector3 FaceNormal(const size_t face, const double u, const double v)///< Unit normal of the cube-sphere grid point (u,v) on a given face
+    {
+        dVector3 locNormal;
+        switch(face)
+        {
+            case 0: locNormal = { 1.0,   u,   v}; break;
+            case 1: locNormal = {-1.0,   u,   v}; break;
+            case 2: locNormal = {   v, 1.0,   u}; break;
+            case 3: locNormal = {   v,-1.0,   u}; break;
+            case 4: locNormal = {   u,   v, 1.0}; break;
+            default: locNormal = {  u,   v,-1.0}; break;
+        }
+        return locNormal.normalized();
+    }
 };
 }// namespace openphase
 #endif
@@ -290,6 +290,17 @@ class InterfaceMobilityModel
         }
         return locMobility;
     };
+    double ThermalFactor(const double T) const                                  ///< Temperature dependence of the mobility, tabulated if a table is given, Arrhenius type otherwise
+    {
+        if(not ThermalFactorTable.empty())
+        {
+            /* Neighboring cells have similar temperatures, the interval of
+            the previous lookup of this thread is tried first.*/
+            static thread_local size_t bracket = 0;
+            return ThermalFactorTable(T, bracket);
+        }
+        return exp(-ActivationEnergy/(PhysicalConstants::R*T));
+    };
 
     size_t Nfacets;                                                             ///< Number of facet types, e.g. <100>, <111>, <110>, etc...
     std::vector<std::vector<iVector3>> FacetVectors;                            ///< Set of planes for different facet types
@@ -303,6 +314,7 @@ class InterfaceMobilityModel
     double Epsilon3;                                                            ///< Interface mobility anisotropy parameter
     double Epsilon4;                                                            ///< Interface mobility anisotropy parameter
     double ActivationEnergy;                                                    ///< Interface mobility activation energy
+    InterpolationTable ThermalFactorTable;                                      ///< Tabulated mobility factor vs. temperature, replaces the activation energy if set
 };
 }// namespace openphase
 #endif
@@ -30,6 +30,7 @@
 #include "Includes.h"
 #include "PhaseField.h"
 #include "BoundaryConditions.h"
+#include "InterfaceAveraging.h"
 
 namespace openphase
 {
@@ -50,6 +51,8 @@ class OP_EXPORTS InterfaceRegularization : public OPObject
     void ReadInput(const std::string InputFileName) override;                   ///< Reads settings
     void ReadInput(std::stringstream& inp) override;                            ///< Reads settings
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override;///< Remeshes the storage while keeping the data
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void SetBoundaryConditions(const BoundaryConditions& BC) override;          ///< Sets the boundary conditions
 
     void Clear(void);                                                           ///< Deletes curvature in the storage.
@@ -82,13 +85,7 @@ class OP_EXPORTS InterfaceRegularization : public OPObject
 
  protected:
  private:
-    void SetWeightsSR(const PhaseField& Phase);                                 ///< Sets averaging weights for curvature across the interface in single resolution
-    void CollectAverageSR(const PhaseField& Phase);                             ///< Average curvature across the interface in single resolution
-    void DistributeAverageSR(const PhaseField& Phase);                          ///< Average curvature across the interface in single resolution
-
-    void SetWeightsDR(const PhaseField& Phase);                                 ///< Sets averaging weights for curvature across the interface in double resolution
-    void CollectAverageDR(const PhaseField& Phase);                             ///< Average curvature across the interface in double resolution
-    void DistributeAverageDR(const PhaseField& Phase);                          ///< Average curvature across the interface in double resolution
+    InterfaceAveraging Averager;                                                ///< Averaging stencil and stages shared with DrivingForce
 
     void MergePhaseFieldIncrementsSR(PhaseField& Phase, InterfaceProperties& IP);///< Merges the curvature contribution into the phase field increments.
     void MergePhaseFieldIncrementsDR(PhaseField& Phase, InterfaceProperties& IP);///< Merges the curvature contribution into the phase field increments.
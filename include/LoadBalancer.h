@@ -0,0 +1,189 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LOADBALANCER_H
+#define LOADBALANCER_H
+
+#include "Includes.h"
+#include "GridParameters.h"
+#include <numeric>
+
+namespace openphase
+{
+class Settings;
+class BoundaryConditions;
+class PhaseField;
+
+/* Dynamic load balancing of the MPI 3D domain decomposition. By default every
+rank gets an equal box, while the work concentrates at interfaces and in the
+fluid. Every Interval time steps Balance() estimates the cost of each cell
+(bulk cells 1, interface cells 1 + InterfaceCost, fluid cells 1 + FluidCost
+times the liquid fraction, or a user supplied cost field), sums it into one
+profile per Cartesian direction and cuts each profile into MPI_CART_SIZE
+parts of equal cost by recursive bisection. The cut planes stay orthogonal
+to the axes so that every rank keeps one neighbour per face and the halo
+exchange of BoundaryConditions works unchanged. If the cost imbalance (max
+over mean of the rank costs) exceeds Threshold and the new cut planes reduce
+the most expensive rank by at least MinGain, they are stored in
+MPI_CART_CUTS and Settings::RepartitionAll() migrates the data: each object
+registered for remeshing moves its storages with Migrate(), which packs the
+overlap of the old local box with each new box through the pack()/unpack()
+windows of Storage3D and exchanges them in one all-to-all. Objects without a
+Repartition() method (e.g. the spectral solvers, which need equal slabs)
+disable the balancing. Each repartitioning is logged to TextDir/CutPlanes.dat
+(time step, imbalance before and after, cut planes). Raw data written after
+a repartitioning holds the repartitioned local boxes: Settings::WriteAll()
+stores the cut planes next to it (RawDataDir/CutPlanes_<tStep>.dat) and
+Settings::ReadAll() reapplies them before reading, raw data written by the
+Write() methods of individual objects carries no such record and cannot be
+restarted. Input (module @LoadBalancer):
+
+    $Interval       Time steps between checks (0 disables)            0
+    $Threshold      Imbalance that triggers a repartitioning          1.1
+    $MinGain        Required relative reduction of the maximum cost   0.05
+    $InterfaceCost  Extra cost of an interface cell                   4.0
+    $FluidCost      Extra cost of a liquid cell                       0.0  */
+
+class OP_EXPORTS LoadBalancer : public OPObject
+{
+ public:
+    LoadBalancer(){};
+    LoadBalancer(Settings& locSettings,
+                 const std::string InputFileName = DefaultInputFileName)
+    {
+        Initialize(locSettings);
+        ReadInput(InputFileName);
+    }
+    void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override;///< Initializes the default parameters
+    void ReadInput(const std::string InputFileName) override;                   ///< Reads input parameters from the file
+    void ReadInput(std::stringstream& inp) override;                            ///< Reads input parameters from the stringstream
+
+    bool Balance(Settings& locSettings, const PhaseField& Phase,
+                 const BoundaryConditions& BC, const int tStep);                ///< Repartitions the domain if due and profitable, cost estimated from Phase (collective), returns true if repartitioned
+    bool Balance(Settings& locSettings, const Storage3D<double,0>& Cost,
+                 const BoundaryConditions& BC, const int tStep);                ///< Repartitions the domain if due and profitable, user cost per cell (collective), returns true if repartitioned
+
+    void CellCosts(const PhaseField& Phase, Storage3D<double,0>& Cost) const;   ///< Estimates the cost of each local cell from the phase field
+
+    static std::vector<int> Bisect(const std::vector<double>& Profile,
+                                   const int Parts, const int MinWidth);        ///< Cut planes (Parts + 1 coordinates) splitting Profile into Parts of equal cost by recursive bisection, each part at least MinWidth wide
+
+    template<class T, size_t Rank>
+    static void Migrate(Storage3D<T,Rank>& Field, const GridParameters& OldGrid,
+                        const GridParameters& NewGrid);                         ///< Moves the interior of Field from the local box of OldGrid to the one of NewGrid (collective), boundary cells have to be set afterwards
+
+    int    Interval;                                                            ///< Time steps between checks, 0 disables the balancing
+    double Threshold;                                                           ///< Imbalance (max over mean rank cost) that triggers a repartitioning
+    double MinGain;                                                             ///< Required relative reduction of the maximum rank cost
+    double InterfaceCost;                                                       ///< Extra cost of an interface cell relative to a bulk cell
+    double FluidCost;                                                           ///< Extra cost of a liquid cell relative to a bulk cell
+
+    double Imbalance;                                                           ///< Imbalance at the last check
+    size_t Repartitions;                                                        ///< Number of repartitionings done
+
+ private:
+    Storage3D<double,0> Costs;                                                  ///< Cost per cell, reallocated with the local domain
+    bool Warned;                                                                ///< Balancing is not possible, the warning has been issued
+};
+
+template<class T, size_t Rank>
+void LoadBalancer::Migrate(Storage3D<T,Rank>& Field, const GridParameters& OldGrid,
+                           const GridParameters& NewGrid)
+{
+#ifdef MPI_PARALLEL
+    /* Local boxes {OffsetX, Nx, OffsetY, Ny, OffsetZ, Nz} of all ranks */
+    const int OldBox[6] = {OldGrid.OffsetX, OldGrid.Nx, OldGrid.OffsetY, OldGrid.Ny, OldGrid.OffsetZ, OldGrid.Nz};
+    const int NewBox[6] = {NewGrid.OffsetX, NewGrid.Nx, NewGrid.OffsetY, NewGrid.Ny, NewGrid.OffsetZ, NewGrid.Nz};
+    std::vector<int> OldBoxes(6*MPI_SIZE);
+    std::vector<int> NewBoxes(6*MPI_SIZE);
+    OP_MPI_Allgather(OldBox, 6, OP_MPI_INT, OldBoxes.data(), 6, OP_MPI_INT, OP_MPI_COMM_WORLD);
+    OP_MPI_Allgather(NewBox, 6, OP_MPI_INT, NewBoxes.data(), 6, OP_MPI_INT, OP_MPI_COMM_WORLD);
+
+    /* Overlap of two boxes as a pack() window relative to the origin of the
+    first one, both sides traverse it in the same order */
+    auto Window = [](const int* Box, const int* Other, std::vector<long int>& window)
+    {
+        bool Empty = false;
+        for(int d = 0; d < 3; d++)
+        {
+            const int Begin = std::max(Box[2*d], Other[2*d]);
+            const int End   = std::min(Box[2*d] + Box[2*d+1], Other[2*d] + Other[2*d+1]);
+            window[2*d]   = Begin - Box[2*d];
+            window[2*d+1] = End   - Box[2*d];
+            Empty = Empty or End <= Begin;
+        }
+        return not Empty;
+    };
+
+    std::vector<long int> window(6);
+    std::vector<double> Chunk;
+    std::vector<double> SendBuffer;
+    std::vector<int> SendCounts(MPI_SIZE, 0);
+    std::vector<int> SendDispls(MPI_SIZE, 0);
+    for(int r = 0; r < MPI_SIZE; r++)
+    {
+        SendDispls[r] = SendBuffer.size();
+        if(Window(OldBox, &NewBoxes[6*r], window))
+        {
+            Field.pack(Chunk, window);
+            SendBuffer.insert(SendBuffer.end(), Chunk.begin(), Chunk.end());
+            SendCounts[r] = Chunk.size();
+        }
+    }
+
+    /* Node storages pack a variable number of values per cell, the counts
+    are exchanged first */
+    std::vector<int> Ones(MPI_SIZE, 1);
+    std::vector<int> Ranks(MPI_SIZE);
+    std::iota(Ranks.begin(), Ranks.end(), 0);
+    std::vector<int> RecvCounts(MPI_SIZE, 0);
+    OP_MPI_Alltoallv(SendCounts.data(), Ones.data(), Ranks.data(), OP_MPI_INT,
+                     RecvCounts.data(), Ones.data(), Ranks.data(), OP_MPI_INT, OP_MPI_COMM_WORLD);
+    std::vector<int> RecvDispls(MPI_SIZE, 0);
+    for(int r = 1; r < MPI_SIZE; r++)
+    {
+        RecvDispls[r] = RecvDispls[r-1] + RecvCounts[r-1];
+    }
+    std::vector<double> RecvBuffer(RecvDispls.back() + RecvCounts.back());
+    OP_MPI_Alltoallv(SendBuffer.data(), SendCounts.data(), SendDispls.data(), OP_MPI_DOUBLE,
+                     RecvBuffer.data(), RecvCounts.data(), RecvDispls.data(), OP_MPI_DOUBLE, OP_MPI_COMM_WORLD);
+    SendBuffer = std::vector<double>();
+
+    Field.Reallocate(NewGrid.Nx, NewGrid.Ny, NewGrid.Nz);
+    Field.Clear();
+    for(int r = 0; r < MPI_SIZE; r++)
+    if(Window(NewBox, &OldBoxes[6*r], window))
+    {
+        Chunk.assign(RecvBuffer.begin() + RecvDispls[r],
+                     RecvBuffer.begin() + RecvDispls[r] + RecvCounts[r]);
+        Field.unpack(Chunk, window);
+    }
+#else
+    (void) Field;   //unused
+    (void) OldGrid; //unused
+    (void) NewGrid; //unused
+#endif
+}
+
+}// namespace openphase
+#endif
@@ -44,12 +44,23 @@
 #    define OMP_COLLAPSE_LOOPS 3
 #    define OMP_CHUNKSIZE 128
 #    define OMP_SCHEDULING_TYPE dynamic
+#    ifdef NUMA_FIRST_TOUCH
+/* The storages are first written with a static partition of their data (see
+ResizeStorage() in AlignedAllocator.h), the storage loops use the same static
+schedule so that each thread mostly works on memory of its own NUMA node */
+#        define OMP_STORAGE_SCHEDULE schedule(static)
+#    else
+#        define OMP_STORAGE_SCHEDULE schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
+#    endif
 #else
 #    define myclock_t clock_t
 #    define mygettime() clock()
 #    define OP_CLOCKS_PER_SEC CLOCKS_PER_SEC
 #endif
 
+#define OMP_DEFAULT_TILE_SIZE_X 8
+#define OMP_DEFAULT_TILE_SIZE_Y 8
+
 #define STORAGE_LOOP_BEGIN(i,j,k,T__,op_loop_bcells__) \
     {\
     if ((long int) op_loop_bcells__ > (T__).Bcells() )\
@@ -103,7 +114,7 @@
     const long int op_loop_upper_X__ = std::max((long int)((T__).sizeX() + (op_loop_bcells_X__)),(long int)((T__).sizeX())); \
     const long int op_loop_upper_Y__ = std::max((long int)((T__).sizeY() + (op_loop_bcells_Y__)),(long int)((T__).sizeY())); \
     const long int op_loop_upper_Z__ = std::max((long int)((T__).sizeZ() + (op_loop_bcells_Z__)),(long int)((T__).sizeZ())); \
-    _Pragma(STRINGIFY(omp parallel for collapse(OMP_COLLAPSE_LOOPS) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE) __VA_ARGS__) ) \
+    _Pragma(STRINGIFY(omp parallel for collapse(OMP_COLLAPSE_LOOPS) OMP_STORAGE_SCHEDULE __VA_ARGS__) ) \
     for (long int i = op_loop_lower_X__; i < op_loop_upper_X__; ++i) \
     for (long int j = op_loop_lower_Y__; j < op_loop_upper_Y__; ++j) \
     for (long int k = op_loop_lower_Z__; k < op_loop_upper_Z__; ++k) \
@@ -112,4 +123,279 @@
 #define OMP_PARALLEL_STORAGE_LOOP_END \
     }\
 }
+
+/* Orphaned variants of the loop macros. They contain only the work-sharing
+"omp for" and have to be encountered by all threads of an enclosing parallel
+region. This way the loops of one stage, e.g. finalizing the phase fields,
+setting the boundary conditions, flags and derivatives, run in a single
+parallel region instead of forking and joining the threads for every loop:
+
+    #pragma omp parallel
+    {
+        OMP_STORAGE_LOOP_BEGIN(i,j,k,Field,0,)
+        {
+            ...
+        }
+        OMP_STORAGE_LOOP_END
+        OMP_TILED_STORAGE_LOOP_BEGIN(i,j,k,Field,1,)
+        ...
+    }
+
+Each loop ends with an implicit barrier, "nowait" can be passed with the
+clauses if the following code does not depend on the results of the loop.
+Variables declared inside the region are private, reductions therefore need
+variables declared before the region. Outside of a parallel region the loops
+are executed by the calling thread alone. Methods built from these loops are
+named with the suffix "Team" (e.g. BoundaryConditions::SetLocalTeam()). */
+
+#define OMP_FOR_LOOP_BEGIN(i,begin__,end__,...) \
+{\
+    _Pragma(STRINGIFY(omp for schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE) __VA_ARGS__) ) \
+    for (long int i = begin__; i < end__; ++i) \
+    {
+
+#define OMP_FOR_LOOP_END \
+    } \
+}
+
+#define OMP_STORAGE_LOOP_BEGIN(i,j,k,T__,op_loop_bcells__,...) \
+{\
+    if ((long int) op_loop_bcells__ > (T__).Bcells() )\
+    {\
+        std::cerr << "OMP_STORAGE_LOOP: BOUNDARY TOO SMALL! PLEASE ADJUST! BCELLS NEEDED " << op_loop_bcells__ << std::endl;\
+        std::abort();\
+    }\
+    const long int op_loop_bcells_X__ = std::min((T__).BcellsX(), (long int) op_loop_bcells__); \
+    const long int op_loop_bcells_Y__ = std::min((T__).BcellsY(), (long int) op_loop_bcells__); \
+    const long int op_loop_bcells_Z__ = std::min((T__).BcellsZ(), (long int) op_loop_bcells__); \
+    const long int op_loop_lower_X__ = std::min(-(op_loop_bcells_X__),(long int)0); \
+    const long int op_loop_lower_Y__ = std::min(-(op_loop_bcells_Y__),(long int)0); \
+    const long int op_loop_lower_Z__ = std::min(-(op_loop_bcells_Z__),(long int)0); \
+    const long int op_loop_upper_X__ = std::max((long int)((T__).sizeX() + (op_loop_bcells_X__)),(long int)((T__).sizeX())); \
+    const long int op_loop_upper_Y__ = std::max((long int)((T__).sizeY() + (op_loop_bcells_Y__)),(long int)((T__).sizeY())); \
+    const long int op_loop_upper_Z__ = std::max((long int)((T__).sizeZ() + (op_loop_bcells_Z__)),(long int)((T__).sizeZ())); \
+    _Pragma(STRINGIFY(omp for collapse(OMP_COLLAPSE_LOOPS) OMP_STORAGE_SCHEDULE __VA_ARGS__) ) \
+    for (long int i = op_loop_lower_X__; i < op_loop_upper_X__; ++i) \
+    for (long int j = op_loop_lower_Y__; j < op_loop_upper_Y__; ++j) \
+    for (long int k = op_loop_lower_Z__; k < op_loop_upper_Z__; ++k) \
+    {
+
+#define OMP_STORAGE_LOOP_END \
+    }\
+}
+
+/* Cache-blocked variant of OMP_PARALLEL_STORAGE_LOOP_BEGIN. The loop range is
+split into tiles of OMP_TILE_SIZE[0] x OMP_TILE_SIZE[1] x OMP_TILE_SIZE[2]
+cells which are distributed over the threads, the cells of each tile are
+traversed by a single thread. Tile sizes of 0 select the default tile size,
+which keeps the full (contiguous) z range in one tile. This way stencil
+neighbors in x and y are reused from the cache while processing the tile.
+Tile sizes are set via the @Settings input ($TileSizeX, $TileSizeY, $TileSizeZ).
+Use OMP_PARALLEL_TILED_STORAGE_LOOP_END to close the loop. */
+
+#define OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i,j,k,T__,op_loop_bcells__,...) \
+{\
+    if ((long int) op_loop_bcells__ > (T__).Bcells() )\
+    {\
+        std::cerr << "OMP_PARALLEL_TILED_STORAGE_LOOP: BOUNDARY TOO SMALL! PLEASE ADJUST! BCELLS NEEDED " << op_loop_bcells__ << std::endl;\
+        throw std::invalid_argument("Bcells");\
+    }\
+    const long int op_loop_bcells_X__ = std::min((T__).BcellsX(), (long int) op_loop_bcells__); \
+    const long int op_loop_bcells_Y__ = std::min((T__).BcellsY(), (long int) op_loop_bcells__); \
+    const long int op_loop_bcells_Z__ = std::min((T__).BcellsZ(), (long int) op_loop_bcells__); \
+    const long int op_loop_lower_X__ = std::min(-(op_loop_bcells_X__),(long int)0); \
+    const long int op_loop_lower_Y__ = std::min(-(op_loop_bcells_Y__),(long int)0); \
+    const long int op_loop_lower_Z__ = std::min(-(op_loop_bcells_Z__),(long int)0); \
+    const long int op_loop_upper_X__ = std::max((long int)((T__).sizeX() + (op_loop_bcells_X__)),(long int)((T__).sizeX())); \
+    const long int op_loop_upper_Y__ = std::max((long int)((T__).sizeY() + (op_loop_bcells_Y__)),(long int)((T__).sizeY())); \
+    const long int op_loop_upper_Z__ = std::max((long int)((T__).sizeZ() + (op_loop_bcells_Z__)),(long int)((T__).sizeZ())); \
+    const long int op_tile_X__ = (OMP_TILE_SIZE[0] > 0) ? OMP_TILE_SIZE[0] : OMP_DEFAULT_TILE_SIZE_X; \
+    const long int op_tile_Y__ = (OMP_TILE_SIZE[1] > 0) ? OMP_TILE_SIZE[1] : OMP_DEFAULT_TILE_SIZE_Y; \
+    const long int op_tile_Z__ = (OMP_TILE_SIZE[2] > 0) ? OMP_TILE_SIZE[2] : std::max(op_loop_upper_Z__ - op_loop_lower_Z__, (long int)1); \
+    const long int op_ntiles_X__ = (op_loop_upper_X__ - op_loop_lower_X__ + op_tile_X__ - 1)/op_tile_X__; \
+    const long int op_ntiles_Y__ = (op_loop_upper_Y__ - op_loop_lower_Y__ + op_tile_Y__ - 1)/op_tile_Y__; \
+    const long int op_ntiles_Z__ = (op_loop_upper_Z__ - op_loop_lower_Z__ + op_tile_Z__ - 1)/op_tile_Z__; \
+    _Pragma(STRINGIFY(omp parallel for collapse(OMP_COLLAPSE_LOOPS) schedule(OMP_SCHEDULING_TYPE,1) __VA_ARGS__) ) \
+    for (long int op_tile_i__ = 0; op_tile_i__ < op_ntiles_X__; ++op_tile_i__) \
+    for (long int op_tile_j__ = 0; op_tile_j__ < op_ntiles_Y__; ++op_tile_j__) \
+    for (long int op_tile_k__ = 0; op_tile_k__ < op_ntiles_Z__; ++op_tile_k__) \
+    {\
+    const long int op_tile_lower_X__ = op_loop_lower_X__ + op_tile_i__*op_tile_X__; \
+    const long int op_tile_lower_Y__ = op_loop_lower_Y__ + op_tile_j__*op_tile_Y__; \
+    const long int op_tile_lower_Z__ = op_loop_lower_Z__ + op_tile_k__*op_tile_Z__; \
+    const long int op_tile_upper_X__ = std::min(op_tile_lower_X__ + op_tile_X__, op_loop_upper_X__); \
+    const long int op_tile_upper_Y__ = std::min(op_tile_lower_Y__ + op_tile_Y__, op_loop_upper_Y__); \
+    const long int op_tile_upper_Z__ = std::min(op_tile_lower_Z__ + op_tile_Z__, op_loop_upper_Z__); \
+    for (long int i = op_tile_lower_X__; i < op_tile_upper_X__; ++i) \
+    for (long int j = op_tile_lower_Y__; j < op_tile_upper_Y__; ++j) \
+    for (long int k = op_tile_lower_Z__; k < op_tile_upper_Z__; ++k) \
+    {
+
+#define OMP_PARALLEL_TILED_STORAGE_LOOP_END \
+    }\
+    }\
+}
+
+/* Orphaned variant of OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN, see
+OMP_STORAGE_LOOP_BEGIN. Use OMP_TILED_STORAGE_LOOP_END to close the loop. */
+
+#define OMP_TILED_STORAGE_LOOP_BEGIN(i,j,k,T__,op_loop_bcells__,...) \
+{\
+    if ((long int) op_loop_bcells__ > (T__).Bcells() )\
+    {\
+        std::cerr << "OMP_TILED_STORAGE_LOOP: BOUNDARY TOO SMALL! PLEASE ADJUST! BCELLS NEEDED " << op_loop_bcells__ << std::endl;\
+        std::abort();\
+    }\
+    const long int op_loop_bcells_X__ = std::min((T__).BcellsX(), (long int) op_loop_bcells__); \
+    const long int op_loop_bcells_Y__ = std::min((T__).BcellsY(), (long int) op_loop_bcells__); \
+    const long int op_loop_bcells_Z__ = std::min((T__).BcellsZ(), (long int) op_loop_bcells__); \
+    const long int op_loop_lower_X__ = std::min(-(op_loop_bcells_X__),(long int)0); \
+    const long int op_loop_lower_Y__ = std::min(-(op_loop_bcells_Y__),(long int)0); \
+    const long int op_loop_lower_Z__ = std::min(-(op_loop_bcells_Z__),(long int)0); \
+    const long int op_loop_upper_X__ = std::max((long int)((T__).sizeX() + (op_loop_bcells_X__)),(long int)((T__).sizeX())); \
+    const long int op_loop_upper_Y__ = std::max((long int)((T__).sizeY() + (op_loop_bcells_Y__)),(long int)((T__).sizeY())); \
+    const long int op_loop_upper_Z__ = std::max((long int)((T__).sizeZ() + (op_loop_bcells_Z__)),(long int)((T__).sizeZ())); \
+    const long int op_tile_X__ = (OMP_TILE_SIZE[0] > 0) ? OMP_TILE_SIZE[0] : OMP_DEFAULT_TILE_SIZE_X; \
+    const long int op_tile_Y__ = (OMP_TILE_SIZE[1] > 0) ? OMP_TILE_SIZE[1] : OMP_DEFAULT_TILE_SIZE_Y; \
+    const long int op_tile_Z__ = (OMP_TILE_SIZE[2] > 0) ? OMP_TILE_SIZE[2] : std::max(op_loop_upper_Z__ - op_loop_lower_Z__, (long int)1); \
+    const long int op_ntiles_X__ = (op_loop_upper_X__ - op_loop_lower_X__ + op_tile_X__ - 1)/op_tile_X__; \
+    const long int op_ntiles_Y__ = (op_loop_upper_Y__ - op_loop_lower_Y__ + op_tile_Y__ - 1)/op_tile_Y__; \
+    const long int op_ntiles_Z__ = (op_loop_upper_Z__ - op_loop_lower_Z__ + op_tile_Z__ - 1)/op_tile_Z__; \
+    _Pragma(STRINGIFY(omp for collapse(OMP_COLLAPSE_LOOPS) schedule(OMP_SCHEDULING_TYPE,1) __VA_ARGS__) ) \
+    for (long int op_tile_i__ = 0; op_tile_i__ < op_ntiles_X__; ++op_tile_i__) \
+    for (long int op_tile_j__ = 0; op_tile_j__ < op_ntiles_Y__; ++op_tile_j__) \
+    for (long int op_tile_k__ = 0; op_tile_k__ < op_ntiles_Z__; ++op_tile_k__) \
+    {\
+    const long int op_tile_lower_X__ = op_loop_lower_X__ + op_tile_i__*op_tile_X__; \
+    const long int op_tile_lower_Y__ = op_loop_lower_Y__ + op_tile_j__*op_tile_Y__; \
+    const long int op_tile_lower_Z__ = op_loop_lower_Z__ + op_tile_k__*op_tile_Z__; \
+    const long int op_tile_upper_X__ = std::min(op_tile_lower_X__ + op_tile_X__, op_loop_upper_X__); \
+    const long int op_tile_upper_Y__ = std::min(op_tile_lower_Y__ + op_tile_Y__, op_loop_upper_Y__); \
+    const long int op_tile_upper_Z__ = std::min(op_tile_lower_Z__ + op_tile_Z__, op_loop_upper_Z__); \
+    for (long int i = op_tile_lower_X__; i < op_tile_upper_X__; ++i) \
+    for (long int j = op_tile_lower_Y__; j < op_tile_upper_Y__; ++j) \
+    for (long int k = op_tile_lower_Z__; k < op_tile_upper_Z__; ++k) \
+    {
+
+#define OMP_TILED_STORAGE_LOOP_END \
+    }\
+    }\
+}
+/* Split of OMP_PARALLEL_STORAGE_LOOP_BEGIN for overlapping computations with
+the halo exchange (BoundaryConditions::BeginExchange()/EndExchange()).
+The INTERIOR loop covers the cells which are at least op_loop_reach__ cells away
+from the storage boundaries in every active direction, therefore a stencil of
+this reach does not access the boundary cells. The SHELL loop covers the
+remaining cells of the corresponding storage loop with op_loop_bcells__
+boundary cells. Together both loops visit every cell of that loop once.
+Use OMP_PARALLEL_STORAGE_LOOP_INTERIOR_END and OMP_PARALLEL_STORAGE_LOOP_SHELL_END
+to close the loops. */
+
+#define OMP_PARALLEL_STORAGE_LOOP_INTERIOR_BEGIN(i,j,k,T__,op_loop_reach__,...) \
+{\
+    const long int op_loop_reach_X__ = (T__).dNx()*(long int)(op_loop_reach__); \
+    const long int op_loop_reach_Y__ = (T__).dNy()*(long int)(op_loop_reach__); \
+    const long int op_loop_reach_Z__ = (T__).dNz()*(long int)(op_loop_reach__); \
+    const long int op_loop_upper_X__ = (T__).sizeX() - op_loop_reach_X__; \
+    const long int op_loop_upper_Y__ = (T__).sizeY() - op_loop_reach_Y__; \
+    const long int op_loop_upper_Z__ = (T__).sizeZ() - op_loop_reach_Z__; \
+    _Pragma(STRINGIFY(omp parallel for collapse(OMP_COLLAPSE_LOOPS) OMP_STORAGE_SCHEDULE __VA_ARGS__) ) \
+    for (long int i = op_loop_reach_X__; i < op_loop_upper_X__; ++i) \
+    for (long int j = op_loop_reach_Y__; j < op_loop_upper_Y__; ++j) \
+    for (long int k = op_loop_reach_Z__; k < op_loop_upper_Z__; ++k) \
+    {
+
+#define OMP_PARALLEL_STORAGE_LOOP_INTERIOR_END \
+    }\
+}
+
+#define OMP_PARALLEL_STORAGE_LOOP_SHELL_BEGIN(i,j,k,T__,op_loop_bcells__,op_loop_reach__,...) \
+{\
+    if ((long int) op_loop_bcells__ > (T__).Bcells() )\
+    {\
+        std::cerr << "OMP_PARALLEL_STORAGE_LOOP_SHELL: BOUNDARY TOO SMALL! PLEASE ADJUST! BCELLS NEEDED " << op_loop_bcells__ << std::endl;\
+        throw std::invalid_argument("Bcells");\
+    }\
+    const long int op_loop_bcells_X__ = std::min((T__).BcellsX(), (long int) op_loop_bcells__); \
+    const long int op_loop_bcells_Y__ = std::min((T__).BcellsY(), (long int) op_loop_bcells__); \
+    const long int op_loop_bcells_Z__ = std::min((T__).BcellsZ(), (long int) op_loop_bcells__); \
+    const long int op_loop_lower_X__ = std::min(-(op_loop_bcells_X__),(long int)0); \
+    const long int op_loop_lower_Y__ = std::min(-(op_loop_bcells_Y__),(long int)0); \
+    const long int op_loop_lower_Z__ = std::min(-(op_loop_bcells_Z__),(long int)0); \
+    const long int op_loop_upper_X__ = std::max((long int)((T__).sizeX() + (op_loop_bcells_X__)),(long int)((T__).sizeX())); \
+    const long int op_loop_upper_Y__ = std::max((long int)((T__).sizeY() + (op_loop_bcells_Y__)),(long int)((T__).sizeY())); \
+    const long int op_loop_upper_Z__ = std::max((long int)((T__).sizeZ() + (op_loop_bcells_Z__)),(long int)((T__).sizeZ())); \
+    const long int op_loop_reach_X__ = (T__).dNx()*(long int)(op_loop_reach__); \
+    const long int op_loop_reach_Y__ = (T__).dNy()*(long int)(op_loop_reach__); \
+    const long int op_loop_reach_Z__ = (T__).dNz()*(long int)(op_loop_reach__); \
+    _Pragma(STRINGIFY(omp parallel for collapse(2) schedule(OMP_SCHEDULING_TYPE,1) __VA_ARGS__) ) \
+    for (long int i = op_loop_lower_X__; i < op_loop_upper_X__; ++i) \
+    for (long int j = op_loop_lower_Y__; j < op_loop_upper_Y__; ++j) \
+    {\
+    const bool op_loop_skip__ = i >= op_loop_reach_X__ and i < (T__).sizeX() - op_loop_reach_X__ and \
+                                j >= op_loop_reach_Y__ and j < (T__).sizeY() - op_loop_reach_Y__ and \
+                                op_loop_reach_Z__ < (T__).sizeZ() - op_loop_reach_Z__; \
+    const long int op_loop_skip_begin__ = op_loop_skip__ ? op_loop_reach_Z__ : op_loop_upper_Z__; \
+    const long int op_loop_skip_end__   = op_loop_skip__ ? (T__).sizeZ() - op_loop_reach_Z__ : op_loop_upper_Z__; \
+    for (long int k = (op_loop_lower_Z__ == op_loop_skip_begin__) ? op_loop_skip_end__ : op_loop_lower_Z__; \
+         k < op_loop_upper_Z__; k = (k + 1 == op_loop_skip_begin__) ? op_loop_skip_end__ : k + 1) \
+    {
+
+#define OMP_PARALLEL_STORAGE_LOOP_SHELL_END \
+    }\
+    }\
+}
+
+/* Loop over a precomputed list of cell coordinates, e.g. PhaseField::InterfaceCells.
+The loop variables i, j and k are set from the list entries. Use
+OMP_PARALLEL_CELL_LIST_LOOP_END to close the loop. */
+
+#define OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,CellList__,...) \
+{\
+    const long int op_list_size__ = (CellList__).size(); \
+    _Pragma(STRINGIFY(omp parallel for schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE) __VA_ARGS__) ) \
+    for (long int op_list_idx__ = 0; op_list_idx__ < op_list_size__; ++op_list_idx__) \
+    {\
+    const long int i = (CellList__)[op_list_idx__][0]; \
+    const long int j = (CellList__)[op_list_idx__][1]; \
+    const long int k = (CellList__)[op_list_idx__][2]; \
+    {
+
+#define OMP_PARALLEL_CELL_LIST_LOOP_END \
+    }\
+    }\
+}
+
+/* Loop over the interior cells of T__ block by block, skipping the blocks
+which the occupancy map Map__ (e.g. PhaseField::Occupancy) marks as bulk or
+fluid. Intended for loops whose body only acts on interface cells. If the map
+does not match the storage every block is visited, the loop then covers the
+same cells as OMP_PARALLEL_STORAGE_LOOP_BEGIN with zero boundary cells.
+Use OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END to close the loop. */
+
+#define OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,T__,Map__,...) \
+{\
+    const bool op_map_valid__ = (Map__).Matches((T__).sizeX(), (T__).sizeY(), (T__).sizeZ()); \
+    const long int op_block__ = (Map__).LoopBlockSize(); \
+    const long int op_nblocks_X__ = ((T__).sizeX() + op_block__ - 1)/op_block__; \
+    const long int op_nblocks_Y__ = ((T__).sizeY() + op_block__ - 1)/op_block__; \
+    const long int op_nblocks_Z__ = ((T__).sizeZ() + op_block__ - 1)/op_block__; \
+    _Pragma(STRINGIFY(omp parallel for collapse(OMP_COLLAPSE_LOOPS) schedule(OMP_SCHEDULING_TYPE,1) __VA_ARGS__) ) \
+    for (long int op_block_i__ = 0; op_block_i__ < op_nblocks_X__; ++op_block_i__) \
+    for (long int op_block_j__ = 0; op_block_j__ < op_nblocks_Y__; ++op_block_j__) \
+    for (long int op_block_k__ = 0; op_block_k__ < op_nblocks_Z__; ++op_block_k__) \
+    if (not op_map_valid__ or not (Map__).Skip(op_block_i__, op_block_j__, op_block_k__)) \
+    {\
+    const long int op_block_upper_X__ = std::min((op_block_i__ + 1)*op_block__, (long int)(T__).sizeX()); \
+    const long int op_block_upper_Y__ = std::min((op_block_j__ + 1)*op_block__, (long int)(T__).sizeY()); \
+    const long int op_block_upper_Z__ = std::min((op_block_k__ + 1)*op_block__, (long int)(T__).sizeZ()); \
+    for (long int i = op_block_i__*op_block__; i < op_block_upper_X__; ++i) \
+    for (long int j = op_block_j__*op_block__; j < op_block_upper_Y__; ++j) \
+    for (long int k = op_block_k__*op_block__; k < op_block_upper_Z__; ++k) \
+    {
+
+#define OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END \
+    }\
+    }\
+}
 #endif //MACROS_H
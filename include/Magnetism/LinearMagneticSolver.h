@@ -27,6 +27,11 @@
 #ifndef MAGNETICSOLVER_H
 #define MAGNETICSOLVER_H
 
+#ifdef MPI_PARALLEL
+#include "mpi_wrapper.h"
+#else
+#include "fftw3.h"
+#endif
 #include "Includes.h"
 #include "BoundaryConditions.h"
 
@@ -44,8 +49,10 @@ public:
 
     LinearMagneticSolver(){};
     LinearMagneticSolver(Settings& locSettings, const std::string InputFileName = DefaultInputFileName);
+    ~LinearMagneticSolver(void);
 
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override;
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;
     void ReadInput(std::stringstream& inp) override;
     void SetEffectiveSusceptibility(const PhaseField& Phase, const BoundaryConditions& BC);
@@ -73,12 +80,46 @@ public:
 
     GridParameters Grid;                                                        ///< Simulation grid parameters
 
-    size_t MaxIterations;                                                       ///< Maximal residual value for iteration to stop
+    size_t MaxIterations;                                                       ///< Maximum number of iterations per solve
+    std::string LinearSolver;                                                   ///< "BiCG" (assembled sparse matrix, default) or "BiCGStab" (matrix-free)
+    std::string Preconditioner;                                                 ///< Preconditioner of BiCGStab: "FFT" (default), "Jacobi" or "None"
+    size_t Iterations = 0;                                                      ///< Number of iterations of the last solve
+    double SolveTime = 0.0;                                                     ///< Wall time of the last solve in seconds
 
     std::vector<double> PhaseChi;
     std::vector<double> b,x;
     SparseMatrixCSR A;
 
+ private:
+    /* The BiCGStab path applies the discrete operator of Solve() directly to
+    the potential without assembling A. The neighbour tables map each index
+    along X, Y and Z to the index of its +1 and -1 neighbour according to the
+    boundary conditions (-1 for Fixed, where the neighbour is zero). The FFT
+    preconditioner inverts the constant-coefficient operator mean(mu) *
+    Laplace with real-to-real transforms matching the boundary conditions:
+    Periodic -> R2HC/HC2R, NoFlux -> DCT-I, Fixed -> DST-I.*/
+    std::array<double,7> Stencil(const int i, const int j, const int k) const;  ///< Coefficients of the cell and its +X, -X, +Y, -Y, +Z and -Z neighbours
+    void SetupOperator(const BoundaryConditions& BC);                           ///< Sets neighbour tables, right hand side and diagonal for the matrix-free solve
+    void SetupFFTPreconditioner(const BoundaryConditions& BC);                  ///< Creates the transforms and eigenvalues of the FFT preconditioner
+    void ApplyOperator(const std::vector<double>& in, std::vector<double>& out) const;///< out = A*in (matrix-free)
+    void ApplyPreconditioner(const std::vector<double>& in, std::vector<double>& out);///< out ~ A^-1*in
+    double ScaledResidual(const std::vector<double>& r) const;                  ///< max |r_i/A_ii|, the residual measure of the Jacobi scaled system
+    void SolveAssembled(const BoundaryConditions& BC, const double MaxResidual);///< Assembles A and solves with BiCG (original algorithm)
+
+    std::vector<int> NeighbourXP, NeighbourXM;                                  ///< +1/-1 neighbours along X
+    std::vector<int> NeighbourYP, NeighbourYM;                                  ///< +1/-1 neighbours along Y
+    std::vector<int> NeighbourZP, NeighbourZM;                                  ///< +1/-1 neighbours along Z
+    std::vector<double> Diagonal;                                               ///< Diagonal of A
+    std::vector<double> Work;                                                   ///< Work array of the FFT preconditioner
+    std::vector<double> LambdaX, LambdaY, LambdaZ;                              ///< Eigenvalues of the 1D discrete Laplacians (times dx^2)
+    double PreconditionerNorm = 1.0;                                            ///< Normalization of the backward transform
+    double PreconditionerMu = 1.0;                                              ///< Mean relative permeability of the preconditioner
+    bool   FFTPreconditioner = false;                                           ///< True if the FFT preconditioner is available for the current boundary conditions
+    fftw_plan ForwardPlan = nullptr;                                            ///< Forward transform of the FFT preconditioner
+    fftw_plan BackwardPlan = nullptr;                                           ///< Backward transform of the FFT preconditioner
+
+ public:
+
     inline size_t idx(const int i, const int j, const int k) const
     {
         return i+Grid.Nx*(j+Grid.Ny*k);
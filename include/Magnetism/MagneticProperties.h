@@ -44,6 +44,7 @@ class MagneticProperties : public OPObject
     MagneticProperties(Settings& locSettings);                                  ///< Constructor call Initialize and ReadInput
 
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override;                            ///< Initializes storage class
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;                   ///< Reads the initial parameters for the interface diffusion
     void ReadInput(std::stringstream& inp) override;                            ///< Reads elastic properties from the input file
     //double MagneticEnergy(void) const;                                          ///< Calculates and returns the magnetic energy
@@ -0,0 +1,112 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Read-only view of a whole file. The file is memory mapped where mmap is
+available, so that threads deserializing different parts of it only touch
+the pages they need; otherwise it is read into memory. */
+
+class OP_EXPORTS MappedFile                                                     ///< Read-only memory view of a file
+{
+ public:
+    static constexpr auto thisclassname = "MappedFile";                         ///< Object's implementation class name
+
+    MappedFile(){};
+    explicit MappedFile(const std::string& FileName)
+    {
+        Open(FileName);
+    }
+    ~MappedFile()
+    {
+        Close();
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& FileName);                                     ///< Maps the file, returns false if it can not be opened
+    void Close(void);                                                           ///< Releases the mapping
+    const char* data(void) const                                                ///< First byte of the file
+    {
+        return Data;
+    }
+    size_t size(void) const                                                     ///< File size in bytes
+    {
+        return Size;
+    }
+
+ private:
+    const char* Data = nullptr;
+    size_t Size = 0;
+    bool Mapped = false;                                                        ///< True if Data is a memory mapping, false if it is owned by Buffer
+    std::vector<char> Buffer;                                                   ///< File content if memory mapping is not available
+};
+
+/* Input stream over a range of memory, used to deserialize objects with
+their read(std::istream&) methods directly from a MappedFile */
+
+class MemoryBuffer : public std::streambuf                                      ///< Stream buffer over a read-only memory range
+{
+ public:
+    MemoryBuffer(const char* begin, const size_t size)
+    {
+        char* ptr = const_cast<char*>(begin);
+        setg(ptr, ptr, ptr + size);
+    }
+ protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which = std::ios_base::in) override///< Repositions within the memory range, used by tellg() and seekg()
+    {
+        char* base = (dir == std::ios_base::beg) ? eback() :
+                     (dir == std::ios_base::cur) ? gptr() : egptr();
+        if(not (which & std::ios_base::in) or
+           off < eback() - base or off > egptr() - base) return pos_type(off_type(-1));
+        setg(eback(), base + off, egptr());
+        return pos_type(gptr() - eback());
+    }
+    pos_type seekpos(pos_type pos,
+                     std::ios_base::openmode which = std::ios_base::in) override///< Repositions within the memory range
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+class MemoryStream : private MemoryBuffer, public std::istream                  ///< Input stream over a read-only memory range
+{
+ public:
+    MemoryStream(const char* begin, const size_t size) :
+        MemoryBuffer(begin, size),
+        std::istream(static_cast<std::streambuf*>(this)) {};
+};
+
+}// namespace openphase
+#endif
@@ -64,6 +64,8 @@ class MassDensity : public OPObject
                    const BoundaryConditions& BC) override;                      ///< Shifts the data on the storage by di, dj and dk in x, y and z directions correspondingly.
     void Remesh(int newNx, int newNy, int newNz,
                 const BoundaryConditions& BC) override;                         ///< Remesh the storage while keeping the data
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void PrintPointStatistics(int x, int y, int z);                             ///< Prints to screen density in a given point (x, y, z)
 
     MassDensity& operator=(const MassDensity& rhs);                             ///< Copy operator for Density class
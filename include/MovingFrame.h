@@ -33,6 +33,7 @@ namespace openphase
 {
 class Settings;
 class BoundaryConditions;
+class PhaseField;
 
 class OP_EXPORTS MovingFrame : public OPObject                                  ///< Moving frame class
 {
@@ -52,8 +53,20 @@ class OP_EXPORTS MovingFrame : public OPObject
     size_t trigger_position;                                                    ///< Position which should be reached by the trigger_phase to trigger the moving frame
     std::string moving_direction;                                               ///< Direction to move the frame into
 
+    /* The frame is moved by one cell along the moving direction ("X", "Y" or
+    "Z", optionally signed, e.g. "-Z") once the front of the trigger phase
+    reaches the trigger position. The front is taken from the per-plane
+    phase fractions maintained by PhaseField::TrackFront(), which are updated
+    incrementally while merging, the check is therefore not a domain scan.*/
+    void Register(OPObject& Object, const BoundaryConditions& BC);              ///< Adds an object (with its boundary conditions) which is moved with the frame
+    bool Triggered(PhaseField& Phase);                                          ///< True if the front of the trigger phase has reached the trigger position
+    bool Apply(PhaseField& Phase);                                              ///< Moves all registered objects by one cell if triggered, returns true if the frame was moved
+
  protected:
  private:
+    int Axis;                                                                   ///< Axis of the moving direction (-1 - frame does not move)
+    int Sign;                                                                   ///< Sign of the moving direction
+    std::vector<std::pair<OPObject*, const BoundaryConditions*>> Objects;       ///< Registered objects and their boundary conditions
 
     bool Read(const Settings& locSettings,
               const BoundaryConditions& BC,
@@ -28,7 +28,10 @@
 #define NOISE_H
 
 #include "Includes.h"
-#include "fftw3.h"
+#include "FFTBackend.h"
+#include "PencilFFT.h"
+#include "WaveVectors.h"
+#include <future>
 
 namespace openphase
 {
@@ -37,6 +40,26 @@ class PhaseField;
 class Settings;
 class Temperature;
 
+/* The noise is a random field in reciprocal space below the cut off wave
+length, transformed to real space and normalized. Every TimeSteps time steps
+a new field is generated and Raw is interpolated linearly towards it. The
+transform uses the same backends as the spectral elasticity solver: FFTBackend
+in serial mode, the FFTW MPI slab transform or PencilFFT with the MPI 3D domain
+decomposition, so the noise is one field over the whole simulation domain. The
+random coefficients are a hash of the seed, the generation and the global wave
+vector index, the field is therefore independent of the number of threads and
+MPI processes. In serial mode the next field is generated in the background
+while the phase-field steps of the current interval run ($Asynchronous, on by
+default), in MPI parallel mode the transforms are collective and run in the
+calling thread. Input (module @Noise):
+
+    $dgamma         Macroscopic response of the system                  0
+    $iTime          Time steps between two generated fields
+    $dWaveLength    Cut off wave length
+    $dFixAmpl       Amplitude (without temperature)
+    $RandomSeed     Seed of the random coefficients (-1: system clock)   -1
+    $Asynchronous   Generate the next field in the background          Yes */
+
 class Noise : public OPObject                                                   ///< Calculates a noise, which can be added to the DrivingForce
 {
  public: 
@@ -49,6 +72,7 @@ class Noise : public OPObject
         ReadInput(InputFileName);
     };
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override; ///< Allocates memory, initializes the settings
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void ReadInput(const std::string InputFileName) override;                   ///< Reads input from input file
     void UpdateRaw(int tStep);                                                  ///< Updates Raw Driving force
     void AddToDrivingForce(int tStep, Temperature& Temp, DrivingForce& DF);     ///< Adds Fields to driving force
@@ -68,21 +92,33 @@ class Noise : public OPObject
 
     int    RandomSeed;                                                          ///< Defines the random number table (used to make results reproducible)
     int    TimeSteps;                                                           ///< Number of iteration after which a new noise will be scrabbled
+    bool   Asynchronous;                                                        ///< Generates the next noise field in the background (serial mode only)
 
     //const double kBoltzmann;                                                  ///< Physical constant
 
  protected:
 
-    void Generate(void);                                                        ///< Generates a new noise field (it will be interpolated between new and old noise field)
+    void Generate(void);                                                        ///< Generates the next normalized noise field into Next
+    void StartGenerate(void);                                                   ///< Starts the generation of the next noise field (in the background if Asynchronous)
+    void SetIncrement(void);                                                    ///< Waits for the next noise field, sets the increment towards it and starts the following one
+    void ExecuteBackwardFFT(void);                                              ///< Transforms the random coefficients to real space
 
     Storage3D< double, 0 >           Raw;                                       ///< Real raw noise, which will be merge into the driving force
-    fftw_complex*                    fftw_In;                                   ///< FFTW input pointer
-    fftw_complex*                    fftw_Out;                                  ///< FFTW out pointer
-    fftw_plan                        FFTBackward;                               ///< Plan for the execution of FFTW
-    std::complex<double>*            RandomFourier;                             ///< Pointer to storage of Fourier-space random number distribution
-    std::complex<double>*            RandomReal;                                ///< Pointer to storage of real space random number distribution
-    std::default_random_engine       generator;                                 ///< Random number generator
-    std::normal_distribution<double> distribution;                              ///< Random number distribution
+    Storage3D< double, 0 >           Next;                                      ///< Next normalized noise field, target of the interpolation
+    Storage3D< double, 0 >           Increment;                                 ///< Change of Raw per time step towards Next
+    std::vector<double>              SpectralData;                              ///< In-place transform array (fft_real values), owned as it is used in the background
+    size_t                           SpectralSize;                              ///< Number of fft_real values of the transform array
+    int                              SpectralN[3];                              ///< Local extents of the reciprocal space array
+    int                              SpectralOffset[3];                         ///< Position of the local reciprocal space array in the global reciprocal space
+    WaveVectors                      Q;                                         ///< Wave vectors of the local reciprocal space array
+    size_t                           Generation;                                ///< Number of generated noise fields, selects the random coefficients
+    std::future<void>                Pending;                                   ///< Generation running in the background
+#ifdef MPI_PARALLEL
+    PencilFFT                        Pencil;                                    ///< Pencil decomposed FFT (MPI 3D decomposition)
+    fftw_plan                        SlabPlan;                                  ///< FFTW MPI slab c2r plan
+#else
+    FFTBackend                       FFT;                                       ///< c2r FFT (FFTW or cuFFT)
+#endif
  private:
 };
 }
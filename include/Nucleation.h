@@ -30,6 +30,8 @@
 
 #include "Includes.h"
 #include "H5Interface.h"
+#include "Tools/Philox.h"
+#include <unordered_map>
 
 namespace openphase
 {
@@ -185,17 +187,10 @@ struct NucleationParameters
     NucleiSizeDistributions Distribution;                                       ///< Nuclei size distribution mode
     NucleiVariantsModes VariantsMode;                                           ///< Nuclei variant selection mode
 
-    std::mt19937_64 SizeGenerator;                                              ///< Nuclei size generator
+    uint64_t RandomSeed;                                                        ///< Key of the counter-based seed size, position and orientation generator
+    size_t Draws;                                                               ///< Number of seed candidates drawn so far, index of the next candidate
     std::mt19937_64 VariantsGenerator;                                          ///< Variants generator
 
-    std::mt19937_64 PositionGeneratorX;                                         ///< Nuclei x-position generator
-    std::mt19937_64 PositionGeneratorY;                                         ///< Nuclei y-position generator
-    std::mt19937_64 PositionGeneratorZ;                                         ///< Nuclei z-position generator
-
-    std::mt19937_64 OrientationGenerator1;                                      ///< Nuclei orientation generator Q1
-    std::mt19937_64 OrientationGenerator2;                                      ///< Nuclei orientation generator Q2
-    std::mt19937_64 OrientationGenerator3;                                      ///< Nuclei orientation generator Q3
-
     std::uniform_int_distribution <int> VariantSelector;                        ///< Nuclei symmetry variants distribution
 
     std::uniform_int_distribution <int> PositionDistributionX;                  ///< Nuclei x-position distribution
@@ -212,6 +207,15 @@ struct NucleationParameters
     std::vector <Nucleus> GeneratedNuclei;                                      ///< Generated nuclei storage
     std::vector <Nucleus> PlantedNuclei;                                        ///< Planted nuclei storage
 
+    /* Generated nuclei binned on a uniform grid with bins not smaller than
+    the shielding radius, so the shielding test only visits the bin of the
+    tested position and its periodic neighbours. New nuclei are added by
+    UpdateShieldingIndex(), any other change of GeneratedNuclei requires
+    ResetShieldingIndex() before the next update. */
+    std::unordered_map<long int, std::vector<size_t>> ShieldingBins;            ///< Indices of the generated nuclei in each occupied bin
+    long int ShieldingBinsN[3];                                                 ///< Number of bins in each direction
+    size_t ShieldingIndexed;                                                    ///< Number of generated nuclei already binned
+
     NucleationParameters():
         Allowed(false),
         Generated(false),
@@ -232,14 +236,22 @@ struct NucleationParameters
         LocationMode(NucleiLocationModes::Bulk),
         OrientationMode(NucleiOrientationModes::Reference),
         Distribution(NucleiSizeDistributions::Normal),
-        VariantsMode(NucleiVariantsModes::Random){};
-
-    double     SetSeedRadius();
-    iVector3   SetSeedPosition();
-    Quaternion SetSeedOrientation();
+        VariantsMode(NucleiVariantsModes::Random),
+        RandomSeed(1ul),
+        Draws(0ul),
+        ShieldingBinsN{1, 1, 1},
+        ShieldingIndexed(0ul){};
+
+    double     SetSeedRadius(Philox4x32& Generator) const;                      ///< Draws the seed radius from the size distribution
+    iVector3   SetSeedPosition(Philox4x32& Generator) const;                    ///< Draws the global seed position according to the location mode
+    Quaternion SetSeedOrientation(Philox4x32& Generator) const;                 ///< Draws the seed orientation according to the orientation mode
     bool       CheckLocation(const PhaseField& Phase,
                              const iVector3 loc_position) const;                ///< Returns "true" if seed position fulfills nucleation constraints, "false" otherwise
-    bool       PositionNotShielded(const iVector3 position) const;              ///< Returns "true" if seed position is outside of the "shielding" radius, "false" otherwise.
+    bool       PositionNotShielded(const iVector3 position,
+                                   const size_t First = 0) const;               ///< Returns "true" if seed position is outside of the "shielding" radius of the generated nuclei starting from "First", "false" otherwise.
+    void       UpdateShieldingIndex();                                          ///< Bins the generated nuclei added since the last update
+    void       ResetShieldingIndex();                                           ///< Discards the binning, call after GeneratedNuclei or the grid size are changed
+    long int   ShieldingBin(const iVector3 position) const;                     ///< Bin of the given global position
 };
 
 class OP_EXPORTS Nucleation : public OPObject                                   ///< Handles the nucleation of new phases and grains
@@ -255,6 +267,7 @@ class OP_EXPORTS Nucleation : public OPObject
                    const BoundaryConditions& BC) override;                      ///< Shifts the data in the storage by dx, dy and dz (they should be 0, -1 or +1) in x, y or z direction correspondingly.
 
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override; ///< Changes the mesh size while keeping the data.
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
 
     void GenerateNucleationSites(PhaseField& Phase, Temperature& Tx);           ///< Generates nuclei
     void PlantNuclei(PhaseField& Phi, int tstep);                               ///< Plants generated nuclei according to their nucleation parameters
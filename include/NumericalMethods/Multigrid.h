@@ -0,0 +1,101 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef MULTIGRID_H
+#define MULTIGRID_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+class BoundaryConditions;
+
+class OP_EXPORTS Multigrid                                                      ///< Geometric multigrid V-cycle solver for cell centered scalar fields
+{
+    /* Solves Alpha*U - Beta*Laplace(U) = F on the simulation grid with the
+    standard 3, 5 or 7 point stencil, Beta is taken in the cell center as in
+    the explicit and implicit diffusion solvers. The coarse grids halve the
+    number of cells along every active dimension as long as all of them are
+    even and at least 4 (on every MPI rank), the coefficients are averaged
+    onto the coarse grids. Smoothing is red-black Gauss-Seidel, the residual
+    is restricted by averaging and the correction prolongated by trilinear
+    interpolation. The boundary cells of all levels are set with the
+    BoundaryConditions of the solved field, including the MPI halo exchange.
+    On the coarse grids Fixed boundaries are applied as a zero correction on
+    the domain boundary.
+
+    Usage: Initialize() once per grid, fill RHS(), call SetCoefficients()
+    whenever the coefficients change, then call VCycle() until the returned
+    residual is small enough. */
+ public:
+    void Initialize(const GridParameters& Grid, const size_t MaxLevels = 16);  ///< Builds the grid hierarchy
+    void SetCoefficients(const Storage3D<double,0>& Alpha,
+                         const Storage3D<double,0>& Beta,
+                         const double BetaFactor = 1.0);                        ///< Sets Alpha and BetaFactor*Beta on all levels
+    double VCycle(Storage3D<double,0>& U, const BoundaryConditions& BC);        ///< Performs one V-cycle, returns the local maximum of |residual/diagonal| after pre-smoothing
+    Storage3D<double,0>& RHS(void)                                              ///< Right hand side F on the simulation grid
+    {
+        return Levels[0].F;
+    }
+    size_t NumberOfLevels(void) const                                           ///< Number of grids in the hierarchy
+    {
+        return Levels.size();
+    }
+    size_t AllocatedMemory(void) const;                                         ///< Memory held by the storages in bytes
+
+    int PreSmoothing   = 2;                                                     ///< Gauss-Seidel sweeps before the coarse grid correction
+    int PostSmoothing  = 2;                                                     ///< Gauss-Seidel sweeps after the coarse grid correction
+    int CoarseSweeps   = 32;                                                    ///< Gauss-Seidel sweeps on the coarsest grid
+
+ private:
+    struct Level                                                                ///< One grid of the hierarchy
+    {
+        Storage3D<double,0> U;                                                  ///< Correction (unused on the simulation grid)
+        Storage3D<double,0> F;                                                  ///< Right hand side
+        Storage3D<double,0> R;                                                  ///< Residual
+        Storage3D<double,0> Alpha;                                              ///< Coefficient of U
+        Storage3D<double,0> Beta;                                               ///< Coefficient of -Laplace(U)
+        double dx;                                                              ///< Grid spacing
+    };
+    std::vector<Level> Levels;                                                  ///< Grid hierarchy, Levels[0] is the simulation grid
+    int dNx = 0;                                                                ///< Active dimensions
+    int dNy = 0;
+    int dNz = 0;
+    std::array<bool,3> Boundary0 = {true, true, true};                          ///< Lower domain boundary lies on this rank
+    std::array<bool,3> BoundaryN = {true, true, true};                          ///< Upper domain boundary lies on this rank
+
+    double Cycle(const size_t l, Storage3D<double,0>& U, const BoundaryConditions& BC);///< V-cycle starting on level l, returns the residual of Residual()
+    void Smooth(const size_t l, Storage3D<double,0>& U, const int sweeps,
+                const BoundaryConditions& BC);                                  ///< Red-black Gauss-Seidel sweeps on level l
+    double Residual(const size_t l, const Storage3D<double,0>& U);              ///< Computes R on level l, returns max |R/diagonal|
+    void Restrict(const Storage3D<double,0>& Fine, Storage3D<double,0>& Coarse) const;///< Averages the fine cells of each coarse cell
+    void Prolongate(const Storage3D<double,0>& Coarse, Storage3D<double,0>& Fine) const;///< Adds the trilinear interpolation of Coarse to Fine
+    void SetBoundaryConditions(const size_t l, Storage3D<double,0>& U,
+                               const BoundaryConditions& BC) const;             ///< Sets boundary cells of level l along the active dimensions
+};
+
+}// namespace openphase
+#endif
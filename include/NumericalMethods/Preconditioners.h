@@ -0,0 +1,102 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef PRECONDITIONERS_H
+#define PRECONDITIONERS_H
+
+#include <vector>
+#include "Containers/SparseMatrix.h"
+
+namespace openphase::SystemOfLinearEquationsSolvers
+{
+
+/* Preconditioners for the Krylov solvers. They are built from a matrix in
+compressed row format, keep their own copy of the required coefficients and
+leave the matrix unchanged. Apply(in, out) computes out ~ A^-1*in. */
+
+class OP_EXPORTS IdentityPreconditioner                                        ///< No preconditioning
+{
+ public:
+    IdentityPreconditioner(){};
+    explicit IdentityPreconditioner(const SparseMatrixCompressedRow&){};
+    void Apply(const std::vector<double>& in, std::vector<double>& out) const   ///< out = in
+    {
+        out = in;
+    }
+};
+
+class OP_EXPORTS JacobiPreconditioner                                          ///< Inverse of the diagonal
+{
+ public:
+    JacobiPreconditioner(){};
+    explicit JacobiPreconditioner(const SparseMatrixCompressedRow& A){Initialize(A);};
+    void Initialize(const SparseMatrixCompressedRow& A);                        ///< Stores the inverse diagonal of A
+    void Apply(const std::vector<double>& in, std::vector<double>& out) const;  ///< out = D^-1*in
+
+ protected:
+    std::vector<double> InverseDiagonal;                                        ///< 1/A_ii
+};
+
+class OP_EXPORTS ILU0Preconditioner                                            ///< Incomplete LU factorization without fill-in
+{
+    /* L and U are stored in one matrix with the sparsity pattern of A, the
+    unit diagonal of L is not stored. The triangular solves of Apply() are
+    sequential. */
+ public:
+    ILU0Preconditioner(){};
+    explicit ILU0Preconditioner(const SparseMatrixCompressedRow& A){Initialize(A);};
+    void Initialize(const SparseMatrixCompressedRow& A);                        ///< Factorizes A
+    void Apply(const std::vector<double>& in, std::vector<double>& out) const;  ///< out = (LU)^-1*in
+
+ protected:
+    std::vector<size_t> RowStart;                                               ///< Sparsity pattern of A
+    std::vector<size_t> Column;
+    std::vector<size_t> DiagonalEntry;                                          ///< Position of the diagonal entry of each row
+    std::vector<double> LU;                                                     ///< Factors L (below) and U (on and above the diagonal)
+};
+
+class OP_EXPORTS SSORPreconditioner                                            ///< Symmetric successive over-relaxation
+{
+    /* M = w/(2-w) (D/w + L) (D/w)^-1 (D/w + U) with the strictly lower and
+    upper triangular parts L and U of A. Apply() performs a forward and a
+    backward Gauss-Seidel sweep, both sequential. */
+ public:
+    SSORPreconditioner(){};
+    explicit SSORPreconditioner(const SparseMatrixCompressedRow& A, const double omega = 1.0)
+    {
+        Initialize(A, omega);
+    };
+    void Initialize(const SparseMatrixCompressedRow& A, const double omega = 1.0);///< Stores A and the relaxation factor omega (0 < omega < 2)
+    void Apply(const std::vector<double>& in, std::vector<double>& out) const;  ///< out = M^-1*in
+
+ protected:
+    const SparseMatrixCompressedRow* Matrix = nullptr;                          ///< Preconditioned matrix
+    std::vector<double> Diagonal;                                               ///< A_ii
+    double Omega = 1.0;                                                         ///< Relaxation factor
+};
+
+}// namespace openphase::SystemOfLinearEquationsSolvers
+#endif
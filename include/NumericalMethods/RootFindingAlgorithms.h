@@ -24,6 +24,7 @@
  *
  */
 
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -138,6 +139,125 @@ struct OP_EXPORTS RootFindingAlgorithms ///< Numerically find the solution x of
         }
     }
 
+    /* Batched variants of Newton() and Secant(): Size <= BatchSize independent
+    scalar problems f_n(x_n) = 0 are iterated in lockstep. The functions are
+    called as func(n, x) for the unconverged problems only, the updates of all
+    problems are done in one vectorizable loop with the converged problems
+    masked out. Instead of throwing, the error of each problem is returned in
+    Error[n] (ZeroGradient or MaxIterations), nullptr marks a converged problem.
+    Problem n follows the same iterates as the corresponding scalar call. */
+    template<std::size_t BatchSize, typename BINARY1, typename BINARY2, typename T>
+    static void BatchedNewton(BINARY1 func, BINARY2 dfunc, std::array<T,BatchSize>& x0,
+                              const std::size_t Size, T accuracy, unsigned long iterations,
+                              std::array<const char*,BatchSize>& Error)
+    {
+        assert(Size <= BatchSize);
+        std::array<T,BatchSize> f0;
+        std::array<T,BatchSize> df0;
+        std::array<bool,BatchSize> active;
+        std::size_t nActive = 0;
+        for (std::size_t n = 0; n < Size; n++)
+        {
+            f0[n]     = func(n, x0[n]);
+            Error[n]  = nullptr;
+            active[n] = (std::abs(f0[n]) > accuracy);
+            nActive  += active[n];
+        }
+        unsigned long itr = 0;
+        while (nActive > 0)
+        {
+            for (std::size_t n = 0; n < Size; n++)
+            if (active[n])
+            {
+                df0[n] = dfunc(n, x0[n]);
+                if (df0[n] == 0)
+                {
+                    Error[n]  = ZeroGradient;
+                    active[n] = false;
+                }
+            }
+            #pragma omp simd
+            for (std::size_t n = 0; n < Size; n++)
+            {
+                const T df = active[n] ? df0[n] : T(1);
+                const T p0 = active[n] ? -f0[n]/df : T(0);
+                x0[n] += p0;
+            }
+            itr++;
+            nActive = 0;
+            for (std::size_t n = 0; n < Size; n++)
+            if (active[n])
+            {
+                if (itr >= iterations)
+                {
+                    Error[n]  = MaxIterations;
+                    active[n] = false;
+                    continue;
+                }
+                f0[n]     = func(n, x0[n]);
+                active[n] = (std::abs(f0[n]) > accuracy);
+                nActive  += active[n];
+            }
+        }
+    }
+
+    template<std::size_t BatchSize, typename BINARY, typename T>
+    static void BatchedSecant(BINARY func, std::array<T,BatchSize>& x0, std::array<T,BatchSize>& x1,
+                              const std::size_t Size, T accuracy, unsigned long iterations,
+                              std::array<const char*,BatchSize>& Error)
+    {
+        assert(Size <= BatchSize);
+        std::array<T,BatchSize> f0;
+        std::array<T,BatchSize> f1;
+        std::array<bool,BatchSize> active;
+        std::array<bool,BatchSize> flat;
+        std::size_t nActive = 0;
+        for (std::size_t n = 0; n < Size; n++)
+        {
+            f0[n]     = func(n, x0[n]);
+            f1[n]     = func(n, x1[n]);
+            Error[n]  = nullptr;
+            active[n] = (std::abs(f0[n]) > accuracy);
+            nActive  += active[n];
+        }
+        unsigned long itr = 0;
+        while (nActive > 0)
+        {
+            #pragma omp simd
+            for (std::size_t n = 0; n < Size; n++)
+            {
+                const T df = f0[n] - f1[n];
+                flat[n] = (df == 0);
+                const bool update = active[n] and not flat[n];
+                const T p0 = update ? -f0[n]*(x0[n] - x1[n])/(update ? df : T(1)) : T(0);
+                x1[n] = update ? x0[n] : x1[n];
+                f1[n] = update ? f0[n] : f1[n];
+                x0[n] += p0;
+            }
+            itr++;
+            nActive = 0;
+            for (std::size_t n = 0; n < Size; n++)
+            if (active[n])
+            {
+                if (flat[n])
+                {
+                    Error[n]  = ZeroGradient;
+                    active[n] = false;
+                    continue;
+                }
+                f0[n] = func(n, x0[n]);
+                if (itr >= iterations)
+                {
+                    Error[n]  = MaxIterations;
+                    active[n] = false;
+                    continue;
+                }
+                active[n] = (std::abs(f0[n]) > accuracy);
+                nActive  += active[n];
+            }
+        }
+    }
+
     template<typename UNARY, typename T>
     static void Broyden(UNARY func, T& x0, T accuracy, unsigned long iterations)
     {
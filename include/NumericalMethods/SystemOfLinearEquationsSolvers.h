@@ -486,5 +486,97 @@ size_t OP_EXPORTS BiconjugateGradient(const Matrix& A, Vector& x, const Vector&
     return N;
 }
 
+/// Matrix-free right preconditioned BiCGStab for non-symmetric systems Ax=b.
+/// ApplyA(in,out) computes out = A*in, ApplyM(in,out) computes out ~ A^-1*in
+/// (preconditioner), Residual(r) returns the convergence measure of the
+/// residual r. x holds the initial guess and returns the solution.
+template<class Vector, class OperatorA, class OperatorM, class ResidualNorm>
+size_t OP_EXPORTS BiCGStab(OperatorA ApplyA, OperatorM ApplyM, ResidualNorm Residual,
+                           Vector& x, const Vector& b, const double MaxResidual,
+                           const size_t MaxIterations)
+{
+    //source: van der Vorst, H. A. "Bi-CGSTAB: A fast and smoothly converging variant of Bi-CG for the solution of nonsymmetric linear systems." SIAM J. Sci. Stat. Comput. 13 (1992) 631-644.
+    const size_t N = x.size();
+
+    Vector r(N), r0(N), p(N, 0.0), v(N, 0.0), s(N), t(N), ph(N, 0.0), sh(N, 0.0);
+
+    ApplyA(x, t);
+    #pragma omp parallel for
+    for (size_t i = 0; i < N; i++)
+    {
+        r[i]  = b[i] - t[i];
+        r0[i] = r[i];
+    }
+    if (Residual(r) < MaxResidual) return 0;
+
+    double rho   = 1.0;
+    double alpha = 1.0;
+    double omega = 1.0;
+    for (size_t k = 1; k <= MaxIterations; k++)
+    {
+        const double rhoNew = r0*r;
+        if (rhoNew == 0.0 or omega == 0.0) break;
+        const double beta = (rhoNew/rho)*(alpha/omega);
+        rho = rhoNew;
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < N; i++)
+        {
+            p[i] = r[i] + beta*(p[i] - omega*v[i]);
+        }
+        ApplyM(p, ph);
+        ApplyA(ph, v);
+        alpha = rho/(r0*v);
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < N; i++)
+        {
+            s[i] = r[i] - alpha*v[i];
+        }
+        if (Residual(s) < MaxResidual)
+        {
+            #pragma omp parallel for
+            for (size_t i = 0; i < N; i++)
+            {
+                x[i] += alpha*ph[i];
+            }
+            return k;
+        }
+
+        ApplyM(s, sh);
+        ApplyA(sh, t);
+        const double tt = t*t;
+        omega = (tt > 0.0) ? (t*s)/tt : 0.0;
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < N; i++)
+        {
+            x[i] += alpha*ph[i] + omega*sh[i];
+            r[i]  = s[i] - omega*t[i];
+        }
+        #ifdef DEBUG
+        std::cout << "Iteration: " << k << "\tResidual: " << Residual(r) << "\n";
+        #endif
+        if (Residual(r) < MaxResidual) return k;
+    }
+    ConsoleOutput::WriteWarning("Solution did not converge", "SolveLinearSystem", "BiCGStab");
+    return MaxIterations;
+}
+
+/// Right preconditioned BiCGStab for a matrix A (SparseMatrixCSR or
+/// SparseMatrixCompressedRow). M is one of the preconditioners of
+/// Preconditioners.h or any class with M.Apply(in,out). A and b are not
+/// modified, the iteration stops if max|b-A*x| < MaxResidual.
+template<class Matrix, class Preconditioner, class Vector>
+size_t OP_EXPORTS BiCGStab(const Matrix& A, const Preconditioner& M, Vector& x,
+                           const Vector& b, const double MaxResidual,
+                           const size_t MaxIterations)
+{
+    return BiCGStab([&A](const Vector& in, Vector& out){out = A*in;},
+                    [&M](const Vector& in, Vector& out){M.Apply(in, out);},
+                    [](const Vector& r){return max(r);},
+                    x, b, MaxResidual, MaxIterations);
+}
+
 };
 #endif
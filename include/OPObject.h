@@ -49,6 +49,9 @@ class AdvectionHR;
 class OP_EXPORTS OPObject
 {
  public:
+    OPObject(void);                                                             ///< Registers the object in the list of existing objects
+    OPObject(const OPObject& rhs);                                              ///< Copy constructor, registers the copy
+    OPObject& operator=(const OPObject& rhs) = default;                         ///< Assignment operator, keeps the registration
     virtual ~OPObject(void);
 
     std::string thisclassname;                                                  ///< Object's implementation class name
@@ -57,8 +60,10 @@ class OP_EXPORTS OPObject
     bool initialized         = false;                                           ///< True if obect's Initialize has been executed
     bool input_read          = false;                                           ///< True if obect's ReadInput() has been executed
     bool remeshable          = false;                                           ///< True if the object has non-empty Remesh() method
+    bool repartitionable     = false;                                           ///< True if the object has non-empty Repartition() method
     bool advectable          = false;                                           ///< True if the object has non-empty Advect() method
     bool readable            = false;                                           ///< True if the object has non-empty Read() method
+    bool checkpointable      = false;                                           ///< True if the object has non-empty WriteCheckpoint() and ReadCheckpoint() methods
     bool boundary_conditions = false;                                           ///< True if the object has non-empty SetBoundaryConditions()
 
     virtual void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "")///< Initializes internal variables and storages
@@ -94,6 +99,11 @@ class OP_EXPORTS OPObject
         (void) BC;    //unused
     }
 
+    virtual void Repartition(const BoundaryConditions& BC)                      ///< Migrates the storages to the local domain given by the current MPI cut planes, see LoadBalancer.h
+    {
+        (void) BC;    //unused
+    }
+
     virtual void Advect(AdvectionHR& Adv, const Velocities& Vel,
                         PhaseField& Phi, const BoundaryConditions& BC,
                         const double dt, const double tStep)                    ///< Advects relevant fields
@@ -122,11 +132,34 @@ class OP_EXPORTS OPObject
         return false;
     }
 
+    virtual void WriteCheckpoint(std::ostream& out) const                       ///< Writes binary output into a unified checkpoint, see Checkpoint.h
+    {
+        (void) out; //unused
+    }
+
+    virtual bool ReadCheckpoint(std::istream& inp)                              ///< Reads binary input from a unified checkpoint, must not communicate
+    {
+        (void) inp; //unused
+        return false;
+    }
+
+    virtual void FinalizeRead(const BoundaryConditions& BC)                     ///< Updates derived quantities and boundary conditions after ReadCheckpoint()
+    {
+        SetBoundaryConditions(BC);
+    }
+
     virtual void SetBoundaryConditions(const BoundaryConditions& BC)
     {
         (void) BC; //unused
     }
 
+    virtual size_t AllocatedMemory(void) const                                  ///< Memory held by the object's storages in bytes
+    {
+        return 0;
+    }
+
+    static std::vector<const OPObject*> ExistingObjects(void);                  ///< Returns all currently existing objects in the order of their construction
+
     static OPObject* FindObject(std::vector<OPObject*> ObjectList,
                            std::string ObjectName, std::string thisclassname,
                            std::string thisfunctionname, bool necessary, bool verbose = true)
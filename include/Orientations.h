@@ -50,6 +50,8 @@ class OP_EXPORTS Orientations : public OPObject
 
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override; ///< Initializes the module, allocate the storage, assign internal variables
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override;///< Remesh and reallocate orientations
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
 
     void SetBoundaryConditions(const BoundaryConditions& BC) override;          ///< Sets boundary conditions
     void WriteVTK(const Settings& locSettings,
@@ -0,0 +1,146 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef OUTPUTFIELD_H
+#define OUTPUTFIELD_H
+
+#include "Includes.h"
+#include <any>
+#include <typeindex>
+
+namespace openphase
+{
+
+/* Field descriptor of the VTK and HDF5 output (VTK::Field_t and
+H5Interface::Field_t). The generic form wraps a function returning the value
+at (i,j,k) as std::any, which costs a type check and a heap allocation for
+each cell and value. The typed forms know the value type at compile time and
+fill a contiguous output buffer in bulk with OpenMP:
+
+    ListOfFields.push_back(VTK::Field_t::Typed("Flags",
+        [this](int i,int j,int k){return Fields(i,j,k).flag;}));             // typed function
+    ListOfFields.push_back(VTK::Field_t::FromStorage("Fractions_0", Fractions,
+        [](const Tensor<double,1>& F){return F({0});}));                       // storage and projection
+
+The typed function or projection has to be thread safe. The generic form is
+kept for derived quantities whose type is only known at run time. */
+
+struct OP_EXPORTS OutputField                                                   ///< Short hand for a field's name and function which will be written to file
+{
+    std::string Name;                                                           ///< Name of the field in the output file
+    std::function<std::any(const int, const int, const int)> Function;          ///< Value at (i,j,k), generic access
+    std::type_index Type = typeid(void);                                        ///< Value type of the typed forms
+    std::function<void(void*, const long int, const long int, const long int)> Fill; ///< Bulk access of the typed forms, fills Nx*Ny*Nz values of Type
+
+    OutputField(const std::string& inp_Name,
+            const std::function<std::any(const int, const int, const int)>& inp_Function) :
+        Name(inp_Name), Function(inp_Function) {};
+
+    template<class function_t>
+    static OutputField Typed(const std::string& Name, function_t Function)      ///< Field from a function returning a value of a fixed type
+    {
+        typedef typename std::decay<decltype(Function(0,0,0))>::type T;
+
+        OutputField Field(Name, [Function](const int i, const int j, const int k) -> std::any
+        {
+            return Function(i,j,k);
+        });
+        Field.Type = typeid(T);
+        Field.Fill = [Function](void* Buffer, const long int Nx, const long int Ny, const long int Nz)
+        {
+            T* Values = static_cast<T*>(Buffer);
+            #pragma omp parallel for collapse(2) schedule(static)
+            for(long int k = 0; k < Nz; ++k)
+            for(long int j = 0; j < Ny; ++j)
+            for(long int i = 0; i < Nx; ++i)
+            {
+                Values[(k*Ny + j)*Nx + i] = Function(i,j,k);
+            }
+        };
+        return Field;
+    }
+
+    template<class storage_t, class projection_t>
+    static OutputField FromStorage(const std::string& Name,
+            const storage_t& Storage, projection_t Projection)                  ///< Field from a 3D storage and a projection of its values
+    {
+        typedef typename std::decay<decltype(Projection(Storage(0,0,0)))>::type T;
+
+        OutputField Field(Name, [&Storage, Projection](const int i, const int j, const int k) -> std::any
+        {
+            return Projection(Storage(i,j,k));
+        });
+        Field.Type = typeid(T);
+        Field.Fill = [&Storage, Projection](void* Buffer, const long int Nx, const long int Ny, const long int Nz)
+        {
+            /* Loops in the storage order (z fastest) to read contiguously */
+            T* Values = static_cast<T*>(Buffer);
+            #pragma omp parallel for collapse(2) schedule(static)
+            for(long int i = 0; i < Nx; ++i)
+            for(long int j = 0; j < Ny; ++j)
+            for(long int k = 0; k < Nz; ++k)
+            {
+                Values[(k*Ny + j)*Nx + i] = Projection(Storage(i,j,k));
+            }
+        };
+        return Field;
+    }
+
+    template<class storage_t>
+    static OutputField FromStorage(const std::string& Name, const storage_t& Storage) ///< Field from a 3D storage of output values
+    {
+        return FromStorage(Name, Storage, [](const auto& value){return value;});
+    }
+
+    std::type_index ValueType(void) const                                       ///< Type of the field's values
+    {
+        return (Type != typeid(void)) ? Type : std::type_index(Function(0,0,0).type());
+    }
+
+    template<class T>
+    std::vector<T> Values(const long int Nx, const long int Ny, const long int Nz) const ///< Values of all cells, x fastest
+    {
+        std::vector<T> Buffer(Nx*Ny*Nz);
+        if(Fill and Type == typeid(T))
+        {
+            Fill(Buffer.data(), Nx, Ny, Nz);
+        }
+        else
+        {
+            #pragma omp parallel for collapse(2) schedule(static)
+            for(long int k = 0; k < Nz; ++k)
+            for(long int j = 0; j < Ny; ++j)
+            for(long int i = 0; i < Nx; ++i)
+            {
+                Buffer[(k*Ny + j)*Nx + i] = std::any_cast<T>(Function(i,j,k));
+            }
+        }
+        return Buffer;
+    }
+};
+
+}// namespace openphase
+#endif
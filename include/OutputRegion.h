@@ -0,0 +1,97 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef OUTPUTREGION_H
+#define OUTPUTREGION_H
+
+#include "Includes.h"
+#include "OutputField.h"
+
+namespace openphase
+{
+
+class Settings;
+
+/* Part of the simulation domain written by the visualization output: a box
+of global grid cells [Begin, End) sampled with a stride in each direction.
+A box one cell thick is a slice and gives a single output plane also in dual
+resolution. If Settings::OutputRegions is not empty, the VTK writers and
+H5Interface::WriteVisualization() write each region instead of the whole
+domain, the VTK files are named "<Region>_<File>", the HDF5 datasets
+"<Region>_<Field>". Regions are read in the @Settings module:
+
+    $OutputRegion_0  Region of interest         : ROI BOX 32 96 32 96 0 64
+    $OutputRegion_1  Every 4th cell             : Coarse STRIDE 4
+    $OutputRegion_2  Mid plane, every 2nd cell  : MidZ SLICE Z 32 2
+
+BOX takes x0 x1 y0 y1 z0 z1 and an optional stride, SLICE the direction,
+the position and an optional stride. */
+
+struct OP_EXPORTS OutputRegion                                                  ///< Box, slice or subsampled part of the domain for the visualization output
+{
+    static constexpr auto thisclassname = "OutputRegion";                       ///< Object's implementation class name
+
+    std::string Name;                                                           ///< Prefix of the output file and field names
+    long int Begin[3]  = {0, 0, 0};                                             ///< First global cell in each direction
+    long int End[3]    = {-1, -1, -1};                                          ///< One past the last global cell in each direction, -1 for the domain end
+    long int Stride[3] = {1, 1, 1};                                             ///< Sampling stride in each direction
+
+    static OutputRegion Box(const std::string& Name,
+                            const long int x0, const long int x1,
+                            const long int y0, const long int y1,
+                            const long int z0, const long int z1,
+                            const long int Stride = 1);                         ///< Box [x0,x1) x [y0,y1) x [z0,z1)
+    static OutputRegion Slice(const std::string& Name, const int Direction,
+                              const long int Position,
+                              const long int Stride = 1);                       ///< Plane normal to Direction (0, 1 or 2) at the given cell
+    static OutputRegion Subsampled(const std::string& Name,
+                                   const long int Stride);                      ///< Whole domain, every Stride-th cell
+    static OutputRegion Parse(const std::string& Description);                  ///< Region from the input syntax "Name BOX|SLICE|STRIDE ..."
+
+    struct View_t                                                               ///< Local part of the region on this rank
+    {
+        long int N[3];                                                          ///< Local number of output points
+        long int Total[3];                                                      ///< Global number of output points
+        long int Offset[3];                                                     ///< Position of the local points in the global output grid
+        long int First[3];                                                      ///< Local storage index of the first local output point
+        long int Begin[3];                                                      ///< Global storage index of the first output point
+        long int Stride[3];                                                     ///< Storage index increment between output points
+
+        bool empty(void) const                                                  ///< True if the rank holds no output points
+        {
+            return N[0] == 0 or N[1] == 0 or N[2] == 0;
+        }
+    };
+
+    View_t Local(const Settings& locSettings, const int resolution = 1) const;  ///< Local part of the region at the given output resolution
+    std::vector<OutputField> Restrict(const std::vector<OutputField>& ListOfFields,
+                                      const View_t& View,
+                                      const std::string& Prefix = "") const;    ///< Fields sampled at the local output points of View
+    std::string FileName(const std::string& Filename) const;                    ///< Output file name of the region for Filename
+};
+
+}// namespace openphase
+#endif
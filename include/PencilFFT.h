@@ -0,0 +1,129 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef PENCILFFT_H
+#define PENCILFFT_H
+
+#ifdef MPI_PARALLEL
+#include "mpi_wrapper.h"
+#include "Includes.h"
+
+namespace openphase
+{
+class GridParameters;
+
+class OP_EXPORTS PencilFFT                                                      ///< Distributed 3D real to complex FFT on the MPI 3D domain decomposition
+{
+    /* The FFTW MPI interface distributes the grid in slabs along X and cannot
+    use more MPI processes than grid cells in X. PencilFFT transforms the
+    bricks of the MPI 3D domain decomposition instead. The processes form a
+    P1 x P2 grid, the data is redistributed (transposed) between Z-, Y- and
+    X-pencils, which are transformed locally by FFTW in between:
+
+        brick -> Z-pencils: r2c along Z -> Y-pencils: c2c along Y ->
+        X-pencils: c2c along X
+
+    The backward transform runs through the same steps in reverse order.
+    The real space data is the local brick of the MPI 3D domain
+    decomposition stored as "k + 2*Nz2*(j + Ny*i)" (local Nx, Ny, Nz and
+    Nz2 = Nz/2 + 1 of the GridParameters), the same layout as in the FFTW MPI
+    slab mode. The reciprocal space data is an X-pencil stored as
+    "k + SpectralN[2]*(j + SpectralN[1]*i)" in units of complex numbers, its
+    position in the global reciprocal space is given by SpectralOffset. Both
+    share the array passed to Initialize(), nComponents arrays of LocalSize()
+    doubles each are transformed together. As with FFTW plans, the arrays are
+    overwritten during the planning with measurement.*/
+ public:
+    PencilFFT(){};
+    ~PencilFFT(void);
+    PencilFFT(const PencilFFT&) = delete;
+    PencilFFT& operator=(const PencilFFT&) = delete;
+
+    static size_t LocalSize(const GridParameters& Grid);                        ///< Number of doubles per component required by the transforms
+    void Initialize(const GridParameters& Grid, const size_t nComponents,
+                    double* data, const unsigned int flags);                    ///< Creates the transforms of nComponents arrays of LocalSize() doubles stored one after another in data
+    void Free(void);                                                            ///< Destroys the transforms and frees the work arrays
+
+    void Forward(void);                                                         ///< Transforms all components from real to reciprocal space
+    void Backward(void);                                                        ///< Transforms all components from reciprocal to real space (not normalized)
+
+    int SpectralN[3]{};                                                         ///< Local extents of the reciprocal space data (X, Y, Z)
+    int SpectralOffset[3]{};                                                    ///< Position of the local reciprocal space data in the global reciprocal space
+
+ private:
+    struct Layout                                                               ///< Part of the global index space stored locally
+    {
+        int Offset[3]{};                                                        ///< Global index of the first element
+        int Size[3]{};                                                          ///< Number of elements in each direction
+        int Stride = 0;                                                         ///< Storage extent in Z direction (>= Size[2])
+        int Width = 1;                                                          ///< Number of doubles per element (1 real, 2 complex)
+    };
+    struct Transpose                                                            ///< Redistribution of data between two layouts
+    {
+        Layout In;                                                              ///< Local layout before the redistribution
+        Layout Out;                                                             ///< Local layout after the redistribution
+        std::vector<Layout> SendBoxes;                                          ///< Part of In sent to each process (in local indices)
+        std::vector<Layout> RecvBoxes;                                          ///< Part of Out received from each process (in local indices)
+        std::vector<int> SendCounts;                                            ///< Number of doubles sent to each process
+        std::vector<int> SendDispls;                                            ///< Send buffer offsets
+        std::vector<int> RecvCounts;                                            ///< Number of doubles received from each process
+        std::vector<int> RecvDispls;                                            ///< Receive buffer offsets
+    };
+
+    static void ProcessGrid(const GridParameters& Grid, int& P1, int& P2);     ///< Factorizes the number of processes into the P1 x P2 pencil grid
+    static void Split(const int N, const int P, const int rank,
+                      int& offset, int& size);                                  ///< Block distribution of N cells over P processes
+    static std::array<Layout,5> Layouts(const GridParameters& Grid);            ///< Local brick, real and complex Z-pencil, Y- and X-pencil layouts
+    void SetupTranspose(Transpose& T, const Layout& In, const Layout& Out);     ///< Collects the layouts of all processes and sets the exchanged boxes
+    void Execute(const Transpose& T, const double* in, double* out);            ///< Redistributes all components from T.In to T.Out
+
+    size_t nComp = 0;                                                           ///< Number of transformed components
+    size_t CompSize = 0;                                                        ///< Number of doubles per component
+    double* Data = nullptr;                                                     ///< User array (brick in real, X-pencil in reciprocal space)
+    double* WorkA = nullptr;                                                    ///< Work array: real Z-pencils and Y-pencils
+    double* WorkB = nullptr;                                                    ///< Work array: complex Z-pencils
+    std::vector<double> SendBuffer;                                             ///< Packed data sent during the redistributions
+    std::vector<double> RecvBuffer;                                             ///< Packed data received during the redistributions
+
+    Transpose BrickToZ;                                                         ///< Brick -> real Z-pencils
+    Transpose ZToY;                                                             ///< Complex Z-pencils -> Y-pencils
+    Transpose YToX;                                                             ///< Y-pencils -> X-pencils
+    Transpose XToY;                                                             ///< X-pencils -> Y-pencils
+    Transpose YToZ;                                                             ///< Y-pencils -> complex Z-pencils
+    Transpose ZToBrick;                                                         ///< Real Z-pencils -> brick
+
+    std::vector<fftw_plan> Plans;                                               ///< All 1D transforms, for destruction
+    fftw_plan ForwardZ  = nullptr;                                              ///< r2c transforms along Z
+    fftw_plan ForwardY  = nullptr;                                              ///< Forward c2c transforms along Y
+    fftw_plan ForwardX  = nullptr;                                              ///< Forward c2c transforms along X
+    fftw_plan BackwardX = nullptr;                                              ///< Backward c2c transforms along X
+    fftw_plan BackwardY = nullptr;                                              ///< Backward c2c transforms along Y
+    fftw_plan BackwardZ = nullptr;                                              ///< c2r transforms along Z
+};
+
+}// namespace openphase
+#endif
+#endif
@@ -32,6 +32,8 @@
 #include "GrainsProperties.h"
 #include "Includes.h"
 #include "H5Interface.h"
+#include "DeltaCheckpoint.h"
+#include "GrainTopology.h"
 
 namespace openphase
 {
@@ -63,8 +65,11 @@ class OP_EXPORTS PhaseField : public OPObject
     void AllocateStorages(GridParameters& Grid);                                ///< Allocates internal storages
 
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override; ///< Changes the mesh size while keeping the data.
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
 
     void Clear(void);                                                           ///< Clears the phase field storage
+    void SetInterfaceCells(void);                                               ///< Rebuilds the interface cell lists from the current flags (only needed if flags are modified outside of Finalize())
 
     void Refine(void);                                                          ///< Calculates double resolution phase-fields from the single resolution ones
 
@@ -144,16 +149,49 @@ class OP_EXPORTS PhaseField : public OPObject
     void FixSpreading(const BoundaryConditions& BC, double cutoff);             ///< Removes phase-fields with values below the cutoff (used for reducing parasitic diffusion in advection)
     void KeepPhaseFieldsVolume(void);                                           ///< Keeps phase fields volume constant by allowing only grain shape change. Should be called before NormalizeIncrements()
 
+    void CompactGrainIndices(void);                                             ///< Removes vanished grains and renumbers the phase-field indices of the remaining ones. Call between time steps, per-grain data of other modules becomes invalid
+    size_t SplitDisconnectedGrains(const BoundaryConditions& BC);               ///< Gives every disconnected part of a grain but the largest one a new grain index, returns the number of new grains. Call between time steps (collective)
     void NormalizeIncrements(const BoundaryConditions& BC, const double dt);    ///< Normalizes the interface fields such that resulting phase fields after merge do not escape interval [0,1] and sum up to 1.
+    double ReportMaximumTimeStep(const double MaxChange = 0.1) const;           ///< Returns the time step for which the largest pending increment changes a phase field by MaxChange, call before merging
 
     void MergeIncrements(const BoundaryConditions& BC,
                          const double dt,
                          const bool finalize = true,
                          const bool clear = true);                              ///< Merges the increments into the phase fields
 
+    void NormalizeAndMergeIncrements(const BoundaryConditions& BC,
+                                     const double dt,
+                                     const bool finalize = true,
+                                     const bool clear = true);                  ///< Same as NormalizeIncrements() followed by MergeIncrements(), but limits, merges and finalizes each cell in a single sweep
+
+    /* Communication-avoiding mode (HaloExchangeInterval k > 1, single
+    resolution only): the MPI halo of the phase fields is exchanged every k-th
+    merge only. In between, increments, merging, flags and derivatives are also
+    calculated in the halo layers which are still valid, their number shrinks
+    by one per time step (the reach of the derivative stencils), and only the
+    non-communicating boundary conditions are set. This requires Bcells >= k.
+    InterfaceCells then includes the halo cells within HaloReach(), so that
+    modules iterating over it (InterfaceProperties, DoubleObstacle) follow
+    automatically. Modules reading the halo of other storages have to use
+    HaloReach() and HaloExchangeDue() in the same way, as
+    EquilibriumPartitionDiffusionBinary does. The result is identical to the
+    one with an exchange in every time step for the phase-field model of
+    DoubleObstacle (with or without diffusion). Driving forces are not updated
+    in the halo, the mode is therefore not exact with them. */
+    long int HaloReach(void) const;                                             ///< Halo layers which are updated redundantly in the current time step
+    bool HaloExchangeDue(void) const;                                           ///< True if the halo is exchanged at the end of the current time step
+
     void MoveFrame(const int dx, const int dy, const int dz,
                    const BoundaryConditions& BC) override;                      ///< Shifts the data in the storage by dx, dy and dz (they should be 0, -1 or +1) in x, y and or z directions correspondingly.
 
+    /* Front tracking for moving frames: the fraction of one thermodynamic
+    phase is summed over each plane normal to the tracking axis. Like the
+    incremental grain volumes, the plane sums are updated from the merged
+    cells in MergeIncrements() and rescanned after any other change of the
+    phase fields, so FrontPosition() does not scan the domain.*/
+    void TrackFront(const size_t phase, const int axis);                        ///< Starts tracking the front of thermodynamic phase along axis (0, 1 or 2)
+    long int FrontPosition(const bool forward = true) const;                    ///< Global index of the farthest plane along (forward) or against the tracking axis holding at least half a cell of the tracked phase, -1 if none
+
     void ConsumePlane(const int dx, const int dy, const int dz,
                       const int x, const int y, const int z,
                       const BoundaryConditions& BC);                            ///< Shifts the data in the storage by dx, dy and dz (they should be 0, -1 or +1) in the direction to/from (x, y, z) point.
@@ -195,12 +233,21 @@ class OP_EXPORTS PhaseField : public OPObject
     void WriteGrainsVolume(int time_step, double time, std::string filename);   ///< Writes grains' volume in grid cells over time into a file
 
     bool Read(std::string FileName);                                            ///< Read raw (binary) phase fields from the file named FileName
+    bool Read(std::istream& inp);                                               ///< Read raw (binary) phase fields from the stream inp
     bool Read(const Settings& locSettings,
               const BoundaryConditions& BC, const int tStep) override;          ///< Read raw (binary) phase fields from the file of specific time step
     bool ReadH5(const BoundaryConditions& BC, H5Interface& H5, const int tStep);///< Read raw data from HDF5 file
     
 	bool WriteMPI(const std::string& Path); 
     bool Write(const std::string& FileName) const;                              ///< Write raw (binary) phase fields to the file FileName
+    void Write(std::ostream& out) const;                                        ///< Write raw (binary) phase fields to the stream out
+    void WriteBlock(std::ostream& out, const DeltaCheckpoint::Block_t& B) const;///< Write raw (binary) phase fields of a block of cells to the stream out
+    void ReadBlock(std::istream& inp, const DeltaCheckpoint::Block_t& B);       ///< Read raw (binary) phase fields of a block of cells from the stream inp
+    void WriteIndexed(std::ostream& out) const;                                 ///< Write raw (binary) phase fields in the indexed format to the stream out
+    bool ReadIndexed(const std::string& FileName);                              ///< Read raw (binary) phase fields in the indexed format from the file named FileName
+    void WriteCheckpoint(std::ostream& out) const override;                     ///< Write raw (binary) phase fields and grains properties into a unified checkpoint
+    bool ReadCheckpoint(std::istream& inp) override;                            ///< Read raw (binary) phase fields and grains properties from a unified checkpoint
+    void FinalizeRead(const BoundaryConditions& BC) override;                   ///< Finalizes the phase fields after reading
     bool Write(const Settings& locSettings, const int tStep) const override;    ///< Write raw (binary) phase fields to the file PhaseField_tStep.dat
     void WriteH5(H5Interface& H5, const int tStep);                             ///< Writes output in HDF5 format
 
@@ -242,11 +289,24 @@ class OP_EXPORTS PhaseField : public OPObject
 
     bool NucleationPresent;                                                     ///< True if there are nuclei of any phase, false otherwise
     bool ConsiderNucleusVolume;
+    bool FlatStorage;                                                           ///< If true, a flat (CSR-like) snapshot of the phase fields is used for the stencil operations in Finalize()
+    bool FusedFinalize;                                                         ///< If true, interface flags and derivatives are updated in a single stencil pass in Finalize()
+    bool FixedStencilKernels;                                                   ///< If true, derivatives are calculated by kernels compiled for the fixed stencil size of the active dimensions
+    bool IncrementalGrainsVolume;                                               ///< If true, grain volumes are updated from the merged increments instead of a full domain scan
+    size_t GrainsVolumeCheckInterval;                                           ///< Number of incremental grain volume (and topology) updates between full rescans (0 - never rescan)
+    bool IncrementalGrainsTopology;                                             ///< If true, the grain neighbour graph in Topology is updated from the merged increments
+    bool DeltaGrainsSync;                                                       ///< If true, CalculateGrainsVolume() reduces only the grains changed on any MPI rank since the last synchronization
+    size_t GrainsFullSyncInterval;                                              ///< Number of delta grain synchronizations between full ones (0 - never)
+    size_t HaloExchangeInterval;                                                ///< Time steps between the halo exchanges of the phase fields (1 - every time step)
+    size_t OccupancyBlockSize;                                                  ///< Edge length of the blocks of the occupancy map (0 - no occupancy map)
+    bool NarrowBandDR;                                                          ///< If true, Refine() interpolates only near the interface and keeps the bulk double resolution nodes compact
+    bool IndexedRawData;                                                        ///< If true, raw data files are written in the indexed format which is read in parallel
 
     LaplacianStencil LStencil;                                                  ///< Laplacian stencil. Uses user specified stencil as the basis
     GradientStencil  GStencil;                                                  ///< Gradient stencil. Uses user specified stencil as the basis
 
     GrainsProperties FieldsProperties;                                          ///< Phase fields properties. Contains information about location, velocity, orientation, volume, aggregate state etc. of each phase field
+    mutable GrainTopology Topology;                                             ///< Grain neighbour graph, maintained if IncrementalGrainsTopology is true, Topology.Synchronize() updates the global graph
 
     Storage3D< double, 1 > Fractions;                                           ///< Phase fractions storage
 
@@ -258,6 +318,28 @@ class OP_EXPORTS PhaseField : public OPObject
 
     Storage3D< NodePF, 0 > FieldsDR;                                            ///< Phase-field storage for double resolution mode
     Storage3D< NodeAB<double,double>, 0 > FieldsDotDR;                          ///< Phase-field increments storage for double resolution mode
+
+    FlatStoragePF FieldsFlat;                                                   ///< Flat snapshot of the phase-field values, rebuilt in Finalize() if FlatStorage is enabled
+
+    std::vector<iVector3> InterfaceCells;                                       ///< Coordinates of the interior cells (and halo cells within HaloReach()) with nonzero flag, rebuilt in SetFlagsSR()
+    OccupancyMap Occupancy;                                                     ///< Blocks of interior cells with and without interface cells, rebuilt with InterfaceCells if OccupancyBlockSize > 0
+    std::vector<double> GrainsVolumeLocal;                                      ///< Grain volumes in the local domain, basis of the incremental grain volume updates
+    ThreadLocalAccumulator<Tensor<sum_real_t,1>> GrainsVolumeIncrements;        ///< Grain volume changes of the current merge step accumulated per thread
+    bool GrainsVolumeIncrementsPending;                                         ///< True if GrainsVolumeIncrements have to be added in CalculateGrainsVolume()
+    int FrontAxis = -1;                                                         ///< Axis of the front tracking (-1 - disabled)
+    size_t FrontPhase = 0;                                                      ///< Thermodynamic phase whose front is tracked
+    std::vector<double> FrontPlanesLocal;                                       ///< Fractions of FrontPhase summed over each local plane normal to FrontAxis
+    ThreadLocalAccumulator<Tensor<sum_real_t,1>> FrontPlanesIncrements;         ///< Plane sum changes of the current merge step accumulated per thread
+    bool FrontPlanesIncrementsPending = false;                                  ///< True if FrontPlanesIncrements have to be added in UpdateFront()
+    size_t FrontPlanesUpdates = 0;                                              ///< Number of incremental plane sum updates since the last full rescan
+    size_t HaloSteps;                                                           ///< Time steps since the last halo exchange of the phase fields
+    bool HaloLocalFinalize;                                                     ///< If true, the next Finalize() sets only the non-communicating boundary conditions
+    size_t GrainsVolumeUpdates;                                                 ///< Number of incremental grain volume updates since the last full rescan
+    std::vector<double> GrainsSynced;                                           ///< Local volume and global volume, MAXVolume, RefVolume, stage, variant and phase of each grain at the last MPI synchronization
+    size_t GrainsDeltaSyncs;                                                    ///< Number of delta grain synchronizations since the last full one
+    std::vector<iVector3> InterfaceCellsDR;                                     ///< Coordinates of the interior cells with nonzero flag in double resolution, rebuilt in SetFlagsDR()
+    size_t GrainsTopologyUpdates;                                               ///< Number of incremental grain topology updates since the last full rescan
+    mutable DeltaCheckpoint Checkpoints;                                        ///< Incremental raw data checkpoints, used if Settings::DeltaCheckpoints > 0
     
     // VTK output helper methods:
     double CurvaturePhase  (const int i, const int j, const int k, const size_t Index) const;///< Curvature for each thermodynamic phase VTK output
@@ -278,9 +360,47 @@ class OP_EXPORTS PhaseField : public OPObject
     void SetStencils(GridParameters& Grid);                                     ///< Sets gradient and Laplacian stencils
 
     void SetFlagsSR();                                                          ///< Sets the flags which mark interfaces
+    void SetFlagsTeamSR(void);                                                  ///< Same as SetFlagsSR(), has to be called by all threads of an enclosing parallel region
     void SetFlagsDR();                                                          ///< Sets the flags which mark interfaces in double resolution case
+    static void CollectInterfaceCells(const Storage3D<NodePF,0>& locFields,
+                                      std::vector<iVector3>& Cells,
+                                      const long int Reach = 0);                ///< Collects cells with nonzero flag in storage order, the interior and Reach halo layers
+    static void CollectInterfaceCellsTeam(const Storage3D<NodePF,0>& locFields,
+                                      std::vector<iVector3>& Cells,
+                                      const long int Reach,
+                                      std::vector<std::vector<iVector3>>& ThreadCells,
+                                      std::vector<size_t>& ThreadOffsets);      ///< Same as CollectInterfaceCells() for all threads of an enclosing parallel region, ThreadCells and ThreadOffsets are shared scratch lists
+    void CheckHaloExchangeInterval(void);                                       ///< Validates HaloExchangeInterval against the grid
+    void UpdateOccupancy(void);                                                 ///< Rebuilds the occupancy map from InterfaceCells and the bulk grain indices
+    void UpdateOccupancyTeam(void);                                             ///< Same as UpdateOccupancy(), has to be called by all threads of an enclosing parallel region
+    void SetLocalBoundaryConditionsSR(const BoundaryConditions& BC);            ///< Sets the non-communicating boundary conditions of the phase fields
+    void AdvanceHaloStepSR(const bool clear);                                   ///< Counts a merge in the communication-avoiding mode, clears the increments exchanged into the halo if clear is true
+    bool InteriorCellSR(const long int i, const long int j, const long int k) const;///< True if (i,j,k) is not a halo cell
 
     void CalculateDerivativesSR(void);                                          ///< Calculates local phase-field derivatives
+    void CalculateDerivativesTeamSR(void);                                      ///< Same as CalculateDerivativesSR() without FlatStorage, has to be called by all threads of an enclosing parallel region
+    void SetBoundaryConditionsAndFlagsSR(const BoundaryConditions& BC);         ///< Same as SetBoundaryConditionsSR() followed by SetFlagsSR(), interior flags are set while the halo exchange is in flight
+    void SetBoundaryConditionsAndDerivativesSR(const BoundaryConditions& BC);   ///< Same as SetBoundaryConditionsSR() followed by CalculateDerivativesSR(), interior derivatives are calculated while the halo exchange is in flight
+    void SetBoundaryConditionsFlagsAndDerivativesSR(const BoundaryConditions& BC);///< Fused version of SetBoundaryConditionsAndFlagsSR() and SetBoundaryConditionsAndDerivativesSR() with a single halo exchange and stencil pass
+    void SetNeighborFlagsSR(const long int i, const long int j, const long int k);///< Marks the neighbors of the interface cell (i,j,k)
+    bool UniformNeighborhoodSR(const long int i, const long int j, const long int k) const;///< True if the cell (i,j,k) and all its direct neighbors contain the same single phase field
+    bool BeginGrainsVolumeIncrements(void);                                     ///< Prepares the accumulation of grain volume changes during merging, returns false if the incremental update is not applicable
+    void AddCellVolumeSR(const long int i, const long int j, const long int k,
+                         const double sign);                                    ///< Adds sign times the phase-field values of cell (i,j,k) to the grain volume changes of the calling thread
+    bool BeginGrainsTopologyIncrements(void);                                   ///< Prepares the accumulation of grain contact changes during merging, returns false if the incremental update is not applicable
+    bool BeginFrontIncrements(void);                                            ///< Prepares the accumulation of front plane sum changes during merging, returns false if the incremental update is not applicable
+    void AddCellFrontSR(const long int i, const long int j, const long int k,
+                        const double sign);                                     ///< Adds sign times the FrontPhase fraction of cell (i,j,k) to the plane sum changes of the calling thread
+    void UpdateFront(void);                                                     ///< Adds the merged plane sum changes or rescans the plane sums if front tracking is active
+    long int FrontPlanesSize(void) const                                        ///< Number of local planes normal to FrontAxis
+    {
+        return (FrontAxis == 0) ? Fields.sizeX() : ((FrontAxis == 1) ? Fields.sizeY() : Fields.sizeZ());
+    }
+    void SetFlagAndCalculateTemporaryDerivativesSR(const long int i, const long int j, const long int k);///< Marks cell (i,j,k) if it has an interface neighbor and accumulates its derivatives in its temporary storage
+    void CalculateTemporaryDerivativesSR(const long int i, const long int j, const long int k);///< Accumulates the derivatives of cell (i,j,k) in its temporary storage
+    template<class LaplacianStencilType, class GradientStencilType>
+    void CalculateTemporaryDerivativesFixedSR(const long int i, const long int j, const long int k);///< Same as CalculateTemporaryDerivativesSR() with compile-time stencils
+    void SelectDerivativesKernelSR(void);                                       ///< Selects the fixed stencil derivatives kernel matching the current stencils
     void CalculateDerivativesDR(void);                                          ///< Calculates local phase-field derivatives in double resolution
 
     void SetBoundaryConditionsSR(const BoundaryConditions& BC);                 ///< Set boundary conditions in single resolution case
@@ -290,6 +410,9 @@ class OP_EXPORTS PhaseField : public OPObject
     void SetIncrementsBoundaryConditionsDR(const BoundaryConditions& BC);       ///< Set boundary conditions for phase field increments in double resolution case
 
     void FinalizeSR(const BoundaryConditions& BC, const bool finalize = true);  ///< Finalizing the phase fields calculations in this time step
+    void FinalizeCellsTeamSR(void);                                             ///< Finalizes the merged interface cells and counts their volume and contact changes, has to be called by all threads of an enclosing parallel region
+    void FinalizeTeamSR(const BoundaryConditions& BC, const bool finalize,
+                        const bool fused);                                      ///< Part of FinalizeSR() without halo exchange: cells, local boundary conditions, flags and derivatives, has to be called by all threads of an enclosing parallel region
     void FinalizeDR(const BoundaryConditions& BC, const bool finalize = true);  ///< Finalizing the phase fields calculations in this time step in double resolutions
 
     void KeepPhaseVolumeSR(Tensor<bool,2> AllowedTransitions);                  ///< Keeps phases volume constant by allowing only grain shape change and grain transformations between the grains of the same phase (emulates coexistence of immiscible phases). Should be called before NormalizeIncrements()
@@ -307,6 +430,26 @@ class OP_EXPORTS PhaseField : public OPObject
                            const bool finalize = true,
                            const bool clear = true);                            ///< Merges the increments into the phase fields in double resolution
 
+    void NormalizeAndMergeIncrementsSR(const BoundaryConditions& BC,
+                                       const double dt,
+                                       const bool finalize = true,
+                                       const bool clear = true);                ///< Fused normalization and merge of the increments in single resolution
+    void NormalizeAndMergeIncrementsDR(const BoundaryConditions& BC,
+                                       const double dt,
+                                       const bool finalize = true,
+                                       const bool clear = true);                ///< Fused normalization and merge of the increments in double resolution
+
+    void NormalizeCellIncrementsSR(const long int i, const long int j,
+                                   const long int k, const double dt);          ///< Limits the increments of cell (i,j,k) in single resolution
+    void NormalizeCellIncrementsDR(const long int i, const long int j,
+                                   const long int k, const double dt);          ///< Limits the increments of cell (i,j,k) in double resolution
+    void MergeCellIncrementsSR(const long int i, const long int j,
+                               const long int k, const double dt,
+                               const bool clear);                               ///< Merges the increments of cell (i,j,k) into the phase fields in single resolution
+    void MergeCellIncrementsDR(const long int i, const long int j,
+                               const long int k, const double dt,
+                               const bool clear);                               ///< Merges the increments of cell (i,j,k) into the phase fields in double resolution
+
     void MoveFrameSR(const int dx, const int dy, const int dz,
                      const BoundaryConditions& BC);                             ///< Shifts the data in the storage by dx, dy and dz (they should be 0, -1 or +1) in x, y and or z directions correspondingly.
     void MoveFrameDR(const int dx, const int dy, const int dz,
@@ -331,9 +474,18 @@ class OP_EXPORTS PhaseField : public OPObject
 
     void CombinePhaseFields(void);                                              ///< Merge phase fields of same phase to phase field with index PhaseIndex
     std::vector<bool> Combine;                                                  ///< Indicates which phase's phase fields should be combined
+    std::vector<std::vector<iVector3>> ThreadInterfaceCells;                    ///< Per thread scratch lists of CollectInterfaceCellsTeam()
+    std::vector<size_t> ThreadInterfaceOffsets;                                 ///< Per thread offsets of CollectInterfaceCellsTeam()
+
+    typedef void (PhaseField::*DerivativesKernel)(const long int, const long int, const long int);
+    DerivativesKernel FixedDerivativesKernelSR = nullptr;                       ///< Fixed stencil derivatives kernel matching LStencil and GStencil, nullptr if none matches
+    double FixedLaplacianScale = 1.0;                                           ///< Grid spacing factor 1/dx^2 of the fixed Laplacian stencil weights
+    double FixedGradientScale  = 1.0;                                           ///< Grid spacing factor 1/dx of the fixed gradient stencil weights
 
     void CalculateFractions(void);                                              ///< Calculates phase fractions from phase-fields, populates Fractions storage
     void CalculateGrainsVolume(void);                                           ///< Collects volume for each phase field.
+    std::vector<double> ScanGrainsVolume(void) const;                           ///< Volume of each phase field in the local domain from a full domain scan
+    void UpdateGrainsTopology(void);                                            ///< Applies the merged contact changes to Topology or rescans it
 
     void Advect(AdvectionHR& Adv, const Velocities& Vel,
                 PhaseField& Phi, const BoundaryConditions& BC,
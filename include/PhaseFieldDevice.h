@@ -0,0 +1,116 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef PHASEFIELDDEVICE_H
+#define PHASEFIELDDEVICE_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+class BoundaryConditions;
+class InterfaceProperties;
+class PhaseField;
+
+class OP_EXPORTS PhaseFieldDevice                                               ///< Device resident phase fields and grain growth time step (OpenMP target offload)
+{
+    /* The phase fields of all interior cells are kept in device memory in a
+    padded sparse layout: each cell has MaxFields slots of (index, value),
+    slot n of all cells being contiguous (index n*Ncells + cell, cell index
+    (i*Ny + j)*Nz + k), unused slots have the index -1. A time step runs as two
+    OpenMP target regions: the interface flags, and the fused derivatives,
+    double obstacle increments, normalization, merging and finalization of the
+    interface cells (same algorithms as InterfaceProperties::Set(),
+    DoubleObstacle::CalculatePhaseFieldIncrements(),
+    PhaseField::NormalizeIncrements() and PhaseField::MergeIncrements()).
+    The data stays on the device between the time steps, CopyToHost() is only
+    needed for output, analysis and checkpoints.
+    The kernels cover isotropic grain growth: a single thermodynamic phase with
+    isotropic interface energy and mobility, stable grains (no nucleation),
+    periodic boundaries in all directions, single resolution and the serial
+    (non-MPI) build. Cells in which more than MaxFields phase fields meet keep
+    the largest ones, the number of such truncations is reported by
+    CopyToHost(). Without offload support of the compiler the target regions
+    are executed on the host.*/
+ public:
+    static constexpr auto thisclassname = "PhaseFieldDevice";                   ///< Object's implementation class name
+    static constexpr int MaxLocal = 16;                                         ///< Upper bound of MaxFields and of the phase fields in the neighbourhood of a cell
+
+    PhaseFieldDevice(void){};
+    ~PhaseFieldDevice(void);
+    PhaseFieldDevice(const PhaseFieldDevice&) = delete;
+    PhaseFieldDevice& operator=(const PhaseFieldDevice&) = delete;
+
+    void ReadInput(const std::string InputFileName);                            ///< Reads $Offload and $OffloadMaxFields from the @PhaseField section
+    bool Supported(const PhaseField& Phase, const InterfaceProperties& IP,
+                   const BoundaryConditions& BC, std::string& Reason) const;    ///< Checks if the device kernels cover the simulation setup
+    bool Initialize(const PhaseField& Phase, const InterfaceProperties& IP,
+                    const BoundaryConditions& BC);                              ///< Allocates the device arrays and uploads the phase fields if Offload is enabled and supported, returns true on success
+    void Release(void);                                                         ///< Frees the device arrays
+    bool IsAllocated(void) const
+    {
+        return Ncells != 0;
+    }
+
+    void CopyToDevice(const PhaseField& Phase);                                 ///< Uploads the phase fields of the interior cells
+    void CopyToHost(PhaseField& Phase, const BoundaryConditions& BC);           ///< Downloads the phase fields and finalizes them on the host (flags, derivatives, grain volumes)
+    void Step(const double dt);                                                 ///< Advances the phase fields on the device by one time step
+
+    bool Offload = false;                                                       ///< Set to "true" to run the phase-field time step on the device
+    int MaxFields = 8;                                                          ///< Phase-field slots per cell
+
+ private:
+    long int Nx = 0;                                                            ///< Number of interior cells in x direction
+    long int Ny = 0;                                                            ///< Number of interior cells in y direction
+    long int Nz = 0;                                                            ///< Number of interior cells in z direction
+    int dNx = 0;                                                                ///< Active x dimension (0 or 1)
+    int dNy = 0;                                                                ///< Active y dimension (0 or 1)
+    int dNz = 0;                                                                ///< Active z dimension (0 or 1)
+    size_t Ncells = 0;                                                          ///< Number of interior cells
+    int Nslots = 0;                                                             ///< MaxFields of the allocated arrays
+    int Nstencil = 0;                                                           ///< Number of Laplacian stencil entries
+    int StencilOffsets[3*27] = {};                                              ///< Laplacian stencil offsets (di, dj, dk)
+    double StencilWeights[27] = {};                                             ///< Laplacian stencil weights
+
+    double Energy = 0.0;                                                        ///< Interface energy
+    double Mobility = 0.0;                                                      ///< Interface mobility
+    double TripleJunction = 0.0;                                                ///< Coefficient of the triple junction term
+    double Prefactor = 0.0;                                                     ///< Pi^2/Eta^2
+
+    int* Index = nullptr;                                                       ///< Phase-field indices, -1 for unused slots
+    double* Value = nullptr;                                                    ///< Phase-field values
+    int* IndexNew = nullptr;                                                    ///< Phase-field indices after the time step
+    double* ValueNew = nullptr;                                                 ///< Phase-field values after the time step
+    int* Flag = nullptr;                                                        ///< Interface flags (see NodePF::flag)
+    long int* Truncations = nullptr;                                            ///< Number of cells which had more than MaxFields phase fields
+
+    void SetFlags(void);                                                        ///< Interface flags from the current phase fields
+    void Update(const double dt);                                               ///< Fused increments, normalization, merging and finalization of the interface cells
+};
+
+} //namespace openphase
+#endif
@@ -50,6 +50,7 @@
 
 #include "FlowMixture.h"
 #include "SolidBody.h"
+#include "GhostPointCache.h"
 
 using namespace std;
 
@@ -132,6 +133,8 @@ class EnergyTransport
 	double Cps;
 	double Ts0;
 
+    GhostPointCache GhostPoints;                                                ///< Immersed boundary ghost points, shared with SpeciesTransport
+
 	//Sutherland's constants
 	double TMu0;
 	double SMu0;
@@ -0,0 +1,101 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef GHOSTPOINTCACHE_H_INCLUDED
+#define GHOSTPOINTCACHE_H_INCLUDED
+
+#include <vector>
+
+#include "Includes.h"
+#include "Containers/Storage3D.h"
+
+namespace openphase {
+class PhaseField;
+class FlowSolverLBM;
+class SolidBody;
+
+/* Geometry of the immersed boundary ghost points shared by EnergyTransport
+and SpeciesTransport. Solid ghost points are obstacle cells within two cells
+of the fluid, their values are extrapolated from the point at the distance
+SolidBody::nDist from the boundary inside the fluid. Fluid ghost points are
+the fluid cells within two cells of an obstacle, used by the conjugate heat
+transfer, with the interpolation point inside the solid. Finding the ghost
+points requires a neighbourhood search and the interface normals of every
+cell, Update() therefore keeps the geometry as long as the obstacle map, the
+gas fraction in the ghost cells and nDist are unchanged. Invalidate() forces
+a rebuild, e.g. after moving a body by less than one cell. */
+
+struct GhostPoint                                                               ///< Geometry of one immersed boundary ghost point
+{
+    int i, j, k;                                                                ///< Ghost cell
+    size_t SolidIdx;                                                            ///< Phase field index of the adjacent solid
+    double X;                                                                   ///< Distance of the ghost cell to the boundary
+    double GasFraction;                                                         ///< Gas fraction the geometry was built from
+    int Lo[3];                                                                  ///< Lower corner of the interpolation stencil
+    int Hi[3];                                                                  ///< Upper corner of the interpolation stencil
+    double Weights[8];                                                          ///< Trilinear weights, corner order of SolidBody::TrilinearInterPolation()
+
+    double Interpolate(const Storage3D<double,0>& Field) const                  ///< Field value at the interpolation point
+    {
+        return Weights[0]*Field(Lo[0],Lo[1],Lo[2]) + Weights[1]*Field(Hi[0],Lo[1],Lo[2])
+             + Weights[2]*Field(Lo[0],Hi[1],Lo[2]) + Weights[3]*Field(Hi[0],Hi[1],Lo[2])
+             + Weights[4]*Field(Lo[0],Lo[1],Hi[2]) + Weights[5]*Field(Hi[0],Lo[1],Hi[2])
+             + Weights[6]*Field(Lo[0],Hi[1],Hi[2]) + Weights[7]*Field(Hi[0],Hi[1],Hi[2]);
+    }
+    double Interpolate(const Storage3D<double,1>& Field, const size_t n) const  ///< Component n of the field at the interpolation point
+    {
+        return Weights[0]*Field(Lo[0],Lo[1],Lo[2],{n}) + Weights[1]*Field(Hi[0],Lo[1],Lo[2],{n})
+             + Weights[2]*Field(Lo[0],Hi[1],Lo[2],{n}) + Weights[3]*Field(Hi[0],Hi[1],Lo[2],{n})
+             + Weights[4]*Field(Lo[0],Lo[1],Hi[2],{n}) + Weights[5]*Field(Hi[0],Lo[1],Hi[2],{n})
+             + Weights[6]*Field(Lo[0],Hi[1],Hi[2],{n}) + Weights[7]*Field(Hi[0],Hi[1],Hi[2],{n});
+    }
+};
+
+class GhostPointCache
+{
+ public:
+    bool Update(const PhaseField& Phase, const FlowSolverLBM& FL,
+                const SolidBody& SB);                                           ///< Rebuilds the ghost points if the geometry changed, returns true if rebuilt
+    void Invalidate()                                                           ///< Forces a rebuild at the next Update()
+    {
+        Valid = false;
+    }
+
+    std::vector<GhostPoint> SolidGhosts;                                        ///< Obstacle cells next to the fluid, interpolation points in the fluid
+    std::vector<GhostPoint> FluidGhosts;                                        ///< Fluid cells next to obstacles, interpolation points in the solid
+    size_t Rebuilds = 0;                                                        ///< Number of rebuilds so far
+
+ private:
+    void Build(const PhaseField& Phase, const FlowSolverLBM& FL, const SolidBody& SB);
+    size_t ObstacleHash(const FlowSolverLBM& FL) const;                         ///< Order independent hash of the obstacle map including the boundary cells
+
+    bool   Valid = false;                                                       ///< Ghost points match the last checked geometry
+    size_t Hash  = 0;                                                           ///< Obstacle hash the ghost points were built from
+    double Distance = 0.0;                                                      ///< SolidBody::nDist the ghost points were built with
+    size_t Gasidx = 0;                                                          ///< Phase field index of the gas
+};
+}
+#endif
@@ -87,6 +87,13 @@ class SolidBody
 	void saveSpheresToFile(const std::vector<Sphere>& spheres, const std::string& filename, double dx);
 	vector<Sphere> loadSpheresFromFile(const std::string& filename);
 	vector<Sphere> generateNonOverlappingSpheres(double Nx, double Ny, double Nz, int N, double minRadius, double maxRadius, double dx);
+    vector<array<double,4>> PackRandomBodies(const array<double,3> Box, const size_t N,
+                                             const double minRadius, const double maxRadius,
+                                             const size_t Attempts);            ///< Random sequential packing (x,y,z,r in grid cells) in Box, axes of zero length are inactive
+    void saveCirclesToBinaryFile(const vector<Circle>& circles, const string& filename);///< Binary counterpart of saveCirclesToFile()
+    vector<Circle> loadCirclesFromBinaryFile(const string& filename);           ///< Binary counterpart of loadCirclesFromFile()
+    void saveSpheresToBinaryFile(const vector<Sphere>& spheres, const string& filename);///< Binary counterpart of saveSpheresToFile()
+    vector<Sphere> loadSpheresFromBinaryFile(const string& filename);           ///< Binary counterpart of loadSpheresFromFile()
 
 	// Find 3 nearest neighbors (indices) for point i
 	std::array<int, 3> find_3_nearest(const std::vector<dVector3>& pts, size_t idx, BoundaryConditions& BC);
@@ -134,6 +141,7 @@ class SolidBody
 	double MinRadious;
 	double MaxRadious;
 	double Clearance;
+    size_t MaxAttempts;                                                         ///< Candidate bodies tried by the random packing, 0 selects max(10^4, 100 nParticles)
 
 	vector<Circle>  rand_Circles;
 	vector<Sphere>  rand_Spheres;
@@ -71,12 +71,16 @@ class SpeciesTransport
 	void ReadInput(string InputFile);
 	void Initialize(Settings& locSettings);
 	void CalculateSpeciesHeatCapacitiesAndEnthalpies(EnergyTransport& ET, FlowSolverLBM& FL);
+    void CalculateMixtureHeatCapacityAndThermalConductivity(EnergyTransport& ET,
+                                                            FlowSolverLBM& FL); ///< Mass weighted Cp of the species into ET.Cp_Mixture, K_Mixture from the Prandtl number
 	void UpdateFields(EnergyTransport& ET);
 	void SetBoundaryConditions(EnergyTransport& ET, BoundaryConditions& BC);
 	void SetFreeBCNX(PhaseField& Phase, EnergyTransport& ET);
 	void CalculateAdvection(EnergyTransport& ET, FlowSolverLBM& FL, FlowMixture& FM, double dt);
 	void CalculateDiffusion(PhaseField& Phase, EnergyTransport& ET, FlowSolverLBM& FL, double dt);
 	void CalculateReaction(EnergyTransport& ET, FlowSolverLBM& FL, int nDim, double dt);
+    void CalculateAdvectionDiffusion(EnergyTransport& ET, FlowSolverLBM& FL,
+                                     FlowMixture& FM, double dt);               ///< Fused CalculateAdvection() and CalculateDiffusion(), all species of a cell at once
 
 	void UpdateGhostPoints(PhaseField& Phase, EnergyTransport& ET, FlowSolverLBM& FL, SolidBody& SB);
 	void CalculateGhostPoints(PhaseField& Phase, EnergyTransport& ET, FlowSolverLBM& FL, SolidBody& SB);
@@ -89,7 +93,18 @@ class SpeciesTransport
 	void WriteVTKMassFractions(Settings& locSettings, const int tStep, const int precision = 16);
 	void WriteVTKHHR(Settings& locSettings, const int tStep, const int precision = 16);
  
-	double CalculateMeanMolarMass(const int i, const int j, const int k, string whichtime);
+    enum class TimeLevel {Old, New};                                            ///< Time level of the mass fractions
+    template<TimeLevel Level>
+    double MeanMolarMass(const int i, const int j, const int k) const           ///< Mean molar mass of the mixture in the cell at the given time level
+    {
+        const Storage3D<double,1>& Y = (Level == TimeLevel::Old) ? MassFractionsOld : MassFractions;
+        double MMWi = 0.0;
+        for(size_t n = 0; n < nSpecies; n++)
+        {
+            MMWi += Y(i,j,k,{n}) / MolecularWeight({n});
+        }
+        return 1.0/MMWi;
+    }
 	double MoleFraction( const int i, const int j, const int k, double MMW, size_t kc);
 
     GridParameters Grid;                                                        ///< Simulation grid parameters
@@ -111,12 +126,17 @@ class SpeciesTransport
 	bool AdvectionUpwind; 
 	bool AdvectionCentral;
 	bool AdvectionVanLeer;
-	double CalculatePhiVanLeer(double r);
+    static double CalculatePhiVanLeer(const double r)                           ///< Van Leer flux limiter, branch free to vectorize across species
+    {
+        return (r+std::abs(r))/(1.0+std::abs(r));
+    }
 
 	bool Species;
     Storage3D<double,0> HRR;                                                   ///< Heat release rate of reaction 
     Storage3D<double,1> Cp_Species;    
     Storage3D<double,1> h_Species;    
+    Storage3D<double,0> PropertiesTx;                                           ///< Temperature of the last evaluation of Cp_Species and h_Species
+    double PropertiesTolT;                                                      ///< Species properties are reevaluated only where T changed by more, 0 always reevaluates
 	Storage3D<double,1> MassDiff_Species;      
 	Storage3D<double,1> W_Species;  
 	Storage3D<double,1> MassFractions;  
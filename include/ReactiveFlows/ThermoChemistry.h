@@ -34,6 +34,7 @@
 #include <sstream>
 #include <stdio.h>
 #include <string>
+#include <unordered_map>
 
 #include "Settings.h"
 #include "PhaseField.h"
@@ -59,6 +60,26 @@ namespace openphase {class SpeciesTransport;
 class EnergyTransport;}
 
 namespace openphase {
+
+/* Cantera objects are not thread-safe, the properties and reaction rates are
+therefore evaluated with one set of Cantera objects per OpenMP thread, created
+from ReactionMechanism, PhaseName and TransportName. Optionally the net
+production rates are tabulated: cells whose temperature and mass fractions
+fall into the same bucket of width TableTolT and TableTolY share one
+evaluation of the kinetics, which bounds the tabulation error by the bucket
+width. The tables are kept per thread and are cleared if they exceed
+TableSize entries or the thermodynamic pressure changes. IntegrateReactions()
+advances the chemistry operator-split over a time step in ChemistrySubsteps
+substeps with rates re-evaluated at each substep, replacing
+SpeciesTransport::CalculateReaction() for stiff mechanisms.
+Input (module @ThermoChemistry):
+
+    $ReactionTable      Tabulate the net production rates            false
+    $TableTolT          Temperature bucket width [K]                 1.0
+    $TableTolY          Mass fraction bucket width                   1.0e-4
+    $TableSize          Maximum entries per thread                   100000
+    $ChemistrySubsteps  Substeps of IntegrateReactions()             1      */
+
 class ThermoChemistry 
 {
     public:
@@ -74,6 +95,8 @@ class ThermoChemistry
 				shared_ptr<Cantera::ThermoPhase> &gas, shared_ptr<Cantera::Transport> &transp, shared_ptr<Cantera::Kinetics> &kin) ;
     void UpdateAllProperties(EnergyTransport& ET, SpeciesTransport& EST, FlowSolverLBM& FL,
 				shared_ptr<Cantera::ThermoPhase> &gas, shared_ptr<Cantera::Transport> &transp, shared_ptr<Cantera::Kinetics> &kin) ;
+    void IntegrateReactions(EnergyTransport& ET, SpeciesTransport& ST, FlowSolverLBM& FL,
+                            int nDim, double dt);                               ///< Advances temperature and mass fractions by the reactions over dt in ChemistrySubsteps substeps
     vector<double> GettingFuelMixture(std::shared_ptr<Cantera::ThermoPhase> & gas, string FuelName, string Oxidizer, double ER);
     vector<double> GettingAirMixture();
     vector<double> GettingBackFlowMixture();
@@ -108,6 +131,34 @@ class ThermoChemistry
     int nPhases;
 
     size_t FuelIndex;
+
+    bool   ReactionTable;                                                       ///< Tabulate the net production rates
+    double TableTolT;                                                           ///< Temperature bucket width of the reaction table
+    double TableTolY;                                                           ///< Mass fraction bucket width of the reaction table
+    size_t TableSize;                                                           ///< Maximum number of reaction table entries per thread
+    int    ChemistrySubsteps;                                                   ///< Number of substeps of IntegrateReactions()
+
+    protected:
+    struct ReactionTableEntry                                                   ///< Tabulated net production rates of one bucket
+    {
+        vector<long> Bucket;                                                    ///< Bucket indices of temperature and mass fractions
+        vector<double> Rates;                                                   ///< Net production rates [kg/m^3/s]
+    };
+    struct ChemistryWorkspace                                                   ///< Cantera objects and reaction table of one thread
+    {
+        shared_ptr<Cantera::Solution>    Solution;
+        shared_ptr<Cantera::ThermoPhase> Gas;
+        shared_ptr<Cantera::Transport>   Transport;
+        shared_ptr<Cantera::Kinetics>    Kinetics;
+        unordered_map<size_t, ReactionTableEntry> Table;                        ///< Reaction table keyed by the hash of the bucket indices
+        vector<long> Bucket;                                                    ///< Bucket indices of the current state
+    };
+    void PrepareWorkspaces(const double Pressure);                              ///< Creates the per thread Cantera objects, clears the tables if the pressure changed
+    void NetProductionRates(ChemistryWorkspace& WS, const double Temp,
+                            const double* Y, double* W) const;                  ///< Net production rates [kg/m^3/s] at the state set in WS.Gas, tabulated if enabled
+
+    vector<ChemistryWorkspace> Workspaces;                                      ///< One set of Cantera objects per OpenMP thread
+    double TablePressure = -1.0;                                                ///< Pressure the reaction tables were built at
 };
 }
 #endif
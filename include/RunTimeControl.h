@@ -28,6 +28,9 @@
 #define RUNTIMECONTROL_H
 
 #include "Includes.h"
+#include "Tools/MemoryMonitor.h"
+#include "Tools/StatusMonitor.h"
+#include "Embedded.h"
 //#include "Macros.h"
 //#include "Definitions.h"
 
@@ -38,6 +41,7 @@
 namespace openphase
 {
 class Settings;
+class BoundaryConditions;
 
 class OP_EXPORTS RunTimeControl                                                 ///< Run time control module.
 {
@@ -76,11 +80,30 @@ class OP_EXPORTS RunTimeControl
     int LogScreenFactor;                                                        ///< Outputs to screen per decade = 10 x LogScreenFactor
     int LogVTKFactor;                                                           ///< Outputs to VTK    per decade = 10 x LogVTKFactor
 
+    bool AdaptiveTimeStep = false;                                              ///< If true, dt is adjusted in IncrementTimeStep() from the reported time step limits
+    double dtMin;                                                               ///< Lower bound of the adaptive time step
+    double dtMax;                                                               ///< Upper bound of the adaptive time step
+    double dtSafetyFactor;                                                      ///< Fraction of the smallest reported time step limit used as the new time step
+    double dtGrowthFactor;                                                      ///< Maximum relative increase of the time step per time step
+    double dtLimit = DBL_MAX;                                                   ///< Smallest time step limit reported since the last time step update
+    std::string dtLimitSource;                                                  ///< Name of the module which reported dtLimit
+
+    struct SubcycledModule                                                      ///< Time stepping state of a subcycled module
+    {
+        double dtStable = DBL_MAX;                                              ///< Stable time step declared by the module
+        int Substeps = 1;                                                       ///< Substeps per global time step
+    };
+    std::map<std::string, SubcycledModule> SubcycledModules;                    ///< Subcycled modules by name
+    int MaxSubsteps;                                                            ///< Maximum number of substeps per global time step
+
     std::string SimulationTitle;                                                ///< Simulation title string
     std::string VTKDir;                                                         ///< Directory name for the VTK files
     std::string RawDataDir;                                                     ///< Directory name for the raw data files
     std::string TextDir;                                                        ///< Directory name for the text files
 
+    MemoryMonitor Memory;                                                       ///< Periodic memory sampling ($MemoryInterval, $MemoryWarning), written to TextDir/MemoryUsage.dat
+    StatusMonitor Status;                                                       ///< Machine readable progress ($StatusInterval, $StatusWindow, $StatusCommand), written to TextDir/Status.json
+
     RunTimeControl(){};                                                         ///< Default constructor
     RunTimeControl(Settings& locSettings,
                    const std::string InputFileName = DefaultInputFileName)      ///< Constructor
@@ -94,6 +117,20 @@ class OP_EXPORTS RunTimeControl
     void ReadJSON(const std::string InputFileName);                                       ///< Reads run time control parameters
     void Write();                                                               ///< Write tStep to file
     bool RestartPossible();                                                     ///< Reads tStep from file returns true if successful
+
+    /* Restart fast path: on restart all objects registered for reading are
+    restored from the checkpoint of time step tStart (the unified checkpoint
+    if present, see Settings::ReadAll()) and the caller skips building the
+    initial microstructure. Derived data, e.g. the grains elastic properties,
+    is recomputed lazily from the restored state. Usage:
+
+        if(not RTC.RestoreCheckpoint(OPSettings, BC))
+        {
+            // build the initial microstructure
+        }
+    */
+    bool RestoreCheckpoint(Settings& locSettings,
+                           const BoundaryConditions& BC);                       ///< Restores all readable objects on restart, returns false if the initial state has to be built
     bool WriteToScreen()                                                        ///< Returns true at regular console output intervals
     {
         if (LogModeScreen)
@@ -122,12 +159,14 @@ class OP_EXPORTS RunTimeControl
         }
         return (!(TimeStep%VTKOutputInterval) or StopTrigger);
     }
-    bool WriteRawData()                                                         ///< Returns true at regular raw data files writing intervals
+    bool WriteRawData()                                                         ///< Returns true at regular raw data files writing intervals (never in embedded mode)
     {
+        if (Embedded::Active()) return false;
         return (!(TimeStep%CheckpointInterval) or StopTrigger);
     }
     void IncrementTimeStep()                                                    ///< Increments simultaneously the time step and simulation time
     {
+        if (Memory.Due(TimeStep)) Memory.Sample(TimeStep, MaxTimeStep);
         #ifdef MPI_PARALLEL
         if (MPI_RANK == 0)
         {
@@ -143,11 +182,67 @@ class OP_EXPORTS RunTimeControl
         #endif
         SimulationTime += dt;
         TimeStep++;
+        if (AdaptiveTimeStep) AdaptTimeStep();
+        if (Status.Due(TimeStep)) Status.Update(TimeStep, MaxTimeStep, SimulationTime, dt, StopTrigger);
     }
     void SetNewTimeStep(double new_dt)                                          ///< Sets new time step
     {
         dt = new_dt;
     }
+    void SetTimeStepLimit(const double max_dt, const std::string Source = "")   ///< Reports the maximum stable time step of a module for the current time step
+    {
+        if (max_dt < dtLimit)
+        {
+            dtLimit = max_dt;
+            dtLimitSource = Source;
+        }
+    }
+    double AdaptTimeStep(void);                                                 ///< Sets dt from the reported time step limits within [dtMin, dtMax], returns the new dt
+
+    /* Multi-rate time stepping: a module whose stable time step is smaller
+    than dt (e.g. a diffusion solver next to the phase field) declares it with
+    SetModuleTimeStep() and is advanced by Subcycle() in equal substeps of the
+    global time step, instead of limiting dt for all modules. The step
+    function gets the substep and the fraction of the global step at the start
+    of the substep, with which coupling fields that change over the global
+    step can be interpolated (InterpolateCoupling()). Example:
+
+        RTC.SetModuleTimeStep("Diffusion", DF.ReportMaximumTimeStep(Tx));
+        RTC.Subcycle("Diffusion", [&](double sub_dt, double theta)
+        {
+            RTC.InterpolateCoupling(TxSub, TxOld, Tx.Tx, theta);
+            DF.SolveDiffusion(Phase, Cx, Tx, BC, sub_dt);
+        });
+
+    At most $MaxSubsteps substeps are done, a module which needs more reports
+    its limit through SetTimeStepLimit(), which reduces an adaptive dt. */
+    int SetModuleTimeStep(const std::string Module, const double dtStable);     ///< Declares the stable time step of a module (collective), returns its number of substeps
+    int Substeps(const std::string Module) const                                ///< Number of substeps of a module per global time step
+    {
+        auto it = SubcycledModules.find(Module);
+        return (it != SubcycledModules.end()) ? it->second.Substeps : 1;
+    }
+    template<class StepFunction>
+    void Subcycle(const std::string Module, StepFunction&& Step) const          ///< Calls Step(sub_dt, theta) for each substep of the module in the current time step
+    {
+        const int n = Substeps(Module);
+        for (int s = 0; s < n; s++)
+        {
+            Step(dt/n, double(s)/n);
+        }
+    }
+    template<class T, size_t Rank>
+    static void InterpolateCoupling(Storage3D<T,Rank>& Field,
+                                    const Storage3D<T,Rank>& Start,
+                                    const Storage3D<T,Rank>& End,
+                                    const double theta)                         ///< Field = (1 - theta)*Start + theta*End including the boundary cells
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Field,Field.Bcells(),)
+        {
+            Field(i,j,k) = Start(i,j,k)*(1.0 - theta) + End(i,j,k)*theta;
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
     bool CheckStop()
     {
         double time = mygettime();
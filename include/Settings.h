@@ -29,6 +29,7 @@
 
 #include "Includes.h"
 #include "BoundaryConditions.h"
+#include "OutputRegion.h"
 #ifndef WIN32
 #include "MetaData.h"
 #endif
@@ -74,6 +75,7 @@ class OP_EXPORTS Settings
     void AddForRemeshing(OPObject& obj);                                        ///< Adds object to be remeshed to the ObjectsToRemesh
     void RemeshAll(int newNx, int newNy, int newNz, int tStep,
                    const BoundaryConditions& BC);                               ///< Calls Remesh() on all objects in ObjectsToRemesh
+    void RepartitionAll(const BoundaryConditions& BC);                          ///< Calls Repartition() on all objects in ObjectsToRemesh after the MPI cut planes have changed
     void AddForAdvection(OPObject& obj);                                        ///< Adds object to be advected to the ObjectsToAdvect
     void AdvectAll(AdvectionHR& Adv, const Velocities& Vel, PhaseField& Phi,
                    const BoundaryConditions& BC, double dt, int tStep);         ///< Calls Advect() on all objects in ObjectsToAdvect
@@ -81,11 +83,16 @@ class OP_EXPORTS Settings
                 PhaseField& Phi, const BoundaryConditions& BC,
                 double dt, int tStep);                                          ///< Calls Advect() on object(s) with the given name base
     void AddForReading(OPObject& obj);                                          ///< Adds object which can read raw data to the ObjectsToRead
-    bool ReadAll(const BoundaryConditions& BC, const int tStep);                ///< Calls Read() on all objects in ObjectsToRead
+    bool WriteAll(const int tStep) const;                                       ///< Writes the MPI cut planes and all objects in ObjectsToRead into a unified checkpoint
+    bool ReadAll(const BoundaryConditions& BC, const int tStep);                ///< Reapplies stored MPI cut planes, then restores the unified checkpoint if present or calls Read() on all objects in ObjectsToRead
+    void WriteCutPlanes(const int tStep) const;                                 ///< Writes non-uniform MPI cut planes (see LoadBalancer.h) to RawDataDir
+    void ReadCutPlanes(const BoundaryConditions& BC, const int tStep);          ///< Reads MPI cut planes from InputRawDataDir and repartitions all objects if they differ from the current ones
     bool Read(std::string ObjectName, const BoundaryConditions& BC,
               const int tStep);                                                 ///< Calls Read() on object(s) with the given name base
 
     GridParameters GridHistoryParameters(int time_step) const;                  ///< Returns grid parameters for a given time step based on grid history records
+    void PrintMemoryReport(void) const;                                         ///< Prints the memory held by each existing OPObject (minimum and maximum over MPI ranks)
+    void PrintAffinityReport(void) const;                                       ///< Prints the CPUs and NUMA nodes of the OpenMP threads of each MPI rank
 
     std::vector<OPObject*> ObjectsToRemesh;                                     ///< Stores pointers to objects which have remeshing capability
     std::vector<OPObject*> ObjectsToAdvect;                                     ///< Stores pointers to objects which have advection capability
@@ -105,6 +112,19 @@ class OP_EXPORTS Settings
     std::string TextDir;                                                        ///< Directory name for the text files
     int HDF5Freq = 1;                                                            ///< Frequency (in time steps) for HDF5 writes
     bool WriteDrivingForceH5 = true;                                             ///< If true, DrivingForce::WriteH5 will write driving force fields to HDF5
+    int DeltaCheckpoints = 0;                                                   ///< Number of incremental raw data checkpoints between full ones, 0 writes full checkpoints only
+    int DeltaBlockSize = 16;                                                    ///< Edge length in cells of the blocks of the incremental checkpoints
+    int TimeSeriesFlushEntries = 64;                                            ///< Number of pending lines per time series file before they are written, see TimeSeriesOutput.h
+    double TimeSeriesFlushInterval = 10.0;                                      ///< Time in seconds after which the pending time series lines are written
+    bool AggregateWarnings = false;                                             ///< Print warnings as per step summaries of all threads and MPI ranks, see ConsoleOutput.h
+    int WarningRateLimit = 10;                                                  ///< Immediate prints of identical warnings per thread between two time step outputs, 0 disables the limit
+    double CheckpointTolerance = 0.0;                                           ///< Error bound of the lossy compressed raw data of floating point fields relative to their value range, 0 writes uncompressed raw data, see Tools/LossyCompression.h
+    std::vector<OutputRegion> OutputRegions;                                    ///< Regions written by the visualization output instead of the whole domain, see OutputRegion.h
+#ifdef NUMA_FIRST_TOUCH
+    bool AffinityReport = true;                                                 ///< Print the thread affinity report after reading the input
+#else
+    bool AffinityReport = false;                                                ///< Print the thread affinity report after reading the input
+#endif
 
     Settings& operator= (const Settings& rhs);                                  ///< Assignment operator
 #ifndef WIN32
@@ -57,6 +57,13 @@ class OP_EXPORTS SymmetryVariants : OPObject
 
         return TransformationMatrices[PhaseIndex][VariantIndex];
     }
+    const dMatrix6x6& VoigtRotation(size_t PhaseIndex, size_t VariantIndex) const ///< Voigt rotation operator of a variant, see dMatrix6x6::RotationOperator()
+    {
+        assert(PhaseIndex < VoigtRotations.size() && "Access beyond storage range");
+        assert(VariantIndex < VoigtRotations[PhaseIndex].size() && "Access beyond storage range");
+
+        return VoigtRotations[PhaseIndex][VariantIndex];
+    }
     size_t Nvariants(const size_t PhaseIndex) const                             ///< Returns number of symmetry variants of a given phase
     {
         assert(PhaseIndex < TransformationMatrices.size() && "Access beyond storage range");
@@ -67,6 +74,7 @@ class OP_EXPORTS SymmetryVariants : OPObject
     bool set;                                                                   ///< Indicates if symmetry variants were set
  protected:
      std::vector< std::vector < dMatrix3x3 > > TransformationMatrices;          ///< Transformation matrices storage
+     std::vector< std::vector < dMatrix6x6 > > VoigtRotations;                  ///< Voigt rotation operators of the transformation matrices, set by ReadInput()
  private:
 };
 } // namespace openphase
@@ -154,11 +154,11 @@ class Temperature1Dextension
     {
         DataTMP = Data;
     }
-    void read(std::ifstream& out)
+    void read(std::istream& out)
     {
         out.read(reinterpret_cast<char*>(Data.data()),Data.total_size()*sizeof(double));
     }
-    void write(std::ofstream& out) const
+    void write(std::ostream& out) const
     {
         out.write(reinterpret_cast<const char*>(Data.data()),Data.total_size()*sizeof(double));
     }
@@ -173,6 +173,23 @@ class Temperature1Dextension
 
 };
 
+/* Shared cache of the properties derived from the temperature and the local
+phase composition (e.g. temperature dependent interface mobilities). Once per
+time step the application calls Temperature::TrackChanges(), which advances
+the revision of every cell whose temperature moved by more than
+PropertyCacheTolerance (input $PropertyCacheTolerance, default 0.0) from the
+value of its last revision or whose set of phase fields changed. A module
+subscribes with its own TemperatureSubscription and recomputes its derived
+properties only in the cells for which Outdated() returns true. Without
+TrackChanges() calls Subscribe() returns false and the modules recompute all
+cells as before. */
+
+struct TemperatureSubscription                                                  ///< State of a module using the derived property cache of Temperature
+{
+    Storage3D<unsigned int, 0> Seen;                                            ///< Revision of each cell at the last evaluation of the module's properties
+    size_t Epoch = 0;                                                           ///< Cache epoch the revisions belong to
+};
+
 class OP_EXPORTS Temperature : public OPObject                                  ///< Storage for the temperature
 {
  public:
@@ -183,6 +200,8 @@ class OP_EXPORTS Temperature : public OPObject
     void ReadInput(std::stringstream& inp) override;                            ///< Reads input parameters from the input stream.
     void Remesh(const int newNx, const int newNy, const int newNz,
                                         const BoundaryConditions& BC) override; ///< Changes system size while keeping the data
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
     void MoveFrame(const int dx, const int dy, const int dz,
                    const BoundaryConditions& BC) override;                      ///< Shifts the data in the storage by dx, dy and dz (they should be 0, -1 or +1) in x, y or z direction correspondigly.
     void ConsumePlane(const int dx, const int dy, const int dz,
@@ -195,6 +214,11 @@ class OP_EXPORTS Temperature : public OPObject
     bool Read(const Settings& locSettings,
               const BoundaryConditions& BC, const int tStep = -1) override;     ///< Reads the raw temperature from a file
     bool ReadH5(H5Interface& H5, const int tStep);
+    void WriteCheckpoint(std::ostream& out) const override;                     ///< Writes the raw temperature into a unified checkpoint
+    bool ReadCheckpoint(std::istream& inp) override;                            ///< Reads the raw temperature from a unified checkpoint
+    void WriteRawTemperature(std::ostream& out) const;                          ///< Writes Tx, error bounded compressed if CheckpointTolerance > 0
+    bool ReadRawTemperature(std::istream& inp);                                 ///< Reads Tx written by WriteRawTemperature()
+    void FinalizeRead(const BoundaryConditions& BC) override;                   ///< Updates temperature statistics and boundary conditions after reading
     void WriteVTK(Settings& locSettings, const int tStep) const;                ///< Writes temperature in the VTK format into a file
     void WriteGradientVTK(Settings& locSettings, const int tStep) const;        ///< Writes temperature gradient in the VTK format into a file
 
@@ -212,6 +236,16 @@ class OP_EXPORTS Temperature : public OPObject
 
     void SetInitial(const BoundaryConditions& BC);                              ///< Sets initial temperature according to the starting temperature and temperature gradient
 
+    void TrackChanges(const PhaseField& Phase);                                 ///< Advances the cache revision of the cells whose temperature or set of phase fields changed
+    bool Subscribe(TemperatureSubscription& Sub, const long int Bcells) const;  ///< Prepares Sub for Outdated() queries, false if the changes are not tracked for Bcells boundary cells
+    bool Outdated(const int i, const int j, const int k,
+                  TemperatureSubscription& Sub) const                           ///< True if the cell changed since the last query of Sub, marks it as seen
+    {
+        if(Sub.Seen(i,j,k) == CacheRevision(i,j,k)) return false;
+        Sub.Seen(i,j,k) = CacheRevision(i,j,k);
+        return true;
+    }
+
     double& operator()(const int x, const int y, const int z)                   ///< Bidirectional access operator
     {
         return Tx(x, y, z);
@@ -242,6 +276,7 @@ class OP_EXPORTS Temperature : public OPObject
     dVector3 r0;                                                                ///< Initial position with T0 temperature (temperature gradient will be applied with respect to this position)
 
     GridParameters Grid;                                                        ///< Simulation grid parameters
+    double CheckpointTolerance = 0.0;                                           ///< Relative error bound of the compressed raw data, see Settings::CheckpointTolerance
 
     size_t Nphases;                                                             ///< Number of thermodynamic phases
 
@@ -261,6 +296,8 @@ class OP_EXPORTS Temperature : public OPObject
     Storage<double> HeatCapacity;                                               ///< Volumetric heat capacity for all phases
     Tensor<double, 2> LatentHeat;                                               ///< Latent heat values for each phase pair
 
+    double PropertyCacheTolerance;                                              ///< Temperature change which invalidates the cached derived properties of a cell
+
     bool ExtensionsActive;
     Temperature1Dextension ExtensionX0;                                         ///< 1D temperature field extension at the lower X boundary
     Temperature1Dextension ExtensionXN;                                         ///< 1D temperature field extension at the upper X boundary
@@ -274,6 +311,13 @@ class OP_EXPORTS Temperature : public OPObject
     bool ReadFromFile;                                                          ///< True if temperature should be read from the input file
     std::vector<std::pair<double,double> > TemperatureProfile;                  ///< Temperature entries from the input file
 
+    Storage3D<double, 0> CacheTx;                                               ///< Temperature at the last cache revision of each cell
+    Storage3D<size_t, 0> CachePhaseSet;                                         ///< Signature of the set of phase fields at the last cache revision of each cell
+    Storage3D<unsigned int, 0> CacheRevision;                                   ///< Cache revision of each cell
+    size_t CacheEpoch;                                                          ///< Incremented whenever the revisions are reset
+    bool   CacheValid;                                                          ///< False until the first TrackChanges() call after a reset
+    void   ResetCache(void);                                                    ///< Discards the cache revisions, e.g. after a change of the local domain
+
     void SetInitial1Dextension(Temperature1Dextension& TxExt);                  ///< Sets initial temperature values in 1D extension
     double CalculateLatentHeatEffect(const PhaseField& Phase, const double dt); ///< Calculates temperature change due to release of latent heat
 
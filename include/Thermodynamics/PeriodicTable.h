@@ -28,10 +28,20 @@
 #define PERIODICTABLE_H
 
 #include "Includes.h"
+#include <string_view>
 
 namespace openphase
 {
 
+/* The element data is a constexpr table ordered by atomic number. Symbols
+have one or two letters, Key() maps them case-insensitively to a direct
+address in a 27x27 table (a perfect hash), which is built at compile time.
+Lookups with a literal symbol are resolved by the compiler, e.g.
+static_assert(PeriodicTable::AtomicWeight("Fe") > 55.0). Run time lookups
+cost two character conversions and one table access. Per cell code should
+nevertheless use per component arrays filled once during the setup (see
+Composition::MolecularWeight). */
+
 class PeriodicTable                                                             ///< Stores the properties of all chemical elements in the periodic table
 {
  public:
@@ -43,973 +53,169 @@ class PeriodicTable
         double AtomicWeight;
         double MolarVolume;
     };
-
-    PeriodicTable(void){};
-    void Initialize(void)
+    struct ElementData                                                          ///< Compile time entry of the element table
     {
-        Element temp;
-
-        temp.Name = "H";
-        temp.FullName = "Hydrogen";
-        temp.AtomicNumber = 1;
-        temp.AtomicWeight = 1.008;
-        temp.MolarVolume  = 11.42E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "HE";
-        temp.FullName = "Helium";
-        temp.AtomicNumber = 2;
-        temp.AtomicWeight = 4.003;
-        temp.MolarVolume  = 21.00E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "LI";
-        temp.FullName = "Lithium";
-        temp.AtomicNumber = 3;
-        temp.AtomicWeight = 6.940;
-        temp.MolarVolume  = 13.02E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "BE";
-        temp.FullName = "Beryllium";
-        temp.AtomicNumber = 4;
-        temp.AtomicWeight = 9.012;
-        temp.MolarVolume  = 4.85E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "B";
-        temp.FullName = "Boron";
-        temp.AtomicNumber = 5;
-        temp.AtomicWeight = 10.810;
-        temp.MolarVolume  = 4.39E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "C";
-        temp.FullName = "Carbon";
-        temp.AtomicNumber = 6;
-        temp.AtomicWeight = 12.011;
-        temp.MolarVolume  = 5.31E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "N";
-        temp.FullName = "Nitrogen";
-        temp.AtomicNumber = 7;
-        temp.AtomicWeight = 14.007;
-        temp.MolarVolume  = 13.54E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "O";
-        temp.FullName = "Oxygen";
-        temp.AtomicNumber = 8;
-        temp.AtomicWeight = 15.999;
-        temp.MolarVolume  = 17.36E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "F";
-        temp.FullName = "Fluorine";
-        temp.AtomicNumber = 9;
-        temp.AtomicWeight = 18.998;
-        temp.MolarVolume  = 11.20E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "NE";
-        temp.FullName = "Neon";
-        temp.AtomicNumber = 10;
-        temp.AtomicWeight = 20.180;
-        temp.MolarVolume  = 13.23E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "NA";
-        temp.FullName = "Sodium";
-        temp.AtomicNumber = 11;
-        temp.AtomicWeight = 22.990;
-        temp.MolarVolume  = 23.78E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "MG";
-        temp.FullName = "Magnesium";
-        temp.AtomicNumber = 12;
-        temp.AtomicWeight = 24.305;
-        temp.MolarVolume  = 14.00E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "AL";
-        temp.FullName = "Aluminium";
-        temp.AtomicNumber = 13;
-        temp.AtomicWeight = 26.982;
-        temp.MolarVolume  = 10.00E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "SI";
-        temp.FullName = "Silicon";
-        temp.AtomicNumber = 14;
-        temp.AtomicWeight = 28.085;
-        temp.MolarVolume  = 12.06E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "P";
-        temp.FullName = "Phosphorus";
-        temp.AtomicNumber = 15;
-        temp.AtomicWeight = 30.974;
-        temp.MolarVolume  = 17.02E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "S";
-        temp.FullName = "Sulfur";
-        temp.AtomicNumber = 16;
-        temp.AtomicWeight = 32.060;
-        temp.MolarVolume  = 15.53E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CL";
-        temp.FullName = "Chlorine";
-        temp.AtomicNumber = 17;
-        temp.AtomicWeight = 35.450;
-        temp.MolarVolume  = 17.39E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "AR";
-        temp.FullName = "Argon";
-        temp.AtomicNumber = 18;
-        temp.AtomicWeight = 39.948;
-        temp.MolarVolume  = 22.56E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "K";
-        temp.FullName = "Potassium";
-        temp.AtomicNumber = 19;
-        temp.AtomicWeight = 39.098;
-        temp.MolarVolume  = 45.94E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CA";
-        temp.FullName = "Calcium";
-        temp.AtomicNumber = 20;
-        temp.AtomicWeight = 40.078;
-        temp.MolarVolume  = 26.20E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "SC";
-        temp.FullName = "Scandium";
-        temp.AtomicNumber = 21;
-        temp.AtomicWeight = 44.956;
-        temp.MolarVolume  = 15.00E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "TI";
-        temp.FullName = "Titanium";
-        temp.AtomicNumber = 22;
-        temp.AtomicWeight = 47.867;
-        temp.MolarVolume  = 10.64E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "V";
-        temp.FullName = "Vanadium";
-        temp.AtomicNumber = 23;
-        temp.AtomicWeight = 50.942;
-        temp.MolarVolume  = 8.32E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CR";
-        temp.FullName = "Chromium";
-        temp.AtomicNumber = 24;
-        temp.AtomicWeight = 51.996;
-        temp.MolarVolume  = 7.23E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "MN";
-        temp.FullName = "Manganese";
-        temp.AtomicNumber = 25;
-        temp.AtomicWeight = 54.938;
-        temp.MolarVolume  = 7.35E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "FE";
-        temp.FullName = "Iron";
-        temp.AtomicNumber = 26;
-        temp.AtomicWeight = 55.845;
-        temp.MolarVolume  = 7.09E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CO";
-        temp.FullName = "Cobalt";
-        temp.AtomicNumber = 27;
-        temp.AtomicWeight = 58.933;
-        temp.MolarVolume  = 6.67E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "NI";
-        temp.FullName = "Nickel";
-        temp.AtomicNumber = 28;
-        temp.AtomicWeight = 58.693;
-        temp.MolarVolume  = 6.59E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CU";
-        temp.FullName = "Copper";
-        temp.AtomicNumber = 29;
-        temp.AtomicWeight = 63.546;
-        temp.MolarVolume  = 7.11E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "ZN";
-        temp.FullName = "Zinc";
-        temp.AtomicNumber = 30;
-        temp.AtomicWeight = 65.380;
-        temp.MolarVolume  = 9.16E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "GA";
-        temp.FullName = "Gallium";
-        temp.AtomicNumber = 31;
-        temp.AtomicWeight = 69.723;
-        temp.MolarVolume  = 11.80E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "GE";
-        temp.FullName = "Germanium";
-        temp.AtomicNumber = 32;
-        temp.AtomicWeight = 72.630;
-        temp.MolarVolume  = 13.63E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "AS";
-        temp.FullName = "Arsenic";
-        temp.AtomicNumber = 33;
-        temp.AtomicWeight = 74.922;
-        temp.MolarVolume  = 12.95E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "SE";
-        temp.FullName = "Selenium";
-        temp.AtomicNumber = 34;
-        temp.AtomicWeight = 78.971;
-        temp.MolarVolume  = 16.42E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "BR";
-        temp.FullName = "Bromine";
-        temp.AtomicNumber = 35;
-        temp.AtomicWeight = 79.904;
-        temp.MolarVolume  = 19.78E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "KR";
-        temp.FullName = "Krypton";
-        temp.AtomicNumber = 36;
-        temp.AtomicWeight = 83.798;
-        temp.MolarVolume  = 27.99E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "RB";
-        temp.FullName = "Rubidium";
-        temp.AtomicNumber = 37;
-        temp.AtomicWeight = 85.468;
-        temp.MolarVolume  = 55.76E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "SR";
-        temp.FullName = "Strontium";
-        temp.AtomicNumber = 38;
-        temp.AtomicWeight = 87.620;
-        temp.MolarVolume  = 33.94E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "Y";
-        temp.FullName = "Yttrium";
-        temp.AtomicNumber = 39;
-        temp.AtomicWeight = 88.906;
-        temp.MolarVolume  = 19.88E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "ZR";
-        temp.FullName = "Zirconium";
-        temp.AtomicNumber = 40;
-        temp.AtomicWeight = 91.224;
-        temp.MolarVolume  = 14.02E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "NB";
-        temp.FullName = "Niobium";
-        temp.AtomicNumber = 41;
-        temp.AtomicWeight = 92.906;
-        temp.MolarVolume  = 10.83E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "MO";
-        temp.FullName = "Molybdenum";
-        temp.AtomicNumber = 42;
-        temp.AtomicWeight = 95.951;
-        temp.MolarVolume  = 9.38E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "TC";
-        temp.FullName = "Technetium";
-        temp.AtomicNumber = 43;
-        temp.AtomicWeight = 98.906;
-        temp.MolarVolume  = 8.63E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "RU";
-        temp.FullName = "Ruthenium";
-        temp.AtomicNumber = 44;
-        temp.AtomicWeight = 101.072;
-        temp.MolarVolume  = 8.17E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "RH";
-        temp.FullName = "Rhodium";
-        temp.AtomicNumber = 45;
-        temp.AtomicWeight = 102.906;
-        temp.MolarVolume  = 8.28E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "PD";
-        temp.FullName = "Palladium";
-        temp.AtomicNumber = 46;
-        temp.AtomicWeight = 106.421;
-        temp.MolarVolume  = 8.56E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "AG";
-        temp.FullName = "Silver";
-        temp.AtomicNumber = 47;
-        temp.AtomicWeight = 107.868;
-        temp.MolarVolume  = 10.27E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CD";
-        temp.FullName = "Cadmium";
-        temp.AtomicNumber = 48;
-        temp.AtomicWeight = 112.414;
-        temp.MolarVolume  = 13.00E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "IN";
-        temp.FullName = "Indium";
-        temp.AtomicNumber = 49;
-        temp.AtomicWeight = 114.818;
-        temp.MolarVolume  = 15.76E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "SN";
-        temp.FullName = "Tin";
-        temp.AtomicNumber = 50;
-        temp.AtomicWeight = 118.710;
-        temp.MolarVolume  = 16.29E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "SB";
-        temp.FullName = "Antimony";
-        temp.AtomicNumber = 51;
-        temp.AtomicWeight = 121.760;
-        temp.MolarVolume  = 18.19E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "TE";
-        temp.FullName = "Tellurium";
-        temp.AtomicNumber = 52;
-        temp.AtomicWeight = 127.603;
-        temp.MolarVolume  = 20.46E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "I";
-        temp.FullName = "Iodine";
-        temp.AtomicNumber = 53;
-        temp.AtomicWeight = 126.904;
-        temp.MolarVolume  = 25.72E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "XE";
-        temp.FullName = "Xenon";
-        temp.AtomicNumber = 54;
-        temp.AtomicWeight = 131.293;
-        temp.MolarVolume  = 35.92E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CS";
-        temp.FullName = "Caesium";
-        temp.AtomicNumber = 55;
-        temp.AtomicWeight = 132.905;
-        temp.MolarVolume  = 70.94E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "BA";
-        temp.FullName = "Barium";
-        temp.AtomicNumber = 56;
-        temp.AtomicWeight = 137.327;
-        temp.MolarVolume  = 38.16E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "LA";
-        temp.FullName = "Lanthanum";
-        temp.AtomicNumber = 57;
-        temp.AtomicWeight = 138.905;
-        temp.MolarVolume  = 22.39E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CE";
-        temp.FullName = "Cerium";
-        temp.AtomicNumber = 58;
-        temp.AtomicWeight = 140.116;
-        temp.MolarVolume  = 20.69E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "PR";
-        temp.FullName = "Praseodymium";
-        temp.AtomicNumber = 59;
-        temp.AtomicWeight = 140.908;
-        temp.MolarVolume  = 20.80E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "ND";
-        temp.FullName = "Neodymium";
-        temp.AtomicNumber = 60;
-        temp.AtomicWeight = 144.242;
-        temp.MolarVolume  = 20.59E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "PM";
-        temp.FullName = "Promethium";
-        temp.AtomicNumber = 61;
-        temp.AtomicWeight = 146.915;
-        temp.MolarVolume  = 20.10E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "SM";
-        temp.FullName = "Samarium";
-        temp.AtomicNumber = 62;
-        temp.AtomicWeight = 150.362;
-        temp.MolarVolume  = 19.98E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "EU";
-        temp.FullName = "Europium";
-        temp.AtomicNumber = 63;
-        temp.AtomicWeight = 151.964;
-        temp.MolarVolume  = 28.97E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "GD";
-        temp.FullName = "Gadolinium";
-        temp.AtomicNumber = 64;
-        temp.AtomicWeight = 157.253;
-        temp.MolarVolume  = 19.90E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "TB";
-        temp.FullName = "Terbium";
-        temp.AtomicNumber = 65;
-        temp.AtomicWeight = 158.925;
-        temp.MolarVolume  = 19.30E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "DY";
-        temp.FullName = "Dysprosium";
-        temp.AtomicNumber = 66;
-        temp.AtomicWeight = 162.500;
-        temp.MolarVolume  = 19.01E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "HO";
-        temp.FullName = "Holmium";
-        temp.AtomicNumber = 67;
-        temp.AtomicWeight = 164.930;
-        temp.MolarVolume  = 18.74E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "ER";
-        temp.FullName = "Erbium";
-        temp.AtomicNumber = 68;
-        temp.AtomicWeight = 167.259;
-        temp.MolarVolume  = 18.46E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "TM";
-        temp.FullName = "Thulium";
-        temp.AtomicNumber = 69;
-        temp.AtomicWeight = 168.934;
-        temp.MolarVolume  = 19.10E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "YB";
-        temp.FullName = "Ytterbium";
-        temp.AtomicNumber = 70;
-        temp.AtomicWeight = 173.045;
-        temp.MolarVolume  = 24.84E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "LU";
-        temp.FullName = "Lutetium";
-        temp.AtomicNumber = 71;
-        temp.AtomicWeight = 174.967;
-        temp.MolarVolume  = 17.78E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "HF";
-        temp.FullName = "Hafnium";
-        temp.AtomicNumber = 72;
-        temp.AtomicWeight = 178.492;
-        temp.MolarVolume  = 13.44E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "TA";
-        temp.FullName = "Tantalum";
-        temp.AtomicNumber = 73;
-        temp.AtomicWeight = 180.948;
-        temp.MolarVolume  = 10.85E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "W";
-        temp.FullName = "Tungsten";
-        temp.AtomicNumber = 74;
-        temp.AtomicWeight = 183.841;
-        temp.MolarVolume  = 9.47E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "RE";
-        temp.FullName = "Rhenium";
-        temp.AtomicNumber = 75;
-        temp.AtomicWeight = 186.207;
-        temp.MolarVolume  = 8.86E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "OS";
-        temp.FullName = "Osmium";
-        temp.AtomicNumber = 76;
-        temp.AtomicWeight = 190.233;
-        temp.MolarVolume  = 8.42E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "IR";
-        temp.FullName = "Iridium";
-        temp.AtomicNumber = 77;
-        temp.AtomicWeight = 192.217;
-        temp.MolarVolume  = 8.52E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "PT";
-        temp.FullName = "Platinum";
-        temp.AtomicNumber = 78;
-        temp.AtomicWeight = 195.084;
-        temp.MolarVolume  = 9.09E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "AU";
-        temp.FullName = "Gold";
-        temp.AtomicNumber = 79;
-        temp.AtomicWeight = 196.967;
-        temp.MolarVolume  = 10.21E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "HG";
-        temp.FullName = "Mercury";
-        temp.AtomicNumber = 80;
-        temp.AtomicWeight = 200.592;
-        temp.MolarVolume  = 14.09E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "TL";
-        temp.FullName = "Thallium";
-        temp.AtomicNumber = 81;
-        temp.AtomicWeight = 204.382;
-        temp.MolarVolume  = 17.22E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "PB";
-        temp.FullName = "Lead";
-        temp.AtomicNumber = 82;
-        temp.AtomicWeight = 207.210;
-        temp.MolarVolume  = 18.26E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "BI";
-        temp.FullName = "Bismuth";
-        temp.AtomicNumber = 83;
-        temp.AtomicWeight = 208.980;
-        temp.MolarVolume  = 21.31E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "PO";
-        temp.FullName = "Polonium";
-        temp.AtomicNumber = 84;
-        temp.AtomicWeight = 209.980;
-        temp.MolarVolume  = 22.97E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "AT";
-        temp.FullName = "Astatine";
-        temp.AtomicNumber = 85;
-        temp.AtomicWeight = 209.987;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "RN";
-        temp.FullName = "Radon";
-        temp.AtomicNumber = 86;
-        temp.AtomicWeight = 222.000;
-        temp.MolarVolume  = 50.50E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "FR";
-        temp.FullName = "Francium";
-        temp.AtomicNumber = 87;
-        temp.AtomicWeight = 223.020;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "RA";
-        temp.FullName = "Radium";
-        temp.AtomicNumber = 88;
-        temp.AtomicWeight = 226.025;
-        temp.MolarVolume  = 41.09E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "AC";
-        temp.FullName = "Actinium";
-        temp.AtomicNumber = 89;
-        temp.AtomicWeight = 227.028;
-        temp.MolarVolume  = 22.55E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "TH";
-        temp.FullName = "Thorium";
-        temp.AtomicNumber = 90;
-        temp.AtomicWeight = 232.038;
-        temp.MolarVolume  = 19.80E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "PA";
-        temp.FullName = "Protactinium";
-        temp.AtomicNumber = 91;
-        temp.AtomicWeight = 231.036;
-        temp.MolarVolume  = 15.18E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "U";
-        temp.FullName = "Uranium";
-        temp.AtomicNumber = 92;
-        temp.AtomicWeight = 238.029;
-        temp.MolarVolume  = 12.49E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "NP";
-        temp.FullName = "Neptunium";
-        temp.AtomicNumber = 93;
-        temp.AtomicWeight = 237.048;
-        temp.MolarVolume  = 11.59E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "PU";
-        temp.FullName = "Plutonium";
-        temp.AtomicNumber = 94;
-        temp.AtomicWeight = 244.064;
-        temp.MolarVolume  = 12.29E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "AM";
-        temp.FullName = "Americium";
-        temp.AtomicNumber = 95;
-        temp.AtomicWeight = 243.061;
-        temp.MolarVolume  = 17.78E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CM";
-        temp.FullName = "Curium";
-        temp.AtomicNumber = 96;
-        temp.AtomicWeight = 247.070;
-        temp.MolarVolume  = 18.05E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "BK";
-        temp.FullName = "Berkelium";
-        temp.AtomicNumber = 97;
-        temp.AtomicWeight = 247.0;
-        temp.MolarVolume  = 16.84E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "CF";
-        temp.FullName = "Californium";
-        temp.AtomicNumber = 98;
-        temp.AtomicWeight = 251.0;
-        temp.MolarVolume  = 16.50E-6;
-
-        Data.push_back(temp);
-
-        temp.Name = "ES";
-        temp.FullName = "Einsteinium";
-        temp.AtomicNumber = 99;
-        temp.AtomicWeight = 252.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "FM";
-        temp.FullName = "Fermium";
-        temp.AtomicNumber = 100;
-        temp.AtomicWeight = 257.095;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "MD";
-        temp.FullName = "Mendelevium";
-        temp.AtomicNumber = 101;
-        temp.AtomicWeight = 258.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "NO";
-        temp.FullName = "Nobelium";
-        temp.AtomicNumber = 102;
-        temp.AtomicWeight = 259.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "LR";
-        temp.FullName = "Lawrencium";
-        temp.AtomicNumber = 103;
-        temp.AtomicWeight = 266.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "RD";
-        temp.FullName = "Rutherfordium";
-        temp.AtomicNumber = 104;
-        temp.AtomicWeight = 261.109;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "DB";
-        temp.FullName = "Dubnium";
-        temp.AtomicNumber = 105;
-        temp.AtomicWeight = 262.114;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "SG";
-        temp.FullName = "Seaborgium";
-        temp.AtomicNumber = 106;
-        temp.AtomicWeight = 263.118;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "BH";
-        temp.FullName = "Bohrium";
-        temp.AtomicNumber = 107;
-        temp.AtomicWeight = 262.123;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "HS";
-        temp.FullName = "Hassium";
-        temp.AtomicNumber = 108;
-        temp.AtomicWeight = 265.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "MT";
-        temp.FullName = "Meitnerium";
-        temp.AtomicNumber = 109;
-        temp.AtomicWeight = 268.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "DS";
-        temp.FullName = "Darmstadtium";
-        temp.AtomicNumber = 110;
-        temp.AtomicWeight = 281.;
-        temp.MolarVolume  = -1.;
-
-        Data.push_back(temp);
-
-        temp.Name = "RG";
-        temp.FullName = "Roentgenium";
-        temp.AtomicNumber = 111;
-        temp.AtomicWeight = 280.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "CN";
-        temp.FullName = "Copernicium";
-        temp.AtomicNumber = 112;
-        temp.AtomicWeight = 277.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "NH";
-        temp.FullName = "Nihonium";
-        temp.AtomicNumber = 113;
-        temp.AtomicWeight = 287.;
-        temp.MolarVolume  = -1.;
-
-        Data.push_back(temp);
-
-        temp.Name = "FL";
-        temp.FullName = "Flerovium";
-        temp.AtomicNumber = 114;
-        temp.AtomicWeight = 289.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "MC";
-        temp.FullName = "Moscovium";
-        temp.AtomicNumber = 115;
-        temp.AtomicWeight = 288.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "LV";
-        temp.FullName = "Livermorium";
-        temp.AtomicNumber = 116;
-        temp.AtomicWeight = 293.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
-
-        temp.Name = "TS";
-        temp.FullName = "Tennessine";
-        temp.AtomicNumber = 117;
-        temp.AtomicWeight = 292.0;
-        temp.MolarVolume  = -1.0;
-
-        Data.push_back(temp);
+        std::string_view Name;                                                  ///< Symbol in upper case letters
+        std::string_view FullName;                                              ///< Full name
+        int AtomicNumber;                                                       ///< Atomic number
+        double AtomicWeight;                                                    ///< Atomic weight in g/mol
+        double MolarVolume;                                                     ///< Molar volume in m^3/mol, -1 if unknown
+    };
 
-        temp.Name = "OG";
-        temp.FullName = "Oganesson";
-        temp.AtomicNumber = 118;
-        temp.AtomicWeight = 294.0;
-        temp.MolarVolume  = -1.0;
+    static constexpr size_t Nelements = 118;                                    ///< Number of elements in the table
+    static constexpr ElementData Table[Nelements] =
+    {
+        {"H",  "Hydrogen",         1,    1.008,  11.42E-6},
+        {"HE", "Helium",           2,    4.003,  21.00E-6},
+        {"LI", "Lithium",          3,    6.940,  13.02E-6},
+        {"BE", "Beryllium",        4,    9.012,   4.85E-6},
+        {"B",  "Boron",            5,   10.810,   4.39E-6},
+        {"C",  "Carbon",           6,   12.011,   5.31E-6},
+        {"N",  "Nitrogen",         7,   14.007,  13.54E-6},
+        {"O",  "Oxygen",           8,   15.999,  17.36E-6},
+        {"F",  "Fluorine",         9,   18.998,  11.20E-6},
+        {"NE", "Neon",            10,   20.180,  13.23E-6},
+        {"NA", "Sodium",          11,   22.990,  23.78E-6},
+        {"MG", "Magnesium",       12,   24.305,  14.00E-6},
+        {"AL", "Aluminium",       13,   26.982,  10.00E-6},
+        {"SI", "Silicon",         14,   28.085,  12.06E-6},
+        {"P",  "Phosphorus",      15,   30.974,  17.02E-6},
+        {"S",  "Sulfur",          16,   32.060,  15.53E-6},
+        {"CL", "Chlorine",        17,   35.450,  17.39E-6},
+        {"AR", "Argon",           18,   39.948,  22.56E-6},
+        {"K",  "Potassium",       19,   39.098,  45.94E-6},
+        {"CA", "Calcium",         20,   40.078,  26.20E-6},
+        {"SC", "Scandium",        21,   44.956,  15.00E-6},
+        {"TI", "Titanium",        22,   47.867,  10.64E-6},
+        {"V",  "Vanadium",        23,   50.942,   8.32E-6},
+        {"CR", "Chromium",        24,   51.996,   7.23E-6},
+        {"MN", "Manganese",       25,   54.938,   7.35E-6},
+        {"FE", "Iron",            26,   55.845,   7.09E-6},
+        {"CO", "Cobalt",          27,   58.933,   6.67E-6},
+        {"NI", "Nickel",          28,   58.693,   6.59E-6},
+        {"CU", "Copper",          29,   63.546,   7.11E-6},
+        {"ZN", "Zinc",            30,   65.380,   9.16E-6},
+        {"GA", "Gallium",         31,   69.723,  11.80E-6},
+        {"GE", "Germanium",       32,   72.630,  13.63E-6},
+        {"AS", "Arsenic",         33,   74.922,  12.95E-6},
+        {"SE", "Selenium",        34,   78.971,  16.42E-6},
+        {"BR", "Bromine",         35,   79.904,  19.78E-6},
+        {"KR", "Krypton",         36,   83.798,  27.99E-6},
+        {"RB", "Rubidium",        37,   85.468,  55.76E-6},
+        {"SR", "Strontium",       38,   87.620,  33.94E-6},
+        {"Y",  "Yttrium",         39,   88.906,  19.88E-6},
+        {"ZR", "Zirconium",       40,   91.224,  14.02E-6},
+        {"NB", "Niobium",         41,   92.906,  10.83E-6},
+        {"MO", "Molybdenum",      42,   95.951,   9.38E-6},
+        {"TC", "Technetium",      43,   98.906,   8.63E-6},
+        {"RU", "Ruthenium",       44,  101.072,   8.17E-6},
+        {"RH", "Rhodium",         45,  102.906,   8.28E-6},
+        {"PD", "Palladium",       46,  106.421,   8.56E-6},
+        {"AG", "Silver",          47,  107.868,  10.27E-6},
+        {"CD", "Cadmium",         48,  112.414,  13.00E-6},
+        {"IN", "Indium",          49,  114.818,  15.76E-6},
+        {"SN", "Tin",             50,  118.710,  16.29E-6},
+        {"SB", "Antimony",        51,  121.760,  18.19E-6},
+        {"TE", "Tellurium",       52,  127.603,  20.46E-6},
+        {"I",  "Iodine",          53,  126.904,  25.72E-6},
+        {"XE", "Xenon",           54,  131.293,  35.92E-6},
+        {"CS", "Caesium",         55,  132.905,  70.94E-6},
+        {"BA", "Barium",          56,  137.327,  38.16E-6},
+        {"LA", "Lanthanum",       57,  138.905,  22.39E-6},
+        {"CE", "Cerium",          58,  140.116,  20.69E-6},
+        {"PR", "Praseodymium",    59,  140.908,  20.80E-6},
+        {"ND", "Neodymium",       60,  144.242,  20.59E-6},
+        {"PM", "Promethium",      61,  146.915,  20.10E-6},
+        {"SM", "Samarium",        62,  150.362,  19.98E-6},
+        {"EU", "Europium",        63,  151.964,  28.97E-6},
+        {"GD", "Gadolinium",      64,  157.253,  19.90E-6},
+        {"TB", "Terbium",         65,  158.925,  19.30E-6},
+        {"DY", "Dysprosium",      66,  162.500,  19.01E-6},
+        {"HO", "Holmium",         67,  164.930,  18.74E-6},
+        {"ER", "Erbium",          68,  167.259,  18.46E-6},
+        {"TM", "Thulium",         69,  168.934,  19.10E-6},
+        {"YB", "Ytterbium",       70,  173.045,  24.84E-6},
+        {"LU", "Lutetium",        71,  174.967,  17.78E-6},
+        {"HF", "Hafnium",         72,  178.492,  13.44E-6},
+        {"TA", "Tantalum",        73,  180.948,  10.85E-6},
+        {"W",  "Tungsten",        74,  183.841,   9.47E-6},
+        {"RE", "Rhenium",         75,  186.207,   8.86E-6},
+        {"OS", "Osmium",          76,  190.233,   8.42E-6},
+        {"IR", "Iridium",         77,  192.217,   8.52E-6},
+        {"PT", "Platinum",        78,  195.084,   9.09E-6},
+        {"AU", "Gold",            79,  196.967,  10.21E-6},
+        {"HG", "Mercury",         80,  200.592,  14.09E-6},
+        {"TL", "Thallium",        81,  204.382,  17.22E-6},
+        {"PB", "Lead",            82,  207.210,  18.26E-6},
+        {"BI", "Bismuth",         83,  208.980,  21.31E-6},
+        {"PO", "Polonium",        84,  209.980,  22.97E-6},
+        {"AT", "Astatine",        85,  209.987,      -1.0},
+        {"RN", "Radon",           86,  222.000,  50.50E-6},
+        {"FR", "Francium",        87,  223.020,      -1.0},
+        {"RA", "Radium",          88,  226.025,  41.09E-6},
+        {"AC", "Actinium",        89,  227.028,  22.55E-6},
+        {"TH", "Thorium",         90,  232.038,  19.80E-6},
+        {"PA", "Protactinium",    91,  231.036,  15.18E-6},
+        {"U",  "Uranium",         92,  238.029,  12.49E-6},
+        {"NP", "Neptunium",       93,  237.048,  11.59E-6},
+        {"PU", "Plutonium",       94,  244.064,  12.29E-6},
+        {"AM", "Americium",       95,  243.061,  17.78E-6},
+        {"CM", "Curium",          96,  247.070,  18.05E-6},
+        {"BK", "Berkelium",       97,    247.0,  16.84E-6},
+        {"CF", "Californium",     98,    251.0,  16.50E-6},
+        {"ES", "Einsteinium",     99,    252.0,      -1.0},
+        {"FM", "Fermium",        100,  257.095,      -1.0},
+        {"MD", "Mendelevium",    101,    258.0,      -1.0},
+        {"NO", "Nobelium",       102,    259.0,      -1.0},
+        {"LR", "Lawrencium",     103,    266.0,      -1.0},
+        {"RD", "Rutherfordium",  104,  261.109,      -1.0},
+        {"DB", "Dubnium",        105,  262.114,      -1.0},
+        {"SG", "Seaborgium",     106,  263.118,      -1.0},
+        {"BH", "Bohrium",        107,  262.123,      -1.0},
+        {"HS", "Hassium",        108,    265.0,      -1.0},
+        {"MT", "Meitnerium",     109,    268.0,      -1.0},
+        {"DS", "Darmstadtium",   110,     281.,       -1.},
+        {"RG", "Roentgenium",    111,    280.0,      -1.0},
+        {"CN", "Copernicium",    112,    277.0,      -1.0},
+        {"NH", "Nihonium",       113,     287.,       -1.},
+        {"FL", "Flerovium",      114,    289.0,      -1.0},
+        {"MC", "Moscovium",      115,    288.0,      -1.0},
+        {"LV", "Livermorium",    116,    293.0,      -1.0},
+        {"TS", "Tennessine",     117,    292.0,      -1.0},
+        {"OG", "Oganesson",      118,    294.0,      -1.0}
+    };
 
-        Data.push_back(temp);
+    static constexpr int Find(std::string_view Symbol)                          ///< Index of the element in Table (case-insensitive), -1 if not found
+    {
+        const int key = Key(Symbol);
+        return (key < 0) ? -1 : Lookup[key];
+    }
+    static constexpr double AtomicWeight(std::string_view Symbol)               ///< Atomic weight of the element, the one of the custom element if not found
+    {
+        const int n = Find(Symbol);
+        return (n < 0) ? CustomAtomicWeight : Table[n].AtomicWeight;
+    }
+    static constexpr double MolarVolume(std::string_view Symbol)                ///< Molar volume of the element, the one of the custom element if not found
+    {
+        const int n = Find(Symbol);
+        return (n < 0) ? CustomMolarVolume : Table[n].MolarVolume;
     }
 
     Element GetData(std::string Name) const
     {
         std::transform(Name.begin(), Name.end(), Name.begin(), ::toupper);      //Change "Element" to upper cases only
-        for(size_t n = 0; n < Data.size(); n++)
+        const int n = Find(Name);
+        if(n >= 0)
         {
-            if(Name == Data[n].Name)
-            {
-                return Data[n];
-            }
+            return Element{std::string(Table[n].Name), std::string(Table[n].FullName),
+                           Table[n].AtomicNumber, Table[n].AtomicWeight, Table[n].MolarVolume};
         }
         Element temp;
         temp.Name = Name;
         temp.FullName = Name;
         temp.AtomicNumber = 100;
-        temp.AtomicWeight = 100.0;
-        temp.MolarVolume  = 1E-5;
+        temp.AtomicWeight = CustomAtomicWeight;
+        temp.MolarVolume  = CustomMolarVolume;
         //std::cout << "Could not find Element " << Name
         //<< " in PeriodicTable.h! Used Custom Element instead!" << std::endl;
         return temp;
@@ -1017,7 +223,33 @@ class PeriodicTable
 
  protected:
  private:
-    std::vector<Element> Data;
+    static constexpr double CustomAtomicWeight = 100.0;                         ///< Atomic weight of elements not in the table
+    static constexpr double CustomMolarVolume  = 1E-5;                          ///< Molar volume of elements not in the table
+
+    static constexpr int Letter(char c)                                         ///< 1..26 for letters (any case), -1 otherwise
+    {
+        if(c >= 'a' and c <= 'z') return c - 'a' + 1;
+        if(c >= 'A' and c <= 'Z') return c - 'A' + 1;
+        return -1;
+    }
+    static constexpr int Key(std::string_view Symbol)                           ///< Direct address of a one or two letter symbol, -1 otherwise
+    {
+        if(Symbol.size() < 1 or Symbol.size() > 2) return -1;
+        const int first  = Letter(Symbol[0]);
+        const int second = (Symbol.size() == 2) ? Letter(Symbol[1]) : 0;
+        if(first < 0 or second < 0) return -1;
+        return first*27 + second;
+    }
+    static constexpr std::array<short, 27*27> BuildLookup(void)
+    {
+        std::array<short, 27*27> result{};
+        for(size_t n = 0; n < result.size(); n++) result[n] = -1;
+        for(size_t n = 0; n < Nelements; n++) result[Key(Table[n].Name)] = n;
+        return result;
+    }
+    static const std::array<short, 27*27> Lookup;                               ///< Table index of each symbol address
 };
+inline constexpr std::array<short, 27*27> PeriodicTable::Lookup = PeriodicTable::BuildLookup();
+static_assert(PeriodicTable::Find("Fe") == 25 and PeriodicTable::Find("OG") == 117, "PeriodicTable lookup is inconsistent");
 }
 #endif//PERIODICTABLE_H
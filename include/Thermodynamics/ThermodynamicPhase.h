@@ -66,6 +66,12 @@ class OP_EXPORTS ThermodynamicPhase
         Number = RHS.Number;
         State = RHS.State;
 		TQName = RHS.TQName;
+        ConsSite = RHS.ConsSite;
+        ConsSubl = RHS.ConsSubl;
+        ConsComp = RHS.ConsComp;
+        Ncomp = RHS.Ncomp;
+        Ncons = RHS.Ncons;
+        dMAdYi = RHS.dMAdYi;
     }
     ThermodynamicPhase& operator=(const ThermodynamicPhase& RHS)                ///< Assignment operator
     {
@@ -91,6 +97,12 @@ class OP_EXPORTS ThermodynamicPhase
             Number = RHS.Number;
             State = RHS.State;
             TQName = RHS.TQName;
+            ConsSite = RHS.ConsSite;
+            ConsSubl = RHS.ConsSubl;
+            ConsComp = RHS.ConsComp;
+            Ncomp = RHS.Ncomp;
+            Ncons = RHS.Ncons;
+            dMAdYi = RHS.dMAdYi;
         }
         return *this;
     }
@@ -141,8 +153,24 @@ class OP_EXPORTS ThermodynamicPhase
     bool get_isStoichiometric(void);
     bool StoichiometricFlag;
     size_t Idx2Cons(size_t sub, int Idx);
-    std::vector<std::vector<double> > dMAdYi;
+    std::vector<double> dMAdYi;                                                 ///< Moles of each component per site fraction dM_A/dy_i, component major [comp*Ncons + con]
     bool AnalyticChemicalPotentials;
+
+    /* Flattened constituent layout and batched kernels. SetConstituentLayout()
+    copies the sublattice structure into contiguous arrays once, the kernels
+    then evaluate a batch of nCells cells at once. Batch arrays are stored
+    constituent (or component) major, Y[con*nCells + cell], so that the inner
+    loops run over contiguous cells and can be vectorized. */
+    void SetConstituentLayout(void);                                            ///< Fills the flattened constituent layout from Sublattice and Component
+    void MoleFractions(const double* Y, double* X, const size_t nCells) const;  ///< Mole fractions X[Ncomp x nCells] from site fractions Y[Ncons x nCells]
+    void ConfigurationalGibbsEnergy(const double* Y, const double* T,
+                                    double* G, double* dGdY, double* d2GdY2,
+                                    const size_t nCells) const;                 ///< Ideal mixing energy RT sum_s a_s sum_i y_i ln(y_i), its gradient and the diagonal of its Hessian per formula unit
+    void MoleFractionJacobian(const double* Y, double* dXdY,
+                              const size_t nCells) const;                       ///< Derivatives dX_A/dy_i[(comp*Ncons + con) x nCells] of the mole fractions with respect to the site fractions Y[Ncons x nCells]
+    std::vector<double> ConsSite;                                               ///< Site coefficient of the sublattice of each constituent
+    std::vector<size_t> ConsSubl;                                               ///< Sublattice of each constituent
+    std::vector<int>    ConsComp;                                               ///< Component number of each constituent, -1 for vacancies
     /*SublatticeModel& Add_Sublattice(unsigned int n_sites)
     {
         SublatticeModel locSublattice(n_sites);
@@ -161,7 +189,7 @@ class OP_EXPORTS ThermodynamicPhase
     std::vector<int> getConsIdx(void);                                          ///< A vector that holds the Index of each Constituent
     std::vector<double> getNsitesWithI(void);                                   ///< Summation of all sites of those sublattices, that include a certain element!
     std::vector<std::string> getConNames(void);                                 ///< A vector of strings with all the Names of each constituent
-    std::vector<std::vector<double> > getdMAdYi(void);
+    std::vector<double> getdMAdYi(void);
     bool getAnalyticChemicalPotentials(void);
     double getSubstitutionalSites(void);
 };
@@ -0,0 +1,64 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef TIMESERIESOUTPUT_H
+#define TIMESERIESOUTPUT_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Buffered output of tabulated time series (statistics, monitors). Each file
+is opened once on its first Append() and stays open, the lines are collected
+in memory and written when a file has FlushEntries pending lines, when
+FlushInterval seconds have passed since the last flush, at checkpoints
+(Checkpoint::Write()), with Flush() and at program exit. This replaces the
+check for existence, open, append and close of each file in every time step,
+which on parallel file systems amounts to thousands of metadata operations.
+
+The header is written if the file does not exist at the first Append() or if
+Restart is set, which starts the file anew. The flushing policy is set with
+$TimeSeriesFlushEntries and $TimeSeriesFlushInterval in the @Settings input,
+FlushEntries = 1 writes every line immediately. Usage:
+
+    std::stringstream line;
+    line << tStep << " " << Value << "\n";
+    TimeSeriesOutput::Append("Value.opd", "tStep Value\n", line.str());     */
+
+class OP_EXPORTS TimeSeriesOutput                                               ///< Buffered output of tabulated time series
+{
+ public:
+    static constexpr auto thisclassname = "TimeSeriesOutput";                   ///< Object's implementation class name
+
+    static void Configure(const size_t FlushEntries, const double FlushInterval);///< Sets the number of pending lines per file and the time in seconds after which the lines are written
+    static void Append(const std::string& FileName, const std::string& Header,
+                       const std::string& Line, const bool Restart = false);    ///< Appends Line to FileName, writes Header first to a new or restarted file
+    static void Flush(void);                                                    ///< Writes the pending lines of all files
+    static void Close(void);                                                    ///< Writes the pending lines and closes all files
+};
+
+}// namespace openphase
+#endif
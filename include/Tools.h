@@ -51,6 +51,7 @@ class OP_EXPORTS Tools
     static double getMisorientation(const dMatrix3x3 RotMatA, const dMatrix3x3 RotMatB); ///< Calculates missorientation between two matrices without consideration of symmetries
     static double getMisorientationCubic(const dMatrix3x3 RotMatA, const dMatrix3x3 RotMatB, const Crystallography& CR); ///< Calculates missorientation between two matrices considering cubic symmetry
     static double getDisorientationCubic(const Quaternion OrientationA, const Quaternion OrientationB); ///< Calculates Disorientation between two quaternions considering cubic symmetry
+    static double getDisorientationCubic(const Quaternion OrientationA, const Quaternion OrientationB, dVector3& Axis); ///< Disorientation angle and axis (in the standard triangle) considering cubic symmetry
     static EulerAngles RotationToEuler(const dMatrix3x3& Rot, const EulerConvention locConvention);
     static dVector3 MillerConversion(const std::vector<double>& hkil, dVector3 hkl, bool PlaneNormal = true); ///< Hexagonal Miller plane Normal indices to Miller-Bravais // flase for directions --
 
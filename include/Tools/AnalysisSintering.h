@@ -32,10 +32,12 @@
 
 #include "OPObject.h"
 #include "PhaseField.h"
+#include "Tools/ConnectedComponents.h"
 
 namespace openphase
 {
 
+class BoundaryConditions;
 class DoubleObstacle;
 class GrandPotentialDensity;
 class GrandPotentialSolver;
@@ -65,6 +67,9 @@ struct OP_EXPORTS AnalysisSintering: public OPObject
     void PrintSolidPhaseFractionInBoundingBox(const PhaseField& Phase, const GrandPotentialDensity& omega, const GrandPotentialSolver& GPS);
     void WriteSolidPhaseFractionInBoundingBox(const PhaseField& Phase, const GrandPotentialDensity& omega, const GrandPotentialSolver& GPS, std::string filename, double time, char separator);
 
+    static std::vector<ConnectedComponents::Component_t> Pores(const PhaseField& Phase,
+            const BoundaryConditions& BC, const size_t GasPhaseIdx);            ///< Connected regions of the gas phase with volume, surface and bounding box, e.g. to detect closed pores (collective)
+
     void DoDiagnostics(Settings& locSettings, PhaseField& Phase,
             DoubleObstacle& DO, InterfaceProperties& IP,
             GrandPotentialDensity& omega, GrandPotentialSolver& GPS,
@@ -49,8 +49,18 @@ class OP_EXPORTS CSVParser
         std::vector<std::vector<std::string>>& dataArray,
         std::vector<std::string>& headerArray, std::string seperator = ",");
 
+    /* Reads a headerless file of integer rows with Ncolumns entries each.
+    The file is memory mapped and split into one chunk of whole lines per
+    thread, Process(row, rowNumber, thread) is called concurrently for every
+    row with its zero based position in the file. Returns the number of rows. */
+    static size_t ReadIntegerRows(const std::string& fileName,
+        const size_t Ncolumns, const char separator,
+        const std::function<void(const long int*, size_t, int)>& Process);
+
  protected:
  private:
+    static void Output(const std::string& fileName, const std::string& Text,
+                       const bool Append, const std::string& Method);           ///< Writes or appends Text to the file, or passes it to the embedded file sink
 };
 
 } // namespace openphase
@@ -0,0 +1,83 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+
+#ifndef CONNECTEDCOMPONENTS_H
+#define CONNECTEDCOMPONENTS_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+class BoundaryConditions;
+class GridParameters;
+class PhaseField;
+
+/* Connected component labeling of regions of equal key, e.g. grains, phases
+or pores. Two grid cells belong to the same component if they have the same
+non-negative key and share a face, cells with a negative key are not
+labeled. Each OpenMP thread runs a union-find on a contiguous range of cells,
+the ranges are joined serially along their first plane. The local components
+are numbered consecutively over all MPI ranks, the labels of the halo cells
+are exchanged with the boundary conditions and the component pairs found
+across the process and periodic boundaries are merged on every rank. The
+final components are numbered in the order of their first cell, i.e. the same
+on all ranks, together with their key, volume, surface, bounding box and
+centroid. The centroid and the bounding box are given in global cell
+coordinates and are not unwrapped across periodic boundaries. Usage:
+
+    Storage3D<size_t,0> Labels;
+    auto Components = ConnectedComponents::Label(Phase.Grid, BC,
+                      ConnectedComponents::GrainKey(Phase), Labels);          */
+
+class OP_EXPORTS ConnectedComponents
+{
+ public:
+    typedef std::function<long int(long int, long int, long int)> Key_t;
+
+    struct Component_t
+    {
+        long int Key = -1;                                                      ///< Key of the cells of the component
+        double Volume = 0.0;                                                    ///< Volume of the component
+        double Surface = 0.0;                                                   ///< Area of the faces to cells with other keys
+        dVector3 Centroid {};                                                   ///< Centroid in global cell coordinates
+        iVector3 Min {};                                                        ///< Lower corner of the bounding box in global cell coordinates
+        iVector3 Max {};                                                        ///< Upper corner of the bounding box in global cell coordinates
+    };
+
+    static constexpr size_t Unlabeled = SIZE_MAX;                               ///< Label of the cells with a negative key
+
+    static std::vector<Component_t> Label(const GridParameters& Grid,
+                                          const BoundaryConditions& BC,
+                                          const Key_t& Key,
+                                          Storage3D<size_t,0>& Labels);         ///< Labels the components of Key, Labels is allocated with one halo cell if not allocated (collective)
+    static Key_t GrainKey(const PhaseField& Phase);                             ///< Index of the majority phase field in a cell
+    static Key_t PhaseKey(const PhaseField& Phase);                             ///< Thermodynamic phase of the majority phase field in a cell
+};
+
+}// namespace openphase
+#endif
@@ -0,0 +1,140 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include "Includes.h"
+#include <mutex>
+#include <atomic>
+
+namespace openphase
+{
+
+/* Runs many small, independent simulations in one process. Each case is an
+object of the user class case_t holding its own Settings and modules:
+    case_t(const size_t Index, const std::string& InputFileName, Shared&...)
+        sets the case up from its input file,
+    void Run(void)
+        executes its time loop.
+The constructors are executed one at a time (Settings::ReadInput and the
+module input routines set process wide parameters like OMP_TILE_SIZE and the
+FFTW planner rigor), the time loops run concurrently. The cases are handed out
+dynamically to teams of TeamSize OpenMP threads, the parallel regions of a case
+use its team only (nested parallelism). TeamSize = 1 runs one case per thread
+which is the most efficient for grids too small to scale over many threads.
+Read-only data needed by all cases (e.g. thermodynamic databases) is created
+once by the caller and passed by reference as Shared arguments. The parsed
+input files are cached by FileInterface, FFTW plans of equal size are found in
+the shared FFTW wisdom so only the first case pays for the planning.
+Each case has to write its output to its own directories (VTKDir, RAWDir and
+DATADir in @Settings), Variant() and WriteCase() create such inputs from a
+common template. A failing case (exception) is reported and does not stop the
+other cases, OP_Exit() in a case still terminates the process. Only supported
+in the serial (non-MPI) build. */
+
+class OP_EXPORTS Ensemble
+{
+ public:
+    struct Result                                                               ///< Outcome of a single case
+    {
+        std::string InputFileName;                                              ///< Input file of the case
+        bool Success = false;                                                   ///< True if setup and time loop finished without exception
+        double WallTime = 0.0;                                                  ///< Wall time of setup and time loop in seconds
+        std::string Error;                                                      ///< Exception message of a failed case
+    };
+
+    static std::string Variant(const std::string& Input,
+            const std::map<std::string, std::string>& Parameters);              ///< Input text with the values of "Key" or "Module/Key" replaced
+    static std::string WriteCase(const std::string& Directory,
+                                 const std::string& Input);                     ///< Writes Input to Directory/ProjectInput.opi, returns the file name
+    static void PrepareThreads(const size_t nCases, const int TeamSize);        ///< Enables nested OpenMP and the thread safe FFTW planner
+    static void Report(const std::vector<Result>& Results);                     ///< Writes the success and wall time of all cases to the console
+
+    template<class case_t, class... shared_t>
+    static std::vector<Result> Run(const std::vector<std::string>& InputFileNames,
+                                   const int TeamSize, shared_t&... Shared);    ///< Runs all cases, returns their outcome in input order
+
+    inline static std::mutex SetupMutex;                                        ///< Serializes the case setup
+};
+
+template<class case_t, class... shared_t>
+std::vector<Ensemble::Result> Ensemble::Run(const std::vector<std::string>& InputFileNames,
+                                            const int TeamSize, shared_t&... Shared)
+{
+    const size_t nCases = InputFileNames.size();
+    std::vector<Result> Results(nCases);
+    if(nCases == 0) return Results;
+
+    const int locTeamSize = std::max(TeamSize, 1);
+    PrepareThreads(nCases, locTeamSize);
+
+    std::atomic<size_t> NextCase(0);
+    int nTeams = 1;
+#ifdef _OPENMP
+    nTeams = std::max(1, omp_get_max_threads()/locTeamSize);
+#endif
+    nTeams = std::min<int>(nTeams, nCases);
+
+    #pragma omp parallel num_threads(nTeams)
+    {
+        for(size_t idx = NextCase++; idx < nCases; idx = NextCase++)
+        {
+            Result& res = Results[idx];
+            res.InputFileName = InputFileNames[idx];
+            const auto start = std::chrono::steady_clock::now();
+            try
+            {
+                std::unique_ptr<case_t> Case;
+                {
+                    std::lock_guard<std::mutex> lock(SetupMutex);
+                    Case = std::make_unique<case_t>(idx, InputFileNames[idx], Shared...);
+                }
+                /* RunTimeControl sets the thread count of the case from its
+                input, the team size of the ensemble takes precedence */
+#ifdef _OPENMP
+                omp_set_num_threads(locTeamSize);
+#endif
+                Case->Run();
+                res.Success = true;
+            }
+            catch(const std::exception& e)
+            {
+                res.Error = e.what();
+            }
+            catch(...)
+            {
+                res.Error = "unknown exception";
+            }
+            res.WallTime = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    return Results;
+}
+
+}// namespace openphase
+#endif
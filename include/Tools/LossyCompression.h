@@ -0,0 +1,78 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef LOSSYCOMPRESSION_H
+#define LOSSYCOMPRESSION_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Error bounded compression of floating point raw data. Each value is
+predicted from the reconstructed value "Stride" entries earlier, which for
+Storage3D data with Stride values per cell is the neighbor cell in the
+contiguous z direction, and the prediction error is quantized in steps of
+twice the absolute error bound. The quantization codes are stored as
+variable length integers and deflated with miniz, values which cannot be
+quantized within the bound (not finite or too large) are stored verbatim.
+Every reconstructed value differs from the original by at most the error
+bound, smooth fields like composition, temperature, strains or LBM
+populations compress 5-20 times at bounds well below their accuracy.
+
+The error bound is given relative to the value range of the data (the
+"REL" mode of SZ), a single tolerance thus suits fields of different units.
+A tolerance of 0 stores the data losslessly (deflated doubles). The data is
+split into blocks which are compressed and decompressed concurrently.
+
+Read() recognizes the compressed format by its signature and leaves the
+stream unchanged otherwise, objects thus read raw checkpoints of both
+formats. Usage:
+
+    std::vector<double> values = ...;
+    LossyCompression::Write(out, values, locSettings.CheckpointTolerance, Stride);
+
+    if(not LossyCompression::Read(inp, values)) ... read the raw values
+
+File layout: "OPLOSSY1", uint64 number of values, uint64 stride, double
+absolute error bound (0: lossless), uint64 values per block, uint64 number
+of blocks, then per block uint64 decoded and uint64 compressed size followed
+by the compressed blocks. */
+
+class OP_EXPORTS LossyCompression                                               ///< Error bounded compression of floating point data
+{
+ public:
+    static constexpr auto thisclassname = "LossyCompression";                   ///< Object's implementation class name
+    static constexpr size_t BlockSize = 1 << 18;                                ///< Values per independently compressed block
+
+    static void Write(std::ostream& out, const std::vector<double>& data,
+                      const double Tolerance, const size_t Stride = 1);         ///< Compresses data with an error bound relative to its value range
+    static bool Read(std::istream& inp, std::vector<double>& data);             ///< Decompresses data, returns false and leaves the stream unchanged if it does not start with compressed data
+    static double ErrorBound(const std::vector<double>& data,
+                             const double Tolerance);                           ///< Absolute error bound of data for a relative Tolerance
+};
+
+}// namespace openphase
+#endif
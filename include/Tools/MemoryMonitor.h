@@ -0,0 +1,80 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MEMORYMONITOR_H
+#define MEMORYMONITOR_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Periodic memory sampling over the run. Every Interval time steps the
+resident set size (RSS) and its high-water mark of the process are read from
+/proc/self/status and the memory held by each existing OPObject is collected
+(OPObject::AllocatedMemory(), including the node entries of NodePF, NodeAB
+and NodeIP storages, which grow as interfaces multiply). One line per sample
+is appended to FileName with the minimum and maximum over the MPI ranks in
+MB. If the maximum RSS exceeds WarningThreshold, or its linear growth since
+the first sample projects it beyond WarningThreshold before the last time
+step, a warning is issued once. The high-water marks of the run are printed
+when the monitor is destroyed. Sample() is collective in MPI parallel mode,
+RunTimeControl calls it from IncrementTimeStep() if $MemoryInterval is set. */
+
+class OP_EXPORTS MemoryMonitor
+{
+ public:
+    MemoryMonitor(){};
+    ~MemoryMonitor();
+
+    void Initialize(const std::string locFileName, const int locInterval,
+                    const double locWarningThreshold, const bool append);       ///< Sets the output file, the sampling interval (0 disables) and the RSS warning threshold [MB] (0 disables)
+    bool Due(const int tStep) const                                             ///< Returns true if a sample is due at the given time step
+    {
+        return Interval > 0 and tStep % Interval == 0;
+    }
+    void Sample(const int tStep, const int nSteps);                             ///< Samples the memory usage at time step tStep of nSteps (collective)
+
+    static double ResidentMemory(void);                                         ///< Current resident set size [MB], negative if not available
+    static double PeakResidentMemory(void);                                     ///< High-water mark of the resident set size [MB], negative if not available
+
+    int Interval = 0;                                                           ///< Sampling interval in time steps, 0 disables the sampling
+    double WarningThreshold = 0.0;                                              ///< RSS per rank above which a warning is issued [MB], 0 disables the warning
+    std::string FileName;                                                       ///< Output file of the samples
+
+ private:
+    static double ProcStatus(const std::string Key);                            ///< Value of Key in /proc/self/status [MB], negative if not available
+
+    bool Append = false;                                                        ///< Appends to an existing output file (restart)
+    size_t Samples = 0;                                                         ///< Number of samples taken
+    std::vector<std::string> Modules;                                           ///< Object names of the per module columns, fixed by the first sample
+    std::vector<double> PeakModules;                                            ///< Maximum memory of each module over the ranks and samples [MB]
+    double PeakRSS = 0.0;                                                       ///< Maximum RSS over the ranks and samples [MB]
+    double FirstRSS = 0.0;                                                      ///< Maximum RSS over the ranks at the first sample [MB]
+    int FirstStep = 0;                                                          ///< Time step of the first sample
+    bool Exceeded = false;                                                      ///< The threshold warning has been issued
+    bool Projected = false;                                                     ///< The projection warning has been issued
+};
+
+}// namespace openphase
+#endif
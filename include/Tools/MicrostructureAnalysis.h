@@ -34,6 +34,7 @@
 
 namespace openphase
 {
+class BoundaryConditions;
 class PhaseField;
 class SymmetryVariants;
 class Crystallography;
@@ -50,6 +51,9 @@ class OP_EXPORTS MicrostructureAnalysis
 
     static void WriteEBSDDataQuaternions(const PhaseField& Phase, const SymmetryVariants& SV, const int tStep, double scale = 1.0);
     static void WriteEBSDDataQuaternionsSlice(const PhaseField& Phase, const SymmetryVariants& SV, const int tStep, const char Axis, const int Position, double scale = 1.0);
+    static void WriteEBSDH5(const PhaseField& Phase, H5Interface& H5, const int tStep, const SymmetryVariants* SV = nullptr);///< Writes phase index (+1) and orientation quaternion of the majority phase field per cell to /Visualization/EBSD/tStep (per rank hyperslabs)
+    static void WriteEBSDNpy(const PhaseField& Phase, const int tStep, const SymmetryVariants* SV = nullptr);///< Writes phase index (+1) and orientation quaternion of the majority phase field as float32 .npy array of shape (Nx,Ny,Nz,5), one file per rank
+    static void WriteEBSDANG(const PhaseField& Phase, const int tStep, const int Position, const double Step = 1.0, const SymmetryVariants* SV = nullptr);///< Writes TSL .ang map (Bunge Euler angles) of the slice normal to Z at the global position Position, one file per rank holding the slice
     static void WriteEBSDVTK(PhaseField& Phase, Crystallography& CR, const Settings& locSettings, EulerConvention locConvention, const int sd, const int tStep);
     static dVector3 IPFColor(size_t sd, EulerAngles& tempEuler, Crystallography& CR);
 
@@ -66,14 +70,56 @@ class OP_EXPORTS MicrostructureAnalysis
 
     static void WriteSymmetryVariantsStatistics(size_t pIndex, const PhaseField& Phase, const SymmetryVariants& SV, const int tStep);
     static double GrainBoundaryStatistics(PhaseField& Phase, std::vector<dVector3> Facets, double DegreeTolerance);
-    static void WriteGrainsStatistics(const PhaseField& Phase, const int tStep, const std::string& h5FileName = "");
+    /* Distributed grain graph: the grains are split over the MPI ranks in
+    blocks of consecutive indices, each rank holds the volumes and the sorted
+    neighbour lists (compressed rows) of its block only. The cells are scanned
+    with sparse per-thread accumulators, neither the threads nor the ranks
+    hold arrays over all grains. Two grains are neighbours if they share an
+    interface cell holding only these two phase fields, the number of these
+    cells divided by the interface width approximates the area of their
+    common grain boundary (in units of dx^2, like GrainsSurfaceArea()). */
+    struct GrainGraph_t
+    {
+        size_t Ngrains = 0;                                                     ///< Total number of phase fields
+        size_t First   = 0;                                                     ///< First grain of the local block
+        std::vector<double> Volumes;                                            ///< Sum of the phase fractions over all cells per grain of the local block
+        std::vector<size_t> Offsets;                                            ///< Neighbours of grain First + n are Neighbours[Offsets[n]] to Neighbours[Offsets[n+1] - 1]
+        std::vector<size_t> Neighbours;                                         ///< Sorted neighbour indices
+        std::vector<double> Areas;                                              ///< Shared interface area with each neighbour in Neighbours
+
+        size_t size(void) const
+        {
+            return Volumes.size();
+        }
+    };
+    static GrainGraph_t GrainGraph(const PhaseField& Phase);                    ///< Builds the distributed grain graph (collective)
+
+    static void WriteGrainsStatistics(const PhaseField& Phase, const int tStep, const std::string& h5FileName = "");///< Writes the grain statistics to TextData, optionally to h5FileName written by rank 0 (collective)
+    static void WriteGrainsStatistics(const PhaseField& Phase, const int tStep, H5Interface& H5);///< Writes the grain statistics to TextData and the blocks of the grain graph to the open file of H5, in parallel with a parallel HDF5 library (collective)
+    static void WriteGrainGraph(const PhaseField& Phase, const int tStep,
+                                H5Interface& H5, const bool CubicSymmetry = false);///< Writes the edge list (COO) and edge features of the grain graph to the open file of H5 (collective)
     static void WriteGlobalFeatures(PhaseField& Phase, const DoubleObstacle& DO, H5Interface& H5, const RunTimeControl& RTC, const InterfaceProperties& IP);
 
-    static void GrainSizeDistribution();
-    static void GrainTopologyStatistics();
-    static void GrainsSurfaceArea(const PhaseField& Phase);                     ///< Calculates approximate grains surface area.
+    static void GrainSizeDistribution(const PhaseField& Phase, const int tStep, const size_t Nbins = 20);///< Appends the histogram of the grain volumes relative to the mean (bins up to 3) to TextData/GrainSizeDistribution.dat (collective)
+    static void GrainTopologyStatistics(const PhaseField& Phase, const int tStep);///< Appends the histogram of the number of neighbours per grain to TextData/GrainTopology.dat, uses Phase.Topology if it is maintained incrementally (collective)
+    static std::vector<double> GrainsSurfaceArea(const PhaseField& Phase);      ///< Calculates approximate grains surface area (collective)
+    static void GrainConnectivityStatistics(const PhaseField& Phase, const BoundaryConditions& BC, const int tStep);///< Appends the number of grains, of their connected parts and of disconnected grains to TextData/GrainConnectivity.dat (collective)
 
     static dVector3 FindValuePosition(PhaseField& Phi, size_t index, double value, dVector3 start_position, dVector3 direction, double tolerance = 1.0e-4);
+
+ private:
+    static void WriteGrainTopology(const std::vector<double>& Histogram, const int tStep);///< Appends the neighbour count histogram to TextData/GrainTopology.dat
+    static Quaternion MajorityOrientation(const PhaseField& Phase,
+                                          const SymmetryVariants* SV,
+                                          const long int i, const long int j,
+                                          const long int k, size_t& pIndex,
+                                          double& value);                       ///< Normalized orientation (with the variant rotation if SV is given), phase index and value of the majority phase field in a cell
+    static void WriteEBSDText(const PhaseField& Phase,
+                              const SymmetryVariants* SV, const int tStep,
+                              const char Axis, const int Position,
+                              const double scale);                              ///< Common implementation of WriteEBSDDataQuaternions*(), Axis = 0 writes the entire domain
+    static std::vector<std::array<float,5>> EBSDPoints(const PhaseField& Phase,
+                                                       const SymmetryVariants* SV);///< Phase index (+1) and quaternion per cell in (i,j,k) row major order
 };
 
 }
@@ -0,0 +1,74 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+
+#ifndef MISORIENTATIONCACHE_H
+#define MISORIENTATIONCACHE_H
+
+#include "Includes.h"
+#include <unordered_map>
+
+namespace openphase
+{
+
+/* Per grain pair cache of the cubic disorientation. The symmetry reduction
+over the 24 rotations of the cubic group is evaluated once per grain pair and
+reused for every interface cell of that pair until one of the two orientations
+changes. Each record keeps the orientations it was computed from, a lookup
+with different orientations (rotated or recycled grain) recomputes the entry.
+Every OpenMP thread owns a separate table, Get() is therefore lock-free and
+can be called from parallel cell loops. Threads beyond the number of tables
+compute the value directly. */
+
+class OP_EXPORTS MisorientationCache
+{
+ public:
+    struct Entry
+    {
+        double Angle = 0.0;                                                     ///< Disorientation angle in radians
+        dVector3 Axis {};                                                       ///< Disorientation axis in the standard triangle
+    };
+
+    MisorientationCache(void);
+
+    Entry Get(const size_t indexA, const Quaternion& OrientationA,
+              const size_t indexB, const Quaternion& OrientationB) const;       ///< Returns the disorientation of grains A and B
+    void Clear(void);                                                           ///< Removes all cached entries
+
+    size_t MaxEntries = 1 << 16;                                                ///< Entries per thread table before it is flushed
+
+ private:
+    struct Record
+    {
+        std::array<double,4> OrientationA;                                      ///< Orientation of the smaller grain index
+        std::array<double,4> OrientationB;                                      ///< Orientation of the larger grain index
+        Entry Value;                                                            ///< Cached disorientation
+    };
+    mutable std::vector<std::unordered_map<uint64_t, Record>> Tables;           ///< One table per OpenMP thread
+};
+
+}// namespace openphase
+#endif
@@ -0,0 +1,70 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef PERFORMANCECOUNTERS_H
+#define PERFORMANCECOUNTERS_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Hardware performance counters of the TimeInfo regions. They are read with
+PAPI if OpenPhase is compiled with PAPI support (make SETTINGS="papi" or
+cmake -DENABLE_PAPI=ON), otherwise no counters are available. Each OpenMP
+thread counts in its own PAPI event set and the counts of the threads are
+summed, which requires a parallel region per read outside of parallel
+regions: timed regions should therefore enclose whole kernels, not single
+loop iterations. Events the processor does not support are skipped. The
+memory traffic is estimated from the last level cache misses times the
+cache line size. */
+
+class OP_EXPORTS PerformanceCounters
+{
+ public:
+    static constexpr auto thisclassname = "PerformanceCounters";                ///< Object's implementation class name
+
+    enum Events                                                                 ///< Counted events
+    {
+        Cycles,                                                                 ///< Core cycles
+        Instructions,                                                           ///< Retired instructions
+        FLOPs,                                                                  ///< Double precision floating point operations
+        CacheMisses,                                                            ///< Last level cache misses
+        Nevents
+    };
+    using Values_t = std::array<long long, Nevents>;                            ///< Counts of all events
+    static constexpr const char* EventNames[Nevents] =
+        {"cycles", "instructions", "flops", "cache_misses"};                    ///< Event names in the exports
+    static constexpr double CacheLineSize = 64.0;                               ///< Bytes moved per cache miss
+
+    static bool Start(void);                                                    ///< Starts the counters on all threads, returns false if they are not available
+    static bool Enabled(void);                                                  ///< True if the counters are running
+    static bool Available(const Events Event);                                  ///< True if Event is counted
+    static Values_t Read(void);                                                 ///< Counts since Start() summed over the threads
+};
+
+}// namespace openphase
+#endif
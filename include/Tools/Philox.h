@@ -0,0 +1,110 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <cstdint>
+#include <limits>
+
+namespace openphase
+{
+
+/* Counter-based random number generator Philox-4x32-10 (Salmon et al.,
+"Parallel random numbers: as easy as 1, 2, 3", SC11). A stream is fully
+determined by the seed, the stream number and the index, e.g. of a draw or a
+grid cell, so independent streams can be evaluated in any order, by any
+thread or rank, and still give the same numbers. The class satisfies the
+UniformRandomBitGenerator requirements and can drive the std distributions. */
+
+class Philox4x32                                                                ///< Counter-based random bit generator with independent streams
+{
+ public:
+    typedef uint32_t result_type;
+
+    Philox4x32(const uint64_t Seed, const uint32_t Stream, const uint64_t Index) ///< Stream "Stream" at position "Index" of the generator keyed by "Seed"
+    {
+        Key[0] = uint32_t(Seed);
+        Key[1] = uint32_t(Seed >> 32);
+        Counter[0] = uint32_t(Index);
+        Counter[1] = uint32_t(Index >> 32);
+        Counter[2] = Stream;
+        Counter[3] = 0;
+        Used = 4;
+    }
+
+    static constexpr result_type min()                                          ///< Smallest generated value
+    {
+        return 0;
+    }
+    static constexpr result_type max()                                          ///< Largest generated value
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()()                                                    ///< Next 32 random bits of the stream
+    {
+        if(Used == 4)
+        {
+            Generate(Counter, Key, Block);
+            Counter[3]++;
+            Used = 0;
+        }
+        return Block[Used++];
+    }
+
+    static void Generate(const uint32_t Ctr[4], const uint32_t Key[2], uint32_t Out[4]) ///< Ten Philox rounds of the counter "Ctr" with the key "Key"
+    {
+        uint32_t C[4] = {Ctr[0], Ctr[1], Ctr[2], Ctr[3]};
+        uint32_t K[2] = {Key[0], Key[1]};
+        for(int round = 0; round < 10; round++)
+        {
+            const uint64_t P0 = uint64_t(0xD2511F53u)*C[0];
+            const uint64_t P1 = uint64_t(0xCD9E8D57u)*C[2];
+            const uint32_t Hi0 = uint32_t(P0 >> 32);
+            const uint32_t Hi1 = uint32_t(P1 >> 32);
+            C[0] = Hi1 ^ C[1] ^ K[0];
+            C[1] = uint32_t(P1);
+            C[2] = Hi0 ^ C[3] ^ K[1];
+            C[3] = uint32_t(P0);
+            K[0] += 0x9E3779B9u;
+            K[1] += 0xBB67AE85u;
+        }
+        Out[0] = C[0];
+        Out[1] = C[1];
+        Out[2] = C[2];
+        Out[3] = C[3];
+    }
+
+ private:
+    uint32_t Key[2];
+    uint32_t Counter[4];
+    uint32_t Block[4];
+    int Used;
+};
+
+}// namespace openphase
+#endif
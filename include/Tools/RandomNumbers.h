@@ -0,0 +1,133 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef RANDOMNUMBERS_H
+#define RANDOMNUMBERS_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "Tools/Philox.h"
+
+namespace openphase
+{
+
+/* Central counter-based random number service. Every number is a pure
+function of (seed, stream, cell, step, draw): the seed and the stream select
+the Philox key, the cell index, the time step and the draw form the counter.
+A stochastic kernel can therefore draw its numbers in any order, with any
+number of threads and MPI processes, and still reproduce the same field.
+Modules use their own stream numbers, the cell is usually a global (not
+rank local) cell or object index. Two uniform or two normal draws share one
+Philox block, Generator(stream, cell, step) returns the bit stream behind
+the draws of a triple for use with the std distributions. */
+
+class RandomNumbers                                                             ///< Counter-based random numbers keyed by seed, stream, cell and step
+{
+ public:
+    RandomNumbers(const uint64_t locSeed = 0) : Seed(locSeed){};
+
+    Philox4x32 Generator(const uint32_t Stream, const uint64_t Cell,
+                         const uint32_t Step) const                             ///< Generator of all draws of a (stream, cell, step) triple
+    {
+        return Philox4x32(StreamKey(Stream), Step, Cell);
+    }
+    double Uniform(const uint32_t Stream, const uint64_t Cell,
+                   const uint32_t Step, const uint32_t Draw = 0) const          ///< Uniform random number in (0,1)
+    {
+        uint32_t Block[4];
+        Generate(StreamKey(Stream), Cell, Step, Draw/2, Block);
+        return ToUniform(Block[2*(Draw%2)], Block[2*(Draw%2) + 1]);
+    }
+    double Normal(const uint32_t Stream, const uint64_t Cell,
+                  const uint32_t Step, const uint32_t Draw = 0) const           ///< Standard normal random number (Box-Muller)
+    {
+        uint32_t Block[4];
+        Generate(StreamKey(Stream), Cell, Step, Draw/2, Block);
+        return ToNormal(Block, Draw%2);
+    }
+    void Uniform(const uint32_t Stream, const uint64_t FirstCell,
+                 const uint32_t Step, const size_t N, double* Result,
+                 const uint32_t Draw = 0) const                                 ///< Result[n] = Uniform(Stream, FirstCell + n, Step, Draw) for n < N
+    {
+        const uint64_t Key = StreamKey(Stream);
+        #pragma omp simd
+        for(size_t n = 0; n < N; n++)
+        {
+            uint32_t Block[4];
+            Generate(Key, FirstCell + n, Step, Draw/2, Block);
+            Result[n] = ToUniform(Block[2*(Draw%2)], Block[2*(Draw%2) + 1]);
+        }
+    }
+    void Normal(const uint32_t Stream, const uint64_t FirstCell,
+                const uint32_t Step, const size_t N, double* Result,
+                const uint32_t Draw = 0) const                                  ///< Result[n] = Normal(Stream, FirstCell + n, Step, Draw) for n < N
+    {
+        const uint64_t Key = StreamKey(Stream);
+        #pragma omp simd
+        for(size_t n = 0; n < N; n++)
+        {
+            uint32_t Block[4];
+            Generate(Key, FirstCell + n, Step, Draw/2, Block);
+            Result[n] = ToNormal(Block, Draw%2);
+        }
+    }
+
+    uint64_t Seed;                                                              ///< Seed of all streams
+
+ private:
+    uint64_t StreamKey(const uint32_t Stream) const                             ///< Philox key of a stream
+    {
+        uint64_t x = Seed ^ (uint64_t(Stream) << 32 | Stream);
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30))*0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27))*0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+    static void Generate(const uint64_t Key, const uint64_t Cell,
+                         const uint32_t Step, const uint32_t Block,
+                         uint32_t Out[4])                                       ///< Random block "Block" of a (key, cell, step) triple
+    {
+        const uint32_t K[2] = {uint32_t(Key), uint32_t(Key >> 32)};
+        const uint32_t C[4] = {uint32_t(Cell), uint32_t(Cell >> 32), Step, Block};
+        Philox4x32::Generate(C, K, Out);
+    }
+    static double ToUniform(const uint32_t Hi, const uint32_t Lo)               ///< 53 bit uniform number in (0,1) of two random words
+    {
+        const uint64_t Bits = (uint64_t(Hi) << 32 | Lo) >> 11;
+        return (double(Bits) + 0.5)*(1.0/9007199254740992.0);
+    }
+    static double ToNormal(const uint32_t Block[4],
+                           const uint32_t Half)                                 ///< Cosine (Half = 0) or sine (Half = 1) Box-Muller branch of a block
+    {
+        const double r   = std::sqrt(-2.0*std::log(ToUniform(Block[0], Block[1])));
+        const double phi = 2.0*3.14159265358979323846*ToUniform(Block[2], Block[3]);
+        return r*(Half ? std::sin(phi) : std::cos(phi));
+    }
+};
+
+}// namespace openphase
+#endif
@@ -0,0 +1,98 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef REDUCTIONBATCH_H
+#define REDUCTIONBATCH_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Fused global reductions. Each OP_MPI_Allreduce is a latency bound global
+synchronization, reducing several scalars one after another multiplies that
+latency. A ReductionBatch collects the local values of a computation, Start()
+packs them into one buffer per operation (minima are negated and reduced as
+maxima) and issues at most two non-blocking reductions, Finish() waits for
+them and writes the global values back to the registered addresses. Local
+work can overlap the reductions between Start() and Finish(), Reduce() does
+both at once. The registered values must stay valid until Finish(), after
+which the batch is empty and can be reused. In serial mode the values are
+left unchanged. ReproducibleSum accumulators are reduced exactly by summing
+their digits as integers, the result does not depend on the order in which
+the ranks are combined. With -DDETERMINISTIC_REDUCTIONS the double sums are
+reduced the same way. Usage:
+
+    ReductionBatch Batch;
+    Batch.Min(&Tmin);
+    Batch.Max(&Tmax);
+    Batch.Sum(&Tavg);
+    Batch.Sum(NpointsAB.data(), NpointsAB.size());
+    Batch.Reduce();                                                          */
+
+class OP_EXPORTS ReductionBatch
+{
+ public:
+    ReductionBatch(){};
+    ~ReductionBatch();
+
+    void Sum(double* values, const size_t count = 1);                           ///< Registers count values for a global sum
+    void Sum(ReproducibleSum* values, const size_t count = 1);                  ///< Registers count accumulators for an exact global sum
+    void Max(double* values, const size_t count = 1);                           ///< Registers count values for a global maximum
+    void Min(double* values, const size_t count = 1);                           ///< Registers count values for a global minimum
+
+    void Start(void);                                                           ///< Issues the reductions of all registered values (collective)
+    void Finish(void);                                                          ///< Waits for the reductions and writes the results back
+    void Reduce(void)                                                           ///< Reduces all registered values (collective)
+    {
+        Start();
+        Finish();
+    }
+    size_t size(void) const                                                     ///< Number of registered values
+    {
+        return SumValues.size() + ExactValues.size() + MaxValues.size();
+    }
+
+ private:
+    std::vector<double*> SumValues;                                             ///< Addresses of the values to sum
+    std::vector<double*> MaxValues;                                             ///< Addresses of the values to maximize
+    std::vector<bool> Negated;                                                  ///< Marks the minima among MaxValues
+    std::vector<ReproducibleSum*> ExactValues;                                  ///< Addresses of the accumulators to sum exactly
+    std::vector<ReproducibleSum> Converted;                                     ///< Accumulators of the double sums with DETERMINISTIC_REDUCTIONS
+    std::vector<long long> DigitBuffer;                                         ///< Packed digits of the exact sum
+    std::vector<double> SumBuffer;                                              ///< Packed values of the sum
+    std::vector<double> MaxBuffer;                                              ///< Packed values of the maximum
+    void* SumRequest = nullptr;                                                 ///< Request of the pending sum
+    void* MaxRequest = nullptr;                                                 ///< Request of the pending maximum
+    void* DigitRequest = nullptr;                                               ///< Request of the pending exact sum
+
+    ReproducibleSum& Exact(const size_t n)                                      ///< Registered accumulators followed by the converted double sums
+    {
+        return n < ExactValues.size() ? *ExactValues[n] : Converted[n - ExactValues.size()];
+    }
+    bool Started = false;                                                       ///< Reductions have been issued and not finished
+};
+
+}// namespace openphase
+#endif
@@ -0,0 +1,72 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STATUSMONITOR_H
+#define STATUSMONITOR_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Machine readable progress of a running simulation for batch schedulers.
+Every Interval time steps the status file is replaced atomically (written to
+FileName.tmp and renamed) by a JSON object with the current time step and
+simulation time, dt, the time steps per second averaged over the last Window
+updates, the estimated time to reach the last time step, the wall clock time
+of the update, the run time fractions of the sections of the active TimeInfo
+and the resident memory (maximum over the MPI ranks). A stalled or slowed
+down job is detected from the age of "updated_unix" or from "steps_per_s".
+Optionally Command is executed on rank 0 after each update with the status
+file name as argument, e.g. to push it to a monitoring server
+("curl -s -T" or a script ending with "&" to run in the background).
+Update() is collective in MPI parallel mode, RunTimeControl calls it from
+IncrementTimeStep() if $StatusInterval is set. */
+
+class OP_EXPORTS StatusMonitor
+{
+ public:
+    void Initialize(const std::string locFileName, const std::string locTitle,
+                    const int locInterval, const int locWindow,
+                    const std::string locCommand);                              ///< Sets the status file, title, update interval (0 disables), averaging window and push command
+    bool Due(const int tStep) const                                             ///< Returns true if an update is due at the given time step
+    {
+        return Interval > 0 and tStep % Interval == 0;
+    }
+    void Update(const int tStep, const int nSteps, const double SimulationTime,
+                const double dt, const bool Stopping);                          ///< Writes the status after time step tStep of nSteps (collective)
+
+    int Interval = 0;                                                           ///< Update interval in time steps, 0 disables the status file
+    int Window = 10;                                                            ///< Number of updates the step rate is averaged over
+    std::string FileName;                                                       ///< Status file
+    std::string Title;                                                          ///< Simulation title
+    std::string Command;                                                        ///< Command executed after each update, empty if none
+
+ private:
+    std::vector<std::pair<double, int>> Samples;                                ///< Wall time and time step of the last Window + 1 updates
+    double StartTime = -1.0;                                                    ///< Wall time of the first update
+    int StartStep = 0;                                                          ///< Time step of the first update
+};
+
+}// namespace openphase
+#endif
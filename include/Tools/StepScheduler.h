@@ -0,0 +1,146 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef STEPSCHEDULER_H
+#define STEPSCHEDULER_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+/* Runs the module updates of a time step as a graph of stages. Each stage
+declares the objects (fields, modules) it reads and writes, a stage depends on
+every earlier stage which writes an object it reads or writes, or which reads
+an object it writes. Stages without mutual dependencies are grouped into
+levels, the stages of a level run concurrently, each with its own team of
+OpenMP threads for its parallel loops (nested parallelism):
+
+    StepScheduler Step;
+    Step.AddStage("Interface properties", [&]{IP.Set(Phi, Tx, BC);},
+                  {&Phi, &Tx, &BC}, {&IP});
+    Step.AddStage("Chemical diffusion", [&]{DF.SolveDiffusion(Phi, Cx, Tx, BC, RTC.dt);},
+                  {&Phi, &Tx, &BC}, {&Cx, &DF});
+    Step.AddStage("Curvature", [&]{DO.CalculatePhaseFieldIncrements(Phi, IP, dG);},
+                  {&IP}, {&Phi, &dG});
+    ...
+    for(RTC.tStep = ...) Step.Run();
+
+The threads are divided among the stages of a level in proportion to their
+weights, the team sizes only depend on the stage graph and the number of
+threads. Conflicting stages are always executed in declaration order, so the
+results do not depend on the execution order of the concurrent stages and are
+reproducible from run to run. Sequential = true (and the MPI build, where the
+stages communicate) executes all stages one after another in declaration order
+with all threads, the reference for checking the declared dependencies.
+
+Boundary conditions of an object are registered as separate stages by
+AddBoundaryConditions(). Such a stage is redundant if an earlier boundary
+stage of the same object exists in the step and no stage in between writes the
+object, redundant stages are skipped (SkipRedundantBoundaryConditions). Reads
+which access the neighbours of a cell are declared by StencilReads(). Two
+consecutive stages are reported as fusion candidates if the second one does not
+read the results of the first one through a stencil and does not write an
+object the first one reads through a stencil, i.e. both could be done in a
+single sweep without a halo exchange in between. Each executed stage is timed
+as a TimeInfo region with its name. */
+
+class OP_EXPORTS StepScheduler                                                  ///< Concurrent execution of independent stages of a time step
+{
+ public:
+    static constexpr auto thisclassname = "StepScheduler";                      ///< Object's implementation class name
+
+    typedef std::function<void(void)> Stage_t;                                  ///< Body of a stage
+
+    size_t AddStage(const std::string& Name, Stage_t Body,
+                    const std::vector<const void*>& Reads,
+                    const std::vector<const void*>& Writes,
+                    const double Weight = 1.0);                                 ///< Appends a stage, returns its index
+    size_t AddBoundaryConditions(const std::string& Name, Stage_t Body,
+                                 const void* Object);                           ///< Appends a stage setting the boundary conditions of Object, returns its index
+    void StencilReads(const size_t stage,
+                      const std::vector<const void*>& Objects);                 ///< Declares reads of a stage which access the neighbours of a cell
+    void Clear(void);                                                           ///< Removes all stages
+    void Run(void);                                                             ///< Executes all stages once
+    void Report(void);                                                          ///< Writes the levels, team sizes and accumulated wall times of the stages, the skipped boundary stages and the fusion candidates to the console
+    std::vector<std::pair<size_t,size_t>> FusionCandidates(void) const;         ///< Pairs of consecutive stages which could be fused into a single sweep
+    bool Redundant(const size_t stage)                                          ///< True if the stage is a redundant boundary stage
+    {
+        Build();
+        return Stages[stage].Redundant;
+    }
+
+    size_t NumberOfStages(void) const                                           ///< Number of stages
+    {
+        return Stages.size();
+    }
+    size_t NumberOfLevels(void)                                                 ///< Number of levels of concurrently executed stages
+    {
+        Build();
+        return Levels.size();
+    }
+    size_t Level(const size_t stage)                                            ///< Level of a stage
+    {
+        Build();
+        return Stages[stage].Level;
+    }
+
+    bool Sequential = false;                                                    ///< If true, stages are executed one after another in declaration order
+    bool SkipRedundantBoundaryConditions = true;                                ///< If true, redundant boundary stages are not executed
+
+ private:
+    struct Stage
+    {
+        std::string Name;                                                       ///< Name used in Report() and error messages
+        Stage_t Body;                                                           ///< Work of the stage
+        std::vector<const void*> Reads;                                         ///< Objects read by the stage
+        std::vector<const void*> Writes;                                        ///< Objects written by the stage
+        std::vector<const void*> Stencil;                                       ///< Objects read through a stencil
+        const void* Boundary = nullptr;                                         ///< Object of a boundary stage, nullptr for other stages
+        bool Redundant = false;                                                 ///< True for a boundary stage of an unchanged object
+        double Weight = 1.0;                                                    ///< Relative share of the threads of its level
+        size_t Level = 0;                                                       ///< Longest dependency chain leading to the stage, redundant boundary stages excluded
+        int TeamSize = 1;                                                       ///< Threads of the stage if run concurrently
+        double WallTime = 0.0;                                                  ///< Accumulated wall time of the stage in seconds
+        size_t Calls = 0;                                                       ///< Number of executions
+    };
+
+    std::vector<Stage> Stages;                                                  ///< Stages in declaration order
+    std::vector<std::vector<size_t>> Levels;                                    ///< Stages of each level in declaration order
+    bool Built = false;                                                         ///< True if Levels, team sizes and redundant boundary stages are up to date
+    int Threads = 0;                                                            ///< Number of threads the team sizes were calculated for
+    bool Skipping = true;                                                       ///< SkipRedundantBoundaryConditions the levels were calculated for
+
+    void Build(void);                                                           ///< Finds the redundant boundary stages, calculates the levels and team sizes
+    bool Skipped(const Stage& locStage) const                                   ///< True if the stage is not executed
+    {
+        return locStage.Redundant and SkipRedundantBoundaryConditions;
+    }
+    void RunStage(Stage& locStage);                                             ///< Executes and times a stage
+};
+
+}// namespace openphase
+#endif
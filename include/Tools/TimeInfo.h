@@ -28,11 +28,61 @@
 #define TIMEINFO_H
 
 #include "Includes.h"
+#include "Tools/PerformanceCounters.h"
 
 namespace openphase
 {
 
 class Settings;
+
+/* Wall clock profiler. The time steps of the main loop are divided into
+sections by SetTimeStamp(), each section accumulating the wall and CPU time
+since the previous stamp. Independently, any scope, also inside the modules,
+can be timed as a named region:
+
+    {
+        TimeInfo::Region Guard("Solve heat diffusion");
+        ...
+    }
+
+Regions opened within other regions are recorded as "Outer/Inner", with the
+number of calls and the total, minimum and maximum time per call over the
+whole run. Only the master thread records regions, regions opened by other
+OpenMP threads are ignored. The summaries and the CSV/JSON exports are
+collective in MPI parallel mode and add the minimum, mean and maximum over
+the ranks, which shows the load imbalance; only regions present on rank 0
+are reported. If OpenPhase is compiled with PAPI support, the regions also
+record hardware counters (see PerformanceCounters.h), reported as sums over
+the ranks together with the instructions per cycle and the GFLOP/s and GB/s
+rates relative to the slowest rank.
+
+MPI communication is timed separately by the TimeInfo::Communication guard,
+which the halo exchange of BoundaryConditions and the transposes of
+PencilFFT use. Communications are accumulated by name regardless of the
+open regions and reported with the bytes sent, summed over the ranks.
+
+Load imbalance: the time a rank spends blocked in MPI (OP_MPI_Wait() and the
+collectives of the MPI wrapper) is subtracted from the section and region
+times, the remainder is the busy time of the rank. The ratio of the maximum
+to the mean busy time over the ranks is the rank imbalance factor. Loops over
+the interface cells of the main modules call CountIteration(), the ratio of
+the maximum to the mean iteration count over the OpenMP threads is the thread
+imbalance factor (the maximum over the ranks). Both are reported for the
+whole run by the summaries and exports, and per time step interval by
+WriteLoadImbalance().
+
+Timeline trace: after StartTrace() the begin and end of every section,
+region and communication is recorded with its thread in a ring buffer of
+preallocated events per thread, the oldest events being overwritten. In
+trace mode regions are also recorded on the worker threads (for the trace
+only). An event costs two clock reads and the copy of its name (truncated to
+TraceNameLength characters), so tracing can stay on in production runs. At
+exit, or by WriteTrace(), each rank writes its events in the Chrome trace
+format, viewable with Perfetto (ui.perfetto.dev) or chrome://tracing. The
+times are relative to a common origin set in StartTrace(), in MPI parallel
+mode the files of the ranks (pid = rank) can be merged with
+jq -s '{traceEvents: map(.traceEvents) | add}' Trace_*.json > Trace.json */
+
 class OP_EXPORTS TimeInfo
 {
  public:
@@ -45,39 +95,186 @@ class OP_EXPORTS TimeInfo
     void SetTimeStamp(const std::string Message);
     void SkipToHere(void);
     void Reset(void);
-    void PrintWallClockSummary(void);
-    void PrintCPUClockSummary(void) const
+    void PrintWallClockSummary(void);                                           ///< Prints the wall time per time step of the sections since the last summary and resets them
+    void PrintCPUClockSummary(void);                                            ///< Prints the CPU time per time step of the sections since the last summary and resets them
+    void PrintFullSummary(void);                                                ///< Prints the sections and regions of the whole run with the spread over MPI ranks (collective)
+    void WriteCSV(const std::string FileName) const;                            ///< Writes the sections and regions of the whole run as CSV (collective)
+    void WriteJSON(const std::string FileName) const;                           ///< Writes the sections and regions of the whole run as JSON (collective)
+    void WritePerformance(const std::string FileName, const long int Cells) const; ///< Writes the throughput metrics compared by benchmarks/PerfCompare.sh (collective)
+    void WriteLoadImbalance(const std::string FileName, const int tStep);       ///< Appends the imbalance factors of the sections since the last call (collective)
+
+    static void CountIteration(void)                                            ///< Counts one loop iteration of the calling OpenMP thread
     {
-        ConsoleOutput::WriteWarning("TimeInfo::PrintCPUClockSummary() not yet implemented.",
-                "TimeInfo", "PrintCPUClockSummary()");
+        const int Thread = omp_get_thread_num();
+        if (Thread < MaxThreads) ThreadIterations[Thread].Count++;
+    }
+
+    class OP_EXPORTS Region                                                     ///< Times the enclosing scope as a named profiling region
+    {
+     public:
+        explicit Region(const std::string& Name);
+        ~Region();
+        Region(const Region&) = delete;
+        Region& operator=(const Region&) = delete;
+     private:
+        bool Active;                                                            ///< True if the region is recorded by this thread
+        bool Traced;                                                            ///< True if the region is traced by a worker thread
+        std::string Name;                                                       ///< Region name, worker threads in trace mode only
+        double Start;                                                           ///< Wall time at the region entry
+        double StartWait;                                                       ///< MPI wait time at the region entry
+        std::vector<size_t> StartIterations;                                    ///< Thread iteration counts at the region entry
+        PerformanceCounters::Values_t StartCounters;                            ///< Hardware counters at the region entry
     };
-    void PrintFullSummary(void) const
+    class OP_EXPORTS Communication                                              ///< Times the enclosing scope as MPI communication
     {
-        ConsoleOutput::WriteWarning("TimeInfo::PrintFullSummary() not yet implemented.",
-                "TimeInfo", "PrintFullSummary()");
+     public:
+        explicit Communication(const char* Name);
+        ~Communication();
+        Communication(const Communication&) = delete;
+        Communication& operator=(const Communication&) = delete;
+        double Bytes = 0.0;                                                     ///< Bytes sent by this rank, set by the caller
+     private:
+        const char* Name;                                                       ///< Communication name
+        bool Active;                                                            ///< True if the communication is recorded by this thread
+        double Start;                                                           ///< Wall time at the scope entry
     };
+    static void ResetRegions(void);                                             ///< Discards the recorded regions and communication times
+
+    static void StartTrace(const size_t Capacity, const std::string FileName);  ///< Starts the timeline trace with Capacity events per thread, written to FileName at exit (collective)
+    static void WriteTrace(const std::string FileName);                         ///< Writes the traced events of this rank as Chrome trace JSON
+    static std::vector<std::pair<std::string, double>> ActiveSections(void);    ///< Sections of the most recently initialized timer with their fraction of the run time
+    static bool Tracing(void)                                                   ///< True if the timeline trace is recorded
+    {
+        return TraceEnabled;
+    }
 
  protected:
  private:
     std::string thisclassname;
     bool verbose;
 
-    double GetTime(void)
+    static double GetTime(void)
     {
 #ifdef _OPENMP
         return omp_get_wtime();
 #else
-        return clock()/CLOCKS_PER_SEC;
+        return double(clock())/CLOCKS_PER_SEC;
 #endif
     }
+    static double GetCPUTime(void)                                              ///< Processor time of all threads of the process
+    {
+        return double(clock())/CLOCKS_PER_SEC;
+    }
+
+    static double WaitTime(void)                                                ///< Time this rank spent blocked in MPI so far
+    {
+#ifdef MPI_PARALLEL
+        return OP_MPI_WaitTime();
+#else
+        return 0.0;
+#endif
+    }
+
+    static constexpr int MaxThreads = 256;                                      ///< Number of threads with an iteration counter
+    struct alignas(64) ThreadCounter                                            ///< Iteration counter of a thread on its own cache line
+    {
+        size_t Count;
+    };
+    inline static std::array<ThreadCounter, MaxThreads> ThreadIterations;       ///< Loop iterations of each thread, see CountIteration()
+    static std::vector<size_t> IterationCounts(void);                           ///< Current iteration counts of the threads
+
+    static constexpr size_t TraceNameLength = 46;                               ///< Maximum length of the traced names
+    struct TraceEvent                                                           ///< Traced section, region or communication
+    {
+        double Begin;                                                           ///< Wall time at the begin
+        double End;                                                             ///< Wall time at the end
+        char Kind;                                                              ///< 'S'ection, 'R'egion or 'C'ommunication
+        char Name[TraceNameLength + 1];                                         ///< Null terminated name
+    };
+    struct alignas(64) TraceBuffer                                              ///< Ring buffer of the events of a thread
+    {
+        std::vector<TraceEvent> Events;                                         ///< Preallocated events
+        size_t Recorded;                                                        ///< Number of events recorded, the newest one at (Recorded - 1) % Events.size()
+    };
+    inline static std::array<TraceBuffer, MaxThreads> TraceBuffers;             ///< Event buffers of the threads
+    inline static bool TraceEnabled = false;                                    ///< True after StartTrace()
+    inline static double TraceOrigin = 0.0;                                     ///< Wall time of the trace origin
+    inline static std::string TraceFile;                                        ///< File written at exit
+    static void Trace(const char Kind, const char* Name, const double Begin,
+                      const double End);                                        ///< Records an event of the calling thread
 
     double ConvertTime(double Time)
     {
         return Time/double(counter);
     }
 
-    std::map<std::string, double> TimeMap;
+    struct Section                                                              ///< Accumulated times of a section
+    {
+        double Wall = 0.0;                                                      ///< Wall time since the last summary
+        double CPU = 0.0;                                                       ///< CPU time since the last summary
+        double RunWall = 0.0;                                                   ///< Wall time of the whole run
+        double RunCPU = 0.0;                                                    ///< CPU time of the whole run
+        double RunWait = 0.0;                                                   ///< MPI wait time of the whole run
+        size_t Calls = 0;                                                       ///< Number of time stamps of the whole run
+        std::vector<size_t> RunIterations;                                      ///< Iterations of each thread over the whole run
+        double IntervalWall = 0.0;                                              ///< Wall time since the last WriteLoadImbalance()
+        double IntervalWait = 0.0;                                              ///< MPI wait time since the last WriteLoadImbalance()
+        std::vector<size_t> IntervalIterations;                                 ///< Iterations of each thread since the last WriteLoadImbalance()
+    };
+    struct RegionStatistics                                                     ///< Accumulated times of a region
+    {
+        size_t Calls = 0;                                                       ///< Number of calls
+        double Total = 0.0;                                                     ///< Total wall time
+        double Min = DBL_MAX;                                                   ///< Shortest call
+        double Max = 0.0;                                                       ///< Longest call
+        double Wait = 0.0;                                                      ///< MPI wait time of all calls
+        std::vector<size_t> Iterations;                                         ///< Iterations of each thread in all calls
+        PerformanceCounters::Values_t Counters{};                               ///< Hardware counts of all calls
+    };
+    struct CommStatistics                                                       ///< Accumulated times of a communication
+    {
+        size_t Calls = 0;                                                       ///< Number of calls
+        double Total = 0.0;                                                     ///< Total wall time
+        double Bytes = 0.0;                                                     ///< Bytes sent
+    };
+    struct Statistics                                                           ///< Entry of the run summary
+    {
+        std::string Kind;                                                       ///< "section", "region" or "communication"
+        std::string Name;                                                       ///< Section or region name
+        size_t Calls;                                                           ///< Number of calls on this rank
+        double Total;                                                           ///< Total wall time on this rank
+        double CPU;                                                             ///< Total CPU time on this rank, sections only
+        double Min;                                                             ///< Shortest call on this rank, regions only
+        double Max;                                                             ///< Longest call on this rank, regions only
+        double RankMin;                                                         ///< Minimum of Total over the ranks
+        double RankMean;                                                        ///< Mean of Total over the ranks
+        double RankMax;                                                         ///< Maximum of Total over the ranks
+        std::array<double, PerformanceCounters::Nevents> Counters;              ///< Hardware counts summed over the ranks, regions only
+        double Bytes;                                                           ///< Bytes sent summed over the ranks, communications only
+        double Wait;                                                            ///< MPI wait time, on this rank and then the mean over the ranks
+        double BusyMean;                                                        ///< Mean of Total - Wait over the ranks
+        double BusyMax;                                                         ///< Maximum of Total - Wait over the ranks
+        double ThreadImbalance;                                                 ///< Maximum over the ranks of the thread imbalance factor, 0 without counted iterations
+        std::vector<size_t> Iterations;                                         ///< Iterations of each thread on this rank
+        double RankImbalance(void) const                                        ///< Ratio of the maximum to the mean busy time over the ranks
+        {
+            return (BusyMean > 0.0) ? BusyMax/BusyMean : 1.0;
+        }
+    };
+    std::vector<Statistics> RunStatistics(void) const;                          ///< Sections and regions with the spread over the ranks (collective)
+
+    std::map<std::string, Section> TimeMap;
     double ClockStart;
+    double CPUClockStart;
+    double WaitStart;                                                           ///< MPI wait time at the last time stamp
+    std::vector<size_t> IterationsStart;                                        ///< Thread iteration counts at the last time stamp
+    size_t ImbalanceRecords = 0;                                                ///< Number of WriteLoadImbalance() calls
+    double CPUcounter;                                                          ///< Time steps since the last CPU time summary
+
+    inline static std::map<std::string, RegionStatistics> Regions;              ///< Recorded regions by their full name
+    inline static std::vector<std::string> RegionStack;                         ///< Full names of the open regions of the master thread
+    inline static std::map<std::string, CommStatistics> Communications;         ///< Recorded communications by their name
+    inline static const TimeInfo* ActiveTimer = nullptr;                        ///< Most recently initialized timer, see ActiveSections()
 
     std::string TimerName;
     double counter;
@@ -44,6 +44,62 @@ enum class UserDrivingForceModes
     Formula                                                                     ///< User driving force using constant value and/or temperature dependent formula
 };
 
+/* Batched evaluation of user defined driving forces. Instead of being called
+for every cell and phase pair, the user function receives a tile with the
+phase pairs of up to BatchTileCells interface cells in structure of arrays
+layout and fills the driving forces of the whole tile, which lets the
+compiler vectorize the user thermodynamics. The driving forces are added to
+DrivingForce::Force with add_raw() like the built-in modes. Two ways of
+registration exist: a runtime one through the BatchKernel member, and a
+compile-time one passing the kernel directly to the SetDrivingForceBatched()
+template, which allows the kernel to be inlined:
+
+    UDF.SetDrivingForceBatched(Phase, dG, &Tx, &Cx,
+        [&](UserDrivingForceTile& Tile)
+        {
+            for(size_t n = 0; n < Tile.Size; n++)
+            {
+                Tile.dG[n] = L*(Tile.T[n] - Teq)/Teq;
+            }
+        });
+
+Input (module @UserDrivingForce):
+
+    $BatchTileCells   Interface cells per tile of the batched evaluation  256 */
+
+struct UserDrivingForceTile                                                     ///< Phase pairs of a tile of interface cells in structure of arrays layout
+{
+    size_t Size  = 0;                                                           ///< Number of phase pair entries in the tile
+    size_t Ncomp = 0;                                                           ///< Number of chemical components, 0 if no composition is given
+    std::vector<iVector3> Position;                                             ///< Cell of each entry
+    std::vector<size_t> IndexA;                                                 ///< Phase field index alpha of each entry
+    std::vector<size_t> IndexB;                                                 ///< Phase field index beta of each entry
+    std::vector<size_t> PhaseA;                                                 ///< Thermodynamic phase of alpha
+    std::vector<size_t> PhaseB;                                                 ///< Thermodynamic phase of beta
+    std::vector<double> FractionA;                                              ///< Phase field value of alpha
+    std::vector<double> FractionB;                                              ///< Phase field value of beta
+    std::vector<double> T;                                                      ///< Temperature of the cell, empty if no temperature is given
+    std::vector<double> MoleFractionsA;                                         ///< Mole fractions of component c in the phase of alpha at [c*Size + n]
+    std::vector<double> MoleFractionsB;                                         ///< Mole fractions of component c in the phase of beta at [c*Size + n]
+    std::vector<double> dG;                                                     ///< Driving forces to be filled by the kernel, zero on entry
+
+    void clear(void)                                                            ///< Empties the tile, keeps the allocated memory
+    {
+        Size = 0;
+        Position.clear();
+        IndexA.clear();
+        IndexB.clear();
+        PhaseA.clear();
+        PhaseB.clear();
+        FractionA.clear();
+        FractionB.clear();
+        T.clear();
+        MoleFractionsA.clear();
+        MoleFractionsB.clear();
+        dG.clear();
+    }
+};
+
 class OP_EXPORTS UserDrivingForce : public OPObject                             ///< User driving force class
 {
  public:
@@ -58,12 +114,30 @@ class OP_EXPORTS UserDrivingForce : public OPObject
     void SetDrivingForce(PhaseField& Phase, DrivingForce& dGab, Temperature& Tx);///< Sets the user provided driving force considering temperature effect
     void SetDrivingForce(PhaseField& Phase, DrivingForce& dGab, Temperature& Tx, Composition& Cx);///< Sets the user provided driving force considering temperature and composition effect
 
+    void SetDrivingForceBatched(PhaseField& Phase, DrivingForce& dGab,
+                                const Temperature* Tx = nullptr,
+                                const Composition* Cx = nullptr);               ///< Adds the driving forces of BatchKernel tile by tile, Tx and Cx are optional
+    template<class Kernel>
+    void SetDrivingForceBatched(PhaseField& Phase, DrivingForce& dGab,
+                                const Temperature* Tx, const Composition* Cx,
+                                Kernel&& kernel) const;                         ///< Adds the driving forces of the kernel tile by tile, the kernel can be inlined
+
+    std::function<void(UserDrivingForceTile&)> BatchKernel;                     ///< Runtime registered kernel of the batched evaluation
+    size_t BatchTileCells;                                                      ///< Interface cells per tile of the batched evaluation
+
     size_t Nphases;
 
     static void SetDrivingForce(PhaseField& Phase, DrivingForce& dGab,
                                 int indexA, int indexB, double dGvalue);        ///< Sets specified driving force for a pair of phase fields
  protected:
  private:
+    size_t NumberOfTiles(const PhaseField& Phase) const;                        ///< Number of tiles of the interface cells
+    void GatherTile(const PhaseField& Phase, const Temperature* Tx,
+                    const Composition* Cx, const size_t Tile,
+                    UserDrivingForceTile& locTile) const;                       ///< Collects the phase pairs of the interface cells of a tile
+    static void ScatterTile(DrivingForce& dGab,
+                            const UserDrivingForceTile& locTile);               ///< Adds the driving forces of a tile
+
     Matrix<UserDrivingForceModes> Mode;
     Matrix<double> Value;
     Matrix<double> Teq;                                                         ///< Equilibrium temperature between pairs of phases
@@ -72,5 +146,28 @@ class OP_EXPORTS UserDrivingForce : public OPObject
     Matrix<double> LatentHeat;                                                  ///< Latent heat values for the driving force formula
 };
 
+template<class Kernel>
+void UserDrivingForce::SetDrivingForceBatched(PhaseField& Phase, DrivingForce& dGab,
+                                              const Temperature* Tx,
+                                              const Composition* Cx,
+                                              Kernel&& kernel) const
+{
+    const long int Ntiles = NumberOfTiles(Phase);
+
+    #pragma omp parallel
+    {
+        UserDrivingForceTile locTile;
+
+        #pragma omp for schedule(dynamic)
+        for(long int t = 0; t < Ntiles; t++)
+        {
+            GatherTile(Phase, Tx, Cx, t, locTile);
+            if(locTile.Size == 0) continue;
+            kernel(locTile);
+            ScatterTile(dGab, locTile);
+        }
+    }
+}
+
 }// namespace openphase
 #endif
@@ -32,6 +32,8 @@
 #include "Settings.h"
 #include "ElasticProperties.h"
 #include "Tools.h"
+#include "OutputField.h"
+#include "OutputRegion.h"
 #include "../external/WinBase64/base64.h"
 #include "../external/miniz.h"
 
@@ -56,15 +58,7 @@ typedef struct
 struct OP_EXPORTS VTK                                                           ///< static class to write VTK data in xml format
 {
 
-    struct Field_t                                                              ///< Short hand for a field's name and function which will be written to file
-    {
-        std::string Name;
-        std::function<std::any(const int, const int, const int)> Function;
-
-        Field_t(const std::string& inp_Name,
-                const std::function<std::any(const int, const int, const int)>& inp_Function) :
-            Name(inp_Name), Function(inp_Function) {};
-    };
+    typedef OutputField Field_t;                                                ///< Short hand for a field's name and function which will be written to file
 
     template <typename T, class function_t>
     static void ForEach (T& buffer,
@@ -85,31 +79,23 @@ struct OP_EXPORTS VTK
             const long int Nx, const  long int Ny, const long int Nz,
             function_t Function)
     {
-        std::vector<float> vdata;
-        //int it = 0;
-        for(int k = 0; k < Nz; ++k)
-        for(int j = 0; j < Ny; ++j)
-        for(int i = 0; i < Nx; ++i)
+        /* Function returns the components of a cell as std::vector<float>,
+        it is called once per cell from several threads */
+        const size_t Ncomp = (Nx*Ny*Nz > 0) ? Function(0,0,0).size() : 0;
+        std::vector<float> vdata(Nx*Ny*Nz*Ncomp);
+        #pragma omp parallel for collapse(2) schedule(static)
+        for(long int k = 0; k < Nz; ++k)
+        for(long int j = 0; j < Ny; ++j)
+        for(long int i = 0; i < Nx; ++i)
         {
-            for (size_t n = 0; n < Function(i,j,k).size(); ++n)
-            vdata.push_back(Function(i,j,k)[n]);
+            const auto Value = Function(i,j,k);
+            const size_t idx = ((k*Ny + j)*Nx + i)*Ncomp;
+            for (size_t n = 0; n < Ncomp; ++n)
+            {
+                vdata[idx + n] = Value[n];
+            }
         }
-        uint32_t datasize = vdata.size()*sizeof(float);
-        size_t cdatasize;
-        float* data = new float[vdata.size()];
-        memcpy(data,vdata.data(),datasize);
-        char* cpoints = VTK::compress_data(&cdatasize,(const char*)data,datasize);
-        header_singleblock b64header = { 1, datasize, datasize, static_cast<unsigned int>(cdatasize)};
-        char* b64string = VTK::encode_b64(cpoints, cdatasize);
-        char* b64lenstring = VTK::encode_b64((const char*)&b64header, sizeof(header_singleblock));
-        buffer << b64lenstring << b64string << std::endl;
-
-        delete[] (data);
-        free (cpoints);
-
-        free (b64string);
-        free (b64lenstring);
-
+        buffer << CompressEncode((const char*)vdata.data(), vdata.size()*sizeof(float)) << std::endl;
         buffer << "</DataArray>" << std::endl;
     }
 
@@ -137,8 +123,8 @@ struct OP_EXPORTS VTK
         // Use type with highest dimensions to write the data to file
         bool check = true;
         for (auto Field : ListOfFields)
-        if (Field.Function(0,0,0).type()==typeid(dMatrix3x3) or
-            Field.Function(0,0,0).type()==typeid(dMatrix6x6))
+        if (Field.ValueType()==typeid(dMatrix3x3) or
+            Field.ValueType()==typeid(dMatrix6x6))
         {
             buffer << "<PointData Tensors= \"TensorData\">\n";
             check = false;
@@ -146,10 +132,10 @@ struct OP_EXPORTS VTK
         }
         if(check)
         for (auto Field : ListOfFields)
-        if (Field.Function(0,0,0).type()==typeid(dVector3) or
-            Field.Function(0,0,0).type()==typeid(dVector6) or
-            Field.Function(0,0,0).type()==typeid(vStress) or
-            Field.Function(0,0,0).type()==typeid(vStrain))
+        if (Field.ValueType()==typeid(dVector3) or
+            Field.ValueType()==typeid(dVector6) or
+            Field.ValueType()==typeid(vStress) or
+            Field.ValueType()==typeid(vStrain))
         {
             buffer << "<PointData Vectors= \"VectorData\">\n";
             check = false;
@@ -161,57 +147,66 @@ struct OP_EXPORTS VTK
         }
         for (auto Field : ListOfFields)
         {
-            if (Field.Function(0,0,0).type() == typeid(int))
+            if (Field.ValueType() == typeid(int))
             {
                 buffer << std::fixed;
                 buffer << std::setprecision(0);
                 WriteFieldHeader(buffer, Field.Name, "Int32");
-                ForEach(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<int>(Field.Function(i,j,k));});
+                const std::vector<int> Values = Field.template Values<int>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i];});
             }
-            else if (Field.Function(0,0,0).type() == typeid(size_t))
+            else if (Field.ValueType() == typeid(size_t))
             {
                 buffer << std::fixed;
                 buffer << std::setprecision(0);
                 WriteFieldHeader(buffer, Field.Name, "UInt64");
-                ForEach(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<size_t>(Field.Function(i,j,k));});
+                const std::vector<size_t> Values = Field.template Values<size_t>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i];});
             }
-            else if (Field.Function(0,0,0).type() == typeid(double))
+            else if (Field.ValueType() == typeid(double))
             {
                 //out << std::scientific; //NOTE: this results in unnecessarily large files
                 buffer << std::defaultfloat;
                 buffer << std::setprecision(precision);
                 WriteFieldHeader(buffer, Field.Name, "Float64");
-                ForEach(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<double>(Field.Function(i,j,k));});
+                const std::vector<double> Values = Field.template Values<double>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i];});
             }
-            else if (Field.Function(0,0,0).type() == typeid(dVector3))
+            else if (Field.ValueType() == typeid(dVector3))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float64", 3);
-                ForEach(buffer,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){return std::any_cast<dVector3>(Field.Function(i,j,k)).write(precision);});
+                const std::vector<dVector3> Values = Field.template Values<dVector3>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].write(precision);});
             }
-            else if (Field.Function(0,0,0).type() == typeid(dVector6))
+            else if (Field.ValueType() == typeid(dVector6))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float64", 6);
-                ForEach(buffer,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){return std::any_cast<dVector6>(Field.Function(i,j,k)).write(precision);});
+                const std::vector<dVector6> Values = Field.template Values<dVector6>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].write(precision);});
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStrain))
+            else if (Field.ValueType() == typeid(vStrain))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float64", 6);
-                ForEach(buffer,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){return std::any_cast<vStrain>(Field.Function(i,j,k)).write(precision);});
+                const std::vector<vStrain> Values = Field.template Values<vStrain>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].write(precision);});
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStress))
+            else if (Field.ValueType() == typeid(vStress))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float64", 6);
-                ForEach(buffer,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){return std::any_cast<vStress>(Field.Function(i,j,k)).write(precision);});
+                const std::vector<vStress> Values = Field.template Values<vStress>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].write(precision);});
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix3x3))
+            else if (Field.ValueType() == typeid(dMatrix3x3))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float64", 9);
-                ForEach(buffer,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){return std::any_cast<dMatrix3x3>(Field.Function(i,j,k)).write(precision);});
+                const std::vector<dMatrix3x3> Values = Field.template Values<dMatrix3x3>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].write(precision);});
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix6x6))
+            else if (Field.ValueType() == typeid(dMatrix6x6))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float64", 36);
-                ForEach(buffer,Nx,Ny,Nz,[&Field, precision](int i,int j,int k){return std::any_cast<dMatrix6x6>(Field.Function(i,j,k)).write(precision);});
+                const std::vector<dMatrix6x6> Values = Field.template Values<dMatrix6x6>(Nx,Ny,Nz);
+                ForEach(buffer,Nx,Ny,Nz,[&Values, Nx, Ny, precision](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].write(precision);});
             }
         }
     }
@@ -226,8 +221,8 @@ struct OP_EXPORTS VTK
         // Use type with highest dimensions to write the data to file
         bool check = true;
         for (auto Field : ListOfFields)
-        if (Field.Function(0,0,0).type()==typeid(dMatrix3x3) or
-            Field.Function(0,0,0).type()==typeid(dMatrix6x6))
+        if (Field.ValueType()==typeid(dMatrix3x3) or
+            Field.ValueType()==typeid(dMatrix6x6))
         {
             buffer << "<PointData Tensors= \"TensorData\">\n";
             check = false;
@@ -235,10 +230,10 @@ struct OP_EXPORTS VTK
         }
         if(check)
         for (auto Field : ListOfFields)
-        if (Field.Function(0,0,0).type()==typeid(dVector3) or
-            Field.Function(0,0,0).type()==typeid(dVector6) or
-            Field.Function(0,0,0).type()==typeid(vStress) or
-            Field.Function(0,0,0).type()==typeid(vStrain))
+        if (Field.ValueType()==typeid(dVector3) or
+            Field.ValueType()==typeid(dVector6) or
+            Field.ValueType()==typeid(vStress) or
+            Field.ValueType()==typeid(vStrain))
         {
             buffer << "<PointData Vectors= \"VectorData\">\n";
             check = false;
@@ -251,60 +246,69 @@ struct OP_EXPORTS VTK
 
         for (auto Field : ListOfFields)
         {
-            if (Field.Function(0,0,0).type() == typeid(int))
+            if (Field.ValueType() == typeid(int))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 1, "binary");
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){
+                const std::vector<int> Values = Field.template Values<int>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){
                 std::vector<float> data;
-                data.push_back(std::any_cast<int>(Field.Function(i,j,k)));
+                data.push_back(Values[(k*Ny + j)*Nx + i]);
                 return data; });
             }
-            else if (Field.Function(0,0,0).type() == typeid(size_t))
+            else if (Field.ValueType() == typeid(size_t))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 1, "binary");
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){
+                const std::vector<size_t> Values = Field.template Values<size_t>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){
                 std::vector<float> data;
-                data.push_back(std::any_cast<size_t>(Field.Function(i,j,k)));
+                data.push_back(Values[(k*Ny + j)*Nx + i]);
                 return data; });
             }
-            else if (Field.Function(0,0,0).type() == typeid(double))
+            else if (Field.ValueType() == typeid(double))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 1, "binary");
                 buffer << std::setprecision(precision) << std::scientific;
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){
+                const std::vector<double> Values = Field.template Values<double>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){
                 std::vector<float> data;
-                data.push_back(std::any_cast<double>(Field.Function(i,j,k)));
+                data.push_back(Values[(k*Ny + j)*Nx + i]);
                 return data; });
             }
-            else if (Field.Function(0,0,0).type() == typeid(dVector3))
+            else if (Field.ValueType() == typeid(dVector3))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 3, "binary");
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<dVector3>(Field.Function(i,j,k)).writeCompressed();});
+                const std::vector<dVector3> Values = Field.template Values<dVector3>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].writeCompressed();});
             }
-            else if (Field.Function(0,0,0).type() == typeid(dVector6))
+            else if (Field.ValueType() == typeid(dVector6))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 6, "binary");
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<dVector6>(Field.Function(i,j,k)).writeCompressed();});
+                const std::vector<dVector6> Values = Field.template Values<dVector6>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].writeCompressed();});
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStrain))
+            else if (Field.ValueType() == typeid(vStrain))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 6, "binary");
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<vStrain>(Field.Function(i,j,k)).writeCompressed();});
+                const std::vector<vStrain> Values = Field.template Values<vStrain>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].writeCompressed();});
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStress))
+            else if (Field.ValueType() == typeid(vStress))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 6, "binary");
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<vStress>(Field.Function(i,j,k)).writeCompressed();});
+                const std::vector<vStress> Values = Field.template Values<vStress>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].writeCompressed();});
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix3x3))
+            else if (Field.ValueType() == typeid(dMatrix3x3))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 9, "binary");
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<dMatrix3x3>(Field.Function(i,j,k)).writeCompressed();});
+                const std::vector<dMatrix3x3> Values = Field.template Values<dMatrix3x3>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].writeCompressed();});
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix6x6))
+            else if (Field.ValueType() == typeid(dMatrix6x6))
             {
                 WriteFieldHeader(buffer, Field.Name, "Float32", 36, "binary");
-                ForEachCompressed(buffer,Nx,Ny,Nz,[&Field](int i,int j,int k){return std::any_cast<dMatrix6x6>(Field.Function(i,j,k)).writeCompressed();});
+                const std::vector<dMatrix6x6> Values = Field.template Values<dMatrix6x6>(Nx,Ny,Nz);
+                ForEachCompressed(buffer,Nx,Ny,Nz,[&Values, Nx, Ny](int i,int j,int k){return Values[(k*Ny + j)*Nx + i].writeCompressed();});
             }
         }
     }
@@ -324,6 +328,29 @@ struct OP_EXPORTS VTK
             const int precision = 16,
             const int resolution = 1);
 
+    /* Raw binary output: the values are written unformatted into the
+    <AppendedData encoding="raw"> section after the XML description, with
+    Compressed = true zlib compressed in blocks. In MPI runs each rank writes
+    its own piece "<name>_<rank>.vts" and rank 0 the index "<name>.pvts". */
+    static void WriteAppended(
+            const std::string Filename,
+            const Settings& locSettings,
+            std::vector<Field_t> ListOfFields,
+            const bool Compressed = false,
+            const int resolution = 1);
+
+    /* Output of a part of the domain (box, slice or subsampled, see
+    OutputRegion.h) in the appended format of WriteAppended(). Write(),
+    WriteCompressed() and WriteAppended() call it for each region if
+    Settings::OutputRegions is not empty. */
+    static void WriteRegion(
+            const std::string Filename,
+            const Settings& locSettings,
+            std::vector<Field_t> ListOfFields,
+            const OutputRegion& Region,
+            const bool Compressed = false,
+            const int resolution = 1);
+
     static void WriteDistorted(
             const std::string Filename,
             const Settings& locSettings,
@@ -511,30 +538,20 @@ struct OP_EXPORTS VTK
 
         }
 
-        int size = Nx*Ny*Nz*3;
-        double* points = new double[size];
-        int it = 0;
-        for(int k = 0; k < Nz; ++k)
-        for(int j = 0; j < Ny; ++j)
-        for(int i = 0; i < Nx; ++i)
+        std::vector<double> points(Nx*Ny*Nz*3);
+        #pragma omp parallel for collapse(2) schedule(static)
+        for(long int k = 0; k < Nz; ++k)
+        for(long int j = 0; j < Ny; ++j)
+        for(long int i = 0; i < Nx; ++i)
         {
-            points[it] = (i + OffsetX)*a - loc_offsetX; it++;
-            points[it] = (j + OffsetY)*b - loc_offsetY; it++;
-            points[it] = (k + OffsetZ)*c - loc_offsetZ; it++;
+            const size_t it = ((k*Ny + j)*Nx + i)*3;
+            points[it    ] = (i + OffsetX)*a - loc_offsetX;
+            points[it + 1] = (j + OffsetY)*b - loc_offsetY;
+            points[it + 2] = (k + OffsetZ)*c - loc_offsetZ;
         }
-        uint32_t datasize = size*sizeof(double);
-        size_t cdatasize;
-        char* cpoints = compress_data(&cdatasize,(const char*)points,datasize);
-        header_singleblock b64header = { 1, datasize, datasize, static_cast<unsigned int>(cdatasize)};
-        char* b64string = encode_b64(cpoints, cdatasize);
-        char* b64lenstring = encode_b64((const char*)&b64header, sizeof(header_singleblock));
-        buffer << b64lenstring << b64string << std::endl;
+        buffer << CompressEncode((const char*)points.data(), points.size()*sizeof(double)) << std::endl;
         buffer << "</DataArray>" << std::endl;
         buffer << "</Points>" << std::endl;
-        delete[] (points);
-        free(cpoints);
-        free(b64string);
-        free(b64lenstring);
     }
 
     template <typename T>
@@ -619,12 +636,11 @@ struct OP_EXPORTS VTK
             b = locSettings.Grid.dNy/*(TotalNy-1)*/ ? 0.5*(TotalNy-1)/TotalNy : 0;
             c = locSettings.Grid.dNz/*(TotalNz-1)*/ ? 0.5*(TotalNz-1)/TotalNz : 0;
         }
-		int size = Nx*Ny*Nz*3;	
-       	double* points = new double[size];
-        int it = 0;
-        for(int k = 0; k < Nz; ++k)
-        for(int j = 0; j < Ny; ++j)
-        for(int i = 0; i < Nx; ++i)
+        std::vector<double> points(Nx*Ny*Nz*3);
+        #pragma omp parallel for collapse(2) schedule(static)
+        for(long int k = 0; k < Nz; ++k)
+        for(long int j = 0; j < Ny; ++j)
+        for(long int i = 0; i < Nx; ++i)
         {
             double x = i * a;
             double y = j * b;
@@ -633,17 +649,12 @@ struct OP_EXPORTS VTK
                                   (-0.5*TotalNy + y + b*OffsetY),
                                   (-0.5*TotalNz + z + c*OffsetZ)};
             coordinates = locDefGrad*coordinates + EP.Displacements.at(x,y,z);
-            points[it] = 0.5*TotalNx + coordinates[0]; it++;
-            points[it] = 0.5*TotalNy + coordinates[1]; it++;
-            points[it] = 0.5*TotalNz + coordinates[2]; it++;
+            const size_t it = ((k*Ny + j)*Nx + i)*3;
+            points[it    ] = 0.5*TotalNx + coordinates[0];
+            points[it + 1] = 0.5*TotalNy + coordinates[1];
+            points[it + 2] = 0.5*TotalNz + coordinates[2];
         }
-        uint32_t datasize = size*sizeof(double);
-        size_t cdatasize;
-        char* cpoints = compress_data(&cdatasize,(const char*)points,datasize);
-        header_singleblock b64header = { 1, datasize, datasize, static_cast<unsigned int>(cdatasize)};
-        char* b64string = encode_b64(cpoints, cdatasize);
-        char* b64lenstring = encode_b64((const char*)&b64header, sizeof(header_singleblock));
-        buffer << b64lenstring << b64string << std::endl;
+        buffer << CompressEncode((const char*)points.data(), points.size()*sizeof(double)) << std::endl;
         buffer << "</DataArray>\n";
         buffer << "</Points>\n";
     }
@@ -668,9 +679,17 @@ struct OP_EXPORTS VTK
 
     static char* encode_b64(const char* data, size_t size);
     static char* compress_data(size_t* csize, const char* data, size_t size);
+    static std::string CompressEncode(const char* data, const size_t size);     ///< Compressed and base64 encoded data in multi block format, header included
+    static constexpr size_t CompressionBlockSize = size_t(1) << 18;             ///< Uncompressed size of a block in bytes
+    static constexpr int    CompressionLevel = 10;                              ///< zlib compression level of the blocks
 
 private:
 
+    static bool WriteEmbedded(const std::string& Filename,
+                              const Settings& locSettings,
+                              const std::vector<Field_t>& ListOfFields,
+                              const int resolution);                            ///< Passes the fields to the field sink in embedded mode (see Embedded.h), returns false otherwise
+
     static long int get_Nx (const int resolution, const Settings& locSettings) 
     {
         if (resolution == 1) return locSettings.Grid.Nx;
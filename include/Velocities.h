@@ -44,6 +44,8 @@ class OP_EXPORTS Velocities : public OPObject
     Velocities(Settings& locSettings);
     void Initialize(Settings& locSettings, std::string ObjectNameSuffix = "") override; ///< Allocates memory, initializes the settings
     void Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC) override; ///< Remeshes the system while keeping the data
+    void Repartition(const BoundaryConditions& BC) override;                    ///< Migrates the storages to the local domain of the new MPI cut planes
+    size_t AllocatedMemory(void) const override;                                ///< Memory held by the storages in bytes
 
     double GetMaxVelocity();                                                    ///< returns maximal velocity component
     void Advect(BoundaryConditions& BC, double dt,
@@ -66,7 +68,7 @@ class OP_EXPORTS Velocities : public OPObject
 
     Storage3D < dVector3, 0 > Average;                                          ///< Average velocities storage
     Storage3D < dVector3, 0 > AverageDot;                                       ///< Average velocities increments storage
-    Storage3D < dVector3, 1 > Phase;                                            ///< Phase velocities storage
+    SparseVectorStorage Phase;                                                  ///< Phase velocities storage, only the locally present phases are stored
 
     size_t Nphases;                                                             ///< Number of thermodynamic phases
 
@@ -0,0 +1,96 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#ifndef WAVEVECTORS_H
+#define WAVEVECTORS_H
+
+#include "Includes.h"
+
+namespace openphase
+{
+
+class OP_EXPORTS WaveVectors                                                    ///< Cached wave vector components of the local reciprocal space block of a spectral solver
+{
+    /* The wave vector of the reciprocal space point (i,j,k) is separable:
+    each component depends on the index along its own axis only. Instead of
+    recomputing it for every point and solve, or storing three full
+    reciprocal space arrays, the components are tabulated once per axis for
+    the local block [Offset, Offset + SpectralN) of the global grid of size N.
+    A component is Scale*2*Pi*n/N with n folded to [-N/2, N/2], the discrete
+    variant Scale*sin(2*Pi*n/N) corresponds to central difference
+    derivatives. Axis() returns plain arrays which can be used in OpenMP
+    target regions, Squared() and InverseLaplacian() give the Green operator
+    of the Poisson problems solved by the electric and magnetic solvers.*/
+ public:
+    void Initialize(const long int N[3], const int SpectralN[3],
+                    const int Offset[3], const double Scale = 1.0)              ///< Tabulates the components of the local block
+    {
+        for(int d = 0; d < 3; d++)
+        {
+            Q[d].resize(SpectralN[d]);
+            Qd[d].resize(SpectralN[d]);
+            for(int n = 0; n < SpectralN[d]; n++)
+            {
+                const long int nn = n + Offset[d];
+                const double phase = 2.0*Pi/double(N[d])*(nn <= N[d]/2 ? nn : nn - N[d]);
+                Q[d][n]  = Scale*phase;
+                Qd[d][n] = Scale*sin(phase);
+            }
+        }
+    }
+    const double* Axis(const int d, const bool Discrete = false) const          ///< Components along axis d of the local block
+    {
+        return Discrete ? Qd[d].data() : Q[d].data();
+    }
+    dVector3 operator()(const int i, const int j, const int k) const            ///< Wave vector of the local reciprocal space point (i,j,k)
+    {
+        return dVector3{Q[0][i], Q[1][j], Q[2][k]};
+    }
+    double Squared(const int i, const int j, const int k) const                 ///< Squared length of the wave vector
+    {
+        return Q[0][i]*Q[0][i] + Q[1][j]*Q[1][j] + Q[2][k]*Q[2][k];
+    }
+    double InverseLaplacian(const int i, const int j, const int k) const        ///< Reciprocal space Green operator -1/|Q|^2 of the Laplacian, zero for Q = 0
+    {
+        const double QQ = Squared(i,j,k);
+        return (QQ != 0.0) ? -1.0/QQ : 0.0;
+    }
+    size_t AllocatedMemory(void) const                                          ///< Memory held by the tables in bytes
+    {
+        size_t bytes = 0;
+        for(int d = 0; d < 3; d++)
+        {
+            bytes += sizeof(double)*(Q[d].size() + Qd[d].size());
+        }
+        return bytes;
+    }
+
+ private:
+    std::vector<double> Q[3];                                                   ///< Wave vector components along each axis
+    std::vector<double> Qd[3];                                                  ///< Discrete (sine) wave vector components along each axis
+};
+
+}// namespace openphase
+#endif
@@ -30,6 +30,8 @@
 #include <vector>
 #include <sstream>
 #include <iostream>
+#include <set>
+#include <algorithm>
 
 int MPI_RANK = 0;
 int MPI_SIZE = 1;
@@ -50,6 +52,7 @@ MPI_Datatype getDatatype(OP_MPI_Datatype op_mpi_datatype)
     	case OP_MPI_Datatype::OP_MPI_CHAR: return MPI_CHAR;
         case OP_MPI_Datatype::OP_MPI_INT: return MPI_INT;
         case OP_MPI_Datatype::OP_MPI_LONG: return MPI_LONG;
+        case OP_MPI_Datatype::OP_MPI_LONG_LONG: return MPI_LONG_LONG;
         case OP_MPI_Datatype::OP_MPI_FLOAT: return MPI_FLOAT;
         case OP_MPI_Datatype::OP_MPI_DOUBLE: return MPI_DOUBLE;
         case OP_MPI_Datatype::OP_MPI_DOUBLE_INT: return MPI_DOUBLE_INT;
@@ -110,6 +113,29 @@ int OP_MPI_Init_thread(int* argc, char ***argv, OP_MPI_Threads required, int* pr
     return result;
 }
 
+int OP_MPI_Query_thread(OP_MPI_Threads* provided)
+{
+    int level = MPI_THREAD_SINGLE;
+    int result = MPI_Query_thread(&level);
+
+    switch(level)
+    {
+        case MPI_THREAD_FUNNELED:
+            *provided = OP_MPI_THREAD_FUNNELED;
+            break;
+        case MPI_THREAD_SERIALIZED:
+            *provided = OP_MPI_THREAD_SERIALIZED;
+            break;
+        case MPI_THREAD_MULTIPLE:
+            *provided = OP_MPI_THREAD_MULTIPLE;
+            break;
+        default:
+            *provided = OP_MPI_THREAD_SINGLE;
+            break;
+    }
+    return result;
+}
+
 int OP_MPI_Comm_rank(OP_MPI_Comm communicator, int* MPI_RANK)
 {
     int result = MPI_Comm_rank(MPI_COMM_WORLD, MPI_RANK);
@@ -122,14 +148,26 @@ int OP_MPI_Comm_size(OP_MPI_Comm communicator, int* MPI_SIZE)
     return result;
 }
 
+/* Time spent blocked in MPI, which the profiler (TimeInfo) subtracts from
+the section and region times to separate the busy time of a rank from the
+time it waits for the others */
+static double WaitTime = 0.0;
+
+double OP_MPI_WaitTime()
+{
+    return WaitTime;
+}
+
 int OP_MPI_Allreduce(const void *sendbuf, void *recvbuf, int count,
                      OP_MPI_Datatype op_mpi_datatype, OP_MPI_Op op_mpi_op,
                      OP_MPI_Comm communicator)
 {
     MPI_Datatype datatype = getDatatype(op_mpi_datatype);
     MPI_Op op = getOp(op_mpi_op);
+    const double start = MPI_Wtime();
     int result = MPI_Allreduce(sendbuf, recvbuf, count,
                                datatype, op, MPI_COMM_WORLD);
+    WaitTime += MPI_Wtime() - start;
     return result;
 }
 
@@ -139,9 +177,22 @@ int OP_MPI_Allreduce(OP_MPI_Options inplace, void *buf, int count,
 {
     MPI_Datatype datatype = getDatatype(op_mpi_datatype);
     MPI_Op op = getOp(op_mpi_op);
+    const double start = MPI_Wtime();
     int result = MPI_Allreduce(MPI_IN_PLACE, buf, count,
                    datatype, op, MPI_COMM_WORLD);
+    WaitTime += MPI_Wtime() - start;
+
+    return result;
+}
 
+int OP_MPI_Iallreduce(OP_MPI_Options inplace, void *buf, int count,
+                      OP_MPI_Datatype op_mpi_datatype, OP_MPI_Op op_mpi_op,
+                      OP_MPI_Comm communicator, void *request)
+{
+    MPI_Datatype datatype = getDatatype(op_mpi_datatype);
+    MPI_Op op = getOp(op_mpi_op);
+    int result = MPI_Iallreduce(MPI_IN_PLACE, buf, count,
+                                datatype, op, MPI_COMM_WORLD, (MPI_Request*)request);
     return result;
 }
 
@@ -151,8 +202,10 @@ int OP_MPI_Reduce(const void *sendbuf, void *recvbuf, int count,
 {
     MPI_Datatype datatype = getDatatype(op_mpi_datatype);
     MPI_Op op = getOp(op_mpi_op);
+    const double start = MPI_Wtime();
     int result = MPI_Reduce(sendbuf, recvbuf, count,
                             datatype, op, root, MPI_COMM_WORLD);
+    WaitTime += MPI_Wtime() - start;
     return result;
 }
 
@@ -178,7 +231,9 @@ int OP_MPI_Irecv(void *buf, int count,
 
 int OP_MPI_Wait(void *request, OP_MPI_Status status)
 {
+    const double start = MPI_Wtime();
     int result = MPI_Wait((MPI_Request*)request, MPI_STATUS_IGNORE);
+    WaitTime += MPI_Wtime() - start;
     return result;
 }
 
@@ -193,22 +248,271 @@ int OP_MPI_Cart_Setup(const int dims[], int& rank, int* cart_rank)
     return std::max(result1,result2);
 }
 
+int OP_MPI_Cart_Setup_node_aware(const int dims[], const int rank, int* cart_rank,
+                                 const long int extent[], std::vector<int>& cart_process)
+{
+    /* Node of each rank (lowest rank on the node), position within the node
+    and number of ranks on the node */
+    MPI_Comm node_comm;
+    int result = MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    int node_rank = 0;
+    int node_size = 1;
+    int leader = rank;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+    MPI_Allreduce(MPI_IN_PLACE, &leader, 1, MPI_INT, MPI_MIN, node_comm);
+    MPI_Comm_free(&node_comm);
+
+    int size = 1;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    const int mine[3] = {leader, node_rank, node_size};
+    std::vector<int> info(3*size);
+    MPI_Allgather(mine, 3, MPI_INT, info.data(), 3, MPI_INT, MPI_COMM_WORLD);
+
+    cart_process.clear();
+    for(int p = 0; p < size; p++)
+    {
+        if(info[3*p+2] != node_size) return result;
+    }
+
+    /* Sub-block of node_size ranks which divides the process grid and has the
+    smallest faces towards other nodes, weighted by the cell extent of the
+    local boxes */
+    int block[3] = {0, 0, 0};
+    double best = 0.0;
+    for(int nx = 1; nx <= node_size; nx++)
+    for(int ny = 1; nx*ny <= node_size; ny++)
+    {
+        if(node_size % (nx*ny) != 0) continue;
+        const int n[3] = {nx, ny, node_size/(nx*ny)};
+        if(dims[0] % n[0] or dims[1] % n[1] or dims[2] % n[2]) continue;
+
+        double cost = 0.0;
+        for(int d = 0; d < 3; d++)
+        if(dims[d] > n[d])
+        {
+            const int d1 = (d+1)%3;
+            const int d2 = (d+2)%3;
+            cost += double(n[d1]*extent[d1])*double(n[d2]*extent[d2]);
+        }
+        if(block[0] == 0 or cost < best)
+        {
+            best = cost;
+            block[0] = n[0];
+            block[1] = n[1];
+            block[2] = n[2];
+        }
+    }
+    if(block[0] == 0) return result;
+
+    std::vector<int> leaders;
+    for(int p = 0; p < size; p++) leaders.push_back(info[3*p]);
+    std::sort(leaders.begin(), leaders.end());
+    leaders.erase(std::unique(leaders.begin(), leaders.end()), leaders.end());
+
+    const int blocks[3] = {dims[0]/block[0], dims[1]/block[1], dims[2]/block[2]};
+    cart_process.assign(size, -1);
+    for(int p = 0; p < size; p++)
+    {
+        const int m = std::lower_bound(leaders.begin(), leaders.end(), info[3*p]) - leaders.begin();
+        const int r = info[3*p+1];
+        const int c[3] = {(m/(blocks[1]*blocks[2]))*block[0] + r/(block[1]*block[2]),
+                          ((m/blocks[2])%blocks[1])*block[1] + (r/block[2])%block[1],
+                          (m%blocks[2])*block[2] + r%block[2]};
+        cart_process[(c[0]*dims[1] + c[1])*dims[2] + c[2]] = p;
+        if(p == rank)
+        {
+            cart_rank[0] = c[0];
+            cart_rank[1] = c[1];
+            cart_rank[2] = c[2];
+        }
+    }
+    return result;
+}
+
 int OP_MPI_Bcast(void *buffer, int count,
                  OP_MPI_Datatype op_mpi_datatype, int root,
                  OP_MPI_Comm communicator)
 {
     MPI_Datatype datatype = getDatatype(op_mpi_datatype);
+    const double start = MPI_Wtime();
     int result = MPI_Bcast(buffer, count, datatype, root, MPI_COMM_WORLD);
+    WaitTime += MPI_Wtime() - start;
     return result;
 }
 
 void OP_MPI_Barrier(OP_MPI_Comm communicator)
 {
+    const double start = MPI_Wtime();
     MPI_Barrier(MPI_COMM_WORLD);
+    WaitTime += MPI_Wtime() - start;
+}
+
+int OP_MPI_Allgather(const void *sendbuf, int sendcount, OP_MPI_Datatype sendtype,
+                     void *recvbuf, int recvcount, OP_MPI_Datatype recvtype,
+                     OP_MPI_Comm communicator)
+{
+    const double start = MPI_Wtime();
+    int result = MPI_Allgather(sendbuf, sendcount, getDatatype(sendtype),
+                               recvbuf, recvcount, getDatatype(recvtype), MPI_COMM_WORLD);
+    WaitTime += MPI_Wtime() - start;
+    return result;
+}
+
+int OP_MPI_Allgatherv(const void *sendbuf, int sendcount, OP_MPI_Datatype sendtype,
+                      void *recvbuf, const int recvcounts[], const int displs[],
+                      OP_MPI_Datatype recvtype, OP_MPI_Comm communicator)
+{
+    const double start = MPI_Wtime();
+    int result = MPI_Allgatherv(sendbuf, sendcount, getDatatype(sendtype),
+                                recvbuf, recvcounts, displs, getDatatype(recvtype), MPI_COMM_WORLD);
+    WaitTime += MPI_Wtime() - start;
+    return result;
+}
+
+int OP_MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[],
+                     OP_MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                     const int rdispls[], OP_MPI_Datatype recvtype,
+                     OP_MPI_Comm communicator)
+{
+    const double start = MPI_Wtime();
+    int result = MPI_Alltoallv(sendbuf, sendcounts, sdispls, getDatatype(sendtype),
+                               recvbuf, recvcounts, rdispls, getDatatype(recvtype),
+                               MPI_COMM_WORLD);
+    WaitTime += MPI_Wtime() - start;
+    return result;
+}
+
+/* Derived datatypes and persistent requests which are still alive are
+released in OP_MPI_Finalize() */
+static std::set<void*> PersistentRequests;
+static std::set<void*> DerivedDatatypes;
+
+void* OP_MPI_Type_create_subarray(int ndims, const int sizes[],
+                                  const int subsizes[], const int starts[],
+                                  OP_MPI_Datatype op_mpi_datatype)
+{
+    MPI_Datatype basetype = getDatatype(op_mpi_datatype);
+    MPI_Datatype* datatype = (MPI_Datatype*)malloc(sizeof(MPI_Datatype));
+    MPI_Type_create_subarray(ndims, sizes, subsizes, starts, MPI_ORDER_C,
+                             basetype, datatype);
+    MPI_Type_commit(datatype);
+    DerivedDatatypes.insert(datatype);
+    return datatype;
+}
+
+void OP_MPI_Type_free(void* datatype)
+{
+    if(DerivedDatatypes.erase(datatype))
+    {
+        MPI_Type_free((MPI_Datatype*)datatype);
+        free(datatype);
+    }
+}
+
+int OP_MPI_Send_init(const void *buf, int count, void* datatype, int dest, int tag,
+                     OP_MPI_Comm communicator, void *request)
+{
+    int result = MPI_Send_init(buf, count, *(MPI_Datatype*)datatype, dest, tag,
+                               MPI_COMM_WORLD, (MPI_Request*)request);
+    PersistentRequests.insert(request);
+    return result;
+}
+
+int OP_MPI_Recv_init(void *buf, int count, void* datatype, int source, int tag,
+                     OP_MPI_Comm communicator, void *request)
+{
+    int result = MPI_Recv_init(buf, count, *(MPI_Datatype*)datatype, source, tag,
+                               MPI_COMM_WORLD, (MPI_Request*)request);
+    PersistentRequests.insert(request);
+    return result;
+}
+
+int OP_MPI_Start(void *request)
+{
+    int result = MPI_Start((MPI_Request*)request);
+    return result;
+}
+
+void OP_MPI_Request_free(void *request)
+{
+    if(PersistentRequests.erase(request))
+    {
+        MPI_Request_free((MPI_Request*)request);
+    }
+    free_request(request);
+}
+
+/* Shared memory windows on the processes of a node, the windows stay locked
+(passive target epoch) until OP_MPI_Finalize() */
+struct SharedWindow
+{
+    MPI_Win   Window;
+    MPI_Comm  NodeComm;
+    MPI_Group NodeGroup;
+    MPI_Group WorldGroup;
+};
+static std::set<SharedWindow*> SharedWindows;
+
+void* OP_MPI_Shared_window(size_t bytes)
+{
+    SharedWindow* window = new SharedWindow;
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &window->NodeComm);
+    MPI_Comm_group(window->NodeComm, &window->NodeGroup);
+    MPI_Comm_group(MPI_COMM_WORLD, &window->WorldGroup);
+
+    void* base = nullptr;
+    MPI_Win_allocate_shared(bytes, 1, MPI_INFO_NULL, window->NodeComm, &base, &window->Window);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, window->Window);
+    SharedWindows.insert(window);
+    return window;
+}
+
+char* OP_MPI_Shared_pointer(void* window, int rank)
+{
+    SharedWindow* locWindow = static_cast<SharedWindow*>(window);
+    int node_rank = MPI_UNDEFINED;
+    MPI_Group_translate_ranks(locWindow->WorldGroup, 1, &rank, locWindow->NodeGroup, &node_rank);
+    if(node_rank == MPI_UNDEFINED) return nullptr;
+
+    MPI_Aint size = 0;
+    int disp_unit = 1;
+    void* base = nullptr;
+    MPI_Win_shared_query(locWindow->Window, node_rank, &size, &disp_unit, &base);
+    return static_cast<char*>(base);
+}
+
+void OP_MPI_Shared_sync(void* window)
+{
+    MPI_Win_sync(static_cast<SharedWindow*>(window)->Window);
 }
 
 void OP_MPI_Finalize()
 {
+    for(auto window : SharedWindows)
+    {
+        MPI_Win_unlock_all(window->Window);
+        MPI_Win_free(&window->Window);
+        MPI_Group_free(&window->NodeGroup);
+        MPI_Group_free(&window->WorldGroup);
+        MPI_Comm_free(&window->NodeComm);
+        delete window;
+    }
+    SharedWindows.clear();
+    for(auto request : PersistentRequests)
+    {
+        MPI_Request_free((MPI_Request*)request);
+        free_request(request);
+    }
+    PersistentRequests.clear();
+    for(auto datatype : DerivedDatatypes)
+    {
+        MPI_Type_free((MPI_Datatype*)datatype);
+        free(datatype);
+    }
+    DerivedDatatypes.clear();
     MPI_Finalize();
 }
 
@@ -245,6 +549,16 @@ void op_fftw_mpi_cleanup()
     fftw_mpi_cleanup();
 }
 
+void op_fftw_mpi_broadcast_wisdom()
+{
+    fftw_mpi_broadcast_wisdom(MPI_COMM_WORLD);
+}
+
+void op_fftw_mpi_gather_wisdom()
+{
+    fftw_mpi_gather_wisdom(MPI_COMM_WORLD);
+}
+
 void op_mpi_write_vtk(const std::string Filename, std::stringstream& buffer,
     std::stringstream& hbuffer,
     std::stringstream& tbuffer)
@@ -33,6 +33,7 @@ enum OP_MPI_Datatype
 	OP_MPI_CHAR,
     OP_MPI_INT,
     OP_MPI_LONG,
+    OP_MPI_LONG_LONG,
     OP_MPI_FLOAT,
     OP_MPI_DOUBLE,
     OP_MPI_DOUBLE_INT,
@@ -84,6 +85,8 @@ void free_request(void* req);
 
 int OP_MPI_Init_thread(int* argc, char ***argv, OP_MPI_Threads required, int* provided);
 
+int OP_MPI_Query_thread(OP_MPI_Threads* provided);
+
 int OP_MPI_Comm_rank(OP_MPI_Comm commnicator, int* MPI_RANK);
 
 int OP_MPI_Comm_size(OP_MPI_Comm commnicator, int* MPI_SIZE);
@@ -96,6 +99,10 @@ int OP_MPI_Allreduce(OP_MPI_Options inplace, void *buf, int count,
                      OP_MPI_Datatype op_mpi_datatype, OP_MPI_Op op_mpi_op,
                      OP_MPI_Comm communicator);
 
+int OP_MPI_Iallreduce(OP_MPI_Options inplace, void *buf, int count,
+                      OP_MPI_Datatype op_mpi_datatype, OP_MPI_Op op_mpi_op,
+                      OP_MPI_Comm communicator, void *request);                 ///< Non-blocking in place reduction, completed by OP_MPI_Wait()
+
 int OP_MPI_Reduce(const void *sendbuf, void *recvbuf, int count,
                   OP_MPI_Datatype op_mpi_datatype, OP_MPI_Op op_mpi_op, int root,
                   OP_MPI_Comm communicator);
@@ -110,14 +117,53 @@ int OP_MPI_Wait(void *request, OP_MPI_Status status);
 
 int OP_MPI_Cart_Setup(const int dims[], int& rank, int* cart_rank);
 
+int OP_MPI_Cart_Setup_node_aware(const int dims[], const int rank, int* cart_rank,
+                                 const long int extent[],
+                                 std::vector<int>& cart_process);               ///< Places the ranks of each node in a compact sub-block of the dims grid, cart_process gets the rank at each Cartesian position (row-major), empty if not possible
+
 int OP_MPI_Bcast(void *buffer, int count,
                  OP_MPI_Datatype op_mpi_datatype, int root,
                  OP_MPI_Comm communicator);
 
 void OP_MPI_Barrier(OP_MPI_Comm communicator);
 
+int OP_MPI_Allgather(const void *sendbuf, int sendcount, OP_MPI_Datatype sendtype,
+                     void *recvbuf, int recvcount, OP_MPI_Datatype recvtype,
+                     OP_MPI_Comm communicator);
+
+int OP_MPI_Allgatherv(const void *sendbuf, int sendcount, OP_MPI_Datatype sendtype,
+                      void *recvbuf, const int recvcounts[], const int displs[],
+                      OP_MPI_Datatype recvtype, OP_MPI_Comm communicator);
+
+int OP_MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[],
+                     OP_MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                     const int rdispls[], OP_MPI_Datatype recvtype,
+                     OP_MPI_Comm communicator);
+
+void* OP_MPI_Type_create_subarray(int ndims, const int sizes[],
+                                  const int subsizes[], const int starts[],
+                                  OP_MPI_Datatype op_mpi_datatype);             ///< Returns a committed subarray datatype (C order)
+
+void OP_MPI_Type_free(void* datatype);
+
+int OP_MPI_Send_init(const void *buf, int count, void* datatype, int dest, int tag,
+                     OP_MPI_Comm communicator, void *request);
+
+int OP_MPI_Recv_init(void *buf, int count, void* datatype, int source, int tag,
+                     OP_MPI_Comm communicator, void *request);
+
+int OP_MPI_Start(void *request);
+
+void OP_MPI_Request_free(void *request);                                        ///< Frees a persistent request and its handle
+
+void* OP_MPI_Shared_window(size_t bytes);                                       ///< Allocates "bytes" of node shared memory per process (collective), returns the window
+char* OP_MPI_Shared_pointer(void* window, int rank);                            ///< Window memory of process "rank", nullptr if it is not on the same node
+void OP_MPI_Shared_sync(void* window);                                          ///< Synchronizes the public and private copy of the window memory
+
 void OP_MPI_Finalize();
 
+double OP_MPI_WaitTime();                                                       ///< Wall time [s] this process spent in OP_MPI_Wait() and blocking collectives
+
 void op_fftw_mpi_init();
 
 fftw_plan op_fftw_mpi_plan_dft_r2c_3d(ptrdiff_t n0, ptrdiff_t n1, ptrdiff_t n2,
@@ -136,6 +182,10 @@ ptrdiff_t op_fftw_mpi_local_size_3d(ptrdiff_t n0, ptrdiff_t n1, ptrdiff_t n2,
 
 void op_fftw_mpi_cleanup();
 
+void op_fftw_mpi_broadcast_wisdom();                                            ///< Sends the FFTW wisdom of rank 0 to all ranks
+
+void op_fftw_mpi_gather_wisdom();                                               ///< Collects the FFTW wisdom of all ranks on rank 0
+
 void op_mpi_write_vtk(const std::string Filename, std::stringstream& buffer,
     std::stringstream& hbuffer,
     std::stringstream& tbuffer);
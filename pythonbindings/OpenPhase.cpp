@@ -1,4 +1,7 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/functional.h>
+#include <numeric>
 #include "Settings.h"
 #include "RunTimeControl.h"
 #include "BoundaryConditions.h"
@@ -21,12 +24,241 @@
 #include "InterfaceRegularization.h"
 #include "AdvectionHR.h"
 #include "FluidDynamics/FlowSolverLBM.h"
+#include "Velocities.h"
 #include "EquilibriumPartitionDiffusionBinary.h"
 #include "Tools/TimeInfo.h"
+#include "ConsoleOutput.h"
 
 namespace py = pybind11;
 
+namespace
+{
+/* The compute bindings release the GIL, Python threads (e.g. analysis of the
+zero-copy views) run concurrently. Bindings which create Python objects keep
+it. Callbacks passed to the solvers reacquire it through pybind11 */
+using release_gil = py::call_guard<py::gil_scoped_release>;
+
+/* Zero-copy access to the POD storages. The buffers cover the whole padded
+memory including the boundary cells, x is the slowest and z the fastest
+running index, the tensor components of each cell are stored contiguously
+after the cell. Interior() returns the view of the local domain without the
+boundary cells, both keep the owning Python object alive. The views become
+invalid if the storage is reallocated (Remesh(), Repartition()). */
+
+template<class T>
+struct ValueLayout                                                              ///< Number of doubles per stored value
+{
+    static constexpr size_t Components = 1;
+};
+
+template<>
+struct ValueLayout<openphase::dVector3>
+{
+    static_assert(sizeof(openphase::dVector3) == 3*sizeof(double), "dVector3 is expected to hold exactly three doubles");
+    static constexpr size_t Components = 3;
+};
+
+template<class T, size_t Rank>
+py::buffer_info StorageBuffer(openphase::Storage3D<T,Rank>& Field, const bool Interior)
+{
+    if(Field.IsNotAllocated())
+    {
+        throw std::runtime_error("Storage3D is not allocated");
+    }
+
+    const long int bX = Field.BcellsX();
+    const long int bY = Field.BcellsY();
+    const long int bZ = Field.BcellsZ();
+
+    std::vector<py::ssize_t> Shape;
+    if(Interior) Shape = {Field.sizeX(), Field.sizeY(), Field.sizeZ()};
+    else Shape = {Field.sizeX() + 2*bX, Field.sizeY() + 2*bY, Field.sizeZ() + 2*bZ};
+
+    /* Components of one cell, innermost first for the strides */
+    std::vector<py::ssize_t> Components;
+    T* Base = nullptr;
+    if constexpr (Rank == 0)
+    {
+        Base = Interior ? &Field(0,0,0) : &Field(-bX,-bY,-bZ);
+    }
+    else
+    {
+        std::array<size_t,Rank> Zero{};
+        Base = Interior ? &Field(0,0,0,Zero) : &Field(-bX,-bY,-bZ,Zero);
+        for(size_t n = 0; n < Rank; n++) Components.push_back(Field.Dimensions()[n]);
+    }
+    if constexpr (ValueLayout<T>::Components > 1)
+    {
+        Components.push_back(ValueLayout<T>::Components);
+    }
+
+    std::vector<py::ssize_t> Strides(Components.size());
+    py::ssize_t Stride = sizeof(double);
+    for(size_t n = Components.size(); n-- > 0;)
+    {
+        Strides[n] = Stride;
+        Stride *= Components[n];
+    }
+    const py::ssize_t StrideZ = Stride;
+    const py::ssize_t StrideY = StrideZ*(Field.sizeZ() + 2*bZ);
+    const py::ssize_t StrideX = StrideY*(Field.sizeY() + 2*bY);
+    Strides.insert(Strides.begin(), {StrideX, StrideY, StrideZ});
+    Shape.insert(Shape.end(), Components.begin(), Components.end());
+
+    return py::buffer_info(reinterpret_cast<double*>(Base), sizeof(double),
+                           py::format_descriptor<double>::format(),
+                           Shape.size(), Shape, Strides);
+}
+
+template<class T, size_t Rank>
+void BindStorage(py::module_& m, const char* Name)
+{
+    using StorageType = openphase::Storage3D<T,Rank>;
+    py::class_<StorageType>(m, Name, py::buffer_protocol())
+        .def_buffer([](StorageType& self) {return StorageBuffer(self, false);})
+        .def("Interior", [](py::object self) {
+            py::buffer_info info = StorageBuffer(self.cast<StorageType&>(), true);
+            return py::array(py::dtype::of<double>(), info.shape, info.strides,
+                             static_cast<double*>(info.ptr), self);
+        })
+        .def("sizeX", &StorageType::sizeX)
+        .def("sizeY", &StorageType::sizeY)
+        .def("sizeZ", &StorageType::sizeZ)
+        .def("Bcells", &StorageType::Bcells);
+}
+
+/* Phase-field fractions of the interior cells as a dense array
+(Nx, Ny, Nz, number of phase fields), copied */
+py::array_t<double> DenseFractions(const openphase::PhaseField& Phase)
+{
+    const openphase::Storage3D<openphase::NodePF,0>& Fields = Phase.Fields;
+    const py::ssize_t Nx = Fields.sizeX();
+    const py::ssize_t Ny = Fields.sizeY();
+    const py::ssize_t Nz = Fields.sizeZ();
+    const py::ssize_t Nf = Phase.FieldsProperties.size();
+
+    py::array_t<double> Fractions({Nx, Ny, Nz, Nf});
+    double* data = Fractions.mutable_data();
+    std::fill(data, data + Nx*Ny*Nz*Nf, 0.0);
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
+    {
+        double* cell = data + ((i*Ny + j)*Nz + k)*Nf;
+        for(auto alpha = Fields(i,j,k).cbegin(); alpha != Fields(i,j,k).cend(); ++alpha)
+        {
+            cell[alpha->index] = alpha->value;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return Fractions;
+}
+
+/* Phase-field fractions of the interior cells in compressed sparse row
+format: the entries of cell (i,j,k), numbered x-major like the dense array,
+are Indices/Values[Offsets[c]:Offsets[c+1]] with c = (i*Ny + j)*Nz + k */
+py::tuple SparseFractions(const openphase::PhaseField& Phase)
+{
+    const openphase::Storage3D<openphase::NodePF,0>& Fields = Phase.Fields;
+    const py::ssize_t Ny = Fields.sizeY();
+    const py::ssize_t Nz = Fields.sizeZ();
+    const py::ssize_t Ncells = Fields.sizeX()*Ny*Nz;
+
+    py::array_t<int64_t> Offsets(Ncells + 1);
+    int64_t* offsets = Offsets.mutable_data();
+    offsets[0] = 0;
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
+    {
+        offsets[(i*Ny + j)*Nz + k + 1] = Fields(i,j,k).cend() - Fields(i,j,k).cbegin();
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    std::partial_sum(offsets, offsets + Ncells + 1, offsets);
+
+    py::array_t<int64_t> Indices(offsets[Ncells]);
+    py::array_t<double>  Values(offsets[Ncells]);
+    int64_t* indices = Indices.mutable_data();
+    double*  values  = Values.mutable_data();
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
+    {
+        int64_t n = offsets[(i*Ny + j)*Nz + k];
+        for(auto alpha = Fields(i,j,k).cbegin(); alpha != Fields(i,j,k).cend(); ++alpha, ++n)
+        {
+            indices[n] = alpha->index;
+            values[n]  = alpha->value;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return py::make_tuple(Offsets, Indices, Values);
+}
+
+/* C++ side time loop of the normal grain growth example (NormalGG.py), Python
+only orchestrates chunks of time steps. The output follows the RunTimeControl
+intervals as in the Python loop */
+class NormalGrainGrowth
+{
+ public:
+    NormalGrainGrowth(openphase::Settings& locSettings,
+                      openphase::RunTimeControl& locRTC,
+                      openphase::PhaseField& locPhase,
+                      openphase::DoubleObstacle& locDO,
+                      openphase::InterfaceProperties& locIP,
+                      openphase::BoundaryConditions& locBC) :
+        OPSettings(locSettings), RTC(locRTC), Phase(locPhase),
+        DO(locDO), IP(locIP), BC(locBC)
+    {
+    }
+
+    int Step(const int n)                                                       ///< Performs up to n time steps, returns the number of steps done (0 at the end of the simulation)
+    {
+        int done = 0;
+        for(; done < n and RTC.TimeStep <= RTC.MaxTimeStep; done++)
+        {
+            IP.Set(Phase, BC);
+            DO.CalculatePhaseFieldIncrements(Phase, IP);
+            Phase.NormalizeIncrements(BC, RTC.dt);
+            if(RTC.AdaptiveTimeStep)
+            {
+                RTC.SetTimeStepLimit(IP.ReportMaximumTimeStep(), "InterfaceProperties");
+                RTC.SetTimeStepLimit(Phase.ReportMaximumTimeStep(), "PhaseField");
+            }
+            Phase.MergeIncrements(BC, RTC.dt);
+
+            if(RTC.WriteVTK())
+            {
+                Phase.WriteVTK(OPSettings, RTC.TimeStep);
+            }
+            if(RTC.WriteRawData())
+            {
+                Phase.Write(OPSettings, RTC.TimeStep);
+            }
+            if(RTC.WriteToScreen())
+            {
+                const double I_En = DO.AverageEnergyDensity(Phase, IP);
+                openphase::ConsoleOutput::WriteTimeStep(RTC,
+                    openphase::ConsoleOutput::GetStandard("Interface energy density", I_En));
+            }
+            RTC.IncrementTimeStep();
+        }
+        return done;
+    }
+
+ private:
+    openphase::Settings&            OPSettings;
+    openphase::RunTimeControl&      RTC;
+    openphase::PhaseField&          Phase;
+    openphase::DoubleObstacle&      DO;
+    openphase::InterfaceProperties& IP;
+    openphase::BoundaryConditions&  BC;
+};
+}// namespace
+
 PYBIND11_MODULE(OpenPhase, m) {
+    BindStorage<double,0>(m, "Storage3D_double_0");
+    BindStorage<double,1>(m, "Storage3D_double_1");
+    BindStorage<double,2>(m, "Storage3D_double_2");
+    BindStorage<openphase::dVector3,0>(m, "Storage3D_dVector3_0");
+
     py::class_<openphase::Settings>(m, "Settings")
         .def(py::init<const std::string &>())
         .def("ReadInput",  static_cast<void (openphase::Settings::*)(std::string)>(&openphase::Settings::ReadInput));
@@ -75,21 +307,23 @@ PYBIND11_MODULE(OpenPhase, m) {
          py::arg("BC"),
          py::arg("dt"),
          py::arg("finalize") = true,
-         py::arg("clear") = true)
-        .def("NormalizeIncrements",&openphase::PhaseField::NormalizeIncrements) 
-        .def("PlantGrainNucleus", &openphase::PhaseField::PlantGrainNucleus)
+         py::arg("clear") = true, release_gil())
+        .def("NormalizeIncrements",&openphase::PhaseField::NormalizeIncrements, release_gil()) 
+        .def("PlantGrainNucleus", &openphase::PhaseField::PlantGrainNucleus, release_gil())
         .def("WriteVTK",
          &openphase::PhaseField::WriteVTK,
          py::arg("locSettings"),
          py::arg("tStep"),
          py::arg("CurvatureOutput") = false,
-         py::arg("precision") = 16)
-    	.def("Read", static_cast<bool (openphase::PhaseField::*)(std::string)>(&openphase::PhaseField::Read))
-		.def("Read", static_cast<bool (openphase::PhaseField::*)(const openphase::Settings&, const openphase::BoundaryConditions&, int)>(&openphase::PhaseField::Read))
-        .def("Write", static_cast<bool (openphase::PhaseField::*)(const std::string&) const>(&openphase::PhaseField::Write))
-        .def("Write", static_cast<bool (openphase::PhaseField::*)(const openphase::Settings&, const int) const>(&openphase::PhaseField::Write))
+         py::arg("precision") = 16, release_gil())
+    	.def("Read", static_cast<bool (openphase::PhaseField::*)(std::string)>(&openphase::PhaseField::Read), release_gil())
+		.def("Read", static_cast<bool (openphase::PhaseField::*)(const openphase::Settings&, const openphase::BoundaryConditions&, int)>(&openphase::PhaseField::Read), release_gil())
+        .def("Write", static_cast<bool (openphase::PhaseField::*)(const std::string&) const>(&openphase::PhaseField::Write), release_gil())
+        .def("Write", static_cast<bool (openphase::PhaseField::*)(const openphase::Settings&, const int) const>(&openphase::PhaseField::Write), release_gil())
         .def("PrintVolumeFractions", &openphase::PhaseField::PrintVolumeFractions)
-        .def("WriteDistortedVTK",&openphase::PhaseField::WriteDistortedVTK)
+        .def("DenseFractions", &DenseFractions)
+        .def("SparseFractions", &SparseFractions)
+        .def("WriteDistortedVTK",&openphase::PhaseField::WriteDistortedVTK, release_gil())
         .def("Advect", [](openphase::PhaseField& self,
 				          openphase::AdvectionHR& Adv,
 				          const openphase::Velocities& Vel,
@@ -98,7 +332,7 @@ PYBIND11_MODULE(OpenPhase, m) {
 				          bool finalize) {
 			self.Advect(Adv, Vel, BC, dt, tStep, finalize);
 		}, py::arg("Adv"), py::arg("Vel"), py::arg("BC"), 
-		   py::arg("dt"), py::arg("tStep"), py::arg("finalize") = true)
+		   py::arg("dt"), py::arg("tStep"), py::arg("finalize") = true, release_gil())
 
 		.def("AdvectWithLBM", [](openphase::PhaseField& self,
 				                 openphase::AdvectionHR& Adv,
@@ -109,7 +343,7 @@ PYBIND11_MODULE(OpenPhase, m) {
 				                 bool finalize) {
 			self.Advect(Adv, Vel, BC, LBM, dt, tStep, finalize);
 		}, py::arg("Adv"), py::arg("Vel"), py::arg("BC"), 
-		   py::arg("LBM"), py::arg("dt"), py::arg("tStep"), py::arg("finalize") = true)
+		   py::arg("LBM"), py::arg("dt"), py::arg("tStep"), py::arg("finalize") = true, release_gil())
 		.def_readwrite("FieldsProperties", &openphase::PhaseField::FieldsProperties);
 
         
@@ -118,8 +352,8 @@ PYBIND11_MODULE(OpenPhase, m) {
         .def(py::init<openphase::Settings&, const std::string &>())
         .def("Initialize", &openphase::InterfaceProperties::Initialize)  
         .def("ReadInput",  static_cast<void (openphase::InterfaceProperties::*)(std::string)>(&openphase::InterfaceProperties::ReadInput))  
-	    .def("Set", static_cast<void (openphase::InterfaceProperties::*)(const openphase::PhaseField&, const openphase::BoundaryConditions&)>(&openphase::InterfaceProperties::Set))
-	    .def("Set", static_cast<void (openphase::InterfaceProperties::*)(const openphase::PhaseField&, const openphase::Temperature&, const openphase::BoundaryConditions&)>(&openphase::InterfaceProperties::Set))
+	    .def("Set", static_cast<void (openphase::InterfaceProperties::*)(const openphase::PhaseField&, const openphase::BoundaryConditions&)>(&openphase::InterfaceProperties::Set), release_gil())
+	    .def("Set", static_cast<void (openphase::InterfaceProperties::*)(const openphase::PhaseField&, const openphase::Temperature&, const openphase::BoundaryConditions&)>(&openphase::InterfaceProperties::Set), release_gil())
 	    .def("ReportMaximumTimeStep", &openphase::InterfaceProperties::ReportMaximumTimeStep);;	
 	    
     py::class_<openphase::InterfaceRegularization>(m, "InterfaceRegularization")
@@ -127,15 +361,15 @@ PYBIND11_MODULE(OpenPhase, m) {
         .def(py::init<openphase::Settings&, const std::string &>())
         .def("Initialize", &openphase::InterfaceRegularization::Initialize)  
         .def("ReadInput",  static_cast<void (openphase::InterfaceRegularization::*)(std::string)>(&openphase::InterfaceRegularization::ReadInput))
-        .def("Average", &openphase::InterfaceRegularization::Average)
-        .def("MergePhaseFieldIncrements", &openphase::InterfaceRegularization::MergePhaseFieldIncrements);
+        .def("Average", &openphase::InterfaceRegularization::Average, release_gil())
+        .def("MergePhaseFieldIncrements", &openphase::InterfaceRegularization::MergePhaseFieldIncrements, release_gil());
         
     py::class_<openphase::HeatSources>(m, "HeatSources")
         .def(py::init<>())    
         .def(py::init<openphase::Settings&, const std::string &>())
         .def("Initialize", &openphase::HeatSources::Initialize)  
         .def("ReadInput",  static_cast<void (openphase::HeatSources::*)(std::string)>(&openphase::HeatSources::ReadInput))
-        .def("Apply", &openphase::HeatSources::Apply);
+        .def("Apply", &openphase::HeatSources::Apply, release_gil());
         
 	py::class_<openphase::HeatDiffusion>(m, "HeatDiffusion")
         .def(py::init<>())    
@@ -146,19 +380,19 @@ PYBIND11_MODULE(OpenPhase, m) {
 			const openphase::PhaseField&,
 			const openphase::Temperature&)>(
 				&openphase::HeatDiffusion::SetEffectiveProperties)
-		)
-        .def("SolveImplicit", &openphase::HeatDiffusion::SolveImplicit);	       
+		, release_gil())
+        .def("SolveImplicit", &openphase::HeatDiffusion::SolveImplicit, release_gil());	       
 			
 	py::class_<openphase::DrivingForce>(m, "DrivingForce")
         .def(py::init<>())     
         .def(py::init<openphase::Settings&, const std::string &>())
         .def("Initialize", &openphase::DrivingForce::Initialize)
         .def("ReadInput",  static_cast<void (openphase::DrivingForce::*)(std::string)>(&openphase::DrivingForce::ReadInput))
-        .def("Average", &openphase::DrivingForce::Average)
+        .def("Average", &openphase::DrivingForce::Average, release_gil())
         .def("Clear", &openphase::DrivingForce::Clear)
-        .def("MergePhaseFieldIncrements", &openphase::DrivingForce::MergePhaseFieldIncrements)
+        .def("MergePhaseFieldIncrements", &openphase::DrivingForce::MergePhaseFieldIncrements, release_gil())
         .def("PrintDiagnostics", &openphase::DrivingForce::PrintDiagnostics)
-        .def("WriteVTK",static_cast<void (openphase::DrivingForce::*)(const openphase::Settings&, const openphase::PhaseField&, const int, const int) const>(&openphase::DrivingForce::WriteVTK));      
+        .def("WriteVTK",static_cast<void (openphase::DrivingForce::*)(const openphase::Settings&, const openphase::PhaseField&, const int, const int) const>(&openphase::DrivingForce::WriteVTK), release_gil());      
         
     py::class_<openphase::DoubleObstacle>(m, "DoubleObstacle")
         .def(py::init<>())   
@@ -166,17 +400,17 @@ PYBIND11_MODULE(OpenPhase, m) {
         .def("Initialize", &openphase::DoubleObstacle::Initialize)  
 	    .def("CalculatePhaseFieldIncrements",
          py::overload_cast<openphase::PhaseField&, openphase::InterfaceProperties&>(
-             &openphase::DoubleObstacle::CalculatePhaseFieldIncrements))
+             &openphase::DoubleObstacle::CalculatePhaseFieldIncrements), release_gil())
         .def("CalculatePhaseFieldIncrements",
              py::overload_cast<openphase::PhaseField&, openphase::InterfaceProperties&, openphase::DrivingForce&>(
-                 &openphase::DoubleObstacle::CalculatePhaseFieldIncrements))
+                 &openphase::DoubleObstacle::CalculatePhaseFieldIncrements), release_gil())
         .def("CalculatePhaseFieldIncrements",
              py::overload_cast<openphase::PhaseField&, openphase::InterfaceProperties&, openphase::InterfaceRegularization&>(
-                 &openphase::DoubleObstacle::CalculatePhaseFieldIncrements))
+                 &openphase::DoubleObstacle::CalculatePhaseFieldIncrements), release_gil())
         .def("CalculatePhaseFieldIncrements",
              py::overload_cast<openphase::PhaseField&, openphase::InterfaceProperties&, openphase::DrivingForce&, openphase::InterfaceRegularization&>(
-                 &openphase::DoubleObstacle::CalculatePhaseFieldIncrements))
-	    .def("AverageEnergyDensity", &openphase::DoubleObstacle::AverageEnergyDensity);
+                 &openphase::DoubleObstacle::CalculatePhaseFieldIncrements), release_gil())
+	    .def("AverageEnergyDensity", &openphase::DoubleObstacle::AverageEnergyDensity, release_gil());
 	
     py::class_<openphase::Composition>(m, "Composition")
         .def(py::init<>())      
@@ -184,39 +418,53 @@ PYBIND11_MODULE(OpenPhase, m) {
 		.def("Initialize", &openphase::Composition::Initialize)
         .def("ReadInput",  static_cast<void (openphase::Composition::*)(std::string)>(&openphase::Composition::ReadInput))
         .def("SetBoundaryConditions",&openphase::Composition::SetBoundaryConditions)
-        .def("CalculateMoleFractionsAverage",&openphase::Composition::CalculateMoleFractionsAverage)
-        .def("SetInitialMoleFractions", &openphase::Composition::SetInitialMoleFractions)
-        .def("Read", &openphase::Composition::Read)
-        .def("Write", &openphase::Composition::Write)
+        .def("CalculateMoleFractionsAverage",&openphase::Composition::CalculateMoleFractionsAverage, release_gil())
+        .def("SetInitialMoleFractions", &openphase::Composition::SetInitialMoleFractions, release_gil())
+        .def("Read", &openphase::Composition::Read, release_gil())
+        .def("Write", &openphase::Composition::Write, release_gil())
         .def("WriteStatistics", &openphase::Composition::WriteStatistics)
-        .def("WriteVTK",&openphase::Composition::WriteVTK)
-		.def("Advect",&openphase::Composition::Advect);     
+        .def("WriteVTK",&openphase::Composition::WriteVTK, release_gil())
+		.def("Advect",&openphase::Composition::Advect, release_gil())
+        .def_property_readonly("MoleFractionsTotal", [](openphase::Composition& self) -> openphase::Storage3D<double,1>& {return self.MoleFractionsTotal;},
+             py::return_value_policy::reference_internal);     
            
      py::class_<openphase::Temperature>(m, "Temperature")
         .def(py::init<>())     
         .def(py::init<openphase::Settings&, const std::string &>())
 		.def("Initialize", &openphase::Temperature::Initialize)
         .def("ReadInput",  static_cast<void (openphase::Temperature::*)(std::string)>(&openphase::Temperature::ReadInput))
-        .def("SetInitial", &openphase::Temperature::SetInitial)
-        .def("WriteVTK",&openphase::Temperature::WriteVTK)
-        .def("Write",&openphase::Temperature::Write)
-        .def("Read",&openphase::Temperature::Read)
-        .def("Advect",&openphase::Temperature::Advect)
-        .def("PrintStatistics",&openphase::Temperature::PrintStatistics);
+        .def("SetInitial", &openphase::Temperature::SetInitial, release_gil())
+        .def("WriteVTK",&openphase::Temperature::WriteVTK, release_gil())
+        .def("Write",&openphase::Temperature::Write, release_gil())
+        .def("Read",&openphase::Temperature::Read, release_gil())
+        .def("Advect",&openphase::Temperature::Advect, release_gil())
+        .def("PrintStatistics",&openphase::Temperature::PrintStatistics)
+        .def_property_readonly("Tx", [](openphase::Temperature& self) -> openphase::Storage3D<double,0>& {return self.Tx;},
+             py::return_value_policy::reference_internal);
+
+    py::class_<openphase::Velocities>(m, "Velocities")
+        .def(py::init<>())
+        .def(py::init<openphase::Settings&>())
+        .def("Initialize", &openphase::Velocities::Initialize)
+        .def("SetBoundaryConditions", &openphase::Velocities::SetBoundaryConditions)
+        .def("CalculateAverage", &openphase::Velocities::CalculateAverage, release_gil())
+        .def("WriteVTK", &openphase::Velocities::WriteVTK, release_gil())
+        .def_property_readonly("Average", [](openphase::Velocities& self) -> openphase::Storage3D<openphase::dVector3,0>& {return self.Average;},
+             py::return_value_policy::reference_internal);
               
     py::class_<openphase::ElasticProperties>(m, "ElasticProperties")
         .def(py::init<>())     
         .def(py::init<openphase::Settings&, const std::string &>())
 		.def("Initialize", &openphase::ElasticProperties::Initialize)
         .def("ReadInput",  static_cast<void (openphase::ElasticProperties::*)(std::string)>(&openphase::ElasticProperties::ReadInput))
-        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&>(&openphase::ElasticProperties::SetEffectiveProperties))
-        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&, const openphase::Composition&>(&openphase::ElasticProperties::SetEffectiveProperties))
-        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&, const openphase::Temperature&>(&openphase::ElasticProperties::SetEffectiveProperties))
-        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&, const openphase::Composition&, const openphase::Temperature&>(&openphase::ElasticProperties::SetEffectiveProperties))
-        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&, const openphase::InterfaceProperties&>(&openphase::ElasticProperties::SetEffectiveProperties))
-        .def("CalculateDrivingForce",static_cast<void (openphase::ElasticProperties::*)(const openphase::PhaseField&, openphase::DrivingForce&)>(&openphase::ElasticProperties::CalculateDrivingForce))
-        .def("WritePlasticStrainsVTK", &openphase::ElasticProperties::WritePlasticStrainsVTK)
-        .def("WriteTotalRotationsVTK", &openphase::ElasticProperties::WriteTotalRotationsVTK);     
+        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&>(&openphase::ElasticProperties::SetEffectiveProperties), release_gil())
+        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&, const openphase::Composition&>(&openphase::ElasticProperties::SetEffectiveProperties), release_gil())
+        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&, const openphase::Temperature&>(&openphase::ElasticProperties::SetEffectiveProperties), release_gil())
+        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&, const openphase::Composition&, const openphase::Temperature&>(&openphase::ElasticProperties::SetEffectiveProperties), release_gil())
+        .def("SetEffectiveProperties", py::overload_cast<const openphase::PhaseField&, const openphase::InterfaceProperties&>(&openphase::ElasticProperties::SetEffectiveProperties), release_gil())
+        .def("CalculateDrivingForce",static_cast<void (openphase::ElasticProperties::*)(const openphase::PhaseField&, openphase::DrivingForce&)>(&openphase::ElasticProperties::CalculateDrivingForce), release_gil())
+        .def("WritePlasticStrainsVTK", &openphase::ElasticProperties::WritePlasticStrainsVTK, release_gil())
+        .def("WriteTotalRotationsVTK", &openphase::ElasticProperties::WriteTotalRotationsVTK, release_gil());     
         
     py::class_<openphase::ElasticitySolverSpectral>(m, "ElasticitySolverSpectral")
         .def(py::init<>())     
@@ -224,25 +472,25 @@ PYBIND11_MODULE(OpenPhase, m) {
 		.def("Initialize", static_cast<void (openphase::ElasticitySolverSpectral::*)(openphase::Settings&, std::string)>(&openphase::ElasticitySolverSpectral::Initialize))
 		.def("Initialize", static_cast<void (openphase::ElasticitySolverSpectral::*)(openphase::Settings&, const openphase::BoundaryConditions&, std::string)>(&openphase::ElasticitySolverSpectral::Initialize))
         .def("ReadInput",  static_cast<void (openphase::ElasticitySolverSpectral::*)(std::string)>(&openphase::ElasticitySolverSpectral::ReadInput))
-        .def("Solve", static_cast<int (openphase::ElasticitySolverSpectral::*)(openphase::ElasticProperties&, openphase::BoundaryConditions&, double, std::function<bool()>)>(&openphase::ElasticitySolverSpectral::Solve));    
+        .def("Solve", static_cast<int (openphase::ElasticitySolverSpectral::*)(openphase::ElasticProperties&, openphase::BoundaryConditions&, double, std::function<bool()>)>(&openphase::ElasticitySolverSpectral::Solve), release_gil());    
                 
     py::class_<openphase::Nucleation>(m, "Nucleation")
         .def(py::init<>())     
         .def(py::init<openphase::Settings&, const std::string &>())
 		.def("Initialize", &openphase::Nucleation::Initialize)
         .def("ReadInput",  static_cast<void (openphase::Nucleation::*)(std::string)>(&openphase::Nucleation::ReadInput))
-        .def("GenerateNucleationSites", &openphase::Nucleation::GenerateNucleationSites)
-        .def("PlantNuclei", &openphase::Nucleation::PlantNuclei)
-        .def("CheckNuclei", &openphase::Nucleation::CheckNuclei)
-        .def("Write", &openphase::Nucleation::Write)
-        .def("Read", &openphase::Nucleation::Read); 
+        .def("GenerateNucleationSites", &openphase::Nucleation::GenerateNucleationSites, release_gil())
+        .def("PlantNuclei", &openphase::Nucleation::PlantNuclei, release_gil())
+        .def("CheckNuclei", &openphase::Nucleation::CheckNuclei, release_gil())
+        .def("Write", &openphase::Nucleation::Write, release_gil())
+        .def("Read", &openphase::Nucleation::Read, release_gil()); 
         
     py::class_<openphase::UserDrivingForce>(m, "UserDrivingForce")
         .def(py::init<>())    
         .def(py::init<openphase::Settings&, const std::string &>()) 
 		.def("Initialize", &openphase::UserDrivingForce::Initialize)
         .def("ReadInput",  static_cast<void (openphase::UserDrivingForce::*)(std::string)>(&openphase::UserDrivingForce::ReadInput))
-        .def("SetDrivingForce", static_cast<void (openphase::UserDrivingForce::*)(openphase::PhaseField&, openphase::DrivingForce&, openphase::Temperature&)>(&openphase::UserDrivingForce::SetDrivingForce));     
+        .def("SetDrivingForce", static_cast<void (openphase::UserDrivingForce::*)(openphase::PhaseField&, openphase::DrivingForce&, openphase::Temperature&)>(&openphase::UserDrivingForce::SetDrivingForce), release_gil());     
                   
     py::class_<openphase::Crystallography>(m, "Crystallography")
         .def(py::init<>())     
@@ -263,23 +511,30 @@ PYBIND11_MODULE(OpenPhase, m) {
         .def("ReadInput",  static_cast<void (openphase::FlowSolverLBM::*)(std::string)>(&openphase::FlowSolverLBM::ReadInput))
         .def("Solve", static_cast<void (openphase::FlowSolverLBM::*)(
 			openphase::PhaseField&, openphase::Velocities&, const openphase::BoundaryConditions&)>(
-			&openphase::FlowSolverLBM::Solve))
+			&openphase::FlowSolverLBM::Solve), release_gil())
 		.def("Solve", static_cast<void (openphase::FlowSolverLBM::*)(
 			openphase::PhaseField&, const openphase::Composition&, openphase::Velocities&, const openphase::BoundaryConditions&)>(
-			&openphase::FlowSolverLBM::Solve))
+			&openphase::FlowSolverLBM::Solve), release_gil())
 		.def("SetUniformVelocity", &openphase::FlowSolverLBM::SetUniformVelocity);   
     
+    py::class_<NormalGrainGrowth>(m, "NormalGrainGrowth")
+        .def(py::init<openphase::Settings&, openphase::RunTimeControl&, openphase::PhaseField&,
+                      openphase::DoubleObstacle&, openphase::InterfaceProperties&, openphase::BoundaryConditions&>(),
+             py::keep_alive<1,2>(), py::keep_alive<1,3>(), py::keep_alive<1,4>(),
+             py::keep_alive<1,5>(), py::keep_alive<1,6>(), py::keep_alive<1,7>())
+        .def("Step", &NormalGrainGrowth::Step, py::arg("n") = 1, release_gil());
+
     py::class_<openphase::Initializations>(m, "Initializations")
-        .def_static("VoronoiTessellation",  &openphase::Initializations::VoronoiTessellation)   
-        .def_static("Single",  &openphase::Initializations::Single);   
+        .def_static("VoronoiTessellation",  &openphase::Initializations::VoronoiTessellation, release_gil())   
+        .def_static("Single",  &openphase::Initializations::Single, release_gil());   
         
     py::class_<openphase::EquilibriumPartitionDiffusionBinary>(m, "EquilibriumPartitionDiffusionBinary")
         .def(py::init<>())     
         .def(py::init<openphase::Settings&, const std::string &>())
 		.def("Initialize", &openphase::EquilibriumPartitionDiffusionBinary::Initialize)
         .def("ReadInput",  static_cast<void (openphase::EquilibriumPartitionDiffusionBinary::*)(std::string)>(&openphase::EquilibriumPartitionDiffusionBinary::ReadInput))
-        .def("SolveDiffusion", &openphase::EquilibriumPartitionDiffusionBinary::SolveDiffusion)
-        .def("CalculateDrivingForce", &openphase::EquilibriumPartitionDiffusionBinary::CalculateDrivingForce);  
+        .def("SolveDiffusion", &openphase::EquilibriumPartitionDiffusionBinary::SolveDiffusion, release_gil())
+        .def("CalculateDrivingForce", &openphase::EquilibriumPartitionDiffusionBinary::CalculateDrivingForce, release_gil());  
         
     py::class_<openphase::TimeInfo>(m, "TimeInfo")
         .def(py::init<>())     
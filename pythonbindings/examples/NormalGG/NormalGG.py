@@ -22,6 +22,7 @@ from OpenPhase import (
     BoundaryConditions,
     Initializations,
     TimeInfo,
+    NormalGrainGrowth,
 )
 # Optional (only if available in bindings)
 try:
@@ -57,6 +58,20 @@ def main():
     print("Entering the Time Loop!!!")
 
     # --- Main time-stepping loop ---
+    # The per-step calls below are the explicit form of the loop. With
+    # use_driver the steps run in C++ (NormalGrainGrowth.Step) in chunks of
+    # steps_per_call, the GIL is released meanwhile.
+    use_driver = True
+    steps_per_call = 100
+
+    if use_driver:
+        GG = NormalGrainGrowth(OPSettings, RTC, Phi, DO, IP, BC)
+        while GG.Step(steps_per_call) > 0:
+            # Analysis of the current state, e.g. through Phi.SparseFractions()
+            pass
+        print("Simulation finished successfully.")
+        return
+
     t = RTC.StartTimeStep
     while t <= RTC.MaxTimeStep:
         Timer.SetStart()
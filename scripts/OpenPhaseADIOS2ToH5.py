@@ -0,0 +1,75 @@
+# -------------------------------------------------------------
+# -------------------------------------------------------------
+#        	  OpenPhaseADIOS2ToH5
+#
+# 	Converter of the ADIOS2 output of OpenPhase (ADIOS2Interface)
+#	into the HDF5 layout of H5Interface
+# Call function with the following parameters:
+# - Name of the ADIOS2 output (e.g. NormalGG_output.bp)
+# - (Optional) Name of the HDF5 file, default: the input file
+#   name with ".h5" instead of ".bp"
+#
+# Every ADIOS2 step holds the time step index /Step/TimeStep and
+# the variables written by one call:
+#   /Visualization/<Field>  ->  /Visualization/<Field>/<tStep>
+#   /CheckPoints/...        ->  /CheckPoints/... , the blocks of
+#                               the ranks are concatenated and
+#                               their sizes stored in the
+#                               RankSizes attribute
+# Requires the ADIOS2 Python bindings (2.10 or newer) and h5py.
+#
+# 	OpenPhase, ICAMS, Ruhr-Universitaet Bochum
+# -------------------------------------------------------------
+# -------------------------------------------------------------
+
+import sys, os
+import numpy as np
+import adios2
+import h5py
+
+# -------------------------------------------------------------
+# -------------------------------------------------------------
+
+def writeDataset(h5file, path, data, ranksizes = None):
+	if path in h5file:
+		del h5file[path]
+	dataset = h5file.create_dataset(path, data = data)
+	if ranksizes is not None:
+		dataset.attrs['RankSizes'] = np.asarray(ranksizes, dtype = np.uint64)
+
+def readBlocks(stream, name):
+	variable = stream.inquire_variable(name)
+	blocks = stream._engine.blocks_info(name, stream.current_step())
+	data = []
+	for block in range(len(blocks)):
+		variable.set_block_selection(block)
+		data.append(np.asarray(stream.read(variable)).ravel())
+	return data
+
+def convert(infile, outfile):
+	with adios2.Stream(infile, 'r') as stream, h5py.File(outfile, 'a') as h5file:
+		for _ in stream.steps():
+			names = stream.available_variables()
+			if '/Step/TimeStep' not in names:
+				continue
+			tstep = int(stream.read('/Step/TimeStep'))
+			for name in names:
+				if name.startswith('/Visualization/'):
+					writeDataset(h5file, name + '/' + str(tstep), stream.read(name))
+				elif name.startswith('/CheckPoints/'):
+					blocks = readBlocks(stream, name)
+					writeDataset(h5file, name, np.concatenate(blocks), [b.size for b in blocks])
+			print("Time step " + str(tstep) + " converted")
+
+# -------------------------------------------------------------
+# -------------------------------------------------------------
+
+if __name__ == '__main__':
+	if len(sys.argv) < 2:
+		sys.exit("Error: Name of the ADIOS2 output missing. Quit!")
+	infile = sys.argv[1]
+	if len(sys.argv) > 2:
+		outfile = sys.argv[2]
+	else:
+		outfile = os.path.splitext(infile.rstrip('/'))[0] + '.h5'
+	convert(infile, outfile)
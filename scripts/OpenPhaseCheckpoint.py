@@ -0,0 +1,85 @@
+# -------------------------------------------------------------
+# -------------------------------------------------------------
+#        	  OpenPhaseCheckpoint
+#
+# 	Reconstruction tool for incremental checkpoints of OpenPhase
+#	($DeltaCheckpoints > 0 in the @Settings module)
+# Call function with the following parameters:
+# - Name of the checkpoint file of the time step to reconstruct
+#   (e.g. RawData/PhaseField_00012000.delta)
+# - (Optional) Name of the output file, default: the input file
+#   name with ".full" appended
+#
+# The chain of checkpoints back to the last full one is merged
+# into a single full checkpoint. Renamed to the original file
+# name it can be used for a restart without the earlier files.
+#
+# 	OpenPhase, ICAMS, Ruhr-Universitaet Bochum
+# -------------------------------------------------------------
+# -------------------------------------------------------------
+
+import sys, os
+import re
+import struct
+
+MAGIC = b'OPDELTA1'
+HEADER = struct.Struct('<8s5iQ')
+BLOCK = struct.Struct('<QQ')
+
+# -------------------------------------------------------------
+# -------------------------------------------------------------
+
+def readHeader(filename):
+	with open(filename, 'rb') as f:
+		magic, previous, nx, ny, nz, blocksize, count = HEADER.unpack(f.read(HEADER.size))
+	if magic != MAGIC:
+		sys.exit("Error: " + filename + " is not an incremental checkpoint. Quit!")
+	return previous, (nx, ny, nz, blocksize)
+
+def readBlocks(filename, blocks):
+	with open(filename, 'rb') as f:
+		count = HEADER.unpack(f.read(HEADER.size))[-1]
+		for n in range(count):
+			idx, size = BLOCK.unpack(f.read(BLOCK.size))
+			blocks[idx] = f.read(size)
+
+def stepFileName(filename, step):
+	# Replaces the (zero padded) time step in the file name
+	match = re.search(r'(\d+)(\.delta)$', filename)
+	if match is None:
+		sys.exit("Error: Time step not found in " + filename + ". Quit!")
+	digits = match.group(1)
+	return filename[:match.start(1)] + str(step).zfill(len(digits)) + match.group(2)
+
+def reconstruct(filename, output):
+	chain = [filename]
+	previous, dimensions = readHeader(filename)
+	while previous >= 0:
+		name = stepFileName(filename, previous)
+		if not os.path.isfile(name):
+			sys.exit("Error: Checkpoint " + name + " is missing. Quit!")
+		previous, locdimensions = readHeader(name)
+		if locdimensions != dimensions:
+			sys.exit("Error: Inconsistent dimensions in " + name + ". Quit!")
+		chain.append(name)
+
+	blocks = {}
+	for name in reversed(chain):
+		readBlocks(name, blocks)
+
+	nx, ny, nz, blocksize = dimensions
+	with open(output, 'wb') as f:
+		f.write(HEADER.pack(MAGIC, -1, nx, ny, nz, blocksize, len(blocks)))
+		for idx in sorted(blocks):
+			f.write(BLOCK.pack(idx, len(blocks[idx])))
+			f.write(blocks[idx])
+	print("Merged " + str(len(chain)) + " checkpoint(s) into " + output)
+
+# -------------------------------------------------------------
+# -------------------------------------------------------------
+
+if __name__ == '__main__':
+	if len(sys.argv) < 2:
+		sys.exit("Usage: OpenPhaseCheckpoint.py <checkpoint.delta> [output]")
+	output = sys.argv[2] if len(sys.argv) > 2 else sys.argv[1] + '.full'
+	reconstruct(sys.argv[1], output)
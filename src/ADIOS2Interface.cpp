@@ -0,0 +1,312 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "ADIOS2Interface.h"
+
+#ifdef ADIOS2OP
+#include <adios2.h>
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+#endif
+
+namespace openphase
+{
+using namespace std;
+
+struct ADIOS2Interface::Handles
+{
+#ifdef ADIOS2OP
+    unique_ptr<adios2::ADIOS> Adios;
+    adios2::IO Output;
+    adios2::Engine Writer;
+#endif
+};
+
+ADIOS2Interface::ADIOS2Interface() :
+    Engine("BP5"), Aggregators(0), AsyncWrite(true), ADIOS2(make_unique<Handles>())
+{
+}
+
+ADIOS2Interface::~ADIOS2Interface()
+{
+    CloseFile();
+}
+
+void ADIOS2Interface::ReadInput(const std::string InputFileName)
+{
+    stringstream inp = FileInterface::OpenInput(InputFileName);
+    if (!inp)
+    {
+        ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened", thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    };
+    stringstream data;
+    data << inp.rdbuf();
+    ReadInput(data);
+}
+
+void ADIOS2Interface::ReadInput(std::stringstream& inp)
+{
+    const int moduleLocation = FileInterface::FindModuleLocation(inp, thisclassname);
+
+    Engine      = FileInterface::ReadParameterS(inp, moduleLocation, "Engine", false, Engine);
+    Aggregators = FileInterface::ReadParameterI(inp, moduleLocation, "Aggregators", false, Aggregators);
+    AsyncWrite  = FileInterface::ReadParameterB(inp, moduleLocation, "AsyncWrite", false, AsyncWrite);
+    Config      = FileInterface::ReadParameterS(inp, moduleLocation, "Config", false, Config);
+}
+
+void ADIOS2Interface::OpenFile(const std::string InputFileName, const std::string OutputFileName)
+{
+    CloseFile();
+    ADIOS2InputFileName  = InputFileName;
+    ADIOS2OutputFileName = OutputFileName;
+
+    #ifdef ADIOS2OP
+    #ifdef MPI_PARALLEL
+    ADIOS2->Adios = Config.empty() ? make_unique<adios2::ADIOS>(MPI_COMM_WORLD)
+                                   : make_unique<adios2::ADIOS>(Config, MPI_COMM_WORLD);
+    #else
+    ADIOS2->Adios = Config.empty() ? make_unique<adios2::ADIOS>()
+                                   : make_unique<adios2::ADIOS>(Config);
+    #endif
+    /* The settings of a configuration file take precedence */
+    ADIOS2->Output = ADIOS2->Adios->DeclareIO("Output");
+    if(not ADIOS2->Output.InConfigFile())
+    {
+        ADIOS2->Output.SetEngine(Engine);
+        if(Aggregators > 0)
+        {
+            ADIOS2->Output.SetParameter("NumAggregators", to_string(Aggregators));
+        }
+        ADIOS2->Output.SetParameter("AsyncWrite", AsyncWrite ? "true" : "false");
+    }
+    ADIOS2->Writer = ADIOS2->Output.Open(ADIOS2OutputFileName, adios2::Mode::Write);
+    #else
+    ConsoleOutput::WriteExit("OpenPhase is not compiled with ADIOS2 support, use: make SETTINGS=\"adios2\"", thisclassname, "OpenFile()");
+    OP_Exit(EXIT_ADIOS2_ERROR);
+    #endif
+}
+
+void ADIOS2Interface::CloseFile(void)
+{
+    #ifdef ADIOS2OP
+    if(ADIOS2->Writer)
+    {
+        ADIOS2->Writer.Close();
+        ADIOS2->Writer = adios2::Engine();
+    }
+    #endif
+}
+
+#ifdef ADIOS2OP
+/* Values of an output field as floats (x fastest), as in the HDF5 output,
+returns false if the field has a different type */
+template<class T>
+static bool TabulateAs(const OutputField& Field,
+                       const long int Nx, const long int Ny, const long int Nz,
+                       vector<float>& Data, size_t& Ncomp)
+{
+    if(Field.ValueType() != typeid(T)) return false;
+
+    const vector<T> Values = Field.Values<T>(Nx, Ny, Nz);
+    if constexpr (is_arithmetic<T>::value)
+    {
+        Ncomp = 1;
+        Data.assign(Values.begin(), Values.end());
+    }
+    else
+    {
+        Ncomp = Values.empty() ? 0 : Values[0].writeBinary().size();
+        Data.resize(Ncomp*Values.size());
+        #pragma omp parallel for schedule(static)
+        for(size_t n = 0; n < Values.size(); n++)
+        {
+            const vector<double> Components = Values[n].writeBinary();
+            copy(Components.begin(), Components.end(), Data.begin() + n*Ncomp);
+        }
+    }
+    return true;
+}
+
+/* Variables are defined at their first use, the selection follows the local
+box which changes with the load balancing */
+template<class T>
+static adios2::Variable<T> Variable(adios2::IO& IO, const string& Name, const adios2::Dims& Shape,
+                                    const adios2::Dims& Start, const adios2::Dims& Count)
+{
+    adios2::Variable<T> locVariable = IO.InquireVariable<T>(Name);
+    if(not locVariable)
+    {
+        return IO.DefineVariable<T>(Name, Shape, Start, Count);
+    }
+    if(not Shape.empty()) locVariable.SetShape(Shape);
+    locVariable.SetSelection({Start, Count});
+    return locVariable;
+}
+#endif
+
+void ADIOS2Interface::WriteVisualization(
+        int tStep,
+        const Settings& locSettings,
+        std::vector<Field_t> ListOfFields,
+        const int resolution)
+{
+    #ifdef ADIOS2OP
+    if(not ADIOS2->Writer)
+    {
+        ConsoleOutput::WriteExit("Output is not open, call OpenFile() first", thisclassname, "WriteVisualization()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    if(not locSettings.OutputRegions.empty())
+    {
+        ConsoleOutput::WriteWarning("Output regions are not supported, writing the whole domain", thisclassname, "WriteVisualization()");
+    }
+    const GridParameters& Grid = locSettings.Grid;
+    const long int Nx = resolution*Grid.Nx;
+    const long int Ny = resolution*Grid.Ny;
+    const long int Nz = resolution*Grid.Nz;
+
+    adios2::IO& IO = ADIOS2->Output;
+    adios2::Engine& Writer = ADIOS2->Writer;
+    Writer.BeginStep();
+    #ifdef MPI_PARALLEL
+    if(MPI_RANK == 0)
+    #endif
+    {
+        Writer.Put(Variable<int>(IO, "/Step/TimeStep", {}, {}, {}), tStep);
+    }
+
+    vector<float> Data;
+    for(const Field_t& Field : ListOfFields)
+    {
+        size_t Ncomp = 0;
+        if(not (TabulateAs<int>       (Field, Nx, Ny, Nz, Data, Ncomp) or
+                TabulateAs<size_t>    (Field, Nx, Ny, Nz, Data, Ncomp) or
+                TabulateAs<double>    (Field, Nx, Ny, Nz, Data, Ncomp) or
+                TabulateAs<dVector3>  (Field, Nx, Ny, Nz, Data, Ncomp) or
+                TabulateAs<dVector6>  (Field, Nx, Ny, Nz, Data, Ncomp) or
+                TabulateAs<vStrain>   (Field, Nx, Ny, Nz, Data, Ncomp) or
+                TabulateAs<vStress>   (Field, Nx, Ny, Nz, Data, Ncomp) or
+                TabulateAs<dMatrix3x3>(Field, Nx, Ny, Nz, Data, Ncomp) or
+                TabulateAs<dMatrix6x6>(Field, Nx, Ny, Nz, Data, Ncomp)))
+        {
+            ConsoleOutput::WriteWarning("Field \"" + Field.Name + "\" has an unsupported type, skipped", thisclassname, "WriteVisualization()");
+            continue;
+        }
+        adios2::Dims Shape {size_t(resolution*Grid.TotalNz), size_t(resolution*Grid.TotalNy), size_t(resolution*Grid.TotalNx)};
+        adios2::Dims Start {size_t(resolution*Grid.OffsetZ), size_t(resolution*Grid.OffsetY), size_t(resolution*Grid.OffsetX)};
+        adios2::Dims Count {size_t(Nz), size_t(Ny), size_t(Nx)};
+        if(Ncomp > 1)
+        {
+            Shape.push_back(Ncomp);
+            Start.push_back(0);
+            Count.push_back(Ncomp);
+        }
+        /* Sync put copies into the engine buffers, Data is reused */
+        Writer.Put(Variable<float>(IO, "/Visualization/" + Field.Name, Shape, Start, Count),
+                   Data.data(), adios2::Mode::Sync);
+    }
+    Writer.EndStep();
+    #else
+    ConsoleOutput::WriteWarning("OpenPhase is not compiled with ADIOS2 support, skipping ADIOS2 visualization write", thisclassname, "WriteVisualization()");
+    #endif
+}
+
+void ADIOS2Interface::WriteCheckPoint(int tStep, std::string name, std::vector<double>& data,
+                                      const std::string leaf)
+{
+    #ifdef ADIOS2OP
+    if(not ADIOS2->Writer)
+    {
+        ConsoleOutput::WriteExit("Output is not open, call OpenFile() first", thisclassname, "WriteCheckPoint()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    string path = "/CheckPoints/" + name + "/" + to_string(tStep);
+    if(not leaf.empty()) path += "/" + leaf;
+
+    adios2::IO& IO = ADIOS2->Output;
+    adios2::Engine& Writer = ADIOS2->Writer;
+    Writer.BeginStep();
+    #ifdef MPI_PARALLEL
+    if(MPI_RANK == 0)
+    #endif
+    {
+        Writer.Put(Variable<int>(IO, "/Step/TimeStep", {}, {}, {}), tStep);
+    }
+    /* Local array: no global shape, each rank contributes one block */
+    Writer.Put(Variable<double>(IO, path, {}, {}, {data.size()}), data.data(), adios2::Mode::Sync);
+    Writer.EndStep();
+    #else
+    ConsoleOutput::WriteExit("OpenPhase is not compiled with ADIOS2 support, use: make SETTINGS=\"adios2\"", thisclassname, "WriteCheckPoint()");
+    OP_Exit(EXIT_ADIOS2_ERROR);
+    #endif
+}
+
+void ADIOS2Interface::ReadCheckPoint(int tStep, std::string name, std::vector<double>& data)
+{
+    #ifdef ADIOS2OP
+    const string path = "/CheckPoints/" + name + "/" + to_string(tStep);
+
+    #ifdef MPI_PARALLEL
+    adios2::ADIOS Adios(MPI_COMM_WORLD);
+    const int Rank = MPI_RANK;
+    const int Size = MPI_SIZE;
+    #else
+    adios2::ADIOS Adios;
+    const int Rank = 0;
+    const int Size = 1;
+    #endif
+    adios2::IO Input = Adios.DeclareIO("Input");
+    Input.SetEngine(Engine);
+    adios2::Engine Reader = Input.Open(ADIOS2InputFileName, adios2::Mode::ReadRandomAccess);
+
+    adios2::Variable<double> locVariable = Input.InquireVariable<double>(path);
+    if(not locVariable)
+    {
+        ConsoleOutput::WriteExit(path + " not found in " + ADIOS2InputFileName, thisclassname, "ReadCheckPoint()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    const size_t Step = locVariable.StepsStart();
+    const size_t Blocks = Reader.BlocksInfo(locVariable, Step).size();
+    if(Blocks != size_t(Size))
+    {
+        ConsoleOutput::WriteExit(path + " was written by " + to_string(Blocks)
+                                 + " MPI ranks, restart requires the same number of ranks.", thisclassname, "ReadCheckPoint()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    locVariable.SetStepSelection({Step, 1});
+    locVariable.SetBlockSelection(Rank);
+    data.resize(locVariable.SelectionSize());
+    Reader.Get(locVariable, data.data(), adios2::Mode::Sync);
+    Reader.Close();
+    #else
+    ConsoleOutput::WriteExit("OpenPhase is not compiled with ADIOS2 support, use: make SETTINGS=\"adios2\"", thisclassname, "ReadCheckPoint()");
+    OP_Exit(EXIT_ADIOS2_ERROR);
+    #endif
+}
+
+}// namespace openphase
@@ -0,0 +1,192 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "AsyncOutput.h"
+#include "ConsoleOutput.h"
+#include "Embedded.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace openphase
+{
+using namespace std;
+
+/* State of the service shared by the calling thread and the I/O threads,
+all members are protected by Mutex */
+struct AsyncOutputState
+{
+    mutex Mutex;
+    condition_variable TaskAvailable;                                           ///< Signals new tasks and the stop request to the I/O threads
+    condition_variable TaskFinished;                                            ///< Signals finished tasks to Submit() and Flush()
+    deque<pair<function<void()>, size_t>> Tasks;                                ///< Pending tasks and their staged memory
+    vector<thread> Threads;
+    size_t MemoryLimit = AsyncOutput::DefaultMemoryLimit;
+    size_t StagedBytes = 0;                                                     ///< Memory staged by pending and running tasks
+    size_t Running = 0;                                                         ///< Number of tasks being executed
+    bool Stopping = false;
+
+    ~AsyncOutputState()                                                         ///< Writes the pending output at program exit
+    {
+        {
+            lock_guard<mutex> lock(Mutex);
+            Stopping = true;
+        }
+        TaskAvailable.notify_all();
+        for(auto& Thread : Threads)
+        {
+            Thread.join();
+        }
+    }
+};
+
+static AsyncOutputState& State(void)
+{
+    static AsyncOutputState state;
+    return state;
+}
+
+static thread_local bool IsIOThread = false;
+
+void AsyncOutput::Start(const size_t nThreads, const size_t MemoryLimit)
+{
+    Stop();
+    AsyncOutputState& S = State();
+    {
+        lock_guard<mutex> lock(S.Mutex);
+        S.MemoryLimit = MemoryLimit;
+        S.Stopping = false;
+    }
+    for(size_t n = 0; n < max<size_t>(nThreads, 1); n++)
+    {
+        S.Threads.emplace_back(Worker);
+    }
+}
+
+void AsyncOutput::Stop(void)
+{
+    AsyncOutputState& S = State();
+    {
+        lock_guard<mutex> lock(S.Mutex);
+        S.Stopping = true;
+    }
+    S.TaskAvailable.notify_all();
+    for(auto& Thread : S.Threads)
+    {
+        Thread.join();
+    }
+    S.Threads.clear();
+}
+
+void AsyncOutput::Flush(void)
+{
+    if(IsIOThread) return;
+    AsyncOutputState& S = State();
+    unique_lock<mutex> lock(S.Mutex);
+    S.TaskFinished.wait(lock, [&S]{return S.Tasks.empty() and S.Running == 0;});
+}
+
+bool AsyncOutput::Active(void)
+{
+    AsyncOutputState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    return not S.Threads.empty() and not S.Stopping and not IsIOThread;
+}
+
+void AsyncOutput::Submit(function<void()> Task, const size_t Bytes)
+{
+    if(not Active())
+    {
+        Task();
+        return;
+    }
+    AsyncOutputState& S = State();
+    {
+        /* A task larger than the limit is accepted once all others are done */
+        unique_lock<mutex> lock(S.Mutex);
+        S.TaskFinished.wait(lock, [&S, Bytes]{return S.StagedBytes == 0 or
+                                              S.StagedBytes + Bytes <= S.MemoryLimit;});
+        S.StagedBytes += Bytes;
+        S.Tasks.emplace_back(std::move(Task), Bytes);
+    }
+    S.TaskAvailable.notify_one();
+}
+
+void AsyncOutput::WriteFile(const string& FileName, string&& Data)
+{
+    if(Embedded::WriteFile(FileName, Data)) return;
+
+    const size_t Bytes = Data.size();
+    auto Buffer = make_shared<string>(std::move(Data));
+    Submit([FileName, Buffer]()
+    {
+        ofstream out(FileName.c_str(), ios::out | ios::binary);
+        if(!out)
+        {
+            ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be opened",
+                                        thisclassname, "WriteFile()");
+            return;
+        }
+        out.write(Buffer->data(), Buffer->size());
+    }, Bytes);
+}
+
+void AsyncOutput::Worker(void)
+{
+    IsIOThread = true;
+    AsyncOutputState& S = State();
+    while(true)
+    {
+        pair<function<void()>, size_t> Task;
+        {
+            unique_lock<mutex> lock(S.Mutex);
+            S.TaskAvailable.wait(lock, [&S]{return S.Stopping or not S.Tasks.empty();});
+            if(S.Tasks.empty()) return;
+            Task = std::move(S.Tasks.front());
+            S.Tasks.pop_front();
+            S.Running++;
+        }
+        try
+        {
+            Task.first();
+        }
+        catch(const exception& e)
+        {
+            ConsoleOutput::WriteWarning(string("Output task failed: ") + e.what(),
+                                        thisclassname, "Worker()");
+        }
+        {
+            lock_guard<mutex> lock(S.Mutex);
+            S.Running--;
+            S.StagedBytes -= Task.second;
+        }
+        S.TaskFinished.notify_all();
+    }
+}
+
+}// namespace openphase
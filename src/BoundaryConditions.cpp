@@ -27,10 +27,55 @@
 #include "BoundaryConditions.h"
 #include "Settings.h"
 
+#include <map>
+
 using  namespace std;
 namespace openphase
 {
 
+bool BoundaryConditions::HaloLayers(const BoundaryConditionTypes BC0,
+                                    const BoundaryConditionTypes BCN,
+                                    const long int size, const long int bcells,
+                                    vector<array<long int,2>>& Layers) const
+{
+    /* Periodic, no-flux and mirror boundary conditions copy whole layers of
+    the storage, the source layers are calculated once per call instead of
+    once per cell. The positions are the same as in the cell-wise loops. */
+
+    Layers.clear();
+    bool Free = false;
+
+    if(BC0 == BoundaryConditionTypes::Periodic or
+       BCN == BoundaryConditionTypes::Periodic)
+    {
+        for(long int i = -bcells; i < 0; i++)
+        {
+            Layers.push_back({i, (size + i)%size});
+            Layers.push_back({size - i - 1, (-i - 1)%size});
+        }
+        return Free;
+    }
+
+    for(long int i = -bcells; i < 0; i++)
+    {
+        switch(BC0)
+        {
+            case BoundaryConditionTypes::NoFlux: Layers.push_back({i, (-i - 1)%size}); break;
+            case BoundaryConditionTypes::Mirror: Layers.push_back({i, (-i)%size}); break;
+            case BoundaryConditionTypes::Free:   Free = true; break;
+            default: break;
+        }
+        switch(BCN)
+        {
+            case BoundaryConditionTypes::NoFlux: Layers.push_back({size - i - 1, (size + i)%size}); break;
+            case BoundaryConditionTypes::Mirror: Layers.push_back({size - i - 1, (size + i - 1)%size}); break;
+            case BoundaryConditionTypes::Free:   Free = true; break;
+            default: break;
+        }
+    }
+    return Free;
+}
+
 BoundaryConditionTypes BoundaryConditions::TranslateBoundaryConditions(string Key)
 {
     BoundaryConditionTypes myBC;
@@ -72,6 +117,35 @@ BoundaryConditionTypes BoundaryConditions::TranslateBoundaryConditions(string Ke
     return myBC;
 }
 
+HaloThreadingModes BoundaryConditions::TranslateHaloThreading(string Key)
+{
+    if(Key == "OVERLAP")
+    {
+#ifdef MPI_PARALLEL
+        /* The halo is exchanged inside an OpenMP parallel region, by the
+        master thread or, with MPI_THREAD_MULTIPLE, by any thread */
+        OP_MPI_Threads provided = OP_MPI_THREAD_SINGLE;
+        OP_MPI_Query_thread(&provided);
+        HaloThreadMultiple = (provided == OP_MPI_THREAD_MULTIPLE);
+        if(provided == OP_MPI_THREAD_SINGLE)
+        {
+            ConsoleOutput::WriteWarning("HaloThreading OVERLAP needs at least MPI_THREAD_FUNNELED, "
+                                        "MASTER is used", thisclassname, "ReadInput()");
+            return HaloThreadingModes::Master;
+        }
+#endif
+        return HaloThreadingModes::Overlap;
+    }
+    if(Key != "MASTER")
+    {
+        ConsoleOutput::WriteExit("Illegal HaloThreading input \"" + Key + "\". "
+                                 "Legal values are Master or Overlap.",
+                                 thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    return HaloThreadingModes::Master;
+}
+
 void BoundaryConditions::Initialize(Settings& Settings, std::string ObjectNameSuffix)
 {
     thisclassname = "BoundaryConditions";
@@ -84,10 +158,13 @@ void BoundaryConditions::Initialize(Settings& Settings, std::string ObjectNameSu
     BC0Z = BoundaryConditionTypes::Periodic;
     BCNZ = BoundaryConditionTypes::Periodic;
 
+    HaloThreading = HaloThreadingModes::Master;
+
 #ifdef MPI_PARALLEL
     MPIperiodicX = false;
     MPIperiodicY = false;
     MPIperiodicZ = false;
+    HaloThreadMultiple = false;
 #endif
 
     initialized = true;
@@ -102,7 +179,7 @@ void BoundaryConditions::ReadInput(const string InputFileName)
     std::string filetype = FileInterface::getFileExtension(InputFileName); 
 	if (filetype == "opi")
 	{
-		fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+		std::stringstream inp = FileInterface::OpenInput(InputFileName);
 
 		if (!inp)
 		{
@@ -113,8 +190,6 @@ void BoundaryConditions::ReadInput(const string InputFileName)
 		std::stringstream data;
 		data << inp.rdbuf();
 		ReadInput(data);
-
-		inp.close();
 	}
 	else
 	if (filetype == "json")
@@ -146,7 +221,10 @@ void BoundaryConditions::ReadInput(stringstream& inp)
     BC0Z = TranslateBoundaryConditions(BC0Zstring);
     BCNZ = TranslateBoundaryConditions(BCNZstring);
 
+    HaloThreading = TranslateHaloThreading(FileInterface::ReadParameterK(inp, moduleLocation, string("HaloThreading"), false, "MASTER"));
+
 #ifdef MPI_PARALLEL
+    SetupSharedHalo(FileInterface::ReadParameterD(inp, moduleLocation, string("SharedHaloMB"), false, 0.0));
     if(MPI_3D_DECOMPOSITION)
     {
         Setup_MPIX();
@@ -164,7 +242,7 @@ void BoundaryConditions::ReadInput(stringstream& inp)
 
 void BoundaryConditions::ReadJSON(const string InputFileName)
 {
-    std::ifstream f(InputFileName);
+    std::stringstream f = FileInterface::OpenInput(InputFileName);
 	json data = json::parse(f);
 	if (data.contains(thisclassname))
 	{
@@ -190,6 +268,13 @@ void BoundaryConditions::ReadJSON(const string InputFileName)
 		BCNY = TranslateBoundaryConditions(BCNYstring);
 		BC0Z = TranslateBoundaryConditions(BC0Zstring);
 		BCNZ = TranslateBoundaryConditions(BCNZstring);
+
+		string HaloThreadingString = FileInterface::ReadParameter<std::string>(bc, {"HaloThreading"}, "MASTER");
+		std::transform(HaloThreadingString.begin(), HaloThreadingString.end(), HaloThreadingString.begin(), ::toupper);
+		HaloThreading = TranslateHaloThreading(HaloThreadingString);
+#ifdef MPI_PARALLEL
+		SetupSharedHalo(FileInterface::ReadParameter<double>(bc, {"SharedHaloMB"}, 0.0));
+#endif
 	}
 #ifdef MPI_PARALLEL
     if(MPI_3D_DECOMPOSITION)
@@ -283,6 +368,357 @@ bool BoundaryConditions::Setup_MPIZ()
     }
     return false;
 }
+
+/* Datatypes and persistent requests of the direct halo exchange are created
+once per storage, shape, direction and neighbor configuration. The plans are
+keyed by the storage object and not by its memory: if the data has moved since
+the last exchange, e.g. by Storage3D::Shift() in a moving frame or by a
+reallocation with the same shape, only the persistent requests are rebound to
+the new address and the datatypes are kept. Plans of other shapes are released
+when the cache is full.*/
+struct HaloExchangePlan
+{
+    void* SendLeft  = nullptr;                                                  ///< Persistent requests
+    void* SendRight = nullptr;
+    void* RecvLeft  = nullptr;
+    void* RecvRight = nullptr;
+    std::array<void*,4> Datatypes = {};                                         ///< Subarray datatypes of the requests (send left, receive left, send right, receive right)
+
+    /* Sides exchanged through the node shared memory window */
+    char* Data = nullptr;                                                       ///< Storage memory including the halo
+    std::array<int,4> Sizes = {0,0,0,0};                                        ///< Storage extents (X, Y, Z, components)
+    std::array<int,3> Halo = {0,0,0};                                           ///< Boundary cells in each direction
+    int Direction = 0;
+    int LeftProcess = 0;
+    int RightProcess = 0;
+    size_t ValueSize = 0;                                                       ///< Bytes per value
+    char* SharedSendLeft  = nullptr;                                            ///< Own window slots for the layers sent to the neighbors
+    char* SharedSendRight = nullptr;
+    char* SharedRecvLeft  = nullptr;                                            ///< Window slots of the neighbors holding the layers for this process
+    char* SharedRecvRight = nullptr;
+    std::array<void*,8> Notifications = {};                                     ///< Zero byte notification and acknowledgment requests
+};
+
+typedef std::array<long int,16> HaloExchangePlanKey;
+static std::map<HaloExchangePlanKey, HaloExchangePlan> HaloExchangePlans;
+static const size_t MaxHaloExchangePlans = 1024;
+static size_t HaloExchangesInFlight = 0;                                        ///< Plans which are in use must not be freed
+
+static void FreeHaloExchangePlans()
+{
+    for(auto& entry : HaloExchangePlans)
+    {
+        HaloExchangePlan& plan = entry.second;
+        for(void* request : {plan.SendLeft, plan.SendRight, plan.RecvLeft, plan.RecvRight})
+        {
+            if(request != nullptr) OP_MPI_Request_free(request);
+        }
+        for(void* datatype : plan.Datatypes)
+        {
+            if(datatype != nullptr) OP_MPI_Type_free(datatype);
+        }
+    }
+    HaloExchangePlans.clear();
+}
+
+/* Intra-node halo exchange through an MPI-3 shared memory window. Every
+process owns two slots (left and right) per direction in the window. The
+sender copies its boundary layer into its slot and notifies the neighbor with a
+zero byte message, the neighbor copies the layer from the slot directly into
+its halo and acknowledges, which releases the slot for the next exchange. This
+replaces the copies of the MPI library into and out of its own shared memory
+buffers by a single copy on each side. Layers which do not fit into a slot,
+neighbors on other nodes and exchanges along a direction while another one is
+in flight use the persistent requests. The window is enabled by the input
+$SharedHaloMB (size of the window per process in MB, 0 disables). */
+struct SharedHaloWindow
+{
+    void* Window = nullptr;                                                     ///< MPI shared memory window
+    size_t SlotBytes = 0;                                                       ///< Bytes per slot
+    std::array<bool,6> Busy = {};                                               ///< Slots in use by an exchange in flight
+};
+static SharedHaloWindow SharedHalo;
+
+void BoundaryConditions::SetupSharedHalo(const double MegaBytes)
+{
+    if(SharedHalo.Window != nullptr or MegaBytes <= 0.0) return;
+    SharedHalo.SlotBytes = size_t(MegaBytes*1024.0*1024.0)/6;
+    SharedHalo.Window = OP_MPI_Shared_window(6*SharedHalo.SlotBytes);
+}
+
+static size_t HaloValueSize(const OP_MPI_Datatype type)
+{
+    switch(type)
+    {
+        case OP_MPI_FLOAT:         return sizeof(float);
+        case OP_MPI_INT:           return sizeof(int);
+        case OP_MPI_LONG:          return sizeof(long int);
+        case OP_MPI_UNSIGNED_LONG: return sizeof(unsigned long int);
+        default:                   return sizeof(double);
+    }
+}
+
+static void CopyHaloLayer(char* data, char* buffer, const HaloExchangePlan& plan,
+                          const int start, const bool toBuffer)
+{
+    /* Copies the layer [start, start + halo) along the plan direction between
+    the storage and a contiguous buffer, the rows along Z (including the
+    components) are contiguous in both */
+    long int lower[3] = {0, 0, 0};
+    long int upper[3] = {plan.Sizes[0], plan.Sizes[1], plan.Sizes[2]};
+    lower[plan.Direction] = start;
+    upper[plan.Direction] = start + plan.Halo[plan.Direction];
+    const size_t row = (upper[2] - lower[2])*plan.Sizes[3]*plan.ValueSize;
+    for(long int i = lower[0]; i < upper[0]; i++)
+    for(long int j = lower[1]; j < upper[1]; j++)
+    {
+        char* cell = data + ((i*plan.Sizes[1] + j)*plan.Sizes[2] + lower[2])*plan.Sizes[3]*plan.ValueSize;
+        if(toBuffer) memcpy(buffer, cell, row);
+        else memcpy(cell, buffer, row);
+        buffer += row;
+    }
+}
+
+static void* HaloDatatype(const std::array<int,4>& sizes,
+                          const std::array<int,3>& halo,
+                          const int direction, const int start,
+                          const OP_MPI_Datatype type)
+{
+    int subsizes[4] = {sizes[0], sizes[1], sizes[2], sizes[3]};
+    int starts[4]   = {0, 0, 0, 0};
+    subsizes[direction] = halo[direction];
+    starts[direction]   = start;
+    return OP_MPI_Type_create_subarray(4, sizes.data(), subsizes, starts, type);
+}
+
+/* (Re)creates the persistent requests of a plan for the memory at "data" */
+static void BindHaloExchangePlan(HaloExchangePlan& plan, char* data)
+{
+    const int LeftDataTag  = 2; // used to identify data stream
+    const int RightDataTag = 8; // used to identify data stream
+
+    for(void** request : {&plan.SendLeft, &plan.RecvLeft, &plan.SendRight, &plan.RecvRight})
+    {
+        if(*request != nullptr) OP_MPI_Request_free(*request);
+        *request = nullptr;
+    }
+    plan.Data = data;
+    if(plan.Datatypes[0] != nullptr)
+    {
+        plan.SendLeft = create_request();
+        plan.RecvLeft = create_request();
+        OP_MPI_Send_init(data, 1, plan.Datatypes[0], plan.LeftProcess, RightDataTag, OP_MPI_COMM_WORLD, plan.SendLeft);
+        OP_MPI_Recv_init(data, 1, plan.Datatypes[1], plan.LeftProcess, LeftDataTag, OP_MPI_COMM_WORLD, plan.RecvLeft);
+    }
+    if(plan.Datatypes[2] != nullptr)
+    {
+        plan.SendRight = create_request();
+        plan.RecvRight = create_request();
+        OP_MPI_Send_init(data, 1, plan.Datatypes[2], plan.RightProcess, LeftDataTag, OP_MPI_COMM_WORLD, plan.SendRight);
+        OP_MPI_Recv_init(data, 1, plan.Datatypes[3], plan.RightProcess, RightDataTag, OP_MPI_COMM_WORLD, plan.RecvRight);
+    }
+}
+
+void* BoundaryConditions::BeginHaloDirect(const void* storage, void* data, const OP_MPI_Datatype type,
+        const std::array<int,4>& sizes, const std::array<int,3>& halo,
+        const int direction, const int LeftProcess, const int RightProcess,
+        const bool exchangeLeft, const bool exchangeRight)
+{
+    /* Sides exchanged through the shared memory window, the decision is the
+    same on both processes of a side as their layers have the same size */
+    const size_t layerBytes = size_t(sizes[0])*sizes[1]*sizes[2]/sizes[direction]
+                            *halo[direction]*sizes[3]*HaloValueSize(type);
+    const bool shared = SharedHalo.Window != nullptr and layerBytes <= SharedHalo.SlotBytes;
+    char* LeftWindow  = (shared and exchangeLeft)  ? OP_MPI_Shared_pointer(SharedHalo.Window, LeftProcess)  : nullptr;
+    char* RightWindow = (shared and exchangeRight) ? OP_MPI_Shared_pointer(SharedHalo.Window, RightProcess) : nullptr;
+    const bool sharedLeft  = LeftWindow  != nullptr and not SharedHalo.Busy[2*direction];
+    const bool sharedRight = RightWindow != nullptr and not SharedHalo.Busy[2*direction+1];
+
+    const HaloExchangePlanKey key = {(long int)reinterpret_cast<std::uintptr_t>(storage),
+                                     direction, sizes[0], sizes[1], sizes[2], sizes[3],
+                                     halo[0], halo[1], halo[2], type,
+                                     LeftProcess, RightProcess,
+                                     exchangeLeft, exchangeRight,
+                                     sharedLeft, sharedRight};
+
+    auto plan = HaloExchangePlans.find(key);
+    if(plan == HaloExchangePlans.end())
+    {
+        if(HaloExchangePlans.size() >= MaxHaloExchangePlans and
+           HaloExchangesInFlight == 0)
+        {
+            FreeHaloExchangePlans();
+        }
+        HaloExchangePlan& newPlan = HaloExchangePlans[key];
+
+        const int width    = halo[direction];
+        const int interior = sizes[direction] - 2*width;
+        newPlan.Sizes        = sizes;
+        newPlan.Halo         = halo;
+        newPlan.Direction    = direction;
+        newPlan.LeftProcess  = LeftProcess;
+        newPlan.RightProcess = RightProcess;
+        newPlan.ValueSize    = HaloValueSize(type);
+        if(sharedLeft)
+        {
+            char* own = OP_MPI_Shared_pointer(SharedHalo.Window, MPI_RANK);
+            newPlan.SharedSendLeft = own + (2*direction)*SharedHalo.SlotBytes;
+            newPlan.SharedRecvLeft = LeftWindow + (2*direction+1)*SharedHalo.SlotBytes;
+        }
+        if(sharedRight)
+        {
+            char* own = OP_MPI_Shared_pointer(SharedHalo.Window, MPI_RANK);
+            newPlan.SharedSendRight = own + (2*direction+1)*SharedHalo.SlotBytes;
+            newPlan.SharedRecvRight = RightWindow + (2*direction)*SharedHalo.SlotBytes;
+        }
+        if(exchangeLeft and not sharedLeft)
+        {
+            newPlan.Datatypes[0] = HaloDatatype(sizes, halo, direction, width, type);
+            newPlan.Datatypes[1] = HaloDatatype(sizes, halo, direction, 0, type);
+        }
+        if(exchangeRight and not sharedRight)
+        {
+            newPlan.Datatypes[2] = HaloDatatype(sizes, halo, direction, interior, type);
+            newPlan.Datatypes[3] = HaloDatatype(sizes, halo, direction, interior + width, type);
+        }
+        plan = HaloExchangePlans.find(key);
+    }
+
+    HaloExchangePlan& locPlan = plan->second;
+    if(locPlan.Data != data)
+    {
+        BindHaloExchangePlan(locPlan, static_cast<char*>(data));
+    }
+    if(locPlan.RecvLeft  != nullptr) OP_MPI_Start(locPlan.RecvLeft);
+    if(locPlan.RecvRight != nullptr) OP_MPI_Start(locPlan.RecvRight);
+    if(locPlan.SendLeft  != nullptr) OP_MPI_Start(locPlan.SendLeft);
+    if(locPlan.SendRight != nullptr) OP_MPI_Start(locPlan.SendRight);
+
+    if(sharedLeft or sharedRight)
+    {
+        /* Tags name the side on which the receiver gets the message */
+        const int NotifyLeftTag  = 16;
+        const int NotifyRightTag = 32;
+        const int AckLeftTag     = 64;
+        const int AckRightTag    = 128;
+
+        const int width    = halo[direction];
+        const int interior = sizes[direction] - 2*width;
+        if(sharedLeft)  CopyHaloLayer(locPlan.Data, locPlan.SharedSendLeft,  locPlan, width, true);
+        if(sharedRight) CopyHaloLayer(locPlan.Data, locPlan.SharedSendRight, locPlan, interior, true);
+        OP_MPI_Shared_sync(SharedHalo.Window);
+
+        std::array<void*,8>& N = locPlan.Notifications;
+        if(sharedLeft)
+        {
+            SharedHalo.Busy[2*direction] = true;
+            for(int n = 0; n < 4; n++) N[n] = create_request();
+            OP_MPI_Irecv(nullptr, 0, OP_MPI_CHAR, LeftProcess, NotifyLeftTag,  OP_MPI_COMM_WORLD, N[0]);
+            OP_MPI_Irecv(nullptr, 0, OP_MPI_CHAR, LeftProcess, AckLeftTag,     OP_MPI_COMM_WORLD, N[1]);
+            OP_MPI_Isend(nullptr, 0, OP_MPI_CHAR, LeftProcess, NotifyRightTag, OP_MPI_COMM_WORLD, N[2]);
+        }
+        if(sharedRight)
+        {
+            SharedHalo.Busy[2*direction+1] = true;
+            for(int n = 4; n < 8; n++) N[n] = create_request();
+            OP_MPI_Irecv(nullptr, 0, OP_MPI_CHAR, RightProcess, NotifyRightTag, OP_MPI_COMM_WORLD, N[4]);
+            OP_MPI_Irecv(nullptr, 0, OP_MPI_CHAR, RightProcess, AckRightTag,    OP_MPI_COMM_WORLD, N[5]);
+            OP_MPI_Isend(nullptr, 0, OP_MPI_CHAR, RightProcess, NotifyLeftTag,  OP_MPI_COMM_WORLD, N[6]);
+        }
+    }
+    HaloExchangesInFlight++;
+    return &locPlan;
+}
+
+void BoundaryConditions::EndHaloDirect(void* plan)
+{
+    HaloExchangePlan& locPlan = *static_cast<HaloExchangePlan*>(plan);
+    if(locPlan.RecvLeft != nullptr)
+    {
+        OP_MPI_Wait(locPlan.RecvLeft, OP_MPI_STATUS_IGNORE);
+        OP_MPI_Wait(locPlan.SendLeft, OP_MPI_STATUS_IGNORE);
+    }
+    if(locPlan.RecvRight != nullptr)
+    {
+        OP_MPI_Wait(locPlan.RecvRight, OP_MPI_STATUS_IGNORE);
+        OP_MPI_Wait(locPlan.SendRight, OP_MPI_STATUS_IGNORE);
+    }
+
+    /* Shared memory sides: copy the neighbor layers once they are notified,
+    acknowledge, and wait until the own slots have been read */
+    const int AckLeftTag  = 64;
+    const int AckRightTag = 128;
+    const int direction   = locPlan.Direction;
+    std::array<void*,8>& N = locPlan.Notifications;
+    if(N[0] != nullptr)
+    {
+        OP_MPI_Wait(N[0], OP_MPI_STATUS_IGNORE);
+        OP_MPI_Shared_sync(SharedHalo.Window);
+        CopyHaloLayer(locPlan.Data, locPlan.SharedRecvLeft, locPlan, 0, false);
+        OP_MPI_Isend(nullptr, 0, OP_MPI_CHAR, locPlan.LeftProcess, AckRightTag, OP_MPI_COMM_WORLD, N[3]);
+    }
+    if(N[4] != nullptr)
+    {
+        OP_MPI_Wait(N[4], OP_MPI_STATUS_IGNORE);
+        OP_MPI_Shared_sync(SharedHalo.Window);
+        CopyHaloLayer(locPlan.Data, locPlan.SharedRecvRight, locPlan,
+                      locPlan.Sizes[direction] - locPlan.Halo[direction], false);
+        OP_MPI_Isend(nullptr, 0, OP_MPI_CHAR, locPlan.RightProcess, AckLeftTag, OP_MPI_COMM_WORLD, N[7]);
+    }
+    for(int side = 0; side < 2; side++)
+    if(N[4*side] != nullptr)
+    {
+        for(int n = 4*side + 1; n < 4*side + 4; n++)
+        {
+            OP_MPI_Wait(N[n], OP_MPI_STATUS_IGNORE);
+        }
+        for(int n = 4*side; n < 4*side + 4; n++)
+        {
+            free_request(N[n]);
+            N[n] = nullptr;
+        }
+        SharedHalo.Busy[2*direction + side] = false;
+    }
+    HaloExchangesInFlight--;
+}
+
+bool BoundaryConditions::HaloNeighbors(const int direction, const bool decomposition3D,
+                                       int& LeftProcess, int& RightProcess,
+                                       bool& exchangeLeft, bool& exchangeRight) const
+{
+    const bool periodic[3] = {MPIperiodicX, MPIperiodicY, MPIperiodicZ};
+
+    if(not decomposition3D)
+    {
+        // 1D domain decomposition along X
+        RightProcess = (((MPI_RANK+1)%MPI_SIZE)+MPI_SIZE)%MPI_SIZE;
+        LeftProcess  = (((MPI_RANK-1)%MPI_SIZE)+MPI_SIZE)%MPI_SIZE;
+
+        exchangeLeft  = MPI_RANK > 0 or MPIperiodicX;
+        exchangeRight = MPI_RANK < MPI_SIZE-1 or MPIperiodicX;
+        return true;
+    }
+
+    if(MPI_CART_SIZE[direction] <= 1) return false;
+
+    int RightRank[3] = {MPI_CART_RANK[0], MPI_CART_RANK[1], MPI_CART_RANK[2]};
+    int LeftRank[3]  = {MPI_CART_RANK[0], MPI_CART_RANK[1], MPI_CART_RANK[2]};
+    RightRank[direction] = (MPI_CART_RANK[direction] + 1)%MPI_CART_SIZE[direction];
+    LeftRank[direction]  = (MPI_CART_RANK[direction] - 1 + MPI_CART_SIZE[direction])%MPI_CART_SIZE[direction];
+
+    RightProcess = RightRank[2] + RightRank[1] * MPI_CART_SIZE[2] + RightRank[0] * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
+    LeftProcess  = LeftRank[2]  + LeftRank[1]  * MPI_CART_SIZE[2] + LeftRank[0]  * MPI_CART_SIZE[1] * MPI_CART_SIZE[2];
+    if(not MPI_CART_PROCESS.empty())
+    {
+        // Node-aware placement of the ranks, see GridParameters::SetDimensions()
+        RightProcess = MPI_CART_PROCESS[RightProcess];
+        LeftProcess  = MPI_CART_PROCESS[LeftProcess];
+    }
+
+    exchangeLeft  = MPI_CART_RANK[direction] > 0 or periodic[direction];
+    exchangeRight = MPI_CART_RANK[direction] < MPI_CART_SIZE[direction]-1 or periodic[direction];
+    return true;
+}
 #endif
 
 }// namespace openphase
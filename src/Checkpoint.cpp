@@ -0,0 +1,237 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "Checkpoint.h"
+#include "AsyncOutput.h"
+#include "ConsoleOutput.h"
+#include "FileInterface.h"
+#include "MappedFile.h"
+#include "OPObject.h"
+#include "Settings.h"
+#include "TimeSeriesOutput.h"
+
+namespace openphase
+{
+using namespace std;
+
+static const char CheckpointMagic[8] = {'O','P','C','H','K','P','T','1'};
+
+template<class T>
+static void Append(string& out, const T value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+string Checkpoint::FileName(const string& Directory, const int tStep)
+{
+    #ifdef MPI_PARALLEL
+    return FileInterface::MakeFileName(Directory, string(thisclassname) + "_" + to_string(MPI_RANK) + "_", tStep, ".opc");
+    #else
+    return FileInterface::MakeFileName(Directory, string(thisclassname) + "_", tStep, ".opc");
+    #endif
+}
+
+bool Checkpoint::Exists(const Settings& locSettings, const int tStep)
+{
+    return std::filesystem::exists(FileName(locSettings.InputRawDataDir, tStep));
+}
+
+bool Checkpoint::Write(const Settings& locSettings, const int tStep)
+{
+    /* The time series text output is written up to the checkpoint */
+    TimeSeriesOutput::Flush();
+
+    bool write_status = true;
+    vector<const OPObject*> Objects;
+    for(const OPObject* Obj : locSettings.ObjectsToRead)
+    {
+        if(Obj->checkpointable)
+        {
+            Objects.push_back(Obj);
+        }
+        else
+        {
+            /* Objects without checkpoint support write their own files */
+            write_status = Obj->Write(locSettings, tStep) and write_status;
+        }
+    }
+
+    auto Data = make_shared<vector<string>>(Objects.size());
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t n = 0; n < Objects.size(); n++)
+    {
+        ostringstream out(ios::out | ios::binary);
+        Objects[n]->WriteCheckpoint(out);
+        (*Data)[n] = out.str();
+    }
+
+    size_t HeaderSize = sizeof(CheckpointMagic) + sizeof(uint64_t);
+    for(const OPObject* Obj : Objects)
+    {
+        HeaderSize += Obj->thisobjectname.size() + 3*sizeof(uint64_t);
+    }
+    auto Header = make_shared<string>();
+    Header->reserve(HeaderSize);
+    Header->append(CheckpointMagic, sizeof(CheckpointMagic));
+    Append<uint64_t>(*Header, Objects.size());
+    uint64_t Offset = HeaderSize;
+    for(size_t n = 0; n < Objects.size(); n++)
+    {
+        Append<uint64_t>(*Header, Objects[n]->thisobjectname.size());
+        Header->append(Objects[n]->thisobjectname);
+        Append<uint64_t>(*Header, Offset);
+        Append<uint64_t>(*Header, (*Data)[n].size());
+        Offset += (*Data)[n].size();
+    }
+
+    const string Name = FileName(locSettings.RawDataDir, tStep);
+    AsyncOutput::Submit([Name, Header, Data]()
+    {
+        ofstream out(Name.c_str(), ios::out | ios::binary);
+        if(!out)
+        {
+            ConsoleOutput::WriteWarning("File \"" + Name + "\" could not be created",
+                                        thisclassname, "Write()");
+            return;
+        }
+        out.write(Header->data(), Header->size());
+        for(const string& Entry : *Data)
+        {
+            out.write(Entry.data(), Entry.size());
+        }
+    }, Offset);
+    return write_status;
+}
+
+bool Checkpoint::Read(const Settings& locSettings, const BoundaryConditions& BC, const int tStep)
+{
+    /* The checkpoint may still be written by the output threads */
+    AsyncOutput::Flush();
+
+    const string Name = FileName(locSettings.InputRawDataDir, tStep);
+    MappedFile File(Name);
+
+    struct Entry_t
+    {
+        string Name;
+        uint64_t Offset;
+        uint64_t Size;
+        bool Used;
+    };
+    vector<Entry_t> Entries;
+
+    size_t Position = sizeof(CheckpointMagic);
+    auto Extract = [&File, &Position](void* value, const size_t size)
+    {
+        if(Position + size > File.size()) return false;
+        memcpy(value, File.data() + Position, size);
+        Position += size;
+        return true;
+    };
+
+    uint64_t nEntries = 0;
+    bool valid = File.size() >= Position and
+                 memcmp(File.data(), CheckpointMagic, sizeof(CheckpointMagic)) == 0 and
+                 Extract(&nEntries, sizeof(uint64_t));
+    for(uint64_t n = 0; valid and n < nEntries; n++)
+    {
+        Entry_t Entry{"", 0, 0, false};
+        uint64_t Length = 0;
+        valid = Extract(&Length, sizeof(uint64_t)) and Position + Length <= File.size();
+        if(not valid) break;
+        Entry.Name.assign(File.data() + Position, Length);
+        Position += Length;
+        valid = Extract(&Entry.Offset, sizeof(uint64_t)) and
+                Extract(&Entry.Size, sizeof(uint64_t)) and
+                Entry.Offset <= File.size() and Entry.Size <= File.size() - Entry.Offset;
+        Entries.push_back(Entry);
+    }
+    if(not valid)
+    {
+        ConsoleOutput::WriteWarning("File \"" + Name + "\" is not a valid checkpoint",
+                                    thisclassname, "Read()");
+        return false;
+    }
+
+    /* Assigns the entries to the objects by name, in the order of registration */
+    vector<OPObject*> Objects;
+    vector<const Entry_t*> ObjectEntries;
+    for(OPObject* Obj : locSettings.ObjectsToRead)
+    if(Obj->checkpointable)
+    {
+        const Entry_t* ObjectEntry = nullptr;
+        for(auto& Entry : Entries)
+        if(not Entry.Used and Entry.Name == Obj->thisobjectname)
+        {
+            Entry.Used = true;
+            ObjectEntry = &Entry;
+            break;
+        }
+        Objects.push_back(Obj);
+        ObjectEntries.push_back(ObjectEntry);
+    }
+
+    vector<int> Status(Objects.size(), 0);
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t n = 0; n < Objects.size(); n++)
+    if(ObjectEntries[n])
+    {
+        MemoryStream inp(File.data() + ObjectEntries[n]->Offset, ObjectEntries[n]->Size);
+        Status[n] = Objects[n]->ReadCheckpoint(inp);
+    }
+
+    bool read_status = true;
+    size_t idx = 0;
+    for(OPObject* Obj : locSettings.ObjectsToRead)
+    {
+        if(Obj->checkpointable)
+        {
+            if(Status[idx])
+            {
+                Obj->FinalizeRead(BC);
+            }
+            else
+            {
+                ConsoleOutput::WriteWarning("Checkpoint entry of " + Obj->thisobjectname +
+                                            " is missing or could not be read", thisclassname, "Read()");
+                read_status = false;
+            }
+            idx++;
+        }
+        else
+        {
+            read_status = Obj->Read(locSettings, BC, tStep) and read_status;
+        }
+    }
+    if(read_status)
+    {
+        ConsoleOutput::WriteStandard(thisclassname, "Restored " + to_string(Objects.size()) +
+                                     " object(s) from " + Name);
+    }
+    return read_status;
+}
+
+}// namespace openphase
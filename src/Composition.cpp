@@ -33,6 +33,10 @@
 #include "AdvectionHR.h"
 #include "Thermodynamics/PeriodicTable.h"
 #include "H5Interface.h"
+#include "LoadBalancer.h"
+#include "Tools/ReductionBatch.h"
+#include "Tools/LossyCompression.h"
+#include "TimeSeriesOutput.h"
 
 namespace openphase
 {
@@ -48,6 +52,7 @@ void Composition::Initialize(Settings& locSettings, std::string ObjectNameSuffix
 
     Ncomp   = locSettings.Ncomp;
     Nphases = locSettings.Nphases;
+    CheckpointTolerance = locSettings.CheckpointTolerance;
 
     for(size_t i = 0; i < Ncomp; i++)
     {
@@ -76,13 +81,7 @@ void Composition::Initialize(Settings& locSettings, std::string ObjectNameSuffix
 
     MoleFractions.Allocate(Grid, {Nphases, Ncomp}, Bcells);
 
-    NormIn.Allocate(Grid, {Nphases, Ncomp}, Bcells);
-    NormOut.Allocate(Grid, {Nphases, Ncomp}, Bcells);
-
     MoleFractionsDotIn.Allocate(Grid, {Nphases, Ncomp}, Bcells);
-    MoleFractionsDotOut.Allocate(Grid, {Nphases, Ncomp}, Bcells);
-
-    NormTotal.Allocate(Grid, {Ncomp}, Bcells);
 
     MoleFractionsTotal.Allocate(Grid, {Ncomp}, Bcells);
     MoleFractionsTotalDot.Allocate(Grid, {Ncomp}, Bcells);
@@ -90,8 +89,7 @@ void Composition::Initialize(Settings& locSettings, std::string ObjectNameSuffix
     MassFractionsTotal.Allocate(Grid, {Ncomp}, Bcells);
     MassFractionsTotalOld.Allocate(Grid, {Ncomp}, Bcells);
     MolecularWeight.Allocate({Ncomp});
-
-    Limiting.Allocate(Grid, Bcells);
+    MolarVolume.Allocate({Ncomp});
 
     Initial.Allocate({Nphases, Ncomp});
 
@@ -102,13 +100,20 @@ void Composition::Initialize(Settings& locSettings, std::string ObjectNameSuffix
 
     TotInitial.Allocate({Ncomp});
 
-    PT.Initialize();
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    {
+        const PeriodicTable::Element locElement = PT.GetData(Component[comp].Name);
+        MolecularWeight({comp}) = locElement.AtomicWeight;
+        MolarVolume    ({comp}) = locElement.MolarVolume;
+    }
 
     AtStart = true;
 
     locSettings.AddForAdvection(*this);
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
     locSettings.AddForReading(*this);
+    checkpointable = true;
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -116,7 +121,7 @@ void Composition::Initialize(Settings& locSettings, std::string ObjectNameSuffix
 
 void Composition::ReadInput(const string InputFileName)
 {
-    fstream inp(InputFileName.c_str(), ios::in);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened", thisclassname, "ReadInput");
@@ -125,7 +130,6 @@ void Composition::ReadInput(const string InputFileName)
 
     std::stringstream data;
     data << inp.rdbuf();
-    inp.close();
 
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteLineInsert(thisclassname+" input");
@@ -356,7 +360,6 @@ void Composition::SetInitialMoleFractions(PhaseField& Phi)
     OMP_PARALLEL_STORAGE_LOOP_END
 
     CalculateTotalMoleFractions(Phi);
-    CalculateMoleFractionsTotalAverage();
     CalculateMoleFractionsAverage(Phi);
     CalculateTotalMolarVolume();
 
@@ -387,7 +390,7 @@ Tensor<double, 1> Composition::WeightFractionsTotal(int x, int y, int z) const
     double div = 0.0;
     for(size_t comp = 0; comp < Ncomp; comp++)
     {
-        double locWeight = MoleFractionsTotal(x,y,z,{comp})*PT.GetData(Component[comp].Name).AtomicWeight;
+        double locWeight = MoleFractionsTotal(x,y,z,{comp})*MolecularWeight({comp});
         div += locWeight;
         result({comp}) = locWeight;
     }
@@ -400,7 +403,10 @@ Tensor<double, 1> Composition::WeightFractionsTotal(int x, int y, int z) const
 
 void Composition::CalculateTotalMoleFractions(PhaseField& Phi)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,MoleFractionsTotal.Bcells(),)
+    /* The domain average of the total mole fractions is accumulated in the
+    same pass, no separate CalculateMoleFractionsTotalAverage() is needed.*/
+    Tensor<double, 1> locMoleFractionsTotalSum({Ncomp});
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,MoleFractionsTotal.Bcells(),reduction(TensorD1Sum: locMoleFractionsTotalSum))
     {
         MoleFractionsTotal(i,j,k).set_to_zero();
 
@@ -410,8 +416,17 @@ void Composition::CalculateTotalMoleFractions(PhaseField& Phi)
             MoleFractionsTotal(i,j,k,{comp}) += Phi.Fractions(i,j,k,{alpha})*
                                              MoleFractions(i,j,k,{alpha,comp});
         }
+
+        if(i >= 0 and i < Grid.Nx and
+           j >= 0 and j < Grid.Ny and
+           k >= 0 and k < Grid.Nz)
+        {
+            locMoleFractionsTotalSum += MoleFractionsTotal(i,j,k);
+        }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+
+    SetMoleFractionsTotalAverage(locMoleFractionsTotalSum);
 }
 
 void Composition::CalculateTotalMolarVolume(void)
@@ -420,24 +435,29 @@ void Composition::CalculateTotalMolarVolume(void)
 
     for(size_t i = 0; i < Ncomp; i++)
     {
-        TotalMolarVolume += PT.GetData(Component[i].Name).MolarVolume
+        TotalMolarVolume += MolarVolume({i})
                             *MoleFractionsTotalAverage[i];
     }
 }
 
 void Composition::CalculateMoleFractionsTotalAverage(void)
 {
-    Tensor<double, 1> locMoleFractionsTotalAverage({Ncomp});
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,0,reduction(TensorD1Sum: locMoleFractionsTotalAverage))
+    Tensor<double, 1> locMoleFractionsTotalSum({Ncomp});
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,0,reduction(TensorD1Sum: locMoleFractionsTotalSum))
     {
-        locMoleFractionsTotalAverage += MoleFractionsTotal(i,j,k);
+        locMoleFractionsTotalSum += MoleFractionsTotal(i,j,k);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
-    MoleFractionsTotalAverage = locMoleFractionsTotalAverage;
+    SetMoleFractionsTotalAverage(locMoleFractionsTotalSum);
+}
+
+void Composition::SetMoleFractionsTotalAverage(const Tensor<double, 1>& LocalSum)
+{
+    MoleFractionsTotalAverage = LocalSum;
 
 #ifdef MPI_PARALLEL
-    OP_MPI_Allreduce(locMoleFractionsTotalAverage.data(), MoleFractionsTotalAverage.data(), Ncomp, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    OP_MPI_Allreduce(LocalSum.data(), MoleFractionsTotalAverage.data(), Ncomp, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
 #endif
     MoleFractionsTotalAverage /= double(Grid.TotalNumberOfCells());
 }
@@ -485,13 +505,12 @@ void Composition::CalculateMoleFractionsAverage(PhaseField& Phase)
     MoleFractionsInterfaceAverage = locMoleFractionsInterfaceAverage;
 
 #ifdef MPI_PARALLEL
-    Tensor<double, 1> tmpNpointsA = NpointsA;
-    Tensor<double, 2> tmpNpointsAB = NpointsAB;
-    OP_MPI_Allreduce(tmpNpointsA.data(), NpointsA.data(), Nphases, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(tmpNpointsAB.data(), NpointsAB.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-
-    OP_MPI_Allreduce(locMoleFractionsAverage.data(), MoleFractionsAverage.data(), Nphases*Ncomp, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(locMoleFractionsInterfaceAverage.data(), MoleFractionsInterfaceAverage.data(), Nphases*Nphases*Ncomp, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    ReductionBatch Batch;
+    Batch.Sum(NpointsA.data(), Nphases);
+    Batch.Sum(NpointsAB.data(), Nphases*Nphases);
+    Batch.Sum(MoleFractionsAverage.data(), Nphases*Ncomp);
+    Batch.Sum(MoleFractionsInterfaceAverage.data(), Nphases*Nphases*Ncomp);
+    Batch.Reduce();
 #endif
 
     for(size_t alpha = 0; alpha < Nphases; alpha++)
@@ -545,6 +564,17 @@ void Composition::CalculateMoleFractionsAverage(PhaseField& Phase)
     }
 }
 
+size_t Composition::AllocatedMemory(void) const
+{
+    return MassFractionsTotal.AllocatedMemory() +
+           MassFractionsTotalOld.AllocatedMemory() +
+           MoleFractions.AllocatedMemory() +
+           MoleFractionsTotal.AllocatedMemory() +
+           MoleFractionsDotIn.AllocatedMemory() +
+           MoleFractionsTotalDot.AllocatedMemory() +
+           NormTotal.AllocatedMemory();
+}
+
 void Composition::Remesh(const int newNx, const int newNy, const int newNz, const BoundaryConditions& BC)
 {
     Grid.SetDimensions(newNx, newNy,newNz);
@@ -553,40 +583,38 @@ void Composition::Remesh(const int newNx, const int newNy, const int newNz, cons
     MoleFractionsTotal.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
 
     MoleFractionsDotIn.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
-    MoleFractionsDotOut.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
     MoleFractionsTotalDot.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
 
-    Limiting.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
-
-    NormIn.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
-    NormOut.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    /* The limiting storage is allocated on first use */
+    if(NormTotal.IsAllocated()) NormTotal.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
 
     SetBoundaryConditions(BC);
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
-void Composition::MoveFrame(const int dx, const int dy, const int dz,
-                            const BoundaryConditions& BC)
+void Composition::Repartition(const BoundaryConditions& BC)
 {
-    int xBeg = (dx >= 0) + (dx < 0)*(Grid.Nx) - 1;
-    int xEnd = (dx >= 0)*(Grid.Nx) + (dx < 0) - 1;
-    int xInc = 1 - 2*(dx < 0);
+    const GridParameters OldGrid = Grid;
+    Grid.ApplyCutPlanes();
 
-    int yBeg = (dy >= 0) + (dy < 0)*(Grid.Ny) - 1;
-    int yEnd = (dy >= 0)*(Grid.Ny) + (dy < 0) - 1;
-    int yInc = 1 - 2*(dy < 0);
+    LoadBalancer::Migrate(MoleFractions, OldGrid, Grid);
+    LoadBalancer::Migrate(MoleFractionsTotal, OldGrid, Grid);
+    if(MassFractionsTotal.IsAllocated())    LoadBalancer::Migrate(MassFractionsTotal, OldGrid, Grid);
+    if(MassFractionsTotalOld.IsAllocated()) LoadBalancer::Migrate(MassFractionsTotalOld, OldGrid, Grid);
 
-    int zBeg = (dz >= 0) + (dz < 0)*(Grid.Nz) - 1;
-    int zEnd = (dz >= 0)*(Grid.Nz) + (dz < 0) - 1;
-    int zInc = 1 - 2*(dz < 0);
+    MoleFractionsDotIn.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    MoleFractionsTotalDot.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+
+    if(NormTotal.IsAllocated()) NormTotal.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
 
-    for(int i = xBeg; ((dx >= 0) and (i <= xEnd)) or ((dx < 0) and (i >= xEnd)); i += xInc)
-    for(int j = yBeg; ((dy >= 0) and (j <= yEnd)) or ((dy < 0) and (j >= yEnd)); j += yInc)
-    for(int k = zBeg; ((dz >= 0) and (k <= zEnd)) or ((dz < 0) and (k >= zEnd)); k += zInc)
-    {
-        MoleFractions(i,j,k) = MoleFractions(i + dx*Grid.dNx, j + dy*Grid.dNy, k + dz*Grid.dNz);
-        MoleFractionsTotal(i,j,k) = MoleFractionsTotal(i + dx*Grid.dNx, j + dy*Grid.dNy, k + dz*Grid.dNz);
-    }
+    SetBoundaryConditions(BC);
+}
+
+void Composition::MoveFrame(const int dx, const int dy, const int dz,
+                            const BoundaryConditions& BC)
+{
+    MoleFractions.Shift(dx*Grid.dNx, dy*Grid.dNy, dz*Grid.dNz);
+    MoleFractionsTotal.Shift(dx*Grid.dNx, dy*Grid.dNy, dz*Grid.dNz);
     SetBoundaryConditions(BC);
 
     if(ExtensionX0.isActive()) ExtensionX0.moveFrame(-dx*Grid.dNx, BC.BC0X);
@@ -666,30 +694,22 @@ void Composition::SetBoundaryConditions(const BoundaryConditions& BC)
     BC.SetZ(MoleFractionsTotal);
 }
 
-void Composition::SetLimitsBoundaryConditions(const BoundaryConditions& BC)
+void Composition::AllocateTotalLimits(void)
 {
-    BC.SetX(NormIn);
-    BC.SetY(NormIn);
-    BC.SetZ(NormIn);
-
-    BC.SetX(NormOut);
-    BC.SetY(NormOut);
-    BC.SetZ(NormOut);
-
-    BC.SetXFlags(Limiting);
-    BC.SetYFlags(Limiting);
-    BC.SetZFlags(Limiting);
+    if(NormTotal.IsNotAllocated())
+    {
+        NormTotal.Allocate(Grid, {Ncomp}, Grid.Bcells);
+        ConsoleOutput::WriteStandard(thisclassname, "Allocated NormTotal");
+    }
 }
 
 void Composition::SetTotalLimitsBoundaryConditions(const BoundaryConditions& BC)
 {
+    AllocateTotalLimits();
+
     BC.SetX(NormTotal);
     BC.SetY(NormTotal);
     BC.SetZ(NormTotal);
-
-    BC.SetXFlags(Limiting);
-    BC.SetYFlags(Limiting);
-    BC.SetZFlags(Limiting);
 }
 
 bool Composition::Write(const Settings& locSettings, const int tStep) const
@@ -710,7 +730,12 @@ bool Composition::Write(const Settings& locSettings, const int tStep) const
         ConsoleOutput::WriteExit(message.str(), thisclassname, "Write()");
         OP_Exit(EXIT_FAILURE);
     };
+    WriteCheckpoint(out);
+    return true;
+}
 
+void Composition::WriteCheckpoint(std::ostream& out) const
+{
     int tmp = Grid.Nx;
     out.write(reinterpret_cast<char*>(&tmp), sizeof(int));
     tmp = Grid.Ny;
@@ -722,13 +747,29 @@ bool Composition::Write(const Settings& locSettings, const int tStep) const
     tmp2 = Ncomp;
     out.write(reinterpret_cast<char*>(&tmp2), sizeof(size_t));
 
+    if(CheckpointTolerance > 0.0)
+    {
+        /* Error bounded compression, the prediction stride is the number of
+        values per cell, see Tools/LossyCompression.h */
+        std::vector<double> values;
+        values.reserve(Grid.LocalNumberOfCells()*Nphases*Ncomp);
+        STORAGE_LOOP_BEGIN(i,j,k,MoleFractions,0)
+            values.insert(values.end(), MoleFractions(i,j,k).data(), MoleFractions(i,j,k).data() + MoleFractions(i,j,k).size());
+        STORAGE_LOOP_END
+        LossyCompression::Write(out, values, CheckpointTolerance, Nphases*Ncomp);
+        values.clear();
+        STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,0)
+            values.insert(values.end(), MoleFractionsTotal(i,j,k).data(), MoleFractionsTotal(i,j,k).data() + MoleFractionsTotal(i,j,k).size());
+        STORAGE_LOOP_END
+        LossyCompression::Write(out, values, CheckpointTolerance, Ncomp);
+        return;
+    }
     STORAGE_LOOP_BEGIN(i,j,k,MoleFractions,0)
         out.write(reinterpret_cast<const char*>(MoleFractions(i,j,k).data()), MoleFractions(i,j,k).size()*sizeof(double));
     STORAGE_LOOP_END
     STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,0)
         out.write(reinterpret_cast<const char*>(MoleFractionsTotal(i,j,k).data()), MoleFractionsTotal(i,j,k).size()*sizeof(double));
     STORAGE_LOOP_END
-    return true;
 }
 
 bool Composition::Read(const Settings& locSettings, const BoundaryConditions& BC, const int tStep)
@@ -749,7 +790,14 @@ bool Composition::Read(const Settings& locSettings, const BoundaryConditions& BC
         ConsoleOutput::WriteWarning(message.str(), thisclassname, "Read()");
         return false;
     }
+    if(not ReadCheckpoint(inp)) return false;
+    FinalizeRead(BC);
+    ConsoleOutput::WriteStandard(thisclassname, "Binary input loaded");
+    return true;
+}
 
+bool Composition::ReadCheckpoint(std::istream& inp)
+{
     int locNx = Grid.Nx;
     int locNy = Grid.Ny;
     int locNz = Grid.Nz;
@@ -774,29 +822,52 @@ bool Composition::Read(const Settings& locSettings, const BoundaryConditions& BC
         return false;
     }
 
+    std::vector<double> values;
+    if(LossyCompression::Read(inp, values))
+    {
+        size_t n = 0;
+        if(values.size() != Grid.LocalNumberOfCells()*Nphases*Ncomp) return false;
+        STORAGE_LOOP_BEGIN(i,j,k,MoleFractions,0)
+            std::copy_n(values.data() + n, MoleFractions(i,j,k).size(), MoleFractions(i,j,k).data());
+            n += MoleFractions(i,j,k).size();
+        STORAGE_LOOP_END
+        n = 0;
+        if(not LossyCompression::Read(inp, values) or values.size() != Grid.LocalNumberOfCells()*Ncomp) return false;
+        STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,0)
+            std::copy_n(values.data() + n, MoleFractionsTotal(i,j,k).size(), MoleFractionsTotal(i,j,k).data());
+            n += MoleFractionsTotal(i,j,k).size();
+        STORAGE_LOOP_END
+        return bool(inp);
+    }
     STORAGE_LOOP_BEGIN(i,j,k,MoleFractions,0)
         inp.read(reinterpret_cast<char*>(MoleFractions(i,j,k).data()), MoleFractions(i,j,k).size()*sizeof(double));
     STORAGE_LOOP_END
     STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,0)
         inp.read(reinterpret_cast<char*>(MoleFractionsTotal(i,j,k).data()), MoleFractionsTotal(i,j,k).size()*sizeof(double));
     STORAGE_LOOP_END
-    STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,0)
-        for(size_t n = 0; n < Ncomp; n++)
-        {
-            TotInitial({n}) += MoleFractionsTotal(i, j, k)({n});
-        }
-    STORAGE_LOOP_END
+    return bool(inp);
+}
+
+void Composition::FinalizeRead(const BoundaryConditions& BC)
+{
+    // One pass gives the local initial amounts and the global averages
+    Tensor<double, 1> locMoleFractionsTotalSum({Ncomp});
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MoleFractionsTotal,0,reduction(TensorD1Sum: locMoleFractionsTotalSum))
+    {
+        locMoleFractionsTotalSum += MoleFractionsTotal(i,j,k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
     for(size_t n = 0; n < Ncomp; n++)
     {
+        TotInitial({n}) += locMoleFractionsTotalSum({n});
         TotInitial({n}) /= double(Grid.LocalNumberOfCells());
     }
     SetBoundaryConditions(BC);
 
     // Calculation of MoleFractionsTotalAverage is needed for CalculateTotalMolarVolume()
-    CalculateMoleFractionsTotalAverage();
+    SetMoleFractionsTotalAverage(locMoleFractionsTotalSum);
     CalculateTotalMolarVolume();
-    ConsoleOutput::WriteStandard(thisclassname, "Binary input loaded");
-    return true;
 }
 
 void Composition::WriteH5(H5Interface& H5, const int tStep)
@@ -811,10 +882,10 @@ void Composition::WriteH5(H5Interface& H5, const int tStep)
     H5.WriteCheckPoint(tStep, "CxDomain", dbuffer);
     dbuffer.clear();
     dbuffer = MoleFractions.pack();
-    H5.WriteCheckPoint(tStep, "MoleFractions", dbuffer);
+    H5.WriteCheckPoint(tStep, "MoleFractions", dbuffer, "", true);
     dbuffer.clear();
     dbuffer = MoleFractionsTotal.pack();
-    H5.WriteCheckPoint(tStep, "MoleFractionsTotal", dbuffer);
+    H5.WriteCheckPoint(tStep, "MoleFractionsTotal", dbuffer, "", true);
     #else
     ConsoleOutput::WriteExit("OpenPhase is not compiled with HDF5 support, use: make Settings=\"H5\"", thisclassname, "H5Interface()");
     OP_Exit(EXIT_H5_ERROR);
@@ -946,28 +1017,24 @@ void Composition::WriteStatistics(const Settings& locSettings, const int tStep,
     if(MPI_RANK == 0)
     {
 #endif
-    ofstream output_file;
-    if (tStep == 0)
+    stringstream header;
+    header << "sim_time" << "   ";
+    for(size_t comp = 0; comp < Ncomp; comp++)
     {
-        output_file.open(locSettings.TextDir + "CompositionStatistics.opd", ios::out);
-        output_file << "sim_time" << "   ";
-        for(size_t comp = 0; comp < Ncomp; comp++)
-        {
-            output_file << "total_" << Component[comp].Name << "   "
-                        << "deviation_" << Component[comp].Name << "   ";
-        }
-        output_file << endl;
-        output_file.close();
+        header << "total_" << Component[comp].Name << "   "
+               << "deviation_" << Component[comp].Name << "   ";
     }
+    header << "\n";
 
-    output_file.open(locSettings.TextDir + "CompositionStatistics.opd", ios::app);
+    stringstream output_file;
     output_file << sim_time << "   ";
     for(size_t comp = 0; comp < Ncomp; comp++)
     {
         output_file << MoleFractionsTotalAverage({comp})  << "   " << deviation[comp] << "   ";
     }
-    output_file << endl;
-    output_file.close();
+    output_file << "\n";
+    TimeSeriesOutput::Append(locSettings.TextDir + "CompositionStatistics.opd",
+                             header.str(), output_file.str(), tStep == 0);
 #ifdef MPI_PARALLEL
     }
 #endif
@@ -975,8 +1042,8 @@ void Composition::WriteStatistics(const Settings& locSettings, const int tStep,
 
 void Composition::Advect(AdvectionHR& Adv, const Velocities& Vel, PhaseField& Phi, const BoundaryConditions& BC, const double dt, const double tStep)
 {
-    Adv.AdvectField(MoleFractions, MoleFractionsDotIn, Vel, BC, dt);
-    Adv.AdvectField(MoleFractionsTotal, MoleFractionsTotalDot, Vel, BC, dt);
+    Adv.AdvectFields(Vel, BC, dt, std::tie(MoleFractions, MoleFractionsDotIn),
+                                  std::tie(MoleFractionsTotal, MoleFractionsTotalDot));
     //CalculateTotalMoleFractions(Phi);
 }
 
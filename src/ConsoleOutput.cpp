@@ -29,11 +29,180 @@
 #include "Includes.h"
 #include "BuildInfo.h"
 
+#include <mutex>
+
 namespace openphase
 {
 
 using namespace std;
 
+struct WarningRecord                                                            ///< Occurrences of one distinct warning since the last flush
+{
+    size_t Count   = 0;                                                         ///< Number of times the warning was issued
+    size_t Printed = 0;                                                         ///< Number of times it was printed immediately
+};
+
+struct WarningBuffer                                                            ///< Warnings issued by a single thread
+{
+    std::map<std::string, WarningRecord> Records;                               ///< Records by "Instance::Method\nMessage"
+};
+
+/* Warnings are counted in a buffer owned by the issuing thread, so WriteWarning()
+needs no locking when it is called from within the parallel loops of the
+solvers. The registry is only locked when a thread issues its first warning.
+Buffers are never destroyed and are only read by FlushWarnings() outside of
+parallel regions.*/
+static std::mutex WarningRegistryMutex;
+static std::vector<WarningBuffer*> WarningRegistry;
+static std::chrono::steady_clock::time_point LastLogFlush;
+
+static void FlushWarningsAtExit(void);
+
+static WarningBuffer& LocalWarningBuffer()
+{
+    static thread_local WarningBuffer* buffer = nullptr;
+    if(buffer == nullptr)
+    {
+        buffer = new WarningBuffer;
+        std::lock_guard<std::mutex> lock(WarningRegistryMutex);
+        if(WarningRegistry.empty())
+        {
+            std::atexit(FlushWarningsAtExit);
+        }
+        WarningRegistry.push_back(buffer);
+    }
+    return *buffer;
+}
+
+/// Collects the not yet printed occurrences of all threads and clears the buffers
+static std::map<std::string, size_t> CollectWarnings(void)
+{
+    std::map<std::string, size_t> Warnings;
+    std::lock_guard<std::mutex> lock(WarningRegistryMutex);
+    for(WarningBuffer* buffer : WarningRegistry)
+    {
+        for(const auto& [key, record] : buffer->Records)
+        {
+            if(record.Count > record.Printed)
+            {
+                Warnings[key] += record.Count - record.Printed;
+            }
+        }
+        buffer->Records.clear();
+    }
+    return Warnings;
+}
+
+static std::string FormatWarning(const std::string& Instance,
+        const std::string& Message, const std::string& Note = "")
+{
+    const size_t LineLength = ConsoleOutput::LineLength;
+    std::ostringstream oss;
+    oss << setfill('~') << setw(LineLength) << "" << "\n";
+    oss << setfill(' ') << setw(10)  << left << "Warning: "  << Instance << "\n"
+        << "          " << Message      << "\n";
+    if(Note != "")
+    {
+        oss << "          " << Note << "\n";
+    }
+    oss << setfill('~') << setw(LineLength) << "" << "\n";
+    return oss.str();
+}
+
+/// Prints one summary entry per distinct warning with its number of occurrences and ranks
+static void WriteWarningSummary(const std::map<std::string, std::pair<size_t,int>>& Warnings)
+{
+    std::string out;
+    for(const auto& [key, occurrences] : Warnings)
+    {
+        const size_t split = key.find('\n');
+        std::string Note = "(" + to_string(occurrences.first) + " occurrence"
+                         + ((occurrences.first > 1) ? "s" : "");
+        if(occurrences.second > 1)
+        {
+            Note += " on " + to_string(occurrences.second) + " MPI ranks";
+        }
+        Note += (ConsoleOutput::AggregateWarnings) ? ")" : " not shown)";
+        out += FormatWarning(key.substr(0, split), key.substr(split + 1), Note);
+    }
+    if(out.empty()) return;
+
+    ConsoleOutput::WriteToLog(out);
+    if(ConsoleOutput::OutputVerbosity >= VerbosityLevels::Warning)
+    {
+        cerr << out;
+    }
+}
+
+static void FlushWarningsAtExit(void)
+{
+    /* MPI is finalized at this point, so leftover warnings of the other
+    ranks can not be collected anymore and each rank prints its own.*/
+    std::map<std::string, std::pair<size_t,int>> Warnings;
+    for(const auto& [key, count] : CollectWarnings())
+    {
+        Warnings[key] = {count, 1};
+    }
+    WriteWarningSummary(Warnings);
+    if (ConsoleOutput::LogEnabled) ConsoleOutput::LogFile.flush();
+}
+
+void ConsoleOutput::FlushWarnings(void)
+{
+    std::map<std::string, std::pair<size_t,int>> Warnings;
+    std::map<std::string, size_t> locWarnings = CollectWarnings();
+#ifdef MPI_PARALLEL
+    if(AggregateWarnings)
+    {
+        /* Entries are serialized as "count\x1fInstance::Method\nMessage\0" and
+        gathered from all ranks. A single integer is exchanged if no rank has
+        issued a warning since the last flush.*/
+        std::string Send;
+        for(const auto& [key, count] : locWarnings)
+        {
+            Send += to_string(count) + '\x1f' + key + '\0';
+        }
+        int locSize = Send.size();
+        std::vector<int> Sizes(MPI_SIZE, 0);
+        OP_MPI_Allgather(&locSize, 1, OP_MPI_INT, Sizes.data(), 1, OP_MPI_INT, OP_MPI_COMM_WORLD);
+        std::vector<int> Offsets(MPI_SIZE, 0);
+        for(int rank = 1; rank < MPI_SIZE; rank++)
+        {
+            Offsets[rank] = Offsets[rank-1] + Sizes[rank-1];
+        }
+        const int totalSize = Offsets[MPI_SIZE-1] + Sizes[MPI_SIZE-1];
+        if(totalSize == 0) return;
+
+        std::vector<char> Received(totalSize);
+        OP_MPI_Allgatherv(Send.data(), locSize, OP_MPI_CHAR, Received.data(),
+                          Sizes.data(), Offsets.data(), OP_MPI_CHAR, OP_MPI_COMM_WORLD);
+        if(MPI_RANK != 0) return;
+
+        size_t pos = 0;
+        while(pos < Received.size())
+        {
+            const std::string entry(Received.data() + pos);
+            pos += entry.size() + 1;
+            const size_t split = entry.find('\x1f');
+            auto& occurrences = Warnings[entry.substr(split + 1)];
+            occurrences.first += std::stoul(entry.substr(0, split));
+            occurrences.second += 1;
+        }
+    }
+    else
+#endif
+    for(const auto& [key, count] : locWarnings)
+    {
+        Warnings[key] = {count, 1};
+    }
+    WriteWarningSummary(Warnings);
+    if (LogEnabled)
+    {
+        LogFile.flush();
+        LastLogFlush = std::chrono::steady_clock::now();
+    }
+}
+
 void ConsoleOutput::InitLogFile(const std::string& filename, VerbosityLevels consoleVerbosity)
 {
 #ifdef MPI_PARALLEL
@@ -87,8 +256,13 @@ void ConsoleOutput::WriteToLog(const std::string& message)
     if (LogEnabled)
     {
         LogFile << message;
-        // Ensure flushed so logs are available during long runs
-        LogFile.flush();
+        // Flushed periodically so logs are available during long runs
+        const auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - LastLogFlush).count() >= LogFlushInterval)
+        {
+            LogFile.flush();
+            LastLogFlush = now;
+        }
     }
 }
 
@@ -104,6 +278,7 @@ std::string ConsoleOutput::get_time()
 void ConsoleOutput::WriteTimeStep(const RunTimeControl& RTC, const string Message,
         size_t ColumnWidth)
 {
+    FlushWarnings();
 #ifdef MPI_PARALLEL
     if (MPI_RANK == 0)
 #endif
@@ -262,24 +437,27 @@ void ConsoleOutput::WriteWarning(const string Message, const string Instance,
                         const string Method)
 {
 #ifdef MPI_PARALLEL
-    if (MPI_RANK == 0)
+    if (MPI_RANK != 0 and not AggregateWarnings) return;
 #endif
+    string thisInstance = Instance;
+    if (Method != "")
+    {
+        thisInstance += "::" + Method;
+    }
+    if (AggregateWarnings or WarningRateLimit > 0)
+    {
+        WarningRecord& record = LocalWarningBuffer().Records[thisInstance + "\n" + Message];
+        record.Count++;
+        if (AggregateWarnings or record.Count > WarningRateLimit) return;
+        record.Printed++;
+    }
     if(OutputVerbosity >= VerbosityLevels::Warning)
     {
-        string thisInstance = Instance;
-        if (Method != "")
-        {
-            thisInstance += "::" + Method;
-        }
-        std::ostringstream oss;
-        oss << setfill('~') << setw(LineLength) << "" << "\n";
-        oss << setfill(' ') << setw(10)  << left << "Warning: "  << thisInstance << "\n"
-            << "          " << Message      << "\n";
-        oss << setfill('~') << setw(LineLength) << "" << "\n";
+        std::string out = FormatWarning(thisInstance, Message);
         // write to log first
-        WriteToLog(oss.str());
+        WriteToLog(out);
         // then to console (cerr)
-        cerr << oss.str();
+        cerr << out;
     }
 }
 
@@ -304,6 +482,7 @@ void ConsoleOutput::WriteExit(const string Message, const string Instance, const
         oss << setfill('*') << setw(LineLength) << "" << "\n";
         oss << "\n";
         WriteToLog(oss.str());
+        if (LogEnabled) LogFile.flush();
         cerr << oss.str();
     }
 }
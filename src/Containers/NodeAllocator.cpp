@@ -0,0 +1,180 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "Containers/NodeAllocator.h"
+#include "ConsoleOutput.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+
+namespace openphase
+{
+
+#ifdef NODE_POOL
+struct NodePoolFreeBlock                                                        ///< Header of an unused block in a free list
+{
+    NodePoolFreeBlock* next;
+};
+
+struct NodePoolThreadCache                                                      ///< Free lists and counters of a single thread
+{
+    std::array<NodePoolFreeBlock*, NodeMemoryPool::NumberOfClasses> FreeLists{};
+    std::atomic<size_t> PoolAllocations{0};
+    std::atomic<size_t> PoolDeallocations{0};
+    std::atomic<size_t> HeapAllocations{0};
+    std::atomic<size_t> ReservedBytes{0};
+};
+
+/* Thread caches are never destroyed: blocks may be returned by a different
+thread than the one which allocated them, and slabs stay valid for the whole
+program run. The registry is only accessed when a new thread touches the pool
+for the first time and when the statistics are collected.*/
+static std::mutex NodePoolRegistryMutex;
+static std::vector<NodePoolThreadCache*> NodePoolRegistry;
+
+static NodePoolThreadCache& LocalNodePoolCache()
+{
+    static thread_local NodePoolThreadCache* cache = nullptr;
+    if(cache == nullptr)
+    {
+        cache = new NodePoolThreadCache;
+        std::lock_guard<std::mutex> lock(NodePoolRegistryMutex);
+        NodePoolRegistry.push_back(cache);
+    }
+    return *cache;
+}
+
+static void RefillNodePoolClass(NodePoolThreadCache& cache, const size_t sizeClass)
+{
+    const size_t blockSize = (sizeClass + 1)*NodeMemoryPool::BlockGranularity;
+    const size_t nBlocks = NodeMemoryPool::SlabSize/blockSize;
+
+    char* slab = static_cast<char*>(::operator new(nBlocks*blockSize));
+    cache.HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    cache.ReservedBytes.fetch_add(nBlocks*blockSize, std::memory_order_relaxed);
+
+    for(size_t n = nBlocks; n > 0; n--)
+    {
+        NodePoolFreeBlock* block = reinterpret_cast<NodePoolFreeBlock*>(slab + (n-1)*blockSize);
+        block->next = cache.FreeLists[sizeClass];
+        cache.FreeLists[sizeClass] = block;
+    }
+}
+#endif
+
+void* NodeMemoryPool::Allocate(const size_t bytes)
+{
+#ifdef NODE_POOL
+    NodePoolThreadCache& cache = LocalNodePoolCache();
+    if(bytes == 0 or bytes > MaxBlockSize)
+    {
+        cache.HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(bytes);
+    }
+    const size_t sizeClass = (bytes - 1)/BlockGranularity;
+    if(cache.FreeLists[sizeClass] == nullptr)
+    {
+        RefillNodePoolClass(cache, sizeClass);
+    }
+    NodePoolFreeBlock* block = cache.FreeLists[sizeClass];
+    cache.FreeLists[sizeClass] = block->next;
+    cache.PoolAllocations.fetch_add(1, std::memory_order_relaxed);
+    return block;
+#else
+    return ::operator new(bytes);
+#endif
+}
+
+void NodeMemoryPool::Deallocate(void* ptr, const size_t bytes)
+{
+    if(ptr == nullptr) return;
+#ifdef NODE_POOL
+    if(bytes == 0 or bytes > MaxBlockSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    NodePoolThreadCache& cache = LocalNodePoolCache();
+    const size_t sizeClass = (bytes - 1)/BlockGranularity;
+    NodePoolFreeBlock* block = static_cast<NodePoolFreeBlock*>(ptr);
+    block->next = cache.FreeLists[sizeClass];
+    cache.FreeLists[sizeClass] = block;
+    cache.PoolDeallocations.fetch_add(1, std::memory_order_relaxed);
+#else
+    (void) bytes; //unused
+    ::operator delete(ptr);
+#endif
+}
+
+bool NodeMemoryPool::Enabled()
+{
+#ifdef NODE_POOL
+    return true;
+#else
+    return false;
+#endif
+}
+
+NodePoolStatistics NodeMemoryPool::GetStatistics()
+{
+    NodePoolStatistics result;
+#ifdef NODE_POOL
+    std::lock_guard<std::mutex> lock(NodePoolRegistryMutex);
+    for(auto cache : NodePoolRegistry)
+    {
+        result.PoolAllocations   += cache->PoolAllocations.load(std::memory_order_relaxed);
+        result.PoolDeallocations += cache->PoolDeallocations.load(std::memory_order_relaxed);
+        result.HeapAllocations   += cache->HeapAllocations.load(std::memory_order_relaxed);
+        result.ReservedBytes     += cache->ReservedBytes.load(std::memory_order_relaxed);
+    }
+#endif
+    return result;
+}
+
+void NodeMemoryPool::PrintStatistics(const int tStep)
+{
+    if(not Enabled())
+    {
+        ConsoleOutput::WriteStandard("NodeMemoryPool", "disabled (compile with NODE_POOL)");
+        return;
+    }
+    static NodePoolStatistics Previous;
+    NodePoolStatistics Current = GetStatistics();
+
+    ConsoleOutput::WriteLineInsert("Node memory pool statistics");
+    ConsoleOutput::WriteStandardNarrow("Time step", std::to_string(tStep));
+    ConsoleOutput::WriteStandardNarrow("Pool allocations", std::to_string(Current.PoolAllocations - Previous.PoolAllocations));
+    ConsoleOutput::WriteStandardNarrow("Pool deallocations", std::to_string(Current.PoolDeallocations - Previous.PoolDeallocations));
+    ConsoleOutput::WriteStandardNarrow("Heap allocations", std::to_string(Current.HeapAllocations - Previous.HeapAllocations));
+    ConsoleOutput::WriteStandardNarrow("Reserved memory [MB]", std::to_string(Current.ReservedBytes/(1024.0*1024.0)));
+    ConsoleOutput::WriteLine();
+
+    Previous = Current;
+}
+
+}// namespace openphase
@@ -25,6 +25,7 @@
  */
 
 #include "Containers/SparseMatrix.h"
+#include "Containers.h"
 #include <algorithm>
 #include <cassert>
 #include <fenv.h>
@@ -307,12 +308,13 @@ size_t SparseMatrixCSR::MaxRow(const size_t i, const size_t j)
     size_t max_i = i;
     double max_value = 0.0;
 
+    ThreadLocalAccumulator<std::pair<size_t, double>> loc_max({max_i, max_value});
     #pragma omp parallel
     {
         size_t loc_max_i = max_i;
         double loc_max_value = max_value;
 
-        #pragma omp for
+        #pragma omp for schedule(static)
         for (size_t k = i; k < storage.size(); k++)
         for (auto it : storage[k])
         if (it.index == j)
@@ -325,14 +327,15 @@ size_t SparseMatrixCSR::MaxRow(const size_t i, const size_t j)
             break;
         }
 
-        #pragma omp critical
-        {
-            if (std::abs(loc_max_value) > std::abs(max_value))
-            {
-                max_i = loc_max_i;
-                max_value = loc_max_value;
-            }
-        }
+        loc_max.Local() = {loc_max_i, loc_max_value};
+    }
+
+    // Threads hold ascending row ranges, the first maximum is kept as in the serial search
+    for (size_t thread = 0; thread < loc_max.size(); thread++)
+    if (std::abs(loc_max[thread].second) > std::abs(max_value))
+    {
+        max_i = loc_max[thread].first;
+        max_value = loc_max[thread].second;
     }
     return max_i;
 }
@@ -398,153 +401,91 @@ bool operator==(const SparseMatrixCSR& lhs, const SparseMatrixCSC& rhs)
     return eq;
 }
 
-//void BiCGStab::Solve_Unpreconditioned(Vector& x, const Matrix& A, const Vector& b, const double Accuracy)
-//{
-//    //Source (08.07.2020): https://en.wikipedia.org/wiki/Biconjugate_gradient_stabilized_method
-//    //Contact: raphael.schiedung@rub.de
-//    //
-//
-//    const size_t size = b.size();
-//    std::vector<double> r_0 = b-A*x;
-//    std::vector<double> r_i(r_0);
-//    std::vector<double> x_i = x;
-//
-//    double alpha     = 1.0;
-//    double omega_i   = 1.0;
-//    double rho_i     = 1.0;
-//
-//    std::vector<double> v_i (size,0.0);
-//    std::vector<double> p_i (size,0.0);
-//
-//    auto div = [] (const double& nom, const double& div){return nom/div;};//(div > DBL_EPSILON) ? nom/div : DBL_MAX;};
-//
-//    double res = std::sqrt(r_0*r_0)/size;
-//    std::cout << "Iteration: 0\tResiduum: " << res  << "\n";
-//    if (res > Accuracy)
-//    for (size_t i = 1; i < size; i++)
-//    {
-//        const double rho_im1 = rho_i;
-//        rho_i = r_0*r_i;
-//        const double beta  = (rho_i/rho_im1)*(alpha/omega_i);
-//        const std::vector<double> p_im1 (p_i);
-//        p_i = r_i + beta*(p_im1 - omega_i*v_i);
-//        v_i = A*p_i;
-//        alpha = div(rho_i,(r_0*v_i));
-//        const std::vector<double> h = x_i + alpha*p_i;
-//        res = std::sqrt((b-A*h)*(b-A*h))/size;
-//        std::cout << "Iteration: " << i-1 << ".5\tResiduum: " << res  << "\n";
-//        if (res < Accuracy) {x_i = h; break;};
-//        const std::vector<double> s = r_i - v_i*alpha;
-//        const std::vector<double> t = A*s;
-//        omega_i = div(t*s,t*t);
-//        x_i = h + omega_i*s;
-//        r_i = s - omega_i*t;
-//        res = std::sqrt(r_i*r_i)/size;
-//        std::cout << "Iteration: " << i << ".0\tResiduum: " << res  << "\n";
-//        if (res < Accuracy) break;
-//    }
-//    x = x_i;
-//}
+void SparseMatrixCompressedRow::Assign(const SparseMatrixCSR& A)
+{
+    size = A.storage.size();
+    RowStart.assign(size + 1, 0);
+    for (size_t i = 0; i < size; i++)
+    {
+        size_t nonzeros = 0;
+        for (auto& it : A.storage[i]) if (it.value != 0.0) nonzeros++;
+        RowStart[i+1] = RowStart[i] + nonzeros;
+    }
+    Column.resize(RowStart[size]);
+    Value.resize(RowStart[size]);
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < size; i++)
+    {
+        std::vector<SparseMatrix::entry> row;
+        row.reserve(A.storage[i].size());
+        for (auto& it : A.storage[i]) if (it.value != 0.0) row.push_back(it);
+        std::sort(row.begin(), row.end(), [](const SparseMatrix::entry& a, const SparseMatrix::entry& b){return a.index < b.index;});
+
+        size_t n = RowStart[i];
+        for (auto& it : row)
+        {
+            Column[n] = it.index;
+            Value[n]  = it.value;
+            n++;
+        }
+    }
+}
+
+double SparseMatrixCompressedRow::operator()(const size_t i, const size_t j) const
+{
+    assert(i < size && "SparseMatrixCompressedRow::operator(): Access beyond matrix size ");
+
+    auto begin = Column.cbegin() + RowStart[i];
+    auto end   = Column.cbegin() + RowStart[i+1];
+    auto it    = std::lower_bound(begin, end, j);
+    if (it != end and *it == j) return Value[it - Column.cbegin()];
+    return 0.0;
+}
+
+std::vector<double> SparseMatrixCompressedRow::Diagonal() const
+{
+    std::vector<double> tmp(size,0.0);
+    #pragma omp parallel for
+    for (size_t i = 0; i < size; i++)
+    {
+        tmp[i] = (*this)(i,i);
+    }
+    return tmp;
+}
+
+SparseMatrixCompressedRow SparseMatrixCompressedRow::transposed() const
+{
+    /* Counting sort of the entries by column, rows stay sorted */
+    SparseMatrixCompressedRow tmp;
+    size_t nColumns = size;
+    for (size_t j : Column) nColumns = std::max(nColumns, j + 1);
+
+    tmp.size = nColumns;
+    tmp.RowStart.assign(nColumns + 1, 0);
+    tmp.Column.resize(Value.size());
+    tmp.Value.resize(Value.size());
+
+    for (size_t j : Column) tmp.RowStart[j+1]++;
+    for (size_t j = 0; j < nColumns; j++) tmp.RowStart[j+1] += tmp.RowStart[j];
+
+    std::vector<size_t> next(tmp.RowStart.begin(), tmp.RowStart.end() - 1);
+    for (size_t i = 0; i < size; i++)
+    for (size_t n = RowStart[i]; n < RowStart[i+1]; n++)
+    {
+        const size_t m = next[Column[n]]++;
+        tmp.Column[m] = i;
+        tmp.Value[m]  = Value[n];
+    }
+    return tmp;
+}
+
+void SparseMatrixCompressedRow::DivideRowBy(size_t i, double scalar)
+{
+    for (size_t n = RowStart[i]; n < RowStart[i+1]; n++)
+    {
+        Value[n] /= scalar;
+    }
+}
 
-//void BiCGStab::BiCGstab_Jacobi(const Matrix& A, const Vector& b, Vector& x, const size_t l, const double TOL)
-//{
-//    std::cout << "Starte BiCGstab(" << l << ")" << std::endl;
-//    std::vector<Vector> u(l + 1);
-//    std::vector<Vector> r(l + 1);
-//    std::vector<double> sigma(l + 1);
-//    std::vector<double> gamma(l + 1);
-//    std::vector<double> gamma_(l + 1);
-//    std::vector<double> gamma__(l + 1);
-//    Matrix Kinv(x.size());
-//    for (size_t i = 0; i<x.size();++i)
-//    {
-//        Kinv(i,i) = 1./A(i,i);
-//    }
-//
-//    std::vector<std::vector<double> > tau(l + 1);
-//    for (size_t i = 0; i < l + 1; ++i)
-//    {
-//        tau[i].resize(l + 1);
-//    }
-//    u[0].resize(x.size(),0.);
-//    long int k = -l;
-//    auto x0 = x;
-//    auto KA = Kinv*A;
-//    r[0] = Kinv*b - KA * x0;
-//    Vector r0_(r[0].size(),1.);
-//    double rho0 = 1.;
-//    double rho1;
-//    double alpha = 0.;
-//    double omega = 1.;
-//    double res = (r[0]* r[0]);
-//    double res0 = (r[0]* r[0]);
-//    while (res > TOL * TOL*res0)
-//    {
-//        k=k+l;
-//        rho0 = -omega * rho0;
-//        size_t ll = l > 1 ? l -1 : 0;
-//        for (size_t j = 0; j <= ll; ++j)
-//        {
-//            rho1 = (r[j]* r0_);
-//            double beta = alpha * rho1 / rho0;
-//            rho0 = rho1;
-//            for (size_t i = 0; i <= j; ++i)
-//            {
-//                u[i] = r[i] - beta * u[i];
-//            }
-//            u[j + 1] = KA * u[j];
-//            double gamma = (u[j + 1]* r0_);
-//            alpha = rho0 / gamma;
-//            for (size_t i = 0; i <= j; ++i)
-//            {
-//                r[i] -= alpha * u[i + 1];
-//            }
-//            r[j + 1] = KA * r[j];
-//            x0 += alpha * u[0];
-//        }
-//        for (size_t j = 1; j <= l; ++j)
-//        {
-//            for (size_t i = 1; i <= j - 1; ++i)
-//            {
-//                tau[i][j] = (1. / sigma[i]) * (r[j]* r[i]);
-//                r[j] -= tau[i][j] * r[i];
-//            }
-//            sigma[j] = (r[j]* r[j]);
-//            gamma_[j] = (1. / sigma[j]) * (r[0]* r[j]);
-//        }
-//        gamma[l] = gamma_[l];
-//        omega = gamma[l];
-//        for (size_t j = ll; j >= 1; --j)
-//        {
-//            double sum = 0;
-//            for (size_t i = j + 1; i <= l; ++i)
-//            {
-//                sum += tau[j][i] * gamma[i];
-//            }
-//            gamma[j] = gamma_[j] - sum;
-//        }
-//        for (size_t j = 1; j <= ll; ++j)
-//        {
-//            double sum = 0;
-//            for (size_t i = j + 1; i <= ll; ++i)
-//            {
-//                sum += tau[j][i] * gamma[i + 1];
-//            }
-//            gamma__[j] = gamma[j + 1] + sum;
-//        }
-//        x0 += gamma[1] * r[0];
-//        r[0] -= gamma_[l] * r[l];
-//        u[0] -= gamma[l] * u[l];
-//        for (size_t j = 1; j <= ll; ++j)
-//        {
-//            u[0] -= gamma[j]*u[j];
-//            x0 += gamma__[j] * r[j];
-//            r[0] -= gamma_[j] * r[j];
-//        }
-//        x = x0;
-//        res = (r[0]* r[0]);
-//        std::cout << sqrt(res) << std::endl;
-//    }
-//    std::cout << "Iterations: " << k << "\n";
-//}
 }//namespace openphase
@@ -0,0 +1,230 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "DeltaCheckpoint.h"
+#include "AsyncOutput.h"
+#include "ConsoleOutput.h"
+#include "FileInterface.h"
+
+namespace openphase
+{
+using namespace std;
+
+static const char DeltaMagic[8] = {'O','P','D','E','L','T','A','1'};
+
+static uint64_t Hash(const string& data)
+{
+    /* FNV-1a, 64 bit */
+    uint64_t hash = 14695981039346656037ull;
+    for(const char c : data)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+template<class T>
+static void Append(string& out, const T value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<class T>
+static T Extract(istream& inp)
+{
+    T value{};
+    inp.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+void DeltaCheckpoint::Initialize(const long int nx, const long int ny, const long int nz,
+                                 const long int blocksize, const int fullinterval)
+{
+    const long int locBlockSize = max(blocksize, 1l);
+    if(nx != Nx or ny != Ny or nz != Nz or locBlockSize != BlockSize)
+    {
+        Nx = nx;
+        Ny = ny;
+        Nz = nz;
+        BlockSize = locBlockSize;
+        nBlocksX = (Nx + BlockSize - 1)/BlockSize;
+        nBlocksY = (Ny + BlockSize - 1)/BlockSize;
+        nBlocksZ = (Nz + BlockSize - 1)/BlockSize;
+        Hashes.clear();
+    }
+    FullInterval = max(fullinterval, 0);
+}
+
+DeltaCheckpoint::Block_t DeltaCheckpoint::Block(const size_t idx) const
+{
+    const long int bz = idx%nBlocksZ;
+    const long int by = (idx/nBlocksZ)%nBlocksY;
+    const long int bx = idx/(nBlocksZ*nBlocksY);
+    return {bx*BlockSize, min((bx + 1)*BlockSize, Nx),
+            by*BlockSize, min((by + 1)*BlockSize, Ny),
+            bz*BlockSize, min((bz + 1)*BlockSize, Nz)};
+}
+
+string DeltaCheckpoint::Prefix(const string& Name)
+{
+    #ifdef MPI_PARALLEL
+    return Name + "_" + to_string(MPI_RANK) + "_";
+    #else
+    return Name + "_";
+    #endif
+}
+
+string DeltaCheckpoint::FileName(const string& Directory, const string& Prefix, const int tStep)
+{
+    return FileInterface::MakeFileName(Directory, Prefix, tStep, ".delta");
+}
+
+bool DeltaCheckpoint::Write(const string& Directory, const string& Prefix,
+                            const int tStep, const BlockWriter_t& WriteBlock)
+{
+    vector<string> Data(nBlocks());
+    vector<uint64_t> locHashes(nBlocks());
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t idx = 0; idx < nBlocks(); idx++)
+    {
+        ostringstream out(ios::out | ios::binary);
+        WriteBlock(out, Block(idx));
+        Data[idx] = out.str();
+        locHashes[idx] = Hash(Data[idx]);
+    }
+
+    const bool Full = (Hashes.size() != nBlocks() or Count >= FullInterval);
+    vector<size_t> Changed;
+    size_t Bytes = 0;
+    for(size_t idx = 0; idx < nBlocks(); idx++)
+    if(Full or locHashes[idx] != Hashes[idx])
+    {
+        Changed.push_back(idx);
+        Bytes += Data[idx].size() + 2*sizeof(uint64_t);
+    }
+
+    string out;
+    out.reserve(sizeof(DeltaMagic) + 5*sizeof(int32_t) + sizeof(uint64_t) + Bytes);
+    out.append(DeltaMagic, sizeof(DeltaMagic));
+    Append<int32_t>(out, Full ? -1 : PreviousStep);
+    Append<int32_t>(out, Nx);
+    Append<int32_t>(out, Ny);
+    Append<int32_t>(out, Nz);
+    Append<int32_t>(out, BlockSize);
+    Append<uint64_t>(out, Changed.size());
+    for(size_t idx : Changed)
+    {
+        Append<uint64_t>(out, idx);
+        Append<uint64_t>(out, Data[idx].size());
+        out.append(Data[idx]);
+    }
+    AsyncOutput::WriteFile(FileName(Directory, Prefix, tStep), std::move(out));
+
+    Hashes = std::move(locHashes);
+    PreviousStep = tStep;
+    Count = Full ? 1 : Count + 1;
+    return true;
+}
+
+bool DeltaCheckpoint::Read(const string& Directory, const string& Prefix,
+                           const int tStep, const BlockReader_t& ReadBlock)
+{
+    /* The checkpoint may still be written by the output threads */
+    AsyncOutput::Flush();
+
+    /* Collects the chain of checkpoints back to the last full one */
+    vector<int> Chain;
+    int Step = tStep;
+    while(true)
+    {
+        const string Name = FileName(Directory, Prefix, Step);
+        ifstream inp(Name.c_str(), ios::in | ios::binary);
+        char magic[sizeof(DeltaMagic)];
+        inp.read(magic, sizeof(DeltaMagic));
+        if(!inp or memcmp(magic, DeltaMagic, sizeof(DeltaMagic)) != 0)
+        {
+            ConsoleOutput::WriteWarning("Incremental checkpoint \"" + Name + "\" could not be read",
+                                        thisclassname, "Read()");
+            return false;
+        }
+        const int32_t Previous = Extract<int32_t>(inp);
+        const int32_t locNx = Extract<int32_t>(inp);
+        const int32_t locNy = Extract<int32_t>(inp);
+        const int32_t locNz = Extract<int32_t>(inp);
+        const int32_t locBlockSize = Extract<int32_t>(inp);
+        if(locNx != Nx or locNy != Ny or locNz != Nz or locBlockSize != BlockSize)
+        {
+            stringstream message;
+            message << "Inconsistent checkpoint \"" << Name << "\"!\n"
+                    << "Input data dimensions: (" << locNx << ", " << locNy << ", " << locNz
+                    << ") grid points, block size " << locBlockSize << ".\n"
+                    << "Required data dimensions: (" << Nx << ", " << Ny << ", " << Nz
+                    << ") grid points, block size " << BlockSize << ".\n";
+            ConsoleOutput::WriteWarning(message.str(), thisclassname, "Read()");
+            return false;
+        }
+        Chain.push_back(Step);
+        if(Previous < 0) break;
+        if(Previous >= Step)
+        {
+            ConsoleOutput::WriteWarning("Invalid previous time step in \"" + Name + "\"",
+                                        thisclassname, "Read()");
+            return false;
+        }
+        Step = Previous;
+    }
+
+    for(auto it = Chain.rbegin(); it != Chain.rend(); ++it)
+    {
+        const string Name = FileName(Directory, Prefix, *it);
+        ifstream inp(Name.c_str(), ios::in | ios::binary);
+        inp.seekg(sizeof(DeltaMagic) + 5*sizeof(int32_t));
+        const uint64_t nStored = Extract<uint64_t>(inp);
+        for(uint64_t n = 0; n < nStored; n++)
+        {
+            const uint64_t idx  = Extract<uint64_t>(inp);
+            const uint64_t size = Extract<uint64_t>(inp);
+            string data(size, '\0');
+            inp.read(&data[0], size);
+            if(!inp or idx >= nBlocks())
+            {
+                ConsoleOutput::WriteWarning("Incremental checkpoint \"" + Name + "\" is corrupted",
+                                            thisclassname, "Read()");
+                return false;
+            }
+            istringstream block(data, ios::in | ios::binary);
+            ReadBlock(block, Block(idx));
+        }
+    }
+    /* The next checkpoint is written in full */
+    Hashes.clear();
+    ConsoleOutput::WriteStandard(thisclassname, "Restored time step " + to_string(tStep) +
+                                 " from " + to_string(Chain.size()) + " checkpoint(s)");
+    return true;
+}
+
+}// namespace openphase
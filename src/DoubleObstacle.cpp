@@ -32,6 +32,8 @@
 #include "InterfaceRegularization.h"
 #include "PhaseField.h"
 #include "VTK.h"
+#include "Tools/ReductionBatch.h"
+#include "Tools/TimeInfo.h"
 
 namespace openphase
 {
@@ -102,6 +104,7 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsSharpSR(PhaseField& Phase,
     {
         if(Phase.Fields(i,j,k).wide_interface())
         {
+            TimeInfo::CountIteration();
             const NodePF& locPF = Phase.Fields(i,j,k);
 
             double norm_1 = 1.0/Phase.LocalN(locPF);
@@ -262,6 +265,7 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsSharpDR(PhaseField& Phase,
     {
         if(Phase.FieldsDR(i,j,k).wide_interface())
         {
+            TimeInfo::CountIteration();
             const NodePF& locPF = Phase.FieldsDR(i,j,k);
 
             double norm_1 = 1.0/Phase.LocalN(locPF);
@@ -503,10 +507,11 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsSR(PhaseField& Phase,
                                                      InterfaceProperties& IP)
 {
     const double Prefactor = Pi*Pi/(Phase.Grid.Eta*Phase.Grid.Eta);
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCells,)
     {
         if(Phase.Fields(i,j,k).wide_interface())
         {
+            TimeInfo::CountIteration();
             const NodePF& locPF = Phase.Fields(i,j,k);
             double norm_1 = 1.0/Phase.LocalN(locPF);
 
@@ -567,17 +572,18 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsSR(PhaseField& Phase,
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void DoubleObstacle::CalculatePhaseFieldIncrementsDR(PhaseField& Phase,
                                                      InterfaceProperties& IP)
 {
     const double Prefactor = Pi*Pi/(Phase.Grid.Eta*Phase.Grid.Eta);
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.FieldsDR,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCellsDR,)
     {
         if(Phase.FieldsDR(i,j,k).wide_interface())
         {
+            TimeInfo::CountIteration();
             const NodePF& locPF = Phase.FieldsDR(i,j,k);
             double norm_1 = 1.0/Phase.LocalN(locPF);
 
@@ -638,7 +644,7 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsDR(PhaseField& Phase,
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void DoubleObstacle::CalculatePhaseFieldIncrements(PhaseField& Phase,
@@ -691,10 +697,11 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsSR(PhaseField& Phase,
     const double Prefactor = Pi*Pi/(Phase.Grid.Eta*Phase.Grid.Eta);
     const double Prefactor2 = Phase.Grid.Eta/Pi;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCells,)
     {
         if(Phase.Fields(i,j,k).wide_interface())
         {
+            TimeInfo::CountIteration();
             const NodePF& locPF = Phase.Fields(i,j,k);
             double norm_1 = 1.0/Phase.LocalN(locPF);
 
@@ -766,7 +773,7 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsSR(PhaseField& Phase,
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void DoubleObstacle::CalculatePhaseFieldIncrementsDR(PhaseField& Phase,
@@ -776,10 +783,11 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsDR(PhaseField& Phase,
     const double Prefactor = Pi*Pi/(Phase.Grid.Eta*Phase.Grid.Eta);
     const double Prefactor2 = Phase.Grid.Eta/Pi;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.FieldsDR,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCellsDR,)
     {
         if(Phase.FieldsDR(i,j,k).wide_interface())
         {
+            TimeInfo::CountIteration();
             const NodePF& locPF = Phase.FieldsDR(i,j,k);
             double norm_1 = 1.0/Phase.LocalN(locPF);
 
@@ -851,7 +859,7 @@ void DoubleObstacle::CalculatePhaseFieldIncrementsDR(PhaseField& Phase,
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void DoubleObstacle::StabilizeThinChannels(PhaseField& Phase, InterfaceProperties& IP, double penalty)
@@ -950,58 +958,61 @@ double DoubleObstacle::PointEnergy(const PhaseField& Phase,
 double DoubleObstacle::Energy(const PhaseField& Phase,
                               const InterfaceProperties& IP) const
 {
-    double Energy = 0.0;
+    sum_real_t Energy = 0.0;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,reduction(+:Energy))
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,reduction(ReproducibleSUM:Energy))
     {
         Energy += PointEnergy(Phase, IP, i,j,k);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
 #ifdef MPI_PARALLEL
-    double loc_Energy = Energy;
-    OP_MPI_Allreduce(&loc_Energy, &Energy, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    ReductionBatch Batch;
+    Batch.Sum(&Energy);
+    Batch.Reduce();
 #endif
 
-    return Energy*Phase.Grid.CellVolume();
+    return double(Energy)*Phase.Grid.CellVolume();
 }
 
 double DoubleObstacle::Energy(const PhaseField& Phase,
                               const InterfaceProperties& IP,
                               const ElasticProperties& EP) const
 {
-    double Energy = 0.0;
+    sum_real_t Energy = 0.0;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,reduction(+:Energy))
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,reduction(ReproducibleSUM:Energy))
     {
         Energy += PointEnergy(Phase, IP, EP, i,j,k);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
 #ifdef MPI_PARALLEL
-    double loc_Energy = Energy;
-    OP_MPI_Allreduce(&loc_Energy, &Energy, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    ReductionBatch Batch;
+    Batch.Sum(&Energy);
+    Batch.Reduce();
 #endif
 
-    return Energy*Phase.Grid.CellVolume();
+    return double(Energy)*Phase.Grid.CellVolume();
 }
 
 double DoubleObstacle::AverageEnergyDensity(const PhaseField& Phase,
                                             const InterfaceProperties& IP) const
 {
-    double Energy = 0.0;
+    sum_real_t Energy = 0.0;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,reduction(+:Energy))
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,reduction(ReproducibleSUM:Energy))
     {
         Energy += PointEnergy(Phase, IP, i,j,k);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 #ifdef MPI_PARALLEL
-    double loc_Energy = Energy;
-    OP_MPI_Allreduce(&loc_Energy, &Energy, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    ReductionBatch Batch;
+    Batch.Sum(&Energy);
+    Batch.Reduce();
 #endif
 
-    return Energy/double(Phase.Grid.TotalNumberOfCells());
+    return double(Energy)/double(Phase.Grid.TotalNumberOfCells());
 }
 
 void DoubleObstacle::WriteEnergyVTK(const int tStep,
@@ -1041,7 +1052,9 @@ void DoubleObstacle::CalculateFullAnisotropy(const PhaseField& Phase,
     const double Prefactor2 = Phase.Grid.Eta*Phase.Grid.Eta/Pi/Pi;
     const double Prefactor3 = - 4.0*Phase.Grid.Eta*Phase.Grid.Eta/Pi/Pi;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
+    Phase.FieldsProperties.UpdateRotations();                                   // Used by IP.dEnergy_dGradientAlpha()
+
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,Phase.Occupancy,)
     if(Phase.Fields(i,j,k).interface())
     {
         for(auto alpha  = Phase.Fields(i,j,k).cbegin();
@@ -1077,12 +1090,12 @@ void DoubleObstacle::CalculateFullAnisotropy(const PhaseField& Phase,
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
 
     const double DWeights[3] = {-0.5/Phase.Grid.dx, 0.0, 0.5/Phase.Grid.dx};
     if (Phase.Grid.dNx)
     {
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,IP.InterfaceStiffnessTMP,0,)
+        OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,IP.InterfaceStiffnessTMP,Phase.Occupancy,)
         {
             if(Phase.Fields(i,j,k).interface())
             for (int ii = -1; ii <= +1; ii+=2)
@@ -1092,12 +1105,12 @@ void DoubleObstacle::CalculateFullAnisotropy(const PhaseField& Phase,
                 dG.Force(i,j,k).add_raw(it->indexA, it->indexB,-DWeights[ii+1]*it->value1[0]);
             }
         }
-        OMP_PARALLEL_STORAGE_LOOP_END
+        OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
     }
 
     if (Phase.Grid.dNy)
     {
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,IP.InterfaceStiffnessTMP,0,)
+        OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,IP.InterfaceStiffnessTMP,Phase.Occupancy,)
         {
             if(Phase.Fields(i,j,k).interface())
             for (int ii = -1; ii <= +1; ii+=2)
@@ -1107,12 +1120,12 @@ void DoubleObstacle::CalculateFullAnisotropy(const PhaseField& Phase,
                 dG.Force(i,j,k).add_raw(it->indexA, it->indexB,-DWeights[ii+1]*it->value1[1]);
             }
         }
-        OMP_PARALLEL_STORAGE_LOOP_END
+        OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
     }
 
     if (Phase.Grid.dNz)
     {
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,IP.InterfaceStiffnessTMP,0,)
+        OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,IP.InterfaceStiffnessTMP,Phase.Occupancy,)
         {
             if(Phase.Fields(i,j,k).interface())
             for (int ii = -1; ii <= +1; ii+=2)
@@ -1122,7 +1135,7 @@ void DoubleObstacle::CalculateFullAnisotropy(const PhaseField& Phase,
                 dG.Force(i,j,k).add_raw(it->indexA, it->indexB,-DWeights[ii+1]*it->value1[2]);
             }
         }
-        OMP_PARALLEL_STORAGE_LOOP_END
+        OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
     }
 }
 
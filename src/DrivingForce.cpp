@@ -31,6 +31,8 @@
 #include "InterfaceProperties.h"
 #include "BoundaryConditions.h"
 #include "Temperature.h"
+#include "LoadBalancer.h"
+#include "Tools/ReductionBatch.h"
 
 namespace openphase
 {
@@ -98,6 +100,7 @@ void DrivingForce::Initialize(Settings& locSettings, std::string ObjectNameSuffi
     MAXDrivingForceNEG.Allocate(Nphases,Nphases);
 
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -108,7 +111,7 @@ void DrivingForce::ReadInput(const string InputFileName)
     ConsoleOutput::WriteLineInsert("DrivingForce input");
     ConsoleOutput::WriteStandard("Source", InputFileName.c_str());
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -120,7 +123,6 @@ void DrivingForce::ReadInput(const string InputFileName)
     data << inp.rdbuf();
     ReadInput(data);
 
-    inp.close();
 }
 
 void DrivingForce::ReadInput(stringstream& inp)
@@ -243,11 +245,22 @@ void DrivingForce::Average(const PhaseField& Phase, const BoundaryConditions& BC
 {
     if(Averaging)
     {
-        SetWeights(Phase);
+        AveragingRules Rules;
+        Rules.CollectWeights      = WeightsMode;
+        Rules.DistributeWeights   = WeightsMode;
+        Rules.PhiThreshold        = PhiThreshold;
+        Rules.MinWeight           = 0.0;
+        Rules.ScaleThreshold      = true;
+        Rules.InterfaceNeighbours = false;
+        Rules.SeedsCollectRaw     = false;
+        Rules.EmptyCollectRaw     = true;
+
+        Averager.Initialize(Grid, Range);
+        Averager.SetWeights(Force, Phase.Fields, Phase.InterfaceCells);
         SetBoundaryConditions(BC);
-        CollectAverage(Phase);
+        Averager.Collect(Force, Phase.Fields, Phase.InterfaceCells, Phase.FieldsProperties, Rules);
         SetBoundaryConditions(BC);
-        DistributeAverage(Phase);
+        Averager.Distribute(Force, Phase.Fields, Phase.InterfaceCells, Phase.FieldsProperties, Rules);
     }
     else
     {
@@ -257,7 +270,7 @@ void DrivingForce::Average(const PhaseField& Phase, const BoundaryConditions& BC
 
 void DrivingForce::SkipAverage(const PhaseField& Phase)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Force,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCells,)
     {
         if (Phase.Fields(i,j,k).interface())
         for(auto it  = Force(i,j,k).begin();
@@ -270,211 +283,7 @@ void DrivingForce::SkipAverage(const PhaseField& Phase)
             it->average = it->raw;
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-void DrivingForce::SetWeights(const PhaseField& Phase)
-{
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Force,0,)
-    {
-        if (Phase.Fields(i,j,k).interface())
-        for(auto it  = Force(i,j,k).begin();
-                 it != Force(i,j,k).end(); ++it)
-        {
-            double PhiAlpha = Phase.Fields(i,j,k).get_value(it->indexA);
-            double PhiBeta  = Phase.Fields(i,j,k).get_value(it->indexB);
-
-            it->weight = sqrt(PhiAlpha*PhiBeta);
-        }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-void DrivingForce::CollectAverage(const PhaseField& Phase)
-{
-    const int Xrange = min(Range, Grid.Nx-1)*Grid.dNx;
-    const int Yrange = min(Range, Grid.Ny-1)*Grid.dNy;
-    const int Zrange = min(Range, Grid.Nz-1)*Grid.dNz;
-
-    const double weight_threshold = sqrt(PhiThreshold*(1.0 - PhiThreshold));
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Force,0,)
-    {
-        if (Phase.Fields(i,j,k).interface())
-        for(auto it  = Force(i,j,k).begin();
-                 it != Force(i,j,k).end(); ++it)
-        {
-            double scale = Phase.FieldsProperties[it->indexA].VolumeRatio *
-                           Phase.FieldsProperties[it->indexB].VolumeRatio;
-
-            if (it->weight > weight_threshold*scale)
-            {
-                double value       = 0.0;
-                double sum_weights = 0.0;
-                int    counter     = 0;
-
-                for(int ii = -Xrange; ii <= Xrange; ii++)
-                for(int jj = -Yrange; jj <= Yrange; jj++)
-                for(int kk = -Zrange; kk <= Zrange; kk++)
-                {
-                    double weight_dist = Range - sqrt(ii*ii + jj*jj + kk*kk);
-                    double weight_phi  = Force(i+ii, j+jj, k+kk).get_weight(it->indexA, it->indexB);
-
-                    if(weight_dist > 0.0 and weight_phi > 0.0)
-                    {
-                        double weight = 0.0;
-                        switch(WeightsMode)
-                        {
-                            case AveragingWeightsModes::Range:
-                            {
-                                weight = weight_dist;
-                                sum_weights += weight;
-                                break;
-                            }
-                            case AveragingWeightsModes::PhaseFields:
-                            {
-                                weight = weight_phi;
-                                sum_weights += weight;
-                                break;
-                            }
-                            case AveragingWeightsModes::Counter:
-                            {
-                                counter++;
-                                weight = 1.0;
-                                break;
-                            }
-                        }
-                        value += weight*Force(i+ii, j+jj, k+kk).get_raw(it->indexA, it->indexB);
-                    }
-                }
-                switch(WeightsMode)
-                {
-                    case AveragingWeightsModes::Range:
-                    case AveragingWeightsModes::PhaseFields:
-                    {
-                        if(sum_weights > 0.0)
-                        {
-                            it->tmp = value/sum_weights;
-                        }
-                        else
-                        {
-                            it->tmp = it->raw;
-                        }
-                        break;
-                    }
-                    case AveragingWeightsModes::Counter:
-                    {
-                        if(counter != 0)
-                        {
-                            it->tmp = value/counter;
-                        }
-                        else
-                        {
-                            it->tmp = it->raw;
-                        }
-                        break;
-                    }
-                }
-            }
-        }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-void DrivingForce::DistributeAverage(const PhaseField& Phase)
-{
-    const int Xrange = min(Range, Grid.Nx-1)*Grid.dNx;
-    const int Yrange = min(Range, Grid.Ny-1)*Grid.dNy;
-    const int Zrange = min(Range, Grid.Nz-1)*Grid.dNz;
-
-    const double weight_threshold = sqrt(PhiThreshold*(1.0 - PhiThreshold));
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Force,0,)
-    {
-        if (Phase.Fields(i,j,k).interface())
-        for(auto it  = Force(i,j,k).begin();
-                 it != Force(i,j,k).end(); ++it)
-        {
-            if (it->weight > 0.0)
-            {
-                double value       = 0.0;
-                double sum_weights = 0.0;
-                int    counter     = 0;
-
-                double scale = Phase.FieldsProperties[it->indexA].VolumeRatio *
-                               Phase.FieldsProperties[it->indexB].VolumeRatio;
-
-                for(int ii = -Xrange; ii <= Xrange; ii++)
-                for(int jj = -Yrange; jj <= Yrange; jj++)
-                for(int kk = -Zrange; kk <= Zrange; kk++)
-                {
-                    double weight_dist = Range - sqrt(ii*ii + jj*jj + kk*kk);
-                    double weight_phi  = Force(i+ii, j+jj, k+kk).get_weight(it->indexA, it->indexB);
-                    if(weight_dist > 0.0 and weight_phi > weight_threshold*scale)
-                    {
-                        double weight = 0.0;
-                        switch(WeightsMode)
-                        {
-                            case AveragingWeightsModes::Range:
-                            {
-                                weight = weight_dist;
-                                sum_weights += weight;
-                                break;
-                            }
-                            case AveragingWeightsModes::PhaseFields:
-                            {
-                                weight = weight_phi;
-                                sum_weights += weight;
-                                break;
-                            }
-                            case AveragingWeightsModes::Counter:
-                            {
-                                counter++;
-                                weight = 1.0;
-                                break;
-                            }
-                        }
-                        value += weight*Force(i+ii, j+jj, k+kk).get_tmp(it->indexA, it->indexB);
-                    }
-                }
-
-                switch(WeightsMode)
-                {
-                    case AveragingWeightsModes::Range:
-                    case AveragingWeightsModes::PhaseFields:
-                    {
-                        if(sum_weights > 0.0)
-                        {
-                            it->average = value/sum_weights;
-                        }
-                        else
-                        {
-                            it->average = it->tmp;
-                        }
-                        break;
-                    }
-                    case AveragingWeightsModes::Counter:
-                    {
-                        if(counter != 0)
-                        {
-                            it->average = value/counter;
-                        }
-                        else
-                        {
-                            it->average = it->tmp;
-                        }
-                        break;
-                    }
-                }
-            }
-            else if(Phase.FieldsProperties[it->indexA].Stage == GrainStages::Seed or
-                    Phase.FieldsProperties[it->indexB].Stage == GrainStages::Seed)
-            {
-                it->average = it->raw;
-            }
-        }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void DrivingForce::MergePhaseFieldIncrements(PhaseField& Phase, InterfaceProperties& IP)
@@ -759,11 +568,15 @@ double DrivingForce::MaxTimeStep(PhaseField& Phase, InterfaceProperties& IP,
 void DrivingForce::PrintDiagnostics()
 {
 #ifdef MPI_PARALLEL
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &OvershootCounter, 1, OP_MPI_LONG, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, MAXOvershootPOS.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, MAXOvershootNEG.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, MAXDrivingForcePOS.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, MAXDrivingForceNEG.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+    double Overshoots = OvershootCounter;
+    ReductionBatch Batch;
+    Batch.Sum(&Overshoots);
+    Batch.Max(MAXOvershootPOS.data(), Nphases*Nphases);
+    Batch.Min(MAXOvershootNEG.data(), Nphases*Nphases);
+    Batch.Max(MAXDrivingForcePOS.data(), Nphases*Nphases);
+    Batch.Min(MAXDrivingForceNEG.data(), Nphases*Nphases);
+    Batch.Reduce();
+    OvershootCounter = llround(Overshoots);
 #endif
 
     if (OvershootCounter)
@@ -1012,6 +825,11 @@ void DrivingForce::WriteH5(H5Interface& H5, const Settings& locSettings, const P
     H5.WriteVisualization(tStep, locSettings, FieldsToWrite, 1);
 }
 
+size_t DrivingForce::AllocatedMemory(void) const
+{
+    return Force.AllocatedMemory();
+}
+
 void DrivingForce::Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC)
 {
     Grid.SetDimensions(newNx, newNy, newNz);
@@ -1021,6 +839,13 @@ void DrivingForce::Remesh(int newNx, int newNy, int newNz, const BoundaryConditi
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
+void DrivingForce::Repartition(const BoundaryConditions& BC)
+{
+    Grid.ApplyCutPlanes();
+
+    Force.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+}
+
 DrivingForce& DrivingForce::operator= (const DrivingForce& rhs)
 {
     // protect against self-assignment and copy of uninitialized object
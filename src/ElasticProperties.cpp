@@ -39,6 +39,8 @@
 #include "EquilibriumPartitionDiffusionBinary.h"
 #include "Tools.h"
 #include "AdvectionHR.h"
+#include "Tools/LossyCompression.h"
+#include "TimeSeriesOutput.h"
 
 namespace openphase
 {
@@ -65,6 +67,7 @@ void ElasticProperties::Initialize(Settings& locSettings, std::string ObjectName
 
     ElasticityModel = ElasticityModels::Khachaturyan;
     StrainModel  = StrainModels::Small;
+    JumpCacheTolerance = 0.0;
 
     Nphases = locSettings.Nphases;
     Ncomp = locSettings.Ncomp;
@@ -94,8 +97,6 @@ void ElasticProperties::Initialize(Settings& locSettings, std::string ObjectName
     DeformationGradientsEigen.Allocate(Grid, Bcells);
     EffectiveElasticConstants.Allocate(Grid, Bcells);
     Displacements.Allocate(Grid, Bcells);
-    ElasticConstants.Allocate(Grid, Bcells);
-    TransformationStretches.Allocate(Grid, Bcells);
 
     // TODO: Plasticity related storages should be allocated only if plasticity is active.
     DeformationGradientsPlastic.Allocate(Grid, Bcells);
@@ -193,7 +194,7 @@ void ElasticProperties::InitializeLD(Settings& locSettings)
 void ElasticProperties::ReadInput(const string InputFileName)
 {
     ConsoleOutput::Write("Source", InputFileName);
-    fstream inp(InputFileName.c_str(), ios::in);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File " + InputFileName + " could not be opened",thisclassname, "ReadInput()");
@@ -201,7 +202,6 @@ void ElasticProperties::ReadInput(const string InputFileName)
     };
     std::stringstream data;
     data << inp.rdbuf();
-    inp.close();
 
     ReadInput(data);
 }
@@ -246,6 +246,10 @@ void ElasticProperties::ReadInput(stringstream& inp)
     {
         ConsoleOutput::WriteWarning("No or wrong elasticity model specified!\nThe default \"Khachaturyan\" model is used!", thisclassname, "ReadInput()");
     }
+    if(ElasticityModel == ElasticityModels::Rank1 or ElasticityModel == ElasticityModels::Rank1NL)
+    {
+        JumpCacheTolerance = FileInterface::ReadParameterD(inp, moduleLocation, "JumpCacheTolerance", false, 0.0);
+    }
 
     /// Mechanical boundary conditions
 
@@ -539,6 +543,32 @@ void ElasticProperties::ReadInput(stringstream& inp)
     ConsoleOutput::WriteBlankLine();
 
     Variants.ReadInput(inp);
+    ResetGrainsProperties();
+}
+
+size_t ElasticProperties::AllocatedMemory(void) const
+{
+    return VelocityGradientsTotal.AllocatedMemory() +
+           DeformationGradientsTotal.AllocatedMemory() +
+           DeformationGradientsTotalAdvectionDot.AllocatedMemory() +
+           VelocityGradientsPlastic.AllocatedMemory() +
+           DeformationGradientsPlastic.AllocatedMemory() +
+           DeformationGradientsPlasticAdvectionDot.AllocatedMemory() +
+           VelocityGradientsEigen.AllocatedMemory() +
+           DeformationGradientsEigen.AllocatedMemory() +
+           DeformationGradientsEigenAdvectionDot.AllocatedMemory() +
+           DeformationJumps.AllocatedMemory() +
+           NonLocalDeformationJumpTerm.AllocatedMemory() +
+           Stresses.AllocatedMemory() +
+           StressesAdvectionDot.AllocatedMemory() +
+           StressIncrements.AllocatedMemory() +
+           EffectiveElasticConstants.AllocatedMemory() +
+           ElasticConstants.AllocatedMemory() +
+           TransformationStretches.AllocatedMemory() +
+           ForceDensity.AllocatedMemory() +
+           Displacements.AllocatedMemory() +
+           LocalRotations.AllocatedMemory() +
+           LocalRotationsAdvectionDot.AllocatedMemory();
 }
 
 void ElasticProperties::Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC)
@@ -572,14 +602,15 @@ void ElasticProperties::Remesh(int newNx, int newNy, int newNz, const BoundaryCo
 
     Displacements.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
     EffectiveElasticConstants.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
-    ElasticConstants.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
-    TransformationStretches.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
+    if(ElasticConstants.IsAllocated()) ElasticConstants.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
+    if(TransformationStretches.IsAllocated()) TransformationStretches.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
 
     if(VelocityGradientsTotal.IsAllocated()) VelocityGradientsTotal.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
     if(LocalRotations.IsAllocated()) LocalRotations.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
 
     DeformationJumps.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
     NonLocalDeformationJumpTerm.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
+    JumpCellsValid = false;
 
     SetBoundaryConditions(BC);
 
@@ -601,44 +632,94 @@ void ElasticProperties::SetGrainsProperties(const PhaseField& Phase)
         }
         GrainAlpha.Reallocate(size);
         GrainGamma.Reallocate(size);
+        GrainsPropertiesKeys.clear();
+    }
+    GrainsPropertiesKeys.resize(size, {-1.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+    if(Variants.set and VariantsProperties.empty())
+    {
+        SetVariantsProperties();
     }
+    Phase.FieldsProperties.UpdateRotations();
     for(size_t alpha = 0; alpha != size; alpha++)
     if(Phase.FieldsProperties[alpha].Exist)
     {
+        const Grain& locGrain = Phase.FieldsProperties[alpha];
+        const std::array<double,6> Key = {double(locGrain.Phase), double(locGrain.Variant),
+                                          locGrain.Orientation[0], locGrain.Orientation[1],
+                                          locGrain.Orientation[2], locGrain.Orientation[3]};
+        if(GrainsPropertiesKeys[alpha] == Key) continue;
+        GrainsPropertiesKeys[alpha] = Key;
+
+        const dMatrix3x3& R = Phase.FieldsProperties[alpha].RotationMatrix();
+        const dMatrix6x6& M = Phase.FieldsProperties[alpha].VoigtRotation();
+
         size_t pIndex = Phase.FieldsProperties[alpha].Phase;
         size_t vIndex = Phase.FieldsProperties[alpha].Variant;
 
-        GrainTransformationStretches[alpha] = PhaseTransformationStretches[pIndex];
-        GrainElasticConstants[alpha] = PhaseElasticConstants[pIndex];
-        GrainAlpha[alpha] = PhaseAlpha[pIndex];
-        GrainGamma[alpha] = PhaseGamma[pIndex];
-
         if(Variants.set)
         {
-            GrainTransformationStretches[alpha].rotate(Variants(pIndex, vIndex));
-            GrainElasticConstants[alpha].rotate(Variants(pIndex, vIndex));
-            GrainAlpha[alpha].rotate(Variants(pIndex, vIndex));
-            GrainGamma[alpha].rotate(Variants(pIndex, vIndex));
+            const VariantProperties& locVariant = VariantsProperties[pIndex][vIndex];
+            GrainTransformationStretches[alpha] = locVariant.TransformationStretches;
+            GrainElasticConstants[alpha] = locVariant.ElasticConstants;
+            GrainAlpha[alpha] = locVariant.Alpha;
+            GrainGamma[alpha] = locVariant.Gamma;
+        }
+        else
+        {
+            GrainTransformationStretches[alpha] = PhaseTransformationStretches[pIndex];
+            GrainElasticConstants[alpha] = PhaseElasticConstants[pIndex];
+            GrainAlpha[alpha] = PhaseAlpha[pIndex];
+            GrainGamma[alpha] = PhaseGamma[pIndex];
         }
 
-        GrainTransformationStretches[alpha].rotate(Phase.FieldsProperties[alpha].Orientation.RotationMatrix);
-        GrainElasticConstants[alpha].rotate(Phase.FieldsProperties[alpha].Orientation.RotationMatrix);
-        GrainAlpha[alpha].rotate(Phase.FieldsProperties[alpha].Orientation.RotationMatrix);
-        GrainGamma[alpha].rotate(Phase.FieldsProperties[alpha].Orientation.RotationMatrix);
+        GrainTransformationStretches[alpha].rotate(R);
+        GrainElasticConstants[alpha].transform(M);
+        GrainAlpha[alpha].rotate(R);
+        GrainGamma[alpha].transform(M);
 
         for(size_t comp = 0; comp != Ncomp; comp++)
         {
-            GrainLambda({alpha, comp}) = PhaseLambda({pIndex, comp});
-            GrainKappa({alpha, comp})  = PhaseKappa({pIndex, comp});
-
             if(Variants.set)
             {
-                GrainLambda({alpha, comp}).rotate(Variants(pIndex, vIndex));
-                GrainKappa({alpha, comp}).rotate(Variants(pIndex, vIndex));
+                GrainLambda({alpha, comp}) = VariantsProperties[pIndex][vIndex].Lambda[comp];
+                GrainKappa({alpha, comp})  = VariantsProperties[pIndex][vIndex].Kappa[comp];
+            }
+            else
+            {
+                GrainLambda({alpha, comp}) = PhaseLambda({pIndex, comp});
+                GrainKappa({alpha, comp})  = PhaseKappa({pIndex, comp});
             }
 
-            GrainLambda({alpha, comp}).rotate(Phase.FieldsProperties[alpha].Orientation.RotationMatrix);
-            GrainKappa({alpha, comp}).rotate(Phase.FieldsProperties[alpha].Orientation.RotationMatrix);
+            GrainLambda({alpha, comp}).rotate(R);
+            GrainKappa({alpha, comp}).transform(M);
+        }
+    }
+}
+
+void ElasticProperties::SetVariantsProperties(void)
+{
+    VariantsProperties.resize(Variants.Nphases);
+    for(size_t pIndex = 0; pIndex != Variants.Nphases; pIndex++)
+    {
+        VariantsProperties[pIndex].resize(Variants.Nvariants(pIndex));
+        for(size_t vIndex = 0; vIndex != Variants.Nvariants(pIndex); vIndex++)
+        {
+            const dMatrix3x3& R = Variants(pIndex, vIndex);
+            const dMatrix6x6& M = Variants.VoigtRotation(pIndex, vIndex);
+
+            VariantProperties& locVariant = VariantsProperties[pIndex][vIndex];
+            locVariant.TransformationStretches = PhaseTransformationStretches[pIndex].rotated(R);
+            locVariant.ElasticConstants = PhaseElasticConstants[pIndex].transformed(M);
+            locVariant.Alpha = PhaseAlpha[pIndex].rotated(R);
+            locVariant.Gamma = PhaseGamma[pIndex].transformed(M);
+
+            locVariant.Lambda.resize(Ncomp);
+            locVariant.Kappa.resize(Ncomp);
+            for(size_t comp = 0; comp != Ncomp; comp++)
+            {
+                locVariant.Lambda[comp] = PhaseLambda({pIndex, comp}).rotated(R);
+                locVariant.Kappa[comp]  = PhaseKappa({pIndex, comp}).transformed(M);
+            }
         }
     }
 }
@@ -712,6 +793,8 @@ ElasticProperties& ElasticProperties::operator= (const ElasticProperties& rhs)
         ElementNames = rhs.ElementNames;
         ElasticityModel = rhs.ElasticityModel;
         StrainModel = rhs.StrainModel;
+        JumpCacheTolerance = rhs.JumpCacheTolerance;
+        JumpCellsValid = false;
 
         if (DeformationGradientsTotal.IsNotAllocated())
         {
@@ -720,8 +803,11 @@ ElasticProperties& ElasticProperties::operator= (const ElasticProperties& rhs)
             Stresses.Allocate(Grid, rhs.Stresses.Bcells());
             EffectiveElasticConstants.Allocate(Grid, rhs.EffectiveElasticConstants.Bcells());
             Displacements.Allocate(Grid, 0);
-            ElasticConstants.Allocate(Grid, rhs.ElasticConstants.Bcells());
-            TransformationStretches.Allocate(Grid, rhs.TransformationStretches.Bcells());
+            if(rhs.ElasticConstants.IsAllocated())
+            {
+                ElasticConstants.Allocate(Grid, rhs.ElasticConstants.Bcells());
+                TransformationStretches.Allocate(Grid, rhs.TransformationStretches.Bcells());
+            }
 
             if (AnyPlasticity)
             {
@@ -742,8 +828,11 @@ ElasticProperties& ElasticProperties::operator= (const ElasticProperties& rhs)
             Stresses.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
             EffectiveElasticConstants.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
             Displacements.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
-            ElasticConstants.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
-            TransformationStretches.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+            if(ElasticConstants.IsAllocated())
+            {
+                ElasticConstants.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+                TransformationStretches.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+            }
 
             if (LargeDeformations)
             {
@@ -794,6 +883,7 @@ ElasticProperties& ElasticProperties::operator= (const ElasticProperties& rhs)
         }
         GrainElasticConstants = rhs.GrainElasticConstants;
         GrainTransformationStretches = rhs.GrainTransformationStretches;
+        ResetGrainsProperties();
 
         GrainAlpha = rhs.GrainAlpha;
         GrainGamma = rhs.GrainGamma;
@@ -838,6 +928,12 @@ ElasticProperties& ElasticProperties::operator= (const ElasticProperties& rhs)
 
 void ElasticProperties::SetBaseTransformationStretches(const PhaseField& Phase)
 {
+    if(not LocalGrainProperties()) return;
+    if(TransformationStretches.IsNotAllocated())
+    {
+        TransformationStretches.Allocate(Grid, Grid.Bcells);
+    }
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k, TransformationStretches, TransformationStretches.Bcells(),)
     {
         TransformationStretches(i,j,k).clear();
@@ -868,12 +964,12 @@ void ElasticProperties::SetDeformationGradientsEigen(const PhaseField& Phase)
             for(auto alpha  = Phase.Fields(i,j,k).cbegin();
                      alpha != Phase.Fields(i,j,k).cend(); ++alpha)
             {
-                DeformationGradientsEigen(i, j, k) += TransformationStretches(i, j, k).get_value(alpha->index) * alpha->value;
+                DeformationGradientsEigen(i, j, k) += LocalTransformationStretches(i, j, k, alpha->index) * alpha->value;
             }
         }
         else
         {
-            DeformationGradientsEigen(i,j,k) = TransformationStretches(i, j, k).front().value;
+            DeformationGradientsEigen(i,j,k) = LocalTransformationStretches(i, j, k, Phase.Fields(i,j,k).front().index);
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
@@ -917,7 +1013,7 @@ void ElasticProperties::AddInterfaceStressContribution(const PhaseField& Phase,
     //Raphael Schiedung, Ingo Steinbach, and Fathollah Varnik.
     //"Multi-phase-field method for surface tension induced elasticity."
     //Physical Review B 97.3 (2018): 035410.
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, DeformationGradientsEigen,0,)
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,DeformationGradientsEigen,Phase.Occupancy,)
     if (Phase.Fields(i,j,k).interface())
     {
         const double pre1 = 4.0/Phase.Grid.Eta;
@@ -975,11 +1071,17 @@ void ElasticProperties::AddInterfaceStressContribution(const PhaseField& Phase,
 //            sqrtM3x3(locEigenStrain.tensor()*2.0 + dMatrix3x3::UnitTensor());
 //        }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
 }
 
 void ElasticProperties::SetBaseElasticConstants(const PhaseField& Phase)
 {
+    if(not LocalGrainProperties()) return;
+    if(ElasticConstants.IsNotAllocated())
+    {
+        ElasticConstants.Allocate(Grid, Grid.Bcells);
+    }
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ElasticConstants, ElasticConstants.Bcells(),)
     {
         ElasticConstants(i,j,k).clear();
@@ -1172,7 +1274,7 @@ void ElasticProperties::SetEffectiveElasticConstants(const PhaseField& Phase)
                     for(auto alpha  = Phase.Fields(i,j,k).cbegin();
                              alpha != Phase.Fields(i,j,k).cend(); ++alpha)
                     {
-                        EffectiveElasticConstants(i, j, k) += ElasticConstants(i, j, k).get_value(alpha->index) * alpha->value;
+                        EffectiveElasticConstants(i, j, k) += LocalElasticConstants(i, j, k, alpha->index) * alpha->value;
                     }
                     break;
                 }
@@ -1183,7 +1285,7 @@ void ElasticProperties::SetEffectiveElasticConstants(const PhaseField& Phase)
                     for(auto alpha  = Phase.Fields(i,j,k).cbegin();
                              alpha != Phase.Fields(i,j,k).cend(); ++alpha)
                     {
-                        EffectiveElasticConstants(i, j, k) += ElasticConstants(i, j, k).get_value(alpha->index).inverted() * alpha->value;
+                        EffectiveElasticConstants(i, j, k) += LocalElasticConstants(i, j, k, alpha->index).inverted() * alpha->value;
                     }
                     EffectiveElasticConstants(i, j, k).invert();
                     break;
@@ -1192,7 +1294,7 @@ void ElasticProperties::SetEffectiveElasticConstants(const PhaseField& Phase)
         }
         else
         {
-            EffectiveElasticConstants(i,j,k) = ElasticConstants(i, j, k).front().value;
+            EffectiveElasticConstants(i,j,k) = LocalElasticConstants(i, j, k, Phase.Fields(i,j,k).front().index);
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
@@ -1210,7 +1312,7 @@ void ElasticProperties::CalculateDrivingForce(const PhaseField& Phase, DrivingFo
         CalculateNonlocalJumpContribution(Phase);
     }
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, DeformationGradientsTotal,0,)
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,DeformationGradientsTotal,Phase.Occupancy,)
     if(Phase.Fields(i,j,k).interface())
     {
         const vStrain ElasticStrains = EffectiveElasticConstants(i,j,k).inverted()*Stresses(i, j, k);
@@ -1221,8 +1323,8 @@ void ElasticProperties::CalculateDrivingForce(const PhaseField& Phase, DrivingFo
         for(auto  beta  = alpha + 1;
                   beta != Phase.Fields(i, j, k).cend();  ++beta)
         {
-            dMatrix3x3 locStretchesAlpha = TransformationStretches(i,j,k).get_value(alpha->index);
-            dMatrix3x3 locStretchesBeta  = TransformationStretches(i,j,k).get_value( beta->index);
+            dMatrix3x3 locStretchesAlpha = LocalTransformationStretches(i,j,k, alpha->index);
+            dMatrix3x3 locStretchesBeta  = LocalTransformationStretches(i,j,k,  beta->index);
 
             vStrain locEigenStrainDifference =
                 EigenStrainDifference(locStretchesAlpha, locStretchesBeta, i,j,k);
@@ -1233,8 +1335,8 @@ void ElasticProperties::CalculateDrivingForce(const PhaseField& Phase, DrivingFo
                 case ElasticityModels::Khachaturyan:
                 {
                     dG_AB += (ElasticStrains*
-                             ((ElasticConstants(i,j,k).get_value( beta->index) -
-                               ElasticConstants(i,j,k).get_value(alpha->index))*
+                             ((LocalElasticConstants(i,j,k,  beta->index) -
+                               LocalElasticConstants(i,j,k, alpha->index))*
                               ElasticStrains))*0.5;
 
                     dG_AB -= Stresses(i, j, k)*locEigenStrainDifference;
@@ -1244,8 +1346,8 @@ void ElasticProperties::CalculateDrivingForce(const PhaseField& Phase, DrivingFo
                 case ElasticityModels::Reuss:
                 {
                     dG_AB += (Stresses(i, j, k)*
-                             ((ElasticConstants(i,j,k).get_value(alpha->index).inverted() -
-                               ElasticConstants(i,j,k).get_value( beta->index).inverted())*
+                             ((LocalElasticConstants(i,j,k, alpha->index).inverted() -
+                               LocalElasticConstants(i,j,k,  beta->index).inverted())*
                               Stresses(i, j, k)))*0.5;
 
                     dG_AB -= Stresses(i, j, k)*locEigenStrainDifference;
@@ -1256,15 +1358,15 @@ void ElasticProperties::CalculateDrivingForce(const PhaseField& Phase, DrivingFo
                     vStrain locStrain = StrainSmall(DeformationGradientsTotal(i,j,k))
                                       - StrainSmall(DeformationGradientsPlastic(i,j,k));
 
-                    vStrain locEigenStrainAlpha = StrainSmall(TransformationStretches(i,j,k).get_value(alpha->index));
-                    vStrain locEigenStrainBeta  = StrainSmall(TransformationStretches(i,j,k).get_value( beta->index));
+                    vStrain locEigenStrainAlpha = StrainSmall(LocalTransformationStretches(i,j,k, alpha->index));
+                    vStrain locEigenStrainBeta  = StrainSmall(LocalTransformationStretches(i,j,k,  beta->index));
 
                     dG_AB += ((locStrain - locEigenStrainBeta)*
-                              (ElasticConstants(i,j,k).get_value(beta->index)*
+                              (LocalElasticConstants(i,j,k,  beta->index)*
                               (locStrain - locEigenStrainBeta)) -
 
                               (locStrain - locEigenStrainAlpha)*
-                              (ElasticConstants(i,j,k).get_value(alpha->index)*
+                              (LocalElasticConstants(i,j,k, alpha->index)*
                               (locStrain - locEigenStrainAlpha)))*0.5;
                     break;
                 }
@@ -1313,11 +1415,11 @@ void ElasticProperties::CalculateDrivingForce(const PhaseField& Phase, DrivingFo
                         vStrain locEigenStrainBeta  = StrainSmall(locStretchesBeta);
 
                         dG_AB += ((StrainBeta - locEigenStrainBeta)*
-                                  (ElasticConstants(i,j,k).get_value(beta->index)*
+                                  (LocalElasticConstants(i,j,k,  beta->index)*
                                   (StrainBeta - locEigenStrainBeta)) -
 
                                   (StrainAlpha - locEigenStrainAlpha)*
-                                  (ElasticConstants(i,j,k).get_value(alpha->index)*
+                                  (LocalElasticConstants(i,j,k, alpha->index)*
                                   (StrainAlpha - locEigenStrainAlpha)))*0.5*scale;
 
                         dG_AB -= Stresses(i,j,k)*(locStrainJumpA - locStrainJumpB)*0.5*scale;
@@ -1342,8 +1444,8 @@ void ElasticProperties::CalculateDrivingForce(const PhaseField& Phase, DrivingFo
                         if((1.0 - scale) > FLT_EPSILON)
                         {
                             dG_AB += (ElasticStrains*
-                                     ((ElasticConstants(i,j,k).get_value( beta->index) -
-                                       ElasticConstants(i,j,k).get_value(alpha->index))*
+                                     ((LocalElasticConstants(i,j,k,  beta->index) -
+                                       LocalElasticConstants(i,j,k, alpha->index))*
                                       ElasticStrains))*0.5*(1.0 - scale);
 
                             dG_AB -= Stresses(i, j, k)*locEigenStrainDifference*(1.0 - scale);
@@ -1355,84 +1457,155 @@ void ElasticProperties::CalculateDrivingForce(const PhaseField& Phase, DrivingFo
             dGab.Force(i,j,k).add_raw(alpha->index, beta->index, dG_AB);
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
+}
+
+void ElasticProperties::UpdateJumpCells(const PhaseField& Phase)
+{
+    if(JumpCellsValid)
+    {
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,JumpCells,)
+        {
+            DeformationJumps(i,j,k).clear();
+            NonLocalDeformationJumpTerm(i,j,k).clear();
+        }
+        OMP_PARALLEL_CELL_LIST_LOOP_END
+    }
+    else
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DeformationJumps,0,)
+        {
+            DeformationJumps(i,j,k).clear();
+            NonLocalDeformationJumpTerm(i,j,k).clear();
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
+
+    JumpCells.clear();
+    for(const iVector3& cell : Phase.InterfaceCells)
+    if(cell[0] >= 0 and cell[0] < DeformationJumps.sizeX() and
+       cell[1] >= 0 and cell[1] < DeformationJumps.sizeY() and
+       cell[2] >= 0 and cell[2] < DeformationJumps.sizeZ())
+    {
+        JumpCells.push_back(cell);
+    }
+    JumpCellsValid = true;
+}
+
+void ElasticProperties::ValidateAcousticTensorCaches(void)
+{
+    bool changed = (AcousticTensorStiffness.size() != GrainElasticConstants.size());
+    for(size_t alpha = 0; alpha < GrainElasticConstants.size() and not changed; alpha++)
+    {
+        changed = (GrainElasticConstants[alpha] - AcousticTensorStiffness[alpha]).norm() >
+                   GrainElasticConstants[alpha].norm()*JumpCacheTolerance;
+    }
+    const size_t nThreads = omp_get_max_threads();
+    if(changed or AcousticTensorCaches.size() != nThreads)
+    {
+        AcousticTensorCaches.assign(nThreads, {});
+        AcousticTensorStiffness.resize(GrainElasticConstants.size());
+        for(size_t alpha = 0; alpha < GrainElasticConstants.size(); alpha++)
+        {
+            AcousticTensorStiffness[alpha] = GrainElasticConstants[alpha];
+        }
+    }
 }
 
 void ElasticProperties::CalculateDeformationJumps(const PhaseField& Phase)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DeformationJumps,0,)
+    UpdateJumpCells(Phase);
+
+    const bool CacheAcousticTensors = JumpCacheTolerance > 0.0 and not LocalGrainProperties();
+    if(CacheAcousticTensors)
     {
-        DeformationJumps(i,j,k).clear();
+        ValidateAcousticTensorCaches();
+    }
 
+    /* The jumps of a pair do not depend on the jumps of the other pairs (the
+    triple junction contribution below is disabled), a single pass gives the
+    converged result.*/
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,JumpCells,)
+    {
         if(Phase.Fields(i,j,k).interface())
         {
             vStrain locStrain = StrainSmall(DeformationGradientsTotal(i,j,k))
                               - StrainSmall(DeformationGradientsPlastic(i,j,k));
             NodeAB<dVector3,dVector3> locNormals = Phase.Normals(i,j,k);
-            double residual = 0.0;
-            do
+            NodeAB<dVector3,dMatrix3x3>& locJumps = DeformationJumps(i,j,k);
+            for(auto alpha  = Phase.Fields(i, j, k).cbegin();
+                     alpha != Phase.Fields(i, j, k).cend() - 1; ++alpha)
+            for(auto  beta  = alpha + 1;
+                      beta != Phase.Fields(i, j, k).cend();  ++beta)
+            if(alpha->value > DBL_EPSILON and beta->value > DBL_EPSILON)
             {
-                NodeAB<dVector3,dMatrix3x3> locJumps;
-                residual = 0.0;
-                for(auto alpha  = Phase.Fields(i, j, k).cbegin();
-                         alpha != Phase.Fields(i, j, k).cend() - 1; ++alpha)
-                for(auto  beta  = alpha + 1;
-                          beta != Phase.Fields(i, j, k).cend();  ++beta)
-                if(alpha->value > DBL_EPSILON and beta->value > DBL_EPSILON)
-                {
-                    dVector3 locNormalAB = locNormals.get_asym1(alpha->index, beta->index);
+                dVector3 locNormalAB = locNormals.get_asym1(alpha->index, beta->index);
 
-                    vStrain dStrainA = locStrain - StrainSmall(TransformationStretches(i,j,k).get_value(alpha->index));
-                    vStrain dStrainB = locStrain - StrainSmall(TransformationStretches(i,j,k).get_value( beta->index));
+                vStrain dStrainA = locStrain - StrainSmall(LocalTransformationStretches(i,j,k, alpha->index));
+                vStrain dStrainB = locStrain - StrainSmall(LocalTransformationStretches(i,j,k,  beta->index));
 
-                    /*for(auto gamma  = beta + 1;
-                             gamma != Phase.Fields(i, j, k).cend(); ++gamma)
-                    if(gamma->value > DBL_EPSILON)
-                    {
-                        dVector3 locNormalAG = locNormals.get_asym(alpha->index, gamma->index);
-                        dVector3 locNormalBG = locNormals.get_asym( beta->index, gamma->index);
+                /*for(auto gamma  = beta + 1;
+                         gamma != Phase.Fields(i, j, k).cend(); ++gamma)
+                if(gamma->value > DBL_EPSILON)
+                {
+                    dVector3 locNormalAG = locNormals.get_asym(alpha->index, gamma->index);
+                    dVector3 locNormalBG = locNormals.get_asym( beta->index, gamma->index);
 
-                        dVector3 locJumpA = DeformationJumps(i,j,k).get_asym1(alpha->index, gamma->index);
-                        dVector3 locJumpB = DeformationJumps(i,j,k).get_asym1( beta->index, gamma->index);
+                    dVector3 locJumpA = DeformationJumps(i,j,k).get_asym1(alpha->index, gamma->index);
+                    dVector3 locJumpB = DeformationJumps(i,j,k).get_asym1( beta->index, gamma->index);
 
-                        dMatrix3x3 locFjumpA = locJumpA.dyadic(locNormalAG);
-                        dMatrix3x3 locFjumpB = locJumpB.dyadic(locNormalBG);
+                    dMatrix3x3 locFjumpA = locJumpA.dyadic(locNormalAG);
+                    dMatrix3x3 locFjumpB = locJumpB.dyadic(locNormalBG);
 
-                        dStrainA -= VoigtStrain(locFjumpA + locFjumpA.transposed())*gamma->value*0.5;
-                        dStrainB -= VoigtStrain(locFjumpB + locFjumpB.transposed())*gamma->value*0.5;
-                    }*/
+                    dStrainA -= VoigtStrain(locFjumpA + locFjumpA.transposed())*gamma->value*0.5;
+                    dStrainB -= VoigtStrain(locFjumpB + locFjumpB.transposed())*gamma->value*0.5;
+                }*/
 
-                    dMatrix6x6 Cij_alpha = ElasticConstants(i,j,k).get_value(alpha->index);
-                    dMatrix6x6 Cij_beta  = ElasticConstants(i,j,k).get_value( beta->index);
-                    dMatrix6x6 Cij = Cij_alpha*(1.0 - alpha->value) +
-                                     Cij_beta *(1.0 -  beta->value);
+                dMatrix6x6 Cij_alpha = LocalElasticConstants(i,j,k, alpha->index);
+                dMatrix6x6 Cij_beta  = LocalElasticConstants(i,j,k,  beta->index);
 
-                    if(locNormalAB.abs() > DBL_EPSILON)
+                if(locNormalAB.abs() > DBL_EPSILON)
+                {
+                    dMatrix3x3 projCij;
+                    if(CacheAcousticTensors)
                     {
-                        dMatrix3x3 projCij = Cij.project(locNormalAB);
-                        dVector3 locJump = projCij.inverted()*(Cij_alpha*dStrainA - Cij_beta*dStrainB).tensor()*locNormalAB;
-                        dMatrix3x3 locDefJump = locJump.dyadic(locNormalAB);
-                        locJumps.set_asym1(alpha->index, beta->index, locJump);
-                        locJumps.set_asym2(alpha->index, beta->index, locDefJump);
-
-                        dVector3 locJumpOLD = DeformationJumps(i,j,k).get_asym1(alpha->index, beta->index);
-                        residual = max((locJumpOLD - locJump).abs()*beta->value, residual);
+                        auto& Cache = AcousticTensorCaches[omp_get_thread_num()];
+                        const AcousticTensorKey Key{alpha->index, beta->index,
+                            {std::lround(locNormalAB[0]/JumpCacheTolerance),
+                             std::lround(locNormalAB[1]/JumpCacheTolerance),
+                             std::lround(locNormalAB[2]/JumpCacheTolerance)}};
+                        auto Entry = Cache.find(Key);
+                        if(Entry == Cache.end())
+                        {
+                            if(Cache.size() >= MaxAcousticTensorCacheSize) Cache.clear();
+                            Entry = Cache.emplace(Key, AcousticTensors{Cij_alpha.project(locNormalAB),
+                                                                       Cij_beta.project(locNormalAB)}).first;
+                        }
+                        projCij = Entry->second.Alpha*(1.0 - alpha->value) +
+                                  Entry->second.Beta *(1.0 -  beta->value);
                     }
+                    else
+                    {
+                        dMatrix6x6 Cij = Cij_alpha*(1.0 - alpha->value) +
+                                         Cij_beta *(1.0 -  beta->value);
+                        projCij = Cij.project(locNormalAB);
+                    }
+                    dVector3 locJump = projCij.inverted()*(Cij_alpha*dStrainA - Cij_beta*dStrainB).tensor()*locNormalAB;
+                    dMatrix3x3 locDefJump = locJump.dyadic(locNormalAB);
+                    locJumps.set_asym1(alpha->index, beta->index, locJump);
+                    locJumps.set_asym2(alpha->index, beta->index, locDefJump);
                 }
-                DeformationJumps(i,j,k) = locJumps;
             }
-            while(residual > 1.0e-6);
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void ElasticProperties::CalculateNonlocalJumpContribution(const PhaseField& Phase)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DeformationJumps,0,)
+    /* NonLocalDeformationJumpTerm has been cleared by UpdateJumpCells() */
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,JumpCells,)
     {
-        NonLocalDeformationJumpTerm(i,j,k).clear();
-
         if(Phase.Fields(i,j,k).interface())
         {
             vStrain locStrain = StrainSmall(DeformationGradientsTotal(i,j,k))
@@ -1451,11 +1624,11 @@ void ElasticProperties::CalculateNonlocalJumpContribution(const PhaseField& Phas
                 dMatrix3x3 defJumpT = DeformationJumps(i,j,k).get_asym2(alpha->index, beta->index);
                 dMatrix3x3 strainJumpAB = (defJumpT.transposed() + defJumpT)*0.5;
 
-                vStrain dStrainA = (locStrain - StrainSmall(TransformationStretches(i,j,k).get_value(alpha->index)) - VoigtStrain(strainJumpAB)*beta->value);
-                vStrain dStrainB = (locStrain - StrainSmall(TransformationStretches(i,j,k).get_value( beta->index)) + VoigtStrain(strainJumpAB)*alpha->value);
+                vStrain dStrainA = (locStrain - StrainSmall(LocalTransformationStretches(i,j,k, alpha->index)) - VoigtStrain(strainJumpAB)*beta->value);
+                vStrain dStrainB = (locStrain - StrainSmall(LocalTransformationStretches(i,j,k,  beta->index)) + VoigtStrain(strainJumpAB)*alpha->value);
 
-                vStress stressAlpha = ElasticConstants(i,j,k).get_value(alpha->index) * dStrainA;
-                vStress stressBeta  = ElasticConstants(i,j,k).get_value( beta->index) * dStrainB;
+                vStress stressAlpha = LocalElasticConstants(i,j,k, alpha->index) * dStrainA;
+                vStress stressBeta  = LocalElasticConstants(i,j,k,  beta->index) * dStrainB;
 
                 dMatrix3x3 locUnity = dMatrix3x3::UnitTensor() - locNormalAB.dyadic(locNormalAB);
 
@@ -1465,7 +1638,7 @@ void ElasticProperties::CalculateNonlocalJumpContribution(const PhaseField& Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 void ElasticProperties::CalculateChemicalPotentialContribution(
                                         const PhaseField& Phase,
@@ -1525,8 +1698,8 @@ void ElasticProperties::Advect(AdvectionHR& Adv, const Velocities& Vel, PhaseFie
     //    Adv.AdvectField(DeformationGradientsEigen, DeformationGradientsEigenAdvectionDot, Vel, BC, dx, dt);
     //    Adv.AdvectField(DeformationGradientsPlastic, DeformationGradientsPlasticAdvectionDot, Vel, BC, dx, dt);
 
-        Adv.AdvectField(Stresses, StressesAdvectionDot, Vel, BC, dt);
-        Adv.AdvectField(LocalRotations, LocalRotationsAdvectionDot, Vel, BC, dt);
+        Adv.AdvectFields(Vel, BC, dt, std::tie(Stresses, StressesAdvectionDot),
+                                      std::tie(LocalRotations, LocalRotationsAdvectionDot));
     
         ConsoleOutput::WriteStandard(thisclassname, "Advected");
     }
@@ -1571,6 +1744,10 @@ vStrain ElasticProperties::AveragePlasticStrain(void) const
     return locAveragePlasticStrain/(Grid.TotalNumberOfCells());
 }
 
+/* Number of values per cell in the raw data files: total, eigen and plastic
+deformation gradients and the stresses */
+static constexpr size_t CellValues = (3*sizeof(dMatrix3x3) + sizeof(vStress))/sizeof(double);
+
 bool ElasticProperties::Write(const Settings& locSettings, const int tStep) const
 {
 #ifdef MPI_PARALLEL
@@ -1588,14 +1765,37 @@ bool ElasticProperties::Write(const Settings& locSettings, const int tStep) cons
 
     out.write(reinterpret_cast<const char*>(&(AverageStrain)), sizeof(vStrain));
 
-    STORAGE_LOOP_BEGIN(i,j,k,DeformationGradientsTotal,0)
+    if(locSettings.CheckpointTolerance > 0.0)
     {
-        out.write(reinterpret_cast<const char*>(&(DeformationGradientsTotal(i,j,k))), sizeof(dMatrix3x3));
-        out.write(reinterpret_cast<const char*>(&(DeformationGradientsEigen(i,j,k))), sizeof(dMatrix3x3));
-        out.write(reinterpret_cast<const char*>(&(DeformationGradientsPlastic(i,j,k))), sizeof(dMatrix3x3));
-        out.write(reinterpret_cast<const char*>(&(Stresses(i,j,k))), sizeof(vStress));
+        /* Error bounded compression of the cell data, see Tools/LossyCompression.h */
+        std::vector<double> values(Grid.LocalNumberOfCells()*CellValues);
+        size_t idx = 0;
+        auto Append = [&values, &idx](const auto& value)
+        {
+            memcpy(values.data() + idx, &value, sizeof(value));
+            idx += sizeof(value)/sizeof(double);
+        };
+        STORAGE_LOOP_BEGIN(i,j,k,DeformationGradientsTotal,0)
+        {
+            Append(DeformationGradientsTotal(i,j,k));
+            Append(DeformationGradientsEigen(i,j,k));
+            Append(DeformationGradientsPlastic(i,j,k));
+            Append(Stresses(i,j,k));
+        }
+        STORAGE_LOOP_END
+        LossyCompression::Write(out, values, locSettings.CheckpointTolerance, CellValues);
+    }
+    else
+    {
+        STORAGE_LOOP_BEGIN(i,j,k,DeformationGradientsTotal,0)
+        {
+            out.write(reinterpret_cast<const char*>(&(DeformationGradientsTotal(i,j,k))), sizeof(dMatrix3x3));
+            out.write(reinterpret_cast<const char*>(&(DeformationGradientsEigen(i,j,k))), sizeof(dMatrix3x3));
+            out.write(reinterpret_cast<const char*>(&(DeformationGradientsPlastic(i,j,k))), sizeof(dMatrix3x3));
+            out.write(reinterpret_cast<const char*>(&(Stresses(i,j,k))), sizeof(vStress));
+        }
+        STORAGE_LOOP_END
     }
-    STORAGE_LOOP_END
 
     out.close();
     return true;
@@ -1619,14 +1819,40 @@ bool ElasticProperties::Read(const Settings& locSettings, const BoundaryConditio
 
     inp.read(reinterpret_cast<char*>(&(AverageStrain)), sizeof(vStrain));
 
-    STORAGE_LOOP_BEGIN(i,j,k,DeformationGradientsTotal,DeformationGradientsTotal.Bcells())
+    std::vector<double> values;
+    if(LossyCompression::Read(inp, values))
+    {
+        if(values.size() != Grid.LocalNumberOfCells()*CellValues)
+        {
+            ConsoleOutput::WriteWarning("File " + FileName + " has inconsistent dimensions",thisclassname);
+            return false;
+        }
+        size_t idx = 0;
+        auto Extract = [&values, &idx](auto& value)
+        {
+            memcpy(reinterpret_cast<char*>(&value), values.data() + idx, sizeof(value));
+            idx += sizeof(value)/sizeof(double);
+        };
+        STORAGE_LOOP_BEGIN(i,j,k,DeformationGradientsTotal,0)
+        {
+            Extract(DeformationGradientsTotal(i,j,k));
+            Extract(DeformationGradientsEigen(i,j,k));
+            Extract(DeformationGradientsPlastic(i,j,k));
+            Extract(Stresses(i,j,k));
+        }
+        STORAGE_LOOP_END
+    }
+    else
     {
-        inp.read(reinterpret_cast<char*>(&(DeformationGradientsTotal(i,j,k))), sizeof(dMatrix3x3));
-        inp.read(reinterpret_cast<char*>(&(DeformationGradientsEigen(i,j,k))), sizeof(dMatrix3x3));
-        inp.read(reinterpret_cast<char*>(&(DeformationGradientsPlastic(i,j,k))), sizeof(dMatrix3x3));
-        inp.read(reinterpret_cast<char*>(&(Stresses(i,j,k))), sizeof(vStress));
+        STORAGE_LOOP_BEGIN(i,j,k,DeformationGradientsTotal,0)
+        {
+            inp.read(reinterpret_cast<char*>(&(DeformationGradientsTotal(i,j,k))), sizeof(dMatrix3x3));
+            inp.read(reinterpret_cast<char*>(&(DeformationGradientsEigen(i,j,k))), sizeof(dMatrix3x3));
+            inp.read(reinterpret_cast<char*>(&(DeformationGradientsPlastic(i,j,k))), sizeof(dMatrix3x3));
+            inp.read(reinterpret_cast<char*>(&(Stresses(i,j,k))), sizeof(vStress));
+        }
+        STORAGE_LOOP_END
     }
-    STORAGE_LOOP_END
     SetBoundaryConditions(BC);
     ConsoleOutput::Write(thisclassname, "Binary input loaded");
     return true;
@@ -1861,30 +2087,26 @@ void ElasticProperties::WriteStressStrainData(int time_step, double time, string
 #endif
     string separator = " ";
 
-    if(!std::filesystem::exists(filename) or time_step <= 0)
-    {
-        ofstream file(filename, ios::out);
-        file << "TimeStep"   << separator
-             << "Time"       << separator
-             << "Epsilon_xx" << separator
-             << "Epsilon_yy" << separator
-             << "Epsilon_zz" << separator
-             << "Epsilon_yz" << separator
-             << "Epsilon_xz" << separator
-             << "Epsilon_xy" << separator
-             << "Sigma_xx"   << separator
-             << "Sigma_yy"   << separator
-             << "Sigma_zz"   << separator
-             << "Sigma_yz"   << separator
-             << "Sigma_xz"   << separator
-             << "Sigma_xy"   << separator
-             << "Mises"      << separator
-             << "Pressure"   << separator
-             << "Norm"       << endl;
-        file.close();
-    }
-
-    ofstream outputFile(filename, ios::app);
+    stringstream header;
+    header << "TimeStep"   << separator
+           << "Time"       << separator
+           << "Epsilon_xx" << separator
+           << "Epsilon_yy" << separator
+           << "Epsilon_zz" << separator
+           << "Epsilon_yz" << separator
+           << "Epsilon_xz" << separator
+           << "Epsilon_xy" << separator
+           << "Sigma_xx"   << separator
+           << "Sigma_yy"   << separator
+           << "Sigma_zz"   << separator
+           << "Sigma_yz"   << separator
+           << "Sigma_xz"   << separator
+           << "Sigma_xy"   << separator
+           << "Mises"      << separator
+           << "Pressure"   << separator
+           << "Norm"       << "\n";
+
+    stringstream outputFile;
     outputFile << time_step        << separator
                << time             << separator
 
@@ -1904,9 +2126,8 @@ void ElasticProperties::WriteStressStrainData(int time_step, double time, string
 
                << AverageStress.Mises()    << separator
                << AverageStress.Pressure() << separator
-               << AverageStress.norm()     << endl;
-
-    outputFile.close();
+               << AverageStress.norm()     << "\n";
+    TimeSeriesOutput::Append(filename, header.str(), outputFile.str(), time_step <= 0);
 #ifdef MPI_PARALLEL
     }
 #endif
@@ -1918,10 +2139,9 @@ void ElasticProperties::WriteDilatometerCurve(std::string filename, double tempe
     if(MPI_RANK == 0)
     {
 #endif
-    ofstream outputFile;
-    outputFile.open(filename, ios::app|ios::out);
-    outputFile << temperature  << ", " << (pow(AverageDeformationGradient().determinant(), 1.0/(Grid.Active()))-1.0)*real_size << endl;
-    outputFile.close();
+    stringstream outputFile;
+    outputFile << temperature  << ", " << (pow(AverageDeformationGradient().determinant(), 1.0/(Grid.Active()))-1.0)*real_size << "\n";
+    TimeSeriesOutput::Append(filename, "", outputFile.str());
 #ifdef MPI_PARALLEL
     }
 #endif
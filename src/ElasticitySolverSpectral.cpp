@@ -34,6 +34,11 @@
 #include "BoundaryConditions.h"
 #include "ElasticProperties.h"
 #include "ElasticitySolverSpectral.h"
+#include "FFTBackend.h"
+#include "FFTWorkspace.h"
+#include "FFTWPlanner.h"
+#include "PencilFFT.h"
+#include "WaveVectors.h"
 
 namespace openphase
 {
@@ -74,14 +79,39 @@ class OP_EXPORTS ElasticitySolverSpectralImpl : public OPObject
     int    MAXIterations;                                                       ///< Maximum iterations per time step for the elasticity solver
     bool   VerboseIterations;                                                   ///< If true enables iterations statistics output to console
     bool   DiscreteDerivatives;                                                 ///< If true, uses sin(Q) instead of Q (wave vector) for reciprocal space derivatives calculations
+    int    AndersonDepth;                                                       ///< Number of previous iterations used by the Anderson acceleration, 0 disables it
+    double SkipStressTolerance;                                                 ///< Solve is skipped if the local stresses changed less than this since the last solve, 0 disables skipping
+    int    SkipMaxSteps;                                                        ///< Maximum number of consecutive skipped solves
+    int    SkippedSteps;                                                        ///< Number of consecutive skipped solves
 
-    double *  UandForce[3];                                                     ///< Force and displacements in real and reciprocal space
-    double *  RHSandDefGrad[9];                                                 ///< RHS and deformation gradient in real and reciprocal space
+    static constexpr int AndersonMaxDepth = 16;                                 ///< Upper limit of AndersonDepth
+    int    AndersonIteration;                                                   ///< Number of Anderson steps in the current Solve() call
+    std::vector<Storage3D<dMatrix3x3,0>> AndersonHistory;                       ///< Previous deformation gradient and residual, followed by AndersonDepth differences of each
+    double AndersonGram[AndersonMaxDepth][AndersonMaxDepth];                    ///< Inner products of the residual differences
 
-    fftw_plan ForwardPlanRHS[9];                                                ///< Forward FFT plans for the RHSide
-    fftw_plan ForwardPlanForce[3];                                              ///< Forward FFT plans for the force
-    fftw_plan BackwardPlanDefGrad[9];                                           ///< Backward FFT plans for the deformation gradients
-    fftw_plan BackwardPlanU[3];                                                 ///< Backward FFT plans for the displacements
+    fft_real* UandForce[3];                                                     ///< Force and displacements in real and reciprocal space
+    fft_real* RHSandDefGrad[9];                                                 ///< RHS and deformation gradient in real and reciprocal space
+    fft_real* UandForceData = nullptr;                                          ///< Contiguous memory of all UandForce components
+    fft_real* RHSandDefGradData = nullptr;                                      ///< Contiguous memory of all RHSandDefGrad components
+
+#ifdef MPI_PARALLEL
+    std::vector<fftw_plan> ForwardPlanRHS;                                      ///< Forward FFT plans for the RHSide
+    std::vector<fftw_plan> ForwardPlanForce;                                    ///< Forward FFT plans for the force
+    std::vector<fftw_plan> BackwardPlanDefGrad;                                 ///< Backward FFT plans for the deformation gradients
+    std::vector<fftw_plan> BackwardPlanU;                                       ///< Backward FFT plans for the displacements
+    PencilFFT PencilRHSandDefGrad;                                              ///< Pencil decomposed FFT of RHSandDefGrad (MPI 3D decomposition)
+    PencilFFT PencilUandForce;                                                  ///< Pencil decomposed FFT of UandForce (MPI 3D decomposition)
+#else
+    FFTBackend FFTRHSandDefGrad;                                                ///< Batched FFT of RHSandDefGrad (FFTW or cuFFT)
+    FFTBackend FFTUandForce;                                                    ///< Batched FFT of UandForce (FFTW or cuFFT)
+#endif
+    int SpectralN[3];                                                           ///< Local extents of the reciprocal space arrays
+    int SpectralOffset[3];                                                      ///< Position of the local reciprocal space arrays in the global reciprocal space
+    WaveVectors Q;                                                              ///< Wave vectors of the local reciprocal space arrays
+
+    size_t LocalSize(void) const;                                               ///< Number of doubles per component of the FFT arrays
+    void AllocateFFT(const size_t SIZE);                                        ///< Allocates the FFT arrays of SIZE doubles per component and creates the FFT plans
+    void FreeFFT(void);                                                         ///< Destroys the FFT plans and frees the FFT arrays
 
     void CopyForceDensity(ElasticProperties& EP);                               ///< Copies force density into the internal storage of the solver
     void CalculateRHS(const ElasticProperties& EP, const dMatrix6x6& Cij);      ///< Calculates right hand side of the mechanical equilibrium equation
@@ -93,6 +123,9 @@ class OP_EXPORTS ElasticitySolverSpectralImpl : public OPObject
     void CalculateTargetStress(ElasticProperties& EP,
                                vStress& TargetStress);                          ///< Calculates average stress
     void CopyDisplacements(ElasticProperties& EP);                              ///< Copies displacements to the ElasticProperties
+    void AndersonMixing(ElasticProperties& EP, const dMatrix3x3& avgDefGrad,
+                        double& MAXStrainDifference);                           ///< Sets the deformation gradients by Anderson acceleration of the fixed-point iteration
+    bool SkipSolve(ElasticProperties& EP);                                      ///< Checks if the stresses changed enough since the last solve to require a new solve
     void SetElasticProperties(ElasticProperties& EP,
                               double& MAXStrainDifference,
                               double& MAXStressDifference);                     ///< Sets stresses and deformation gradients
@@ -155,6 +188,10 @@ ElasticitySolverSpectralImpl::ElasticitySolverSpectralImpl()
     MAXIterations    = 100;
 
     DiscreteDerivatives = false;
+    AndersonDepth = 0;
+    SkipStressTolerance = 0.0;
+    SkipMaxSteps = 10;
+    SkippedSteps = 0;
     VerboseIterations = false;
     OPMECH = false;
 };
@@ -187,6 +224,10 @@ void ElasticitySolverSpectralImpl::Initialize(Settings& locSettings, std::string
 
     VerboseIterations = false;
     DiscreteDerivatives = false;
+    AndersonDepth = 0;
+    SkipStressTolerance = 0.0;
+    SkipMaxSteps = 10;
+    SkippedSteps = 0;
     //Initialize FFTW OpenMP threads
 #ifdef _OPENMP
     fftw_init_threads();
@@ -198,93 +239,15 @@ void ElasticitySolverSpectralImpl::Initialize(Settings& locSettings, std::string
     // Initialize FFTW MPI parallelism
 #ifdef MPI_PARALLEL
     op_fftw_mpi_init();
-
-    ptrdiff_t local_n0      = 0;
-    ptrdiff_t local_0_start = 0;
-
-    size_t SIZE = 2*op_fftw_mpi_local_size_3d(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, OP_MPI_COMM_WORLD,
-                                              &local_n0, &local_0_start);
-#else
-    size_t SIZE = Grid.Nx*Grid.Ny*Grid.Nz2*2;
 #endif
-
-    // Allocate arrays
-    for(int n = 0; n < 9; n++)
-    {
-        RHSandDefGrad[n] = (double *)fftw_malloc(sizeof(double)*SIZE);
-    }
-    for(int n = 0; n < 3; n++)
-    {
-        UandForce[n] = (double *)fftw_malloc(sizeof(double)*SIZE);
-    }
+    size_t SIZE = LocalSize();
 
     // Set number of FFTW OpenMP threads
 #ifdef _OPENMP
     fftw_plan_with_nthreads(omp_get_max_threads());
 #endif
 
-    // Create FFT plans
-    for(int n = 0; n < 9; n++)
-    {
-        #ifdef MPI_PARALLEL
-        ForwardPlanRHS[n] = op_fftw_mpi_plan_dft_r2c_3d (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, RHSandDefGrad[n],
-                        reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                        OP_MPI_COMM_WORLD,
-                        FFTW_ESTIMATE);
-        #else
-        ForwardPlanRHS[n] = fftw_plan_dft_r2c_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz, RHSandDefGrad[n],
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         FFTW_ESTIMATE);
-        #endif
-    }
-
-    for(int n = 0; n < 9; n++)
-    {
-        #ifdef MPI_PARALLEL
-        BackwardPlanDefGrad[n] = op_fftw_mpi_plan_dft_c2r_3d
-                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         RHSandDefGrad[n],
-                         OP_MPI_COMM_WORLD,
-                         FFTW_ESTIMATE);
-        #else
-        BackwardPlanDefGrad[n] = fftw_plan_dft_c2r_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz,
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         RHSandDefGrad[n],
-                         FFTW_ESTIMATE);
-        #endif
-    }
-
-    for(int n = 0; n < 3; n++)
-    {
-        #ifdef MPI_PARALLEL
-        BackwardPlanU[n] = op_fftw_mpi_plan_dft_c2r_3d
-                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
-                         reinterpret_cast<fftw_complex*> (UandForce[n]),
-                         UandForce[n],
-                         OP_MPI_COMM_WORLD,
-                         FFTW_ESTIMATE);
-
-        ForwardPlanForce[n] = op_fftw_mpi_plan_dft_r2c_3d
-                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, UandForce[n],
-                            reinterpret_cast<fftw_complex*> (UandForce[n]),
-                            OP_MPI_COMM_WORLD,
-                            FFTW_ESTIMATE);
-        #else
-        BackwardPlanU[n] = fftw_plan_dft_c2r_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz,
-                         reinterpret_cast<fftw_complex*> (UandForce[n]),
-                         UandForce[n],
-                         FFTW_ESTIMATE);
-
-        ForwardPlanForce[n] = fftw_plan_dft_r2c_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz, UandForce[n],
-                         reinterpret_cast<fftw_complex*> (UandForce[n]),
-                         FFTW_ESTIMATE);
-        #endif
-    }
+    AllocateFFT(SIZE);
 
     locSettings.AddForRemeshing(*this);
     initialized = true;
@@ -303,6 +266,10 @@ void ElasticitySolverSpectralImpl::Initialize(Settings& locSettings, const Bound
 
     VerboseIterations = false;
     DiscreteDerivatives = false;
+    AndersonDepth = 0;
+    SkipStressTolerance = 0.0;
+    SkipMaxSteps = 10;
+    SkippedSteps = 0;
 
     // Set system dimensions
     Grid = locSettings.Grid;
@@ -322,12 +289,28 @@ void ElasticitySolverSpectralImpl::Initialize(Settings& locSettings, const Bound
     if(BC.BC0Y != BoundaryConditionTypes::Periodic or
        BC.BCNY != BoundaryConditionTypes::Periodic)
     {
+#ifdef MPI_PARALLEL
+        if(MPI_3D_DECOMPOSITION and MPI_CART_SIZE[1] > 1)
+        {
+            std::cerr << "ElasticitySolverSpectralImpl::Initialize()\n"
+                      << "\tNonperiodic boundary conditions in Y-direction are not permitted if Y-direction is decomposed!" << std::endl;
+            OP_Exit(EXIT_FAILURE);
+        }
+#endif
         Grid.TotalNy *= 2;
         Grid.Ny *= 2;
     }
     if(BC.BC0Z != BoundaryConditionTypes::Periodic or
        BC.BCNZ != BoundaryConditionTypes::Periodic)
     {
+#ifdef MPI_PARALLEL
+        if(MPI_3D_DECOMPOSITION and MPI_CART_SIZE[2] > 1)
+        {
+            std::cerr << "ElasticitySolverSpectralImpl::Initialize()\n"
+                      << "\tNonperiodic boundary conditions in Z-direction are not permitted if Z-direction is decomposed!" << std::endl;
+            OP_Exit(EXIT_FAILURE);
+        }
+#endif
         Grid.TotalNz *= 2;
         Grid.Nz *= 2;
     }
@@ -337,15 +320,8 @@ void ElasticitySolverSpectralImpl::Initialize(Settings& locSettings, const Bound
     // Initialize FFTW MPI parallelism
 #ifdef MPI_PARALLEL
     op_fftw_mpi_init();
-
-    ptrdiff_t local_n0      = 0;
-    ptrdiff_t local_0_start = 0;
-
-    size_t SIZE = 2*op_fftw_mpi_local_size_3d(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, OP_MPI_COMM_WORLD,
-                                  &local_n0, &local_0_start);
-#else
-    size_t SIZE = Grid.Nx*Grid.Ny*Grid.Nz2*2;
 #endif
+    size_t SIZE = LocalSize();
 
     // Initialize FFTW OpenMP threads
 #ifdef _OPENMP
@@ -357,77 +333,7 @@ void ElasticitySolverSpectralImpl::Initialize(Settings& locSettings, const Bound
    fftw_plan_with_nthreads(omp_get_max_threads());
 #endif
 
-    // Allocate arrays
-    for(int n = 0; n < 9; n++)
-    {
-        RHSandDefGrad[n] = (double *)fftw_malloc(sizeof(double)*SIZE);
-    }
-    for(int n = 0; n < 3; n++)
-    {
-        UandForce[n] = (double *)fftw_malloc(sizeof(double)*SIZE);
-    }
-
-    // Create FFT plans
-    for(int n = 0; n < 9; n++)
-    {
-        #ifdef MPI_PARALLEL
-        ForwardPlanRHS[n] = op_fftw_mpi_plan_dft_r2c_3d (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, RHSandDefGrad[n],
-                        reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                        OP_MPI_COMM_WORLD,
-                        FFTW_ESTIMATE);
-        #else
-        ForwardPlanRHS[n] = fftw_plan_dft_r2c_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz, RHSandDefGrad[n],
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         FFTW_ESTIMATE);
-        #endif
-    }
-
-    for(int n = 0; n < 9; n++)
-    {
-        #ifdef MPI_PARALLEL
-        BackwardPlanDefGrad[n] = op_fftw_mpi_plan_dft_c2r_3d
-                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         RHSandDefGrad[n],
-                         OP_MPI_COMM_WORLD,
-                         FFTW_ESTIMATE);
-        #else
-        BackwardPlanDefGrad[n] = fftw_plan_dft_c2r_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz,
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         RHSandDefGrad[n],
-                         FFTW_ESTIMATE);
-        #endif
-    }
-
-    for(int n = 0; n < 3; n++)
-    {
-        #ifdef MPI_PARALLEL
-        BackwardPlanU[n] = op_fftw_mpi_plan_dft_c2r_3d
-                            (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             UandForce[n],
-                             OP_MPI_COMM_WORLD,
-                             FFTW_ESTIMATE);
-
-        ForwardPlanForce[n] = op_fftw_mpi_plan_dft_r2c_3d (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, UandForce[n],
-                            reinterpret_cast<fftw_complex*> (UandForce[n]),
-                            OP_MPI_COMM_WORLD,
-                            FFTW_ESTIMATE);
-        #else
-        BackwardPlanU[n] = fftw_plan_dft_c2r_3d
-                            (Grid.Nx, Grid.Ny, Grid.Nz,
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             UandForce[n],
-                             FFTW_ESTIMATE);
-
-        ForwardPlanForce[n] = fftw_plan_dft_r2c_3d
-                            (Grid.Nx, Grid.Ny, Grid.Nz, UandForce[n],
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             FFTW_ESTIMATE);
-        #endif
-    }
+    AllocateFFT(SIZE);
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
 }
@@ -437,103 +343,11 @@ void ElasticitySolverSpectralImpl::Remesh(int newNx, int newNy, int newNz, const
     Grid.SetDimensions(newNx, newNy, newNz);
 
     // Destroy old FFT plans and free allocated memory
-    for(int n = 0; n < 9; n++)
-    {
-        fftw_destroy_plan(ForwardPlanRHS[n]);
-        fftw_destroy_plan(BackwardPlanDefGrad[n]);
-
-        fftw_free(RHSandDefGrad[n]);
-    }
-    for(int n = 0; n < 3; n++)
-    {
-        fftw_destroy_plan(BackwardPlanU[n]);
-        fftw_destroy_plan(ForwardPlanForce[n]);
-
-        fftw_free(UandForce[n]);
-    }
-
-#ifdef MPI_PARALLEL
-
-    ptrdiff_t local_n0      = 0;
-    ptrdiff_t local_0_start = 0;
-
-    size_t SIZE = 2*op_fftw_mpi_local_size_3d(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, OP_MPI_COMM_WORLD,
-                                  &local_n0, &local_0_start);
-#else
-    size_t SIZE = Grid.Nx*Grid.Ny*Grid.Nz2*2;
-#endif
-
-    // Reallocate arrays
-    for(int n = 0; n < 9; n++)
-    {
-        RHSandDefGrad[n] = (double *)fftw_malloc(sizeof(double)*SIZE);
-    }
-    for(int n = 0; n < 3; n++)
-    {
-        UandForce[n] = (double *)fftw_malloc(sizeof(double)*SIZE);
-    }
-
-    // Create new FFT plans
-    for(int n = 0; n < 9; n++)
-    {
-        #ifdef MPI_PARALLEL
-        ForwardPlanRHS[n] = op_fftw_mpi_plan_dft_r2c_3d (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, RHSandDefGrad[n],
-                        reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                        OP_MPI_COMM_WORLD,
-                        FFTW_ESTIMATE);
-        #else
-        ForwardPlanRHS[n] = fftw_plan_dft_r2c_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz, RHSandDefGrad[n],
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         FFTW_ESTIMATE);
-        #endif
-    }
+    FreeFFT();
 
-    for(int n = 0; n < 9; n++)
-    {
-        #ifdef MPI_PARALLEL
-        BackwardPlanDefGrad[n] = op_fftw_mpi_plan_dft_c2r_3d
-                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         RHSandDefGrad[n],
-                         OP_MPI_COMM_WORLD,
-                         FFTW_ESTIMATE);
-        #else
-        BackwardPlanDefGrad[n] = fftw_plan_dft_c2r_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz,
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         RHSandDefGrad[n],
-                         FFTW_ESTIMATE);
-        #endif
-    }
+    size_t SIZE = LocalSize();
 
-    for(int n = 0; n < 3; n++)
-    {
-        #ifdef MPI_PARALLEL
-        BackwardPlanU[n] = op_fftw_mpi_plan_dft_c2r_3d
-                            (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             UandForce[n],
-                             OP_MPI_COMM_WORLD,
-                             FFTW_ESTIMATE);
-
-        ForwardPlanForce[n] = op_fftw_mpi_plan_dft_r2c_3d (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, UandForce[n],
-                            reinterpret_cast<fftw_complex*> (UandForce[n]),
-                            OP_MPI_COMM_WORLD,
-                            FFTW_ESTIMATE);
-        #else
-        BackwardPlanU[n] = fftw_plan_dft_c2r_3d
-                            (Grid.Nx, Grid.Ny, Grid.Nz,
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             UandForce[n],
-                             FFTW_ESTIMATE);
-
-        ForwardPlanForce[n] = fftw_plan_dft_r2c_3d
-                            (Grid.Nx, Grid.Ny, Grid.Nz, UandForce[n],
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             FFTW_ESTIMATE);
-        #endif
-    }
+    AllocateFFT(SIZE);
     ConsoleOutput::Write(thisclassname, "Remeshed");
 }
 
@@ -557,12 +371,28 @@ void ElasticitySolverSpectralImpl::Reinitialize(ElasticProperties& EP, const Bou
     if(BC.BC0Y != BoundaryConditionTypes::Periodic or
        BC.BCNY != BoundaryConditionTypes::Periodic)
     {
+#ifdef MPI_PARALLEL
+        if(MPI_3D_DECOMPOSITION and MPI_CART_SIZE[1] > 1)
+        {
+            std::cerr << "ElasticitySolverSpectralImpl::Initialize()\n"
+                      << "\tNonperiodic boundary conditions in Y-direction are not permitted if Y-direction is decomposed!" << std::endl;
+            OP_Exit(EXIT_FAILURE);
+        }
+#endif
         Grid.TotalNy *= 2;
         Grid.Ny *= 2;
     }
     if(BC.BC0Z != BoundaryConditionTypes::Periodic or
        BC.BCNZ != BoundaryConditionTypes::Periodic)
     {
+#ifdef MPI_PARALLEL
+        if(MPI_3D_DECOMPOSITION and MPI_CART_SIZE[2] > 1)
+        {
+            std::cerr << "ElasticitySolverSpectralImpl::Initialize()\n"
+                      << "\tNonperiodic boundary conditions in Z-direction are not permitted if Z-direction is decomposed!" << std::endl;
+            OP_Exit(EXIT_FAILURE);
+        }
+#endif
         Grid.TotalNz *= 2;
         Grid.Nz *= 2;
     }
@@ -570,20 +400,7 @@ void ElasticitySolverSpectralImpl::Reinitialize(ElasticProperties& EP, const Bou
     Grid.Nz2 = Grid.Nz/2 + 1;
 
     // Destroy old FFT plans and free allocated memory
-    for(int n = 0; n < 9; n++)
-    {
-        fftw_destroy_plan(ForwardPlanRHS[n]);
-        fftw_destroy_plan(BackwardPlanDefGrad[n]);
-
-        fftw_free(RHSandDefGrad[n]);
-    }
-    for(int n = 0; n < 3; n++)
-    {
-        fftw_destroy_plan(BackwardPlanU[n]);
-        fftw_destroy_plan(ForwardPlanForce[n]);
-
-        fftw_free(UandForce[n]);
-    }
+    FreeFFT();
 
 #ifdef _OPENMP
     fftw_cleanup_threads();
@@ -598,15 +415,8 @@ void ElasticitySolverSpectralImpl::Reinitialize(ElasticProperties& EP, const Bou
     // Initialize FFTW MPI parallelism
 #ifdef MPI_PARALLEL
     op_fftw_mpi_init();
-
-    ptrdiff_t local_n0      = 0;
-    ptrdiff_t local_0_start = 0;
-
-    size_t SIZE = 2*op_fftw_mpi_local_size_3d(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, OP_MPI_COMM_WORLD,
-                                              &local_n0, &local_0_start);
-#else
-    size_t SIZE = Grid.Nx*Grid.Ny*Grid.Nz2*2;
 #endif
+    size_t SIZE = LocalSize();
 
     //Initialize FFTW OpenMP threads
 #ifdef _OPENMP
@@ -618,84 +428,153 @@ void ElasticitySolverSpectralImpl::Reinitialize(ElasticProperties& EP, const Bou
     fftw_plan_with_nthreads(omp_get_max_threads());
 #endif
 
-    // Reallocate arrays
+    AllocateFFT(SIZE);
+    ConsoleOutput::WriteStandard(thisclassname, "Reinitialized");
+}
+
+size_t ElasticitySolverSpectralImpl::LocalSize(void) const
+{
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
+    {
+        return PencilFFT::LocalSize(Grid);
+    }
+    ptrdiff_t local_n0      = 0;
+    ptrdiff_t local_0_start = 0;
+
+    return 2*op_fftw_mpi_local_size_3d(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, OP_MPI_COMM_WORLD,
+                                       &local_n0, &local_0_start);
+#else
+    return Grid.Nx*Grid.Ny*Grid.Nz2*2;
+#endif
+}
+
+void ElasticitySolverSpectralImpl::AllocateFFT(const size_t SIZE)
+{
+    /* The components are stored one after another in a single array, each
+    padded to SIZE doubles as required by the in-place real to complex
+    transforms. In serial mode all nine RHS/deformation gradient components
+    and all three force/displacement components are transformed by a single
+    batched plan per direction, which passes over the memory and forks the
+    FFTW threads once instead of once per component. The MPI interface of
+    FFTW batches only interleaved components, therefore in MPI parallel mode
+    each component keeps its own plan. With the MPI 3D domain decomposition
+    the local bricks are transformed by PencilFFT, which is not limited to
+    one process per grid cell in X, and the reciprocal space arrays are
+    X-pencils instead of slabs. The arrays are only scratch memory during
+    Solve(), they are borrowed from the FFTWorkspace pool and shared with
+    other spectral solvers of the same size. The serial transforms are done by
+    FFTBackend, which uses FFTW or, if compiled with -DCUFFT, cuFFT. In the
+    latter case the reciprocal space arrays live in device memory and
+    CalculateFourierSolution() runs as an OpenMP target region, only the
+    real space components cross the PCIe bus once per transform. With
+    -DSINGLE_PRECISION_FFT the arrays hold single precision values, all
+    computations using them remain in double precision. */
+
+    const size_t nDoubles = (SIZE*sizeof(fft_real) + sizeof(double) - 1)/sizeof(double);
+    RHSandDefGradData = reinterpret_cast<fft_real*>(FFTWorkspace::Acquire(nDoubles*9, 0));
+    UandForceData     = reinterpret_cast<fft_real*>(FFTWorkspace::Acquire(nDoubles*3, 1));
     for(int n = 0; n < 9; n++)
     {
-        RHSandDefGrad[n] = (double *)fftw_malloc(sizeof(double)*SIZE);
+        RHSandDefGrad[n] = RHSandDefGradData + n*SIZE;
     }
     for(int n = 0; n < 3; n++)
     {
-        UandForce[n] = (double *)fftw_malloc(sizeof(double)*SIZE);
+        UandForce[n] = UandForceData + n*SIZE;
     }
 
-    // Create new FFT plans
-    for(int n = 0; n < 9; n++)
+    FFTWPlanner::ImportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+
+    SpectralN[0] = Grid.Nx;      SpectralOffset[0] = Grid.OffsetX;
+    SpectralN[1] = Grid.Ny;      SpectralOffset[1] = Grid.OffsetY;
+    SpectralN[2] = Grid.Nz2;     SpectralOffset[2] = Grid.OffsetZ;
+    const long int N[3] = {Grid.TotalNx, Grid.TotalNy, Grid.TotalNz};
+
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
     {
-        #ifdef MPI_PARALLEL
-        ForwardPlanRHS[n] = op_fftw_mpi_plan_dft_r2c_3d (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, RHSandDefGrad[n],
-                        reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                        OP_MPI_COMM_WORLD,
-                        FFTW_ESTIMATE);
-        #else
-        ForwardPlanRHS[n] = fftw_plan_dft_r2c_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz, RHSandDefGrad[n],
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         FFTW_ESTIMATE);
-        #endif
+        PencilRHSandDefGrad.Initialize(Grid, 9, RHSandDefGradData, FFTWPlanner::Flags());
+        PencilUandForce.Initialize(Grid, 3, UandForceData, FFTWPlanner::Flags());
+        for(int d = 0; d < 3; d++)
+        {
+            SpectralN[d]      = PencilRHSandDefGrad.SpectralN[d];
+            SpectralOffset[d] = PencilRHSandDefGrad.SpectralOffset[d];
+        }
+        Q.Initialize(N, SpectralN, SpectralOffset);
+        FFTWPlanner::ExportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+        return;
     }
-
+    ForwardPlanRHS.resize(9);
+    BackwardPlanDefGrad.resize(9);
     for(int n = 0; n < 9; n++)
     {
-        #ifdef MPI_PARALLEL
+        ForwardPlanRHS[n] = op_fftw_mpi_plan_dft_r2c_3d
+                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, RHSandDefGrad[n],
+                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
+                         OP_MPI_COMM_WORLD,
+                         FFTWPlanner::Flags());
+
         BackwardPlanDefGrad[n] = op_fftw_mpi_plan_dft_c2r_3d
                         (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
                          reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
                          RHSandDefGrad[n],
                          OP_MPI_COMM_WORLD,
-                         FFTW_ESTIMATE);
-        #else
-        BackwardPlanDefGrad[n] = fftw_plan_dft_c2r_3d
-                        (Grid.Nx, Grid.Ny, Grid.Nz,
-                         reinterpret_cast<fftw_complex*> (RHSandDefGrad[n]),
-                         RHSandDefGrad[n],
-                         FFTW_ESTIMATE);
-        #endif
+                         FFTWPlanner::Flags());
     }
 
+    BackwardPlanU.resize(3);
+    ForwardPlanForce.resize(3);
     for(int n = 0; n < 3; n++)
     {
-        #ifdef MPI_PARALLEL
         BackwardPlanU[n] = op_fftw_mpi_plan_dft_c2r_3d
-                            (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             UandForce[n],
-                             OP_MPI_COMM_WORLD,
-                             FFTW_ESTIMATE);
-
-        ForwardPlanForce[n] = op_fftw_mpi_plan_dft_r2c_3d (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, UandForce[n],
-                            reinterpret_cast<fftw_complex*> (UandForce[n]),
-                            OP_MPI_COMM_WORLD,
-                            FFTW_ESTIMATE);
-        #else
-        BackwardPlanU[n] = fftw_plan_dft_c2r_3d
-                            (Grid.Nx, Grid.Ny, Grid.Nz,
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             UandForce[n],
-                             FFTW_ESTIMATE);
-
-        ForwardPlanForce[n] = fftw_plan_dft_r2c_3d
-                            (Grid.Nx, Grid.Ny, Grid.Nz, UandForce[n],
-                             reinterpret_cast<fftw_complex*> (UandForce[n]),
-                             FFTW_ESTIMATE);
-        #endif
+                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
+                         reinterpret_cast<fftw_complex*> (UandForce[n]),
+                         UandForce[n],
+                         OP_MPI_COMM_WORLD,
+                         FFTWPlanner::Flags());
+
+        ForwardPlanForce[n] = op_fftw_mpi_plan_dft_r2c_3d
+                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, UandForce[n],
+                         reinterpret_cast<fftw_complex*> (UandForce[n]),
+                         OP_MPI_COMM_WORLD,
+                         FFTWPlanner::Flags());
     }
-    ConsoleOutput::WriteStandard(thisclassname, "Reinitialized");
+#else
+    FFTRHSandDefGrad.Initialize(Grid.Nx, Grid.Ny, Grid.Nz, 9, SIZE, RHSandDefGradData, FFTWPlanner::Flags());
+    FFTUandForce.Initialize(Grid.Nx, Grid.Ny, Grid.Nz, 3, SIZE, UandForceData, FFTWPlanner::Flags());
+#endif
+    Q.Initialize(N, SpectralN, SpectralOffset);
+    FFTWPlanner::ExportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+}
+
+void ElasticitySolverSpectralImpl::FreeFFT(void)
+{
+#ifdef MPI_PARALLEL
+    for(std::vector<fftw_plan>* Plans : {&ForwardPlanRHS, &BackwardPlanDefGrad,
+                                         &BackwardPlanU, &ForwardPlanForce})
+    {
+        for(fftw_plan& Plan : *Plans)
+        {
+            fftw_destroy_plan(Plan);
+        }
+        Plans->clear();
+    }
+    PencilRHSandDefGrad.Free();
+    PencilUandForce.Free();
+#else
+    FFTRHSandDefGrad.Free();
+    FFTUandForce.Free();
+#endif
+    FFTWorkspace::Release(reinterpret_cast<double*>(RHSandDefGradData));
+    FFTWorkspace::Release(reinterpret_cast<double*>(UandForceData));
+    RHSandDefGradData = nullptr;
+    UandForceData     = nullptr;
 }
 
 void ElasticitySolverSpectralImpl::ReadInput(const string InputFileName)
 {
     ConsoleOutput::Write("Source", InputFileName);
-    fstream inp(InputFileName.c_str(), ios::in);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File " + InputFileName + " could not be opened",thisclassname, "ReadInput()");
@@ -703,7 +582,6 @@ void ElasticitySolverSpectralImpl::ReadInput(const string InputFileName)
     };
     std::stringstream data;
     data << inp.rdbuf();
-    inp.close();
 
     ReadInput(data);
 }
@@ -720,6 +598,23 @@ void ElasticitySolverSpectralImpl::ReadInput(stringstream& inp)
     IncrementScaling    = FileInterface::ReadParameterD(inp, moduleLocation, "IncrementScaling",    false, IncrementScaling);
     VerboseIterations   = FileInterface::ReadParameterB(inp, moduleLocation, "VerboseIterations",   false, VerboseIterations);
     DiscreteDerivatives = FileInterface::ReadParameterB(inp, moduleLocation, "DiscreteDerivatives", false, DiscreteDerivatives);
+    AndersonDepth       = FileInterface::ReadParameterI(inp, moduleLocation, "AndersonDepth",       false, AndersonDepth);
+    SkipStressTolerance = FileInterface::ReadParameterD(inp, moduleLocation, "SkipStressTolerance", false, SkipStressTolerance);
+    SkipMaxSteps        = FileInterface::ReadParameterI(inp, moduleLocation, "SkipMaxSteps",        false, SkipMaxSteps);
+
+    if(AndersonDepth < 0 or AndersonDepth > AndersonMaxDepth)
+    {
+        ConsoleOutput::WriteExit("AndersonDepth has to be between 0 and " + std::to_string(AndersonMaxDepth),
+                                 thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
+#ifdef SINGLE_PRECISION_FFT
+    if(StrainAccuracy < 1.0e-5)
+    {
+        ConsoleOutput::WriteWarning("StrainAccuracy below 1e-5 may not be reached with single precision FFT",
+                                    thisclassname, "ReadInput()");
+    }
+#endif
 
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteBlankLine();
@@ -731,21 +626,7 @@ ElasticitySolverSpectralImpl::~ElasticitySolverSpectralImpl(void)
 {
     if(initialized)
     {
-        for(int n = 0; n < 9; n++)
-        {
-            fftw_destroy_plan(ForwardPlanRHS[n]);
-            fftw_destroy_plan(BackwardPlanDefGrad[n]);
-
-            fftw_free(RHSandDefGrad[n]);
-        }
-
-        for(int n = 0; n < 3; n++)
-        {
-            fftw_destroy_plan(BackwardPlanU[n]);
-            fftw_destroy_plan(ForwardPlanForce[n]);
-
-            fftw_free(UandForce[n]);
-        }
+        FreeFFT();
 
 #ifdef MPI_PARALLEL
         op_fftw_mpi_cleanup();
@@ -768,11 +649,32 @@ int ElasticitySolverSpectralImpl::Solve(ElasticProperties& EP,
     vStress TargetStress;
     vStrain oldAverageStrain;
 
+    if(SkipSolve(EP))
+    {
+        EP.SetBoundaryConditions(BC);
+        return 0;
+    }
+
     int    IterationsCount = 0;
     double MAXLocalStressDifference = 0.0;
     double MAXLocalStrainDifference = 0.0;
     double MAXAverageStrainDifference = 0.0;
 
+    if(AndersonDepth > 0)
+    {
+        AndersonIteration = 0;
+        if(AndersonHistory.size() != size_t(2 + 2*AndersonDepth) or
+           !AndersonHistory[0].IsSize(EP.Grid.Nx, EP.Grid.Ny, EP.Grid.Nz))
+        {
+            AndersonHistory.clear();
+            AndersonHistory.resize(2 + 2*AndersonDepth);
+            for(Storage3D<dMatrix3x3,0>& History : AndersonHistory)
+            {
+                History.Allocate(EP.Grid, 0);
+            }
+        }
+    }
+
     if (!EP.LargeDeformations)
     {
         for(int n = 0; n < 6; n++)
@@ -938,51 +840,67 @@ void ElasticitySolverSpectralImpl::CalculateFourierSolution(const ElasticPropert
 {
     double Norm = 1.0/double(Grid.TotalNumberOfCells());
 
-    double DPi_Nx = 2.0*Pi/double(Grid.TotalNx);
-    double DPi_Ny = 2.0*Pi/double(Grid.TotalNy);
-    double DPi_Nz = 2.0*Pi/double(Grid.TotalNz);
-
-    #pragma omp parallel for collapse(3)
-    for(int i = 0; i < Grid.Nx ; i++)
-    for(int j = 0; j < Grid.Ny ; j++)
-    for(int k = 0; k < Grid.Nz2; k++)
-    {
-        long int XYZ = k + Grid.Nz2*(j + Grid.Ny*i);
+    /* The loop works on local copies of all parameters and on plain pointers
+    to the reciprocal space arrays, the components are CompSize complex
+    numbers apart. This allows to run it as an OpenMP target region on the
+    device arrays of the cuFFT backend, where the members of this class are
+    not accessible. */
 #ifdef MPI_PARALLEL
-        long int ii = i + Grid.OffsetX;
-        double Qx = DPi_Nx*(ii*(ii <= Grid.TotalNx/2) - (Grid.TotalNx-ii)*(ii > Grid.TotalNx/2));
-        long int jj = j + Grid.OffsetY;
-        double Qy = DPi_Ny*(jj*(jj <= Grid.TotalNy/2) - (Grid.TotalNy-jj)*(jj > Grid.TotalNy/2));
-        long int kk = k + Grid.OffsetZ;
-        double Qz = DPi_Nz*(kk*(kk <= Grid.TotalNz/2) - (Grid.TotalNz-kk)*(kk > Grid.TotalNz/2));
+    complex<fft_real>* rhs = reinterpret_cast<complex<fft_real>*>(RHSandDefGradData);
+    complex<fft_real>* u   = reinterpret_cast<complex<fft_real>*>(UandForceData);
 #else
-        double Qx = DPi_Nx*(i*(i <= Grid.Nx/2) - (Grid.Nx-i)*(i > Grid.Nx/2));
-        double Qy = DPi_Ny*(j*(j <= Grid.Ny/2) - (Grid.Ny-j)*(j > Grid.Ny/2));
-        double Qz = DPi_Nz*(k*(k <= Grid.Nz/2) - (Grid.Nz-k)*(k > Grid.Nz/2));
-
-        if(DiscreteDerivatives)
-        {
-            Qx = sin(Qx);
-            Qy = sin(Qy);
-            Qz = sin(Qz);
-        }
+    complex<fft_real>* rhs = reinterpret_cast<complex<fft_real>*>(FFTRHSandDefGrad.Data());
+    complex<fft_real>* u   = reinterpret_cast<complex<fft_real>*>(FFTUandForce.Data());
 #endif
+    const long int CompSize = LocalSize()/2;
+    const int SNx = SpectralN[0];
+    const int SNy = SpectralN[1];
+    const int SNz = SpectralN[2];
+    /* The wave vector components are read from the tables of Q, the sine
+    variant of DiscreteDerivatives is used in the serial build only.*/
+#ifdef MPI_PARALLEL
+    const double* QX = Q.Axis(0);
+    const double* QY = Q.Axis(1);
+    const double* QZ = Q.Axis(2);
+#else
+    const double* QX = Q.Axis(0, DiscreteDerivatives);
+    const double* QY = Q.Axis(1, DiscreteDerivatives);
+    const double* QZ = Q.Axis(2, DiscreteDerivatives);
+#endif
+    const bool ExternalForces = EP.ConsiderExternalForces;
+    const complex<double> Im(0.0, 1.0);
 
-        complex<double> rhsX = -I*(Qx*reinterpret_cast<complex<double>*>(RHSandDefGrad[0])[XYZ] +
-                                   Qy*reinterpret_cast<complex<double>*>(RHSandDefGrad[1])[XYZ] +
-                                   Qz*reinterpret_cast<complex<double>*>(RHSandDefGrad[2])[XYZ]);
-        complex<double> rhsY = -I*(Qx*reinterpret_cast<complex<double>*>(RHSandDefGrad[3])[XYZ] +
-                                   Qy*reinterpret_cast<complex<double>*>(RHSandDefGrad[4])[XYZ] +
-                                   Qz*reinterpret_cast<complex<double>*>(RHSandDefGrad[5])[XYZ]);
-        complex<double> rhsZ = -I*(Qx*reinterpret_cast<complex<double>*>(RHSandDefGrad[6])[XYZ] +
-                                   Qy*reinterpret_cast<complex<double>*>(RHSandDefGrad[7])[XYZ] +
-                                   Qz*reinterpret_cast<complex<double>*>(RHSandDefGrad[8])[XYZ]);
-
-        if(EP.ConsiderExternalForces)
+#ifdef CUFFT
+    #pragma omp target teams distribute parallel for collapse(3) is_device_ptr(rhs, u) map(to: Cij, QX[0:SNx], QY[0:SNy], QZ[0:SNz])
+#else
+    #pragma omp parallel for collapse(3)
+#endif
+    for(int i = 0; i < SNx; i++)
+    for(int j = 0; j < SNy; j++)
+    for(int k = 0; k < SNz; k++)
+    {
+        long int XYZ = k + SNz*(j + SNy*i);
+        complex<fft_real>* locRHS = rhs + XYZ;
+        complex<fft_real>* locU   = u + XYZ;
+        const double Qx = QX[i];
+        const double Qy = QY[j];
+        const double Qz = QZ[k];
+
+        complex<double> rhsX = -Im*(Qx*complex<double>(locRHS[0*CompSize]) +
+                                    Qy*complex<double>(locRHS[1*CompSize]) +
+                                    Qz*complex<double>(locRHS[2*CompSize]));
+        complex<double> rhsY = -Im*(Qx*complex<double>(locRHS[3*CompSize]) +
+                                    Qy*complex<double>(locRHS[4*CompSize]) +
+                                    Qz*complex<double>(locRHS[5*CompSize]));
+        complex<double> rhsZ = -Im*(Qx*complex<double>(locRHS[6*CompSize]) +
+                                    Qy*complex<double>(locRHS[7*CompSize]) +
+                                    Qz*complex<double>(locRHS[8*CompSize]));
+
+        if(ExternalForces)
         {
-            rhsX += reinterpret_cast<complex<double>*>(UandForce[0])[XYZ];
-            rhsY += reinterpret_cast<complex<double>*>(UandForce[1])[XYZ];
-            rhsZ += reinterpret_cast<complex<double>*>(UandForce[2])[XYZ];
+            rhsX += complex<double>(locU[0*CompSize]);
+            rhsY += complex<double>(locU[1*CompSize]);
+            rhsZ += complex<double>(locU[2*CompSize]);
         }
 
         double a11 = (Cij(0,0)*Qx*Qx + 2.0*Cij(0,5)*Qx*Qy + Cij(5,5)*Qy*Qy +
@@ -1033,19 +951,19 @@ void ElasticitySolverSpectralImpl::CalculateFourierSolution(const ElasticPropert
         complex<double> locUrcZ = (-a22*a31*rhsX + a21*a32*rhsX + a12*a31*rhsY -
                                     a11*a32*rhsY - a12*a21*rhsZ + a11*a22*rhsZ)*denominator*Norm;
 
-        reinterpret_cast<complex<double>*>(UandForce[0])[XYZ] = locUrcX;
-        reinterpret_cast<complex<double>*>(UandForce[1])[XYZ] = locUrcY;
-        reinterpret_cast<complex<double>*>(UandForce[2])[XYZ] = locUrcZ;
-
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[0])[XYZ] = I*(Qx*locUrcX);
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[1])[XYZ] = I*(Qy*locUrcX);
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[2])[XYZ] = I*(Qz*locUrcX);
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[3])[XYZ] = I*(Qx*locUrcY);
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[4])[XYZ] = I*(Qy*locUrcY);
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[5])[XYZ] = I*(Qz*locUrcY);
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[6])[XYZ] = I*(Qx*locUrcZ);
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[7])[XYZ] = I*(Qy*locUrcZ);
-        reinterpret_cast<complex<double>*>(RHSandDefGrad[8])[XYZ] = I*(Qz*locUrcZ);
+        locU[0*CompSize] = complex<fft_real>(locUrcX);
+        locU[1*CompSize] = complex<fft_real>(locUrcY);
+        locU[2*CompSize] = complex<fft_real>(locUrcZ);
+
+        locRHS[0*CompSize] = complex<fft_real>(Im*(Qx*locUrcX));
+        locRHS[1*CompSize] = complex<fft_real>(Im*(Qy*locUrcX));
+        locRHS[2*CompSize] = complex<fft_real>(Im*(Qz*locUrcX));
+        locRHS[3*CompSize] = complex<fft_real>(Im*(Qx*locUrcY));
+        locRHS[4*CompSize] = complex<fft_real>(Im*(Qy*locUrcY));
+        locRHS[5*CompSize] = complex<fft_real>(Im*(Qz*locUrcY));
+        locRHS[6*CompSize] = complex<fft_real>(Im*(Qx*locUrcZ));
+        locRHS[7*CompSize] = complex<fft_real>(Im*(Qy*locUrcZ));
+        locRHS[8*CompSize] = complex<fft_real>(Im*(Qz*locUrcZ));
     }
 }
 
@@ -1091,13 +1009,210 @@ void ElasticitySolverSpectralImpl::CalculateTargetStress(ElasticProperties& EP,
     TargetStress[5] = -EP.AverageStress[5]*(1.0 - EP.AppliedStressMask[5]) + (EP.AppliedStress[5]-EP.AverageStress[5])*EP.AppliedStressMask[5];
 }
 
+void ElasticitySolverSpectralImpl::AndersonMixing(ElasticProperties& EP,
+                                                  const dMatrix3x3& avgDefGrad,
+                                                  double& MAXStrainDifference)
+{
+    /* Anderson acceleration of the fixed-point iteration F -> G(F), where
+    G(F) is the deformation gradient obtained from the spectral solution. With
+    the residual R = G(F) - F and the differences dF, dR of the last m
+    iterations the new deformation gradient is
+
+        F' = F + b*R - sum_n g_n*(dF_n + b*dR_n),
+
+    where g minimizes |R - sum_n g_n*dR_n| over the whole domain and b is the
+    IncrementScaling. Without history (first iteration of each Solve()) this
+    is the plain fixed-point step. Each iteration updates one row of the Gram
+    matrix of the residual differences, thus the cost is two passes over the
+    grid and one reduction of 2*m numbers. The stopping criteria are the same
+    as for the plain iteration, the strain difference is the residual norm.*/
+
+    const int m    = AndersonDepth;
+    const int slot = (AndersonIteration - 1 + m) % m;                           // Slot of the newest differences
+    const int mk   = min(AndersonIteration, m);                                 // Number of valid differences
+
+    Storage3D<dMatrix3x3,0>& prevF = AndersonHistory[0];
+    Storage3D<dMatrix3x3,0>& prevR = AndersonHistory[1];
+    Storage3D<dMatrix3x3,0>* dF    = &AndersonHistory[2];
+    Storage3D<dMatrix3x3,0>* dR    = &AndersonHistory[2 + m];
+
+    double Products[2*AndersonMaxDepth] = {};                                   // <dR_slot,dR_n> followed by <dR_n,R>
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EP.DeformationGradientsTotal,0,reduction(max:MAXStrainDifference) reduction(+:Products))
+    {
+        const long int xyz = k + 2*Grid.Nz2*(j + Grid.Ny*i);
+
+        dMatrix3x3 locDefGrad = avgDefGrad;
+        locDefGrad(0,0) += RHSandDefGrad[0][xyz];
+        locDefGrad(0,1) += RHSandDefGrad[1][xyz];
+        locDefGrad(0,2) += RHSandDefGrad[2][xyz];
+
+        locDefGrad(1,0) += RHSandDefGrad[3][xyz];
+        locDefGrad(1,1) += RHSandDefGrad[4][xyz];
+        locDefGrad(1,2) += RHSandDefGrad[5][xyz];
+
+        locDefGrad(2,0) += RHSandDefGrad[6][xyz];
+        locDefGrad(2,1) += RHSandDefGrad[7][xyz];
+        locDefGrad(2,2) += RHSandDefGrad[8][xyz];
+
+        const dMatrix3x3& locF = EP.DeformationGradientsTotal(i,j,k);
+        const dMatrix3x3  locR = locDefGrad - locF;
+        MAXStrainDifference = max(MAXStrainDifference, locR.norm());
+
+        if(mk > 0)
+        {
+            dF[slot](i,j,k) = locF - prevF(i,j,k);
+            dR[slot](i,j,k) = locR - prevR(i,j,k);
+            for(int n = 0; n < mk; n++)
+            {
+                Products[n]     += dR[slot](i,j,k).double_contract(dR[n](i,j,k));
+                Products[m + n] += dR[n](i,j,k).double_contract(locR);
+            }
+        }
+        prevF(i,j,k) = locF;
+        prevR(i,j,k) = locR;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    double gamma[AndersonMaxDepth] = {};
+    if(mk > 0)
+    {
+#ifdef MPI_PARALLEL
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, Products, 2*m, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+#endif
+        for(int n = 0; n < mk; n++)
+        {
+            AndersonGram[slot][n] = Products[n];
+            AndersonGram[n][slot] = Products[n];
+        }
+
+        // Solves the (regularized) normal equations by Gaussian elimination
+        double A[AndersonMaxDepth][AndersonMaxDepth + 1];
+        double trace = 0.0;
+        for(int n = 0; n < mk; n++)
+        {
+            trace += AndersonGram[n][n];
+        }
+        for(int n = 0; n < mk; n++)
+        {
+            for(int l = 0; l < mk; l++)
+            {
+                A[n][l] = AndersonGram[n][l];
+            }
+            A[n][n] += 1.0e-10*trace/mk + DBL_MIN;
+            A[n][mk] = Products[m + n];
+        }
+        for(int n = 0; n < mk; n++)
+        {
+            int pivot = n;
+            for(int l = n + 1; l < mk; l++)
+            if(std::abs(A[l][n]) > std::abs(A[pivot][n]))
+            {
+                pivot = l;
+            }
+            std::swap(A[n], A[pivot]);
+            for(int l = n + 1; l < mk; l++)
+            {
+                const double factor = A[l][n]/A[n][n];
+                for(int c = n; c <= mk; c++)
+                {
+                    A[l][c] -= factor*A[n][c];
+                }
+            }
+        }
+        for(int n = mk - 1; n >= 0; n--)
+        {
+            gamma[n] = A[n][mk];
+            for(int l = n + 1; l < mk; l++)
+            {
+                gamma[n] -= A[n][l]*gamma[l];
+            }
+            gamma[n] /= A[n][n];
+        }
+    }
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EP.DeformationGradientsTotal,0,)
+    {
+        dMatrix3x3 locF = prevF(i,j,k) + prevR(i,j,k)*IncrementScaling;
+        for(int n = 0; n < mk; n++)
+        {
+            locF -= (dF[n](i,j,k) + dR[n](i,j,k)*IncrementScaling)*gamma[n];
+        }
+        EP.DeformationGradientsTotal(i,j,k) = locF;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    AndersonIteration++;
+}
+
+bool ElasticitySolverSpectralImpl::SkipSolve(ElasticProperties& EP)
+{
+    /* The deformation gradients of the last solve are the initial guess of
+    the next one. If the eigenstrains and elastic constants changed only
+    slightly since then, the stresses they produce with these deformation
+    gradients differ by less than SkipStressTolerance from the stresses of
+    the last solve and the solve is skipped, only the local stresses are
+    updated. At most SkipMaxSteps consecutive solves are skipped, which
+    bounds the accumulated error. Applied strain rates, external forces and
+    large deformations always require a solve.*/
+
+    bool skip = SkipStressTolerance > 0.0 and SkippedSteps < SkipMaxSteps and
+                not EP.LargeDeformations and not EP.ConsiderExternalForces;
+    for(int n = 0; n < 6; n++)
+    if(EP.AppliedStrainRateMask[n] and EP.AppliedStrainRate[n] != 0.0)
+    {
+        skip = false;
+    }
+
+    if(skip)
+    {
+        double MAXStressChange = 0.0;
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EP.Stresses,0,reduction(max:MAXStressChange))
+        {
+            vStress locStress = EP.EffectiveElasticConstants(i,j,k)*EP.ElasticStrains(i,j,k);
+            MAXStressChange = max(MAXStressChange, (EP.Stresses(i,j,k) - locStress).norm());
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE,&MAXStressChange,1,OP_MPI_DOUBLE,OP_MPI_MAX,OP_MPI_COMM_WORLD);
+#endif
+        skip = MAXStressChange < SkipStressTolerance;
+    }
+
+    if(not skip)
+    {
+        SkippedSteps = 0;
+        return false;
+    }
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EP.Stresses,0,)
+    {
+        EP.Stresses(i,j,k) = EP.EffectiveElasticConstants(i,j,k)*EP.ElasticStrains(i,j,k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    SkippedSteps++;
+    if(VerboseIterations)
+    {
+        ConsoleOutput::WriteWithinMethod("Solve skipped, stresses changed less than SkipStressTolerance",
+                                         thisclassname, "Solve()");
+    }
+    return true;
+}
+
 void ElasticitySolverSpectralImpl::SetElasticProperties(ElasticProperties& EP,
                                                     double& MAXStrainDifference,
                                                     double& MAXStressDifference)
 {
     const dMatrix3x3 avgDefGrad = EP.AverageDeformationGradient(StrainAccuracy*0.1);
 
+    if(AndersonDepth > 0)
+    {
+        AndersonMixing(EP, avgDefGrad, MAXStrainDifference);
+    }
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EP.DeformationGradientsTotal,0,reduction(max:MAXStrainDifference) reduction(max:MAXStressDifference) )
+    if(AndersonDepth == 0)
     {
         const long int xyz = k + 2*Grid.Nz2*(j + Grid.Ny*i);
 
@@ -1123,7 +1238,8 @@ void ElasticitySolverSpectralImpl::SetElasticProperties(ElasticProperties& EP,
         }
 
         EP.DeformationGradientsTotal(i,j,k) += locDefGradDelta;
-
+    }
+    {
         vStress locStress = EP.EffectiveElasticConstants(i,j,k)*EP.ElasticStrains(i,j,k);
         MAXStressDifference = max(MAXStressDifference, (EP.Stresses(i,j,k) - locStress).norm());
 
@@ -1141,42 +1257,74 @@ void ElasticitySolverSpectralImpl::SetElasticProperties(ElasticProperties& EP,
 
 void ElasticitySolverSpectralImpl::ExecuteForwardFFT(void)
 {
-    fftw_execute(ForwardPlanRHS[0]);
-    fftw_execute(ForwardPlanRHS[1]);
-    fftw_execute(ForwardPlanRHS[2]);
-    fftw_execute(ForwardPlanRHS[3]);
-    fftw_execute(ForwardPlanRHS[4]);
-    fftw_execute(ForwardPlanRHS[5]);
-    fftw_execute(ForwardPlanRHS[6]);
-    fftw_execute(ForwardPlanRHS[7]);
-    fftw_execute(ForwardPlanRHS[8]);
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
+    {
+        PencilRHSandDefGrad.Forward();
+        return;
+    }
+    for(fftw_plan& Plan : ForwardPlanRHS)
+    {
+        fftw_execute(Plan);
+    }
+#else
+    FFTRHSandDefGrad.CopyToDevice(0, 9);
+    FFTRHSandDefGrad.Forward();
+#endif
 }
 
 void ElasticitySolverSpectralImpl::ExecuteBackwardFFT(void)
 {
-    fftw_execute(BackwardPlanDefGrad[0]);
-    fftw_execute(BackwardPlanDefGrad[1]);
-    fftw_execute(BackwardPlanDefGrad[2]);
-    fftw_execute(BackwardPlanDefGrad[3]);
-    fftw_execute(BackwardPlanDefGrad[4]);
-    fftw_execute(BackwardPlanDefGrad[5]);
-    fftw_execute(BackwardPlanDefGrad[6]);
-    fftw_execute(BackwardPlanDefGrad[7]);
-    fftw_execute(BackwardPlanDefGrad[8]);
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
+    {
+        PencilRHSandDefGrad.Backward();
+        return;
+    }
+    for(fftw_plan& Plan : BackwardPlanDefGrad)
+    {
+        fftw_execute(Plan);
+    }
+#else
+    FFTRHSandDefGrad.Backward();
+    FFTRHSandDefGrad.CopyToHost(0, 9);
+#endif
 }
 
 void ElasticitySolverSpectralImpl::ExecuteBackwardFFTdisplacements(void)
 {
-    fftw_execute(BackwardPlanU[0]);
-    fftw_execute(BackwardPlanU[1]);
-    fftw_execute(BackwardPlanU[2]);
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
+    {
+        PencilUandForce.Backward();
+        return;
+    }
+    for(fftw_plan& Plan : BackwardPlanU)
+    {
+        fftw_execute(Plan);
+    }
+#else
+    FFTUandForce.Backward();
+    FFTUandForce.CopyToHost(0, 3);
+#endif
 }
 
 void ElasticitySolverSpectralImpl::ExecuteForwardFFTforces(void)
 {
-    fftw_execute(ForwardPlanForce[0]);
-    fftw_execute(ForwardPlanForce[1]);
-    fftw_execute(ForwardPlanForce[2]);
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
+    {
+        PencilUandForce.Forward();
+        return;
+    }
+    for(fftw_plan& Plan : ForwardPlanForce)
+    {
+        fftw_execute(Plan);
+    }
+#else
+    FFTUandForce.CopyToDevice(0, 3);
+    FFTUandForce.Forward();
+#endif
 }
 
 void ElasticitySolverSpectralImpl::CopyForceDensity(ElasticProperties& EP)
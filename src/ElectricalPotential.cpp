@@ -25,6 +25,8 @@
  */
 
 #include "ElectricalPotential.h"
+#include "FFTWPlanner.h"
+#include "FFTWorkspace.h"
 #include "Composition.h"
 #include "PhaseField.h"
 #include "Settings.h"
@@ -42,15 +44,12 @@ ElectricalPotential::~ElectricalPotential()
         //fftw_free(ftPotential);
         //fftw_free(RHS);
         //fftw_free(rlPotential);
-        delete[] ftRHS;
-        delete[] ftPotential;
-        delete[] RHS;
-        delete[] rlPotential;
-        fftw_destroy_plan(ForwardPlan);
-        fftw_destroy_plan(BackwardPlan);
-        delete[] Q[0];
-        delete[] Q[1];
-        delete[] Q[2];
+        FFTWorkspace::Release(RHS);
+        FFTWorkspace::Release(reinterpret_cast<double*>(ftRHS));
+        FFTWorkspace::Release(reinterpret_cast<double*>(ftPotential));
+        FFTWorkspace::Release(rlPotential);
+        FFTWPlanner::ReleasePlan(ForwardPlan);
+        FFTWPlanner::ReleasePlan(BackwardPlan);
 
 #ifdef MPI_PARALLEL
         op_fftw_mpi_cleanup();
@@ -88,18 +87,17 @@ void ElectricalPotential::Initialize(Settings& locSettings, std::string ObjectNa
     Ncomp   = locSettings.Ncomp;
     Nphases = locSettings.Nphases;
 
-    Q[0] = new double[ftSize];
-    Q[1] = new double[ftSize];
-    Q[2] = new double[ftSize];
     QXYZ();
 
-    ftRHS       = new complex<double>[ftSize];
-    ftPotential = new complex<double>[ftSize];
-    RHS         = new double[Size];
-    rlPotential = new double[Size];
+    RHS         = FFTWorkspace::Acquire(Size, 0);
+    ftRHS       = reinterpret_cast<complex<double>*>(FFTWorkspace::Acquire(2*ftSize, 1));
+    ftPotential = reinterpret_cast<complex<double>*>(FFTWorkspace::Acquire(2*ftSize, 2));
+    rlPotential = FFTWorkspace::Acquire(Size, 3);
 
-    ForwardPlan  = fftw_plan_dft_r2c_3d(Grid.Nx, Grid.Ny, Grid.Nz, RHS,reinterpret_cast<fftw_complex*> (ftRHS),FFTW_ESTIMATE);
-    BackwardPlan = fftw_plan_dft_c2r_3d(Grid.Nx, Grid.Ny, Grid.Nz, reinterpret_cast<fftw_complex*> (ftPotential), rlPotential, FFTW_ESTIMATE);
+    FFTWPlanner::ImportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+    ForwardPlan  = FFTWPlanner::PlanR2C(Grid.Nx, Grid.Ny, Grid.Nz, RHS, reinterpret_cast<fftw_complex*> (ftRHS));
+    BackwardPlan = FFTWPlanner::PlanC2R(Grid.Nx, Grid.Ny, Grid.Nz, reinterpret_cast<fftw_complex*> (ftPotential), rlPotential);
+    FFTWPlanner::ExportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
 
 //    PotentialDataDir     = "PotentialData/";
 //    int ignore = system(string("mkdir " + PotentialDataDir).c_str());
@@ -121,7 +119,7 @@ void ElectricalPotential::ReadInput(string InputFileName)
     ConsoleOutput::WriteLineInsert("ElectricalPotential input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -133,7 +131,6 @@ void ElectricalPotential::ReadInput(string InputFileName)
     data << inp.rdbuf();
     ReadInput(data);
 
-    inp.close();
 }
 
 void ElectricalPotential::ReadInput(stringstream& inp)
@@ -276,21 +273,10 @@ void ElectricalPotential::CalculateElectrodeInterfaceVolumes(const PhaseField& P
 
 void ElectricalPotential::QXYZ(void)
 {
-    double DPi_nX = 2.0*Pi/double(Grid.Nx);
-    double DPi_nY = 2.0*Pi/double(Grid.Ny);
-    double DPi_nZ = 2.0*Pi/double(Grid.Nz);
-
-    ///copied from the spectral solver
-    for(int i = 0; i < Grid.Nx ; i++)
-    for(int j = 0; j < Grid.Ny ; j++)
-    for(int k = 0; k < Grid.Nz2; k++)
-    {
-         int XYZ = k + Grid.Nz2*(j + Grid.Ny*i);
-
-         Q[0][XYZ] = DPi_nX*(i*(i <= Grid.Nx/2) - (Grid.Nx-i)*(i > Grid.Nx/2))/Grid.dx;
-         Q[1][XYZ] = DPi_nY*(j*(j <= Grid.Ny/2) - (Grid.Ny-j)*(j > Grid.Ny/2))/Grid.dx;
-         Q[2][XYZ] = DPi_nZ*(k*(k <= Grid.Nz/2) - (Grid.Nz-k)*(k > Grid.Nz/2))/Grid.dx;
-    }
+    const long int N[3] = {Grid.Nx, Grid.Ny, Grid.Nz};
+    const int SpectralN[3] = {Grid.Nx, Grid.Ny, Grid.Nz2};
+    const int Offset[3] = {0, 0, 0};
+    Q.Initialize(N, SpectralN, Offset, 1.0/Grid.dx);
 }
 
 void ElectricalPotential::Solve(PhaseField& Phase, Composition& Cx, BoundaryConditions& BC)
@@ -305,18 +291,14 @@ void ElectricalPotential::Solve(PhaseField& Phase, Composition& Cx, BoundaryCond
 
     fftw_execute(ForwardPlan);
 
-    for(int XYZ = 0; XYZ < ftSize; XYZ++)
+    #pragma omp parallel for collapse(2)
+    for(int i = 0; i < Grid.Nx ; i++)
+    for(int j = 0; j < Grid.Ny ; j++)
+    for(int k = 0; k < Grid.Nz2; k++)
     {
         /// ^phi = - ^rho / (i*q*i*q)
-        double Q_sqr = Q[0][XYZ]*Q[0][XYZ] + Q[1][XYZ]*Q[1][XYZ] + Q[2][XYZ]*Q[2][XYZ];
-        if (Q_sqr == 0)
-        {
-            ftPotential[XYZ] = 0.0;
-        }
-        else
-        {
-            ftPotential[XYZ] = ftRHS[XYZ] / Q_sqr * EpsInv;
-        }
+        const int XYZ = k + Grid.Nz2*(j + Grid.Ny*i);
+        ftPotential[XYZ] = - ftRHS[XYZ] * Q.InverseLaplacian(i,j,k) * EpsInv;
     }
 
     fftw_execute(BackwardPlan);
@@ -354,4 +336,9 @@ void ElectricalPotential::WritePotentialVTK(const int tStep, const Settings& loc
     VTK::Write(Filename, locSettings, ListOfFields);
 }  //  WriteVTK
 
+size_t ElectricalPotential::AllocatedMemory(void) const
+{
+    return Potential.AllocatedMemory();
+}
+
 }
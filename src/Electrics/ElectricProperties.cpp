@@ -100,7 +100,7 @@ void ElectricProperties::CalculateChargeDensity(const Composition& Cx)
         ChargeDensity(i,j,k) = 0.0;
         for(size_t comp = 0; comp < Ncomp; comp++)
         {
-            const double MolarComponentDensity = Cx.MoleFractionsTotal(i,j,k,{comp})*Cx.PT.GetData(Cx.Component[comp].Name).MolarVolume;
+            const double MolarComponentDensity = Cx.MoleFractionsTotal(i,j,k,{comp})*Cx.MolarVolume({comp});
             ChargeDensity(i,j,k) += MolarCharge[comp] * MolarComponentDensity;
         }
     }
@@ -138,4 +138,13 @@ void ElectricProperties::WriteVTK(const Settings& locSettings, const int tStep,
     VTK::Write(Filename, locSettings, ListOfFields);
 }
 
+size_t ElectricProperties::AllocatedMemory(void) const
+{
+    return PolarizationDensity.AllocatedMemory() +
+           ElectricField.AllocatedMemory() +
+           WaveVector.AllocatedMemory() +
+           ElectricPotential.AllocatedMemory() +
+           ChargeDensity.AllocatedMemory();
+}
+
 }// end of namespace openphase
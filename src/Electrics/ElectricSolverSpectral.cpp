@@ -27,6 +27,8 @@
 #include "Settings.h"
 #include "Electrics/ElectricProperties.h"
 #include "Electrics/ElectricSolverSpectral.h"
+#include "FFTWPlanner.h"
+#include "FFTWorkspace.h"
 #include <complex>
 
 namespace openphase
@@ -48,11 +50,18 @@ void ElectricSolverSpectral::Initialize(Settings& locSettings, std::string Objec
     Nz2 = locSettings.Grid.Nz/2+1;
     rlSize = Grid.Nx*Grid.Ny*Grid.Nz;
     ftSize = Grid.Nx*Grid.Ny*Nz2;
-    freq = new fftw_complex [ftSize];
-    rhs = new double [rlSize];
+    rhs  = FFTWorkspace::Acquire(rlSize, 0);
+    freq = reinterpret_cast<fftw_complex*>(FFTWorkspace::Acquire(2*ftSize, 1));
 
-    ForwardPlan  = fftw_plan_dft_r2c_3d(Grid.Nx, Grid.Ny, Grid.Nz, rhs, freq, FFTW_ESTIMATE);
-    BackwardPlan = fftw_plan_dft_c2r_3d(Grid.Nx, Grid.Ny, Grid.Nz, freq, rhs, FFTW_ESTIMATE);
+    FFTWPlanner::ImportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+    ForwardPlan  = FFTWPlanner::PlanR2C(Grid.Nx, Grid.Ny, Grid.Nz, rhs, freq);
+    BackwardPlan = FFTWPlanner::PlanC2R(Grid.Nx, Grid.Ny, Grid.Nz, freq, rhs);
+    FFTWPlanner::ExportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+
+    const long int N[3] = {Grid.TotalNx, Grid.TotalNy, Grid.TotalNz};
+    const int SpectralN[3] = {Grid.Nx, Grid.Ny, int(Nz2)};
+    const int Offset[3] = {Grid.OffsetX, Grid.OffsetY, Grid.OffsetZ};
+    Q.Initialize(N, SpectralN, Offset, 1.0/Grid.dx);
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -60,11 +69,11 @@ void ElectricSolverSpectral::Initialize(Settings& locSettings, std::string Objec
 
 ElectricSolverSpectral::~ElectricSolverSpectral()
 {
-    delete [] freq;
-    delete [] rhs;
+    FFTWorkspace::Release(reinterpret_cast<double*>(freq));
+    FFTWorkspace::Release(rhs);
 
-    fftw_destroy_plan(ForwardPlan);
-    fftw_destroy_plan(BackwardPlan);
+    FFTWPlanner::ReleasePlan(ForwardPlan);
+    FFTWPlanner::ReleasePlan(BackwardPlan);
 }
 
 void ElectricSolverSpectral::ReadInput(const std::string InputFileName)
@@ -94,10 +103,6 @@ void ElectricSolverSpectral::ReadInput(std::stringstream& inp)
 
 void  ElectricSolverSpectral::Solve(ElectricProperties& EP, BoundaryConditions& BC)
 {
-    const double Lx = Grid.TotalNx*Grid.dx;
-    const double Ly = Grid.TotalNy*Grid.dx;
-    const double Lz = Grid.TotalNz*Grid.dx;
-
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EP.ChargeDensity,0,)
     {
         rhs[rlidx(i,j,k)] = - EP.ChargeDensity(i,j,k)/PhysicalConstants::epsilon_0;
@@ -106,40 +111,16 @@ void  ElectricSolverSpectral::Solve(ElectricProperties& EP, BoundaryConditions&
 
     fftw_execute(ForwardPlan);
 
+    #pragma omp parallel for collapse(2)
     for (long int i = 0; i < Grid.Nx; i++)
     for (long int j = 0; j < Grid.Ny; j++)
     for (long int k = 0; k < Nz2; k++)
     {
-        const long int ii = Grid.OffsetX + i;
-        const long int jj = Grid.OffsetY + j;
-        const long int kk = Grid.OffsetZ + k;
-
-        assert(ii < Grid.TotalNx);
-        assert(jj < Grid.TotalNy);
-        assert(kk < Grid.TotalNz);
-
-        const double ni = (ii <= Grid.TotalNx/2) ? ii : ii - Grid.TotalNx;
-        const double nj = (jj <= Grid.TotalNy/2) ? jj : jj - Grid.TotalNy;
-        const double nk = kk;
-
-        const double Qx = 2.0*Pi*ni/Lx;
-        const double Qy = 2.0*Pi*nj/Ly;
-        const double Qz = 2.0*Pi*nk/Lz;
-
-        const double QQ = Qx*Qx + Qy*Qy + Qz*Qz;
-
         const size_t XYZ = k + Nz2*(j + Grid.Ny*i);
-        assert( XYZ < ftSize ); 
-        if (QQ == 0.0)
-        {
-            freq[XYZ][0] = 0.0;
-            freq[XYZ][1] = 0.0;
-        }
-        else
-        {
-            freq[XYZ][0] /= -QQ;
-            freq[XYZ][1] /= -QQ;
-        }
+        assert( XYZ < ftSize );
+        const double Green = Q.InverseLaplacian(i,j,k);
+        freq[XYZ][0] *= Green;
+        freq[XYZ][1] *= Green;
     }
 
     fftw_execute(BackwardPlan);
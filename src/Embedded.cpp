@@ -0,0 +1,154 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "Embedded.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace openphase
+{
+using namespace std;
+
+/* Registered inputs and sinks, shared by all simulations of the process and
+protected by Mutex */
+struct EmbeddedState
+{
+    mutex Mutex;
+    atomic<bool> Active{false};
+    unordered_map<string, shared_ptr<const string>> Inputs;
+    shared_ptr<const Embedded::FieldSink_t> FieldSink;
+    shared_ptr<const Embedded::FileSink_t> FileSink;
+};
+
+static EmbeddedState& State(void)
+{
+    static EmbeddedState S;
+    return S;
+}
+
+void Embedded::Enable(void)
+{
+    State().Active = true;
+}
+
+void Embedded::Disable(void)
+{
+    State().Active = false;
+}
+
+bool Embedded::Active(void)
+{
+    return State().Active;
+}
+
+void Embedded::SetInput(const string& FileName, const string& Text)
+{
+    EmbeddedState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    S.Inputs[FileName] = make_shared<const string>(Text);
+}
+
+void Embedded::SetJSON(const string& FileName, const json& Data)
+{
+    SetInput(FileName, Data.dump());
+}
+
+void Embedded::RemoveInput(const string& FileName)
+{
+    EmbeddedState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    S.Inputs.erase(FileName);
+}
+
+void Embedded::ClearInputs(void)
+{
+    EmbeddedState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    S.Inputs.clear();
+}
+
+bool Embedded::GetInput(const string& FileName, string& Text)
+{
+    shared_ptr<const string> Input;
+    {
+        EmbeddedState& S = State();
+        lock_guard<mutex> lock(S.Mutex);
+        auto it = S.Inputs.find(FileName);
+        if(it == S.Inputs.end()) return false;
+        Input = it->second;
+    }
+    Text = *Input;
+    return true;
+}
+
+void Embedded::SetFieldSink(FieldSink_t Sink)
+{
+    EmbeddedState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    S.FieldSink = Sink ? make_shared<const FieldSink_t>(std::move(Sink)) : nullptr;
+}
+
+void Embedded::SetFileSink(FileSink_t Sink)
+{
+    EmbeddedState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    S.FileSink = Sink ? make_shared<const FileSink_t>(std::move(Sink)) : nullptr;
+}
+
+bool Embedded::WriteFields(const string& FileName, const vector<OutputField>& Fields,
+                           const long int Nx, const long int Ny, const long int Nz)
+{
+    EmbeddedState& S = State();
+    if(not S.Active) return false;
+
+    /* The sink is called without holding the lock, it may take long and
+    several simulations may write concurrently */
+    shared_ptr<const FieldSink_t> Sink;
+    {
+        lock_guard<mutex> lock(S.Mutex);
+        Sink = S.FieldSink;
+    }
+    if(Sink) (*Sink)(FileName, Fields, Nx, Ny, Nz);
+    return true;
+}
+
+bool Embedded::WriteFile(const string& FileName, const string& Data, const bool Append)
+{
+    EmbeddedState& S = State();
+    if(not S.Active) return false;
+
+    shared_ptr<const FileSink_t> Sink;
+    {
+        lock_guard<mutex> lock(S.Mutex);
+        Sink = S.FileSink;
+    }
+    if(Sink) (*Sink)(FileName, Data, Append);
+    return true;
+}
+
+}// namespace openphase
@@ -93,6 +93,8 @@ void EquilibriumPartitionDiffusionBinary::Initialize(Settings& locSettings,
     Tcross.Allocate({Nphases, Nphases});
     Ccross.Allocate({Nphases, Nphases});
     Slope.Allocate({Nphases, Nphases});
+    InvSlope.Allocate({Nphases, Nphases});
+    Partitioning.Allocate({Nphases, Nphases});
 
     IDC.resize(Nphases,1.0);
     DC.resize(Nphases,0.0);
@@ -147,7 +149,7 @@ void EquilibriumPartitionDiffusionBinary::ReadInput(const string InputFileName)
     ConsoleOutput::WriteLineInsert("EquilibriumPartitionDiffusionBinary input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -162,7 +164,6 @@ void EquilibriumPartitionDiffusionBinary::ReadInput(const string InputFileName)
     data << inp.rdbuf();
     ReadInput(data);
 
-    inp.close();
 }
 
 void EquilibriumPartitionDiffusionBinary::ReadInput(stringstream& inp)
@@ -239,6 +240,7 @@ void EquilibriumPartitionDiffusionBinary::ReadInput(stringstream& inp)
     {
         Slope({n, n}) = 1.0;
     }
+    SetPhaseDiagramTables();
 
     string tmp1 = FileInterface::ReadParameterK(inp, moduleLocation, string("DiffusionStencil"), false, string("ISOTROPIC"));
     if(tmp1 == "SIMPLE")
@@ -343,15 +345,24 @@ double EquilibriumPartitionDiffusionBinary::ReportMaximumTimeStep(Temperature& T
     return max_dt;
 }
 
+void EquilibriumPartitionDiffusionBinary::SetPhaseDiagramTables(void)
+{
+    /* The phase diagram is temperature independent apart from the linear
+    equilibrium lines, therefore the divisions by the slopes are done once
+    here instead of for every phase pair in every interface cell.*/
+    for(size_t n = 0; n < Nphases; ++n)
+    for(size_t m = 0; m < Nphases; ++m)
+    {
+        InvSlope({n, m}) = (Slope({n, m}) != 0.0) ? 1.0/Slope({n, m}) : 0.0;
+        Partitioning({n, m}) = (Slope({m, n}) != 0.0) ? fabs(Slope({n, m})/Slope({m, n})) : 0.0;
+    }
+}
+
 double EquilibriumPartitionDiffusionBinary::EquilibriumComposition(size_t n,
                                                                    size_t m,
                                                                    double Temp)
 {
-    double eqC = Ccross({n, m});
-    if(Slope({n, m}) != 0.0)
-    {
-        eqC += (Temp - Tcross({n, m}))/Slope({n, m});
-    }
+    double eqC = Ccross({n, m}) + (Temp - Tcross({n, m}))*InvSlope({n, m});
     eqC = std::clamp(eqC, 0.0, 1.0);
     return eqC;
 }
@@ -359,12 +370,7 @@ double EquilibriumPartitionDiffusionBinary::EquilibriumComposition(size_t n,
 double EquilibriumPartitionDiffusionBinary::PartitioningCoefficient(size_t n,
                                                                     size_t m)
 {
-    double pt_coefficient = 0.0;
-    if(Slope({m, n}) != 0.0)
-    {
-        pt_coefficient = fabs(Slope({n, m}) / Slope({m, n}));
-    }
-    return pt_coefficient;
+    return Partitioning({n, m});
 }
 
 void EquilibriumPartitionDiffusionBinary::CalculateLocalPhaseConcentrations(
@@ -383,7 +389,9 @@ void EquilibriumPartitionDiffusionBinary::CalculateLocalPhaseConcentrations(
     }
     else
     {
-        vector<double> partitioning_reduction(Nphases, 0.0);
+        /* Reused per thread to avoid a heap allocation in every interface cell*/
+        static thread_local vector<double> partitioning_reduction;
+        partitioning_reduction.assign(Nphases, 0.0);
         bool iterate = false;
 
         size_t MaxIterations = 10;
@@ -400,10 +408,11 @@ void EquilibriumPartitionDiffusionBinary::CalculateLocalPhaseConcentrations(
             {
                 double eqCx    = 0.0;
                 double divisor = 0.0;
+                const double locT = Tx(i,j,k);
                 for(size_t m = 0; m < Nphases; ++m)
                 if(n != m and Phase.Fractions(i,j,k,{m}) != 0.0)
                 {
-                    eqCx += Phase.Fractions(i,j,k,{m})*EquilibriumComposition(n,m,Tx(i,j,k))*(1.0 - partitioning_reduction[n]);
+                    eqCx += Phase.Fractions(i,j,k,{m})*EquilibriumComposition(n,m,locT)*(1.0 - partitioning_reduction[n]);
                     if(partitioning_reduction[n] > DBL_EPSILON)
                     {
                         eqCx += Phase.Fractions(i,j,k,{m})*Cx.MoleFractionsTotal(i,j,k,{Comp})*partitioning_reduction[n];
@@ -533,9 +542,15 @@ void EquilibriumPartitionDiffusionBinary::CalculateDrivingForce(PhaseField& Phas
                                                                 Temperature& Tx,
                                                                 DrivingForce& dG)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cx.MoleFractionsTotal,0,)
+    /* Only the interface cells contribute to the driving force. The interface
+    cell list also contains halo cells within Phase.HaloReach(), they are
+    skipped here as in the storage loop over the interior.*/
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCells,)
     {
-        if(Phase.Fields(i,j,k).interface())
+        if(i >= 0 and i < Cx.MoleFractionsTotal.sizeX() and
+           j >= 0 and j < Cx.MoleFractionsTotal.sizeY() and
+           k >= 0 and k < Cx.MoleFractionsTotal.sizeZ() and
+           Phase.Fields(i,j,k).interface())
         {
             CalculateLocalPhaseConcentrations(Phase, Cx, Tx, i, j, k);
 
@@ -611,7 +626,12 @@ void EquilibriumPartitionDiffusionBinary::CalculateDrivingForce(PhaseField& Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+}
+
+size_t EquilibriumPartitionDiffusionBinary::AllocatedMemory(void) const
+{
+    return dMu.AllocatedMemory();
 }
 
 void EquilibriumPartitionDiffusionBinary::Remesh(int newNx,
@@ -682,7 +702,7 @@ void EquilibriumPartitionDiffusionBinary::CalculateInterfaceMobility(PhaseField&
     {
         case Resolutions::Single:
         {
-            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,IP.Properties,0,)
+            OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCells,)
             {
                 if(Phase.Fields(i,j,k).wide_interface())
                 {
@@ -702,12 +722,12 @@ void EquilibriumPartitionDiffusionBinary::CalculateInterfaceMobility(PhaseField&
                     }
                 }
             }
-            OMP_PARALLEL_STORAGE_LOOP_END
+            OMP_PARALLEL_CELL_LIST_LOOP_END
             break;
         }
         case Resolutions::Dual:
         {
-            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,IP.PropertiesDR,0,)
+            OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCellsDR,)
             {
                 if(Phase.FieldsDR(i,j,k).wide_interface())
                 {
@@ -727,7 +747,7 @@ void EquilibriumPartitionDiffusionBinary::CalculateInterfaceMobility(PhaseField&
                     }
                 }
             }
-            OMP_PARALLEL_STORAGE_LOOP_END
+            OMP_PARALLEL_CELL_LIST_LOOP_END
             IP.SetBoundaryConditionsDR(BC);
             IP.Coarsen(Phase);
             break;
@@ -741,9 +761,12 @@ void EquilibriumPartitionDiffusionBinary::CalculateAntitrappingIncrements(PhaseF
 {
     const double coef = Phase.Grid.Eta/Pi;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cx.MoleFractionsTotal,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCells,)
     {
-        if(Phase.Fields(i,j,k).interface())
+        if(i >= 0 and i < Cx.MoleFractionsTotal.sizeX() and
+           j >= 0 and j < Cx.MoleFractionsTotal.sizeY() and
+           k >= 0 and k < Cx.MoleFractionsTotal.sizeZ() and
+           Phase.Fields(i,j,k).interface())
         {
             for(auto ds = DStencil.begin(); ds != DStencil.end(); ds++)
             {
@@ -814,35 +837,63 @@ void EquilibriumPartitionDiffusionBinary::CalculateAntitrappingIncrements(PhaseF
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void EquilibriumPartitionDiffusionBinary::CalculateDiffusionIncrements(
                                                         PhaseField& Phase,
-                                                        Composition& Cx)
+                                                        Composition& Cx,
+                                                        const long int Reach)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cx.MoleFractionsTotal,0,)
+    /* Away from the interfaces only one phase is present in the cell and in
+    all its stencil neighbors, the increment then reduces to the plain
+    Laplacian of the phase concentration (the neighbor fraction check is kept
+    to give identical results next to sharp grain contacts). The interface
+    cells go through the loop over all phases.*/
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cx.MoleFractionsTotal,Reach,)
     {
-        for(size_t n = 0; n < Nphases; n++)
-        if(Phase.Fractions(i,j,k,{n}) != 0.0)
+        if(not Phase.Fields(i,j,k).wide_interface())
         {
+            const size_t n = Phase.FieldsProperties[Phase.Fields(i,j,k).front().index].Phase;
+            const double locC = Cx.MoleFractions(i,j,k,{n, Comp});
+            const double locF = Phase.Fractions(i,j,k,{n});
+
             double locDelta = 0.0;
             for(auto ds = DStencil.cbegin(); ds != DStencil.cend(); ds++)
             {
-                int di = ds->di;
-                int dj = ds->dj;
-                int dk = ds->dk;
+                const double nbF = Phase.Fractions(i+ds->di, j+ds->dj, k+ds->dk, {n});
+                if(nbF != 0.0)
+                {
+                    locDelta += ds->weight*0.5*(locF + nbF)*
+                               (Cx.MoleFractions(i+ds->di, j+ds->dj, k+ds->dk, {n, Comp}) - locC);
+                }
+            }
+            Cx.MoleFractionsTotalDot(i,j,k,{Comp}) += DC[n]*IDC[n]*locDelta;
+        }
+        else
+        {
+            for(size_t n = 0; n < Nphases; n++)
+            if(Phase.Fractions(i,j,k,{n}) != 0.0)
+            {
+                const double locC = Cx.MoleFractions(i,j,k,{n, Comp});
+                const double locF = Phase.Fractions(i,j,k,{n});
 
-                if(Phase.Fractions(i+di, j+dj, k+dk, {n}) != 0.0)
+                double locDelta = 0.0;
+                for(auto ds = DStencil.cbegin(); ds != DStencil.cend(); ds++)
                 {
-                    locDelta += ds->weight*DC[n]*IDC[n]*
-                              0.5*(Phase.Fractions(i   , j   , k   , {n}) +
-                                   Phase.Fractions(i+di, j+dj, k+dk, {n}))*
-                                  (Cx.MoleFractions(i+di, j+dj, k+dk, {n, Comp}) -
-                                   Cx.MoleFractions(i   , j   , k   , {n, Comp}));
+                    int di = ds->di;
+                    int dj = ds->dj;
+                    int dk = ds->dk;
+
+                    if(Phase.Fractions(i+di, j+dj, k+dk, {n}) != 0.0)
+                    {
+                        locDelta += ds->weight*
+                                  0.5*(locF + Phase.Fractions(i+di, j+dj, k+dk, {n}))*
+                                      (Cx.MoleFractions(i+di, j+dj, k+dk, {n, Comp}) - locC);
+                    }
                 }
+                Cx.MoleFractionsTotalDot(i,j,k,{Comp}) += DC[n]*IDC[n]*locDelta;
             }
-            Cx.MoleFractionsTotalDot(i,j,k,{Comp}) += locDelta;
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
@@ -905,11 +956,11 @@ bool EquilibriumPartitionDiffusionBinary::CalculateLimits(PhaseField& Phase,
 {
     bool LimitingNeeded = false;
 
+    Cx.AllocateTotalLimits();
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cx.NormTotal,Cx.NormTotal.Bcells(),)
     {
         Cx.NormTotal(i,j,k,{Comp}) = 1.0;
-
-        Cx.Limiting(i,j,k) = false;
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
@@ -946,25 +997,11 @@ bool EquilibriumPartitionDiffusionBinary::CalculateLimits(PhaseField& Phase,
             {
                 Cx.NormTotal(i,j,k,{Comp}) = (locMAX - TotalOld)/dTotal;
                 LimitingNeeded = true;
-
-                for (int x = -Grid.dNx; x <= Grid.dNx; ++x)
-                for (int y = -Grid.dNy; y <= Grid.dNy; ++y)
-                for (int z = -Grid.dNz; z <= Grid.dNz; ++z)
-                {
-                    Cx.Limiting(i+x, j+y, k+z) = true;
-                }
             }
             if(TotalNew < locMIN)
             {
                 Cx.NormTotal(i,j,k,{Comp}) = (locMIN - TotalOld)/dTotal;
                 LimitingNeeded = true;
-
-                for (int x = -Grid.dNx; x <= Grid.dNx; ++x)
-                for (int y = -Grid.dNy; y <= Grid.dNy; ++y)
-                for (int z = -Grid.dNz; z <= Grid.dNz; ++z)
-                {
-                    Cx.Limiting(i+x, j+y, k+z) = true;
-                }
             }
         }
     }
@@ -988,7 +1025,16 @@ void EquilibriumPartitionDiffusionBinary::LimitDiffusionIncrements(PhaseField& P
 
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cx.MoleFractionsTotalDot,0,)
     {
-        if(Cx.Limiting(i, j, k))
+        /* Only cells with a limited cell (norm below one) in their
+        neighborhood are corrected, elsewhere the correction vanishes */
+        bool Limiting = false;
+        for (int x = -Grid.dNx; x <= Grid.dNx; ++x)
+        for (int y = -Grid.dNy; y <= Grid.dNy; ++y)
+        for (int z = -Grid.dNz; z <= Grid.dNz; ++z)
+        {
+            Limiting = Limiting or Cx.NormTotal(i+x, j+y, k+z, {Comp}) != 1.0;
+        }
+        if(Limiting)
         {
             for(size_t alpha = 0; alpha < Nphases; ++alpha)
             if(Phase.Fractions(i, j, k, {alpha}) != 0.0)
@@ -1038,9 +1084,10 @@ void EquilibriumPartitionDiffusionBinary::LimitDiffusionIncrements(PhaseField& P
 
 void EquilibriumPartitionDiffusionBinary::ApplyIncrements(PhaseField& Phase,
                                                           Composition& Cx,
-                                                          double dt)
+                                                          double dt,
+                                                          const long int Reach)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cx.MoleFractionsTotal,0,)
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cx.MoleFractionsTotal,Reach,)
     {
         Cx.MoleFractionsTotal(i,j,k,{Comp})   += Cx.MoleFractionsTotalDot(i,j,k,{Comp})*dt;
         Cx.MoleFractionsTotal(i,j,k,{RefComp}) = 1.0 - Cx.MoleFractionsTotal(i,j,k,{Comp});
@@ -1055,19 +1102,37 @@ void EquilibriumPartitionDiffusionBinary::SolveDiffusion(PhaseField& Phase,
                                                          BoundaryConditions& BC,
                                                          double dt)
 {
+    /* In the communication-avoiding mode of the phase field the composition
+    is exchanged together with the phase fields only. The increments are also
+    calculated in the halo layers within Phase.HaloReach(), the phase
+    concentrations they read are set in the whole halo. Antitrapping, the
+    chemical potential and 1D extensions exchange in every time step.*/
+    const bool avoid = not EnableAntiTrapping and
+                       not ConsiderChemicalPotential and
+                       not Cx.ExtensionsActive;
+    const long int Reach = avoid ? Phase.HaloReach() : 0;
+
     CalculateDiffusionCoefficients(Tx);
 
     CalculatePhaseConcentrations(Phase, Cx, Tx);
 
-    CalculateDiffusionIncrements(Phase, Cx);
+    CalculateDiffusionIncrements(Phase, Cx, Reach);
 
     if(EnableAntiTrapping)
     {
         CalculateAntitrappingIncrements(Phase, Cx);
     }
 
-    ApplyIncrements(Phase, Cx, dt);
-    Cx.SetBoundaryConditions(BC);
+    ApplyIncrements(Phase, Cx, dt, Reach);
+    if(not avoid or Phase.HaloExchangeDue())
+    {
+        Cx.SetBoundaryConditions(BC);
+    }
+    else
+    {
+        BC.SetLocal(Cx.MoleFractions);
+        BC.SetLocal(Cx.MoleFractionsTotal);
+    }
 
     if(ConsiderChemicalPotential)
     {
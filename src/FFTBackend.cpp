@@ -0,0 +1,201 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "FFTBackend.h"
+#ifdef CUFFT
+#include <cuda_runtime.h>
+#endif
+
+namespace openphase
+{
+using namespace std;
+
+#ifdef CUFFT
+#ifdef SINGLE_PRECISION_FFT
+typedef cufftComplex       cufft_complex;
+static constexpr cufftType ForwardType  = CUFFT_R2C;
+static constexpr cufftType BackwardType = CUFFT_C2R;
+#else
+typedef cufftDoubleComplex cufft_complex;
+static constexpr cufftType ForwardType  = CUFFT_D2Z;
+static constexpr cufftType BackwardType = CUFFT_Z2D;
+#endif
+
+static void CheckCUDA(const bool success, const string what)
+{
+    if(not success)
+    {
+        ConsoleOutput::WriteExit(what + " failed", "FFTBackend", "cuFFT");
+        OP_Exit(EXIT_FAILURE);
+    }
+}
+#endif
+
+FFTBackend::~FFTBackend(void)
+{
+    Free();
+}
+
+void FFTBackend::Initialize(const int Nx, const int Ny, const int Nz,
+                            const size_t nComponents, const size_t ComponentSize,
+                            fft_real* hostData, const unsigned int flags)
+{
+    Free();
+
+    nComp    = nComponents;
+    CompSize = ComponentSize;
+    HostData = hostData;
+
+    int realDims[3]     = {Nx, Ny, Nz};                                         // Transform size
+    int realEmbed[3]    = {Nx, Ny, 2*(Nz/2 + 1)};                               // Padded real array
+    int complexEmbed[3] = {Nx, Ny, Nz/2 + 1};                                   // Complex array
+    const int realDist    = CompSize;
+    const int complexDist = CompSize/2;
+
+#ifdef CUFFT
+    CheckCUDA(cudaMalloc(reinterpret_cast<void**>(&DeviceData), sizeof(fft_real)*CompSize*nComp) == cudaSuccess,
+              "cudaMalloc");
+    CheckCUDA(cufftPlanMany(&ForwardPlan, 3, realDims, realEmbed, 1, realDist,
+                            complexEmbed, 1, complexDist, ForwardType, nComp) == CUFFT_SUCCESS,
+              "cufftPlanMany(forward)");
+    CheckCUDA(cufftPlanMany(&BackwardPlan, 3, realDims, complexEmbed, 1, complexDist,
+                            realEmbed, 1, realDist, BackwardType, nComp) == CUFFT_SUCCESS,
+              "cufftPlanMany(backward)");
+    Planned = true;
+#elif defined(SINGLE_PRECISION_FFT)
+    DeviceData = HostData;
+
+    /* The single precision library has its own threads and wisdom. */
+#ifdef _OPENMP
+    fftwf_init_threads();
+    fftwf_plan_with_nthreads(omp_get_max_threads());
+#endif
+    ForwardPlan = fftwf_plan_many_dft_r2c(3, realDims, nComp,
+                    DeviceData, realEmbed, 1, realDist,
+                    reinterpret_cast<fftwf_complex*> (DeviceData), complexEmbed, 1, complexDist,
+                    flags);
+
+    BackwardPlan = fftwf_plan_many_dft_c2r(3, realDims, nComp,
+                    reinterpret_cast<fftwf_complex*> (DeviceData), complexEmbed, 1, complexDist,
+                    DeviceData, realEmbed, 1, realDist,
+                    flags);
+#else
+    DeviceData = HostData;
+
+    ForwardPlan = fftw_plan_many_dft_r2c(3, realDims, nComp,
+                    DeviceData, realEmbed, 1, realDist,
+                    reinterpret_cast<fftw_complex*> (DeviceData), complexEmbed, 1, complexDist,
+                    flags);
+
+    BackwardPlan = fftw_plan_many_dft_c2r(3, realDims, nComp,
+                    reinterpret_cast<fftw_complex*> (DeviceData), complexEmbed, 1, complexDist,
+                    DeviceData, realEmbed, 1, realDist,
+                    flags);
+#endif
+}
+
+void FFTBackend::Free(void)
+{
+#ifdef CUFFT
+    if(Planned)
+    {
+        cufftDestroy(ForwardPlan);
+        cufftDestroy(BackwardPlan);
+        Planned = false;
+    }
+    cudaFree(DeviceData);
+#elif defined(SINGLE_PRECISION_FFT)
+    if(ForwardPlan)  fftwf_destroy_plan(ForwardPlan);
+    if(BackwardPlan) fftwf_destroy_plan(BackwardPlan);
+    ForwardPlan  = nullptr;
+    BackwardPlan = nullptr;
+#else
+    if(ForwardPlan)  fftw_destroy_plan(ForwardPlan);
+    if(BackwardPlan) fftw_destroy_plan(BackwardPlan);
+    ForwardPlan  = nullptr;
+    BackwardPlan = nullptr;
+#endif
+    DeviceData = nullptr;
+    HostData   = nullptr;
+}
+
+void FFTBackend::Forward(void)
+{
+#ifdef CUFFT
+#ifdef SINGLE_PRECISION_FFT
+    CheckCUDA(cufftExecR2C(ForwardPlan, DeviceData,
+                           reinterpret_cast<cufft_complex*>(DeviceData)) == CUFFT_SUCCESS,
+              "cufftExecR2C");
+#else
+    CheckCUDA(cufftExecD2Z(ForwardPlan, DeviceData,
+                           reinterpret_cast<cufft_complex*>(DeviceData)) == CUFFT_SUCCESS,
+              "cufftExecD2Z");
+#endif
+#elif defined(SINGLE_PRECISION_FFT)
+    fftwf_execute(ForwardPlan);
+#else
+    fftw_execute(ForwardPlan);
+#endif
+}
+
+void FFTBackend::Backward(void)
+{
+#ifdef CUFFT
+#ifdef SINGLE_PRECISION_FFT
+    CheckCUDA(cufftExecC2R(BackwardPlan, reinterpret_cast<cufft_complex*>(DeviceData),
+                           DeviceData) == CUFFT_SUCCESS,
+              "cufftExecC2R");
+#else
+    CheckCUDA(cufftExecZ2D(BackwardPlan, reinterpret_cast<cufft_complex*>(DeviceData),
+                           DeviceData) == CUFFT_SUCCESS,
+              "cufftExecZ2D");
+#endif
+#elif defined(SINGLE_PRECISION_FFT)
+    fftwf_execute(BackwardPlan);
+#else
+    fftw_execute(BackwardPlan);
+#endif
+}
+
+void FFTBackend::CopyToDevice(const size_t first, const size_t count)
+{
+#ifdef CUFFT
+    CheckCUDA(cudaMemcpy(DeviceData + first*CompSize, HostData + first*CompSize,
+                         sizeof(fft_real)*CompSize*count, cudaMemcpyHostToDevice) == cudaSuccess,
+              "cudaMemcpy");
+#endif
+}
+
+void FFTBackend::CopyToHost(const size_t first, const size_t count)
+{
+#ifdef CUFFT
+    CheckCUDA(cudaMemcpy(HostData + first*CompSize, DeviceData + first*CompSize,
+                         sizeof(fft_real)*CompSize*count, cudaMemcpyDeviceToHost) == cudaSuccess,
+              "cudaMemcpy");
+#endif
+}
+
+}// namespace openphase
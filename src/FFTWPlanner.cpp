@@ -0,0 +1,196 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifdef MPI_PARALLEL
+#include "mpi_wrapper.h"
+#else
+#include "fftw3.h"
+#endif
+
+#include "FFTWPlanner.h"
+#include "FileInterface.h"
+
+namespace openphase
+{
+using namespace std;
+
+void FFTWPlanner::ReadInput(stringstream& inp, const int moduleLocation)
+{
+    SetRigor(FileInterface::ReadParameterK(inp, moduleLocation, "FFTWPlanner", false, Rigor));
+    SetWisdomDir(FileInterface::ReadParameterF(inp, moduleLocation, "FFTWWisdomDir", false, WisdomDir));
+}
+
+void FFTWPlanner::SetRigor(const string rigor)
+{
+    string key = rigor;
+    std::transform(key.begin(), key.end(), key.begin(), ::toupper);
+    if(key == "ESTIMATE")        Rigor = "Estimate";
+    else if(key == "MEASURE")    Rigor = "Measure";
+    else if(key == "PATIENT")    Rigor = "Patient";
+    else if(key == "EXHAUSTIVE") Rigor = "Exhaustive";
+    else
+    {
+        ConsoleOutput::WriteExit("Unknown FFTW planning rigor \"" + rigor +
+                                 "\", use Estimate, Measure, Patient or Exhaustive",
+                                 "FFTWPlanner", "SetRigor()");
+        OP_Exit(EXIT_FAILURE);
+    }
+}
+
+void FFTWPlanner::SetWisdomDir(const string dir)
+{
+    WisdomDir = dir;
+    if(!WisdomDir.empty() and WisdomDir.back() != dirSeparator.back())
+    {
+        WisdomDir += dirSeparator;
+    }
+}
+
+unsigned int FFTWPlanner::Flags(void)
+{
+    if(Rigor == "Measure")    return FFTW_MEASURE;
+    if(Rigor == "Patient")    return FFTW_PATIENT;
+    if(Rigor == "Exhaustive") return FFTW_EXHAUSTIVE;
+    return FFTW_ESTIMATE;
+}
+
+string FFTWPlanner::WisdomFileName(const long int Nx, const long int Ny,
+                                   const long int Nz)
+{
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    int ranks = 1;
+#ifdef MPI_PARALLEL
+    ranks = MPI_SIZE;
+#endif
+    stringstream name;
+    name << WisdomDir << "FFTW_" << Nx << "x" << Ny << "x" << Nz
+         << "_T" << threads << "_R" << ranks << ".wisdom";
+    return name.str();
+}
+
+void FFTWPlanner::ImportWisdom(const long int Nx, const long int Ny,
+                               const long int Nz)
+{
+    if(WisdomDir.empty() or Rigor == "Estimate") return;
+
+    const string FileName = WisdomFileName(Nx, Ny, Nz);
+#ifdef MPI_PARALLEL
+    if(MPI_RANK == 0)
+#endif
+    {
+        if(fftw_import_wisdom_from_filename(FileName.c_str()))
+        {
+            ConsoleOutput::WriteStandard("FFTW wisdom imported", FileName);
+        }
+#ifdef SINGLE_PRECISION_FFT
+        fftwf_import_wisdom_from_filename((FileName + "f").c_str());
+#endif
+    }
+#ifdef MPI_PARALLEL
+    op_fftw_mpi_broadcast_wisdom();
+#endif
+}
+
+void FFTWPlanner::ExportWisdom(const long int Nx, const long int Ny,
+                               const long int Nz)
+{
+    if(WisdomDir.empty() or Rigor == "Estimate") return;
+
+#ifdef MPI_PARALLEL
+    op_fftw_mpi_gather_wisdom();
+    if(MPI_RANK == 0)
+#endif
+    {
+        const string FileName = WisdomFileName(Nx, Ny, Nz);
+        std::filesystem::create_directories(WisdomDir);
+        if(!fftw_export_wisdom_to_filename(FileName.c_str()))
+        {
+            ConsoleOutput::WriteWarning("FFTW wisdom could not be written to " + FileName,
+                                        "FFTWPlanner", "ExportWisdom()");
+        }
+#ifdef SINGLE_PRECISION_FFT
+        fftwf_export_wisdom_to_filename((FileName + "f").c_str());
+#endif
+    }
+}
+
+FFTWPlanner::SharedPlan* FFTWPlanner::FindPlan(const int Sign, const int Nx,
+                                               const int Ny, const int Nz,
+                                               const void* in, const void* out)
+{
+    for(SharedPlan& plan : Plans)
+    if(plan.Sign == Sign and plan.N[0] == Nx and plan.N[1] == Ny and
+       plan.N[2] == Nz and plan.In == in and plan.Out == out and
+       plan.PlanFlags == Flags())
+    {
+        plan.Users++;
+        return &plan;
+    }
+    return nullptr;
+}
+
+fftw_plan FFTWPlanner::PlanR2C(const int Nx, const int Ny, const int Nz,
+                               double* in, fftw_complex* out)
+{
+    if(SharedPlan* plan = FindPlan(FFTW_FORWARD, Nx, Ny, Nz, in, out))
+    {
+        return plan->Plan;
+    }
+    fftw_plan plan = fftw_plan_dft_r2c_3d(Nx, Ny, Nz, in, out, Flags());
+    Plans.push_back({plan, FFTW_FORWARD, {Nx, Ny, Nz}, in, out, Flags(), 1});
+    return plan;
+}
+
+fftw_plan FFTWPlanner::PlanC2R(const int Nx, const int Ny, const int Nz,
+                               fftw_complex* in, double* out)
+{
+    if(SharedPlan* plan = FindPlan(FFTW_BACKWARD, Nx, Ny, Nz, in, out))
+    {
+        return plan->Plan;
+    }
+    fftw_plan plan = fftw_plan_dft_c2r_3d(Nx, Ny, Nz, in, out, Flags());
+    Plans.push_back({plan, FFTW_BACKWARD, {Nx, Ny, Nz}, in, out, Flags(), 1});
+    return plan;
+}
+
+void FFTWPlanner::ReleasePlan(fftw_plan plan)
+{
+    for(size_t n = 0; n < Plans.size(); n++)
+    if(Plans[n].Plan == plan)
+    {
+        if(--Plans[n].Users == 0)
+        {
+            fftw_destroy_plan(Plans[n].Plan);
+            Plans.erase(Plans.begin() + n);
+        }
+        return;
+    }
+}
+
+}// namespace openphase
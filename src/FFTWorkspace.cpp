@@ -0,0 +1,93 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifdef MPI_PARALLEL
+#include "mpi_wrapper.h"
+#else
+#include "fftw3.h"
+#endif
+
+#include "FFTWorkspace.h"
+
+namespace openphase
+{
+using namespace std;
+
+double* FFTWorkspace::Acquire(const size_t nDoubles, const int slot)
+{
+    /* The smallest sufficient array of the slot is shared, which leaves
+    larger arrays to the solvers that need them. */
+    Buffer* best = nullptr;
+    for(Buffer& buffer : Buffers)
+    if(buffer.Slot == slot and buffer.Size >= nDoubles)
+    {
+        if(best == nullptr or buffer.Size < best->Size)
+        {
+            best = &buffer;
+        }
+    }
+    if(best)
+    {
+        best->Users++;
+        return best->Data;
+    }
+
+    double* data = static_cast<double*>(fftw_malloc(sizeof(double)*nDoubles));
+    if(data == nullptr)
+    {
+        ConsoleOutput::WriteExit("Allocation of " + to_string(sizeof(double)*nDoubles) +
+                                 " bytes failed", "FFTWorkspace", "Acquire()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    Buffers.push_back({data, nDoubles, slot, 1});
+    return data;
+}
+
+void FFTWorkspace::Release(double* data)
+{
+    for(size_t n = 0; n < Buffers.size(); n++)
+    if(Buffers[n].Data == data)
+    {
+        if(--Buffers[n].Users == 0)
+        {
+            fftw_free(Buffers[n].Data);
+            Buffers.erase(Buffers.begin() + n);
+        }
+        return;
+    }
+}
+
+size_t FFTWorkspace::AllocatedMemory(void)
+{
+    size_t bytes = 0;
+    for(const Buffer& buffer : Buffers)
+    {
+        bytes += sizeof(double)*buffer.Size;
+    }
+    return bytes;
+}
+
+}// namespace openphase
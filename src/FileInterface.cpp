@@ -26,7 +26,11 @@
  */
 
 #include "FileInterface.h"
+#include "Embedded.h"
+#include "MappedFile.h"
 #include <filesystem>
+#include <string_view>
+#include <unordered_map>
 
 namespace openphase
 {
@@ -63,7 +67,7 @@ string replacePunctuationMarksWithComma(string& Instring)
     return Instring;
 }
 
-int StringToInt(const std::string& str, const std::string name)
+int StringToInt(const std::string& str, const std::string name, const size_t line)
 {
     int ivar = 0;
 
@@ -73,13 +77,13 @@ int StringToInt(const std::string& str, const std::string name)
     }
     catch (const std::invalid_argument&)
     {
-        ConsoleOutput::WriteExit("Argument for $" + name + " is invalid", "FileInterface", "ReadParameterI()");
+        ConsoleOutput::WriteExit("Argument for $" + name + " in line " + std::to_string(line) + " is invalid", "FileInterface", "ReadParameterI()");
         OP_Exit(EXIT_FAILURE);
     }
     return ivar;
 }
 
-double StringToDouble(const std::string& str, const std::string name)
+double StringToDouble(const std::string& str, const std::string name, const size_t line)
 {
     double dvar = 0.0;
 
@@ -89,13 +93,185 @@ double StringToDouble(const std::string& str, const std::string name)
     }
     catch (const std::invalid_argument&)
     {
-        ConsoleOutput::WriteExit("Argument for $" + name + " is invalid", "FileInterface", "ReadParameterD()");
+        ConsoleOutput::WriteExit("Argument for $" + name + " in line " + std::to_string(line) + " is invalid", "FileInterface", "ReadParameterD()");
         OP_Exit(EXIT_FAILURE);
     }
     return dvar;
 }
 // ====================== Auxiliary functions end ============================//
 
+// ========================== Parsed input index =============================//
+/* The input text is parsed once into the positions of its modules and keys
+and the result is shared by all readers of the same text, instead of copying
+and scanning the text again for every parameter. The lookups reproduce the
+sequential scan of the readers: starting from the given location, the first
+"$Key" token is taken unless an '@' precedes it, which ends the module. */
+struct InputIndex
+{
+    struct Entry
+    {
+        size_t Begin;                                                           ///< Position of '$'
+        size_t KeyEnd;                                                          ///< Position right after the key
+        size_t Line;                                                            ///< Line number of the key, starting at 1
+    };
+
+    std::string Text;                                                           ///< Input text
+    std::unordered_map<std::string, size_t> Modules;                            ///< Position right after the first "@Module" token of each module
+    std::unordered_map<std::string, std::vector<Entry>> Keys;                   ///< All occurrences of each key in the order of appearance
+    std::vector<size_t> Stops;                                                  ///< Positions of '@' outside of the key tokens
+
+    explicit InputIndex(std::string&& InputText) : Text(std::move(InputText))
+    {
+        auto isspace = [](const char c)
+        {
+            return c == ' ' or c == '\t' or c == '\n' or c == '\v' or c == '\f' or c == '\r';
+        };
+        auto TokenEnd = [this, &isspace](size_t pos)
+        {
+            while (pos < Text.size() and not isspace(Text[pos])) pos++;
+            return pos;
+        };
+        auto TokenBegin = [this, &isspace](size_t pos)
+        {
+            while (pos < Text.size() and isspace(Text[pos])) pos++;
+            return pos;
+        };
+
+        size_t Line = 1;
+        size_t LinePos = 0;
+        size_t pos = Text.find_first_of("$@");
+        while (pos != std::string::npos)
+        {
+            const size_t begin = TokenBegin(pos + 1);
+            const size_t end = TokenEnd(begin);
+            if (Text[pos] == '@')
+            {
+                Stops.push_back(pos);
+                if (end > begin) Modules.emplace(Text.substr(begin, end - begin), end);
+                pos = Text.find_first_of("$@", pos + 1);
+            }
+            else
+            {
+                if (end > begin)
+                {
+                    Line += std::count(Text.begin() + LinePos, Text.begin() + pos, '\n');
+                    LinePos = pos;
+                    Keys[Text.substr(begin, end - begin)].push_back({pos, end, Line});
+                }
+                pos = Text.find_first_of("$@", end);
+            }
+        }
+    }
+
+    // First occurrence of Key at or after location within the same module
+    const Entry* Find(const int location, const std::string& Key) const
+    {
+        auto it = Keys.find(Key);
+        if (it == Keys.end()) return nullptr;
+
+        const size_t start = std::max(location, 0);
+        auto stop = std::lower_bound(Stops.begin(), Stops.end(), start);
+        const size_t end = (stop == Stops.end()) ? Text.size() : *stop;
+
+        const std::vector<Entry>& Entries = it->second;
+        auto entry = std::lower_bound(Entries.begin(), Entries.end(), start,
+                     [](const Entry& a, const size_t b){ return a.Begin < b; });
+        if (entry == Entries.end() or entry->Begin >= end) return nullptr;
+        return &(*entry);
+    }
+
+    // Text held by the buffer of a string stream, without copying it
+    struct BufferView : std::stringbuf
+    {
+        static std::string_view Get(const std::stringstream& Inp)
+        {
+            /* The pointers to the protected members of std::streambuf apply to
+            any stream buffer, the text ends at the furthest written or read
+            position as in std::stringbuf::str() */
+            std::streambuf* Buffer = Inp.rdbuf();
+            const char* Begin = (Buffer->*(&BufferView::eback))();
+            const char* End   = (Buffer->*(&BufferView::egptr))();
+            const char* Put   = (Buffer->*(&BufferView::pptr))();
+            if (Begin == nullptr) Begin = (Buffer->*(&BufferView::pbase))();
+            if (Begin == nullptr) return std::string_view();
+            if (Put > End) End = Put;
+            return std::string_view(Begin, End - Begin);
+        }
+    };
+
+    const char* Source = nullptr;                                               ///< Buffer of the stream the index was parsed from
+
+    static void Release(std::ios_base::event Event, std::ios_base& Stream, int Slot)
+    {
+        void*& Cached = Stream.pword(Slot);
+        if (Event == std::ios_base::erase_event)
+        {
+            delete static_cast<std::shared_ptr<const InputIndex>*>(Cached);
+        }
+        /* After copyfmt() the pointer belongs to the source stream */
+        Cached = nullptr;
+    }
+
+    // Index of the text of Inp, parsed on first use
+    static std::shared_ptr<const InputIndex> Get(const std::stringstream& Inp)
+    {
+        /* The index is attached to the stream itself (pword slot released
+        with the stream) and reparsed if the text differs from the indexed
+        copy, e.g. after str() was called with a new input. str() may reuse
+        the buffer for a text of the same length, so the full text is
+        compared. A lookup thereby costs one comparison instead of a copy and
+        a rescan, needs no lock, and concurrent readers of different streams
+        do not share a cache. */
+        static const int Slot = std::ios_base::xalloc();
+
+        std::stringstream& Stream = const_cast<std::stringstream&>(Inp);
+        void*& Cached = Stream.pword(Slot);
+        const std::string_view View = BufferView::Get(Inp);
+
+        auto* Index = static_cast<std::shared_ptr<const InputIndex>*>(Cached);
+        if (Index != nullptr and (*Index)->Source == View.data() and
+            std::string_view((*Index)->Text) == View)
+        {
+            return *Index;
+        }
+        if (Index == nullptr)
+        {
+            Index = new std::shared_ptr<const InputIndex>();
+            Cached = Index;
+            Stream.register_callback(Release, Slot);
+        }
+        auto NewIndex = std::make_shared<InputIndex>(std::string(View));
+        NewIndex->Source = View.data();
+        *Index = std::move(NewIndex);
+        return *Index;
+    }
+};
+// ======================== Parsed input index end ===========================//
+
+std::stringstream FileInterface::OpenInput(const std::string& FileName)
+{
+    /* Inputs registered in memory take precedence, in embedded mode the
+    file system is not accessed */
+    std::stringstream data;
+    std::string Text;
+    if(Embedded::GetInput(FileName, Text))
+    {
+        data.str(std::move(Text));
+        return data;
+    }
+    if(not Embedded::Active())
+    {
+        std::ifstream inp(FileName.c_str(), std::ios::in | std::ios::binary);
+        if(inp)
+        {
+            if(inp.peek() != std::ifstream::traits_type::eof()) data << inp.rdbuf();
+            return data;
+        }
+    }
+    data.setstate(std::ios::failbit);
+    return data;
+}
+
 std::string FileInterface::getFileExtension(const std::string& filename) 
 {
     size_t dotPos = filename.rfind('.');
@@ -126,132 +302,88 @@ string FileInterface::MakeFileName(string Directory, string NameBase, int Index,
     return FilePath.string();
 }
 
-int FileInterface::FindModuleLocation(const stringstream& sInp, const string module)
+void FileInterface::WriteRows(const string& FileName, const string& Header,
+                              const size_t Nrows,
+                              const function<void(ostream&, const size_t)>& Row)
 {
-    std::stringstream Inp(sInp.str());
-    // Returns the location of the first line in the module specified in the parameters
-    Inp.seekg(0, ios::beg);
-    while (!Inp.eof())
+    /* Text formatting dominates the cost of large tabulated outputs. Each
+     * chunk of consecutive rows is formatted into its own buffer by one
+     * thread, the buffers are then written in order, so the file content does
+     * not depend on the number of threads. Several chunks per thread keep the
+     * load balanced if the row cost varies. */
+
+    const size_t Nchunks = min<size_t>(max<size_t>(Nrows, 1),
+                                       4*omp_get_max_threads());
+    vector<string> Chunks(Nchunks);
+
+    #pragma omp parallel for schedule(dynamic,1)
+    for(size_t c = 0; c < Nchunks; c++)
     {
-        string tmp;
-        string ReadKey;
-
-        getline(Inp, tmp, '@');
-        if (Inp.eof()) break;
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(module))
+        ostringstream Buffer;
+        for(size_t n = Nrows*c/Nchunks; n < Nrows*(c+1)/Nchunks; n++)
         {
-            streampos temp = Inp.tellg();
-            //temp += 1;
-            return temp;
+            Row(Buffer, n);
         }
+        Chunks[c] = Buffer.str();
     }
-    Inp.seekg(0, ios::beg);
-    return 0;
+
+    ofstream out(FileName, ios::out | ios::binary);
+    if(!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be created",
+                                    "FileInterface", "WriteRows()");
+        return;
+    }
+    out << Header;
+    for(const string& Chunk : Chunks) out << Chunk;
+    out.close();
 }
 
-int FileInterface::FindParameter(const stringstream& sInp,
+bool FileInterface::ParameterPresent(const stringstream& sInp,
     const int location, const string Key)
 {
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(location);
-    Inp.seekg(curPos);
-
-    bool found = false;
-    int keyLocation = 0;
+    return FindParameter(sInp, location, Key) != -1;
+}
 
-    while (!Inp.eof() and !found)
+int FileInterface::FindModuleLocation(const stringstream& sInp, const string module)
+{
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
+    // Returns the location of the first line in the module specified in the parameters
+    auto it = Index->Modules.find(module);
+    if (it != Index->Modules.end())
     {
-        string tmp;
-        string ReadKey;
-
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            keyLocation = -1;
-            break;
-        }
-
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
-        {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                keyLocation = -1;
-                break;
-            }
-        }
-
-        if (endReading)
-            break;
+        return it->second;
+    }
+    return 0;
+}
 
-        Inp >> ReadKey;
+int FileInterface::FindParameter(const stringstream& sInp,
+    const int location, const string Key)
+{
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
-        if (!ReadKey.compare(Key))
-        {
-            keyLocation = Inp.tellg();
-            keyLocation -= (ReadKey.size() + 1);
-            found = true;
-            break;
-        }
+    if (const InputIndex::Entry* Entry = Index->Find(location, Key))
+    {
+        return Entry->KeyEnd - (Key.size() + 1);
     }
-    Inp.clear();
-    return keyLocation;
+    return -1;
 }
 
 int FileInterface::FindParameterLocation(const stringstream& sInp,
     const int location, const string Key)
 {
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
-    streampos curPos(location+1);
-    Inp.seekg(curPos);
-
-    bool found = false;
-    int keyLocation = 0;
-    while (!Inp.eof() and !found)
+    if (const InputIndex::Entry* Entry = Index->Find(location + 1, Key))
     {
-        string tmp;
-        string ReadKey;
-
-        getline(Inp, tmp, '$');
-
-        if (Inp.eof())
-        {
-            keyLocation = -1;
-            break;
-        }
-
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
-        {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                keyLocation = -1;
-                break;
-            }
-        }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        // Location right after the ':' separating the comment from the value
+        size_t colon = Index->Text.find(':', Entry->KeyEnd);
+        if (colon != std::string::npos)
         {
-            getline(Inp, tmp, ':');
-            keyLocation = Inp.tellg();
-            //keyLocation -= (ReadKey.size() + 1);
-            found = true;
-            break;
+            return colon + 1;
         }
     }
-    Inp.clear();
-    return keyLocation;
+    return -1;
 }
 
 double FileInterface::ReadParameterD(const stringstream& sInp, int currentLocation, string Key,
@@ -261,64 +393,35 @@ double FileInterface::ReadParameterD(const stringstream& sInp, int currentLocati
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     double ReturnValue = defaultval;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
         string tmp2;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
+        getline(Inp, tmp, ':');
+        getline(Inp, tmp2);
+        tmp = removeLeadingTrailingWhiteSpaces(tmp);
+        tmp2 = removeAllWhiteSpaces(tmp2);
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        // Transfer string tmp2 to double (and check if this is possible at all)
+        ReturnValue = StringToDouble(tmp2, Key, Entry->Line);
+
+        // Checks if comment is given, otherwise use "Key" as output
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            getline(Inp, tmp2);
-            tmp = removeLeadingTrailingWhiteSpaces(tmp);
-            tmp2 = removeAllWhiteSpaces(tmp2);
-
-            // Transfer string tmp2 to double (and check if this is possible at all)
-            ReturnValue = StringToDouble(tmp2, tmp);
-
-            // Checks if comment is given, otherwise use "Key" as output
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
-            }
-            else
-            {
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
-            }
-            found = true;
-            break;
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
         }
-
+        found = true;
     }
 
     if (not found)
@@ -339,7 +442,6 @@ double FileInterface::ReadParameterD(const stringstream& sInp, int currentLocati
         }
 
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -400,64 +502,36 @@ double FileInterface::ReadParameterD(const stringstream& sInp, int currentLocati
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     double ReturnValue = defaultval;
     for (unsigned int i = 0; i < Key.size(); ++i)
     {
-        streampos curPos(currentLocation);
-        Inp.seekg(curPos);
-        while (!Inp.eof())
+        if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key[i]))
         {
+            MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
             string tmp;
             string tmp2;
-            string ReadKey;
 
-            getline(Inp, tmp, '$');
-            if (Inp.eof())
-            {
-                break;
-            }
+            getline(Inp, tmp, ':');
+            getline(Inp, tmp2);
+            tmp = removeLeadingTrailingWhiteSpaces(tmp);
+            tmp2 = removeAllWhiteSpaces(tmp2);
+
+            // Transfer string tmp2 to double (and check if this is possible at all)
+            ReturnValue = StringToDouble(tmp2, Key[i], Entry->Line);
 
-            bool endReading = false;
-            for (unsigned int i = 0; i < tmp.size(); i++)
+            // Checks if comment is given, otherwise use "Key" as output
+            if (tmp.find_first_not_of(' ') == std::string::npos)
             {
-                if (tmp.at(i) == '@')
-                {
-                    endReading = true;
-                    break;
-                }
+                ConsoleOutput::WriteStandard("$" + Key[i], ReturnValue, 5);
             }
-
-            if (endReading)
-                break;
-
-            Inp >> ReadKey;
-
-            if (!ReadKey.compare(Key[i]))
+            else
             {
-                getline(Inp, tmp, ':');
-                getline(Inp, tmp2);
-                tmp = removeLeadingTrailingWhiteSpaces(tmp);
-                tmp2 = removeAllWhiteSpaces(tmp2);
-
-                // Transfer string tmp2 to double (and check if this is possible at all)
-                ReturnValue = StringToDouble(tmp2, tmp);
-
-                // Checks if comment is given, otherwise use "Key" as output
-                if (tmp.find_first_not_of(' ') == std::string::npos)
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i], ReturnValue, 5);
-                }
-                else
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, ReturnValue, 5);
-                }
-                found = true;
-                break;
+                ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, ReturnValue, 5);
             }
-
+            found = true;
         }
         if (found)
         {
@@ -483,7 +557,6 @@ double FileInterface::ReadParameterD(const stringstream& sInp, int currentLocati
         }
 
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -494,60 +567,32 @@ dVector3 FileInterface::ReadParameterV3(const stringstream& sInp, int currentLoc
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     dVector3 ReturnValue = defaultval;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
         string tmp2;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
+        getline(Inp, tmp, ':');
+        tmp = removeLeadingTrailingWhiteSpaces(tmp);
+
+        ReturnValue.read(Inp);
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        // Checks if comment is given, otherwise use "Key" as output
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            tmp = removeLeadingTrailingWhiteSpaces(tmp);
-
-            ReturnValue.read(Inp);
-
-            // Checks if comment is given, otherwise use "Key" as output
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
-            }
-            else
-            {
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
-            }
-            found = true;
-            break;
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
         }
+        found = true;
     }
 
     if (not found)
@@ -567,7 +612,6 @@ dVector3 FileInterface::ReadParameterV3(const stringstream& sInp, int currentLoc
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -578,60 +622,33 @@ dVector3 FileInterface::ReadParameterV3(const stringstream& sInp, int currentLoc
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     dVector3 ReturnValue = defaultval;
     for (unsigned int i = 0; i < Key.size(); ++i)
     {
-        streampos curPos(currentLocation);
-        Inp.seekg(curPos);
-        while (!Inp.eof())
+        if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key[i]))
         {
+            MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
             string tmp;
             string tmp2;
-            string ReadKey;
 
-            getline(Inp, tmp, '$');
-            if (Inp.eof())
-            {
-                break;
-            }
+            getline(Inp, tmp, ':');
+            tmp = removeLeadingTrailingWhiteSpaces(tmp);
+
+            ReturnValue.read(Inp);
 
-            bool endReading = false;
-            for (unsigned int i = 0; i < tmp.size(); i++)
+            // Checks if comment is given, otherwise use "Key" as output
+            if (tmp.find_first_not_of(' ') == std::string::npos)
             {
-                if (tmp.at(i) == '@')
-                {
-                    endReading = true;
-                    break;
-                }
+                ConsoleOutput::WriteStandard("$" + Key[i], ReturnValue, 5);
             }
-
-            if (endReading)
-                break;
-
-            Inp >> ReadKey;
-
-            if (!ReadKey.compare(Key[i]))
+            else
             {
-                getline(Inp, tmp, ':');
-                tmp = removeLeadingTrailingWhiteSpaces(tmp);
-
-                ReturnValue.read(Inp);
-
-                // Checks if comment is given, otherwise use "Key" as output
-                if (tmp.find_first_not_of(' ') == std::string::npos)
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i], ReturnValue, 5);
-                }
-                else
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, ReturnValue, 5);
-                }
-                found = true;
-                break;
+                ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, ReturnValue, 5);
             }
+            found = true;
         }
         if (found)
         {
@@ -656,7 +673,6 @@ dVector3 FileInterface::ReadParameterV3(const stringstream& sInp, int currentLoc
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -667,59 +683,32 @@ iVector3 FileInterface::ReadParameterV3I(const stringstream& sInp, int currentLo
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
     bool found = false;
     iVector3 ReturnValue = defaultval;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
         string tmp2;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
+        getline(Inp, tmp, ':');
+        tmp = removeLeadingTrailingWhiteSpaces(tmp);
+
+        ReturnValue.read(Inp);
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        // Checks if comment is given, otherwise use "Key" as output
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            tmp = removeLeadingTrailingWhiteSpaces(tmp);
-
-            ReturnValue.read(Inp);
-
-            // Checks if comment is given, otherwise use "Key" as output
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
-            }
-            else
-            {
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
-            }
-            found = true;
-            break;
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
         }
+        found = true;
     }
 
     if (not found)
@@ -739,7 +728,6 @@ iVector3 FileInterface::ReadParameterV3I(const stringstream& sInp, int currentLo
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -750,59 +738,32 @@ dMatrix3x3 FileInterface::ReadParameterM3x3(const stringstream& sInp, int curren
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
     bool found = false;
     dMatrix3x3 ReturnValue = defaultval;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
         string tmp2;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
+        getline(Inp, tmp, ':');
+        tmp = removeLeadingTrailingWhiteSpaces(tmp);
+
+        ReturnValue.read(Inp);
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        // Checks if comment is given, otherwise use "Key" as output
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            tmp = removeLeadingTrailingWhiteSpaces(tmp);
-
-            ReturnValue.read(Inp);
-
-            // Checks if comment is given, otherwise use "Key" as output
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
-            }
-            else
-            {
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
-            }
-            found = true;
-            break;
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
         }
+        found = true;
     }
 
     if (not found)
@@ -822,7 +783,6 @@ dMatrix3x3 FileInterface::ReadParameterM3x3(const stringstream& sInp, int curren
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -834,60 +794,32 @@ dMatrix6x6 FileInterface::ReadParameterT6(const stringstream& sInp, int currentL
     // mandatory: if parameter not found, program will stop (standard = true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     dMatrix6x6 ReturnValue = defaultval;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
         string tmp2;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
+        getline(Inp, tmp, ':');
+        tmp = removeLeadingTrailingWhiteSpaces(tmp);
+
+        ReturnValue.read(Inp);
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        // Checks if comment is given, otherwise use "Key" as output
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            tmp = removeLeadingTrailingWhiteSpaces(tmp);
-
-            ReturnValue.read(Inp);
-
-            // Checks if comment is given, otherwise use "Key" as output
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
-            }
-            else
-            {
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
-            }
-            found = true;
-            break;
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
         }
+        found = true;
     }
 
     if (not found)
@@ -907,7 +839,6 @@ dMatrix6x6 FileInterface::ReadParameterT6(const stringstream& sInp, int currentL
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -918,59 +849,31 @@ dMatrix6x6 FileInterface::ReadParameterM6x6(const stringstream& sInp, int curren
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     dMatrix6x6 ReturnValue = defaultval;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
         string tmp2;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
+        getline(Inp, tmp, ':');
+        tmp = removeLeadingTrailingWhiteSpaces(tmp);
+        ReturnValue.read(Inp);
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        // Checks if comment is given, otherwise use "Key" as output
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            tmp = removeLeadingTrailingWhiteSpaces(tmp);
-            ReturnValue.read(Inp);
-
-            // Checks if comment is given, otherwise use "Key" as output
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, ReturnValue, 5);
-            }
-            else
-            {
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
-            }
-            found = true;
-            break;
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue, 5);
         }
+        found = true;
     }
 
     if (not found)
@@ -990,7 +893,6 @@ dMatrix6x6 FileInterface::ReadParameterM6x6(const stringstream& sInp, int curren
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -1001,58 +903,30 @@ string FileInterface::ReadParameterS(const stringstream& sInp, int currentLocati
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     string ReturnValue;
     string tFileName;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
+        getline(Inp, tmp, ':');
+        getline(Inp, tFileName);
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            break;
+            ConsoleOutput::WriteStandard("$" + Key, tFileName);
         }
-
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        else
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
-        }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
-        {
-            getline(Inp, tmp, ':');
-            getline(Inp, tFileName);
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, tFileName);
-            }
-            else
-            {
-                tmp.erase(0, tmp.find_first_not_of(" \t"));
-                tFileName.erase(0, tFileName.find_first_not_of(" \t"));
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, tFileName);
-            }
-            found = true;
-            break;
+            tmp.erase(0, tmp.find_first_not_of(" \t"));
+            tFileName.erase(0, tFileName.find_first_not_of(" \t"));
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, tFileName);
         }
+        found = true;
     }
 
     for (unsigned int i = 0; i < tFileName.size(); i++)
@@ -1079,7 +953,6 @@ string FileInterface::ReadParameterS(const stringstream& sInp, int currentLocati
         }
     }
 
-    Inp.clear();
     removeCarriageReturn(ReturnValue);
     return ReturnValue;
 }
@@ -1091,7 +964,7 @@ string FileInterface::ReadParameterS(const stringstream& sInp, int currentLocati
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     string ReturnValue;
@@ -1099,51 +972,24 @@ string FileInterface::ReadParameterS(const stringstream& sInp, int currentLocati
 
     for (unsigned int i = 0; i < Key.size(); ++i)
     {
-        streampos curPos(currentLocation);
-        Inp.seekg(curPos);
-        while (!Inp.eof())
+        if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key[i]))
         {
+            MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
             string tmp;
-            string ReadKey;
 
-            getline(Inp, tmp, '$');
-            if (Inp.eof())
-            {
-                break;
-            }
-
-            bool endReading = false;
-            for (unsigned int i = 0; i < tmp.size(); i++)
-            {
-                if (tmp.at(i) == '@')
-                {
-                    endReading = true;
-                    break;
-                }
-            }
-
-            if (endReading)
-                break;
-
-            Inp >> ReadKey;
-
-            if (!ReadKey.compare(Key[i]))
+            getline(Inp, tmp, ':');
+            getline(Inp, tFileName);
+            if (tmp.find_first_not_of(' ') == std::string::npos)
             {
-                getline(Inp, tmp, ':');
-                getline(Inp, tFileName);
-                if (tmp.find_first_not_of(' ') == std::string::npos)
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i], tFileName);
-                }
-                else
-                {
-                    tmp.erase(0, tmp.find_first_not_of(" \t"));
-                    tFileName.erase(0, tFileName.find_first_not_of(" \t"));
-                    ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, tFileName);
-                }
-                found = true;
-                break;
+                ConsoleOutput::WriteStandard("$" + Key[i], tFileName);
             }
+            else
+            {
+                tmp.erase(0, tmp.find_first_not_of(" \t"));
+                tFileName.erase(0, tFileName.find_first_not_of(" \t"));
+                ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, tFileName);
+            }
+            found = true;
         }
         if (found)
         {
@@ -1176,7 +1022,6 @@ string FileInterface::ReadParameterS(const stringstream& sInp, int currentLocati
         }
     }
 
-    Inp.clear();
     removeCarriageReturn(ReturnValue);
     return ReturnValue;
 }
@@ -1218,78 +1063,50 @@ vector<string> FileInterface::ReadParameterVS(const stringstream& sInp, int curr
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     vector<string> ReturnValue;
     string locString;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
-        string ReadKey;
-
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
-
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
-        {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
-        }
 
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        // Yet problem with blanks in name
+        getline(Inp, tmp, ':');
+        getline(Inp, locString);
+        std::transform(locString.begin(), locString.end(), locString.begin(), ::toupper);
+        locString = removeLeadingTrailingWhiteSpaces(locString);
+        locString = replacePunctuationMarksWithComma(locString);
+        string tmp2;
+        for(unsigned int i =0; i < locString.size(); i++)
         {
-            // Yet problem with blanks in name
-            getline(Inp, tmp, ':');
-            getline(Inp, locString);
-            std::transform(locString.begin(), locString.end(), locString.begin(), ::toupper);
-            locString = removeLeadingTrailingWhiteSpaces(locString);
-            locString = replacePunctuationMarksWithComma(locString);
-            string tmp2;
-            for(unsigned int i =0; i < locString.size(); i++)
-            {
-
-                if(locString[i] != ',')
-                {
-                    tmp2.push_back(locString[i]);
-                }
-                else
-                {
-                    ReturnValue.push_back(tmp2);
-                    tmp2.clear();
-                }
-            }
-            ReturnValue.push_back(tmp2);
 
-            if (tmp.find_first_not_of(' ') == std::string::npos)
+            if(locString[i] != ',')
             {
-                ConsoleOutput::WriteStandard("$" + Key, locString);
+                tmp2.push_back(locString[i]);
             }
             else
             {
-                tmp.erase(0, tmp.find_first_not_of(" \t"));
-                tmp.erase(tmp.find_last_not_of(" \t") + 1, tmp.size());
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, locString);
+                ReturnValue.push_back(tmp2);
+                tmp2.clear();
             }
-            found = true;
-            break;
         }
+        ReturnValue.push_back(tmp2);
+
+        if (tmp.find_first_not_of(' ') == std::string::npos)
+        {
+            ConsoleOutput::WriteStandard("$" + Key, locString);
+        }
+        else
+        {
+            tmp.erase(0, tmp.find_first_not_of(" \t"));
+            tmp.erase(tmp.find_last_not_of(" \t") + 1, tmp.size());
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, locString);
+        }
+        found = true;
     }
     if (not found)
     {
@@ -1308,7 +1125,6 @@ vector<string> FileInterface::ReadParameterVS(const stringstream& sInp, int curr
             }
         }
     }
-    Inp.clear();
     for (auto& it : ReturnValue) removeCarriageReturn(it);
     return ReturnValue;
 }
@@ -1320,68 +1136,40 @@ bool FileInterface::ReadParameterB(const stringstream& sInp, int currentLocation
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     bool ReturnValue = false;
     string Answer;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
+        getline(Inp, tmp, ':');
+        getline(Inp, Answer);
+
+        std::transform(Answer.begin(), Answer.end(), Answer.begin(), ::toupper);
+        //ReadKey.erase(std::remove(Answer.begin(), Answer.end(), ' '), Answer.end());
+
+        Answer.erase(0, Answer.find_first_not_of("YESNO") + 1);
+        if (Answer.find_last_of("YESNO") + 1 != Answer.size())
         {
-            break;
+            Answer.erase(Answer.find_last_of("YESNO") + 1, Answer.size());
         }
-
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        //Inp >> ReturnValue;
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, Answer);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            getline(Inp, Answer);
-
-            std::transform(Answer.begin(), Answer.end(), Answer.begin(), ::toupper);
-            //ReadKey.erase(std::remove(Answer.begin(), Answer.end(), ' '), Answer.end());
-
-            Answer.erase(0, Answer.find_first_not_of("YESNO") + 1);
-            if (Answer.find_last_of("YESNO") + 1 != Answer.size())
-            {
-                Answer.erase(Answer.find_last_of("YESNO") + 1, Answer.size());
-            }
-            //Inp >> ReturnValue;
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, Answer);
-            }
-            else
-            {
-                tmp.erase(0, tmp.find_first_not_of(" \t"));
-                tmp.erase(tmp.find_last_not_of(" \t") + 1, tmp.size());
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, Answer);
-            }
-            found = true;
-            break;
+            tmp.erase(0, tmp.find_first_not_of(" \t"));
+            tmp.erase(tmp.find_last_not_of(" \t") + 1, tmp.size());
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, Answer);
         }
+        found = true;
     }
     string tmp;
     for (unsigned int i = 0; i < Answer.size(); ++i)
@@ -1418,7 +1206,6 @@ bool FileInterface::ReadParameterB(const stringstream& sInp, int currentLocation
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -1429,7 +1216,7 @@ bool FileInterface::ReadParameterB(const stringstream& sInp, int currentLocation
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     bool ReturnValue = false;
@@ -1437,61 +1224,34 @@ bool FileInterface::ReadParameterB(const stringstream& sInp, int currentLocation
 
     for (unsigned int i = 0; i < Key.size(); ++i)
     {
-        streampos curPos(currentLocation);
-        Inp.seekg(curPos);
-        while (!Inp.eof())
+        if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key[i]))
         {
+            MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
             string tmp;
-            string ReadKey;
 
-            getline(Inp, tmp, '$');
-            if (Inp.eof())
+            getline(Inp, tmp, ':');
+            getline(Inp, Answer);
+
+            std::transform(Answer.begin(), Answer.end(), Answer.begin(), ::toupper);
+            //ReadKey.erase(std::remove(Answer.begin(), Answer.end(), ' '), Answer.end());
+
+            Answer.erase(0, Answer.find_first_not_of("YESNO") + 1);
+            if (Answer.find_last_of("YESNO") + 1 != Answer.size())
             {
-                break;
+                Answer.erase(Answer.find_last_of("YESNO") + 1, Answer.size());
             }
-
-            bool endReading = false;
-            for (unsigned int i = 0; i < tmp.size(); i++)
+            //Inp >> ReturnValue;
+            if (tmp.find_first_not_of(' ') == std::string::npos)
             {
-                if (tmp.at(i) == '@')
-                {
-                    endReading = true;
-                    break;
-                }
+                ConsoleOutput::WriteStandard("$" + Key[i], Answer);
             }
-
-            if (endReading)
-                break;
-
-            Inp >> ReadKey;
-
-            if (!ReadKey.compare(Key[i]))
+            else
             {
-                getline(Inp, tmp, ':');
-                getline(Inp, Answer);
-
-                std::transform(Answer.begin(), Answer.end(), Answer.begin(), ::toupper);
-                //ReadKey.erase(std::remove(Answer.begin(), Answer.end(), ' '), Answer.end());
-
-                Answer.erase(0, Answer.find_first_not_of("YESNO") + 1);
-                if (Answer.find_last_of("YESNO") + 1 != Answer.size())
-                {
-                    Answer.erase(Answer.find_last_of("YESNO") + 1, Answer.size());
-                }
-                //Inp >> ReturnValue;
-                if (tmp.find_first_not_of(' ') == std::string::npos)
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i], Answer);
-                }
-                else
-                {
-                    tmp.erase(0, tmp.find_first_not_of(" \t"));
-                    tmp.erase(tmp.find_last_not_of(" \t") + 1, tmp.size());
-                    ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, Answer);
-                }
-                found = true;
-                break;
+                tmp.erase(0, tmp.find_first_not_of(" \t"));
+                tmp.erase(tmp.find_last_not_of(" \t") + 1, tmp.size());
+                ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, Answer);
             }
+            found = true;
         }
         if (found)
         {
@@ -1534,7 +1294,6 @@ bool FileInterface::ReadParameterB(const stringstream& sInp, int currentLocation
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -1545,58 +1304,30 @@ string FileInterface::ReadParameterF(const stringstream& sInp, int currentLocati
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     string ReturnValue;
     string tFileName;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
+        getline(Inp, tmp, ':');
+        getline(Inp, tFileName);
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            break;
-        }
-
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
-        {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, tFileName);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            getline(Inp, tFileName);
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, tFileName);
-            }
-            else
-            {
-                tmp.erase(0, tmp.find_first_not_of(" \t"));
-                tFileName.erase(0, tFileName.find_first_not_of(" \t"));
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, tFileName);
-            }
-            found = true;
-            break;
+            tmp.erase(0, tmp.find_first_not_of(" \t"));
+            tFileName.erase(0, tFileName.find_first_not_of(" \t"));
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, tFileName);
         }
+        found = true;
     }
     //string tmp;
     //for (unsigned int i = 0; i < tFileName.size(); i++)
@@ -1620,7 +1351,6 @@ string FileInterface::ReadParameterF(const stringstream& sInp, int currentLocati
         }
     }
 
-    Inp.clear();
     removeCarriageReturn(ReturnValue);
     return ReturnValue;
 }
@@ -1632,7 +1362,7 @@ string FileInterface::ReadParameterF(const stringstream& sInp, int currentLocati
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     string ReturnValue;
@@ -1640,51 +1370,24 @@ string FileInterface::ReadParameterF(const stringstream& sInp, int currentLocati
 
     for (unsigned int i = 0; i < Key.size(); ++i)
     {
-        streampos curPos(currentLocation);
-        Inp.seekg(curPos);
-        while (!Inp.eof())
+        if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key[i]))
         {
+            MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
             string tmp;
-            string ReadKey;
-
-            getline(Inp, tmp, '$');
-            if (Inp.eof())
-            {
-                break;
-            }
 
-            bool endReading = false;
-            for (unsigned int i = 0; i < tmp.size(); i++)
+            getline(Inp, tmp, ':');
+            getline(Inp, tFileName);
+            if (tmp.find_first_not_of(' ') == std::string::npos)
             {
-                if (tmp.at(i) == '@')
-                {
-                    endReading = true;
-                    break;
-                }
+                ConsoleOutput::WriteStandard("$" + Key[i], tFileName);
             }
-
-            if (endReading)
-                break;
-
-            Inp >> ReadKey;
-
-            if (!ReadKey.compare(Key[i]))
+            else
             {
-                getline(Inp, tmp, ':');
-                getline(Inp, tFileName);
-                if (tmp.find_first_not_of(' ') == std::string::npos)
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i], tFileName);
-                }
-                else
-                {
-                    tmp.erase(0, tmp.find_first_not_of(" \t"));
-                    tFileName.erase(0, tFileName.find_first_not_of(" \t"));
-                    ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, tFileName);
-                }
-                found = true;
-                break;
+                tmp.erase(0, tmp.find_first_not_of(" \t"));
+                tFileName.erase(0, tFileName.find_first_not_of(" \t"));
+                ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, tFileName);
             }
+            found = true;
         }
         if (found)
         {
@@ -1714,7 +1417,6 @@ string FileInterface::ReadParameterF(const stringstream& sInp, int currentLocati
         }
     }
 
-    Inp.clear();
     removeCarriageReturn(ReturnValue);
     return ReturnValue;
 }
@@ -1726,58 +1428,30 @@ string FileInterface::ReadParameterFW(const stringstream& sInp, int currentLocat
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     string ReturnValue;
     string tFileName;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
-        string ReadKey;
-
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        getline(Inp, tmp, ':');
+        getline(Inp, tFileName);
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, tFileName);
         }
-
-        if (endReading)
-            break;
-        Inp >> noskipws;
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            getline(Inp, tFileName);
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, tFileName);
-            }
-            else
-            {
-                tmp.erase(0, tmp.find_first_not_of(" \t"));
-                tFileName.erase(0, tFileName.find_first_not_of(" \t"));
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, tFileName);
-            }
-            found = true;
-            break;
+            tmp.erase(0, tmp.find_first_not_of(" \t"));
+            tFileName.erase(0, tFileName.find_first_not_of(" \t"));
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, tFileName);
         }
+        found = true;
     }
     string tmp;
     for (unsigned int i = 0; i < tFileName.size(); i++)
@@ -1801,7 +1475,6 @@ string FileInterface::ReadParameterFW(const stringstream& sInp, int currentLocat
         }
     }
 
-    Inp.clear();
     removeCarriageReturn(ReturnValue);
     return ReturnValue;
 }
@@ -1813,7 +1486,7 @@ string FileInterface::ReadParameterFW(const stringstream& sInp, int currentLocat
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-        std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     string ReturnValue;
@@ -1821,51 +1494,24 @@ string FileInterface::ReadParameterFW(const stringstream& sInp, int currentLocat
 
     for (unsigned int i = 0; i < Key.size(); ++i)
     {
-        streampos curPos(currentLocation);
-        Inp.seekg(curPos);
-        while (!Inp.eof())
+        if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key[i]))
         {
+            MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
             string tmp;
-            string ReadKey;
-
-            getline(Inp, tmp, '$');
-            if (Inp.eof())
-            {
-                break;
-            }
 
-            bool endReading = false;
-            for (unsigned int i = 0; i < tmp.size(); i++)
+            getline(Inp, tmp, ':');
+            getline(Inp, tFileName);
+            if (tmp.find_first_not_of(' ') == std::string::npos)
             {
-                if (tmp.at(i) == '@')
-                {
-                    endReading = true;
-                    break;
-                }
+                ConsoleOutput::WriteStandard("$" + Key[i], tFileName);
             }
-
-            if (endReading)
-                break;
-            Inp >> noskipws;
-            Inp >> ReadKey;
-
-            if (!ReadKey.compare(Key[i]))
+            else
             {
-                getline(Inp, tmp, ':');
-                getline(Inp, tFileName);
-                if (tmp.find_first_not_of(' ') == std::string::npos)
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i], tFileName);
-                }
-                else
-                {
-                    tmp.erase(0, tmp.find_first_not_of(" \t"));
-                    tFileName.erase(0, tFileName.find_first_not_of(" \t"));
-                    ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, tFileName);
-                }
-                found = true;
-                break;
+                tmp.erase(0, tmp.find_first_not_of(" \t"));
+                tFileName.erase(0, tFileName.find_first_not_of(" \t"));
+                ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, tFileName);
             }
+            found = true;
         }
         if (found)
         {
@@ -1894,7 +1540,6 @@ string FileInterface::ReadParameterFW(const stringstream& sInp, int currentLocat
             }
         }
     }
-    Inp.clear();
     removeCarriageReturn(ReturnValue);
     return ReturnValue;
 }
@@ -1906,62 +1551,34 @@ int FileInterface::ReadParameterI(const stringstream& sInp, int currentLocation,
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     int ReturnValue = defaultval;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
         string tmp2;
-        string ReadKey;
 
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
+        getline(Inp, tmp, ':');
+        getline(Inp, tmp2);
+        tmp = removeLeadingTrailingWhiteSpaces(tmp);
+        tmp2 = removeAllWhiteSpaces(tmp2);
+
+        // Transfer string tmp2 to int (and check if this is possible at all)
+        ReturnValue = StringToInt(tmp2, Key, Entry->Line);
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        if (tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, ReturnValue);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if (!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            getline(Inp, tmp2);
-            tmp = removeLeadingTrailingWhiteSpaces(tmp);
-            tmp2 = removeAllWhiteSpaces(tmp2);
-
-            // Transfer string tmp2 to int (and check if this is possible at all)
-            ReturnValue = StringToInt(tmp2, tmp);
-
-            if (tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, ReturnValue);
-            }
-            else
-            {
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue);
-            }
-            found = true;
-            break;
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue);
         }
+        found = true;
     }
 
     if (not found)
@@ -1981,7 +1598,6 @@ int FileInterface::ReadParameterI(const stringstream& sInp, int currentLocation,
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -1992,63 +1608,36 @@ int FileInterface::ReadParameterI(const stringstream& sInp, int currentLocation,
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     int ReturnValue = defaultval;
 
     for (unsigned int i = 0; i < Key.size(); ++i)
     {
-        streampos curPos(currentLocation);
-        Inp.seekg(curPos);
-        while (!Inp.eof())
+        if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key[i]))
         {
+            MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
             string tmp;
             string tmp2;
-            string ReadKey;
 
-            getline(Inp, tmp, '$');
-            if (Inp.eof())
-            {
-                break;
-            }
+            getline(Inp, tmp, ':');
+            getline(Inp, tmp2);
+            tmp = removeLeadingTrailingWhiteSpaces(tmp);
+            tmp2 = removeAllWhiteSpaces(tmp2);
 
-            bool endReading = false;
-            for (unsigned int i = 0; i < tmp.size(); i++)
+            // Transfer string tmp2 to int (and check if this is possible at all)
+            ReturnValue = StringToInt(tmp2, Key[i], Entry->Line);
+
+            if (tmp.find_first_not_of(' ') == std::string::npos)
             {
-                if (tmp.at(i) == '@')
-                {
-                    endReading = true;
-                    break;
-                }
+                ConsoleOutput::WriteStandard("$" + Key[i], ReturnValue);
             }
-
-            if (endReading)
-                break;
-
-            Inp >> ReadKey;
-
-            if (!ReadKey.compare(Key[i]))
+            else
             {
-                getline(Inp, tmp, ':');
-                getline(Inp, tmp2);
-                tmp = removeLeadingTrailingWhiteSpaces(tmp);
-                tmp2 = removeAllWhiteSpaces(tmp2);
-
-                // Transfer string tmp2 to int (and check if this is possible at all)
-                ReturnValue = StringToInt(tmp2, tmp);
-
-                if (tmp.find_first_not_of(' ') == std::string::npos)
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i], ReturnValue);
-                }
-                else
-                {
-                    ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, ReturnValue);
-                }
-                found = true;
-                break;
+                ConsoleOutput::WriteStandard("$" + Key[i] + "\t" + tmp, ReturnValue);
             }
+            found = true;
         }
         if (found)
         {
@@ -2073,7 +1662,6 @@ int FileInterface::ReadParameterI(const stringstream& sInp, int currentLocation,
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -2084,56 +1672,28 @@ char FileInterface::ReadParameterC(const stringstream& sInp, int currentLocation
     // mandatory: if parameter not found, program will stop (default: true = mandatory)
     // defaultval: if parameter not found and not mandatory, method returns defaultval
 
-    std::stringstream Inp(sInp.str());
-
-    streampos curPos(currentLocation);
-    Inp.seekg(curPos);
+    std::shared_ptr<const InputIndex> Index = InputIndex::Get(sInp);
 
     bool found = false;
     char ReturnValue;
 
-    while (!Inp.eof())
+    if (const InputIndex::Entry* Entry = Index->Find(currentLocation, Key))
     {
+        MemoryStream Inp(Index->Text.data() + Entry->KeyEnd, Index->Text.size() - Entry->KeyEnd);
         string tmp;
-        string ReadKey;
-
-        getline(Inp, tmp, '$');
-        if (Inp.eof())
-        {
-            break;
-        }
 
-        bool endReading = false;
-        for (unsigned int i = 0; i < tmp.size(); i++)
+        getline(Inp, tmp, ':');
+        Inp >> ReturnValue;
+        if(tmp.find_first_not_of(' ') == std::string::npos)
         {
-            if (tmp.at(i) == '@')
-            {
-                endReading = true;
-                break;
-            }
+            ConsoleOutput::WriteStandard("$" + Key, tmp);
         }
-
-        if (endReading)
-            break;
-
-        Inp >> ReadKey;
-
-        if(!ReadKey.compare(Key))
+        else
         {
-            getline(Inp, tmp, ':');
-            Inp >> ReturnValue;
-            if(tmp.find_first_not_of(' ') == std::string::npos)
-            {
-                ConsoleOutput::WriteStandard("$" + Key, tmp);
-            }
-            else
-            {
-                tmp.erase(0,tmp.find_first_not_of(" \t"));
-                ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue);
-            }
-            found = true;
-            break;
+            tmp.erase(0,tmp.find_first_not_of(" \t"));
+            ConsoleOutput::WriteStandard("$" + Key + "\t" + tmp, ReturnValue);
         }
+        found = true;
     }
 
     if(not found)
@@ -2153,7 +1713,6 @@ char FileInterface::ReadParameterC(const stringstream& sInp, int currentLocation
             }
         }
     }
-    Inp.clear();
     return ReturnValue;
 }
 
@@ -30,12 +30,16 @@
 #include "FluidDynamics/BenziGas.h"
 #include "FluidDynamics/D3Q27.h"
 #include "FluidDynamics/FlowSolverLBM.h"
+#include "FluidDynamics/LBLattices.h"
 #include "FluidDynamics/VanDerWaalsGas.h"
 #include "PhaseField.h"
 #include "Settings.h"
 #include "Temperature.h"
 #include "VTK.h"
 #include "Velocities.h"
+#include "LoadBalancer.h"
+#include "Tools/ReductionBatch.h"
+#include "Tools/LossyCompression.h"
 
 namespace openphase
 {
@@ -108,6 +112,7 @@ void FlowSolverLBM::Initialize(Settings& locSettings, std::stringstream& inp, do
     cs2 = lbcs2*Grid.dx*Grid.dx/dt/dt;
 
     ObstaclesChanged = false;
+    InvalidateFluidNodes();
 
     Bcells = Grid.Bcells;
     ElementNames = locSettings.ElementNames;
@@ -121,11 +126,10 @@ void FlowSolverLBM::Initialize(Settings& locSettings, std::stringstream& inp, do
     ForceDensity.Allocate           (Grid, {N_Fluid_Comp}, Bcells);
     MomentumDensity.Allocate        (Grid, {N_Fluid_Comp}, Bcells);
     lbPopulations.Allocate          (Grid, {N_Fluid_Comp}, Bcells);
+    if (not InPlaceStreaming)
     lbPopulationsTMP.Allocate       (Grid, {N_Fluid_Comp}, Bcells);
-    nut.Allocate                    (Grid, {N_Fluid_Comp}, Bcells);
-    HydroPressure.Allocate          (Grid, {N_Fluid_Comp}, Bcells);
-    DivVel.Allocate                 (Grid, {N_Fluid_Comp}, Bcells);
-    GradRho.Allocate                (Grid, {N_Fluid_Comp}, Bcells);
+    if (Do_ThermalComp)
+    AllocateThermalCompressibility();
     
     switch(Grid.Active())
     {
@@ -155,8 +159,16 @@ void FlowSolverLBM::Initialize(Settings& locSettings, std::stringstream& inp, do
             for(int jj = 0; jj < 3; jj++)
             for(int kk = 0; kk < 3; kk++)
             {
-                lbWeights[ii][jj][kk] = LBStencil3D[ii][jj][kk];
+                lbWeights[ii][jj][kk] = (Lattice == "D3Q27") ? LBStencil3D[ii][jj][kk] : 0.0;
             }
+            /* Velocities of the reduced lattices keep zero weight, their
+            populations stay zero and are skipped in the neighbour loops of
+            streaming and of the moment calculation. The nodes still hold all
+            27 populations, which are cleared, copied and collided as before,
+            so the reduced lattices change the velocity set but neither the
+            memory nor the memory traffic per cell.*/
+            if (Lattice == "D3Q19") SetLatticeWeights<D3Q19Lattice>(lbWeights);
+            if (Lattice == "D3Q15") SetLatticeWeights<D3Q15Lattice>(lbWeights);
             break;
         }
         default:
@@ -164,6 +176,9 @@ void FlowSolverLBM::Initialize(Settings& locSettings, std::stringstream& inp, do
 
         }
     }
+#ifdef SINGLE_PRECISION_POPULATIONS
+    D3Q27Shifted::SetShift(lbWeights);
+#endif
 
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,DensityWetting.Bcells(),)
     {
@@ -175,12 +190,10 @@ void FlowSolverLBM::Initialize(Settings& locSettings, std::stringstream& inp, do
         for (size_t n = 0; n < N_Fluid_Comp; ++n)
         {
             DensityWetting   (i,j,k,{n}) = 0.0;
-            HydroPressure    (i,j,k,{n}) = 0.0;
-            DivVel           (i,j,k,{n}) = 0.0;
-            GradRho          (i,j,k,{n}).set_to_zero();
             ForceDensity     (i,j,k,{n}).set_to_zero();
             MomentumDensity  (i,j,k,{n}).set_to_zero();
             lbPopulations    (i,j,k,{n}).set_to_zero();
+            if (not InPlaceStreaming)
             lbPopulationsTMP (i,j,k,{n}).set_to_zero();
         }
     }
@@ -190,6 +203,7 @@ void FlowSolverLBM::Initialize(Settings& locSettings, std::stringstream& inp, do
 
     locSettings.AddForAdvection(*this);
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
     locSettings.AddForReading(*this);
 
     initialized = true;
@@ -238,6 +252,15 @@ void FlowSolverLBM::ReadInput(std::stringstream& inp)
     Do_Kupershtokh           = FileInterface::ReadParameterB(inp, moduleLocation, std::string("KUPERSHTOKH"), false, false);
     Do_ThermalComp           = FileInterface::ReadParameterB(inp, moduleLocation, std::string("THERMALCOMP"), false, false);
     Do_DI          			 = FileInterface::ReadParameterB(inp, moduleLocation, std::string("Diffuse_Interface"), false, false);
+    InPlaceStreaming         = FileInterface::ReadParameterB(inp, moduleLocation, std::string("InPlaceStreaming"), false, false);
+    SparseFluidNodes         = FileInterface::ReadParameterB(inp, moduleLocation, std::string("SparseFluidNodes"), false, false);
+    Offload                  = FileInterface::ReadParameterB(inp, moduleLocation, std::string("Offload"), false, false);
+    Lattice                  = FileInterface::ReadParameterK(inp, moduleLocation, std::string("Lattice"), false, "D3Q27");
+    if (Lattice != "D3Q27" and Lattice != "D3Q19" and Lattice != "D3Q15")
+    {
+        ConsoleOutput::WriteExit("Unknown lattice \"" + Lattice + "\", use D3Q27, D3Q19 or D3Q15", thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
     FluidRedistributionRange = FileInterface::ReadParameterI(inp, moduleLocation, std::string("FluidRedistributionRange"), false, 1);
     ParaKuper                = FileInterface::ReadParameterD(inp, moduleLocation, std::string("ParaKuper"), false, -0.0152);
     h_star                   = FileInterface::ReadParameterD(inp, moduleLocation, std::string("H_STAR"), Do_Drag, 0.0);
@@ -478,6 +501,24 @@ void FlowSolverLBM::Update_dt(double _dt)
     }
 }
 
+size_t FlowSolverLBM::AllocatedMemory(void) const
+{
+    return lbPopulations.AllocatedMemory() +
+           lbPopulationsTMP.AllocatedMemory() +
+           Obstacle.AllocatedMemory() +
+           ObstacleAppeared.AllocatedMemory() +
+           ObstacleChangedDensity.AllocatedMemory() +
+           ObstacleVanished.AllocatedMemory() +
+           ForceDensity.AllocatedMemory() +
+           MomentumDensity.AllocatedMemory() +
+           DensityWetting.AllocatedMemory() +
+           nut.AllocatedMemory() +
+           HydroPressure.AllocatedMemory() +
+           DivVel.AllocatedMemory() +
+           GradRho.AllocatedMemory() +
+           InteractionPotential.AllocatedMemory();
+}
+
 void FlowSolverLBM::Remesh(int newNx, int newNy, int newNz,
                            const BoundaryConditions& BC)
 {
@@ -488,7 +529,68 @@ void FlowSolverLBM::Remesh(int newNx, int newNy, int newNz,
     MomentumDensity .Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
     ForceDensity    .Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
     lbPopulations   .Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    if (lbPopulationsTMP.IsAllocated())
     lbPopulationsTMP.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    if (InteractionPotential.IsAllocated())
+    InteractionPotential.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    InvalidateFluidNodes();
+    Device.Release(); // Reallocated and filled in the next Solve()
+}
+
+void FlowSolverLBM::Repartition(const BoundaryConditions& BC)
+{
+    const GridParameters OldGrid = Grid;
+    Grid.ApplyCutPlanes();
+
+    LoadBalancer::Migrate(lbPopulations,   OldGrid, Grid);
+    LoadBalancer::Migrate(DensityWetting,  OldGrid, Grid);
+    LoadBalancer::Migrate(MomentumDensity, OldGrid, Grid);
+    LoadBalancer::Migrate(ForceDensity,    OldGrid, Grid);
+    LoadBalancer::Migrate(Obstacle,        OldGrid, Grid);
+
+    if(lbPopulationsTMP.IsAllocated())       lbPopulationsTMP.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    if(ObstacleAppeared.IsAllocated())       ObstacleAppeared.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    if(ObstacleChangedDensity.IsAllocated()) ObstacleChangedDensity.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    if(ObstacleVanished.IsAllocated())       ObstacleVanished.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    if(nut.IsAllocated())                    LoadBalancer::Migrate(nut, OldGrid, Grid);
+    if(HydroPressure.IsAllocated())          LoadBalancer::Migrate(HydroPressure, OldGrid, Grid);
+    if(DivVel.IsAllocated())                 DivVel.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    if(GradRho.IsAllocated())                GradRho.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    if(InteractionPotential.IsAllocated())   InteractionPotential.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+
+    InvalidateFluidNodes();
+    Device.Release(); // Reallocated and filled in the next Solve()
+    SetBoundaryConditions(BC);
+}
+
+void FlowSolverLBM::AllocateTemporaryPopulations(void)
+{
+    if (lbPopulationsTMP.IsNotAllocated())
+    {
+        lbPopulationsTMP.Allocate(Grid, {N_Fluid_Comp}, Bcells);
+    }
+}
+
+void FlowSolverLBM::AllocateThermalCompressibility(void)
+{
+    if (nut.IsNotAllocated())
+    {
+        nut          .Allocate(Grid, {N_Fluid_Comp}, Bcells);
+        HydroPressure.Allocate(Grid, {N_Fluid_Comp}, Bcells);
+        DivVel       .Allocate(Grid, {N_Fluid_Comp}, Bcells);
+        GradRho      .Allocate(Grid, {N_Fluid_Comp}, Bcells);
+
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,nut,nut.Bcells(),)
+        for (size_t n = 0; n < N_Fluid_Comp; ++n)
+        {
+            HydroPressure(i,j,k,{n}) = 0.0;
+            DivVel       (i,j,k,{n}) = 0.0;
+            GradRho      (i,j,k,{n}).set_to_zero();
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+
+        ConsoleOutput::WriteStandard(thisclassname, "Allocated nut, HydroPressure, DivVel, GradRho");
+    }
 }
 
 bool FlowSolverLBM::Read(const Settings& locSettings, const BoundaryConditions& BC, const int tStep)
@@ -553,33 +655,75 @@ bool FlowSolverLBM::Read(const Settings& locSettings, const BoundaryConditions&
 #endif
     }
 
-    STORAGE_LOOP_BEGIN(i,j,k,lbPopulations,0)
+    const size_t Npop = (2*Grid.dNx + 1)*(2*Grid.dNy + 1)*(2*Grid.dNz + 1);
+    std::vector<double> values;
+    if(LossyCompression::Read(inp, values))
     {
-        for(size_t n = 0; n < N_Fluid_Comp; ++n)
-        for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
-        for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
-        for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+        if(values.size() != Grid.LocalNumberOfCells()*N_Fluid_Comp*Npop) return false;
+        size_t idx = 0;
+        STORAGE_LOOP_BEGIN(i,j,k,lbPopulations,0)
         {
-            inp.read(reinterpret_cast<char*>(&lbPopulations(i,j,k,{n})(ii,jj,kk)), sizeof(double));
+            for(size_t n = 0; n < N_Fluid_Comp; ++n)
+            for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
+            for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
+            for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+            {
+                lbPopulations(i,j,k,{n})(ii,jj,kk) = values[idx++];
+            }
         }
-    }
-    STORAGE_LOOP_END
+        STORAGE_LOOP_END
 
-    STORAGE_LOOP_BEGIN(i,j,k,ForceDensity,0)
+        if(not LossyCompression::Read(inp, values) or
+           values.size() != Grid.LocalNumberOfCells()*N_Fluid_Comp*3) return false;
+        idx = 0;
+        STORAGE_LOOP_BEGIN(i,j,k,ForceDensity,0)
+        {
+            for(size_t n = 0; n < N_Fluid_Comp; ++n)
+            for(int m = 0; m < 3; ++m)
+            {
+                ForceDensity(i,j,k,{n})[m] = values[idx++];
+            }
+        }
+        STORAGE_LOOP_END
+    }
+    else
     {
-        for(size_t n = 0; n < N_Fluid_Comp; ++n)
-        for(int m = 0; m < 3; ++m)
+        STORAGE_LOOP_BEGIN(i,j,k,lbPopulations,0)
         {
-            inp.read(reinterpret_cast<char*>(&ForceDensity(i,j,k,{n})[m]), sizeof(double));
+            for(size_t n = 0; n < N_Fluid_Comp; ++n)
+            for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
+            for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
+            for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+            {
+                double value = 0.0;
+                inp.read(reinterpret_cast<char*>(&value), sizeof(double));
+                lbPopulations(i,j,k,{n})(ii,jj,kk) = value;
+            }
         }
+        STORAGE_LOOP_END
+
+        STORAGE_LOOP_BEGIN(i,j,k,ForceDensity,0)
+        {
+            for(size_t n = 0; n < N_Fluid_Comp; ++n)
+            for(int m = 0; m < 3; ++m)
+            {
+                inp.read(reinterpret_cast<char*>(&ForceDensity(i,j,k,{n})[m]), sizeof(double));
+            }
+        }
+        STORAGE_LOOP_END
     }
-    STORAGE_LOOP_END
 
     STORAGE_LOOP_BEGIN(i,j,k,Obstacle,0)
     {
         inp.read(reinterpret_cast<char*>(&Obstacle(i,j,k)), sizeof(bool));
     }
     STORAGE_LOOP_END
+    InvalidateFluidNodes();
+    if (Device.IsAllocated())
+    {
+        Device.CopyPopulationsToDevice(lbPopulations);
+        Device.CopyObstacleToDevice(Obstacle);
+    }
 
     CalculateDensityAndMomentum();
     SetBoundaryConditions(BC);
@@ -626,29 +770,73 @@ bool FlowSolverLBM::Write(const Settings& locSettings, const int tStep) const
     out.write(reinterpret_cast<const char*>(&Grid.Nz),           sizeof(int));
     out.write(reinterpret_cast<const char*>(&N_Fluid_Comp), sizeof(size_t));
 
-    STORAGE_LOOP_BEGIN(i,j,k,lbPopulations,0)
+    // With Offload the current populations are on the device
+    Storage3D<lbnode_t,1> DevicePopulations;
+    if (Device.IsAllocated())
     {
-        for(size_t n = 0; n < N_Fluid_Comp; ++n)
-        for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
-        for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
-        for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+        DevicePopulations = lbPopulations;
+        Device.CopyPopulationsToHost(DevicePopulations);
+    }
+    const Storage3D<lbnode_t,1>& locPopulations = Device.IsAllocated() ? DevicePopulations : lbPopulations;
+
+    const size_t Npop = (2*Grid.dNx + 1)*(2*Grid.dNy + 1)*(2*Grid.dNz + 1);
+    if(locSettings.CheckpointTolerance > 0.0)
+    {
+        /* Error bounded compression of the populations and forces, the
+        obstacle flags are stored losslessly, see Tools/LossyCompression.h */
+        std::vector<double> values;
+        values.reserve(Grid.LocalNumberOfCells()*N_Fluid_Comp*Npop);
+        STORAGE_LOOP_BEGIN(i,j,k,locPopulations,0)
         {
-            const double value = lbPopulations(i,j,k,{n})(ii,jj,kk);
-            out.write(reinterpret_cast<const char*>(&value), sizeof(double));
+            for(size_t n = 0; n < N_Fluid_Comp; ++n)
+            for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
+            for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
+            for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+            {
+                values.push_back(locPopulations(i,j,k,{n})(ii,jj,kk));
+            }
         }
-    }
-    STORAGE_LOOP_END
+        STORAGE_LOOP_END
+        LossyCompression::Write(out, values, locSettings.CheckpointTolerance, N_Fluid_Comp*Npop);
 
-    STORAGE_LOOP_BEGIN(i,j,k,ForceDensity,0)
+        values.clear();
+        STORAGE_LOOP_BEGIN(i,j,k,ForceDensity,0)
+        {
+            for(size_t n = 0; n < N_Fluid_Comp; ++n)
+            for(int m = 0; m < 3; ++m)
+            {
+                values.push_back(ForceDensity(i,j,k,{n})[m]);
+            }
+        }
+        STORAGE_LOOP_END
+        LossyCompression::Write(out, values, locSettings.CheckpointTolerance, N_Fluid_Comp*3);
+    }
+    else
     {
-        for(size_t n = 0; n < N_Fluid_Comp; ++n)
-        for(int m = 0; m < 3; ++m)
+        STORAGE_LOOP_BEGIN(i,j,k,locPopulations,0)
+        {
+            for(size_t n = 0; n < N_Fluid_Comp; ++n)
+            for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
+            for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
+            for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+            {
+                const double value = locPopulations(i,j,k,{n})(ii,jj,kk);
+                out.write(reinterpret_cast<const char*>(&value), sizeof(double));
+            }
+        }
+        STORAGE_LOOP_END
+
+        STORAGE_LOOP_BEGIN(i,j,k,ForceDensity,0)
         {
-            const double value = ForceDensity(i,j,k,{n})[m];
-            out.write(reinterpret_cast<const char*>(&value), sizeof(double));
+            for(size_t n = 0; n < N_Fluid_Comp; ++n)
+            for(int m = 0; m < 3; ++m)
+            {
+                const double value = ForceDensity(i,j,k,{n})[m];
+                out.write(reinterpret_cast<const char*>(&value), sizeof(double));
+            }
         }
+        STORAGE_LOOP_END
     }
-    STORAGE_LOOP_END
 
     STORAGE_LOOP_BEGIN(i,j,k,Obstacle,0)
     {
@@ -698,6 +886,11 @@ void FlowSolverLBM::SetBoundaryConditions(const BoundaryConditions& BC)
     BC.SetYVector(lbPopulations);
     BC.SetZVector(lbPopulations);
 
+    SetMacroscopicBoundaryConditions(BC);
+}
+
+void FlowSolverLBM::SetMacroscopicBoundaryConditions(const BoundaryConditions& BC)
+{
     BC.SetX(DensityWetting);
     BC.SetY(DensityWetting);
     BC.SetZ(DensityWetting);
@@ -707,8 +900,55 @@ void FlowSolverLBM::SetBoundaryConditions(const BoundaryConditions& BC)
     BC.SetZVector(MomentumDensity);
 }
 
+void FlowSolverLBM::CalculateInteractionPotential(void)
+{
+    /* The potential of a cell enters the forces of all its neighbors, it is
+    evaluated once per cell instead of once per neighbor direction. Only
+    cells which are fluid or neighbor a fluid cell of the local domain are
+    evaluated, the density (wetting parameter) deep inside obstacles is not
+    a valid argument of the equation of state. */
+    if (InteractionPotential.IsNotAllocated())
+    {
+        InteractionPotential.Allocate(Grid, {N_Fluid_Comp}, Bcells);
+    }
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,InteractionPotential,1,)
+    {
+        bool needed = false;
+        for(int ii = -Grid.dNx; ii <= Grid.dNx and not needed; ++ii)
+        for(int jj = -Grid.dNy; jj <= Grid.dNy and not needed; ++jj)
+        for(int kk = -Grid.dNz; kk <= Grid.dNz and not needed; ++kk)
+        if (i+ii >= 0 and i+ii < Grid.Nx and
+            j+jj >= 0 and j+jj < Grid.Ny and
+            k+kk >= 0 and k+kk < Grid.Nz)
+        {
+            needed = !Obstacle(i+ii,j+jj,k+kk);
+        }
+
+        for (size_t n = 0; n < N_Fluid_Comp; ++n)
+        {
+            double potential = 0.0;
+            if (needed)
+            {
+                if (Do_Benzi)
+                {
+                    potential = psi(DensityWetting(i,j,k,{n}), rho_0[n]);
+                }
+                else if (Do_Kupershtokh)
+                {
+                    // Evaluate equation of state (Van der Waals)
+                    const double p = VanDerWaalsGas::ReducedPressure(DensityWetting(i,j,k,{n})/dRho, lbTemperature[n], CriticalDensity[n]/dRho, lbCriticalTemperature[n]);
+                    potential = Phi(DensityWetting(i,j,k,{n})/dRho, p, GasParameter[n]);
+                }
+            }
+            InteractionPotential(i,j,k,{n}) = potential;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
 void FlowSolverLBM::CalculateForceTwoPhase(const int i, const int j,
-        const int k, PhaseField& Phase)
+        const int k, PhaseField& Phase, Tensor<sum_vector3_t,2>& GrainForces)
 {
     for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
     for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
@@ -724,7 +964,7 @@ void FlowSolverLBM::CalculateForceTwoPhase(const int i, const int j,
             {
                 // Benzi et. al. (2006) - Mesoscopic modeling of a two-phase flow
                 // in the presence of boundaries
-                tmp = - Gb[n][m]/dRho * psi(DensityWetting(i,j,k,{n}), rho_0[n]) * lbWeights[ii+1][jj+1][kk+1] * psi(DensityWetting(i+ii,j+jj,k+kk,{m}), rho_0[m]);
+                tmp = - Gb[n][m]/dRho * InteractionPotential(i,j,k,{n}) * lbWeights[ii+1][jj+1][kk+1] * InteractionPotential(i+ii,j+jj,k+kk,{m});
             }
             else if (Do_Kupershtokh)
             {
@@ -732,13 +972,9 @@ void FlowSolverLBM::CalculateForceTwoPhase(const int i, const int j,
                 // Kupershtokh, Medvedev and Karpov, 2009, On equations of state in a lattice Boltzmann method
                 // Kupershtokh, Medvedev and Gribanov, 2017, Thermal lattice Boltzmann method for multiphase flows
 
-                // Evaluate equation of state (Van der Waals)
-                const double p_000 = VanDerWaalsGas::ReducedPressure(DensityWetting(i   ,j   ,k   ,{n})/dRho, lbTemperature[n], CriticalDensity[n]/dRho, lbCriticalTemperature[n]);
-                const double p_ijk = VanDerWaalsGas::ReducedPressure(DensityWetting(i+ii,j+jj,k+kk,{m})/dRho, lbTemperature[m], CriticalDensity[m]/dRho, lbCriticalTemperature[m]);
-
-                // Calculate interaction potential
-                const double Phi_000 = Phi(DensityWetting(i,   j,   k   ,{n})/dRho, p_000, GasParameter[n]);
-                const double Phi_ijk = Phi(DensityWetting(i+ii,j+jj,k+kk,{m})/dRho, p_ijk, GasParameter[m]);
+                // Interaction potentials from the equation of state (Van der Waals)
+                const double Phi_000 = InteractionPotential(i,   j,   k   ,{n});
+                const double Phi_ijk = InteractionPotential(i+ii,j+jj,k+kk,{m});
 
                 // Interpolate between both way
                 tmp = 6.0*lbWeights[ii+1][jj+1][kk+1]*lbGK[n][m]*(ParaKuper*(Phi_ijk*Phi_ijk) + (1.0-2.0*ParaKuper)*(Phi_000*Phi_ijk));
@@ -759,13 +995,8 @@ void FlowSolverLBM::CalculateForceTwoPhase(const int i, const int j,
                     CalculateDistancePeriodic(pos, grain.Rcm, distanceCM, Grid.Nx, Grid.Ny, Grid.Nz);
                     const dVector3 R = distanceCM * Grid.dx;
 
-                    #ifdef _OPENMP
-                    #pragma omp critical
-                    #endif
-                    {
-                        grain.Force  -= BenziForceDensity * Grid.CellVolume(true);
-                        grain.Torque -= R.cross(BenziForceDensity) * Grid.CellVolume(true);
-                    }
+                    GrainForces({it.index,0}) -= BenziForceDensity * Grid.CellVolume(true);
+                    GrainForces({it.index,1}) -= R.cross(BenziForceDensity) * Grid.CellVolume(true);
                 }
             }
         }
@@ -801,7 +1032,7 @@ void FlowSolverLBM::AcountForAndLimitPhaseTransformation(PhaseField& Phase, int
     }
 
     if (Do_TwoPhase)
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,Phase.Occupancy,)
     if(Phase.Fields(i,j,k).wide_interface())
     {
         double locDensity = DensityWetting(i,j,k,{0});
@@ -842,7 +1073,7 @@ void FlowSolverLBM::AcountForAndLimitPhaseTransformation(PhaseField& Phase, int
         DensityWetting(i,j,k,{0}) -= locDensityChange;
         lbPopulations (i,j,k,{0}) = EquilibriumDistribution(DensityWetting(i,j,k,{0})/dRho, lbWeights, MomentumDensity(i,j,k,{0})/dm);
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
 }
 
 void FlowSolverLBM::CalculateForceGravity(PhaseField& Phase)
@@ -895,6 +1126,8 @@ void FlowSolverLBM::CalculateDensityTC(Temperature& Tx, Composition& Cx, const B
     double R= PhysicalConstants::R;     ///<  Universal gas constant  j/mol k
     double Rm=R/AW_air;             ///< gas constant for air j/kg k
 
+    AllocateThermalCompressibility();
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,DensityWetting.Bcells(),)
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
@@ -921,6 +1154,8 @@ double FlowSolverLBM::CalculateIdealGasDensity(double p, double Rm, double Temp)
 
 void FlowSolverLBM::SetInitialPopulationsTC(BoundaryConditions& BC, Velocities& Vel)
 {
+    AllocateThermalCompressibility();
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,HydroPressure,HydroPressure.Bcells(),)
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
@@ -931,7 +1166,7 @@ void FlowSolverLBM::SetInitialPopulationsTC(BoundaryConditions& BC, Velocities&
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,DensityWetting.Bcells(),)
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
-        dVector3 lbvel      = Vel.Phase(i,j,k,{n})/dv;
+        dVector3 lbvel      = Vel.Phase.get(i,j,k,n)/dv;
     	dVector3 lbFb       = ForceDensity(i,j,k,{n})/df;
     	dVector3 lbGradRho  = GradRho(i,j,k,{n})*Grid.dx;
         double lbnu         = nut(i,j,k,{n})/dnu;
@@ -972,7 +1207,7 @@ void FlowSolverLBM::CalculateDensityGradient(PhaseField& Phase, Velocities& Vel)
                 if (Phase.FieldsProperties[it->index].State != AggregateStates::Solid)
                 {
                     size_t PhaseIdx = Phase.FieldsProperties[it->index].Phase;
-                    v = Vel.Phase(i,j,k,{PhaseIdx})[direction] ;
+                    v = Vel.Phase.get(i,j,k,PhaseIdx)[direction] ;
                 }
                 double Rho   = DensityWetting(i,j,k,{n});
                 double Rhop  = DensityWetting(ip,jp,kp,{n});
@@ -1068,7 +1303,7 @@ void FlowSolverLBM::CollisionTC( Velocities& Vel)
     if (!Obstacle(i,j,k))
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
-        dVector3 lbvel      = Vel.Phase(i,j,k,{n})/dv;
+        dVector3 lbvel      = Vel.Phase.get(i,j,k,n)/dv;
         dVector3 lbFb       = ForceDensity(i,j,k,{n})/df;
         dVector3 lbGradRho  = GradRho(i,j,k,{n})*Grid.dx;
         double lbu2         = lbvel[0]*lbvel[0]+lbvel[1]*lbvel[1]+lbvel[2]*lbvel[2];
@@ -1219,17 +1454,17 @@ void FlowSolverLBM::SetPressureOutlet(Velocities& Vel, const PhaseField& Phase,
                     double Pbmold  = HydroPressure(i-1,j,k,{n});
                     double Pbmmold = HydroPressure(i-2,j,k,{n});
 
-                    double uxbold  = Vel.Phase(i,j,k,{n})[0];
-                    double uxbmold = Vel.Phase(i-1,j,k,{n})[0];
-                    double uxbmmold= Vel.Phase(i-2,j,k,{n})[0];
+                    double uxbold  = Vel.Phase.get(i,j,k,n)[0];
+                    double uxbmold = Vel.Phase.get(i-1,j,k,n)[0];
+                    double uxbmmold= Vel.Phase.get(i-2,j,k,n)[0];
 
-                    double uybold  = Vel.Phase(i,j,k,{n})[1];
-                    double uybmold = Vel.Phase(i-1,j,k,{n})[1];
-                    double uybmmold= Vel.Phase(i-2,j,k,{n})[1];
+                    double uybold  = Vel.Phase.get(i,j,k,n)[1];
+                    double uybmold = Vel.Phase.get(i-1,j,k,n)[1];
+                    double uybmmold= Vel.Phase.get(i-2,j,k,n)[1];
 
-                    double uzbold  = Vel.Phase(i,j,k,{n})[2];
-                    double uzbmold = Vel.Phase(i-1,j,k,{n})[2];
-                    double uzbmmold= Vel.Phase(i-2,j,k,{n})[2];
+                    double uzbold  = Vel.Phase.get(i,j,k,n)[2];
+                    double uzbmold = Vel.Phase.get(i-1,j,k,n)[2];
+                    double uzbmmold= Vel.Phase.get(i-2,j,k,n)[2];
 
                     double rhob = DensityWetting(i,j,k,{n});
                     double rhobm= DensityWetting(i-1,j,k,{n});
@@ -1351,13 +1586,13 @@ void FlowSolverLBM::Set1DNonReflectingPressureOutletatBCXN(Velocities& Vel, cons
                     double Pbmold  = HydroPressure(i-1,j,k,{n});
                     double Pbmmold = HydroPressure(i-2,j,k,{n});
 
-                    double uxbold  = Vel.Phase(i,j,k,{n})[0];
-                    double uxbmold = Vel.Phase(i-1,j,k,{n})[0];
-                    double uxbmmold= Vel.Phase(i-2,j,k,{n})[0];
+                    double uxbold  = Vel.Phase.get(i,j,k,n)[0];
+                    double uxbmold = Vel.Phase.get(i-1,j,k,n)[0];
+                    double uxbmmold= Vel.Phase.get(i-2,j,k,n)[0];
 
-                    double uzbold  = Vel.Phase(i,j,k,{n})[2];
-                    double uzbmold = Vel.Phase(i-1,j,k,{n})[2];
-                    double uzbmmold= Vel.Phase(i-2,j,k,{n})[2];
+                    double uzbold  = Vel.Phase.get(i,j,k,n)[2];
+                    double uzbmold = Vel.Phase.get(i-1,j,k,n)[2];
+                    double uzbmmold= Vel.Phase.get(i-2,j,k,n)[2];
 
                     double rhob = DensityWetting(i,j,k,{n});
                     double rhobm= DensityWetting(i-1,j,k,{n});
@@ -1505,7 +1740,7 @@ void FlowSolverLBM::SetOutFlow(int order)
 }
 
 void FlowSolverLBM::CalculateForceDrag(const int i,const int j,const int k,
-        PhaseField& Phase, const Velocities& Vel)
+        PhaseField& Phase, const Velocities& Vel, Tensor<sum_vector3_t,2>& GrainForces)
 {
     double dx3 = Grid.CellVolume(true);
 
@@ -1522,19 +1757,14 @@ void FlowSolverLBM::CalculateForceDrag(const int i,const int j,const int k,
                 const double factor =
                     (it.value * it.value * (1.0 - locSolidFraction))/
                     (Phase.Grid.iWidth * Phase.Grid.iWidth);
-                const dVector3 locSolidVelocity = Vel.Phase(i,j,k,{grain.Phase});
+                const dVector3 locSolidVelocity = Vel.Phase.get(i,j,k,grain.Phase);
                 const dVector3 DragForceDensity = (FluidVelocity(i,j,k,n) - locSolidVelocity) * mu * factor * h_star;
                 const dVector3 pos = {double(i), double(j), double(k)};
                 dVector3 distanceCM;
                 CalculateDistancePeriodic(pos, grain.Rcm, distanceCM, Grid.Nx, Grid.Ny, Grid.Nz);
                 const dVector3 locR = distanceCM * Grid.dx;
-                #ifdef _OPENMP
-                #pragma omp critical
-                #endif
-                {
-                    grain.Force  += DragForceDensity * dx3;
-                    grain.Torque += locR.cross(DragForceDensity) * dx3;
-                }
+                GrainForces({it.index,0}) += DragForceDensity * dx3;
+                GrainForces({it.index,1}) += locR.cross(DragForceDensity) * dx3;
             }
         }
     }
@@ -1542,11 +1772,21 @@ void FlowSolverLBM::CalculateForceDrag(const int i,const int j,const int k,
 
 double FlowSolverLBM::BounceBack(const int i, const int j, const int k,
         const int ii, const int jj, const int kk, const size_t n,
-        PhaseField& Phase, const BoundaryConditions& BC, double& lbDensityChange)
+        PhaseField& Phase, const BoundaryConditions& BC, double& lbDensityChange,
+        Tensor<sum_vector3_t,2>& GrainForces)
+{
+    return BounceBack(i, j, k, ii, jj, kk, n, lbPopulations(i,j,k,{n}), Phase,
+                      lbDensityChange, GrainForces);
+}
+
+double FlowSolverLBM::BounceBack(const int i, const int j, const int k,
+        const int ii, const int jj, const int kk, const size_t n,
+        const D3Q27& Populations, PhaseField& Phase, double& lbDensityChange,
+        Tensor<sum_vector3_t,2>& GrainForces)
 {
     double dx3 = Grid.CellVolume(true);
 
-    double NewPopulation = lbPopulations(i,j,k,{n})(-ii,-jj,-kk);
+    double NewPopulation = Populations(-ii,-jj,-kk);
     if (Do_BounceBack)
     {
         for(auto it : Phase.Fields(i-ii,j-jj,k-kk))
@@ -1575,7 +1815,7 @@ double FlowSolverLBM::BounceBack(const int i, const int j, const int k,
                     DensityWetting(i,j,k,{n})/dRho * (Vel[0]*ii + Vel[1]*jj + Vel[2]*kk) * dt/Grid.dx;
 
                 const double lbBBDensity =
-                    2.0 * (lbPopulations(i,j,k,{n})(-ii,-jj,-kk) + 3.0 * tmp);
+                    2.0 * (Populations(-ii,-jj,-kk) + 3.0 * tmp);
 
                 NewPopulation += it.value * 6.0 * tmp;
 
@@ -1587,20 +1827,15 @@ double FlowSolverLBM::BounceBack(const int i, const int j, const int k,
 
                 const dVector3 BounceBackForceDensity = lbBounceBackForceDensity * df;
 
-                #ifdef _OPENMP
-                #pragma omp critical
-                #endif
-                {
-                    grain.Force  += BounceBackForceDensity * dx3;
-                    grain.Torque += locR.cross(BounceBackForceDensity) * dx3;
-                }
+                GrainForces({it.index,0}) += BounceBackForceDensity * dx3;
+                GrainForces({it.index,1}) += locR.cross(BounceBackForceDensity) * dx3;
             }
         }
     }
     else if (Do_BounceBackElastic)
     {
         // Author: raphael.schiedung@rub.de
-        const double rho1    = lbPopulations(i,j,k,{n})(-ii,-jj,-kk);
+        const double rho1    = Populations(-ii,-jj,-kk);
         const double ci      = std::sqrt(ii*ii+jj*jj+kk*kk);
         const double ici     = 1.0/ci;
         const double p1      = rho1*ci;
@@ -1650,36 +1885,25 @@ double FlowSolverLBM::BounceBack(const int i, const int j, const int k,
 
                 dVector3 BounceBackForceDensity = {0,0,0};
                 BounceBackForceDensity += nn*it.value*(p2p-p2)*df;
-                #ifdef _OPENMP
-                #pragma omp critical
-                #endif
-                {
-                    grain.Force  += BounceBackForceDensity * dx3;
-                    grain.Torque += locR.cross(BounceBackForceDensity) * dx3;
-                }
+                GrainForces({it.index,0}) += BounceBackForceDensity * dx3;
+                GrainForces({it.index,1}) += locR.cross(BounceBackForceDensity) * dx3;
             }
         }
     }
-    lbDensityChange += NewPopulation - lbPopulations(i,j,k,{n})(-ii,-jj,-kk);
+    lbDensityChange += NewPopulation - Populations(-ii,-jj,-kk);
     return NewPopulation;
 }
 
-void FlowSolverLBM::Propagation(PhaseField& Phase, const BoundaryConditions& BC)
+void FlowSolverLBM::StreamPopulations(const long int i, const long int j, const long int k,
+        PhaseField& Phase, const BoundaryConditions& BC, Tensor<sum_vector3_t,2>& GrainForces)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,lbPopulationsTMP,0,)
-    for (size_t n = 0; n < N_Fluid_Comp; ++n)
-    {
-        lbPopulationsTMP(i,j,k,{n}).set_to_zero();
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,lbPopulations,0,)
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
         double lbDensityChange = 0.0;
         for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
         for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
         for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+        if (lbWeights[ii+1][jj+1][kk+1] != 0.0)
         {
             if (Obstacle(i, j, k))
             {
@@ -1689,7 +1913,7 @@ void FlowSolverLBM::Propagation(PhaseField& Phase, const BoundaryConditions& BC)
             else if (Obstacle(i-ii, j-jj, k-kk))
             {
                 lbPopulationsTMP(i,j,k,{n})(ii,jj,kk) =
-                    BounceBack(i, j, k, ii, jj, kk, n, Phase, BC, lbDensityChange);
+                    BounceBack(i, j, k, ii, jj, kk, n, Phase, BC, lbDensityChange, GrainForces);
             }
             else
             {
@@ -1699,8 +1923,48 @@ void FlowSolverLBM::Propagation(PhaseField& Phase, const BoundaryConditions& BC)
         }
         lbPopulationsTMP(i,j,k,{n})(0,0,0) -= lbDensityChange; //NoSlip
     }
+}
+
+void FlowSolverLBM::Propagation(PhaseField& Phase, const BoundaryConditions& BC)
+{
+    /* The populations are streamed from the nearest neighbors. The halo of
+    lbPopulations is exchanged while the interior cells are streamed, the
+    cells next to the boundaries are streamed after the exchange is complete.*/
+    if (InPlaceStreaming)
+    {
+        PropagationInPlace(Phase, BC, false);
+        return;
+    }
+    if (SparseFluidNodes)
+    {
+        PropagationSparse(Phase, BC);
+        return;
+    }
+    BC.BeginExchangePopulations(lbPopulations);
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,lbPopulationsTMP,0,)
+    for (size_t n = 0; n < N_Fluid_Comp; ++n)
+    {
+        lbPopulationsTMP(i,j,k,{n}).set_to_zero();
+    }
     OMP_PARALLEL_STORAGE_LOOP_END
 
+    ThreadLocalAccumulator<Tensor<sum_vector3_t,2>> locGrainForces(GrainForcesTensor(Phase));
+    OMP_PARALLEL_STORAGE_LOOP_INTERIOR_BEGIN(i,j,k,lbPopulations,1,)
+    {
+        StreamPopulations(i, j, k, Phase, BC, locGrainForces.Local());
+    }
+    OMP_PARALLEL_STORAGE_LOOP_INTERIOR_END
+
+    BC.EndExchangePopulations(lbPopulations);
+
+    OMP_PARALLEL_STORAGE_LOOP_SHELL_BEGIN(i,j,k,lbPopulations,0,1,)
+    {
+        StreamPopulations(i, j, k, Phase, BC, locGrainForces.Local());
+    }
+    OMP_PARALLEL_STORAGE_LOOP_SHELL_END
+    AddGrainForces(Phase, locGrainForces);
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,lbPopulations,0,)
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
@@ -1713,6 +1977,181 @@ void FlowSolverLBM::Propagation(PhaseField& Phase, const BoundaryConditions& BC)
    // if(dNz) BC.SetZVector(lbPopulations);
 }
 
+void FlowSolverLBM::PropagationSparse(PhaseField& Phase, const BoundaryConditions& BC)
+{
+    /* Same as Propagation() but only the fluid cells are visited, using the
+    fluid cell list and the precomputed bounce back directions. Obstacle cells
+    keep their populations.*/
+    AllocateTemporaryPopulations();
+    UpdateFluidNodes();
+
+    BC.BeginExchangePopulations(lbPopulations);
+    BC.EndExchangePopulations(lbPopulations);
+
+    ThreadLocalAccumulator<Tensor<sum_vector3_t,2>> locGrainForces(GrainForcesTensor(Phase));
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < FluidNodes.size(); ++c)
+    {
+        const long int i = FluidNodes[c][0];
+        const long int j = FluidNodes[c][1];
+        const long int k = FluidNodes[c][2];
+        for (size_t n = 0; n < N_Fluid_Comp; ++n)
+        {
+            lbnode_t& locPopulations = lbPopulationsTMP(i,j,k,{n});
+            double lbDensityChange = 0.0;
+            for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
+            for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
+            for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+            if (lbWeights[ii+1][jj+1][kk+1] != 0.0)
+            {
+                if (FluidNodesBounceBack[c] & (uint32_t(1) << (13 + 9*ii + 3*jj + kk)))
+                {
+                    locPopulations(ii,jj,kk) = BounceBack(i, j, k, ii, jj, kk, n,
+                        lbPopulations(i,j,k,{n}), Phase, lbDensityChange, locGrainForces.Local());
+                }
+                else
+                {
+                    locPopulations(ii,jj,kk) = lbPopulations(i-ii,j-jj,k-kk,{n})(ii,jj,kk);
+                }
+            }
+            locPopulations(0,0,0) -= lbDensityChange; //NoSlip
+        }
+    }
+    AddGrainForces(Phase, locGrainForces);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < FluidNodes.size(); ++c)
+    for (size_t n = 0; n < N_Fluid_Comp; ++n)
+    {
+        lbPopulations(FluidNodes[c][0],FluidNodes[c][1],FluidNodes[c][2],{n}) =
+            lbPopulationsTMP(FluidNodes[c][0],FluidNodes[c][1],FluidNodes[c][2],{n});
+    }
+}
+
+void FlowSolverLBM::PropagationInPlace(PhaseField& Phase,
+        const BoundaryConditions& BC, const bool CalculateMoments)
+{
+    /* The populations are pulled from the nearest neighbors and written back
+    into lbPopulations. The domain is swept plane by plane along x. Before a
+    plane is overwritten its pre-streaming populations are copied into a plane
+    buffer, so that the plane itself and the next plane can still read them.
+    Only two planes are held in addition to lbPopulations instead of a full
+    copy. If requested, density and momentum are calculated in the same sweep
+    while the streamed populations are still in cache.*/
+
+    BC.BeginExchangePopulations(lbPopulations);
+    BC.EndExchangePopulations(lbPopulations);
+
+    const long int BcellsY = lbPopulations.BcellsY();
+    const long int BcellsZ = lbPopulations.BcellsZ();
+    const long int SizeY   = lbPopulations.sizeY() + 2*BcellsY;
+    const long int SizeZ   = lbPopulations.sizeZ() + 2*BcellsZ;
+    const long int Nx = lbPopulations.sizeX();
+    const long int Ny = lbPopulations.sizeY();
+    const long int Nz = lbPopulations.sizeZ();
+
+    std::vector<lbnode_t> PreviousPlane(SizeY*SizeZ*N_Fluid_Comp);
+    std::vector<lbnode_t> CurrentPlane (SizeY*SizeZ*N_Fluid_Comp);
+
+    auto PlaneIndex = [BcellsY, BcellsZ, SizeZ, this](long int j, long int k, size_t n)
+    {
+        return ((j + BcellsY)*SizeZ + k + BcellsZ)*N_Fluid_Comp + n;
+    };
+    auto CopyPlane = [&](std::vector<lbnode_t>& Plane, long int i)
+    {
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (long int j = -BcellsY; j < SizeY - BcellsY; ++j)
+        for (long int k = -BcellsZ; k < SizeZ - BcellsZ; ++k)
+        for (size_t n = 0; n < N_Fluid_Comp; ++n)
+        {
+            Plane[PlaneIndex(j,k,n)] = lbPopulations(i,j,k,{n});
+        }
+    };
+
+    if (Grid.dNx) CopyPlane(PreviousPlane, -1);
+    if (SparseFluidNodes) UpdateFluidNodes();
+
+    ThreadLocalAccumulator<Tensor<sum_vector3_t,2>> locGrainForces(GrainForcesTensor(Phase));
+    for (long int i = 0; i < Nx; ++i)
+    {
+        CopyPlane(CurrentPlane, i);
+
+        /* Pre-streaming populations of the planes i-1 and i are read from the
+        buffers, the plane i+1 has not been overwritten yet.*/
+        auto Source = [&](long int x, long int y, long int z, size_t n) -> const lbnode_t&
+        {
+            if (x < i)  return PreviousPlane[PlaneIndex(y,z,n)];
+            if (x == i) return CurrentPlane [PlaneIndex(y,z,n)];
+            return lbPopulations(x,y,z,{n});
+        };
+
+        auto StreamFluidCell = [&](long int j, long int k, uint32_t BounceBackDirections)
+        {
+            for (size_t n = 0; n < N_Fluid_Comp; ++n)
+            {
+                D3Q27 locPopulations;
+                double lbDensityChange = 0.0;
+                for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
+                for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
+                for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+                if (lbWeights[ii+1][jj+1][kk+1] != 0.0)
+                {
+                    if (BounceBackDirections & (uint32_t(1) << (13 + 9*ii + 3*jj + kk)))
+                    {
+                        locPopulations(ii,jj,kk) = BounceBack(i, j, k, ii, jj, kk, n,
+                            Source(i,j,k,n), Phase, lbDensityChange, locGrainForces.Local());
+                    }
+                    else
+                    {
+                        locPopulations(ii,jj,kk) = Source(i-ii,j-jj,k-kk,n)(ii,jj,kk);
+                    }
+                }
+                locPopulations(0,0,0) -= lbDensityChange; //NoSlip
+                lbPopulations(i,j,k,{n}) = locPopulations;
+            }
+        };
+
+        if (SparseFluidNodes)
+        {
+            #pragma omp parallel for schedule(static)
+            for (size_t c = FluidNodesPlaneBegin[i]; c < FluidNodesPlaneBegin[i+1]; ++c)
+            {
+                StreamFluidCell(FluidNodes[c][1], FluidNodes[c][2], FluidNodesBounceBack[c]);
+                if (CalculateMoments) CalculateDensityAndMomentum(i, FluidNodes[c][1], FluidNodes[c][2]);
+            }
+        }
+        else
+        {
+            #pragma omp parallel for collapse(2) schedule(static)
+            for (long int j = 0; j < Ny; ++j)
+            for (long int k = 0; k < Nz; ++k)
+            {
+                if (not Obstacle(i,j,k)) StreamFluidCell(j, k, BounceBackMask(i,j,k));
+                if (CalculateMoments) CalculateDensityAndMomentum(i,j,k);
+            }
+        }
+        std::swap(PreviousPlane, CurrentPlane);
+    }
+    AddGrainForces(Phase, locGrainForces);
+
+    if (CalculateMoments)
+    {
+        // Boundary cells (and obstacle cells in sparse mode) have not been visited by the sweep
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,DensityWetting.Bcells(),)
+        {
+            if ((SparseFluidNodes and Obstacle(i,j,k)) or i < 0 or i >= Nx
+                                or j < 0 or j >= Ny
+                                or k < 0 or k >= Nz)
+            {
+                CalculateDensityAndMomentum(i,j,k);
+            }
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+
+        FixPopulations();
+    }
+}
+
 double FlowSolverLBM::SecondOrderBounceBack(const int i, const int j, const int k,
         const int ii, const int jj, const int kk, const size_t n,
         PhaseField& Phase, const BoundaryConditions& BC, double& lbDensityChange)
@@ -1786,6 +2225,8 @@ double FlowSolverLBM::SecondOrderBounceBack(const int i, const int j, const int
 
 void FlowSolverLBM::PropagationSecondOrderBB(PhaseField& Phase, const BoundaryConditions& BC)
 {
+    AllocateTemporaryPopulations();
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,lbPopulationsTMP,0,)
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
@@ -1832,6 +2273,22 @@ void FlowSolverLBM::PropagationSecondOrderBB(PhaseField& Phase, const BoundaryCo
    // if(dNz) BC.SetZVector(lbPopulations);
 }
 
+Tensor<sum_vector3_t,2> FlowSolverLBM::GrainForcesTensor(const PhaseField& Phase)
+{
+    return Tensor<sum_vector3_t,2>({Phase.FieldsProperties.size(),2});
+}
+
+void FlowSolverLBM::AddGrainForces(PhaseField& Phase,
+        const ThreadLocalAccumulator<Tensor<sum_vector3_t,2>>& GrainForces)
+{
+    const Tensor<sum_vector3_t,2> locGrainForces = GrainForces.SumElementwise();
+    for (size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
+    {
+        Phase.FieldsProperties[idx].Force  += dVector3(locGrainForces({idx,0}));
+        Phase.FieldsProperties[idx].Torque += dVector3(locGrainForces({idx,1}));
+    }
+}
+
 void FlowSolverLBM::ApplyForces(PhaseField& Phase, const Velocities& Vel)
 {
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ForceDensity,0,)
@@ -1841,16 +2298,20 @@ void FlowSolverLBM::ApplyForces(PhaseField& Phase, const Velocities& Vel)
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
+    if (Do_TwoPhase) CalculateInteractionPotential();
+
+    ThreadLocalAccumulator<Tensor<sum_vector3_t,2>> locGrainForces(GrainForcesTensor(Phase));
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,0,)
     if (!Obstacle(i,j,k))
     {
-        if (Do_TwoPhase) CalculateForceTwoPhase(i,j,k, Phase);
+        if (Do_TwoPhase) CalculateForceTwoPhase(i,j,k, Phase, locGrainForces.Local());
         if (Do_Drag and Phase.Fields(i,j,k).interface())
         {
-            CalculateForceDrag(i,j,k, Phase, Vel);
+            CalculateForceDrag(i,j,k, Phase, Vel, locGrainForces.Local());
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+    AddGrainForces(Phase, locGrainForces);
 
     if (Do_Gravity) CalculateForceGravity(Phase);
 }
@@ -1865,16 +2326,20 @@ void FlowSolverLBM::ApplyForces(PhaseField& Phase, const Velocities& Vel,
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
+    if (Do_TwoPhase) CalculateInteractionPotential();
+
+    ThreadLocalAccumulator<Tensor<sum_vector3_t,2>> locGrainForces(GrainForcesTensor(Phase));
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,0,)
     if (!Obstacle(i,j,k))
     {
-        if (Do_TwoPhase) CalculateForceTwoPhase(i,j,k, Phase);
+        if (Do_TwoPhase) CalculateForceTwoPhase(i,j,k, Phase, locGrainForces.Local());
         if (Do_Drag and Phase.Fields(i,j,k).interface())
         {
-            CalculateForceDrag(i,j,k, Phase, Vel);
+            CalculateForceDrag(i,j,k, Phase, Vel, locGrainForces.Local());
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+    AddGrainForces(Phase, locGrainForces);
 
     if (Do_Gravity)
     {
@@ -1884,25 +2349,39 @@ void FlowSolverLBM::ApplyForces(PhaseField& Phase, const Velocities& Vel,
 }
 
 void FlowSolverLBM::Collision()
+{
+    if (not Do_GuoForcing and not Do_EDForcing) return;
+
+    if (SparseFluidNodes)
+    {
+        UpdateFluidNodes();
+        #pragma omp parallel for schedule(static)
+        for (size_t c = 0; c < FluidNodes.size(); ++c)
+        {
+            CollisionCell(FluidNodes[c][0], FluidNodes[c][1], FluidNodes[c][2]);
+        }
+        return;
+    }
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,0,)
+    if (!Obstacle(i,j,k))
+    {
+        CollisionCell(i,j,k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+void FlowSolverLBM::CollisionCell(const long int i, const long int j, const long int k)
 {
     // Apply body force
     if (Do_GuoForcing) // Guo, Zheng, and, Shi, Phy. Rev. E (2002)
     {
-        // Apply body force with force projection method
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,0,)
-        if (!Obstacle(i,j,k))
         for (size_t n = 0; n < N_Fluid_Comp; ++n)
         {
+            // Apply body force with force projection method
             const dVector3 EqMomentum = MomentumDensity(i,j,k,{n}) + ForceDensity(i,j,k,{n})*dt/2;
             lbPopulations(i,j,k,{n}) += (EquilibriumDistribution(DensityWetting(i,j,k,{n})/dRho, lbWeights, EqMomentum/dm) - lbPopulations(i,j,k,{n}))/lbtau[n];
-        }
-        OMP_PARALLEL_STORAGE_LOOP_END
 
-        // Apply body force with force projection method
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,0,)
-        if (!Obstacle(i,j,k))
-        for (size_t n = 0; n < N_Fluid_Comp; ++n)
-        {
             assert(DensityWetting(i,j,k,{n})/dRho > DBL_EPSILON);
             assert(DensityWetting(i,j,k,{n}) < DBL_MAX);
 
@@ -1935,12 +2414,9 @@ void FlowSolverLBM::Collision()
 
             lbPopulations(i,j,k,{n}) += lblocForcing;
         }
-        OMP_PARALLEL_STORAGE_LOOP_END
     }
     else if (Do_EDForcing)
     {
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,0,)
-        if (!Obstacle(i,j,k))
         for (size_t n = 0; n < N_Fluid_Comp; ++n)
         {
             const double q = 1.0 - 1.0/lbtau[n];
@@ -1948,10 +2424,67 @@ void FlowSolverLBM::Collision()
                                         EquilibriumDistribution(DensityWetting(i,j,k,{n})/dRho, lbWeights,  MomentumDensity(i,j,k,{n})/dm))*q +
                                         EquilibriumDistribution(DensityWetting(i,j,k,{n})/dRho, lbWeights, (MomentumDensity(i,j,k,{n})/dm + ForceDensity(i,j,k,{n})/df*dt));
         }
-        OMP_PARALLEL_STORAGE_LOOP_END
     }
 }
 
+void FlowSolverLBM::UpdateFluidNodes(void)
+{
+    /* The interior fluid cells are listed plane by plane (in storage order),
+    FluidNodesPlaneBegin[i] is the position of the first fluid cell of plane i.
+    For each fluid cell bit 13 + 9*ii + 3*jj + kk of FluidNodesBounceBack is
+    set if the population (ii,jj,kk) is streamed from an obstacle cell, i.e.
+    has to be bounced back.*/
+    if (FluidNodesValid) return;
+
+    const long int Nx = Obstacle.sizeX();
+    const long int Ny = Obstacle.sizeY();
+    const long int Nz = Obstacle.sizeZ();
+
+    std::vector<size_t> PlaneCount(Nx + 1, 0);
+    #pragma omp parallel for schedule(static)
+    for (long int i = 0; i < Nx; ++i)
+    for (long int j = 0; j < Ny; ++j)
+    for (long int k = 0; k < Nz; ++k)
+    {
+        if (not Obstacle(i,j,k)) PlaneCount[i+1]++;
+    }
+    FluidNodesPlaneBegin.assign(Nx + 1, 0);
+    for (long int i = 0; i < Nx; ++i)
+    {
+        FluidNodesPlaneBegin[i+1] = FluidNodesPlaneBegin[i] + PlaneCount[i+1];
+    }
+
+    FluidNodes.resize(FluidNodesPlaneBegin[Nx]);
+    FluidNodesBounceBack.resize(FluidNodesPlaneBegin[Nx]);
+    #pragma omp parallel for schedule(static)
+    for (long int i = 0; i < Nx; ++i)
+    {
+        size_t c = FluidNodesPlaneBegin[i];
+        for (long int j = 0; j < Ny; ++j)
+        for (long int k = 0; k < Nz; ++k)
+        if (not Obstacle(i,j,k))
+        {
+            FluidNodes[c] = {int(i), int(j), int(k)};
+            FluidNodesBounceBack[c] = BounceBackMask(i,j,k);
+            c++;
+        }
+    }
+    FluidNodesValid = true;
+}
+
+uint32_t FlowSolverLBM::BounceBackMask(const long int i, const long int j, const long int k) const
+{
+    uint32_t Mask = 0;
+    for(int ii = -Grid.dNx; ii <= Grid.dNx; ++ii)
+    for(int jj = -Grid.dNy; jj <= Grid.dNy; ++jj)
+    for(int kk = -Grid.dNz; kk <= Grid.dNz; ++kk)
+    if (Obstacle(i-ii, j-jj, k-kk))
+    {
+        Mask |= uint32_t(1) << (13 + 9*ii + 3*jj + kk);
+    }
+    return Mask;
+}
+
 size_t FlowSolverLBM::CountObstacleNodes(void) const
 {
     size_t locObstacleNodes = 0;
@@ -2125,6 +2658,7 @@ void FlowSolverLBM::DetectObstacles(const PhaseField& Phase)
     OP_MPI_Allreduce(OP_MPI_IN_PLACE, &locObstaclesChanged, 1, OP_MPI_CXX_BOOL, OP_MPI_LOR, OP_MPI_COMM_WORLD);
 #endif
     ObstaclesChanged = locObstaclesChanged;
+    if (ObstaclesChanged) InvalidateFluidNodes();
 }
 
 void FlowSolverLBM::DetectObstaclesAdvection(const PhaseField& Phase,
@@ -2173,6 +2707,7 @@ void FlowSolverLBM::DetectObstaclesAdvection(const PhaseField& Phase,
 #endif
 
     ObstaclesChanged = locObstaclesChanged;
+    if (ObstaclesChanged) InvalidateFluidNodes();
 
     if (locObstaclesAppeared + locObstaclesVanished > 0)
     {
@@ -2212,9 +2747,9 @@ std::vector<dVector3> FlowSolverLBM::CalculateFluidMomentum(const PhaseField& Ph
     std::vector<dVector3> Momentum(N_Fluid_Comp);
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
-        std::vector<double> tmpMomentumX;
-        std::vector<double> tmpMomentumY;
-        std::vector<double> tmpMomentumZ;
+        ThreadLocalAccumulator<double> locMomentumSumX(0.0);
+        ThreadLocalAccumulator<double> locMomentumSumY(0.0);
+        ThreadLocalAccumulator<double> locMomentumSumZ(0.0);
 
         // Calculate fluid momentum
         #pragma omp parallel
@@ -2250,14 +2785,15 @@ std::vector<dVector3> FlowSolverLBM::CalculateFluidMomentum(const PhaseField& Ph
             for (auto value : tmplocMomentumY) locMomentumY += value;
             for (auto value : tmplocMomentumZ) locMomentumZ += value;
 
-            #pragma omp critical
-            {
-                tmpMomentumX.push_back(locMomentumX);
-                tmpMomentumY.push_back(locMomentumY);
-                tmpMomentumZ.push_back(locMomentumZ);
-            }
+            locMomentumSumX.Local() = locMomentumX;
+            locMomentumSumY.Local() = locMomentumY;
+            locMomentumSumZ.Local() = locMomentumZ;
         }
 
+        std::vector<double> tmpMomentumX = locMomentumSumX.Values();
+        std::vector<double> tmpMomentumY = locMomentumSumY.Values();
+        std::vector<double> tmpMomentumZ = locMomentumSumZ.Values();
+
         std::sort(tmpMomentumX.begin(),tmpMomentumX.end(), [] (double a, double b) { return a < b;});
         std::sort(tmpMomentumY.begin(),tmpMomentumY.end(), [] (double a, double b) { return a < b;});
         std::sort(tmpMomentumZ.begin(),tmpMomentumZ.end(), [] (double a, double b) { return a < b;});
@@ -2267,12 +2803,9 @@ std::vector<dVector3> FlowSolverLBM::CalculateFluidMomentum(const PhaseField& Ph
         for (auto value : tmpMomentumZ) Momentum[n][2] += value;
 
         #ifdef MPI_PARALLEL
-        double tmpX = Momentum[n][0];
-        double tmpY = Momentum[n][1];
-        double tmpZ = Momentum[n][2];
-        OP_MPI_Allreduce(&tmpX, &(Momentum[n][0]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&tmpY, &(Momentum[n][1]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&tmpZ, &(Momentum[n][2]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        ReductionBatch Batch;
+        Batch.Sum(Momentum[n].data(), 3);
+        Batch.Reduce();
         #endif
 
         Momentum[n] *= Grid.dx /dt *dRho*Grid.CellVolume(true);
@@ -2282,6 +2815,8 @@ std::vector<dVector3> FlowSolverLBM::CalculateFluidMomentum(const PhaseField& Ph
 
 void FlowSolverLBM::SetFluidNodesNearObstacle()
 {
+    AllocateTemporaryPopulations();
+
     const int rrrr = std::max(3,FluidRedistributionRange*FluidRedistributionRange);
     auto InsideRedistributionRange = [rrrr](int ii, int jj, int kk) {return ii*ii + jj*jj + kk*kk <= rrrr;};
     auto redistributable = [this, InsideRedistributionRange](int i, int j, int k, int ii, int jj, int kk)
@@ -2349,12 +2884,18 @@ void FlowSolverLBM::SetFluidNodesNearObstacle()
             for (int kk = -FluidRedistributionRange*Grid.dNz; kk <= FluidRedistributionRange*Grid.dNz; ++kk)
             if (redistributable(i,j,k,ii,jj,kk))
             {
-                #pragma omp critical
+                const double weight = DensityWetting(i+ii,j+jj,k+kk,{n})/SumWeights;
+                lbnode_t& locPopulations = lbPopulationsTMP(i+ii,j+jj,k+kk,{n});
+                for (int x = -1; x <= 1; ++x)
+                for (int y = -1; y <= 1; ++y)
+                for (int z = -1; z <= 1; ++z)
                 {
-                    const double weight = DensityWetting(i+ii,j+jj,k+kk,{n});
-                    lbPopulationsTMP(i+ii,j+jj,k+kk,{n}) -= DeltaPop*weight/SumWeights;
-                    ObstacleChangedDensity(i+ii,j+jj,k+kk) = true;
+                    // Increments do not depend on the storage shift of lbnode_t
+                    #pragma omp atomic
+                    locPopulations.data()[13 + 9*x + 3*y + z] -= DeltaPop(x,y,z)*weight;
                 }
+                #pragma omp atomic write
+                ObstacleChangedDensity(i+ii,j+jj,k+kk) = true;
             }
         }
         else std::cerr << "Warning no fluid Neighbours\n";
@@ -2390,12 +2931,18 @@ void FlowSolverLBM::SetFluidNodesNearObstacle()
             for (int kk = -FluidRedistributionRange*Grid.dNz; kk <= FluidRedistributionRange*Grid.dNz; ++kk)
             if (redistributable(i,j,k,ii,jj,kk))
             {
-                #pragma omp critical
+                const double weight = DensityWetting(i+ii,j+jj,k+kk,{n})/SumWeights;
+                lbnode_t& locPopulations = lbPopulationsTMP(i+ii,j+jj,k+kk,{n});
+                for (int x = -1; x <= 1; ++x)
+                for (int y = -1; y <= 1; ++y)
+                for (int z = -1; z <= 1; ++z)
                 {
-                    const double weight = DensityWetting(i+ii,j+jj,k+kk,{n});
-                    lbPopulationsTMP(i+ii,j+jj,k+kk,{n}) += DeltaPop*weight/SumWeights;
-                    ObstacleChangedDensity(i+ii,j+jj,k+kk) = true;
+                    // Increments do not depend on the storage shift of lbnode_t
+                    #pragma omp atomic
+                    locPopulations.data()[13 + 9*x + 3*y + z] += DeltaPop(x,y,z)*weight;
                 }
+                #pragma omp atomic write
+                ObstacleChangedDensity(i+ii,j+jj,k+kk) = true;
             }
        }
        else std::cerr << "Warning no fluid Neighbours\n";
@@ -2624,79 +3171,202 @@ void FlowSolverLBM::SetDivUnearBCsZeroXZPlane()
 void FlowSolverLBM::Solve(PhaseField& Phase, Velocities& Vel,
         const BoundaryConditions& BC)
 {
+    if (Offload and not Device.IsAllocated()) InitializeOffload(BC);
+
+    double Time = LBKernelTimes::Now();
     DetectObstacles(Phase);
+    if (Offload and ObstaclesChanged) SynchronizePopulations();
     SetObstacleNodes(Phase, Vel);
     if(ObstaclesChanged) CalculateDensityAndMomentum();
+    KernelTimes.ObstacleDetection += LBKernelTimes::Now() - Time;
 
-    Propagation(Phase,BC);
-    CalculateDensityAndMomentum();
+    Time = LBKernelTimes::Now();
+    if (Offload)
+    {
+        PropagationOffload(BC);
+    }
+    else if (InPlaceStreaming)
+    {
+        PropagationInPlace(Phase, BC, true);
+    }
+    else
+    {
+        Propagation(Phase, BC);
+        CalculateDensityAndMomentum();
+    }
+    KernelTimes.Propagation += LBKernelTimes::Now() - Time;
 
+    Time = LBKernelTimes::Now();
     BC.SetX(DensityWetting);
     BC.SetY(DensityWetting);
     BC.SetZ(DensityWetting);
 
     ApplyForces(Phase, Vel);
-    Collision();
-    CalculateDensityAndMomentum(); //Commented by Dmitry // Uncommented by Raphael
-    SetBoundaryConditions(BC);
+    KernelTimes.Forces += LBKernelTimes::Now() - Time;
+
+    Time = LBKernelTimes::Now();
+    if (Offload)
+    {
+        CollisionOffload();
+    }
+    else
+    {
+        Collision();
+        CalculateDensityAndMomentum(); //Commented by Dmitry // Uncommented by Raphael
+    }
+    KernelTimes.Collision += LBKernelTimes::Now() - Time;
+
+    Time = LBKernelTimes::Now();
+    SetMacroscopicBoundaryConditions(BC); // Populations halo is set in Propagation()
 
     CalculateFluidVelocities(Vel, Phase, BC);
+    KernelTimes.Velocities += LBKernelTimes::Now() - Time;
+    KernelTimes.Steps++;
 
     #ifdef MPI_PARALLEL
+    ReductionBatch Batch;
     for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
     if(Phase.FieldsProperties[idx].Exist and Phase.FieldsProperties[idx].State == AggregateStates::Solid)
     {
-        auto locForce = Phase.FieldsProperties[idx].Force;
-        OP_MPI_Allreduce(&locForce[0], &(Phase.FieldsProperties[idx].Force[0]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&locForce[1], &(Phase.FieldsProperties[idx].Force[1]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&locForce[2], &(Phase.FieldsProperties[idx].Force[2]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-
-        auto locTorque = Phase.FieldsProperties[idx].Torque;
-        OP_MPI_Allreduce(&locTorque[0], &(Phase.FieldsProperties[idx].Torque[0]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&locTorque[1], &(Phase.FieldsProperties[idx].Torque[1]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&locTorque[2], &(Phase.FieldsProperties[idx].Torque[2]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        Batch.Sum(Phase.FieldsProperties[idx].Force.data(), 3);
+        Batch.Sum(Phase.FieldsProperties[idx].Torque.data(), 3);
     }
+    Batch.Reduce();
     #endif
 }
 
 void FlowSolverLBM::Solve(PhaseField& Phase, const Composition& Cx,
         Velocities& Vel, const BoundaryConditions& BC)
 {
+    if (Offload and not Device.IsAllocated()) InitializeOffload(BC);
+
+    double Time = LBKernelTimes::Now();
     DetectObstacles(Phase);
+    if (Offload and ObstaclesChanged) SynchronizePopulations();
     SetObstacleNodes(Phase, Vel);
     if(ObstaclesChanged) CalculateDensityAndMomentum();
+    KernelTimes.ObstacleDetection += LBKernelTimes::Now() - Time;
 
-    Propagation(Phase, BC);
-    CalculateDensityAndMomentum();
+    Time = LBKernelTimes::Now();
+    if (Offload)
+    {
+        PropagationOffload(BC);
+    }
+    else if (InPlaceStreaming)
+    {
+        PropagationInPlace(Phase, BC, true);
+    }
+    else
+    {
+        Propagation(Phase, BC);
+        CalculateDensityAndMomentum();
+    }
+    KernelTimes.Propagation += LBKernelTimes::Now() - Time;
 
+    Time = LBKernelTimes::Now();
     BC.SetX(DensityWetting);
     BC.SetY(DensityWetting);
     BC.SetZ(DensityWetting);
 
     ApplyForces(Phase, Vel, Cx);
-    Collision();
-    CalculateDensityAndMomentum(); //Commented by Dmitry // Uncommented by Raphael
-    SetBoundaryConditions(BC);
+    KernelTimes.Forces += LBKernelTimes::Now() - Time;
+
+    Time = LBKernelTimes::Now();
+    if (Offload)
+    {
+        CollisionOffload();
+    }
+    else
+    {
+        Collision();
+        CalculateDensityAndMomentum(); //Commented by Dmitry // Uncommented by Raphael
+    }
+    KernelTimes.Collision += LBKernelTimes::Now() - Time;
+
+    Time = LBKernelTimes::Now();
+    SetMacroscopicBoundaryConditions(BC); // Populations halo is set in Propagation()
 
     CalculateFluidVelocities(Vel, Phase, BC);
+    KernelTimes.Velocities += LBKernelTimes::Now() - Time;
+    KernelTimes.Steps++;
 
     #ifdef MPI_PARALLEL
+    ReductionBatch Batch;
     for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
     if(Phase.FieldsProperties[idx].Exist and Phase.FieldsProperties[idx].State == AggregateStates::Solid)
     {
-        auto locForce = Phase.FieldsProperties[idx].Force;
-        OP_MPI_Allreduce(&locForce[0], &(Phase.FieldsProperties[idx].Force[0]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&locForce[1], &(Phase.FieldsProperties[idx].Force[1]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&locForce[2], &(Phase.FieldsProperties[idx].Force[2]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-
-        auto locTorque = Phase.FieldsProperties[idx].Torque;
-        OP_MPI_Allreduce(&locTorque[0], &(Phase.FieldsProperties[idx].Torque[0]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&locTorque[1], &(Phase.FieldsProperties[idx].Torque[1]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(&locTorque[2], &(Phase.FieldsProperties[idx].Torque[2]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        Batch.Sum(Phase.FieldsProperties[idx].Force.data(), 3);
+        Batch.Sum(Phase.FieldsProperties[idx].Torque.data(), 3);
     }
+    Batch.Reduce();
     #endif
 }
 
+bool FlowSolverLBM::OffloadSupported(const BoundaryConditions& BC) const
+{
+    /* The device kernels implement periodic streaming, bounce back at resting
+    obstacles and BGK collision with Guo or ED forcing. Forces on grains from
+    the bounce back, thermal compressibility and domain decomposition are only
+    available on the host.*/
+#ifdef MPI_PARALLEL
+    return false;
+#endif
+    const bool Periodic =
+        BC.BC0X == BoundaryConditionTypes::Periodic and BC.BCNX == BoundaryConditionTypes::Periodic and
+        BC.BC0Y == BoundaryConditionTypes::Periodic and BC.BCNY == BoundaryConditionTypes::Periodic and
+        BC.BC0Z == BoundaryConditionTypes::Periodic and BC.BCNZ == BoundaryConditionTypes::Periodic;
+
+    return Periodic and not Do_BounceBack and not Do_BounceBackElastic and
+           not Do_ThermalComp and (Do_GuoForcing or Do_EDForcing);
+}
+
+void FlowSolverLBM::InitializeOffload(const BoundaryConditions& BC)
+{
+    if (not OffloadSupported(BC))
+    {
+        ConsoleOutput::WriteWarning("Offload requires periodic boundaries, Guo or ED forcing and no grain bounce back. Running on the host.", thisclassname, "InitializeOffload()");
+        Offload = false;
+        return;
+    }
+    Device.Allocate(Grid, N_Fluid_Comp, lbWeights);
+    Device.CopyPopulationsToDevice(lbPopulations);
+    Device.CopyObstacleToDevice(Obstacle);
+}
+
+void FlowSolverLBM::SynchronizePopulations(void)
+{
+    if (Device.IsAllocated()) Device.CopyPopulationsToHost(lbPopulations);
+}
+
+void FlowSolverLBM::PropagationOffload(const BoundaryConditions& BC)
+{
+    if (ObstaclesChanged)
+    {
+        // The host populations were synchronized and updated in Solve()
+        Device.CopyPopulationsToDevice(lbPopulations);
+        Device.CopyObstacleToDevice(Obstacle);
+    }
+    Device.Propagate();
+    Device.CalculateMoments(Do_FixPopulations);
+    Device.CopyMomentsToHost(DensityWetting, MomentumDensity, Obstacle, dRho, dm);
+    SetMacroscopicBoundaryConditions(BC);
+}
+
+void FlowSolverLBM::CollisionOffload(void)
+{
+    Device.CopyForceDensityToDevice(ForceDensity, df);
+    if (Do_GuoForcing)
+    {
+        Device.CollisionGuo(lbtau);
+    }
+    else
+    {
+        Device.CollisionED(lbtau, dt); // Same force increment as in CollisionCell()
+    }
+    Device.CalculateMoments(Do_FixPopulations);
+    Device.CopyMomentsToHost(DensityWetting, MomentumDensity, Obstacle, dRho, dm);
+}
+
 double FlowSolverLBM::CalculateLiquidVolume(size_t Fluid_Comp)
 {
     double VolumeLiquid = 0.0;
@@ -2811,7 +3481,7 @@ std::vector<double> FlowSolverLBM::CalculateFluidMass(void) const
     std::vector<double> Mass(N_Fluid_Comp);
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
-        std::vector<double> tmpMass;
+        ThreadLocalAccumulator<double> locMassSum(0.0);
         // Calculate fluid momentum
         #pragma omp parallel
         {
@@ -2835,12 +3505,11 @@ std::vector<double> FlowSolverLBM::CalculateFluidMass(void) const
             double locMass = 0.0;
             for (auto value : tmplocMass) locMass += value;
 
-            #pragma omp critical
-            {
-                tmpMass.push_back(locMass);
-            }
+            locMassSum.Local() = locMass;
         }
 
+        std::vector<double> tmpMass = locMassSum.Values();
+
         std::sort(tmpMass.begin(),tmpMass.end(), [] (double a, double b) { return a < b;});
 
         for (auto value : tmpMass) Mass[n] += value;
@@ -2855,21 +3524,35 @@ std::vector<double> FlowSolverLBM::CalculateFluidMass(void) const
     return Mass;
 }
 
-void FlowSolverLBM::CalculateDensityAndMomentum(void)
+void FlowSolverLBM::CalculateDensityAndMomentum(const long int i,
+        const long int j, const long int k)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,DensityWetting.Bcells(),)
     for (size_t n = 0; n < N_Fluid_Comp; ++n)
     {
-        DensityWetting (i,j,k,{n}) = 0.0;
-        MomentumDensity(i,j,k,{n}).set_to_zero();
+        // Accumulated in double precision independent of the storage types
+        double   lbDensity  = 0.0;
+        dVector3 lbMomentum = {0.0, 0.0, 0.0};
         for (int ii = -Grid.dNx; ii <= Grid.dNx; ii++)
         for (int jj = -Grid.dNy; jj <= Grid.dNy; jj++)
         for (int kk = -Grid.dNz; kk <= Grid.dNz; kk++)
+        if (lbWeights[ii+1][jj+1][kk+1] != 0.0)
         {
-            const dVector3 vel {ii*Grid.dx/dt,jj*Grid.dx/dt,kk*Grid.dx/dt};
-            DensityWetting (i,j,k,{n}) +=     lbPopulations(i,j,k,{n})(ii,jj,kk)*dRho;
-            MomentumDensity(i,j,k,{n}) += vel*lbPopulations(i,j,k,{n})(ii,jj,kk)*dRho;
+            const double Population = lbPopulations(i,j,k,{n})(ii,jj,kk);
+            lbDensity     += Population;
+            lbMomentum[0] += ii*Population;
+            lbMomentum[1] += jj*Population;
+            lbMomentum[2] += kk*Population;
         }
+        DensityWetting (i,j,k,{n}) = lbDensity*dRho;
+        MomentumDensity(i,j,k,{n}) = lbMomentum*(dRho*Grid.dx/dt);
+    }
+}
+
+void FlowSolverLBM::CalculateDensityAndMomentum(void)
+{
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DensityWetting,DensityWetting.Bcells(),)
+    {
+        CalculateDensityAndMomentum(i,j,k);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
@@ -49,7 +49,7 @@ void InteractionSolidFluid::ReadInput(std::string InputFileName)
      ConsoleOutput::WriteLineInsert(thisclassname+"input");
      ConsoleOutput::WriteStandard("Source", InputFileName);
 
-     std::fstream inp(InputFileName.c_str(), std::ios::in);
+     std::stringstream inp = FileInterface::OpenInput(InputFileName);
 
      if (!inp)
      {
@@ -59,7 +59,6 @@ void InteractionSolidFluid::ReadInput(std::string InputFileName)
 
      std::stringstream data;
      data << inp.rdbuf();
-     inp.close();
 
      ReadInput(data);
 
@@ -27,6 +27,7 @@
 
 #include "FluidDynamics/InteractionSolidSolid.h"
 #include "Tools.h"
+#include <unordered_map>
 
 namespace openphase
 {
@@ -60,7 +61,7 @@ void InteractionSolidSolid::ReadInput(std::string InputFileName)
      ConsoleOutput::WriteLineInsert(thisclassname+"input");
      ConsoleOutput::WriteStandard("Source", InputFileName);
 
-     std::fstream inp(InputFileName.c_str(), std::ios::in);
+     std::stringstream inp = FileInterface::OpenInput(InputFileName);
 
      if (!inp)
      {
@@ -70,7 +71,6 @@ void InteractionSolidSolid::ReadInput(std::string InputFileName)
 
      std::stringstream data;
      data << inp.rdbuf();
-     inp.close();
 
      ReadInput(data);
 
@@ -115,19 +115,157 @@ void InteractionSolidSolid::ReadInput(std::stringstream& inp)
     }
 }
 
+InteractionSolidSolid::Contacts_t InteractionSolidSolid::BroadPhase(
+        const PhaseField& Phase,
+        const BoundaryConditions& BC) const
+{
+    /* Broad phase: every grain is enclosed in a sphere around its center of
+    mass which contains all its cells, including the boundary cells reached
+    by the cutoff stencil. Only grains whose spheres are closer than the
+    cutoff can interact. The spheres are sorted into a spatial hash with
+    buckets not smaller than the largest possible interaction distance, so
+    only the grains in neighboring buckets have to be compared. */
+
+    const size_t Ngrains = Phase.FieldsProperties.size();
+    const long int reach = std::min<long int>(cutoff, Phase.Fields.Bcells());
+    const int TotalN[3] = {Phase.Grid.TotalNx, Phase.Grid.TotalNy, Phase.Grid.TotalNz};
+
+    Contacts_t Contacts;
+    Contacts.Radius.assign(Ngrains, -1.0);
+    Contacts.Partners.resize(Ngrains);
+
+    std::vector<std::vector<double>> locRadius(omp_get_max_threads(), Contacts.Radius);
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,reach,)
+    {
+        std::vector<double>& Radius = locRadius[omp_get_thread_num()];
+        const dVector3 pos = Tools::Position(dVector3({double(i), double(j), double(k)}), Phase.Grid.OffsetX, Phase.Grid.OffsetY, Phase.Grid.OffsetZ);
+        for (auto alpha  = Phase.Fields(i,j,k).cbegin();
+                  alpha != Phase.Fields(i,j,k).cend(); ++alpha)
+        if (applicable(Phase.FieldsProperties[alpha->index]))
+        {
+            const double r = Tools::Distance(pos, Phase.FieldsProperties[alpha->index].Rcm, TotalN[0], TotalN[1], TotalN[2], BC).abs();
+            Radius[alpha->index] = std::max(Radius[alpha->index], r);
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    for (auto& Radius : locRadius)
+    for (size_t idx = 0; idx < Ngrains; idx++)
+    {
+        Contacts.Radius[idx] = std::max(Contacts.Radius[idx], Radius[idx]);
+    }
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, Contacts.Radius.data(), Ngrains, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+
+    double Rmax = 0.0;
+    for (size_t idx = 0; idx < Ngrains; idx++)
+    if (Contacts.Radius[idx] >= 0.0 and applicable(Phase.FieldsProperties[idx]))
+    {
+        Rmax = std::max(Rmax, Contacts.Radius[idx]);
+    }
+
+    bool periodic[3] = {BC.BC0X == BoundaryConditionTypes::Periodic,
+                        BC.BC0Y == BoundaryConditionTypes::Periodic,
+                        BC.BC0Z == BoundaryConditionTypes::Periodic};
+#ifdef MPI_PARALLEL
+    periodic[0] = periodic[0] or BC.MPIperiodicX;
+    periodic[1] = periodic[1] or BC.MPIperiodicY;
+    periodic[2] = periodic[2] or BC.MPIperiodicZ;
+#endif
+
+    // Buckets are at least as wide as the largest interaction distance
+    const double width = std::max(2.0*Rmax + cutoff, 1.0);
+    long int Nbuckets[3];
+    for (int d = 0; d < 3; d++)
+    {
+        Nbuckets[d] = std::max<long int>(1, std::floor(TotalN[d]/width));
+    }
+    auto Bucket = [&](const dVector3& R, const int d)
+    {
+        double x = R[d];
+        if (periodic[d]) x -= std::floor(x/TotalN[d])*TotalN[d];
+        const long int b = std::floor(x*Nbuckets[d]/TotalN[d]);
+        return std::min(std::max(b, 0l), Nbuckets[d] - 1);
+    };
+
+    std::unordered_map<long int, std::vector<size_t>> Buckets;
+    for (size_t idx = 0; idx < Ngrains; idx++)
+    if (Contacts.Radius[idx] >= 0.0 and applicable(Phase.FieldsProperties[idx]))
+    {
+        const dVector3& R = Phase.FieldsProperties[idx].Rcm;
+        Buckets[(Bucket(R,0)*Nbuckets[1] + Bucket(R,1))*Nbuckets[2] + Bucket(R,2)].push_back(idx);
+    }
+
+    for (auto& [key, Members] : Buckets)
+    {
+        const long int b[3] = {key/(Nbuckets[1]*Nbuckets[2]), (key/Nbuckets[2])%Nbuckets[1], key%Nbuckets[2]};
+        for (long int di = -1; di <= 1; di++)
+        for (long int dj = -1; dj <= 1; dj++)
+        for (long int dk = -1; dk <= 1; dk++)
+        {
+            long int n[3] = {b[0] + di, b[1] + dj, b[2] + dk};
+            bool valid = true;
+            for (int d = 0; d < 3; d++)
+            {
+                if (periodic[d]) n[d] = (n[d] + Nbuckets[d])%Nbuckets[d];
+                else if (n[d] < 0 or n[d] >= Nbuckets[d]) valid = false;
+            }
+            if (not valid) continue;
+
+            auto Neighbors = Buckets.find((n[0]*Nbuckets[1] + n[1])*Nbuckets[2] + n[2]);
+            if (Neighbors == Buckets.end()) continue;
+
+            for (size_t alpha : Members)
+            for (size_t beta : Neighbors->second)
+            if (alpha != beta)
+            {
+                const dVector3 dist = Tools::Distance(Phase.FieldsProperties[alpha].Rcm, Phase.FieldsProperties[beta].Rcm, TotalN[0], TotalN[1], TotalN[2], BC);
+                if (dist.abs() <= Contacts.Radius[alpha] + Contacts.Radius[beta] + cutoff)
+                {
+                    Contacts.Partners[alpha].push_back(beta);
+                }
+            }
+        }
+    }
+
+    // Neighboring buckets may coincide for few buckets per direction
+    for (auto& Partners : Contacts.Partners)
+    {
+        std::sort(Partners.begin(), Partners.end());
+        Partners.erase(std::unique(Partners.begin(), Partners.end()), Partners.end());
+    }
+    return Contacts;
+}
+
 void InteractionSolidSolid::CalculateLocal(
         const int i, const int j, const int k,
-        PhaseField& Phase,
+        const PhaseField& Phase,
         const BoundaryConditions& BC,
-        const double dt) const
+        const Contacts_t& Contacts,
+        const double dt,
+        Tensor<sum_vector3_t,2>& GrainForces) const
 {
     const double dV = Grid.CellVolume(true);
     //const NodeAB<dVector3,dVector3> locNormal = Phase.Normals(i,j,k);
 
+    const dVector3 pos = Tools::Position(dVector3({double(i), double(j), double(k)}), Phase.Grid.OffsetX, Phase.Grid.OffsetY, Phase.Grid.OffsetZ);
+
     for (auto alpha  = Phase.Fields(i,j,k).cbegin();
               alpha != Phase.Fields(i,j,k).cend(); ++alpha)
     if (applicable(Phase.FieldsProperties[alpha->index]))
     {
+        // Skips the stencil if no partner grain can be reached from this cell
+        const std::vector<size_t>& Partners = Contacts.Partners[alpha->index];
+        bool reachable = false;
+        for (size_t idx : Partners)
+        if (Tools::Distance(pos, Phase.FieldsProperties[idx].Rcm, Phase.Grid.TotalNx, Phase.Grid.TotalNy, Phase.Grid.TotalNz, BC).abs() <= Contacts.Radius[idx] + cutoff)
+        {
+            reachable = true;
+            break;
+        }
+        if (not reachable) continue;
+
         const size_t pidxA = Phase.FieldsProperties[alpha->index].Phase;
         const dVector3& pos_cm_alpha = Phase.FieldsProperties[alpha->index].Rcm;
 
@@ -145,6 +283,7 @@ void InteractionSolidSolid::CalculateLocal(
                      beta != Phase.Fields(i+ii,j+jj,k+kk).cend(); ++beta)
             if (applicable(Phase.FieldsProperties[beta->index]))
             if(alpha->index != beta->index)
+            if(std::binary_search(Partners.begin(), Partners.end(), beta->index))
             {
                 const double r = sqrt(ii*ii+jj*jj+kk*kk); // Distance between (i,j,k) and (i+ii,j+jj,k+kk).
                 const size_t pidxB = Phase.FieldsProperties[beta->index].Phase;
@@ -171,15 +310,10 @@ void InteractionSolidSolid::CalculateLocal(
                 const dVector3 pos_beta  = Tools::Position(dVector3({double(i+ii), double(j+jj), double(k+kk)}), Phase.Grid.OffsetX, Phase.Grid.OffsetY, Phase.Grid.OffsetZ);
                 const dVector3 r_alpha = Tools::Distance(pos_alpha, pos_cm_alpha, Phase.Grid.TotalNx, Phase.Grid.TotalNy, Phase.Grid.TotalNz, BC)*Grid.dx;
                 const dVector3 r_beta  = Tools::Distance(pos_beta,  pos_cm_beta,  Phase.Grid.TotalNx, Phase.Grid.TotalNy, Phase.Grid.TotalNz, BC)*Grid.dx;
-                #ifdef _OPENMP
-                #pragma omp critical
-                #endif
-                {
-                    Phase.FieldsProperties[alpha->index].Force  += force_density*dV;
-                    Phase.FieldsProperties[beta ->index].Force  -= force_density*dV;
-                    Phase.FieldsProperties[alpha->index].Torque += r_alpha.cross(force_density)*dV;
-                    Phase.FieldsProperties[beta ->index].Torque -= r_beta .cross(force_density)*dV;
-                }
+                GrainForces({alpha->index,0}) += force_density*dV;
+                GrainForces({beta ->index,0}) -= force_density*dV;
+                GrainForces({alpha->index,1}) += r_alpha.cross(force_density)*dV;
+                GrainForces({beta ->index,1}) -= r_beta .cross(force_density)*dV;
             }
         }
     }
@@ -187,9 +321,10 @@ void InteractionSolidSolid::CalculateLocal(
 
 void InteractionSolidSolid::CalculateLocalWang(
         const int i, const int j, const int k,
-        PhaseField& Phase,
+        const PhaseField& Phase,
         const BoundaryConditions& BC,
-        const std::function<double(int,int,int)>& MassDensity) const
+        const std::function<double(int,int,int)>& MassDensity,
+        Tensor<sum_vector3_t,2>& GrainForces) const
 {
     const double dV = Grid.CellVolume(true);
     //The calculation of the force density is based on, Wang, Y. U. (2006).
@@ -217,15 +352,10 @@ void InteractionSolidSolid::CalculateLocalWang(
             const dVector3 ForceDensity   = (gradient_alpha-gradient_beta)*(locMassDensity-locMassDensity_Uncompressed)*strength_wang;
             const dVector3 pos_cm_beta    = Phase.FieldsProperties[beta->index].Rcm;
             const dVector3 r_beta         = Tools::Distance(pos, pos_cm_beta, Phase.Grid.TotalNx, Phase.Grid.TotalNy, Phase.Grid.TotalNz, BC)*Grid.dx;
-            #ifdef _OPENMP
-            #pragma omp critical
-            #endif
-            {
-                Phase.FieldsProperties[alpha->index].Force  += ForceDensity*dV;
-                Phase.FieldsProperties[beta ->index].Force  -= ForceDensity*dV;
-                Phase.FieldsProperties[alpha->index].Torque += r_alpha.cross(ForceDensity)*dV;
-                Phase.FieldsProperties[beta ->index].Torque -= r_beta .cross(ForceDensity)*dV;
-            }
+            GrainForces({alpha->index,0}) += ForceDensity*dV;
+            GrainForces({beta ->index,0}) -= ForceDensity*dV;
+            GrainForces({alpha->index,1}) += r_alpha.cross(ForceDensity)*dV;
+            GrainForces({beta ->index,1}) -= r_beta .cross(ForceDensity)*dV;
         }
     }
 }
@@ -235,22 +365,38 @@ void InteractionSolidSolid::Calculate(PhaseField& Phase,
         const std::function<double(int,int,int)>& MassDensity,
         const double dt) const
 {
+    const size_t Ngrains = Phase.FieldsProperties.size();
+    Tensor<sum_vector3_t,2> GrainForces({Ngrains,2});
+    ThreadLocalAccumulator<Tensor<sum_vector3_t,2>> locGrainForces(GrainForces);
+
     switch (Model)
     {
         case SolidSolidInteractionModel::Wang:
             OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
             {
-                CalculateLocalWang(i,j,k,Phase,BC,MassDensity);
+                CalculateLocalWang(i,j,k,Phase,BC,MassDensity,locGrainForces.Local());
             }
             OMP_PARALLEL_STORAGE_LOOP_END
             break;
 
         default:
+        {
+            const Contacts_t Contacts = BroadPhase(Phase, BC);
+            if (Contacts.empty()) break;
+
             OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
             {
-                CalculateLocal(i,j,k,Phase,BC,dt);
+                CalculateLocal(i,j,k,Phase,BC,Contacts,dt,locGrainForces.Local());
             }
             OMP_PARALLEL_STORAGE_LOOP_END
+        }
+    }
+
+    GrainForces = locGrainForces.SumElementwise();
+    for (size_t idx = 0; idx < Ngrains; idx++)
+    {
+        Phase.FieldsProperties[idx].Force  += dVector3(GrainForces({idx,0}));
+        Phase.FieldsProperties[idx].Torque += dVector3(GrainForces({idx,1}));
     }
 }
 } //namespace openphase
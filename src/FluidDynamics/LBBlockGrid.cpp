@@ -0,0 +1,693 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo; Raphael Schiedung
+ *
+ */
+
+#include "FluidDynamics/LBBlockGrid.h"
+#include "FluidDynamics/LBLattices.h"
+
+namespace openphase
+{
+
+static const std::string thisclassname = "LBBlockGrid";
+
+typedef D3Q27Lattice Lattice;
+
+/* Block kinds used while the hierarchy is built */
+enum BlockKinds
+{
+    KindAbsent,
+    KindFluid,
+    KindGhost,
+    KindRefined
+};
+
+static inline long int WrapIndex(const long int i, const long int N)
+{
+    return ((i % N) + N) % N;
+}
+
+void LBBlockGrid::Initialize(const long int nx, const long int ny, const long int nz,
+                    const int blocksize, const int maxlevel, const double tau,
+                    const dVector3 acceleration, const std::array<bool,3> periodic,
+                    const std::function<bool(double,double,double)>& IsObstacle)
+{
+    if(blocksize < 2 or nx % blocksize or ny % blocksize or nz % blocksize)
+    {
+        ConsoleOutput::WriteExit("The system size has to be a multiple of the block size (at least 2)", thisclassname, "Initialize()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    if(tau <= 0.5 or maxlevel < 0)
+    {
+        ConsoleOutput::WriteExit("Relaxation time has to exceed 0.5 and the number of levels has to be positive", thisclassname, "Initialize()");
+        OP_Exit(EXIT_FAILURE);
+    }
+
+    BlockSize = blocksize;
+    Periodic  = periodic;
+    Level.clear();
+    Level.resize(1);
+    Level[0].Nx = nx;
+    Level[0].Ny = ny;
+    Level[0].Nz = nz;
+    Level[0].NBx = nx/BlockSize;
+    Level[0].NBy = ny/BlockSize;
+    Level[0].NBz = nz/BlockSize;
+    Level[0].tau = tau;
+    Level[0].Acceleration = acceleration;
+    Level[0].Volume = 1.0;
+
+    std::vector<std::vector<char>> Kind(1);
+    Kind[0].assign(Level[0].NBx*Level[0].NBy*Level[0].NBz, KindFluid);
+
+    /* Kind of a block position, KindRefined and KindFluid are both treated as
+    "present at this level" by the nesting condition */
+    auto KindAt = [&](const int l, long int bx, long int by, long int bz)
+    {
+        const GridLevel& L = Level[l];
+        if(Periodic[0]) bx = WrapIndex(bx, L.NBx); else if(bx < 0 or bx >= L.NBx) return -1;
+        if(Periodic[1]) by = WrapIndex(by, L.NBy); else if(by < 0 or by >= L.NBy) return -1;
+        if(Periodic[2]) bz = WrapIndex(bz, L.NBz); else if(bz < 0 or bz >= L.NBz) return -1;
+        return int(Kind[l][(bx*L.NBy + by)*L.NBz + bz]);
+    };
+
+    for(int l = 0; l < maxlevel; l++)
+    {
+        GridLevel& L = Level[l];
+        std::vector<size_t> Marked;
+        for(long int bx = 0; bx < L.NBx; bx++)
+        for(long int by = 0; by < L.NBy; by++)
+        for(long int bz = 0; bz < L.NBz; bz++)
+        {
+            const size_t idx = (bx*L.NBy + by)*L.NBz + bz;
+            if(Kind[l][idx] != KindFluid) continue;
+
+            bool Nested = true;
+            for(int x = -1; x <= 1; x++)
+            for(int y = -1; y <= 1; y++)
+            for(int z = -1; z <= 1; z++)
+            {
+                const int kind = KindAt(l, bx+x, by+y, bz+z);
+                if(kind == KindAbsent or kind == KindGhost) Nested = false;
+            }
+            if(Nested and ObstacleNearBlock(l, bx, by, bz, IsObstacle))
+            {
+                Marked.push_back(idx);
+            }
+        }
+        if(Marked.empty()) break;
+        for(size_t idx : Marked) Kind[l][idx] = KindRefined;
+
+        Level.resize(l+2);
+        Kind.resize(l+2);
+        GridLevel& Lc = Level[l];
+        GridLevel& Lf = Level[l+1];
+        Lf.Nx  = 2*Lc.Nx;
+        Lf.Ny  = 2*Lc.Ny;
+        Lf.Nz  = 2*Lc.Nz;
+        Lf.NBx = 2*Lc.NBx;
+        Lf.NBy = 2*Lc.NBy;
+        Lf.NBz = 2*Lc.NBz;
+        Lf.tau = 2.0*(Lc.tau - 0.5) + 0.5;
+        Lf.Acceleration = Lc.Acceleration*0.5;
+        Lf.Volume = Lc.Volume/8.0;
+        Kind[l+1].assign(Lf.NBx*Lf.NBy*Lf.NBz, KindAbsent);
+
+        for(long int bx = 0; bx < Lc.NBx; bx++)
+        for(long int by = 0; by < Lc.NBy; by++)
+        for(long int bz = 0; bz < Lc.NBz; bz++)
+        {
+            const int kind = Kind[l][(bx*Lc.NBy + by)*Lc.NBz + bz];
+            char ChildKind = KindAbsent;
+            if(kind == KindRefined)
+            {
+                ChildKind = KindFluid;
+            }
+            else if(kind == KindFluid)
+            {
+                for(int x = -1; x <= 1; x++)
+                for(int y = -1; y <= 1; y++)
+                for(int z = -1; z <= 1; z++)
+                if(KindAt(l, bx+x, by+y, bz+z) == KindRefined)
+                {
+                    ChildKind = KindGhost;
+                }
+            }
+            if(ChildKind == KindAbsent) continue;
+            for(int x = 0; x <= 1; x++)
+            for(int y = 0; y <= 1; y++)
+            for(int z = 0; z <= 1; z++)
+            {
+                Kind[l+1][((2*bx+x)*Lf.NBy + 2*by+y)*Lf.NBz + 2*bz+z] = ChildKind;
+            }
+        }
+    }
+
+    /* Allocation of the blocks */
+    for(size_t l = 0; l < Level.size(); l++)
+    {
+        GridLevel& L = Level[l];
+        L.Current = 0;
+        L.BlockMap.assign(Kind[l].size(), Absent);
+        L.Blocks.clear();
+        size_t nBlocks = 0;
+        for(size_t idx = 0; idx < Kind[l].size(); idx++)
+        {
+            if(Kind[l][idx] == KindFluid or Kind[l][idx] == KindGhost) nBlocks++;
+        }
+        L.Blocks.resize(nBlocks);
+
+        size_t b = 0;
+        for(long int bx = 0; bx < L.NBx; bx++)
+        for(long int by = 0; by < L.NBy; by++)
+        for(long int bz = 0; bz < L.NBz; bz++)
+        {
+            const size_t idx = (bx*L.NBy + by)*L.NBz + bz;
+            if(Kind[l][idx] == KindRefined)
+            {
+                L.BlockMap[idx] = Refined;
+            }
+            else if(Kind[l][idx] != KindAbsent)
+            {
+                Block& B = L.Blocks[b];
+                B.X0 = bx*BlockSize;
+                B.Y0 = by*BlockSize;
+                B.Z0 = bz*BlockSize;
+                B.Ghost = (Kind[l][idx] == KindGhost);
+                B.Populations[0].Allocate(BlockSize, BlockSize, BlockSize, 1, 1, 1, 0);
+                B.Populations[1].Allocate(BlockSize, BlockSize, BlockSize, 1, 1, 1, 0);
+                B.Flags.Allocate(BlockSize, BlockSize, BlockSize, 1, 1, 1, 0);
+                L.BlockMap[idx] = b;
+                b++;
+            }
+        }
+    }
+
+    for(size_t l = 0; l < Level.size(); l++)
+    {
+        BuildLevel(l, IsObstacle);
+    }
+
+    std::stringstream message;
+    for(size_t l = 0; l < Level.size(); l++)
+    {
+        message << "Level " << l << ": " << FluidCells(l) << " fluid cells";
+        if(l + 1 < Level.size()) message << "\n";
+    }
+    ConsoleOutput::WriteStandard(thisclassname, message.str());
+}
+
+bool LBBlockGrid::ObstacleNearBlock(const int l, const long int bx,
+        const long int by, const long int bz,
+        const std::function<bool(double,double,double)>& IsObstacle) const
+{
+    /* Cell centers of level l and l+1 within two level l cells around the
+    block are tested */
+    const GridLevel& L = Level[l];
+    const long int N[3] = {L.Nx, L.Ny, L.Nz};
+    const long int B0[3] = {bx*BlockSize, by*BlockSize, bz*BlockSize};
+    const double h = 1.0/std::pow(2.0, l);
+
+    for(int sub = 1; sub <= 2; sub++)
+    {
+        const double hs = h/sub;
+        long int Begin[3];
+        long int End[3];
+        for(int d = 0; d < 3; d++)
+        {
+            Begin[d] = sub*(B0[d] - 2);
+            End[d]   = sub*(B0[d] + BlockSize + 2);
+            if(not Periodic[d])
+            {
+                Begin[d] = std::max(Begin[d], 0l);
+                End[d]   = std::min(End[d], sub*N[d]);
+            }
+        }
+        for(long int x = Begin[0]; x < End[0]; x++)
+        for(long int y = Begin[1]; y < End[1]; y++)
+        for(long int z = Begin[2]; z < End[2]; z++)
+        {
+            if(IsObstacle((WrapIndex(x, sub*N[0]) + 0.5)*hs,
+                          (WrapIndex(y, sub*N[1]) + 0.5)*hs,
+                          (WrapIndex(z, sub*N[2]) + 0.5)*hs))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void LBBlockGrid::BuildLevel(const int l,
+        const std::function<bool(double,double,double)>& IsObstacle)
+{
+    GridLevel& L = Level[l];
+    const double h = 1.0/std::pow(2.0, l);
+
+    for(Block& B : L.Blocks)
+    {
+        for(int i = 0; i < BlockSize; i++)
+        for(int j = 0; j < BlockSize; j++)
+        for(int k = 0; k < BlockSize; k++)
+        {
+            int flags = 0;
+            const long int X = B.X0 + i;
+            const long int Y = B.Y0 + j;
+            const long int Z = B.Z0 + k;
+            if(B.Ghost)
+            {
+                /* Ghost cells of margin cells of level l-1 carry parcels */
+                long int PX = X/2;
+                long int PY = Y/2;
+                long int PZ = Z/2;
+                const int pb = Locate(l-1, PX, PY, PZ);
+                const Block& P = Level[l-1].Blocks[pb];
+                if(P.Flags(PX - P.X0, PY - P.Y0, PZ - P.Z0) & MarginCell)
+                {
+                    flags |= TrackedCell;
+                    if(IsObstacle((X + 0.5)*h, (Y + 0.5)*h, (Z + 0.5)*h))
+                    {
+                        ConsoleOutput::WriteExit("Obstacle in the ghost cells of level " + std::to_string(l) + ", increase the distance between obstacles and coarser levels", thisclassname, "BuildLevel()");
+                        OP_Exit(EXIT_FAILURE);
+                    }
+                }
+            }
+            else
+            {
+                if(IsObstacle((X + 0.5)*h, (Y + 0.5)*h, (Z + 0.5)*h))
+                {
+                    flags |= ObstacleCell;
+                }
+                if(l + 1 < int(Level.size()))
+                {
+                    for(int x = -1; x <= 1; x++)
+                    for(int y = -1; y <= 1; y++)
+                    for(int z = -1; z <= 1; z++)
+                    {
+                        long int NX = X + x;
+                        long int NY = Y + y;
+                        long int NZ = Z + z;
+                        if(Locate(l, NX, NY, NZ) == Refined) flags |= MarginCell;
+                    }
+                }
+                if((flags & ObstacleCell) and (flags & MarginCell))
+                {
+                    ConsoleOutput::WriteExit("Obstacle next to the refined region of level " + std::to_string(l+1) + ", increase the distance between obstacles and coarser levels", thisclassname, "BuildLevel()");
+                    OP_Exit(EXIT_FAILURE);
+                }
+            }
+            B.Flags(i,j,k) = flags;
+        }
+    }
+}
+
+int LBBlockGrid::Locate(const int l, long int& X, long int& Y, long int& Z) const
+{
+    const GridLevel& L = Level[l];
+    if(Periodic[0]) X = WrapIndex(X, L.Nx); else if(X < 0 or X >= L.Nx) return Outside;
+    if(Periodic[1]) Y = WrapIndex(Y, L.Ny); else if(Y < 0 or Y >= L.Ny) return Outside;
+    if(Periodic[2]) Z = WrapIndex(Z, L.Nz); else if(Z < 0 or Z >= L.Nz) return Outside;
+    return L.BlockMap[((X/BlockSize)*L.NBy + Y/BlockSize)*L.NBz + Z/BlockSize];
+}
+
+void LBBlockGrid::SetEquilibrium(const double rho, const dVector3 u)
+{
+    const double u2 = u*u;
+    D3Q27 Equilibrium;
+    for(int q = 0; q < Lattice::Q; q++)
+    {
+        const double cu = Lattice::c[q][0]*u[0] + Lattice::c[q][1]*u[1] + Lattice::c[q][2]*u[2];
+        Equilibrium.data()[q] = Lattice::w[q]*rho*(1.0 + 3.0*cu + 4.5*cu*cu - 1.5*u2);
+    }
+    for(GridLevel& L : Level)
+    for(Block& B : L.Blocks)
+    for(int n = 0; n < 2; n++)
+    for(int i = 0; i < BlockSize; i++)
+    for(int j = 0; j < BlockSize; j++)
+    for(int k = 0; k < BlockSize; k++)
+    {
+        B.Populations[n](i,j,k) = Equilibrium;
+    }
+}
+
+void LBBlockGrid::Step(void)
+{
+    Force.set_to_zero();
+    Advance(0, 1);
+}
+
+void LBBlockGrid::Advance(const int l, const int substep)
+{
+    Collide(l);
+    if(l + 1 < int(Level.size()))
+    {
+        Explode(l);
+        Advance(l+1, 1);
+        Advance(l+1, 2);
+    }
+    Stream(l, substep);
+    if(l + 1 < int(Level.size()))
+    {
+        Coalesce(l);
+    }
+    Level[l].Current = 1 - Level[l].Current;
+}
+
+void LBBlockGrid::Collide(const int l)
+{
+    GridLevel& L = Level[l];
+    const double tau = L.tau;
+    const double ForcePrefactor = 1.0 - 0.5/tau;
+    const long int nBlocks = L.Blocks.size();
+
+    #pragma omp parallel for schedule(dynamic)
+    for(long int b = 0; b < nBlocks; b++)
+    {
+        Block& B = L.Blocks[b];
+        if(B.Ghost) continue;
+        for(int i = 0; i < BlockSize; i++)
+        for(int j = 0; j < BlockSize; j++)
+        for(int k = 0; k < BlockSize; k++)
+        {
+            if(B.Flags(i,j,k) & ObstacleCell) continue;
+
+            double* f = B.Populations[L.Current](i,j,k).data();
+            double rho = 0.0;
+            double mom[3] = {0.0, 0.0, 0.0};
+            for(int q = 0; q < Lattice::Q; q++)
+            {
+                rho += f[q];
+                for(int d = 0; d < 3; d++) mom[d] += Lattice::c[q][d]*f[q];
+            }
+            /* Guo forcing, the force term does not change the mass */
+            double u[3];
+            double F[3];
+            for(int d = 0; d < 3; d++)
+            {
+                F[d] = rho*L.Acceleration[d];
+                u[d] = (mom[d] + 0.5*F[d])/rho;
+            }
+            const double u2 = u[0]*u[0] + u[1]*u[1] + u[2]*u[2];
+            for(int q = 0; q < Lattice::Q; q++)
+            {
+                const int* c = Lattice::c[q];
+                const double cu = c[0]*u[0] + c[1]*u[1] + c[2]*u[2];
+                const double cF = c[0]*F[0] + c[1]*F[1] + c[2]*F[2];
+                const double uF = u[0]*F[0] + u[1]*F[1] + u[2]*F[2];
+                const double feq = Lattice::w[q]*rho*(1.0 + 3.0*cu + 4.5*cu*cu - 1.5*u2);
+                const double Fq  = ForcePrefactor*Lattice::w[q]*(3.0*(cF - uF) + 9.0*cu*cF);
+                f[q] += (feq - f[q])/tau + Fq;
+            }
+        }
+    }
+}
+
+void LBBlockGrid::Explode(const int l)
+{
+    const GridLevel& Lc = Level[l];
+    GridLevel& Lf = Level[l+1];
+    const long int nBlocks = Lf.Blocks.size();
+
+    #pragma omp parallel for schedule(dynamic)
+    for(long int b = 0; b < nBlocks; b++)
+    {
+        Block& B = Lf.Blocks[b];
+        if(not B.Ghost) continue;
+        for(int i = 0; i < BlockSize; i++)
+        for(int j = 0; j < BlockSize; j++)
+        for(int k = 0; k < BlockSize; k++)
+        {
+            if(not (B.Flags(i,j,k) & TrackedCell)) continue;
+            long int X = (B.X0 + i)/2;
+            long int Y = (B.Y0 + j)/2;
+            long int Z = (B.Z0 + k)/2;
+            const Block& P = Lc.Blocks[Locate(l, X, Y, Z)];
+            B.Populations[Lf.Current](i,j,k) =
+                P.Populations[Lc.Current](X - P.X0, Y - P.Y0, Z - P.Z0);
+        }
+    }
+}
+
+double LBBlockGrid::CoarseParcel(const int l, long int X, long int Y, long int Z,
+                                 const int q, const int substep) const
+{
+    /* Before sub-step 1 an untracked position holds the population of its
+    parent, before sub-step 2 the one of the parent of its upstream neighbor
+    (or its own reflected population next to a wall) */
+    int qq = q;
+    if(substep == 2)
+    {
+        long int UX = X - Lattice::c[q][0];
+        long int UY = Y - Lattice::c[q][1];
+        long int UZ = Z - Lattice::c[q][2];
+        if(Locate(l, UX, UY, UZ) == Outside)
+        {
+            qq = Lattice::Q - 1 - q;
+        }
+        else
+        {
+            X = UX;
+            Y = UY;
+            Z = UZ;
+        }
+    }
+    X /= 2;
+    Y /= 2;
+    Z /= 2;
+    const GridLevel& Lc = Level[l-1];
+    const int pb = Locate(l-1, X, Y, Z);
+    assert(pb >= 0 and not Lc.Blocks[pb].Ghost);
+    const Block& P = Lc.Blocks[pb];
+    return P.Populations[Lc.Current](X - P.X0, Y - P.Y0, Z - P.Z0).const_data()[qq];
+}
+
+void LBBlockGrid::Stream(const int l, const int substep)
+{
+    GridLevel& L = Level[l];
+    const int Old = L.Current;
+    const int New = 1 - L.Current;
+    const long int nBlocks = L.Blocks.size();
+    double Fx = 0.0;
+    double Fy = 0.0;
+    double Fz = 0.0;
+
+    #pragma omp parallel for schedule(dynamic) reduction(+:Fx,Fy,Fz)
+    for(long int b = 0; b < nBlocks; b++)
+    {
+        Block& B = L.Blocks[b];
+        for(int i = 0; i < BlockSize; i++)
+        for(int j = 0; j < BlockSize; j++)
+        for(int k = 0; k < BlockSize; k++)
+        {
+            const int flags = B.Flags(i,j,k);
+            if(B.Ghost ? not (flags & TrackedCell) : (flags & (ObstacleCell | MarginCell))) continue;
+
+            const double* fOld = B.Populations[Old](i,j,k).const_data();
+            double* fNew = B.Populations[New](i,j,k).data();
+            for(int q = 0; q < Lattice::Q; q++)
+            {
+                const int cx = Lattice::c[q][0];
+                const int cy = Lattice::c[q][1];
+                const int cz = Lattice::c[q][2];
+                const int ii = i - cx;
+                const int jj = j - cy;
+                const int kk = k - cz;
+                if(ii >= 0 and ii < BlockSize and jj >= 0 and jj < BlockSize and kk >= 0 and kk < BlockSize)
+                {
+                    const int srcflags = B.Flags(ii,jj,kk);
+                    if(B.Ghost and not (srcflags & TrackedCell))
+                    {
+                        fNew[q] = CoarseParcel(l, B.X0 + ii, B.Y0 + jj, B.Z0 + kk, q, substep);
+                    }
+                    else if(srcflags & ObstacleCell)
+                    {
+                        fNew[q] = fOld[Lattice::Q - 1 - q];
+                        Fx -= 2.0*cx*fNew[q]*L.Volume;
+                        Fy -= 2.0*cy*fNew[q]*L.Volume;
+                        Fz -= 2.0*cz*fNew[q]*L.Volume;
+                    }
+                    else
+                    {
+                        fNew[q] = B.Populations[Old](ii,jj,kk).const_data()[q];
+                    }
+                    continue;
+                }
+
+                long int X = B.X0 + ii;
+                long int Y = B.Y0 + jj;
+                long int Z = B.Z0 + kk;
+                const int sb = Locate(l, X, Y, Z);
+                if(sb == Outside)
+                {
+                    fNew[q] = fOld[Lattice::Q - 1 - q];
+                }
+                else if(sb >= 0)
+                {
+                    const Block& S = L.Blocks[sb];
+                    const int srcflags = S.Flags(X - S.X0, Y - S.Y0, Z - S.Z0);
+                    if(S.Ghost and not (srcflags & TrackedCell))
+                    {
+                        fNew[q] = CoarseParcel(l, X, Y, Z, q, substep);
+                    }
+                    else if(srcflags & ObstacleCell)
+                    {
+                        fNew[q] = fOld[Lattice::Q - 1 - q];
+                        Fx -= 2.0*cx*fNew[q]*L.Volume;
+                        Fy -= 2.0*cy*fNew[q]*L.Volume;
+                        Fz -= 2.0*cz*fNew[q]*L.Volume;
+                    }
+                    else
+                    {
+                        fNew[q] = S.Populations[Old](X - S.X0, Y - S.Y0, Z - S.Z0).const_data()[q];
+                    }
+                }
+                else
+                {
+                    /* Only ghost cells reach into the coarser level, margin
+                    cells are not streamed */
+                    assert(sb == Absent);
+                    fNew[q] = CoarseParcel(l, X, Y, Z, q, substep);
+                }
+            }
+        }
+    }
+    Force[0] += Fx;
+    Force[1] += Fy;
+    Force[2] += Fz;
+}
+
+void LBBlockGrid::Coalesce(const int l)
+{
+    GridLevel& Lc = Level[l];
+    const GridLevel& Lf = Level[l+1];
+    const int New = 1 - Lc.Current;
+    const long int nBlocks = Lc.Blocks.size();
+
+    #pragma omp parallel for schedule(dynamic)
+    for(long int b = 0; b < nBlocks; b++)
+    {
+        Block& B = Lc.Blocks[b];
+        if(B.Ghost) continue;
+        for(int i = 0; i < BlockSize; i++)
+        for(int j = 0; j < BlockSize; j++)
+        for(int k = 0; k < BlockSize; k++)
+        {
+            if(not (B.Flags(i,j,k) & MarginCell)) continue;
+
+            double* f = B.Populations[New](i,j,k).data();
+            for(int q = 0; q < Lattice::Q; q++) f[q] = 0.0;
+            for(int x = 0; x <= 1; x++)
+            for(int y = 0; y <= 1; y++)
+            for(int z = 0; z <= 1; z++)
+            {
+                long int X = 2*(B.X0 + i) + x;
+                long int Y = 2*(B.Y0 + j) + y;
+                long int Z = 2*(B.Z0 + k) + z;
+                const Block& C = Lf.Blocks[Locate(l+1, X, Y, Z)];
+                const double* fc = C.Populations[Lf.Current](X - C.X0, Y - C.Y0, Z - C.Z0).const_data();
+                for(int q = 0; q < Lattice::Q; q++) f[q] += 0.125*fc[q];
+            }
+        }
+    }
+}
+
+double LBBlockGrid::Mass(void) const
+{
+    double Total = 0.0;
+    for(const GridLevel& L : Level)
+    for(const Block& B : L.Blocks)
+    {
+        if(B.Ghost) continue;
+        for(int i = 0; i < BlockSize; i++)
+        for(int j = 0; j < BlockSize; j++)
+        for(int k = 0; k < BlockSize; k++)
+        {
+            if(B.Flags(i,j,k) & ObstacleCell) continue;
+            const double* f = B.Populations[L.Current](i,j,k).const_data();
+            for(int q = 0; q < Lattice::Q; q++) Total += f[q]*L.Volume;
+        }
+    }
+    return Total;
+}
+
+bool LBBlockGrid::Velocity(const double x, const double y, const double z,
+                           dVector3& u) const
+{
+    for(int l = Level.size() - 1; l >= 0; l--)
+    {
+        const GridLevel& L = Level[l];
+        const double scale = std::pow(2.0, l);
+        long int X = std::floor(x*scale);
+        long int Y = std::floor(y*scale);
+        long int Z = std::floor(z*scale);
+        const int b = Locate(l, X, Y, Z);
+        if(b < 0 or L.Blocks[b].Ghost) continue;
+
+        const Block& B = L.Blocks[b];
+        u.set_to_zero();
+        if(B.Flags(X - B.X0, Y - B.Y0, Z - B.Z0) & ObstacleCell) return true;
+
+        const double* f = B.Populations[L.Current](X - B.X0, Y - B.Y0, Z - B.Z0).const_data();
+        double rho = 0.0;
+        for(int q = 0; q < Lattice::Q; q++)
+        {
+            rho += f[q];
+            for(int d = 0; d < 3; d++) u[d] += Lattice::c[q][d]*f[q];
+        }
+        for(int d = 0; d < 3; d++)
+        {
+            u[d] = (u[d] + 0.5*rho*L.Acceleration[d])/rho;
+        }
+        return true;
+    }
+    return false;
+}
+
+size_t LBBlockGrid::FluidCells(const int l) const
+{
+    size_t Count = 0;
+    for(const Block& B : Level[l].Blocks)
+    {
+        if(B.Ghost) continue;
+        for(int i = 0; i < BlockSize; i++)
+        for(int j = 0; j < BlockSize; j++)
+        for(int k = 0; k < BlockSize; k++)
+        {
+            if(not (B.Flags(i,j,k) & ObstacleCell)) Count++;
+        }
+    }
+    return Count;
+}
+
+size_t LBBlockGrid::CellUpdates(void) const
+{
+    size_t Updates = 0;
+    for(size_t l = 0; l < Level.size(); l++)
+    {
+        Updates += FluidCells(l) << l;
+    }
+    return Updates;
+}
+
+} //namespace openphase
@@ -0,0 +1,409 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo; Raphael Schiedung
+ *
+ */
+
+#include "FluidDynamics/LBDeviceSolver.h"
+#include "GridParameters.h"
+
+namespace openphase
+{
+
+#pragma omp declare target
+/* Second order equilibrium population of direction (x,y,z), same as
+FlowSolverLBM::EquilibriumDistribution()*/
+static inline double Equilibrium(const double w, const int x, const int y,
+        const int z, const double rho, const double ux, const double uy,
+        const double uz)
+{
+    const double u2 = ux*ux + uy*uy + uz*uz;
+    const double cu = x*ux + y*uy + z*uz;
+    return rho*w*(1.0 - 1.5*u2 + cu*(3.0 + 4.5*cu));
+}
+#pragma omp end declare target
+
+LBDeviceSolver::~LBDeviceSolver(void)
+{
+    Release();
+}
+
+void LBDeviceSolver::Allocate(const GridParameters& Grid, const size_t ncomp,
+        const double weights[3][3][3])
+{
+    Release();
+
+    Nx = Grid.Nx;
+    Ny = Grid.Ny;
+    Nz = Grid.Nz;
+    dNx = Grid.dNx;
+    dNy = Grid.dNy;
+    dNz = Grid.dNz;
+    Ncomp = ncomp;
+    Ncells = Nx*Ny*Nz;
+
+    // Directions along inactive dimensions are switched off by a zero weight
+    for (int x = -1; x <= 1; x++)
+    for (int y = -1; y <= 1; y++)
+    for (int z = -1; z <= 1; z++)
+    {
+        const bool active = std::abs(x) <= dNx and std::abs(y) <= dNy and std::abs(z) <= dNz;
+        Weights[9*(x+1) + 3*(y+1) + (z+1)] = active ? weights[x+1][y+1][z+1] : 0.0;
+    }
+
+    const size_t NPopulations = Ncomp*27*Ncells;
+    const size_t NVectors     = Ncomp*3*Ncells;
+    const size_t NScalars     = Ncomp*Ncells;
+    const size_t NCells       = Ncells;
+
+    Populations    = new double[NPopulations]();
+    PopulationsTMP = new double[NPopulations]();
+    Density        = new double[NScalars]();
+    Momentum       = new double[NVectors]();
+    Force          = new double[NVectors]();
+    Obstacle       = new int[NCells]();
+
+    // The aliases are only used by the target pragmas, which are ignored without offload
+    [[maybe_unused]] double* f   = Populations;
+    [[maybe_unused]] double* ft  = PopulationsTMP;
+    [[maybe_unused]] double* rho = Density;
+    [[maybe_unused]] double* mom = Momentum;
+    [[maybe_unused]] double* F   = Force;
+    [[maybe_unused]] int*    obs = Obstacle;
+    #pragma omp target enter data map(to: f[0:NPopulations], ft[0:NPopulations], \
+            rho[0:NScalars], mom[0:NVectors], F[0:NVectors], obs[0:NCells])
+}
+
+void LBDeviceSolver::Release(void)
+{
+    if (not IsAllocated()) return;
+
+    const size_t NPopulations = Ncomp*27*Ncells;
+    const size_t NVectors     = Ncomp*3*Ncells;
+    const size_t NScalars     = Ncomp*Ncells;
+    const size_t NCells       = Ncells;
+
+    [[maybe_unused]] double* f   = Populations;
+    [[maybe_unused]] double* ft  = PopulationsTMP;
+    [[maybe_unused]] double* rho = Density;
+    [[maybe_unused]] double* mom = Momentum;
+    [[maybe_unused]] double* F   = Force;
+    [[maybe_unused]] int*    obs = Obstacle;
+    #pragma omp target exit data map(delete: f[0:NPopulations], ft[0:NPopulations], \
+            rho[0:NScalars], mom[0:NVectors], F[0:NVectors], obs[0:NCells])
+
+    delete[] Populations;
+    delete[] PopulationsTMP;
+    delete[] Density;
+    delete[] Momentum;
+    delete[] Force;
+    delete[] Obstacle;
+    Populations    = nullptr;
+    PopulationsTMP = nullptr;
+    Density        = nullptr;
+    Momentum       = nullptr;
+    Force          = nullptr;
+    Obstacle       = nullptr;
+    Ncells = 0;
+}
+
+void LBDeviceSolver::CopyPopulationsToDevice(const Storage3D<lbnode_t,1>& locPopulations)
+{
+    const size_t NPopulations = Ncomp*27*Ncells;
+    double* f = Populations;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (long int i = 0; i < Nx; ++i)
+    for (long int j = 0; j < Ny; ++j)
+    for (long int k = 0; k < Nz; ++k)
+    {
+        const size_t idx = (i*Ny + j)*Nz + k;
+        for (size_t n = 0; n < Ncomp; ++n)
+        for (int q = 0; q < 27; ++q)
+        {
+            f[(n*27 + q)*Ncells + idx] = locPopulations(i,j,k,{n})(q/9 - 1, (q/3)%3 - 1, q%3 - 1);
+        }
+    }
+    #pragma omp target update to(f[0:NPopulations])
+}
+
+void LBDeviceSolver::CopyPopulationsToHost(Storage3D<lbnode_t,1>& locPopulations) const
+{
+    const size_t NPopulations = Ncomp*27*Ncells;
+    double* f = Populations;
+    #pragma omp target update from(f[0:NPopulations])
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (long int i = 0; i < Nx; ++i)
+    for (long int j = 0; j < Ny; ++j)
+    for (long int k = 0; k < Nz; ++k)
+    {
+        const size_t idx = (i*Ny + j)*Nz + k;
+        for (size_t n = 0; n < Ncomp; ++n)
+        for (int q = 0; q < 27; ++q)
+        {
+            locPopulations(i,j,k,{n})(q/9 - 1, (q/3)%3 - 1, q%3 - 1) = f[(n*27 + q)*Ncells + idx];
+        }
+    }
+}
+
+void LBDeviceSolver::CopyObstacleToDevice(const Storage3D<int,0>& locObstacle)
+{
+    const size_t NCells = Ncells;
+    int* obs = Obstacle;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (long int i = 0; i < Nx; ++i)
+    for (long int j = 0; j < Ny; ++j)
+    for (long int k = 0; k < Nz; ++k)
+    {
+        obs[(i*Ny + j)*Nz + k] = locObstacle(i,j,k);
+    }
+    #pragma omp target update to(obs[0:NCells])
+}
+
+void LBDeviceSolver::CopyForceDensityToDevice(const Storage3D<dVector3,1>& ForceDensity,
+        const double df)
+{
+    const size_t NVectors = Ncomp*3*Ncells;
+    double* F = Force;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (long int i = 0; i < Nx; ++i)
+    for (long int j = 0; j < Ny; ++j)
+    for (long int k = 0; k < Nz; ++k)
+    {
+        const size_t idx = (i*Ny + j)*Nz + k;
+        for (size_t n = 0; n < Ncomp; ++n)
+        for (int d = 0; d < 3; ++d)
+        {
+            F[(n*3 + d)*Ncells + idx] = ForceDensity(i,j,k,{n})[d]/df;
+        }
+    }
+    #pragma omp target update to(F[0:NVectors])
+}
+
+void LBDeviceSolver::CopyMomentsToHost(Storage3D<real_t,1>& DensityWetting,
+        Storage3D<dVector3,1>& MomentumDensity, const Storage3D<int,0>& locObstacle,
+        const double dRho, const double dm)
+{
+    const size_t NVectors = Ncomp*3*Ncells;
+    const size_t NScalars = Ncomp*Ncells;
+    double* rho = Density;
+    double* mom = Momentum;
+    #pragma omp target update from(rho[0:NScalars], mom[0:NVectors])
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (long int i = 0; i < Nx; ++i)
+    for (long int j = 0; j < Ny; ++j)
+    for (long int k = 0; k < Nz; ++k)
+    if (not locObstacle(i,j,k))
+    {
+        const size_t idx = (i*Ny + j)*Nz + k;
+        for (size_t n = 0; n < Ncomp; ++n)
+        {
+            DensityWetting(i,j,k,{n}) = rho[n*Ncells + idx]*dRho;
+            for (int d = 0; d < 3; ++d)
+            {
+                MomentumDensity(i,j,k,{n})[d] = mom[(n*3 + d)*Ncells + idx]*dm;
+            }
+        }
+    }
+}
+
+void LBDeviceSolver::Propagate(void)
+{
+    double* f = Populations;
+    double* ft = PopulationsTMP;
+    const int* obs = Obstacle;
+    const long int nx = Nx;
+    const long int ny = Ny;
+    const long int nz = Nz;
+    const size_t ncells = Ncells;
+    const size_t ncomp = Ncomp;
+    const double* w = Weights;
+
+    #pragma omp target teams distribute parallel for collapse(3) map(to: w[0:27])
+    for (long int i = 0; i < nx; ++i)
+    for (long int j = 0; j < ny; ++j)
+    for (long int k = 0; k < nz; ++k)
+    {
+        const size_t idx = (i*ny + j)*nz + k;
+        for (size_t n = 0; n < ncomp; ++n)
+        for (int q = 0; q < 27; ++q)
+        if (w[q] != 0.0)
+        {
+            const size_t dst = (n*27 + q)*ncells + idx;
+            if (obs[idx])
+            {
+                ft[dst] = f[dst];
+                continue;
+            }
+            const long int si = (i - (q/9 - 1) + nx) % nx;
+            const long int sj = (j - ((q/3)%3 - 1) + ny) % ny;
+            const long int sk = (k - (q%3 - 1) + nz) % nz;
+            const size_t src = (si*ny + sj)*nz + sk;
+            if (obs[src])
+            {
+                // Halfway bounce back of the opposite population (26 - q)
+                ft[dst] = f[(n*27 + 26 - q)*ncells + idx];
+            }
+            else
+            {
+                ft[dst] = f[(n*27 + q)*ncells + src];
+            }
+        }
+    }
+    std::swap(Populations, PopulationsTMP);
+}
+
+void LBDeviceSolver::CalculateMoments(const bool FixPopulations)
+{
+    double* f = Populations;
+    double* rho = Density;
+    double* mom = Momentum;
+    const int* obs = Obstacle;
+    const size_t ncells = Ncells;
+    const size_t ncomp = Ncomp;
+    const double* w = Weights;
+
+    #pragma omp target teams distribute parallel for map(to: w[0:27])
+    for (size_t idx = 0; idx < ncells; ++idx)
+    for (size_t n = 0; n < ncomp; ++n)
+    {
+        double locRho = 0.0;
+        double locMom[3] = {0.0, 0.0, 0.0};
+        bool Fix = false;
+        for (int q = 0; q < 27; ++q)
+        if (w[q] != 0.0)
+        {
+            const double fq = f[(n*27 + q)*ncells + idx];
+            locRho    += fq;
+            locMom[0] += (q/9 - 1)*fq;
+            locMom[1] += ((q/3)%3 - 1)*fq;
+            locMom[2] += (q%3 - 1)*fq;
+            if (fq <= 0.0) Fix = true;
+        }
+        if (FixPopulations and not obs[idx] and (Fix or locRho <= 0.0))
+        {
+            if (locRho <= 0.0)
+            {
+                locRho = 0.0;
+                locMom[0] = locMom[1] = locMom[2] = 0.0;
+            }
+            const double ux = (locRho != 0.0) ? locMom[0]/locRho : 0.0;
+            const double uy = (locRho != 0.0) ? locMom[1]/locRho : 0.0;
+            const double uz = (locRho != 0.0) ? locMom[2]/locRho : 0.0;
+            for (int q = 0; q < 27; ++q)
+            if (w[q] != 0.0)
+            {
+                f[(n*27 + q)*ncells + idx] = Equilibrium(w[q], q/9 - 1,
+                        (q/3)%3 - 1, q%3 - 1, locRho, ux, uy, uz);
+            }
+        }
+        rho[n*ncells + idx] = locRho;
+        for (int d = 0; d < 3; ++d) mom[(n*3 + d)*ncells + idx] = locMom[d];
+    }
+}
+
+void LBDeviceSolver::CollisionGuo(const std::vector<double>& tau)
+{
+    double* f = Populations;
+    const double* rho = Density;
+    const double* mom = Momentum;
+    const double* F = Force;
+    const int* obs = Obstacle;
+    const size_t ncells = Ncells;
+    const size_t ncomp = Ncomp;
+    const double* w = Weights;
+    const double* locTau = tau.data();
+
+    #pragma omp target teams distribute parallel for map(to: w[0:27], locTau[0:ncomp])
+    for (size_t idx = 0; idx < ncells; ++idx)
+    if (not obs[idx])
+    for (size_t n = 0; n < ncomp; ++n)
+    {
+        const double locRho = rho[n*ncells + idx];
+        const double Fx = F[(n*3 + 0)*ncells + idx];
+        const double Fy = F[(n*3 + 1)*ncells + idx];
+        const double Fz = F[(n*3 + 2)*ncells + idx];
+        // Velocity including half of the force (force projection method)
+        const double ux = (locRho != 0.0) ? (mom[(n*3 + 0)*ncells + idx] + 0.5*Fx)/locRho : 0.0;
+        const double uy = (locRho != 0.0) ? (mom[(n*3 + 1)*ncells + idx] + 0.5*Fy)/locRho : 0.0;
+        const double uz = (locRho != 0.0) ? (mom[(n*3 + 2)*ncells + idx] + 0.5*Fz)/locRho : 0.0;
+        for (int q = 0; q < 27; ++q)
+        if (w[q] != 0.0)
+        {
+            const int x = q/9 - 1;
+            const int y = (q/3)%3 - 1;
+            const int z = q%3 - 1;
+            double& fq = f[(n*27 + q)*ncells + idx];
+            fq += (Equilibrium(w[q], x, y, z, locRho, ux, uy, uz) - fq)/locTau[n];
+            fq += (1.0 - 0.5/locTau[n])*w[q]*
+                  (3.0*((x - ux)*Fx + (y - uy)*Fy + (z - uz)*Fz) +
+                   9.0*(ux*x + uy*y + uz*z)*(x*Fx + y*Fy + z*Fz));
+        }
+    }
+}
+
+void LBDeviceSolver::CollisionED(const std::vector<double>& tau, const double ForceScale)
+{
+    double* f = Populations;
+    const double* rho = Density;
+    const double* mom = Momentum;
+    const double* F = Force;
+    const int* obs = Obstacle;
+    const size_t ncells = Ncells;
+    const size_t ncomp = Ncomp;
+    const double* w = Weights;
+    const double* locTau = tau.data();
+
+    #pragma omp target teams distribute parallel for map(to: w[0:27], locTau[0:ncomp])
+    for (size_t idx = 0; idx < ncells; ++idx)
+    if (not obs[idx])
+    for (size_t n = 0; n < ncomp; ++n)
+    {
+        const double locRho = rho[n*ncells + idx];
+        const double q1 = 1.0 - 1.0/locTau[n];
+        double u[3]  = {0.0, 0.0, 0.0};
+        double uF[3] = {0.0, 0.0, 0.0};
+        if (locRho != 0.0)
+        for (int d = 0; d < 3; ++d)
+        {
+            u [d] = mom[(n*3 + d)*ncells + idx]/locRho;
+            uF[d] = (mom[(n*3 + d)*ncells + idx] + F[(n*3 + d)*ncells + idx]*ForceScale)/locRho;
+        }
+        for (int q = 0; q < 27; ++q)
+        if (w[q] != 0.0)
+        {
+            const int x = q/9 - 1;
+            const int y = (q/3)%3 - 1;
+            const int z = q%3 - 1;
+            double& fq = f[(n*27 + q)*ncells + idx];
+            fq = (fq - Equilibrium(w[q], x, y, z, locRho, u[0], u[1], u[2]))*q1 +
+                       Equilibrium(w[q], x, y, z, locRho, uF[0], uF[1], uF[2]);
+        }
+    }
+}
+
+} //namespace openphase
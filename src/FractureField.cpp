@@ -66,6 +66,8 @@ void FractureField::Initialize(Settings& locSettings, std::string ObjectNameSuff
     FractureFieldLaplacianStencil = LaplacianStencils::Isotropic;
     FractureFieldGradientStencil  = GradientStencils::Isotropic;
     FractureModel = FractureModels::Obstacle;
+    CrackBand     = true;
+    BandValid     = false;
 
     Fields          .Allocate(Grid, Grid.Bcells);
     Fields_dot      .Allocate(Grid, Grid.Bcells);
@@ -73,8 +75,6 @@ void FractureField::Initialize(Settings& locSettings, std::string ObjectNameSuff
     Flag            .Allocate(Grid, Grid.Bcells);
     DisplacementsOLD.Allocate(Grid, Grid.Bcells);
     SurfaceEnergy     .Allocate(Grid, Grid.Bcells);
-    TestOutput.Allocate(Grid, Grid.Bcells);
-    TestOutput2.Allocate(Grid, Grid.Bcells);
 
     switch(Grid.Active())
     {
@@ -178,7 +178,7 @@ void FractureField::ReadInput(const string InputFileName)
     ConsoleOutput::WriteLineInsert("Fracture field input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -190,7 +190,6 @@ void FractureField::ReadInput(const string InputFileName)
     data << inp.rdbuf();
     ReadInput(data);
 
-    inp.close();
 }
 
 void FractureField::ReadInput(stringstream& inp)
@@ -202,6 +201,7 @@ void FractureField::ReadInput(stringstream& inp)
     delta_g_0     = FileInterface::ReadParameterD(inp, moduleLocation, string("delta_g_0"), false, 30000);
     string mode   = FileInterface::ReadParameterK(inp, moduleLocation, string("FractureModel"), false, string("Obstacle"));
     InitialSurfaceEnergy = FileInterface::ReadParameterD(inp, moduleLocation, string("Sigma"),     true, 1.0);
+    CrackBand     = FileInterface::ReadParameterB(inp, moduleLocation, string("CrackBand"), false, true);
 
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells(), )
     {
@@ -355,6 +355,7 @@ void FractureField::Advect(AdvectionHR& Adv, const Velocities& Vel, PhaseField&
     if (Fields_dot.IsNotAllocated()) Fields_dot.Allocate(Fields);
     if(not Fields_dot.IsSize(Grid.Nx, Grid.Ny, Grid.Nz)) Fields_dot.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
     Adv.AdvectField(Fields, Fields_dot, Vel, BC, dt);
+    BandValid = false;
 }
 
 void FractureField::CreatePF(PhaseField& Phase, size_t PhaseIndex, BoundaryConditions& BC)
@@ -449,6 +450,7 @@ void FractureField::CreateCrack(dVector3& CrackStart, dVector3& CrackEnd, Settin
         }
     }
     STORAGE_LOOP_END
+    BandValid = false;
     Finalize(BC);
     CorrectFractureProfile(BC, 1e-8, 1000);
 }
@@ -487,12 +489,8 @@ void FractureField::CorrectFractureProfile( BoundaryConditions& BC, double locMo
     };
     for (size_t i = 0; i < nSteps; ++i)
     {
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, 0, )
-        {
-            CalculateFielddot(i, j, k); 
-        }
-       OMP_PARALLEL_STORAGE_LOOP_END
-       MergeIncrements(BC, 0.01);
+        ForEachCrackCell(CalculateFielddot);
+        MergeIncrements(BC, 0.01);
     }
 }
 
@@ -538,7 +536,7 @@ void FractureField::Solve(PhaseField& Phase,
 
 void FractureField::CalculateIncrementsWell(const PhaseField& Phase, InterfaceProperties& IP, ElasticProperties& EP, DoubleObstacle& DO)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, 0, )
+    ForEachCrackCell([&](const long int i, const long int j, const long int k)
     {
         if (Flag(i, j, k))
         {
@@ -552,8 +550,7 @@ void FractureField::CalculateIncrementsWell(const PhaseField& Phase, InterfacePr
         {
              Fields_dot(i, j, k) += 2.0 * Mobility * EP.EnergyDensity(Phase,i, j, k) / (1.0 - Fields(i, j, k));
         }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    });
 }
 
 void FractureField::CalculateIncrementsObstacle(const PhaseField& Phase, InterfaceProperties& IP, ElasticProperties& EP, DoubleObstacle& DO)
@@ -561,21 +558,40 @@ void FractureField::CalculateIncrementsObstacle(const PhaseField& Phase, Interfa
     double Eta     = sWidth * Grid.dx;
     double epsilon = 3 / 16.0 * Eta;
     double K       = 9 / 64.0;
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, 0, )
+
+#ifdef DEBUG
+    /* Diagnostic storages, allocated on first use */
+    if (TestOutput.IsNotAllocated())
+    {
+        TestOutput .Allocate(Grid, Grid.Bcells);
+        TestOutput2.Allocate(Grid, Grid.Bcells);
+        ConsoleOutput::WriteStandard(thisclassname, "Allocated TestOutput, TestOutput2");
+    }
+    if (not TestOutput.IsSize(Grid.Nx, Grid.Ny, Grid.Nz))
+    {
+        TestOutput .Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+        TestOutput2.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
+#endif
+
+    ForEachCrackCell([&](const long int i, const long int j, const long int k)
     {
         if (Flag(i, j, k))
         {
             Fields_dot(i, j, k) = Mobility * (SurfaceEnergy(i, j, k) * (2 * epsilon * Laplacian(i, j, k) - K/epsilon));
+#ifdef DEBUG
             TestOutput(i,j,k) = Fields_dot(i,j,k);
+#endif
         }
 
         if (Flag(i, j, k) and Fields(i, j, k) != 1.0)
         {
             Fields_dot(i, j, k) += 2.0 * Mobility * EP.EnergyDensity(Phase,i, j, k) / (1.0 - Fields(i, j, k));
+#ifdef DEBUG
             TestOutput2(i,j,k) =   2.0 * Mobility * EP.EnergyDensity(Phase,i, j, k) / (1.0 - Fields(i, j, k));
+#endif
         }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    });
 }
 
 void FractureField::ApplyAdvection(Settings &locSettings, PhaseField& Phase, ElasticProperties& EP, Orientations& OR,
@@ -645,7 +661,7 @@ void FractureField::FixAdvectionFractureProfile(ElasticProperties &EP)
         }
         return Displacement;
     };
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, 0, )
+    ForEachCrackCell([&](const long int i, const long int j, const long int k)
     {
         if (Flag(i, j, k))
         {
@@ -656,8 +672,7 @@ void FractureField::FixAdvectionFractureProfile(ElasticProperties &EP)
                 Fields(i, j, k) += maxDisplacement(i, j, k);
             }
         }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    });
 }
 
 void FractureField::SetMobilityPF(PhaseField &Phase, InterfaceProperties &IP)
@@ -690,7 +705,7 @@ void FractureField::SetMobilityPF(PhaseField &Phase, InterfaceProperties &IP)
 
 void FractureField::SetDrivingForcePF(const PhaseField &Phase, DrivingForce &dGab)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields,0,)
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,Fields,Phase.Occupancy,)
     if(Phase.Fields(i,j,k).wide_interface())
     {
         for(auto alpha  = Phase.Fields(i, j, k).cbegin();
@@ -702,10 +717,39 @@ void FractureField::SetDrivingForcePF(const PhaseField &Phase, DrivingForce &dGa
                 dGab.Force(i,j,k).set_raw(alpha->index, beta->index, 0.0);
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
 }
 void FractureField::SetFracturedElasticConstants(ElasticProperties& EP)
 {
+    if (CrackBand and BandValid)
+    {
+        /* The elastic constants only change where the fracture field is
+        nonzero, i.e. in the crack band.*/
+        const long int reachX = std::min(EP.EffectiveElasticConstants.BcellsX(), Fields.BcellsX());
+        const long int reachY = std::min(EP.EffectiveElasticConstants.BcellsY(), Fields.BcellsY());
+        const long int reachZ = std::min(EP.EffectiveElasticConstants.BcellsZ(), Fields.BcellsZ());
+        auto Degrade = [&](const long int i, const long int j, const long int k)
+        {
+            if (Fields(i, j, k) != 0.0 and
+                i >= -reachX and i < Fields.sizeX() + reachX and
+                j >= -reachY and j < Fields.sizeY() + reachY and
+                k >= -reachZ and k < Fields.sizeZ() + reachZ)
+            {
+                EP.EffectiveElasticConstants(i, j, k) *= (1.0 - Fields(i, j, k)) * (1.0 - Fields(i, j, k));
+            }
+        };
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i, j, k, BandCells, )
+        {
+            Degrade(i, j, k);
+        }
+        OMP_PARALLEL_CELL_LIST_LOOP_END
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i, j, k, BandBoundaryCells, )
+        {
+            Degrade(i, j, k);
+        }
+        OMP_PARALLEL_CELL_LIST_LOOP_END
+        return;
+    }
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, EP.EffectiveElasticConstants, EP.EffectiveElasticConstants.Bcells(), )
     {
         EP.EffectiveElasticConstants(i, j, k) *= (1.0 - Fields(i, j, k)) * (1.0 - Fields(i, j, k));
@@ -716,7 +760,7 @@ void FractureField::SetFracturedElasticConstants(ElasticProperties& EP)
 void FractureField::MergeIncrements(const BoundaryConditions& BC,
                                            const double dt)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, 0, )
+    ForEachCrackCell([&](const long int i, const long int j, const long int k)
     {
         if (Flag(i, j, k))
         {
@@ -727,8 +771,7 @@ void FractureField::MergeIncrements(const BoundaryConditions& BC,
            }
            Fields_dot(i, j, k) = 0;
         }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    });
     Finalize(BC);
 }
 
@@ -742,6 +785,7 @@ void FractureField::Clear()
         Flag      (i, j, k) = 0;
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+    BandValid = false;
 }
 
 dVector3 FractureField::Gradient(const int i, const int j, const int k) const
@@ -816,22 +860,47 @@ void FractureField::CalculateCrackTip()
 void FractureField::CalculateLaplacians(void)
 {
     const int offset = Fields.Bcells() - 1;
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, offset, )
+    if (CrackBand and BandValid)
     {
-        if (Flag(i, j, k))
+        const long int reachX = std::min<long int>(Fields.BcellsX(), offset);
+        const long int reachY = std::min<long int>(Fields.BcellsY(), offset);
+        const long int reachZ = std::min<long int>(Fields.BcellsZ(), offset);
+        auto LaplacianCell = [&](const long int i, const long int j, const long int k)
         {
-            Laplacian(i, j, k) = 0.0;
-            for (auto ls = LStencil.begin(); ls != LStencil.end(); ls++)
+            if (Flag(i, j, k) and
+                i >= -reachX and i < Fields.sizeX() + reachX and
+                j >= -reachY and j < Fields.sizeY() + reachY and
+                k >= -reachZ and k < Fields.sizeZ() + reachZ)
             {
-                int ii = i + ls->di;
-                int jj = j + ls->dj;
-                int kk = k + ls->dk;
-
-                Laplacian(i, j, k) += ls->weight * Fields(ii, jj, kk);
+                double value = 0.0;
+                for (auto ls = LStencil.cbegin(); ls != LStencil.cend(); ++ls)
+                {
+                    value += ls->weight * Fields(i + ls->di, j + ls->dj, k + ls->dk);
+                }
+                Laplacian(i, j, k) = value;
             }
+        };
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i, j, k, BandCells, )
+        {
+            LaplacianCell(i, j, k);
         }
+        OMP_PARALLEL_CELL_LIST_LOOP_END
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i, j, k, BandBoundaryCells, )
+        {
+            LaplacianCell(i, j, k);
+        }
+        OMP_PARALLEL_CELL_LIST_LOOP_END
+        return;
+    }
+    const bool fixed = FixedStencils::Laplacian(FractureFieldLaplacianStencil, Grid,
+                                                [&](auto Stencil)
+    {
+        StencilKernels::Laplacian<decltype(Stencil)>(Fields, Laplacian, Flag, Grid.dx, offset);
+    });
+    if(not fixed)
+    {
+        StencilKernels::Laplacian(Fields, LStencil, Laplacian, Flag, offset);
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
 }
 
 void FractureField::SetFlags(void)
@@ -855,8 +924,7 @@ void FractureField::SetFlags(void)
 
 void FractureField::Finalize(const BoundaryConditions& BC)
 {
-    const int offset = Fields.Bcells();
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, offset, )
+    auto FinalizeCell = [&](const long int i, const long int j, const long int k)
     {
         if (Flag(i, j, k))
         {
@@ -873,14 +941,99 @@ void FractureField::Finalize(const BoundaryConditions& BC)
             Fields_dot(i, j, k) = 0;
             Laplacian(i, j, k)  = 0;
         }
+    };
+
+    if (CrackBand and BandValid)
+    {
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i, j, k, BandCells, )
+        {
+            FinalizeCell(i, j, k);
+        }
+        OMP_PARALLEL_CELL_LIST_LOOP_END
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i, j, k, BandBoundaryCells, )
+        {
+            FinalizeCell(i, j, k);
+        }
+        OMP_PARALLEL_CELL_LIST_LOOP_END
+    }
+    else
+    {
+        const int offset = Fields.Bcells();
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, offset, )
+        {
+            FinalizeCell(i, j, k);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
 
     SetBoundaryConditions(BC);
     SetFlags();
+    if (CrackBand)
+    {
+        SetCrackBand();
+    }
     CalculateLaplacians();
 }
 
+void FractureField::SetCrackBand(void)
+{
+    /* Each thread collects the cells of a contiguous range of x-planes, the
+    per-thread lists are then concatenated in thread order. The band cell
+    lists are therefore sorted in storage order.*/
+    const long int bX = Fields.BcellsX();
+    const long int bY = Fields.BcellsY();
+    const long int bZ = Fields.BcellsZ();
+    const long int Nx = Fields.sizeX() + 2*bX;
+
+    std::vector<std::vector<iVector3>> ThreadCells;
+    std::vector<std::vector<iVector3>> ThreadBoundaryCells;
+
+    #pragma omp parallel
+    {
+        const int thread = omp_get_thread_num();
+        const int nth    = omp_get_num_threads();
+
+        #pragma omp single
+        {
+            ThreadCells.resize(nth);
+            ThreadBoundaryCells.resize(nth);
+        }
+
+        const long int chunk = (Nx + nth - 1)/nth;
+        const long int first = std::min(Nx, thread*chunk);
+        const long int last  = std::min(Nx, first + chunk);
+
+        for(long int i = first - bX; i < last - bX; i++)
+        for(long int j = -bY; j < Fields.sizeY() + bY; j++)
+        for(long int k = -bZ; k < Fields.sizeZ() + bZ; k++)
+        if(Flag(i,j,k) != 0.0 or Fields(i,j,k) != 0.0)
+        {
+            if(i >= 0 and i < Fields.sizeX() and
+               j >= 0 and j < Fields.sizeY() and
+               k >= 0 and k < Fields.sizeZ())
+            {
+                ThreadCells[thread].push_back(iVector3({i,j,k}));
+            }
+            else
+            {
+                ThreadBoundaryCells[thread].push_back(iVector3({i,j,k}));
+            }
+        }
+    }
+
+    BandCells.clear();
+    BandBoundaryCells.clear();
+    for(const auto& cells : ThreadCells)
+    {
+        BandCells.insert(BandCells.end(), cells.begin(), cells.end());
+    }
+    for(const auto& cells : ThreadBoundaryCells)
+    {
+        BandBoundaryCells.insert(BandBoundaryCells.end(), cells.begin(), cells.end());
+    }
+    BandValid = true;
+}
+
 void FractureField::PrintVolumeFractions(void)
 {
     double VolumeFraction = 0.0;
@@ -995,6 +1148,7 @@ bool FractureField::Read(string FileName)
         Fields(i, j, k) = val;
     }
     STORAGE_LOOP_END
+    BandValid = false;
 
     inp.close();
 
@@ -1002,6 +1156,18 @@ bool FractureField::Read(string FileName)
     return true;
 }
 
+size_t FractureField::AllocatedMemory(void) const
+{
+    return Fields.AllocatedMemory() +
+           Fields_dot.AllocatedMemory() +
+           Laplacian.AllocatedMemory() +
+           Flag.AllocatedMemory() +
+           DisplacementsOLD.AllocatedMemory() +
+           SurfaceEnergy.AllocatedMemory() +
+           TestOutput.AllocatedMemory() +
+           TestOutput2.AllocatedMemory();
+}
+
 void FractureField::Remesh(int newNx, int newNy, int newNz,
                            const BoundaryConditions& BC)
 {
@@ -1016,6 +1182,7 @@ void FractureField::Remesh(int newNx, int newNy, int newNz,
         Flag(i, j, k) = 2 * (Fields(i, j, k) > 0);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+    BandValid = false;
 
     Finalize(BC);
         
@@ -1044,6 +1211,8 @@ FractureField& FractureField::operator= (const FractureField& rhs)
         sWidth    = rhs.sWidth;
         RefVolume = rhs.RefVolume;
         Mobility  = rhs.Mobility;
+        CrackBand = rhs.CrackBand;
+        BandValid = false;
 
         if (Fields.IsNotAllocated())
         {
@@ -1122,8 +1291,11 @@ void FractureField::WriteVTK(const Settings& locSettings, const int tStep, const
     ListOfFields.push_back((VTK::Field_t){"FractureField", [this](int i, int j, int k) { return Fields     (i, j, k);}});
     ListOfFields.push_back((VTK::Field_t){"Laplacian",     [this](int i, int j, int k) { return Laplacian  (i, j, k);}});
     ListOfFields.push_back((VTK::Field_t){"SurfaceEnergy", [this](int i, int j, int k) { return SurfaceEnergy(i, j, k);}});
-    ListOfFields.push_back((VTK::Field_t){"TestOutPut",    [this](int i, int j, int k) { return TestOutput(i, j, k);}});
-    ListOfFields.push_back((VTK::Field_t){"TestOutPut2",    [this](int i, int j, int k) { return TestOutput2(i, j, k);}});
+    if (TestOutput.IsAllocated())
+    {
+        ListOfFields.push_back((VTK::Field_t){"TestOutPut",    [this](int i, int j, int k) { return TestOutput(i, j, k);}});
+        ListOfFields.push_back((VTK::Field_t){"TestOutPut2",    [this](int i, int j, int k) { return TestOutput2(i, j, k);}});
+    }
     VTK::Write(Filename, locSettings, ListOfFields, precision);
 }
 
@@ -32,5 +32,10 @@
     int MPI_CART_RANK[3] = {0,0,0};
     int MPI_CART_SIZE[3] = {1,1,1};
     bool MPI_3D_DECOMPOSITION = false;
+    bool MPI_CART_NODE_AWARE = false;
+    std::vector<int> MPI_CART_PROCESS;
+    std::vector<int> MPI_CART_CUTS[3];
 #endif
 
+int OMP_TILE_SIZE[3] = {0,0,0};
+
@@ -0,0 +1,252 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "GrainTopology.h"
+
+namespace openphase
+{
+using namespace std;
+
+namespace
+{
+unordered_map<uint64_t, long int> ScanContacts(const Storage3D<NodePF,0>& Fields)
+{
+    ThreadLocalAccumulator<unordered_map<uint64_t, long int>> ThreadContacts;
+    ThreadContacts.Reset(unordered_map<uint64_t, long int>());
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
+    {
+        const NodePF& locPF = Fields(i,j,k);
+        if(locPF.size() == 2)
+        {
+            const uint64_t key = GrainTopology::Key(locPF.cbegin()->index, (locPF.cbegin()+1)->index);
+            ThreadContacts.Local()[key] += 1;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    unordered_map<uint64_t, long int> Contacts = ThreadContacts[0];
+    for(size_t t = 1; t < ThreadContacts.size(); t++)
+    {
+        for(const auto& [key, cells] : ThreadContacts[t]) Contacts[key] += cells;
+    }
+    return Contacts;
+}
+}// namespace
+
+void GrainTopology::Scan(const Storage3D<NodePF,0>& Fields)
+{
+    LocalContacts = ScanContacts(Fields);
+    Events.clear();
+    Scanned = true;
+    IncrementsPending = false;
+    Rebuild = true;
+}
+
+void GrainTopology::Clear(void)
+{
+    LocalContacts.clear();
+    Events.clear();
+    Scanned = false;
+    IncrementsPending = false;
+    Rebuild = true;
+}
+
+void GrainTopology::BeginIncrements(void)
+{
+    Increments.Reset(unordered_map<uint64_t, long int>());
+    IncrementsPending = true;
+}
+
+void GrainTopology::ApplyIncrements(void)
+{
+    if(not IncrementsPending) return;
+    IncrementsPending = false;
+
+    /* The changes of all threads are summed first, a pair moved from one
+    thread's cells to another's within a step is therefore no event.*/
+    unordered_map<uint64_t, long int> Changes = Increments[0];
+    for(size_t t = 1; t < Increments.size(); t++)
+    {
+        for(const auto& [key, delta] : Increments[t]) Changes[key] += delta;
+    }
+
+    for(const auto& [key, delta] : Changes)
+    if(delta != 0)
+    {
+        auto it = LocalContacts.find(key);
+        const long int before = (it != LocalContacts.end()) ? it->second : 0;
+        const long int after  = before + delta;
+
+        if(before <= 0 and after > 0) Events.emplace_back(key,  1);
+        if(before > 0 and after <= 0) Events.emplace_back(key, -1);
+
+        if(after == 0)
+        {
+            if(it != LocalContacts.end()) LocalContacts.erase(it);
+        }
+        else if(it != LocalContacts.end())
+        {
+            it->second = after;
+        }
+        else
+        {
+            LocalContacts.emplace(key, after);
+        }
+    }
+}
+
+bool GrainTopology::Check(const Storage3D<NodePF,0>& Fields)
+{
+    unordered_map<uint64_t, long int> Contacts = ScanContacts(Fields);
+
+    bool consistent = (Contacts.size() == LocalContacts.size());
+    for(auto it = Contacts.cbegin(); consistent and it != Contacts.cend(); ++it)
+    {
+        auto jt = LocalContacts.find(it->first);
+        consistent = (jt != LocalContacts.end() and jt->second == it->second);
+    }
+    if(not consistent)
+    {
+        LocalContacts = std::move(Contacts);
+        Events.clear();
+        Rebuild = true;
+    }
+    return consistent;
+}
+
+void GrainTopology::Synchronize(void)
+{
+    int locRebuild = Rebuild;
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &locRebuild, 1, OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    /* A rebuild on any rank rebuilds the global graph from the local contacts
+    of all ranks, otherwise only the events are exchanged. Each event is sent
+    as the pair key followed by 1 (appeared) or 0 (vanished).*/
+    vector<unsigned long long> Send;
+    if(locRebuild)
+    {
+        PairRanks.clear();
+        Neighbours.clear();
+        Send.reserve(2*LocalContacts.size());
+        for(const auto& [key, cells] : LocalContacts)
+        if(cells > 0)
+        {
+            Send.push_back(key);
+            Send.push_back(1);
+        }
+    }
+    else
+    {
+        Send.reserve(2*Events.size());
+        for(const auto& [key, sign] : Events)
+        {
+            Send.push_back(key);
+            Send.push_back(sign > 0);
+        }
+    }
+    Events.clear();
+    Rebuild = false;
+
+#ifdef MPI_PARALLEL
+    int locCount = Send.size();
+    vector<int> Counts(MPI_SIZE);
+    OP_MPI_Allgather(&locCount, 1, OP_MPI_INT, Counts.data(), 1, OP_MPI_INT, OP_MPI_COMM_WORLD);
+    vector<int> Displs(MPI_SIZE, 0);
+    for(int r = 1; r < MPI_SIZE; r++) Displs[r] = Displs[r-1] + Counts[r-1];
+    vector<unsigned long long> Received(Displs[MPI_SIZE-1] + Counts[MPI_SIZE-1]);
+    OP_MPI_Allgatherv(Send.data(), locCount, OP_MPI_UNSIGNED_LONG_LONG,
+                      Received.data(), Counts.data(), Displs.data(),
+                      OP_MPI_UNSIGNED_LONG_LONG, OP_MPI_COMM_WORLD);
+#else
+    const vector<unsigned long long>& Received = Send;
+#endif
+
+    for(size_t n = 0; n + 1 < Received.size(); n += 2)
+    {
+        const uint64_t key = Received[n];
+        int& ranks = PairRanks[key];
+        if(Received[n+1])
+        {
+            if(ranks++ == 0) Connect(key);
+        }
+        else if(ranks > 0 and --ranks == 0)
+        {
+            PairRanks.erase(key);
+            Disconnect(key);
+        }
+    }
+}
+
+const vector<size_t>& GrainTopology::NeighboursOf(const size_t idx) const
+{
+    static const vector<size_t> None;
+    return (idx < Neighbours.size()) ? Neighbours[idx] : None;
+}
+
+void GrainTopology::Edges(vector<size_t>& Row, vector<size_t>& Col) const
+{
+    Row.clear();
+    Col.clear();
+    for(size_t n = 0; n < Neighbours.size(); n++)
+    for(const size_t m : Neighbours[n])
+    if(m > n)
+    {
+        Row.push_back(n);
+        Col.push_back(m);
+    }
+}
+
+void GrainTopology::Connect(const uint64_t key)
+{
+    const size_t alpha = key >> 32;
+    const size_t beta  = key & 0xFFFFFFFFull;
+    if(Neighbours.size() <= beta) Neighbours.resize(beta + 1);
+
+    for(const auto& [a, b] : {make_pair(alpha, beta), make_pair(beta, alpha)})
+    {
+        vector<size_t>& list = Neighbours[a];
+        auto it = lower_bound(list.begin(), list.end(), b);
+        if(it == list.end() or *it != b) list.insert(it, b);
+    }
+}
+
+void GrainTopology::Disconnect(const uint64_t key)
+{
+    const size_t alpha = key >> 32;
+    const size_t beta  = key & 0xFFFFFFFFull;
+    if(Neighbours.size() <= beta) return;
+
+    for(const auto& [a, b] : {make_pair(alpha, beta), make_pair(beta, alpha)})
+    {
+        vector<size_t>& list = Neighbours[a];
+        auto it = lower_bound(list.begin(), list.end(), b);
+        if(it != list.end() and *it == b) list.erase(it);
+    }
+}
+
+}// namespace openphase
@@ -30,6 +30,7 @@
 #include "GrandPotential/GrandPotentialPhaseDensity_IdealGas.h"
 #include "GrandPotential/GrandPotentialPhaseDensity_ImplicitParabolic.h"
 #include "GrandPotential/GrandPotentialPhaseDensity_Parabolic.h"
+#include "GrandPotential/GrandPotentialPhaseDensity_Tabulated.h"
 #include "VTK.h"
 
 namespace openphase
@@ -64,6 +65,10 @@ void GrandPotentialDensity::InitializeAndReadInput(Settings& locSettings, std::s
             ConsoleOutput::WriteExit(message.str(),thisclassname,"ReadInput");
             OP_Exit(EXIT_FAILURE);
         }
+        if(FileInterface::ReadParameterB(inp_data, moduleLocation, "TABULATE_"+converter, false, false))
+        {
+            storage.back() = new GrandPotentialPhaseDensity_Tabulated(PhaseIdx, storage.back());
+        }
     }
 
     DoGravity = FileInterface::ReadParameterB(inp_data, moduleLocation, "Gravity", false, false);
@@ -91,7 +96,7 @@ void GrandPotentialDensity::InitializeAndReadInput(Settings& locSettings, std::s
 }
 void GrandPotentialDensity::InitializeAndReadInput(Settings& locSettings, std::string filename)
 {
-    std::fstream inp(filename.c_str(), std::ios::in);
+    std::stringstream inp = FileInterface::OpenInput(filename);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File \"" + filename + "\" could not be opened", thisclassname, "InitializeAndReadInput");
@@ -99,7 +104,6 @@ void GrandPotentialDensity::InitializeAndReadInput(Settings& locSettings, std::s
     };
     std::stringstream inp_data;
     inp_data << inp.rdbuf();
-    inp.close();
     ConsoleOutput::WriteStandard("Source", filename);
     InitializeAndReadInput(locSettings,inp_data);
 }
@@ -48,6 +48,21 @@ void GrandPotentialPhaseDensity_ImplicitParabolic::ReadInput(std::stringstream&
     std::string converter = ""+std::to_string(PhaseIdx);
     precision     = FileInterface::ReadParameterD(InputFile, moduleLocation, "PREC_"+converter);
     MaxIterations = FileInterface::ReadParameterI(InputFile, moduleLocation, "MAXI_"+converter);
+
+    UseMemo = FileInterface::ReadParameterB(InputFile, moduleLocation, "MEMO_"+converter, false, false);
+    if (UseMemo)
+    {
+        MemoResolution = FileInterface::ReadParameterD(InputFile, moduleLocation, "MEMO_DMU_"+converter, false, 1.0);
+        size_t Size    = FileInterface::ReadParameterI(InputFile, moduleLocation, "MEMO_SIZE_"+converter, false, 4096);
+        if (MemoResolution <= 0.0)
+        {
+            ConsoleOutput::WriteExit("MEMO_DMU_"+converter+" has to be positive", thisclassname, "ReadInput()");
+            OP_Exit(EXIT_FAILURE);
+        }
+        MemoSize = 1;
+        while (MemoSize < Size) MemoSize *= 2;
+        Memo.assign(omp_get_max_threads(), std::vector<MemoEntry>(Ncomp*MemoSize));
+    }
     ConsoleOutput::Write("");
 }
 }// namespace openphase
@@ -0,0 +1,233 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "GrandPotential/GrandPotentialPhaseDensity_Tabulated.h"
+#include "Settings.h"
+
+namespace openphase
+{
+void GrandPotentialPhaseDensity_Tabulated::Initialize(Settings& locSettings)
+{
+    GrandPotentialPhaseDensity::Initialize(locSettings);
+    Model->Initialize(locSettings);
+}
+
+void GrandPotentialPhaseDensity_Tabulated::ReadInput(std::stringstream& InputFile, int moduleLocation)
+{
+    Model->ReadInput(InputFile, moduleLocation);
+
+    ConsoleOutput::Write("Tabulation of the grand potential density of "+PhaseNames[PhaseIdx]);
+    std::string converter = "_"+std::to_string(PhaseIdx);
+
+    MuMin.assign(Ncomp, 0.0);
+    MuMax.assign(Ncomp, 0.0);
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    {
+        MuMin[comp] = FileInterface::ReadParameterD(InputFile, moduleLocation, "TAB_MUMIN"+converter+"_"+ElementNames[comp]);
+        MuMax[comp] = FileInterface::ReadParameterD(InputFile, moduleLocation, "TAB_MUMAX"+converter+"_"+ElementNames[comp]);
+        if(MuMax[comp] <= MuMin[comp])
+        {
+            ConsoleOutput::WriteExit("TAB_MUMAX"+converter+"_"+ElementNames[comp]+" has to exceed TAB_MUMIN", thisclassname, "ReadInput");
+            OP_Exit(EXIT_FAILURE);
+        }
+    }
+    TMin = FileInterface::ReadParameterD(InputFile, moduleLocation, "TAB_TMIN"+converter, false, 0.0);
+    TMax = FileInterface::ReadParameterD(InputFile, moduleLocation, "TAB_TMAX"+converter, false, TMin);
+    NMu  = std::max(2, FileInterface::ReadParameterI(InputFile, moduleLocation, "TAB_NMU"+converter, false, 256));
+    NT   = (TMax > TMin) ? std::max(2, FileInterface::ReadParameterI(InputFile, moduleLocation, "TAB_NT"+converter, false, 16)) : 1;
+    const double Tolerance   = FileInterface::ReadParameterD(InputFile, moduleLocation, "TAB_TOL"+converter, false, 1.0e-6);
+    const int    Refinements = FileInterface::ReadParameterI(InputFile, moduleLocation, "TAB_REFINE"+converter, false, 4);
+
+    /* Doubles the resolution in the direction which misses the error bound */
+    for(int r = 0; ; r++)
+    {
+        Build();
+        double ErrorMu = 0.0;
+        double ErrorT  = 0.0;
+        Check(ErrorMu, ErrorT);
+        MaxError = std::max(ErrorMu, ErrorT);
+
+        if(MaxError <= Tolerance)
+        {
+            Active = true;
+            break;
+        }
+        if(r == Refinements)
+        {
+            ConsoleOutput::WriteWarning("Interpolation error " + std::to_string(MaxError) + " of the tables of "
+                                        + PhaseNames[PhaseIdx] + " exceeds TAB_TOL" + converter
+                                        + ", the model is evaluated directly", thisclassname, "ReadInput");
+            Active = false;
+            Pressure.clear();
+            Concentration.clear();
+            Susceptibility.clear();
+            SusceptibilitySlope.clear();
+            break;
+        }
+        if(ErrorMu > Tolerance) NMu = 2*NMu - 1;
+        if(ErrorT  > Tolerance) NT  = 2*NT  - 1;
+    }
+
+    if(Active)
+    {
+        ConsoleOutput::WriteStandard("Nodes (mu x T)", std::to_string(NMu) + " x " + std::to_string(NT));
+        ConsoleOutput::WriteStandard("Max. relative error", MaxError);
+    }
+    ConsoleOutput::Write("");
+}
+
+void GrandPotentialPhaseDensity_Tabulated::Build(void)
+{
+    dMu.resize(Ncomp);
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    {
+        dMu[comp] = (MuMax[comp] - MuMin[comp])/double(NMu - 1);
+    }
+    dT = (NT > 1) ? (TMax - TMin)/double(NT - 1) : 0.0;
+
+    const size_t Size = NT*NMu;
+    Concentration      .assign(Ncomp, std::vector<double>(Size));
+    Susceptibility     .assign(Ncomp, std::vector<double>(Size));
+    SusceptibilitySlope.assign(Ncomp, std::vector<double>(Size));
+    Pressure           .assign((Ncomp == 1) ? 1 : 0, std::vector<double>(Size));
+
+    bool Finite = true;
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    {
+        #pragma omp parallel for reduction(&&:Finite)
+        for(size_t n = 0; n < Size; n++)
+        {
+            const double T  = TMin + (n/NMu)*dT;
+            const double mu = MuMin[comp] + (n%NMu)*dMu[comp];
+            Concentration [comp][n] = Model->PhaseConcentration (T, mu, comp);
+            Susceptibility[comp][n] = Model->PhaseSusceptibility(T, mu, comp);
+            if(Ncomp == 1)
+            {
+                Tensor<double,1> locMu({Ncomp});
+                locMu({0}) = mu;
+                Pressure[0][n] = Model->PhasePressure(T, locMu);
+                Finite = Finite and std::isfinite(Pressure[0][n]);
+            }
+            Finite = Finite and std::isfinite(Concentration[comp][n]) and std::isfinite(Susceptibility[comp][n]);
+        }
+
+        /* Slopes of the susceptibility: centered differences limited to three
+        times the adjacent secants and zero at extrema (Fritsch-Carlson), which
+        keeps the interpolation monotone, second order one sided differences
+        at the ends */
+        for(size_t nT = 0; nT < NT; nT++)
+        {
+            const double* chi = &Susceptibility[comp][nT*NMu];
+            double* slope = &SusceptibilitySlope[comp][nT*NMu];
+            if(NMu > 2)
+            {
+                slope[0]       = (-3.0*chi[0] + 4.0*chi[1] - chi[2])/(2.0*dMu[comp]);
+                slope[NMu - 1] = ( 3.0*chi[NMu - 1] - 4.0*chi[NMu - 2] + chi[NMu - 3])/(2.0*dMu[comp]);
+            }
+            else
+            {
+                slope[0] = slope[1] = (chi[1] - chi[0])/dMu[comp];
+            }
+            for(size_t n = 1; n < NMu - 1; n++)
+            {
+                const double left  = (chi[n] - chi[n-1])/dMu[comp];
+                const double right = (chi[n+1] - chi[n])/dMu[comp];
+                if(left*right <= 0.0)
+                {
+                    slope[n] = 0.0;
+                    continue;
+                }
+                const double limit = 3.0*std::min(std::fabs(left), std::fabs(right));
+                slope[n] = std::copysign(std::min(std::fabs(0.5*(left + right)), limit), left);
+            }
+        }
+    }
+    if(not Finite)
+    {
+        ConsoleOutput::WriteExit("The model of " + PhaseNames[PhaseIdx] + " is not finite in the tabulated range, adjust TAB_MUMIN/TAB_MUMAX/TAB_TMIN/TAB_TMAX", thisclassname, "Build");
+        OP_Exit(EXIT_FAILURE);
+    }
+}
+
+void GrandPotentialPhaseDensity_Tabulated::Check(double& ErrorMu, double& ErrorT) const
+{
+    ErrorMu = 0.0;
+    ErrorT  = 0.0;
+
+    /* Relative error, values far below the table magnitude are compared to
+    a small fraction of it */
+    auto Scale = [](const std::vector<double>& Table)
+    {
+        double locMax = 0.0;
+        for(double value : Table) locMax = std::max(locMax, std::fabs(value));
+        return 1.0e-12*locMax + DBL_MIN;
+    };
+    auto Error = [](double Interpolated, double Exact, double Floor)
+    {
+        return std::fabs(Interpolated - Exact)/std::max(std::fabs(Exact), Floor);
+    };
+
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    {
+        const double FloorC   = Scale(Concentration[comp]);
+        const double FloorChi = Scale(Susceptibility[comp]);
+        const double FloorP   = (Ncomp == 1) ? Scale(Pressure[0]) : 0.0;
+
+        /* Midpoints in mu on the T nodes, midpoints in T on the mu nodes */
+        for(int direction = 0; direction < 2; direction++)
+        {
+            const size_t Nmu = (direction == 0) ? NMu - 1 : NMu;
+            const size_t Nt  = (direction == 0) ? NT : NT - 1;
+            double locError = 0.0;
+
+            #pragma omp parallel for collapse(2) reduction(max:locError)
+            for(size_t nT = 0; nT < Nt; nT++)
+            for(size_t nMu = 0; nMu < Nmu; nMu++)
+            {
+                const double T  = TMin + (nT + 0.5*direction)*dT;
+                const double mu = MuMin[comp] + (nMu + 0.5*(1 - direction))*dMu[comp];
+
+                double Interpolated = 0.0;
+                Interpolate(Concentration[comp], Susceptibility[comp], comp, T, mu, Interpolated);
+                locError = std::max(locError, Error(Interpolated, Model->PhaseConcentration(T, mu, comp), FloorC));
+
+                Interpolate(Susceptibility[comp], SusceptibilitySlope[comp], comp, T, mu, Interpolated);
+                locError = std::max(locError, Error(Interpolated, Model->PhaseSusceptibility(T, mu, comp), FloorChi));
+
+                if(Ncomp == 1)
+                {
+                    Tensor<double,1> locMu({Ncomp});
+                    locMu({0}) = mu;
+                    Interpolate(Pressure[0], Concentration[0], 0, T, mu, Interpolated);
+                    locError = std::max(locError, Error(Interpolated, Model->PhasePressure(T, locMu), FloorP));
+                }
+            }
+            if(direction == 0) ErrorMu = std::max(ErrorMu, locError);
+            else               ErrorT  = std::max(ErrorT,  locError);
+        }
+    }
+}
+}// namespace openphase
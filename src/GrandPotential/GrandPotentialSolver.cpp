@@ -38,6 +38,7 @@
 #include "Temperature.h"
 #include "Velocities.h"
 #include "VTK.h"
+#include "Tools/ReductionBatch.h"
 
 namespace openphase
 {
@@ -96,7 +97,7 @@ void GrandPotentialSolver::Initialize(Settings& locSettings, std::string ObjectN
 }
 void GrandPotentialSolver::ReadInput(const std::string filename)
 {
-    std::fstream inp(filename.c_str(), std::ios::in);
+    std::stringstream inp = FileInterface::OpenInput(filename);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File \"" + filename + "\" could not be opened", thisclassname, "ReadInput");
@@ -104,7 +105,6 @@ void GrandPotentialSolver::ReadInput(const std::string filename)
     };
     std::stringstream inp_data;
     inp_data << inp.rdbuf();
-    inp.close();
 
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteLineInsert(thisclassname);
@@ -186,20 +186,24 @@ void GrandPotentialSolver::ReadInput(std::stringstream& inp_data)
         InterfaceMobilities({beta, alpha, comp}) = valueAB;
     }
 
-    UseImplicitSolver = FileInterface::ReadParameterB(inp_data, moduleLocation, "Implicit");
-    if (UseImplicitSolver)
+    UseImplicitSolver       = FileInterface::ReadParameterB(inp_data, moduleLocation, "Implicit");
+    UseGlobalImplicitSolver = FileInterface::ReadParameterB(inp_data, moduleLocation, "GlobalImplicit", false, false);
+    if (UseImplicitSolver or UseGlobalImplicitSolver)
     {
         ChemicalPotentialAccuracy = FileInterface::ReadParameterD(inp_data, moduleLocation, "ACC");
         MaxIterations             = FileInterface::ReadParameterI(inp_data, moduleLocation, "MAXI");
-
-        ChemicalPotentialOld .Allocate(Grid, {Ncomp}, Bcells);
-        ChemicalPotentialDot2.Allocate(Grid, {Ncomp}, Bcells);
     }
     else
     {
         ChemicalPotentialAccuracy = 0.0;
         MaxIterations             = 0;
     }
+    if (UseImplicitSolver)
+    {
+        ChemicalPotentialOld       .Allocate(Grid, {Ncomp}, Bcells);
+        ChemicalPotentialDot2      .Allocate(Grid, {Ncomp}, Bcells);
+        ChemicalPotentialCorrection.Allocate(Grid, {Ncomp}, Bcells);
+    }
 
     ConserveTOC = FileInterface::ReadParameterB(inp_data, moduleLocation, "TOC");
     if (ConserveTOC)
@@ -620,21 +624,6 @@ void GrandPotentialSolver::EnforceConservationOfTOC(const PhaseField& Phase, con
         OMP_PARALLEL_STORAGE_LOOP_END
     }
 }
-void GrandPotentialSolver::CaclulateLocalDiffusionFlux(long i, long j, long k, dVector3 locVelocity, const PhaseField& Phase, const Temperature& Temp)
-{
-    for(size_t comp = 0; comp < Ncomp; comp++)
-    {
-        // Calculate chemical potential gradient
-        DiffusionFlux(i,j,k,{comp}) = {0.0,0.0,0.0};
-        dVector3 locForce = {0.0,0.0,0.0};
-        if (Grid.dNx) locForce[0] -= (ChemicalPotential(i+1,j  ,k   ,{comp}) - ChemicalPotential(i-1,j  ,k  ,{comp}))/Grid.dx/2.0;
-        if (Grid.dNy) locForce[1] -= (ChemicalPotential(i  ,j+1,k   ,{comp}) - ChemicalPotential(i  ,j-1,k  ,{comp}))/Grid.dx/2.0;
-        if (Grid.dNz) locForce[2] -= (ChemicalPotential(i  ,j  ,k +1,{comp}) - ChemicalPotential(i  ,j  ,k-1,{comp}))/Grid.dx/2.0;
-
-        DiffusionFlux(i,j,k,{comp}) += locForce*Mobility(i,j,k,comp,Phase,Temp);
-        DiffusionFlux(i,j,k,{comp}) -= locVelocity*Concentrations(i,j,k,{comp});
-    }
-}
 dVector3 GrandPotentialSolver::CenterOfMassVelocity(long i, long j, long k, const PhaseField& Phase) const
 {
     dVector3 locCenterOfMassVelocity = {0.,0.,0.};
@@ -693,31 +682,6 @@ void GrandPotentialSolver::CalculateLocalConcentrations(long i, long j, long k,
         CalculateLocalConcentrations(i,j,k,comp,Phase,omega);
     }
 }
-void GrandPotentialSolver::CalculateLocalIncrements(long i, long j, long k, const PhaseField& Phase, const GrandPotentialDensity& omega, double dt)
-{
-    for (size_t comp = 0; comp < Ncomp; comp++)
-    {
-        // Calculate change of concentration due to diffusion
-        double ConcentrationDot = ConcentrationsDot(i,j,k,{comp});
-        if (Grid.dNx) ConcentrationDot -= (DiffusionFlux(i+1,j  ,k   ,{comp})[0]-DiffusionFlux(i-1,j  ,k   ,{comp})[0])/Grid.dx/2.0;
-        if (Grid.dNy) ConcentrationDot -= (DiffusionFlux(i  ,j+1,k   ,{comp})[1]-DiffusionFlux(i  ,j-1,k   ,{comp})[1])/Grid.dx/2.0;
-        if (Grid.dNz) ConcentrationDot -= (DiffusionFlux(i  ,j  ,k +1,{comp})[2]-DiffusionFlux(i  ,j  ,k -1,{comp})[2])/Grid.dx/2.0;
-
-        double locInverseSusceptibility = 1/Susceptibility(i,j,k,comp,Phase,omega);
-        ChemicalPotentialDot(i,j,k,{comp}) += ConcentrationDot*locInverseSusceptibility;
-
-        // Calculate change of concentration due to phase-transformation
-        NodeA locPhaseDot = Phase.Dot(i,j,k, dt);
-        for (auto alpha = Phase.Fields(i,j,k).cbegin();
-                  alpha != Phase.Fields(i,j,k).cend(); alpha++)
-        {
-            size_t PhaseIdx = Phase.FieldsProperties[alpha->index].Phase;
-            double locPhaseConcentration = -omega(PhaseIdx).dChemicalPotential(i,j,k,comp);
-            ChemicalPotentialDot(i,j,k,{comp}) -= locPhaseConcentration*locPhaseDot.get_value(alpha->index)*locInverseSusceptibility;
-        }
-        ConcentrationsDot(i,j,k,{comp}) = 0.0;
-    }
-}
 void GrandPotentialSolver::CalculateLocalIncrements1(long i, long j, long k, const PhaseField& Phase, const GrandPotentialDensity& omega, double dt)
 {
     for (size_t comp = 0; comp < Ncomp; comp++)
@@ -785,14 +749,6 @@ void GrandPotentialSolver::CalculateLocalPhaseFieldIncrements (long i, long j, l
         }
     }
 }
-void GrandPotentialSolver::MergeLocalIncrements(long i, long j, long k, double dt)
-{
-    for(size_t comp = 0; comp < Ncomp; comp++)
-    {
-        ChemicalPotential   (i,j,k,{comp}) += dt*ChemicalPotentialDot(i,j,k,{comp});
-        ChemicalPotentialDot(i,j,k,{comp}) = 0.0;
-    }
-}
 void GrandPotentialSolver::MergeLocalIncrements1(long i, long j, long k, double dt)
 {
     for(size_t comp = 0; comp < Ncomp; comp++)
@@ -832,8 +788,9 @@ void GrandPotentialSolver::MergeLocalIncrements2Implicit(long i, long j, long k,
             return res;
         };
 
-        // Use chemical potential of the previous time step as starting point for the root fining algorithm
-        ChemicalPotential(i,j,k,{0}) = ChemicalPotentialOld(i,j,k,{0});
+        // Warm start: the implicit correction of the previous time step is
+        // applied to the explicit estimate
+        ChemicalPotential(i,j,k,{0}) = ChemicalPotential_Curvature + ChemicalPotentialCorrection(i,j,k,{0});
 
         try
         {
@@ -846,6 +803,7 @@ void GrandPotentialSolver::MergeLocalIncrements2Implicit(long i, long j, long k,
         {
             ConsoleOutput::WriteWarning(ecep.what(),thisclassname,"MergeLocalIncrements2Implicit");
         }
+        ChemicalPotentialCorrection(i,j,k,{0}) = ChemicalPotential(i,j,k,{0}) - ChemicalPotential_Curvature;
     }
     else
     {
@@ -881,11 +839,12 @@ void GrandPotentialSolver::MergeLocalIncrements2Implicit(long i, long j, long k,
             return f0;
         };
 
-        // Use chemical potential of the previous time step as starting point for the root fining algorithm
+        // Warm start: the implicit correction of the previous time step is
+        // applied to the explicit estimate
         std::vector<double> mu (Ncomp);
         for (std::size_t comp = 0; comp < Ncomp; comp++)
         {
-            mu[comp] = ChemicalPotentialOld(i,j,k,{comp});
+            mu[comp] = ChemicalPotential_Curvature[comp] + ChemicalPotentialCorrection(i,j,k,{comp});
         }
 
         try
@@ -900,6 +859,59 @@ void GrandPotentialSolver::MergeLocalIncrements2Implicit(long i, long j, long k,
         for (std::size_t comp = 0; comp < Ncomp; comp++)
         {
             ChemicalPotential(i,j,k,{comp}) = mu[comp] ;
+            ChemicalPotentialCorrection(i,j,k,{comp}) = mu[comp] - ChemicalPotential_Curvature[comp];
+        }
+    }
+}
+void GrandPotentialSolver::MergeLocalIncrements2ImplicitBatch(const CellBatch& Cells, const size_t Size, PhaseField& Phase, const GrandPotentialDensity& omega, const InterfaceProperties& IP, const double dt)
+{
+    // Same secant iteration as MergeLocalIncrements2Implicit for Ncomp == 1, the cells of the batch are iterated in lockstep
+    std::array<double,RootFindingBatchSize> ChemicalPotential_Curvature;
+    std::array<double,RootFindingBatchSize> x0;
+    std::array<double,RootFindingBatchSize> x1;
+    std::array<const char*,RootFindingBatchSize> Error;
+
+    for (size_t n = 0; n < Size; n++)
+    {
+        const long int i = Cells[n][0];
+        const long int j = Cells[n][1];
+        const long int k = Cells[n][2];
+        MergeLocalIncrements1(i,j,k,dt);
+        ChemicalPotential_Curvature[n] = ChemicalPotential(i,j,k,{0});
+
+        // Warm start from the implicit correction of the previous time step
+        ChemicalPotential(i,j,k,{0}) = ChemicalPotential_Curvature[n] + ChemicalPotentialCorrection(i,j,k,{0});
+        x0[n] = ChemicalPotential(i,j,k,{0});
+        x1[n] = ChemicalPotential(i,j,k,{0})*1.01;
+    }
+
+    auto residual = [this,&Cells,&Phase,&omega,&IP,dt,&ChemicalPotential_Curvature](size_t n, double mu)
+    {
+        const long int i = Cells[n][0];
+        const long int j = Cells[n][1];
+        const long int k = Cells[n][2];
+        double mu0 = ChemicalPotential(i,j,k,{0});
+        ChemicalPotential(i,j,k,{0}) = mu;
+        ChemicalPotentialDot2(i,j,k,{0}) = 0.0;
+
+        CalculateLocalConcentrations       (i,j,k,Phase,omega);
+        CalculateLocalPhaseFieldIncrements (i,j,k,Phase,omega,IP);
+        CalculateLocalIncrements2          (i,j,k,Phase,omega,dt);
+
+        double res = ChemicalPotential(i,j,k,{0}) - ChemicalPotential_Curvature[n] - ChemicalPotentialDot2(i,j,k,{0})*dt;
+        ChemicalPotential(i,j,k,{0}) = mu0;
+        return res;
+    };
+
+    RootFindingAlgorithms::BatchedSecant<RootFindingBatchSize>(residual, x0, x1, Size, ChemicalPotentialAccuracy, MaxIterations, Error);
+
+    for (size_t n = 0; n < Size; n++)
+    {
+        ChemicalPotential(Cells[n][0],Cells[n][1],Cells[n][2],{0}) = x0[n];
+        ChemicalPotentialCorrection(Cells[n][0],Cells[n][1],Cells[n][2],{0}) = x0[n] - ChemicalPotential_Curvature[n];
+        if (Error[n] != nullptr)
+        {
+            ConsoleOutput::WriteWarning(Error[n],thisclassname,"MergeLocalIncrements2Implicit");
         }
     }
 }
@@ -957,19 +969,167 @@ double GrandPotentialSolver::MaximumTimeStep(const PhaseField& Phase, const Temp
     OMP_PARALLEL_STORAGE_LOOP_END
     return dt_max;
 }
-void GrandPotentialSolver::SolveExplicit(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions&  BC, const InterfaceProperties& IP, const Temperature& Temp, const double dt)
+template<class RowKernel>
+void GrandPotentialSolver::RowSweep(long int bcells, RowKernel&& Kernel) const
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ChemicalPotential,ChemicalPotential.Bcells()-2,)
+    /* Same loop range as OMP_PARALLEL_STORAGE_LOOP_BEGIN, the z rows are
+    handed to the kernel as a whole. Each thread keeps its own scratch
+    buffers for all of its rows. */
+    const long int bcellsX = std::min(ChemicalPotential.BcellsX(), bcells);
+    const long int bcellsY = std::min(ChemicalPotential.BcellsY(), bcells);
+    const long int bcellsZ = std::min(ChemicalPotential.BcellsZ(), bcells);
+    const long int lowerX  = std::min(-bcellsX, 0l);
+    const long int lowerY  = std::min(-bcellsY, 0l);
+    const long int lowerZ  = std::min(-bcellsZ, 0l);
+    const long int upperX  = std::max(ChemicalPotential.sizeX() + bcellsX, ChemicalPotential.sizeX());
+    const long int upperY  = std::max(ChemicalPotential.sizeY() + bcellsY, ChemicalPotential.sizeY());
+    const long int upperZ  = std::max(ChemicalPotential.sizeZ() + bcellsZ, ChemicalPotential.sizeZ());
+
+    #pragma omp parallel
+    {
+        RowScratch Scratch;
+        #pragma omp for collapse(2) schedule(static)
+        for (long int i = lowerX; i < upperX; ++i)
+        for (long int j = lowerY; j < upperY; ++j)
+        {
+            Kernel(i, j, lowerZ, upperZ, Scratch);
+        }
+    }
+}
+void GrandPotentialSolver::CalculateRowFluxAndPhaseFieldIncrements(long i, long j, long kBegin, long kEnd, PhaseField& Phase, const GrandPotentialDensity& omega, const InterfaceProperties& IP, const Temperature& Temp, RowScratch& Scratch)
+{
+    const long n = kEnd - kBegin;
+    const long s = Ncomp;
+    Scratch.resize(n, Ncomp);
+
+    // Per cell part: driving forces and mobilities, both traverse the phase-field node
+    for (long m = 0; m < n; m++)
     {
-        CalculateLocalIncrements(i,j,k,Phase,omega,dt);
+        CalculateLocalPhaseFieldIncrements(i,j,kBegin+m,Phase,omega,IP);
+        for (size_t comp = 0; comp < Ncomp; comp++)
+        {
+            Scratch.Mobility[comp*n+m] = Mobility(i,j,kBegin+m,comp,Phase,Temp);
+        }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ChemicalPotential,ChemicalPotential.Bcells()-2,)
+    // Row part: diffusion flux from the chemical potential gradient, the
+    // values of a component are Ncomp apart along the row (unit stride for a
+    // single component)
+    for (size_t comp = 0; comp < Ncomp; comp++)
     {
-        MergeLocalIncrements(i,j,k,dt);
+        const double* M  = Scratch.Mobility.data() + comp*n;
+        const double* mu = &ChemicalPotential(i,j,kBegin,{comp});
+        const double* muXp = (Grid.dNx) ? &ChemicalPotential(i+1,j,kBegin,{comp}) : mu;
+        const double* muXm = (Grid.dNx) ? &ChemicalPotential(i-1,j,kBegin,{comp}) : mu;
+        const double* muYp = (Grid.dNy) ? &ChemicalPotential(i,j+1,kBegin,{comp}) : mu;
+        const double* muYm = (Grid.dNy) ? &ChemicalPotential(i,j-1,kBegin,{comp}) : mu;
+        const double* muZp = (Grid.dNz) ? mu + s : mu;
+        const double* muZm = (Grid.dNz) ? mu - s : mu;
+        dVector3* J = &DiffusionFlux(i,j,kBegin,{comp});
+
+        #pragma omp simd
+        for (long m = 0; m < n; m++)
+        {
+            J[m*s][0] = -(muXp[m*s] - muXm[m*s])/Grid.dx/2.0*M[m];
+            J[m*s][1] = -(muYp[m*s] - muYm[m*s])/Grid.dx/2.0*M[m];
+            J[m*s][2] = -(muZp[m*s] - muZm[m*s])/Grid.dx/2.0*M[m];
+        }
+    }
+}
+void GrandPotentialSolver::SolveExplicitRow(long i, long j, long kBegin, long kEnd, const PhaseField& Phase, const GrandPotentialDensity& omega, double dt, bool UpdateConcentrations, RowScratch& Scratch)
+{
+    const long n = kEnd - kBegin;
+    const long s = Ncomp;
+    Scratch.resize(n, Ncomp);
+
+    // Row part: change of concentration due to diffusion and advection
+    for (size_t comp = 0; comp < Ncomp; comp++)
+    {
+        double* cDot       = Scratch.ConcentrationDot.data() + comp*n;
+        double* cDotStored = &ConcentrationsDot(i,j,kBegin,{comp});
+        for (long m = 0; m < n; m++)
+        {
+            cDot[m] = cDotStored[m*s];
+            cDotStored[m*s] = 0.0;
+        }
+        if (Grid.dNx)
+        {
+            const dVector3* Jp = &DiffusionFlux(i+1,j,kBegin,{comp});
+            const dVector3* Jm = &DiffusionFlux(i-1,j,kBegin,{comp});
+            #pragma omp simd
+            for (long m = 0; m < n; m++) cDot[m] -= (Jp[m*s][0] - Jm[m*s][0])/Grid.dx/2.0;
+        }
+        if (Grid.dNy)
+        {
+            const dVector3* Jp = &DiffusionFlux(i,j+1,kBegin,{comp});
+            const dVector3* Jm = &DiffusionFlux(i,j-1,kBegin,{comp});
+            #pragma omp simd
+            for (long m = 0; m < n; m++) cDot[m] -= (Jp[m*s][1] - Jm[m*s][1])/Grid.dx/2.0;
+        }
+        if (Grid.dNz)
+        {
+            const dVector3* J = &DiffusionFlux(i,j,kBegin,{comp});
+            #pragma omp simd
+            for (long m = 0; m < n; m++) cDot[m] -= (J[(m+1)*s][2] - J[(m-1)*s][2])/Grid.dx/2.0;
+        }
+    }
+
+    // Per cell part: susceptibility and change of concentration due to
+    // phase-transformation, each phase density is evaluated once per component
+    for (long m = 0; m < n; m++)
+    {
+        const long k = kBegin + m;
+        NodeA locPhaseDot = Phase.Dot(i,j,k,dt);
+        for (size_t comp = 0; comp < Ncomp; comp++)
+        {
+            double locSusceptibility = 0.0;
+            double locPhaseConcentrationDot = 0.0;
+            for (auto alpha = Phase.Fields(i,j,k).cbegin();
+                      alpha != Phase.Fields(i,j,k).cend(); alpha++)
+            {
+                size_t PhaseIdx = Phase.FieldsProperties[alpha->index].Phase;
+                locSusceptibility        -= alpha->value*omega(PhaseIdx).dChemicalPotential2(i,j,k,comp);
+                locPhaseConcentrationDot -= omega(PhaseIdx).dChemicalPotential(i,j,k,comp)*locPhaseDot.get_value(alpha->index);
+            }
+            Scratch.InverseSusceptibility[comp*n+m] = 1.0/locSusceptibility;
+            Scratch.PhaseConcentrationDot[comp*n+m] = locPhaseConcentrationDot;
+        }
+    }
+
+    // Row part: merge of the chemical potential increments
+    for (size_t comp = 0; comp < Ncomp; comp++)
+    {
+        const double* cDot    = Scratch.ConcentrationDot.data() + comp*n;
+        const double* invChi  = Scratch.InverseSusceptibility.data() + comp*n;
+        const double* cPhDot  = Scratch.PhaseConcentrationDot.data() + comp*n;
+        double* mu    = &ChemicalPotential(i,j,kBegin,{comp});
+        double* muDot = &ChemicalPotentialDot(i,j,kBegin,{comp});
+        #pragma omp simd
+        for (long m = 0; m < n; m++)
+        {
+            mu[m*s] += dt*(muDot[m*s] + (cDot[m] - cPhDot[m])*invChi[m]);
+            muDot[m*s] = 0.0;
+        }
+    }
+
+    if (UpdateConcentrations)
+    for (long m = 0; m < n; m++)
+    {
+        CalculateLocalConcentrations(i,j,kBegin+m,Phase,omega);
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+}
+void GrandPotentialSolver::SolveExplicit(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions&  BC, const InterfaceProperties& IP, const Temperature& Temp, const double dt)
+{
+    /* The increments of a cell only read the diffusion flux of the neighbours
+    and the chemical potential of the cell itself, calculation and merge are
+    therefore done in one sweep, followed by the concentrations unless they
+    are set by the conservation of the total amount of components. */
+    const bool UpdateConcentrations = not ConserveTOC;
+    RowSweep(ChemicalPotential.Bcells()-2, [&](long i, long j, long kBegin, long kEnd, RowScratch& Scratch)
+    {
+        SolveExplicitRow(i,j,kBegin,kEnd,Phase,omega,dt,UpdateConcentrations,Scratch);
+    });
+    ConcentrationsUpdated = UpdateConcentrations;
 }
 void GrandPotentialSolver::SolveImplicit(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const InterfaceProperties& IP, const Temperature& Temp, const double dt)
 {
@@ -980,27 +1140,283 @@ void GrandPotentialSolver::SolveImplicit(PhaseField& Phase, const GrandPotential
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ChemicalPotential,ChemicalPotential.Bcells()-2,)
+    if (Ncomp == 1)
     {
-        MergeLocalIncrements1(i,j,k,dt);
-        MergeLocalIncrements2Implicit(i,j,k,Phase,omega,IP,dt);
+        /* The single component update is local to each cell. The cells of the
+        loop range of OMP_PARALLEL_STORAGE_LOOP_BEGIN are enumerated in storage
+        order and solved in batches of RootFindingBatchSize cells, which works
+        for any number of active dimensions. */
+        const long int bcells  = ChemicalPotential.Bcells()-2;
+        const long int bcellsX = std::max(std::min(ChemicalPotential.BcellsX(), bcells), 0l);
+        const long int bcellsY = std::max(std::min(ChemicalPotential.BcellsY(), bcells), 0l);
+        const long int bcellsZ = std::max(std::min(ChemicalPotential.BcellsZ(), bcells), 0l);
+        const long int nX       = ChemicalPotential.sizeX() + 2*bcellsX;
+        const long int nY       = ChemicalPotential.sizeY() + 2*bcellsY;
+        const long int nZ       = ChemicalPotential.sizeZ() + 2*bcellsZ;
+        const long int nCells   = nX*nY*nZ;
+        const long int nBatch   = RootFindingBatchSize;
+        const long int nBatches = (nCells + nBatch - 1)/nBatch;
+
+        #pragma omp parallel for schedule(dynamic,16)
+        for (long int batch = 0; batch < nBatches; batch++)
+        {
+            CellBatch Cells;
+            size_t Size = 0;
+            for (long int L = batch*nBatch; L < std::min(nCells, (batch+1)*nBatch); L++)
+            {
+                Cells[Size++] = {L/(nY*nZ) - bcellsX, (L/nZ)%nY - bcellsY, L%nZ - bcellsZ};
+            }
+            MergeLocalIncrements2ImplicitBatch(Cells, Size, Phase, omega, IP, dt);
+        }
+    }
+    else
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ChemicalPotential,ChemicalPotential.Bcells()-2,)
+        {
+            MergeLocalIncrements1(i,j,k,dt);
+            MergeLocalIncrements2Implicit(i,j,k,Phase,omega,IP,dt);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
 }
-void GrandPotentialSolver::Solve(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const InterfaceProperties& IP, const Temperature& Temp, double dt)
+bool GrandPotentialSolver::GlobalImplicitApplicable(const PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const Temperature& Temp) const
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ChemicalPotential,ChemicalPotential.Bcells()-1,)
+    /* The implicit Euler step of the diffusion equation is symmetric positive
+    definite if all susceptibilities are positive, the mobilities are not
+    negative and the boundary conditions are periodic, no flux or fixed. */
+    bool applicable = true;
+    auto supported = [](const BoundaryConditionTypes bc)
+    {
+        return bc == BoundaryConditionTypes::Periodic or
+               bc == BoundaryConditionTypes::NoFlux   or
+               bc == BoundaryConditionTypes::Fixed;
+    };
+    if (Grid.dNx > 0 and not (supported(BC.BC0X) and supported(BC.BCNX))) applicable = false;
+    if (Grid.dNy > 0 and not (supported(BC.BC0Y) and supported(BC.BCNY))) applicable = false;
+    if (Grid.dNz > 0 and not (supported(BC.BC0Z) and supported(BC.BCNZ))) applicable = false;
+
+    double minSusceptibility = std::numeric_limits<double>::max();
+    double minMobility       = std::numeric_limits<double>::max();
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ChemicalPotential,0,reduction(min:minSusceptibility))
     {
-        CalculateLocalPhaseFieldIncrements(i,j,k,Phase,omega,IP);
-        CaclulateLocalDiffusionFlux       (i,j,k,{0.0,0.0,0.0},Phase,Temp);
+        for (size_t comp = 0; comp < Ncomp; comp++)
+        {
+            minSusceptibility = std::min(minSusceptibility, Susceptibility(i,j,k,comp,Phase,omega));
+        }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ChemicalPotential,1,reduction(min:minMobility))
+    {
+        for (size_t comp = 0; comp < Ncomp; comp++)
+        {
+            minMobility = std::min(minMobility, Mobility(i,j,k,comp,Phase,Temp));
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+    ReductionBatch Batch;
+    Batch.Min(&minSusceptibility);
+    Batch.Min(&minMobility);
+    Batch.Reduce();
+#endif
+    if (minSusceptibility <= 0.0 or minMobility < 0.0) applicable = false;
+
+    if (not applicable)
+    {
+        ConsoleOutput::WriteWarning("Global implicit solver requires positive susceptibilities, non-negative mobilities "
+                                    "and Periodic, NoFlux or Fixed boundary conditions.\n"
+                                    "The local solver is used instead.", thisclassname, "SolveGlobalImplicit()");
+    }
+    return applicable;
+}
+void GrandPotentialSolver::SolveGlobalImplicit(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const InterfaceProperties& IP, const Temperature& Temp, const double dt)
+{
+    /** Implicit Euler step of the diffusion equation of each component,
+        solved on the whole grid with the Jacobi preconditioned conjugate
+        gradient method:
+
+        Chi/dt*(mu - muOld) - div(M*grad(mu)) = Chi*S
+
+        The flux between two cells uses the mean mobility of both cells, the
+        operator is applied cell by cell without assembling a matrix. The
+        source S collects the explicit concentration changes and the change of
+        concentration due to phase-transformation, as in the explicit solver.
+        The iterations stop when the chemical potential increment of a Jacobi
+        iteration, max|r/diag|, is below ChemicalPotentialAccuracy relative to
+        the largest chemical potential, or after MaxIterations. */
+
+    if (not GlobalImplicitApplicable(Phase, omega, BC, Temp))
+    {
+        if (UseImplicitSolver) SolveImplicit(Phase, omega, BC, IP, Temp, dt);
+        else                   SolveExplicit(Phase, omega, BC, IP, Temp, dt);
+        return;
+    }
+
+    if (ImplicitMobility.IsNotAllocated())
+    {
+        ImplicitCapacity .Allocate(Grid, Bcells);
+        ImplicitMobility .Allocate(Grid, Bcells);
+        ImplicitResidual .Allocate(Grid, Bcells);
+        ImplicitDirection.Allocate(Grid, Bcells);
+        ImplicitProduct  .Allocate(Grid, Bcells);
+    }
+
+    const double dx2 = Grid.dx*Grid.dx;
+
+    auto Divergence = [&](const auto& X, const long int i, const long int j, const long int k)
+    {
+        const double M  = ImplicitMobility(i,j,k);
+        const double X0 = X(i,j,k);
+        double value = 0.0;
+        if (Grid.dNx) value += (M + ImplicitMobility(i+1,j,k))*(X(i+1,j,k) - X0)
+                             + (M + ImplicitMobility(i-1,j,k))*(X(i-1,j,k) - X0);
+        if (Grid.dNy) value += (M + ImplicitMobility(i,j+1,k))*(X(i,j+1,k) - X0)
+                             + (M + ImplicitMobility(i,j-1,k))*(X(i,j-1,k) - X0);
+        if (Grid.dNz) value += (M + ImplicitMobility(i,j,k+1))*(X(i,j,k+1) - X0)
+                             + (M + ImplicitMobility(i,j,k-1))*(X(i,j,k-1) - X0);
+        return 0.5*value/dx2;
+    };
+    auto Diagonal = [&](const long int i, const long int j, const long int k)
+    {
+        const double M = ImplicitMobility(i,j,k);
+        double value = 0.0;
+        if (Grid.dNx) value += 2.0*M + ImplicitMobility(i+1,j,k) + ImplicitMobility(i-1,j,k);
+        if (Grid.dNy) value += 2.0*M + ImplicitMobility(i,j+1,k) + ImplicitMobility(i,j-1,k);
+        if (Grid.dNz) value += 2.0*M + ImplicitMobility(i,j,k+1) + ImplicitMobility(i,j,k-1);
+        return ImplicitCapacity(i,j,k) + 0.5*value/dx2;
+    };
+    auto Direction = [&](const long int i, const long int j, const long int k)
+    {
+        return ImplicitDirection(i,j,k);
+    };
+
+    for (size_t comp = 0; comp < Ncomp; comp++)
+    {
+        auto Potential = [&](const long int i, const long int j, const long int k)
+        {
+            return ChemicalPotential(i,j,k,{comp});
+        };
+
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ImplicitMobility,1,)
+        {
+            ImplicitMobility(i,j,k) = Mobility(i,j,k,comp,Phase,Temp);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+
+        /* Initial residual r = Chi*S + div(M*grad(muOld)), direction p = r/diag */
+        sum_real_t rzSum = 0.0;
+        double maxResidual = 0.0;
+        double maxPotential = 0.0;
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ImplicitResidual,0,reduction(ReproducibleSUM:rzSum) reduction(max:maxResidual,maxPotential))
+        {
+            double locConcentrationDot = ConcentrationsDot(i,j,k,{comp});
+            NodeA locPhaseDot = Phase.Dot(i,j,k, dt);
+            for (auto alpha = Phase.Fields(i,j,k).cbegin();
+                      alpha != Phase.Fields(i,j,k).cend(); alpha++)
+            {
+                size_t PhaseIdx = Phase.FieldsProperties[alpha->index].Phase;
+                double locPhaseConcentration = -omega(PhaseIdx).dChemicalPotential(i,j,k,comp);
+                locConcentrationDot -= locPhaseConcentration*locPhaseDot.get_value(alpha->index);
+            }
+            ConcentrationsDot(i,j,k,{comp}) = 0.0;
 
-    if (UseImplicitSolver) SolveImplicit(Phase, omega, BC, IP, Temp, dt);
-    else                   SolveExplicit(Phase, omega, BC, IP, Temp, dt);
+            ImplicitCapacity(i,j,k) = Susceptibility(i,j,k,comp,Phase,omega)/dt;
+
+            const double locDiagonal = Diagonal(i,j,k);
+            const double locResidual = locConcentrationDot + Divergence(Potential,i,j,k);
+            ImplicitResidual (i,j,k) = locResidual;
+            ImplicitDirection(i,j,k) = locResidual/locDiagonal;
+            rzSum += locResidual*locResidual/locDiagonal;
+            maxResidual  = std::max(maxResidual, std::abs(locResidual/locDiagonal));
+            maxPotential = std::max(maxPotential, std::abs(ChemicalPotential(i,j,k,{comp})));
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+        ReductionBatch Batch;
+        Batch.Sum(&rzSum);
+        Batch.Max(&maxResidual);
+        Batch.Max(&maxPotential);
+        Batch.Reduce();
+#endif
+        double rz = double(rzSum);
+        const double MaxResidual = ChemicalPotentialAccuracy*std::max(maxPotential, 1.0);
+
+        size_t iteration = 0;
+        while (maxResidual >= MaxResidual and iteration < MaxIterations and rz > 0.0)
+        {
+            iteration++;
+
+            /* The fixed boundary cells of the direction keep their initial
+            zero values, the correction does not change fixed chemical potentials */
+            if (Grid.dNx) BC.SetX(ImplicitDirection);
+            if (Grid.dNy) BC.SetY(ImplicitDirection);
+            if (Grid.dNz) BC.SetZ(ImplicitDirection);
+
+            /* q = A*p */
+            sum_real_t pqSum = 0.0;
+            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ImplicitProduct,0,reduction(ReproducibleSUM:pqSum))
+            {
+                ImplicitProduct(i,j,k) = ImplicitCapacity(i,j,k)*ImplicitDirection(i,j,k) - Divergence(Direction,i,j,k);
+                pqSum += ImplicitDirection(i,j,k)*ImplicitProduct(i,j,k);
+            }
+            OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+            Batch.Sum(&pqSum);
+            Batch.Reduce();
+#endif
+            const double alpha = rz/double(pqSum);
+
+            /* mu += alpha*p, r -= alpha*q */
+            sum_real_t rzNewSum = 0.0;
+            maxResidual = 0.0;
+            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ImplicitResidual,0,reduction(ReproducibleSUM:rzNewSum) reduction(max:maxResidual))
+            {
+                ChemicalPotential(i,j,k,{comp}) += alpha*ImplicitDirection(i,j,k);
+                ImplicitResidual(i,j,k) -= alpha*ImplicitProduct(i,j,k);
+                const double locZ = ImplicitResidual(i,j,k)/Diagonal(i,j,k);
+                rzNewSum += ImplicitResidual(i,j,k)*locZ;
+                maxResidual = std::max(maxResidual, std::abs(locZ));
+            }
+            OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+            Batch.Sum(&rzNewSum);
+            Batch.Max(&maxResidual);
+            Batch.Reduce();
+#endif
+            const double rzNew = double(rzNewSum);
+            const double beta = rzNew/rz;
+            rz = rzNew;
+
+            /* p = r/diag + beta*p */
+            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ImplicitDirection,0,)
+            {
+                ImplicitDirection(i,j,k) = ImplicitResidual(i,j,k)/Diagonal(i,j,k) + beta*ImplicitDirection(i,j,k);
+            }
+            OMP_PARALLEL_STORAGE_LOOP_END
+        }
+        if (maxResidual >= MaxResidual and rz > 0.0)
+        {
+            ConsoleOutput::WriteWarning("Conjugate gradient method did not converge for " + ElementNames[comp]
+                                        + " within " + std::to_string(MaxIterations) + " iterations",
+                                        thisclassname, "SolveGlobalImplicit()");
+        }
+    }
+}
+void GrandPotentialSolver::Solve(PhaseField& Phase, const GrandPotentialDensity& omega, const BoundaryConditions& BC, const InterfaceProperties& IP, const Temperature& Temp, double dt)
+{
+    RowSweep(ChemicalPotential.Bcells()-1, [&](long i, long j, long kBegin, long kEnd, RowScratch& Scratch)
+    {
+        CalculateRowFluxAndPhaseFieldIncrements(i,j,kBegin,kEnd,Phase,omega,IP,Temp,Scratch);
+    });
+
+    ConcentrationsUpdated = false;
+
+    if      (UseGlobalImplicitSolver) SolveGlobalImplicit(Phase, omega, BC, IP, Temp, dt);
+    else if (UseImplicitSolver)       SolveImplicit      (Phase, omega, BC, IP, Temp, dt);
+    else                              SolveExplicit      (Phase, omega, BC, IP, Temp, dt);
 
     if (ConserveTOC) EnforceConservationOfTOC(Phase,omega);
-    else
+    else if (not ConcentrationsUpdated)
     {
         OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ChemicalPotential,0,)
         {
@@ -1137,4 +1553,21 @@ void GrandPotentialSolver::WriteVTKCenterOfMassVelocity(const Settings& locSetti
     std::string Filename = FileInterface::MakeFileName(locSettings.VTKDir, "CenterOfMassVelocity_", tStep, ".vts");
     VTK::Write(Filename, locSettings, ListOfFields, precision);
 }
+
+size_t GrandPotentialSolver::AllocatedMemory(void) const
+{
+    return ChemicalPotential.AllocatedMemory() +
+           Concentrations.AllocatedMemory() +
+           ConcentrationsDot.AllocatedMemory() +
+           ChemicalPotentialOld.AllocatedMemory() +
+           ChemicalPotentialDot.AllocatedMemory() +
+           ChemicalPotentialDot2.AllocatedMemory() +
+           ChemicalPotentialCorrection.AllocatedMemory() +
+           DiffusionFlux.AllocatedMemory() +
+           ImplicitCapacity.AllocatedMemory() +
+           ImplicitMobility.AllocatedMemory() +
+           ImplicitResidual.AllocatedMemory() +
+           ImplicitDirection.AllocatedMemory() +
+           ImplicitProduct.AllocatedMemory();
+}
 }// namespace openphase::GrandPotential
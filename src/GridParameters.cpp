@@ -207,7 +207,7 @@ void GridParameters::ReadInput(const string InputFileName)
     ConsoleOutput::WriteLineInsert(thisclassname+" input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened", thisclassname, "ReadInput()");
@@ -215,7 +215,6 @@ void GridParameters::ReadInput(const string InputFileName)
     };
     std::stringstream data;
     data << inp.rdbuf();
-    inp.close();
 
     ReadInput(data);
 
@@ -269,6 +268,7 @@ void GridParameters::ReadInput(std::stringstream& inp)
         MPI_CART_SIZE[0] = FileInterface::ReadParameterI(inp, moduleLocation, string("Ncx"), false, 1);
         MPI_CART_SIZE[1] = FileInterface::ReadParameterI(inp, moduleLocation, string("Ncy"), false, 1);
         MPI_CART_SIZE[2] = FileInterface::ReadParameterI(inp, moduleLocation, string("Ncz"), false, 1);
+        MPI_CART_NODE_AWARE = FileInterface::ReadParameterB(inp, moduleLocation, string("MPINodeAware"), false, false);
 
         if(MPI_CART_SIZE[0] * MPI_CART_SIZE[1] * MPI_CART_SIZE[2] != MPI_SIZE)
         {
@@ -293,7 +293,7 @@ void GridParameters::ReadJSON(const string InputFileName)
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteLineInsert("Grid Parameters");
 
-    std::ifstream f(InputFileName);
+    std::stringstream f = FileInterface::OpenInput(InputFileName);
     
     json data = json::parse(f);
     if (data.contains(thisclassname))
@@ -339,6 +339,7 @@ void GridParameters::ReadJSON(const string InputFileName)
             MPI_CART_SIZE[0] = FileInterface::ReadParameter<int>(grid, {"Ncx"},1);
             MPI_CART_SIZE[1] = FileInterface::ReadParameter<int>(grid, {"Ncy"},1);
             MPI_CART_SIZE[2] = FileInterface::ReadParameter<int>(grid, {"Ncz"},1);
+            MPI_CART_NODE_AWARE = FileInterface::ReadParameter<bool>(grid, {"MPINodeAware"},false);
 
             if(MPI_CART_SIZE[0] * MPI_CART_SIZE[1] * MPI_CART_SIZE[2] != MPI_SIZE)
             {
@@ -414,7 +415,34 @@ void GridParameters::SetDimensions(int total_nx, int total_ny, int total_nz)
 {
     if(MPI_3D_DECOMPOSITION)
     {
-        OP_MPI_Cart_Setup(MPI_CART_SIZE,MPI_RANK,MPI_CART_RANK);
+        /* With MPINodeAware the ranks of each node form a compact block of
+        the process grid, so that most of the halo exchanges stay within the
+        node. The placement is set up once, later calls (remeshing) keep the
+        position of each rank. */
+        if(MPI_CART_NODE_AWARE and MPI_CART_PROCESS.empty())
+        {
+            const long int extent[3] = {std::max(total_nx, 1)/MPI_CART_SIZE[0],
+                                        std::max(total_ny, 1)/MPI_CART_SIZE[1],
+                                        std::max(total_nz, 1)/MPI_CART_SIZE[2]};
+            OP_MPI_Cart_Setup_node_aware(MPI_CART_SIZE, MPI_RANK, MPI_CART_RANK, extent, MPI_CART_PROCESS);
+            if(MPI_CART_PROCESS.empty())
+            {
+                ConsoleOutput::WriteWarning("The nodes have different numbers of processes or their number does not divide the process grid, "
+                                            "the ranks are placed in row-major order", thisclassname, "SetDimensions()");
+                MPI_CART_NODE_AWARE = false;
+            }
+        }
+        if(MPI_CART_PROCESS.empty())
+        {
+            OP_MPI_Cart_Setup(MPI_CART_SIZE,MPI_RANK,MPI_CART_RANK);
+        }
+        else
+        {
+            const int position = std::find(MPI_CART_PROCESS.begin(), MPI_CART_PROCESS.end(), MPI_RANK) - MPI_CART_PROCESS.begin();
+            MPI_CART_RANK[0] = position/(MPI_CART_SIZE[1]*MPI_CART_SIZE[2]);
+            MPI_CART_RANK[1] = (position/MPI_CART_SIZE[2])%MPI_CART_SIZE[1];
+            MPI_CART_RANK[2] = position%MPI_CART_SIZE[2];
+        }
 
         if(total_nx != 0)
         {
@@ -550,6 +578,7 @@ void GridParameters::SetDimensions(int total_nx, int total_ny, int total_nz)
             ConsoleOutput::WriteExit("Dimension Z is suppressed and cannot be decomposed into " + std::to_string(MPI_CART_SIZE[2]) + " MPI processes", thisclassname, "SetDimensions()");
             OP_Exit(EXIT_FAILURE);
         }
+        ApplyCutPlanes();
         ConsoleOutput::WriteStandard(thisclassname + "(RANK " + std::to_string(MPI_RANK) + ")", "MPI 3D environment is initialized");
     }
     else
@@ -640,6 +669,37 @@ void GridParameters::SetDimensions(int total_nx, int total_ny, int total_nz)
     }
 }
 
+void GridParameters::ApplyCutPlanes(void)
+{
+    if(not MPI_3D_DECOMPOSITION) return;
+
+    /* Cut planes set for a different total size (e.g. before remeshing) are
+    ignored, the equal boxes of SetDimensions() are kept in that direction */
+    int* N[3]      = {&Nx, &Ny, &Nz};
+    int* Offset[3] = {&OffsetX, &OffsetY, &OffsetZ};
+    int* maxN[3]   = {&maxNx, &maxNy, &maxNz};
+    const int Total[3] = {TotalNx, TotalNy, TotalNz};
+    const std::string Direction[3] = {"X", "Y", "Z"};
+
+    for(int d = 0; d < 3; d++)
+    {
+        const std::vector<int>& Cuts = MPI_CART_CUTS[d];
+        if(Cuts.size() != size_t(MPI_CART_SIZE[d] + 1) or
+           Cuts.front() != 0 or Cuts.back() != Total[d]) continue;
+
+        *Offset[d] = Cuts[MPI_CART_RANK[d]];
+        *N[d]      = Cuts[MPI_CART_RANK[d] + 1] - Cuts[MPI_CART_RANK[d]];
+        *maxN[d]   = std::max(*maxN[d], *N[d]);
+
+        if(*N[d] < Bcells and Total[d] > 1)
+        {
+            ConsoleOutput::WriteExit("Cut planes leave less than " + std::to_string(Bcells) + " cells in direction " + Direction[d] + " on RANK " + std::to_string(MPI_RANK), thisclassname, "ApplyCutPlanes()");
+            OP_Exit(EXIT_FAILURE);
+        }
+    }
+    Nz2 = Nz/2 + 1;
+}
+
 #else
 
 void GridParameters::SetDimensions(int total_nx, int total_ny, int total_nz)
@@ -705,5 +765,10 @@ void GridParameters::SetDimensions(int total_nx, int total_ny, int total_nz)
     }
 }
 
+void GridParameters::ApplyCutPlanes(void)
+{
+    // Nothing to do without MPI domain decomposition
+}
+
 #endif
 } //namespace openphase
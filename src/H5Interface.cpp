@@ -25,6 +25,7 @@
  */
 
 #include "H5Interface.h"
+#include "FileInterface.h"
 #include "Settings.h"
 #ifdef H5OP
 #include "../HighFive/include/highfive/H5Easy.hpp"
@@ -43,78 +44,335 @@ using namespace tinyxml2;
     #define XMLCheckResult(a_eResult) if (a_eResult != XML_SUCCESS) { printf("Error: %i\n", a_eResult); return a_eResult; }
 #endif
 
+static H5Interface::Compressions ReadCompression(const std::string& Filter)
+{
+    if(Filter == "NONE")  return H5Interface::Compressions::None;
+    if(Filter == "GZIP")  return H5Interface::Compressions::GZIP;
+    if(Filter == "SZIP")  return H5Interface::Compressions::SZIP;
+    if(Filter == "ZSTD")  return H5Interface::Compressions::ZSTD;
+    if(Filter == "BLOSC") return H5Interface::Compressions::BLOSC;
+    if(Filter == "ZFP")   return H5Interface::Compressions::ZFP;
+    if(Filter == "SZ")    return H5Interface::Compressions::SZ;
+    ConsoleOutput::WriteExit("Unknown HDF5 compression \"" + Filter +
+                             "\", use None, GZIP, SZIP, ZSTD, BLOSC, ZFP or SZ",
+                             H5Interface::thisclassname, "ReadInput()");
+    OP_Exit(EXIT_FAILURE);
+    return H5Interface::Compressions::None;
+}
+
+void H5Interface::ReadInput(const std::string InputFileName)
+{
+    std::stringstream inp = FileInterface::OpenInput(InputFileName);
+    if (!inp)
+    {
+        ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened", thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    };
+    std::stringstream data;
+    data << inp.rdbuf();
+    ReadInput(data);
+}
+
+void H5Interface::ReadInput(std::stringstream& inp)
+{
+    const int moduleLocation = FileInterface::FindModuleLocation(inp, thisclassname);
+
+    DefaultCompression.Filter  = ReadCompression(FileInterface::ReadParameterK(inp, moduleLocation, "Compression", false, "NONE"));
+    DefaultCompression.Level   = FileInterface::ReadParameterI(inp, moduleLocation, "CompressionLevel", false, DefaultCompression.Level);
+    DefaultCompression.Shuffle = FileInterface::ReadParameterB(inp, moduleLocation, "Shuffle", false, DefaultCompression.Shuffle);
+    DefaultCompression.Tolerance = FileInterface::ReadParameterD(inp, moduleLocation, "CompressionTolerance", false, DefaultCompression.Tolerance);
+    ChunkSize[0] = FileInterface::ReadParameterI(inp, moduleLocation, "ChunkSizeX", false, ChunkSize[0]);
+    ChunkSize[1] = FileInterface::ReadParameterI(inp, moduleLocation, "ChunkSizeY", false, ChunkSize[1]);
+    ChunkSize[2] = FileInterface::ReadParameterI(inp, moduleLocation, "ChunkSizeZ", false, ChunkSize[2]);
+
+    CheckpointCompression = DefaultCompression;
+    CheckpointCompression.Filter    = ReadCompression(FileInterface::ReadParameterK(inp, moduleLocation, "CheckpointCompression", false, "NONE"));
+    CheckpointCompression.Tolerance = FileInterface::ReadParameterD(inp, moduleLocation, "CheckpointTolerance", false, DefaultCompression.Tolerance);
+
+    /* Field specific filters "$Compression_<Field>" and error bounds
+    "$CompressionTolerance_<Field>", the field names are collected from the
+    module since they are not known in advance */
+    FieldCompression.clear();
+    std::stringstream module(inp.str());
+    module.seekg(moduleLocation);
+    const std::string prefix = "$Compression_";
+    const std::string tolerancePrefix = "$CompressionTolerance_";
+    std::string line;
+    while(std::getline(module, line))
+    {
+        const size_t start = line.find_first_not_of(" \t");
+        if(start == std::string::npos) continue;
+        if(line[start] == '@') break;
+        const bool isFilter    = (line.compare(start, prefix.size(), prefix) == 0);
+        const bool isTolerance = (line.compare(start, tolerancePrefix.size(), tolerancePrefix) == 0);
+        if(not isFilter and not isTolerance) continue;
+
+        std::string Name = line.substr(start + 1);
+        Name = Name.substr(0, Name.find_first_of(" \t:"));
+        const std::string Field = Name.substr((isFilter ? prefix : tolerancePrefix).size() - 1);
+        if(FieldCompression.find(Field) == FieldCompression.end())
+        {
+            FieldCompression[Field] = DefaultCompression;
+        }
+        if(isFilter)
+        {
+            FieldCompression[Field].Filter = ReadCompression(FileInterface::ReadParameterK(inp, moduleLocation, Name));
+        }
+        else
+        {
+            FieldCompression[Field].Tolerance = FileInterface::ReadParameterD(inp, moduleLocation, Name);
+        }
+    }
+}
+
+H5Interface::~H5Interface()
+{
+    CloseFile();
+}
+
 void H5Interface::OpenFile(const std::string InputFileName, const std::string OutputFileName)
 {
+    CloseFile();
     H5InputFileName = InputFileName;
     H5OutputFileName = OutputFileName;
 
-    std::ifstream in(H5InputFileName);
-    std::ifstream out(H5OutputFileName);
-    if(in.good() && !out.good())
+    #ifdef MPI_PARALLEL
+    if(MPI_RANK == 0)
+    #endif
     {
-        std::string command = "cp " + H5InputFileName + " " + H5OutputFileName;
-        system(command.c_str());
+        std::ifstream in(H5InputFileName);
+        std::ifstream out(H5OutputFileName);
+        if(in.good() && !out.good())
+        {
+            std::string command = "cp " + H5InputFileName + " " + H5OutputFileName;
+            system(command.c_str());
+        }
+        in.close();
+        out.close();
     }
-    in.close();
-    out.close();
+    #ifdef MPI_PARALLEL
+    OP_MPI_Barrier(OP_MPI_COMM_WORLD);
+    #endif
 }
 
-void H5Interface::WriteSimulationSettings(const std::string InputFileName)
+void H5Interface::CloseFile(void)
 {
     #ifdef H5OP
-    H5Easy::File file(H5OutputFileName, H5Easy::File::OpenOrCreate);
+    AsyncOutput::Flush();
+    if(OutputFileHandle)
+    {
+        OutputFileHandle->flush();
+        OutputFileHandle.reset();
+    }
+    #endif
+}
+
+#ifdef H5OP
+static HighFive::FileAccessProps FileAccessProperties(void)
+{
+    HighFive::FileAccessProps fapl;
+    #ifdef H5OP_PARALLEL
+    fapl.add(HighFive::MPIOFileAccess{MPI_COMM_WORLD, MPI_INFO_NULL});
+    fapl.add(HighFive::MPIOCollectiveMetadata{});
+    #endif
+    return fapl;
+}
+
+H5Easy::File& H5Interface::OutputFile(void)
+{
+    if(not OutputFileHandle)
+    {
+        OutputFileHandle = std::make_shared<H5Easy::File>(H5OutputFileName,
+                           H5Easy::File::OpenOrCreate, FileAccessProperties());
+    }
+    return *OutputFileHandle;
+}
+
+H5Easy::File H5Interface::InputFile(void) const
+{
+    if(OutputFileHandle and H5InputFileName == H5OutputFileName)
+    {
+        return *OutputFileHandle;
+    }
+    return H5Easy::File(H5InputFileName, H5Easy::File::OpenOrCreate, FileAccessProperties());
+}
+#endif
+
+#ifdef H5OP
+/* HDF5 filter setup, applied through the HighFive property lists */
+struct H5CompressionFilter
+{
+    H5Interface::Compression_t Compression;
+
+    void apply(const hid_t plist) const
     {
-        std::fstream inp(InputFileName.c_str(), std::ios::in | std::ios_base::binary);
-        if (!inp)
+        const unsigned int level = std::max(Compression.Level, 1);
+        H5Z_filter_t id = H5Z_FILTER_DEFLATE;
+        switch(Compression.Filter)
         {
-            ConsoleOutput::WriteExit("File " + InputFileName + " could not be opened", "H5", "WriteSimulationSettings()");
-            OP_Exit(EXIT_FAILURE);
-        };
-        std::vector<std::string> inputlines;
-        std::string str;
-        while(std::getline(inp, str)){
-            inputlines.push_back(str);
+            case H5Interface::Compressions::None:  return;
+            case H5Interface::Compressions::GZIP:  id = H5Z_FILTER_DEFLATE; break;
+            case H5Interface::Compressions::SZIP:  id = H5Z_FILTER_SZIP;    break;
+            case H5Interface::Compressions::ZSTD:  id = 32015;              break;
+            case H5Interface::Compressions::BLOSC: id = 32001;              break;
+            case H5Interface::Compressions::ZFP:   id = 32013;              break;
+            case H5Interface::Compressions::SZ:    id = 32017;              break;
         }
-        if (!file.exist("/SimulationSettings")) {
-            // Create the HDF5 group path:
-            file.createGroup("/SimulationSettings");
+        if(H5Zfilter_avail(id) <= 0)
+        {
+            static bool Warned = false;
+            if(not Warned)
+            {
+                ConsoleOutput::WriteWarning("HDF5 compression filter " + std::to_string(id) +
+                                            " is not available, GZIP is used instead",
+                                            H5Interface::thisclassname, "DatasetProperties()");
+                Warned = true;
+            }
+            id = H5Z_FILTER_DEFLATE;
         }
-        H5Easy::DataSet ds;
-        const std::string path = "/SimulationSettings/ProjectInput";
-        try {
-            if (file.exist(path)) {
-                // Try to read existing dataset shape and compare to avoid inconsistent-dimension errors
-                try {
-                    std::vector<size_t> shape = H5Easy::getShape(file, path);
-                    if (shape.size() == 1 && shape[0] == inputlines.size()) {
-                        // Same size: safe to overwrite
-                        ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Overwrite);
-                    } else {
-                        // Different shape -> remove existing dataset and recreate
-                        try { file.unlink(path); } catch (...) { /* ignore unlink failures */ }
-                        ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Create);
-                    }
-                } catch (const std::exception &e) {
-                    // Could not inspect existing dataset (incompatible type/shape) -> remove and recreate
-                    try { if (file.exist(path)) file.unlink(path); } catch (...) { /* ignore */ }
-                    ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Create);
+        /* The lossy filters need the unshuffled floating point values */
+        if(Compression.Shuffle and id != H5Z_FILTER_SZIP and id != 32001 and
+           id != 32013 and id != 32017)
+        {
+            H5Pset_shuffle(plist);
+        }
+        switch(id)
+        {
+            case H5Z_FILTER_DEFLATE:
+            {
+                H5Pset_deflate(plist, std::min(level, 9u));
+                break;
+            }
+            case H5Z_FILTER_SZIP:
+            {
+                H5Pset_szip(plist, H5_SZIP_NN_OPTION_MASK, 16);
+                break;
+            }
+            case 32015:
+            {
+                const unsigned int cd_values[1] = {level};
+                H5Pset_filter(plist, id, H5Z_FLAG_OPTIONAL, 1, cd_values);
+                break;
+            }
+            case 32001:
+            {
+                /* The first four values are set by the filter itself, then
+                level, shuffle and the compressor (0: blosclz) */
+                const unsigned int cd_values[7] = {0, 0, 0, 0, std::min(level, 9u),
+                                                   Compression.Shuffle ? 1u : 0u, 0};
+                H5Pset_filter(plist, id, H5Z_FLAG_OPTIONAL, 7, cd_values);
+                break;
+            }
+            case 32013:
+            {
+                /* H5Z-ZFP fixed accuracy mode (3), the error bound is
+                passed as a double in the last two values */
+                unsigned int cd_values[4] = {3, 0, 0, 0};
+                memcpy(&cd_values[2], &Compression.Tolerance, sizeof(double));
+                H5Pset_filter(plist, id, H5Z_FLAG_OPTIONAL, 4, cd_values);
+                break;
+            }
+            case 32017:
+            {
+                /* H5Z-SZ error configuration: the error bound mode (0:
+                absolute) followed by the absolute, relative, point-wise
+                relative and PSNR bounds, each double split into its high and
+                low 32 bits. The filter adds the dimensions itself. */
+                const double bounds[4] = {Compression.Tolerance, 0.0, 0.0, 0.0};
+                unsigned int cd_values[9] = {0};
+                for(int b = 0; b < 4; b++)
+                {
+                    uint64_t bits = 0;
+                    memcpy(&bits, &bounds[b], sizeof(double));
+                    cd_values[1 + 2*b] = static_cast<unsigned int>(bits >> 32);
+                    cd_values[2 + 2*b] = static_cast<unsigned int>(bits & 0xFFFFFFFF);
                 }
-            } else {
-                ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Create);
+                H5Pset_filter(plist, id, H5Z_FLAG_OPTIONAL, 9, cd_values);
+                break;
             }
-        } catch (const std::exception &e) {
-            // Forward exceptions as a warning to the console and continue without aborting
-            ConsoleOutput::WriteWarning(std::string("Could not write simulation settings to HDF5: ") + e.what(), thisclassname, "WriteSimulationSettings()");
-            return;
         }
+    }
+};
 
-        size_t el = ds.getElementCount();
+/* Largest divisor of n not exceeding limit, chunks with this edge length
+tile a subdomain of size n exactly */
+static size_t ChunkEdge(const size_t n, const size_t limit)
+{
+    for(size_t d = std::min(n, limit); d > 1; d--)
+    {
+        if(n % d == 0 and 4*d >= std::min(n, limit)) return d;
+    }
+    return std::min(n, limit);
+}
 
-        // Error checking:
-        if(el == 0) {
-            ConsoleOutput::WriteWarning("Zero elements were written to the HDF5 file", thisclassname, "WriteSimulationSettings()");
-        }
+HighFive::DataSetCreateProps H5Interface::DatasetProperties(const std::string& Name,
+                                                            const std::vector<size_t>& count) const
+{
+    HighFive::DataSetCreateProps props;
+
+    /* Chunks are aligned with the smallest subdomain, in parallel mode all
+    ranks have to use the same chunk dimensions */
+    std::vector<size_t> extent = count;
+    #ifdef H5OP_PARALLEL
+    for(size_t d = 0; d < extent.size(); d++)
+    {
+        unsigned long locExtent = extent[d];
+        unsigned long minExtent = 0;
+        OP_MPI_Allreduce(&locExtent, &minExtent, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+        extent[d] = minExtent;
+    }
+    #endif
+    std::vector<size_t> chunk(extent.size());
+    for(size_t d = 0; d < extent.size(); d++)
+    {
+        /* count is ordered (Z, Y, X[, components]) */
+        const long int requested = (d < 3) ? ChunkSize[2 - d] : 0;
+        if(d == 3)              chunk[d] = extent[d];
+        else if(requested > 0)  chunk[d] = std::min<size_t>(requested, extent[d]);
+        else                    chunk[d] = ChunkEdge(extent[d], 64);
+        chunk[d] = std::max<size_t>(chunk[d], 1);
     }
+    props.add(HighFive::Chunking(chunk));
+
+    auto it = FieldCompression.find(Name);
+    props.add(H5CompressionFilter{(it != FieldCompression.end()) ? it->second : DefaultCompression});
+    return props;
+}
+
+HighFive::DataSetCreateProps H5Interface::CheckpointProperties(const bool Lossy,
+                                                               const size_t size) const
+{
+    HighFive::DataSetCreateProps props;
+    if(CheckpointCompression.Filter == Compressions::None or size == 0) return props;
+
+    /* The chunk size depends only on the global size, all ranks agree on it */
+    props.add(HighFive::Chunking(std::vector<size_t>{std::min<size_t>(size, 1 << 16)}));
+    Compression_t locCompression = CheckpointCompression;
+    if(not Lossy and (locCompression.Filter == Compressions::ZFP or
+                      locCompression.Filter == Compressions::SZ))
+    {
+        locCompression.Filter = Compressions::GZIP;
+    }
+    props.add(H5CompressionFilter{locCompression});
+    return props;
+}
+#endif
+
+#ifdef H5OP_PARALLEL
+std::vector<size_t> H5Interface::GatherSizes(const size_t size) const
+{
+    std::vector<unsigned long> locSizes(MPI_SIZE);
+    unsigned long locSize = size;
+    OP_MPI_Allgather(&locSize, 1, OP_MPI_UNSIGNED_LONG,
+                     locSizes.data(), 1, OP_MPI_UNSIGNED_LONG, OP_MPI_COMM_WORLD);
+    return std::vector<size_t>(locSizes.begin(), locSizes.end());
+}
+#endif
+
+void H5Interface::WriteSimulationSettings(const std::string InputFileName)
+{
+    #ifdef H5OP
+    WriteInputLines(InputFileName, "/SimulationSettings/ProjectInput", "simulation settings", "WriteSimulationSettings()");
     #else
     ConsoleOutput::WriteWarning("OpenPhase is not compiled with HDF5 support, skipping HDF5 write", thisclassname, "WriteSimulationSettings()");
     return;
@@ -123,64 +381,95 @@ void H5Interface::WriteSimulationSettings(const std::string InputFileName)
 void H5Interface::WriteOPID(const std::string InputFileName)
 {
     #ifdef H5OP
-    H5Easy::File file(H5OutputFileName, H5Easy::File::OpenOrCreate);
+    WriteInputLines(InputFileName, "/SimulationSettings/OPID", "OPID", "WriteOPID()");
+    #else
+    ConsoleOutput::WriteWarning("OpenPhase is not compiled with HDF5 support, skipping HDF5 OPID write", thisclassname, "WriteOPID()");
+    return;
+    #endif
+}
+
+#ifdef H5OP
+static void DumpInputLines(H5Easy::File& file, const std::string InputFileName,
+                           const std::string path, const std::string what,
+                           const std::string method)
+{
+    std::stringstream inp = FileInterface::OpenInput(InputFileName);
+    if (!inp)
     {
-        std::fstream inp(InputFileName.c_str(), std::ios::in | std::ios_base::binary);
-        if (!inp)
-        {
-            ConsoleOutput::WriteExit("File " + InputFileName + " could not be opened", "H5", "WriteOPID()");
-            OP_Exit(EXIT_FAILURE);
-        };
-        std::vector<std::string> inputlines;
-        std::string str;
-        while(std::getline(inp, str)){
-            inputlines.push_back(str);
-        }
-        if (!file.exist("/SimulationSettings")) {
-            // Create the HDF5 group path:
-            file.createGroup("/SimulationSettings");
-        }
-        H5Easy::DataSet ds;
-        const std::string path = "/SimulationSettings/OPID";
-        try {
-            if (file.exist(path)) {
-                try {
-                    std::vector<size_t> shape = H5Easy::getShape(file, path);
-                    if (shape.size() == 1 && shape[0] == inputlines.size()) {
-                        ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Overwrite);
-                    } else {
-                        try { file.unlink(path); } catch (...) { }
-                        ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Create);
-                    }
-                } catch (const std::exception &e) {
-                    try { if (file.exist(path)) file.unlink(path); } catch (...) { }
+        ConsoleOutput::WriteExit("File " + InputFileName + " could not be opened", "H5", method);
+        OP_Exit(EXIT_FAILURE);
+    };
+    std::vector<std::string> inputlines;
+    std::string str;
+    while(std::getline(inp, str)){
+        inputlines.push_back(str);
+    }
+    if (!file.exist("/SimulationSettings")) {
+        // Create the HDF5 group path:
+        file.createGroup("/SimulationSettings");
+    }
+    H5Easy::DataSet ds;
+    try {
+        if (file.exist(path)) {
+            // Try to read existing dataset shape and compare to avoid inconsistent-dimension errors
+            try {
+                std::vector<size_t> shape = H5Easy::getShape(file, path);
+                if (shape.size() == 1 && shape[0] == inputlines.size()) {
+                    // Same size: safe to overwrite
+                    ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Overwrite);
+                } else {
+                    // Different shape -> remove existing dataset and recreate
+                    try { file.unlink(path); } catch (...) { /* ignore unlink failures */ }
                     ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Create);
                 }
-            } else {
+            } catch (const std::exception &e) {
+                // Could not inspect existing dataset (incompatible type/shape) -> remove and recreate
+                try { if (file.exist(path)) file.unlink(path); } catch (...) { /* ignore */ }
                 ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Create);
             }
-        } catch (const std::exception &e) {
-            ConsoleOutput::WriteWarning(std::string("Could not write OPID to HDF5: ") + e.what(), thisclassname, "WriteOPID()");
-            return;
+        } else {
+            ds = H5Easy::dump(file, path, inputlines, H5Easy::DumpMode::Create);
         }
+    } catch (const std::exception &e) {
+        // Forward exceptions as a warning to the console and continue without aborting
+        ConsoleOutput::WriteWarning("Could not write " + what + " to HDF5: " + e.what(), H5Interface::thisclassname, method);
+        return;
+    }
 
-        size_t el = ds.getElementCount();
+    size_t el = ds.getElementCount();
 
-        // Error checking:
-        if(el == 0) {
-            ConsoleOutput::WriteWarning("Zero elements were written to the HDF5 file", thisclassname, "WriteOPID()");
-        }
+    // Error checking:
+    if(el == 0) {
+        ConsoleOutput::WriteWarning("Zero elements were written to the HDF5 file", H5Interface::thisclassname, method);
+    }
+}
+
+void H5Interface::WriteInputLines(const std::string InputFileName,
+                                  const std::string path, const std::string what,
+                                  const std::string method)
+{
+    AsyncOutput::Flush();
+    #ifdef H5OP_PARALLEL
+    /* Variable length strings can not be written through the MPI-IO driver,
+    the first rank writes them with a serial file handle */
+    CloseFile();
+    if(MPI_RANK == 0)
+    {
+        H5Easy::File file(H5OutputFileName, H5Easy::File::OpenOrCreate);
+        DumpInputLines(file, InputFileName, path, what, method);
     }
+    OP_MPI_Barrier(OP_MPI_COMM_WORLD);
     #else
-    ConsoleOutput::WriteWarning("OpenPhase is not compiled with HDF5 support, skipping HDF5 OPID write", thisclassname, "WriteOPID()");
-    return;
+    DumpInputLines(OutputFile(), InputFileName, path, what, method);
     #endif
 }
+#endif
 
 void H5Interface::getProjectInput(std::stringstream& data)
 {
     #ifdef H5OP
-    H5Easy::File file(H5InputFileName, H5Easy::File::OpenOrCreate);
+    AsyncOutput::Flush();
+    H5Easy::File file = InputFile();
     if (!file.exist("/SimulationSettings")) {
         ConsoleOutput::WriteExit("/SimulationSettings not found.", "H5", "getProjectInput()");
         OP_Exit(EXIT_FAILURE);
@@ -206,7 +495,8 @@ void H5Interface::getProjectInput(std::stringstream& data)
 void H5Interface::getOPID(std::stringstream& data)
 {
     #ifdef H5OP
-    H5Easy::File file(H5InputFileName, H5Easy::File::OpenOrCreate);
+    AsyncOutput::Flush();
+    H5Easy::File file = InputFile();
     if (!file.exist("/SimulationSettings")) {
         ConsoleOutput::WriteExit("/SimulationSettings not found.", "H5", "getOPID()");
         OP_Exit(EXIT_FAILURE);
@@ -236,12 +526,114 @@ void H5Interface::WriteVisualization(
         const int resolution)
     {
         #ifdef H5OP
+        if(not locSettings.OutputRegions.empty())
+        {
+            WriteVisualizationRegions(tStep, locSettings, ListOfFields, resolution);
+            return;
+        }
+
         const long int Nx = resolution*locSettings.Grid.Nx;
         const long int Ny = resolution*locSettings.Grid.Ny;
         const long int Nz = resolution*locSettings.Grid.Nz;
 
+        /* At most one visualization output is written at a time */
+        AsyncOutput::Flush();
+        #ifndef H5OP_PARALLEL
+        if(AsyncOutput::Active())
+        {
+            size_t Bytes = 0;
+            if(AsyncOutput::Snapshot(ListOfFields, Nx, Ny, Nz, Bytes))
+            {
+                AsyncOutput::Submit([this, tStep, locSettings, ListOfFields, resolution]()
+                {
+                    WriteVisualization(tStep, locSettings, ListOfFields, resolution);
+                }, Bytes);
+                return;
+            }
+        }
+        #endif
+
+        #ifdef H5OP_PARALLEL
+        Subdomain.TotalNx = resolution*locSettings.Grid.TotalNx;
+        Subdomain.TotalNy = resolution*locSettings.Grid.TotalNy;
+        Subdomain.TotalNz = resolution*locSettings.Grid.TotalNz;
+        Subdomain.OffsetX = resolution*locSettings.Grid.OffsetX;
+        Subdomain.OffsetY = resolution*locSettings.Grid.OffsetY;
+        Subdomain.OffsetZ = resolution*locSettings.Grid.OffsetZ;
+
+        /* The XDMF description of the global dataset is written by the
+        first rank only */
+        if(MPI_RANK == 0)
+        {
+            WriteVisualizationXDMF(tStep, ListOfFields, Subdomain.TotalNx, Subdomain.TotalNy, Subdomain.TotalNz);
+        }
+        #else
+        WriteVisualizationXDMF(tStep, ListOfFields, Nx, Ny, Nz);
+        #endif
+
+        WritePointData( tStep,ListOfFields,
+             Nx,  Ny, Nz);
+
+        #else
+        ConsoleOutput::WriteWarning("OpenPhase is not compiled with HDF5 support, skipping HDF5 visualization write", thisclassname, "WriteVisualization()");
+        return;
+        #endif
+    }
+
+void H5Interface::WriteVisualizationRegions(
+        int tStep,
+        const Settings& locSettings,
+        const std::vector<Field_t>& ListOfFields,
+        const int resolution)
+    {
+        #ifdef H5OP
+        /* The region output is small and written synchronously */
+        AsyncOutput::Flush();
+        for(const OutputRegion& Region : locSettings.OutputRegions)
+        {
+            const OutputRegion::View_t View = Region.Local(locSettings, resolution);
+            if(View.Total[0] == 0 or View.Total[1] == 0 or View.Total[2] == 0)
+            {
+                ConsoleOutput::WriteWarning("Output region \"" + Region.Name + "\" is outside of the domain",
+                                            thisclassname, "WriteVisualization()");
+                continue;
+            }
+            const std::vector<Field_t> RegionFields = Region.Restrict(ListOfFields, View, Region.Name + "_");
+
+            Subdomain.TotalNx = View.Total[0];
+            Subdomain.TotalNy = View.Total[1];
+            Subdomain.TotalNz = View.Total[2];
+            Subdomain.OffsetX = View.Offset[0];
+            Subdomain.OffsetY = View.Offset[1];
+            Subdomain.OffsetZ = View.Offset[2];
+
+            std::stringstream Origin;
+            std::stringstream Spacing;
+            Origin  << 0.1*View.Begin[0]  << " " << 0.1*View.Begin[1]  << " " << 0.1*View.Begin[2];
+            Spacing << 0.1*View.Stride[0] << " " << 0.1*View.Stride[1] << " " << 0.1*View.Stride[2];
+            #ifdef H5OP_PARALLEL
+            if(MPI_RANK == 0)
+            #endif
+            {
+                WriteVisualizationXDMF(tStep, RegionFields, View.Total[0], View.Total[1], View.Total[2],
+                                       "_" + Region.Name, Origin.str(), Spacing.str());
+            }
+            WritePointData(tStep, RegionFields, View.N[0], View.N[1], View.N[2]);
+        }
+        #endif
+    }
+
+void H5Interface::WriteVisualizationXDMF(
+        int tStep,
+        const std::vector<Field_t>& ListOfFields,
+        const long int Nx, const long int Ny, const long int Nz,
+        const std::string& Suffix,
+        const std::string& Origin,
+        const std::string& Spacing)
+    {
+        #ifdef H5OP
         std::stringstream xdmffilename;
-        xdmffilename << H5OutputFileName << ".xdmf";
+        xdmffilename << H5OutputFileName << Suffix << ".xdmf";
 
         std::ifstream f(xdmffilename.str().c_str());
         if(!f.good())
@@ -304,7 +696,7 @@ void H5Interface::WriteVisualization(
         pOrigin->SetAttribute("NumberType", "Double");
         pOrigin->SetAttribute("Precision", 4);
         pOrigin->SetAttribute("Format", "XML");
-        pOrigin->SetText("0 0 0");
+        pOrigin->SetText(Origin.c_str());
         pGeo->InsertEndChild(pOrigin);
 
         XMLElement * pSpacing = xmlDoc.NewElement("DataItem");
@@ -313,7 +705,7 @@ void H5Interface::WriteVisualization(
         pSpacing->SetAttribute("NumberType", "Double");
         pSpacing->SetAttribute("Precision", 4);
         pSpacing->SetAttribute("Format", "XML");
-        pSpacing->SetText("0.1 0.1 0.1");
+        pSpacing->SetText(Spacing.c_str());
         pGeo->InsertEndChild(pSpacing);
 
         std::vector<XMLElement*> Attribute(ListOfFields.size());
@@ -324,27 +716,27 @@ void H5Interface::WriteVisualization(
             Attribute[i] = xmlDoc.NewElement("Attribute");
             Attribute[i]->SetAttribute("Name", Field.Name.c_str());
 
-            if (Field.Function(0,0,0).type() == typeid(dVector3))
+            if (Field.ValueType() == typeid(dVector3))
             {
                 Attribute[i]->SetAttribute("AttributeType", "Vector");
             }
-            else if (Field.Function(0,0,0).type() == typeid(dVector6))
+            else if (Field.ValueType() == typeid(dVector6))
             {
                 Attribute[i]->SetAttribute("AttributeType", "Vector");
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStrain))
+            else if (Field.ValueType() == typeid(vStrain))
             {
                 Attribute[i]->SetAttribute("AttributeType", "Tensor6");
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStress))
+            else if (Field.ValueType() == typeid(vStress))
             {
                 Attribute[i]->SetAttribute("AttributeType", "Tensor6");
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix3x3))
+            else if (Field.ValueType() == typeid(dMatrix3x3))
             {
                 Attribute[i]->SetAttribute("AttributeType", "Matrix");
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix6x6))
+            else if (Field.ValueType() == typeid(dMatrix6x6))
             {
                 Attribute[i]->SetAttribute("AttributeType", "Matrix");
             }
@@ -360,27 +752,27 @@ void H5Interface::WriteVisualization(
             std::stringstream ndims;
             ndims << dims.str();
 
-            if (Field.Function(0,0,0).type() == typeid(dVector3))
+            if (Field.ValueType() == typeid(dVector3))
             {
                 ndims << " 3";
             }
-            else if (Field.Function(0,0,0).type() == typeid(dVector6))
+            else if (Field.ValueType() == typeid(dVector6))
             {
                 ndims << " 6";
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStrain))
+            else if (Field.ValueType() == typeid(vStrain))
             {
                 ndims << " 6";
             }
-            else if (Field.Function(0,0,0).type() == typeid(vStress))
+            else if (Field.ValueType() == typeid(vStress))
             {
                 ndims << " 6";
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix3x3))
+            else if (Field.ValueType() == typeid(dMatrix3x3))
             {
                 ndims << " 3 3";
             }
-            else if (Field.Function(0,0,0).type() == typeid(dMatrix6x6))
+            else if (Field.ValueType() == typeid(dMatrix6x6))
             {
                 ndims << " 6 6";
             }
@@ -397,13 +789,6 @@ void H5Interface::WriteVisualization(
         }
 
         xmlDoc.SaveFile(xdmffilename.str().c_str());
-
-        WritePointData( tStep,ListOfFields,
-             Nx,  Ny, Nz);
-
-        #else
-        ConsoleOutput::WriteWarning("OpenPhase is not compiled with HDF5 support, skipping HDF5 visualization write", thisclassname, "WriteVisualization()");
-        return;
         #endif
     }
 }
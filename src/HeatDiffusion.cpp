@@ -30,6 +30,8 @@
 #include "PhaseField.h"
 #include "BoundaryConditions.h"
 #include "Composition.h"
+#include "LoadBalancer.h"
+#include "Tools/ReductionBatch.h"
 
 namespace openphase
 {
@@ -73,6 +75,10 @@ void HeatDiffusion::Initialize(Settings& locSettings, std::string ObjectNameSuff
     SolverCallsInterval = 1;
     SolverCallsCounter = 0;
     VerboseIterations = false;
+    ImplicitSolver = ImplicitSolverTypes::Jacobi;
+    LTSBlockSize = 8;
+    LTSMaxLevel = 10;
+    LTSSourceSubsteps = 1;
 
     PhaseThermalConductivity.Allocate(Nphases);
     PhaseVolumetricHeatCapacity.Allocate(Nphases);
@@ -86,6 +92,7 @@ void HeatDiffusion::Initialize(Settings& locSettings, std::string ObjectNameSuff
     Qdot.Allocate(Grid, Bcells);
 
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -130,6 +137,32 @@ void HeatDiffusion::ReadInput(std::stringstream& inp)
     SolverCallsInterval = FileInterface::ReadParameterI(inp, moduleLocation, string("SolverCallsInterval"), false, SolverCallsInterval);
     VerboseIterations = FileInterface::ReadParameterB(inp, moduleLocation, string("VerboseIterations"), false, VerboseIterations);
 
+    string SolverString = FileInterface::ReadParameterK(inp, moduleLocation, string("ImplicitSolver"), false, "JACOBI");
+    if(SolverString == "JACOBI")
+    {
+        ImplicitSolver = ImplicitSolverTypes::Jacobi;
+    }
+    else if(SolverString == "MULTIGRID")
+    {
+        ImplicitSolver = ImplicitSolverTypes::Multigrid;
+    }
+    else if(SolverString == "CG" or SolverString == "CONJUGATEGRADIENT")
+    {
+        ImplicitSolver = ImplicitSolverTypes::ConjugateGradient;
+    }
+    else if(SolverString == "ADI")
+    {
+        ImplicitSolver = ImplicitSolverTypes::ADI;
+    }
+    else
+    {
+        ConsoleOutput::WriteExit("Unknown implicit solver \"" + SolverString + "\". Use Jacobi, Multigrid, CG or ADI.", thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    LTSBlockSize      = FileInterface::ReadParameterI(inp, moduleLocation, string("LTSBlockSize"), false, LTSBlockSize);
+    LTSMaxLevel       = FileInterface::ReadParameterI(inp, moduleLocation, string("LTSMaxLevel"), false, LTSMaxLevel);
+    LTSSourceSubsteps = FileInterface::ReadParameterI(inp, moduleLocation, string("LTSSourceSubsteps"), false, LTSSourceSubsteps);
+
     MaxThermalConductivity = 0.0;
     for(size_t n = 0; n < Nphases; n++)
     {
@@ -140,25 +173,69 @@ void HeatDiffusion::ReadInput(std::stringstream& inp)
     ConsoleOutput::WriteBlankLine();
 }
 
+size_t HeatDiffusion::AllocatedMemory(void) const
+{
+    return EffectiveThermalConductivity.AllocatedMemory() +
+           EffectiveHeatCapacity.AllocatedMemory() +
+           Qdot.AllocatedMemory() +
+           TxOld.AllocatedMemory() +
+           dTx.AllocatedMemory() +
+           MultigridSolver.AllocatedMemory() +
+           ResidualCG.AllocatedMemory() +
+           DirectionCG.AllocatedMemory() +
+           ProductCG.AllocatedMemory() +
+           ScratchADI.AllocatedMemory();
+}
+
 void HeatDiffusion::Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC)
 {
     EffectiveThermalConductivity.Reallocate(newNx, newNy, newNz);
     EffectiveHeatCapacity.Reallocate(newNx, newNy, newNz);
+    PropertyCache.Epoch = 0;
     TxOld.Reallocate(newNx, newNy, newNz);
     dTx.Reallocate(newNx, newNy, newNz);
     Qdot.Reallocate(newNx, newNy, newNz);
 
     Grid.SetDimensions(newNx, newNy, newNz);
+    if(MultigridSolver.NumberOfLevels()) MultigridSolver.Initialize(Grid);
+    if(ResidualCG.IsAllocated())
+    {
+        ResidualCG.Reallocate(newNx, newNy, newNz);
+        DirectionCG.Reallocate(newNx, newNy, newNz);
+        ProductCG.Reallocate(newNx, newNy, newNz);
+    }
+    if(ScratchADI.IsAllocated()) ScratchADI.Reallocate(newNx, newNy, newNz);
 
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
+void HeatDiffusion::Repartition(const BoundaryConditions& BC)
+{
+    Grid.ApplyCutPlanes();
+
+    EffectiveThermalConductivity.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    EffectiveHeatCapacity.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    PropertyCache.Epoch = 0;
+    TxOld.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    dTx.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    Qdot.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+
+    if(MultigridSolver.NumberOfLevels()) MultigridSolver.Initialize(Grid);
+    if(ResidualCG.IsAllocated())
+    {
+        ResidualCG.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+        DirectionCG.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+        ProductCG.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
+    if(ScratchADI.IsAllocated()) ScratchADI.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+}
+
 void HeatDiffusion::SetLocalLatentHeat(const PhaseField& Phase, const Temperature& Tx)
 {
     /** This function accounts for the latent heat release due to
         phase-transformations. */
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Qdot,0,)
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,Qdot,Phase.Occupancy,)
     if(Phase.Fields(i,j,k).interface())
     {
         for(auto it  = Phase.FieldsDot(i,j,k).cbegin();
@@ -171,7 +248,7 @@ void HeatDiffusion::SetLocalLatentHeat(const PhaseField& Phase, const Temperatur
             Qdot(i,j,k) += Tx.LatentHeat({PIdxA,PIdxB})*it->value1;
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
 }
 
 void HeatDiffusion::SetLocalLatentHeatAndApply(const PhaseField& Phase, Temperature& Tx, double dt)
@@ -179,7 +256,7 @@ void HeatDiffusion::SetLocalLatentHeatAndApply(const PhaseField& Phase, Temperat
     /** This function accounts for the latent heat release due to
         phase-transformations. */
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Qdot,0,)
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,Qdot,Phase.Occupancy,)
     if(Phase.Fields(i,j,k).interface())
     {
         for(auto it  = Phase.FieldsDot(i,j,k).cbegin();
@@ -192,13 +269,13 @@ void HeatDiffusion::SetLocalLatentHeatAndApply(const PhaseField& Phase, Temperat
             Qdot(i,j,k) += Tx.LatentHeat({PIdxA,PIdxB})*it->value1;
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Qdot,0,)
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_BEGIN(i,j,k,Qdot,Phase.Occupancy,)
     if(Phase.Fields(i,j,k).interface())
     {
         Tx(i,j,k) += dt*Qdot(i,j,k)/EffectiveHeatCapacity(i,j,k);
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_OCCUPIED_STORAGE_LOOP_END
     Qdot.Clear();
 }
 void HeatDiffusion::SetEffectiveProperties(const PhaseField& Phase, const Temperature& Tx)
@@ -208,8 +285,15 @@ void HeatDiffusion::SetEffectiveProperties(const PhaseField& Phase, const Temper
         SetLocalLatentHeat(Phase, Tx);
     }
 
+    /* The properties of a bulk cell depend only on its phase, they are kept
+    while the derived property cache of Tx reports no change of the cell */
+    const bool Cached = Tx.Subscribe(PropertyCache, EffectiveThermalConductivity.Bcells());
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EffectiveThermalConductivity,EffectiveThermalConductivity.Bcells(),)
     {
+        if(Cached and not Phase.Fields(i,j,k).interface() and
+           not Tx.Outdated(i,j,k,PropertyCache)) continue;
+
         EffectiveHeatCapacity(i,j,k) = 0.0;
         EffectiveThermalConductivity(i,j,k) = 0.0;
 
@@ -259,10 +343,12 @@ void HeatDiffusion::Perform1DIteration(Temperature& Tx,
 #ifdef MPI_PARALLEL
     if(TxExt.Direction[0] == 0)
     {
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &averageRhoCP, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &averageLambda, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &boundaryValue, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &area, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        ReductionBatch Batch;
+        Batch.Sum(&averageRhoCP);
+        Batch.Sum(&averageLambda);
+        Batch.Sum(&boundaryValue);
+        Batch.Sum(&area);
+        Batch.Reduce();
     }
 #endif
 
@@ -299,6 +385,551 @@ void HeatDiffusion::Perform1DIteration(Temperature& Tx,
     TxExt.setBC(extBC);
 }
 
+bool HeatDiffusion::ConjugateGradientApplicable(const BoundaryConditions& BC) const
+{
+    /* The implicit time step RhoCp*T - dt*Lambda*Laplace(T) = RhoCp*TOld + Qdot*dt
+    uses the conductivity of the cell center. Divided by Lambda it becomes
+    symmetric positive definite if Lambda > 0 and the boundary conditions are
+    periodic, no flux or fixed. Otherwise the Jacobi iterations are used. */
+    bool applicable = true;
+    auto supported = [](const BoundaryConditionTypes bc)
+    {
+        return bc == BoundaryConditionTypes::Periodic or
+               bc == BoundaryConditionTypes::NoFlux   or
+               bc == BoundaryConditionTypes::Fixed;
+    };
+    if(Grid.dNx > 0 and not (supported(BC.BC0X) and supported(BC.BCNX))) applicable = false;
+    if(Grid.dNy > 0 and not (supported(BC.BC0Y) and supported(BC.BCNY))) applicable = false;
+    if(Grid.dNz > 0 and not (supported(BC.BC0Z) and supported(BC.BCNZ))) applicable = false;
+
+    double minLambda = std::numeric_limits<double>::max();
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EffectiveThermalConductivity,0,reduction(min:minLambda))
+    {
+        minLambda = min(minLambda, EffectiveThermalConductivity(i,j,k));
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &minLambda, 1, OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+#endif
+    if(minLambda <= 0.0) applicable = false;
+
+    if(not applicable)
+    {
+        ConsoleOutput::WriteWarning("Conjugate gradient solver requires positive thermal conductivities "
+                                    "and Periodic, NoFlux or Fixed boundary conditions.\n"
+                                    "Jacobi iterations are used instead.", thisclassname, "SolveImplicit()");
+    }
+    return applicable;
+}
+
+int HeatDiffusion::SolveConjugateGradient(Temperature& Temp,
+                                          const BoundaryConditions& BC,
+                                          const double dt,
+                                          const double MaxResidual,
+                                          const int IterationsLimit,
+                                          double& residual)
+{
+    /** Jacobi preconditioned conjugate gradient for the implicit time step
+        divided by the thermal conductivity:
+
+        A*T = (RhoCp/Lambda + 2*dim*dt/dx^2)*T - dt/dx^2*sum(T[neighbors])
+            = (RhoCp*TOld + Qdot*dt)/Lambda
+
+        The operator is applied cell by cell, no matrix is assembled. The
+        boundary cells of Temp (including the values set by the 1D
+        extensions) enter the initial residual, the correction is solved
+        with zero fixed boundary values. The residual measure max|r/diag(A)|
+        is the temperature increment of a Jacobi iteration. */
+
+    if(ResidualCG.IsNotAllocated())
+    {
+        ResidualCG.Allocate(Grid, Grid.Bcells);
+        DirectionCG.Allocate(Grid, Grid.Bcells);
+        ProductCG.Allocate(Grid, Grid.Bcells);
+    }
+
+    const double dt_dx2 = dt/(Grid.dx*Grid.dx);
+    const double dimension = 2.0*double(Grid.Active());
+    const double fx = (Grid.dNx > 0) ? 1.0 : 0.0;
+    const double fy = (Grid.dNy > 0) ? 1.0 : 0.0;
+    const double fz = (Grid.dNz > 0) ? 1.0 : 0.0;
+
+    auto Diagonal = [&](const long int i, const long int j, const long int k)
+    {
+        return EffectiveHeatCapacity(i,j,k)/EffectiveThermalConductivity(i,j,k) + dimension*dt_dx2;
+    };
+    auto Neighbours = [&](const Storage3D<double,0>& X, const long int i, const long int j, const long int k)
+    {
+        return (X(i+Grid.dNx,j,k) + X(i-Grid.dNx,j,k))*fx
+             + (X(i,j+Grid.dNy,k) + X(i,j-Grid.dNy,k))*fy
+             + (X(i,j,k+Grid.dNz) + X(i,j,k-Grid.dNz))*fz;
+    };
+
+    /* Initial residual r = b - A*T, direction p = r/diag(A) */
+    sum_real_t rzSum = 0.0;
+    double maxResidual = 0.0;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ResidualCG,0,reduction(ReproducibleSUM:rzSum) reduction(max:maxResidual))
+    {
+        const double locDiagonal = Diagonal(i,j,k);
+        const double locRHS = (EffectiveHeatCapacity(i,j,k)*TxOld(i,j,k) + Qdot(i,j,k)*dt)/EffectiveThermalConductivity(i,j,k);
+        const double locResidual = locRHS - locDiagonal*Temp(i,j,k) + dt_dx2*Neighbours(Temp.Tx,i,j,k);
+        ResidualCG(i,j,k)  = locResidual;
+        DirectionCG(i,j,k) = locResidual/locDiagonal;
+        rzSum += locResidual*locResidual/locDiagonal;
+        maxResidual = max(maxResidual, std::abs(locResidual/locDiagonal));
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+    ReductionBatch Batch;
+    Batch.Sum(&rzSum);
+    Batch.Max(&maxResidual);
+    Batch.Reduce();
+#endif
+    double rz = double(rzSum);
+
+    int iteration = 0;
+    while(maxResidual >= MaxResidual and iteration < IterationsLimit and rz > 0.0)
+    {
+        iteration++;
+
+        if(Grid.dNx > 0) BC.SetX(DirectionCG);
+        if(Grid.dNy > 0) BC.SetY(DirectionCG);
+        if(Grid.dNz > 0) BC.SetZ(DirectionCG);
+
+        /* q = A*p */
+        sum_real_t pqSum = 0.0;
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ProductCG,0,reduction(ReproducibleSUM:pqSum))
+        {
+            ProductCG(i,j,k) = Diagonal(i,j,k)*DirectionCG(i,j,k) - dt_dx2*Neighbours(DirectionCG,i,j,k);
+            pqSum += DirectionCG(i,j,k)*ProductCG(i,j,k);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+        Batch.Sum(&pqSum);
+        Batch.Reduce();
+#endif
+        const double alpha = rz/double(pqSum);
+
+        /* T += alpha*p, r -= alpha*q */
+        sum_real_t rzNewSum = 0.0;
+        maxResidual = 0.0;
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ResidualCG,0,reduction(ReproducibleSUM:rzNewSum) reduction(max:maxResidual))
+        {
+            Temp(i,j,k) += alpha*DirectionCG(i,j,k);
+            ResidualCG(i,j,k) -= alpha*ProductCG(i,j,k);
+            const double locZ = ResidualCG(i,j,k)/Diagonal(i,j,k);
+            rzNewSum += ResidualCG(i,j,k)*locZ;
+            maxResidual = max(maxResidual, std::abs(locZ));
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+        Batch.Sum(&rzNewSum);
+        Batch.Max(&maxResidual);
+        Batch.Reduce();
+#endif
+        const double rzNew = double(rzNewSum);
+        const double beta = rzNew/rz;
+        rz = rzNew;
+
+        /* p = r/diag(A) + beta*p */
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DirectionCG,0,)
+        {
+            DirectionCG(i,j,k) = ResidualCG(i,j,k)/Diagonal(i,j,k) + beta*DirectionCG(i,j,k);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
+
+    Temp.SetBoundaryConditions(BC);
+    residual = maxResidual;
+    return iteration;
+}
+
+bool HeatDiffusion::ADIApplicable(const BoundaryConditions& BC) const
+{
+    /* The factorization divides by the heat capacity, which therefore has to
+    be positive. Periodic lines are solved as cyclic tridiagonal systems,
+    which requires them to be local to a process. */
+    bool applicable = true;
+#ifdef MPI_PARALLEL
+    const bool periodic[3] = {BC.MPIperiodicX, BC.MPIperiodicY, BC.MPIperiodicZ};
+    for(int d = 0; d < 3; d++)
+    {
+        const int parts = MPI_3D_DECOMPOSITION ? MPI_CART_SIZE[d] : ((d == 0) ? MPI_SIZE : 1);
+        if(periodic[d] and parts > 1) applicable = false;
+    }
+#endif
+    double minRhoCp = std::numeric_limits<double>::max();
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,EffectiveHeatCapacity,0,reduction(min:minRhoCp))
+    {
+        minRhoCp = min(minRhoCp, EffectiveHeatCapacity(i,j,k));
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &minRhoCp, 1, OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+#endif
+    if(minRhoCp <= 0.0) applicable = false;
+
+    if(not applicable)
+    {
+        ConsoleOutput::WriteWarning("ADI solver requires positive volumetric heat capacities "
+                                    "and periodic boundaries only along directions which are not split among MPI processes.\n"
+                                    "Jacobi iterations are used instead.", thisclassname, "SolveImplicit()");
+    }
+    return applicable;
+}
+
+/* Treatment of the line ends in the ADI line solves, the correction in the
+boundary cell follows the boundary condition of the temperature */
+enum class LineEnds
+{
+    Fixed,                                                                      ///< Zero correction beyond the end (Fixed, 1D extensions)
+    NoFlux,                                                                     ///< Correction beyond the end equals the end value
+    Mirror,                                                                     ///< Correction beyond the end equals the value next to the end
+    Free,                                                                       ///< Correction extrapolated linearly beyond the end
+    Neighbor                                                                    ///< The line continues on the neighboring MPI process
+};
+
+static LineEnds LineEnd(const BoundaryConditionTypes type, const bool extension)
+{
+    switch(type)
+    {
+        case BoundaryConditionTypes::MPIcomm: return LineEnds::Neighbor;
+        case BoundaryConditionTypes::NoFlux:  return extension ? LineEnds::Fixed : LineEnds::NoFlux;
+        case BoundaryConditionTypes::Mirror:  return extension ? LineEnds::Fixed : LineEnds::Mirror;
+        case BoundaryConditionTypes::Free:    return extension ? LineEnds::Fixed : LineEnds::Free;
+        default:                              return LineEnds::Fixed;
+    }
+}
+
+void HeatDiffusion::SolveLines(const int direction, const Temperature& Temp,
+                               const BoundaryConditions& BC, const double dt)
+{
+    /** Solves the tridiagonal systems
+            -k*Lambda[n]*x[n-1] + (RhoCp[n] + 2*k*Lambda[n])*x[n] - k*Lambda[n]*x[n+1] = dTx[n]
+        with k = dt/dx^2 along all grid lines in "direction" with the Thomas
+        algorithm, the solution replaces dTx. The lines are independent and
+        solved in parallel. Lines which are split among MPI processes are
+        solved in a pipeline: the forward elimination passes the last modified
+        coefficients to the next process, the back substitution the first
+        solution value to the previous one. The lines are processed in chunks
+        so that the processes along the line work on different chunks at the
+        same time. Periodic lines are solved as cyclic systems with the
+        Sherman-Morrison formula. */
+
+    const long int N[3] = {dTx.sizeX(), dTx.sizeY(), dTx.sizeZ()};
+    const int d1 = (direction + 1)%3;
+    const int d2 = (direction + 2)%3;
+    const long int length = N[direction];
+    const long int Lines  = N[d1]*N[d2];
+    const double dt_dx2 = dt/(Grid.dx*Grid.dx);
+
+    const BoundaryConditionTypes BC0[3] = {BC.BC0X, BC.BC0Y, BC.BC0Z};
+    const BoundaryConditionTypes BCN[3] = {BC.BCNX, BC.BCNY, BC.BCNZ};
+    const bool Ext0[3] = {Temp.ExtensionX0.isActive(), Temp.ExtensionY0.isActive(), Temp.ExtensionZ0.isActive()};
+    const bool ExtN[3] = {Temp.ExtensionXN.isActive(), Temp.ExtensionYN.isActive(), Temp.ExtensionZN.isActive()};
+
+    bool cyclic = BC0[direction] == BoundaryConditionTypes::Periodic or
+                  BCN[direction] == BoundaryConditionTypes::Periodic;
+    LineEnds lower = LineEnd(BC0[direction], Temp.ExtensionsActive and Ext0[direction]);
+    LineEnds upper = LineEnd(BCN[direction], Temp.ExtensionsActive and ExtN[direction]);
+#ifdef MPI_PARALLEL
+    const bool periodic[3] = {BC.MPIperiodicX, BC.MPIperiodicY, BC.MPIperiodicZ};
+    if(periodic[direction])
+    {
+        /* Periodic along an undivided direction, see ADIApplicable() */
+        cyclic = true;
+        lower  = LineEnds::Fixed;
+        upper  = LineEnds::Fixed;
+    }
+#endif
+
+    if(ScratchADI.IsNotAllocated())
+    {
+        ScratchADI.Allocate(Grid, Grid.Bcells);
+    }
+
+    long int unit[3] = {0, 0, 0};
+    unit[direction] = 1;
+    const long int stride = &dTx(unit[0],unit[1],unit[2]) - &dTx(0,0,0);
+
+    /* Coefficients of row n, the end rows include the boundary condition */
+    auto Row = [&](const long int n, const double RhoCp, const double Lambda,
+                   double& a, double& b, double& c)
+    {
+        a = -dt_dx2*Lambda;
+        c = -dt_dx2*Lambda;
+        b = RhoCp + 2.0*dt_dx2*Lambda;
+        if(n == 0 and not cyclic)
+        switch(lower)
+        {
+            case LineEnds::NoFlux: b += a; a = 0.0; break;
+            case LineEnds::Mirror: c += a; a = 0.0; break;
+            case LineEnds::Free:   b += 2.0*a; c -= a; a = 0.0; break;
+            case LineEnds::Fixed:  a = 0.0; break;
+            case LineEnds::Neighbor: break;
+        }
+        if(n == length - 1 and not cyclic)
+        switch(upper)
+        {
+            case LineEnds::NoFlux: b += c; c = 0.0; break;
+            case LineEnds::Mirror: a += c; c = 0.0; break;
+            case LineEnds::Free:   b += 2.0*c; a -= c; c = 0.0; break;
+            case LineEnds::Fixed:  c = 0.0; break;
+            case LineEnds::Neighbor: break;
+        }
+    };
+    auto LineStart = [&](const long int line, auto& S)
+    {
+        long int cell[3];
+        cell[direction] = 0;
+        cell[d1] = line/N[d2];
+        cell[d2] = line%N[d2];
+        return &S(cell[0],cell[1],cell[2]);
+    };
+
+    if(cyclic)
+    {
+        #pragma omp parallel
+        {
+            vector<double> a(length), b(length), c(length), cp(length), y(length), z(length);
+            #pragma omp for schedule(static)
+            for(long int line = 0; line < Lines; line++)
+            {
+                double* D = LineStart(line, dTx);
+                const double* RhoCp  = LineStart(line, EffectiveHeatCapacity);
+                const double* Lambda = LineStart(line, EffectiveThermalConductivity);
+                for(long int n = 0; n < length; n++)
+                {
+                    Row(n, RhoCp[n*stride], Lambda[n*stride], a[n], b[n], c[n]);
+                }
+                /* A = A' + u*v^T with u = (gamma, 0, ..., c[N-1]) and
+                v = (1, 0, ..., a[0]/gamma) */
+                const double gamma = -b[0];
+                const double alpha = a[0];
+                const double beta  = c[length-1];
+                b[0] -= gamma;
+                b[length-1] -= alpha*beta/gamma;
+                auto Thomas = [&](vector<double>& x)
+                {
+                    cp[0] = c[0]/b[0];
+                    x[0] /= b[0];
+                    for(long int n = 1; n < length; n++)
+                    {
+                        const double denominator = b[n] - a[n]*cp[n-1];
+                        cp[n] = c[n]/denominator;
+                        x[n]  = (x[n] - a[n]*x[n-1])/denominator;
+                    }
+                    for(long int n = length - 2; n >= 0; n--)
+                    {
+                        x[n] -= cp[n]*x[n+1];
+                    }
+                };
+                for(long int n = 0; n < length; n++)
+                {
+                    y[n] = D[n*stride];
+                    z[n] = 0.0;
+                }
+                z[0] = gamma;
+                z[length-1] = beta;
+                Thomas(y);
+                Thomas(z);
+                const double factor = (y[0] + alpha*y[length-1]/gamma)/
+                                      (1.0 + z[0] + alpha*z[length-1]/gamma);
+                for(long int n = 0; n < length; n++)
+                {
+                    D[n*stride] = y[n] - factor*z[n];
+                }
+            }
+        }
+        return;
+    }
+
+    /* Forward elimination of the lines [first, last), In holds the modified
+    upper diagonal and right-hand side of the last row of each line on the
+    previous process */
+    auto Forward = [&](const long int first, const long int last,
+                       const double* In, double* Out)
+    {
+        #pragma omp parallel for schedule(static)
+        for(long int line = first; line < last; line++)
+        {
+            double* D  = LineStart(line, dTx);
+            double* CP = LineStart(line, ScratchADI);
+            const double* RhoCp  = LineStart(line, EffectiveHeatCapacity);
+            const double* Lambda = LineStart(line, EffectiveThermalConductivity);
+            double cpPrev = In ? In[2*(line - first)]     : 0.0;
+            double dpPrev = In ? In[2*(line - first) + 1] : 0.0;
+            for(long int n = 0; n < length; n++)
+            {
+                double a, b, c;
+                Row(n, RhoCp[n*stride], Lambda[n*stride], a, b, c);
+                const double denominator = b - a*cpPrev;
+                cpPrev = c/denominator;
+                dpPrev = (D[n*stride] - a*dpPrev)/denominator;
+                CP[n*stride] = cpPrev;
+                D[n*stride]  = dpPrev;
+            }
+            if(Out)
+            {
+                Out[2*(line - first)]     = cpPrev;
+                Out[2*(line - first) + 1] = dpPrev;
+            }
+        }
+    };
+    /* Back substitution, In holds the first solution value of each line on
+    the next process */
+    auto Backward = [&](const long int first, const long int last,
+                        const double* In, double* Out)
+    {
+        #pragma omp parallel for schedule(static)
+        for(long int line = first; line < last; line++)
+        {
+            double* D = LineStart(line, dTx);
+            const double* CP = LineStart(line, ScratchADI);
+            double x = In ? In[line - first] : 0.0;
+            for(long int n = length - 1; n >= 0; n--)
+            {
+                x = D[n*stride] - CP[n*stride]*x;
+                D[n*stride] = x;
+            }
+            if(Out) Out[line - first] = x;
+        }
+    };
+
+#ifdef MPI_PARALLEL
+    if(lower == LineEnds::Neighbor or upper == LineEnds::Neighbor)
+    {
+        int LeftProcess  = 0;
+        int RightProcess = 0;
+        bool exchangeLeft  = false;
+        bool exchangeRight = false;
+        BC.HaloNeighbors(direction, MPI_3D_DECOMPOSITION, LeftProcess, RightProcess, exchangeLeft, exchangeRight);
+        const bool fromLeft = lower == LineEnds::Neighbor;
+        const bool toRight  = upper == LineEnds::Neighbor;
+
+        const int parts  = MPI_3D_DECOMPOSITION ? MPI_CART_SIZE[direction] : MPI_SIZE;
+        const long int Chunks = max(1l, min(Lines, 4l*parts));
+        auto ChunkBegin = [&](const long int chunk) {return (chunk*Lines)/Chunks;};
+
+        const int ForwardTag  = 300;
+        const int BackwardTag = 301;
+        vector<double> Received(2*Lines);
+        vector<double> Sent(2*Lines);
+        vector<double> SentBack(Lines);
+        vector<void*> Requests;
+
+        for(long int chunk = 0; chunk < Chunks; chunk++)
+        {
+            const long int first = ChunkBegin(chunk);
+            const long int last  = ChunkBegin(chunk + 1);
+            double* In  = fromLeft ? &Received[2*first] : nullptr;
+            double* Out = toRight  ? &Sent[2*first]     : nullptr;
+            if(fromLeft)
+            {
+                void* request = create_request();
+                OP_MPI_Irecv(In, 2*(last - first), OP_MPI_DOUBLE, LeftProcess, ForwardTag, OP_MPI_COMM_WORLD, request);
+                OP_MPI_Wait(request, OP_MPI_STATUS_IGNORE);
+                free_request(request);
+            }
+            Forward(first, last, In, Out);
+            if(toRight)
+            {
+                Requests.push_back(create_request());
+                OP_MPI_Isend(Out, 2*(last - first), OP_MPI_DOUBLE, RightProcess, ForwardTag, OP_MPI_COMM_WORLD, Requests.back());
+            }
+        }
+        for(long int chunk = 0; chunk < Chunks; chunk++)
+        {
+            const long int first = ChunkBegin(chunk);
+            const long int last  = ChunkBegin(chunk + 1);
+            double* In  = toRight  ? &Received[first] : nullptr;
+            double* Out = fromLeft ? &SentBack[first] : nullptr;
+            if(toRight)
+            {
+                void* request = create_request();
+                OP_MPI_Irecv(In, last - first, OP_MPI_DOUBLE, RightProcess, BackwardTag, OP_MPI_COMM_WORLD, request);
+                OP_MPI_Wait(request, OP_MPI_STATUS_IGNORE);
+                free_request(request);
+            }
+            Backward(first, last, In, Out);
+            if(fromLeft)
+            {
+                Requests.push_back(create_request());
+                OP_MPI_Isend(Out, last - first, OP_MPI_DOUBLE, LeftProcess, BackwardTag, OP_MPI_COMM_WORLD, Requests.back());
+            }
+        }
+        for(void* request : Requests)
+        {
+            OP_MPI_Wait(request, OP_MPI_STATUS_IGNORE);
+            free_request(request);
+        }
+        return;
+    }
+#endif
+    Forward(0, Lines, nullptr, nullptr);
+    Backward(0, Lines, nullptr, nullptr);
+}
+
+void HeatDiffusion::SolveADI(Temperature& Temp, const BoundaryConditions& BC, const double dt)
+{
+    /** One step of the Douglas-Gunn approximate factorization of the implicit
+        time step in delta form:
+
+        r = RhoCp*TOld + Qdot*dt - (RhoCp - dt*Lambda*Laplace)(T)
+        (RhoCp - dt*Lambda*dxx) x1 = r
+        (RhoCp - dt*Lambda*dyy) x2 = RhoCp*x1
+        (RhoCp - dt*Lambda*dzz) x3 = RhoCp*x2
+        T += x3
+
+        Each factor is a set of independent tridiagonal line solves, the step
+        is unconditionally stable at the cost of one residual evaluation and
+        three line sweeps. The current boundary values of T (including the
+        values of the 1D extensions) enter the residual. */
+
+    const double dt_dx2 = dt/(Grid.dx*Grid.dx);
+    const double dimension = 2.0*double(Grid.Active());
+    const double fx = (Grid.dNx > 0) ? 1.0 : 0.0;
+    const double fy = (Grid.dNy > 0) ? 1.0 : 0.0;
+    const double fz = (Grid.dNz > 0) ? 1.0 : 0.0;
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,dTx,0,)
+    {
+        const double locStencil = (Temp(i+Grid.dNx,j,k) + Temp(i-Grid.dNx,j,k))*fx
+                                + (Temp(i,j+Grid.dNy,k) + Temp(i,j-Grid.dNy,k))*fy
+                                + (Temp(i,j,k+Grid.dNz) + Temp(i,j,k-Grid.dNz))*fz;
+        dTx(i,j,k) = EffectiveHeatCapacity(i,j,k)*TxOld(i,j,k) + Qdot(i,j,k)*dt
+                   - (EffectiveHeatCapacity(i,j,k) + dimension*EffectiveThermalConductivity(i,j,k)*dt_dx2)*Temp(i,j,k)
+                   + EffectiveThermalConductivity(i,j,k)*dt_dx2*locStencil;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    const bool active[3] = {Grid.dNx > 0, Grid.dNy > 0, Grid.dNz > 0};
+    bool first = true;
+    for(int direction = 0; direction < 3; direction++)
+    if(active[direction])
+    {
+        if(not first)
+        {
+            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,dTx,0,)
+            {
+                dTx(i,j,k) *= EffectiveHeatCapacity(i,j,k);
+            }
+            OMP_PARALLEL_STORAGE_LOOP_END
+        }
+        SolveLines(direction, Temp, BC, dt);
+        first = false;
+    }
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Temp.Tx,0,)
+    {
+        Temp(i,j,k) += dTx(i,j,k);
+        dTx(i,j,k) = 0.0;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    Temp.SetBoundaryConditions(BC);
+}
+
 int HeatDiffusion::SolveImplicit(const PhaseField& Phase,
                                  const BoundaryConditions& BC,
                                  Temperature& Temp,
@@ -331,6 +962,28 @@ int HeatDiffusion::SolveImplicit(const PhaseField& Phase,
         const double dt_dx2 = dt/(Grid.dx*Grid.dx);
         const double dimension = 2.0*double(Grid.Active());                       // Laplacian stencil dimension parameter
 
+        /* The multigrid solver does not include the 1D extensions, they are
+        coupled through the Jacobi iterations only. The conjugate gradient
+        solver takes the extension values as boundary values, each of the
+        outer iterations below updates the extensions and then solves the
+        bulk problem. The ADI solver does one factorized step per iteration,
+        the iterations continue only while the 1D extensions change. */
+        const bool useMultigrid = (ImplicitSolver == ImplicitSolverTypes::Multigrid) and not Temp.ExtensionsActive;
+        const bool useConjugateGradient = (ImplicitSolver == ImplicitSolverTypes::ConjugateGradient) and ConjugateGradientApplicable(BC);
+        const bool useADI = (ImplicitSolver == ImplicitSolverTypes::ADI) and ADIApplicable(BC);
+        if(useMultigrid)
+        {
+            if(MultigridSolver.NumberOfLevels() == 0) MultigridSolver.Initialize(Grid);
+
+            Storage3D<double,0>& RHS = MultigridSolver.RHS();
+            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,RHS,0,)
+            {
+                RHS(i,j,k) = EffectiveHeatCapacity(i,j,k)*TxOld(i,j,k) + Qdot(i,j,k)*dt;
+            }
+            OMP_PARALLEL_STORAGE_LOOP_END
+            MultigridSolver.SetCoefficients(EffectiveHeatCapacity, EffectiveThermalConductivity, dt);
+        }
+
         do
         {
             iteration++;
@@ -371,37 +1024,84 @@ int HeatDiffusion::SolveImplicit(const PhaseField& Phase,
                 }
             }
 
-            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Temp.Tx,0,reduction(max:residual))
+            if(useMultigrid)
             {
-                /* Calculation of heat diffusion using Jacobi implicit method. */
-
-                double RhoCp      = EffectiveHeatCapacity(i,j,k);                   // Volumetric heat capacity [J/(m^3 K)]
-                double Lambda     = EffectiveThermalConductivity(i,j,k);            // Thermal conductivity [J/(m s K)]
-                double locQdot    = Qdot(i,j,k);                                    // Heat source [J/(m^3 s)]
-                double locStencil = 0.0;                                            // Temperature stencil from the updated field [K]
-
-                if (Grid.dNx > 0) locStencil += (Temp(i+1,j,k) + Temp(i-1,j,k));
-                if (Grid.dNy > 0) locStencil += (Temp(i,j+1,k) + Temp(i,j-1,k));
-                if (Grid.dNz > 0) locStencil += (Temp(i,j,k+1) + Temp(i,j,k-1));
-
-                dTx(i,j,k) = (RhoCp*TxOld(i,j,k) + Lambda*locStencil*dt_dx2 + locQdot*dt)
-                            /(RhoCp + dimension*Lambda*dt_dx2) - Temp(i,j,k);
-
-                residual = max(residual,dTx(i,j,k)*dTx(i,j,k));
+                /* One V-cycle, the residual is squared like the Jacobi increments below. */
+                residual = MultigridSolver.VCycle(Temp.Tx, BC);
+                residual *= residual;
             }
-            OMP_PARALLEL_STORAGE_LOOP_END
-
-            /* Updating the temperature with the calculated increment.*/
-
-            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Temp.Tx,0,)
+            else if(useConjugateGradient)
             {
-                Temp(i,j,k) += dTx(i,j,k);
-                dTx(i,j,k) = 0.0;
+                /* The iterations of the solver count towards MaxIterations. */
+                double locResidual = 0.0;
+                int locIterations = SolveConjugateGradient(Temp, BC, dt, Tolerance*(Temp.Tavg + Tolerance),
+                                                           MaxIterations - iteration + 1, locResidual);
+                iteration += max(locIterations, 1) - 1;
+                residual = max(residual, locResidual*locResidual);
             }
-            OMP_PARALLEL_STORAGE_LOOP_END
+            else if(useADI)
+            {
+                SolveADI(Temp, BC, dt);
+            }
+            else
+            {
+                /* Calculation of heat diffusion using Jacobi implicit method.
+                   The grid is processed in contiguous z-rows, so the inner loop
+                   is a unit stride loop which is vectorized by the compiler.
+                   Neighbours along inactive dimensions are excluded by a zero
+                   factor instead of a branch inside the loop. */
+
+                const long int Nx = Temp.Tx.sizeX();
+                const long int Ny = Temp.Tx.sizeY();
+                const long int Nz = Temp.Tx.sizeZ();
+                const double fx = (Grid.dNx > 0) ? 1.0 : 0.0;
+                const double fy = (Grid.dNy > 0) ? 1.0 : 0.0;
+                const double fz = (Grid.dNz > 0) ? 1.0 : 0.0;
+
+                #pragma omp parallel for collapse(2) schedule(static) reduction(max:residual)
+                for(long int i = 0; i < Nx; ++i)
+                for(long int j = 0; j < Ny; ++j)
+                {
+                    const double* T   = &Temp(i,j,0);
+                    const double* Txp = &Temp(i+Grid.dNx,j,0);
+                    const double* Txm = &Temp(i-Grid.dNx,j,0);
+                    const double* Typ = &Temp(i,j+Grid.dNy,0);
+                    const double* Tym = &Temp(i,j-Grid.dNy,0);
+                    const double* Tzp = &Temp(i,j,Grid.dNz);
+                    const double* Tzm = &Temp(i,j,-Grid.dNz);
+
+                    const double* RhoCp   = &EffectiveHeatCapacity(i,j,0);          // Volumetric heat capacity [J/(m^3 K)]
+                    const double* Lambda  = &EffectiveThermalConductivity(i,j,0);   // Thermal conductivity [J/(m s K)]
+                    const double* locQdot = &Qdot(i,j,0);                           // Heat source [J/(m^3 s)]
+                    const double* locTOld = &TxOld(i,j,0);
+                    double* locdT = &dTx(i,j,0);
+
+                    #pragma omp simd reduction(max:residual)
+                    for(long int k = 0; k < Nz; ++k)
+                    {
+                        double locStencil = (Txp[k] + Txm[k])*fx                    // Temperature stencil from the updated field [K]
+                                          + (Typ[k] + Tym[k])*fy
+                                          + (Tzp[k] + Tzm[k])*fz;
+
+                        locdT[k] = (RhoCp[k]*locTOld[k] + Lambda[k]*locStencil*dt_dx2 + locQdot[k]*dt)
+                                  /(RhoCp[k] + dimension*Lambda[k]*dt_dx2) - T[k];
+
+                        residual = max(residual,locdT[k]*locdT[k]);
+                    }
+                }
 
-            /* Assigning values for the boundary cells. */
-            Temp.SetBoundaryConditions(BC);
+                /* Updating the temperature with the calculated increment.*/
+
+                OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Temp.Tx,0,)
+                {
+                    Temp(i,j,k) += dTx(i,j,k);
+                    dTx(i,j,k) = 0.0;
+                }
+                OMP_PARALLEL_STORAGE_LOOP_END
+
+                /* Assigning values for the boundary cells. */
+                Temp.SetBoundaryConditions(BC);
+            }
 
             /* Warning output, if number of iterations exceeds MaxIterations. */
 
@@ -424,7 +1124,7 @@ int HeatDiffusion::SolveImplicit(const PhaseField& Phase,
                 ConsoleOutput::WriteWithinMethod(message, thisclassname, "SolveImplicit()");
             }
 
-            if(iteration == MaxIterations)
+            if(iteration >= MaxIterations)
             {
                 stringstream value;
                 value.precision(16);
@@ -458,4 +1158,292 @@ int HeatDiffusion::SolveImplicit(const PhaseField& Phase,
     SolverCallsCounter++;
     return iteration;
 }
+long int HeatDiffusion::NeighborBlock(const BoundaryConditions& BC, const size_t Index,
+                                      const int face) const
+{
+    const int d = face/2;
+    const bool active[3] = {Grid.dNx > 0, Grid.dNy > 0, Grid.dNz > 0};
+    if(not active[d]) return -1;
+
+    bool periodic[3] = {BC.BC0X == BoundaryConditionTypes::Periodic or BC.BCNX == BoundaryConditionTypes::Periodic,
+                        BC.BC0Y == BoundaryConditionTypes::Periodic or BC.BCNY == BoundaryConditionTypes::Periodic,
+                        BC.BC0Z == BoundaryConditionTypes::Periodic or BC.BCNZ == BoundaryConditionTypes::Periodic};
+#ifdef MPI_PARALLEL
+    periodic[0] = periodic[0] or BC.MPIperiodicX;
+    periodic[1] = periodic[1] or BC.MPIperiodicY;
+    periodic[2] = periodic[2] or BC.MPIperiodicZ;
+#endif
+
+    long int Block[3] = {long(Index)/(NumBlocks[1]*NumBlocks[2]),
+                         (long(Index)/NumBlocks[2])%NumBlocks[1],
+                         long(Index)%NumBlocks[2]};
+    Block[d] += (face%2 == 0) ? -1 : 1;
+    if(Block[d] < 0 or Block[d] >= NumBlocks[d])
+    {
+        if(not periodic[d]) return -1;
+        Block[d] = (Block[d] + NumBlocks[d])%NumBlocks[d];
+    }
+    return (Block[0]*NumBlocks[1] + Block[1])*NumBlocks[2] + Block[2];
+}
+
+int HeatDiffusion::SetBlockLevels(const BoundaryConditions& BC, const double dt)
+{
+    /* The domain is covered by a global grid of cubic blocks of LTSBlockSize
+    cells, a block straddling a process boundary is split between the
+    processes. The level of a block is set by the most restrictive forward
+    Euler stability limit of its cells, blocks with heat sources and their
+    neighbours get at least the finest level, and neighbouring blocks differ
+    by at most one level. */
+    const long int Total[3]  = {Grid.TotalNx, Grid.TotalNy, Grid.TotalNz};
+    const long int Offset[3] = {Grid.OffsetX, Grid.OffsetY, Grid.OffsetZ};
+    const long int Size[3]   = {Grid.Nx, Grid.Ny, Grid.Nz};
+    const long int B = max(LTSBlockSize, 1);
+
+    for(int d = 0; d < 3; d++) NumBlocks[d] = (Total[d] + B - 1)/B;
+    BlockLevels.assign(size_t(NumBlocks[0])*NumBlocks[1]*NumBlocks[2], 0);
+    vector<int> Sources(BlockLevels.size(), 0);
+
+    LocalBlocks.clear();
+    for(long int b0 = Offset[0]/B; b0 <= (Offset[0] + Size[0] - 1)/B; b0++)
+    for(long int b1 = Offset[1]/B; b1 <= (Offset[1] + Size[1] - 1)/B; b1++)
+    for(long int b2 = Offset[2]/B; b2 <= (Offset[2] + Size[2] - 1)/B; b2++)
+    {
+        const long int Block[3] = {b0, b1, b2};
+        TimeSteppingBlock locBlock;
+        for(int d = 0; d < 3; d++)
+        {
+            locBlock.Begin[d] = max(Block[d]*B, Offset[d]) - Offset[d];
+            locBlock.End[d]   = min((Block[d] + 1)*B, Offset[d] + Size[d]) - Offset[d];
+        }
+        locBlock.Index = (b0*NumBlocks[1] + b1)*NumBlocks[2] + b2;
+        LocalBlocks.push_back(locBlock);
+    }
+
+    const double dx2 = Grid.dx*Grid.dx;
+    const double Safety = 0.9;                                                  // Fraction of the stability limit
+    double minRhoCp = std::numeric_limits<double>::max();
+    #pragma omp parallel for schedule(dynamic) reduction(min:minRhoCp)
+    for(size_t n = 0; n < LocalBlocks.size(); n++)
+    {
+        const TimeSteppingBlock& locBlock = LocalBlocks[n];
+        int locLevel = 0;
+        int locSource = 0;
+        for(long int i = locBlock.Begin[0]; i < locBlock.End[0]; i++)
+        for(long int j = locBlock.Begin[1]; j < locBlock.End[1]; j++)
+        for(long int k = locBlock.Begin[2]; k < locBlock.End[2]; k++)
+        {
+            const double Lambda = EffectiveThermalConductivity(i,j,k);
+            double Conductance = 0.0;
+            if(Grid.dNx) Conductance += Lambda + 0.5*(EffectiveThermalConductivity(i+1,j,k) + EffectiveThermalConductivity(i-1,j,k));
+            if(Grid.dNy) Conductance += Lambda + 0.5*(EffectiveThermalConductivity(i,j+1,k) + EffectiveThermalConductivity(i,j-1,k));
+            if(Grid.dNz) Conductance += Lambda + 0.5*(EffectiveThermalConductivity(i,j,k+1) + EffectiveThermalConductivity(i,j,k-1));
+
+            const double RhoCp = EffectiveHeatCapacity(i,j,k);
+            minRhoCp = min(minRhoCp, RhoCp);
+            if(RhoCp > 0.0)
+            {
+                const double ratio = dt*Conductance/(Safety*RhoCp*dx2);
+                if(ratio > 1.0) locLevel = max(locLevel, int(ceil(log2(ratio))));
+            }
+            if(Qdot(i,j,k) != 0.0) locSource = 1;
+        }
+        BlockLevels[locBlock.Index] = locLevel;
+        Sources[locBlock.Index] = locSource;
+    }
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, BlockLevels.data(), BlockLevels.size(), OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, Sources.data(), Sources.size(), OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &minRhoCp, 1, OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+#endif
+    if(minRhoCp <= 0.0)
+    {
+        ConsoleOutput::WriteExit("Explicit solver requires positive volumetric heat capacities", thisclassname, "SolveExplicit()");
+        OP_Exit(EXIT_FAILURE);
+    }
+
+    const int SourceLevel = max(*max_element(BlockLevels.begin(), BlockLevels.end()),
+                                int(ceil(log2(max(LTSSourceSubsteps, 1)))));
+    vector<int> Levels = BlockLevels;
+    for(size_t b = 0; b < BlockLevels.size(); b++)
+    if(Sources[b])
+    {
+        Levels[b] = max(Levels[b], SourceLevel);
+        for(int face = 0; face < 6; face++)
+        {
+            const long int nb = NeighborBlock(BC, b, face);
+            if(nb >= 0) Levels[nb] = max(Levels[nb], SourceLevel);
+        }
+    }
+    BlockLevels.swap(Levels);
+
+    if(*max_element(BlockLevels.begin(), BlockLevels.end()) > LTSMaxLevel)
+    {
+        ConsoleOutput::WriteWarning("Time step requires more than 2^" + to_string(LTSMaxLevel) +
+                                    " substeps, the explicit solver may be unstable.\n"
+                                    "Reduce the time step or increase $LTSMaxLevel.", thisclassname, "SolveExplicit()");
+        for(auto& Level : BlockLevels) Level = min(Level, LTSMaxLevel);
+    }
+
+    bool changed = true;
+    while(changed)
+    {
+        changed = false;
+        for(size_t b = 0; b < BlockLevels.size(); b++)
+        for(int face = 0; face < 6; face++)
+        {
+            const long int nb = NeighborBlock(BC, b, face);
+            if(nb >= 0 and BlockLevels[nb] - 1 > BlockLevels[b])
+            {
+                BlockLevels[b] = BlockLevels[nb] - 1;
+                changed = true;
+            }
+        }
+    }
+
+    /* Faces of the local part which are not faces of the global block (at
+    process boundaries) keep the level of the block */
+    for(auto& locBlock : LocalBlocks)
+    {
+        locBlock.Level = BlockLevels[locBlock.Index];
+        for(int face = 0; face < 6; face++)
+        {
+            const int d = face/2;
+            const long int Global = (face%2 == 0) ? locBlock.Begin[d] + Offset[d] : locBlock.End[d] + Offset[d];
+            const bool BlockFace = (Global%B == 0) or (Global == Total[d]);
+            const long int nb = NeighborBlock(BC, locBlock.Index, face);
+            locBlock.FaceLevel[face] = (BlockFace and nb >= 0) ? max(locBlock.Level, BlockLevels[nb]) : locBlock.Level;
+        }
+    }
+    return *max_element(BlockLevels.begin(), BlockLevels.end());
+}
+
+int HeatDiffusion::SolveExplicit(const PhaseField& Phase,
+                                 const BoundaryConditions& BC,
+                                 Temperature& Temp,
+                                 const double dt)
+{
+    /** Explicit solver with block-local time stepping. A block of level L
+        advances in 2^L forward Euler substeps of dt/2^L, so that the work
+        concentrates where the stability limit or an active heat source
+        requires small steps. The heat flux across a face uses the mean
+        conductivity of the two cells and is evaluated with the substep of the
+        finer adjacent block from the current temperatures. Both cells add the
+        same flux times the substep to their energy increments in dTx, a cell
+        updates its temperature at the end of its own step. The scheme is
+        therefore conservative across level changes, the coarse side sees the
+        fine temperatures of the substeps within its step. */
+
+    if(Temp.ExtensionsActive)
+    {
+        ConsoleOutput::WriteExit("The 1D temperature extensions are only supported by SolveImplicit()", thisclassname, "SolveExplicit()");
+        OP_Exit(EXIT_FAILURE);
+    }
+
+    const int maxLevel = SetBlockLevels(BC, dt);
+    const long int Steps = 1l << maxLevel;
+    const double dx2 = Grid.dx*Grid.dx;
+    const bool active[3] = {Grid.dNx > 0, Grid.dNy > 0, Grid.dNz > 0};
+    const int Neighbors[6][3] = {{-1,0,0},{1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+
+    auto Period = [maxLevel](const int Level) {return 1l << (maxLevel - Level);};
+    auto Substep = [dt](const int Level) {return dt/double(1l << Level);};
+    auto Flux = [&](const long int i, const long int j, const long int k, const int face)
+    {
+        const long int ii = i + Neighbors[face][0];
+        const long int jj = j + Neighbors[face][1];
+        const long int kk = k + Neighbors[face][2];
+        return 0.5*(EffectiveThermalConductivity(i,j,k) + EffectiveThermalConductivity(ii,jj,kk))
+                  *(Temp(ii,jj,kk) - Temp(i,j,k))/dx2;
+    };
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,dTx,0,)
+    {
+        dTx(i,j,k) = 0.0;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    size_t Updates = 0;
+    for(long int s = 0; s < Steps; s++)
+    {
+        #pragma omp parallel for schedule(dynamic) reduction(+:Updates)
+        for(size_t n = 0; n < LocalBlocks.size(); n++)
+        {
+            const TimeSteppingBlock& locBlock = LocalBlocks[n];
+            if(s % Period(locBlock.Level) == 0)
+            {
+                const double h = Substep(locBlock.Level);
+                double hFace[6];
+                for(int face = 0; face < 6; face++) hFace[face] = Substep(locBlock.FaceLevel[face]);
+
+                for(long int i = locBlock.Begin[0]; i < locBlock.End[0]; i++)
+                for(long int j = locBlock.Begin[1]; j < locBlock.End[1]; j++)
+                for(long int k = locBlock.Begin[2]; k < locBlock.End[2]; k++)
+                {
+                    const long int Position[3] = {i, j, k};
+                    double locIncrement = Qdot(i,j,k)*h;
+                    for(int face = 0; face < 6; face++)
+                    if(active[face/2])
+                    {
+                        const int d = face/2;
+                        const bool BlockFace = (face%2 == 0) ? (Position[d] == locBlock.Begin[d])
+                                                             : (Position[d] == locBlock.End[d] - 1);
+                        locIncrement += Flux(i,j,k,face)*(BlockFace ? hFace[face] : h);
+                    }
+                    dTx(i,j,k) += locIncrement;
+                }
+                Updates += (locBlock.End[0] - locBlock.Begin[0])*(locBlock.End[1] - locBlock.Begin[1])*(locBlock.End[2] - locBlock.Begin[2]);
+            }
+            else for(int face = 0; face < 6; face++)
+            if(active[face/2] and locBlock.FaceLevel[face] > locBlock.Level and s % Period(locBlock.FaceLevel[face]) == 0)
+            {
+                /* Between its own steps a block evaluates only the faces
+                towards finer blocks */
+                const int d = face/2;
+                long int Begin[3] = {locBlock.Begin[0], locBlock.Begin[1], locBlock.Begin[2]};
+                long int End[3]   = {locBlock.End[0],   locBlock.End[1],   locBlock.End[2]};
+                if(face%2 == 0) End[d] = Begin[d] + 1;
+                else            Begin[d] = End[d] - 1;
+
+                const double h = Substep(locBlock.FaceLevel[face]);
+                for(long int i = Begin[0]; i < End[0]; i++)
+                for(long int j = Begin[1]; j < End[1]; j++)
+                for(long int k = Begin[2]; k < End[2]; k++)
+                {
+                    dTx(i,j,k) += Flux(i,j,k,face)*h;
+                }
+            }
+        }
+
+        #pragma omp parallel for schedule(dynamic)
+        for(size_t n = 0; n < LocalBlocks.size(); n++)
+        {
+            const TimeSteppingBlock& locBlock = LocalBlocks[n];
+            if((s + 1) % Period(locBlock.Level) == 0)
+            for(long int i = locBlock.Begin[0]; i < locBlock.End[0]; i++)
+            for(long int j = locBlock.Begin[1]; j < locBlock.End[1]; j++)
+            for(long int k = locBlock.Begin[2]; k < locBlock.End[2]; k++)
+            {
+                Temp(i,j,k) += dTx(i,j,k)/EffectiveHeatCapacity(i,j,k);
+                dTx(i,j,k) = 0.0;
+            }
+        }
+        Temp.SetBoundaryConditions(BC);
+    }
+
+    if(VerboseIterations)
+    {
+        double Work = double(Updates)/(double(Steps)*double(Grid.LocalNumberOfCells()));
+#ifdef MPI_PARALLEL
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &Work, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+        std::string message  = ConsoleOutput::GetStandard("Substeps of the finest blocks", std::to_string(Steps));
+                    message += ConsoleOutput::GetStandard("Work relative to global substeps",
+                               ConsoleOutput::to_string_with_precision(Work));
+        ConsoleOutput::WriteWithinMethod(message, thisclassname, "SolveExplicit()");
+    }
+
+    Temp.CalculateMinMaxAvg();
+    Qdot.Clear();
+    return Steps;
+}
 }// namespace openphase
@@ -52,7 +52,7 @@ void HeatSources::ReadInput(const std::string InputFileName)
     ConsoleOutput::WriteLineInsert("HeatSources input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -63,7 +63,6 @@ void HeatSources::ReadInput(const std::string InputFileName)
     std::stringstream data;
     data << inp.rdbuf();
     ReadInput(data);
-    inp.close();
 
     ConsoleOutput::WriteLine();
 }
@@ -317,6 +316,9 @@ bool HeatSources::Write(const std::string FileName) const
 
 void HeatSources::Apply(PhaseField& Phase, Temperature& Tx, HeatDiffusion& HD)
 {
+    // Phase sources are collected and applied in one pass over the domain
+    std::vector<std::pair<size_t,double>> PhaseSources;
+
     for(auto source = Sources.begin(); source != Sources.end(); source++)
     if(source->Active)
     {
@@ -450,14 +452,7 @@ void HeatSources::Apply(PhaseField& Phase, Temperature& Tx, HeatDiffusion& HD)
             }
             case HeatSourceTypes::Phase:
             {
-                OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
-                {
-                    if(Phase.Fractions(i,j,k,{source->PhaseIndex}) > DBL_EPSILON)
-                    {
-                        HD.Qdot(i,j,k) += source_value * Phase.Fractions(i,j,k,{source->PhaseIndex});
-                    }
-                }
-                OMP_PARALLEL_STORAGE_LOOP_END
+                PhaseSources.push_back({source->PhaseIndex, source_value});
                 break;
             }
             case HeatSourceTypes::Ellipsoidal:
@@ -466,7 +461,25 @@ void HeatSources::Apply(PhaseField& Phase, Temperature& Tx, HeatDiffusion& HD)
                 double radiusY2 = pow(source->Size[1],2);
                 double radiusZ2 = pow(source->Size[2],2);
 
-                OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
+                // Only the bounding box of the ellipsoid in the local domain is visited
+                long int Begin[3];
+                long int End[3];
+                const long int Offset[3] = {Phase.Grid.OffsetX, Phase.Grid.OffsetY, Phase.Grid.OffsetZ};
+                const long int N[3]      = {Phase.Grid.Nx, Phase.Grid.Ny, Phase.Grid.Nz};
+                for(int d = 0; d < 3; d++)
+                {
+                    const double lower = floor(source->Position[d] - fabs(source->Size[d])) - Offset[d];
+                    const double upper =  ceil(source->Position[d] + fabs(source->Size[d])) - Offset[d] + 1;
+                    Begin[d] = std::max(0l,   long(std::max(lower, -1.0)));
+                    End[d]   = std::min(N[d], long(std::min(upper, double(N[d]))));
+                }
+
+#ifdef _OPENMP
+#pragma omp parallel for collapse(3) schedule(OMP_SCHEDULING_TYPE,OMP_CHUNKSIZE)
+#endif
+                for(long int i = Begin[0]; i < End[0]; i++)
+                for(long int j = Begin[1]; j < End[1]; j++)
+                for(long int k = Begin[2]; k < End[2]; k++)
                 {
                     double radX2 = pow((i+Phase.Grid.OffsetX - source->Position[0]), 2);
                     double radY2 = pow((j+Phase.Grid.OffsetY - source->Position[1]), 2);
@@ -489,7 +502,6 @@ void HeatSources::Apply(PhaseField& Phase, Temperature& Tx, HeatDiffusion& HD)
                         }
                     }
                 }
-                OMP_PARALLEL_STORAGE_LOOP_END
                 break;
             }
 
@@ -499,6 +511,19 @@ void HeatSources::Apply(PhaseField& Phase, Temperature& Tx, HeatDiffusion& HD)
             }
         }
     }
+
+    if(not PhaseSources.empty())
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
+        {
+            for(auto& source : PhaseSources)
+            if(Phase.Fractions(i,j,k,{source.first}) > DBL_EPSILON)
+            {
+                HD.Qdot(i,j,k) += source.second * Phase.Fractions(i,j,k,{source.first});
+            }
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
 }
 
 void HeatSources::Activate(PhaseField& Phase, Temperature& Tx, RunTimeControl& RTC)
@@ -0,0 +1,431 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "InSitu.h"
+#include "Settings.h"
+#include "RunTimeControl.h"
+
+#ifdef ADIOS2OP
+#include <adios2.h>
+#ifdef MPI_PARALLEL
+#include <mpi.h>
+#endif
+#endif
+
+#ifdef CATALYSTOP
+#include <catalyst.hpp>
+#endif
+
+namespace openphase
+{
+using namespace std;
+
+struct InSitu::BackendState
+{
+#ifdef ADIOS2OP
+    unique_ptr<adios2::ADIOS> Adios;
+    adios2::IO IO;
+    adios2::Engine Writer;
+#endif
+};
+
+InSitu::InSitu() :
+    Backend(Backends::None), Interval(1), Engine("SST"), Stream("OpenPhase"),
+    State(make_unique<BackendState>()), Active(false)
+{
+}
+
+InSitu::InSitu(const Settings& locSettings, const std::string InputFileName) : InSitu()
+{
+    ReadInput(InputFileName);
+    Initialize(locSettings);
+}
+
+InSitu::~InSitu()
+{
+    Finalize();
+}
+
+void InSitu::ReadInput(const std::string InputFileName)
+{
+    ConsoleOutput::WriteLineInsert("InSitu input");
+    ConsoleOutput::WriteStandard("Source", InputFileName);
+
+    stringstream inp = FileInterface::OpenInput(InputFileName);
+
+    if (!inp)
+    {
+        ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened", thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    };
+
+    std::stringstream data;
+    data << inp.rdbuf();
+    ReadInput(data);
+
+    ConsoleOutput::WriteLine();
+}
+
+void InSitu::ReadInput(std::stringstream& inp)
+{
+    /* The module is optional, without it the keys of other modules (e.g.
+    $Interval) must not be picked up */
+    if(inp.str().find(string("@") + thisclassname) == string::npos) return;
+
+    const int moduleLocation = FileInterface::FindModuleLocation(inp, thisclassname);
+
+    const string locBackend = FileInterface::ReadParameterK(inp, moduleLocation, "Backend", false, "NONE");
+    if     (locBackend == "NONE")     Backend = Backends::None;
+    else if(locBackend == "ADIOS2")   Backend = Backends::ADIOS2;
+    else if(locBackend == "CATALYST") Backend = Backends::Catalyst;
+    else
+    {
+        ConsoleOutput::WriteExit("Unknown in-situ backend \"" + locBackend + "\", use None, ADIOS2 or Catalyst", thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
+
+    Interval = FileInterface::ReadParameterI(inp, moduleLocation, "Interval", false, 1);
+    Engine   = FileInterface::ReadParameterS(inp, moduleLocation, "Engine", false, "SST");
+    Stream   = FileInterface::ReadParameterS(inp, moduleLocation, "Stream", false, "OpenPhase");
+    Config   = FileInterface::ReadParameterS(inp, moduleLocation, "Config", false, "");
+
+    stringstream locScripts(FileInterface::ReadParameterS(inp, moduleLocation, "Scripts", false, ""));
+    Scripts.clear();
+    for(string Script; locScripts >> Script;)
+    {
+        Scripts.push_back(Script);
+    }
+}
+
+void InSitu::Initialize(const Settings& locSettings)
+{
+    if(Active or Backend == Backends::None) return;
+
+    switch(Backend)
+    {
+        case Backends::ADIOS2:
+        {
+#ifdef ADIOS2OP
+#ifdef MPI_PARALLEL
+            State->Adios = Config.empty() ? make_unique<adios2::ADIOS>(MPI_COMM_WORLD)
+                                          : make_unique<adios2::ADIOS>(Config, MPI_COMM_WORLD);
+#else
+            State->Adios = Config.empty() ? make_unique<adios2::ADIOS>()
+                                          : make_unique<adios2::ADIOS>(Config);
+#endif
+            /* The engine of a configuration file takes precedence */
+            State->IO = State->Adios->DeclareIO(Stream);
+            if(not State->IO.InConfigFile()) State->IO.SetEngine(Engine);
+            State->Writer = State->IO.Open(Stream, adios2::Mode::Write);
+#else
+            ConsoleOutput::WriteExit("OpenPhase is compiled without ADIOS2, use SETTINGS=\"... adios2\"", thisclassname, "Initialize()");
+            OP_Exit(EXIT_FAILURE);
+#endif
+            break;
+        }
+        case Backends::Catalyst:
+        {
+#ifdef CATALYSTOP
+            conduit_cpp::Node Node;
+            for(size_t n = 0; n < Scripts.size(); n++)
+            {
+                Node["catalyst/scripts/script" + to_string(n)].set_string(Scripts[n]);
+            }
+            if(catalyst_initialize(conduit_cpp::c_node(&Node)) != catalyst_status_ok)
+            {
+                ConsoleOutput::WriteExit("Catalyst initialization failed", thisclassname, "Initialize()");
+                OP_Exit(EXIT_FAILURE);
+            }
+#else
+            ConsoleOutput::WriteExit("OpenPhase is compiled without Catalyst, use SETTINGS=\"... catalyst\"", thisclassname, "Initialize()");
+            OP_Exit(EXIT_FAILURE);
+#endif
+            break;
+        }
+        default: break;
+    }
+    (void) locSettings; //unused
+    Active = true;
+}
+
+void InSitu::Register(const std::vector<OutputField>& ListOfFields)
+{
+    Fields.insert(Fields.end(), ListOfFields.begin(), ListOfFields.end());
+}
+
+void InSitu::RegisterView(const std::string& Name, const Storage3D<double,0>& Field)
+{
+    Views.push_back(View{Name, 1,
+        [&Field](){return &Field(-Field.BcellsX(), -Field.BcellsY(), -Field.BcellsZ());},
+        [&Field](){return array<long int,3>{Field.sizeX(), Field.sizeY(), Field.sizeZ()};},
+        [&Field](){return array<long int,3>{Field.BcellsX(), Field.BcellsY(), Field.BcellsZ()};}});
+}
+
+void InSitu::RegisterView(const std::string& Name, const Storage3D<dVector3,0>& Field)
+{
+    static_assert(sizeof(dVector3) == 3*sizeof(double), "dVector3 is expected to hold exactly three doubles");
+    Views.push_back(View{Name, 3,
+        [&Field](){return reinterpret_cast<const double*>(&Field(-Field.BcellsX(), -Field.BcellsY(), -Field.BcellsZ()));},
+        [&Field](){return array<long int,3>{Field.sizeX(), Field.sizeY(), Field.sizeZ()};},
+        [&Field](){return array<long int,3>{Field.BcellsX(), Field.BcellsY(), Field.BcellsZ()};}});
+}
+
+void InSitu::RegisterView(const std::string& Name, const Storage3D<double,1>& Field)
+{
+    Views.push_back(View{Name, Field.Dimensions()[0],
+        [&Field](){return &Field(-Field.BcellsX(), -Field.BcellsY(), -Field.BcellsZ(), {0});},
+        [&Field](){return array<long int,3>{Field.sizeX(), Field.sizeY(), Field.sizeZ()};},
+        [&Field](){return array<long int,3>{Field.BcellsX(), Field.BcellsY(), Field.BcellsZ()};}});
+}
+
+size_t InSitu::Tabulate(const OutputField& Field, const long int Nx,
+                        const long int Ny, const long int Nz)
+{
+    vector<double>& Buffer = Buffers[Field.Name];
+    const type_index Type = Field.ValueType();
+    if(Type == typeid(double))
+    {
+        Buffer = Field.Values<double>(Nx, Ny, Nz);
+        return 1;
+    }
+    if(Type == typeid(int))
+    {
+        const vector<int> Values = Field.Values<int>(Nx, Ny, Nz);
+        Buffer.assign(Values.begin(), Values.end());
+        return 1;
+    }
+    if(Type == typeid(size_t))
+    {
+        const vector<size_t> Values = Field.Values<size_t>(Nx, Ny, Nz);
+        Buffer.assign(Values.begin(), Values.end());
+        return 1;
+    }
+    if(Type == typeid(dVector3))
+    {
+        const vector<dVector3> Values = Field.Values<dVector3>(Nx, Ny, Nz);
+        Buffer.resize(3*Values.size());
+        for(size_t n = 0; n < Values.size(); n++)
+        for(size_t c = 0; c < 3; c++)
+        {
+            Buffer[3*n + c] = Values[n][c];
+        }
+        return 3;
+    }
+    return 0;
+}
+
+size_t InSitu::Tabulate(const View& locView)
+{
+    vector<double>& Buffer = Buffers[locView.Name];
+    const array<long int,3> N = locView.Size();
+    const array<long int,3> B = locView.Bcells();
+    const long int NyBC = N[1] + 2*B[1];
+    const long int NzBC = N[2] + 2*B[2];
+    const size_t C = locView.Components;
+    const double* Data = locView.Data();
+
+    Buffer.resize(N[0]*N[1]*N[2]*C);
+    #pragma omp parallel for collapse(2) schedule(static)
+    for(long int i = 0; i < N[0]; ++i)
+    for(long int j = 0; j < N[1]; ++j)
+    for(long int k = 0; k < N[2]; ++k)
+    {
+        const double* cell = Data + (((i + B[0])*NyBC + j + B[1])*NzBC + k + B[2])*C;
+        double* value = Buffer.data() + ((k*N[1] + j)*N[0] + i)*C;
+        for(size_t c = 0; c < C; c++) value[c] = cell[c];
+    }
+    return C;
+}
+
+bool InSitu::Execute(const Settings& locSettings, const RunTimeControl& RTC)
+{
+    if(Backend == Backends::None or Interval <= 0 or RTC.TimeStep % Interval != 0) return false;
+    if(not Active) Initialize(locSettings);
+
+    const GridParameters& Grid = locSettings.Grid;
+    const long int Nx = Grid.Nx;
+    const long int Ny = Grid.Ny;
+    const long int Nz = Grid.Nz;
+
+#ifdef ADIOS2OP
+    if(Backend == Backends::ADIOS2)
+    {
+        adios2::IO& IO = State->IO;
+        adios2::Engine& Writer = State->Writer;
+
+        /* Variables are defined at the first call, the selection follows
+        the local box, which changes with the load balancing */
+        auto Variable = [&IO](const string& Name, const adios2::Dims& Shape,
+                              const adios2::Dims& Start, const adios2::Dims& Count)
+        {
+            adios2::Variable<double> locVariable = IO.InquireVariable<double>(Name);
+            if(not locVariable)
+            {
+                return IO.DefineVariable<double>(Name, Shape, Start, Count);
+            }
+            locVariable.SetShape(Shape);
+            locVariable.SetSelection({Start, Count});
+            return locVariable;
+        };
+
+        Writer.BeginStep();
+        adios2::Variable<int> Step = IO.InquireVariable<int>("TimeStep");
+        if(not Step) Step = IO.DefineVariable<int>("TimeStep");
+        adios2::Variable<double> Time = IO.InquireVariable<double>("Time");
+        if(not Time) Time = IO.DefineVariable<double>("Time");
+#ifdef MPI_PARALLEL
+        if(MPI_RANK == 0)
+#endif
+        {
+            Writer.Put(Step, RTC.TimeStep);
+            Writer.Put(Time, RTC.SimulationTime);
+        }
+
+        for(const OutputField& Field : Fields)
+        {
+            const size_t C = Tabulate(Field, Nx, Ny, Nz);
+            if(C == 0) continue;
+            adios2::Dims Shape {size_t(Grid.TotalNz), size_t(Grid.TotalNy), size_t(Grid.TotalNx)};
+            adios2::Dims Start {size_t(Grid.OffsetZ), size_t(Grid.OffsetY), size_t(Grid.OffsetX)};
+            adios2::Dims Count {size_t(Nz), size_t(Ny), size_t(Nx)};
+            if(C > 1)
+            {
+                Shape.push_back(C);
+                Start.push_back(0);
+                Count.push_back(C);
+            }
+            Writer.Put(Variable(Field.Name, Shape, Start, Count), Buffers[Field.Name].data());
+        }
+
+        /* Zero-copy: the memory selection describes the padded storage */
+        for(const View& locView : Views)
+        {
+            const array<long int,3> N = locView.Size();
+            const array<long int,3> B = locView.Bcells();
+            const size_t C = locView.Components;
+            adios2::Dims Shape {size_t(Grid.TotalNx), size_t(Grid.TotalNy), size_t(Grid.TotalNz)};
+            adios2::Dims Start {size_t(Grid.OffsetX), size_t(Grid.OffsetY), size_t(Grid.OffsetZ)};
+            adios2::Dims Count {size_t(N[0]), size_t(N[1]), size_t(N[2])};
+            adios2::Dims MemoryStart {size_t(B[0]), size_t(B[1]), size_t(B[2])};
+            adios2::Dims MemoryCount {size_t(N[0] + 2*B[0]), size_t(N[1] + 2*B[1]), size_t(N[2] + 2*B[2])};
+            if(C > 1)
+            {
+                Shape.push_back(C);
+                Start.push_back(0);
+                Count.push_back(C);
+                MemoryStart.push_back(0);
+                MemoryCount.push_back(C);
+            }
+            adios2::Variable<double> locVariable = Variable(locView.Name, Shape, Start, Count);
+            locVariable.SetMemorySelection({MemoryStart, MemoryCount});
+            Writer.Put(locVariable, locView.Data());
+        }
+        Writer.EndStep();
+    }
+#endif
+
+#ifdef CATALYSTOP
+    if(Backend == Backends::Catalyst)
+    {
+        conduit_cpp::Node Node;
+        Node["catalyst/state/timestep"].set(RTC.TimeStep);
+        Node["catalyst/state/time"].set(RTC.SimulationTime);
+        Node["catalyst/channels/grid/type"].set_string("mesh");
+
+        conduit_cpp::Node Mesh = Node["catalyst/channels/grid/data"];
+        Mesh["coordsets/coords/type"].set_string("uniform");
+        Mesh["coordsets/coords/dims/i"].set(int(Nx + 1));
+        Mesh["coordsets/coords/dims/j"].set(int(Ny + 1));
+        Mesh["coordsets/coords/dims/k"].set(int(Nz + 1));
+        Mesh["coordsets/coords/origin/x"].set(Grid.OffsetX*Grid.dx);
+        Mesh["coordsets/coords/origin/y"].set(Grid.OffsetY*Grid.dx);
+        Mesh["coordsets/coords/origin/z"].set(Grid.OffsetZ*Grid.dx);
+        Mesh["coordsets/coords/spacing/dx"].set(Grid.dx);
+        Mesh["coordsets/coords/spacing/dy"].set(Grid.dx);
+        Mesh["coordsets/coords/spacing/dz"].set(Grid.dx);
+        Mesh["topologies/mesh/type"].set_string("uniform");
+        Mesh["topologies/mesh/coordset"].set_string("coords");
+
+        auto AddField = [&Mesh](const string& Name, vector<double>& Buffer, const size_t C)
+        {
+            conduit_cpp::Node locField = Mesh["fields/" + Name];
+            locField["association"].set_string("element");
+            locField["topology"].set_string("mesh");
+            locField["volume_dependent"].set_string("false");
+            const conduit_index_t Size = Buffer.size()/C;
+            if(C == 1)
+            {
+                locField["values"].set_external(Buffer.data(), Size);
+            }
+            else for(size_t c = 0; c < C; c++)
+            {
+                const string Component = (C == 3) ? string(1, char('x' + c)) : to_string(c);
+                locField["values/" + Component].set_external(Buffer.data(), Size,
+                        c*sizeof(double), C*sizeof(double));
+            }
+        };
+        for(const OutputField& Field : Fields)
+        {
+            const size_t C = Tabulate(Field, Nx, Ny, Nz);
+            if(C) AddField(Field.Name, Buffers[Field.Name], C);
+        }
+        for(const View& locView : Views)
+        {
+            AddField(locView.Name, Buffers[locView.Name], Tabulate(locView));
+        }
+
+        if(catalyst_execute(conduit_cpp::c_node(&Node)) != catalyst_status_ok)
+        {
+            ConsoleOutput::WriteWarning("Catalyst execution failed at time step " + to_string(RTC.TimeStep), thisclassname, "Execute()");
+        }
+    }
+#endif
+    (void) Nx; //unused without a backend
+    (void) Ny; //unused without a backend
+    (void) Nz; //unused without a backend
+    return true;
+}
+
+void InSitu::Finalize(void)
+{
+    if(not Active) return;
+#ifdef ADIOS2OP
+    if(Backend == Backends::ADIOS2)
+    {
+        State->Writer.Close();
+    }
+#endif
+#ifdef CATALYSTOP
+    if(Backend == Backends::Catalyst)
+    {
+        conduit_cpp::Node Node;
+        catalyst_finalize(conduit_cpp::c_node(&Node));
+    }
+#endif
+    Active = false;
+}
+
+}// namespace openphase
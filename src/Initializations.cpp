@@ -39,10 +39,13 @@
 #include "Settings.h"
 #include "Tools.h"
 #include "Tools/AnalysisSintering.h"
+#include "Tools/CSVParser.h"
+#include "MappedFile.h"
 #include "NumericalMethods/RootFindingAlgorithms.h"
 #include "UserDrivingForce.h"
 #include <cwctype>
 #include <set>
+#include <unordered_map>
 
 /***************************************************************/
 
@@ -128,6 +131,7 @@ vector<iVector3> Initializations::QuasiRandomSpheres(PhaseField& Phase,
                                                      int seed)
 {
     vector<iVector3> result;
+    vector<SphereShape> Shapes;
 
     if (seed == -1)
     {
@@ -175,13 +179,14 @@ vector<iVector3> Initializations::QuasiRandomSpheres(PhaseField& Phase,
                 k + dk >= 0 and k + dk < Nz)
             {
                 double randPhase = double(rand()) / double(RAND_MAX);
+                const dVector3 Center({double(i+di), double(j+dj), double(k+dk)});
                 if (randPhase < probabilityPhase1)
                 {
-                    Initializations::Sphere(Phase, phaseIndex1, radius1, i+di, j+dj, k+dk, BC);
+                    Shapes.push_back({size_t(phaseIndex1), radius1, Center});
                 }
                 else
                 {
-                    Initializations::Sphere(Phase, phaseIndex2, radius2, i+di, j+dj, k+dk, BC);
+                    Shapes.push_back({size_t(phaseIndex2), radius2, Center});
                 }
 
                 iVector3 temp;
@@ -193,9 +198,18 @@ vector<iVector3> Initializations::QuasiRandomSpheres(PhaseField& Phase,
             }
         }
     }
+    Spheres(Phase, Shapes, BC);
     return result;
 }
 
+/* Nuclei are placed by dart throwing on a background occupancy grid: a local
+cell is occupied if a flagged cell (including the halo) or an already planted
+nucleus is within iWidth of it along each axis. The grid is built once by
+separable dilation of the flags, each planted nucleus marks its own box, so the
+overlap test of a dart is a single lookup. Darts are drawn from the list of
+remaining candidate cells and every draw removes one candidate, the placement
+therefore does not degrade at high packing fractions and stops only if no free
+cell is left. In MPI each rank plants Nparticles nuclei in its own cells. */
 void Initializations::RandomNuclei(PhaseField& Phase,
                                    const Settings& locSettings,
                                    size_t phaseIndex,
@@ -205,80 +219,118 @@ void Initializations::RandomNuclei(PhaseField& Phase,
                                    string onPlane,
                                    int seed)
 {
-    if (seed == -1)
-    {
-        srand(time(NULL));
-    }
-    else
-    {
+    unsigned int PositionsSeed = (seed == -1) ? time(NULL) : seed;
 #ifdef MPI_PARALLEL
-        srand(pow(seed + MPI_RANK,(MPI_RANK + 1)));
-#else
-        srand(seed);
+    PositionsSeed += 7919*MPI_RANK;
 #endif
-    }
-
-    default_random_engine OrientationsGenerator(2*seed);
+    default_random_engine PositionsGenerator(PositionsSeed);
     default_random_engine VariantsGenerator(3*seed);
 
-    for (size_t n = 0; n < Nparticles; n++)
-    {
-        bool planted = false;
-        int iterations = 0;
-        while(!planted and iterations < 1000)
-        {
-            iterations++;
-
-            int di = 0;
-            if     (onPlane == "Xbottom") {di = 0;}
-            else if(onPlane == "Xtop")    {di = Phase.Grid.Nx - 1;}
-            else                          {di = rand() % Phase.Grid.Nx;};
+    const long int iWidth = Phase.Grid.iWidth;
+    const long int N[3] = {Phase.Grid.Nx, Phase.Grid.Ny, Phase.Grid.Nz};
+    const long int B[3] = {Phase.Fields.BcellsX(), Phase.Fields.BcellsY(), Phase.Fields.BcellsZ()};
+    const long int E[3] = {N[0] + 2*B[0], N[1] + 2*B[1], N[2] + 2*B[2]};
+    const long int S[3] = {E[1]*E[2], E[2], 1};
 
-            int dj = 0;
-            if     (onPlane == "Ybottom") {dj = 0;}
-            else if(onPlane == "Ytop")    {dj = Phase.Grid.Ny - 1;}
-            else                          {dj = rand() % Phase.Grid.Ny;};
-
-            int dk = 0;
-            if     (onPlane == "Zbottom") {dk = 0;}
-            else if(onPlane == "Ztop")    {dk = Phase.Grid.Nz - 1;}
-            else                          {dk = rand() % Phase.Grid.Nz;};
-
-            bool freecell = true;
+    /* Occupancy of the local cells and the halo, indexed from -B */
+    vector<unsigned char> Occupied(size_t(E[0])*E[1]*E[2]);
+    #pragma omp parallel for collapse(3)
+    for(long int i = -B[0]; i < N[0] + B[0]; i++)
+    for(long int j = -B[1]; j < N[1] + B[1]; j++)
+    for(long int k = -B[2]; k < N[2] + B[2]; k++)
+    {
+        Occupied[(i + B[0])*S[0] + (j + B[1])*S[1] + (k + B[2])] = (Phase.Fields(i,j,k).flag != 0);
+    }
 
-            for (int ii = - Phase.Grid.iWidth; ii <= Phase.Grid.iWidth; ii++)
-            for (int jj = - Phase.Grid.iWidth; jj <= Phase.Grid.iWidth; jj++)
-            for (int kk = - Phase.Grid.iWidth; kk <= Phase.Grid.iWidth; kk++)
-            if ((di+ii > -Phase.Fields.Bcells() and di+ii < Phase.Grid.Nx + Phase.Fields.Bcells() and
-                 dj+jj > -Phase.Fields.Bcells() and dj+jj < Phase.Grid.Ny + Phase.Fields.Bcells() and
-                 dk+kk > -Phase.Fields.Bcells() and dk+kk < Phase.Grid.Nz + Phase.Fields.Bcells()) and
-                Phase.Fields(di+ii,dj+jj,dk+kk).flag)
-            {
-                freecell = false;
-                break;
-            }
-            if(freecell)
+    for(int d = 0; d < 3; d++)
+    {
+        const int a = (d + 1) % 3;
+        const int b = (d + 2) % 3;
+        #pragma omp parallel
+        {
+            vector<long int> Prefix(E[d] + 1, 0);
+            #pragma omp for collapse(2)
+            for(long int ia = 0; ia < E[a]; ia++)
+            for(long int ib = 0; ib < E[b]; ib++)
             {
-                int locIndex = Phase.PlantGrainNucleus(phaseIndex, di, dj, dk);
-                if(randomOrientation)
+                unsigned char* Line = Occupied.data() + ia*S[a] + ib*S[b];
+                for(long int x = 0; x < E[d]; x++)
                 {
-                    uniform_real_distribution<double> loc_orientation(0, 180);
-                    int Q1 = loc_orientation(VariantsGenerator);
-                    int Q2 = loc_orientation(VariantsGenerator);
-                    int Q3 = loc_orientation(VariantsGenerator);
-                    EulerAngles locAngles({Q1*Pi/180, Q2*Pi/180, Q3*Pi/180}, XYZ);
-
-                    Phase.FieldsProperties[locIndex].Orientation = locAngles.getQuaternion();
+                    Prefix[x + 1] = Prefix[x] + Line[x*S[d]];
                 }
-                if(randomVariants)
+                for(long int x = 0; x < E[d]; x++)
                 {
-                    uniform_int_distribution<int> loc_variant(0, locSettings.Nvariants[phaseIndex]-1);
-                    Phase.FieldsProperties[locIndex].Variant = loc_variant(VariantsGenerator);
+                    Line[x*S[d]] = (Prefix[min(x + iWidth + 1, E[d])] > Prefix[max(x - iWidth, 0l)]);
                 }
-                planted = true;
             }
         }
     }
+
+    long int Lo[3] = {0, 0, 0};
+    long int Hi[3] = {N[0], N[1], N[2]};
+    if     (onPlane == "Xbottom") {Hi[0] = 1;}
+    else if(onPlane == "Xtop")    {Lo[0] = N[0] - 1;}
+    else if(onPlane == "Ybottom") {Hi[1] = 1;}
+    else if(onPlane == "Ytop")    {Lo[1] = N[1] - 1;}
+    else if(onPlane == "Zbottom") {Hi[2] = 1;}
+    else if(onPlane == "Ztop")    {Lo[2] = N[2] - 1;}
+
+    vector<size_t> Candidates;
+    for(long int i = Lo[0]; i < Hi[0]; i++)
+    for(long int j = Lo[1]; j < Hi[1]; j++)
+    for(long int k = Lo[2]; k < Hi[2]; k++)
+    {
+        size_t idx = (i + B[0])*S[0] + (j + B[1])*S[1] + (k + B[2]);
+        if(!Occupied[idx]) Candidates.push_back(idx);
+    }
+
+    size_t Nplanted = 0;
+    while(Nplanted < Nparticles and !Candidates.empty())
+    {
+        uniform_int_distribution<size_t> Dart(0, Candidates.size() - 1);
+        const size_t c = Dart(PositionsGenerator);
+        const size_t idx = Candidates[c];
+        Candidates[c] = Candidates.back();
+        Candidates.pop_back();
+        if(Occupied[idx]) continue;
+
+        const long int di = idx / S[0] - B[0];
+        const long int dj = (idx % S[0]) / S[1] - B[1];
+        const long int dk = idx % S[1] - B[2];
+
+        for(long int i = max(di - iWidth, -B[0]); i <= min(di + iWidth, N[0] + B[0] - 1); i++)
+        for(long int j = max(dj - iWidth, -B[1]); j <= min(dj + iWidth, N[1] + B[1] - 1); j++)
+        for(long int k = max(dk - iWidth, -B[2]); k <= min(dk + iWidth, N[2] + B[2] - 1); k++)
+        {
+            Occupied[(i + B[0])*S[0] + (j + B[1])*S[1] + (k + B[2])] = 1;
+        }
+
+        int locIndex = Phase.PlantGrainNucleus(phaseIndex, di + Phase.Grid.OffsetX,
+                                                           dj + Phase.Grid.OffsetY,
+                                                           dk + Phase.Grid.OffsetZ);
+        if(randomOrientation)
+        {
+            uniform_real_distribution<double> loc_orientation(0, 180);
+            int Q1 = loc_orientation(VariantsGenerator);
+            int Q2 = loc_orientation(VariantsGenerator);
+            int Q3 = loc_orientation(VariantsGenerator);
+            EulerAngles locAngles({Q1*Pi/180, Q2*Pi/180, Q3*Pi/180}, XYZ);
+
+            Phase.FieldsProperties[locIndex].Orientation = locAngles.getQuaternion();
+        }
+        if(randomVariants)
+        {
+            uniform_int_distribution<int> loc_variant(0, locSettings.Nvariants[phaseIndex]-1);
+            Phase.FieldsProperties[locIndex].Variant = loc_variant(VariantsGenerator);
+        }
+        Nplanted++;
+    }
+    if(Nplanted < Nparticles)
+    {
+        ConsoleOutput::WriteWarning("Only " + to_string(Nplanted) + " of " +
+                                    to_string(Nparticles) + " nuclei planted, "
+                                    "no free cells left", thisclassname, "RandomNuclei");
+    }
 }
 
 /**
@@ -388,6 +440,80 @@ size_t Initializations::Sphere(PhaseField& Phase,
     return locIndex;
 }
 
+std::vector<size_t> Initializations::Spheres(PhaseField& Phase,
+                                             const std::vector<SphereShape>& Shapes,
+                                             const BoundaryConditions& BC,
+                                             const bool Finalize)
+{
+    /* Each sphere only visits the cells of its bounding box on this rank,
+    the phase-field is finalized once for the whole batch */
+    std::vector<size_t> locIndices;
+    locIndices.reserve(Shapes.size());
+    for(const SphereShape& Shape : Shapes)
+    {
+        locIndices.push_back(Sphere(Phase, Shape.PhaseIndex, Shape.Radius,
+                                    Shape.Center[0], Shape.Center[1], Shape.Center[2], BC, false));
+    }
+    if (Finalize) Phase.FinalizeInitialization(BC);
+    return locIndices;
+}
+
+void Initializations::BoxCells(std::vector<long int> (&Cells)[3],
+                               const std::array<long int,3>& Begin,
+                               const std::array<long int,3>& End,
+                               const std::array<long int,3>& Size,
+                               const GridParameters& Dimensions,
+                               const BoundaryConditions& BC)
+{
+#ifdef MPI_PARALLEL
+    const long int Offset[3] = {Dimensions.OffsetX, Dimensions.OffsetY, Dimensions.OffsetZ};
+    const long int Total[3]  = {Dimensions.TotalNx, Dimensions.TotalNy, Dimensions.TotalNz};
+    const bool PeriodicLow[3]  = {BC.MPIperiodicX or BC.BC0X == BoundaryConditionTypes::Periodic,
+                                  BC.MPIperiodicY or BC.BC0Y == BoundaryConditionTypes::Periodic,
+                                  BC.MPIperiodicZ or BC.BC0Z == BoundaryConditionTypes::Periodic};
+    const bool PeriodicHigh[3] = {BC.MPIperiodicX or BC.BCNX == BoundaryConditionTypes::Periodic,
+                                  BC.MPIperiodicY or BC.BCNY == BoundaryConditionTypes::Periodic,
+                                  BC.MPIperiodicZ or BC.BCNZ == BoundaryConditionTypes::Periodic};
+#else
+    const long int Offset[3] = {0, 0, 0};
+    const long int Total[3]  = {Dimensions.Nx, Dimensions.Ny, Dimensions.Nz};
+    const bool PeriodicLow[3]  = {BC.BC0X == BoundaryConditionTypes::Periodic,
+                                  BC.BC0Y == BoundaryConditionTypes::Periodic,
+                                  BC.BC0Z == BoundaryConditionTypes::Periodic};
+    const bool PeriodicHigh[3] = {BC.BCNX == BoundaryConditionTypes::Periodic,
+                                  BC.BCNY == BoundaryConditionTypes::Periodic,
+                                  BC.BCNZ == BoundaryConditionTypes::Periodic};
+#endif
+    for(int d = 0; d < 3; d++)
+    {
+        Cells[d].clear();
+        if(End[d] < Begin[d] or Size[d] <= 0) continue;
+
+        /* A box longer than the domain covers each periodic cell once */
+        long int First = Begin[d];
+        long int Last  = End[d];
+        if(PeriodicLow[d] and PeriodicHigh[d] and Last - First + 1 > Total[d])
+        {
+            First = 0;
+            Last  = Total[d] - 1;
+        }
+
+        std::vector<bool> Visited(Size[d], false);
+        for(long int g = First; g <= Last; g++)
+        {
+            long int x = g;
+            if(PeriodicHigh[d]) while(x >= Total[d]) x -= Total[d];
+            if(PeriodicLow[d])  while(x <  0)        x += Total[d];
+            x -= Offset[d];
+            if(x >= 0 and x < Size[d]) Visited[x] = true;
+        }
+        for(long int x = 0; x < Size[d]; x++)
+        {
+            if(Visited[x]) Cells[d].push_back(x);
+        }
+    }
+}
+
 void Initializations::Young4Periodic(PhaseField& Phase,
                                      size_t PhaseIndex,
                                      BoundaryConditions& BC)
@@ -2011,6 +2137,213 @@ std::vector<size_t> Initializations::ThermalGrooving(PhaseField& Phase,
     return locIndex;
 }
 
+/* Grid cell assignment of VoronoiTessellation(). Growing the grains from
+their seeds over coordination shells of increasing radius, a cell belongs to
+the seed it is reached from first: the closest seed, on equal distance the one
+whose sorted absolute offset (x <= y <= z) comes first lexicographically, then
+the one with the lower index. On periodic axes the minimal image offset is
+used. The seeds are binned into buckets of a uniform grid, the cells of each
+bucket only test the seeds which can be the closest to one of them. Each rank
+assigns its own cells, returns the number of assigned cells. */
+static size_t AssignNearestSeeds(PhaseField& Phase, const vector<iVector3>& Seeds,
+                                 const bool Periodic[3])
+{
+    if(Seeds.empty()) return 0;
+
+    const long int N[3]      = {Phase.Grid.TotalNx, Phase.Grid.TotalNy, Phase.Grid.TotalNz};
+    const long int Offset[3] = {Phase.Grid.OffsetX, Phase.Grid.OffsetY, Phase.Grid.OffsetZ};
+    const long int Local[3]  = {Phase.Grid.Nx, Phase.Grid.Ny, Phase.Grid.Nz};
+
+    /* Bucket edge close to the mean seed spacing */
+    const double CellsPerSeed = double(N[0])*double(N[1])*double(N[2])/Seeds.size();
+    const long int W = max(1l, lround(cbrt(CellsPerSeed)));
+    const long int B[3] = {(N[0] + W - 1)/W, (N[1] + W - 1)/W, (N[2] + W - 1)/W};
+    const long int Rmax = max(max(B[0], B[1]), B[2]);
+
+    auto Bucket = [&B](const long int bx, const long int by, const long int bz)
+    {
+        return size_t((bz*B[1] + by)*B[0] + bx);
+    };
+
+    /* Seed indices sorted by bucket, ascending within each bucket */
+    vector<size_t> BucketStart(B[0]*B[1]*B[2] + 1, 0);
+    vector<size_t> BucketSeeds(Seeds.size());
+    for(size_t n = 0; n < Seeds.size(); n++)
+    {
+        BucketStart[Bucket(Seeds[n][0]/W, Seeds[n][1]/W, Seeds[n][2]/W) + 1]++;
+    }
+    for(size_t b = 1; b < BucketStart.size(); b++)
+    {
+        BucketStart[b] += BucketStart[b-1];
+    }
+    {
+        vector<size_t> Position(BucketStart.begin(), BucketStart.end() - 1);
+        for(size_t n = 0; n < Seeds.size(); n++)
+        {
+            BucketSeeds[Position[Bucket(Seeds[n][0]/W, Seeds[n][1]/W, Seeds[n][2]/W)]++] = n;
+        }
+    }
+
+    auto AxisDistance = [&N, Periodic](const int d, const long int a, const long int b)
+    {
+        const long int r = labs(a - b);
+        return Periodic[d] ? min(r, N[d] - r) : r;
+    };
+    /* Lower bound of the distance between cells in buckets which are delta
+    buckets apart along an axis, allowing for the partial last bucket */
+    auto Gap = [W](const long int delta)
+    {
+        return (delta == 0) ? 0l : max(1l, (delta - 2)*W + 2);
+    };
+
+    long int Bbegin[3];
+    long int Bend[3];
+    for(int d = 0; d < 3; d++)
+    {
+        Bbegin[d] = Offset[d]/W;
+        Bend[d]   = (Local[d] > 0) ? (Offset[d] + Local[d] - 1)/W + 1 : Bbegin[d];
+    }
+
+    size_t Nassigned = 0;
+    #pragma omp parallel for collapse(3) schedule(dynamic) reduction(+:Nassigned)
+    for(long int bz = Bbegin[2]; bz < Bend[2]; bz++)
+    for(long int by = Bbegin[1]; by < Bend[1]; by++)
+    for(long int bx = Bbegin[0]; bx < Bend[0]; bx++)
+    {
+        const long int bc[3] = {bx, by, bz};
+        long int Lo[3];
+        long int Hi[3];
+        for(int d = 0; d < 3; d++)
+        {
+            Lo[d] = max(bc[d]*W, Offset[d]);
+            Hi[d] = min((bc[d] + 1)*W, Offset[d] + Local[d]) - 1;
+        }
+
+        vector<size_t> Candidates;
+        auto Gather = [&](const long int R)
+        {
+            vector<long int> Range[3];
+            for(int d = 0; d < 3; d++)
+            {
+                if(Periodic[d] and 2*R + 1 >= B[d])
+                {
+                    for(long int b = 0; b < B[d]; b++) Range[d].push_back(b);
+                }
+                else for(long int b = bc[d] - R; b <= bc[d] + R; b++)
+                {
+                    if(Periodic[d]) Range[d].push_back((b + B[d]) % B[d]);
+                    else if(b >= 0 and b < B[d]) Range[d].push_back(b);
+                }
+            }
+            Candidates.clear();
+            for(long int z : Range[2])
+            for(long int y : Range[1])
+            for(long int x : Range[0])
+            {
+                const size_t b = Bucket(x, y, z);
+                Candidates.insert(Candidates.end(), BucketSeeds.begin() + BucketStart[b],
+                                                    BucketSeeds.begin() + BucketStart[b+1]);
+            }
+        };
+
+        long int R = 1;
+        Gather(R);
+        while(Candidates.empty() and R < Rmax)
+        {
+            R = min(2*R, Rmax);
+            Gather(R);
+        }
+
+        /* Upper bound of the squared distance from any cell of the bucket to
+        its closest seed, and the bucket radius beyond which no seed can be
+        that close */
+        long int MaxDist2 = numeric_limits<long int>::max();
+        for(size_t n : Candidates)
+        {
+            long int Dist2 = 0;
+            for(int d = 0; d < 3; d++)
+            {
+                long int Dist = max(labs(Lo[d] - Seeds[n][d]), labs(Hi[d] - Seeds[n][d]));
+                if(Periodic[d]) Dist = min(Dist, N[d]/2);
+                Dist2 += Dist*Dist;
+            }
+            MaxDist2 = min(MaxDist2, Dist2);
+        }
+        long int Rneeded = 0;
+        while(Rneeded < Rmax and Gap(Rneeded + 1)*Gap(Rneeded + 1) <= MaxDist2)
+        {
+            Rneeded++;
+        }
+        if(Rneeded > R)
+        {
+            Gather(Rneeded);
+        }
+
+        /* Keeps the seeds which can be the closest to one of the cells,
+        ordered by their distance from the bucket */
+        struct Candidate_t
+        {
+            long int Dist2;
+            long int x;
+            long int y;
+            long int z;
+            size_t n;
+        };
+        vector<Candidate_t> Cand;
+        for(size_t n : Candidates)
+        {
+            long int Dist2 = 0;
+            for(int d = 0; d < 3; d++)
+            {
+                const long int s = Seeds[n][d];
+                const long int Dist = (s >= Lo[d] and s <= Hi[d]) ? 0 :
+                                      min(AxisDistance(d, s, Lo[d]), AxisDistance(d, s, Hi[d]));
+                Dist2 += Dist*Dist;
+            }
+            if(Dist2 <= MaxDist2)
+            {
+                Cand.push_back({Dist2, Seeds[n][0], Seeds[n][1], Seeds[n][2], n});
+            }
+        }
+        sort(Cand.begin(), Cand.end(), [](const Candidate_t& a, const Candidate_t& b)
+        {
+            return a.Dist2 < b.Dist2 or (a.Dist2 == b.Dist2 and a.n < b.n);
+        });
+
+        for(long int k = Lo[2]; k <= Hi[2]; k++)
+        for(long int j = Lo[1]; j <= Hi[1]; j++)
+        for(long int i = Lo[0]; i <= Hi[0]; i++)
+        {
+            bool found = false;
+            long int BestKey[5] = {0, 0, 0, 0, 0};
+            for(const Candidate_t& C : Cand)
+            {
+                if(found and C.Dist2 > BestKey[0]) break;
+                long int a0 = AxisDistance(0, i, C.x);
+                long int a1 = AxisDistance(1, j, C.y);
+                long int a2 = AxisDistance(2, k, C.z);
+                const long int Dist2 = a0*a0 + a1*a1 + a2*a2;
+                if(found and Dist2 > BestKey[0]) continue;
+                if(a0 > a1) swap(a0, a1);
+                if(a1 > a2) swap(a1, a2);
+                if(a0 > a1) swap(a0, a1);
+                const long int Key[5] = {Dist2, a0, a1, a2, long(C.n)};
+                if(not found or lexicographical_compare(Key, Key + 5, BestKey, BestKey + 5))
+                {
+                    found = true;
+                    copy(Key, Key + 5, BestKey);
+                }
+            }
+            if(found)
+            {
+                Phase.Fields(i - Offset[0], j - Offset[1], k - Offset[2]).set_value(BestKey[4], 1.0);
+                Nassigned++;
+            }
+        }
+    }
+    return Nassigned;
+}
+
 void Initializations::VoronoiTessellation(PhaseField& Phase,
                                          BoundaryConditions& BC,
                                          const size_t Ngrains,
@@ -2056,74 +2389,38 @@ void Initializations::VoronoiTessellation(PhaseField& Phase,
     }
     ConsoleOutput::WriteSimple("Done!");
 
-    ConsoleOutput::WriteSimple("Creating coordination shells...");
-
-    size_t NpointsTotal = TotalNx*TotalNy*TotalNz;
-    size_t NpointsRun = 0;
+    ConsoleOutput::WriteSimple("Assigning grid cells to the nearest seeds...");
 
-    vector<iVector3> CoordinationShells;
+    bool Periodic[3];
+#ifdef MPI_PARALLEL
+    Periodic[0] = (BC.BC0X == BoundaryConditionTypes::Periodic or BC.MPIperiodicX);
+    Periodic[1] = (BC.BC0Y == BoundaryConditionTypes::Periodic or BC.MPIperiodicY);
+    Periodic[2] = (BC.BC0Z == BoundaryConditionTypes::Periodic or BC.MPIperiodicZ);
+#else
+    Periodic[0] = (BC.BC0X == BoundaryConditionTypes::Periodic);
+    Periodic[1] = (BC.BC0Y == BoundaryConditionTypes::Periodic);
+    Periodic[2] = (BC.BC0Z == BoundaryConditionTypes::Periodic);
+#endif
 
-    int MAXsize = std::max(std::max(Phase.Grid.TotalNx, Phase.Grid.TotalNy), Phase.Grid.TotalNz);
-    for(int x = 0; x < MAXsize; x++)
-    for(int y = x; y < MAXsize; y++)
-    for(int z = y; z < MAXsize; z++)
+    vector<iVector3> Seeds(Phase.FieldsProperties.size());
+    for (size_t n = 0; n < Phase.FieldsProperties.size(); ++n)
     {
-        CoordinationShells.push_back(iVector3({x,y,z}));
+        Seeds[n] = iVector3({int(Phase.FieldsProperties[n].Rcm[0]),
+                             int(Phase.FieldsProperties[n].Rcm[1]),
+                             int(Phase.FieldsProperties[n].Rcm[2])});
     }
-    std::sort(CoordinationShells.begin(),CoordinationShells.end());
-
-    ConsoleOutput::WriteSimple("Done!");
-
-    ConsoleOutput::StartProgressIndicator("Creating Voronoi grain structure");
-    int position = 0;
 
-    for(size_t s = 0; s < CoordinationShells.size(); s++)
-    {
-        vector <iVector3> locShell = Tools::findIndexPermutations(CoordinationShells[s]);
-
-        for (size_t n = 0; n < Phase.FieldsProperties.size(); ++n)
-        {
-            int Rx = Phase.FieldsProperties[n].Rcm[0];
-            int Ry = Phase.FieldsProperties[n].Rcm[1];
-            int Rz = Phase.FieldsProperties[n].Rcm[2];
-
-            for(size_t m = 0; m < locShell.size(); m++)
-            {
-                int x = Rx + locShell[m][0];
-                int y = Ry + locShell[m][1];
-                int z = Rz + locShell[m][2];
+    size_t NpointsTotal = size_t(TotalNx)*TotalNy*TotalNz;
+    size_t NpointsRun = AssignNearestSeeds(Phase, Seeds, Periodic);
 #ifdef MPI_PARALLEL
-                if(BC.BC0X == BoundaryConditionTypes::Periodic or BC.MPIperiodicX) x = (x + TotalNx) % TotalNx;
-                if(BC.BC0Y == BoundaryConditionTypes::Periodic or BC.MPIperiodicY) y = (y + TotalNy) % TotalNy;
-                if(BC.BC0Z == BoundaryConditionTypes::Periodic or BC.MPIperiodicZ) z = (z + TotalNz) % TotalNz;
-
-                x -= Phase.Grid.OffsetX;
-                y -= Phase.Grid.OffsetY;
-                z -= Phase.Grid.OffsetZ;
-#else
-                if(BC.BC0X == BoundaryConditionTypes::Periodic) x = (x + Nx) % Nx;
-                if(BC.BC0Y == BoundaryConditionTypes::Periodic) y = (y + Ny) % Ny;
-                if(BC.BC0Z == BoundaryConditionTypes::Periodic) z = (z + Nz) % Nz;
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &NpointsRun, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_SUM, OP_MPI_COMM_WORLD);
 #endif
-                if(x >= 0 and x < Nx and
-                   y >= 0 and y < Ny and
-                   z >= 0 and z < Nz and
-                   Phase.Fields(x,y,z).size() == 0)
-                {
-                    Phase.Fields(x,y,z).set_value(n, 1.0);
-                    NpointsRun ++;
-                }
-            }
-#ifdef MPI_PARALLEL
-            OP_MPI_Allreduce(OP_MPI_IN_PLACE, &NpointsRun, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-#endif
-            ConsoleOutput::AdvanceProgressIndicator(0,NpointsTotal,NpointsRun, position);
-
-            if(NpointsRun == NpointsTotal) break;
-        }
-        if(NpointsRun == NpointsTotal) break;
+    if(NpointsRun != NpointsTotal)
+    {
+        ConsoleOutput::WriteWarning(to_string(NpointsTotal - NpointsRun) + " grid cells are not assigned to a grain",
+                                    thisclassname, "VoronoiTessellation()");
     }
-    ConsoleOutput::EndProgressIndicator();
+    ConsoleOutput::WriteSimple("Done!");
 
     Phase.SetBoundaryConditions(BC);
 
@@ -2193,100 +2490,183 @@ void Initializations::VoronoiTessellation(PhaseField& Phase,
     ConsoleOutput::WriteSimple("Done!");
 }
 
-void Initializations::ReadCSV(PhaseField& Phase, BoundaryConditions& BC, std::filesystem::path FilePath, char Separator)
+void Initializations::ReadCSV(PhaseField& Phase, BoundaryConditions& BC, std::filesystem::path FilePath, char Separator, bool BinaryCache)
 {
     ConsoleOutput::WriteLineInsert("Reading CSV file");
     ConsoleOutput::WriteStandard("Filename", FilePath.string());
 
-    // Open file
-    std::ifstream file(FilePath);
-    if (!file.is_open())
-    {
-        ConsoleOutput::WriteExit("Could not open file", FilePath.string(), "ReadCSV");
-        OP_Exit(EXIT_FAILURE);
+    const GridParameters& Grid = Phase.Grid;
+    const int Nthreads = omp_get_max_threads();
+
+    /* The binary cache holds the rows of the CSV file as 64 bit integers in
+    native byte order after a 16 byte header (magic string and number of
+    rows). It is used if it is not older than the CSV file. */
+    std::filesystem::path CachePath = FilePath;
+    CachePath += ".bin";
+    const char CacheMagic[8] = {'O','P','C','S','V','5','\0','\0'};
+    const size_t CacheHeader = 16;
+
+    bool RootRank = true;
+#ifdef MPI_PARALLEL
+    RootRank = (MPI_RANK == 0);
+#endif
+    int UseCache = 0;
+    if (BinaryCache and RootRank)
+    {
+        std::error_code CacheError;
+        std::error_code FileError;
+        auto CacheTime = std::filesystem::last_write_time(CachePath, CacheError);
+        auto FileTime  = std::filesystem::last_write_time(FilePath, FileError);
+        UseCache = (!CacheError and (FileError or CacheTime >= FileTime));
     }
+#ifdef MPI_PARALLEL
+    OP_MPI_Bcast(&UseCache, 1, OP_MPI_INT, 0, OP_MPI_COMM_WORLD);
+#endif
+    bool WriteCache = BinaryCache and !UseCache and RootRank;
 
-    // Read data
-    std::set<size_t> PhaseIndices;
-    std::vector<std::vector<long int>> data;
+    /* Rows of the local subdomain and the first row of each grain in the
+    file are collected per thread. Rows reach each thread in file order. */
+    std::vector<std::vector<std::array<long int,5>>> LocalRows(Nthreads);
+    std::vector<std::unordered_map<long int, std::pair<size_t, long int>>> FirstRows(Nthreads);
+    std::vector<size_t> InvalidRow(Nthreads, std::numeric_limits<size_t>::max());
+    std::vector<std::ofstream> CacheParts(Nthreads);
+    std::vector<size_t> CacheNextRow(Nthreads, std::numeric_limits<size_t>::max());
+
+    auto Process = [&](const long int* row, const size_t rowNumber, const int thread)
     {
-        std::string line;
-        while (std::getline(file, line))
+        if (row[3] < 0 or row[4] < 0)
         {
-            std::vector<long int> row;
-            std::istringstream lineStream(line);
-            std::string cell;
-
-            while (std::getline(lineStream, cell, Separator))
+            InvalidRow[thread] = std::min(InvalidRow[thread], rowNumber);
+            return;
+        }
+        FirstRows[thread].emplace(row[4], std::make_pair(rowNumber, row[3]));
+        if (Grid.PositionInLocalBounds(row[0], row[1], row[2]))
+        {
+            LocalRows[thread].push_back({row[0], row[1], row[2], row[3], row[4]});
+        }
+        if (WriteCache)
+        {
+            std::ofstream& Part = CacheParts[thread];
+            if (!Part.is_open())
             {
-                try
-                {
-                    long int value = std::stol(cell);
-                    row.push_back(value);
-                }
-                catch (std::invalid_argument& e)
-                {
-                    ConsoleOutput::WriteExit("Invalid argument: "+cell, thisclassname, "ReadCSV");
-                    OP_Exit(EXIT_FAILURE);
-                }
-                catch (std::out_of_range& e)
-                {
-                    ConsoleOutput::WriteExit("Out of range: "+cell, thisclassname, "ReadCSV");
-                    OP_Exit(EXIT_FAILURE);
-                }
+                Part.open(CachePath, std::ios::in | std::ios::out | std::ios::binary);
             }
-            if (row.size() != 5u)
+            if (CacheNextRow[thread] != rowNumber)
             {
-                ConsoleOutput::WriteExit("Wrong data format. Expected 4 columns i,j,k,phaseIdx,grainIdx", thisclassname, "ReadCSV");
-                OP_Exit(EXIT_FAILURE);
+                Part.seekp(CacheHeader + rowNumber*5*sizeof(int64_t));
             }
-            long int phaseIdx = row[3];
-            if (phaseIdx < 0)
+            int64_t Values[5] = {row[0], row[1], row[2], row[3], row[4]};
+            Part.write(reinterpret_cast<const char*>(Values), sizeof(Values));
+            CacheNextRow[thread] = rowNumber + 1;
+        }
+    };
+
+    size_t Nrows = 0;
+    bool CacheRead = false;
+    if (UseCache)
+    {
+        MappedFile Cache;
+        uint64_t CacheRows = 0;
+        if (Cache.Open(CachePath.string()) and Cache.size() >= CacheHeader and
+            std::equal(CacheMagic, CacheMagic + 8, Cache.data()))
+        {
+            memcpy(&CacheRows, Cache.data() + 8, sizeof(CacheRows));
+        }
+        if (CacheRows > 0 and Cache.size() == CacheHeader + CacheRows*5*sizeof(int64_t))
+        {
+            ConsoleOutput::WriteStandard("Binary cache", CachePath.string());
+            const char* Data = Cache.data() + CacheHeader;
+            #pragma omp parallel for schedule(static)
+            for (size_t r = 0; r < CacheRows; r++)
             {
-                ConsoleOutput::WriteExit("Phase index must be positive", thisclassname, "ReadCSV");
+                int64_t Values[5];
+                memcpy(Values, Data + r*sizeof(Values), sizeof(Values));
+                const long int row[5] = {long(Values[0]), long(Values[1]), long(Values[2]),
+                                         long(Values[3]), long(Values[4])};
+                Process(row, r, omp_get_thread_num());
+            }
+            Nrows = CacheRows;
+            CacheRead = true;
+        }
+        else
+        {
+            ConsoleOutput::WriteWarning("Binary cache \"" + CachePath.string() + "\" is invalid, reading the CSV file", thisclassname, "ReadCSV");
+            WriteCache = BinaryCache and RootRank;
+        }
+    }
+    if (!CacheRead)
+    {
+        if (WriteCache)
+        {
+            std::ofstream Cache(CachePath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!Cache)
+            {
+                ConsoleOutput::WriteExit("Could not create binary cache", CachePath.string(), "ReadCSV");
                 OP_Exit(EXIT_FAILURE);
             }
-            if (row[4] < 0)
+        }
+        Nrows = CSVParser::ReadIntegerRows(FilePath.string(), 5, Separator, Process);
+        if (WriteCache)
+        {
+            CacheParts.clear();
+            std::fstream Cache(CachePath, std::ios::in | std::ios::out | std::ios::binary);
+            const uint64_t CacheRows = Nrows;
+            Cache.write(CacheMagic, 8);
+            Cache.write(reinterpret_cast<const char*>(&CacheRows), sizeof(CacheRows));
+            if (!Cache)
             {
-                ConsoleOutput::WriteExit("Grain index must be positive", thisclassname, "ReadCSV");
+                ConsoleOutput::WriteExit("Could not write binary cache", CachePath.string(), "ReadCSV");
                 OP_Exit(EXIT_FAILURE);
             }
-            PhaseIndices.insert(phaseIdx);
-            data.push_back(row);
+            ConsoleOutput::WriteStandard("Binary cache written", CachePath.string());
         }
-        file.close();
     }
-    if (data.size() != (size_t) Phase.Grid.TotalNumberOfCells())
+
+    const size_t FirstInvalidRow = *std::min_element(InvalidRow.begin(), InvalidRow.end());
+    if (FirstInvalidRow < Nrows)
+    {
+        ConsoleOutput::WriteExit("Phase and grain indices must be positive, line " + std::to_string(FirstInvalidRow + 1), thisclassname, "ReadCSV");
+        OP_Exit(EXIT_FAILURE);
+    }
+    if (Nrows != (size_t) Phase.Grid.TotalNumberOfCells())
     {
         std::stringstream message;
-        message << "Wrong number of rows, " << data.size() << ", expected: Nx*Ny*Nz = " << Phase.Grid.TotalNumberOfCells();
+        message << "Wrong number of rows, " << Nrows << ", expected: Nx*Ny*Nz = " << Phase.Grid.TotalNumberOfCells();
         ConsoleOutput::WriteExit(message.str(), thisclassname, "ReadCSV");
         OP_Exit(EXIT_FAILURE);
     }
 
+    /* Grains are created in the order of their first appearance in the file,
+    which gives the same grain indices on all ranks */
+    std::unordered_map<long int, std::pair<size_t, long int>> Grains;
+    for (auto& ThreadGrains : FirstRows)
+    for (auto& Grain : ThreadGrains)
+    {
+        auto Entry = Grains.emplace(Grain.first, Grain.second);
+        if (!Entry.second and Grain.second.first < Entry.first->second.first)
+        {
+            Entry.first->second = Grain.second;
+        }
+    }
+    std::vector<std::pair<size_t, long int>> GrainOrder;
+    GrainOrder.reserve(Grains.size());
+    for (auto& Grain : Grains) GrainOrder.emplace_back(Grain.second.first, Grain.first);
+    std::sort(GrainOrder.begin(), GrainOrder.end());
+
+    std::unordered_map<long int, size_t> grainIdxMap;
+    for (auto& Grain : GrainOrder)
+    {
+        grainIdxMap[Grain.second] = Phase.AddGrainInfo(Grains[Grain.second].second);
+    }
+
     // Set phase-field values
-    std::map<size_t, size_t> grainIdxMap;
-    for (auto& line : data) 
+    for (auto& ThreadRows : LocalRows)
+    for (auto& line : ThreadRows)
     {
         long int i = line[0] - Phase.Grid.OffsetX;
         long int j = line[1] - Phase.Grid.OffsetY;
         long int k = line[2] - Phase.Grid.OffsetZ;
-        if (i < 0 or i >= Phase.Grid.Nx) continue;
-        if (j < 0 or j >= Phase.Grid.Ny) continue;
-        if (k < 0 or k >= Phase.Grid.Nz) continue;
-        size_t phaseIdx = line[3];
-        size_t grainIdxFile = line[4];
-        size_t grainIdx = 0;
-        if (grainIdxMap.find(grainIdxFile) == grainIdxMap.end())
-        {
-            grainIdxMap[grainIdxFile] = Phase.AddGrainInfo(phaseIdx);
-            grainIdx = grainIdxMap[grainIdxFile];
-        }
-        else
-        {
-            grainIdx = grainIdxMap[grainIdxFile];
-        }
-        Phase.Fields(i,j,k).set_value(grainIdx, 1.0);
+        Phase.Fields(i,j,k).set_value(grainIdxMap[line[4]], 1.0);
     }
     Phase.FinalizeInitialization(BC);
     Phase.SetBoundaryConditions(BC);
@@ -0,0 +1,211 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "InterfaceAveraging.h"
+#include "GrainsProperties.h"
+
+namespace openphase
+{
+using namespace std;
+
+void InterfaceAveraging::Initialize(const GridParameters& Grid, const int locRange)
+{
+    /* Offsets inside the averaging sphere with their distance weights, the
+    averaging loops skip the corners of the bounding box and the square root
+    evaluation per neighbour */
+    Range  = locRange;
+    Xrange = min(Range, Grid.Nx-1)*Grid.dNx;
+    Yrange = min(Range, Grid.Ny-1)*Grid.dNy;
+    Zrange = min(Range, Grid.Nz-1)*Grid.dNz;
+
+    Stencil.clear();
+    for(int ii = -Xrange; ii <= Xrange; ii++)
+    for(int jj = -Yrange; jj <= Yrange; jj++)
+    for(int kk = -Zrange; kk <= Zrange; kk++)
+    {
+        double weight_dist = Range - sqrt(ii*ii + jj*jj + kk*kk);
+        if(weight_dist > 0.0)
+        {
+            Stencil.push_back({ii, jj, kk, weight_dist});
+        }
+    }
+}
+
+void InterfaceAveraging::SetWeights(Storage3D<NodeDF, 0>& Values,
+                                    const Storage3D<NodePF, 0>& Fields,
+                                    const vector<iVector3>& Cells) const
+{
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Cells,)
+    {
+        if (Fields(i,j,k).interface())
+        for(auto it  = Values(i,j,k).begin();
+                 it != Values(i,j,k).end(); ++it)
+        {
+            double PhiAlpha = Fields(i,j,k).get_value(it->indexA);
+            double PhiBeta  = Fields(i,j,k).get_value(it->indexB);
+
+            it->weight = sqrt(PhiAlpha*PhiBeta);
+        }
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+}
+
+/* Weight of a neighbour value */
+static inline double NeighbourWeight(const AveragingWeightsModes Mode,
+                                     const double weight_dist,
+                                     const double weight_phi)
+{
+    switch(Mode)
+    {
+        case AveragingWeightsModes::Range:            return weight_dist;
+        case AveragingWeightsModes::PhaseFields:      return weight_phi;
+        case AveragingWeightsModes::Counter:          return 1.0;
+        case AveragingWeightsModes::RangePhaseFields: return weight_phi*weight_dist;
+    }
+    return 0.0;
+}
+
+static inline double Threshold(const AveragingRules& Rules,
+                               const GrainsProperties& Grains,
+                               const size_t indexA, const size_t indexB)
+{
+    const double weight_threshold = sqrt(Rules.PhiThreshold*(1.0 - Rules.PhiThreshold));
+    if(Rules.ScaleThreshold)
+    {
+        return weight_threshold*Grains[indexA].VolumeRatio*Grains[indexB].VolumeRatio;
+    }
+    return weight_threshold;
+}
+
+void InterfaceAveraging::Collect(Storage3D<NodeDF, 0>& Values,
+                                 const Storage3D<NodePF, 0>& Fields,
+                                 const vector<iVector3>& Cells,
+                                 const GrainsProperties& Grains,
+                                 const AveragingRules& Rules) const
+{
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Cells,)
+    {
+        if (Fields(i,j,k).interface() and Reachable(Values,i,j,k))
+        for(auto it  = Values(i,j,k).begin();
+                 it != Values(i,j,k).end(); ++it)
+        {
+            if (it->weight > Threshold(Rules, Grains, it->indexA, it->indexB))
+            {
+                double value       = 0.0;
+                double sum_weights = 0.0;
+
+                for(const Offset& offset : Stencil)
+                {
+                    const NodeDF& locValues = Values(i+offset.di, j+offset.dj, k+offset.dk);
+                    if(locValues.size() == 0) continue;
+                    if(Rules.InterfaceNeighbours and
+                       not Fields(i+offset.di, j+offset.dj, k+offset.dk).interface()) continue;
+
+                    double weight_phi = locValues.get_weight(it->indexA, it->indexB);
+                    if(weight_phi > 0.0)
+                    {
+                        double weight = NeighbourWeight(Rules.CollectWeights, offset.weight, weight_phi);
+                        if(weight > Rules.MinWeight)
+                        {
+                            sum_weights += weight;
+                            value += weight*locValues.get_raw(it->indexA, it->indexB);
+                        }
+                    }
+                }
+                if(sum_weights > Rules.MinWeight)
+                {
+                    it->tmp = value/sum_weights;
+                }
+                else if(Rules.EmptyCollectRaw)
+                {
+                    it->tmp = it->raw;
+                }
+            }
+            else if(Rules.SeedsCollectRaw and
+                    (Grains[it->indexA].Stage == GrainStages::Seed or
+                     Grains[it->indexB].Stage == GrainStages::Seed))
+            {
+                it->tmp = it->raw;
+            }
+        }
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+}
+
+void InterfaceAveraging::Distribute(Storage3D<NodeDF, 0>& Values,
+                                    const Storage3D<NodePF, 0>& Fields,
+                                    const vector<iVector3>& Cells,
+                                    const GrainsProperties& Grains,
+                                    const AveragingRules& Rules) const
+{
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Cells,)
+    {
+        if (Fields(i,j,k).interface() and Reachable(Values,i,j,k))
+        for(auto it  = Values(i,j,k).begin();
+                 it != Values(i,j,k).end(); ++it)
+        {
+            if (it->weight > Rules.MinWeight)
+            {
+                double value       = 0.0;
+                double sum_weights = 0.0;
+
+                const double threshold = Threshold(Rules, Grains, it->indexA, it->indexB);
+
+                for(const Offset& offset : Stencil)
+                {
+                    const NodeDF& locValues = Values(i+offset.di, j+offset.dj, k+offset.dk);
+                    if(locValues.size() == 0) continue;
+                    if(Rules.InterfaceNeighbours and
+                       not Fields(i+offset.di, j+offset.dj, k+offset.dk).interface()) continue;
+
+                    double weight_phi = locValues.get_weight(it->indexA, it->indexB);
+                    if(weight_phi > threshold)
+                    {
+                        double weight = NeighbourWeight(Rules.DistributeWeights, offset.weight, weight_phi);
+                        sum_weights += weight;
+                        value += weight*locValues.get_tmp(it->indexA, it->indexB);
+                    }
+                }
+                if(sum_weights > 0.0)
+                {
+                    it->average = value/sum_weights;
+                }
+                else
+                {
+                    it->average = it->tmp;
+                }
+            }
+            else if(Grains[it->indexA].Stage == GrainStages::Seed or
+                    Grains[it->indexB].Stage == GrainStages::Seed)
+            {
+                it->average = it->raw;
+            }
+        }
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+}
+
+} // namespace openphase
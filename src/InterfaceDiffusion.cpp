@@ -81,7 +81,7 @@ void InterfaceDiffusion::ReadInput(const std::string InputFileName)
     ConsoleOutput::WriteLineInsert("InterfaceDiffusion input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -92,7 +92,6 @@ void InterfaceDiffusion::ReadInput(const std::string InputFileName)
     std::stringstream data;
     data << inp.rdbuf();
     ReadInput(data);
-    inp.close();
 }
 
 void InterfaceDiffusion::ReadInput(std::stringstream& inp)
@@ -141,6 +140,7 @@ void InterfaceDiffusion::CalculatePhaseFieldIncrements(PhaseField& Phase,
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields, 3,)
         Phase.Fields(i,j,k).flag = 2;
     OMP_PARALLEL_STORAGE_LOOP_END
+    Phase.SetInterfaceCells();
 
     CalculateDiffusionPotential          (Phase, IP);
     CalculateDiffusionPotentialLaplacian (Phase);
@@ -149,24 +149,29 @@ void InterfaceDiffusion::CalculatePhaseFieldIncrements(PhaseField& Phase,
 void InterfaceDiffusion::CalculateDiffusionPotentialLaplacian(
         PhaseField& Phase)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DiffusionPotential, 0,)
+    /* The stencil sum of each pair is collected in a small local node, the
+    coefficient is applied and the increment merged once per pair */
+    NodeAB<double,double> Sum;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,DiffusionPotential, 0, private(Sum))
     {
+        Sum.clear();
         for (auto ls = LStencil.begin(); ls != LStencil.end(); ls++)
         {
-            const int ii = ls->di;
-            const int jj = ls->dj;
-            const int kk = ls->dk;
+            const NodeAB<double,double>& locPotential = DiffusionPotential(i+ls->di,j+ls->dj,k+ls->dk);
 
-            for (auto it  = DiffusionPotential(i+ii,j+jj,k+kk).cbegin();
-                      it != DiffusionPotential(i+ii,j+jj,k+kk).cend(); ++it)
+            for (auto it  = locPotential.cbegin();
+                      it != locPotential.cend(); ++it)
             {
-                const int pIndexA = Phase.FieldsProperties[it->indexA].Phase;
-                const int pIndexB = Phase.FieldsProperties[it->indexB].Phase;
-
-                double value = - Coefficients(pIndexA,pIndexB)*ls->weight*it->value1;
-                Phase.FieldsDot(i,j,k).add_asym1(it->indexA, it->indexB, value);
+                Sum.add_asym1(it->indexA, it->indexB, ls->weight*it->value1);
             }
         }
+        for (auto it = Sum.cbegin(); it != Sum.cend(); ++it)
+        {
+            const int pIndexA = Phase.FieldsProperties[it->indexA].Phase;
+            const int pIndexB = Phase.FieldsProperties[it->indexB].Phase;
+
+            Phase.FieldsDot(i,j,k).add_asym1(it->indexA, it->indexB, - Coefficients(pIndexA,pIndexB)*it->value1);
+        }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
@@ -239,42 +244,42 @@ void InterfaceDiffusion::CalculateDiffusionPotential(PhaseField& Phase,
 {
     const double Prefactor2 = Pi*Pi/(Phase.Grid.Eta*Phase.Grid.Eta);
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields, 2,)
+    /* The potential of the pair alpha-beta reads
+        (sigma_ab*(L_ba - L_ab) + sum_g!=a,b (sigma_bg*L_bg - sigma_ag*L_ag))/N
+    with L_xg = laplacian_g + Prefactor2*dV(phi_x, phi_g). The pair terms are
+    the missing gamma terms of both sums, hence it equals (S_b - S_a)/N with
+    S_x = sum_g!=x sigma_xg*L_xg, which costs O(N^2) per cell instead of
+    O(N^3) energy lookups and potential derivatives */
+    vector<double> Sums;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields, 2, private(Sums))
     {
-        double norm_1 = 1.0/double(Phase.Fields(i,j,k).size());
-
         const NodePF& locPF = Phase.Fields(i,j,k);
-
-        for(auto alpha = locPF.cbegin();
-                 alpha < locPF.cend(); ++alpha)
-        for(auto  beta = alpha + 1;
-                  beta < locPF.cend(); ++beta)
+        if(locPF.size() > 1)
         {
-            double dDiffusionPotential_dt =
-                IP.Properties(i,j,k).get_energy(alpha->index, beta->index) *
-                ((alpha->laplacian + Prefactor2 *
-                  PotentialDerivative(beta->value,  alpha->value)) -
-                 (beta->laplacian + Prefactor2 *
-                  PotentialDerivative(alpha->value, beta->value)));
-
-            if(locPF.size() > 2)
-            for(auto gamma = locPF.cbegin();
-                     gamma < locPF.cend(); ++gamma)
-            if((gamma != alpha) && (gamma != beta))
+            const double norm_1 = 1.0/double(locPF.size());
+
+            Sums.assign(locPF.size(), 0.0);
+            for(auto alpha = locPF.cbegin(); alpha < locPF.cend(); ++alpha)
+            for(auto gamma = locPF.cbegin(); gamma < locPF.cend(); ++gamma)
+            if(gamma != alpha)
             {
-                dDiffusionPotential_dt +=
-                     IP.Properties(i,j,k).get_energy( beta->index, gamma->index) *
-                    (gamma->laplacian + Prefactor2 *
-                     PotentialDerivative(beta->value,  gamma->value)) -
-                     IP.Properties(i,j,k).get_energy(alpha->index, gamma->index) *
+                Sums[alpha - locPF.cbegin()] +=
+                    IP.Properties(i,j,k).get_energy(alpha->index, gamma->index) *
                     (gamma->laplacian + Prefactor2 *
                      PotentialDerivative(alpha->value, gamma->value));
             }
 
-            dDiffusionPotential_dt *= norm_1;
+            for(auto alpha = locPF.cbegin();
+                     alpha < locPF.cend(); ++alpha)
+            for(auto  beta = alpha + 1;
+                      beta < locPF.cend(); ++beta)
+            {
+                double dDiffusionPotential_dt = norm_1 *
+                    (Sums[beta - locPF.cbegin()] - Sums[alpha - locPF.cbegin()]);
 
-            DiffusionPotential(i,j,k).add_asym1(alpha->index, beta->index,
-                    dDiffusionPotential_dt);
+                DiffusionPotential(i,j,k).add_asym1(alpha->index, beta->index,
+                        dDiffusionPotential_dt);
+            }
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
@@ -330,6 +335,7 @@ void InterfaceDiffusionAnisotropic::CalculatePhaseFieldIncrements(PhaseField& Ph
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields, 3,)
         Phase.Fields(i,j,k).flag = 2;
     OMP_PARALLEL_STORAGE_LOOP_END
+    Phase.SetInterfaceCells();
 
     // This method solves the anisotropic diffusion-equation
     // PhiDot = Nabla ( Diffusion-Tensor * Nabla( Diffusion-potential))
@@ -473,4 +479,16 @@ void InterfaceDiffusionAnisotropic::CalculateDiffusionPotentialGradients()
         DiffusionPotential(i,j,k).clear();
     OMP_PARALLEL_STORAGE_LOOP_END
 }
+
+size_t InterfaceDiffusion::AllocatedMemory(void) const
+{
+    return DiffusionPotential.AllocatedMemory();
+}
+
+size_t InterfaceDiffusionAnisotropic::AllocatedMemory(void) const
+{
+    return InterfaceDiffusion::AllocatedMemory() +
+           DiffusionFlux.AllocatedMemory();
+}
+
 }
@@ -31,6 +31,9 @@
 #include "Temperature.h"
 #include "ElasticProperties.h"
 #include "VTK.h"
+#include "LoadBalancer.h"
+#include "Tools/ReductionBatch.h"
+#include "Tools/CSVParser.h"
 
 namespace openphase
 {
@@ -40,7 +43,7 @@ dVector3 InterfaceOrientation(const PhaseField& Phase, NodePF::citerator it)
 {
     dVector3 normal = it->gradient*(-1.0);
     normal.normalize();
-    normal = Phase.FieldsProperties[it->index].Orientation.RotationMatrix.transposed()*normal;
+    normal = Phase.FieldsProperties[it->index].RotationMatrixTransposed()*normal;
     return normal;
 }
 
@@ -70,6 +73,8 @@ void InterfaceProperties::Initialize(Settings& locSettings, std::string ObjectNa
     }
 
     FullAnisotropy = false;
+    IncrementalSet = false;
+    IncrementalSetTolerance = 1.0;
 
     size_t Bcells = Grid.Bcells;
     Properties.Allocate(Grid, Bcells);
@@ -87,6 +92,7 @@ void InterfaceProperties::Initialize(Settings& locSettings, std::string ObjectNa
     //PhaseInteractions = locSettings.PhaseInteractions;
 
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
 }
@@ -98,7 +104,7 @@ void InterfaceProperties::ReadInput(const string InputFileName)
     std::string filetype = FileInterface::getFileExtension(InputFileName);
     if (filetype == "opi")
     {
-        fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+        stringstream inp = FileInterface::OpenInput(InputFileName);
 
         if (!inp)
         {
@@ -109,8 +115,6 @@ void InterfaceProperties::ReadInput(const string InputFileName)
         std::stringstream data;
         data << inp.rdbuf();
         ReadInput(data);
-
-        inp.close();
     }
     else
     if (filetype == "json")
@@ -236,6 +240,18 @@ void InterfaceProperties::ReadInput(stringstream& inp)
 
         RespectParentBoundaries(alpha, beta) = FileInterface::ReadParameterB(inp, moduleLocation, string("RPB") + counter, false, false);
 
+        double locTableTolerance = FileInterface::ReadParameterD(inp, moduleLocation, string("EnergyTable") + counter, false, 0.0);
+        if(locTableTolerance > 0.0)
+        {
+            TabulateInterfaceEnergy(alpha, beta, locTableTolerance);
+        }
+
+        string locMobilityTable = FileInterface::ReadParameterF(inp, moduleLocation, string("MobilityTable") + counter, false, "NONE");
+        if(locMobilityTable != "NONE")
+        {
+            ReadMobilityTable(alpha, beta, locMobilityTable);
+        }
+
         if(alpha != beta)
         {
             InterfaceEnergy(beta,alpha) = InterfaceEnergy(alpha,beta);
@@ -324,13 +340,24 @@ void InterfaceProperties::ReadInput(stringstream& inp)
     }
     MaxExtrapolationInterations = FileInterface::ReadParameterI(inp, moduleLocation, std::string("MaxExtrapolationInterations"), false, 6);
 
+    IncrementalSet = FileInterface::ReadParameterB(inp, moduleLocation, std::string("IncrementalSet"), false, false);
+    if(IncrementalSet)
+    {
+        double locTolerance = FileInterface::ReadParameterD(inp, moduleLocation, std::string("IncrementalSetTolerance"), false, 1.0);
+        IncrementalSetTolerance = cos(locTolerance*Pi/180.0);
+        if(Grid.Resolution == Resolutions::Single)
+        {
+            PropertiesNormals.Allocate(Grid, Grid.Bcells);
+        }
+    }
+
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteBlankLine();
 }
 
 void InterfaceProperties::ReadJSON(const string InputFileName)
 {
-    std::ifstream f(InputFileName);
+    std::stringstream f = FileInterface::OpenInput(InputFileName);
     json data = json::parse(f);
     if (data.contains(thisclassname))
     {
@@ -399,6 +426,18 @@ void InterfaceProperties::ReadJSON(const string InputFileName)
 
             RespectParentBoundaries(alpha, beta) = FileInterface::ReadParameter<bool>(interfaceproperties, {"RPB", alpha, beta}, false);
 
+            double locTableTolerance = FileInterface::ReadParameter<double>(interfaceproperties, {"EnergyTable", alpha, beta}, 0.0);
+            if(locTableTolerance > 0.0)
+            {
+                TabulateInterfaceEnergy(alpha, beta, locTableTolerance);
+            }
+
+            std::string locMobilityTable = FileInterface::ReadParameter<std::string>(interfaceproperties, {"MobilityTable", alpha, beta}, "NONE");
+            if(locMobilityTable != "NONE")
+            {
+                ReadMobilityTable(alpha, beta, locMobilityTable);
+            }
+
             if(alpha != beta)
             {
                 InterfaceEnergy(beta,alpha) = InterfaceEnergy(alpha,beta);
@@ -454,16 +493,93 @@ void InterfaceProperties::ReadJSON(const string InputFileName)
 
         RegularizationFactor = FileInterface::ReadParameter<double>(interfaceproperties, {"RegularizationFactor"}, 1.0);
         CurvatureFactor      = FileInterface::ReadParameter<double>(interfaceproperties, {"CurvatureFactor"}, 1.0);
+
+        IncrementalSet = FileInterface::ReadParameter<bool>(interfaceproperties, {"IncrementalSet"}, false);
+        if(IncrementalSet)
+        {
+            double locTolerance = FileInterface::ReadParameter<double>(interfaceproperties, {"IncrementalSetTolerance"}, 1.0);
+            IncrementalSetTolerance = cos(locTolerance*Pi/180.0);
+            if(Grid.Resolution == Resolutions::Single)
+            {
+                PropertiesNormals.Allocate(Grid, Grid.Bcells);
+            }
+        }
     }
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteBlankLine();
 }
 
+void InterfaceProperties::TabulateInterfaceEnergy(const size_t alpha, const size_t beta, const double Tolerance)
+{
+    std::stringstream message;
+    message << "Interface energy " << alpha << "-" << beta;
+    if(InterfaceEnergy(alpha,beta).Tabulate(Tolerance))
+    {
+        message << " tabulated with " << InterfaceEnergy(alpha,beta).TableSize
+                << " intervals per cube face edge, maximum relative error "
+                << InterfaceEnergy(alpha,beta).TableError;
+        ConsoleOutput::WriteStandard(thisclassname, message.str());
+    }
+    else
+    {
+        message << ": the energy model does not support tabulation, the analytic expression is used";
+        ConsoleOutput::WriteWarning(message.str(), thisclassname, "TabulateInterfaceEnergy()");
+    }
+}
+
+void InterfaceProperties::ReadMobilityTable(const size_t alpha, const size_t beta, std::string FileName)
+{
+    std::vector<std::vector<double>> locData;
+    std::vector<std::string> locHeader;
+    CSVParser::readFile(FileName, locData, locHeader);
+
+    std::vector<double> locT;
+    std::vector<double> locFactor;
+    for(auto& row : locData)
+    {
+        if(row.size() < 2)
+        {
+            ConsoleOutput::WriteExit("Mobility table \"" + FileName + "\" needs two columns: temperature and mobility factor", thisclassname, "ReadMobilityTable()");
+            OP_Exit(EXIT_FAILURE);
+        }
+        locT.push_back(row[0]);
+        locFactor.push_back(row[1]);
+    }
+    if(locT.empty() or not InterfaceMobility(alpha,beta).ThermalFactorTable.Set(locT, locFactor))
+    {
+        ConsoleOutput::WriteExit("Mobility table \"" + FileName + "\" is empty or its temperatures are not strictly increasing", thisclassname, "ReadMobilityTable()");
+        OP_Exit(EXIT_FAILURE);
+    }
+
+    std::stringstream message;
+    message << "Interface mobility " << alpha << "-" << beta << " thermal factor tabulated with "
+            << locT.size() << (InterfaceMobility(alpha,beta).ThermalFactorTable.IsUniform() ? " equidistant" : "")
+            << " temperatures from \"" << FileName << "\"";
+    ConsoleOutput::WriteStandard(thisclassname, message.str());
+}
+
+size_t InterfaceProperties::AllocatedMemory(void) const
+{
+    return Properties.AllocatedMemory() +
+           PropertiesDR.AllocatedMemory() +
+           InterfaceStiffnessTMP.AllocatedMemory() +
+           PropertiesExtrapolations.AllocatedMemory() +
+           PropertiesNormals.AllocatedMemory();
+}
+
 void InterfaceProperties::Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC)
 {
     Grid.SetDimensions(newNx, newNy, newNz);
 
     Properties.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    SetCells.clear();
+    SetCellsDR.clear();
+    ThermalCache.Epoch = 0;
+
+    if(PropertiesNormals.IsAllocated())
+    {
+        PropertiesNormals.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
 
     if(InterfaceStiffnessTMP.IsAllocated())
     {
@@ -478,6 +594,36 @@ void InterfaceProperties::Remesh(int newNx, int newNy, int newNz, const Boundary
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
+void InterfaceProperties::Repartition(const BoundaryConditions& BC)
+{
+    Grid.ApplyCutPlanes();
+
+    Properties.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    SetCells.clear();
+    SetCellsDR.clear();
+    ThermalCache.Epoch = 0;
+
+    if(PropertiesNormals.IsAllocated())
+    {
+        PropertiesNormals.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
+
+    if(InterfaceStiffnessTMP.IsAllocated())
+    {
+        InterfaceStiffnessTMP.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
+
+    if(PropertiesExtrapolations.IsAllocated())
+    {
+        PropertiesExtrapolations.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
+
+    if(Grid.Resolution == Resolutions::Dual)
+    {
+        PropertiesDR.Reallocate((1+Grid.dNx)*Grid.Nx, (1+Grid.dNy)*Grid.Ny, (1+Grid.dNz)*Grid.Nz);
+    }
+}
+
 void InterfaceProperties::Coarsen(const PhaseField& Phase)
 {
     double norm = 1.0/pow(2.0,Grid.Active());
@@ -560,7 +706,7 @@ void InterfaceProperties::Set(const PhaseField& Phase, const BoundaryConditions&
     {
         case Resolutions::Single:
         {
-            SetSR(Phase);
+            SetSR(Phase, true);
             break;
         }
         case Resolutions::Dual:
@@ -571,7 +717,15 @@ void InterfaceProperties::Set(const PhaseField& Phase, const BoundaryConditions&
             break;
         }
     }
-    SetBoundaryConditions(BC);
+    // Halo cells within Phase.HaloReach() have been set redundantly
+    if(Phase.HaloExchangeDue())
+    {
+        SetBoundaryConditions(BC);
+    }
+    else
+    {
+        BC.SetLocal(Properties);
+    }
     Extrapolate(Phase, BC);
 }
 
@@ -583,8 +737,17 @@ void InterfaceProperties::Set(const PhaseField& Phase,
     {
         case Resolutions::Single:
         {
-            SetSR(Phase);
-            SetMobilityThermalEffectSR(Phase, Tx);
+            // The thermal effect scales the stored mobilities, they can only
+            // be reused in cells whose temperature did not change
+            if(IncrementalSet and Tx.Subscribe(ThermalCache, Properties.Bcells()))
+            {
+                SetSR(Phase, true, &Tx);
+            }
+            else
+            {
+                SetSR(Phase, false);
+                SetMobilityThermalEffectSR(Phase, Tx);
+            }
             break;
         }
         case Resolutions::Dual:
@@ -596,18 +759,116 @@ void InterfaceProperties::Set(const PhaseField& Phase,
             break;
         }
     }
-    SetBoundaryConditions(BC);
+    // Halo cells within Phase.HaloReach() have been set redundantly
+    if(Phase.HaloExchangeDue())
+    {
+        SetBoundaryConditions(BC);
+    }
+    else
+    {
+        BC.SetLocal(Properties);
+    }
     Extrapolate(Phase, BC);
 }
 
-void InterfaceProperties::SetSR(const PhaseField& Phase)
+bool InterfaceProperties::ReusePropertiesSR(const PhaseField& Phase,
+                                            const long int i, const long int j, const long int k) const
+{
+    /* The properties depend on the set of phase fields in the cell, on the
+    interface normals of the solid grains and on the grain properties. Cells
+    with growing nuclei or violated growth constraints are always updated.*/
+    const NodePF& locPF = Phase.Fields(i,j,k);
+    const NodeA<dVector3>& locNormals = PropertiesNormals(i,j,k);
+    if(locPF.size() != locNormals.size()) return false;
+
+    for(auto alpha = locPF.cbegin(); alpha != locPF.cend(); ++alpha)
+    {
+        if(not locNormals.present(alpha->index)) return false;
+
+        const Grain& locGrain = Phase.FieldsProperties[alpha->index];
+        if(locGrain.IsNucleus() or
+           locGrain.GrowthConstraintsViolation != GrowthConstraintsViolations::None)
+        {
+            return false;
+        }
+        if(locGrain.State == AggregateStates::Solid and
+           alpha->value != 0.0 and alpha->value != 1.0)
+        {
+            const double length = alpha->gradient.length();
+            if(length <= DBL_EPSILON) return false;
+
+            const dVector3 normal = alpha->gradient*(-1.0/length);
+            if(normal*locNormals.get_value(alpha->index) < IncrementalSetTolerance) return false;
+        }
+    }
+    return true;
+}
+
+void InterfaceProperties::StorePropertiesNormalsSR(const PhaseField& Phase,
+                                                   const long int i, const long int j, const long int k)
+{
+    PropertiesNormals(i,j,k).clear();
+    for(auto alpha  = Phase.Fields(i,j,k).cbegin();
+             alpha != Phase.Fields(i,j,k).cend(); ++alpha)
+    {
+        const double length = alpha->gradient.length();
+        dVector3 normal = {0.0, 0.0, 0.0};
+        if(length > DBL_EPSILON)
+        {
+            normal = alpha->gradient*(-1.0/length);
+        }
+        PropertiesNormals(i,j,k).set_value(alpha->index, normal);
+    }
+}
+
+void InterfaceProperties::SetSR(const PhaseField& Phase, const bool incremental,
+                                const Temperature* Tx)
 {
     Matrix<double> locMaxEnergies(Nphases,Nphases);
     Matrix<double> locMaxMobilities(Nphases,Nphases);
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Properties, 0, reduction(MatrixDMAX:locMaxEnergies) reduction(MatrixDMAX:locMaxMobilities))
+    /* In the incremental mode the properties of a cell are kept from the
+    previous call if ReusePropertiesSR() allows it. The first order
+    extrapolation modifies the stored energies, it requires a full update.*/
+    const bool reuse = incremental and IncrementalSet and PropertiesNormals.IsAllocated() and
+                       ExtrapolationMode != ExtrapolationModes::FirstOrder;
+
+    // Mobilities set without the thermal effect must not be reused with it
+    if(Tx == nullptr) ThermalCache.Epoch = 0;
+
+    // Only interface cells hold properties: clear the ones set in the previous call
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,SetCells,)
+    {
+        if(not reuse or Phase.Fields(i,j,k).flag == 0)
+        {
+            Properties(i,j,k).clear();
+            if(PropertiesNormals.IsAllocated()) PropertiesNormals(i,j,k).clear();
+        }
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+
+    Phase.FieldsProperties.UpdateRotations();                                   // Used by InterfaceOrientation()
+
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCells, reduction(MatrixDMAX:locMaxEnergies) reduction(MatrixDMAX:locMaxMobilities))
     {
+        if(reuse and Phase.Fields(i,j,k).wide_interface() and
+           (Tx == nullptr or not Tx->Outdated(i,j,k,ThermalCache)) and
+           ReusePropertiesSR(Phase,i,j,k))
+        {
+            for(auto it  = Properties(i,j,k).cbegin();
+                     it != Properties(i,j,k).cend(); ++it)
+            {
+                size_t pIndexA = Phase.FieldsProperties[it->indexA].Phase;
+                size_t pIndexB = Phase.FieldsProperties[it->indexB].Phase;
+                locMaxEnergies(pIndexA,pIndexB) = max(locMaxEnergies(pIndexA,pIndexB),double(it->energy));
+                locMaxEnergies(pIndexB,pIndexA) = max(locMaxEnergies(pIndexB,pIndexA),double(it->energy));
+                locMaxMobilities(pIndexA,pIndexB) = max(locMaxMobilities(pIndexA,pIndexB),double(it->mobility));
+                locMaxMobilities(pIndexB,pIndexA) = max(locMaxMobilities(pIndexB,pIndexA),double(it->mobility));
+            }
+            continue;
+        }
         Properties(i,j,k).clear();
+        if(PropertiesNormals.IsAllocated()) PropertiesNormals(i,j,k).clear();
 
         if(Phase.Fields(i,j,k).wide_interface())
         {
@@ -628,9 +889,8 @@ void InterfaceProperties::SetSR(const PhaseField& Phase)
                 }
                 else if(InterfaceEnergy(pIndexA, pIndexB).Model == InterfaceEnergyModels::Disorientation)
                 {
-                    Quaternion OrientationA = Phase.FieldsProperties[alpha->index].Orientation;
-                    Quaternion OrientationB = Phase.FieldsProperties[ beta->index].Orientation;
-                    locEnergy = InterfaceEnergy(pIndexA, pIndexB).CalculateDisorientation(OrientationA, OrientationB);
+                    double misorientation = Phase.FieldsProperties.Misorientation(alpha->index, beta->index).Angle;
+                    locEnergy = InterfaceEnergy(pIndexA, pIndexB).CalculateDisorientation(misorientation);
                 }
                 else if(InterfaceEnergy(pIndexA, pIndexB).Model != InterfaceEnergyModels::Ext)
                 {
@@ -741,6 +1001,12 @@ void InterfaceProperties::SetSR(const PhaseField& Phase)
                     locMobility *= Phase.PairwiseGrowthFactors.get_sym1(alpha->index,beta->index);
                 }
 
+                // Thermally activated mobility
+                if(Tx != nullptr)
+                {
+                    locMobility *= InterfaceMobility(pIndexA, pIndexB).ThermalFactor((*Tx)(i,j,k));
+                }
+
                 // Putting interface energy and mobility values into the properties storage
                 if(locEnergy != 0.0 or locMobility != 0.0)
                 {
@@ -749,15 +1015,23 @@ void InterfaceProperties::SetSR(const PhaseField& Phase)
                 locMaxEnergies(pIndexA,pIndexB) = max(locMaxEnergies(pIndexA,pIndexB),locEnergy);
                 locMaxMobilities(pIndexA,pIndexB) = max(locMaxMobilities(pIndexA,pIndexB),locMobility);
             }
+            if(PropertiesNormals.IsAllocated())
+            {
+                StorePropertiesNormalsSR(Phase,i,j,k);
+            }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    SetCells = Phase.InterfaceCells;
+
     maxEnergies = locMaxEnergies;
     maxMobilities = locMaxMobilities;
 
 #ifdef MPI_PARALLEL
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, maxEnergies.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, maxMobilities.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    ReductionBatch Batch;
+    Batch.Max(maxEnergies.data(), Nphases*Nphases);
+    Batch.Max(maxMobilities.data(), Nphases*Nphases);
+    Batch.Reduce();
 #endif
 }
 
@@ -775,7 +1049,7 @@ dVector3 InterfaceProperties::dEnergy_dGradientAlpha(const PhaseField& Phase, No
         if(Phase.FieldsProperties[alpha->index].State == AggregateStates::Solid)
         if(alpha->value != 0.0 and alpha->value != 1.0)
         {
-            const dMatrix3x3 R = Phase.FieldsProperties[alpha->index].Orientation.RotationMatrix.transposed();
+            const dMatrix3x3& R = Phase.FieldsProperties[alpha->index].RotationMatrixTransposed();
             const dVector3 normal = alpha->gradient.normalized()*(-1);
             const dVector3 locInterfaceOrientationAlpha = R*normal;
             const dMatrix3x3 dlocInterfaceOrientationAlpha_dGradientAlpha = (R*(normal.dyadic(normal) - dMatrix3x3::UnitTensor()))/alpha->gradient.length();
@@ -803,7 +1077,16 @@ void InterfaceProperties::SetDR(const PhaseField& Phase)
     Matrix<double> locMaxEnergies(Nphases,Nphases);
     Matrix<double> locMaxMobilities(Nphases,Nphases);
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PropertiesDR, 0, reduction(MatrixDMAX:locMaxEnergies) reduction(MatrixDMAX:locMaxMobilities))
+    // Only interface cells hold properties: clear the ones set in the previous call
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,SetCellsDR,)
+    {
+        PropertiesDR(i,j,k).clear();
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+
+    Phase.FieldsProperties.UpdateRotations();                                   // Used by InterfaceOrientation()
+
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Phase.InterfaceCellsDR, reduction(MatrixDMAX:locMaxEnergies) reduction(MatrixDMAX:locMaxMobilities))
     {
         PropertiesDR(i,j,k).clear();
 
@@ -826,9 +1109,8 @@ void InterfaceProperties::SetDR(const PhaseField& Phase)
                 }
                 else if(InterfaceEnergy(pIndexA, pIndexB).Model == InterfaceEnergyModels::Disorientation)
                 {
-                    Quaternion OrientationA = Phase.FieldsProperties[alpha->index].Orientation;
-                    Quaternion OrientationB = Phase.FieldsProperties[ beta->index].Orientation;
-                    locEnergy = InterfaceEnergy(pIndexA, pIndexB).CalculateDisorientation(OrientationA, OrientationB);
+                    double misorientation = Phase.FieldsProperties.Misorientation(alpha->index, beta->index).Angle;
+                    locEnergy = InterfaceEnergy(pIndexA, pIndexB).CalculateDisorientation(misorientation);
                 }
                 else if(InterfaceEnergy(pIndexA, pIndexB).Model != InterfaceEnergyModels::Ext)
                 {
@@ -948,13 +1230,17 @@ void InterfaceProperties::SetDR(const PhaseField& Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    SetCellsDR = Phase.InterfaceCellsDR;
+
     maxEnergies = locMaxEnergies;
     maxMobilities = locMaxMobilities;
 
 #ifdef MPI_PARALLEL
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, maxEnergies.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, maxMobilities.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    ReductionBatch Batch;
+    Batch.Max(maxEnergies.data(), Nphases*Nphases);
+    Batch.Max(maxMobilities.data(), Nphases*Nphases);
+    Batch.Reduce();
 #endif
 }
 
@@ -979,14 +1265,14 @@ void InterfaceProperties::SetMobilityThermalEffectSR(const PhaseField& Phase, co
     {
         if(Phase.Fields(i, j, k).wide_interface())
         {
-            double invT = 1.0 / (PhysicalConstants::R * Tx(i, j, k));
+            double locT = Tx(i, j, k);
             for(auto it = Properties(i, j, k).begin();
                      it != Properties(i, j, k).end(); ++it)
             {
                 int pIndexA = Phase.FieldsProperties[it->indexA].Phase;
                 int pIndexB = Phase.FieldsProperties[it->indexB].Phase;
-                it->mobility *= exp(-InterfaceMobility(pIndexA, pIndexB).ActivationEnergy * invT);
-                locMaxMobilities(pIndexA, pIndexB) = max(locMaxMobilities(pIndexA, pIndexB), it->mobility);
+                it->mobility *= InterfaceMobility(pIndexA, pIndexB).ThermalFactor(locT);
+                locMaxMobilities(pIndexA, pIndexB) = max(locMaxMobilities(pIndexA, pIndexB), double(it->mobility));
             }
         }
     }
@@ -1006,15 +1292,15 @@ void InterfaceProperties::SetMobilityThermalEffectDR(const PhaseField& Phase, co
     {
         if(Phase.FieldsDR(i, j, k).wide_interface())
         {
-            double invT = 1.0 / (PhysicalConstants::R * Tx.at(0.5 * i - Grid.dNx * 0.25, 0.5 * j - Grid.dNy * 0.25, 0.5 * k - Grid.dNz * 0.25));
+            double locT = Tx.at(0.5 * i - Grid.dNx * 0.25, 0.5 * j - Grid.dNy * 0.25, 0.5 * k - Grid.dNz * 0.25);
             for(auto it = PropertiesDR(i, j, k).begin();
                      it != PropertiesDR(i, j, k).end(); ++it)
             {
                 int pIndexA = Phase.FieldsProperties[it->indexA].Phase;
                 int pIndexB = Phase.FieldsProperties[it->indexB].Phase;
-                it->mobility *= exp(-InterfaceMobility(pIndexA, pIndexB).ActivationEnergy * invT);
-                locMaxMobility                     = max(locMaxMobility, it->mobility);
-                locMaxMobilities(pIndexA, pIndexB) = max(locMaxMobilities(pIndexA, pIndexB), it->mobility);
+                it->mobility *= InterfaceMobility(pIndexA, pIndexB).ThermalFactor(locT);
+                locMaxMobility                     = max(locMaxMobility, double(it->mobility));
+                locMaxMobilities(pIndexA, pIndexB) = max(locMaxMobilities(pIndexA, pIndexB), double(it->mobility));
             }
         }
     }
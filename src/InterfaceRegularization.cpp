@@ -31,6 +31,7 @@
 #include "PhaseField.h"
 #include "InterfaceProperties.h"
 #include "BoundaryConditions.h"
+#include "LoadBalancer.h"
 
 namespace openphase
 {
@@ -73,6 +74,7 @@ void InterfaceRegularization::Initialize(Settings& locSettings, std::string Obje
     }
 
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -83,7 +85,7 @@ void InterfaceRegularization::ReadInput(const string InputFileName)
     ConsoleOutput::WriteLineInsert("InterfaceRegularization input");
     ConsoleOutput::WriteStandard("Source", InputFileName.c_str());
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -95,7 +97,6 @@ void InterfaceRegularization::ReadInput(const string InputFileName)
     data << inp.rdbuf();
     ReadInput(data);
 
-    inp.close();
 }
 
 void InterfaceRegularization::ReadInput(stringstream& inp)
@@ -135,269 +136,30 @@ void InterfaceRegularization::Average(const PhaseField& Phase, const BoundaryCon
 {
     if(Averaging)
     {
-        if(Grid.Resolution == Resolutions::Single)
-        {
-            SetWeightsSR(Phase);
-            SetBoundaryConditions(BC);
-            CollectAverageSR(Phase);
-            SetBoundaryConditions(BC);
-            DistributeAverageSR(Phase);
-        }
-        else
-        {
-            SetWeightsDR(Phase);
-            SetBoundaryConditions(BC);
-            CollectAverageDR(Phase);
-            SetBoundaryConditions(BC);
-            DistributeAverageDR(Phase);
-        }
-    }
-}
-
-void InterfaceRegularization::SetWeightsSR(const PhaseField& Phase)
-{
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Curvature,0,)
-    {
-        if (Phase.Fields(i,j,k).interface())
-        for(auto it  = Curvature(i,j,k).begin();
-                 it != Curvature(i,j,k).end(); ++it)
-        {
-            double PhiAlpha = Phase.Fields(i,j,k).get_value(it->indexA);
-            double PhiBeta  = Phase.Fields(i,j,k).get_value(it->indexB);
-
-            it->weight = sqrt(PhiAlpha*PhiBeta);
-        }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-void InterfaceRegularization::CollectAverageSR(const PhaseField& Phase)
-{
-    const int Xrange = min(Range, Grid.Nx-1)*Grid.dNx;
-    const int Yrange = min(Range, Grid.Ny-1)*Grid.dNy;
-    const int Zrange = min(Range, Grid.Nz-1)*Grid.dNz;
-
-    const double weight_threshold = sqrt(PhiThreshold*(1.0 - PhiThreshold));
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Curvature,0,)
-    {
-        if (Phase.Fields(i,j,k).interface())
-        for(auto it  = Curvature(i,j,k).begin();
-                 it != Curvature(i,j,k).end(); ++it)
-        {
-            if (it->weight > weight_threshold)
-            {
-                double value = 0.0;
-
-                double SumWeights = 0.0;
-
-                for(int ii = -Xrange; ii <= Xrange; ii++)
-                for(int jj = -Yrange; jj <= Yrange; jj++)
-                for(int kk = -Zrange; kk <= Zrange; kk++)
-                {
-                    double dist = sqrt(ii*ii + jj*jj + kk*kk);
-
-                    if((Range - dist) > 0.0 and Phase.Fields(i+ii,j+jj,k+kk).interface())
-                    {
-                        double weight = Curvature(i+ii, j+jj, k+kk).get_weight(it->indexA, it->indexB)*(Range - dist);
-
-                        if (weight > DBL_EPSILON)
-                        {
-                            SumWeights += weight;
-                            value += weight*Curvature(i+ii, j+jj, k+kk).get_raw(it->indexA, it->indexB);
-                        }
-                    }
-                }
-                if(SumWeights > DBL_EPSILON)
-                {
-                    it->tmp = value/SumWeights;
-                }
-            }
-            else if(Phase.FieldsProperties[it->indexA].Stage == GrainStages::Seed or
-                    Phase.FieldsProperties[it->indexB].Stage == GrainStages::Seed)
-            {
-                it->tmp = it->raw;
-            }
-        }
+        /* Weights of the raw curvatures combine the distance and the phase
+        fields, the inner interface cells are then averaged with equal
+        weights */
+        AveragingRules Rules;
+        Rules.CollectWeights      = AveragingWeightsModes::RangePhaseFields;
+        Rules.DistributeWeights   = AveragingWeightsModes::Counter;
+        Rules.PhiThreshold        = PhiThreshold;
+        Rules.MinWeight           = DBL_EPSILON;
+        Rules.ScaleThreshold      = false;
+        Rules.InterfaceNeighbours = true;
+        Rules.SeedsCollectRaw     = true;
+        Rules.EmptyCollectRaw     = false;
+
+        const bool SR = (Grid.Resolution == Resolutions::Single);
+        const Storage3D<NodePF, 0>& Fields = SR ? Phase.Fields : Phase.FieldsDR;
+        const std::vector<iVector3>& Cells = SR ? Phase.InterfaceCells : Phase.InterfaceCellsDR;
+
+        Averager.Initialize(Grid, Range);
+        Averager.SetWeights(Curvature, Fields, Cells);
+        SetBoundaryConditions(BC);
+        Averager.Collect(Curvature, Fields, Cells, Phase.FieldsProperties, Rules);
+        SetBoundaryConditions(BC);
+        Averager.Distribute(Curvature, Fields, Cells, Phase.FieldsProperties, Rules);
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-void InterfaceRegularization::DistributeAverageSR(const PhaseField& Phase)
-{
-    const int Xrange = min(Range, Grid.Nx-1)*Grid.dNx;
-    const int Yrange = min(Range, Grid.Ny-1)*Grid.dNy;
-    const int Zrange = min(Range, Grid.Nz-1)*Grid.dNz;
-
-    const double weight_threshold = sqrt(PhiThreshold*(1.0 - PhiThreshold));
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Curvature,0,)
-    {
-        if (Phase.Fields(i,j,k).interface())
-        for(auto it  = Curvature(i,j,k).begin();
-                 it != Curvature(i,j,k).end(); ++it)
-        {
-            if (it->weight > DBL_EPSILON)
-            {
-                int  counter = 0;
-                double value = 0.0;
-                for(int ii = -Xrange; ii <= Xrange; ii++)
-                for(int jj = -Yrange; jj <= Yrange; jj++)
-                for(int kk = -Zrange; kk <= Zrange; kk++)
-                {
-                    double dist = sqrt(ii*ii + jj*jj + kk*kk);
-
-                    if((Range - dist) > 0.0 and Phase.Fields(i+ii,j+jj,k+kk).interface())
-                    {
-                        double weight = Curvature(i+ii, j+jj, k+kk).get_weight(it->indexA, it->indexB);
-
-                        if (weight > weight_threshold)
-                        {
-                            counter ++;
-                            value += Curvature(i+ii, j+jj, k+kk).get_tmp(it->indexA, it->indexB);
-                        }
-                    }
-                }
-                if(counter != 0)
-                {
-                    it->average = value/counter;
-                }
-                else
-                {
-                    it->average = it->tmp;
-                }
-            }
-            else if(Phase.FieldsProperties[it->indexA].Stage == GrainStages::Seed or
-                    Phase.FieldsProperties[it->indexB].Stage == GrainStages::Seed)
-            {
-                it->average = it->raw;
-            }
-        }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-void InterfaceRegularization::SetWeightsDR(const PhaseField& Phase)
-{
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Curvature,0,)
-    {
-        if (Phase.FieldsDR(i,j,k).interface())
-        for(auto it  = Curvature(i,j,k).begin();
-                 it != Curvature(i,j,k).end(); ++it)
-        {
-            double PhiAlpha = Phase.FieldsDR(i,j,k).get_value(it->indexA);
-            double PhiBeta  = Phase.FieldsDR(i,j,k).get_value(it->indexB);
-
-            it->weight = sqrt(PhiAlpha*PhiBeta);
-        }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-void InterfaceRegularization::CollectAverageDR(const PhaseField& Phase)
-{
-    const int Xrange = min(Range, Grid.Nx-1)*Grid.dNx;
-    const int Yrange = min(Range, Grid.Ny-1)*Grid.dNy;
-    const int Zrange = min(Range, Grid.Nz-1)*Grid.dNz;
-
-    const double weight_threshold = sqrt(PhiThreshold*(1.0 - PhiThreshold));
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Curvature,0,)
-    {
-        if (Phase.FieldsDR(i,j,k).interface())
-        for(auto it  = Curvature(i,j,k).begin();
-                 it != Curvature(i,j,k).end(); ++it)
-        {
-            if (it->weight > weight_threshold)
-            {
-                double value = 0.0;
-
-                double SumWeights = 0.0;
-
-                for(int ii = -Xrange; ii <= Xrange; ii++)
-                for(int jj = -Yrange; jj <= Yrange; jj++)
-                for(int kk = -Zrange; kk <= Zrange; kk++)
-                {
-                    double dist = sqrt(ii*ii + jj*jj + kk*kk);
-
-                    if((Range - dist) > 0.0 and Phase.FieldsDR(i+ii,j+jj,k+kk).interface())
-                    {
-                        double weight = Curvature(i+ii, j+jj, k+kk).get_weight(it->indexA, it->indexB)*(Range - dist);
-
-                        if (weight > DBL_EPSILON)
-                        {
-                            SumWeights += weight;
-                            value += weight*Curvature(i+ii, j+jj, k+kk).get_raw(it->indexA, it->indexB);
-                        }
-                    }
-                }
-                if(SumWeights > DBL_EPSILON)
-                {
-                    it->tmp = value/SumWeights;
-                }
-            }
-            else if(Phase.FieldsProperties[it->indexA].Stage == GrainStages::Seed or
-                    Phase.FieldsProperties[it->indexB].Stage == GrainStages::Seed)
-            {
-                it->tmp = it->raw;
-            }
-        }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-void InterfaceRegularization::DistributeAverageDR(const PhaseField& Phase)
-{
-    const int Xrange = min(Range, Grid.Nx-1)*Grid.dNx;
-    const int Yrange = min(Range, Grid.Ny-1)*Grid.dNy;
-    const int Zrange = min(Range, Grid.Nz-1)*Grid.dNz;
-
-    const double weight_threshold = sqrt(PhiThreshold*(1.0 - PhiThreshold));
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Curvature,0,)
-    {
-        if (Phase.FieldsDR(i,j,k).interface())
-        for(auto it  = Curvature(i,j,k).begin();
-                 it != Curvature(i,j,k).end(); ++it)
-        {
-            if (it->weight > DBL_EPSILON)
-            {
-                int counter = 0;
-                double value = 0.0;
-                for(int ii = -Xrange; ii <= Xrange; ii++)
-                for(int jj = -Yrange; jj <= Yrange; jj++)
-                for(int kk = -Zrange; kk <= Zrange; kk++)
-                {
-                    double dist = sqrt(ii*ii + jj*jj + kk*kk);
-
-                    if((Range - dist) > 0.0 and Phase.FieldsDR(i+ii,j+jj,k+kk).interface())
-                    {
-                        double weight = Curvature(i+ii, j+jj, k+kk).get_weight(it->indexA, it->indexB);
-
-                        if (weight > weight_threshold)
-                        {
-                            counter ++;
-                            value += Curvature(i+ii, j+jj, k+kk).get_tmp(it->indexA, it->indexB);
-                        }
-                    }
-                }
-                if(counter != 0)
-                {
-                    it->average = value/counter;
-                }
-                else
-                {
-                    it->average = it->tmp;
-                }
-            }
-            else if(Phase.FieldsProperties[it->indexA].Stage == GrainStages::Seed or
-                    Phase.FieldsProperties[it->indexB].Stage == GrainStages::Seed)
-            {
-                it->average = it->raw;
-            }
-        }
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
 }
 
 void InterfaceRegularization::MergePhaseFieldIncrements(PhaseField& Phase, InterfaceProperties& IP)
@@ -537,6 +299,11 @@ void InterfaceRegularization::WriteVTK(const Settings& locSettings,
     }
 }
 
+size_t InterfaceRegularization::AllocatedMemory(void) const
+{
+    return Curvature.AllocatedMemory();
+}
+
 void InterfaceRegularization::Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC)
 {
     if(Grid.Resolution == Resolutions::Dual)
@@ -553,6 +320,20 @@ void InterfaceRegularization::Remesh(int newNx, int newNy, int newNz, const Boun
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
+void InterfaceRegularization::Repartition(const BoundaryConditions& BC)
+{
+    Grid.ApplyCutPlanes();
+
+    if(Grid.Resolution == Resolutions::Dual)
+    {
+        Curvature.Reallocate((1+Grid.dNx)*Grid.Nx, (1+Grid.dNy)*Grid.Ny, (1+Grid.dNz)*Grid.Nz);
+    }
+    else
+    {
+        Curvature.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
+}
+
 InterfaceRegularization& InterfaceRegularization::operator= (const InterfaceRegularization& rhs)
 {
     // protect against self-assignment and copy of uninitialized object
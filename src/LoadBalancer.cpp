@@ -0,0 +1,276 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LoadBalancer.h"
+#include "Settings.h"
+#include "PhaseField.h"
+
+namespace openphase
+{
+using namespace std;
+
+void LoadBalancer::Initialize(Settings& locSettings, std::string ObjectNameSuffix)
+{
+    thisclassname = "LoadBalancer";
+    thisobjectname = thisclassname + ObjectNameSuffix;
+
+    Interval      = 0;
+    Threshold     = 1.1;
+    MinGain       = 0.05;
+    InterfaceCost = 4.0;
+    FluidCost     = 0.0;
+
+    Imbalance     = 1.0;
+    Repartitions  = 0;
+    Warned        = false;
+
+    initialized = true;
+    ConsoleOutput::WriteStandard(thisclassname, "Initialized");
+}
+
+void LoadBalancer::ReadInput(const std::string InputFileName)
+{
+    ConsoleOutput::WriteLineInsert("LoadBalancer input");
+    ConsoleOutput::WriteStandard("Source", InputFileName);
+
+    stringstream inp = FileInterface::OpenInput(InputFileName);
+
+    if (!inp)
+    {
+        ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened", thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    };
+
+    std::stringstream data;
+    data << inp.rdbuf();
+    ReadInput(data);
+
+    ConsoleOutput::WriteLine();
+}
+
+void LoadBalancer::ReadInput(std::stringstream& inp)
+{
+    int moduleLocation = FileInterface::FindModuleLocation(inp, thisclassname);
+
+    Interval      = FileInterface::ReadParameterI(inp, moduleLocation, string("Interval"), false, 0);
+    Threshold     = FileInterface::ReadParameterD(inp, moduleLocation, string("Threshold"), false, 1.1);
+    MinGain       = FileInterface::ReadParameterD(inp, moduleLocation, string("MinGain"), false, 0.05);
+    InterfaceCost = FileInterface::ReadParameterD(inp, moduleLocation, string("InterfaceCost"), false, 4.0);
+    FluidCost     = FileInterface::ReadParameterD(inp, moduleLocation, string("FluidCost"), false, 0.0);
+
+    input_read = true;
+    ConsoleOutput::WriteLine();
+    ConsoleOutput::WriteBlankLine();
+}
+
+void LoadBalancer::CellCosts(const PhaseField& Phase, Storage3D<double,0>& Cost) const
+{
+    if(Cost.IsNotAllocated())
+    {
+        Cost.Allocate(Phase.Grid, 0);
+    }
+    else if(not Cost.IsSize(Phase.Grid.Nx, Phase.Grid.Ny, Phase.Grid.Nz))
+    {
+        Cost.Reallocate(Phase.Grid.Nx, Phase.Grid.Ny, Phase.Grid.Nz);
+    }
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cost,0,)
+    {
+        double locCost = 1.0;
+        if(Phase.Fields(i,j,k).wide_interface())
+        {
+            locCost += InterfaceCost;
+        }
+        if(FluidCost != 0.0)
+        for(auto alpha = Phase.Fields(i,j,k).cbegin(); alpha != Phase.Fields(i,j,k).cend(); ++alpha)
+        if(Phase.FieldsProperties[alpha->index].State == AggregateStates::Liquid)
+        {
+            locCost += FluidCost*alpha->value;
+        }
+        Cost(i,j,k) = locCost;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+vector<int> LoadBalancer::Bisect(const vector<double>& Profile, const int Parts, const int MinWidth)
+{
+    vector<int> Cuts(Parts + 1, 0);
+    Cuts[Parts] = Profile.size();
+
+    vector<double> Cumulative(Profile.size() + 1, 0.0);
+    partial_sum(Profile.begin(), Profile.end(), Cumulative.begin() + 1);
+
+    /* Splits the cells [Begin, End) among the parts [First, Last): the left
+    half of the parts gets its share of the cost, each side keeps at least
+    MinWidth cells per part */
+    function<void(int,int,int,int)> Split = [&](int First, int Last, int Begin, int End)
+    {
+        if(Last - First < 2) return;
+
+        const int Middle = (First + Last)/2;
+        const double Target = Cumulative[Begin] + (Cumulative[End] - Cumulative[Begin])*(Middle - First)/(Last - First);
+
+        int Cut = lower_bound(Cumulative.begin() + Begin, Cumulative.begin() + End, Target) - Cumulative.begin();
+        if(Cut > Begin and Target - Cumulative[Cut - 1] < Cumulative[Cut] - Target) Cut--;
+        Cut = max(Cut, Begin + (Middle - First)*MinWidth);
+        Cut = min(Cut, End - (Last - Middle)*MinWidth);
+
+        Cuts[Middle] = Cut;
+        Split(First, Middle, Begin, Cut);
+        Split(Middle, Last, Cut, End);
+    };
+    Split(0, Parts, 0, Profile.size());
+
+    return Cuts;
+}
+
+bool LoadBalancer::Balance(Settings& locSettings, const PhaseField& Phase,
+                           const BoundaryConditions& BC, const int tStep)
+{
+    if(Interval <= 0 or tStep % Interval != 0) return false;
+
+    CellCosts(Phase, Costs);
+    return Balance(locSettings, Costs, BC, tStep);
+}
+
+bool LoadBalancer::Balance(Settings& locSettings, const Storage3D<double,0>& Cost,
+                           const BoundaryConditions& BC, const int tStep)
+{
+    if(Interval <= 0 or tStep % Interval != 0) return false;
+
+#ifdef MPI_PARALLEL
+    if(not MPI_3D_DECOMPOSITION or MPI_SIZE == 1)
+    {
+        if(not Warned) ConsoleOutput::WriteWarning("Load balancing needs the MPI 3D domain decomposition, disabled", thisclassname, "Balance()");
+        Warned = true;
+        return false;
+    }
+    for(auto Object : locSettings.ObjectsToRemesh)
+    if(not Object->repartitionable)
+    {
+        if(not Warned) ConsoleOutput::WriteWarning(Object->thisclassname + " cannot be repartitioned, load balancing is disabled", thisclassname, "Balance()");
+        Warned = true;
+        return false;
+    }
+
+    const GridParameters& Grid = locSettings.Grid;
+    const int Total[3]  = {Grid.TotalNx, Grid.TotalNy, Grid.TotalNz};
+    const int Offset[3] = {Grid.OffsetX, Grid.OffsetY, Grid.OffsetZ};
+
+    /* Cost profiles along each direction summed over the whole domain */
+    vector<double> Profile[3];
+    for(int d = 0; d < 3; d++) Profile[d].assign(Total[d], 0.0);
+
+    double LocalCost = 0.0;
+    STORAGE_LOOP_BEGIN(i,j,k,Cost,0)
+    {
+        LocalCost += Cost(i,j,k);
+        Profile[0][i + Offset[0]] += Cost(i,j,k);
+        Profile[1][j + Offset[1]] += Cost(i,j,k);
+        Profile[2][k + Offset[2]] += Cost(i,j,k);
+    }
+    STORAGE_LOOP_END
+
+    for(int d = 0; d < 3; d++)
+    {
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, Profile[d].data(), Total[d], OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    }
+    double MaxCost = LocalCost;
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &MaxCost, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    const double MeanCost = accumulate(Profile[0].begin(), Profile[0].end(), 0.0)/MPI_SIZE;
+
+    if(MeanCost <= 0.0) return false;
+    Imbalance = MaxCost/MeanCost;
+    if(Imbalance < Threshold) return false;
+
+    /* New cut planes and the resulting cost of each box, the per direction
+    cuts only approximate the optimum, hence the check of the gain */
+    vector<int> Cuts[3];
+    vector<int> Owner[3];
+    for(int d = 0; d < 3; d++)
+    {
+        Cuts[d] = Bisect(Profile[d], MPI_CART_SIZE[d], (Total[d] > 1) ? Grid.Bcells : 1);
+        Owner[d].resize(Total[d]);
+        for(int p = 0; p < MPI_CART_SIZE[d]; p++)
+        {
+            fill(Owner[d].begin() + Cuts[d][p], Owner[d].begin() + Cuts[d][p+1], p);
+        }
+    }
+
+    vector<double> BoxCosts(MPI_SIZE, 0.0);
+    STORAGE_LOOP_BEGIN(i,j,k,Cost,0)
+    {
+        const int Box = (Owner[0][i + Offset[0]]*MPI_CART_SIZE[1] + Owner[1][j + Offset[1]])*MPI_CART_SIZE[2] + Owner[2][k + Offset[2]];
+        BoxCosts[Box] += Cost(i,j,k);
+    }
+    STORAGE_LOOP_END
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, BoxCosts.data(), MPI_SIZE, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    const double NewMaxCost = *max_element(BoxCosts.begin(), BoxCosts.end());
+
+    if(NewMaxCost > (1.0 - MinGain)*MaxCost) return false;
+
+    for(int d = 0; d < 3; d++)
+    {
+        MPI_CART_CUTS[d] = Cuts[d];
+    }
+    locSettings.RepartitionAll(BC);
+    Repartitions++;
+    if(Repartitions == 1)
+    {
+        ConsoleOutput::WriteWarning("Raw data now holds the repartitioned local boxes, "
+                                    "only Settings::WriteAll()/ReadAll() restore the cut planes on restart",
+                                    thisclassname, "Balance()");
+    }
+
+    auto CutList = [](const vector<int>& locCuts)
+    {
+        stringstream list;
+        for(size_t n = 0; n < locCuts.size(); n++) list << (n ? " " : "") << locCuts[n];
+        return list.str();
+    };
+    ConsoleOutput::WriteLineInsert("Load balancing at time step " + to_string(tStep));
+    ConsoleOutput::WriteStandard("Imbalance before", Imbalance);
+    ConsoleOutput::WriteStandard("Imbalance after", NewMaxCost/MeanCost);
+    ConsoleOutput::WriteStandard("Cut planes X", CutList(Cuts[0]));
+    ConsoleOutput::WriteStandard("Cut planes Y", CutList(Cuts[1]));
+    ConsoleOutput::WriteStandard("Cut planes Z", CutList(Cuts[2]));
+    ConsoleOutput::WriteLine();
+
+    if(MPI_RANK == 0)
+    {
+        ofstream out(locSettings.TextDir + "CutPlanes.dat", (Repartitions == 1) ? ios::out : ios::app);
+        out << tStep << " " << Imbalance << " " << NewMaxCost/MeanCost << " X " << CutList(Cuts[0])
+            << " Y " << CutList(Cuts[1]) << " Z " << CutList(Cuts[2]) << "\n";
+    }
+
+    Imbalance = NewMaxCost/MeanCost;
+    return true;
+#else
+    (void) locSettings; //unused
+    (void) Cost;        //unused
+    (void) BC;          //unused
+    return false;
+#endif
+}
+
+}// namespace openphase
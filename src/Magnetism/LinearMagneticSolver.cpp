@@ -27,6 +27,7 @@
 #include "Includes.h"
 #include "Magnetism/LinearMagneticSolver.h"
 #include "ElasticProperties.h"
+#include "FFTWPlanner.h"
 #include "NumericalMethods/SystemOfLinearEquationsSolvers.h"
 #include "PhaseField.h"
 #include "PhysicalConstants.h"
@@ -41,6 +42,12 @@ LinearMagneticSolver::LinearMagneticSolver(Settings& locSettings, const std::str
     ReadInput(InputFileName);
 }
 
+LinearMagneticSolver::~LinearMagneticSolver(void)
+{
+    if(ForwardPlan)  fftw_destroy_plan(ForwardPlan);
+    if(BackwardPlan) fftw_destroy_plan(BackwardPlan);
+}
+
 void LinearMagneticSolver::Initialize(Settings& locSettings, std::string ObjectNameSuffix)
 {
     thisclassname = "LinearMagneticSolver";
@@ -58,6 +65,11 @@ void LinearMagneticSolver::Initialize(Settings& locSettings, std::string ObjectN
     A.Allocate(N,7);
     b.resize(N);
     x.resize(N);
+    Diagonal.resize(N);
+
+    MaxIterations  = 10000;
+    LinearSolver   = "BICG";
+    Preconditioner = "FFT";
 
     initialized = true;
     ConsoleOutput::Write(thisclassname, "Initialized");
@@ -65,7 +77,7 @@ void LinearMagneticSolver::Initialize(Settings& locSettings, std::string ObjectN
 
 void LinearMagneticSolver::ReadInput(const std::string InputFileName)
 {
-    std::fstream inp(InputFileName.c_str(), std::ios::in);
+    std::stringstream inp = FileInterface::OpenInput(InputFileName);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File " + InputFileName + " could not be opened",
@@ -82,7 +94,6 @@ void LinearMagneticSolver::ReadInput(const std::string InputFileName)
 
     ReadInput(data);
 
-    inp.close();
 }
 
 void LinearMagneticSolver::ReadInput(std::stringstream& inp)
@@ -102,6 +113,22 @@ void LinearMagneticSolver::ReadInput(std::stringstream& inp)
     dH0y_dz = FileInterface::ReadParameterD(inp, moduleLocation,"H0YZ",   false, 0.0);
     dH0z_dz = FileInterface::ReadParameterD(inp, moduleLocation,"H0ZZ",   false, 0.0);
     //MaxResidual = UserInterface::ReadParameterD(inp, moduleLocation,"MaxRes", false, 1.0e-2);
+    MaxIterations  = FileInterface::ReadParameterI(inp, moduleLocation, "MaxIterations",  false, MaxIterations);
+    LinearSolver   = FileInterface::ReadParameterK(inp, moduleLocation, "LinearSolver",   false, LinearSolver);
+    Preconditioner = FileInterface::ReadParameterK(inp, moduleLocation, "Preconditioner", false, Preconditioner);
+
+    if(LinearSolver != "BICGSTAB" and LinearSolver != "BICG")
+    {
+        ConsoleOutput::WriteExit("Unknown LinearSolver \"" + LinearSolver + "\", use BiCGStab or BiCG",
+                                 thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    if(Preconditioner != "FFT" and Preconditioner != "JACOBI" and Preconditioner != "NONE")
+    {
+        ConsoleOutput::WriteExit("Unknown Preconditioner \"" + Preconditioner + "\", use FFT, Jacobi or None",
+                                 thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
 
     PhaseChi.resize(Nphases);
     for (size_t i = 0; i < Nphases; ++i)
@@ -141,6 +168,40 @@ void LinearMagneticSolver::Solve(const BoundaryConditions& BC, double MaxResidua
     OP_Exit(EXIT_FAILURE);
 #endif
 
+    const auto start = std::chrono::steady_clock::now();
+
+    if(LinearSolver == "BICG")
+    {
+        SolveAssembled(BC, MaxResidual);
+    }
+    else
+    {
+        /* The potential of the previous solve is the initial guess. */
+        SetupOperator(BC);
+        Iterations = SystemOfLinearEquationsSolvers::BiCGStab(
+            [this](const std::vector<double>& in, std::vector<double>& out){ApplyOperator(in, out);},
+            [this](const std::vector<double>& in, std::vector<double>& out){ApplyPreconditioner(in, out);},
+            [this](const std::vector<double>& r){return ScaledResidual(r);},
+            x, b, MaxResidual, MaxIterations);
+    }
+
+    SolveTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ConsoleOutput::WriteStandard("Magnetic solver iterations", Iterations);
+    ConsoleOutput::WriteStandard("Magnetic solver time [s]", SolveTime);
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,phi,0)
+    {
+        phi(i,j,k) = x[idx(i,j,k)];
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    BC.SetX(phi);
+    BC.SetY(phi);
+    BC.SetZ(phi);
+}
+
+void LinearMagneticSolver::SolveAssembled(const BoundaryConditions& BC, const double MaxResidual)
+{
     A.clear();
     for (int i = 0; i < Grid.Nx; ++i)
     for (int j = 0; j < Grid.Ny; ++j)
@@ -226,17 +287,235 @@ void LinearMagneticSolver::Solve(const BoundaryConditions& BC, double MaxResidua
     //SystemOfLinearEquationsSolvers::Pivote(A,b);
     SystemOfLinearEquationsSolvers::FastPivote(A,b);
     SystemOfLinearEquationsSolvers::PreconditionJacobi(A,b);
-    SystemOfLinearEquationsSolvers::BiconjugateGradient(A,x,b,MaxResidual);
+    Iterations = SystemOfLinearEquationsSolvers::BiconjugateGradient(A,x,b,MaxResidual);
+}
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,phi,0)
+static std::vector<int> NeighbourTable(const int N, const int direction,
+                                       const BoundaryConditionTypes BCType)
+{
+    std::vector<int> table(N);
+    for(int i = 0; i < N; i++)
     {
-        phi(i,j,k) = x[idx(i,j,k)];
+        int n = i + direction;
+        if(n < 0 or n >= N)
+        {
+            switch(BCType)
+            {
+                case BoundaryConditionTypes::Periodic: { n = (n + N) % N; break; }
+                case BoundaryConditionTypes::NoFlux:   { n = (N > 1) ? i - direction : i; break; }
+                case BoundaryConditionTypes::Fixed:    { n = -1; break; } // Potential outside of the domain is zero
+                default:
+                {
+                    ConsoleOutput::WriteExit("Boundary condition not implemented", "LinearMagneticSolver", "SetupOperator()");
+                    OP_Exit(EXIT_FAILURE);
+                }
+            }
+        }
+        table[i] = n;
+    }
+    return table;
+}
+
+std::array<double,7> LinearMagneticSolver::Stencil(const int i, const int j, const int k) const
+{
+    const double dchi_dx = (Grid.dNx) ? (chi(i+1,j,k)-chi(i-1,j,k))/2.0/Grid.dx : 0;
+    const double dchi_dy = (Grid.dNy) ? (chi(i,j+1,k)-chi(i,j-1,k))/2.0/Grid.dx : 0;
+    const double dchi_dz = (Grid.dNz) ? (chi(i,j,k+1)-chi(i,j,k-1))/2.0/Grid.dx : 0;
+
+    const double mu_rel = (chi(i,j,k)+1);
+
+    return {-6.0*mu_rel/Grid.dx/Grid.dx,
+             dchi_dx/2.0/Grid.dx + mu_rel/Grid.dx/Grid.dx,
+            -dchi_dx/2.0/Grid.dx + mu_rel/Grid.dx/Grid.dx,
+             dchi_dy/2.0/Grid.dx + mu_rel/Grid.dx/Grid.dx,
+            -dchi_dy/2.0/Grid.dx + mu_rel/Grid.dx/Grid.dx,
+             dchi_dz/2.0/Grid.dx + mu_rel/Grid.dx/Grid.dx,
+            -dchi_dz/2.0/Grid.dx + mu_rel/Grid.dx/Grid.dx};
+}
+
+void LinearMagneticSolver::SetupOperator(const BoundaryConditions& BC)
+{
+    NeighbourXP = NeighbourTable(Grid.Nx, +1, BC.BCNX);
+    NeighbourXM = NeighbourTable(Grid.Nx, -1, BC.BC0X);
+    NeighbourYP = NeighbourTable(Grid.Ny, +1, BC.BCNY);
+    NeighbourYM = NeighbourTable(Grid.Ny, -1, BC.BC0Y);
+    NeighbourZP = NeighbourTable(Grid.Nz, +1, BC.BCNZ);
+    NeighbourZM = NeighbourTable(Grid.Nz, -1, BC.BC0Z);
+
+    double SumMu = 0.0;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,chi,0,reduction(+:SumMu))
+    {
+        const double mu_rel = (chi(i,j,k)+1);
+
+        const double dchi_dx = (Grid.dNx) ? (chi(i+1,j,k)-chi(i-1,j,k))/2.0/Grid.dx : 0;
+        const double dchi_dy = (Grid.dNy) ? (chi(i,j+1,k)-chi(i,j-1,k))/2.0/Grid.dx : 0;
+        const double dchi_dz = (Grid.dNz) ? (chi(i,j,k+1)-chi(i,j,k-1))/2.0/Grid.dx : 0;
+
+        const double dphi0_dx = (Grid.dNx) ?  -H0x - (dH0x_dx*i + dH0x_dy*j + dH0x_dz*k)*Grid.dx : 0;
+        const double dphi0_dy = (Grid.dNy) ?  -H0y - (dH0y_dx*i + dH0y_dy*j + dH0y_dz*k)*Grid.dx : 0;
+        const double dphi0_dz = (Grid.dNz) ?  -H0z - (dH0z_dx*i + dH0z_dy*j + dH0z_dz*k)*Grid.dx : 0;
+        const double Laplacephi0 = -dH0x_dx - dH0y_dy - dH0z_dz;
+
+        b[idx(i,j,k)] = -dchi_dx*dphi0_dx - dchi_dy*dphi0_dy - dchi_dz*dphi0_dz - mu_rel*Laplacephi0;
+
+        /* Neighbours mapped onto the cell itself contribute to the diagonal */
+        const std::array<double,7> c = Stencil(i,j,k);
+        double diagonal = c[0];
+        if(NeighbourXP[i] == i) diagonal += c[1];
+        if(NeighbourXM[i] == i) diagonal += c[2];
+        if(NeighbourYP[j] == j) diagonal += c[3];
+        if(NeighbourYM[j] == j) diagonal += c[4];
+        if(NeighbourZP[k] == k) diagonal += c[5];
+        if(NeighbourZM[k] == k) diagonal += c[6];
+        Diagonal[idx(i,j,k)] = diagonal;
+
+        SumMu += mu_rel;
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
-    BC.SetX(phi);
-    BC.SetY(phi);
-    BC.SetZ(phi);
+    PreconditionerMu = SumMu/double(Grid.LocalNumberOfCells());
+
+    if(Preconditioner == "FFT" and ForwardPlan == nullptr)
+    {
+        SetupFFTPreconditioner(BC);
+    }
+}
+
+void LinearMagneticSolver::ApplyOperator(const std::vector<double>& in, std::vector<double>& out) const
+{
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,chi,0,)
+    {
+        const std::array<double,7> c = Stencil(i,j,k);
+
+        double sum = c[0]*in[idx(i,j,k)];
+        if(NeighbourXP[i] >= 0) sum += c[1]*in[idx(NeighbourXP[i],j,k)];
+        if(NeighbourXM[i] >= 0) sum += c[2]*in[idx(NeighbourXM[i],j,k)];
+        if(NeighbourYP[j] >= 0) sum += c[3]*in[idx(i,NeighbourYP[j],k)];
+        if(NeighbourYM[j] >= 0) sum += c[4]*in[idx(i,NeighbourYM[j],k)];
+        if(NeighbourZP[k] >= 0) sum += c[5]*in[idx(i,j,NeighbourZP[k])];
+        if(NeighbourZM[k] >= 0) sum += c[6]*in[idx(i,j,NeighbourZM[k])];
+        out[idx(i,j,k)] = sum;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+double LinearMagneticSolver::ScaledResidual(const std::vector<double>& r) const
+{
+    const size_t N = r.size();
+    double MaxValue = 0.0;
+    #pragma omp parallel for reduction(max:MaxValue)
+    for (size_t n = 0; n < N; n++)
+    {
+        MaxValue = std::max(MaxValue, std::abs(r[n]/Diagonal[n]));
+    }
+    return MaxValue;
+}
+
+/// Real-to-real transform and eigenvalues of the 1D discrete Laplacian for the boundary conditions BC0 and BCN
+static bool LaplaceTransform(const int N, const BoundaryConditionTypes BC0,
+                             const BoundaryConditionTypes BCN,
+                             fftw_r2r_kind& forward, fftw_r2r_kind& backward,
+                             std::vector<double>& lambda, double& norm)
+{
+    lambda.assign(N, 0.0);
+    if(BC0 != BCN) return false;
+
+    if(N == 1)
+    {
+        forward = backward = FFTW_R2HC;                                         // Identity
+        lambda[0] = (BC0 == BoundaryConditionTypes::Fixed) ? -2.0 : 0.0;
+        norm = 1.0;
+        return true;
+    }
+    switch(BC0)
+    {
+        case BoundaryConditionTypes::Periodic:
+        {
+            forward  = FFTW_R2HC;
+            backward = FFTW_HC2R;
+            for(int p = 0; p < N; p++) lambda[p] = 2.0*cos(2.0*Pi*p/N) - 2.0;
+            norm = N;
+            return true;
+        }
+        case BoundaryConditionTypes::NoFlux:
+        {
+            forward = backward = FFTW_REDFT00;
+            for(int p = 0; p < N; p++) lambda[p] = 2.0*cos(Pi*p/(N-1)) - 2.0;
+            norm = 2.0*(N-1);
+            return true;
+        }
+        case BoundaryConditionTypes::Fixed:
+        {
+            forward = backward = FFTW_RODFT00;
+            for(int p = 0; p < N; p++) lambda[p] = 2.0*cos(Pi*(p+1)/(N+1)) - 2.0;
+            norm = 2.0*(N+1);
+            return true;
+        }
+        default: return false;
+    }
+}
+
+void LinearMagneticSolver::SetupFFTPreconditioner(const BoundaryConditions& BC)
+{
+    fftw_r2r_kind forwardX, forwardY, forwardZ, backwardX, backwardY, backwardZ;
+    double normX = 1.0, normY = 1.0, normZ = 1.0;
+
+    FFTPreconditioner = LaplaceTransform(Grid.Nx, BC.BC0X, BC.BCNX, forwardX, backwardX, LambdaX, normX) and
+                        LaplaceTransform(Grid.Ny, BC.BC0Y, BC.BCNY, forwardY, backwardY, LambdaY, normY) and
+                        LaplaceTransform(Grid.Nz, BC.BC0Z, BC.BCNZ, forwardZ, backwardZ, LambdaZ, normZ);
+    if(not FFTPreconditioner)
+    {
+        ConsoleOutput::WriteWarning("FFT preconditioner requires equal boundary conditions on opposite sides, using Jacobi",
+                                    thisclassname, "SetupFFTPreconditioner()");
+        Preconditioner = "JACOBI";
+        return;
+    }
+    PreconditionerNorm = normX*normY*normZ;
+
+    /* idx() runs fastest along X, the last dimension of the FFTW row-major layout */
+    Work.resize(Grid.LocalNumberOfCells());
+    FFTWPlanner::ImportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+    ForwardPlan  = fftw_plan_r2r_3d(Grid.Nz, Grid.Ny, Grid.Nx, Work.data(), Work.data(),
+                                    forwardZ, forwardY, forwardX, FFTWPlanner::Flags());
+    BackwardPlan = fftw_plan_r2r_3d(Grid.Nz, Grid.Ny, Grid.Nx, Work.data(), Work.data(),
+                                    backwardZ, backwardY, backwardX, FFTWPlanner::Flags());
+    FFTWPlanner::ExportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+}
+
+void LinearMagneticSolver::ApplyPreconditioner(const std::vector<double>& in, std::vector<double>& out)
+{
+    const size_t N = in.size();
+    if(Preconditioner == "NONE")
+    {
+        out = in;
+    }
+    else if(Preconditioner == "JACOBI")
+    {
+        #pragma omp parallel for
+        for (size_t n = 0; n < N; n++)
+        {
+            out[n] = in[n]/Diagonal[n];
+        }
+    }
+    else
+    {
+        /* Solves mean(mu)*Laplace(out) = in in the eigenbasis of the discrete
+        Laplacian, the null space (pure periodic or NoFlux) is removed. */
+        const double Scale = Grid.dx*Grid.dx/(PreconditionerMu*PreconditionerNorm);
+
+        Work = in;
+        fftw_execute(ForwardPlan);
+        #pragma omp parallel for collapse(3)
+        for (int k = 0; k < Grid.Nz; k++)
+        for (int j = 0; j < Grid.Ny; j++)
+        for (int i = 0; i < Grid.Nx; i++)
+        {
+            const double lambda = LambdaX[i] + LambdaY[j] + LambdaZ[k];
+            Work[idx(i,j,k)] *= (lambda < 0.0) ? Scale/lambda : 0.0;
+        }
+        fftw_execute(BackwardPlan);
+        out = Work;
+    }
 }
 
 void LinearMagneticSolver::CalcForceDensity(ElasticProperties& EP,
@@ -275,4 +554,11 @@ void LinearMagneticSolver::WriteVTK(const int tStep, const Settings& locSettings
 
     VTK::Write(Filename, locSettings, ListOfFields);
 }
+
+size_t LinearMagneticSolver::AllocatedMemory(void) const
+{
+    return chi.AllocatedMemory() +
+           phi.AllocatedMemory();
+}
+
 }
@@ -71,7 +71,7 @@ void MagneticProperties::ReadInput(std::string InputFileName)
     ConsoleOutput::WriteLineInsert("Magnetic properties");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened",
@@ -83,8 +83,6 @@ void MagneticProperties::ReadInput(std::string InputFileName)
 
     ReadInput(data);
 
-    inp.close();
-
     ConsoleOutput::WriteLine();
 }
 
@@ -182,4 +180,11 @@ void MagneticProperties::SetBoundaryConditions(const BoundaryConditions& BC)
     BC.SetYVector(Magnetisation);
     BC.SetZVector(Magnetisation);
 }
+
+size_t MagneticProperties::AllocatedMemory(void) const
+{
+    return Magnetisation.AllocatedMemory() +
+           MagneticField.AllocatedMemory();
+}
+
 }// end of namespace openphase
@@ -0,0 +1,87 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "MappedFile.h"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace openphase
+{
+using namespace std;
+
+bool MappedFile::Open(const string& FileName)
+{
+    Close();
+    #ifndef WIN32
+    int fd = open(FileName.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    struct stat st;
+    if(fstat(fd, &st) == 0 and st.st_size > 0)
+    {
+        void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(ptr != MAP_FAILED)
+        {
+            Data = static_cast<const char*>(ptr);
+            Size = st.st_size;
+            Mapped = true;
+        }
+    }
+    close(fd);
+    if(Mapped) return true;
+    #endif
+
+    /* Falls back to reading the whole file */
+    ifstream inp(FileName.c_str(), ios::in | ios::binary | ios::ate);
+    if(!inp) return false;
+    Buffer.resize(inp.tellg());
+    inp.seekg(0);
+    inp.read(Buffer.data(), Buffer.size());
+    Data = Buffer.data();
+    Size = Buffer.size();
+    return bool(inp);
+}
+
+void MappedFile::Close(void)
+{
+    #ifndef WIN32
+    if(Mapped)
+    {
+        munmap(const_cast<char*>(Data), Size);
+    }
+    #endif
+    Buffer.clear();
+    Buffer.shrink_to_fit();
+    Data = nullptr;
+    Size = 0;
+    Mapped = false;
+}
+
+}// namespace openphase
@@ -31,6 +31,7 @@
 #include "Temperature.h"
 #include "BoundaryConditions.h"
 #include "VTK.h"
+#include "LoadBalancer.h"
 
 namespace openphase
 {
@@ -53,6 +54,7 @@ void MassDensity::Initialize(Settings& locSettings, std::string ObjectNameSuffix
 
     locSettings.AddForAdvection(*this);
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
     locSettings.AddForReading(*this);
 
     initialized = true;
@@ -64,7 +66,7 @@ void MassDensity::ReadInput(const string InputFileName)
     ConsoleOutput::WriteLineInsert("Density input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -75,7 +77,6 @@ void MassDensity::ReadInput(const string InputFileName)
     data << inp.rdbuf();
     ReadInput(data);
 
-    inp.close();
 }
 
 void MassDensity::ReadInput(stringstream& inp)
@@ -140,6 +141,12 @@ void MassDensity::SetInitial(PhaseField& PF)
     OMP_PARALLEL_STORAGE_LOOP_END
 }
 
+size_t MassDensity::AllocatedMemory(void) const
+{
+    return Phase.AllocatedMemory() +
+           Total.AllocatedMemory();
+}
+
 void MassDensity::Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC)
 {
     Total.Remesh(newNx, newNy, newNz);
@@ -151,29 +158,23 @@ void MassDensity::Remesh(int newNx, int newNy, int newNz, const BoundaryConditio
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
-void MassDensity::MoveFrame(const int dx, const int dy, const int dz, const BoundaryConditions& BC)
+void MassDensity::Repartition(const BoundaryConditions& BC)
 {
-    int xBeg = (dx >= 0) + (dx < 0)*(Grid.Nx) - 1;
-    int xEnd = (dx >= 0)*(Grid.Nx) + (dx < 0) - 1;
-    int xInc = 1 - 2*(dx < 0);
+    const GridParameters OldGrid = Grid;
+    Grid.ApplyCutPlanes();
 
-    int yBeg = (dy >= 0) + (dy < 0)*(Grid.Ny) - 1;
-    int yEnd = (dy >= 0)*(Grid.Ny) + (dy < 0) - 1;
-    int yInc = 1 - 2*(dy < 0);
+    LoadBalancer::Migrate(Total, OldGrid, Grid);
+    LoadBalancer::Migrate(Phase, OldGrid, Grid);
 
-    int zBeg = (dz >= 0) + (dz < 0)*(Grid.Nz) - 1;
-    int zEnd = (dz >= 0)*(Grid.Nz) + (dz < 0) - 1;
-    int zInc = 1 - 2*(dz < 0);
+    SetBoundaryConditions(BC);
+}
 
+void MassDensity::MoveFrame(const int dx, const int dy, const int dz, const BoundaryConditions& BC)
+{
     SetBoundaryConditions(BC);
 
-    for(int i = xBeg; ((dx >= 0) and (i <= xEnd)) or ((dx < 0) and (i >= xEnd)); i += xInc)
-    for(int j = yBeg; ((dy >= 0) and (j <= yEnd)) or ((dy < 0) and (j >= yEnd)); j += yInc)
-    for(int k = zBeg; ((dz >= 0) and (k <= zEnd)) or ((dz < 0) and (k >= zEnd)); k += zInc)
-    {
-        Phase(i,j,k) = Phase(i + dx, j + dy, k + dz);
-        Total(i, j, k) = Total(i + dx, j + dy, k + dz);
-    }
+    Phase.Shift(dx, dy, dz);
+    Total.Shift(dx, dy, dz);
 
     SetBoundaryConditions(BC);
 
@@ -52,7 +52,7 @@ void MechanicalLoads::ReadInput(const std::string InputFileName)
     ConsoleOutput::WriteLineInsert("MechanicalLoads input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -63,7 +63,6 @@ void MechanicalLoads::ReadInput(const std::string InputFileName)
     std::stringstream data;
     data << inp.rdbuf();
     ReadInput(data);
-    inp.close();
 
     ConsoleOutput::WriteLine();
 }
@@ -26,6 +26,7 @@
 
 #include "MovingFrame.h"
 #include "Settings.h"
+#include "PhaseField.h"
 
 namespace openphase
 {
@@ -36,6 +37,8 @@ MovingFrame::MovingFrame()
     trigger_phase_idx = -1;
     trigger_position  = -1;
     moving_direction  = "NN";
+    Axis = -1;
+    Sign = 1;
 }
 
 void MovingFrame::Initialize(Settings& locSettings, std::string ObjectNameSuffix)
@@ -46,6 +49,9 @@ void MovingFrame::Initialize(Settings& locSettings, std::string ObjectNameSuffix
     trigger_phase_idx = -1;
     trigger_position  = -1;
     moving_direction  = "NN";
+    Axis = -1;
+    Sign = 1;
+    Objects.clear();
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -56,7 +62,7 @@ void MovingFrame::ReadInput(const std::string InputFileName)
     ConsoleOutput::WriteLineInsert("MovingFrame input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -67,7 +73,6 @@ void MovingFrame::ReadInput(const std::string InputFileName)
     std::stringstream data;
     data << inp.rdbuf();
     ReadInput(data);
-    inp.close();
 
     ConsoleOutput::WriteLine();
 }
@@ -80,8 +85,55 @@ void MovingFrame::ReadInput(std::stringstream& inp)
     trigger_position  = FileInterface::ReadParameterI(inp, moduleLocation, string("TriggerPosition"), false, -1);
     moving_direction  = FileInterface::ReadParameterS(inp, moduleLocation, string("MovingDirection"), false, "No");
 
+    string direction = moving_direction;
+    std::transform(direction.begin(), direction.end(), direction.begin(), ::toupper);
+    Sign = 1;
+    if(!direction.empty() and (direction[0] == '+' or direction[0] == '-'))
+    {
+        Sign = (direction[0] == '-') ? -1 : 1;
+        direction.erase(0, 1);
+    }
+    if(direction == "X")      Axis = 0;
+    else if(direction == "Y") Axis = 1;
+    else if(direction == "Z") Axis = 2;
+    else                      Axis = -1;
+
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteBlankLine();
 }
 
+void MovingFrame::Register(OPObject& Object, const BoundaryConditions& BC)
+{
+    Objects.push_back({&Object, &BC});
+}
+
+bool MovingFrame::Triggered(PhaseField& Phase)
+{
+    if(Axis < 0 or trigger_phase_idx >= Phase.Nphases or
+       trigger_position == size_t(-1))
+    {
+        return false;
+    }
+    Phase.TrackFront(trigger_phase_idx, Axis);
+    const long int position = Phase.FrontPosition(Sign > 0);
+    if(position < 0) return false;
+
+    return (Sign > 0) ? (position >= long(trigger_position)) :
+                        (position <= long(trigger_position));
+}
+
+bool MovingFrame::Apply(PhaseField& Phase)
+{
+    if(not Triggered(Phase)) return false;
+
+    const int dx = (Axis == 0)*Sign;
+    const int dy = (Axis == 1)*Sign;
+    const int dz = (Axis == 2)*Sign;
+    for(auto& [Object, BC] : Objects)
+    {
+        Object->MoveFrame(dx, dy, dz, *BC);
+    }
+    return true;
+}
+
 }// namespace openphase
@@ -24,13 +24,20 @@
  *
  */
 
+#ifdef MPI_PARALLEL
+#include "mpi_wrapper.h"
+#else
+#include "fftw3.h"
+#endif
+
 #include "Includes.h"
 #include "DrivingForce.h"
 #include "Noise.h"
+#include "FFTWPlanner.h"
 #include "Settings.h"
 #include "Temperature.h"
 #include "VTK.h"
-#include "fftw3.h"
+#include "Tools/RandomNumbers.h"
 
 namespace openphase
 {
@@ -40,12 +47,19 @@ Noise::~Noise(void)
 {
     if (initialized)
     {
-        delete[] RandomFourier;
-        delete[] RandomReal;
-        fftw_destroy_plan(FFTBackward);
-//#ifdef MPI_PARALLEL // TODO implement MPI
-//        op_fftw_mpi_cleanup();
-//#endif
+        if(Pending.valid()) Pending.wait();
+#ifdef MPI_PARALLEL
+        if(MPI_3D_DECOMPOSITION)
+        {
+            Pencil.Free();
+        }
+        else
+        {
+            fftw_destroy_plan(SlabPlan);
+        }
+#else
+        FFT.Free();
+#endif
 #ifdef _OPENMP
         fftw_cleanup_threads();
 #endif
@@ -58,32 +72,84 @@ void Noise::Initialize(Settings& locSettings, std::string ObjectNameSuffix)
     thisobjectname = thisclassname + ObjectNameSuffix;
 
     Grid = locSettings.Grid;
+    Grid.Nz2 = Grid.Nz/2 + 1;
 
     Nphases   = locSettings.Nphases;
+    TimeSteps = 1;
+    Generation = 0;
+    Asynchronous = false;
 
-    // Allocate three-dimensional Fourier space noise
-    RandomFourier = new complex<double>[Grid.LocalNumberOfCells()]();
-    RandomReal    = new complex<double>[Grid.LocalNumberOfCells()]();
-
-    // Allocate raw Noise Storage
+    // Allocate raw noise, next noise and increment storages
     Raw.Allocate(Grid, 0);
+    Next.Allocate(Grid, 0);
+    Increment.Allocate(Grid, 0);
 
-    // Assign storages to fftw pointers
-    fftw_In  = reinterpret_cast<fftw_complex*>(RandomFourier);
-    fftw_Out = reinterpret_cast<fftw_complex*>(RandomReal);
-
-    // Create FFT-Plan, which determines how the FFT will be executed
+    /* The transform array is owned by the noise and not borrowed from the
+    FFTWorkspace pool, as the next field is generated in the background
+    while the other spectral solvers may use the pool */
 #ifdef _OPENMP
     fftw_init_threads();
+#endif
+#ifdef MPI_PARALLEL
+    op_fftw_mpi_init();
+    if(MPI_3D_DECOMPOSITION)
+    {
+        SpectralSize = PencilFFT::LocalSize(Grid);
+    }
+    else
+    {
+        ptrdiff_t local_n0      = 0;
+        ptrdiff_t local_0_start = 0;
+        SpectralSize = 2*op_fftw_mpi_local_size_3d(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz, OP_MPI_COMM_WORLD,
+                                                   &local_n0, &local_0_start);
+    }
+#else
+    SpectralSize = Grid.Nx*Grid.Ny*Grid.Nz2*2;
+#endif
+    SpectralData.assign((SpectralSize*sizeof(fft_real) + sizeof(double) - 1)/sizeof(double), 0.0);
+
+    // Create the plan once, it is reused by every generation
+#ifdef _OPENMP
     fftw_plan_with_nthreads(omp_get_max_threads());
 #endif
-    FFTBackward = fftw_plan_dft_3d(Grid.Nx, Grid.Ny, Grid.Nz, fftw_In,fftw_Out,FFTW_BACKWARD,FFTW_ESTIMATE);
+    FFTWPlanner::ImportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
+
+    SpectralN[0] = Grid.Nx;      SpectralOffset[0] = Grid.OffsetX;
+    SpectralN[1] = Grid.Ny;      SpectralOffset[1] = Grid.OffsetY;
+    SpectralN[2] = Grid.Nz2;     SpectralOffset[2] = Grid.OffsetZ;
+
+    fft_real* Data = reinterpret_cast<fft_real*>(SpectralData.data());
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
+    {
+        Pencil.Initialize(Grid, 1, Data, FFTWPlanner::Flags());
+        for(int d = 0; d < 3; d++)
+        {
+            SpectralN[d]      = Pencil.SpectralN[d];
+            SpectralOffset[d] = Pencil.SpectralOffset[d];
+        }
+    }
+    else
+    {
+        SlabPlan = op_fftw_mpi_plan_dft_c2r_3d
+                        (Grid.TotalNx, Grid.TotalNy, Grid.TotalNz,
+                         reinterpret_cast<fftw_complex*> (Data), Data,
+                         OP_MPI_COMM_WORLD,
+                         FFTWPlanner::Flags());
+    }
+#else
+    FFT.Initialize(Grid.Nx, Grid.Ny, Grid.Nz, 1, SpectralSize, Data, FFTWPlanner::Flags());
+#endif
+    FFTWPlanner::ExportWisdom(Grid.TotalNx, Grid.TotalNy, Grid.TotalNz);
 
-    // Initialize random number distribution
-    distribution = normal_distribution<double>(0.0,0.5);
+    const long int N[3] = {Grid.TotalNx, Grid.TotalNy, Grid.TotalNz};
+    Q.Initialize(N, SpectralN, SpectralOffset, 1.0/Grid.dx);
 
-    size_t seed = std::chrono::system_clock::now().time_since_epoch().count();
-    generator = std::default_random_engine(seed);
+    // All processes have to draw the same random coefficients
+    RandomSeed = std::chrono::system_clock::now().time_since_epoch().count() & 0x7FFFFFFF;
+#ifdef MPI_PARALLEL
+    OP_MPI_Bcast(&RandomSeed, 1, OP_MPI_INT, 0, OP_MPI_COMM_WORLD);
+#endif
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -94,7 +160,7 @@ void Noise::ReadInput(const std::string InputFileName)
     ConsoleOutput::WriteLineInsert("Noise input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -105,7 +171,6 @@ void Noise::ReadInput(const std::string InputFileName)
     std::stringstream data;
     data << inp.rdbuf();
     ReadInput(data);
-    inp.close();
 }
 
 void Noise::ReadInput(std::stringstream& inp)
@@ -117,6 +182,14 @@ void Noise::ReadInput(std::stringstream& inp)
     TimeSteps        = FileInterface::ReadParameterI(inp, moduleLocation, string("iTime"));
     CutOffWaveLength = FileInterface::ReadParameterI(inp, moduleLocation, string("dWaveLength"));
     FixAmpl          = FileInterface::ReadParameterI(inp, moduleLocation, string("dFixAmpl"));
+    int Seed         = FileInterface::ReadParameterI(inp, moduleLocation, string("RandomSeed"), false, -1);
+    Asynchronous     = FileInterface::ReadParameterB(inp, moduleLocation, string("Asynchronous"), false, true);
+
+    if (Seed >= 0) RandomSeed = Seed;
+#ifdef MPI_PARALLEL
+    // The transforms are collective, they can not run in a background thread
+    Asynchronous = false;
+#endif
 
     // Check if the input TimeSteps makes sense
     if (TimeSteps < 1)
@@ -124,7 +197,7 @@ void Noise::ReadInput(std::stringstream& inp)
         std::string message = "A input value TimeSteps < 1 does not make sense! "
             "Set TimeSteps to 1!";
         ConsoleOutput::WriteWarning( message, thisclassname, "ReadInput");
-        TimeSteps = 0;
+        TimeSteps = 1;
     }
 
     // Check if the input CutOffWaveLength makes sense
@@ -139,53 +212,107 @@ void Noise::ReadInput(std::stringstream& inp)
     ConsoleOutput::WriteBlankLine();
 }
 
-void Noise::Generate(void)
+void Noise::ExecuteBackwardFFT(void)
 {
-    double Lx = 2.0 * Pi / (double(Grid.Nx) * Grid.dx);
-    double Ly = 2.0 * Pi / (double(Grid.Ny) * Grid.dx);
-    double Lz = 2.0 * Pi / (double(Grid.Nz) * Grid.dx);
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Raw,0,)
+#ifdef MPI_PARALLEL
+    if(MPI_3D_DECOMPOSITION)
     {
-        dVector3 WaveVector;
-        WaveVector[0] = Lx*(i*(i <= Grid.Nx/2) - (Grid.Nx-i)*(i > Grid.Nx/2));
-        WaveVector[1] = Ly*(j*(j <= Grid.Ny/2) - (Grid.Ny-j)*(j > Grid.Ny/2));
-        WaveVector[2] = Lz*(k*(k <= Grid.Nz/2) - (Grid.Nz-k)*(k > Grid.Nz/2));
+        Pencil.Backward();
+        return;
+    }
+    fftw_execute(SlabPlan);
+#else
+    FFT.CopyToDevice(0, 1);
+    FFT.Backward();
+    FFT.CopyToHost(0, 1);
+#endif
+}
 
-        if(WaveVector.abs() < 2.0 * Pi/CutOffWaveLength)
-        {
-            // Generate Gaussian white noise coefficients
-            complex<double> cijk{distribution(generator),distribution(generator)};
-            //cijk /= abs(cijk);
+void Noise::Generate(void)
+{
+    const long int Ny  = Grid.TotalNy;
+    const long int Nz  = Grid.TotalNz;
+    const long int Nz2 = Nz/2 + 1;
+    const double QCutOff = 2.0 * Pi/CutOffWaveLength;
+
+    /* Counter based random numbers: the coefficient of a wave vector depends
+    only on the seed, the generation and the global wave vector index, not on
+    the order in which the threads and processes draw them */
+    const RandomNumbers RNG(RandomSeed);
+    const uint32_t Step = Generation++;
+
+    const int SNx = SpectralN[0];
+    const int SNy = SpectralN[1];
+    const int SNz = SpectralN[2];
+    fft_real* Data = reinterpret_cast<fft_real*>(SpectralData.data());
+    complex<fft_real>* RandomFourier = reinterpret_cast<complex<fft_real>*>(Data);
+
+    #pragma omp parallel for collapse(3)
+    for(int i = 0; i < SNx; i++)
+    for(int j = 0; j < SNy; j++)
+    for(int k = 0; k < SNz; k++)
+    {
+        const long int ii = i + SpectralOffset[0];
+        const long int jj = j + SpectralOffset[1];
+        const long int kk = k + SpectralOffset[2];
 
-            // Store computed coefficient
-            RandomFourier[k + Grid.Nz*(j + Grid.Ny*i)] = cijk;
-        }
-        else
+        complex<double> cijk(0.0,0.0);
+        if(Q.Squared(i,j,k) < QCutOff*QCutOff)
         {
-            RandomFourier[k + Grid.Nz*(j + Grid.Ny*i)] = complex<double>(0.0,0.0);
+            // Gaussian white noise coefficient of the global wave vector index
+            const uint64_t Cell = kk + Nz2*(jj + Ny*ii);
+            cijk = complex<double>(0.5*RNG.Normal(0, Cell, Step, 0),
+                                   0.5*RNG.Normal(0, Cell, Step, 1));
         }
+        RandomFourier[k + SNz*(j + SNy*i)] = complex<fft_real>(cijk);
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
     // Do Fourier transform
-    fftw_execute(FFTBackward);
+    ExecuteBackwardFFT();
 
-    // Calculate global maximum of RandomReal
+    // Calculate global maximum of the real space noise
     double Max = 0.0;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Raw,0,reduction(max:Max))
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Next,0,reduction(max:Max))
     {
-        Max = max(Max, abs(real(RandomReal[k + Grid.Nz*(j + Grid.Ny*i)])));
+        Max = max(Max, abs(double(Data[k + 2*Grid.Nz2*(j + Grid.Ny*i)])));
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &Max, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    if(Max == 0.0) Max = 1.0;
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Next,0,)
+    {
+        Next(i,j,k) = Data[k + 2*Grid.Nz2*(j + Grid.Ny*i)]/Max;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+void Noise::StartGenerate(void)
+{
+    if(Asynchronous)
+    {
+        Pending = std::async(std::launch::async, [this]{Generate();});
+    }
+    else
+    {
+        Generate();
+    }
+}
+
+void Noise::SetIncrement(void)
+{
+    if(Pending.valid()) Pending.get();
 
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Raw,0,)
     {
-        RandomReal[k + Grid.Nz*(j + Grid.Ny*i)] /= Max;
-        RandomReal[k + Grid.Nz*(j + Grid.Ny*i)] -= Raw(i,j,k);
-        RandomReal[k + Grid.Nz*(j + Grid.Ny*i)] /= TimeSteps;
+        Increment(i,j,k) = (Next(i,j,k) - Raw(i,j,k))/TimeSteps;
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+
+    // The following field is generated while the next interval runs
+    StartGenerate();
 }
 
 void Noise::UpdateRaw(int tStep)
@@ -193,30 +320,31 @@ void Noise::UpdateRaw(int tStep)
     if (tStep == 0)
     {
         // Generate initial noise distribution
+        if(Pending.valid()) Pending.get();
         Generate();
 
         // Save initial noise distribution and add it to the driving force
-
         OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Raw,0,)
         {
             // Set initial noise
-            Raw(i,j,k) = TimeSteps * real(RandomReal[k + Grid.Nz*(j + Grid.Ny*i)]);
+            Raw(i,j,k) = Next(i,j,k);
         }
         OMP_PARALLEL_STORAGE_LOOP_END
         // Generate new noise distribution in order to able to interpolate
         // between the old distribution and the new one.
-        Generate();
+        StartGenerate();
+        SetIncrement();
     }
     else
     {
         // First check if a new noise Distribution has to be generated
-        if (!(tStep%TimeSteps)) Generate();
+        if (!(tStep%TimeSteps)) SetIncrement();
 
-        // Interpolate between old and new noise distribution by adding RandomReal
+        // Interpolate between old and new noise distribution
         OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Raw,0,)
         {
             // Compute noise for this time step
-            Raw(i,j,k) += real(RandomReal[k + Grid.Nz*(j + Grid.Ny*i)]);
+            Raw(i,j,k) += Increment(i,j,k);
         }
         OMP_PARALLEL_STORAGE_LOOP_END
     }
@@ -229,6 +357,10 @@ void Noise::UpdateRaw(int tStep)
         Max = max(Max, abs(Raw(i,j,k)));
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &Max, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    if(Max == 0.0) return;
 
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Raw,0,)
     {
@@ -279,4 +411,10 @@ void Noise::WriteVTK(const Settings& locSettings, const int tStep, const int pre
     VTK::Write(Filename, locSettings, ListOfFields, precision);
 }
 
+size_t Noise::AllocatedMemory(void) const
+{
+    return Raw.AllocatedMemory() + Next.AllocatedMemory() + Increment.AllocatedMemory()
+         + SpectralData.capacity()*sizeof(double);
+}
+
 }// end of name space
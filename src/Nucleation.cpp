@@ -34,12 +34,13 @@
 #include "Orientations.h"
 #include "ConsoleOutput.h"
 #include "SymmetryVariants.h"
+#include "LoadBalancer.h"
 
 namespace openphase
 {
 using namespace std;
 
-double NucleationParameters::SetSeedRadius()
+double NucleationParameters::SetSeedRadius(Philox4x32& Generator) const
 {
     double radius = 0.0;
 
@@ -47,17 +48,20 @@ double NucleationParameters::SetSeedRadius()
     {
         case NucleiSizeDistributions::Normal:
         {
-            radius = 0.5*SizeDistributionNormal(SizeGenerator);
+            normal_distribution<double> locDistribution(SizeDistributionNormal.param());
+            radius = 0.5*locDistribution(Generator);
             break;
         }
         case NucleiSizeDistributions::Cauchy:
         {
-            radius = 0.5*SizeDistributionCauchy(SizeGenerator);
+            cauchy_distribution<double> locDistribution(SizeDistributionCauchy.param());
+            radius = 0.5*locDistribution(Generator);
             break;
         }
         case NucleiSizeDistributions::Uniform:
         {
-            radius = 0.5*SizeDistributionUniform(SizeGenerator);
+            uniform_real_distribution<double> locDistribution(SizeDistributionUniform.param());
+            radius = 0.5*locDistribution(Generator);
             break;
         }
         case NucleiSizeDistributions::FixedRadius:
@@ -72,16 +76,14 @@ double NucleationParameters::SetSeedRadius()
             break;
         }
     }
-
-    if (radius == 0.0)
-    {
-        ConsoleOutput::WriteWarning("Seed radius has been set to zero. Check input Parameters!", "NucleationParametersEXP", "SetSeedRadius");
-    }
     return radius;
 }
-iVector3 NucleationParameters::SetSeedPosition()
+iVector3 NucleationParameters::SetSeedPosition(Philox4x32& Generator) const
 {
     iVector3 position{-1,-1,-1};
+    uniform_int_distribution<int> locDistributionX(PositionDistributionX.param());
+    uniform_int_distribution<int> locDistributionY(PositionDistributionY.param());
+    uniform_int_distribution<int> locDistributionZ(PositionDistributionZ.param());
 
     if(LocationMode == NucleiLocationModes::XBottom)
     {
@@ -93,7 +95,7 @@ iVector3 NucleationParameters::SetSeedPosition()
     }
     else
     {
-        position[0] = PositionDistributionX(PositionGeneratorX);
+        position[0] = locDistributionX(Generator);
     }
 
     if(LocationMode == NucleiLocationModes::YBottom)
@@ -106,7 +108,7 @@ iVector3 NucleationParameters::SetSeedPosition()
     }
     else
     {
-        position[1] = PositionDistributionY(PositionGeneratorY);
+        position[1] = locDistributionY(Generator);
     }
 
     if(LocationMode == NucleiLocationModes::ZBottom)
@@ -119,14 +121,16 @@ iVector3 NucleationParameters::SetSeedPosition()
     }
     else
     {
-        position[2] = PositionDistributionZ(PositionGeneratorZ);
+        position[2] = locDistributionZ(Generator);
     }
     return position;
 }
 
-Quaternion NucleationParameters::SetSeedOrientation()
+Quaternion NucleationParameters::SetSeedOrientation(Philox4x32& Generator) const
 {
     Quaternion loc_orientation;
+    uniform_real_distribution<double> locDistributionA(OrientationDistributionA.param());
+    uniform_real_distribution<double> locDistributionQ(OrientationDistributionQ.param());
 
     int active_dimensions = (PositionDistributionX.b() != 0)
                           + (PositionDistributionY.b() != 0)
@@ -147,9 +151,9 @@ Quaternion NucleationParameters::SetSeedOrientation()
                 double a2 = 0.0;
                 double a3 = 0.0;
 
-                if(PositionDistributionX.b() == 0) a1 = OrientationDistributionA(OrientationGenerator1);
-                if(PositionDistributionY.b() == 0) a2 = OrientationDistributionA(OrientationGenerator2);
-                if(PositionDistributionZ.b() == 0) a3 = OrientationDistributionA(OrientationGenerator3);
+                if(PositionDistributionX.b() == 0) a1 = locDistributionA(Generator);
+                if(PositionDistributionY.b() == 0) a2 = locDistributionA(Generator);
+                if(PositionDistributionZ.b() == 0) a3 = locDistributionA(Generator);
 
                 EulerAngles ph1({a1,a2,a3},XYZ);
 
@@ -158,9 +162,9 @@ Quaternion NucleationParameters::SetSeedOrientation()
             }
             case 3: // Full rotation freedom in 3D
             {
-                double u1 = OrientationDistributionQ(OrientationGenerator1);
-                double u2 = OrientationDistributionQ(OrientationGenerator2);
-                double u3 = OrientationDistributionQ(OrientationGenerator3);
+                double u1 = locDistributionQ(Generator);
+                double u2 = locDistributionQ(Generator);
+                double u3 = locDistributionQ(Generator);
 
                 Quaternion locQuaternion;
                 locQuaternion.set(sqrt(1.0-u1)*sin(2.0*Pi*u2),
@@ -267,30 +271,129 @@ bool NucleationParameters::CheckLocation(const PhaseField& Phase,
     return enable_seed;
 }
 
-bool NucleationParameters::PositionNotShielded(const iVector3 position) const
+bool NucleationParameters::PositionNotShielded(const iVector3 position,
+                                               const size_t First) const
 {
-    bool my_return = true;
-    double ShieldingRadiusSquare = ShieldingRadius*ShieldingRadius;
+    if(ShieldingRadius <= 0.0) return true;
+
+    const double ShieldingRadiusSquare = ShieldingRadius*ShieldingRadius;
 
-    long int TotalNx = PositionDistributionX.b();
-    long int TotalNy = PositionDistributionY.b();
-    long int TotalNz = PositionDistributionZ.b();
+    const long int TotalNx = PositionDistributionX.b();
+    const long int TotalNy = PositionDistributionY.b();
+    const long int TotalNz = PositionDistributionZ.b();
+
+    const int x = position.get_x();
+    const int y = position.get_y();
+    const int z = position.get_z();
+
+    auto Shielded = [&](const Nucleus& Seed)
+    {
+        const double xdis = std::min(std::fabs(x - Seed.position[0]), std::min( std::fabs(x - Seed.position[0] + TotalNx), std::fabs(x - Seed.position[0] - TotalNx)));
+        const double ydis = std::min(std::fabs(y - Seed.position[1]), std::min( std::fabs(y - Seed.position[1] + TotalNy), std::fabs(y - Seed.position[1] - TotalNy)));
+        const double zdis = std::min(std::fabs(z - Seed.position[2]), std::min( std::fabs(z - Seed.position[2] + TotalNz), std::fabs(z - Seed.position[2] - TotalNz)));
+        return xdis*xdis + ydis*ydis + zdis*zdis < ShieldingRadiusSquare;
+    };
 
-    for (auto it = GeneratedNuclei.begin(); it != GeneratedNuclei.end(); ++it)
+    if(ShieldingIndexed > GeneratedNuclei.size())
     {
-        int x = position.get_x();
-        int y = position.get_y();
-        int z = position.get_z();
-        const double xdis = std::min(std::fabs(x - it->position[0]), std::min( std::fabs(x - it->position[0] + TotalNx), std::fabs(x - it->position[0] - TotalNx)));
-        const double ydis = std::min(std::fabs(y - it->position[1]), std::min( std::fabs(y - it->position[1] + TotalNy), std::fabs(y - it->position[1] - TotalNy)));
-        const double zdis = std::min(std::fabs(z - it->position[2]), std::min( std::fabs(z - it->position[2] + TotalNz), std::fabs(z - it->position[2] - TotalNz)));
-        const double distanceSquare = xdis*xdis + ydis*ydis + zdis*zdis;
-        if(distanceSquare < ShieldingRadiusSquare)
+        /* Outdated binning, test all nuclei */
+        for(size_t idx = First; idx < GeneratedNuclei.size(); idx++)
+        if(Shielded(GeneratedNuclei[idx]))
         {
-            my_return = false;
+            return false;
         }
+        return true;
     }
-    return my_return;
+
+    /* Nuclei added since the last update of the binning */
+    for(size_t idx = std::max(First, ShieldingIndexed); idx < GeneratedNuclei.size(); idx++)
+    if(Shielded(GeneratedNuclei[idx]))
+    {
+        return false;
+    }
+
+    if(ShieldingIndexed <= First) return true;
+
+    /* Binned nuclei: bins are at least as wide as the shielding radius, only
+    the bin of the position and its periodic neighbours are tested */
+    const long int Total[3] = {TotalNx, TotalNy, TotalNz};
+    std::vector<long int> Neighbours[3];
+    for(int d = 0; d < 3; d++)
+    {
+        const long int N = ShieldingBinsN[d];
+        const long int P = Total[d];
+        const long int Wrapped = (P > 0) ? ((position[d] % P) + P) % P : 0;
+        const long int Bin = (P > 0) ? std::min(N - 1, Wrapped*N/P) : 0;
+        if(N <= 3)
+        {
+            for(long int b = 0; b < N; b++) Neighbours[d].push_back(b);
+        }
+        else
+        {
+            Neighbours[d] = {(Bin - 1 + N) % N, Bin, (Bin + 1) % N};
+        }
+    }
+
+    for(long int bx : Neighbours[0])
+    for(long int by : Neighbours[1])
+    for(long int bz : Neighbours[2])
+    {
+        auto Bin = ShieldingBins.find((bx*ShieldingBinsN[1] + by)*ShieldingBinsN[2] + bz);
+        if(Bin != ShieldingBins.end())
+        for(size_t idx : Bin->second)
+        if(idx >= First and Shielded(GeneratedNuclei[idx]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+long int NucleationParameters::ShieldingBin(const iVector3 position) const
+{
+    const long int Total[3] = {PositionDistributionX.b(),
+                               PositionDistributionY.b(),
+                               PositionDistributionZ.b()};
+    long int Bin[3] = {0, 0, 0};
+    for(int d = 0; d < 3; d++)
+    if(Total[d] > 0)
+    {
+        const long int Wrapped = ((position[d] % Total[d]) + Total[d]) % Total[d];
+        Bin[d] = std::min(ShieldingBinsN[d] - 1, Wrapped*ShieldingBinsN[d]/Total[d]);
+    }
+    return (Bin[0]*ShieldingBinsN[1] + Bin[1])*ShieldingBinsN[2] + Bin[2];
+}
+
+void NucleationParameters::UpdateShieldingIndex()
+{
+    if(ShieldingIndexed > GeneratedNuclei.size())
+    {
+        ResetShieldingIndex();
+    }
+    if(ShieldingIndexed == 0)
+    {
+        const long int Total[3] = {PositionDistributionX.b(),
+                                   PositionDistributionY.b(),
+                                   PositionDistributionZ.b()};
+        for(int d = 0; d < 3; d++)
+        {
+            ShieldingBinsN[d] = 1;
+            if(ShieldingRadius > 0.0 and Total[d] > 0)
+            {
+                ShieldingBinsN[d] = std::max(1l, static_cast<long int>(Total[d]/ShieldingRadius));
+            }
+        }
+    }
+    for(; ShieldingIndexed < GeneratedNuclei.size(); ShieldingIndexed++)
+    {
+        ShieldingBins[ShieldingBin(GeneratedNuclei[ShieldingIndexed].position)].push_back(ShieldingIndexed);
+    }
+}
+
+void NucleationParameters::ResetShieldingIndex()
+{
+    ShieldingBins.clear();
+    ShieldingIndexed = 0;
 }
 
 //=============================================================================
@@ -343,6 +446,7 @@ void Nucleation::Initialize(Settings& locSettings, std::string ObjectNameSuffix)
     }
 
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
     locSettings.AddForReading(*this);
 
     initialized = true;
@@ -354,7 +458,7 @@ void Nucleation::ReadInput(const std::string InputFileName)
     ConsoleOutput::WriteLineInsert("Nucleation input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -365,7 +469,6 @@ void Nucleation::ReadInput(const std::string InputFileName)
     data << inp.rdbuf();
     ReadInput(data);
 
-    inp.close();
 }
 
 void Nucleation::ReadInput(std::stringstream& inp)
@@ -650,6 +753,7 @@ void Nucleation::Remesh(int newNx, int newNy, int newNz,
         Parameters(n, m).PositionDistributionX.param(uniform_int_distribution<int>::param_type(0, Grid.TotalNx - 1));
         Parameters(n, m).PositionDistributionY.param(uniform_int_distribution<int>::param_type(0, Grid.TotalNy - 1));
         Parameters(n, m).PositionDistributionZ.param(uniform_int_distribution<int>::param_type(0, Grid.TotalNz - 1));
+        Parameters(n, m).ResetShieldingIndex();
 
         if(Parameters(n, m).Generated)
         for(auto it  = Parameters(n, m).GeneratedNuclei.begin();
@@ -669,11 +773,24 @@ void Nucleation::Remesh(int newNx, int newNy, int newNz,
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
+void Nucleation::Repartition(const BoundaryConditions& BC)
+{
+    /* The generated nuclei are stored in global coordinates */
+    Grid.ApplyCutPlanes();
+}
+
 void Nucleation::SeedRandomGenerators(int RandomNumberSeedInput)
 {
-    const size_t RandomNumberSeed = (RandomNumberSeedInput < 0)
+    size_t RandomNumberSeed = (RandomNumberSeedInput < 0)
                ? static_cast<size_t>(std::chrono::system_clock::now().time_since_epoch().count())
                : static_cast<size_t>(RandomNumberSeedInput);
+#ifdef MPI_PARALLEL
+    /* All ranks draw the same seed candidates, the time based seed is taken
+    from the root rank */
+    unsigned long long locRandomNumberSeed = RandomNumberSeed;
+    OP_MPI_Bcast(&locRandomNumberSeed, 1, OP_MPI_UNSIGNED_LONG_LONG, 0, OP_MPI_COMM_WORLD);
+    RandomNumberSeed = locRandomNumberSeed;
+#endif
 
     for(size_t n = 0; n < Nphases; n++)
     for(size_t m = 0; m < Nphases; m++)
@@ -681,14 +798,11 @@ void Nucleation::SeedRandomGenerators(int RandomNumberSeedInput)
     {
         size_t seed_multiplier = n + m*Nphases + 1;
 
-        Parameters(n, m).SizeGenerator.seed(34784u*seed_multiplier*RandomNumberSeed);
+        /* Phase pairs draw from different streams of the same key, see
+        GenerateSeeds() */
+        Parameters(n, m).RandomSeed = RandomNumberSeed;
+        Parameters(n, m).Draws = 0;
         Parameters(n, m).VariantsGenerator.seed(5467u*seed_multiplier*RandomNumberSeed);
-        Parameters(n, m).PositionGeneratorX.seed(253u*seed_multiplier*RandomNumberSeed);
-        Parameters(n, m).PositionGeneratorY.seed(4958u*seed_multiplier*RandomNumberSeed);
-        Parameters(n, m).PositionGeneratorZ.seed(54861u*seed_multiplier*RandomNumberSeed);
-        Parameters(n, m).OrientationGenerator1.seed(45u*seed_multiplier*RandomNumberSeed);
-        Parameters(n, m).OrientationGenerator2.seed(697u*seed_multiplier*RandomNumberSeed);
-        Parameters(n, m).OrientationGenerator3.seed(2597u*seed_multiplier*RandomNumberSeed);
     }
 }
 
@@ -701,6 +815,7 @@ void Nucleation::Clear()
     {
         Parameters(n, m).GeneratedNuclei.clear();
         Parameters(n, m).PlantedNuclei.clear();
+        Parameters(n, m).ResetShieldingIndex();
     }
 }
 
@@ -714,6 +829,7 @@ void Nucleation::ClearOutOfRange(const Temperature& Tx)
          Parameters(n, m).Tmax >= Tx.Tmin))
     {
         Parameters(n, m).GeneratedNuclei.clear();
+        Parameters(n, m).ResetShieldingIndex();
         //Parameters(n, m).NucleatedParticles.clear();
         Parameters(n, m).Generated = false;
     }
@@ -729,6 +845,7 @@ void Nucleation::MoveFrame(const int dX, const int dY, const int dZ,
     if(Parameters(n, m).Allowed and
        Parameters(n, m).Generated)
     {
+        Parameters(n, m).ResetShieldingIndex();
         for (auto it  = Parameters(n, m).GeneratedNuclei.begin();
                   it != Parameters(n, m).GeneratedNuclei.end(); )
         {
@@ -831,61 +948,92 @@ void Nucleation::GenerateSeeds(PhaseField& Phase, Temperature& Tx)
     {
         Parameters(n, m).Generated = true;
 
+        NucleationParameters& locParameters = Parameters(n, m);
+
+        /* Seed candidates are drawn from the counter-based generator: the
+        candidate with index "Draws" takes its radius and position from the
+        stream SizeStream and its orientation from the stream SizeStream + 1
+        at this index. The candidates of a batch are thereby independent and
+        are evaluated in parallel, the owning rank checks the location and
+        a single reduction per batch collects the results. Candidates are
+        then accepted in the order of their index, with the shielding test
+        repeated against seeds accepted earlier in the same batch, and only
+        processed candidates are counted in "Draws". The generated seeds thus
+        do not depend on the batch size or the number of threads and ranks. */
+        const uint32_t SizeStream = 2*(n + m*Nphases);
+        const size_t BatchSize = 256;
+
+        vector<double>   loc_radius(BatchSize);
+        vector<iVector3> loc_position(BatchSize);
+        vector<int>      enable_seed(BatchSize);
+
         int attempts = 0;
 
         bool PrintMsg2 = false;
-        while (Parameters(n, m).Nseeds < Parameters(n, m).Nsites and
+        while (locParameters.Nseeds < locParameters.Nsites and
                attempts < NumberOfAttempts)
         {
-            bool enable_seed = false;
-
-            int increment_part = 0;
-            int increment_attempts = 0;
+            locParameters.UpdateShieldingIndex();
 
-            double loc_radius = Parameters(n,m).SetSeedRadius();
-            if(loc_radius >= Parameters(n,m).SeedRadiusMIN and
-               loc_radius <= Parameters(n,m).SeedRadiusMAX)
+            #pragma omp parallel for schedule(static)
+            for(size_t b = 0; b < BatchSize; b++)
             {
-                iVector3 loc_position = Parameters(n,m).SetSeedPosition();
+                Philox4x32 Generator(locParameters.RandomSeed, SizeStream, locParameters.Draws + b);
 
-                enable_seed = Parameters(n,m).CheckLocation(Phase, loc_position);
+                loc_radius[b] = locParameters.SetSeedRadius(Generator);
+                loc_position[b] = iVector3{-1,-1,-1};
+                enable_seed[b] = 0;
+                if(loc_radius[b] >= locParameters.SeedRadiusMIN and
+                   loc_radius[b] <= locParameters.SeedRadiusMAX)
+                {
+                    loc_position[b] = locParameters.SetSeedPosition(Generator);
+                    enable_seed[b] = locParameters.CheckLocation(Phase, loc_position[b]);
+                }
+            }
+#ifdef MPI_PARALLEL
+            OP_MPI_Allreduce(OP_MPI_IN_PLACE, enable_seed.data(), BatchSize, OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+            const size_t FirstInBatch = locParameters.GeneratedNuclei.size();
 
-    #ifdef MPI_PARALLEL
-                int tmp_enable_seed = enable_seed;
-                OP_MPI_Allreduce(OP_MPI_IN_PLACE, &tmp_enable_seed, 1, OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-                enable_seed = tmp_enable_seed;
-    #endif
-                if(enable_seed)
+            size_t b = 0;
+            for(; b < BatchSize and
+                  locParameters.Nseeds < locParameters.Nsites and
+                  attempts < NumberOfAttempts; b++)
+            {
+                if (loc_radius[b] == 0.0)
+                {
+                    ConsoleOutput::WriteWarning("Seed radius has been set to zero. Check input Parameters!", "NucleationParametersEXP", "SetSeedRadius");
+                }
+
+                if(enable_seed[b] and
+                   locParameters.PositionNotShielded(loc_position[b], FirstInBatch))
                 {
+                    Philox4x32 Generator(locParameters.RandomSeed, SizeStream + 1, locParameters.Draws + b);
+
                     Nucleus locSeed;
-                    locSeed.position    = loc_position;
-                    locSeed.radius      = loc_radius;
-                    locSeed.orientation = Parameters(n, m).SetSeedOrientation();
+                    locSeed.position    = loc_position[b];
+                    locSeed.radius      = loc_radius[b];
+                    locSeed.orientation = locParameters.SetSeedOrientation(Generator);
 
                     std::stringstream message;
-                    message << "Nucleation: Generated seed particle " << Parameters(n, m).Nseeds << " at ["
-                            << loc_position.get_x() << ", "
-                            << loc_position.get_y() << ", "
-                            << loc_position.get_z() << "] and effective radius of "
-                            << loc_radius;
+                    message << "Nucleation: Generated seed particle " << locParameters.Nseeds << " at ["
+                            << loc_position[b].get_x() << ", "
+                            << loc_position[b].get_y() << ", "
+                            << loc_position[b].get_z() << "] and effective radius of "
+                            << loc_radius[b];
                     ConsoleOutput::WriteSimple(message.str());
 
-                    Parameters(n, m).GeneratedNuclei.push_back(locSeed);
-                    increment_part = 1;
+                    locParameters.GeneratedNuclei.push_back(locSeed);
+                    locParameters.Nseeds += 1;
                     attempts = 0;
                     PrintMsg2 = true;
                 }
-                else // if no seed location found
+                else // if no seed location found or radius outside [R_min,R_max]
                 {
-                    increment_attempts = 1;
+                    attempts += 1;
                 }
             }
-            else // if radius outside [R_min,R_max]
-            {
-                increment_attempts = 1;
-            }
-            Parameters(n, m).Nseeds += increment_part;
-            attempts += increment_attempts;
+            locParameters.Draws += b;
         } // end while loop
         if (PrintMsg2)
         {
@@ -990,17 +1138,19 @@ void Nucleation::PlantNuclei(PhaseField& Phase, int tStep)
 {
     for(size_t n = 0; n < Nphases; n++)
     for(size_t m = 0; m < Nphases; m++)
-    for(auto ind  = Parameters(n, m).GeneratedNuclei.begin();
-             ind != Parameters(n, m).GeneratedNuclei.end(); ind++)
+    if(!Parameters(n, m).GeneratedNuclei.empty())
     {
-        if(!ind->planted)
+        /* Parent grains of all nuclei of the phase pair are detected by the
+        owning ranks first and collected with a single reduction */
+        vector<unsigned long> ParentGrainIndices(Parameters(n, m).GeneratedNuclei.size(), 0);
+        for(size_t idx = 0; idx < Parameters(n, m).GeneratedNuclei.size(); idx++)
         {
-            // detect parent grain by max phase-field value
-            size_t ParentGrainIndex = 0;
-            if(Grid.PositionInLocalBounds(ind->position))
+            const Nucleus& locNucleus = Parameters(n, m).GeneratedNuclei[idx];
+            if(!locNucleus.planted and Grid.PositionInLocalBounds(locNucleus.position))
             {
+                // detect parent grain by max phase-field value
                 double locMax = 0.0;
-                iVector3 locPosition = Grid.ConvertToLocal(ind->position);
+                iVector3 locPosition = Grid.ConvertToLocal(locNucleus.position);
 
                 for(auto alpha  = Phase.Fields(locPosition[0], locPosition[1], locPosition[2]).begin();
                          alpha != Phase.Fields(locPosition[0], locPosition[1], locPosition[2]).end(); ++alpha)
@@ -1008,34 +1158,70 @@ void Nucleation::PlantNuclei(PhaseField& Phase, int tStep)
                     if(Phase.FieldsProperties[alpha->index].Phase == m and alpha->value > locMax)
                     {
                         locMax = alpha->value;
-                        ParentGrainIndex = alpha->index;
+                        ParentGrainIndices[idx] = alpha->index;
                     }
                 }
             }
+        }
 #ifdef MPI_PARALLEL
-            unsigned long locParentGrainIndex = ParentGrainIndex;
-            OP_MPI_Allreduce(OP_MPI_IN_PLACE, &locParentGrainIndex, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-            ParentGrainIndex = locParentGrainIndex;
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, ParentGrainIndices.data(), ParentGrainIndices.size(), OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
 #endif
-            // select symmetry variants
-            if(Nvariants[n] > 1)
+        for(auto ind  = Parameters(n, m).GeneratedNuclei.begin();
+                 ind != Parameters(n, m).GeneratedNuclei.end(); ind++)
+        {
+            if(!ind->planted)
             {
-                vector<bool> locVariants(Nvariants[n], false);
+                const size_t ParentGrainIndex = ParentGrainIndices[ind - Parameters(n, m).GeneratedNuclei.begin()];
 
-                switch(Parameters(n,m).VariantsMode)
+                // select symmetry variants
+                if(Nvariants[n] > 1)
                 {
-                    case NucleiVariantsModes::Random:
+                    vector<bool> locVariants(Nvariants[n], false);
+
+                    switch(Parameters(n,m).VariantsMode)
                     {
-                        size_t locNvariants = 0;
-                        while(locNvariants < Parameters(n,m).Nvariants)
+                        case NucleiVariantsModes::Random:
                         {
-                            int locVariant = Parameters(n, m).VariantSelector(Parameters(n, m).VariantsGenerator);
-
-                            if(!locVariants[locVariant])
+                            size_t locNvariants = 0;
+                            while(locNvariants < Parameters(n,m).Nvariants)
                             {
-                                locVariants[locVariant] = true;
-                                locNvariants++;
+                                int locVariant = Parameters(n, m).VariantSelector(Parameters(n, m).VariantsGenerator);
 
+                                if(!locVariants[locVariant])
+                                {
+                                    locVariants[locVariant] = true;
+                                    locNvariants++;
+
+                                    size_t locIndex = Phase.PlantGrainNucleus(n, ind->position[0], ind->position[1], ind->position[2]);
+
+                                    if(Parameters(n, m).TrueRadius)
+                                    {
+                                        Phase.FieldsProperties[locIndex].RefVolume = Phase.CalculateReferenceVolume(ind->radius/Grid.dx);
+                                    }
+
+                                    if(Parameters(n, m).OrientationMode == NucleiOrientationModes::Parent)
+                                    {
+                                        Phase.FieldsProperties[locIndex].Orientation =
+                                               Phase.FieldsProperties[ParentGrainIndex].Orientation;
+
+                                        ind->orientation = Phase.FieldsProperties[ParentGrainIndex].Orientation;
+                                    }
+                                    else
+                                    {
+                                        Phase.FieldsProperties[locIndex].Orientation = ind->orientation;
+                                    }
+
+                                    Phase.FieldsProperties[locIndex].Variant = locVariant;
+                                    Phase.FieldsProperties[locIndex].Parent  = ParentGrainIndex;
+                                    Phase.FieldsProperties[locIndex].RefVolume /= Parameters(n,m).Nvariants;
+                                }
+                            }
+                            break;
+                        }
+                        case NucleiVariantsModes::LowestEnergy:
+                        {
+                            for(size_t locVariant = 0; locVariant < Nvariants[n]; locVariant++)
+                            {
                                 size_t locIndex = Phase.PlantGrainNucleus(n, ind->position[0], ind->position[1], ind->position[2]);
 
                                 if(Parameters(n, m).TrueRadius)
@@ -1059,67 +1245,38 @@ void Nucleation::PlantNuclei(PhaseField& Phase, int tStep)
                                 Phase.FieldsProperties[locIndex].Parent  = ParentGrainIndex;
                                 Phase.FieldsProperties[locIndex].RefVolume /= Parameters(n,m).Nvariants;
                             }
+                            break;
                         }
-                        break;
                     }
-                    case NucleiVariantsModes::LowestEnergy:
-                    {
-                        for(size_t locVariant = 0; locVariant < Nvariants[n]; locVariant++)
-                        {
-                            size_t locIndex = Phase.PlantGrainNucleus(n, ind->position[0], ind->position[1], ind->position[2]);
-
-                            if(Parameters(n, m).TrueRadius)
-                            {
-                                Phase.FieldsProperties[locIndex].RefVolume = Phase.CalculateReferenceVolume(ind->radius/Grid.dx);
-                            }
-
-                            if(Parameters(n, m).OrientationMode == NucleiOrientationModes::Parent)
-                            {
-                                Phase.FieldsProperties[locIndex].Orientation =
-                                       Phase.FieldsProperties[ParentGrainIndex].Orientation;
-
-                                ind->orientation = Phase.FieldsProperties[ParentGrainIndex].Orientation;
-                            }
-                            else
-                            {
-                                Phase.FieldsProperties[locIndex].Orientation = ind->orientation;
-                            }
+                }
+                else
+                {
+                    size_t locIndex = Phase.PlantGrainNucleus(n, ind->position[0], ind->position[1], ind->position[2]);
 
-                            Phase.FieldsProperties[locIndex].Variant = locVariant;
-                            Phase.FieldsProperties[locIndex].Parent  = ParentGrainIndex;
-                            Phase.FieldsProperties[locIndex].RefVolume /= Parameters(n,m).Nvariants;
-                        }
-                        break;
+                    if(Parameters(n, m).TrueRadius)
+                    {
+                        Phase.FieldsProperties[locIndex].RefVolume = Phase.CalculateReferenceVolume(ind->radius/Grid.dx);
                     }
-                }
-            }
-            else
-            {
-                size_t locIndex = Phase.PlantGrainNucleus(n, ind->position[0], ind->position[1], ind->position[2]);
 
-                if(Parameters(n, m).TrueRadius)
-                {
-                    Phase.FieldsProperties[locIndex].RefVolume = Phase.CalculateReferenceVolume(ind->radius/Grid.dx);
-                }
+                    if(Parameters(n, m).OrientationMode == NucleiOrientationModes::Parent)
+                    {
+                        Phase.FieldsProperties[locIndex].Orientation =
+                               Phase.FieldsProperties[ParentGrainIndex].Orientation;
 
-                if(Parameters(n, m).OrientationMode == NucleiOrientationModes::Parent)
-                {
-                    Phase.FieldsProperties[locIndex].Orientation =
-                           Phase.FieldsProperties[ParentGrainIndex].Orientation;
+                        ind->orientation = Phase.FieldsProperties[ParentGrainIndex].Orientation;
+                    }
+                    else
+                    {
+                        Phase.FieldsProperties[locIndex].Orientation = ind->orientation;
+                    }
 
-                    ind->orientation = Phase.FieldsProperties[ParentGrainIndex].Orientation;
-                }
-                else
-                {
-                    Phase.FieldsProperties[locIndex].Orientation = ind->orientation;
+                    Phase.FieldsProperties[locIndex].Parent = ParentGrainIndex;
                 }
+                //ind->planted = true;
+                ind->time_stamp = tStep;
 
-                Phase.FieldsProperties[locIndex].Parent = ParentGrainIndex;
+                NucleiPlanted = true;
             }
-            //ind->planted = true;
-            ind->time_stamp = tStep;
-
-            NucleiPlanted = true;
         }
     }
 }
@@ -1360,6 +1517,7 @@ void Nucleation::ReadH5(H5Interface& H5, const int tStep)
     for (size_t m = 0; m < Nphases; ++m)
     {
         int tmp = static_cast<int>(dbuffer[idx++]);   // count of nuclei for (n,m)
+        Parameters(n,m).ResetShieldingIndex();
         if (tmp > 0) {
             Parameters(n,m).GeneratedNuclei.resize(static_cast<size_t>(tmp));
         } else {
@@ -0,0 +1,303 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "NumericalMethods/Multigrid.h"
+#include "BoundaryConditions.h"
+
+namespace openphase
+{
+using namespace std;
+
+void Multigrid::Initialize(const GridParameters& Grid, const size_t MaxLevels)
+{
+    dNx = Grid.dNx;
+    dNy = Grid.dNy;
+    dNz = Grid.dNz;
+
+    Boundary0 = {Grid.OffsetX == 0, Grid.OffsetY == 0, Grid.OffsetZ == 0};
+    BoundaryN = {Grid.OffsetX + Grid.Nx == Grid.TotalNx,
+                 Grid.OffsetY + Grid.Ny == Grid.TotalNy,
+                 Grid.OffsetZ + Grid.Nz == Grid.TotalNz};
+
+    long int Nx = Grid.Nx;
+    long int Ny = Grid.Ny;
+    long int Nz = Grid.Nz;
+
+    /* Number of grids which can be coarsened on all ranks */
+    int nLevels = 1;
+    auto coarsenable = [](const long int N, const int dN)
+    {
+        return dN == 0 or (N % 2 == 0 and N >= 4);
+    };
+    while(nLevels < int(MaxLevels) and (dNx + dNy + dNz) > 0 and
+          coarsenable(Nx, dNx) and coarsenable(Ny, dNy) and coarsenable(Nz, dNz))
+    {
+        Nx /= 1 + dNx;
+        Ny /= 1 + dNy;
+        Nz /= 1 + dNz;
+        nLevels++;
+    }
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &nLevels, 1, OP_MPI_INT, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+#endif
+
+    Levels.clear();
+    Levels.resize(nLevels);
+
+    Nx = Grid.Nx;
+    Ny = Grid.Ny;
+    Nz = Grid.Nz;
+    double dx = Grid.dx;
+    for(int l = 0; l < nLevels; l++)
+    {
+        Level& L = Levels[l];
+        if(l > 0)
+        {
+            L.U = Storage3D<double,0>(Nx, Ny, Nz, dNx, dNy, dNz, 1);
+        }
+        L.F     = Storage3D<double,0>(Nx, Ny, Nz, dNx, dNy, dNz, 1);
+        L.R     = Storage3D<double,0>(Nx, Ny, Nz, dNx, dNy, dNz, 1);
+        L.Alpha = Storage3D<double,0>(Nx, Ny, Nz, dNx, dNy, dNz, 1);
+        L.Beta  = Storage3D<double,0>(Nx, Ny, Nz, dNx, dNy, dNz, 1);
+        L.dx    = dx;
+
+        Nx /= 1 + dNx;
+        Ny /= 1 + dNy;
+        Nz /= 1 + dNz;
+        dx *= 2.0;
+    }
+}
+
+size_t Multigrid::AllocatedMemory(void) const
+{
+    size_t bytes = 0;
+    for(const Level& L : Levels)
+    {
+        bytes += L.U.AllocatedMemory() + L.F.AllocatedMemory() + L.R.AllocatedMemory()
+               + L.Alpha.AllocatedMemory() + L.Beta.AllocatedMemory();
+    }
+    return bytes;
+}
+
+void Multigrid::SetCoefficients(const Storage3D<double,0>& Alpha,
+                                const Storage3D<double,0>& Beta,
+                                const double BetaFactor)
+{
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Levels[0].Alpha,0,)
+    {
+        Levels[0].Alpha(i,j,k) = Alpha(i,j,k);
+        Levels[0].Beta(i,j,k)  = Beta(i,j,k)*BetaFactor;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    for(size_t l = 1; l < Levels.size(); l++)
+    {
+        Restrict(Levels[l-1].Alpha, Levels[l].Alpha);
+        Restrict(Levels[l-1].Beta,  Levels[l].Beta);
+    }
+}
+
+void Multigrid::SetBoundaryConditions(const size_t l, Storage3D<double,0>& U,
+                                      const BoundaryConditions& BC) const
+{
+    if(dNx) BC.SetX(U);
+    if(dNy) BC.SetY(U);
+    if(dNz) BC.SetZ(U);
+
+    if(l == 0) return;
+
+    /* The fixed value of the simulation grid sits in the boundary cell, half a
+    cell outside of the domain. The coarse grid corrections vanish on the
+    domain boundary instead (antisymmetric boundary cells), otherwise the
+    boundary would move outwards with every coarsening. */
+    const long int Nx = U.sizeX();
+    const long int Ny = U.sizeY();
+    const long int Nz = U.sizeZ();
+    if(dNx and BC.BC0X == BoundaryConditionTypes::Fixed and Boundary0[0])
+    {
+        #pragma omp parallel for collapse(2)
+        for(long int j = -U.BcellsY(); j < Ny + U.BcellsY(); j++)
+        for(long int k = -U.BcellsZ(); k < Nz + U.BcellsZ(); k++) U(-1,j,k) = -U(0,j,k);
+    }
+    if(dNx and BC.BCNX == BoundaryConditionTypes::Fixed and BoundaryN[0])
+    {
+        #pragma omp parallel for collapse(2)
+        for(long int j = -U.BcellsY(); j < Ny + U.BcellsY(); j++)
+        for(long int k = -U.BcellsZ(); k < Nz + U.BcellsZ(); k++) U(Nx,j,k) = -U(Nx-1,j,k);
+    }
+    if(dNy and BC.BC0Y == BoundaryConditionTypes::Fixed and Boundary0[1])
+    {
+        #pragma omp parallel for collapse(2)
+        for(long int i = -U.BcellsX(); i < Nx + U.BcellsX(); i++)
+        for(long int k = -U.BcellsZ(); k < Nz + U.BcellsZ(); k++) U(i,-1,k) = -U(i,0,k);
+    }
+    if(dNy and BC.BCNY == BoundaryConditionTypes::Fixed and BoundaryN[1])
+    {
+        #pragma omp parallel for collapse(2)
+        for(long int i = -U.BcellsX(); i < Nx + U.BcellsX(); i++)
+        for(long int k = -U.BcellsZ(); k < Nz + U.BcellsZ(); k++) U(i,Ny,k) = -U(i,Ny-1,k);
+    }
+    if(dNz and BC.BC0Z == BoundaryConditionTypes::Fixed and Boundary0[2])
+    {
+        #pragma omp parallel for collapse(2)
+        for(long int i = -U.BcellsX(); i < Nx + U.BcellsX(); i++)
+        for(long int j = -U.BcellsY(); j < Ny + U.BcellsY(); j++) U(i,j,-1) = -U(i,j,0);
+    }
+    if(dNz and BC.BCNZ == BoundaryConditionTypes::Fixed and BoundaryN[2])
+    {
+        #pragma omp parallel for collapse(2)
+        for(long int i = -U.BcellsX(); i < Nx + U.BcellsX(); i++)
+        for(long int j = -U.BcellsY(); j < Ny + U.BcellsY(); j++) U(i,j,Nz) = -U(i,j,Nz-1);
+    }
+}
+
+double Multigrid::VCycle(Storage3D<double,0>& U, const BoundaryConditions& BC)
+{
+    SetBoundaryConditions(0, U, BC);
+    return Cycle(0, U, BC);
+}
+
+double Multigrid::Cycle(const size_t l, Storage3D<double,0>& U, const BoundaryConditions& BC)
+{
+    if(l + 1 == Levels.size())
+    {
+        Smooth(l, U, (l == 0) ? PreSmoothing + PostSmoothing : CoarseSweeps, BC);
+        return Residual(l, U);
+    }
+
+    Smooth(l, U, PreSmoothing, BC);
+    const double residual = Residual(l, U);
+
+    Level& Coarse = Levels[l+1];
+    Restrict(Levels[l].R, Coarse.F);
+    Coarse.U.Clear();
+    Cycle(l + 1, Coarse.U, BC);
+    SetBoundaryConditions(l + 1, Coarse.U, BC);
+
+    Prolongate(Coarse.U, U);
+    SetBoundaryConditions(l, U, BC);
+
+    Smooth(l, U, PostSmoothing, BC);
+    return residual;
+}
+
+void Multigrid::Smooth(const size_t l, Storage3D<double,0>& U, const int sweeps,
+                       const BoundaryConditions& BC)
+{
+    const Level& L = Levels[l];
+    const double idx2 = 1.0/(L.dx*L.dx);
+    const double dimension = 2.0*(dNx + dNy + dNz);
+
+    for(int sweep = 0; sweep < sweeps; sweep++)
+    for(int color = 0; color < 2; color++)
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,U,0,)
+        {
+            if(((i + j + k) & 1) != color) continue;
+
+            const double neighbours = (U(i+dNx,j,k) + U(i-dNx,j,k))*dNx
+                                    + (U(i,j+dNy,k) + U(i,j-dNy,k))*dNy
+                                    + (U(i,j,k+dNz) + U(i,j,k-dNz))*dNz;
+            const double beta = L.Beta(i,j,k)*idx2;
+
+            U(i,j,k) = (L.F(i,j,k) + beta*neighbours)/(L.Alpha(i,j,k) + dimension*beta);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+
+        SetBoundaryConditions(l, U, BC);
+    }
+}
+
+double Multigrid::Residual(const size_t l, const Storage3D<double,0>& U)
+{
+    Level& L = Levels[l];
+    const double idx2 = 1.0/(L.dx*L.dx);
+    const double dimension = 2.0*(dNx + dNy + dNz);
+
+    double MaxResidual = 0.0;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,U,0,reduction(max:MaxResidual))
+    {
+        const double neighbours = (U(i+dNx,j,k) + U(i-dNx,j,k))*dNx
+                                + (U(i,j+dNy,k) + U(i,j-dNy,k))*dNy
+                                + (U(i,j,k+dNz) + U(i,j,k-dNz))*dNz;
+        const double beta = L.Beta(i,j,k)*idx2;
+        const double diagonal = L.Alpha(i,j,k) + dimension*beta;
+
+        L.R(i,j,k) = L.F(i,j,k) - diagonal*U(i,j,k) + beta*neighbours;
+        MaxResidual = max(MaxResidual, fabs(L.R(i,j,k)/diagonal));
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return MaxResidual;
+}
+
+void Multigrid::Restrict(const Storage3D<double,0>& Fine, Storage3D<double,0>& Coarse) const
+{
+    const double weight = 1.0/double(1 << (dNx + dNy + dNz));
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Coarse,0,)
+    {
+        double sum = 0.0;
+        for(int di = 0; di <= dNx; di++)
+        for(int dj = 0; dj <= dNy; dj++)
+        for(int dk = 0; dk <= dNz; dk++)
+        {
+            sum += Fine((1+dNx)*i + di, (1+dNy)*j + dj, (1+dNz)*k + dk);
+        }
+        Coarse(i,j,k) = sum*weight;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+void Multigrid::Prolongate(const Storage3D<double,0>& Coarse, Storage3D<double,0>& Fine) const
+{
+    /* A fine cell lies at a quarter of the coarse spacing from the center of
+    its parent cell, towards the neighbour with offset s: weights 3/4 and 1/4
+    per active dimension. */
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fine,0,)
+    {
+        const long int I = i/(1+dNx);
+        const long int J = j/(1+dNy);
+        const long int K = k/(1+dNz);
+        const long int si = (i % 2) ? dNx : -dNx;
+        const long int sj = (j % 2) ? dNy : -dNy;
+        const long int sk = (k % 2) ? dNz : -dNz;
+        const double wx[2] = {dNx ? 0.75 : 1.0, dNx ? 0.25 : 0.0};
+        const double wy[2] = {dNy ? 0.75 : 1.0, dNy ? 0.25 : 0.0};
+        const double wz[2] = {dNz ? 0.75 : 1.0, dNz ? 0.25 : 0.0};
+
+        double value = 0.0;
+        for(int a = 0; a <= dNx; a++)
+        for(int b = 0; b <= dNy; b++)
+        for(int c = 0; c <= dNz; c++)
+        {
+            value += wx[a]*wy[b]*wz[c]*Coarse(I + a*si, J + b*sj, K + c*sk);
+        }
+        Fine(i,j,k) += value;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+}// namespace openphase
@@ -0,0 +1,173 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "NumericalMethods/Preconditioners.h"
+#include "ConsoleOutput.h"
+
+namespace openphase::SystemOfLinearEquationsSolvers
+{
+using namespace std;
+
+static void CheckDiagonal(const double value, const size_t i, const string name)
+{
+    if(value == 0.0)
+    {
+        ConsoleOutput::WriteExit("Zero diagonal element in row " + to_string(i), name, "Initialize()");
+        OP_Exit(EXIT_FAILURE);
+    }
+}
+
+void JacobiPreconditioner::Initialize(const SparseMatrixCompressedRow& A)
+{
+    InverseDiagonal = A.Diagonal();
+    for(size_t i = 0; i < InverseDiagonal.size(); i++)
+    {
+        CheckDiagonal(InverseDiagonal[i], i, "JacobiPreconditioner");
+        InverseDiagonal[i] = 1.0/InverseDiagonal[i];
+    }
+}
+
+void JacobiPreconditioner::Apply(const vector<double>& in, vector<double>& out) const
+{
+    const size_t N = InverseDiagonal.size();
+    #pragma omp parallel for
+    for(size_t i = 0; i < N; i++)
+    {
+        out[i] = InverseDiagonal[i]*in[i];
+    }
+}
+
+void ILU0Preconditioner::Initialize(const SparseMatrixCompressedRow& A)
+{
+    RowStart = A.RowStarts();
+    Column   = A.Columns();
+    LU       = A.Values();
+
+    const size_t N = A.Rows();
+    DiagonalEntry.assign(N, 0);
+    for(size_t i = 0; i < N; i++)
+    {
+        size_t n = RowStart[i];
+        while(n < RowStart[i+1] and Column[n] < i) n++;
+        if(n == RowStart[i+1] or Column[n] != i)
+        {
+            CheckDiagonal(0.0, i, "ILU0Preconditioner");
+        }
+        DiagonalEntry[i] = n;
+    }
+
+    /* IKJ variant of the Gaussian elimination restricted to the pattern of A,
+    Position maps the columns of row i to their entries. */
+    vector<long int> Position(N, -1);
+    for(size_t i = 0; i < N; i++)
+    {
+        for(size_t n = RowStart[i]; n < RowStart[i+1]; n++) Position[Column[n]] = n;
+
+        for(size_t n = RowStart[i]; n < DiagonalEntry[i]; n++)
+        {
+            const size_t k = Column[n];
+            LU[n] /= LU[DiagonalEntry[k]];
+            for(size_t m = DiagonalEntry[k] + 1; m < RowStart[k+1]; m++)
+            if(Position[Column[m]] >= 0)
+            {
+                LU[Position[Column[m]]] -= LU[n]*LU[m];
+            }
+        }
+        CheckDiagonal(LU[DiagonalEntry[i]], i, "ILU0Preconditioner");
+
+        for(size_t n = RowStart[i]; n < RowStart[i+1]; n++) Position[Column[n]] = -1;
+    }
+}
+
+void ILU0Preconditioner::Apply(const vector<double>& in, vector<double>& out) const
+{
+    const size_t N = DiagonalEntry.size();
+    for(size_t i = 0; i < N; i++)
+    {
+        double sum = in[i];
+        for(size_t n = RowStart[i]; n < DiagonalEntry[i]; n++)
+        {
+            sum -= LU[n]*out[Column[n]];
+        }
+        out[i] = sum;
+    }
+    for(size_t i = N; i-- > 0;)
+    {
+        double sum = out[i];
+        for(size_t n = DiagonalEntry[i] + 1; n < RowStart[i+1]; n++)
+        {
+            sum -= LU[n]*out[Column[n]];
+        }
+        out[i] = sum/LU[DiagonalEntry[i]];
+    }
+}
+
+void SSORPreconditioner::Initialize(const SparseMatrixCompressedRow& A, const double omega)
+{
+    if(omega <= 0.0 or omega >= 2.0)
+    {
+        ConsoleOutput::WriteExit("Relaxation factor has to be in (0,2)", "SSORPreconditioner", "Initialize()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    Matrix   = &A;
+    Omega    = omega;
+    Diagonal = A.Diagonal();
+    for(size_t i = 0; i < Diagonal.size(); i++)
+    {
+        CheckDiagonal(Diagonal[i], i, "SSORPreconditioner");
+    }
+}
+
+void SSORPreconditioner::Apply(const vector<double>& in, vector<double>& out) const
+{
+    const vector<size_t>& RowStart = Matrix->RowStarts();
+    const vector<size_t>& Column   = Matrix->Columns();
+    const vector<double>& Value    = Matrix->Values();
+    const size_t N = Diagonal.size();
+
+    // (D/w + L) y = in
+    for(size_t i = 0; i < N; i++)
+    {
+        double sum = in[i];
+        for(size_t n = RowStart[i]; n < RowStart[i+1] and Column[n] < i; n++)
+        {
+            sum -= Value[n]*out[Column[n]];
+        }
+        out[i] = sum*Omega/Diagonal[i];
+    }
+    // (D/w + U) out = (2-w)/w D/w y
+    for(size_t i = N; i-- > 0;)
+    {
+        double sum = (2.0 - Omega)/Omega*Diagonal[i]/Omega*out[i];
+        for(size_t n = RowStart[i+1]; n-- > RowStart[i] and Column[n] > i;)
+        {
+            sum -= Value[n]*out[Column[n]];
+        }
+        out[i] = sum*Omega/Diagonal[i];
+    }
+}
+
+}// namespace openphase::SystemOfLinearEquationsSolvers
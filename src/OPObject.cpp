@@ -26,11 +26,61 @@
 
 #include "OPObject.h"
 
+#include <algorithm>
+#include <mutex>
+
 namespace openphase
 {
 
+/* The registry is never destroyed, so objects with static storage duration
+can deregister themselves at program exit.*/
+struct OPObjectRegistry
+{
+    std::mutex Mutex;
+    std::vector<const OPObject*> Objects;
+};
+
+static OPObjectRegistry& Registry(void)
+{
+    static OPObjectRegistry* registry = new OPObjectRegistry;
+    return *registry;
+}
+
+OPObject::OPObject(void)
+{
+    std::lock_guard<std::mutex> lock(Registry().Mutex);
+    Registry().Objects.push_back(this);
+}
+
+OPObject::OPObject(const OPObject& rhs) :
+    thisclassname(rhs.thisclassname),
+    thisobjectname(rhs.thisobjectname),
+    initialized(rhs.initialized),
+    input_read(rhs.input_read),
+    remeshable(rhs.remeshable),
+    repartitionable(rhs.repartitionable),
+    advectable(rhs.advectable),
+    readable(rhs.readable),
+    checkpointable(rhs.checkpointable),
+    boundary_conditions(rhs.boundary_conditions)
+{
+    std::lock_guard<std::mutex> lock(Registry().Mutex);
+    Registry().Objects.push_back(this);
+}
+
+std::vector<const OPObject*> OPObject::ExistingObjects(void)
+{
+    std::lock_guard<std::mutex> lock(Registry().Mutex);
+    return Registry().Objects;
+}
+
 OPObject::~OPObject(void)
 {
+    {
+        std::lock_guard<std::mutex> lock(Registry().Mutex);
+        auto& objects = Registry().Objects;
+        objects.erase(std::remove(objects.begin(), objects.end(), this), objects.end());
+    }
     if(thisclassname.size() != 0)
     {
         ConsoleOutput::WriteStandard(this->thisclassname, "Exited normally");
@@ -33,6 +33,7 @@
 #include "Velocities.h"
 #include "VTK.h"
 #include "AdvectionHR.h"
+#include "LoadBalancer.h"
 
 namespace openphase
 {
@@ -57,6 +58,7 @@ void Orientations::Initialize(Settings& locSettings, std::string ObjectNameSuffi
 
     locSettings.AddForAdvection(*this);
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
     initialized = true;
     ConsoleOutput::WriteStandard("Orientations", "Initialized");
 }
@@ -68,6 +70,12 @@ void Orientations::SetBoundaryConditions(const BoundaryConditions& BC)
     BC.SetZ(Quaternions);
 }
 
+size_t Orientations::AllocatedMemory(void) const
+{
+    return Quaternions.AllocatedMemory() +
+           QuaternionsDot.AllocatedMemory();
+}
+
 void Orientations::Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC)
 {
     Quaternions.Remesh(newNx, newNy, newNz);
@@ -85,6 +93,27 @@ void Orientations::Remesh(int newNx, int newNy, int newNz, const BoundaryConditi
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
+void Orientations::Repartition(const BoundaryConditions& BC)
+{
+    const GridParameters OldGrid = Grid;
+    Grid.ApplyCutPlanes();
+
+    LoadBalancer::Migrate(Quaternions, OldGrid, Grid);
+
+    if(QuaternionsDot.IsAllocated())
+    {
+        QuaternionsDot.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
+
+    SetBoundaryConditions(BC);
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Quaternions, Quaternions.Bcells(),)
+    {
+        Quaternions(i, j, k).setRotationMatrix();
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
 Orientations& Orientations::operator= (const Orientations& rhs)
 {
     // protect against invalid self-assignment and copy of unitialized object
@@ -203,25 +232,33 @@ void Orientations::WriteGrainEBSDDataQuaternions(const Settings& locSettings,
                                                  const PhaseField& Phase,
                                                  const int tStep)
 {
-    stringstream outbuffer;
-    outbuffer << "Index\t"
-              << "Phase\t"
-              << "X\t"
-              << "Y\t"
-              << "Z\t"
-              << "Quat real\t"
-              << "Quat i\t"
-              << "Quat j\t"
-              << "Quat k\t" << endl;
-
-    int index = 1;
-    STORAGE_LOOP_BEGIN(i,j,k,Quaternions,0)
+    stringstream header;
+    header << "Index\t"
+           << "Phase\t"
+           << "X\t"
+           << "Y\t"
+           << "Z\t"
+           << "Quat real\t"
+           << "Quat i\t"
+           << "Quat j\t"
+           << "Quat k\t" << endl;
+
+    const long int Ny = Quaternions.sizeY();
+    const long int Nz = Quaternions.sizeZ();
+    const size_t Nrows = Quaternions.sizeX()*Ny*Nz;
+
+    string FileName = FileInterface::MakeFileName(locSettings.RawDataDir, "EBSD_", tStep, ".dat");
+
+    FileInterface::WriteRows(FileName, header.str(), Nrows,
+                             [&](ostream& outbuffer, const size_t n)
     {
-        EulerAngles tempAng;
-        dMatrix3x3  tempMatrix;
+        const long int i = n/(Ny*Nz);
+        const long int j = (n/Nz)%Ny;
+        const long int k = n%Nz;
+
         Quaternion  tempQuat;
 
-        outbuffer << index << "\t";
+        outbuffer << n + 1 << "\t";
         if (Phase.Fields(i,j,k).interface())
         {
             // linear interpolation in interface via quaternions
@@ -246,16 +283,8 @@ void Orientations::WriteGrainEBSDDataQuaternions(const Settings& locSettings,
                   << tempQuat[0] << "\t"
                   << tempQuat[1] << "\t"
                   << tempQuat[2] << "\t"
-                  << tempQuat[3] << endl;
-        index++;
-    }
-    STORAGE_LOOP_END
-
-    string FileName = FileInterface::MakeFileName(locSettings.RawDataDir, "EBSD_", tStep, ".dat");
-
-    ofstream ebsd_file(FileName.c_str());
-    ebsd_file << outbuffer.rdbuf();
-    ebsd_file.close();
+                  << tempQuat[3] << "\n";
+    });
 
     ConsoleOutput::WriteStandard("EBSD file", FileName);
 }
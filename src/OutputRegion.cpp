@@ -0,0 +1,184 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "OutputRegion.h"
+#include "ConsoleOutput.h"
+#include "Settings.h"
+
+namespace openphase
+{
+using namespace std;
+
+OutputRegion OutputRegion::Box(const string& Name,
+                               const long int x0, const long int x1,
+                               const long int y0, const long int y1,
+                               const long int z0, const long int z1,
+                               const long int Stride)
+{
+    OutputRegion Region;
+    Region.Name = Name;
+    Region.Begin[0] = x0; Region.End[0] = x1;
+    Region.Begin[1] = y0; Region.End[1] = y1;
+    Region.Begin[2] = z0; Region.End[2] = z1;
+    for(int d = 0; d < 3; d++) Region.Stride[d] = Stride;
+    return Region;
+}
+
+OutputRegion OutputRegion::Slice(const string& Name, const int Direction,
+                                 const long int Position, const long int Stride)
+{
+    OutputRegion Region = Subsampled(Name, Stride);
+    Region.Begin[Direction]  = Position;
+    Region.End[Direction]    = Position + 1;
+    Region.Stride[Direction] = 1;
+    return Region;
+}
+
+OutputRegion OutputRegion::Subsampled(const string& Name, const long int Stride)
+{
+    OutputRegion Region;
+    Region.Name = Name;
+    for(int d = 0; d < 3; d++) Region.Stride[d] = Stride;
+    return Region;
+}
+
+OutputRegion OutputRegion::Parse(const string& Description)
+{
+    stringstream inp(Description);
+    string Name;
+    string Type;
+    inp >> Name >> Type;
+    transform(Type.begin(), Type.end(), Type.begin(), ::toupper);
+
+    long int Stride = 1;
+    if(Type == "BOX")
+    {
+        long int x0, x1, y0, y1, z0, z1;
+        if(inp >> x0 >> x1 >> y0 >> y1 >> z0 >> z1)
+        {
+            inp >> Stride;
+            return Box(Name, x0, x1, y0, y1, z0, z1, Stride);
+        }
+    }
+    else if(Type == "SLICE")
+    {
+        string Direction;
+        long int Position;
+        if(inp >> Direction >> Position)
+        {
+            inp >> Stride;
+            transform(Direction.begin(), Direction.end(), Direction.begin(), ::toupper);
+            if(Direction == "X") return Slice(Name, 0, Position, Stride);
+            if(Direction == "Y") return Slice(Name, 1, Position, Stride);
+            if(Direction == "Z") return Slice(Name, 2, Position, Stride);
+        }
+    }
+    else if(Type == "STRIDE")
+    {
+        if(inp >> Stride) return Subsampled(Name, Stride);
+    }
+    ConsoleOutput::WriteExit("Invalid output region \"" + Description + "\".\n"
+                             "Expected \"Name BOX x0 x1 y0 y1 z0 z1 [stride]\", "
+                             "\"Name SLICE X|Y|Z position [stride]\" or \"Name STRIDE stride\"",
+                             thisclassname, "Parse()");
+    OP_Exit(EXIT_FAILURE);
+    return OutputRegion();
+}
+
+OutputRegion::View_t OutputRegion::Local(const Settings& locSettings, const int resolution) const
+{
+    const GridParameters& Grid = locSettings.Grid;
+    const long int Refinement[3] = {resolution == 1 ? 1 : Grid.dNx + 1,
+                                    resolution == 1 ? 1 : Grid.dNy + 1,
+                                    resolution == 1 ? 1 : Grid.dNz + 1};
+    const long int TotalN[3] = {Grid.TotalNx, Grid.TotalNy, Grid.TotalNz};
+    const long int LocalN[3] = {Grid.Nx, Grid.Ny, Grid.Nz};
+    const long int Offset[3] = {Grid.OffsetX, Grid.OffsetY, Grid.OffsetZ};
+
+    View_t View;
+    for(int d = 0; d < 3; d++)
+    {
+        const long int R    = Refinement[d];
+        const long int Size = R*TotalN[d];
+        const long int B    = min(max(Begin[d]*R, 0l), Size);
+        long int E = (End[d] < 0) ? Size : min(max(End[d]*R, B), Size);
+        /* A slice has one output plane at any resolution */
+        if(End[d] == Begin[d] + 1) E = min(B + 1, Size);
+        const long int S = max(Stride[d], 1l);
+
+        /* Output points B + n*S, n in [0, Total), which lie in the local
+        range [LocB, LocE) of the storage */
+        const long int LocB = R*Offset[d];
+        const long int LocE = LocB + R*LocalN[d];
+        const long int Total = (E - B + S - 1)/S;
+        const long int n0 = (LocB <= B) ? 0 : min((LocB - B + S - 1)/S, Total);
+        const long int n1 = (LocE <= B) ? 0 : min((LocE - B + S - 1)/S, Total);
+
+        View.Total[d]  = Total;
+        View.N[d]      = max(n1 - n0, 0l);
+        View.Offset[d] = (View.N[d] > 0) ? n0 : 0;
+        View.First[d]  = B + n0*S - LocB;
+        View.Begin[d]  = B;
+        View.Stride[d] = S;
+    }
+    return View;
+}
+
+vector<OutputField> OutputRegion::Restrict(const vector<OutputField>& ListOfFields,
+                                           const View_t& View, const string& Prefix) const
+{
+    const long int fx = View.First[0];
+    const long int fy = View.First[1];
+    const long int fz = View.First[2];
+    const long int sx = View.Stride[0];
+    const long int sy = View.Stride[1];
+    const long int sz = View.Stride[2];
+
+    vector<OutputField> Result;
+    Result.reserve(ListOfFields.size());
+    for(const OutputField& Field : ListOfFields)
+    {
+        auto Function = Field.Function;
+        OutputField Restricted(Prefix + Field.Name,
+            [Function, fx, fy, fz, sx, sy, sz](const int i, const int j, const int k)
+            {
+                return Function(fx + i*sx, fy + j*sy, fz + k*sz);
+            });
+        /* The type is taken from the full field, the local part may be empty */
+        Restricted.Type = Field.ValueType();
+        Result.push_back(std::move(Restricted));
+    }
+    return Result;
+}
+
+string OutputRegion::FileName(const string& Filename) const
+{
+    const size_t sep = Filename.find_last_of("/\\");
+    if(sep == string::npos) return Name + "_" + Filename;
+    return Filename.substr(0, sep + 1) + Name + "_" + Filename.substr(sep + 1);
+}
+
+}// namespace openphase
@@ -0,0 +1,352 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#ifdef MPI_PARALLEL
+
+#include "PencilFFT.h"
+#include "GridParameters.h"
+#include "Tools/TimeInfo.h"
+
+namespace openphase
+{
+using namespace std;
+
+enum PencilLayouts {Brick, ZReal, ZComplex, YPencil, XPencil};
+
+PencilFFT::~PencilFFT(void)
+{
+    Free();
+}
+
+void PencilFFT::Split(const int N, const int P, const int rank,
+                      int& offset, int& size)
+{
+    size   = N/P + (rank < N%P);
+    offset = rank*(N/P) + min(rank, N%P);
+}
+
+void PencilFFT::ProcessGrid(const GridParameters& Grid, int& P1, int& P2)
+{
+    /* P1 splits X in the Z- and Y-pencils and Y in the X-pencils, P2 splits Y
+    in the Z-pencils and Z in the Y- and X-pencils. The most square grid
+    which leaves no process without data is selected. */
+    const int N0  = Grid.TotalNx;
+    const int N1  = Grid.TotalNy;
+    const int N2c = Grid.TotalNz/2 + 1;
+
+    P1 = 0;
+    for(int p = 1; p <= MPI_SIZE; p++)
+    if(MPI_SIZE % p == 0 and p <= min(N0,N1) and MPI_SIZE/p <= min(N1,N2c))
+    {
+        if(P1 == 0 or abs(p - MPI_SIZE/p) < abs(P1 - MPI_SIZE/P1)) P1 = p;
+    }
+    if(P1 == 0)
+    {
+        ConsoleOutput::WriteExit("The grid " + to_string(N0) + "x" + to_string(N1) + "x" + to_string(Grid.TotalNz) +
+                                 " is too small for the pencil decomposition on " + to_string(MPI_SIZE) +
+                                 " MPI processes", "PencilFFT", "ProcessGrid()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    P2 = MPI_SIZE/P1;
+}
+
+std::array<PencilFFT::Layout,5> PencilFFT::Layouts(const GridParameters& Grid)
+{
+    const int N0  = Grid.TotalNx;
+    const int N1  = Grid.TotalNy;
+    const int N2  = Grid.TotalNz;
+    const int N2c = Grid.TotalNz/2 + 1;
+
+    int P1 = 1;
+    int P2 = 1;
+    ProcessGrid(Grid, P1, P2);
+    const int R1 = MPI_RANK / P2;
+    const int R2 = MPI_RANK % P2;
+
+    std::array<Layout,5> L;
+
+    L[Brick].Offset[0] = Grid.OffsetX; L[Brick].Size[0] = Grid.Nx;
+    L[Brick].Offset[1] = Grid.OffsetY; L[Brick].Size[1] = Grid.Ny;
+    L[Brick].Offset[2] = Grid.OffsetZ; L[Brick].Size[2] = Grid.Nz;
+    L[Brick].Stride = 2*(Grid.Nz/2 + 1);
+    L[Brick].Width  = 1;
+
+    Split(N0, P1, R1, L[ZReal].Offset[0], L[ZReal].Size[0]);
+    Split(N1, P2, R2, L[ZReal].Offset[1], L[ZReal].Size[1]);
+    L[ZReal].Size[2] = N2;
+    L[ZReal].Stride  = N2;
+    L[ZReal].Width   = 1;
+
+    L[ZComplex] = L[ZReal];
+    L[ZComplex].Size[2] = N2c;
+    L[ZComplex].Stride  = N2c;
+    L[ZComplex].Width   = 2;
+
+    Split(N0,  P1, R1, L[YPencil].Offset[0], L[YPencil].Size[0]);
+    Split(N2c, P2, R2, L[YPencil].Offset[2], L[YPencil].Size[2]);
+    L[YPencil].Size[1] = N1;
+    L[YPencil].Stride  = L[YPencil].Size[2];
+    L[YPencil].Width   = 2;
+
+    Split(N1,  P1, R1, L[XPencil].Offset[1], L[XPencil].Size[1]);
+    Split(N2c, P2, R2, L[XPencil].Offset[2], L[XPencil].Size[2]);
+    L[XPencil].Size[0] = N0;
+    L[XPencil].Stride  = L[XPencil].Size[2];
+    L[XPencil].Width   = 2;
+
+    return L;
+}
+
+size_t PencilFFT::LocalSize(const GridParameters& Grid)
+{
+    size_t size = 0;
+    for(const Layout& L : Layouts(Grid))
+    {
+        size = max(size, size_t(L.Size[0])*L.Size[1]*L.Stride*L.Width);
+    }
+    // Keeps all components aligned for the SIMD kernels of FFTW
+    return (size + 7)/8*8;
+}
+
+void PencilFFT::Initialize(const GridParameters& Grid, const size_t nComponents,
+                           double* data, const unsigned int flags)
+{
+    Free();
+
+    nComp    = nComponents;
+    CompSize = LocalSize(Grid);
+    Data     = data;
+    WorkA    = (double *)fftw_malloc(sizeof(double)*CompSize*nComp);
+    WorkB    = (double *)fftw_malloc(sizeof(double)*CompSize*nComp);
+
+    const std::array<Layout,5> L = Layouts(Grid);
+
+    SetupTranspose(BrickToZ, L[Brick],    L[ZReal]);
+    SetupTranspose(ZToY,     L[ZComplex], L[YPencil]);
+    SetupTranspose(YToX,     L[YPencil],  L[XPencil]);
+    SetupTranspose(XToY,     L[XPencil],  L[YPencil]);
+    SetupTranspose(YToZ,     L[YPencil],  L[ZComplex]);
+    SetupTranspose(ZToBrick, L[ZReal],    L[Brick]);
+
+    for(int d = 0; d < 3; d++)
+    {
+        SpectralN[d]      = L[XPencil].Size[d];
+        SpectralOffset[d] = L[XPencil].Offset[d];
+    }
+
+    const int N0  = Grid.TotalNx;
+    const int N1  = Grid.TotalNy;
+    const int N2  = Grid.TotalNz;
+    const int N2c = Grid.TotalNz/2 + 1;
+    const int RealDist    = CompSize;
+    const int ComplexDist = CompSize/2;
+    fftw_complex* cData  = reinterpret_cast<fftw_complex*>(Data);
+    fftw_complex* cWorkA = reinterpret_cast<fftw_complex*>(WorkA);
+    fftw_complex* cWorkB = reinterpret_cast<fftw_complex*>(WorkB);
+
+    // Z-pencils: real to complex along the contiguous Z direction
+    {
+        const int nZ = L[ZReal].Size[0]*L[ZReal].Size[1];
+        fftw_iodim dimF = {N2, 1, 1};
+        fftw_iodim howF[2] = {{int(nComp), RealDist, ComplexDist}, {nZ, N2, N2c}};
+        ForwardZ = fftw_plan_guru_dft_r2c(1, &dimF, 2, howF, WorkA, cWorkB, flags);
+
+        fftw_iodim dimB = {N2, 1, 1};
+        fftw_iodim howB[2] = {{int(nComp), ComplexDist, RealDist}, {nZ, N2c, N2}};
+        BackwardZ = fftw_plan_guru_dft_c2r(1, &dimB, 2, howB, cWorkB, WorkA, flags);
+    }
+    // Y-pencils: complex to complex along Y, in place
+    {
+        const int nX = L[YPencil].Size[0];
+        const int nZ = L[YPencil].Size[2];
+        fftw_iodim dim = {N1, nZ, nZ};
+        fftw_iodim how[3] = {{int(nComp), ComplexDist, ComplexDist},
+                             {nX, N1*nZ, N1*nZ}, {nZ, 1, 1}};
+        ForwardY  = fftw_plan_guru_dft(1, &dim, 3, how, cWorkA, cWorkA, FFTW_FORWARD,  flags);
+        BackwardY = fftw_plan_guru_dft(1, &dim, 3, how, cWorkA, cWorkA, FFTW_BACKWARD, flags);
+    }
+    // X-pencils: complex to complex along X, in place in the user array
+    {
+        const int nYZ = L[XPencil].Size[1]*L[XPencil].Size[2];
+        fftw_iodim dim = {N0, nYZ, nYZ};
+        fftw_iodim how[2] = {{int(nComp), ComplexDist, ComplexDist}, {nYZ, 1, 1}};
+        ForwardX  = fftw_plan_guru_dft(1, &dim, 2, how, cData, cData, FFTW_FORWARD,  flags);
+        BackwardX = fftw_plan_guru_dft(1, &dim, 2, how, cData, cData, FFTW_BACKWARD, flags);
+    }
+    Plans = {ForwardZ, ForwardY, ForwardX, BackwardX, BackwardY, BackwardZ};
+}
+
+void PencilFFT::Free(void)
+{
+    for(fftw_plan& Plan : Plans)
+    {
+        fftw_destroy_plan(Plan);
+    }
+    Plans.clear();
+    fftw_free(WorkA);
+    fftw_free(WorkB);
+    WorkA = nullptr;
+    WorkB = nullptr;
+    Data  = nullptr;
+}
+
+void PencilFFT::SetupTranspose(Transpose& T, const Layout& In, const Layout& Out)
+{
+    T.In  = In;
+    T.Out = Out;
+
+    int local[12];
+    for(int d = 0; d < 3; d++)
+    {
+        local[d    ] = In.Offset[d];
+        local[d + 3] = In.Size[d];
+        local[d + 6] = Out.Offset[d];
+        local[d + 9] = Out.Size[d];
+    }
+    vector<int> all(12*MPI_SIZE);
+    OP_MPI_Allgather(local, 12, OP_MPI_INT, all.data(), 12, OP_MPI_INT, OP_MPI_COMM_WORLD);
+
+    /* Intersection of the local layout with the global box of another
+    process, in local indices of the local layout */
+    auto Intersect = [](const Layout& Local, const int* offset, const int* size)
+    {
+        Layout Box = Local;
+        for(int d = 0; d < 3; d++)
+        {
+            const int begin = max(Local.Offset[d], offset[d]);
+            const int end   = min(Local.Offset[d] + Local.Size[d], offset[d] + size[d]);
+            Box.Offset[d] = begin - Local.Offset[d];
+            Box.Size[d]   = max(end - begin, 0);
+        }
+        return Box;
+    };
+
+    T.SendBoxes.resize(MPI_SIZE);
+    T.RecvBoxes.resize(MPI_SIZE);
+    T.SendCounts.assign(MPI_SIZE, 0);
+    T.SendDispls.assign(MPI_SIZE, 0);
+    T.RecvCounts.assign(MPI_SIZE, 0);
+    T.RecvDispls.assign(MPI_SIZE, 0);
+
+    size_t sendSize = 0;
+    size_t recvSize = 0;
+    for(int p = 0; p < MPI_SIZE; p++)
+    {
+        const int* remote = &all[12*p];
+        T.SendBoxes[p] = Intersect(In,  remote + 6, remote + 9);
+        T.RecvBoxes[p] = Intersect(Out, remote,     remote + 3);
+
+        const Layout& S = T.SendBoxes[p];
+        const Layout& R = T.RecvBoxes[p];
+        T.SendCounts[p] = S.Size[0]*S.Size[1]*S.Size[2]*S.Width*nComp;
+        T.RecvCounts[p] = R.Size[0]*R.Size[1]*R.Size[2]*R.Width*nComp;
+        T.SendDispls[p] = sendSize;
+        T.RecvDispls[p] = recvSize;
+        sendSize += T.SendCounts[p];
+        recvSize += T.RecvCounts[p];
+    }
+    SendBuffer.resize(max(SendBuffer.size(), sendSize));
+    RecvBuffer.resize(max(RecvBuffer.size(), recvSize));
+}
+
+void PencilFFT::Execute(const Transpose& T, const double* in, double* out)
+{
+    /* Both sides traverse the exchanged boxes in the global X, Y, Z order,
+    each Z-row is a contiguous run of doubles in all layouts */
+    TimeInfo::Communication Timer("FFT transpose");
+    for(int p = 0; p < MPI_SIZE; p++)
+    if(p != MPI_RANK)
+    {
+        Timer.Bytes += double(T.SendCounts[p])*sizeof(double);
+    }
+
+    for(int p = 0; p < MPI_SIZE; p++)
+    if(T.SendCounts[p])
+    {
+        const Layout& Box = T.SendBoxes[p];
+        const int W   = Box.Width;
+        const int row = Box.Size[2]*W;
+        double* buffer = SendBuffer.data() + T.SendDispls[p];
+
+        #pragma omp parallel for collapse(3)
+        for(size_t n = 0; n < nComp; n++)
+        for(int i = 0; i < Box.Size[0]; i++)
+        for(int j = 0; j < Box.Size[1]; j++)
+        {
+            const double* src = in + n*CompSize +
+                ((size_t(i + Box.Offset[0])*T.In.Size[1] + j + Box.Offset[1])*T.In.Stride + Box.Offset[2])*W;
+            double* dst = buffer + ((n*Box.Size[0] + i)*Box.Size[1] + j)*row;
+            std::copy(src, src + row, dst);
+        }
+    }
+
+    OP_MPI_Alltoallv(SendBuffer.data(), T.SendCounts.data(), T.SendDispls.data(), OP_MPI_DOUBLE,
+                     RecvBuffer.data(), T.RecvCounts.data(), T.RecvDispls.data(), OP_MPI_DOUBLE,
+                     OP_MPI_COMM_WORLD);
+
+    for(int p = 0; p < MPI_SIZE; p++)
+    if(T.RecvCounts[p])
+    {
+        const Layout& Box = T.RecvBoxes[p];
+        const int W   = Box.Width;
+        const int row = Box.Size[2]*W;
+        const double* buffer = RecvBuffer.data() + T.RecvDispls[p];
+
+        #pragma omp parallel for collapse(3)
+        for(size_t n = 0; n < nComp; n++)
+        for(int i = 0; i < Box.Size[0]; i++)
+        for(int j = 0; j < Box.Size[1]; j++)
+        {
+            const double* src = buffer + ((n*Box.Size[0] + i)*Box.Size[1] + j)*row;
+            double* dst = out + n*CompSize +
+                ((size_t(i + Box.Offset[0])*T.Out.Size[1] + j + Box.Offset[1])*T.Out.Stride + Box.Offset[2])*W;
+            std::copy(src, src + row, dst);
+        }
+    }
+}
+
+void PencilFFT::Forward(void)
+{
+    Execute(BrickToZ, Data, WorkA);
+    fftw_execute(ForwardZ);
+    Execute(ZToY, WorkB, WorkA);
+    fftw_execute(ForwardY);
+    Execute(YToX, WorkA, Data);
+    fftw_execute(ForwardX);
+}
+
+void PencilFFT::Backward(void)
+{
+    fftw_execute(BackwardX);
+    Execute(XToY, Data, WorkA);
+    fftw_execute(BackwardY);
+    Execute(YToZ, WorkA, WorkB);
+    fftw_execute(BackwardZ);
+    Execute(ZToBrick, WorkA, Data);
+}
+
+}// namespace openphase
+#endif
@@ -35,6 +35,13 @@
 #include "Velocities.h"
 #include "AdvectionHR.h"
 #include "H5Interface.h"
+#include "AsyncOutput.h"
+#include "MappedFile.h"
+#include "TimeSeriesOutput.h"
+#include "Tools/TimeInfo.h"
+#include "LoadBalancer.h"
+#include "Tools/ReductionBatch.h"
+#include "Tools/ConnectedComponents.h"
 
 namespace openphase
 {
@@ -59,6 +66,24 @@ void PhaseField::Initialize(Settings& locSettings, std::string ObjectNameSuffix)
     NucleusVolumeFactor = 1.0;
 
     ConsiderNucleusVolume = true;
+    FlatStorage = false;
+    FusedFinalize = true;
+    FixedStencilKernels = true;
+    IncrementalGrainsVolume = false;
+    GrainsVolumeCheckInterval = 100;
+    IncrementalGrainsTopology = false;
+    GrainsTopologyUpdates = 0;
+    GrainsVolumeIncrementsPending = false;
+    GrainsVolumeUpdates = 0;
+    DeltaGrainsSync = false;
+    GrainsFullSyncInterval = 100;
+    GrainsDeltaSyncs = 0;
+    HaloExchangeInterval = 1;
+    OccupancyBlockSize = OccupancyMap::DefaultBlockSize;
+    HaloSteps = 0;
+    HaloLocalFinalize = false;
+    NarrowBandDR = true;
+    IndexedRawData = false;
     Combine.resize(Nphases, false);
 
     PhaseFieldLaplacianStencil = LaplacianStencils::Isotropic;
@@ -66,7 +91,9 @@ void PhaseField::Initialize(Settings& locSettings, std::string ObjectNameSuffix)
 
     locSettings.AddForAdvection(*this);
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
     locSettings.AddForReading(*this);
+    checkpointable = true;
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -79,7 +106,7 @@ void PhaseField::ReadInput(const string InputFileName)
     std::string filetype = FileInterface::getFileExtension(InputFileName);
     if (filetype == "opi")
     {
-        fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+        stringstream inp = FileInterface::OpenInput(InputFileName);
 
         if (!inp)
         {
@@ -90,8 +117,6 @@ void PhaseField::ReadInput(const string InputFileName)
         std::stringstream data;
         data << inp.rdbuf();
         ReadInput(data);
-
-        inp.close();
     }
     else
     if (filetype == "json")
@@ -111,6 +136,18 @@ void PhaseField::ReadInput(stringstream& inp)
 
     ConsiderNucleusVolume = FileInterface::ReadParameterB(inp, moduleLocation, string("ConsiderNucleusVolume"), false, true);
     NucleusVolumeFactor   = FileInterface::ReadParameterD(inp, moduleLocation, string("NucleusVolumeFactor"), false, 1.0);
+    FlatStorage           = FileInterface::ReadParameterB(inp, moduleLocation, string("FlatStorage"), false, false);
+    FusedFinalize         = FileInterface::ReadParameterB(inp, moduleLocation, string("FusedFinalize"), false, true);
+    FixedStencilKernels   = FileInterface::ReadParameterB(inp, moduleLocation, string("FixedStencils"), false, true);
+    IncrementalGrainsVolume   = FileInterface::ReadParameterB(inp, moduleLocation, string("IncrementalGrainsVolume"), false, false);
+    GrainsVolumeCheckInterval = FileInterface::ReadParameterI(inp, moduleLocation, string("GrainsVolumeCheckInterval"), false, 100);
+    IncrementalGrainsTopology = FileInterface::ReadParameterB(inp, moduleLocation, string("IncrementalGrainsTopology"), false, false);
+    DeltaGrainsSync           = FileInterface::ReadParameterB(inp, moduleLocation, string("DeltaGrainsSync"), false, false);
+    GrainsFullSyncInterval    = FileInterface::ReadParameterI(inp, moduleLocation, string("GrainsFullSyncInterval"), false, 100);
+    HaloExchangeInterval      = FileInterface::ReadParameterI(inp, moduleLocation, string("HaloExchangeInterval"), false, 1);
+    OccupancyBlockSize        = FileInterface::ReadParameterI(inp, moduleLocation, string("OccupancyBlockSize"), false, OccupancyMap::DefaultBlockSize);
+    NarrowBandDR              = FileInterface::ReadParameterB(inp, moduleLocation, string("NarrowBandDR"), false, true);
+    IndexedRawData            = FileInterface::ReadParameterB(inp, moduleLocation, string("IndexedRawData"), false, false);
 
     // Reading combine phase fields conditions for all phases
     for(size_t pIndex = 0; pIndex < Nphases; pIndex++)
@@ -170,6 +207,7 @@ void PhaseField::ReadInput(stringstream& inp)
         ConsoleOutput::WriteWarning("No or wrong gradient stencil specified!\nThe default \"ISOTROPIC\" model is used!", thisclassname, "ReadInput()");
     }
 
+    CheckHaloExchangeInterval();
     SetStencils(Grid);
     AllocateStorages(Grid);
 
@@ -179,13 +217,25 @@ void PhaseField::ReadInput(stringstream& inp)
 
 void PhaseField::ReadJSON(const string InputFileName)
 {
-    std::ifstream f(InputFileName);
+    std::stringstream f = FileInterface::OpenInput(InputFileName);
     json data = json::parse(f);
     if (data.contains(thisclassname))
     {
         json phasefield = data[thisclassname];
         ConsiderNucleusVolume = FileInterface::ReadParameter<bool>(phasefield, {"ConsiderNucleusVolume"}, false);
         NucleusVolumeFactor   = FileInterface::ReadParameter<double>(phasefield, {"NucleusVolumeFactor"}, 1.0);
+        FlatStorage           = FileInterface::ReadParameter<bool>(phasefield, {"FlatStorage"}, false);
+        FusedFinalize         = FileInterface::ReadParameter<bool>(phasefield, {"FusedFinalize"}, true);
+        FixedStencilKernels   = FileInterface::ReadParameter<bool>(phasefield, {"FixedStencils"}, true);
+        IncrementalGrainsVolume   = FileInterface::ReadParameter<bool>(phasefield, {"IncrementalGrainsVolume"}, false);
+        GrainsVolumeCheckInterval = FileInterface::ReadParameter<size_t>(phasefield, {"GrainsVolumeCheckInterval"}, 100);
+        IncrementalGrainsTopology = FileInterface::ReadParameter<bool>(phasefield, {"IncrementalGrainsTopology"}, false);
+        DeltaGrainsSync           = FileInterface::ReadParameter<bool>(phasefield, {"DeltaGrainsSync"}, false);
+        GrainsFullSyncInterval    = FileInterface::ReadParameter<size_t>(phasefield, {"GrainsFullSyncInterval"}, 100);
+        HaloExchangeInterval      = FileInterface::ReadParameter<size_t>(phasefield, {"HaloExchangeInterval"}, 1);
+        OccupancyBlockSize        = FileInterface::ReadParameter<size_t>(phasefield, {"OccupancyBlockSize"}, OccupancyMap::DefaultBlockSize);
+        NarrowBandDR              = FileInterface::ReadParameter<bool>(phasefield, {"NarrowBandDR"}, true);
+        IndexedRawData            = FileInterface::ReadParameter<bool>(phasefield, {"IndexedRawData"}, false);
 
         string tmp1 = FileInterface::ReadParameter<std::string>(phasefield, {"InterfaceNormalModel"}, "AVERAGEGRADIENT");
         if(tmp1 == "AVERAGEGRADIENT")
@@ -237,6 +287,7 @@ void PhaseField::ReadJSON(const string InputFileName)
             ConsoleOutput::WriteWarning("No or wrong gradient stencil specified!\nThe default \"ISOTROPIC\" model is used!", thisclassname, "ReadInput()");
         }
     }
+    CheckHaloExchangeInterval();
     SetStencils(Grid);
     AllocateStorages(Grid);
     ConsoleOutput::WriteLine();
@@ -336,6 +387,24 @@ void PhaseField::SetStencils(GridParameters& Grid)
             break;
         }
     }
+    SelectDerivativesKernelSR();
+}
+
+void PhaseField::SelectDerivativesKernelSR(void)
+{
+    /* The stencils are fixed by the active dimensions and the chosen stencil
+    types. The kernel is compiled for each combination with the stencil
+    offsets and weights as constants and selected once here.*/
+    FixedLaplacianScale = 1.0/(Grid.dx*Grid.dx);
+    FixedGradientScale  = 1.0/Grid.dx;
+    FixedDerivativesKernelSR = nullptr;
+    FixedStencils::LaplacianAndGradient(PhaseFieldLaplacianStencil,
+                                        PhaseFieldGradientStencil, Grid,
+                                        [this](auto LStencilType, auto GStencilType)
+    {
+        FixedDerivativesKernelSR = &PhaseField::CalculateTemporaryDerivativesFixedSR<
+                                   decltype(LStencilType), decltype(GStencilType)>;
+    });
 }
 
 void PhaseField::AllocateStorages(GridParameters& Grid)
@@ -406,6 +475,9 @@ void PhaseField::Clear()
         }
         OMP_PARALLEL_STORAGE_LOOP_END
     }
+    InterfaceCells.clear();
+    InterfaceCellsDR.clear();
+    Occupancy.Clear();
 }
 
 void PhaseField::CalculateFractions(void)
@@ -565,58 +637,212 @@ NodePF PhaseField::FieldsLaplaciansDR(const int i, const int j, const int k) con
 
 void PhaseField::CalculateDerivativesSR(void)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+    if(FlatStorage)
     {
-        if(Fields(i,j,k).wide_interface())
-        {
-            Fields(i,j,k).set_temporary();
+        /* Neighbor values are gathered from the contiguous flat snapshot,
+        therefore the derivatives can be accumulated in place and no temporary
+        copy of the fields is needed.*/
+        FieldsFlat.Rebuild(Fields);
 
-            for (auto ls = LStencil.cbegin(); ls != LStencil.cend(); ls++)
+        OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+        {
+            if(FieldsFlat(i,j,k).wide_interface())
             {
-                int ii = ls->di;
-                int jj = ls->dj;
-                int kk = ls->dk;
-
-                for (auto it  = Fields(i + ii, j + jj, k + kk).cbegin();
-                          it != Fields(i + ii, j + jj, k + kk).cend(); ++it)
-                if (it->value != 0.0)
+                for (auto ls = LStencil.cbegin(); ls != LStencil.cend(); ls++)
+                {
+                    const NodePFView locPF = FieldsFlat(i + ls->di, j + ls->dj, k + ls->dk);
+                    for (auto it = locPF.cbegin(); it != locPF.cend(); ++it)
+                    if (it->value != 0.0)
+                    {
+                        Fields(i,j,k).add_laplacian(it->index, ls->weight * it->value);
+                    }
+                }
+                for (auto gs = GStencil.cbegin(); gs != GStencil.cend(); ++gs)
                 {
-                    double laplacian = ls->weight * it->value;
-                    Fields(i,j,k).add_laplacian_tmp(it->index, laplacian);
+                    const NodePFView locPF = FieldsFlat(i + gs->di, j + gs->dj, k + gs->dk);
+                    for (auto it = locPF.cbegin(); it != locPF.cend(); ++it)
+                    if (it->value != 0.0)
+                    {
+                        double value_x = gs->weightX * it->value;
+                        double value_y = gs->weightY * it->value;
+                        double value_z = gs->weightZ * it->value;
+                        Fields(i,j,k).add_gradient(it->index, (dVector3){value_x,value_y,value_z});
+                    }
                 }
             }
-            for (auto gs = GStencil.cbegin(); gs != GStencil.cend(); ++gs)
+        }
+        OMP_PARALLEL_TILED_STORAGE_LOOP_END
+        return;
+    }
+
+    #pragma omp parallel
+    {
+        CalculateDerivativesTeamSR();
+    }
+}
+
+void PhaseField::CalculateDerivativesTeamSR(void)
+{
+    OMP_TILED_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+    {
+        CalculateTemporaryDerivativesSR(i,j,k);
+    }
+    OMP_TILED_STORAGE_LOOP_END
+    OMP_TILED_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+    {
+        if(Fields(i,j,k).wide_interface())
+        {
+            Fields(i,j,k).copy_from_temporary();
+        }
+    }
+    OMP_TILED_STORAGE_LOOP_END
+}
+
+template<class LaplacianStencilType, class GradientStencilType>
+void PhaseField::CalculateTemporaryDerivativesFixedSR(const long int i, const long int j, const long int k)
+{
+    Fields(i,j,k).set_temporary();
+
+    const double LScale = FixedLaplacianScale;
+    const double GScale = FixedGradientScale;
+    LaplacianStencilType::ForEach([&](const LaplacianStencil::LaplacianStencilEntry& ls, size_t)
+    {
+        const NodePF& locPF = Fields(i + ls.di, j + ls.dj, k + ls.dk);
+        const double weight = ls.weight * LScale;
+        for (auto it = locPF.cbegin(); it != locPF.cend(); ++it)
+        if (it->value != 0.0)
+        {
+            Fields(i,j,k).add_laplacian_tmp(it->index, weight * it->value);
+        }
+    });
+    GradientStencilType::ForEach([&](const GradientStencil::GradientStencilEntry& gs, size_t)
+    {
+        const NodePF& locPF = Fields(i + gs.di, j + gs.dj, k + gs.dk);
+        const double weightX = gs.weightX * GScale;
+        const double weightY = gs.weightY * GScale;
+        const double weightZ = gs.weightZ * GScale;
+        for (auto it = locPF.cbegin(); it != locPF.cend(); ++it)
+        if (it->value != 0.0)
+        {
+            double value_x = weightX * it->value;
+            double value_y = weightY * it->value;
+            double value_z = weightZ * it->value;
+            Fields(i,j,k).add_gradient_tmp(it->index, (dVector3){value_x,value_y,value_z});
+        }
+    });
+}
+
+void PhaseField::CalculateTemporaryDerivativesSR(const long int i, const long int j, const long int k)
+{
+    if(Fields(i,j,k).wide_interface())
+    {
+        if(FixedStencilKernels and FixedDerivativesKernelSR)
+        {
+            (this->*FixedDerivativesKernelSR)(i,j,k);
+            return;
+        }
+        Fields(i,j,k).set_temporary();
+
+        for (auto ls = LStencil.cbegin(); ls != LStencil.cend(); ls++)
+        {
+            int ii = ls->di;
+            int jj = ls->dj;
+            int kk = ls->dk;
+
+            for (auto it  = Fields(i + ii, j + jj, k + kk).cbegin();
+                      it != Fields(i + ii, j + jj, k + kk).cend(); ++it)
+            if (it->value != 0.0)
             {
-                int ii = gs->di;
-                int jj = gs->dj;
-                int kk = gs->dk;
+                double laplacian = ls->weight * it->value;
+                Fields(i,j,k).add_laplacian_tmp(it->index, laplacian);
+            }
+        }
+        for (auto gs = GStencil.cbegin(); gs != GStencil.cend(); ++gs)
+        {
+            int ii = gs->di;
+            int jj = gs->dj;
+            int kk = gs->dk;
 
-                for (auto it  = Fields(i + ii, j + jj, k + kk).cbegin();
-                          it != Fields(i + ii, j + jj, k + kk).cend(); ++it)
-                if (it->value != 0.0)
-                {
-                    double value_x = gs->weightX * it->value;
-                    double value_y = gs->weightY * it->value;
-                    double value_z = gs->weightZ * it->value;
-                    Fields(i,j,k).add_gradient_tmp(it->index, (dVector3){value_x,value_y,value_z});
-                }
+            for (auto it  = Fields(i + ii, j + jj, k + kk).cbegin();
+                      it != Fields(i + ii, j + jj, k + kk).cend(); ++it)
+            if (it->value != 0.0)
+            {
+                double value_x = gs->weightX * it->value;
+                double value_y = gs->weightY * it->value;
+                double value_z = gs->weightZ * it->value;
+                Fields(i,j,k).add_gradient_tmp(it->index, (dVector3){value_x,value_y,value_z});
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+}
+
+void PhaseField::SetBoundaryConditionsAndDerivativesSR(const BoundaryConditions& BC)
+{
+    if(FlatStorage)
+    {
+        // The flat snapshot is built from the complete storage including the halo
+        BC.BeginExchange(Fields);
+        BC.EndExchange(Fields);
+        CalculateDerivativesSR();
+        return;
+    }
+
+    /* Laplacian and gradient stencils reach one cell, the interior cells are
+    therefore calculated while the halo is exchanged. Derivatives are
+    accumulated in the temporary storage of the nodes, the neighbor values used
+    by the stencils are not modified before the final copy.*/
+    BC.ExchangeAndApply(Fields, 1, Fields.Bcells()-1, [this](long int i, long int j, long int k)
+    {
+        CalculateTemporaryDerivativesSR(i,j,k);
+    });
+    OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
     {
         if(Fields(i,j,k).wide_interface())
         {
             Fields(i,j,k).copy_from_temporary();
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_TILED_STORAGE_LOOP_END
 }
 
 void PhaseField::CalculateDerivativesDR(void)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, FieldsDR, FieldsDR.Bcells()-1,)
+    if(FlatStorage)
+    {
+        FieldsFlat.Rebuild(FieldsDR);
+
+        OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i, j, k, FieldsDR, FieldsDR.Bcells()-1,)
+        {
+            if(FieldsFlat(i,j,k).wide_interface())
+            {
+                for (auto ls = LStencil.cbegin(); ls != LStencil.cend(); ls++)
+                {
+                    const NodePFView locPF = FieldsFlat(i + ls->di, j + ls->dj, k + ls->dk);
+                    for (auto it = locPF.cbegin(); it != locPF.cend(); ++it)
+                    if (it->value != 0.0)
+                    {
+                        FieldsDR(i,j,k).add_laplacian(it->index, 4.0*ls->weight * it->value);
+                    }
+                }
+                for (auto gs = GStencil.cbegin(); gs != GStencil.cend(); ++gs)
+                {
+                    const NodePFView locPF = FieldsFlat(i + gs->di, j + gs->dj, k + gs->dk);
+                    for (auto it = locPF.cbegin(); it != locPF.cend(); ++it)
+                    if (it->value != 0.0)
+                    {
+                        double value_x = 2.0*gs->weightX * it->value;
+                        double value_y = 2.0*gs->weightY * it->value;
+                        double value_z = 2.0*gs->weightZ * it->value;
+                        FieldsDR(i,j,k).add_gradient(it->index, (dVector3){value_x,value_y,value_z});
+                    }
+                }
+            }
+        }
+        OMP_PARALLEL_TILED_STORAGE_LOOP_END
+        return;
+    }
+
+    OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i, j, k, FieldsDR, FieldsDR.Bcells()-1,)
     {
         if(FieldsDR(i,j,k).wide_interface())
         {
@@ -654,15 +880,15 @@ void PhaseField::CalculateDerivativesDR(void)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, FieldsDR, FieldsDR.Bcells()-1,)
+    OMP_PARALLEL_TILED_STORAGE_LOOP_END
+    OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i, j, k, FieldsDR, FieldsDR.Bcells()-1,)
     {
         if(FieldsDR(i,j,k).wide_interface())
         {
             FieldsDR(i,j,k).copy_from_temporary();
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_TILED_STORAGE_LOOP_END
 }
 /*
 NodePF PhaseField::FieldsGradients(const int i, const int j, const int k) const
@@ -809,7 +1035,7 @@ dMatrix3x3 PhaseField::EffectiveOrientation(const int i, const int j, const int
     return locQuaternion.RotationMatrix;
 }
 
-void PhaseField::CalculateGrainsVolume(void)
+std::vector<double> PhaseField::ScanGrainsVolume(void) const
 {
     int Nthreads = 1;
 
@@ -817,7 +1043,7 @@ void PhaseField::CalculateGrainsVolume(void)
     Nthreads = omp_get_max_threads();
     #endif
     const size_t size = FieldsProperties.size();
-    vector<vector<double>> Volume(Nthreads);
+    vector<vector<sum_real_t>> Volume(Nthreads);
     for(int t = 0; t < Nthreads; t++)
     {
         Volume[t].resize(size, 0.0);
@@ -840,55 +1066,360 @@ void PhaseField::CalculateGrainsVolume(void)
     OMP_PARALLEL_STORAGE_LOOP_END
 
     // Add volumes from different OpenMP chunks
+    std::vector<double> result(size, 0.0);
     for(size_t idx = 0; idx < size; idx++)
     {
-        FieldsProperties[idx].Volume = 0.0;
+        sum_real_t locVolume = Volume[0][idx];
+        for(int t = 1; t < Nthreads; t++)
+        {
+            locVolume += Volume[t][idx];
+        }
+        result[idx] = double(locVolume);
+    }
+    return result;
+}
+
+bool PhaseField::BeginGrainsVolumeIncrements(void)
+{
+    /* The incremental update needs a valid set of local grain volumes from the
+    last call of CalculateGrainsVolume() and is only done if merging is the
+    only change of the phase fields before CalculateGrainsVolume() is called.*/
+    if(not IncrementalGrainsVolume or
+       Grid.Resolution != Resolutions::Single or
+       GrainsVolumeLocal.size() != FieldsProperties.size() or
+       std::find(Combine.begin(), Combine.end(), true) != Combine.end())
+    {
+        GrainsVolumeIncrementsPending = false;
+        return false;
+    }
+    GrainsVolumeIncrements.Reset(Tensor<sum_real_t,1>({FieldsProperties.size()}));
+    GrainsVolumeIncrementsPending = true;
+    return true;
+}
+
+bool PhaseField::BeginGrainsTopologyIncrements(void)
+{
+    // Same conditions as for the grain volumes, a valid topology from the last scan is needed
+    if(not IncrementalGrainsTopology or
+       not Topology.Valid() or
+       Grid.Resolution != Resolutions::Single or
+       std::find(Combine.begin(), Combine.end(), true) != Combine.end())
+    {
+        return false;
+    }
+    Topology.BeginIncrements();
+    return true;
+}
+
+void PhaseField::AddCellVolumeSR(const long int i, const long int j,
+                                 const long int k, const double sign)
+{
+    Tensor<sum_real_t,1>& locIncrements = GrainsVolumeIncrements.Local();
+    for(auto it  = Fields(i,j,k).cbegin();
+             it != Fields(i,j,k).cend(); ++it)
+    {
+        locIncrements({it->index}) += sign*it->value;
+    }
+}
+
+bool PhaseField::BeginFrontIncrements(void)
+{
+    // Same conditions as for the grain volumes, valid plane sums from the last update are needed
+    if(FrontAxis < 0 or
+       Grid.Resolution != Resolutions::Single or
+       long(FrontPlanesLocal.size()) != FrontPlanesSize() or
+       std::find(Combine.begin(), Combine.end(), true) != Combine.end())
+    {
+        FrontPlanesIncrementsPending = false;
+        return false;
+    }
+    FrontPlanesIncrements.Reset(Tensor<sum_real_t,1>({FrontPlanesLocal.size()}));
+    FrontPlanesIncrementsPending = true;
+    return true;
+}
 
-        for(int t = 0; t < Nthreads; t++)
+void PhaseField::AddCellFrontSR(const long int i, const long int j,
+                                const long int k, const double sign)
+{
+    double fraction = 0.0;
+    for(auto it  = Fields(i,j,k).cbegin();
+             it != Fields(i,j,k).cend(); ++it)
+    if(FieldsProperties[it->index].Phase == FrontPhase)
+    {
+        fraction += it->value;
+    }
+    if(fraction != 0.0)
+    {
+        const size_t plane = (FrontAxis == 0) ? i : ((FrontAxis == 1) ? j : k);
+        FrontPlanesIncrements.Local()({plane}) += sign*fraction;
+    }
+}
+
+void PhaseField::UpdateFront(void)
+{
+    if(FrontAxis < 0) return;
+
+    if(FrontPlanesIncrementsPending and
+       (GrainsVolumeCheckInterval == 0 or FrontPlanesUpdates < GrainsVolumeCheckInterval))
+    {
+        const Tensor<sum_real_t,1> locIncrements = FrontPlanesIncrements.SumElementwise();
+        for(size_t p = 0; p < FrontPlanesLocal.size(); p++)
+        {
+            FrontPlanesLocal[p] += double(locIncrements({p}));
+        }
+        FrontPlanesUpdates++;
+    }
+    else
+    {
+        const size_t size = FrontPlanesSize();
+        FrontPlanesIncrements.Reset(Tensor<sum_real_t,1>({size}));
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
         {
-            FieldsProperties[idx].Volume += Volume[t][idx];
+            AddCellFrontSR(i,j,k,1.0);
         }
+        OMP_PARALLEL_STORAGE_LOOP_END
+        const Tensor<sum_real_t,1> locPlanes = FrontPlanesIncrements.SumElementwise();
+        FrontPlanesLocal.assign(size, 0.0);
+        for(size_t p = 0; p < size; p++)
+        {
+            FrontPlanesLocal[p] = double(locPlanes({p}));
+        }
+        FrontPlanesUpdates = 0;
     }
+    FrontPlanesIncrementsPending = false;
+}
 
-    // Update FieldsProperties across MPI domains
+void PhaseField::TrackFront(const size_t phase, const int axis)
+{
+    if(axis < 0 or axis > 2 or phase >= Nphases)
+    {
+        ConsoleOutput::WriteExit("Wrong front tracking axis or phase index", thisclassname, "TrackFront()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    if(FrontAxis != axis or FrontPhase != phase or FrontPlanesLocal.empty())
+    {
+        FrontAxis  = axis;
+        FrontPhase = phase;
+        FrontPlanesLocal.clear();
+        FrontPlanesIncrementsPending = false;
+        UpdateFront();
+    }
+}
+
+long int PhaseField::FrontPosition(const bool forward) const
+{
+    if(FrontAxis < 0)
+    {
+        ConsoleOutput::WriteExit("Front tracking is not active, call TrackFront() first", thisclassname, "FrontPosition()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    const long int offset = (FrontAxis == 0) ? Grid.OffsetX : ((FrontAxis == 1) ? Grid.OffsetY : Grid.OffsetZ);
+    const long int total  = (FrontAxis == 0) ? Grid.TotalNx : ((FrontAxis == 1) ? Grid.TotalNy : Grid.TotalNz);
+
+    /* Backward fronts are searched as the largest mirrored index, so that a
+    single maximum reduction serves both directions*/
+    long int position = -1;
+    for(size_t p = 0; p < FrontPlanesLocal.size(); p++)
+    if(FrontPlanesLocal[p] >= 0.5)
+    {
+        const long int global = offset + p;
+        position = std::max(position, forward ? global : total - 1 - global);
+    }
 #ifdef MPI_PARALLEL
-    unsigned long loc_size = FieldsProperties.size();
-    unsigned long max_size = loc_size;
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &position, 1, OP_MPI_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    if(position < 0 or forward) return position;
+    return total - 1 - position;
+}
 
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &max_size, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-    if (max_size > loc_size)
+bool PhaseField::InteriorCellSR(const long int i, const long int j, const long int k) const
+{
+    return i >= 0 and i < Fields.sizeX() and
+           j >= 0 and j < Fields.sizeY() and
+           k >= 0 and k < Fields.sizeZ();
+}
+
+void PhaseField::UpdateGrainsTopology(void)
+{
+    if(not IncrementalGrainsTopology) return;
+
+    if(Topology.Pending())
     {
-        FieldsProperties.Resize(max_size);
+        Topology.ApplyIncrements();
+        GrainsTopologyUpdates++;
+
+        if(GrainsVolumeCheckInterval and GrainsTopologyUpdates >= GrainsVolumeCheckInterval)
+        {
+            if(not Topology.Check(Fields))
+            {
+                ConsoleOutput::WriteWarning("Incremental grain contacts deviate from the full scan. "
+                                            "Phase fields were modified outside of MergeIncrements()?",
+                                            thisclassname, "UpdateGrainsTopology()");
+            }
+            GrainsTopologyUpdates = 0;
+        }
     }
+    else
+    {
+        Topology.Scan(Fields);
+        GrainsTopologyUpdates = 0;
+    }
+}
 
-    for(size_t idx = 0; idx < FieldsProperties.size(); idx++)
+void PhaseField::CalculateGrainsVolume(void)
+{
+    const size_t size = FieldsProperties.size();
+    if(GrainsVolumeIncrementsPending)
+    {
+        const Tensor<sum_real_t,1> locIncrements = GrainsVolumeIncrements.SumElementwise();
+        for(size_t idx = 0; idx < size; idx++)
+        {
+            GrainsVolumeLocal[idx] += double(locIncrements({idx}));
+        }
+        GrainsVolumeIncrementsPending = false;
+        GrainsVolumeUpdates++;
+
+        if(GrainsVolumeCheckInterval and GrainsVolumeUpdates >= GrainsVolumeCheckInterval)
+        {
+            // Consistency check, volumes are in grid cells
+            const std::vector<double> ScannedVolume = ScanGrainsVolume();
+            double maxDeviation = 0.0;
+            for(size_t idx = 0; idx < size; idx++)
+            {
+                maxDeviation = std::max(maxDeviation, std::abs(ScannedVolume[idx] - GrainsVolumeLocal[idx]));
+            }
+            if(maxDeviation > 1.0e-6)
+            {
+                std::stringstream message;
+                message << "Incremental grain volumes deviate from the full scan by " << maxDeviation
+                        << " cells. Phase fields were modified outside of MergeIncrements()?";
+                ConsoleOutput::WriteWarning(message.str(), thisclassname, "CalculateGrainsVolume()");
+            }
+            GrainsVolumeLocal = ScannedVolume;
+            GrainsVolumeUpdates = 0;
+        }
+    }
+    else
     {
-        double loc_volume = FieldsProperties[idx].Volume;
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &loc_volume, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        FieldsProperties[idx].Volume = loc_volume;
+        GrainsVolumeLocal = ScanGrainsVolume();
+        GrainsVolumeUpdates = 0;
+    }
 
-        double loc_maxvolume = FieldsProperties[idx].MAXVolume;
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &loc_maxvolume, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-        FieldsProperties[idx].MAXVolume = loc_maxvolume;
+    for(size_t idx = 0; idx < size; idx++)
+    {
+        FieldsProperties[idx].Volume = GrainsVolumeLocal[idx];
+    }
 
-        double loc_refvolume = FieldsProperties[idx].RefVolume;
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &loc_refvolume, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-        FieldsProperties[idx].RefVolume = loc_refvolume;
+    // Update FieldsProperties across MPI domains
+#ifdef MPI_PARALLEL
+    /* A full synchronization is needed if the delta synchronization is off
+    or due, or if the grain table has changed on any rank since the last one */
+    const size_t loc_size = FieldsProperties.size();
+    unsigned long loc_sync[2] = {loc_size, 0};
+    loc_sync[1] = not DeltaGrainsSync or GrainsSynced.size() != 7*loc_size or
+                  (GrainsFullSyncInterval and GrainsDeltaSyncs >= GrainsFullSyncInterval);
+
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, loc_sync, 2, OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    const size_t max_size = loc_sync[0];
+    const bool FullSync = loc_sync[1];
+    if (max_size > loc_size)
+    {
+        FieldsProperties.Resize(max_size);
+        GrainsVolumeLocal.resize(max_size, 0.0);
+    }
 
-        int loc_stage = static_cast<int>(FieldsProperties[idx].Stage);
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &loc_stage, 1, OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-        FieldsProperties[idx].Stage = static_cast<openphase::GrainStages>(loc_stage);
+    /* Local record of each grain: the volume is summed over the ranks,
+    MAXVolume, RefVolume, stage, variant and phase are maximized, the indices
+    are exact in double. The number of grains is bounded by the grain index
+    recycling in add_grain() and by CompactGrainIndices().*/
+    const size_t mpi_size = FieldsProperties.size();
+    std::vector<double> Records(6*mpi_size);
+    for(size_t idx = 0; idx < mpi_size; idx++)
+    {
+        Records[6*idx  ] = FieldsProperties[idx].Volume;
+        Records[6*idx+1] = FieldsProperties[idx].MAXVolume;
+        Records[6*idx+2] = FieldsProperties[idx].RefVolume;
+        Records[6*idx+3] = static_cast<double>(FieldsProperties[idx].Stage);
+        Records[6*idx+4] = FieldsProperties[idx].Variant;
+        Records[6*idx+5] = FieldsProperties[idx].Phase;
+    }
 
-        unsigned long loc_variant = FieldsProperties[idx].Variant;
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &loc_variant, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-        FieldsProperties[idx].Variant = loc_variant;
+    std::vector<unsigned long> Reduced;
+    if(FullSync)
+    {
+        Reduced.resize(mpi_size);
+        std::iota(Reduced.begin(), Reduced.end(), 0);
+        GrainsSynced.assign(7*mpi_size, 0.0);
+        GrainsDeltaSyncs = 0;
+    }
+    else
+    {
+        /* Delta synchronization: only grains whose record has changed on any
+        rank since the last synchronization are reduced, all others keep the
+        synchronized values. GrainsSynced holds the local volume and the
+        global record of each grain after the last synchronization. */
+        std::vector<unsigned long> Changed;
+        for(size_t idx = 0; idx < mpi_size; idx++)
+        {
+            bool changed = Records[6*idx] != GrainsSynced[7*idx];
+            for(size_t n = 1; n < 6 and not changed; n++)
+            {
+                changed = Records[6*idx+n] != GrainsSynced[7*idx+1+n];
+            }
+            if(changed) Changed.push_back(idx);
+        }
+        int Count = Changed.size();
+        std::vector<int> Counts(MPI_SIZE);
+        OP_MPI_Allgather(&Count, 1, OP_MPI_INT, Counts.data(), 1, OP_MPI_INT, OP_MPI_COMM_WORLD);
+        std::vector<int> Displs(MPI_SIZE, 0);
+        for(int r = 1; r < MPI_SIZE; r++)
+        {
+            Displs[r] = Displs[r-1] + Counts[r-1];
+        }
+        std::vector<unsigned long> AllChanged(Displs.back() + Counts.back());
+        OP_MPI_Allgatherv(Changed.data(), Count, OP_MPI_UNSIGNED_LONG, AllChanged.data(),
+                          Counts.data(), Displs.data(), OP_MPI_UNSIGNED_LONG, OP_MPI_COMM_WORLD);
+        std::vector<char> Marked(mpi_size, 0);
+        for(const unsigned long idx : AllChanged) Marked[idx] = 1;
+        for(size_t idx = 0; idx < mpi_size; idx++)
+        if(Marked[idx])
+        {
+            Reduced.push_back(idx);
+        }
+        GrainsDeltaSyncs++;
+    }
 
-        unsigned long loc_phase = FieldsProperties[idx].Phase;
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &loc_phase, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-        FieldsProperties[idx].Phase = loc_phase;
+    std::vector<double> loc_volume(Reduced.size());
+    std::vector<double> loc_maxima(5*Reduced.size());
+    for(size_t n = 0; n < Reduced.size(); n++)
+    {
+        loc_volume[n] = Records[6*Reduced[n]];
+        for(size_t m = 0; m < 5; m++) loc_maxima[5*n+m] = Records[6*Reduced[n]+1+m];
+    }
+    ReductionBatch Batch;
+    Batch.Sum(loc_volume.data(), loc_volume.size());
+    Batch.Max(loc_maxima.data(), loc_maxima.size());
+    Batch.Reduce();
 
-        //TODO: add other missing reductions
+    for(size_t idx = 0; idx < mpi_size; idx++)
+    {
+        GrainsSynced[7*idx] = Records[6*idx];
     }
+    for(size_t n = 0; n < Reduced.size(); n++)
+    {
+        GrainsSynced[7*Reduced[n]+1] = loc_volume[n];
+        for(size_t m = 0; m < 5; m++) GrainsSynced[7*Reduced[n]+2+m] = loc_maxima[5*n+m];
+    }
+    for(size_t idx = 0; idx < mpi_size; idx++)
+    {
+        FieldsProperties[idx].Volume    = GrainsSynced[7*idx+1];
+        FieldsProperties[idx].MAXVolume = GrainsSynced[7*idx+2];
+        FieldsProperties[idx].RefVolume = GrainsSynced[7*idx+3];
+        FieldsProperties[idx].Stage     = static_cast<openphase::GrainStages>(lround(GrainsSynced[7*idx+4]));
+        FieldsProperties[idx].Variant   = lround(GrainsSynced[7*idx+5]);
+        FieldsProperties[idx].Phase     = lround(GrainsSynced[7*idx+6]);
+    }
+    //TODO: add other missing reductions
 #endif
 
     // Calculate MAXVolume and VolumeRatio for all phase fields
@@ -948,29 +1479,284 @@ void PhaseField::CalculateGrainsVolume(void)
     {
         FractionsTotal[n] /= double(Grid.TotalNumberOfCells());
     }
+    FieldsProperties.UpdateFreeIndices();
 }
 
-void PhaseField::SetFlagsSR(void)
+void PhaseField::CompactGrainIndices(void)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+    /* Removes the vanished grains from FieldsProperties and renumbers the
+    remaining ones in ascending order. The renumbering is monotonic, the order
+    of the entries in the nodes is therefore preserved. The Exist flags are
+    synchronized in CalculateGrainsVolume(), all MPI ranks produce the same
+    renumbering.*/
+    if(FieldsProperties.NumberOfFreeIndices() == 0) return;
+
+    const size_t old_size = FieldsProperties.size();
+    const std::vector<size_t> NewIndex = FieldsProperties.Compact();
+
+    auto RemapPF = [&NewIndex](Storage3D<NodePF,0>& locFields)
     {
-        if(Fields(i,j,k).flag == 2)
+        if(locFields.IsNotAllocated()) return;
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,locFields,locFields.Bcells(),)
         {
-            for(int ii = -Grid.dNx; ii <= +Grid.dNx; ++ii)
-            for(int jj = -Grid.dNy; jj <= +Grid.dNy; ++jj)
-            for(int kk = -Grid.dNz; kk <= +Grid.dNz; ++kk)
-            if(!(Fields(i+ii, j+jj, k+kk).flag))
+            for(auto it = locFields(i,j,k).begin(); it != locFields(i,j,k).end(); ++it)
             {
-                Fields(i+ii, j+jj, k+kk).flag = 1;
+                it->index = NewIndex[it->index];
             }
         }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    };
+    auto RemapAB = [&NewIndex](NodeAB<double,double>& locNode)
+    {
+        for(auto it = locNode.begin(); it != locNode.end(); ++it)
+        {
+            it->indexA = NewIndex[it->indexA];
+            it->indexB = NewIndex[it->indexB];
+        }
+    };
+    auto RemapDot = [&RemapAB](Storage3D<NodeAB<double,double>,0>& locFieldsDot)
+    {
+        if(locFieldsDot.IsNotAllocated()) return;
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,locFieldsDot,locFieldsDot.Bcells(),)
+        {
+            RemapAB(locFieldsDot(i,j,k));
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    };
+
+    RemapPF(Fields);
+    RemapPF(FieldsDR);
+    RemapPF(FieldsAdvectionBackup);
+    RemapDot(FieldsDot);
+    RemapDot(FieldsDotDR);
+    RemapAB(PairwiseGrowthFactors);
+
+    if(GrainsVolumeLocal.size() == old_size)
+    {
+        std::vector<double> locVolume(FieldsProperties.size(), 0.0);
+        for(size_t idx = 0; idx < old_size; idx++)
+        if(NewIndex[idx] != SIZE_MAX)
+        {
+            locVolume[NewIndex[idx]] = GrainsVolumeLocal[idx];
+        }
+        GrainsVolumeLocal = locVolume;
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    else
+    {
+        GrainsVolumeLocal.clear();
+    }
+    GrainsVolumeIncrementsPending = false;
+    GrainsSynced.clear();
+    if(IncrementalGrainsTopology) Topology.Scan(Fields);
+    else Topology.Clear();
+    UpdateOccupancy();
+
+    std::stringstream message;
+    message << "Grain indices compacted from " << old_size << " to " << FieldsProperties.size();
+    ConsoleOutput::WriteStandard(thisclassname, message.str());
 }
 
-void PhaseField::SetFlagsDR(void)
+size_t PhaseField::SplitDisconnectedGrains(const BoundaryConditions& BC)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, FieldsDR, FieldsDR.Bcells()-1,)
+    /* The grains are labeled by the majority phase field of each cell. The
+    largest component of a grain keeps its index, each other component becomes
+    a new grain with the properties of the original one. A phase field in a
+    cell in which it is not the majority follows the nearest cell within the
+    halo in which it is, otherwise it keeps its index. All MPI ranks obtain
+    the same components and add the same grains.*/
+    Storage3D<size_t,0> Labels(Grid, Fields.Bcells());
+    const std::vector<ConnectedComponents::Component_t> Components =
+        ConnectedComponents::Label(Grid, BC, ConnectedComponents::GrainKey(*this), Labels);
+
+    std::vector<size_t> Largest(FieldsProperties.size(), SIZE_MAX);
+    for(size_t c = 0; c < Components.size(); c++)
+    {
+        size_t& locLargest = Largest[Components[c].Key];
+        if(locLargest == SIZE_MAX or Components[c].Volume > Components[locLargest].Volume)
+        {
+            locLargest = c;
+        }
+    }
+    std::vector<size_t> NewIndex(Components.size(), SIZE_MAX);
+    std::vector<bool> Split(FieldsProperties.size(), false);
+    size_t Nsplit = 0;
+    for(size_t c = 0; c < Components.size(); c++)
+    if(Largest[Components[c].Key] != c)
+    {
+        const Grain locGrain = FieldsProperties[Components[c].Key];
+        NewIndex[c] = FieldsProperties.add_grain(locGrain.Phase);
+        FieldsProperties[NewIndex[c]] = locGrain;
+        Split[Components[c].Key] = true;
+        Nsplit++;
+    }
+    if(Nsplit == 0) return 0;
+
+    const long int Reach = Labels.Bcells();
+    auto Target = [&](const long int i, const long int j, const long int k, const size_t alpha)
+    {
+        size_t Nearest = SIZE_MAX;
+        long int MinDistance = std::numeric_limits<long int>::max();
+        for(long int ii = -Reach*Grid.dNx; ii <= Reach*Grid.dNx; ii++)
+        for(long int jj = -Reach*Grid.dNy; jj <= Reach*Grid.dNy; jj++)
+        for(long int kk = -Reach*Grid.dNz; kk <= Reach*Grid.dNz; kk++)
+        {
+            const size_t c = Labels(i+ii, j+jj, k+kk);
+            const long int Distance = ii*ii + jj*jj + kk*kk;
+            if(c < Components.size() and Components[c].Key == long(alpha) and Distance < MinDistance)
+            {
+                Nearest = c;
+                MinDistance = Distance;
+            }
+        }
+        return (Nearest != SIZE_MAX and NewIndex[Nearest] != SIZE_MAX) ? NewIndex[Nearest] : alpha;
+    };
+    auto RenamePF = [&](NodePF& Node, const long int i, const long int j, const long int k)
+    {
+        for(auto it = Node.begin(); it != Node.end(); ++it)
+        if(Split[it->index])
+        {
+            it->index = Target(i, j, k, it->index);
+        }
+    };
+
+    auto RenameDot = [&](NodeAB<double,double>& Node, const long int i, const long int j, const long int k)
+    {
+        for(auto it = Node.begin(); it != Node.end(); ++it)
+        {
+            if(Split[it->indexA]) it->indexA = Target(i, j, k, it->indexA);
+            if(Split[it->indexB]) it->indexB = Target(i, j, k, it->indexB);
+        }
+    };
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
+    {
+        RenamePF(Fields(i,j,k), i, j, k);
+        if(FieldsAdvectionBackup.IsAllocated()) RenamePF(FieldsAdvectionBackup(i,j,k), i, j, k);
+        if(FieldsDot.IsAllocated()) RenameDot(FieldsDot(i,j,k), i, j, k);
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    if(Grid.Resolution == Resolutions::Dual)
+    {
+        const long int fx = 1 + Grid.dNx;
+        const long int fy = 1 + Grid.dNy;
+        const long int fz = 1 + Grid.dNz;
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,FieldsDR,0,)
+        {
+            RenamePF(FieldsDR(i,j,k), i/fx, j/fy, k/fz);
+            if(FieldsDotDR.IsAllocated()) RenameDot(FieldsDotDR(i,j,k), i/fx, j/fy, k/fz);
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
+
+    GrainsVolumeLocal.clear();
+    GrainsVolumeIncrementsPending = false;
+    GrainsSynced.clear();
+    Finalize(BC);
+    if(IncrementalGrainsTopology) Topology.Scan(Fields);
+    else Topology.Clear();
+
+    std::stringstream message;
+    message << Nsplit << " disconnected grain parts moved to new grain indices";
+    ConsoleOutput::WriteStandard(thisclassname, message.str());
+    return Nsplit;
+}
+
+void PhaseField::SetFlagsSR(void)
+{
+    #pragma omp parallel
+    {
+        SetFlagsTeamSR();
+    }
+}
+
+void PhaseField::SetFlagsTeamSR(void)
+{
+    OMP_TILED_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+    {
+        SetNeighborFlagsSR(i,j,k);
+    }
+    OMP_TILED_STORAGE_LOOP_END
+    CollectInterfaceCellsTeam(Fields, InterfaceCells, HaloReach(),
+                              ThreadInterfaceCells, ThreadInterfaceOffsets);
+    UpdateOccupancyTeam();
+}
+
+void PhaseField::SetNeighborFlagsSR(const long int i, const long int j, const long int k)
+{
+    if(Fields(i,j,k).flag == 2)
+    {
+        for(int ii = -Grid.dNx; ii <= +Grid.dNx; ++ii)
+        for(int jj = -Grid.dNy; jj <= +Grid.dNy; ++jj)
+        for(int kk = -Grid.dNz; kk <= +Grid.dNz; ++kk)
+        if(!(Fields(i+ii, j+jj, k+kk).flag))
+        {
+            Fields(i+ii, j+jj, k+kk).flag = 1;
+        }
+    }
+}
+
+void PhaseField::SetBoundaryConditionsAndFlagsSR(const BoundaryConditions& BC)
+{
+    /* Flags only change from 0 to 1 around the cells with flag 2, therefore
+    the result does not depend on the order in which the cells are processed.
+    Interior cells mark neighbors within one cell and never touch the halo
+    while it is exchanged, the node values sent to the neighbors are packed in
+    BeginExchange().*/
+    BC.ExchangeAndApply(Fields, 1, Fields.Bcells()-1, [this](long int i, long int j, long int k)
+    {
+        SetNeighborFlagsSR(i,j,k);
+    });
+    CollectInterfaceCells(Fields, InterfaceCells, HaloReach());
+    UpdateOccupancy();
+}
+
+void PhaseField::SetFlagAndCalculateTemporaryDerivativesSR(const long int i, const long int j, const long int k)
+{
+    /* The flag of cell (i,j,k) is pulled from its neighbors instead of being
+    pushed by the interface cells as in SetNeighborFlagsSR(). Each cell only
+    writes its own flag and derivatives, therefore the cells can be processed
+    in any order. Neighbor flags are only tested for 2, which is not modified
+    in this pass.*/
+    NodePF& locNode = Fields(i,j,k);
+    if(not locNode.wide_interface())
+    {
+        for(int ii = -Grid.dNx; ii <= +Grid.dNx and not locNode.flag; ++ii)
+        for(int jj = -Grid.dNy; jj <= +Grid.dNy and not locNode.flag; ++jj)
+        for(int kk = -Grid.dNz; kk <= +Grid.dNz; ++kk)
+        if(Fields(i+ii, j+jj, k+kk).flag == 2)
+        {
+            locNode.flag = 1;
+            break;
+        }
+    }
+    CalculateTemporaryDerivativesSR(i,j,k);
+}
+
+void PhaseField::SetBoundaryConditionsFlagsAndDerivativesSR(const BoundaryConditions& BC)
+{
+    /* Flags and derivatives both only need the neighbors within one cell and
+    the finalized node values, so a single halo exchange is sufficient. The
+    outermost halo layer is not updated, it has to be set by a subsequent
+    SetBoundaryConditionsSR().*/
+    BC.ExchangeAndApply(Fields, 1, Fields.Bcells()-1, [this](long int i, long int j, long int k)
+    {
+        SetFlagAndCalculateTemporaryDerivativesSR(i,j,k);
+    });
+    OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+    {
+        if(Fields(i,j,k).wide_interface())
+        {
+            Fields(i,j,k).copy_from_temporary();
+        }
+    }
+    OMP_PARALLEL_TILED_STORAGE_LOOP_END
+    CollectInterfaceCells(Fields, InterfaceCells, HaloReach());
+    UpdateOccupancy();
+}
+
+void PhaseField::SetFlagsDR(void)
+{
+    OMP_PARALLEL_TILED_STORAGE_LOOP_BEGIN(i, j, k, FieldsDR, FieldsDR.Bcells()-1,)
     {
         if(FieldsDR(i,j,k).flag == 2)
         {
@@ -983,7 +1769,161 @@ void PhaseField::SetFlagsDR(void)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_TILED_STORAGE_LOOP_END
+    CollectInterfaceCells(FieldsDR, InterfaceCellsDR);
+}
+
+void PhaseField::CollectInterfaceCells(const Storage3D<NodePF,0>& locFields,
+                                       std::vector<iVector3>& Cells,
+                                       const long int Reach)
+{
+    std::vector<std::vector<iVector3>> ThreadCells;
+    std::vector<size_t> ThreadOffsets;
+
+    #pragma omp parallel
+    {
+        CollectInterfaceCellsTeam(locFields, Cells, Reach, ThreadCells, ThreadOffsets);
+    }
+}
+
+void PhaseField::CollectInterfaceCellsTeam(const Storage3D<NodePF,0>& locFields,
+                                           std::vector<iVector3>& Cells,
+                                           const long int Reach,
+                                           std::vector<std::vector<iVector3>>& ThreadCells,
+                                           std::vector<size_t>& ThreadOffsets)
+{
+    /* Each thread collects the cells of a contiguous range of x-planes, the
+    per-thread lists are then concatenated in thread order. The resulting list
+    is therefore sorted in storage order.*/
+    const long int ReachX = std::min(locFields.BcellsX(), Reach);
+    const long int ReachY = std::min(locFields.BcellsY(), Reach);
+    const long int ReachZ = std::min(locFields.BcellsZ(), Reach);
+    const long int Nx = locFields.sizeX() + 2*ReachX;
+    const int thread = omp_get_thread_num();
+    const int nth    = omp_get_num_threads();
+
+    #pragma omp single
+    {
+        ThreadCells.resize(nth);
+        ThreadOffsets.assign(nth + 1, 0);
+    }
+
+    const long int chunk = (Nx + nth - 1)/nth;
+    const long int first = std::min(Nx, thread*chunk);
+    const long int last  = std::min(Nx, first + chunk);
+
+    std::vector<iVector3>& locCells = ThreadCells[thread];
+    locCells.clear();
+    for(long int i = first - ReachX; i < last - ReachX; i++)
+    for(long int j = -ReachY; j < locFields.sizeY() + ReachY; j++)
+    for(long int k = -ReachZ; k < locFields.sizeZ() + ReachZ; k++)
+    if(locFields(i,j,k).wide_interface())
+    {
+        locCells.push_back(iVector3({i,j,k}));
+    }
+    ThreadOffsets[thread + 1] = locCells.size();
+
+    #pragma omp barrier
+    #pragma omp single
+    {
+        for(int t = 0; t < nth; t++) ThreadOffsets[t+1] += ThreadOffsets[t];
+        Cells.resize(ThreadOffsets[nth]);
+    }
+
+    std::copy(locCells.begin(), locCells.end(), Cells.begin() + ThreadOffsets[thread]);
+
+    // The list is complete when the threads continue
+    #pragma omp barrier
+}
+
+void PhaseField::UpdateOccupancy(void)
+{
+    #pragma omp parallel
+    {
+        UpdateOccupancyTeam();
+    }
+}
+
+void PhaseField::UpdateOccupancyTeam(void)
+{
+    /* Blocks containing a cell of InterfaceCells are interface blocks. All
+    other blocks contain only single-grain cells, they are bulk blocks if the
+    cells carry the same grain and it is solid, fluid blocks if it is fluid.
+    Blocks with several bulk grains (possible only after a phase field was
+    set by hand) remain interface blocks, so that nothing is skipped wrongly.*/
+    if(OccupancyBlockSize == 0 or Grid.Resolution != Resolutions::Single)
+    {
+        #pragma omp single
+        {
+            Occupancy.Clear();
+        }
+        return;
+    }
+    const long int Size = OccupancyBlockSize;
+    #pragma omp single
+    {
+        if(not Occupancy.Matches(Fields.sizeX(), Fields.sizeY(), Fields.sizeZ())
+           or Occupancy.BlockSize() != Size)
+        {
+            Occupancy.Resize(Fields.sizeX(), Fields.sizeY(), Fields.sizeZ(), Size);
+        }
+        const long int NBlocks = Occupancy.BlocksX()*Occupancy.BlocksY()*Occupancy.BlocksZ();
+        const long int NBy = Occupancy.BlocksY();
+        const long int NBz = Occupancy.BlocksZ();
+        for(long int b = 0; b < NBlocks; b++)
+        {
+            Occupancy.State(b/(NBy*NBz), (b/NBz)%NBy, b%NBz) = OccupancyStates::Bulk;
+        }
+        for(const iVector3& cell : InterfaceCells)
+        if(cell[0] >= 0 and cell[0] < Fields.sizeX() and
+           cell[1] >= 0 and cell[1] < Fields.sizeY() and
+           cell[2] >= 0 and cell[2] < Fields.sizeZ())
+        {
+            Occupancy.State(cell[0]/Size, cell[1]/Size, cell[2]/Size) = OccupancyStates::Interface;
+        }
+    }
+    const long int NBx = Occupancy.BlocksX();
+    const long int NBy = Occupancy.BlocksY();
+    const long int NBz = Occupancy.BlocksZ();
+
+    #pragma omp for collapse(3) schedule(dynamic,1)
+    for(long int bx = 0; bx < NBx; bx++)
+    for(long int by = 0; by < NBy; by++)
+    for(long int bz = 0; bz < NBz; bz++)
+    if(Occupancy.State(bx,by,bz) != OccupancyStates::Interface)
+    {
+        const NodePF& first = Fields(bx*Size, by*Size, bz*Size);
+        bool single = (first.size() == 1);
+        const size_t index = single ? first.front().index : 0;
+        for(long int i = bx*Size; i < std::min((bx+1)*Size, (long int)Fields.sizeX()) and single; i++)
+        for(long int j = by*Size; j < std::min((by+1)*Size, (long int)Fields.sizeY()) and single; j++)
+        for(long int k = bz*Size; k < std::min((bz+1)*Size, (long int)Fields.sizeZ()); k++)
+        if(Fields(i,j,k).size() != 1 or Fields(i,j,k).front().index != index)
+        {
+            single = false;
+            break;
+        }
+        if(single)
+        {
+            Occupancy.Grain(bx,by,bz) = index;
+            Occupancy.State(bx,by,bz) = FieldsProperties[index].is_fluid() ?
+                                        OccupancyStates::Fluid : OccupancyStates::Bulk;
+        }
+        else
+        {
+            Occupancy.State(bx,by,bz) = OccupancyStates::Interface;
+        }
+    }
+}
+
+void PhaseField::SetInterfaceCells(void)
+{
+    CollectInterfaceCells(Fields, InterfaceCells, HaloReach());
+    UpdateOccupancy();
+    if(Grid.Resolution == Resolutions::Dual)
+    {
+        CollectInterfaceCells(FieldsDR, InterfaceCellsDR);
+    }
 }
 
 void PhaseField::Finalize(const BoundaryConditions& BC, bool finalize)
@@ -1007,29 +1947,134 @@ void PhaseField::Finalize(const BoundaryConditions& BC, bool finalize)
 
 void PhaseField::FinalizeSR(const BoundaryConditions& BC, bool finalize)
 {
-    if(finalize)
+    /* Only a merge in the communication-avoiding mode skips the halo exchange,
+    any other call exchanges the halo and restarts the count*/
+    const bool localHalo = HaloLocalFinalize;
+    HaloLocalFinalize = false;
+    if(not localHalo) HaloSteps = 0;
+
+    /* Without a halo exchange (serial build or a merge in the
+    communication-avoiding mode) all steps run in a single parallel region,
+    saving the fork and join of every loop. The flat storage snapshot is
+    rebuilt in its own parallel region and takes the separate steps.*/
+#ifdef MPI_PARALLEL
+    const bool team = localHalo and not FlatStorage;
+#else
+    const bool team = not FlatStorage;
+#endif
+    if(team)
     {
-        #ifdef MPI_PARALLEL
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,Fields.Bcells(),)
-        #else
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
-        #endif
+        // The fused pass relies on the boundary conditions for the outermost halo layer
+        const bool fused = FusedFinalize and not localHalo;
+        #pragma omp parallel
         {
-            if(Fields(i,j,k).wide_interface())
+            FinalizeTeamSR(BC, finalize, fused);
+        }
+    }
+    else
+    {
+        if(finalize)
+        {
+            #pragma omp parallel
             {
-                Fields(i,j,k).finalize();
+                FinalizeCellsTeamSR();
             }
         }
-        OMP_PARALLEL_STORAGE_LOOP_END
+        if(localHalo)
+        {
+            SetLocalBoundaryConditionsSR(BC);
+            SetFlagsSR();
+            CalculateDerivativesSR();
+            SetLocalBoundaryConditionsSR(BC);
+        }
+        else
+        {
+            if(FusedFinalize and not FlatStorage)
+            {
+                SetBoundaryConditionsFlagsAndDerivativesSR(BC);
+            }
+            else
+            {
+                SetBoundaryConditionsAndFlagsSR(BC);
+                SetBoundaryConditionsAndDerivativesSR(BC);
+            }
+            SetBoundaryConditionsSR(BC);
+        }
     }
-
-    SetBoundaryConditionsSR(BC);
-    SetFlagsSR();
-    SetBoundaryConditionsSR(BC);
-    CalculateDerivativesSR();
-    SetBoundaryConditionsSR(BC);
     CalculateFractions();
     CalculateGrainsVolume();
+    UpdateGrainsTopology();
+    UpdateFront();
+}
+
+void PhaseField::FinalizeCellsTeamSR(void)
+{
+    // Merged cells contribute their final values to the grain volume and contact changes
+    const bool countVolume = GrainsVolumeIncrementsPending;
+    const bool countPairs  = Topology.Pending();
+    const bool countFront  = FrontPlanesIncrementsPending;
+    #ifdef MPI_PARALLEL
+    OMP_STORAGE_LOOP_BEGIN(i,j,k,Fields,Fields.Bcells(),)
+    #else
+    OMP_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
+    #endif
+    {
+        if(Fields(i,j,k).wide_interface())
+        {
+            Fields(i,j,k).finalize();
+            if(countVolume and InteriorCellSR(i,j,k))
+            {
+                AddCellVolumeSR(i,j,k,1.0);
+            }
+            if(countPairs and InteriorCellSR(i,j,k))
+            {
+                Topology.AddCell(Fields(i,j,k),1);
+            }
+            if(countFront and InteriorCellSR(i,j,k))
+            {
+                AddCellFrontSR(i,j,k,1.0);
+            }
+        }
+    }
+    OMP_STORAGE_LOOP_END
+}
+
+void PhaseField::FinalizeTeamSR(const BoundaryConditions& BC, const bool finalize,
+                                const bool fused)
+{
+    /* The steps are separated by the implicit barriers at the end of the
+    work-sharing loops: the boundary conditions copy finalized cells, the flags
+    and derivatives read the halo set by the boundary conditions.*/
+    if(finalize)
+    {
+        FinalizeCellsTeamSR();
+    }
+    BC.SetLocalTeam(Fields);
+    if(fused)
+    {
+        OMP_TILED_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+        {
+            SetFlagAndCalculateTemporaryDerivativesSR(i,j,k);
+        }
+        OMP_TILED_STORAGE_LOOP_END
+        OMP_TILED_STORAGE_LOOP_BEGIN(i, j, k, Fields, Fields.Bcells()-1,)
+        {
+            if(Fields(i,j,k).wide_interface())
+            {
+                Fields(i,j,k).copy_from_temporary();
+            }
+        }
+        OMP_TILED_STORAGE_LOOP_END
+        CollectInterfaceCellsTeam(Fields, InterfaceCells, HaloReach(),
+                                  ThreadInterfaceCells, ThreadInterfaceOffsets);
+        UpdateOccupancyTeam();
+    }
+    else
+    {
+        SetFlagsTeamSR();
+        CalculateDerivativesTeamSR();
+    }
+    BC.SetLocalTeam(Fields);
 }
 
 void PhaseField::FinalizeDR(const BoundaryConditions& BC, bool finalize)
@@ -1057,12 +2102,20 @@ void PhaseField::FinalizeDR(const BoundaryConditions& BC, bool finalize)
 
     Coarsen();
 
-    SetBoundaryConditionsSR(BC);
-    SetFlagsSR();
-    SetBoundaryConditionsSR(BC);
-    CalculateDerivativesSR();
+    if(FusedFinalize and not FlatStorage)
+    {
+        SetBoundaryConditionsFlagsAndDerivativesSR(BC);
+        SetBoundaryConditionsSR(BC);
+    }
+    else
+    {
+        SetBoundaryConditionsAndFlagsSR(BC);
+        SetBoundaryConditionsAndDerivativesSR(BC);
+    }
     CalculateFractions();
     CalculateGrainsVolume();
+    UpdateGrainsTopology();
+    UpdateFront();
 }
 
 void PhaseField::FinalizeInitialization(const BoundaryConditions& BC)
@@ -1124,7 +2177,7 @@ void PhaseField::CoarsenDot(void)
     long int fx = 1 + Grid.dNx;
     long int fy = 1 + Grid.dNy;
     long int fz = 1 + Grid.dNz;
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,FieldsDot,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,InterfaceCells,)
     {
         if(Fields(i,j,k).wide_interface())
         {
@@ -1139,7 +2192,22 @@ void PhaseField::CoarsenDot(void)
             FieldsDot(i,j,k) *= norm;
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+}
+
+bool PhaseField::UniformNeighborhoodSR(const long int i, const long int j, const long int k) const
+{
+    if(Fields(i,j,k).size() != 1) return false;
+
+    const size_t index = Fields(i,j,k).front().index;
+    for(int di = -Grid.dNx; di <= Grid.dNx; di++)
+    for(int dj = -Grid.dNy; dj <= Grid.dNy; dj++)
+    for(int dk = -Grid.dNz; dk <= Grid.dNz; dk++)
+    {
+        const NodePF& locPF = Fields(i+di,j+dj,k+dk);
+        if(locPF.size() != 1 or locPF.front().index != index) return false;
+    }
+    return true;
 }
 
 void PhaseField::Refine(void)
@@ -1149,13 +2217,37 @@ void PhaseField::Refine(void)
     long int fz = 1 + Grid.dNz;
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
     {
-        //if(Fields(i,j,k).flag)
-        for(int di = -Grid.dNx; di <= Grid.dNx; di+=2)
-        for(int dj = -Grid.dNy; dj <= Grid.dNy; dj+=2)
-        for(int dk = -Grid.dNz; dk <= Grid.dNz; dk+=2)
+        if(NarrowBandDR and UniformNeighborhoodSR(i,j,k))
         {
-            FieldsDR(fx*i+(di+1)/2,fy*j+(dj+1)/2,fz*k+(dk+1)/2) = Fields.at(i+di*0.25,j+dj*0.25,k+dk*0.25);
-            FieldsDR(fx*i+(di+1)/2,fy*j+(dj+1)/2,fz*k+(dk+1)/2).finalize();
+            /* All interpolation points are inside the same bulk grain: the
+            interpolated nodes hold a single phase field with the value 1.0.
+            Nodes which already hold it are left untouched, all of them only
+            keep the memory for a single entry.*/
+            const size_t index = Fields(i,j,k).front().index;
+            for(int di = -Grid.dNx; di <= Grid.dNx; di+=2)
+            for(int dj = -Grid.dNy; dj <= Grid.dNy; dj+=2)
+            for(int dk = -Grid.dNz; dk <= Grid.dNz; dk+=2)
+            {
+                NodePF& locPF = FieldsDR(fx*i+(di+1)/2,fy*j+(dj+1)/2,fz*k+(dk+1)/2);
+                if(locPF.flag or locPF.size() != 1 or
+                   locPF.front().index != index or locPF.front().value != 1.0)
+                {
+                    locPF.clear();
+                    locPF.set_value(index, 1.0);
+                    locPF.finalize();
+                }
+                locPF.compact();
+            }
+        }
+        else
+        {
+            for(int di = -Grid.dNx; di <= Grid.dNx; di+=2)
+            for(int dj = -Grid.dNy; dj <= Grid.dNy; dj+=2)
+            for(int dk = -Grid.dNz; dk <= Grid.dNz; dk+=2)
+            {
+                FieldsDR(fx*i+(di+1)/2,fy*j+(dj+1)/2,fz*k+(dk+1)/2) = Fields.at(i+di*0.25,j+dj*0.25,k+dk*0.25);
+                FieldsDR(fx*i+(di+1)/2,fy*j+(dj+1)/2,fz*k+(dk+1)/2).finalize();
+            }
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
@@ -1245,6 +2337,31 @@ NodeA<double> PhaseField::Dot2(const int i, const int j, const int k, const doub
     return value;
 }
 
+double PhaseField::ReportMaximumTimeStep(const double MaxChange) const
+{
+    /* Accuracy limit of the explicit time integration: the largest phase-field
+    rate in the interface should not change a phase field by more than
+    MaxChange in one time step.*/
+    const bool dual = (Grid.Resolution == Resolutions::Dual);
+    const Storage3D<NodeAB<double,double>,0>& locDot = dual ? FieldsDotDR : FieldsDot;
+    const std::vector<iVector3>& locCells = dual ? InterfaceCellsDR : InterfaceCells;
+
+    double maxRate = 0.0;
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,locCells,reduction(max:maxRate))
+    {
+        for(auto it = locDot(i,j,k).cbegin(); it != locDot(i,j,k).cend(); ++it)
+        {
+            maxRate = std::max(maxRate, std::abs(it->value1 + it->value2));
+        }
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &maxRate, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    return (maxRate > 0.0) ? MaxChange/maxRate : DBL_MAX;
+}
+
 void PhaseField::MergeIncrements(const BoundaryConditions& BC,
                                  const double dt,
                                  const bool finalize,
@@ -1265,70 +2382,188 @@ void PhaseField::MergeIncrements(const BoundaryConditions& BC,
     }
 }
 
+void PhaseField::MergeCellIncrementsSR(const long int i, const long int j,
+                                       const long int k, const double dt,
+                                       const bool clear)
+{
+    for(auto psi  = FieldsDot(i,j,k).cbegin();
+             psi != FieldsDot(i,j,k).cend(); ++psi)
+    {
+        double factor = 1.0;
+        if(FieldsProperties[psi->indexA].GrowthConstraintsViolation != GrowthConstraintsViolations::None and
+           FieldsProperties[psi->indexB].GrowthConstraintsViolation != GrowthConstraintsViolations::None)
+        {
+            factor *= PairwiseGrowthFactors.get_sym1(psi->indexA,psi->indexB);
+        }
+
+        double value = factor*(psi->value1 + psi->value2)*dt;
+        if(fabs(value) >= DBL_EPSILON)
+        {
+            Fields(i,j,k).add_value(psi->indexA,  value);
+            Fields(i,j,k).add_value(psi->indexB, -value);
+        }
+    }
+    if(clear) FieldsDot(i,j,k).clear();
+}
+
 void PhaseField::MergeIncrementsSR(const BoundaryConditions& BC,
                                    const double dt,
                                    const bool finalize,
                                    const bool clear)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
+    /* Grain volume changes: the values before merging are subtracted here, the
+    final values are added after the cells have been finalized.*/
+    const bool countVolume = BeginGrainsVolumeIncrements();
+    const bool countPairs  = BeginGrainsTopologyIncrements();
+    const bool countFront  = BeginFrontIncrements();
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,HaloReach(),)
     {
         if(Fields(i,j,k).wide_interface())
         {
-            for(auto psi  = FieldsDot(i,j,k).cbegin();
-                     psi != FieldsDot(i,j,k).cend(); ++psi)
-            {
-                double factor = 1.0;
-                if(FieldsProperties[psi->indexA].GrowthConstraintsViolation != GrowthConstraintsViolations::None and
-                   FieldsProperties[psi->indexB].GrowthConstraintsViolation != GrowthConstraintsViolations::None)
-                {
-                    factor *= PairwiseGrowthFactors.get_sym1(psi->indexA,psi->indexB);
-                }
-            
-                double value = factor*(psi->value1 + psi->value2)*dt;
-                if(fabs(value) >= DBL_EPSILON)
-                {
-                    Fields(i,j,k).add_value(psi->indexA,  value);
-                    Fields(i,j,k).add_value(psi->indexB, -value);
-                }
-            }
-            if(clear) FieldsDot(i,j,k).clear();
+            TimeInfo::CountIteration();
+            const bool countCell  = countVolume and InteriorCellSR(i,j,k);
+            const bool countPair  = countPairs  and InteriorCellSR(i,j,k);
+            const bool countPlane = countFront  and InteriorCellSR(i,j,k);
+            if(countCell) AddCellVolumeSR(i,j,k,-1.0);
+            if(countPair) Topology.AddCell(Fields(i,j,k),-1);
+            if(countPlane) AddCellFrontSR(i,j,k,-1.0);
+            MergeCellIncrementsSR(i,j,k,dt,clear);
+            if(countCell and not finalize) AddCellVolumeSR(i,j,k,1.0);
+            if(countPair and not finalize) Topology.AddCell(Fields(i,j,k),1);
+            if(countPlane and not finalize) AddCellFrontSR(i,j,k,1.0);
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+    AdvanceHaloStepSR(clear);
     Finalize(BC, finalize);
 }
 
+void PhaseField::MergeCellIncrementsDR(const long int i, const long int j,
+                                       const long int k, const double dt,
+                                       const bool clear)
+{
+    for(auto psi  = FieldsDotDR(i,j,k).cbegin();
+             psi != FieldsDotDR(i,j,k).cend(); ++psi)
+    {
+        double factor = 1.0;
+        if(FieldsProperties[psi->indexA].GrowthConstraintsViolation != GrowthConstraintsViolations::None and
+           FieldsProperties[psi->indexB].GrowthConstraintsViolation != GrowthConstraintsViolations::None)
+        {
+            factor *= PairwiseGrowthFactors.get_sym1(psi->indexA,psi->indexB);
+        }
+
+        double value = factor*(psi->value1 + psi->value2)*dt;
+        if(fabs(value) >= DBL_EPSILON)
+        {
+            FieldsDR(i,j,k).add_value(psi->indexA,  value);
+            FieldsDR(i,j,k).add_value(psi->indexB, -value);
+        }
+    }
+    if(clear) FieldsDotDR(i,j,k).clear();
+}
+
 void PhaseField::MergeIncrementsDR(const BoundaryConditions& BC,
                                    const double dt,
                                    const bool finalize,
                                    const bool clear)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,FieldsDR,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,InterfaceCellsDR,)
     {
         if(FieldsDR(i,j,k).wide_interface())
         {
-            for(auto psi  = FieldsDotDR(i,j,k).cbegin();
-                     psi != FieldsDotDR(i,j,k).cend(); ++psi)
-            {
-                double factor = 1.0;
-                if(FieldsProperties[psi->indexA].GrowthConstraintsViolation != GrowthConstraintsViolations::None and
-                   FieldsProperties[psi->indexB].GrowthConstraintsViolation != GrowthConstraintsViolations::None)
-                {
-                    factor *= PairwiseGrowthFactors.get_sym1(psi->indexA,psi->indexB);
-                }
+            TimeInfo::CountIteration();
+            MergeCellIncrementsDR(i,j,k,dt,clear);
+        }
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    Finalize(BC, finalize);
+}
 
-                double value = factor*(psi->value1 + psi->value2)*dt;
-                if(fabs(value) >= DBL_EPSILON)
-                {
-                    FieldsDR(i,j,k).add_value(psi->indexA,  value);
-                    FieldsDR(i,j,k).add_value(psi->indexB, -value);
-                }
-            }
-            if(clear) FieldsDotDR(i,j,k).clear();
+void PhaseField::NormalizeAndMergeIncrements(const BoundaryConditions& BC,
+                                             const double dt,
+                                             const bool finalize,
+                                             const bool clear)
+{
+    switch(Grid.Resolution)
+    {
+        case Resolutions::Single:
+        {
+            NormalizeAndMergeIncrementsSR(BC, dt, finalize, clear);
+            break;
         }
+        case Resolutions::Dual:
+        {
+            NormalizeAndMergeIncrementsDR(BC, dt, finalize, clear);
+            break;
+        }
+    }
+}
+
+void PhaseField::NormalizeAndMergeIncrementsSR(const BoundaryConditions& BC,
+                                               const double dt,
+                                               const bool finalize,
+                                               const bool clear)
+{
+    /* Limiting, merging and the local part of the finalization only use the
+    data of the current cell, so they are done in a single sweep. Combining of
+    phase fields has to precede the finalization of the cells, in this case
+    the cells are finalized in Finalize() as usual.*/
+    const bool finalizeCells = finalize and
+        std::find(Combine.begin(), Combine.end(), true) == Combine.end();
+
+    const bool countVolume = BeginGrainsVolumeIncrements();
+    const bool countPairs  = BeginGrainsTopologyIncrements();
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,HaloReach(),)
+    if(Fields(i,j,k).wide_interface())
+    {
+        const bool countCell = countVolume and InteriorCellSR(i,j,k);
+        const bool countPair = countPairs  and InteriorCellSR(i,j,k);
+        NormalizeCellIncrementsSR(i,j,k,dt);
+        if(countCell) AddCellVolumeSR(i,j,k,-1.0);
+        if(countPair) Topology.AddCell(Fields(i,j,k),-1);
+        MergeCellIncrementsSR(i,j,k,dt,clear);
+        if(finalizeCells) Fields(i,j,k).finalize();
+        if(countCell) AddCellVolumeSR(i,j,k,1.0);
+        if(countPair) Topology.AddCell(Fields(i,j,k),1);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
-    Finalize(BC, finalize);
+    if(not clear) SetIncrementsBoundaryConditionsSR(BC);
+    AdvanceHaloStepSR(clear);
+
+    Finalize(BC, finalize and not finalizeCells);
+}
+
+void PhaseField::NormalizeAndMergeIncrementsDR(const BoundaryConditions& BC,
+                                               const double dt,
+                                               const bool finalize,
+                                               const bool clear)
+{
+    /* Same as in single resolution. The increments are cleared after they have
+    been coarsened, which needs the normalized increments of all fine cells.*/
+    const bool finalizeCells = finalize and
+        std::find(Combine.begin(), Combine.end(), true) == Combine.end();
+
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,InterfaceCellsDR,)
+    if(FieldsDR(i,j,k).wide_interface())
+    {
+        NormalizeCellIncrementsDR(i,j,k,dt);
+        MergeCellIncrementsDR(i,j,k,dt,false);
+        if(finalizeCells) FieldsDR(i,j,k).finalize();
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    CoarsenDot();
+    SetIncrementsBoundaryConditionsSR(BC);
+
+    if(clear)
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,FieldsDotDR,0,)
+        {
+            FieldsDotDR(i,j,k).clear();
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+    }
+
+    Finalize(BC, finalize and not finalizeCells);
 }
 
 void PhaseField::NormalizeIncrements(const BoundaryConditions& BC, const double dt)
@@ -1348,226 +2583,234 @@ void PhaseField::NormalizeIncrements(const BoundaryConditions& BC, const double
     }
 }
 
-void PhaseField::NormalizeIncrementsSR(const BoundaryConditions& BC, const double dt)
+void PhaseField::NormalizeCellIncrementsSR(const long int i, const long int j,
+                                           const long int k, const double dt)
 {
-    /** This function limits phase-field increments for all present phase-field
-    pairs, so that the actual phase-field values are within their natural
-    limits of 0.0 and 1.0.*/
-
-    double precision = FLT_EPSILON;
+    const double precision = FLT_EPSILON;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
-    if (Fields(i,j,k).wide_interface())
+    switch(FieldsDot(i,j,k).size())
     {
-        switch(FieldsDot(i,j,k).size())
+        case 0:
+        {
+            break;
+        }
+        case 1:
         {
-            case 0:
+            size_t indexA = FieldsDot(i,j,k).front().indexA;
+            double valueA = (FieldsDot(i,j,k).front().value1
+                          +  FieldsDot(i,j,k).front().value2)*dt;
+            double old_value = Fields(i,j,k).get_value(indexA);
+
+            if((old_value == 0.0 and valueA < 0.0) or
+               (old_value == 1.0 and valueA > 0.0))
             {
-                break;
+                FieldsDot(i,j,k).clear();
             }
-            case 1:
+            else
             {
-                size_t indexA = FieldsDot(i,j,k).front().indexA;
-                double valueA = (FieldsDot(i,j,k).front().value1
-                              +  FieldsDot(i,j,k).front().value2)*dt;
-                double old_value = Fields(i,j,k).get_value(indexA);
+                double new_value = old_value + valueA;
 
-                if((old_value == 0.0 and valueA < 0.0) or
-                   (old_value == 1.0 and valueA > 0.0))
+                double norm = 1.0;
+                if(new_value < 0.0)
                 {
-                    FieldsDot(i,j,k).clear();
+                    norm *= -old_value/valueA;
                 }
-                else
+                else if(new_value > 1.0)
                 {
-                    double new_value = old_value + valueA;
-
-                    double norm = 1.0;
-                    if(new_value < 0.0)
-                    {
-                        norm *= -old_value/valueA;
-                    }
-                    else if(new_value > 1.0)
-                    {
-                        norm *= (1.0 - old_value)/valueA;
-                    }
+                    norm *= (1.0 - old_value)/valueA;
+                }
 
-                    if(norm > DBL_EPSILON)
-                    {
-                        FieldsDot(i,j,k) *= norm;
-                    }
-                    else
-                    {
-                        FieldsDot(i,j,k).clear();
-                    }
+                if(norm > DBL_EPSILON)
+                {
+                    FieldsDot(i,j,k) *= norm;
+                }
+                else
+                {
+                    FieldsDot(i,j,k).clear();
                 }
-                break;
             }
-            default:
+            break;
+        }
+        default:
+        {
+            for(auto alpha  = Fields(i,j,k).cbegin();
+                     alpha != Fields(i,j,k).cend(); ++alpha)
             {
-                for(auto alpha  = Fields(i,j,k).cbegin();
-                         alpha != Fields(i,j,k).cend(); ++alpha)
+                double dPsiAlpha = 0.0;
+                for(auto beta  = Fields(i,j,k).cbegin();
+                         beta != Fields(i,j,k).cend(); ++beta)
+                if(alpha != beta)
+                {
+                    dPsiAlpha += FieldsDot(i,j,k).get_asym1(alpha->index,
+                                                             beta->index);
+                    dPsiAlpha += FieldsDot(i,j,k).get_asym2(alpha->index,
+                                                             beta->index);
+                }
+                /* Set out of bounds sets to zero */
+                if((alpha->value == 0.0 and dPsiAlpha < 0.0)
+                or (alpha->value == 1.0 and dPsiAlpha > 0.0))
                 {
-                    double dPsiAlpha = 0.0;
                     for(auto beta  = Fields(i,j,k).cbegin();
                              beta != Fields(i,j,k).cend(); ++beta)
                     if(alpha != beta)
                     {
-                        dPsiAlpha += FieldsDot(i,j,k).get_asym1(alpha->index,
-                                                                 beta->index);
-                        dPsiAlpha += FieldsDot(i,j,k).get_asym2(alpha->index,
-                                                                 beta->index);
-                    }
-                    /* Set out of bounds sets to zero */
-                    if((alpha->value == 0.0 and dPsiAlpha < 0.0)
-                    or (alpha->value == 1.0 and dPsiAlpha > 0.0))
-                    {
-                        for(auto beta  = Fields(i,j,k).cbegin();
-                                 beta != Fields(i,j,k).cend(); ++beta)
-                        if(alpha != beta)
-                        {
-                            FieldsDot(i,j,k).set_sym_pair(alpha->index, beta->index, 0.0, 0.0);
-                        }
+                        FieldsDot(i,j,k).set_sym_pair(alpha->index, beta->index, 0.0, 0.0);
                     }
                 }
+            }
 
-                for(auto alpha  = FieldsDot(i,j,k).begin();
-                         alpha != FieldsDot(i,j,k).end();)
+            for(auto alpha  = FieldsDot(i,j,k).begin();
+                     alpha != FieldsDot(i,j,k).end();)
+            {
+                /* Remove zero-sets from the storage */
+                if(alpha->value1 == 0.0 and alpha->value2 == 0.0)
                 {
-                    /* Remove zero-sets from the storage */
-                    if(alpha->value1 == 0.0 and alpha->value2 == 0.0)
-                    {
-                        alpha = FieldsDot(i,j,k).erase(alpha);
-                    }
-                    else
-                    {
-                        ++alpha;
-                    }
+                    alpha = FieldsDot(i,j,k).erase(alpha);
+                }
+                else
+                {
+                    ++alpha;
                 }
+            }
 
-                if(FieldsDot(i,j,k).size())
+            if(FieldsDot(i,j,k).size())
+            {
+                /* Limit increments! This is done in a while loop to account for all
+                existing pair-contributions.*/
+                int number_of_iterations = 0;
+                bool LimitingNeeded = true;
+                while (LimitingNeeded)
                 {
-                    /* Limit increments! This is done in a while loop to account for all
-                    existing pair-contributions.*/
-                    int number_of_iterations = 0;
-                    bool LimitingNeeded = true;
-                    while (LimitingNeeded)
+                    number_of_iterations++;
+                    LimitingNeeded = false;
+                    NodeAB<double,double> locIncrements;
+                    for(auto it  = FieldsDot(i,j,k).cbegin();
+                             it != FieldsDot(i,j,k).cend(); ++it)
                     {
-                        number_of_iterations++;
-                        LimitingNeeded = false;
-                        NodeAB<double,double> locIncrements;
-                        for(auto it  = FieldsDot(i,j,k).cbegin();
-                                 it != FieldsDot(i,j,k).cend(); ++it)
+                        /* Collect increments */
+                        if(it->value1 < 0.0)
+                        {
+                            locIncrements.add_sym2(it->indexA,0, it->value1);
+                            locIncrements.add_sym1(it->indexB,0, -it->value1);
+                        }
+                        if(it->value1 > 0.0)
                         {
-                            /* Collect increments */
-                            if(it->value1 < 0.0)
-                            {
-                                locIncrements.add_sym2(it->indexA,0, it->value1);
-                                locIncrements.add_sym1(it->indexB,0, -it->value1);
-                            }
-                            if(it->value1 > 0.0)
-                            {
-                                locIncrements.add_sym1(it->indexA,0, it->value1);
-                                locIncrements.add_sym2(it->indexB,0, -it->value1);
-                            }
+                            locIncrements.add_sym1(it->indexA,0, it->value1);
+                            locIncrements.add_sym2(it->indexB,0, -it->value1);
                         }
-                        NodeAB<double,double> locLimits;
-                        for(auto alpha  = Fields(i,j,k).cbegin();
-                                 alpha != Fields(i,j,k).cend(); ++alpha)
+                    }
+                    NodeAB<double,double> locLimits;
+                    for(auto alpha  = Fields(i,j,k).cbegin();
+                             alpha != Fields(i,j,k).cend(); ++alpha)
+                    {
+                        /* Calculate limits */
+                        double posIncrement = locIncrements.get_sym1(alpha->index,0);
+                        double negIncrement = locIncrements.get_sym2(alpha->index,0);
+                        double newPFvalue = alpha->value+(posIncrement+negIncrement)*dt;
+                        locLimits.set_sym2(alpha->index,0, 1.0);
+                        locLimits.set_sym1(alpha->index,0, 1.0);
+                        if(newPFvalue < 0.0)
                         {
-                            /* Calculate limits */
-                            double posIncrement = locIncrements.get_sym1(alpha->index,0);
-                            double negIncrement = locIncrements.get_sym2(alpha->index,0);
-                            double newPFvalue = alpha->value+(posIncrement+negIncrement)*dt;
-                            locLimits.set_sym2(alpha->index,0, 1.0);
-                            locLimits.set_sym1(alpha->index,0, 1.0);
-                            if(newPFvalue < 0.0)
-                            {
-                                double tmpLim = locLimits.get_sym2(alpha->index,0);
-                                double tmpLim2 = min(tmpLim,-(alpha->value+posIncrement*dt)
-                                                              /(negIncrement*dt));
-                                locLimits.set_sym2(alpha->index,0, tmpLim2);
-                            }
-                            if(newPFvalue > 1.0)
-                            {
-                                double tmpLim = locLimits.get_sym1(alpha->index,0);
-                                double tmpLim2 = min(tmpLim,(1.0-(alpha->value+negIncrement
-                                                             *dt))/(posIncrement*dt));
-                                locLimits.set_sym1(alpha->index,0, tmpLim2);
-                            }
+                            double tmpLim = locLimits.get_sym2(alpha->index,0);
+                            double tmpLim2 = min(tmpLim,-(alpha->value+posIncrement*dt)
+                                                          /(negIncrement*dt));
+                            locLimits.set_sym2(alpha->index,0, tmpLim2);
                         }
-                        for(auto it  = FieldsDot(i,j,k).begin();
-                                 it != FieldsDot(i,j,k).end(); ++it)
+                        if(newPFvalue > 1.0)
                         {
-                            /* Limit increments */
-                            if(it->value1 < 0.0)
-                            {
-                                double tmpLim = min(locLimits.get_sym2(it->indexA,0),
-                                                    locLimits.get_sym1(it->indexB,0));
-                                it->value1 *= tmpLim;
-                                if (tmpLim < 1.0) LimitingNeeded = true;
-                            }
-                            if(it->value1 > 0.0)
-                            {
-                                double tmpLim = min(locLimits.get_sym1(it->indexA,0),
-                                                    locLimits.get_sym2(it->indexB,0));
-                                it->value1 *= tmpLim;
-                                if (tmpLim < 1.0) LimitingNeeded = true;
-                            }
+                            double tmpLim = locLimits.get_sym1(alpha->index,0);
+                            double tmpLim2 = min(tmpLim,(1.0-(alpha->value+negIncrement
+                                                         *dt))/(posIncrement*dt));
+                            locLimits.set_sym1(alpha->index,0, tmpLim2);
                         }
-                        /* Exit limiting loop, if no convergence after 24 iterations*/
-                        if (number_of_iterations > 24) LimitingNeeded = false;
                     }
-
-                    for(auto alpha  = FieldsDot(i,j,k).begin();
-                             alpha != FieldsDot(i,j,k).end(); )
+                    for(auto it  = FieldsDot(i,j,k).begin();
+                             it != FieldsDot(i,j,k).end(); ++it)
                     {
-                        /* Clean up values which are too small */
-                        if(fabs(alpha->value1*dt) < DBL_EPSILON)
+                        /* Limit increments */
+                        if(it->value1 < 0.0)
                         {
-                            alpha = FieldsDot(i,j,k).erase(alpha);
+                            double tmpLim = min(locLimits.get_sym2(it->indexA,0),
+                                                locLimits.get_sym1(it->indexB,0));
+                            it->value1 *= tmpLim;
+                            if (tmpLim < 1.0) LimitingNeeded = true;
                         }
-                        else
+                        if(it->value1 > 0.0)
                         {
-                            ++alpha;
+                            double tmpLim = min(locLimits.get_sym1(it->indexA,0),
+                                                locLimits.get_sym2(it->indexB,0));
+                            it->value1 *= tmpLim;
+                            if (tmpLim < 1.0) LimitingNeeded = true;
                         }
                     }
+                    /* Exit limiting loop, if no convergence after 24 iterations*/
+                    if (number_of_iterations > 24) LimitingNeeded = false;
+                }
 
-                    /* End plausibility check */
-                    NodePF tmpPF = Fields(i,j,k);
-                    for(auto psi  = FieldsDot(i,j,k).cbegin();
-                             psi != FieldsDot(i,j,k).cend(); ++psi)
-                    if(psi->value1 != 0.0)
+                for(auto alpha  = FieldsDot(i,j,k).begin();
+                         alpha != FieldsDot(i,j,k).end(); )
+                {
+                    /* Clean up values which are too small */
+                    if(fabs(alpha->value1*dt) < DBL_EPSILON)
                     {
-                        tmpPF.add_value(psi->indexA,  psi->value1 * dt);
-                        tmpPF.add_value(psi->indexB, -psi->value1 * dt);
+                        alpha = FieldsDot(i,j,k).erase(alpha);
                     }
-                    for(auto it  = tmpPF.cbegin();
-                             it != tmpPF.cend(); ++it)
-                    if(it->value < -precision or it->value > 1.0 + precision)
+                    else
                     {
-                        double oldFields = Fields(i,j,k).get_value(it->index);
-                        string msg = "Normalizing of phase field increments failed in point ("
-                                   + to_string(i) + "," + to_string(j) + "," + to_string(k)
-                                   + "). " + to_string(Fields(i,j,k).size())
-                                   + " fields present. Grain "
-                                   + to_string(it->index) + " with a fields-value of "
-                                   + to_string(oldFields)
-                                   + " is incremented by "
-                                   + to_string(it->value-oldFields)
-                                   + ", which results in a fields-value of "
-                                   + to_string(it->value)
-                                   + ". This will result in undefined behavior!";
-                        ConsoleOutput::WriteWarning(msg,thisclassname,"NormalizeIncrements");
+                        ++alpha;
                     }
                 }
-                break;
+
+                /* End plausibility check */
+                NodePF tmpPF = Fields(i,j,k);
+                for(auto psi  = FieldsDot(i,j,k).cbegin();
+                         psi != FieldsDot(i,j,k).cend(); ++psi)
+                if(psi->value1 != 0.0)
+                {
+                    tmpPF.add_value(psi->indexA,  psi->value1 * dt);
+                    tmpPF.add_value(psi->indexB, -psi->value1 * dt);
+                }
+                for(auto it  = tmpPF.cbegin();
+                         it != tmpPF.cend(); ++it)
+                if(it->value < -precision or it->value > 1.0 + precision)
+                {
+                    double oldFields = Fields(i,j,k).get_value(it->index);
+                    string msg = "Normalizing of phase field increments failed in point ("
+                               + to_string(i) + "," + to_string(j) + "," + to_string(k)
+                               + "). " + to_string(Fields(i,j,k).size())
+                               + " fields present. Grain "
+                               + to_string(it->index) + " with a fields-value of "
+                               + to_string(oldFields)
+                               + " is incremented by "
+                               + to_string(it->value-oldFields)
+                               + ", which results in a fields-value of "
+                               + to_string(it->value)
+                               + ". This will result in undefined behavior!";
+                    ConsoleOutput::WriteWarning(msg,thisclassname,"NormalizeIncrements");
+                }
             }
+            break;
         }
     }
+}
+
+void PhaseField::NormalizeIncrementsSR(const BoundaryConditions& BC, const double dt)
+{
+    /** This function limits phase-field increments for all present phase-field
+    pairs, so that the actual phase-field values are within their natural
+    limits of 0.0 and 1.0.*/
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,HaloReach(),)
+    if (Fields(i,j,k).wide_interface())
+    {
+        TimeInfo::CountIteration();
+        NormalizeCellIncrementsSR(i,j,k,dt);
+    }
     OMP_PARALLEL_STORAGE_LOOP_END
     SetIncrementsBoundaryConditionsSR(BC);
 
 #ifdef DEBUG
+    double precision = FLT_EPSILON;
 
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
     if(Fields(i,j,k).flag)
@@ -1631,230 +2874,238 @@ void PhaseField::NormalizeIncrementsSR(const BoundaryConditions& BC, const doubl
 #endif
 }
 
-void PhaseField::NormalizeIncrementsDR(const BoundaryConditions& BC, const double dt)
+void PhaseField::NormalizeCellIncrementsDR(const long int i, const long int j,
+                                           const long int k, const double dt)
 {
-    /** This function limits phase-field increments for all present phase-field
-    pairs, so that the actual phase-field values are within their natural
-    limits of 0.0 and 1.0.*/
-
-    double precision = FLT_EPSILON;
+    const double precision = FLT_EPSILON;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,FieldsDotDR,0,)
-    if (FieldsDR(i,j,k).wide_interface())
+    switch(FieldsDotDR(i,j,k).size())
     {
-        switch(FieldsDotDR(i,j,k).size())
+        case 0:
         {
-            case 0:
+            break;
+        }
+        case 1:
+        {
+            size_t indexA = FieldsDotDR(i,j,k).front().indexA;
+            double valueA = (FieldsDotDR(i,j,k).front().value1
+                          +  FieldsDotDR(i,j,k).front().value2)*dt;
+            double old_value = FieldsDR(i,j,k).get_value(indexA);
+
+            if((old_value == 0.0 and valueA < 0.0) or
+               (old_value == 1.0 and valueA > 0.0))
             {
-                break;
+                FieldsDotDR(i,j,k).clear();
             }
-            case 1:
+            else
             {
-                size_t indexA = FieldsDotDR(i,j,k).front().indexA;
-                double valueA = (FieldsDotDR(i,j,k).front().value1
-                              +  FieldsDotDR(i,j,k).front().value2)*dt;
-                double old_value = FieldsDR(i,j,k).get_value(indexA);
+                double new_value = old_value + valueA;
 
-                if((old_value == 0.0 and valueA < 0.0) or
-                   (old_value == 1.0 and valueA > 0.0))
+                double norm = 1.0;
+                if(new_value < 0.0)
                 {
-                    FieldsDotDR(i,j,k).clear();
+                    norm *= -old_value/valueA;
                 }
-                else
+                else if(new_value > 1.0)
                 {
-                    double new_value = old_value + valueA;
-
-                    double norm = 1.0;
-                    if(new_value < 0.0)
-                    {
-                        norm *= -old_value/valueA;
-                    }
-                    else if(new_value > 1.0)
-                    {
-                        norm *= (1.0 - old_value)/valueA;
-                    }
+                    norm *= (1.0 - old_value)/valueA;
+                }
 
-                    if(norm > DBL_EPSILON)
-                    {
-                        FieldsDotDR(i,j,k) *= norm;
-                    }
-                    else
-                    {
-                        FieldsDotDR(i,j,k).clear();
-                    }
+                if(norm > DBL_EPSILON)
+                {
+                    FieldsDotDR(i,j,k) *= norm;
+                }
+                else
+                {
+                    FieldsDotDR(i,j,k).clear();
                 }
-                break;
             }
-            default:
-            {
+            break;
+        }
+        default:
+        {
 
-                for(auto alpha  = FieldsDR(i,j,k).cbegin();
-                         alpha != FieldsDR(i,j,k).cend(); ++alpha)
+            for(auto alpha  = FieldsDR(i,j,k).cbegin();
+                     alpha != FieldsDR(i,j,k).cend(); ++alpha)
+            {
+                double dPsiAlpha = 0.0;
+                for(auto beta  = FieldsDR(i,j,k).cbegin();
+                         beta != FieldsDR(i,j,k).cend(); ++beta)
+                if(alpha != beta)
+                {
+                    dPsiAlpha += FieldsDotDR(i,j,k).get_asym1(alpha->index,
+                                                               beta->index);
+                    dPsiAlpha += FieldsDotDR(i,j,k).get_asym2(alpha->index,
+                                                               beta->index);
+                }
+                /* Set out of bounds sets to zero */
+                if((alpha->value == 0.0 and dPsiAlpha < 0.0)
+                or (alpha->value == 1.0 and dPsiAlpha > 0.0))
                 {
-                    double dPsiAlpha = 0.0;
                     for(auto beta  = FieldsDR(i,j,k).cbegin();
                              beta != FieldsDR(i,j,k).cend(); ++beta)
                     if(alpha != beta)
                     {
-                        dPsiAlpha += FieldsDotDR(i,j,k).get_asym1(alpha->index,
-                                                                   beta->index);
-                        dPsiAlpha += FieldsDotDR(i,j,k).get_asym2(alpha->index,
-                                                                   beta->index);
-                    }
-                    /* Set out of bounds sets to zero */
-                    if((alpha->value == 0.0 and dPsiAlpha < 0.0)
-                    or (alpha->value == 1.0 and dPsiAlpha > 0.0))
-                    {
-                        for(auto beta  = FieldsDR(i,j,k).cbegin();
-                                 beta != FieldsDR(i,j,k).cend(); ++beta)
-                        if(alpha != beta)
-                        {
-                            FieldsDotDR(i,j,k).set_sym_pair(alpha->index, beta->index, 0.0, 0.0);
-                        }
+                        FieldsDotDR(i,j,k).set_sym_pair(alpha->index, beta->index, 0.0, 0.0);
                     }
                 }
-                for(auto alpha  = FieldsDotDR(i,j,k).begin();
-                         alpha != FieldsDotDR(i,j,k).end();)
+            }
+            for(auto alpha  = FieldsDotDR(i,j,k).begin();
+                     alpha != FieldsDotDR(i,j,k).end();)
+            {
+                /* Remove zero-sets from the storage */
+                if(alpha->value1 == 0.0 and alpha->value2 == 0.0)
                 {
-                    /* Remove zero-sets from the storage */
-                    if(alpha->value1 == 0.0 and alpha->value2 == 0.0)
-                    {
-                        alpha = FieldsDotDR(i,j,k).erase(alpha);
-                    }
-                    else
-                    {
-                        ++alpha;
-                    }
+                    alpha = FieldsDotDR(i,j,k).erase(alpha);
+                }
+                else
+                {
+                    ++alpha;
                 }
-                if(FieldsDotDR(i,j,k).size())
+            }
+            if(FieldsDotDR(i,j,k).size())
+            {
+                //cout << "while loop!" << endl;
+                /* Limit increments! This is done in a while loop, to acknowledge all
+                existing pair-contributions.*/
+                int number_of_iterations = 0;
+                bool LimitingNeeded = true;
+                while (LimitingNeeded)
                 {
-                    //cout << "while loop!" << endl;
-                    /* Limit increments! This is done in a while loop, to acknowledge all
-                    existing pair-contributions.*/
-                    int number_of_iterations = 0;
-                    bool LimitingNeeded = true;
-                    while (LimitingNeeded)
+                    number_of_iterations++;
+                    LimitingNeeded = false;
+                    NodeAB<double,double> locIncrements;
+                    for(auto it  = FieldsDotDR(i,j,k).cbegin();
+                             it != FieldsDotDR(i,j,k).cend(); ++it)
                     {
-                        number_of_iterations++;
-                        LimitingNeeded = false;
-                        NodeAB<double,double> locIncrements;
-                        for(auto it  = FieldsDotDR(i,j,k).cbegin();
-                                 it != FieldsDotDR(i,j,k).cend(); ++it)
+                        /* Collect increments */
+                        if(it->value1 < 0.0)
                         {
-                            /* Collect increments */
-                            if(it->value1 < 0.0)
-                            {
-                                locIncrements.add_sym2(it->indexA,0,  it->value1);
-                                locIncrements.add_sym1(it->indexB,0, -it->value1);
-                            }
-                            if(it->value1 > 0.0)
-                            {
-                                locIncrements.add_sym1(it->indexA,0,  it->value1);
-                                locIncrements.add_sym2(it->indexB,0, -it->value1);
-                            }
+                            locIncrements.add_sym2(it->indexA,0,  it->value1);
+                            locIncrements.add_sym1(it->indexB,0, -it->value1);
                         }
-                        NodeAB<double,double> locLimits;
-                        for(auto alpha  = FieldsDR(i,j,k).cbegin();
-                                 alpha != FieldsDR(i,j,k).cend(); ++alpha)
+                        if(it->value1 > 0.0)
+                        {
+                            locIncrements.add_sym1(it->indexA,0,  it->value1);
+                            locIncrements.add_sym2(it->indexB,0, -it->value1);
+                        }
+                    }
+                    NodeAB<double,double> locLimits;
+                    for(auto alpha  = FieldsDR(i,j,k).cbegin();
+                             alpha != FieldsDR(i,j,k).cend(); ++alpha)
+                    {
+                        /* Calculate limits */
+                        double posIncrement = locIncrements.get_sym1(alpha->index,0);
+                        double negIncrement = locIncrements.get_sym2(alpha->index,0);
+                        double newPFvalue = alpha->value+(posIncrement+negIncrement)*dt;
+                        locLimits.set_sym2(alpha->index,0,1.0);
+                        locLimits.set_sym1(alpha->index,0,1.0);
+                        if(newPFvalue < 0.0)
                         {
-                            /* Calculate limits */
-                            double posIncrement = locIncrements.get_sym1(alpha->index,0);
-                            double negIncrement = locIncrements.get_sym2(alpha->index,0);
-                            double newPFvalue = alpha->value+(posIncrement+negIncrement)*dt;
-                            locLimits.set_sym2(alpha->index,0,1.0);
-                            locLimits.set_sym1(alpha->index,0,1.0);
-                            if(newPFvalue < 0.0)
-                            {
-                                double tmpLim = locLimits.get_sym2(alpha->index,0);
-                                double tmpLim2 = min(tmpLim,-(alpha->value+posIncrement*dt)
-                                                              /(negIncrement*dt));
-                                locLimits.set_sym2(alpha->index,0, tmpLim2);
-                            }
-                            if(newPFvalue > 1.0)
-                            {
-                                double tmpLim = locLimits.get_sym1(alpha->index,0);
-                                double tmpLim2 = min(tmpLim,(1.0-(alpha->value+negIncrement*dt))
-                                                                /(posIncrement*dt));
-                                locLimits.set_sym1(alpha->index,0,tmpLim2);
-                            }
+                            double tmpLim = locLimits.get_sym2(alpha->index,0);
+                            double tmpLim2 = min(tmpLim,-(alpha->value+posIncrement*dt)
+                                                          /(negIncrement*dt));
+                            locLimits.set_sym2(alpha->index,0, tmpLim2);
                         }
-                        for(auto it  = FieldsDotDR(i,j,k).begin();
-                                 it != FieldsDotDR(i,j,k).end(); ++it)
+                        if(newPFvalue > 1.0)
                         {
-                            /* Limit increments */
-                            if(it->value1 < 0.0)
-                            {
-                                double tmpLim = min(locLimits.get_sym2(it->indexA,0),
-                                                    locLimits.get_sym1(it->indexB,0));
-                                it->value1 *= tmpLim;
-                                if (tmpLim < 1.0)
-                                LimitingNeeded = true;
-                            }
-                            if(it->value1 > 0.0)
-                            {
-                                double tmpLim = min(locLimits.get_sym1(it->indexA,0),
-                                                    locLimits.get_sym2(it->indexB,0));
-                                it->value1 *= tmpLim;
-                                if (tmpLim < 1.0)
-                                LimitingNeeded = true;
-                            }
+                            double tmpLim = locLimits.get_sym1(alpha->index,0);
+                            double tmpLim2 = min(tmpLim,(1.0-(alpha->value+negIncrement*dt))
+                                                            /(posIncrement*dt));
+                            locLimits.set_sym1(alpha->index,0,tmpLim2);
                         }
-                        /* Exit limiting loop, if no convergence after 24 iterations*/
-                        if (number_of_iterations > 24)
-                        LimitingNeeded = false;
                     }
-                    for(auto alpha  = FieldsDotDR(i,j,k).begin();
-                             alpha != FieldsDotDR(i,j,k).end(); )
+                    for(auto it  = FieldsDotDR(i,j,k).begin();
+                             it != FieldsDotDR(i,j,k).end(); ++it)
                     {
-                        /* Clean up values which are too small */
-                        if(fabs(alpha->value1) < DBL_EPSILON)
+                        /* Limit increments */
+                        if(it->value1 < 0.0)
                         {
-                            alpha = FieldsDotDR(i,j,k).erase(alpha);
+                            double tmpLim = min(locLimits.get_sym2(it->indexA,0),
+                                                locLimits.get_sym1(it->indexB,0));
+                            it->value1 *= tmpLim;
+                            if (tmpLim < 1.0)
+                            LimitingNeeded = true;
                         }
-                        else
+                        if(it->value1 > 0.0)
                         {
-                            ++alpha;
+                            double tmpLim = min(locLimits.get_sym1(it->indexA,0),
+                                                locLimits.get_sym2(it->indexB,0));
+                            it->value1 *= tmpLim;
+                            if (tmpLim < 1.0)
+                            LimitingNeeded = true;
                         }
                     }
-
-                    /* End plausibility check */
-                    NodePF tmpPF = FieldsDR(i,j,k);
-                    for(auto psi  = FieldsDotDR(i,j,k).cbegin();
-                             psi != FieldsDotDR(i,j,k).cend(); ++psi)
-                    if(psi->value1 != 0.0)
+                    /* Exit limiting loop, if no convergence after 24 iterations*/
+                    if (number_of_iterations > 24)
+                    LimitingNeeded = false;
+                }
+                for(auto alpha  = FieldsDotDR(i,j,k).begin();
+                         alpha != FieldsDotDR(i,j,k).end(); )
+                {
+                    /* Clean up values which are too small */
+                    if(fabs(alpha->value1) < DBL_EPSILON)
                     {
-                        tmpPF.add_value(psi->indexA,  psi->value1 * dt);
-                        tmpPF.add_value(psi->indexB, -psi->value1 * dt);
+                        alpha = FieldsDotDR(i,j,k).erase(alpha);
                     }
-                    for(auto it  = tmpPF.cbegin();
-                             it != tmpPF.cend(); ++it)
-                    if(it->value < -precision or it->value > 1.0 + precision)
+                    else
                     {
-                        double oldFields = FieldsDR(i,j,k).get_value(it->index);
-                        string msg = "Normalizing of phase field increments failed in point ("
-                                   + to_string(i) + "," + to_string(j) + "," + to_string(k)
-                                   + "). " + to_string(FieldsDR(i,j,k).size())
-                                   + " fields present. Grain "
-                                   + to_string(it->index) + " with a fields-value of "
-                                   + to_string(oldFields)
-                                   + " is incremented by "
-                                   + to_string(it->value-oldFields)
-                                   + ", which results in a fields-value of "
-                                   + to_string(it->value)
-                                   + ". This will result in undefined behavior!";
-                        ConsoleOutput::WriteWarning(msg,thisclassname,"NormalizeIncrements");
+                        ++alpha;
                     }
                 }
-                break;
+
+                /* End plausibility check */
+                NodePF tmpPF = FieldsDR(i,j,k);
+                for(auto psi  = FieldsDotDR(i,j,k).cbegin();
+                         psi != FieldsDotDR(i,j,k).cend(); ++psi)
+                if(psi->value1 != 0.0)
+                {
+                    tmpPF.add_value(psi->indexA,  psi->value1 * dt);
+                    tmpPF.add_value(psi->indexB, -psi->value1 * dt);
+                }
+                for(auto it  = tmpPF.cbegin();
+                         it != tmpPF.cend(); ++it)
+                if(it->value < -precision or it->value > 1.0 + precision)
+                {
+                    double oldFields = FieldsDR(i,j,k).get_value(it->index);
+                    string msg = "Normalizing of phase field increments failed in point ("
+                               + to_string(i) + "," + to_string(j) + "," + to_string(k)
+                               + "). " + to_string(FieldsDR(i,j,k).size())
+                               + " fields present. Grain "
+                               + to_string(it->index) + " with a fields-value of "
+                               + to_string(oldFields)
+                               + " is incremented by "
+                               + to_string(it->value-oldFields)
+                               + ", which results in a fields-value of "
+                               + to_string(it->value)
+                               + ". This will result in undefined behavior!";
+                    ConsoleOutput::WriteWarning(msg,thisclassname,"NormalizeIncrements");
+                }
             }
+            break;
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
+void PhaseField::NormalizeIncrementsDR(const BoundaryConditions& BC, const double dt)
+{
+    /** This function limits phase-field increments for all present phase-field
+    pairs, so that the actual phase-field values are within their natural
+    limits of 0.0 and 1.0.*/
+
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,InterfaceCellsDR,)
+    if (FieldsDR(i,j,k).wide_interface())
+    {
+        TimeInfo::CountIteration();
+        NormalizeCellIncrementsDR(i,j,k,dt);
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
     //SetIncrementsBoundaryConditionsDR(BC);
     CoarsenDot();
     SetIncrementsBoundaryConditionsSR(BC);
 
 #ifdef DEBUG
+    double precision = FLT_EPSILON;
 
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
     if(Fields(i,j,k).flag)
@@ -2082,30 +3333,86 @@ void PhaseField::SetBoundaryConditions(const BoundaryConditions& BC)
 
 void PhaseField::SetBoundaryConditionsSR(const BoundaryConditions& BC)
 {
-    if(Grid.dNx) BC.SetX(Fields);
-    if(Grid.dNy) BC.SetY(Fields);
-    if(Grid.dNz) BC.SetZ(Fields);
+    BC.SetAll(Fields);
+}
+
+void PhaseField::SetLocalBoundaryConditionsSR(const BoundaryConditions& BC)
+{
+    BC.SetLocal(Fields);
+}
+
+long int PhaseField::HaloReach(void) const
+{
+    return long(HaloExchangeInterval) - 1 - long(HaloSteps);
+}
+
+bool PhaseField::HaloExchangeDue(void) const
+{
+    return HaloSteps + 1 >= HaloExchangeInterval;
+}
+
+void PhaseField::AdvanceHaloStepSR(const bool clear)
+{
+    if(HaloExchangeInterval < 2) return;
+
+    if(HaloExchangeDue())
+    {
+        /* The increments exchanged into the halo would be merged again by the
+        redundant updates of the following time steps*/
+        if(clear)
+        {
+            OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,FieldsDot,FieldsDot.Bcells(),)
+            if(not InteriorCellSR(i,j,k) and FieldsDot(i,j,k).size())
+            {
+                FieldsDot(i,j,k).clear();
+            }
+            OMP_PARALLEL_STORAGE_LOOP_END
+        }
+    }
+    else
+    {
+        HaloSteps++;
+        HaloLocalFinalize = true;
+    }
+}
+
+void PhaseField::CheckHaloExchangeInterval(void)
+{
+    if(HaloExchangeInterval < 1)
+    {
+        HaloExchangeInterval = 1;
+    }
+    if(HaloExchangeInterval > 1 and Grid.Resolution == Resolutions::Dual)
+    {
+        ConsoleOutput::WriteWarning("HaloExchangeInterval > 1 is not supported in double resolution, the halo is exchanged every time step", thisclassname, "CheckHaloExchangeInterval()");
+        HaloExchangeInterval = 1;
+    }
+    if(HaloExchangeInterval > size_t(Grid.Bcells))
+    {
+        ConsoleOutput::WriteExit("HaloExchangeInterval = " + to_string(HaloExchangeInterval) + " needs at least as many boundary cells, Bcells = " + to_string(Grid.Bcells), thisclassname, "CheckHaloExchangeInterval()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    HaloSteps = 0;
 }
 
 void PhaseField::SetBoundaryConditionsDR(const BoundaryConditions& BC)
 {
-    if(Grid.dNx) BC.SetX(FieldsDR);
-    if(Grid.dNy) BC.SetY(FieldsDR);
-    if(Grid.dNz) BC.SetZ(FieldsDR);
+    BC.SetAll(FieldsDR);
 }
 
 void PhaseField::SetIncrementsBoundaryConditionsSR(const BoundaryConditions& BC)
 {
-    if(Grid.dNx) BC.SetX(FieldsDot);
-    if(Grid.dNy) BC.SetY(FieldsDot);
-    if(Grid.dNz) BC.SetZ(FieldsDot);
+    if(not HaloExchangeDue())
+    {
+        BC.SetLocal(FieldsDot);
+        return;
+    }
+    BC.SetAll(FieldsDot);
 }
 
 void PhaseField::SetIncrementsBoundaryConditionsDR(const BoundaryConditions& BC)
 {
-    if(Grid.dNx) BC.SetX(FieldsDotDR);
-    if(Grid.dNy) BC.SetY(FieldsDotDR);
-    if(Grid.dNz) BC.SetZ(FieldsDotDR);
+    BC.SetAll(FieldsDotDR);
 }
 
 void PhaseField::PrintPointStatistics(const int x, const int y, const int z) const
@@ -2133,16 +3440,16 @@ void PhaseField::WriteVTK(Settings& locSettings, const int tStep, const bool Cur
     {
         case Resolutions::Single:
         {
-            ListOfFields.push_back((VTK::Field_t) {"Interfaces",  [this](int i,int j,int k){return Interfaces(i,j,k);}});
-            ListOfFields.push_back((VTK::Field_t) {"Flags",       [this](int i,int j,int k){return Fields(i,j,k).flag;}});
-            ListOfFields.push_back((VTK::Field_t) {"PhaseFields", [this](int i,int j,int k){return Fields(i,j,k).majority_index();}});
+            ListOfFields.push_back(VTK::Field_t::Typed("Interfaces",  [this](int i,int j,int k){return Interfaces(i,j,k);}));
+            ListOfFields.push_back(VTK::Field_t::Typed("Flags",       [this](int i,int j,int k){return Fields(i,j,k).flag;}));
+            ListOfFields.push_back(VTK::Field_t::Typed("PhaseFields", [this](int i,int j,int k){return Fields(i,j,k).majority_index();}));
             for(size_t n = 0; n < Nphases; n++)
             {
-                ListOfFields.push_back((VTK::Field_t) {"PhaseFraction_" + std::to_string(n), [n,this](int i,int j,int k){return Fractions(i,j,k,{n});}});
+                ListOfFields.push_back(VTK::Field_t::Typed("PhaseFraction_" + std::to_string(n), [n,this](int i,int j,int k){return Fractions(i,j,k,{n});}));
             }
-            ListOfFields.push_back((VTK::Field_t) {"Junctions",   [this](int i,int j,int k){return Fields(i,j,k).size();}});
-            ListOfFields.push_back((VTK::Field_t) {"Variants",    [this](int i,int j,int k){return Variants(i,j,k);}});
-            ListOfFields.push_back((VTK::Field_t) {"ParentGrain", [this](int i,int j,int k){return ParentGrain(i,j,k);}});
+            ListOfFields.push_back(VTK::Field_t::Typed("Junctions",   [this](int i,int j,int k){return Fields(i,j,k).size();}));
+            ListOfFields.push_back(VTK::Field_t::Typed("Variants",    [this](int i,int j,int k){return Variants(i,j,k);}));
+            ListOfFields.push_back(VTK::Field_t::Typed("ParentGrain", [this](int i,int j,int k){return ParentGrain(i,j,k);}));
 
             if(CurvatureOutput)
             for (size_t n = 0; n < Nphases; n++)
@@ -2339,6 +3646,16 @@ bool PhaseField::WriteMPI(const std::string& FileName)
 
 bool PhaseField::Write(const std::string& FileName) const
 {
+    if(AsyncOutput::Active())
+    {
+        /* The serialized fields are written by the output threads */
+        ostringstream out(ios::out | ios::binary);
+        if(IndexedRawData) WriteIndexed(out);
+        else               Write(out);
+        AsyncOutput::WriteFile(FileName, out.str());
+        return true;
+    }
+
     fstream out(FileName.c_str(), ios::out | ios::binary);
 
     if (!out)
@@ -2347,7 +3664,14 @@ bool PhaseField::Write(const std::string& FileName) const
                 thisclassname, "Write()");
         return false;
     };
+    if(IndexedRawData) WriteIndexed(out);
+    else               Write(out);
+    out.close();
+    return true;
+}
 
+void PhaseField::Write(std::ostream& out) const
+{
     int Nx = Grid.Nx;
     int Ny = Grid.Ny;
     int Nz = Grid.Nz;
@@ -2383,8 +3707,6 @@ bool PhaseField::Write(const std::string& FileName) const
             break;
         }
     }
-    out.close();
-    return true;
 }
 
 bool PhaseField::Write(const Settings& locSettings, const int tStep) const
@@ -2396,11 +3718,199 @@ bool PhaseField::Write(const Settings& locSettings, const int tStep) const
     string FileName =
         FileInterface::MakeFileName(locSettings.InputRawDataDir,thisclassname+"_", tStep, ".dat");
     #endif
-    bool write_success = Write(FileName);
+    bool write_success = false;
+    if(locSettings.DeltaCheckpoints > 0)
+    {
+        Checkpoints.Initialize(Grid.Nx, Grid.Ny, Grid.Nz, locSettings.DeltaBlockSize, locSettings.DeltaCheckpoints);
+        write_success = Checkpoints.Write(locSettings.InputRawDataDir, DeltaCheckpoint::Prefix(thisclassname), tStep,
+            [this](std::ostream& out, const DeltaCheckpoint::Block_t& B){WriteBlock(out, B);});
+    }
+    else
+    {
+        write_success = Write(FileName);
+    }
     write_success = write_success && FieldsProperties.Write(locSettings, tStep);
     return write_success;
 }
 
+void PhaseField::WriteBlock(std::ostream& out, const DeltaCheckpoint::Block_t& B) const
+{
+    for(long int i = B.x0; i < B.x1; i++)
+    for(long int j = B.y0; j < B.y1; j++)
+    for(long int k = B.z0; k < B.z1; k++)
+    {
+        Fields(i,j,k).write(out);
+    }
+    if(Grid.Resolution == Resolutions::Dual)
+    {
+        for(long int i = (Grid.dNx + 1)*B.x0; i < (Grid.dNx + 1)*B.x1; i++)
+        for(long int j = (Grid.dNy + 1)*B.y0; j < (Grid.dNy + 1)*B.y1; j++)
+        for(long int k = (Grid.dNz + 1)*B.z0; k < (Grid.dNz + 1)*B.z1; k++)
+        {
+            FieldsDR(i,j,k).write(out);
+        }
+    }
+}
+
+void PhaseField::ReadBlock(std::istream& inp, const DeltaCheckpoint::Block_t& B)
+{
+    for(long int i = B.x0; i < B.x1; i++)
+    for(long int j = B.y0; j < B.y1; j++)
+    for(long int k = B.z0; k < B.z1; k++)
+    {
+        Fields(i,j,k).read(inp);
+    }
+    if(Grid.Resolution == Resolutions::Dual)
+    {
+        for(long int i = (Grid.dNx + 1)*B.x0; i < (Grid.dNx + 1)*B.x1; i++)
+        for(long int j = (Grid.dNy + 1)*B.y0; j < (Grid.dNy + 1)*B.y1; j++)
+        for(long int k = (Grid.dNz + 1)*B.z0; k < (Grid.dNz + 1)*B.z1; k++)
+        {
+            FieldsDR(i,j,k).read(inp);
+        }
+    }
+}
+
+/* Indexed raw format: "OPRAWIX1", int32 Nx, Ny, Nz, int32 number of storages
+(2 with FieldsDR in dual resolution), uint64 number of (i,j) columns and the
+uint64 offsets of the columns relative to the end of the offset table (number
+of columns + 1 entries), followed by the serialized columns of Fields and
+FieldsDR, z fastest. The offsets allow to deserialize the columns in parallel
+without scanning the file. */
+static const char IndexedRawMagic[8] = {'O','P','R','A','W','I','X','1'};
+
+void PhaseField::WriteIndexed(std::ostream& out) const
+{
+    vector<const Storage3D<NodePF,0>*> Storages{&Fields};
+    if(Grid.Resolution == Resolutions::Dual) Storages.push_back(&FieldsDR);
+
+    size_t nColumns = 0;
+    for(auto Storage : Storages) nColumns += Storage->sizeX()*Storage->sizeY();
+
+    vector<string> Columns(nColumns);
+    size_t First = 0;
+    for(auto Storage : Storages)
+    {
+        const long int locNy = Storage->sizeY();
+        const long int locNz = Storage->sizeZ();
+        const long int locColumns = Storage->sizeX()*locNy;
+        #pragma omp parallel for schedule(dynamic, 64)
+        for(long int c = 0; c < locColumns; c++)
+        {
+            ostringstream column(ios::out | ios::binary);
+            for(long int k = 0; k < locNz; k++)
+            {
+                (*Storage)(c/locNy, c%locNy, k).write(column);
+            }
+            Columns[First + c] = column.str();
+        }
+        First += locColumns;
+    }
+
+    vector<uint64_t> Offsets(nColumns + 1, 0);
+    for(size_t c = 0; c < nColumns; c++)
+    {
+        Offsets[c + 1] = Offsets[c] + Columns[c].size();
+    }
+
+    const int32_t Header[4] = {int32_t(Grid.Nx), int32_t(Grid.Ny), int32_t(Grid.Nz), int32_t(Storages.size())};
+    const uint64_t locColumns = nColumns;
+    out.write(IndexedRawMagic, sizeof(IndexedRawMagic));
+    out.write(reinterpret_cast<const char*>(Header), sizeof(Header));
+    out.write(reinterpret_cast<const char*>(&locColumns), sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(Offsets.data()), Offsets.size()*sizeof(uint64_t));
+    for(const string& column : Columns)
+    {
+        out.write(column.data(), column.size());
+    }
+}
+
+bool PhaseField::ReadIndexed(const std::string& FileName)
+{
+    MappedFile File(FileName);
+    const size_t HeaderSize = sizeof(IndexedRawMagic) + 4*sizeof(int32_t) + sizeof(uint64_t);
+    if(File.size() < HeaderSize or memcmp(File.data(), IndexedRawMagic, sizeof(IndexedRawMagic)) != 0)
+    {
+        ConsoleOutput::WriteWarning(FileName + " is not an indexed raw data file",
+                thisclassname, "ReadIndexed()");
+        return false;
+    }
+
+    int32_t Header[4];
+    uint64_t nColumns = 0;
+    memcpy(Header, File.data() + sizeof(IndexedRawMagic), sizeof(Header));
+    memcpy(&nColumns, File.data() + sizeof(IndexedRawMagic) + sizeof(Header), sizeof(uint64_t));
+    if(Header[0] != Grid.Nx or Header[1] != Grid.Ny or Header[2] != Grid.Nz)
+    {
+        stringstream message;
+        message << "Inconsistent system dimensions!\n"
+                << "Input data dimensions: ("
+                << Header[0] << ", "
+                << Header[1] << ", "
+                << Header[2] << ") grid points.\n"
+                << "Required data dimensions: ("
+                << Grid.Nx << ", "
+                << Grid.Ny << ", "
+                << Grid.Nz << ") grid points.\n";
+        ConsoleOutput::WriteWarning(message.str(), thisclassname, "ReadIndexed()");
+        return false;
+    }
+
+    vector<Storage3D<NodePF,0>*> Storages{&Fields};
+    if(Grid.Resolution == Resolutions::Dual) Storages.push_back(&FieldsDR);
+
+    size_t locColumns = 0;
+    for(auto Storage : Storages) locColumns += Storage->sizeX()*Storage->sizeY();
+    if(size_t(Header[3]) != Storages.size() or nColumns != locColumns or
+       File.size() < HeaderSize + (nColumns + 1)*sizeof(uint64_t))
+    {
+        ConsoleOutput::WriteWarning(FileName + " does not match the grid resolution",
+                thisclassname, "ReadIndexed()");
+        return false;
+    }
+
+    vector<uint64_t> Offsets(nColumns + 1);
+    memcpy(Offsets.data(), File.data() + HeaderSize, Offsets.size()*sizeof(uint64_t));
+    const char* Data = File.data() + HeaderSize + Offsets.size()*sizeof(uint64_t);
+    if(Offsets.back() > File.size() - (Data - File.data()))
+    {
+        ConsoleOutput::WriteWarning(FileName + " is truncated",
+                thisclassname, "ReadIndexed()");
+        return false;
+    }
+
+    long int nFailed = 0;
+    size_t First = 0;
+    for(auto Storage : Storages)
+    {
+        const long int locNy = Storage->sizeY();
+        const long int locNz = Storage->sizeZ();
+        const long int nStorageColumns = Storage->sizeX()*locNy;
+        #pragma omp parallel for schedule(dynamic, 64) reduction(+:nFailed)
+        for(long int c = 0; c < nStorageColumns; c++)
+        {
+            const uint64_t Begin = Offsets[First + c];
+            const uint64_t End   = Offsets[First + c + 1];
+            if(End < Begin) {nFailed++; continue;}
+            MemoryStream inp(Data + Begin, End - Begin);
+            for(long int k = 0; k < locNz; k++)
+            {
+                (*Storage)(c/locNy, c%locNy, k).read(inp);
+            }
+            if(!inp) nFailed++;
+        }
+        First += nStorageColumns;
+    }
+    if(nFailed)
+    {
+        ConsoleOutput::WriteWarning(FileName + " is corrupted",
+                thisclassname, "ReadIndexed()");
+        return false;
+    }
+    ConsoleOutput::WriteStandard(thisclassname, "Indexed binary input loaded");
+    return true;
+}
+
 void PhaseField::WriteH5(H5Interface& H5, const int tStep)
 {
     #ifdef H5OP
@@ -2485,6 +3995,24 @@ bool PhaseField::Read(string FileName)
         return false;
     };
 
+    char magic[sizeof(IndexedRawMagic)] = {};
+    inp.read(magic, sizeof(IndexedRawMagic));
+    if(inp and memcmp(magic, IndexedRawMagic, sizeof(IndexedRawMagic)) == 0)
+    {
+        inp.close();
+        return ReadIndexed(FileName);
+    }
+    inp.clear();
+    inp.seekg(0);
+
+    if(not Read(inp)) return false;
+    inp.close();
+    ConsoleOutput::WriteStandard(thisclassname, "Binary input loaded");
+    return true;
+}
+
+bool PhaseField::Read(std::istream& inp)
+{
     int locNx = Grid.Nx;
     int locNy = Grid.Ny;
     int locNz = Grid.Nz;
@@ -2533,9 +4061,7 @@ bool PhaseField::Read(string FileName)
             break;
         }
     }
-    inp.close();
-    ConsoleOutput::WriteStandard(thisclassname, "Binary input loaded");
-    return true;
+    return bool(inp);
 }
 
 bool PhaseField::Read(const Settings& locSettings, const BoundaryConditions& BC, int tStep)
@@ -2548,11 +4074,40 @@ bool PhaseField::Read(const Settings& locSettings, const BoundaryConditions& BC,
         FileInterface::MakeFileName(locSettings.InputRawDataDir,thisclassname+"_", tStep, ".dat");
 #endif
 
-    bool read_status = Read(FileName);
+    bool read_status = false;
+    if(std::filesystem::exists(FileName))
+    {
+        read_status = Read(FileName);
+    }
+    else
+    {
+        /* Restores the time step from incremental checkpoints */
+        Checkpoints.Initialize(Grid.Nx, Grid.Ny, Grid.Nz, locSettings.DeltaBlockSize, locSettings.DeltaCheckpoints);
+        read_status = Checkpoints.Read(locSettings.InputRawDataDir, DeltaCheckpoint::Prefix(thisclassname), tStep,
+            [this](std::istream& inp, const DeltaCheckpoint::Block_t& B){ReadBlock(inp, B);});
+    }
     read_status = read_status && FieldsProperties.Read(locSettings, tStep);
     Finalize(BC);
     return read_status;
 }
+void PhaseField::WriteCheckpoint(std::ostream& out) const
+{
+    Write(out);
+    FieldsProperties.Write(out);
+}
+
+bool PhaseField::ReadCheckpoint(std::istream& inp)
+{
+    return Read(inp) and FieldsProperties.Read(inp);
+}
+
+void PhaseField::FinalizeRead(const BoundaryConditions& BC)
+{
+    /* Checkpoints hold finalized cells, normalizing them again would change
+    the values in the last bit and a restart would not reproduce the run */
+    Finalize(BC, false);
+}
+
 void PhaseField::WriteAverageVolume(const int tStep, const size_t PhaseIndex) const
 {
     stringstream converter;
@@ -2561,13 +4116,6 @@ void PhaseField::WriteAverageVolume(const int tStep, const size_t PhaseIndex) co
     string FileName = string("AverageVolumeOfPhase_")
         + converter.str() + string(".txt");
 
-    if(!tStep)
-    {
-        fstream tout(FileName.c_str(), ios::out);
-        tout << "Time\tAvgVolume" << endl;
-        tout.close();
-    }
-
     double avgVol = 0;
     size_t count = 0;
     for(size_t n = 0; n < FieldsProperties.size(); n++)
@@ -2577,16 +4125,16 @@ void PhaseField::WriteAverageVolume(const int tStep, const size_t PhaseIndex) co
         count += 1.0;
     }
 
-    fstream out(FileName.c_str(), ios::out | ios::app);
+    stringstream out;
     if(count)
     {
-        out << tStep << "\t" << avgVol/count << endl;
+        out << tStep << "\t" << avgVol/count << "\n";
     }
     else
     {
-        out << tStep << "\t" << 0.0 << endl;
+        out << tStep << "\t" << 0.0 << "\n";
     }
-    out.close();
+    TimeSeriesOutput::Append(FileName, "Time\tAvgVolume\n", out.str(), not tStep);
 }
 
 void PhaseField::MoveFrame(const int dx, const int dy, const int dz,
@@ -2604,26 +4152,8 @@ void PhaseField::MoveFrame(const int dx, const int dy, const int dz,
 void PhaseField::MoveFrameSR(const int dx, const int dy, const int dz,
                              const BoundaryConditions& BC)
 {
-    int xBeg = (dx >= 0) + (dx < 0)*(Grid.Nx) - 1;
-    int xEnd = (dx >= 0)*(Grid.Nx) + (dx < 0) - 1;
-    int xInc = 1 - 2*(dx < 0);
-
-    int yBeg = (dy >= 0) + (dy < 0)*(Grid.Ny) - 1;
-    int yEnd = (dy >= 0)*(Grid.Ny) + (dy < 0) - 1;
-    int yInc = 1 - 2*(dy < 0);
-
-    int zBeg = (dz >= 0) + (dz < 0)*(Grid.Nz) - 1;
-    int zEnd = (dz >= 0)*(Grid.Nz) + (dz < 0) - 1;
-    int zInc = 1 - 2*(dz < 0);
-
-    for(int i = xBeg; ((dx >= 0) and (i <= xEnd)) or ((dx < 0) and (i >= xEnd)); i += xInc)
-    for(int j = yBeg; ((dy >= 0) and (j <= yEnd)) or ((dy < 0) and (j >= yEnd)); j += yInc)
-    for(int k = zBeg; ((dz >= 0) and (k <= zEnd)) or ((dz < 0) and (k >= zEnd)); k += zInc)
-    {
-        Fields(i, j, k) = Fields(i + dx*Grid.dNx, j + dy*Grid.dNy, k + dz*Grid.dNz);
-        Fractions(i, j, k) = Fractions(i + dx*Grid.dNx, j + dy*Grid.dNy, k + dz*Grid.dNz);
-
-    }
+    Fields.Shift(dx*Grid.dNx, dy*Grid.dNy, dz*Grid.dNz);
+    Fractions.Shift(dx*Grid.dNx, dy*Grid.dNy, dz*Grid.dNz);
     SetBoundaryConditionsSR(BC);
 }
 
@@ -2632,24 +4162,7 @@ void PhaseField::MoveFrameDR(const int dx, const int dy, const int dz,
 {
     for(int n = 0; n <= 1; n++)
     {
-        int xBeg = (dx >= 0) + (dx < 0)*(FieldsDR.sizeX()) - 1;
-        int xEnd = (dx >= 0)*(FieldsDR.sizeX()) + (dx < 0) - 1;
-        int xInc = 1 - 2*(dx < 0);
-
-        int yBeg = (dy >= 0) + (dy < 0)*(FieldsDR.sizeY()) - 1;
-        int yEnd = (dy >= 0)*(FieldsDR.sizeY()) + (dy < 0) - 1;
-        int yInc = 1 - 2*(dy < 0);
-
-        int zBeg = (dz >= 0) + (dz < 0)*(FieldsDR.sizeZ()) - 1;
-        int zEnd = (dz >= 0)*(FieldsDR.sizeZ()) + (dz < 0) - 1;
-        int zInc = 1 - 2*(dz < 0);
-
-        for(int i = xBeg; ((dx >= 0) and (i <= xEnd)) or ((dx < 0) and (i >= xEnd)); i += xInc)
-        for(int j = yBeg; ((dy >= 0) and (j <= yEnd)) or ((dy < 0) and (j >= yEnd)); j += yInc)
-        for(int k = zBeg; ((dz >= 0) and (k <= zEnd)) or ((dz < 0) and (k >= zEnd)); k += zInc)
-        {
-            FieldsDR(i, j, k) = FieldsDR(i + dx*Grid.dNx, j + dy*Grid.dNy, k + dz*Grid.dNz);
-        }
+        FieldsDR.Shift(dx*Grid.dNx, dy*Grid.dNy, dz*Grid.dNz);
     }
     SetBoundaryConditionsDR(BC);
 }
@@ -2820,28 +4333,24 @@ void PhaseField::WriteVolumePercentages(const std::string& filename, double time
     if (MPI_RANK == 0)
 #endif
     {
-        if (!std::filesystem::exists(filename))
+        // Data header
+        std::stringstream header;
+        header << "time";
+        for(size_t idx = 0; idx < Nphases; idx++)
         {
-            // Write data header
-            std::ofstream file(filename, ios::out);
-            file << "time";
-            for(size_t idx = 0; idx < Nphases; idx++)
-            {
-                file << separator << PhaseNames[idx];
-            }
-            file << "\n";
-            file.close();
+            header << separator << PhaseNames[idx];
         }
+        header << "\n";
 
-        // Write data
-        std::ofstream file(filename, ios::app);
-        file << std::scientific << time;
+        // Data
+        std::stringstream line;
+        line << std::scientific << time;
         for(size_t idx = 0; idx < Nphases; idx++)
         {
-            file << std::scientific << separator << 100.0*FractionsTotal[idx];
+            line << std::scientific << separator << 100.0*FractionsTotal[idx];
         }
-        file << "\n";
-        file.close();
+        line << "\n";
+        TimeSeriesOutput::Append(filename, header.str(), line.str());
     }
 }
 
@@ -2854,33 +4363,43 @@ void PhaseField::WriteGrainsVolume(int time_step, double time, std::string filen
 
 string separator = " ";
 
-    if (!std::filesystem::exists(filename))
-    {
-        ofstream file(filename, ios::out);                                      //Create file and write header (or overwrite)
-        file << "# Volume of each grain in the order of their field-index! "
-             << "First row contains the simulation time. "
-             << "The next line contains the thermodynamic phase field index "
-             << "of each grain for identification\n";
+    stringstream header;
+    header << "# Volume of each grain in the order of their field-index! "
+           << "First row contains the simulation time. "
+           << "The next line contains the thermodynamic phase field index "
+           << "of each grain for identification\n";
 
-        file << "TimeStep " << separator << "Time";
-        for(size_t n = 0; n < FieldsProperties.size(); n++)
-        {
-            file << separator << FieldsProperties[n].Phase;
-        }
-        file << "\n";
-        file.close();
+    header << "TimeStep " << separator << "Time";
+    for(size_t n = 0; n < FieldsProperties.size(); n++)
+    {
+        header << separator << FieldsProperties[n].Phase;
     }
+    header << "\n";
 
-    ofstream file(filename, ios::app);
-    file.precision(10);
-    file << time_step << separator << time << separator;
+    stringstream line;
+    line.precision(10);
+    line << time_step << separator << time << separator;
 
     for (size_t i = 0; i < FieldsProperties.size(); i++)
     {
-        file << FieldsProperties[i].Volume << separator;
+        line << FieldsProperties[i].Volume << separator;
     }
-    file << "\n";
-    file.close();
+    line << "\n";
+    TimeSeriesOutput::Append(filename, header.str(), line.str());
+}
+
+size_t PhaseField::AllocatedMemory(void) const
+{
+    return Fractions.AllocatedMemory() +
+           Fields.AllocatedMemory() +
+           FieldsDot.AllocatedMemory() +
+           FieldsAdvectionDot.AllocatedMemory() +
+           FieldsAdvectionBackup.AllocatedMemory() +
+           FieldsDR.AllocatedMemory() +
+           FieldsDotDR.AllocatedMemory() +
+           FieldsFlat.AllocatedMemory() +
+           FieldsProperties.AllocatedMemory() +
+           (InterfaceCells.capacity() + InterfaceCellsDR.capacity())*sizeof(iVector3);
 }
 
 void PhaseField::Remesh(int newNx, int newNy, int newNz,
@@ -2927,6 +4446,25 @@ void PhaseField::Remesh(int newNx, int newNy, int newNz,
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
+void PhaseField::Repartition(const BoundaryConditions& BC)
+{
+    const GridParameters OldGrid = Grid;
+    Grid.ApplyCutPlanes();
+
+    LoadBalancer::Migrate(Fields, OldGrid, Grid);
+    FieldsDot.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    Fractions.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+
+    if(Grid.Resolution == Resolutions::Dual)
+    {
+        const GridParameters DoubleGrid = Grid.DoubleResolution();
+        LoadBalancer::Migrate(FieldsDR, OldGrid.DoubleResolution(), DoubleGrid);
+        FieldsDotDR.Reallocate(DoubleGrid.Nx, DoubleGrid.Ny, DoubleGrid.Nz);
+    }
+
+    Finalize(BC);
+}
+
 size_t PhaseField::PlantGrainNucleus(size_t PhaseIndex, int x, int y, int z)
 {
     size_t locIndex = FieldsProperties.add_grain(PhaseIndex);
@@ -2996,12 +4534,38 @@ PhaseField& PhaseField::operator= (const PhaseField& rhs)
         FractionsTotal = rhs.FractionsTotal;
 
         ConsiderNucleusVolume = rhs.ConsiderNucleusVolume;
+        FlatStorage = rhs.FlatStorage;
+        FusedFinalize = rhs.FusedFinalize;
+        FixedStencilKernels = rhs.FixedStencilKernels;
+        IncrementalGrainsVolume = rhs.IncrementalGrainsVolume;
+        GrainsVolumeCheckInterval = rhs.GrainsVolumeCheckInterval;
+        IncrementalGrainsTopology = rhs.IncrementalGrainsTopology;
+        DeltaGrainsSync = rhs.DeltaGrainsSync;
+        GrainsFullSyncInterval = rhs.GrainsFullSyncInterval;
+        GrainsSynced.clear(); // Next grain synchronization is a full one
+        GrainsDeltaSyncs = 0;
+        HaloExchangeInterval = rhs.HaloExchangeInterval;
+        OccupancyBlockSize = rhs.OccupancyBlockSize;
+        HaloSteps = rhs.HaloSteps;
+        HaloLocalFinalize = false;
+        NarrowBandDR = rhs.NarrowBandDR;
+        IndexedRawData = rhs.IndexedRawData;
+        GrainsVolumeLocal.clear(); // Next grain volume update is a full scan
+        GrainsVolumeIncrementsPending = false;
+        GrainsVolumeUpdates = 0;
+        Topology.Clear(); // Next grain topology update is a full scan
+        GrainsTopologyUpdates = 0;
+        FrontAxis = rhs.FrontAxis;
+        FrontPhase = rhs.FrontPhase;
+        FrontPlanesLocal.clear(); // Next front update is a full scan
+        FrontPlanesIncrementsPending = false;
 
         PhaseFieldLaplacianStencil = rhs.PhaseFieldLaplacianStencil;
         PhaseFieldGradientStencil = rhs.PhaseFieldGradientStencil;
 
         LStencil = rhs.LStencil;
         GStencil = rhs.GStencil;
+        SelectDerivativesKernelSR();
 
         FieldsProperties = rhs.FieldsProperties;
 
@@ -3028,6 +4592,8 @@ PhaseField& PhaseField::operator= (const PhaseField& rhs)
         }
         OMP_PARALLEL_STORAGE_LOOP_END
         CalculateFractions();
+        InterfaceCells = rhs.InterfaceCells;
+        InterfaceCellsDR = rhs.InterfaceCellsDR;
 
         if(Grid.Resolution == Resolutions::Dual)
         {
@@ -3585,6 +5151,7 @@ Matrix<int> PhaseField::GetPhaseFieldOverlap(const size_t thPhase1,
     int numberOfGrains = FieldsProperties.size();
     Overlap.Allocate(numberOfGrains, numberOfGrains);
 
+    ThreadLocalAccumulator<Matrix<int>> locOverlap(Overlap);
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Fields,0,)
     {
         if (Fields(i,j,k).interface())
@@ -3601,18 +5168,16 @@ Matrix<int> PhaseField::GetPhaseFieldOverlap(const size_t thPhase1,
                     size_t phaseIndex2 = jt->index;
                     size_t thPhaseIndex2 = FieldsProperties[phaseIndex2].Phase;
 
-                    #ifdef _OPENMP
-                    #pragma omp critical
-                    #endif
                     if (thPhaseIndex2 == thPhase2)
                     {
-                        Overlap.add(phaseIndex, phaseIndex2, 1);
+                        locOverlap.Local().add(phaseIndex, phaseIndex2, 1);
                     }
                 }
             }
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
+    Overlap = locOverlap.Sum();
     return Overlap;
 }
 
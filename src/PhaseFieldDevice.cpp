@@ -0,0 +1,593 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "PhaseFieldDevice.h"
+#include "BoundaryConditions.h"
+#include "InterfaceProperties.h"
+#include "PhaseField.h"
+
+namespace openphase
+{
+using namespace std;
+
+#pragma omp declare target
+/* Position of phase field idx in the local list of a cell, appended with
+value 0 if missing, -1 if the list is full */
+static inline int LocalSlot(int* locIndex, double* locValue, double* locLaplacian,
+                            int& locSize, const int idx)
+{
+    for(int n = 0; n < locSize; n++)
+    {
+        if(locIndex[n] == idx) return n;
+    }
+    if(locSize == PhaseFieldDevice::MaxLocal) return -1;
+    locIndex[locSize] = idx;
+    locValue[locSize] = 0.0;
+    locLaplacian[locSize] = 0.0;
+    return locSize++;
+}
+#pragma omp end declare target
+
+PhaseFieldDevice::~PhaseFieldDevice(void)
+{
+    Release();
+}
+
+void PhaseFieldDevice::ReadInput(const string InputFileName)
+{
+    stringstream inp = FileInterface::OpenInput(InputFileName);
+    if(!inp)
+    {
+        ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened", thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    int moduleLocation = FileInterface::FindModuleLocation(inp, "PhaseField");
+
+    Offload   = FileInterface::ReadParameterB(inp, moduleLocation, string("Offload"), false, false);
+    MaxFields = FileInterface::ReadParameterI(inp, moduleLocation, string("OffloadMaxFields"), false, 8);
+    if(MaxFields < 2 or MaxFields > MaxLocal)
+    {
+        ConsoleOutput::WriteExit("OffloadMaxFields has to be between 2 and " + to_string(MaxLocal), thisclassname, "ReadInput()");
+        OP_Exit(EXIT_FAILURE);
+    }
+}
+
+bool PhaseFieldDevice::Supported(const PhaseField& Phase, const InterfaceProperties& IP,
+                                 const BoundaryConditions& BC, string& Reason) const
+{
+#ifdef MPI_PARALLEL
+    Reason = "the MPI parallel build is not supported";
+    return false;
+#endif
+    if(Phase.Grid.Resolution != Resolutions::Single)
+    {
+        Reason = "double resolution is not supported";
+        return false;
+    }
+    if(BC.BC0X != BoundaryConditionTypes::Periodic or BC.BCNX != BoundaryConditionTypes::Periodic or
+       BC.BC0Y != BoundaryConditionTypes::Periodic or BC.BCNY != BoundaryConditionTypes::Periodic or
+       BC.BC0Z != BoundaryConditionTypes::Periodic or BC.BCNZ != BoundaryConditionTypes::Periodic)
+    {
+        Reason = "periodic boundary conditions are required";
+        return false;
+    }
+    if(Phase.Nphases != 1)
+    {
+        Reason = "only a single thermodynamic phase is supported";
+        return false;
+    }
+    if(IP.InterfaceEnergy(0,0).Model != InterfaceEnergyModels::Iso or
+       IP.InterfaceMobility(0,0).Model != InterfaceMobilityModels::Iso or
+       IP.FullAnisotropy or IP.RespectParentBoundaries(0,0) or
+       IP.ExtrapolationMode != InterfaceProperties::ExtrapolationModes::None)
+    {
+        Reason = "isotropic interface energy and mobility without extrapolation are required";
+        return false;
+    }
+    if(Phase.LStencil.size() > 27)
+    {
+        Reason = "Laplacian stencils with more than 27 entries are not supported";
+        return false;
+    }
+    for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
+    if(Phase.FieldsProperties[idx].Exist)
+    {
+        if(Phase.FieldsProperties[idx].Stage != GrainStages::Stable or
+           Phase.FieldsProperties[idx].VolumeRatio != 1.0 or
+           Phase.FieldsProperties[idx].GrowthConstraintsViolation != GrowthConstraintsViolations::None)
+        {
+            Reason = "all grains have to be stable";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PhaseFieldDevice::Initialize(const PhaseField& Phase, const InterfaceProperties& IP,
+                                  const BoundaryConditions& BC)
+{
+    Release();
+    if(not Offload) return false;
+
+    string Reason;
+    if(not Supported(Phase, IP, BC, Reason))
+    {
+        ConsoleOutput::WriteWarning("Offload is not possible, " + Reason + ". Running on the host.", thisclassname, "Initialize()");
+        Offload = false;
+        return false;
+    }
+
+    Nx = Phase.Grid.Nx;
+    Ny = Phase.Grid.Ny;
+    Nz = Phase.Grid.Nz;
+    dNx = Phase.Grid.dNx;
+    dNy = Phase.Grid.dNy;
+    dNz = Phase.Grid.dNz;
+    Ncells = Nx*Ny*Nz;
+    Nslots = MaxFields;
+
+    Nstencil = 0;
+    for(auto ls = Phase.LStencil.cbegin(); ls != Phase.LStencil.cend(); ls++)
+    {
+        StencilOffsets[3*Nstencil  ] = ls->di;
+        StencilOffsets[3*Nstencil+1] = ls->dj;
+        StencilOffsets[3*Nstencil+2] = ls->dk;
+        StencilWeights[Nstencil] = ls->weight;
+        Nstencil++;
+    }
+
+    Energy    = IP.InterfaceEnergy(0,0).Energy;
+    Mobility  = IP.InterfaceMobility(0,0).MaxMobility;
+    Prefactor = Pi*Pi/(Phase.Grid.Eta*Phase.Grid.Eta);
+    /* With a single phase and stable grains the triple junction term of
+    DoubleObstacle::CalculatePhaseFieldIncrements() reduces to a constant
+    times (alpha - beta)*gamma */
+    switch(IP.TripleJunctionModel)
+    {
+        case TripleJunctionModels::Model:
+        {
+            TripleJunction = IP.TripleJunctionFactor*Prefactor*3.0*Energy;
+            break;
+        }
+        case TripleJunctionModels::Value:
+        {
+            TripleJunction = IP.TripleJunctionEnergy*Prefactor;
+            break;
+        }
+        case TripleJunctionModels::None:
+        {
+            TripleJunction = 0.0;
+            break;
+        }
+    }
+
+    const size_t NEntries = Nslots*Ncells;
+    const size_t NCells   = Ncells;
+
+    Index       = new int[NEntries];
+    Value       = new double[NEntries]();
+    IndexNew    = new int[NEntries];
+    ValueNew    = new double[NEntries]();
+    Flag        = new int[NCells]();
+    Truncations = new long int[1]();
+    fill(Index, Index + NEntries, -1);
+    fill(IndexNew, IndexNew + NEntries, -1);
+
+    // The aliases are only used by the target pragmas, which are ignored without offload
+    [[maybe_unused]] int*      idx  = Index;
+    [[maybe_unused]] double*   val  = Value;
+    [[maybe_unused]] int*      idxN = IndexNew;
+    [[maybe_unused]] double*   valN = ValueNew;
+    [[maybe_unused]] int*      flg  = Flag;
+    [[maybe_unused]] long int* trc  = Truncations;
+    #pragma omp target enter data map(to: idx[0:NEntries], val[0:NEntries], \
+            idxN[0:NEntries], valN[0:NEntries], flg[0:NCells], trc[0:1])
+
+    CopyToDevice(Phase);
+    return true;
+}
+
+void PhaseFieldDevice::Release(void)
+{
+    if (not IsAllocated()) return;
+
+    const size_t NEntries = Nslots*Ncells;
+    const size_t NCells   = Ncells;
+
+    [[maybe_unused]] int*      idx  = Index;
+    [[maybe_unused]] double*   val  = Value;
+    [[maybe_unused]] int*      idxN = IndexNew;
+    [[maybe_unused]] double*   valN = ValueNew;
+    [[maybe_unused]] int*      flg  = Flag;
+    [[maybe_unused]] long int* trc  = Truncations;
+    #pragma omp target exit data map(delete: idx[0:NEntries], val[0:NEntries], \
+            idxN[0:NEntries], valN[0:NEntries], flg[0:NCells], trc[0:1])
+
+    delete[] Index;
+    delete[] Value;
+    delete[] IndexNew;
+    delete[] ValueNew;
+    delete[] Flag;
+    delete[] Truncations;
+    Index       = nullptr;
+    Value       = nullptr;
+    IndexNew    = nullptr;
+    ValueNew    = nullptr;
+    Flag        = nullptr;
+    Truncations = nullptr;
+    Ncells = 0;
+}
+
+void PhaseFieldDevice::CopyToDevice(const PhaseField& Phase)
+{
+    /* Cells with more than Nslots phase fields keep the largest values,
+    renormalized to a sum of 1 */
+    long int locTruncations = 0;
+    #pragma omp parallel for collapse(3) reduction(+:locTruncations)
+    for(long int i = 0; i < Nx; ++i)
+    for(long int j = 0; j < Ny; ++j)
+    for(long int k = 0; k < Nz; ++k)
+    {
+        const size_t cell = (i*Ny + j)*Nz + k;
+        vector<pair<double,int>> Entries;
+        for(auto it = Phase.Fields(i,j,k).cbegin(); it != Phase.Fields(i,j,k).cend(); ++it)
+        {
+            if(it->value > 0.0) Entries.emplace_back(it->value, it->index);
+        }
+        if(Entries.size() > size_t(Nslots))
+        {
+            partial_sort(Entries.begin(), Entries.begin() + Nslots, Entries.end(),
+                         [](const pair<double,int>& a, const pair<double,int>& b){return a.first > b.first;});
+            Entries.resize(Nslots);
+            locTruncations++;
+        }
+        double total = 0.0;
+        for(const auto& Entry : Entries) total += Entry.first;
+        for(int n = 0; n < Nslots; n++)
+        {
+            const bool used = size_t(n) < Entries.size();
+            Index[n*Ncells + cell] = used ? Entries[n].second : -1;
+            Value[n*Ncells + cell] = used ? Entries[n].first/total : 0.0;
+        }
+    }
+    if(locTruncations)
+    {
+        ConsoleOutput::WriteWarning(to_string(locTruncations) + " cells have more than "
+                + to_string(Nslots) + " phase fields, the smallest ones are dropped. Increase $OffloadMaxFields.",
+                thisclassname, "CopyToDevice()");
+    }
+
+    const size_t NEntries = Nslots*Ncells;
+    [[maybe_unused]] int*    idx = Index;
+    [[maybe_unused]] double* val = Value;
+    #pragma omp target update to(idx[0:NEntries], val[0:NEntries])
+}
+
+void PhaseFieldDevice::CopyToHost(PhaseField& Phase, const BoundaryConditions& BC)
+{
+    const size_t NEntries = Nslots*Ncells;
+    [[maybe_unused]] int*      idx = Index;
+    [[maybe_unused]] double*   val = Value;
+    [[maybe_unused]] long int* trc = Truncations;
+    #pragma omp target update from(idx[0:NEntries], val[0:NEntries], trc[0:1])
+
+    if(Truncations[0])
+    {
+        ConsoleOutput::WriteWarning(to_string(Truncations[0]) + " cell updates had more than "
+                + to_string(Nslots) + " phase fields, the smallest ones were dropped. Increase $OffloadMaxFields.",
+                thisclassname, "CopyToHost()");
+        Truncations[0] = 0;
+        #pragma omp target update to(trc[0:1])
+    }
+
+    #pragma omp parallel for collapse(3)
+    for(long int i = 0; i < Nx; ++i)
+    for(long int j = 0; j < Ny; ++j)
+    for(long int k = 0; k < Nz; ++k)
+    {
+        const size_t cell = (i*Ny + j)*Nz + k;
+        NodePF& locPF = Phase.Fields(i,j,k);
+        locPF.clear();
+        for(int n = 0; n < Nslots; n++)
+        if(Index[n*Ncells + cell] >= 0)
+        {
+            locPF.set_value(Index[n*Ncells + cell], Value[n*Ncells + cell]);
+        }
+    }
+    Phase.Finalize(BC);
+}
+
+void PhaseFieldDevice::Step(const double dt)
+{
+    SetFlags();
+    Update(dt);
+    swap(Index, IndexNew);
+    swap(Value, ValueNew);
+}
+
+void PhaseFieldDevice::SetFlags(void)
+{
+    /* Pulled from the neighbours as in PhaseField::SetNeighborFlagsSR():
+    2 in cells with several phase fields, 1 next to them */
+    const int*    idx = Index;
+    int*          flg = Flag;
+    const long int nx = Nx;
+    const long int ny = Ny;
+    const long int nz = Nz;
+    const int dnx = dNx;
+    const int dny = dNy;
+    const int dnz = dNz;
+    const size_t ncells = Ncells;
+
+    #pragma omp target teams distribute parallel for collapse(3)
+    for (long int i = 0; i < nx; ++i)
+    for (long int j = 0; j < ny; ++j)
+    for (long int k = 0; k < nz; ++k)
+    {
+        const size_t cell = (i*ny + j)*nz + k;
+        int locFlag = (idx[ncells + cell] >= 0) ? 2 : 0;
+        for (int ii = -dnx; ii <= dnx and locFlag == 0; ++ii)
+        for (int jj = -dny; jj <= dny and locFlag == 0; ++jj)
+        for (int kk = -dnz; kk <= dnz and locFlag == 0; ++kk)
+        {
+            const size_t ncell = (((i + ii + nx) % nx)*ny + (j + jj + ny) % ny)*nz + (k + kk + nz) % nz;
+            if (idx[ncells + ncell] >= 0) locFlag = 1;
+        }
+        flg[cell] = locFlag;
+    }
+}
+
+void PhaseFieldDevice::Update(const double dt)
+{
+    const int*    idx  = Index;
+    const double* val  = Value;
+    int*          idxN = IndexNew;
+    double*       valN = ValueNew;
+    const int*    flg  = Flag;
+    long int*     trc  = Truncations;
+    const long int nx = Nx;
+    const long int ny = Ny;
+    const long int nz = Nz;
+    const size_t ncells = Ncells;
+    const int nslots = Nslots;
+    const int nstencil = Nstencil;
+    const int*    so = StencilOffsets;
+    const double* sw = StencilWeights;
+    const double sigma = Energy;
+    const double mu = Mobility;
+    const double tj = TripleJunction;
+    const double P  = Prefactor;
+
+    #pragma omp target teams distribute parallel for collapse(3) \
+            map(to: so[0:3*27], sw[0:27])
+    for (long int i = 0; i < nx; ++i)
+    for (long int j = 0; j < ny; ++j)
+    for (long int k = 0; k < nz; ++k)
+    {
+        const size_t cell = (i*ny + j)*nz + k;
+        if (flg[cell] == 0)
+        {
+            for (int n = 0; n < nslots; n++)
+            {
+                idxN[n*ncells + cell] = idx[n*ncells + cell];
+                valN[n*ncells + cell] = val[n*ncells + cell];
+            }
+            continue;
+        }
+
+        // Phase fields of the cell and of its stencil neighbours with their Laplacians
+        int    locIndex[MaxLocal];
+        double locValue[MaxLocal];
+        double locLaplacian[MaxLocal];
+        int    locSize = 0;
+        bool   truncated = false;
+        for (int n = 0; n < nslots; n++)
+        if (idx[n*ncells + cell] >= 0)
+        {
+            const int slot = LocalSlot(locIndex, locValue, locLaplacian, locSize, idx[n*ncells + cell]);
+            locValue[slot] = val[n*ncells + cell];
+        }
+        for (int s = 0; s < nstencil; s++)
+        {
+            const size_t ncell = (((i + so[3*s] + nx) % nx)*ny + (j + so[3*s+1] + ny) % ny)*nz
+                                + (k + so[3*s+2] + nz) % nz;
+            for (int n = 0; n < nslots; n++)
+            if (idx[n*ncells + ncell] >= 0 and val[n*ncells + ncell] != 0.0)
+            {
+                const int slot = LocalSlot(locIndex, locValue, locLaplacian, locSize, idx[n*ncells + ncell]);
+                if (slot < 0) {truncated = true; continue;}
+                locLaplacian[slot] += sw[s]*val[n*ncells + ncell];
+            }
+        }
+
+        // Double obstacle increments of all pairs (alpha < beta)
+        double Psi[MaxLocal*(MaxLocal-1)/2];
+        int nPairs = 0;
+        const double norm_1 = 1.0/locSize;
+        for (int a = 0; a < locSize; a++)
+        for (int b = a + 1; b < locSize; b++)
+        {
+            double dPhi_dt = sigma*((locLaplacian[a] + P*locValue[a]) -
+                                    (locLaplacian[b] + P*locValue[b]));
+            if (locSize > 2 and tj != 0.0)
+            for (int g = 0; g < locSize; g++)
+            if (g != a and g != b)
+            {
+                dPhi_dt += tj*(locValue[a]*locValue[g] - locValue[b]*locValue[g]);
+            }
+            Psi[nPairs++] = dPhi_dt*mu*norm_1;
+        }
+
+        // Limiting, see PhaseField::NormalizeCellIncrementsSR()
+        if (nPairs == 1)
+        {
+            const double valueA = Psi[0]*dt;
+            const double old_value = locValue[0];
+            if ((old_value == 0.0 and valueA < 0.0) or (old_value == 1.0 and valueA > 0.0))
+            {
+                Psi[0] = 0.0;
+            }
+            else
+            {
+                const double new_value = old_value + valueA;
+                double norm = 1.0;
+                if (new_value < 0.0) norm = -old_value/valueA;
+                else if (new_value > 1.0) norm = (1.0 - old_value)/valueA;
+                Psi[0] = (norm > DBL_EPSILON) ? Psi[0]*norm : 0.0;
+            }
+        }
+        else if (nPairs > 1)
+        {
+            for (int a = 0; a < locSize; a++)
+            {
+                double dPsiAlpha = 0.0;
+                int p = 0;
+                for (int n = 0; n < locSize; n++)
+                for (int m = n + 1; m < locSize; m++, p++)
+                {
+                    if (n == a) dPsiAlpha += Psi[p];
+                    if (m == a) dPsiAlpha -= Psi[p];
+                }
+                if ((locValue[a] == 0.0 and dPsiAlpha < 0.0) or
+                    (locValue[a] == 1.0 and dPsiAlpha > 0.0))
+                {
+                    p = 0;
+                    for (int n = 0; n < locSize; n++)
+                    for (int m = n + 1; m < locSize; m++, p++)
+                    {
+                        if (n == a or m == a) Psi[p] = 0.0;
+                    }
+                }
+            }
+
+            bool LimitingNeeded = true;
+            for (int iteration = 1; LimitingNeeded; iteration++)
+            {
+                LimitingNeeded = false;
+                double Pos[MaxLocal];
+                double Neg[MaxLocal];
+                for (int a = 0; a < locSize; a++) {Pos[a] = 0.0; Neg[a] = 0.0;}
+                int p = 0;
+                for (int n = 0; n < locSize; n++)
+                for (int m = n + 1; m < locSize; m++, p++)
+                {
+                    if (Psi[p] < 0.0) {Neg[n] += Psi[p]; Pos[m] -= Psi[p];}
+                    if (Psi[p] > 0.0) {Pos[n] += Psi[p]; Neg[m] -= Psi[p];}
+                }
+                double LimPos[MaxLocal];
+                double LimNeg[MaxLocal];
+                for (int a = 0; a < locSize; a++)
+                {
+                    const double newPFvalue = locValue[a] + (Pos[a] + Neg[a])*dt;
+                    LimPos[a] = 1.0;
+                    LimNeg[a] = 1.0;
+                    if (newPFvalue < 0.0)
+                    {
+                        LimNeg[a] = fmin(1.0, -(locValue[a] + Pos[a]*dt)/(Neg[a]*dt));
+                    }
+                    if (newPFvalue > 1.0)
+                    {
+                        LimPos[a] = fmin(1.0, (1.0 - (locValue[a] + Neg[a]*dt))/(Pos[a]*dt));
+                    }
+                }
+                p = 0;
+                for (int n = 0; n < locSize; n++)
+                for (int m = n + 1; m < locSize; m++, p++)
+                {
+                    if (Psi[p] < 0.0)
+                    {
+                        const double lim = fmin(LimNeg[n], LimPos[m]);
+                        Psi[p] *= lim;
+                        if (lim < 1.0) LimitingNeeded = true;
+                    }
+                    if (Psi[p] > 0.0)
+                    {
+                        const double lim = fmin(LimPos[n], LimNeg[m]);
+                        Psi[p] *= lim;
+                        if (lim < 1.0) LimitingNeeded = true;
+                    }
+                }
+                if (iteration > 24) LimitingNeeded = false;
+            }
+        }
+
+        // Merging, see PhaseField::MergeCellIncrementsSR()
+        {
+            int p = 0;
+            for (int n = 0; n < locSize; n++)
+            for (int m = n + 1; m < locSize; m++, p++)
+            {
+                const double value = Psi[p]*dt;
+                if (fabs(value) >= DBL_EPSILON)
+                {
+                    locValue[n] += value;
+                    locValue[m] -= value;
+                }
+            }
+        }
+
+        // Finalization, see NodePF::finalize(), the largest Nslots values are kept
+        int    outIndex[MaxLocal];
+        double outValue[MaxLocal];
+        int    outSize = 0;
+        double total = 0.0;
+        for (int n = 0; n < locSize; n++)
+        {
+            double value = locValue[n];
+            if (value >= 1.0 - DBL_EPSILON) value = 1.0;
+            if (value <= DBL_EPSILON) continue;
+            outIndex[outSize] = locIndex[n];
+            outValue[outSize] = value;
+            outSize++;
+        }
+        while (outSize > nslots)
+        {
+            int smallest = 0;
+            for (int n = 1; n < outSize; n++)
+            {
+                if (outValue[n] < outValue[smallest]) smallest = n;
+            }
+            outIndex[smallest] = outIndex[outSize-1];
+            outValue[smallest] = outValue[outSize-1];
+            outSize--;
+            truncated = true;
+        }
+        for (int n = 0; n < outSize; n++) total += outValue[n];
+        for (int n = 0; n < nslots; n++)
+        {
+            const bool used = n < outSize;
+            idxN[n*ncells + cell] = used ? outIndex[n] : -1;
+            valN[n*ncells + cell] = used ? ((outSize > 1) ? outValue[n]/total : 1.0) : 0.0;
+        }
+        if (truncated)
+        {
+            #pragma omp atomic
+            trc[0] += 1;
+        }
+    }
+}
+
+} //namespace openphase
@@ -43,7 +43,7 @@ void EnergyTransport::ReadInput(string InputFile)
     ConsoleOutput::WriteBlankLine();
     ConsoleOutput::WriteLineInsert("EnergyTransport");
     ConsoleOutput::WriteStandard("Source", InputFile);
-    std::fstream inp(InputFile, std::ios::in);
+    std::stringstream inp = FileInterface::OpenInput(InputFile);
     if (!inp)
     {
         std::stringstream message;
@@ -52,7 +52,6 @@ void EnergyTransport::ReadInput(string InputFile)
     };
     std::stringstream inp_data;
     inp_data << inp.rdbuf();
-    inp.close();
     int moduleLocation   = FileInterface::FindModuleLocation(inp_data, "EnergyTransport");
     Pr					 = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("Pr"), false, 0.71);
     Cp					 = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("Cp"), false, 1005.0);
@@ -178,239 +177,79 @@ void EnergyTransport::UpdateGhostPoints(PhaseField& Phase, FlowSolverLBM& FL, So
 
 void EnergyTransport::CalculateGhostPointsConjugateHeatTransfer(PhaseField& Phase, FlowSolverLBM& FL, SolidBody& SB)
 {
-    size_t Gasidx   = 0;
-    size_t Solididx = 1;
     double ep=1e-8;
     double D = SB.nDist;
+    GhostPoints.Update(Phase, FL, SB);
 
-    for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
-    if(Phase.FieldsProperties[idx].State == AggregateStates::Gas)
+    const long int nFluid = GhostPoints.FluidGhosts.size();
+    #pragma omp parallel for schedule(static)
+    for(long int n = 0; n < nFluid; n++)
     {
-        Gasidx = idx;
+        const GhostPoint& GP = GhostPoints.FluidGhosts[n];
+        const double X   = GP.X;
+        const double Tsi = GP.Interpolate(Ts);
+        const double Ksi = GP.Interpolate(K_Solid);
+        const double Tf  = Tx(GP.i,GP.j,GP.k);
+        const double Kf  = K_Mixture(GP.i,GP.j,GP.k);
+
+        double Tb  = (Kf/X*Tf+Ksi/D*Tsi)/(Kf/X+Ksi/D);
+        Ts(GP.i,GP.j,GP.k) = Tb * (1.0+X/D) - X/D*Tsi;
     }
-    int iBC=Grid.dNx*2.0;
-    int jBC=Grid.dNy*2.0;
-    int kBC=Grid.dNz*2.0;
 
-    int idi=Grid.dNx;
-    int jdi=Grid.dNy;
-    int kdi=Grid.dNz;
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Tx,0,)
+    const long int nSolid = GhostPoints.SolidGhosts.size();
+    #pragma omp parallel for schedule(static)
+    for(long int n = 0; n < nSolid; n++)
     {
-        bool Set_TsOut=false;
-        if(!FL.Obstacle(i,j,k))
-        for(int ii = -iBC; ii <= iBC; ii++)
-        for(int jj = -jBC; jj <= jBC; jj++)
-        for(int kk = -kBC; kk <= kBC; kk++)
+        const GhostPoint& GP = GhostPoints.SolidGhosts[n];
+        const double X   = GP.X;
+        const double Tfi = GP.Interpolate(Tx);
+        const double Kfi = GP.Interpolate(K_Mixture);
+        const double Tsi = Ts(GP.i,GP.j,GP.k);
+        const double Ksi = K_Solid(GP.i,GP.j,GP.k);
+        if(X<ep)
         {
-            if(FL.Obstacle(i+ii,j+jj,k+kk))
-            {
-                if(!Set_TsOut)
-                {
-                    dVector3 Norm{0.0,0.0,0.0};
-                    for (auto it = Phase.Fields(i,j,k).cbegin(); it != Phase.Fields(i,j,k).cend(); ++it)
-                    {
-                        if(Phase.FieldsProperties[it->index].State == AggregateStates::Solid)
-                        {
-                            Solididx=it->index;
-                            NodeAB<dVector3,dVector3> Normals=Phase.Normals(i,j,k);
-                            Norm=Normals.get_asym1(Solididx, Gasidx);
-                        }
-                    }
-                    double Phif = Phase.Fractions(i,j,k,{Gasidx});
-                    double X    = fabs(Phase.Grid.iWidth/Pi * asin(1.0-2.0*Phif));
-                    dVector3 Xf = {double(i), double(j), double(k)};
-                    dVector3 Xb = Xf - Norm*X;
-                    dVector3 Xs = Xb - Norm*D;
-                    double ic   = Xs.getX();
-                    double jc   = Xs.getY();
-                    double kc   = Xs.getZ();
-                    double i0   = floor(ic);
-                    double i1   = i0 + 1.0;
-                    double j0   = floor(jc);
-                    double j1   = j0 + 1.0;
-                    double k0   = floor(kc);
-                    double k1   = k0 + 1.0;
-
-                    double Tsi  =  SB.TrilinearInterPolation(ic,jc,kc,
-                                                          Ts(i0*idi,j0*jdi,k0*kdi),Ts(i1*idi,j0*jdi,k0*kdi),
-                                                          Ts(i0*idi,j1*jdi,k0*kdi),Ts(i1*idi,j1*jdi,k0*kdi),
-                                                          Ts(i0*idi,j0*jdi,k1*kdi),Ts(i1*idi,j0*jdi,k1*kdi),
-                                                          Ts(i0*idi,j1*jdi,k1*kdi),Ts(i1*idi,j1*jdi,k1*kdi));
-                    double Ksi  =  SB.TrilinearInterPolation(ic,jc,kc,
-                                                          K_Solid(i0*idi,j0*jdi,k0*kdi),K_Solid(i1*idi,j0*jdi,k0*kdi),
-                                                          K_Solid(i0*idi,j1*jdi,k0*kdi),K_Solid(i1*idi,j1*jdi,k0*kdi),
-                                                          K_Solid(i0*idi,j0*jdi,k1*kdi),K_Solid(i1*idi,j0*jdi,k1*kdi),
-                                                          K_Solid(i0*idi,j1*jdi,k1*kdi),K_Solid(i1*idi,j1*jdi,k1*kdi));
-                    double Tf  = Tx(i,j,k);
-                    double Kf  = K_Mixture(i,j,k);
-
-                    double Tb  = (Kf/X*Tf+Ksi/D*Tsi)/(Kf/X+Ksi/D);
-                    Ts (i,j,k) = Tb * (1.0+X/D) - X/D*Tsi;
-                    Set_TsOut=true;
-                }
-            }
+            Tx(GP.i,GP.j,GP.k) = Tsi;
         }
-
-        bool Set_TfOut=false;
-        if(FL.Obstacle(i,j,k))
-        for(int ii = -iBC; ii <= iBC; ii++)
-        for(int jj = -jBC; jj <= jBC; jj++)
-        for(int kk = -kBC; kk <= kBC; kk++)
+        else
         {
-            if(!FL.Obstacle(i+ii,j+jj,k+kk))
-            {
-                if(!Set_TfOut)
-                {
-                    dVector3 Norm{0.0,0.0,0.0};
-                    for (auto it = Phase.Fields(i,j,k).cbegin(); it != Phase.Fields(i,j,k).cend(); ++it)
-                    {
-                        if(Phase.FieldsProperties[it->index].State == AggregateStates::Solid)
-                        {
-                            Solididx=it->index;
-                            NodeAB<dVector3,dVector3> Normals=Phase.Normals(i,j,k);
-                            Norm=Normals.get_asym1(Solididx, Gasidx);
-                        }
-                    }
-                    double Phif = Phase.Fractions(i,j,k,{Gasidx});
-                    double X    = fabs(Phase.Grid.iWidth/Pi * asin(1.0-2.0*Phif));
-                    dVector3 Xs = {double(i), double(j), double(k)};
-                    dVector3 Xb = Xs + Norm*X;
-                    dVector3 Xf = Xb + Norm*D;
-                    double ic   = Xf.getX();
-                    double jc   = Xf.getY();
-                    double kc   = Xf.getZ();
-                    double i0   = floor(ic);
-                    double i1   = i0 + 1.0;
-                    double j0   = floor(jc);
-                    double j1   = j0 + 1.0;
-                    double k0   = floor(kc);
-                    double k1   = k0 + 1.0;
-
-                    double Tfi  = SB.TrilinearInterPolation(ic,jc,kc,
-                                                        Tx(i0*idi,j0*jdi,k0*kdi),Tx(i1*idi,j0*jdi,k0*kdi),
-                                                        Tx(i0*idi,j1*jdi,k0*kdi),Tx(i1*idi,j1*jdi,k0*kdi),
-                                                        Tx(i0*idi,j0*jdi,k1*kdi),Tx(i1*idi,j0*jdi,k1*kdi),
-                                                        Tx(i0*idi,j1*jdi,k1*kdi),Tx(i1*idi,j1*jdi,k1*kdi));
-                    double Kfi  = SB.TrilinearInterPolation(ic,jc,kc,
-                                                        K_Mixture(i0*idi,j0*jdi,k0*kdi),K_Mixture(i1*idi,j0*jdi,k0*kdi),
-                                                        K_Mixture(i0*idi,j1*jdi,k0*kdi),K_Mixture(i1*idi,j1*jdi,k0*kdi),
-                                                        K_Mixture(i0*idi,j0*jdi,k1*kdi),K_Mixture(i1*idi,j0*jdi,k1*kdi),
-                                                        K_Mixture(i0*idi,j1*jdi,k1*kdi),K_Mixture(i1*idi,j1*jdi,k1*kdi));
-                    double Tsi  = Ts(i,j,k);
-                    double Ksi  = K_Solid(i,j,k);
-                    if(X<ep)
-                    {
-                        Tx (i,j,k) = Tsi;
-                    }
-                    else
-                    {
-                        double Tb  = (Kfi/D*Tfi+Ksi/X*Tsi)/(Kfi/D+Ksi/X);
-                        Tx(i,j,k) =  Tb * (1.0+X/D) - X/D * Tfi;
-                    }
-                    Set_TfOut=true;
-                }
-            }
+            double Tb  = (Kfi/D*Tfi+Ksi/X*Tsi)/(Kfi/D+Ksi/X);
+            Tx(GP.i,GP.j,GP.k) =  Tb * (1.0+X/D) - X/D * Tfi;
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
 }
 
 void EnergyTransport::CalculateGhostPoints(PhaseField& Phase, FlowSolverLBM& FL, SolidBody& SB)
 {
-    size_t Gasidx = 0;
-    size_t Solididx = 1;
-    double Tb=TempSolid;
-    double Qb=HeatFlux;
     double ep=1e-8;
     double D = SB.nDist;
-    for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
-    if(Phase.FieldsProperties[idx].State == AggregateStates::Gas)
-    {
-        Gasidx = idx;
-    }
-    int iBC=Grid.dNx*2.0;
-    int jBC=Grid.dNy*2.0;
-    int kBC=Grid.dNz*2.0;
-    int idi=Grid.dNx;
-    int jdi=Grid.dNy;
-    int kdi=Grid.dNz;
+    GhostPoints.Update(Phase, FL, SB);
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Tx,0,)
+    const long int nSolid = GhostPoints.SolidGhosts.size();
+    #pragma omp parallel for schedule(static)
+    for(long int n = 0; n < nSolid; n++)
     {
-        bool Set_Tfout=false;
-        if(FL.Obstacle(i,j,k))
-        for(int ii = -iBC; ii <= iBC; ii++)
-        for(int jj = -jBC; jj <= jBC; jj++)
-        for(int kk = -kBC; kk <= kBC; kk++)
+        const GhostPoint& GP = GhostPoints.SolidGhosts[n];
+        const double X  = GP.X;
+        const double Tf = GP.Interpolate(Tx);
+        const double Kf = GP.Interpolate(K_Mixture);
+        if(IF_ConstTemp[GP.SolidIdx])
         {
-            if(!Set_Tfout)
+            double Tb = SurfaceTemp[GP.SolidIdx];
+            if(X<ep)
             {
-                if(!FL.Obstacle(i+ii,j+jj,k+kk))
-                {
-                    dVector3 Norm{0.0,0.0,0.0};
-                    for (auto it = Phase.Fields(i,j,k).cbegin(); it != Phase.Fields(i,j,k).cend(); ++it)
-                    {
-                        if(Phase.FieldsProperties[it->index].State == AggregateStates::Solid)
-                        {
-                            Solididx=it->index;
-                            NodeAB<dVector3,dVector3> Normals=Phase.Normals(i,j,k);
-                            Norm=Normals.get_asym1(Solididx, Gasidx);
-                        }
-                    }
-
-                    double Phif = Phase.Fractions(i,j,k,{Gasidx});
-                    double X    = fabs(Phase.Grid.iWidth/Pi * asin(1.0-2.0*Phif));
-
-                    dVector3 Xs = {double(i), double(j), double(k)};
-                    dVector3 Xb = Xs + Norm*X;
-                    dVector3 Xf = Xb + Norm*SB.nDist;
-
-                    double ic   = Xf.getX();
-                    double jc   = Xf.getY();
-                    double kc   = Xf.getZ();
-
-                    double i0   = floor(ic);
-                    double i1   = i0 + 1.0;
-                    double j0   = floor(jc);
-                    double j1   = j0 + 1.0;
-                    double k0   = floor(kc);
-                    double k1   = k0 + 1.0;
-
-                    double Tf   =  SB.TrilinearInterPolation(ic,jc,kc,
-                                                          Tx(i0*idi,j0*jdi,k0*kdi),Tx(i1*idi,j0*jdi,k0*kdi),
-                                                          Tx(i0*idi,j1*jdi,k0*kdi),Tx(i1*idi,j1*jdi,k0*kdi),
-                                                          Tx(i0*idi,j0*jdi,k1*kdi),Tx(i1*idi,j0*jdi,k1*kdi),
-                                                          Tx(i0*idi,j1*jdi,k1*kdi),Tx(i1*idi,j1*jdi,k1*kdi));
-                    double Kf   =  SB.TrilinearInterPolation(ic,jc,kc,
-                                                          K_Mixture(i0*idi,j0*jdi,k0*kdi),K_Mixture(i1*idi,j0*jdi,k0*kdi),
-                                                          K_Mixture(i0*idi,j1*jdi,k0*kdi),K_Mixture(i1*idi,j1*jdi,k0*kdi),
-                                                          K_Mixture(i0*idi,j0*jdi,k1*kdi),K_Mixture(i1*idi,j0*jdi,k1*kdi),
-                                                          K_Mixture(i0*idi,j1*jdi,k1*kdi),K_Mixture(i1*idi,j1*jdi,k1*kdi));
-                    if(IF_ConstTemp[Solididx])
-                    {
-                        Tb = SurfaceTemp[Solididx];
-                        if(X<ep)
-                        {
-                            Tx(i,j,k) = Tb;
-                        }
-                        else
-                        {
-                            Tx(i,j,k) =  Tb * (1.0+X/D) - X/D * Tf;
-                        }
-                    }
-                    else if(IF_ConstFlux[Solididx])
-                    {
-                        Qb = SurfaceFlux[Solididx];
-                        Tx(i,j,k) = Tf-(X+D)*Qb/Kf;
-                    }                    
-                    Set_Tfout = true;
-                }
+                Tx(GP.i,GP.j,GP.k) = Tb;
+            }
+            else
+            {
+                Tx(GP.i,GP.j,GP.k) =  Tb * (1.0+X/D) - X/D * Tf;
             }
         }
+        else if(IF_ConstFlux[GP.SolidIdx])
+        {
+            double Qb = SurfaceFlux[GP.SolidIdx];
+            Tx(GP.i,GP.j,GP.k) = Tf-(X+D)*Qb/Kf;
+        }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
 }
 
 double EnergyTransport::CalculatePhiVanLeer(double r)
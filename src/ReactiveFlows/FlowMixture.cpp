@@ -37,7 +37,7 @@ void FlowMixture::ReadInput(string InputFile)
     ConsoleOutput::WriteBlankLine();
     ConsoleOutput::WriteLineInsert("FlowMixture");
     ConsoleOutput::WriteStandard("Source", InputFile);
-    std::fstream inp(InputFile, std::ios::in);
+    std::stringstream inp = FileInterface::OpenInput(InputFile);
     if (!inp)
     {
         std::stringstream message;
@@ -46,7 +46,6 @@ void FlowMixture::ReadInput(string InputFile)
     };
     std::stringstream inp_data;
     inp_data << inp.rdbuf();
-    inp.close();
     int moduleLocation   = FileInterface::FindModuleLocation(inp_data, "FlowMixture");
     LengthScale    	     = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("LengthScale"), false, 1.0);
     Updating_Velocity    = FileInterface::ReadParameterB(inp_data, moduleLocation, std::string("Update_Vel"), false, false);
@@ -65,6 +64,7 @@ void FlowMixture::ReadInput(string InputFile)
 void FlowMixture::Initialize(Settings& locSettings, PhaseField& Phase, FlowSolverLBM& FL, Velocities& Vel, BoundaryConditions& BC)
 {
     V_Mixture.Allocate(locSettings.Grid, locSettings.Grid.Bcells);
+    FL.AllocateThermalCompressibility();
 
     SetInitialVelocity(Phase, BC, FL, Vel, FL.U0X);
     InitializingFlowProperties(Phase,FL,Vel, BC);
@@ -93,7 +93,7 @@ void FlowMixture::UpdateMixtureVelocity(Velocities& Vel)
     size_t Flowidx=0;
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,V_Mixture, V_Mixture.Bcells(),)
     {
-        V_Mixture (i,j,k)  = Vel.Phase(i,j,k,{Flowidx});
+        V_Mixture (i,j,k)  = Vel.Phase.get(i,j,k,Flowidx);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 }
@@ -308,6 +308,7 @@ void FlowMixture::DetectObstacles(FlowSolverLBM& FL, const PhaseField& Phase, bo
     }
     OMP_PARALLEL_STORAGE_LOOP_END
     FL.ObstaclesChanged = locObstaclesChanged;
+    if (locObstaclesChanged) FL.InvalidateFluidNodes();
 }
 
 void FlowMixture::CalculateDivergenceVelocity(PhaseField& Phase, FlowSolverLBM& FL,  EnergyTransport& ET, BoundaryConditions& BC, double dt)
@@ -367,7 +368,7 @@ void FlowMixture::CalculateDivergenceVelocity(PhaseField& Phase, FlowSolverLBM&
                     double TempoC = 0.0;
                     double SpatiC = 0.0;
 
-                    MMWc= ST.CalculateMeanMolarMass(i, j, k, "new");
+                    MMWc= ST.MeanMolarMass<SpeciesTransport::TimeLevel::New>(i, j, k);
                     for(size_t n =0; n < ST.nSpecies; n++)
                     {
                         TempoC += (ST.MassFractions(i,j,k,{n})-ST.MassFractionsOld(i,j,k,{n}))/dt*MMWc/ST.MolecularWeight({n});
@@ -0,0 +1,160 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "ReactiveFlows/GhostPointCache.h"
+#include "PhaseField.h"
+#include "FluidDynamics/FlowSolverLBM.h"
+#include "ReactiveFlows/SolidBody.h"
+
+namespace openphase
+{
+using namespace std;
+
+size_t GhostPointCache::ObstacleHash(const FlowSolverLBM& FL) const
+{
+    size_t locHash = 0;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,FL.Obstacle,FL.Obstacle.Bcells(),reduction(+:locHash))
+    {
+        if(FL.Obstacle(i,j,k))
+        {
+            locHash += (size_t(i)*73856093ULL) ^ (size_t(j)*19349663ULL) ^ (size_t(k)*83492791ULL);
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return locHash;
+}
+
+bool GhostPointCache::Update(const PhaseField& Phase, const FlowSolverLBM& FL, const SolidBody& SB)
+{
+    const size_t newHash = ObstacleHash(FL);
+    if(Valid and newHash == Hash and SB.nDist == Distance)
+    {
+        /* A static body keeps its obstacle map, the gas fraction in the ghost
+        cells reveals sub-cell motion of the interface */
+        bool Moved = false;
+        for(const auto& Ghosts : {&SolidGhosts, &FluidGhosts})
+        {
+            const long int nGhosts = Ghosts->size();
+            #pragma omp parallel for reduction(||:Moved)
+            for(long int n = 0; n < nGhosts; n++)
+            {
+                const GhostPoint& GP = (*Ghosts)[n];
+                Moved = Moved or Phase.Fractions(GP.i,GP.j,GP.k,{Gasidx}) != GP.GasFraction;
+            }
+        }
+        if(not Moved) return false;
+    }
+    Build(Phase, FL, SB);
+    Hash     = newHash;
+    Distance = SB.nDist;
+    Valid    = true;
+    Rebuilds++;
+    return true;
+}
+
+void GhostPointCache::Build(const PhaseField& Phase, const FlowSolverLBM& FL, const SolidBody& SB)
+{
+    Gasidx = 0;
+    for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
+    if(Phase.FieldsProperties[idx].State == AggregateStates::Gas)
+    {
+        Gasidx = idx;
+    }
+    const double D = SB.nDist;
+    const int iBC = FL.Grid.dNx*2;
+    const int jBC = FL.Grid.dNy*2;
+    const int kBC = FL.Grid.dNz*2;
+    const int dN[3] = {FL.Grid.dNx, FL.Grid.dNy, FL.Grid.dNz};
+
+    /* Ghost point of cell (i,j,k) with the interpolation point at the distance
+    D from the boundary, Side = +1 into the fluid, -1 into the solid */
+    auto Geometry = [&](const int i, const int j, const int k, const double Side)
+    {
+        GhostPoint GP;
+        GP.i = i; GP.j = j; GP.k = k;
+        GP.SolidIdx = 1;
+        dVector3 Norm{0.0,0.0,0.0};
+        for(auto it = Phase.Fields(i,j,k).cbegin(); it != Phase.Fields(i,j,k).cend(); ++it)
+        if(Phase.FieldsProperties[it->index].State == AggregateStates::Solid)
+        {
+            GP.SolidIdx = it->index;
+            Norm = Phase.Normals(i,j,k).get_asym1(GP.SolidIdx, Gasidx);
+        }
+        GP.GasFraction = Phase.Fractions(i,j,k,{Gasidx});
+        GP.X = fabs(Phase.Grid.iWidth/Pi * asin(1.0-2.0*GP.GasFraction));
+
+        dVector3 Xc = {double(i), double(j), double(k)};
+        dVector3 Xb = Xc + Norm*(Side*GP.X);
+        dVector3 Xi = Xb + Norm*(Side*D);
+
+        double C[3];
+        for(int d = 0; d < 3; d++)
+        {
+            const double Lo = floor(Xi[d]);
+            C[d]     = Xi[d] - Lo;
+            GP.Lo[d] = int(Lo)*dN[d];
+            GP.Hi[d] = int(Lo + 1.0)*dN[d];
+        }
+        GP.Weights[0] = (1.0-C[0])*(1.0-C[1])*(1.0-C[2]);
+        GP.Weights[1] =      C[0] *(1.0-C[1])*(1.0-C[2]);
+        GP.Weights[2] = (1.0-C[0])*     C[1] *(1.0-C[2]);
+        GP.Weights[3] =      C[0] *     C[1] *(1.0-C[2]);
+        GP.Weights[4] = (1.0-C[0])*(1.0-C[1])*     C[2];
+        GP.Weights[5] =      C[0] *(1.0-C[1])*     C[2];
+        GP.Weights[6] = (1.0-C[0])*     C[1] *     C[2];
+        GP.Weights[7] =      C[0] *     C[1] *     C[2];
+        return GP;
+    };
+
+    vector<vector<GhostPoint>> locSolid(omp_get_max_threads());
+    vector<vector<GhostPoint>> locFluid(omp_get_max_threads());
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,FL.Obstacle,0,)
+    {
+        const bool Solid = FL.Obstacle(i,j,k);
+        bool Boundary = false;
+        for(int ii = -iBC; ii <= iBC and not Boundary; ii++)
+        for(int jj = -jBC; jj <= jBC and not Boundary; jj++)
+        for(int kk = -kBC; kk <= kBC and not Boundary; kk++)
+        {
+            Boundary = (bool(FL.Obstacle(i+ii,j+jj,k+kk)) != Solid);
+        }
+        if(Boundary)
+        {
+            if(Solid) locSolid[omp_get_thread_num()].push_back(Geometry(i,j,k, 1.0));
+            else      locFluid[omp_get_thread_num()].push_back(Geometry(i,j,k,-1.0));
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    SolidGhosts.clear();
+    FluidGhosts.clear();
+    for(size_t t = 0; t < locSolid.size(); t++)
+    {
+        SolidGhosts.insert(SolidGhosts.end(), locSolid[t].begin(), locSolid[t].end());
+        FluidGhosts.insert(FluidGhosts.end(), locFluid[t].begin(), locFluid[t].end());
+    }
+}
+}
@@ -43,7 +43,7 @@ void SolidBody::ReadInput(string InputFile)
     ConsoleOutput::WriteBlankLine();
     ConsoleOutput::WriteLineInsert("SolidBody");
     ConsoleOutput::WriteStandard("Source", InputFile);
-    std::fstream inp(InputFile, std::ios::in);
+    std::stringstream inp = FileInterface::OpenInput(InputFile);
     if (!inp)
     {
         std::stringstream message;
@@ -52,7 +52,6 @@ void SolidBody::ReadInput(string InputFile)
     };
     std::stringstream inp_data;
     inp_data << inp.rdbuf();
-    inp.close();
     int moduleLocation   = FileInterface::FindModuleLocation(inp_data, "SolidBody");
     nParticles		     = FileInterface::ReadParameterI(inp_data, moduleLocation, std::string("nParticles"), false, 0);
     nRows		         = FileInterface::ReadParameterI(inp_data, moduleLocation, std::string("nRows"), false, 0);
@@ -73,6 +72,7 @@ void SolidBody::ReadInput(string InputFile)
 
     MinRadious       = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("MinRadious"), false,  10);
     MaxRadious       = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("MaxRadious"), false,  20);
+    MaxAttempts      = FileInterface::ReadParameterI(inp_data, moduleLocation, std::string("MaxAttempts"), false, 0);
 
     for (size_t i = 0; i < nParticles; ++i)
     {
@@ -685,46 +685,11 @@ bool SolidBody::isOverlapping(const Circle& c1, const Circle& c2)
 
 vector<Circle> SolidBody::generateNonOverlappingCircles(double width, double height, int N, double minRadius, double maxRadius, double dx)
 {
+    size_t maxAttempts = (MaxAttempts) ? MaxAttempts : max<size_t>(100000, 100*size_t(N));
     std::vector<Circle> circles;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> radiusDist(minRadius/dx, maxRadius/dx);
-    std::uniform_real_distribution<> xDist, yDist;
-
-    int maxAttempts = 100000;
-    int attempts = 0;
-
-    while (circles.size() < static_cast<size_t>(N) && attempts < maxAttempts) 
+    for(const auto& b : PackRandomBodies({width, 0.0, height}, N, minRadius/dx, maxRadius/dx, maxAttempts))
     {
-        double r = radiusDist(gen);
-        xDist = std::uniform_real_distribution<>(r, width - r);
-        yDist = std::uniform_real_distribution<>(r, height - r);
-
-        Circle newCircle{xDist(gen), yDist(gen), r};
-
-        bool overlap = false;
-        for (const auto& c : circles) 
-        {
-            if (isOverlapping(newCircle, c)) 
-            {
-                overlap = true;
-                break;
-            }
-        }
-
-        if (!overlap) 
-        {
-            Circle phynewCircle {newCircle.x, newCircle.z, newCircle.r};
-            circles.push_back(phynewCircle);
-        }
-        attempts++;
-    }
-
-    for (size_t ic = 0; ic < circles.size() ; ic++)
-    {
-        circles[ic].x *= dx; 
-        circles[ic].z *= dx; 
-        circles[ic].r *= dx; 
+        circles.push_back({b[0]*dx, b[2]*dx, b[3]*dx});
     }
 
     if (circles.size() < static_cast<size_t>(N)) 
@@ -782,59 +747,113 @@ bool SolidBody::isOverlapping(const Sphere& s1, const Sphere& s2)
 
 std::vector<Sphere> SolidBody::generateNonOverlappingSpheres(double Nx, double Ny, double Nz, int N,double minRadius, double maxRadius, double dx) 
 {
+    size_t maxAttempts = (MaxAttempts) ? MaxAttempts : max<size_t>(10000, 100*size_t(N));
     std::vector<Sphere> spheres;
-    std::random_device rd; 
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> radiusDist(minRadius/dx, maxRadius/dx);
-    std::uniform_real_distribution<> xDist, yDist, zDist;
-
-    int maxAttempts = 10000;
-    int attempts = 0;
-
-    while (spheres.size() < static_cast<size_t>(N) && attempts < maxAttempts) 
+    for(const auto& b : PackRandomBodies({Nx, Ny, Nz}, N, minRadius/dx, maxRadius/dx, maxAttempts))
     {
-        double r = radiusDist(gen);
+        spheres.push_back({b[0]*dx, b[1]*dx, b[2]*dx, b[3]*dx});
+    }
 
-        // Update bounds to keep the sphere entirely inside the box
-        xDist = std::uniform_real_distribution<>(r, Nx - r);
-        yDist = std::uniform_real_distribution<>(r, Ny - r);
-        zDist = std::uniform_real_distribution<>(r, Nz - r);
+    if (spheres.size() < static_cast<size_t>(N)) 
+    {
+        std::cerr << "Warning: Only " << spheres.size() << " spheres were placed after "
+                  << maxAttempts << " attempts.\n";
+    }
 
-        Sphere newSphere{ xDist(gen), yDist(gen), zDist(gen), r };
+    return spheres;
+}
 
-        bool overlap = false;
-        for (const auto& s : spheres) 
+vector<array<double,4>> SolidBody::PackRandomBodies(const array<double,3> Box, const size_t N,
+        const double minRadius, const double maxRadius, const size_t Attempts)
+{
+    /* Cell list of the placed bodies: with cells of at least the largest
+    interaction distance 2*maxRadius + Clearance only the bodies in the
+    adjacent cells can overlap a candidate */
+    const double CellSize = max(2.0*maxRadius + Clearance, 1.0);
+    array<long int,3> nCells;
+    for(int d = 0; d < 3; d++)
+    {
+        nCells[d] = (Box[d] > 0.0) ? max(1L, long(Box[d]/CellSize)) : 1;
+    }
+    vector<vector<size_t>> Cells(nCells[0]*nCells[1]*nCells[2]);
+    auto CellIndex = [&](const array<double,4>& b, array<long int,3>& c)
+    {
+        for(int d = 0; d < 3; d++)
         {
-            if (isOverlapping(newSphere, s)) 
-            {
-                overlap = true;
-                break;
-            }
+            c[d] = min(nCells[d] - 1, max(0L, long(b[d]/Box[d]*nCells[d])));
+            if(Box[d] <= 0.0) c[d] = 0;
         }
+        return (c[0]*nCells[1] + c[1])*nCells[2] + c[2];
+    };
 
-        if (!overlap) 
+    vector<array<double,4>> Bodies;
+    auto Overlaps = [&](const array<double,4>& b)
+    {
+        array<long int,3> c;
+        CellIndex(b, c);
+        for(long int x = max(0L, c[0]-1); x <= min(nCells[0]-1, c[0]+1); x++)
+        for(long int y = max(0L, c[1]-1); y <= min(nCells[1]-1, c[1]+1); y++)
+        for(long int z = max(0L, c[2]-1); z <= min(nCells[2]-1, c[2]+1); z++)
+        for(size_t n : Cells[(x*nCells[1] + y)*nCells[2] + z])
         {
-            Sphere phynewSphere{newSphere.x, newSphere.y, newSphere.z, newSphere.r};
-            spheres.push_back(phynewSphere);
+            const array<double,4>& o = Bodies[n];
+            const double dx = b[0] - o[0];
+            const double dy = b[1] - o[1];
+            const double dz = b[2] - o[2];
+            const double radiusSum = b[3] + o[3] + Clearance;
+            if(dx*dx + dy*dy + dz*dz < radiusSum*radiusSum) return true;
         }
-        attempts++;
-    }
+        return false;
+    };
 
-    for (size_t is = 0; is < spheres.size() ; is++)
+    /* Candidates are drawn from a counter based generator, candidate n is
+    the same for any number of threads. Each batch is generated and tested
+    against the bodies placed so far in parallel, the survivors are accepted
+    in order after a second test, which also covers the bodies accepted
+    earlier in the same batch */
+    std::random_device rd;
+    const uint64_t Seed = (uint64_t(rd()) << 32) ^ rd();
+    auto Uniform = [](uint64_t& state)
     {
-        spheres[is].x *= dx; 
-        spheres[is].y *= dx; 
-        spheres[is].z *= dx; 
-        spheres[is].r *= dx; 
-    }
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27))*0x94d049bb133111ebULL;
+        return double((z ^ (z >> 31)) >> 11)*0x1.0p-53;
+    };
 
-    if (spheres.size() < static_cast<size_t>(N)) 
+    const size_t BatchSize = 256*omp_get_max_threads();
+    vector<array<double,4>> Candidates;
+    vector<char> Rejected;
+    size_t attempts = 0;
+    while (Bodies.size() < N && attempts < Attempts)
     {
-        std::cerr << "Warning: Only " << spheres.size() << " spheres were placed after "
-                  << maxAttempts << " attempts.\n";
-    }
+        const long int Batch = min(BatchSize, Attempts - attempts);
+        Candidates.resize(Batch);
+        Rejected.resize(Batch);
+        #pragma omp parallel for schedule(static)
+        for(long int n = 0; n < Batch; n++)
+        {
+            uint64_t state = Seed ^ ((attempts + n)*0xd1b54a32d192ed03ULL);
+            array<double,4>& b = Candidates[n];
+            b[3] = minRadius + (maxRadius - minRadius)*Uniform(state);
+            for(int d = 0; d < 3; d++)
+            {
+                b[d] = (Box[d] > 0.0) ? b[3] + (Box[d] - 2.0*b[3])*Uniform(state) : 0.0;
+            }
+            Rejected[n] = Overlaps(b);
+        }
 
-    return spheres;
+        long int n = 0;
+        for(; n < Batch and Bodies.size() < N; n++)
+        if(not Rejected[n] and not Overlaps(Candidates[n]))
+        {
+            array<long int,3> c;
+            Cells[CellIndex(Candidates[n], c)].push_back(Bodies.size());
+            Bodies.push_back(Candidates[n]);
+        }
+        attempts += n;
+    }
+    return Bodies;
 }
 
 // Save spheres to a file
@@ -872,6 +891,68 @@ std::vector<Sphere> SolidBody::loadSpheresFromFile(const std::string& filename)
     return spheres;
 }
 
+/* Binary packing files: 8 byte tag, number of bodies and number of values
+per body (uint64_t each), followed by the raw values */
+template<class Body>
+static void WriteBodies(const std::vector<Body>& bodies, const std::string& filename)
+{
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        std::cerr << "Error: Cannot open file for writing: " << filename << "\n";
+        return;
+    }
+    const uint64_t header[2] = {bodies.size(), sizeof(Body)/sizeof(double)};
+    out.write("OPBODIES", 8);
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(bodies.data()), bodies.size()*sizeof(Body));
+}
+
+template<class Body>
+static std::vector<Body> ReadBodies(const std::string& filename)
+{
+    std::vector<Body> bodies;
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        std::cerr << "Warning: Cannot open file for reading: " << filename << "\n";
+        return bodies;
+    }
+    char tag[8];
+    uint64_t header[2];
+    in.read(tag, 8);
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in or std::string(tag, 8) != "OPBODIES" or header[1] != sizeof(Body)/sizeof(double)) {
+        std::cerr << "Warning: Not a packing file of this body type: " << filename << "\n";
+        return bodies;
+    }
+    bodies.resize(header[0]);
+    in.read(reinterpret_cast<char*>(bodies.data()), bodies.size()*sizeof(Body));
+    if (!in) {
+        std::cerr << "Warning: Truncated packing file: " << filename << "\n";
+        bodies.resize(in.gcount()/sizeof(Body));
+    }
+    return bodies;
+}
+
+void SolidBody::saveCirclesToBinaryFile(const std::vector<Circle>& circles, const std::string& filename)
+{
+    WriteBodies(circles, filename);
+}
+
+std::vector<Circle> SolidBody::loadCirclesFromBinaryFile(const std::string& filename)
+{
+    return ReadBodies<Circle>(filename);
+}
+
+void SolidBody::saveSpheresToBinaryFile(const std::vector<Sphere>& spheres, const std::string& filename)
+{
+    WriteBodies(spheres, filename);
+}
+
+std::vector<Sphere> SolidBody::loadSpheresFromBinaryFile(const std::string& filename)
+{
+    return ReadBodies<Sphere>(filename);
+}
+
 void SolidBody::DistributeRandomSolidBodies(PhaseField& Phase, Settings& locSettings, string dir)
 {
     int nDim=locSettings.Grid.Active();
@@ -884,50 +965,48 @@ void SolidBody::DistributeRandomSolidBodies(PhaseField& Phase, Settings& locSett
             {
                 rand_Circles = generateNonOverlappingCircles(XNDistZone-X0DistZone, ZNDistZone-Z0DistZone, 
                                                             nParticles, MinRadious, MaxRadious, dx);
-                saveCirclesToFile(rand_Circles,dir+"cylindersData.txt",dx);
+                saveCirclesToBinaryFile(rand_Circles,dir+"cylindersData.bin");
             }
             else if(nDim==3)
             {
                 rand_Spheres = generateNonOverlappingSpheres(XNDistZone-X0DistZone, YNDistZone-Y0DistZone,  ZNDistZone-Z0DistZone,
                                                              nParticles, MinRadious, MaxRadious, dx);
-                saveSpheresToFile(rand_Spheres,dir+"spheresData.txt",dx);
+                saveSpheresToBinaryFile(rand_Spheres,dir+"spheresData.bin");
             }
         }
     
+        /* Bodies which could not be placed stay zero, all of them are
+        distributed in one reduction */
+        #ifdef MPI_PARALLEL
         if(nDim==2)
         {
-            for (size_t i = 0; i < nParticles; ++i) 
-            {
-                #ifdef MPI_PARALLEL
-                OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Circles[i].r, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-                OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Circles[i].x, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-                OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Circles[i].z, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-                #endif
-            }
+            rand_Circles.resize(nParticles, {0.0, 0.0, 0.0});
+            OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Circles[0].x, 3*nParticles, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
         }
         else if(nDim==3)
         {
-            for (size_t i = 0; i < nParticles; ++i) 
-            {
-                #ifdef MPI_PARALLEL
-                OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Spheres[i].r, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-                OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Spheres[i].x, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-                OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Spheres[i].y, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-                OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Spheres[i].z, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-                #endif
-            }
+            rand_Spheres.resize(nParticles, {0.0, 0.0, 0.0, 0.0});
+            OP_MPI_Allreduce(OP_MPI_IN_PLACE, &rand_Spheres[0].x, 4*nParticles, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
         }
+        #endif
     }
 
     if(!Do_randDist)
     {
+        /* Text files of earlier setups are still accepted */
         if(nDim==2)
         {
-            rand_Circles = loadCirclesFromFile(dir+"cylindersData.txt");
+            if(std::filesystem::exists(dir+"cylindersData.bin"))
+                rand_Circles = loadCirclesFromBinaryFile(dir+"cylindersData.bin");
+            else
+                rand_Circles = loadCirclesFromFile(dir+"cylindersData.txt");
         }
         else if(nDim==3)
         {
-            rand_Spheres = loadSpheresFromFile(dir+"spheresData.txt");
+            if(std::filesystem::exists(dir+"spheresData.bin"))
+                rand_Spheres = loadSpheresFromBinaryFile(dir+"spheresData.bin");
+            else
+                rand_Spheres = loadSpheresFromFile(dir+"spheresData.txt");
         }
     }
 }
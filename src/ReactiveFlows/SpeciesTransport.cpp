@@ -43,7 +43,7 @@ void SpeciesTransport::ReadInput(string InputFile)
     ConsoleOutput::WriteBlankLine();
     ConsoleOutput::WriteLineInsert("SpeciesTransport");
     ConsoleOutput::WriteStandard("Source", InputFile);
-    std::fstream inp(InputFile, std::ios::in);
+    std::stringstream inp = FileInterface::OpenInput(InputFile);
     if (!inp)
     {
         std::stringstream message;
@@ -52,7 +52,6 @@ void SpeciesTransport::ReadInput(string InputFile)
     };
     std::stringstream inp_data;
     inp_data << inp.rdbuf();
-    inp.close();
     int moduleLocation   = FileInterface::FindModuleLocation(inp_data, "SpeciesTransport");
     BCOrder    	         = FileInterface::ReadParameterI(inp_data, moduleLocation, std::string("BCOrder"), false, 0);
     TempBurntGas		 = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("TempBurntGas"), false, 0.0);
@@ -75,6 +74,7 @@ void SpeciesTransport::ReadInput(string InputFile)
     ZNFuelZone           = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("ZNFuelZone"), false, -10);
     IF_REACTION          = FileInterface::ReadParameterB(inp_data, moduleLocation, std::string("IF_REACTION"), false, false);
     nCoeffs    	         = FileInterface::ReadParameterI(inp_data, moduleLocation, std::string("nCoeffs"), false, 15);
+    PropertiesTolT       = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("PropertiesTolT"), false, 0.0);
 }
 
 void SpeciesTransport::Initialize(Settings& locSettings)
@@ -88,6 +88,7 @@ void SpeciesTransport::Initialize(Settings& locSettings)
     MassDiff_Species.Allocate (locSettings.Grid,{nSpecies}, Bcells);
     W_Species.Allocate (locSettings.Grid,{nSpecies}, Bcells);
     h_Species.Allocate (locSettings.Grid,{nSpecies}, Bcells);
+    PropertiesTx.Allocate (locSettings.Grid, Bcells);
     MassFractions.Allocate(locSettings.Grid,{nSpecies}, Bcells);
     MassFractionsOld.Allocate(locSettings.Grid,{nSpecies}, Bcells);    
     MolecularWeight.Allocate({nSpecies});
@@ -111,39 +112,83 @@ void SpeciesTransport::UpdateFields(EnergyTransport& ET)
 
 void SpeciesTransport::CalculateSpeciesHeatCapacitiesAndEnthalpies(EnergyTransport& ET, FlowSolverLBM& FL)
 {
-	double R = 8.314510;   // J/mol.K
+	/* NASA 7-coefficient polynomials, PolyNomCoeffs holds Tmid, the upper and
+	the lower range. The coefficients are scaled by R/Mw and stored per power
+	contiguous over the species, both ranges are evaluated in Horner form and
+	blended, which keeps the species loop free of branches and gathers */
+	const double R = 8.314510;   // J/mol.K
+	const size_t N = nSpecies;
+	vector<double> Tmid(N);
+	vector<double> cpCoeffs(10*N);   // [range*5 + power][species]
+	vector<double> hCoeffs(12*N);    // [range*6 + power][species], power 5 is the enthalpy constant
+	for (size_t ic = 0; ic < N; ic++)
+	{
+		Tmid[ic] = PolyNomCoeffs({ic,0});
+		for (size_t range = 0; range < 2; range++)
+		{
+			const size_t first = (range == 0) ? 8 : 1;
+			const double scale = R / MolecularWeight({ic});
+			for (size_t p = 0; p < 5; p++)
+			{
+				cpCoeffs[(range*5 + p)*N + ic] = PolyNomCoeffs({ic,first + p})*scale;
+				hCoeffs [(range*6 + p)*N + ic] = PolyNomCoeffs({ic,first + p})/(p + 1.0)*scale;
+			}
+			hCoeffs[(range*6 + 5)*N + ic] = PolyNomCoeffs({ic,first + 5})*scale;
+		}
+	}
+	const double* cpL = cpCoeffs.data();
+	const double* cpH = cpCoeffs.data() + 5*N;
+	const double* hL  = hCoeffs.data();
+	const double* hH  = hCoeffs.data() + 6*N;
+
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Cp_Species,Cp_Species.Bcells(),)
     {
-		if(!FL.Obstacle(i,j,k))
+		const double T = ET.Tx(i,j,k);
+		if(!FL.Obstacle(i,j,k) and !(std::abs(T - PropertiesTx(i,j,k)) <= PropertiesTolT and PropertiesTolT > 0.0))
     	{
-			double T = ET.Tx(i,j,k);
-			for (size_t ic = 0 ; ic < nSpecies; ic++)
+			PropertiesTx(i,j,k) = T;
+			double* Cp = Cp_Species(i,j,k).data();
+			double* h  = h_Species(i,j,k).data();
+			#pragma omp simd
+			for (size_t ic = 0 ; ic < N; ic++)
     		{
-				if(T < PolyNomCoeffs({ic,0}))
-				{
-					Cp_Species(i,j,k,{ic}) = (PolyNomCoeffs({ic,8}) + PolyNomCoeffs({ic,9})*T + PolyNomCoeffs({ic,10})*pow(T,2.0) 
-                                            + PolyNomCoeffs({ic,11})*pow(T,3.0) + PolyNomCoeffs({ic,12})*pow(T,4.0) ) 
-                                            * R / MolecularWeight({ic});
-					h_Species(i,j,k,{ic})  = (PolyNomCoeffs({ic,8}) + PolyNomCoeffs({ic,9})/2.0*T + PolyNomCoeffs({ic,10})/3.0*pow(T,2.0)
-                                            + PolyNomCoeffs({ic,11})/4.0*pow(T,3.0) + PolyNomCoeffs({ic,12})/5.0*pow(T,4.0) + PolyNomCoeffs({ic,13})/T) 
-                                            * R * T / MolecularWeight({ic});
-				}
-				else
-				{
-					Cp_Species(i,j,k,{ic}) = (PolyNomCoeffs({ic,1}) + PolyNomCoeffs({ic,2})*T + PolyNomCoeffs({ic,3})*pow(T,2.0) 
-                                            + PolyNomCoeffs({ic,4})*pow(T,3.0) + PolyNomCoeffs({ic,5})*pow(T,4.0) ) 
-                                            * R / MolecularWeight({ic});
-					h_Species(i,j,k,{ic})  = (PolyNomCoeffs({ic,1}) + PolyNomCoeffs({ic,2})/2.0*T + PolyNomCoeffs({ic,3})/3.0*pow(T,2.0) 
-                                            + PolyNomCoeffs({ic,4})/4.0*pow(T,3.0) + PolyNomCoeffs({ic,5})/5.0*pow(T,4.0) + PolyNomCoeffs({ic,6})/T)
-                                            * R * T / MolecularWeight({ic});
-				}
-				
+				const double CpLow  = cpL[ic] + T*(cpL[N+ic] + T*(cpL[2*N+ic] + T*(cpL[3*N+ic] + T*cpL[4*N+ic])));
+				const double CpHigh = cpH[ic] + T*(cpH[N+ic] + T*(cpH[2*N+ic] + T*(cpH[3*N+ic] + T*cpH[4*N+ic])));
+				const double hLow   = T*(hL[ic] + T*(hL[N+ic] + T*(hL[2*N+ic] + T*(hL[3*N+ic] + T*hL[4*N+ic])))) + hL[5*N+ic];
+				const double hHigh  = T*(hH[ic] + T*(hH[N+ic] + T*(hH[2*N+ic] + T*(hH[3*N+ic] + T*hH[4*N+ic])))) + hH[5*N+ic];
+				const bool Low = T < Tmid[ic];
+				Cp[ic] = Low ? CpLow : CpHigh;
+				h[ic]  = Low ? hLow  : hHigh;
     		}
 		}
 	}
     OMP_PARALLEL_STORAGE_LOOP_END
 }
 
+void SpeciesTransport::CalculateMixtureHeatCapacityAndThermalConductivity(EnergyTransport& ET, FlowSolverLBM& FL)
+{
+    size_t MixtureComp=0;
+    const size_t N = nSpecies;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ET.Cp_Mixture, ET.Cp_Mixture.Bcells(),)
+    {
+        double Cp = ET.Cp;
+        if(!FL.Obstacle(i,j,k))
+        {
+            const double* Y   = MassFractions(i,j,k).data();
+            const double* Cpk = Cp_Species(i,j,k).data();
+            Cp = 0.0;
+            #pragma omp simd reduction(+:Cp)
+            for (size_t ic = 0; ic < N; ic++)
+            {
+                Cp += Y[ic]*Cpk[ic];
+            }
+        }
+        ET.Cp_Mixture(i,j,k) = Cp;
+        ET.K_Mixture(i,j,k)  = FL.DensityWetting(i,j,k,{MixtureComp})*FL.nut(i,j,k,{MixtureComp})*Cp/ET.Pr;
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
 void SpeciesTransport::SetFreeBCNX(PhaseField& Phase, EnergyTransport& ET)
 {
     int iEnd    = Grid.Nx;
@@ -219,24 +264,6 @@ void SpeciesTransport::SetBoundaryConditions(EnergyTransport& ET, BoundaryCondit
     if (Grid.dNz > 0) BC.SetZ(MassFractions);
 }
 
-double SpeciesTransport::CalculateMeanMolarMass(const int i, const int j, const int k, string whichtime)
-{
-    double MMWi=0.0;
-    for(size_t n = 0; n < nSpecies; n++)
-    {
-        if (whichtime == "old")
-        {
-            MMWi += MassFractionsOld(i,j,k,{n}) / MolecularWeight({n});
-        }
-        if (whichtime == "new")
-        {
-            MMWi += MassFractions(i,j,k,{n}) / MolecularWeight({n});
-        }
-    }
-    double MMW=1.0/MMWi;
-    return MMW;
-}
-
 double SpeciesTransport::MoleFraction( const int i, const int j, const int k, double MMW, size_t kc)
 {
     return ( MMW/MolecularWeight({kc}) *  MassFractionsOld(i,j,k,{kc}) );
@@ -250,305 +277,89 @@ void SpeciesTransport::UpdateGhostPoints(PhaseField& Phase, EnergyTransport& ET,
 
 void SpeciesTransport::CalculateGhostPointsConjugateHeatTransfer(PhaseField& Phase, EnergyTransport& ET, FlowSolverLBM& FL, SolidBody& SB)
 {
-    size_t Gasidx = 0;
-    size_t Solididx = 1;
     double D = SB.nDist;
     double ep=1e-8;
-    
-    for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
-    if(Phase.FieldsProperties[idx].State == AggregateStates::Gas)
+    ET.GhostPoints.Update(Phase, FL, SB);
+
+    const long int nFluid = ET.GhostPoints.FluidGhosts.size();
+    #pragma omp parallel for schedule(static)
+    for(long int n = 0; n < nFluid; n++)
     {
-        Gasidx = idx;
+        const GhostPoint& GP = ET.GhostPoints.FluidGhosts[n];
+        const double X   = GP.X;
+        const double Tsi = GP.Interpolate(ET.Ts);
+        const double Ksi = GP.Interpolate(ET.K_Solid);
+        const double Tf  = ET.Tx(GP.i,GP.j,GP.k);
+        const double Kf  = ET.K_Mixture(GP.i,GP.j,GP.k);
+
+        double Tb  = (Kf/X*Tf+Ksi/D*Tsi)/(Kf/X+Ksi/D);
+        ET.Ts(GP.i,GP.j,GP.k) = Tb * (1.0+X/D) - X/D*Tsi;
     }
-    int iBC=Grid.dNx*2.0;
-    int jBC=Grid.dNy*2.0;
-    int kBC=Grid.dNz*2.0;
 
-    int idi=Grid.dNx;
-    int jdi=Grid.dNy;
-    int kdi=Grid.dNz;
-
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ET.Tx,0,)
+    const long int nSolid = ET.GhostPoints.SolidGhosts.size();
+    #pragma omp parallel for schedule(static)
+    for(long int n = 0; n < nSolid; n++)
     {
-        bool Set_TsOut=false;
-        if(!FL.Obstacle(i,j,k))
-        for(int ii = -iBC; ii <= iBC; ii++)
-        for(int jj = -jBC; jj <= jBC; jj++)
-        for(int kk = -kBC; kk <= kBC; kk++)
+        const GhostPoint& GP = ET.GhostPoints.SolidGhosts[n];
+        const double X   = GP.X;
+        const double Tfi = GP.Interpolate(ET.Tx);
+        const double Kfi = GP.Interpolate(ET.K_Mixture);
+        const double Tsi = ET.Ts(GP.i,GP.j,GP.k);
+        const double Ksi = ET.K_Solid(GP.i,GP.j,GP.k);
+
+        if(X<ep)
         {
-            if(FL.Obstacle(i+ii,j+jj,k+kk))
-            {
-                if(!Set_TsOut)
-                {
-                    dVector3 Norm{0.0,0.0,0.0};
-                    for (auto it = Phase.Fields(i,j,k).cbegin(); it != Phase.Fields(i,j,k).cend(); ++it)
-                    {
-                        if(Phase.FieldsProperties[it->index].State == AggregateStates::Solid)
-                        {
-                            Solididx=it->index;
-                            NodeAB<dVector3,dVector3> Normals=Phase.Normals(i,j,k);
-                            Norm=Normals.get_asym1(Solididx, Gasidx);
-                        }
-                    }
-                    double Phif = Phase.Fractions(i,j,k,{Gasidx});
-                    double X    = fabs(Phase.Grid.iWidth/Pi * asin(1.0-2.0*Phif));
-                    dVector3 Xf = {double(i), double(j), double(k)};
-                    dVector3 Xb = Xf - Norm*X;
-                    dVector3 Xs = Xb - Norm*D;
-                    double ic   = Xs.getX();
-                    double jc   = Xs.getY();
-                    double kc   = Xs.getZ();
-                    double i0   = floor(ic);
-                    double i1   = i0 + 1.0;
-                    double j0   = floor(jc);
-                    double j1   = j0 + 1.0;
-                    double k0   = floor(kc);
-                    double k1   = k0 + 1.0;
-
-                    double Tsi  =  SB.TrilinearInterPolation(ic,jc,kc,
-                                                          ET.Ts(i0*idi,j0*jdi,k0*kdi),ET.Ts(i1*idi,j0*jdi,k0*kdi),
-                                                          ET.Ts(i0*idi,j1*jdi,k0*kdi),ET.Ts(i1*idi,j1*jdi,k0*kdi),
-                                                          ET.Ts(i0*idi,j0*jdi,k1*kdi),ET.Ts(i1*idi,j0*jdi,k1*kdi),
-                                                          ET.Ts(i0*idi,j1*jdi,k1*kdi),ET.Ts(i1*idi,j1*jdi,k1*kdi));
-                    double Ksi  =  SB.TrilinearInterPolation(ic,jc,kc,
-                                                          ET.K_Solid(i0*idi,j0*jdi,k0*kdi),ET.K_Solid(i1*idi,j0*jdi,k0*kdi),
-                                                          ET.K_Solid(i0*idi,j1*jdi,k0*kdi),ET.K_Solid(i1*idi,j1*jdi,k0*kdi),
-                                                          ET.K_Solid(i0*idi,j0*jdi,k1*kdi),ET.K_Solid(i1*idi,j0*jdi,k1*kdi),
-                                                          ET.K_Solid(i0*idi,j1*jdi,k1*kdi),ET.K_Solid(i1*idi,j1*jdi,k1*kdi));
-                    double Tf  = ET.Tx(i,j,k);
-                    double Kf  = ET.K_Mixture(i,j,k);
-
-                    double Tb  = (Kf/X*Tf+Ksi/D*Tsi)/(Kf/X+Ksi/D);
-
-                    ET.Ts (i,j,k) = Tb * (1.0+X/D) - X/D*Tsi;
-                    Set_TsOut=true;
-                }
-            }
+            ET.Tx(GP.i,GP.j,GP.k) = Tsi;
         }
-
-        bool Set_TfOut=false;
-        if(FL.Obstacle(i,j,k))
-        for(int ii = -iBC; ii <= iBC; ii++)
-        for(int jj = -jBC; jj <= jBC; jj++)
-        for(int kk = -kBC; kk <= kBC; kk++)
+        else
         {
-            if(!FL.Obstacle(i+ii,j+jj,k+kk))
-            {
-                if(!Set_TfOut)
-                {
-                    dVector3 Norm{0.0,0.0,0.0};
-                    for (auto it = Phase.Fields(i,j,k).cbegin(); it != Phase.Fields(i,j,k).cend(); ++it)
-                    {
-                        if(Phase.FieldsProperties[it->index].State == AggregateStates::Solid)
-                        {
-                            Solididx=it->index;
-                            NodeAB<dVector3,dVector3> Normals=Phase.Normals(i,j,k);
-                            Norm=Normals.get_asym1(Solididx, Gasidx);
-                        }
-                    }
-                    double Phif = Phase.Fractions(i,j,k,{Gasidx});
-                    double X    = fabs(Phase.Grid.iWidth/Pi * asin(1.0-2.0*Phif));
-                    dVector3 Xs = {double(i), double(j), double(k)};
-                    dVector3 Xb = Xs + Norm*X;
-                    dVector3 Xf = Xb + Norm*D;
-                    double ic   = Xf.getX();
-                    double jc   = Xf.getY();
-                    double kc   = Xf.getZ();
-                    double i0   = floor(ic);
-                    double i1   = i0 + 1.0;
-                    double j0   = floor(jc);
-                    double j1   = j0 + 1.0;
-                    double k0   = floor(kc);
-                    double k1   = k0 + 1.0;
-
-                    double Tfi  = SB.TrilinearInterPolation(ic,jc,kc,
-                                                        ET.Tx(i0*idi,j0*jdi,k0*kdi),ET.Tx(i1*idi,j0*jdi,k0*kdi),
-                                                        ET.Tx(i0*idi,j1*jdi,k0*kdi),ET.Tx(i1*idi,j1*jdi,k0*kdi),
-                                                        ET.Tx(i0*idi,j0*jdi,k1*kdi),ET.Tx(i1*idi,j0*jdi,k1*kdi),
-                                                        ET.Tx(i0*idi,j1*jdi,k1*kdi),ET.Tx(i1*idi,j1*jdi,k1*kdi));
-                    double Kfi  = SB.TrilinearInterPolation(ic,jc,kc,
-                                                        ET.K_Mixture(i0*idi,j0*jdi,k0*kdi),ET.K_Mixture(i1*idi,j0*jdi,k0*kdi),
-                                                        ET.K_Mixture(i0*idi,j1*jdi,k0*kdi),ET.K_Mixture(i1*idi,j1*jdi,k0*kdi),
-                                                        ET.K_Mixture(i0*idi,j0*jdi,k1*kdi),ET.K_Mixture(i1*idi,j0*jdi,k1*kdi),
-                                                        ET.K_Mixture(i0*idi,j1*jdi,k1*kdi),ET.K_Mixture(i1*idi,j1*jdi,k1*kdi));
-                    double Tsi  = ET.Ts(i,j,k);
-                    double Ksi  = ET.K_Solid(i,j,k);
-
-                    if(X<ep)
-                    {
-                        ET.Tx (i,j,k) = Tsi;
-                    }
-                    else
-                    {
-                        double Tb   = (Kfi/D*Tfi+Ksi/X*Tsi)/(Kfi/D+Ksi/X);
-                        ET.Tx(i,j,k) =  Tb * (1.0+X/D) - X/D * Tfi;
-                    }
-
-                    double Cf[nSpecies];
-                    for (size_t isp = 0; isp < nSpecies; isp++)
-                    {
-                        Cf[isp]= SB.TrilinearInterPolation(ic,jc,kc,
-                                                        MassFractions(i0*idi,j0*jdi,k0*kdi,{isp}),MassFractions(i1*idi,j0*jdi,k0*kdi,{isp}),
-                                                        MassFractions(i0*idi,j1*jdi,k0*kdi,{isp}),MassFractions(i1*idi,j1*jdi,k0*kdi,{isp}),
-                                                        MassFractions(i0*idi,j0*jdi,k1*kdi,{isp}),MassFractions(i1*idi,j0*jdi,k1*kdi,{isp}),
-                                                        MassFractions(i0*idi,j1*jdi,k1*kdi,{isp}),MassFractions(i1*idi,j1*jdi,k1*kdi,{isp}));
-                    }
-                    for (size_t isp=0; isp<nSpecies; isp++)
-                    {
-                        MassFractions(i,j,k,{isp}) = Cf[isp] ;
-                    }
-                    Set_TfOut=true;
-                }
-            }
+            double Tb   = (Kfi/D*Tfi+Ksi/X*Tsi)/(Kfi/D+Ksi/X);
+            ET.Tx(GP.i,GP.j,GP.k) =  Tb * (1.0+X/D) - X/D * Tfi;
+        }
+        for (size_t isp = 0; isp < nSpecies; isp++)
+        {
+            MassFractions(GP.i,GP.j,GP.k,{isp}) = GP.Interpolate(MassFractions, isp);
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
 }
 
 void SpeciesTransport::CalculateGhostPoints(PhaseField& Phase, EnergyTransport& ET, FlowSolverLBM& FL, SolidBody& SB)
 {
-    size_t Gasidx = 0;
-    size_t Solididx = 1;
     double ep=1e-8;
-    double Tb=ET.TempSolid;
-    double Qb=ET.HeatFlux;
     double D = SB.nDist;
-    
-    for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
-    if(Phase.FieldsProperties[idx].State == AggregateStates::Gas)
-    {
-        Gasidx = idx;
-    }
-    int iBC=Grid.dNx*2.0;
-    int jBC=Grid.dNy*2.0;
-    int kBC=Grid.dNz*2.0;
-
-    int idi=Grid.dNx;
-    int jdi=Grid.dNy;
-    int kdi=Grid.dNz;
+    ET.GhostPoints.Update(Phase, FL, SB);
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ET.Tx,0,)
+    const long int nSolid = ET.GhostPoints.SolidGhosts.size();
+    #pragma omp parallel for schedule(static)
+    for(long int n = 0; n < nSolid; n++)
     {
-        bool Set_Tfout=false;
-        if(FL.Obstacle(i,j,k))
-        for(int ii = -iBC; ii <= iBC; ii++)
-        for(int jj = -jBC; jj <= jBC; jj++)
-        for(int kk = -kBC; kk <= kBC; kk++)
+        const GhostPoint& GP = ET.GhostPoints.SolidGhosts[n];
+        const double X  = GP.X;
+        const double Tf = GP.Interpolate(ET.Tx);
+        const double Kf = GP.Interpolate(ET.K_Mixture);
+
+        if(ET.IF_ConstTemp[GP.SolidIdx])
         {
-            if(!FL.Obstacle(i+ii,j+jj,k+kk))
+            double Tb = ET.SurfaceTemp[GP.SolidIdx];
+            if(X<ep)
             {
-                if(!Set_Tfout)
-                {
-                    dVector3 Norm{0.0,0.0,0.0};
-                    for (auto it = Phase.Fields(i,j,k).cbegin(); it != Phase.Fields(i,j,k).cend(); ++it)
-                    {
-                        if(Phase.FieldsProperties[it->index].State == AggregateStates::Solid)
-                        {
-                            Solididx=it->index;
-                            NodeAB<dVector3,dVector3> Normals=Phase.Normals(i,j,k);
-                            Norm=Normals.get_asym1(Solididx, Gasidx);
-                        }
-                    }
-                    double Phif = Phase.Fractions(i,j,k,{Gasidx});
-                    double X    = fabs(Phase.Grid.iWidth/Pi * asin(1.0-2.0*Phif));
-                    dVector3 Xs = {double(i), double(j), double(k)};
-                    dVector3 Xb = Xs + Norm*X;
-                    dVector3 Xf = Xb + Norm*D;
-                    double ic   = Xf.getX();
-                    double jc   = Xf.getY();
-                    double kc   = Xf.getZ();
-                    double i0   = floor(ic);
-                    double i1   = i0 + 1.0;
-                    double j0   = floor(jc);
-                    double j1   = j0 + 1.0;
-                    double k0   = floor(kc);
-                    double k1   = k0 + 1.0;
-                    
-                    double Tf   =  SB.TrilinearInterPolation(ic,jc,kc,
-                                                          ET.Tx(i0*idi,j0*jdi,k0*kdi),ET.Tx(i1*idi,j0*jdi,k0*kdi),
-                                                          ET.Tx(i0*idi,j1*jdi,k0*kdi),ET.Tx(i1*idi,j1*jdi,k0*kdi),
-                                                          ET.Tx(i0*idi,j0*jdi,k1*kdi),ET.Tx(i1*idi,j0*jdi,k1*kdi),
-                                                          ET.Tx(i0*idi,j1*jdi,k1*kdi),ET.Tx(i1*idi,j1*jdi,k1*kdi));
-                    double Kf   =  SB.TrilinearInterPolation(ic,jc,kc,
-                                                          ET.K_Mixture(i0*idi,j0*jdi,k0*kdi),ET.K_Mixture(i1*idi,j0*jdi,k0*kdi),
-                                                          ET.K_Mixture(i0*idi,j1*jdi,k0*kdi),ET.K_Mixture(i1*idi,j1*jdi,k0*kdi),
-                                                          ET.K_Mixture(i0*idi,j0*jdi,k1*kdi),ET.K_Mixture(i1*idi,j0*jdi,k1*kdi),
-                                                          ET.K_Mixture(i0*idi,j1*jdi,k1*kdi),ET.K_Mixture(i1*idi,j1*jdi,k1*kdi));
-                    double Cf[nSpecies];
-                    for (size_t isp = 0; isp < nSpecies; isp++)
-                    {
-                        Cf[isp]= SB.TrilinearInterPolation(ic,jc,kc,
-                                                        MassFractions(i0*idi,j0*jdi,k0*kdi,{isp}),MassFractions(i1*idi,j0*jdi,k0*kdi,{isp}),
-                                                        MassFractions(i0*idi,j1*jdi,k0*kdi,{isp}),MassFractions(i1*idi,j1*jdi,k0*kdi,{isp}),
-                                                        MassFractions(i0*idi,j0*jdi,k1*kdi,{isp}),MassFractions(i1*idi,j0*jdi,k1*kdi,{isp}),
-                                                        MassFractions(i0*idi,j1*jdi,k1*kdi,{isp}),MassFractions(i1*idi,j1*jdi,k1*kdi,{isp}));
-                    }
-
-                    //dVector3 Xf_2 = Xb + Norm*D*2.0;
-                    //double ic_2   = Xf_2.getX();
-                    //double jc_2   = Xf_2.getY();
-                    //double kc_2   = Xf_2.getZ();
-                    //double i0_2   = floor(ic_2);
-                    //double i1_2   = i0_2 + 1.0;
-                    //double j0_2   = floor(jc_2);
-                    //double j1_2   = j0_2 + 1.0;
-                    //double k0_2   = floor(kc_2);
-                    //double k1_2   = k0_2 + 1.0;
-
-//                    double Tf_2   =  SB.TrilinearInterPolation(ic_2,jc_2,kc_2,
-//                                                          ET.Tx(i0_2*idi,j0_2*jdi,k0_2*kdi),ET.Tx(i1_2*idi,j0_2*jdi,k0_2*kdi),
-//                                                          ET.Tx(i0_2*idi,j1_2*jdi,k0_2*kdi),ET.Tx(i1_2*idi,j1_2*jdi,k0_2*kdi),
-//                                                          ET.Tx(i0_2*idi,j0_2*jdi,k1_2*kdi),ET.Tx(i1_2*idi,j0_2*jdi,k1_2*kdi),
-//                                                          ET.Tx(i0_2*idi,j1_2*jdi,k1_2*kdi),ET.Tx(i1_2*idi,j1_2*jdi,k1_2*kdi));
-//                    double Kf_2   =  SB.TrilinearInterPolation(ic_2,jc_2,kc_2,
-//                                                          ET.K_Mixture(i0_2*idi,j0_2*jdi,k0_2*kdi),ET.K_Mixture(i1_2*idi,j0_2*jdi,k0_2*kdi),
-//                                                          ET.K_Mixture(i0_2*idi,j1_2*jdi,k0_2*kdi),ET.K_Mixture(i1_2*idi,j1_2*jdi,k0_2*kdi),
-//                                                          ET.K_Mixture(i0_2*idi,j0_2*jdi,k1_2*kdi),ET.K_Mixture(i1_2*idi,j0_2*jdi,k1_2*kdi),
-//                                                          ET.K_Mixture(i0_2*idi,j1_2*jdi,k1_2*kdi),ET.K_Mixture(i1_2*idi,j1_2*jdi,k1_2*kdi));
-//                    double Cf_2[nSpecies];
-//                    for (size_t isp = 0; isp < nSpecies; isp++)
-//                    {
-//                        Cf_2[isp]= SB.TrilinearInterPolation(ic_2,jc_2,kc_2,
-//                                                        MassFractions(i0_2*idi,j0_2*jdi,k0_2*kdi,{isp}),MassFractions(i1_2*idi,j0_2*jdi,k0_2*kdi,{isp}),
-//                                                        MassFractions(i0_2*idi,j1_2*jdi,k0_2*kdi,{isp}),MassFractions(i1_2*idi,j1_2*jdi,k0_2*kdi,{isp}),
-//                                                        MassFractions(i0_2*idi,j0_2*jdi,k1_2*kdi,{isp}),MassFractions(i1_2*idi,j0_2*jdi,k1_2*kdi,{isp}),
-//                                                        MassFractions(i0_2*idi,j1_2*jdi,k1_2*kdi,{isp}),MassFractions(i1_2*idi,j1_2*jdi,k1_2*kdi,{isp}));
-//                    }
-
-                    if(ET.IF_ConstTemp[Solididx])
-                    {
-                        Tb = ET.SurfaceTemp[Solididx];
-                        if(X<ep)
-                        {
-                            ET.Tx(i,j,k) = Tb;
-                        }
-                        else
-                        {
-                            ET.Tx(i,j,k) =  Tb * (1.0+X/D) - X/D * Tf;
-                        }
-
-                    }
-                    else if(ET.IF_ConstFlux[Solididx])
-                    {
-                        Qb = ET.SurfaceFlux[Solididx];
-                        ET.Tx(i,j,k) = Tf-(X+D)*Qb/Kf;
-                    }
-                    for (size_t isp=0; isp<nSpecies; isp++)
-                    {
-                        MassFractions(i,j,k,{isp}) = Cf[isp] ;
-                    }
-                    //HRR(i,j,k) = WTi;
-                    Set_Tfout = true;
-                }
+                ET.Tx(GP.i,GP.j,GP.k) = Tb;
             }
+            else
+            {
+                ET.Tx(GP.i,GP.j,GP.k) =  Tb * (1.0+X/D) - X/D * Tf;
+            }
+        }
+        else if(ET.IF_ConstFlux[GP.SolidIdx])
+        {
+            double Qb = ET.SurfaceFlux[GP.SolidIdx];
+            ET.Tx(GP.i,GP.j,GP.k) = Tf-(X+D)*Qb/Kf;
+        }
+        for (size_t isp = 0; isp < nSpecies; isp++)
+        {
+            MassFractions(GP.i,GP.j,GP.k,{isp}) = GP.Interpolate(MassFractions, isp);
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-}
-
-double SpeciesTransport::CalculatePhiVanLeer(double r)
-{
-    return (r+fabs(r))/(1.0+fabs(r));
 }
 
 void  SpeciesTransport::CalculateDiffusion(PhaseField& Phase, EnergyTransport& ET, FlowSolverLBM& FL, double dt)
@@ -556,7 +367,7 @@ void  SpeciesTransport::CalculateDiffusion(PhaseField& Phase, EnergyTransport& E
     size_t MixtureComp=0;
     std::vector<int> dir(3);
     double dx = Grid.dx;
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MassFractions,0,)
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MassFractions,0,firstprivate(dir))
     {
         if(!FL.Obstacle(i,j,k))
         {
@@ -594,11 +405,11 @@ void  SpeciesTransport::CalculateDiffusion(PhaseField& Phase, EnergyTransport& E
                 double YkVkp1[nSpecies];
                 double YkVkm1[nSpecies];
 
-                double MMWc  = CalculateMeanMolarMass(i, j, k, "old");
-                double MMWp  = CalculateMeanMolarMass(ip ,jp ,kp  ,"old");
-                double MMWpp = CalculateMeanMolarMass(ipp,jpp,kpp ,"old");
-                double MMWm  = CalculateMeanMolarMass(im ,jm ,km  ,"old");
-                double MMWmm = CalculateMeanMolarMass(imm,jmm,kmm ,"old");
+                double MMWc  = MeanMolarMass<TimeLevel::Old>(i, j, k);
+                double MMWp  = MeanMolarMass<TimeLevel::Old>(ip ,jp ,kp );
+                double MMWpp = MeanMolarMass<TimeLevel::Old>(ipp,jpp,kpp);
+                double MMWm  = MeanMolarMass<TimeLevel::Old>(im ,jm ,km );
+                double MMWmm = MeanMolarMass<TimeLevel::Old>(imm,jmm,kmm);
 
                 double YkVcc=0.0;
                 double YkVcp=0.0;
@@ -659,8 +470,8 @@ void  SpeciesTransport::CalculateDiffusion(PhaseField& Phase, EnergyTransport& E
 void SpeciesTransport::CalculateReaction(EnergyTransport& ET, FlowSolverLBM& FL, int nDim,  double dt)
 {
 	size_t MixtureComp=0;
-	FuelConsumptionRate=0.0;
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MassFractions,0,)
+	double locFuelConsumptionRate=0.0;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MassFractions,0,reduction(+:locFuelConsumptionRate))
     {
 		if(!FL.Obstacle(i,j,k))
     	{
@@ -670,10 +481,11 @@ void SpeciesTransport::CalculateReaction(EnergyTransport& ET, FlowSolverLBM& FL,
         		MassFractions(i, j, k,{ic}) += dt / FL.DensityWetting(i, j, k,{MixtureComp}) * (W_Species(i, j, k,{ic}));
     		}
     		// Compute Fuel Consumption only if species is fuel
-    		FuelConsumptionRate += abs(W_Species(i, j, k,{FuelIndex}) * pow(Grid.dx, nDim));
+    		locFuelConsumptionRate += abs(W_Species(i, j, k,{FuelIndex}) * pow(Grid.dx, nDim));
 		}
 	}
     OMP_PARALLEL_STORAGE_LOOP_END
+	FuelConsumptionRate = locFuelConsumptionRate;
 	#ifdef MPI_PARALLEL
     	OP_MPI_Allreduce(OP_MPI_IN_PLACE, &FuelConsumptionRate, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
 	#endif
@@ -684,7 +496,7 @@ void SpeciesTransport::CalculateAdvection(EnergyTransport& ET, FlowSolverLBM& FL
     std::vector<int> dir(3);
     double eps=1e-10;
     double dx = Grid.dx;
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MassFractions,0,)
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MassFractions,0,firstprivate(dir))
     {	
         if(!FL.Obstacle(i,j,k))
         {
@@ -806,6 +618,127 @@ void SpeciesTransport::CalculateAdvection(EnergyTransport& ET, FlowSolverLBM& FL
     OMP_PARALLEL_STORAGE_LOOP_END
 } 
 
+void SpeciesTransport::CalculateAdvectionDiffusion(EnergyTransport& ET, FlowSolverLBM& FL, FlowMixture& FM, double dt)
+{
+    /* Same increments as CalculateAdvection() followed by CalculateDiffusion(),
+    both read only the old time level. The stencil of all species is fetched
+    once per direction and the species loops run over contiguous memory */
+    const size_t MixtureComp = 0;
+    const size_t N   = nSpecies;
+    const double dx  = Grid.dx;
+    const double eps = 1e-10;
+    const int dN[3]  = {Grid.dNx, Grid.dNy, Grid.dNz};
+
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,MassFractions,0,)
+    {
+        if(!FL.Obstacle(i,j,k))
+        {
+            const double Tc   = ET.TxOld(i,j,k);
+            const double Rhoc = FL.DensityWetting(i,j,k,{MixtureComp});
+            const double cpc  = ET.Cp_Mixture(i,j,k);
+            const double ktc  = ET.K_Mixture(i,j,k);
+
+            const double* Yc  = MassFractionsOld(i,j,k).data();
+            const double* Dc  = MassDiff_Species(i,j,k).data();
+            const double* Cpc = Cp_Species(i,j,k).data();
+            double* Y = MassFractions(i,j,k).data();
+
+            double dT = 0.0;
+            for(int direction = 0; direction < 3; ++direction)
+            {
+                if(dN[direction] == 0) continue;
+                const int di = (direction == 0) ? dN[0] : 0;
+                const int dj = (direction == 1) ? dN[1] : 0;
+                const int dk = (direction == 2) ? dN[2] : 0;
+
+                const double Tp  = ET.TxOld(i+di,j+dj,k+dk);
+                const double Tm  = ET.TxOld(i-di,j-dj,k-dk);
+                const double Vc  = FM.V_Mixture(i,j,k)[direction];
+                const double* Yp  = MassFractionsOld(i+di,j+dj,k+dk).data();
+                const double* Ym  = MassFractionsOld(i-di,j-dj,k-dk).data();
+                const double* Ypp = MassFractionsOld(i+2*di,j+2*dj,k+2*dk).data();
+                const double* Ymm = MassFractionsOld(i-2*di,j-2*dj,k-2*dk).data();
+
+                /* Advection */
+                if(AdvectionUpwind)
+                {
+                    const double* Yu = (Vc >= 0) ? Ym : Yc;
+                    const double* Yd = (Vc >= 0) ? Yc : Yp;
+                    dT -= dt/dx * Vc * ((Vc >= 0) ? Tc-Tm : Tp-Tc);
+                    #pragma omp simd
+                    for(size_t n = 0; n < N; n++)
+                    {
+                        Y[n] -= dt/dx * Vc * (Yd[n]-Yu[n]);
+                    }
+                }
+                else if(AdvectionVanLeer)
+                {
+                    if(Vc >= 0)
+                    {
+                        const double Tmm = ET.TxOld(i-2*di,j-2*dj,k-2*dk);
+                        const double Thp = Tc + 0.5*CalculatePhiVanLeer((Tc-Tm)/(Tp-Tc+eps))*(Tp-Tc);
+                        const double Thm = Tm + 0.5*CalculatePhiVanLeer((Tm-Tmm)/(Tc-Tm+eps))*(Tc-Tm);
+                        dT -= dt*Vc*(Thp-Thm)/dx;
+                        #pragma omp simd
+                        for(size_t n = 0; n < N; n++)
+                        {
+                            const double Chp = Yc[n] + 0.5*CalculatePhiVanLeer((Yc[n]-Ym[n])/(Yp[n]-Yc[n]+eps))*(Yp[n]-Yc[n]);
+                            const double Chm = Ym[n] + 0.5*CalculatePhiVanLeer((Ym[n]-Ymm[n])/(Yc[n]-Ym[n]+eps))*(Yc[n]-Ym[n]);
+                            Y[n] -= dt*Vc*(Chp-Chm)/dx;
+                        }
+                    }
+                    else
+                    {
+                        const double Tpp = ET.TxOld(i+2*di,j+2*dj,k+2*dk);
+                        const double Thp = Tp - 0.5*CalculatePhiVanLeer((Tpp-Tp)/(Tp-Tc+eps))*(Tp-Tc);
+                        const double Thm = Tc - 0.5*CalculatePhiVanLeer((Tp-Tc)/(Tc-Tm+eps))*(Tc-Tm);
+                        dT -= dt*Vc*(Thp-Thm)/dx;
+                        #pragma omp simd
+                        for(size_t n = 0; n < N; n++)
+                        {
+                            const double Chp = Yp[n] - 0.5*CalculatePhiVanLeer((Ypp[n]-Yp[n])/(Yp[n]-Yc[n]+eps))*(Yp[n]-Yc[n]);
+                            const double Chm = Yc[n] - 0.5*CalculatePhiVanLeer((Yp[n]-Yc[n])/(Yc[n]-Ym[n]+eps))*(Yc[n]-Ym[n]);
+                            Y[n] -= dt*Vc*(Chp-Chm)/dx;
+                        }
+                    }
+                }
+                else if(AdvectionCentral)
+                {
+                    dT -= dt/dx * Vc * (Tp-Tm)/2.0;
+                    #pragma omp simd
+                    for(size_t n = 0; n < N; n++)
+                    {
+                        Y[n] -= dt/dx * Vc * (Yp[n]-Ym[n])/2.0;
+                    }
+                }
+
+                /* Diffusion */
+                const double ktp  = ET.K_Mixture(i+di,j+dj,k+dk);
+                const double ktm  = ET.K_Mixture(i-di,j-dj,k-dk);
+                const double Rhop = FL.DensityWetting(i+di,j+dj,k+dk,{MixtureComp});
+                const double Rhom = FL.DensityWetting(i-di,j-dj,k-dk,{MixtureComp});
+                const double* Dp  = MassDiff_Species(i+di,j+dj,k+dk).data();
+                const double* Dm  = MassDiff_Species(i-di,j-dj,k-dk).data();
+
+                dT += dt/(Rhoc*cpc) * (ktc * (Tp+Tm-2.0*Tc)/dx/dx + (ktp-ktm)/dx/2.0 * (Tp-Tm)/dx/2.0);
+                double EnthalpyFlux = 0.0;
+                #pragma omp simd reduction(+:EnthalpyFlux)
+                for(size_t n = 0; n < N; n++)
+                {
+                    const double YkVkc = - Dc[n]*(Yp[n]-Ym[n])/dx/2.0;
+                    const double YkVkp = - Dp[n]*(Ypp[n]-Yc[n])/dx/2.0;
+                    const double YkVkm = - Dm[n]*(Yc[n]-Ymm[n])/dx/2.0;
+                    EnthalpyFlux += Cpc[n]*YkVkc;
+                    Y[n] -= dt/Rhoc * (Rhop*YkVkp - Rhom*YkVkm)/dx/2.0;
+                }
+                dT -= dt/cpc * EnthalpyFlux * (Tp-Tm)/dx/2.0;
+            }
+            ET.Tx(i,j,k) += dT;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+}
+
 void SpeciesTransport::WriteVTKMassFractions(Settings& locSettings, const int tStep, const int precision)
 {
     std::vector<VTK::Field_t> ListOfFields;
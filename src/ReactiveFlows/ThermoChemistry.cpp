@@ -35,7 +35,7 @@ void ThermoChemistry::ReadInput(string InputFile)
 	ConsoleOutput::WriteBlankLine();
 	ConsoleOutput::WriteLineInsert("ThermoChemistry");
 	ConsoleOutput::WriteStandard("Source", InputFile);
-	std::fstream inp(InputFile, std::ios::in);
+	std::stringstream inp = FileInterface::OpenInput(InputFile);
 	if (!inp)
 	{
 	    std::stringstream message;
@@ -44,7 +44,6 @@ void ThermoChemistry::ReadInput(string InputFile)
 	};
 	std::stringstream inp_data;
 	inp_data << inp.rdbuf();
-	inp.close();
 	int moduleLocation   = FileInterface::FindModuleLocation(inp_data, "ThermoChemistry");
 	ReactionMechanism    = FileInterface::ReadParameterS(inp_data, moduleLocation, std::string("ReactionMechanism"),false,"CH4_BFER.yaml");
 	PhaseName   		 = FileInterface::ReadParameterS(inp_data, moduleLocation, std::string("PhaseName"),false,"CH4_BFER_mix");
@@ -53,6 +52,79 @@ void ThermoChemistry::ReadInput(string InputFile)
 	Oxidizer   		     = FileInterface::ReadParameterS(inp_data, moduleLocation, std::string("Oxidizer"),false,"air");
 	ER        			 = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("EquivRatio"), false, 1.0);
 	nPhases        		 = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("nPhases"), false, 1.0);
+	ReactionTable        = FileInterface::ReadParameterB(inp_data, moduleLocation, std::string("ReactionTable"), false, false);
+	TableTolT            = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("TableTolT"), false, 1.0);
+	TableTolY            = FileInterface::ReadParameterD(inp_data, moduleLocation, std::string("TableTolY"), false, 1.0e-4);
+	TableSize            = FileInterface::ReadParameterI(inp_data, moduleLocation, std::string("TableSize"), false, 100000);
+	ChemistrySubsteps    = FileInterface::ReadParameterI(inp_data, moduleLocation, std::string("ChemistrySubsteps"), false, 1);
+	if(ChemistrySubsteps < 1 or TableTolT <= 0.0 or TableTolY <= 0.0)
+	{
+		ConsoleOutput::WriteExit("ChemistrySubsteps, TableTolT and TableTolY have to be positive", "ThermoChemistry", "ReadInput()");
+		OP_Exit(EXIT_FAILURE);
+	}
+}
+
+void ThermoChemistry::PrepareWorkspaces(const double Pressure)
+{
+	/* Parsing the mechanism is not thread-safe either, the objects are
+	created serially */
+	if(Workspaces.size() != size_t(omp_get_max_threads()))
+	{
+		Workspaces.resize(omp_get_max_threads());
+		for(auto& WS : Workspaces)
+		{
+			WS.Solution  = Cantera::newSolution(ReactionMechanism, PhaseName, TransportName);
+			WS.Gas       = WS.Solution->thermo();
+			WS.Transport = WS.Solution->transport();
+			WS.Kinetics  = WS.Solution->kinetics();
+			WS.Bucket.resize(WS.Gas->nSpecies() + 1);
+			WS.Table.clear();
+		}
+	}
+	if(Pressure != TablePressure)
+	{
+		for(auto& WS : Workspaces) WS.Table.clear();
+		TablePressure = Pressure;
+	}
+}
+
+void ThermoChemistry::NetProductionRates(ChemistryWorkspace& WS, const double Temp,
+				const double* Y, double* W) const
+{
+	const size_t nSp = WS.Gas->nSpecies();
+	size_t Hash = 0;
+	if(ReactionTable)
+	{
+		WS.Bucket[0] = lround(Temp/TableTolT);
+		for(size_t ic = 0; ic < nSp; ic++)
+		{
+			WS.Bucket[ic+1] = lround(Y[ic]/TableTolY);
+		}
+		for(long b : WS.Bucket)
+		{
+			Hash ^= std::hash<long>()(b) + 0x9e3779b97f4a7c15ULL + (Hash << 6) + (Hash >> 2);
+		}
+		auto it = WS.Table.find(Hash);
+		if(it != WS.Table.end() and it->second.Bucket == WS.Bucket)
+		{
+			copy(it->second.Rates.begin(), it->second.Rates.end(), W);
+			return;
+		}
+	}
+
+	WS.Kinetics->getNetProductionRates(W); //kmol/m^3/s
+	for (size_t ic = 0; ic < nSp; ic++)
+	{
+		W[ic] *= MW[ic];
+	}
+
+	if(ReactionTable)
+	{
+		if(WS.Table.size() >= TableSize) WS.Table.clear();
+		ReactionTableEntry& Entry = WS.Table[Hash];
+		Entry.Bucket = WS.Bucket;
+		Entry.Rates.assign(W, W + nSp);
+	}
 }
 
 vector<double> ThermoChemistry::GettingFuelMixture(std::shared_ptr<Cantera::ThermoPhase> & gas, string FuelName, string Oxidizer, double ER)
@@ -77,27 +149,25 @@ vector<double> ThermoChemistry::GettingFuelMixture(std::shared_ptr<Cantera::Ther
 void ThermoChemistry::UpdateProperties(EnergyTransport& ET, SpeciesTransport& ST, FlowSolverLBM& FL,
 				shared_ptr<Cantera::ThermoPhase> &gas, shared_ptr<Cantera::Transport> &transp, shared_ptr<Cantera::Kinetics> &kin) 
 {
-	//double R = 8.314462618; // J/(mol*K)
-	//size_t nr = kin->nReactions();
+	/* The shared objects are not thread-safe, the per thread copies are used */
+	(void) gas; (void) transp; (void) kin; //unused
 	size_t MixtureComp=0;
+	PrepareWorkspaces(FL.Pth);
 
 	OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ET.Tx, ET.Tx.Bcells(),)
     {
 		if(!FL.Obstacle(i,j,k))
     	{
-			gas->setState_TPY(ET.Tx(i,j,k), FL.Pth, ST.MassFractions(i,j,k).data());
-			FL.DensityWetting(i,j,k)({MixtureComp})=gas->density();
-			FL.nut(i,j,k)({MixtureComp})=transp->viscosity()/FL.DensityWetting(i,j,k)({MixtureComp});
-			ET.Cp_Mixture(i,j,k)=gas->cp_mass();
-			ET.K_Mixture(i,j,k)=transp->thermalConductivity();
+			ChemistryWorkspace& WS = Workspaces[omp_get_thread_num()];
+			WS.Gas->setState_TPY(ET.Tx(i,j,k), FL.Pth, ST.MassFractions(i,j,k).data());
+			FL.DensityWetting(i,j,k)({MixtureComp})=WS.Gas->density();
+			FL.nut(i,j,k)({MixtureComp})=WS.Transport->viscosity()/FL.DensityWetting(i,j,k)({MixtureComp});
+			ET.Cp_Mixture(i,j,k)=WS.Gas->cp_mass();
+			ET.K_Mixture(i,j,k)=WS.Transport->thermalConductivity();
 			if(ST.Species)
 			{
-				transp->getMixDiffCoeffsMass(ST.MassDiff_Species(i,j,k).data());
-				kin->getNetProductionRates(ST.W_Species(i,j,k).data()); //kmol/m^3/s
-				for (size_t ic = 0; ic < ST.nSpecies; ic++)
-				{
-            		ST.W_Species(i,j,k)({ic}) *= (1000.0*ST.MolecularWeight({ic}));
-				}
+				WS.Transport->getMixDiffCoeffsMass(ST.MassDiff_Species(i,j,k).data());
+				NetProductionRates(WS, ET.Tx(i,j,k), ST.MassFractions(i,j,k).data(), ST.W_Species(i,j,k).data());
 
 	        	ST.HRR(i,j,k) = 0.0;
 				for (size_t ic = 0; ic < ST.nSpecies; ic++)
@@ -113,30 +183,31 @@ void ThermoChemistry::UpdateProperties(EnergyTransport& ET, SpeciesTransport& ST
 void ThermoChemistry::UpdateAllProperties(EnergyTransport& ET, SpeciesTransport& ST, FlowSolverLBM& FL,
 				shared_ptr<Cantera::ThermoPhase> &gas, shared_ptr<Cantera::Transport> &transp, shared_ptr<Cantera::Kinetics> &kin) 
 {
-	//double R = 8.314462618; // J/(mol*K)
-	//size_t nr = kin->nReactions();
+	/* The shared objects are not thread-safe, the per thread copies are used */
+	(void) gas; (void) transp; (void) kin; //unused
 	size_t MixtureComp=0;
+	PrepareWorkspaces(FL.Pth);
 
 	OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ET.Tx, ET.Tx.Bcells(),)
     {
 		if(!FL.Obstacle(i,j,k))
     	{
-			gas->setState_TPY(ET.Tx(i,j,k), FL.Pth, ST.MassFractions(i,j,k).data());
-			FL.DensityWetting(i,j,k)({MixtureComp})=gas->density();
-			FL.nut(i,j,k)({MixtureComp})=transp->viscosity()/FL.DensityWetting(i,j,k)({MixtureComp});
-			ET.Cp_Mixture(i,j,k)=gas->cp_mass();
-			ET.K_Mixture(i,j,k)=transp->thermalConductivity();
+			ChemistryWorkspace& WS = Workspaces[omp_get_thread_num()];
+			WS.Gas->setState_TPY(ET.Tx(i,j,k), FL.Pth, ST.MassFractions(i,j,k).data());
+			FL.DensityWetting(i,j,k)({MixtureComp})=WS.Gas->density();
+			FL.nut(i,j,k)({MixtureComp})=WS.Transport->viscosity()/FL.DensityWetting(i,j,k)({MixtureComp});
+			ET.Cp_Mixture(i,j,k)=WS.Gas->cp_mass();
+			ET.K_Mixture(i,j,k)=WS.Transport->thermalConductivity();
 			if(ST.Species)
 			{
-				gas->getPartialMolarCp(ST.Cp_Species(i,j,k).data());
-				transp->getMixDiffCoeffsMass(ST.MassDiff_Species(i,j,k).data());
-				kin->getNetProductionRates(ST.W_Species(i,j,k).data()); //kmol/m^3/s
+				WS.Gas->getPartialMolarCp(ST.Cp_Species(i,j,k).data());
+				WS.Transport->getMixDiffCoeffsMass(ST.MassDiff_Species(i,j,k).data());
+				NetProductionRates(WS, ET.Tx(i,j,k), ST.MassFractions(i,j,k).data(), ST.W_Species(i,j,k).data());
 
 				std::vector<double> h(ST.nSpecies);
-				gas->getPartialMolarEnthalpies(h.data());
+				WS.Gas->getPartialMolarEnthalpies(h.data());
 				for (size_t ic = 0; ic < ST.nSpecies; ic++)
 				{
-            		ST.W_Species(i,j,k)({ic}) *= (1000.0*ST.MolecularWeight({ic}));
             		ST.Cp_Species(i,j,k)({ic}) /= (1000.0*ST.MolecularWeight({ic}));
 					h[ic] /= (1000.0*ST.MolecularWeight({ic}));
 				}
@@ -153,6 +224,58 @@ void ThermoChemistry::UpdateAllProperties(EnergyTransport& ET, SpeciesTransport&
 	OMP_PARALLEL_STORAGE_LOOP_END
 }
 
+void ThermoChemistry::IntegrateReactions(EnergyTransport& ET, SpeciesTransport& ST, FlowSolverLBM& FL,
+				int nDim, double dt)
+{
+	PrepareWorkspaces(FL.Pth);
+	const double dtSub = dt/ChemistrySubsteps;
+	double FuelConsumptionRate = 0.0;
+
+	OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,ST.MassFractions,0,reduction(+:FuelConsumptionRate))
+    {
+		if(!FL.Obstacle(i,j,k))
+    	{
+			ChemistryWorkspace& WS = Workspaces[omp_get_thread_num()];
+			double* Y = ST.MassFractions(i,j,k).data();
+			double* W = ST.W_Species(i,j,k).data();
+			vector<double> locW(ST.nSpecies);
+			vector<double> h(ST.nSpecies);
+			for (size_t ic = 0; ic < ST.nSpecies; ic++) W[ic] = 0.0;
+			ST.HRR(i,j,k) = 0.0;
+
+			/* Constant pressure substeps, the state and the rates are updated
+			after each substep. The mean rates are stored for the output */
+			for(int s = 0; s < ChemistrySubsteps; s++)
+			{
+				WS.Gas->setState_TPY(ET.Tx(i,j,k), FL.Pth, Y);
+				const double Rho = WS.Gas->density();
+				const double Cp  = WS.Gas->cp_mass();
+				NetProductionRates(WS, ET.Tx(i,j,k), Y, locW.data());
+				WS.Gas->getPartialMolarEnthalpies(h.data()); //J/kmol
+
+				double locHRR = 0.0;
+				double Ysum = 0.0;
+				for (size_t ic = 0; ic < ST.nSpecies; ic++)
+				{
+					locHRR -= h[ic]/MW[ic]*locW[ic];
+					Y[ic] = max(0.0, Y[ic] + dtSub/Rho*locW[ic]);
+					Ysum += Y[ic];
+					W[ic] += locW[ic]/ChemistrySubsteps;
+				}
+				for (size_t ic = 0; ic < ST.nSpecies; ic++) Y[ic] /= Ysum;
+				ET.Tx(i,j,k) += dtSub/(Rho*Cp)*locHRR;
+				ST.HRR(i,j,k) += locHRR/ChemistrySubsteps;
+			}
+			FuelConsumptionRate += abs(W[ST.FuelIndex] * pow(ST.Grid.dx, nDim));
+		}
+	}
+	OMP_PARALLEL_STORAGE_LOOP_END
+	#ifdef MPI_PARALLEL
+    	OP_MPI_Allreduce(OP_MPI_IN_PLACE, &FuelConsumptionRate, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+	#endif
+	ST.FuelConsumptionRate = FuelConsumptionRate;
+}
+
 vector<vector<double>> ThermoChemistry::GettingSpeciesPolyConstants(std::shared_ptr<Cantera::ThermoPhase> & gas)
 {
 	vector<vector<double>> speciesdata;
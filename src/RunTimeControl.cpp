@@ -26,6 +26,7 @@
 
 #include "RunTimeControl.h"
 #include "Settings.h"
+#include "Tools/TimeInfo.h"
 
 namespace openphase
 {
@@ -55,6 +56,14 @@ void RunTimeControl::Initialize(Settings& locSettings, std::string ObjectNameSuf
     CheckTime = mygettime();
     StopTrigger = false;
 
+    AdaptiveTimeStep      = false;
+    dtMin                 = 0.0;
+    dtMax                 = DBL_MAX;
+    dtSafetyFactor        = 0.9;
+    dtGrowthFactor        = 1.1;
+    dtLimit               = DBL_MAX;
+    MaxSubsteps           = 1000;
+
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
 }
 
@@ -66,7 +75,7 @@ void RunTimeControl::ReadInput(const string InputFileName)
     std::string filetype = FileInterface::getFileExtension(InputFileName); 
 	if (filetype == "opi")
 	{
-		fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+		stringstream inp = FileInterface::OpenInput(InputFileName);
 
 		if (!inp)
 		{
@@ -77,8 +86,6 @@ void RunTimeControl::ReadInput(const string InputFileName)
 		std::stringstream data;
 		data << inp.rdbuf();
 		ReadInput(data);
-
-		inp.close();
 	}
 	else
 	if (filetype == "json")
@@ -130,6 +137,36 @@ void RunTimeControl::ReadInput(stringstream& inp)
     LogScreenFactor       = FileInterface::ReadParameterI(inp, moduleLocation, string("LogScreenF"), false, 1);
     LogVTKFactor          = FileInterface::ReadParameterI(inp, moduleLocation, string("LogVTKF"),    false, 1);
 
+    AdaptiveTimeStep      = FileInterface::ReadParameterB(inp, moduleLocation, string("AdaptiveTimeStep"), false, false);
+    if(AdaptiveTimeStep)
+    {
+        dtMin             = FileInterface::ReadParameterD(inp, moduleLocation, string("dtMin"), false, 0.0);
+        dtMax             = FileInterface::ReadParameterD(inp, moduleLocation, string("dtMax"), false, DBL_MAX);
+        dtSafetyFactor    = FileInterface::ReadParameterD(inp, moduleLocation, string("dtSafety"), false, 0.9);
+        dtGrowthFactor    = FileInterface::ReadParameterD(inp, moduleLocation, string("dtGrowth"), false, 1.1);
+        if(dtMin > dtMax)
+        {
+            ConsoleOutput::WriteExit("dtMin = " + std::to_string(dtMin) + " exceeds dtMax = " + std::to_string(dtMax), thisclassname, "ReadInput()");
+            OP_Exit(EXIT_FAILURE);
+        }
+    }
+    MaxSubsteps           = FileInterface::ReadParameterI(inp, moduleLocation, string("MaxSubsteps"), false, 1000);
+
+    // Periodic memory sampling (optional, 0 disables the sampling or the warning)
+    const int    MemoryInterval = FileInterface::ReadParameterI(inp, moduleLocation, string("MemoryInterval"), false, 0);
+    const double MemoryWarning  = FileInterface::ReadParameterD(inp, moduleLocation, string("MemoryWarning"), false, 0.0);
+    Memory.Initialize(TextDir + "MemoryUsage.dat", MemoryInterval, MemoryWarning, RestartSwitch);
+
+    // Timeline trace (optional, events per thread, 0 disables the trace)
+    const int TraceEvents = FileInterface::ReadParameterI(inp, moduleLocation, string("TraceEvents"), false, 0);
+    TimeInfo::StartTrace(max(TraceEvents, 0), TextDir + "Trace.json");
+
+    // Status file for batch schedulers (optional, 0 disables the status file)
+    const int StatusInterval = FileInterface::ReadParameterI(inp, moduleLocation, string("StatusInterval"), false, 0);
+    const int StatusWindow   = FileInterface::ReadParameterI(inp, moduleLocation, string("StatusWindow"), false, 10);
+    const string StatusCommand = FileInterface::ReadParameterF(inp, moduleLocation, string("StatusCommand"), false, "");
+    Status.Initialize(TextDir + "Status.json", SimulationTitle, StatusInterval, StatusWindow, StatusCommand);
+
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteLine();
 
@@ -144,19 +181,22 @@ void RunTimeControl::ReadInput(stringstream& inp)
         ConsoleOutputInterval = 1;
     }
 
-    if (std::filesystem::create_directories(VTKDir))
+    if (not Embedded::Active())
     {
-        ConsoleOutput::WriteStandard("Created directory", VTKDir);
-    }
-
-    if (std::filesystem::create_directories(RawDataDir))
-    {
-        ConsoleOutput::WriteStandard("Created directory", RawDataDir);
-    }
-
-    if (std::filesystem::create_directories(TextDir))
-    {
-        ConsoleOutput::WriteStandard("Created directory", TextDir);
+        if (std::filesystem::create_directories(VTKDir))
+        {
+            ConsoleOutput::WriteStandard("Created directory", VTKDir);
+        }
+
+        if (std::filesystem::create_directories(RawDataDir))
+        {
+            ConsoleOutput::WriteStandard("Created directory", RawDataDir);
+        }
+
+        if (std::filesystem::create_directories(TextDir))
+        {
+            ConsoleOutput::WriteStandard("Created directory", TextDir);
+        }
     }
 
     ConsoleOutput::WriteLine();
@@ -166,7 +206,7 @@ void RunTimeControl::ReadInput(stringstream& inp)
 void RunTimeControl::ReadJSON(const string InputFileName)
 {
 
-	std::ifstream f(InputFileName);
+	std::stringstream f = FileInterface::OpenInput(InputFileName);
 	json data = json::parse(f);
 	if (data.contains(thisclassname))
 	{
@@ -206,6 +246,31 @@ void RunTimeControl::ReadJSON(const string InputFileName)
 		LogScreenFactor       = FileInterface::ReadParameter<double>(RTC, {"LogScreenF"}, 1);
 		LogVTKFactor          = FileInterface::ReadParameter<double>(RTC, {"LogVTKF"}, 1);
 
+		AdaptiveTimeStep      = FileInterface::ReadParameter<bool>(RTC, {"AdaptiveTimeStep"}, false);
+		dtMin                 = FileInterface::ReadParameter<double>(RTC, {"dtMin"}, 0.0);
+		dtMax                 = FileInterface::ReadParameter<double>(RTC, {"dtMax"}, DBL_MAX);
+		dtSafetyFactor        = FileInterface::ReadParameter<double>(RTC, {"dtSafety"}, 0.9);
+		dtGrowthFactor        = FileInterface::ReadParameter<double>(RTC, {"dtGrowth"}, 1.1);
+		if(dtMin > dtMax)
+		{
+		    ConsoleOutput::WriteExit("dtMin = " + std::to_string(dtMin) + " exceeds dtMax = " + std::to_string(dtMax), thisclassname, "ReadJSON()");
+		    OP_Exit(EXIT_FAILURE);
+		}
+		MaxSubsteps           = FileInterface::ReadParameter<int>(RTC, {"MaxSubsteps"}, 1000);
+
+		Memory.Initialize(TextDir + "MemoryUsage.dat",
+		                  FileInterface::ReadParameter<int>(RTC, {"MemoryInterval"}, 0),
+		                  FileInterface::ReadParameter<double>(RTC, {"MemoryWarning"}, 0.0),
+		                  RestartSwitch);
+
+		TimeInfo::StartTrace(max(FileInterface::ReadParameter<int>(RTC, {"TraceEvents"}, 0), 0),
+		                     TextDir + "Trace.json");
+
+		Status.Initialize(TextDir + "Status.json", SimulationTitle,
+		                  FileInterface::ReadParameter<int>(RTC, {"StatusInterval"}, 0),
+		                  FileInterface::ReadParameter<int>(RTC, {"StatusWindow"}, 10),
+		                  FileInterface::ReadParameter<std::string>(RTC, {"StatusCommand"}, ""));
+
 		ConsoleOutput::WriteLine();
 		ConsoleOutput::WriteLine();
 
@@ -220,19 +285,22 @@ void RunTimeControl::ReadJSON(const string InputFileName)
 		    ConsoleOutputInterval = 1;
 		}
 
-		if (std::filesystem::create_directories(VTKDir))
-		{
-		    ConsoleOutput::WriteStandard("Created directory", VTKDir);
-		}
-
-		if (std::filesystem::create_directories(RawDataDir))
+		if (not Embedded::Active())
 		{
-		    ConsoleOutput::WriteStandard("Created directory", RawDataDir);
-		}
-
-		if (std::filesystem::create_directories(TextDir))
-		{
-		    ConsoleOutput::WriteStandard("Created directory", TextDir);
+		    if (std::filesystem::create_directories(VTKDir))
+		    {
+		        ConsoleOutput::WriteStandard("Created directory", VTKDir);
+		    }
+
+		    if (std::filesystem::create_directories(RawDataDir))
+		    {
+		        ConsoleOutput::WriteStandard("Created directory", RawDataDir);
+		    }
+
+		    if (std::filesystem::create_directories(TextDir))
+		    {
+		        ConsoleOutput::WriteStandard("Created directory", TextDir);
+		    }
 		}
 	}
     ConsoleOutput::WriteLine();
@@ -263,10 +331,25 @@ RunTimeControl& RunTimeControl::operator= (const RunTimeControl& rhs)
         CheckpointInterval    = rhs.CheckpointInterval;
         OpenMPThreads         = rhs.OpenMPThreads;
 
+        AdaptiveTimeStep      = rhs.AdaptiveTimeStep;
+        dtMin                 = rhs.dtMin;
+        dtMax                 = rhs.dtMax;
+        dtSafetyFactor        = rhs.dtSafetyFactor;
+        dtGrowthFactor        = rhs.dtGrowthFactor;
+        dtLimit               = rhs.dtLimit;
+        dtLimitSource         = rhs.dtLimitSource;
+        SubcycledModules      = rhs.SubcycledModules;
+        MaxSubsteps           = rhs.MaxSubsteps;
+
         VTKDir                = rhs.VTKDir;
         RawDataDir            = rhs.RawDataDir;
         TextDir               = rhs.TextDir;
 
+        Memory.Initialize(rhs.Memory.FileName, rhs.Memory.Interval,
+                          rhs.Memory.WarningThreshold, rhs.RestartSwitch);
+        Status.Initialize(rhs.Status.FileName, rhs.Status.Title, rhs.Status.Interval,
+                          rhs.Status.Window, rhs.Status.Command);
+
 #ifdef _OPENMP
         omp_set_num_threads(OpenMPThreads);
 #endif
@@ -280,15 +363,109 @@ void RunTimeControl::Write()
 #endif
     {
         std::ofstream outp(RawDataDir + thisobjectname + ".dat");
-        outp << TimeStep << std::flush;
+        outp << TimeStep;
+        if (AdaptiveTimeStep)
+        {
+            // The adapted time step and the simulation time are needed for a restart
+            outp << " " << std::setprecision(17) << dt << " " << SimulationTime;
+        }
+        outp << std::flush;
     }
 }
+bool RunTimeControl::RestoreCheckpoint(Settings& locSettings, const BoundaryConditions& BC)
+{
+    if(not RestartSwitch) return false;
+
+    myclock_t Start = mygettime();
+    if(not locSettings.ReadAll(BC, StartTimeStep))
+    {
+        ConsoleOutput::WriteExit("Restart data of time step " + std::to_string(StartTimeStep) +
+                                 " could not be read", thisclassname, "RestoreCheckpoint()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    double Elapsed = double(mygettime() - Start)/OP_CLOCKS_PER_SEC;
+    ConsoleOutput::WriteStandard("Restart from time step", std::to_string(StartTimeStep));
+    ConsoleOutput::WriteStandard("Restart data read in [s]", std::to_string(Elapsed));
+    return true;
+}
+
+double RunTimeControl::AdaptTimeStep(void)
+{
+    /* The new time step is the given fraction of the smallest reported limit.
+    It decreases immediately, but grows by at most dtGrowthFactor per time step.
+    Without reported limits the time step grows towards dtMax.*/
+    double locLimit = dtLimit;
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &locLimit, 1, OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+#endif
+    double new_dt = dtGrowthFactor*dt;
+    if (locLimit < DBL_MAX)
+    {
+        new_dt = std::min(new_dt, dtSafetyFactor*locLimit);
+    }
+    if (new_dt < dtMin)
+    {
+        std::stringstream message;
+        message << "Time step limit " << dtSafetyFactor*locLimit;
+        if (not dtLimitSource.empty()) message << " (" << dtLimitSource << ")";
+        message << " is below dtMin = " << dtMin << ", using dtMin";
+        ConsoleOutput::WriteWarning(message.str(), thisclassname, "AdaptTimeStep()");
+    }
+    dt = std::clamp(new_dt, dtMin, dtMax);
+
+    dtLimit = DBL_MAX;
+    dtLimitSource.clear();
+    return dt;
+}
+
+int RunTimeControl::SetModuleTimeStep(const std::string Module, const double dtStable)
+{
+    /* All ranks have to do the same number of substeps */
+    double locStable = dtStable;
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &locStable, 1, OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+#endif
+    SubcycledModule& locModule = SubcycledModules[Module];
+    locModule.dtStable = locStable;
+
+    int locSubsteps = 1;
+    if (locStable > 0.0 and locStable < dt)
+    {
+        locSubsteps = int(std::ceil(dt/locStable*(1.0 - 1.0e-12)));
+    }
+    if (locSubsteps > MaxSubsteps or locStable <= 0.0)
+    {
+        if (not AdaptiveTimeStep)
+        {
+            std::stringstream message;
+            message << Module << " needs a time step of " << locStable
+                    << ", more than $MaxSubsteps = " << MaxSubsteps << " substeps of dt = " << dt;
+            ConsoleOutput::WriteWarning(message.str(), thisclassname, "SetModuleTimeStep()");
+        }
+        locSubsteps = MaxSubsteps;
+        SetTimeStepLimit(MaxSubsteps*std::max(locStable, 0.0), Module);
+    }
+    if (locSubsteps != locModule.Substeps)
+    {
+        ConsoleOutput::WriteStandard(Module + " substeps", std::to_string(locSubsteps));
+    }
+    locModule.Substeps = locSubsteps;
+    return locSubsteps;
+}
+
 bool RunTimeControl::RestartPossible()
 {
     std::ifstream inp(RawDataDir + thisobjectname + ".dat");
     if (inp)
     {
         inp >> StartTimeStep;
+        double locDt = 0.0;
+        double locTime = 0.0;
+        if (AdaptiveTimeStep and inp >> locDt >> locTime)
+        {
+            dt = locDt;
+            SimulationTime = locTime;
+        }
         RestartSwitch = true;
     }
     else
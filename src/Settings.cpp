@@ -26,12 +26,19 @@
 
 #include "Settings.h"
 
+#include "FFTWPlanner.h"
 #include "GridParameters.h"
 #include "RunTimeControl.h"
 #include "BoundaryConditions.h"
+#include "Checkpoint.h"
+#include "TimeSeriesOutput.h"
 #include "OPObject.h"
 #include "PhaseField.h"
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 namespace openphase
 {
 
@@ -63,7 +70,7 @@ void Settings::ReadInput(const string InputFileName)
     std::string filetype = FileInterface::getFileExtension(InputFileName); 
     if (filetype == "opi")
     {
-        fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+        stringstream inp = FileInterface::OpenInput(InputFileName);
 
         if (!inp)
         {
@@ -74,8 +81,6 @@ void Settings::ReadInput(const string InputFileName)
         std::stringstream data;
         data << inp.rdbuf();
         ReadInput(data);
-
-        inp.close();
     }
     else
     if (filetype == "json")
@@ -250,6 +255,35 @@ void Settings::ReadInput(std::stringstream& inp)
     HDF5Freq   = FileInterface::ReadParameterI(inp, moduleLocation, "HDF5Freq", false, HDF5Freq);
     // Control writing of DrivingForce HDF5 fields
     WriteDrivingForceH5 = FileInterface::ReadParameterB(inp, moduleLocation, "WriteDrivingForceH5", false, WriteDrivingForceH5);
+    // Incremental raw data checkpoints (optional, 0 writes full checkpoints only)
+    DeltaCheckpoints = FileInterface::ReadParameterI(inp, moduleLocation, "DeltaCheckpoints", false, DeltaCheckpoints);
+    DeltaBlockSize   = FileInterface::ReadParameterI(inp, moduleLocation, "DeltaBlockSize", false, DeltaBlockSize);
+    // Error bounded compression of the raw data of floating point fields (optional, 0 writes uncompressed raw data)
+    CheckpointTolerance = FileInterface::ReadParameterD(inp, moduleLocation, "CheckpointTolerance", false, CheckpointTolerance);
+    // Buffering of the time series text output (optional)
+    TimeSeriesFlushEntries  = FileInterface::ReadParameterI(inp, moduleLocation, "TimeSeriesFlushEntries", false, TimeSeriesFlushEntries);
+    TimeSeriesFlushInterval = FileInterface::ReadParameterD(inp, moduleLocation, "TimeSeriesFlushInterval", false, TimeSeriesFlushInterval);
+    TimeSeriesOutput::Configure(std::max(TimeSeriesFlushEntries, 1), TimeSeriesFlushInterval);
+    // Aggregation and rate limiting of warnings (optional)
+    AggregateWarnings = FileInterface::ReadParameterB(inp, moduleLocation, "AggregateWarnings", false, AggregateWarnings);
+    WarningRateLimit  = FileInterface::ReadParameterI(inp, moduleLocation, "WarningRateLimit", false, WarningRateLimit);
+    ConsoleOutput::AggregateWarnings = AggregateWarnings;
+    ConsoleOutput::WarningRateLimit  = std::max(WarningRateLimit, 0);
+    // Regions of the visualization output (optional, the whole domain by default)
+    OutputRegions.clear();
+    for(int n = 0; FileInterface::FindParameter(inp, moduleLocation, "OutputRegion_" + to_string(n)) != -1; n++)
+    {
+        OutputRegions.push_back(OutputRegion::Parse(
+            FileInterface::ReadParameterS(inp, moduleLocation, "OutputRegion_" + to_string(n))));
+    }
+    // Tile sizes of the cache-blocked storage loops (optional, 0 selects the default)
+    OMP_TILE_SIZE[0] = FileInterface::ReadParameterI(inp, moduleLocation, "TileSizeX", false, OMP_TILE_SIZE[0]);
+    OMP_TILE_SIZE[1] = FileInterface::ReadParameterI(inp, moduleLocation, "TileSizeY", false, OMP_TILE_SIZE[1]);
+    OMP_TILE_SIZE[2] = FileInterface::ReadParameterI(inp, moduleLocation, "TileSizeZ", false, OMP_TILE_SIZE[2]);
+    // Report of the CPUs and NUMA nodes of the threads (optional)
+    AffinityReport = FileInterface::ReadParameterB(inp, moduleLocation, "AffinityReport", false, AffinityReport);
+    // FFTW planning rigor and wisdom directory of the spectral solvers (optional)
+    FFTWPlanner::ReadInput(inp, moduleLocation);
 
     string from = "\\";
     string to = "/";
@@ -303,12 +337,14 @@ void Settings::ReadInput(std::stringstream& inp)
 
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteBlankLine();
+
+    if(AffinityReport) PrintAffinityReport();
 }
 
 void Settings::ReadJSON(const string InputFileName)
 {
     Grid.ReadJSON(InputFileName);
-    std::ifstream f(InputFileName);
+    std::stringstream f = FileInterface::OpenInput(InputFileName);
     
     json data = json::parse(f);
     if (data.contains(thisclassname))
@@ -391,6 +427,37 @@ void Settings::ReadJSON(const string InputFileName)
         HDF5Freq   = FileInterface::ReadParameter<int>(settings, {"HDF5Freq"}, HDF5Freq);
         // Control writing of DrivingForce HDF5 fields
         WriteDrivingForceH5 = FileInterface::ReadParameter<bool>(settings, {"WriteDrivingForceH5"}, WriteDrivingForceH5);
+        // Incremental raw data checkpoints (optional, 0 writes full checkpoints only)
+        DeltaCheckpoints = FileInterface::ReadParameter<int>(settings, {"DeltaCheckpoints"}, DeltaCheckpoints);
+        DeltaBlockSize   = FileInterface::ReadParameter<int>(settings, {"DeltaBlockSize"}, DeltaBlockSize);
+        // Error bounded compression of the raw data of floating point fields (optional, 0 writes uncompressed raw data)
+        CheckpointTolerance = FileInterface::ReadParameter<double>(settings, {"CheckpointTolerance"}, CheckpointTolerance);
+        // Buffering of the time series text output (optional)
+        TimeSeriesFlushEntries  = FileInterface::ReadParameter<int>(settings, {"TimeSeriesFlushEntries"}, TimeSeriesFlushEntries);
+        TimeSeriesFlushInterval = FileInterface::ReadParameter<double>(settings, {"TimeSeriesFlushInterval"}, TimeSeriesFlushInterval);
+        TimeSeriesOutput::Configure(std::max(TimeSeriesFlushEntries, 1), TimeSeriesFlushInterval);
+        AggregateWarnings = FileInterface::ReadParameter<bool>(settings, {"AggregateWarnings"}, AggregateWarnings);
+        WarningRateLimit  = FileInterface::ReadParameter<int>(settings, {"WarningRateLimit"}, WarningRateLimit);
+        ConsoleOutput::AggregateWarnings = AggregateWarnings;
+        ConsoleOutput::WarningRateLimit  = std::max(WarningRateLimit, 0);
+        // Regions of the visualization output (optional, the whole domain by default)
+        OutputRegions.clear();
+        if(settings.contains("OutputRegions"))
+        {
+            for(const auto& Region : settings["OutputRegions"])
+            {
+                OutputRegions.push_back(OutputRegion::Parse(Region.get<std::string>()));
+            }
+        }
+        // Tile sizes of the cache-blocked storage loops (optional, 0 selects the default)
+        OMP_TILE_SIZE[0] = FileInterface::ReadParameter<int>(settings, {"TileSizeX"}, OMP_TILE_SIZE[0]);
+        OMP_TILE_SIZE[1] = FileInterface::ReadParameter<int>(settings, {"TileSizeY"}, OMP_TILE_SIZE[1]);
+        OMP_TILE_SIZE[2] = FileInterface::ReadParameter<int>(settings, {"TileSizeZ"}, OMP_TILE_SIZE[2]);
+        // Report of the CPUs and NUMA nodes of the threads (optional)
+        AffinityReport = FileInterface::ReadParameter<bool>(settings, {"AffinityReport"}, AffinityReport);
+        // FFTW planning rigor and wisdom directory of the spectral solvers (optional)
+        FFTWPlanner::SetRigor(FileInterface::ReadParameter<std::string>(settings, {"FFTWPlanner"}, FFTWPlanner::Rigor));
+        FFTWPlanner::SetWisdomDir(FileInterface::ReadParameter<std::string>(settings, {"FFTWWisdomDir"}, FFTWPlanner::WisdomDir));
 
         string from = "\\";
         string to = "/";
@@ -445,6 +512,8 @@ void Settings::ReadJSON(const string InputFileName)
 
     ConsoleOutput::WriteLine();
     ConsoleOutput::WriteBlankLine();
+
+    if(AffinityReport) PrintAffinityReport();
 }
 
 void Settings::RemeshAll(int newNx, int newNy, int newNz, int tStep, const BoundaryConditions& BC)
@@ -455,10 +524,26 @@ void Settings::RemeshAll(int newNx, int newNy, int newNz, int tStep, const Bound
         if(!Grid.dNy) newNy = 0;
         if(!Grid.dNz) newNz = 0;
 
+        std::vector<double> Seconds(ObjectsToRemesh.size(), 0.0);
         for(size_t n = 0; n < ObjectsToRemesh.size(); n++)
         {
+            const myclock_t Start = mygettime();
             ObjectsToRemesh[n]->Remesh(newNx, newNy, newNz, BC);
+            Seconds[n] = double(mygettime() - Start)/OP_CLOCKS_PER_SEC;
+        }
+#ifdef MPI_PARALLEL
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, Seconds.data(), Seconds.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+        ConsoleOutput::WriteLineInsert("Remesh timing [s] (max per rank)");
+#else
+        ConsoleOutput::WriteLineInsert("Remesh timing [s]");
+#endif
+        for(size_t n = 0; n < ObjectsToRemesh.size(); n++)
+        {
+            const OPObject* Object = ObjectsToRemesh[n];
+            ConsoleOutput::WriteStandard(Object->thisobjectname.size() ? Object->thisobjectname : Object->thisclassname,
+                                         Seconds[n]);
         }
+        ConsoleOutput::WriteLine();
 
         Grid.SetDimensions(newNx, newNy, newNz);
 
@@ -468,6 +553,212 @@ void Settings::RemeshAll(int newNx, int newNy, int newNz, int tStep, const Bound
     }
 }
 
+void Settings::RepartitionAll(const BoundaryConditions& BC)
+{
+    std::vector<double> Seconds(ObjectsToRemesh.size(), 0.0);
+    for(size_t n = 0; n < ObjectsToRemesh.size(); n++)
+    {
+        const myclock_t Start = mygettime();
+        ObjectsToRemesh[n]->Repartition(BC);
+        Seconds[n] = double(mygettime() - Start)/OP_CLOCKS_PER_SEC;
+    }
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, Seconds.data(), Seconds.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    ConsoleOutput::WriteLineInsert("Repartition timing [s] (max per rank)");
+    for(size_t n = 0; n < ObjectsToRemesh.size(); n++)
+    {
+        const OPObject* Object = ObjectsToRemesh[n];
+        ConsoleOutput::WriteStandard(Object->thisobjectname.size() ? Object->thisobjectname : Object->thisclassname,
+                                     Seconds[n]);
+    }
+    ConsoleOutput::WriteLine();
+
+    Grid.ApplyCutPlanes();
+}
+
+void Settings::PrintMemoryReport(void) const
+{
+    std::vector<const OPObject*> Objects;
+    for(auto object : OPObject::ExistingObjects())
+    if(object->thisclassname.size() != 0)
+    {
+        Objects.push_back(object);
+    }
+
+    std::vector<unsigned long> MinBytes(Objects.size() + 1, 0);
+    for(size_t n = 0; n < Objects.size(); n++)
+    {
+        MinBytes[n] = Objects[n]->AllocatedMemory();
+        MinBytes.back() += MinBytes[n];
+    }
+    std::vector<unsigned long> MaxBytes = MinBytes;
+    bool PerObject = true;
+
+#ifdef MPI_PARALLEL
+    /* Per object values can only be reduced if all ranks hold the same
+    objects, otherwise only the totals are reported.*/
+    unsigned long MinObjects = Objects.size();
+    unsigned long MaxObjects = Objects.size();
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &MinObjects, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &MaxObjects, 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    PerObject = (MinObjects == MaxObjects);
+    if(PerObject)
+    {
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, MinBytes.data(), MinBytes.size(), OP_MPI_UNSIGNED_LONG, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, MaxBytes.data(), MaxBytes.size(), OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    }
+    else
+    {
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &MinBytes.back(), 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &MaxBytes.back(), 1, OP_MPI_UNSIGNED_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    }
+#endif
+
+    auto MB = [](const unsigned long bytes)
+    {
+        std::stringstream out;
+        out << std::fixed << std::setprecision(2) << bytes/(1024.0*1024.0);
+        return out.str();
+    };
+    auto Entry = [&MB](const unsigned long minBytes, const unsigned long maxBytes)
+    {
+#ifdef MPI_PARALLEL
+        return MB(minBytes) + " / " + MB(maxBytes);
+#else
+        (void) minBytes; //unused
+        return MB(maxBytes);
+#endif
+    };
+
+#ifdef MPI_PARALLEL
+    ConsoleOutput::WriteLineInsert("Memory report [MB] (min / max per rank)");
+#else
+    ConsoleOutput::WriteLineInsert("Memory report [MB]");
+#endif
+    if(PerObject)
+    {
+        for(size_t n = 0; n < Objects.size(); n++)
+        if(MaxBytes[n] != 0)
+        {
+            const std::string Name = Objects[n]->thisobjectname.size() ? Objects[n]->thisobjectname : Objects[n]->thisclassname;
+            ConsoleOutput::WriteStandard(Name, Entry(MinBytes[n], MaxBytes[n]));
+        }
+    }
+    else
+    {
+        ConsoleOutput::WriteStandard("Objects", "differ between ranks, only totals are reported");
+    }
+    ConsoleOutput::WriteStandard("Total", Entry(MinBytes.back(), MaxBytes.back()));
+    ConsoleOutput::WriteLine();
+}
+
+void Settings::PrintAffinityReport(void) const
+{
+    /* CPU of each OpenMP thread at the time of the call, threads which are not
+    pinned may later migrate away from the memory they have first touched */
+    int Threads = 1;
+    std::string Binding = "not available";
+#ifdef _OPENMP
+    Threads = omp_get_max_threads();
+    const char* BindingNames[] = {"false", "true", "primary", "close", "spread"};
+    const int Bind = omp_get_proc_bind();
+    Binding = (Bind >= 0 and Bind < 5) ? BindingNames[Bind] : to_string(Bind);
+    Binding += ", " + to_string(omp_get_num_places()) + " places";
+#endif
+    std::vector<int> CPUs(Threads, -1);
+#ifdef __linux__
+    #pragma omp parallel num_threads(Threads)
+    {
+#ifdef _OPENMP
+        CPUs[omp_get_thread_num()] = sched_getcpu();
+#else
+        CPUs[0] = sched_getcpu();
+#endif
+    }
+#endif
+
+    auto NUMANode = [](const int CPU)
+    {
+        std::error_code error;
+        const std::filesystem::path Dir("/sys/devices/system/cpu/cpu" + to_string(CPU));
+        for(const auto& Entry : std::filesystem::directory_iterator(Dir, error))
+        {
+            const std::string Name = Entry.path().filename().string();
+            if(Name.compare(0, 4, "node") == 0 and Name.size() > 4 and isdigit(Name[4]))
+            {
+                return stoi(Name.substr(4));
+            }
+        }
+        return -1;
+    };
+
+    /* One line per rank: compact list of the used CPUs and threads per node */
+    std::vector<int> Sorted = CPUs;
+    sort(Sorted.begin(), Sorted.end());
+    const bool Shared = adjacent_find(Sorted.begin(), Sorted.end()) != Sorted.end() and Sorted.front() >= 0;
+    Sorted.erase(unique(Sorted.begin(), Sorted.end()), Sorted.end());
+    std::stringstream Line;
+    for(size_t n = 0; n < Sorted.size(); n++)
+    {
+        size_t m = n;
+        while(m + 1 < Sorted.size() and Sorted[m+1] == Sorted[m] + 1) m++;
+        Line << (n ? "," : "") << Sorted[n];
+        if(m > n) Line << "-" << Sorted[m];
+        n = m;
+    }
+    std::map<int, int> ThreadsPerNode;
+    for(const int CPU : CPUs) ThreadsPerNode[(CPU >= 0) ? NUMANode(CPU) : -1]++;
+    Line << " |";
+    for(const auto& Node : ThreadsPerNode)
+    {
+        Line << " node " << ((Node.first >= 0) ? to_string(Node.first) : "?") << ": " << Node.second;
+    }
+
+    std::vector<std::string> Lines(1, Line.str());
+    int SharedCPUs = Shared;
+#ifdef MPI_PARALLEL
+    int Length = Lines[0].size();
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &Length, 1, OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &SharedCPUs, 1, OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    std::string Padded = Lines[0];
+    Padded.resize(Length, ' ');
+    std::string All(Length*MPI_SIZE, ' ');
+    OP_MPI_Allgather(Padded.data(), Length, OP_MPI_CHAR, All.data(), Length, OP_MPI_CHAR, OP_MPI_COMM_WORLD);
+    Lines.resize(MPI_SIZE);
+    for(int r = 0; r < MPI_SIZE; r++)
+    {
+        Lines[r] = All.substr(r*Length, Length);
+        Lines[r].erase(Lines[r].find_last_not_of(' ') + 1);
+    }
+#endif
+
+    ConsoleOutput::WriteLineInsert("Thread affinity");
+    ConsoleOutput::WriteStandard("OpenMP threads", Threads);
+    ConsoleOutput::WriteStandard("OpenMP binding", Binding);
+#ifdef NUMA_FIRST_TOUCH
+    ConsoleOutput::WriteStandard("First touch", "parallel, static storage loop schedule");
+#else
+    ConsoleOutput::WriteStandard("First touch", "serial, dynamic storage loop schedule");
+#endif
+    for(size_t r = 0; r < Lines.size(); r++)
+    {
+        ConsoleOutput::WriteStandard("Rank " + to_string(r) + " CPUs | threads per node", Lines[r]);
+    }
+    ConsoleOutput::WriteLine();
+
+#ifdef _OPENMP
+    if(Threads > 1 and omp_get_proc_bind() == omp_proc_bind_false)
+    {
+        ConsoleOutput::WriteWarning("OpenMP threads are not pinned, set OMP_PROC_BIND and OMP_PLACES to keep them next to their memory", "Settings", "PrintAffinityReport()");
+    }
+#endif
+    if(SharedCPUs)
+    {
+        ConsoleOutput::WriteWarning("Several OpenMP threads run on the same CPU, check the affinity settings of the job", "Settings", "PrintAffinityReport()");
+    }
+}
+
 void Settings::AddForRemeshing(OPObject& Obj)
 {
     ObjectsToRemesh.push_back(&Obj);
@@ -505,8 +796,19 @@ void Settings::AddForReading(OPObject& Obj)
     ObjectsToRead.push_back(&Obj);
 }
 
+bool Settings::WriteAll(const int tStep) const
+{
+    WriteCutPlanes(tStep);
+    return Checkpoint::Write(*this, tStep);
+}
+
 bool Settings::ReadAll(const BoundaryConditions& BC, const int tStep)
 {
+    ReadCutPlanes(BC, tStep);
+    if(Checkpoint::Exists(*this, tStep))
+    {
+        return Checkpoint::Read(*this, BC, tStep);
+    }
     bool read_status = true;
     for(size_t n = 0; n < ObjectsToRead.size(); n++)
     {
@@ -515,6 +817,82 @@ bool Settings::ReadAll(const BoundaryConditions& BC, const int tStep)
     return read_status;
 }
 
+void Settings::WriteCutPlanes(const int tStep) const
+{
+#ifdef MPI_PARALLEL
+    /* Equal boxes need no record, the default decomposition reproduces them */
+    if(MPI_CART_CUTS[0].empty() and MPI_CART_CUTS[1].empty() and MPI_CART_CUTS[2].empty()) return;
+    if(MPI_RANK != 0) return;
+
+    const std::string FileName = FileInterface::MakeFileName(RawDataDir, "CutPlanes_", tStep, ".dat");
+    std::ofstream out(FileName, std::ios::out);
+    if(!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be created", thisclassname, "WriteCutPlanes()");
+        return;
+    }
+    const char Axis[3] = {'X','Y','Z'};
+    for(int d = 0; d < 3; d++)
+    {
+        out << Axis[d];
+        for(auto Cut : MPI_CART_CUTS[d]) out << " " << Cut;
+        out << "\n";
+    }
+#else
+    (void) tStep; //unused
+#endif
+}
+
+void Settings::ReadCutPlanes(const BoundaryConditions& BC, const int tStep)
+{
+#ifdef MPI_PARALLEL
+    const std::string FileName = FileInterface::MakeFileName(InputRawDataDir, "CutPlanes_", tStep, ".dat");
+    std::ifstream inp(FileName, std::ios::in);
+    if(!inp) return;
+
+    std::vector<int> Cuts[3];
+    std::string line;
+    for(int d = 0; d < 3 and std::getline(inp, line); d++)
+    {
+        std::stringstream entries(line);
+        char Axis;
+        entries >> Axis;
+        int Cut;
+        while(entries >> Cut) Cuts[d].push_back(Cut);
+    }
+
+    const int Total[3] = {Grid.TotalNx, Grid.TotalNy, Grid.TotalNz};
+    for(int d = 0; d < 3; d++)
+    if(not Cuts[d].empty() and (not MPI_3D_DECOMPOSITION
+                                or Cuts[d].size() != size_t(MPI_CART_SIZE[d] + 1)
+                                or Cuts[d].front() != 0 or Cuts[d].back() != Total[d]))
+    {
+        ConsoleOutput::WriteExit("Cut planes in \"" + FileName + "\" do not match the current "
+                                 "domain decomposition, restart with the same number of MPI ranks "
+                                 "along each direction and the same system size", thisclassname, "ReadCutPlanes()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    if(Cuts[0] == MPI_CART_CUTS[0] and Cuts[1] == MPI_CART_CUTS[1] and Cuts[2] == MPI_CART_CUTS[2]) return;
+
+    for(auto Object : ObjectsToRemesh)
+    if(not Object->repartitionable)
+    {
+        ConsoleOutput::WriteExit("Raw data was written with the cut planes in \"" + FileName + "\", but "
+                                 + Object->thisclassname + " cannot be repartitioned", thisclassname, "ReadCutPlanes()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    for(int d = 0; d < 3; d++)
+    {
+        MPI_CART_CUTS[d] = Cuts[d];
+    }
+    RepartitionAll(BC);
+    ConsoleOutput::WriteStandard(thisclassname, "Restored the cut planes from \"" + FileName + "\"");
+#else
+    (void) BC;    //unused
+    (void) tStep; //unused
+#endif
+}
+
 bool Settings::Read(std::string ObjNameBase, const BoundaryConditions& BC, const int tStep)
 {
     bool read_status = true;
@@ -557,6 +935,14 @@ Settings& Settings::operator= (const Settings& rhs)
         RawDataDir = rhs.RawDataDir;
         InputRawDataDir = rhs.InputRawDataDir;
         TextDir = rhs.TextDir;
+        DeltaCheckpoints = rhs.DeltaCheckpoints;
+        DeltaBlockSize = rhs.DeltaBlockSize;
+        CheckpointTolerance = rhs.CheckpointTolerance;
+        TimeSeriesFlushEntries = rhs.TimeSeriesFlushEntries;
+        TimeSeriesFlushInterval = rhs.TimeSeriesFlushInterval;
+        AggregateWarnings = rhs.AggregateWarnings;
+        WarningRateLimit = rhs.WarningRateLimit;
+        OutputRegions = rhs.OutputRegions;
 
         GridHistory = rhs.GridHistory;
     }
@@ -106,6 +106,21 @@ class StabilizationImpl : public OPObject
     double STAB;
     std::vector<double> n_vector;
     std::vector<StencilDirection>  StencilDirections;
+
+    std::vector<iVector3> Band;                                                 ///< Cells with nonzero phase-field flag (interior and halo), collected by CalculateCurvature*()
+    Storage3D<NodeAB<dVector3,dVector3>, 0> Normals;                            ///< Pair-wise interface normals of the band cells, cached for the averaging passes
+    bool NormalsValid;                                                          ///< True if Normals are up to date with the current band
+
+    void CollectBand(const Storage3D<NodePF, 0>& PF);                           ///< Clears the work storages in the old band and collects the new one
+    void UpdateNormals(const PhaseField& Phase);                                ///< Caches the pair-wise normals of the band cells if not yet done
+    static bool Within(const Storage3D<NodePF, 0>& PF,
+                       const long int i, const long int j, const long int k,
+                       const long int reach)                                    ///< True if (i,j,k) lies within reach layers around the interior
+    {
+        return i >= -reach and i < PF.sizeX() + reach and
+               j >= -reach and j < PF.sizeY() + reach and
+               k >= -reach and k < PF.sizeZ() + reach;
+    }
 };
 
 Stabilization::Stabilization() : impl_(new StabilizationImpl) {}
@@ -226,6 +241,9 @@ void StabilizationImpl::Initialize(Settings& locSettings)
     AverageInterfaceAuxWeight.Allocate(Grid, Bcells);
 
     Velocity.Allocate(Grid, Bcells);
+    Normals.Allocate(Grid, Bcells);
+    Band.clear();
+    NormalsValid = false;
 
     initialized = true;
 
@@ -307,25 +325,94 @@ void StabilizationImpl::ReadInput(std::stringstream& inp)
     ConsoleOutput::WriteBlankLine();
 }
 
+void StabilizationImpl::CollectBand(const Storage3D<NodePF, 0>& PF)
+{
+    /* The work storages are only written in the band cells, clearing the
+    cells of the previous and of the new band replaces clearing the whole
+    domain. The new band is collected once per stabilization pass and reused
+    by all averaging variants, ComputeVelocity() and ComputeUpdate().*/
+    auto ClearBand = [this]()
+    {
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
+        {
+            Curvature(i,j,k).clear();
+            Interface(i,j,k).clear();
+            AverageCurvature(i,j,k).clear();
+            AverageCurvatureWeight(i,j,k).clear();
+            AverageCurvatureAux(i,j,k).clear();
+            AverageCurvatureAuxWeight(i,j,k).clear();
+            AverageInterface(i,j,k).clear();
+            AverageInterfaceWeight(i,j,k).clear();
+            AverageInterfaceAux(i,j,k).clear();
+            AverageInterfaceAuxWeight(i,j,k).clear();
+            Velocity(i,j,k).clear();
+            Normals(i,j,k).clear();
+        }
+        OMP_PARALLEL_CELL_LIST_LOOP_END
+    };
+    ClearBand();
+
+    Band.clear();
+    const long int BX = PF.BcellsX();
+    const long int BY = PF.BcellsY();
+    const long int BZ = PF.BcellsZ();
+    #pragma omp parallel
+    {
+        std::vector<iVector3> locBand;
+        #pragma omp for schedule(static)
+        for(long int i = -BX; i < PF.sizeX() + BX; i++)
+        for(long int j = -BY; j < PF.sizeY() + BY; j++)
+        for(long int k = -BZ; k < PF.sizeZ() + BZ; k++)
+        if(PF(i,j,k).wide_interface())
+        {
+            locBand.push_back(iVector3({i,j,k}));
+        }
+        #pragma omp critical
+        {
+            Band.insert(Band.end(), locBand.begin(), locBand.end());
+        }
+    }
+    ClearBand();
+    NormalsValid = false;
+}
+
+void StabilizationImpl::UpdateNormals(const PhaseField& Phase)
+{
+    /* The normals only depend on the gradients stored in the phase-field
+    entries, they are computed once per band and shared by the normal
+    averaging variants.*/
+    if(NormalsValid) return;
+
+    auto& PF = (Grid.Resolution == Resolutions::Single)?Phase.Fields:Phase.FieldsDR;
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
+    {
+        Normals(i,j,k).clear();
+        for (auto alpha  = PF(i,j,k).cbegin();
+                  alpha != PF(i,j,k).cend(); ++alpha)
+        for (auto  beta  = alpha + 1;
+                   beta != PF(i,j,k).cend(); ++beta)
+        {
+            Normals(i,j,k).set_asym1(alpha->index, beta->index, Phase.Normal(alpha,beta));
+        }
+    }
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    NormalsValid = true;
+}
+
 void StabilizationImpl::CalculateCurvature(PhaseField& Phase)
 {
     //Phase.CalculateDerivativesSR();
 
     auto& PF = (Grid.Resolution == Resolutions::Single)?Phase.Fields:Phase.FieldsDR;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
-    {
-        Curvature(i,j,k).clear();
-        Interface(i,j,k).clear();
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    CollectBand(PF);
 
     const double Prefactor = Pi*Pi/(Phase.Grid.Eta*Phase.Grid.Eta);
 
     size_t bcells = std::max((long int)0,PF.Bcells()-1);
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,bcells,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,bcells))
         {
             NodePF& locPF = (Grid.Resolution == Resolutions::Single)?Phase.Fields(i,j,k):Phase.FieldsDR(i,j,k);
             for(auto alpha  = locPF.cbegin();
@@ -340,24 +427,19 @@ void StabilizationImpl::CalculateCurvature(PhaseField& Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void StabilizationImpl::CalculateCurvature_SPF(PhaseField& Phase)
 {
     auto& PF = (Grid.Resolution == Resolutions::Single)?Phase.Fields:Phase.FieldsDR;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
-    {
-        Curvature(i,j,k).clear();
-        Interface(i,j,k).clear();
-    }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    CollectBand(PF);
     
     size_t bcells = std::max((long int)0,PF.Bcells()-1);
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,bcells,)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,bcells))
         {
             NodePF& locPF = (Grid.Resolution == Resolutions::Single)?Phase.Fields(i,j,k):Phase.FieldsDR(i,j,k);
             for(auto alpha  = locPF.cbegin();
@@ -390,24 +472,24 @@ void StabilizationImpl::CalculateCurvature_SPF(PhaseField& Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
 {
     auto& PF = (Grid.Resolution == Resolutions::Single)?Phase.Fields:Phase.FieldsDR;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         AverageCurvature(i,j,k).clear();
         AverageCurvatureWeight(i,j,k).clear();
         AverageCurvatureAux(i,j,k).clear();
         AverageCurvatureAuxWeight(i,j,k).clear();
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -432,10 +514,10 @@ void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -447,10 +529,10 @@ void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -472,10 +554,10 @@ void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -487,18 +569,18 @@ void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         AverageInterface(i,j,k).clear();
         AverageInterfaceWeight(i,j,k).clear();
         AverageInterfaceAux(i,j,k).clear();
         AverageInterfaceAuxWeight(i,j,k).clear();
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -523,10 +605,10 @@ void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -538,10 +620,10 @@ void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha = PF(i,j,k).cbegin();
                     alpha != PF(i,j,k).cend(); ++alpha)
@@ -563,10 +645,10 @@ void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -578,24 +660,24 @@ void StabilizationImpl::CalculateAverageCurvature(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phase)
 {
     auto& PF = (Grid.Resolution == Resolutions::Single)?Phase.Fields:Phase.FieldsDR;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         AverageCurvature(i,j,k).clear();
         AverageCurvatureWeight(i,j,k).clear();
         AverageCurvatureAux(i,j,k).clear();
         AverageCurvatureAuxWeight(i,j,k).clear();
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -620,10 +702,10 @@ void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -635,10 +717,10 @@ void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -663,10 +745,10 @@ void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -678,18 +760,18 @@ void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         AverageInterface(i,j,k).clear();
         AverageInterfaceWeight(i,j,k).clear();
         AverageInterfaceAux(i,j,k).clear();
         AverageInterfaceAuxWeight(i,j,k).clear();
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -714,10 +796,10 @@ void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -729,10 +811,10 @@ void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -757,10 +839,10 @@ void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend(); ++alpha)
@@ -772,24 +854,25 @@ void StabilizationImpl::CalculateAverageCurvatureRegularization(PhaseField &Phas
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void StabilizationImpl::CalculateAverageCurvatureNormal(PhaseField &Phase)
 {
     auto& PF = (Grid.Resolution == Resolutions::Single)?Phase.Fields:Phase.FieldsDR;
+    UpdateNormals(Phase);
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         AverageCurvature(i,j,k).clear();
         AverageCurvatureWeight(i,j,k).clear();
         AverageInterface(i,j,k).clear();
         AverageInterfaceWeight(i,j,k).clear();
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells()-1,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,PF.Bcells()-1))
         {
             const NodePF& locPF = (Grid.Resolution == Resolutions::Single)?Phase.Fields(i,j,k):Phase.FieldsDR(i,j,k);
             for (auto alpha  = locPF.cbegin();
@@ -798,7 +881,7 @@ void StabilizationImpl::CalculateAverageCurvatureNormal(PhaseField &Phase)
                        beta != locPF.cend(); ++beta)
             if (alpha != beta)
             {
-                dVector3 normal = Phase.Normal(alpha,beta);                
+                const dVector3 normal = Normals(i,j,k).get_asym1(alpha->index, beta->index);
                 for (int r = -2; r <= 2; ++r)
                 {
                     double ii = i+0.5*r*range*normal[0];
@@ -818,8 +901,8 @@ void StabilizationImpl::CalculateAverageCurvatureNormal(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         if (PF(i,j,k).wide_interface())
         {
@@ -837,24 +920,25 @@ void StabilizationImpl::CalculateAverageCurvatureNormal(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void StabilizationImpl::CalculateAverageCurvatureNormalSnap(PhaseField &Phase)
 {
     auto& PF = (Grid.Resolution == Resolutions::Single)?Phase.Fields:Phase.FieldsDR;
+    UpdateNormals(Phase);
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         AverageCurvature(i,j,k).clear();
         AverageCurvatureWeight(i,j,k).clear();
         AverageInterface(i,j,k).clear();
         AverageInterfaceWeight(i,j,k).clear();
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells()-1,)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,PF.Bcells()-1))
         {
             const NodePF& locPF = (Grid.Resolution == Resolutions::Single)?Phase.Fields(i,j,k):Phase.FieldsDR(i,j,k);
             for (auto alpha  = locPF.cbegin();
@@ -863,7 +947,7 @@ void StabilizationImpl::CalculateAverageCurvatureNormalSnap(PhaseField &Phase)
                        beta != locPF.cend(); ++beta)
             if (alpha != beta)
             {
-                dVector3 normal = Phase.Normal(alpha,beta);                
+                const dVector3 normal = Normals(i,j,k).get_asym1(alpha->index, beta->index);
                 for (int r = -2; r <= 2; ++r)
                 {
                     int ii = round(i+0.5*r*range*normal[0]);
@@ -883,8 +967,8 @@ void StabilizationImpl::CalculateAverageCurvatureNormalSnap(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         if (PF(i,j,k).wide_interface())
         {
@@ -902,22 +986,22 @@ void StabilizationImpl::CalculateAverageCurvatureNormalSnap(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 
 void StabilizationImpl::CalculateAverageCurvatureSimple(PhaseField &Phase)
 {
     auto& PF = (Grid.Resolution == Resolutions::Single)?Phase.Fields:Phase.FieldsDR;
 
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         AverageCurvature(i,j,k).clear();
         AverageCurvatureWeight(i,j,k).clear();
         AverageInterface(i,j,k).clear();
         AverageInterfaceWeight(i,j,k).clear();
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,PF.Bcells(),)
+    OMP_PARALLEL_CELL_LIST_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
     {
         if (PF(i,j,k).interface_halo())
         {
@@ -939,7 +1023,7 @@ void StabilizationImpl::CalculateAverageCurvatureSimple(PhaseField &Phase)
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
 }
 void StabilizationImpl::ComputeVelocity(PhaseField& Phase,
                                 InterfaceProperties& IP, DrivingForce& dG)
@@ -951,10 +1035,10 @@ void StabilizationImpl::ComputeVelocity(PhaseField& Phase,
     double maxdG = 0.;
     double maxSigma = 0.;
     int divisor = (Grid.Resolution == Resolutions::Single)?1:2;
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,reduction(max:maxv,maxdG,maxSigma))
+    OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,reduction(max:maxv,maxdG,maxSigma))
     {
         Velocity(i,j,k).clear();
-        if (PF(i,j,k).wide_interface())
+        if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
         {
             for(auto alpha  = PF(i,j,k).cbegin();
                      alpha != PF(i,j,k).cend() - 1; ++alpha)
@@ -988,7 +1072,7 @@ void StabilizationImpl::ComputeVelocity(PhaseField& Phase,
             }
         }
     }
-    OMP_PARALLEL_STORAGE_LOOP_END
+    OMP_PARALLEL_CELL_LIST_LOOP_END
     if (maxv > 0)
     {
         maxdt = 16 * STAB*Phase.Grid.dx / maxv;
@@ -1001,10 +1085,10 @@ void StabilizationImpl::ComputeVelocity(PhaseField& Phase,
     if (maxdt < 1e-6*Phase.Grid.dx)
     {
         maxdt = 1e-6*Phase.Grid.dx;
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,PF,0,)
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i,j,k,Band,)
         {
             Velocity(i,j,k).clear();
-            if (PF(i,j,k).wide_interface())
+            if (PF(i,j,k).wide_interface() and Within(PF,i,j,k,0))
             {
                 for(auto alpha  = PF(i,j,k).cbegin();
                          alpha != PF(i,j,k).cend() - 1; ++alpha)
@@ -1019,7 +1103,7 @@ void StabilizationImpl::ComputeVelocity(PhaseField& Phase,
                 }
             }
         }
-        OMP_PARALLEL_STORAGE_LOOP_END
+        OMP_PARALLEL_CELL_LIST_LOOP_END
     }
 }
 
@@ -1038,9 +1122,9 @@ void StabilizationImpl::ComputeUpdate(PhaseField& Phase,
     {
         double eta = Phase.Grid.Eta;
         double pi = Pi;
-        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i, j, k, PF, 0, )
+        OMP_PARALLEL_CELL_LIST_LOOP_BEGIN(i, j, k, Band, )
         {
-            if (PF(i, j, k).wide_interface())
+            if (PF(i, j, k).wide_interface() and Within(PF,i,j,k,0))
             {
                 NodePF NodePFDR;
                 if(Grid.Resolution == Resolutions::Dual)
@@ -1071,7 +1155,7 @@ void StabilizationImpl::ComputeUpdate(PhaseField& Phase,
                 }
             }
         }
-        OMP_PARALLEL_STORAGE_LOOP_END
+        OMP_PARALLEL_CELL_LIST_LOOP_END
     }
 }
 
@@ -45,9 +45,11 @@ void SymmetryVariants::Initialize(Settings& locSettings, std::string ObjectNameS
 
     Nphases = locSettings.Nphases;
     TransformationMatrices.resize(Nphases);
+    VoigtRotations.resize(Nphases);
     for (size_t pIndex = 0; pIndex < Nphases; pIndex++)
     {
         TransformationMatrices[pIndex].resize(locSettings.Nvariants[pIndex], dMatrix3x3::UnitTensor());
+        VoigtRotations[pIndex].resize(locSettings.Nvariants[pIndex], dMatrix6x6::UnitTensor());
     }
     set = false;
     initialized = true;
@@ -57,7 +59,7 @@ void SymmetryVariants::Initialize(Settings& locSettings, std::string ObjectNameS
 void SymmetryVariants::ReadInput(const string InputFileName)
 {
     ConsoleOutput::WriteStandard("Source", InputFileName);
-    fstream inp(InputFileName.c_str(), ios::in);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File " + InputFileName + " could not be opened", thisclassname, "ReadInput()");
@@ -65,7 +67,6 @@ void SymmetryVariants::ReadInput(const string InputFileName)
     };
     std::stringstream data;
     data << inp.rdbuf();
-    inp.close();
 
     ReadInput(data);
 }
@@ -86,6 +87,7 @@ void SymmetryVariants::ReadInput(stringstream& inp)
             converter << "V" << "_" << pIndex << "_" << n;
 
             TransformationMatrices[pIndex][n] = FileInterface::ReadParameterM3x3(inp, moduleLocation, converter.str(),false,dMatrix3x3::UnitTensor());
+            VoigtRotations[pIndex][n] = dMatrix6x6::RotationOperator(TransformationMatrices[pIndex][n]);
             set = true;
         }
     }
@@ -35,6 +35,10 @@
 #include "VTK.h"
 #include "RunTimeControl.h"
 #include "Velocities.h"
+#include "LoadBalancer.h"
+#include "Tools/ReductionBatch.h"
+#include "Tools/LossyCompression.h"
+#include "TimeSeriesOutput.h"
 
 namespace openphase
 {
@@ -78,6 +82,7 @@ void Temperature::Initialize(Settings& locSettings, std::string ObjectNameSuffix
     Grid = locSettings.Grid;
 
     Nphases = locSettings.Nphases;
+    CheckpointTolerance = locSettings.CheckpointTolerance;
 
     Tmin = 0.0;
     Tmax = 0.0;
@@ -90,6 +95,10 @@ void Temperature::Initialize(Settings& locSettings, std::string ObjectNameSuffix
 
     LatentHeatMode = LatentHeatModes::Off;
 
+    PropertyCacheTolerance = 0.0;
+    CacheEpoch = 0;
+    ResetCache();
+
     size_t Bcells = Grid.Bcells;
     Tx   .Allocate(Grid, Bcells);
     TxOld.Allocate(Grid, Bcells);
@@ -102,7 +111,9 @@ void Temperature::Initialize(Settings& locSettings, std::string ObjectNameSuffix
 
     locSettings.AddForAdvection(*this);
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
     locSettings.AddForReading(*this);
+    checkpointable = true;
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -110,7 +121,7 @@ void Temperature::Initialize(Settings& locSettings, std::string ObjectNameSuffix
 
 void Temperature::ReadInput(const string InputFileName)
 {
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
     if (!inp)
     {
         ConsoleOutput::WriteExit("File \"" + InputFileName + "\" could not be opened", thisclassname, "ReadInput()");
@@ -119,7 +130,6 @@ void Temperature::ReadInput(const string InputFileName)
 
     std::stringstream data;
     data << inp.rdbuf();
-    inp.close();
 
     ConsoleOutput::WriteBlankLine();
     ConsoleOutput::WriteLineInsert(thisclassname+" input");
@@ -285,6 +295,8 @@ void Temperature::ReadInput(stringstream& inp)
         }
     }
 
+    PropertyCacheTolerance = FileInterface::ReadParameterD(inp, moduleLocation, string("PropertyCacheTolerance"), false, 0.0);
+
     if(Grid.dNx)
     {
         int X0_size = FileInterface::ReadParameterI(inp, moduleLocation, "Extension_X0", false, 0);
@@ -396,9 +408,11 @@ void Temperature::CalculateMinMaxAvg()
     OMP_PARALLEL_STORAGE_LOOP_END
 
 #ifdef MPI_PARALLEL
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &locTmin, 1, OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &locTmax, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &locTavg, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    ReductionBatch Batch;
+    Batch.Min(&locTmin);
+    Batch.Max(&locTmax);
+    Batch.Sum(&locTavg);
+    Batch.Reduce();
 #endif
 
     Tmin = locTmin;
@@ -407,6 +421,67 @@ void Temperature::CalculateMinMaxAvg()
     Tiavg.set_to_value(Tavg);
 }
 
+void Temperature::ResetCache(void)
+{
+    CacheEpoch++;
+    CacheValid = false;
+}
+
+void Temperature::TrackChanges(const PhaseField& Phase)
+{
+    const long int Bcells = min(Tx.Bcells(), Phase.Fields.Bcells());
+    if(not CacheValid)
+    {
+        CacheTx       = Storage3D<double, 0>(Grid, Bcells);
+        CachePhaseSet = Storage3D<size_t, 0>(Grid, Bcells);
+        CacheRevision = Storage3D<unsigned int, 0>(Grid, Bcells);
+    }
+
+    /* Order independent signature of the phase field indices of a cell, the
+    indices are scrambled to make collisions of different sets unlikely */
+    auto Signature = [](const NodePF& locPF)
+    {
+        size_t Sum = 0;
+        for(auto alpha = locPF.cbegin(); alpha != locPF.cend(); ++alpha)
+        {
+            size_t x = alpha->index + 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27))*0x94d049bb133111ebULL;
+            Sum += x ^ (x >> 31);
+        }
+        return Sum;
+    };
+
+    const bool Reset = not CacheValid;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,CacheRevision,CacheRevision.Bcells(),)
+    {
+        const size_t locPhaseSet = Signature(Phase.Fields(i,j,k));
+        if(Reset or locPhaseSet != CachePhaseSet(i,j,k) or
+           fabs(Tx(i,j,k) - CacheTx(i,j,k)) > PropertyCacheTolerance)
+        {
+            CacheTx(i,j,k) = Tx(i,j,k);
+            CachePhaseSet(i,j,k) = locPhaseSet;
+            CacheRevision(i,j,k) = Reset ? 1 : CacheRevision(i,j,k) + 1;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    CacheValid = true;
+}
+
+bool Temperature::Subscribe(TemperatureSubscription& Sub, const long int Bcells) const
+{
+    if(not CacheValid or Bcells > CacheRevision.Bcells()) return false;
+
+    if(Sub.Epoch != CacheEpoch)
+    {
+        /* Revisions start at 1, all cells are outdated for the new subscriber */
+        Sub.Seen = Storage3D<unsigned int, 0>(Grid, CacheRevision.Bcells());
+        Sub.Seen.Clear();
+        Sub.Epoch = CacheEpoch;
+    }
+    return true;
+}
+
 void Temperature::SetInitial1Dextension(Temperature1Dextension& TxExt)
 {
     // Get average temperature at the boundary of interest
@@ -428,8 +503,10 @@ void Temperature::SetInitial1Dextension(Temperature1Dextension& TxExt)
 #ifdef MPI_PARALLEL
     if(TxExt.Direction[0] == 0)
     {
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &boundaryValue, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-        OP_MPI_Allreduce(OP_MPI_IN_PLACE, &area, 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        ReductionBatch Batch;
+        Batch.Sum(&boundaryValue);
+        Batch.Sum(&area);
+        Batch.Reduce();
     }
 #endif
 
@@ -712,24 +789,8 @@ void Temperature::SetBoundaryConditions(const BoundaryConditions& BC)
 void Temperature::MoveFrame(const int dx, const int dy, const int dz,
                             const BoundaryConditions& BC)
 {
-    int xBeg = (dx >= 0) + (dx < 0)*(Grid.Nx) - 1;
-    int xEnd = (dx >= 0)*(Grid.Nx) + (dx < 0) - 1;
-    int xInc = 1 - 2*(dx < 0);
-
-    int yBeg = (dy >= 0) + (dy < 0)*(Grid.Ny) - 1;
-    int yEnd = (dy >= 0)*(Grid.Ny) + (dy < 0) - 1;
-    int yInc = 1 - 2*(dy < 0);
-
-    int zBeg = (dz >= 0) + (dz < 0)*(Grid.Nz) - 1;
-    int zEnd = (dz >= 0)*(Grid.Nz) + (dz < 0) - 1;
-    int zInc = 1 - 2*(dz < 0);
-
-    for(int i = xBeg; ((dx >= 0) and (i <= xEnd)) or ((dx < 0) and (i >= xEnd)); i += xInc)
-    for(int j = yBeg; ((dy >= 0) and (j <= yEnd)) or ((dy < 0) and (j >= yEnd)); j += yInc)
-    for(int k = zBeg; ((dz >= 0) and (k <= zEnd)) or ((dz < 0) and (k >= zEnd)); k += zInc)
-    {
-         Tx(i,j,k) = Tx(i + dx*Grid.dNx, j + dy*Grid.dNy, k + dz*Grid.dNz);
-    }
+    Tx.Shift(dx*Grid.dNx, dy*Grid.dNy, dz*Grid.dNz);
+    ResetCache();
 
     SetBoundaryConditions(BC);
 
@@ -813,7 +874,7 @@ bool Temperature::Write(const Settings& locSettings, const int tStep) const
         return false;
     };
 
-    out.write(reinterpret_cast<const char*>(&Tx[0]), Tx.tot_size()*sizeof(double));
+    WriteRawTemperature(out);
     out.close();
 
     if(ExtensionsActive)
@@ -859,7 +920,11 @@ bool Temperature::Read(const Settings& locSettings, const BoundaryConditions& BC
         return false;
     };
 
-    inp.read(reinterpret_cast<char*>(&Tx[0]), Tx.tot_size()*sizeof(double));
+    if(not ReadRawTemperature(inp))
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be read", thisclassname, "Read()");
+        return false;
+    }
     inp.close();
 
     CalculateMinMaxAvg();
@@ -894,6 +959,71 @@ bool Temperature::Read(const Settings& locSettings, const BoundaryConditions& BC
     return true;
 }
 
+void Temperature::WriteRawTemperature(std::ostream& out) const
+{
+    if(CheckpointTolerance > 0.0)
+    {
+        const std::vector<double> values(&Tx[0], &Tx[0] + Tx.tot_size());
+        LossyCompression::Write(out, values, CheckpointTolerance);
+    }
+    else
+    {
+        out.write(reinterpret_cast<const char*>(&Tx[0]), Tx.tot_size()*sizeof(double));
+    }
+}
+
+bool Temperature::ReadRawTemperature(std::istream& inp)
+{
+    std::vector<double> values;
+    if(LossyCompression::Read(inp, values))
+    {
+        if(values.size() != Tx.tot_size()) return false;
+        std::copy(values.begin(), values.end(), &Tx[0]);
+    }
+    else
+    {
+        inp.read(reinterpret_cast<char*>(&Tx[0]), Tx.tot_size()*sizeof(double));
+    }
+    return bool(inp);
+}
+
+void Temperature::WriteCheckpoint(std::ostream& out) const
+{
+    WriteRawTemperature(out);
+
+    if(ExtensionsActive)
+    {
+        if(ExtensionX0.isActive()) ExtensionX0.write(out);
+        if(ExtensionXN.isActive()) ExtensionXN.write(out);
+        if(ExtensionY0.isActive()) ExtensionY0.write(out);
+        if(ExtensionYN.isActive()) ExtensionYN.write(out);
+        if(ExtensionZ0.isActive()) ExtensionZ0.write(out);
+        if(ExtensionZN.isActive()) ExtensionZN.write(out);
+    }
+}
+
+bool Temperature::ReadCheckpoint(std::istream& inp)
+{
+    if(not ReadRawTemperature(inp)) return false;
+
+    if(ExtensionsActive)
+    {
+        if(ExtensionX0.isActive()) ExtensionX0.read(inp);
+        if(ExtensionXN.isActive()) ExtensionXN.read(inp);
+        if(ExtensionY0.isActive()) ExtensionY0.read(inp);
+        if(ExtensionYN.isActive()) ExtensionYN.read(inp);
+        if(ExtensionZ0.isActive()) ExtensionZ0.read(inp);
+        if(ExtensionZN.isActive()) ExtensionZN.read(inp);
+    }
+    return bool(inp);
+}
+
+void Temperature::FinalizeRead(const BoundaryConditions& BC)
+{
+    CalculateMinMaxAvg();
+    SetBoundaryConditions(BC);
+}
+
 void Temperature::WriteH5(H5Interface& H5, const int tStep)
 {
     #ifdef H5OP
@@ -905,7 +1035,7 @@ void Temperature::WriteH5(H5Interface& H5, const int tStep)
     dbuffer.clear();
 
     dbuffer = Tx.pack();
-    H5.WriteCheckPoint(tStep, "Tx", dbuffer);
+    H5.WriteCheckPoint(tStep, "Tx", dbuffer, "", true);
 
     if (ExtensionX0.isActive()) {
         std::vector<double> bufX0(ExtensionX0.Data.size());
@@ -1027,6 +1157,16 @@ bool Temperature::ReadH5(H5Interface& H5, const int tStep)
     return false;
 }
 
+size_t Temperature::AllocatedMemory(void) const
+{
+    return Tx.AllocatedMemory() +
+           TxDot.AllocatedMemory() +
+           TxOld.AllocatedMemory() +
+           CacheTx.AllocatedMemory() +
+           CachePhaseSet.AllocatedMemory() +
+           CacheRevision.AllocatedMemory();
+}
+
 void Temperature::Remesh(const int newNx, const int newNy, const int newNz,
                                                     const BoundaryConditions& BC)
 {
@@ -1035,6 +1175,7 @@ void Temperature::Remesh(const int newNx, const int newNy, const int newNz,
     Grid.SetDimensions(newNx, newNy, newNz);
 
     Tx.Remesh(Grid.Nx, Grid.Ny, Grid.Nz);
+    ResetCache();
 
     if(TxDot.IsAllocated())
     {
@@ -1045,6 +1186,23 @@ void Temperature::Remesh(const int newNx, const int newNy, const int newNz,
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
+void Temperature::Repartition(const BoundaryConditions& BC)
+{
+    const GridParameters OldGrid = Grid;
+    Grid.ApplyCutPlanes();
+
+    LoadBalancer::Migrate(Tx, OldGrid, Grid);
+    TxOld.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    ResetCache();
+
+    if(TxDot.IsAllocated())
+    {
+        TxDot.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
+    }
+
+    SetBoundaryConditions(BC);
+}
+
 void Temperature::PrintPointStatistics(const int x, const int y, const int z) const
 {
     ConsoleOutput::WriteStandard("Point", iVector3{x,y,z});
@@ -1088,24 +1246,20 @@ void Temperature::WriteMinMaxAverage(int time_step, double time, string filename
     {
         string separator = " ";
 
-        if(!std::filesystem::exists(filename) or time_step <= 0)
-        {
-            ofstream file(filename, ios::out);
-            file << "TimeStep" << separator
-                 << "Time"     << separator
-                 << "Min"      << separator
-                 << "Max"      << separator
-                 << "Average"  << endl;
-            file.close();
-        }
+        stringstream header;
+        header << "TimeStep" << separator
+               << "Time"     << separator
+               << "Min"      << separator
+               << "Max"      << separator
+               << "Average"  << "\n";
 
-        ofstream file(filename, ios::app);
-        file << time_step << separator
+        stringstream line;
+        line << time_step << separator
              << time      << separator
              << Tmin      << separator
              << Tmax      << separator
-             << Tavg      << endl;
-        file.close();
+             << Tavg      << "\n";
+        TimeSeriesOutput::Append(filename, header.str(), line.str(), time_step <= 0);
     }
 }
 
@@ -1149,6 +1303,9 @@ Temperature& Temperature::operator=(const Temperature& rhs)
         TemperatureProfile = rhs.TemperatureProfile;
 
         ControlParameters  = rhs.ControlParameters;
+
+        PropertyCacheTolerance = rhs.PropertyCacheTolerance;
+        ResetCache();
     }
     return *this;
 }
@@ -1186,8 +1343,10 @@ void Temperature::CalculateInterfaceAverage(PhaseField& Phi)
     Tiavg = locTiavg;
 
 #ifdef MPI_PARALLEL
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, NpointsAB.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
-    OP_MPI_Allreduce(OP_MPI_IN_PLACE, Tiavg.data(), Nphases*Nphases, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    ReductionBatch Batch;
+    Batch.Sum(NpointsAB.data(), Nphases*Nphases);
+    Batch.Sum(Tiavg.data(), Nphases*Nphases);
+    Batch.Reduce();
 #endif
 
     for(size_t alpha =     0; alpha < Nphases; alpha++)
@@ -34,6 +34,7 @@
 #include "Nucleation.h"
 #include "TextOutput.h"
 #include "Composition.h"
+#include "TimeSeriesOutput.h"
 
 namespace openphase
 {
@@ -45,18 +46,13 @@ void TextOutput::WriteValue(double Value, string filename, double time)
     if(MPI_RANK == 0)
 #endif
     {
-        if (!std::filesystem::exists(filename))
-        {
-            ofstream file(filename, ios::out);
-            file << "time"
-                 << separator << "Value\n";
-            file.close();
-        }
-
-        ofstream file(filename, ios::app);
+        stringstream header;
+        header << "time"
+               << separator << "Value\n";
 
-        file << time << separator << Value << "\n";
-        file.close();
+        stringstream line;
+        line << time << separator << Value << "\n";
+        TimeSeriesOutput::Append(filename, header.str(), line.str());
     }
 }
 
@@ -66,26 +62,22 @@ void TextOutput::WriteMultipleValues(std::vector<string> Names, std::vector<doub
     if(MPI_RANK == 0)
 #endif
     {
-        if (!std::filesystem::exists(filename))
+        stringstream header;
+        header << "time";
+        for (auto& N : Names)
         {
-            ofstream file(filename, ios::out);
-            file << "time";
-            for (auto& N : Names)
-            {
-                file << separator << N;
-            }
-            file << "\n";
-            file.close();
+            header << separator << N;
         }
+        header << "\n";
 
-        ofstream file(filename, ios::app);
-        file << time << scientific;
+        stringstream line;
+        line << time << scientific;
         for (auto& V : value)
         {
-          file << " , " << V;
+          line << " , " << V;
         }
-        file << "\n";
-        file.close();
+        line << "\n";
+        TimeSeriesOutput::Append(filename, header.str(), line.str());
     }
 }
 
@@ -95,26 +87,22 @@ void TextOutput::WritedVectorNValues(std::vector<string> Names, dVectorN value,
     if(MPI_RANK == 0)
 #endif
     {
-        if (!std::filesystem::exists(filename))
+        stringstream header;
+        header << "time";
+        for (auto& N : Names)
         {
-            ofstream file(filename, ios::out);
-            file << "time";
-            for (auto& N : Names)
-            {
-                file << separator << N;
-            }
-            file << "\n";
-            file.close();
+            header << separator << N;
         }
+        header << "\n";
 
-        ofstream file(filename, ios::app);
-        file << time << scientific;
+        stringstream line;
+        line << time << scientific;
         for (size_t i = 0; i < value.size(); i++ )
         {
-          file << " , " << value[i];
+          line << " , " << value[i];
         }
-        file << "\n";
-        file.close();
+        line << "\n";
+        TimeSeriesOutput::Append(filename, header.str(), line.str());
     }
 }
 
@@ -152,29 +140,25 @@ void TextOutput::AveragePlasticStrain(ElasticProperties& EP, string filename,
 #endif
     {
         averagePEEQ /= double(EP.Grid.TotalNumberOfCells());
-    if (!std::filesystem::exists(filename))
-    {
-        ofstream file(filename, ios::out);
-        file << "time"
-             << separator << "Epsilon_0"
-             << separator << "Epsilon_1"
-             << separator << "Epsilon_2"
-             << separator << "Epsilon_3"
-             << separator << "Epsilon_4"
-             << separator << "Epsilon_5"
-             << separator << "PEEQ"
-             << separator << "Rate_0"
-             << separator << "Rate_1"
-             << separator << "Rate_2"
-             << separator << "Rate_3"
-             << separator << "Rate_4"
-             << separator << "Rate_5\n";
-        file.close();
-    }
-
-    ofstream file(filename, ios::app);
-    file.precision(precision);
-    file << timeOrStrain << scientific
+    stringstream header;
+    header << "time"
+           << separator << "Epsilon_0"
+           << separator << "Epsilon_1"
+           << separator << "Epsilon_2"
+           << separator << "Epsilon_3"
+           << separator << "Epsilon_4"
+           << separator << "Epsilon_5"
+           << separator << "PEEQ"
+           << separator << "Rate_0"
+           << separator << "Rate_1"
+           << separator << "Rate_2"
+           << separator << "Rate_3"
+           << separator << "Rate_4"
+           << separator << "Rate_5\n";
+
+    stringstream line;
+    line.precision(precision);
+    line << timeOrStrain << scientific
          << separator << avgStrain[0]
          << separator << avgStrain[1]
          << separator << avgStrain[2]
@@ -188,7 +172,7 @@ void TextOutput::AveragePlasticStrain(ElasticProperties& EP, string filename,
          << separator << Rate[3]
          << separator << Rate[4]
          << separator << Rate[5] << "\n";
-    file.close();
+    TimeSeriesOutput::Append(filename, header.str(), line.str());
     }
 }
 void TextOutput::maxElasticRotation(ElasticProperties& EP, PhaseField& Phase,Orientations& OR, int tStep, string Filename)
@@ -496,28 +480,24 @@ NodeAB<double,double> TextOutput::IntegrateDG(PhaseField& Phase, DrivingForce& d
     if(MPI_RANK == 0)
     #endif
     {
-        if (!std::filesystem::exists(filename) or RealTime == 0.)
+        stringstream header;
+        header << "Time";
+        for (size_t i = 0; i < Phase.Nphases; ++i)
+        for (size_t j = i+1; j < Phase.Nphases; ++j)
         {
-            ofstream file(filename, ios::out | ios::trunc);
-            file << "Time";
-            for (size_t i = 0; i < Phase.Nphases; ++i)
-            for (size_t j = i+1; j < Phase.Nphases; ++j)
-            {
-                file << separator << "dG_" << i << "_" << j;
-            }
-            file << "\n";
-            file.close();
+            header << separator << "dG_" << i << "_" << j;
         }
+        header << "\n";
 
-        ofstream file(filename, ios::app);
-        file << RealTime;
+        stringstream line;
+        line << RealTime;
         for (size_t i = 0; i < Phase.Nphases; ++i)
         for (size_t j = i+1; j < Phase.Nphases; ++j)
         {
-            file << separator << dg.get_asym1(i,j);
+            line << separator << dg.get_asym1(i,j);
         }
-        file << "\n";
-        file.close();
+        line << "\n";
+        TimeSeriesOutput::Append(filename, header.str(), line.str(), RealTime == 0.);
     }
     return dg;
 }
@@ -573,28 +553,24 @@ NodeAB<double,double> TextOutput::IntegrateDG(PhaseField& Phase, DrivingForce& d
     if(MPI_RANK == 0)
     #endif
     {
-        if (!std::filesystem::exists(filename) or RealTime == 0.)
+        stringstream header;
+        header << "Time";
+        for (size_t i = 0; i < Phase.Nphases; ++i)
+        for (size_t j = i+1; j < Phase.Nphases; ++j)
         {
-            ofstream file(filename, ios::out);
-            file << "Time";
-            for (size_t i = 0; i < Phase.Nphases; ++i)
-            for (size_t j = i+1; j < Phase.Nphases; ++j)
-            {
-                file << separator << "dG_" << i << "_" << j;
-            }
-            file << "\n";
-            file.close();
+            header << separator << "dG_" << i << "_" << j;
         }
+        header << "\n";
 
-        ofstream file(filename, ios::app);
-        file << RealTime;
+        stringstream line;
+        line << RealTime;
         for (size_t i = 0; i < Phase.Nphases; ++i)
         for (size_t j = i+1; j < Phase.Nphases; ++j)
         {
-            file << separator << dg.get_asym1(i,j)-dgold.get_asym1(i,j);
+            line << separator << dg.get_asym1(i,j)-dgold.get_asym1(i,j);
         }
-        file << "\n";
-        file.close();
+        line << "\n";
+        TimeSeriesOutput::Append(filename, header.str(), line.str(), RealTime == 0.);
     }
     return dg;
 }
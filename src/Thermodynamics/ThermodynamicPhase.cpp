@@ -426,29 +426,26 @@ bool ThermodynamicPhase::get_isStoichiometric(void)
     return isStoich;
 }
 
-vector<vector<double> > ThermodynamicPhase::getdMAdYi(void)
+vector<double> ThermodynamicPhase::getdMAdYi(void)
 {
     /**This matrix is populated with values for dM_A/dY_i, which are necessary
-    for calculation of chemical potentials*/
+    for calculation of chemical potentials. It is stored densely in one
+    contiguous array, component major: dMAdYi[comp*Ncons + con].*/
 
-    vector<vector<double> > result;
+    vector<double> result(Ncomp*Ncons, 0.0);
 
     for(size_t comp = 0; comp < Ncomp; comp++)
     {
-        vector<double> tempcons(Ncons, 0.0);
-
         size_t counter = 0;
         for(size_t sub = 0; sub < Nsubs; sub++)
         for(size_t con = 0; con < Sublattice[sub].Ncons; con++)
         {
             if(Sublattice[sub].Constituent[con].Index == Component[comp].Index)
             {
-                tempcons[counter] = Sublattice[sub].Site;
+                result[comp*Ncons + counter] = Sublattice[sub].Site;
             }
             counter++;
         }
-
-        result.push_back(tempcons);
     }
 
     return result;
@@ -474,4 +471,171 @@ bool ThermodynamicPhase::getAnalyticChemicalPotentials(void)
     return result;
 }
 
+
+void ThermodynamicPhase::SetConstituentLayout(void)
+{
+    /**This function fills the flattened constituent layout used by the batched
+    kernels MoleFractions() and ConfigurationalGibbsEnergy(). For the phase
+    (A,B)_1 (A,VA)_3 with the components A and B it will hold
+    ConsSite = [1,1,3,3], ConsSubl = [0,0,1,1] and ConsComp = [0,1,0,-1].*/
+    Nsubs = getNsubs();
+    for(size_t sub = 0; sub < Nsubs; sub++)
+    {
+        Sublattice[sub].Initialize();
+    }
+    Ncomp   = getNcomp();
+    Ncons   = getNcons();
+    SublIdx = getSublIdx();
+    ConsIdx = getConsIdx();
+    dMAdYi  = getdMAdYi();
+
+    ConsSite.assign(Ncons, 0.0);
+    ConsSubl.assign(Ncons, 0);
+    ConsComp.assign(Ncons, -1);
+    for(size_t sub = 0; sub < Nsubs; sub++)
+    for(size_t con = SublIdx[sub]; con < SublIdx[sub+1]; con++)
+    {
+        ConsSite[con] = Sublattice[sub].Site;
+        ConsSubl[con] = sub;
+        for(size_t comp = 0; comp < Ncomp; comp++)
+        if(Component[comp].Index == ConsIdx[con] and ConsIdx[con] >= 0)
+        {
+            ConsComp[con] = comp;
+        }
+    }
+}
+
+void ThermodynamicPhase::MoleFractions(const double* Y, double* X,
+                                       const size_t nCells) const
+{
+    /**This function converts the site fractions Y[con*nCells + cell] of a
+    batch of cells into the mole fractions X[comp*nCells + cell]. Vacancies do
+    not contribute to the number of moles.*/
+    vector<double> Nmoles(nCells, 0.0);
+    for(size_t n = 0; n < Ncomp*nCells; n++)
+    {
+        X[n] = 0.0;
+    }
+    for(size_t con = 0; con < ConsSite.size(); con++)
+    if(ConsComp[con] >= 0)
+    {
+        const double site = ConsSite[con];
+        const double* y = Y + con*nCells;
+        double* x = X + ConsComp[con]*nCells;
+        #pragma omp simd
+        for(size_t cell = 0; cell < nCells; cell++)
+        {
+            x[cell]      += site*y[cell];
+            Nmoles[cell] += site*y[cell];
+        }
+    }
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    {
+        double* x = X + comp*nCells;
+        #pragma omp simd
+        for(size_t cell = 0; cell < nCells; cell++)
+        {
+            x[cell] = (Nmoles[cell] > 0.0) ? x[cell]/Nmoles[cell] : 0.0;
+        }
+    }
+}
+
+void ThermodynamicPhase::ConfigurationalGibbsEnergy(const double* Y,
+        const double* T, double* G, double* dGdY, double* d2GdY2,
+        const size_t nCells) const
+{
+    /**This function evaluates the ideal mixing contribution of the sublattice
+    model G = RT sum_s a_s sum_i y_i ln(y_i) per formula unit for a batch of
+    cells together with dG/dy_i = RT a_s (ln(y_i) + 1) and the diagonal
+    d2G/dy_i^2 = RT a_s/y_i of the Hessian, the off-diagonal entries are zero.
+    Site fractions are bounded from below by SiteFractionMin to keep the
+    logarithm finite. dGdY and d2GdY2 may be nullptr if not needed.*/
+    const double SiteFractionMin = 1.0e-15;
+    for(size_t cell = 0; cell < nCells; cell++)
+    {
+        G[cell] = 0.0;
+    }
+    for(size_t con = 0; con < ConsSite.size(); con++)
+    {
+        const double site = ConsSite[con]*PhysicalConstants::R;
+        const double* y = Y + con*nCells;
+        double* dg  = (dGdY   != nullptr) ? dGdY   + con*nCells : nullptr;
+        double* d2g = (d2GdY2 != nullptr) ? d2GdY2 + con*nCells : nullptr;
+        #pragma omp simd
+        for(size_t cell = 0; cell < nCells; cell++)
+        {
+            const double locY = std::max(y[cell], SiteFractionMin);
+            const double lnY  = std::log(locY);
+            G[cell] += site*T[cell]*locY*lnY;
+        }
+        if(dg != nullptr)
+        {
+            #pragma omp simd
+            for(size_t cell = 0; cell < nCells; cell++)
+            {
+                dg[cell] = site*T[cell]*(std::log(std::max(y[cell], SiteFractionMin)) + 1.0);
+            }
+        }
+        if(d2g != nullptr)
+        {
+            #pragma omp simd
+            for(size_t cell = 0; cell < nCells; cell++)
+            {
+                d2g[cell] = site*T[cell]/std::max(y[cell], SiteFractionMin);
+            }
+        }
+    }
+}
+
+void ThermodynamicPhase::MoleFractionJacobian(const double* Y, double* dXdY,
+                                              const size_t nCells) const
+{
+    /**This function evaluates the derivatives of the mole fractions with
+    respect to the site fractions for a batch of cells from the precomputed
+    matrix dMAdYi: with the moles M_A = sum_i dMAdYi[A][i] y_i and
+    M = sum_A M_A it is dX_A/dy_i = (dMAdYi[A][i] - X_A dM/dy_i)/M. Y is
+    stored constituent major Y[con*nCells + cell], the result
+    dXdY[(comp*Ncons + con)*nCells + cell].*/
+    vector<double> dMdYi(Ncons, 0.0);
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    for(size_t con = 0; con < Ncons; con++)
+    {
+        dMdYi[con] += dMAdYi[comp*Ncons + con];
+    }
+
+    vector<double> InverseNmoles(nCells, 0.0);
+    vector<double> M(Ncomp*nCells, 0.0);
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    for(size_t con = 0; con < Ncons; con++)
+    if(dMAdYi[comp*Ncons + con] != 0.0)
+    {
+        const double dM = dMAdYi[comp*Ncons + con];
+        const double* y = Y + con*nCells;
+        double* m = M.data() + comp*nCells;
+        #pragma omp simd
+        for(size_t cell = 0; cell < nCells; cell++)
+        {
+            m[cell]             += dM*y[cell];
+            InverseNmoles[cell] += dM*y[cell];
+        }
+    }
+    for(size_t cell = 0; cell < nCells; cell++)
+    {
+        InverseNmoles[cell] = (InverseNmoles[cell] > 0.0) ? 1.0/InverseNmoles[cell] : 0.0;
+    }
+
+    for(size_t comp = 0; comp < Ncomp; comp++)
+    for(size_t con = 0; con < Ncons; con++)
+    {
+        const double dMA = dMAdYi[comp*Ncons + con];
+        const double dM  = dMdYi[con];
+        const double* m = M.data() + comp*nCells;
+        double* result = dXdY + (comp*Ncons + con)*nCells;
+        #pragma omp simd
+        for(size_t cell = 0; cell < nCells; cell++)
+        {
+            result[cell] = (dMA - m[cell]*InverseNmoles[cell]*dM)*InverseNmoles[cell];
+        }
+    }
+}
 }
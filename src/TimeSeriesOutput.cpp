@@ -0,0 +1,141 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "TimeSeriesOutput.h"
+#include "ConsoleOutput.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace openphase
+{
+using namespace std;
+
+struct TimeSeriesFile                                                           ///< Open file and its pending lines
+{
+    ofstream File;
+    string Pending;
+    size_t Entries = 0;                                                         ///< Number of pending lines
+
+    void Write(void)
+    {
+        if(Entries == 0) return;
+        File << Pending;
+        File.flush();
+        Pending.clear();
+        Entries = 0;
+    }
+};
+
+/* State of the service, all members are protected by Mutex */
+struct TimeSeriesOutputState
+{
+    mutex Mutex;
+    map<string, TimeSeriesFile> Files;
+    size_t FlushEntries = 64;
+    double FlushInterval = 10.0;                                                ///< Seconds
+    chrono::steady_clock::time_point LastFlush = chrono::steady_clock::now();
+
+    void WriteAll(void)
+    {
+        for(auto& [Name, Series] : Files)
+        {
+            Series.Write();
+        }
+        LastFlush = chrono::steady_clock::now();
+    }
+
+    ~TimeSeriesOutputState()                                                    ///< Writes the pending lines at program exit
+    {
+        lock_guard<mutex> lock(Mutex);
+        WriteAll();
+    }
+};
+
+static TimeSeriesOutputState& State(void)
+{
+    static TimeSeriesOutputState state;
+    return state;
+}
+
+void TimeSeriesOutput::Configure(const size_t FlushEntries, const double FlushInterval)
+{
+    TimeSeriesOutputState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    S.FlushEntries  = max<size_t>(FlushEntries, 1);
+    S.FlushInterval = FlushInterval;
+}
+
+void TimeSeriesOutput::Append(const string& FileName, const string& Header,
+                              const string& Line, const bool Restart)
+{
+    TimeSeriesOutputState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+
+    auto it = S.Files.find(FileName);
+    if(it == S.Files.end() or Restart)
+    {
+        /* The file system is queried only when the file is opened */
+        const bool NewFile = Restart or not filesystem::exists(FileName);
+        TimeSeriesFile& Series = S.Files[FileName];
+        if(Series.File.is_open()) Series.File.close();
+        Series.Pending.clear();
+        Series.Entries = 0;
+        Series.File.open(FileName, NewFile ? ios::out : ios::app);
+        if(not Series.File)
+        {
+            ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be opened", thisclassname, "Append()");
+        }
+        if(NewFile) Series.File << Header;
+        it = S.Files.find(FileName);
+    }
+    TimeSeriesFile& Series = it->second;
+    if(not Series.File) return;
+
+    Series.Pending += Line;
+    Series.Entries++;
+    if(Series.Entries >= S.FlushEntries) Series.Write();
+
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - S.LastFlush;
+    if(elapsed.count() >= S.FlushInterval) S.WriteAll();
+}
+
+void TimeSeriesOutput::Flush(void)
+{
+    TimeSeriesOutputState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    S.WriteAll();
+}
+
+void TimeSeriesOutput::Close(void)
+{
+    TimeSeriesOutputState& S = State();
+    lock_guard<mutex> lock(S.Mutex);
+    S.WriteAll();
+    S.Files.clear();
+}
+
+}// namespace openphase
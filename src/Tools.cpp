@@ -28,6 +28,7 @@
 #include "Tools.h"
 #include "Crystallography.h"
 #include "PhaseField.h"
+#include "Tools/RandomNumbers.h"
 
 namespace openphase
 {
@@ -677,6 +678,55 @@ double Tools::getDisorientationCubic(const Quaternion OrientationA, const Quater
     return misorientation;
 }
 
+double Tools::getDisorientationCubic(const Quaternion OrientationA, const Quaternion OrientationB, dVector3& Axis)
+{
+    /* The scalar part of deltaQ*S for the 24 proper rotations S of the cubic
+    group is a signed sum of the components of deltaQ (Grimmer 1974), the
+    largest one selects the symmetry operator of the disorientation. Only the
+    selected product is evaluated in full. Its axis is moved into the standard
+    triangle [001]-[101]-[111] by the symmetry operators, i.e. by taking the
+    absolute values of the components and sorting them. */
+    const double r = 1.0/sqrt(2.0);
+    static const double S[24][4] = {
+        {1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+        {r, r, 0, 0}, {r,-r, 0, 0}, {r, 0, r, 0}, {r, 0,-r, 0},
+        {r, 0, 0, r}, {r, 0, 0,-r}, {0, r, r, 0}, {0, r,-r, 0},
+        {0, r, 0, r}, {0, r, 0,-r}, {0, 0, r, r}, {0, 0, r,-r},
+        {0.5, 0.5, 0.5, 0.5}, {0.5, 0.5, 0.5,-0.5}, {0.5, 0.5,-0.5, 0.5}, {0.5, 0.5,-0.5,-0.5},
+        {0.5,-0.5, 0.5, 0.5}, {0.5,-0.5, 0.5,-0.5}, {0.5,-0.5,-0.5, 0.5}, {0.5,-0.5,-0.5,-0.5}};
+
+    const Quaternion deltaQ = OrientationA*OrientationB.inverted();
+
+    int    best = 0;
+    double bestW = -1.0;
+    for(int s = 0; s < 24; s++)
+    {
+        double w = fabs(deltaQ[0]*S[s][0] - deltaQ[1]*S[s][1] -
+                        deltaQ[2]*S[s][2] - deltaQ[3]*S[s][3]);
+        if(w > bestW)
+        {
+            bestW = w;
+            best  = s;
+        }
+    }
+    Quaternion Sym;
+    Sym.set(S[best][0], S[best][1], S[best][2], S[best][3]);
+    const Quaternion Q = deltaQ*Sym;
+
+    std::array<double,3> v = {fabs(Q[1]), fabs(Q[2]), fabs(Q[3])};
+    std::sort(v.begin(), v.end());
+    const double norm = sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+    if(norm > DBL_EPSILON)
+    {
+        Axis = dVector3({v[1]/norm, v[0]/norm, v[2]/norm});
+    }
+    else
+    {
+        Axis = dVector3({0.0, 0.0, 0.0});
+    }
+    return 2.0*acos(std::min(bestW, 1.0));
+}
+
 EulerAngles Tools::RotationToEuler(const dMatrix3x3& Rot, const EulerConvention EConvention )
 {
     EulerAngles Euler;
@@ -773,16 +823,11 @@ void Tools::SetRandomGrainOrientations(PhaseField& Phase, const int seed)
     // uniform sampling of quaternion parameters using the method presented in (Shoemake, 1992)
     // taken from :: http://planning.cs.uiuc.edu/node198.html#eqn:shoemake
 
-    default_random_engine generator(seed);
-
-    uniform_real_distribution <double> Q1Distribution(0, 1.0);
-    uniform_real_distribution <double> Q2Distribution(0, 1.0);
-    uniform_real_distribution <double> Q3Distribution(0, 1.0);
-
-    uniform_real_distribution <double> A1Distribution(0.0, 2.0*Pi);
-    uniform_real_distribution <double> A2Distribution(0.0, 2.0*Pi);
-    uniform_real_distribution <double> A3Distribution(0.0, 2.0*Pi);
+    // The random numbers of a grain are keyed by its index, the grains are
+    // independent and can be processed in parallel
+    const RandomNumbers RNG(seed);
 
+    #pragma omp parallel for schedule(static)
     for(size_t alpha = 0; alpha < Phase.FieldsProperties.size(); alpha++)
     if(Phase.FieldsProperties[alpha].Exist)
     {
@@ -799,18 +844,18 @@ void Tools::SetRandomGrainOrientations(PhaseField& Phase, const int seed)
                 double a1 = 0.0;
                 double a2 = 0.0;
                 double a3 = 0.0;
-                if(Phase.Grid.dNx == 0) a1 = A1Distribution(generator);
-                if(Phase.Grid.dNy == 0) a2 = A2Distribution(generator);
-                if(Phase.Grid.dNz == 0) a3 = A3Distribution(generator);
+                if(Phase.Grid.dNx == 0) a1 = 2.0*Pi*RNG.Uniform(0, alpha, 0, 0);
+                if(Phase.Grid.dNy == 0) a2 = 2.0*Pi*RNG.Uniform(0, alpha, 0, 1);
+                if(Phase.Grid.dNz == 0) a3 = 2.0*Pi*RNG.Uniform(0, alpha, 0, 2);
                 EulerAngles ph1({a1,a2,a3},XYZ);
                 Phase.FieldsProperties[alpha].Orientation = ph1.getQuaternion().normalized();
                 break;
             }
             case 3: // 3D Full Rotation
             {
-                double u1 = Q1Distribution(generator);
-                double u2 = Q2Distribution(generator);
-                double u3 = Q3Distribution(generator);
+                double u1 = RNG.Uniform(0, alpha, 0, 0);
+                double u2 = RNG.Uniform(0, alpha, 0, 1);
+                double u3 = RNG.Uniform(0, alpha, 0, 2);
 
                 tempQuat.set(sqrt(1.0-u1)*sin(2.0*Pi*u2),
                              sqrt(1.0-u1)*cos(2.0*Pi*u2),
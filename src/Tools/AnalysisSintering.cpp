@@ -391,6 +391,18 @@ double AnalysisSintering::CalculateDensity_LineIntersection(
     return DensityLI;
 }
 
+std::vector<ConnectedComponents::Component_t> AnalysisSintering::Pores(const PhaseField& Phase,
+        const BoundaryConditions& BC, const size_t GasPhaseIdx)
+{
+    Storage3D<size_t,0> Labels;
+    auto GasKey = [&Phase, GasPhaseIdx](long int i, long int j, long int k) -> long int
+    {
+        return (Phase.Fields(i,j,k).size() and
+                Phase.FieldsProperties[Phase.Fields(i,j,k).majority_index()].Phase == GasPhaseIdx) ? 0 : -1;
+    };
+    return ConnectedComponents::Label(Phase.Grid, BC, GasKey, Labels);
+}
+
 void AnalysisSintering::DoDiagnostics(Settings& locSettings, PhaseField& Phase,
         DoubleObstacle& DO, InterfaceProperties& IP, 
         GrandPotentialDensity& omega, GrandPotentialSolver& GPS, RunTimeControl& RTC)
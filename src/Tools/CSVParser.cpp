@@ -25,20 +25,32 @@
  */
 
 #include "Tools/CSVParser.h"
+#include "MappedFile.h"
+#include "Embedded.h"
+#include <charconv>
 
 namespace openphase
 {
 using namespace std;
 
-void CSVParser::WriteHeader(const std::string fileName,
-    const std::vector<std::string> headerArray, const std::string seperator)
+void CSVParser::Output(const std::string& fileName, const std::string& Text,
+                       const bool Append, const std::string& Method)
 {
-    std::ofstream file(fileName.c_str());
+    if (Embedded::WriteFile(fileName, Text, Append)) return;
+
+    std::ofstream file(fileName.c_str(), Append ? ios_base::app : ios_base::trunc);
     if (!file)
     {
-        ConsoleOutput::WriteExit("File \"" + fileName + "\" could not be opened", "CSVParser", "WriteHeader()");
+        ConsoleOutput::WriteExit("File \"" + fileName + "\" could not be opened", "CSVParser", Method);
         OP_Exit(EXIT_FAILURE);
     }
+    file << Text;
+}
+
+void CSVParser::WriteHeader(const std::string fileName,
+    const std::vector<std::string> headerArray, const std::string seperator)
+{
+    std::stringstream file;
     if (headerArray.size() == 0)
     {
         ConsoleOutput::WriteWarning("Tried to write empty header array", "CSVParser", "WriteHeader()");
@@ -51,29 +63,18 @@ void CSVParser::WriteHeader(const std::string fileName,
         }
         file << headerArray.back() << endl;
     }
-    file.close();
+    Output(fileName, file.str(), false, "WriteHeader()");
 }
 
 void CSVParser::ClearContent(const std::string fileName)
 {
-    std::ofstream file(fileName.c_str(), ios_base::trunc);
-    if (!file)
-    {
-        ConsoleOutput::WriteExit("File \"" + fileName + "\" could not be opened", "CSVParser", "ClearContent()");
-        OP_Exit(EXIT_FAILURE);
-    }
-    file.close();
+    Output(fileName, "", false, "ClearContent()");
 }
 
 void CSVParser::WriteData(const std::string fileName,
         const std::vector<int> dataArray, const std::string seperator)
 {
-    std::ofstream file(fileName.c_str(), ios_base::app);
-    if (!file)
-    {
-        ConsoleOutput::WriteExit("File \"" + fileName + "\" could not be opened", "CSVParser", "WriteData()");
-        OP_Exit(EXIT_FAILURE);
-    }
+    std::stringstream file;
     if (dataArray.size() == 0)
     {
         ConsoleOutput::WriteWarning("Tried to write empty data array", "CSVParser", "WriteData()");
@@ -86,18 +87,13 @@ void CSVParser::WriteData(const std::string fileName,
         }
         file << dataArray.back() << endl;
     }
-    file.close();
+    Output(fileName, file.str(), true, "WriteData()");
 }
 
 void CSVParser::WriteData(const std::string fileName,
         const std::vector<double> dataArray, const std::string seperator)
 {
-    std::ofstream file(fileName.c_str(), ios_base::app);
-    if (!file)
-    {
-        ConsoleOutput::WriteExit("File \"" + fileName + "\" could not be opened", "CSVParser", "WriteData()");
-        OP_Exit(EXIT_FAILURE);
-    }
+    std::stringstream file;
     if (dataArray.size() == 0)
     {
         ConsoleOutput::WriteWarning("Tried to write empty data array", "CSVParser", "WriteData()");
@@ -110,7 +106,7 @@ void CSVParser::WriteData(const std::string fileName,
         }
         file << dataArray.back() << endl;
     }
-    file.close();
+    Output(fileName, file.str(), true, "WriteData()");
 }
 
 void CSVParser::readFile(std::string& fileName,
@@ -199,4 +195,102 @@ void CSVParser::readFile(std::string& fileName,
     file.close();
 }
 
+size_t CSVParser::ReadIntegerRows(const std::string& fileName,
+    const size_t Ncolumns, const char separator,
+    const std::function<void(const long int*, size_t, int)>& Process)
+{
+    MappedFile File;
+    if (!File.Open(fileName))
+    {
+        ConsoleOutput::WriteExit("File \"" + fileName + "\" could not be opened", "CSVParser", "ReadIntegerRows()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    const char* Begin = File.data();
+    const char* End   = File.data() + File.size();
+
+    /* Chunk borders are moved forward to the next line start */
+    const int Nchunks = omp_get_max_threads();
+    std::vector<const char*> Borders(Nchunks + 1, End);
+    Borders[0] = Begin;
+    for (int c = 1; c < Nchunks; c++)
+    {
+        const char* Border = std::max(Begin + File.size()*c/Nchunks, Borders[c-1]);
+        if (Border > Begin and Border < End and Border[-1] != '\n')
+        {
+            const char* NewLine = static_cast<const char*>(memchr(Border, '\n', End - Border));
+            Border = (NewLine) ? NewLine + 1 : End;
+        }
+        Borders[c] = Border;
+    }
+
+    /* Number of rows in each chunk gives the position of its first row */
+    std::vector<size_t> FirstRow(Nchunks + 1, 0);
+    #pragma omp parallel for schedule(static,1)
+    for (int c = 0; c < Nchunks; c++)
+    {
+        size_t Nrows = std::count(Borders[c], Borders[c+1], '\n');
+        if (Borders[c+1] > Borders[c] and Borders[c+1][-1] != '\n') Nrows++;
+        FirstRow[c+1] = Nrows;
+    }
+    for (int c = 0; c < Nchunks; c++) FirstRow[c+1] += FirstRow[c];
+
+    std::vector<size_t> ErrorRow(Nchunks, FirstRow[Nchunks]);
+    std::vector<std::string> ErrorMessage(Nchunks);
+    #pragma omp parallel for schedule(static,1)
+    for (int c = 0; c < Nchunks; c++)
+    {
+        const int thread = omp_get_thread_num();
+        std::vector<long int> Row(Ncolumns);
+        size_t RowNumber = FirstRow[c];
+        for (const char* Line = Borders[c]; Line < Borders[c+1]; RowNumber++)
+        {
+            const char* LineEnd = static_cast<const char*>(memchr(Line, '\n', Borders[c+1] - Line));
+            if (!LineEnd) LineEnd = Borders[c+1];
+            const char* Stop = (LineEnd > Line and LineEnd[-1] == '\r') ? LineEnd - 1 : LineEnd;
+
+            size_t Ncells = 0;
+            for (const char* Cell = Line; Cell < Stop; )
+            {
+                const char* CellEnd = std::find(Cell, Stop, separator);
+                const char* Number = Cell;
+                while (Number < CellEnd and (*Number == ' ' or *Number == '\t')) Number++;
+                if (Number < CellEnd and *Number == '+') Number++;
+
+                long int value = 0;
+                auto result = std::from_chars(Number, CellEnd, value);
+                if (result.ec != std::errc())
+                {
+                    ErrorMessage[c] = ((result.ec == std::errc::result_out_of_range) ?
+                                       "Out of range: " : "Invalid argument: ") + std::string(Cell, CellEnd);
+                    break;
+                }
+                if (Ncells < Ncolumns) Row[Ncells] = value;
+                Ncells++;
+                Cell = CellEnd + 1;
+            }
+            if (ErrorMessage[c].empty() and Ncells != Ncolumns)
+            {
+                ErrorMessage[c] = "Wrong data format. Expected " + std::to_string(Ncolumns) +
+                                  " columns, found " + std::to_string(Ncells);
+            }
+            if (!ErrorMessage[c].empty())
+            {
+                ErrorRow[c] = RowNumber;
+                break;
+            }
+            Process(Row.data(), RowNumber, thread);
+            Line = LineEnd + 1;
+        }
+    }
+
+    for (int c = 0; c < Nchunks; c++)
+    if (!ErrorMessage[c].empty())
+    {
+        ConsoleOutput::WriteExit("Line " + std::to_string(ErrorRow[c] + 1) + " of \"" + fileName + "\": " +
+                                 ErrorMessage[c], "CSVParser", "ReadIntegerRows()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    return FirstRow[Nchunks];
+}
+
 }// namespace openphase
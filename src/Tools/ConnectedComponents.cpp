@@ -0,0 +1,346 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "Tools/ConnectedComponents.h"
+#include "Tools/ReductionBatch.h"
+#include "BoundaryConditions.h"
+#include "GridParameters.h"
+#include "PhaseField.h"
+#include <numeric>
+
+namespace openphase
+{
+
+using namespace std;
+
+static size_t FindRoot(vector<size_t>& Parent, size_t n)
+{
+    while(Parent[n] != n)
+    {
+        Parent[n] = Parent[Parent[n]];
+        n = Parent[n];
+    }
+    return n;
+}
+
+static size_t Root(const vector<size_t>& Parent, size_t n)
+{
+    while(Parent[n] != n) n = Parent[n];
+    return n;
+}
+
+static void Unite(vector<size_t>& Parent, size_t a, size_t b)
+{
+    /* The smaller root becomes the parent, the root of a component is its
+    first cell and does not depend on the order of the unions. */
+    a = FindRoot(Parent, a);
+    b = FindRoot(Parent, b);
+    if(a < b) Parent[b] = a;
+    else if(b < a) Parent[a] = b;
+}
+
+vector<ConnectedComponents::Component_t> ConnectedComponents::Label(
+        const GridParameters& Grid, const BoundaryConditions& BC,
+        const Key_t& Key, Storage3D<size_t,0>& Labels)
+{
+    if(Labels.IsNotAllocated())
+    {
+        Labels.Allocate(Grid, 1);
+    }
+
+    const long int Size[3] = {Labels.sizeX(), Labels.sizeY(), Labels.sizeZ()};
+    const long int Offset[3] = {Grid.OffsetX, Grid.OffsetY, Grid.OffsetZ};
+    const long int Total[3] = {Grid.TotalNx, Grid.TotalNy, Grid.TotalNz};
+    const bool Active[3] = {Grid.dNx != 0, Grid.dNy != 0, Grid.dNz != 0};
+    const bool Periodic[3] = {BC.BC0X == BoundaryConditionTypes::Periodic,
+                              BC.BC0Y == BoundaryConditionTypes::Periodic,
+                              BC.BC0Z == BoundaryConditionTypes::Periodic};
+    const size_t Stride[3] = {size_t(Size[1]*Size[2]), size_t(Size[2]), 1};
+    const size_t Ncells = size_t(Size[0])*Stride[0];
+
+    auto Position = [&Size, &Stride](const size_t n)
+    {
+        return array<long int,3>{long(n/Stride[0]), long(n/Stride[1])%Size[1], long(n%Size[2])};
+    };
+    /* Neighbors beyond a non-periodic domain boundary do not exist, the
+    values in these halo cells only reflect the boundary condition. */
+    auto Exists = [&](const array<long int,3>& x)
+    {
+        for(int d = 0; d < 3; d++)
+        if((x[d] < 0 or x[d] >= Size[d]) and not Periodic[d] and
+           (Offset[d] + x[d] < 0 or Offset[d] + x[d] >= Total[d]))
+        {
+            return false;
+        }
+        return true;
+    };
+
+    vector<long int> Keys(Ncells);
+    vector<size_t> Parent(Ncells);
+    #pragma omp parallel for schedule(static)
+    for(size_t n = 0; n < Ncells; n++)
+    {
+        const array<long int,3> x = Position(n);
+        Keys[n] = Key(x[0], x[1], x[2]);
+        Parent[n] = n;
+    }
+
+    // Union-find within contiguous ranges of cells, one per thread
+    const size_t Nchunks = max<size_t>(1, min<size_t>(omp_get_max_threads(), Ncells));
+    auto ChunkBegin = [Ncells, Nchunks](const size_t c){return Ncells*c/Nchunks;};
+
+    #pragma omp parallel for schedule(static,1)
+    for(size_t c = 0; c < Nchunks; c++)
+    for(size_t n = ChunkBegin(c); n < ChunkBegin(c+1); n++)
+    if(Keys[n] >= 0)
+    {
+        const array<long int,3> x = Position(n);
+        for(int d = 0; d < 3; d++)
+        if(x[d] > 0 and n - Stride[d] >= ChunkBegin(c) and Keys[n - Stride[d]] == Keys[n])
+        {
+            Unite(Parent, n, n - Stride[d]);
+        }
+    }
+    // Joining the ranges, only the first plane of a range has neighbors in preceding ranges
+    for(size_t c = 1; c < Nchunks; c++)
+    for(size_t n = ChunkBegin(c); n < min(ChunkBegin(c+1), ChunkBegin(c) + Stride[0]); n++)
+    if(Keys[n] >= 0)
+    {
+        const array<long int,3> x = Position(n);
+        for(int d = 0; d < 3; d++)
+        if(x[d] > 0 and n - Stride[d] < ChunkBegin(c) and Keys[n - Stride[d]] == Keys[n])
+        {
+            Unite(Parent, n, n - Stride[d]);
+        }
+    }
+
+    // Consecutive local numbering of the components in the order of their roots
+    vector<size_t> Counts(Nchunks + 1, 0);
+    #pragma omp parallel for schedule(static,1)
+    for(size_t c = 0; c < Nchunks; c++)
+    for(size_t n = ChunkBegin(c); n < ChunkBegin(c+1); n++)
+    if(Keys[n] >= 0 and Parent[n] == n)
+    {
+        Counts[c+1]++;
+    }
+    partial_sum(Counts.begin(), Counts.end(), Counts.begin());
+
+    vector<size_t> LocalLabel(Ncells, Unlabeled);
+    #pragma omp parallel for schedule(static,1)
+    for(size_t c = 0; c < Nchunks; c++)
+    {
+        size_t Next = Counts[c];
+        for(size_t n = ChunkBegin(c); n < ChunkBegin(c+1); n++)
+        if(Keys[n] >= 0 and Parent[n] == n)
+        {
+            LocalLabel[n] = Next++;
+        }
+    }
+    #pragma omp parallel for schedule(static)
+    for(size_t n = 0; n < Ncells; n++)
+    if(Keys[n] >= 0 and Parent[n] != n)
+    {
+        LocalLabel[n] = LocalLabel[Root(Parent, n)];
+    }
+
+    size_t LabelsOffset = 0;
+    size_t Nlabels = Counts[Nchunks];
+#ifdef MPI_PARALLEL
+    unsigned long locCount = Nlabels;
+    vector<unsigned long> RankCounts(MPI_SIZE);
+    OP_MPI_Allgather(&locCount, 1, OP_MPI_UNSIGNED_LONG, RankCounts.data(), 1, OP_MPI_UNSIGNED_LONG, OP_MPI_COMM_WORLD);
+    LabelsOffset = accumulate(RankCounts.begin(), RankCounts.begin() + MPI_RANK, 0ul);
+    Nlabels = accumulate(RankCounts.begin(), RankCounts.end(), 0ul);
+#endif
+
+    auto SetLabels = [&](const vector<size_t>& Map)
+    {
+        OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Labels,Labels.Bcells(),)
+        {
+            Labels(i,j,k) = Unlabeled;
+        }
+        OMP_PARALLEL_STORAGE_LOOP_END
+        #pragma omp parallel for schedule(static)
+        for(size_t n = 0; n < Ncells; n++)
+        if(LocalLabel[n] != Unlabeled)
+        {
+            const array<long int,3> x = Position(n);
+            Labels(x[0], x[1], x[2]) = Map.empty() ? LabelsOffset + LocalLabel[n] : Map[LabelsOffset + LocalLabel[n]];
+        }
+        BC.SetX(Labels);
+        BC.SetY(Labels);
+        BC.SetZ(Labels);
+    };
+    SetLabels({});
+
+    // Components connected across the process and periodic boundaries
+    vector<unsigned long long> Pairs;
+    for(size_t n = 0; n < Ncells; n++)
+    if(Keys[n] >= 0)
+    {
+        const array<long int,3> x = Position(n);
+        for(int d = 0; d < 3; d++)
+        if(Active[d] and x[d] == 0)
+        {
+            array<long int,3> y = x;
+            y[d] = -1;
+            if(not Exists(y)) continue;
+            const size_t Neighbor = Labels(y[0], y[1], y[2]);
+            if(Neighbor < Nlabels and Key(y[0], y[1], y[2]) == Keys[n])
+            {
+                Pairs.push_back(Labels(x[0], x[1], x[2]));
+                Pairs.push_back(Neighbor);
+            }
+        }
+    }
+#ifdef MPI_PARALLEL
+    int locPairs = Pairs.size();
+    vector<int> PairCounts(MPI_SIZE);
+    OP_MPI_Allgather(&locPairs, 1, OP_MPI_INT, PairCounts.data(), 1, OP_MPI_INT, OP_MPI_COMM_WORLD);
+    vector<int> Displs(MPI_SIZE, 0);
+    for(int r = 1; r < MPI_SIZE; r++) Displs[r] = Displs[r-1] + PairCounts[r-1];
+    vector<unsigned long long> AllPairs(Displs[MPI_SIZE-1] + PairCounts[MPI_SIZE-1]);
+    OP_MPI_Allgatherv(Pairs.data(), locPairs, OP_MPI_UNSIGNED_LONG_LONG,
+                      AllPairs.data(), PairCounts.data(), Displs.data(),
+                      OP_MPI_UNSIGNED_LONG_LONG, OP_MPI_COMM_WORLD);
+#else
+    const vector<unsigned long long>& AllPairs = Pairs;
+#endif
+
+    // Global components, identical on all ranks
+    vector<size_t> GlobalParent(Nlabels);
+    iota(GlobalParent.begin(), GlobalParent.end(), 0);
+    for(size_t n = 0; n + 1 < AllPairs.size(); n += 2)
+    {
+        Unite(GlobalParent, AllPairs[n], AllPairs[n+1]);
+    }
+    vector<size_t> Final(Nlabels);
+    size_t Ncomponents = 0;
+    for(size_t n = 0; n < Nlabels; n++)
+    {
+        Final[n] = (GlobalParent[n] == n) ? Ncomponents++ : Final[FindRoot(GlobalParent, n)];
+    }
+    SetLabels(Final);
+
+    // Statistics of the components
+    const double CellVolume = Grid.CellVolume();
+    const double FaceArea = CellVolume/Grid.dx;
+    vector<double> Sums(5*Ncomponents, 0.0);                                    // cells, faces, x, y, z
+    vector<double> Mins(3*Ncomponents, numeric_limits<double>::max());
+    vector<double> Maxs(4*Ncomponents, -numeric_limits<double>::max());         // x, y, z, key
+    #pragma omp parallel
+    {
+        unordered_map<size_t, array<double,12>> locStats;
+        #pragma omp for schedule(static)
+        for(size_t n = 0; n < Ncells; n++)
+        if(Keys[n] >= 0)
+        {
+            const array<long int,3> x = Position(n);
+            auto [it, inserted] = locStats.try_emplace(Labels(x[0], x[1], x[2]));
+            array<double,12>& Stats = it->second;
+            if(inserted)
+            {
+                Stats.fill(0.0);
+                for(int d = 0; d < 3; d++)
+                {
+                    Stats[5+d] = numeric_limits<double>::max();
+                    Stats[8+d] = -numeric_limits<double>::max();
+                }
+            }
+            Stats[0] += 1.0;
+            for(int d = 0; d < 3; d++)
+            {
+                const double Global = Offset[d] + x[d];
+                Stats[2+d] += Global;
+                Stats[5+d] = min(Stats[5+d], Global);
+                Stats[8+d] = max(Stats[8+d], Global);
+                if(not Active[d]) continue;
+                for(int s = -1; s <= 1; s += 2)
+                {
+                    array<long int,3> y = x;
+                    y[d] += s;
+                    if(not Exists(y)) continue;
+                    const bool Inside = (y[d] >= 0 and y[d] < Size[d]);
+                    const long int NeighborKey = Inside ? Keys[s > 0 ? n + Stride[d] : n - Stride[d]] : Key(y[0], y[1], y[2]);
+                    if(NeighborKey != Keys[n]) Stats[1] += 1.0;
+                }
+            }
+            Stats[11] = Keys[n];
+        }
+        #pragma omp critical
+        for(const auto& [c, Stats] : locStats)
+        {
+            for(int m = 0; m < 5; m++) Sums[5*c + m] += Stats[m];
+            for(int d = 0; d < 3; d++)
+            {
+                Mins[3*c + d] = min(Mins[3*c + d], Stats[5+d]);
+                Maxs[4*c + d] = max(Maxs[4*c + d], Stats[8+d]);
+            }
+            Maxs[4*c + 3] = Stats[11];
+        }
+    }
+    ReductionBatch Batch;
+    Batch.Sum(Sums.data(), Sums.size());
+    Batch.Min(Mins.data(), Mins.size());
+    Batch.Max(Maxs.data(), Maxs.size());
+    Batch.Reduce();
+
+    vector<Component_t> Components(Ncomponents);
+    for(size_t c = 0; c < Ncomponents; c++)
+    {
+        const double Count = Sums[5*c];
+        Components[c].Key     = Maxs[4*c + 3];
+        Components[c].Volume  = Count*CellVolume;
+        Components[c].Surface = Sums[5*c + 1]*FaceArea;
+        for(int d = 0; d < 3; d++)
+        {
+            Components[c].Centroid[d] = Sums[5*c + 2 + d]/Count;
+            Components[c].Min[d] = Mins[3*c + d];
+            Components[c].Max[d] = Maxs[4*c + d];
+        }
+    }
+    return Components;
+}
+
+ConnectedComponents::Key_t ConnectedComponents::GrainKey(const PhaseField& Phase)
+{
+    return [&Phase](long int i, long int j, long int k) -> long int
+    {
+        const NodePF& Node = Phase.Fields(i,j,k);
+        return Node.size() ? Node.majority_index() : -1;
+    };
+}
+
+ConnectedComponents::Key_t ConnectedComponents::PhaseKey(const PhaseField& Phase)
+{
+    return [&Phase](long int i, long int j, long int k) -> long int
+    {
+        const NodePF& Node = Phase.Fields(i,j,k);
+        return Node.size() ? long(Phase.FieldsProperties[Node.majority_index()].Phase) : -1;
+    };
+}
+
+}// namespace openphase
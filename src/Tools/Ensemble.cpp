@@ -0,0 +1,190 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "Tools/Ensemble.h"
+
+#ifndef MPI_PARALLEL
+#include "fftw3.h"
+#endif
+
+namespace openphase
+{
+using namespace std;
+
+string Ensemble::Variant(const string& Input,
+                         const map<string, string>& Parameters)
+{
+    /* Parameters are given as "Key" (all occurrences of $Key) or as
+    "Module/Key" ($Key in @Module only). Module specific keys which are not
+    present in the input are added to the module, or to a new module at the
+    end of the input. */
+    map<string, bool> Found;
+    for(auto& [Name, Value] : Parameters) Found[Name] = false;
+
+    vector<string> Lines;
+    {
+        stringstream inp(Input);
+        string line;
+        while(getline(inp, line)) Lines.push_back(line);
+    }
+
+    map<string, size_t> ModuleLines;
+    string Module;
+    for(size_t n = 0; n < Lines.size(); n++)
+    {
+        string& line = Lines[n];
+        const size_t first = line.find_first_not_of(" \t");
+        if(first == string::npos) continue;
+
+        if(line[first] == '@')
+        {
+            stringstream token(line.substr(first + 1));
+            token >> Module;
+            ModuleLines.emplace(Module, n);
+            continue;
+        }
+        if(line[first] != '$') continue;
+
+        stringstream token(line.substr(first + 1));
+        string Key;
+        token >> Key;
+
+        auto it = Parameters.find(Module + "/" + Key);
+        if(it == Parameters.end()) it = Parameters.find(Key);
+        if(it == Parameters.end()) continue;
+
+        const size_t colon = line.find(':');
+        if(colon == string::npos) line += " : " + it->second;
+        else line = line.substr(0, colon + 1) + " " + it->second;
+        Found[it->first] = true;
+    }
+
+    vector<pair<size_t, string>> Insertions;
+    string Appendix;
+    for(auto& [Name, Value] : Parameters)
+    {
+        if(Found[Name]) continue;
+
+        const size_t slash = Name.find('/');
+        if(slash == string::npos)
+        {
+            ConsoleOutput::WriteExit("Parameter \"" + Name + "\" not found in the input, "
+                                     "use \"Module/" + Name + "\" to add it",
+                                     "Ensemble", "Variant()");
+            OP_Exit(EXIT_FAILURE);
+        }
+        const string locModule = Name.substr(0, slash);
+        const string Line = "$" + Name.substr(slash + 1) + " : " + Value;
+        auto mod = ModuleLines.find(locModule);
+        if(mod != ModuleLines.end()) Insertions.push_back({mod->second, Line});
+        else Appendix += "\n@" + locModule + "\n\n" + Line + "\n";
+    }
+
+    stringstream out;
+    for(size_t n = 0; n < Lines.size(); n++)
+    {
+        out << Lines[n] << "\n";
+        for(auto& [pos, Line] : Insertions)
+        if(pos == n)
+        {
+            out << Line << "\n";
+        }
+    }
+    out << Appendix;
+    return out.str();
+}
+
+string Ensemble::WriteCase(const string& Directory, const string& Input)
+{
+    std::filesystem::create_directories(Directory);
+    std::filesystem::path FileName(Directory);
+    FileName.append(DefaultInputFileName);
+
+    ofstream out(FileName.string());
+    if(!out)
+    {
+        ConsoleOutput::WriteExit("Input file " + FileName.string() + " could not be written",
+                                 "Ensemble", "WriteCase()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    out << Input;
+    return FileName.string();
+}
+
+void Ensemble::PrepareThreads(const size_t nCases, const int TeamSize)
+{
+#ifdef MPI_PARALLEL
+    ConsoleOutput::WriteExit("Ensembles are only supported in the serial build",
+                             "Ensemble", "PrepareThreads()");
+    OP_Exit(EXIT_FAILURE);
+#else
+#ifdef _OPENMP
+    /* The parallel regions of a case are nested in the region of the
+    ensemble, with teams of one thread they execute serially */
+    omp_set_max_active_levels(TeamSize > 1 ? 2 : 1);
+
+    /* FFTW plans are created by the cases concurrently */
+    fftw_init_threads();
+    fftw_make_planner_thread_safe();
+#ifdef SINGLE_PRECISION_FFT
+    fftwf_init_threads();
+    fftwf_make_planner_thread_safe();
+#endif
+    const int nTeams = std::max(1, omp_get_max_threads()/TeamSize);
+#else
+    const int nTeams = 1;
+#endif
+    ConsoleOutput::WriteStandard("Ensemble", to_string(nCases) + " cases, " +
+                                 to_string(std::min<size_t>(nTeams, nCases)) +
+                                 " teams of " + to_string(TeamSize) + " threads");
+#endif
+}
+
+void Ensemble::Report(const vector<Result>& Results)
+{
+    size_t nFailed = 0;
+    for(size_t idx = 0; idx < Results.size(); idx++)
+    {
+        const Result& res = Results[idx];
+        stringstream message;
+        message << (res.Success ? "finished" : "FAILED") << " in "
+                << res.WallTime << " s";
+        if(!res.Success)
+        {
+            message << ": " << res.Error;
+            nFailed++;
+        }
+        ConsoleOutput::WriteStandard("Case " + to_string(idx) + " (" + res.InputFileName + ")",
+                                     message.str());
+    }
+    if(nFailed)
+    {
+        ConsoleOutput::WriteWarning(to_string(nFailed) + " of " + to_string(Results.size()) +
+                                    " cases failed", "Ensemble", "Report()");
+    }
+}
+
+}// namespace openphase
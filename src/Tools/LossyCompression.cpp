@@ -0,0 +1,247 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "Tools/LossyCompression.h"
+#include "ConsoleOutput.h"
+#include "../../external/miniz.h"
+
+namespace openphase
+{
+
+using namespace std;
+
+static const char Signature[8] = {'O','P','L','O','S','S','Y','1'};
+
+/* Quantization codes are zigzag encoded (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+and shifted by one, the code 0 marks a verbatim value */
+static void PutCode(vector<unsigned char>& bytes, uint64_t code)
+{
+    while(code >= 0x80)
+    {
+        bytes.push_back(static_cast<unsigned char>(code | 0x80));
+        code >>= 7;
+    }
+    bytes.push_back(static_cast<unsigned char>(code));
+}
+
+static bool GetCode(const vector<unsigned char>& bytes, size_t& pos, uint64_t& code)
+{
+    code = 0;
+    for(int shift = 0; shift < 64 and pos < bytes.size(); shift += 7)
+    {
+        const unsigned char byte = bytes[pos++];
+        code |= uint64_t(byte & 0x7F) << shift;
+        if(not (byte & 0x80)) return true;
+    }
+    return false;
+}
+
+static void EncodeBlock(const double* data, const size_t size, const size_t Stride,
+                        const double Bound, vector<unsigned char>& bytes)
+{
+    if(Bound <= 0.0)
+    {
+        bytes.resize(size*sizeof(double));
+        memcpy(bytes.data(), data, size*sizeof(double));
+        return;
+    }
+    /* Predictions use the reconstructed values, the decoder sees the same */
+    const double Step = 2.0*Bound;
+    vector<double> rec(size);
+    bytes.reserve(size);
+    for(size_t n = 0; n < size; n++)
+    {
+        const double prediction = (n >= Stride) ? rec[n - Stride] : 0.0;
+        const double q = round((data[n] - prediction)/Step);
+        rec[n] = prediction + q*Step;
+        if(isfinite(q) and fabs(q) < 4.0e15 and fabs(rec[n] - data[n]) <= Bound)
+        {
+            const int64_t code = static_cast<int64_t>(q);
+            PutCode(bytes, ((uint64_t(code) << 1) ^ uint64_t(code >> 63)) + 1);
+        }
+        else
+        {
+            rec[n] = data[n];
+            bytes.push_back(0);
+            const unsigned char* raw = reinterpret_cast<const unsigned char*>(&data[n]);
+            bytes.insert(bytes.end(), raw, raw + sizeof(double));
+        }
+    }
+}
+
+static bool DecodeBlock(const vector<unsigned char>& bytes, const size_t Stride,
+                        const double Bound, double* data, const size_t size)
+{
+    if(Bound <= 0.0)
+    {
+        if(bytes.size() != size*sizeof(double)) return false;
+        memcpy(data, bytes.data(), bytes.size());
+        return true;
+    }
+    const double Step = 2.0*Bound;
+    size_t pos = 0;
+    for(size_t n = 0; n < size; n++)
+    {
+        uint64_t code = 0;
+        if(not GetCode(bytes, pos, code)) return false;
+        if(code == 0)
+        {
+            if(pos + sizeof(double) > bytes.size()) return false;
+            memcpy(&data[n], bytes.data() + pos, sizeof(double));
+            pos += sizeof(double);
+        }
+        else
+        {
+            code -= 1;
+            const int64_t q = static_cast<int64_t>(code >> 1) ^ -static_cast<int64_t>(code & 1);
+            const double prediction = (n >= Stride) ? data[n - Stride] : 0.0;
+            data[n] = prediction + double(q)*Step;
+        }
+    }
+    return pos == bytes.size();
+}
+
+double LossyCompression::ErrorBound(const vector<double>& data, const double Tolerance)
+{
+    double minValue =  numeric_limits<double>::max();
+    double maxValue = -numeric_limits<double>::max();
+    #pragma omp parallel for reduction(min:minValue) reduction(max:maxValue)
+    for(size_t n = 0; n < data.size(); n++)
+    {
+        if(isfinite(data[n]))
+        {
+            minValue = min(minValue, data[n]);
+            maxValue = max(maxValue, data[n]);
+        }
+    }
+    /* Constant fields fall back to an absolute bound */
+    const double range = maxValue - minValue;
+    return (range > 0.0) ? Tolerance*range : Tolerance;
+}
+
+void LossyCompression::Write(ostream& out, const vector<double>& data,
+                             const double Tolerance, const size_t Stride)
+{
+    const double Bound = (Tolerance > 0.0) ? ErrorBound(data, Tolerance) : 0.0;
+    const uint64_t nblocks = (data.size() + BlockSize - 1)/BlockSize;
+    vector<vector<unsigned char>> blocks(nblocks);
+    vector<uint64_t> sizes(2*nblocks, 0);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t b = 0; b < nblocks; b++)
+    {
+        const size_t offset = b*BlockSize;
+        const size_t bsize  = min<size_t>(BlockSize, data.size() - offset);
+        vector<unsigned char> bytes;
+        EncodeBlock(data.data() + offset, bsize, max<size_t>(Stride, 1), Bound, bytes);
+
+        mz_ulong csize = compressBound(bytes.size());
+        blocks[b].resize(csize);
+        if(compress2(blocks[b].data(), &csize, bytes.data(), bytes.size(), 6) != Z_OK)
+        {
+            ConsoleOutput::WriteWarning("Compression of the data failed", thisclassname, "Write()");
+        }
+        blocks[b].resize(csize);
+        sizes[2*b]     = bytes.size();
+        sizes[2*b + 1] = csize;
+    }
+
+    const uint64_t header[2] = {data.size(), max<size_t>(Stride, 1)};
+    const uint64_t layout[2] = {BlockSize, nblocks};
+    out.write(Signature, sizeof(Signature));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(&Bound), sizeof(double));
+    out.write(reinterpret_cast<const char*>(layout), sizeof(layout));
+    out.write(reinterpret_cast<const char*>(sizes.data()), sizes.size()*sizeof(uint64_t));
+    for(const auto& block : blocks)
+    {
+        out.write(reinterpret_cast<const char*>(block.data()), block.size());
+    }
+}
+
+bool LossyCompression::Read(istream& inp, vector<double>& data)
+{
+    const istream::pos_type start = inp.tellg();
+    char signature[sizeof(Signature)] = {};
+    inp.read(signature, sizeof(signature));
+    if(not inp or memcmp(signature, Signature, sizeof(Signature)) != 0)
+    {
+        inp.clear();
+        inp.seekg(start);
+        return false;
+    }
+
+    uint64_t header[2] = {0, 1};
+    uint64_t layout[2] = {BlockSize, 0};
+    double Bound = 0.0;
+    inp.read(reinterpret_cast<char*>(header), sizeof(header));
+    inp.read(reinterpret_cast<char*>(&Bound), sizeof(double));
+    inp.read(reinterpret_cast<char*>(layout), sizeof(layout));
+    const uint64_t size    = header[0];
+    const uint64_t Stride  = header[1];
+    const uint64_t bsize   = layout[0];
+    const uint64_t nblocks = layout[1];
+    if(not inp or bsize == 0 or Stride == 0 or nblocks != (size + bsize - 1)/bsize)
+    {
+        ConsoleOutput::WriteWarning("Corrupted compressed data header", thisclassname, "Read()");
+        inp.setstate(ios::failbit);
+        return true;
+    }
+    vector<uint64_t> sizes(2*nblocks);
+    inp.read(reinterpret_cast<char*>(sizes.data()), sizes.size()*sizeof(uint64_t));
+    vector<vector<unsigned char>> blocks(nblocks);
+    for(size_t b = 0; b < nblocks and inp; b++)
+    {
+        blocks[b].resize(sizes[2*b + 1]);
+        inp.read(reinterpret_cast<char*>(blocks[b].data()), blocks[b].size());
+    }
+    if(not inp)
+    {
+        ConsoleOutput::WriteWarning("Truncated compressed data", thisclassname, "Read()");
+        return true;
+    }
+
+    data.resize(size);
+    bool valid = true;
+    #pragma omp parallel for schedule(dynamic) reduction(&&:valid)
+    for(size_t b = 0; b < nblocks; b++)
+    {
+        vector<unsigned char> bytes(sizes[2*b]);
+        mz_ulong length = bytes.size();
+        const size_t offset = b*bsize;
+        const size_t count  = min<size_t>(bsize, size - offset);
+        valid = valid and uncompress(bytes.data(), &length, blocks[b].data(), blocks[b].size()) == Z_OK
+                      and length == bytes.size()
+                      and DecodeBlock(bytes, Stride, Bound, data.data() + offset, count);
+    }
+    if(not valid)
+    {
+        ConsoleOutput::WriteWarning("Corrupted compressed data", thisclassname, "Read()");
+        inp.setstate(ios::failbit);
+    }
+    return true;
+}
+
+}// namespace openphase
@@ -0,0 +1,217 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Tools/MemoryMonitor.h"
+#include "OPObject.h"
+
+namespace openphase
+{
+
+using namespace std;
+
+/* Leading columns of a sample, followed by the modules */
+enum MemoryColumns {RSS, HWM, Total, Nfixed};
+
+MemoryMonitor::~MemoryMonitor()
+{
+    if(Samples == 0) return;
+#ifdef MPI_PARALLEL
+    if(MPI_RANK != 0) return;
+#endif
+    ConsoleOutput::WriteLineInsert("Memory high-water marks [MB] (maximum over ranks and samples)");
+    ConsoleOutput::WriteStandard("Resident set size", PeakRSS);
+    for(size_t n = 0; n < Modules.size(); n++)
+    if(PeakModules[n] > 0.0)
+    {
+        ConsoleOutput::WriteStandard(Modules[n], PeakModules[n]);
+    }
+    ConsoleOutput::WriteLine();
+}
+
+void MemoryMonitor::Initialize(const string locFileName, const int locInterval,
+                               const double locWarningThreshold, const bool append)
+{
+    FileName = locFileName;
+    Interval = max(locInterval, 0);
+    WarningThreshold = max(locWarningThreshold, 0.0);
+    Append = append;
+    Samples = 0;
+}
+
+double MemoryMonitor::ProcStatus(const string Key)
+{
+    ifstream file("/proc/self/status");
+    string line;
+    while(getline(file, line))
+    {
+        if(line.compare(0, Key.size(), Key) == 0)
+        {
+            istringstream iss(line.substr(Key.size()));
+            double value = -1.0;
+            iss >> value;
+            return value/1024.0;  // kB to MB
+        }
+    }
+    return -1.0;
+}
+
+double MemoryMonitor::ResidentMemory(void)
+{
+    return ProcStatus("VmRSS:");
+}
+
+double MemoryMonitor::PeakResidentMemory(void)
+{
+    return ProcStatus("VmHWM:");
+}
+
+void MemoryMonitor::Sample(const int tStep, const int nSteps)
+{
+    const double MB = 1024.0*1024.0;
+    vector<const OPObject*> Objects;
+    for(auto object : OPObject::ExistingObjects())
+    if(object->thisclassname.size() != 0)
+    {
+        Objects.push_back(object);
+    }
+    auto Name = [](const OPObject* object)
+    {
+        string name = object->thisobjectname.size() ? object->thisobjectname : object->thisclassname;
+        replace(name.begin(), name.end(), ' ', '_');
+        return name;
+    };
+
+    if(Samples == 0)
+    {
+        /* The columns are fixed by the objects of rank 0 at the first sample,
+        objects created later or missing on other ranks are counted in the
+        total only */
+        string Names;
+        for(auto object : Objects)
+        if(find(Modules.begin(), Modules.end(), Name(object)) == Modules.end())
+        {
+            Modules.push_back(Name(object));
+            Names += Modules.back() + "\n";
+        }
+#ifdef MPI_PARALLEL
+        int Length = Names.size();
+        OP_MPI_Bcast(&Length, 1, OP_MPI_INT, 0, OP_MPI_COMM_WORLD);
+        Names.resize(Length);
+        OP_MPI_Bcast(Names.data(), Length, OP_MPI_CHAR, 0, OP_MPI_COMM_WORLD);
+        Modules.clear();
+        stringstream NamesStream(Names);
+        string Line;
+        while(getline(NamesStream, Line)) Modules.push_back(Line);
+#endif
+        PeakModules.assign(Modules.size(), 0.0);
+    }
+
+    vector<double> MinValues(Nfixed + Modules.size(), 0.0);
+    MinValues[RSS] = ResidentMemory();
+    MinValues[HWM] = PeakResidentMemory();
+    for(auto object : Objects)
+    {
+        const double Bytes = object->AllocatedMemory()/MB;
+        MinValues[Total] += Bytes;
+        auto it = find(Modules.begin(), Modules.end(), Name(object));
+        if(it != Modules.end()) MinValues[Nfixed + (it - Modules.begin())] += Bytes;
+    }
+    vector<double> MaxValues = MinValues;
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, MinValues.data(), MinValues.size(), OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, MaxValues.data(), MaxValues.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+
+    if(Samples == 0)
+    {
+        FirstRSS  = MaxValues[RSS];
+        FirstStep = tStep;
+    }
+    Samples++;
+    PeakRSS = max(PeakRSS, max(MaxValues[RSS], MaxValues[HWM]));
+    for(size_t n = 0; n < Modules.size(); n++)
+    {
+        PeakModules[n] = max(PeakModules[n], MaxValues[Nfixed + n]);
+    }
+
+    if(WarningThreshold > 0.0 and MaxValues[RSS] > WarningThreshold and not Exceeded)
+    {
+        Exceeded = true;
+        stringstream message;
+        message << "Resident memory of " << MaxValues[RSS] << " MB per rank at time step "
+                << tStep << " exceeds the threshold of " << WarningThreshold << " MB";
+        ConsoleOutput::WriteWarning(message.str(), "MemoryMonitor", "Sample()");
+    }
+    else if(WarningThreshold > 0.0 and not Exceeded and not Projected and tStep > FirstStep)
+    {
+        const double Growth = (MaxValues[RSS] - FirstRSS)/(tStep - FirstStep);
+        if(Growth > 0.0)
+        {
+            const double Reached = tStep + (WarningThreshold - MaxValues[RSS])/Growth;
+            if(Reached <= nSteps)
+            {
+                Projected = true;
+                stringstream message;
+                message << "Resident memory grows by " << Growth*Interval << " MB per rank every "
+                        << Interval << " time steps and is projected to exceed the threshold of "
+                        << WarningThreshold << " MB at time step " << long(Reached) << " of " << nSteps;
+                ConsoleOutput::WriteWarning(message.str(), "MemoryMonitor", "Sample()");
+            }
+        }
+    }
+
+#ifdef MPI_PARALLEL
+    if(MPI_RANK != 0) return;
+    const bool MinMax = true;
+#else
+    const bool MinMax = false;
+#endif
+    const bool Header = (Samples == 1) and not (Append and filesystem::exists(FileName));
+    ofstream out(FileName, (Samples == 1 and not Append) ? ios::out : ios::app);
+    if(!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be opened", "MemoryMonitor", "Sample()");
+        return;
+    }
+    vector<string> Columns = {"RSS", "HWM", "Total"};
+    Columns.insert(Columns.end(), Modules.begin(), Modules.end());
+    if(Header)
+    {
+        out << "tStep";
+        for(const string& Column : Columns)
+        {
+            if(MinMax) out << " " << Column << "_min " << Column << "_max";
+            else out << " " << Column;
+        }
+        out << "\n";
+    }
+    out << tStep << fixed << setprecision(3);
+    for(size_t n = 0; n < Columns.size(); n++)
+    {
+        if(MinMax) out << " " << MinValues[n];
+        out << " " << MaxValues[n];
+    }
+    out << "\n";
+}
+
+}// namespace openphase
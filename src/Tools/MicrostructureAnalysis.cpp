@@ -25,13 +25,17 @@
  */
 
 #include "Tools/MicrostructureAnalysis.h"
+#include "Tools/ConnectedComponents.h"
 #include "PhaseField.h"
 #include "SymmetryVariants.h"
 #include "Tools.h"
 #include "DoubleObstacle.h"
 #include "H5Interface.h"
+#include "AsyncOutput.h"
 #include "RunTimeControl.h"
 #include "InterfaceProperties.h"
+#include <numeric>
+#include <unordered_map>
 
 #ifdef H5OP
 #include "../HighFive/include/highfive/H5Easy.hpp"
@@ -41,20 +45,312 @@ namespace openphase
 {
 using namespace std;
 
-void MicrostructureAnalysis::GrainsSurfaceArea(const PhaseField& Phase)
+namespace
 {
-    int Nthreads = 1;
+/* Grains are distributed over the ranks in blocks of consecutive indices,
+rank r owns [BlockBegin(r), BlockBegin(r + 1)) */
+size_t BlockBegin(const size_t Ngrains, const int Rank, const int Nranks)
+{
+    return Ngrains*Rank/Nranks;
+}
+
+int BlockOwner(const size_t Grain, const size_t Ngrains, const int Nranks)
+{
+    return ((Grain + 1)*Nranks - 1)/Ngrains;
+}
+
+/* Sends Buckets[r] to rank r in one all-to-all, returns the received values
+concatenated in rank order */
+template<class T>
+vector<T> ExchangeBuckets(const vector<vector<T>>& Buckets)
+{
+#ifdef MPI_PARALLEL
+    const OP_MPI_Datatype Type = std::is_same<T, double>::value ? OP_MPI_DOUBLE : OP_MPI_UNSIGNED_LONG_LONG;
+    vector<int> Ones(MPI_SIZE, 1);
+    vector<int> Ranks(MPI_SIZE);
+    iota(Ranks.begin(), Ranks.end(), 0);
+
+    vector<T> SendBuffer;
+    vector<int> SendCounts(MPI_SIZE);
+    vector<int> SendDispls(MPI_SIZE);
+    for(int r = 0; r < MPI_SIZE; r++)
+    {
+        SendDispls[r] = SendBuffer.size();
+        SendCounts[r] = Buckets[r].size();
+        SendBuffer.insert(SendBuffer.end(), Buckets[r].begin(), Buckets[r].end());
+    }
+    vector<int> RecvCounts(MPI_SIZE);
+    OP_MPI_Alltoallv(SendCounts.data(), Ones.data(), Ranks.data(), OP_MPI_INT,
+                     RecvCounts.data(), Ones.data(), Ranks.data(), OP_MPI_INT, OP_MPI_COMM_WORLD);
+    vector<int> RecvDispls(MPI_SIZE, 0);
+    for(int r = 1; r < MPI_SIZE; r++)
+    {
+        RecvDispls[r] = RecvDispls[r-1] + RecvCounts[r-1];
+    }
+    vector<T> RecvBuffer(RecvDispls.back() + RecvCounts.back());
+    OP_MPI_Alltoallv(SendBuffer.data(), SendCounts.data(), SendDispls.data(), Type,
+                     RecvBuffer.data(), RecvCounts.data(), RecvDispls.data(), Type, OP_MPI_COMM_WORLD);
+    return RecvBuffer;
+#else
+    return Buckets[0];
+#endif
+}
+
+/* Collects the local blocks on rank 0 in rank order, i.e. in grain order */
+template<class T>
+vector<T> GatherBlocks(const vector<T>& Local)
+{
+#ifdef MPI_PARALLEL
+    vector<vector<T>> Buckets(MPI_SIZE);
+    Buckets[0] = Local;
+    return ExchangeBuckets(Buckets);
+#else
+    return Local;
+#endif
+}
+
+/* Number of neighbours per grain of the local block */
+vector<size_t> NeighbourCounts(const MicrostructureAnalysis::GrainGraph_t& Graph)
+{
+    vector<size_t> Counts(Graph.size());
+    for(size_t n = 0; n < Graph.size(); n++)
+    {
+        Counts[n] = Graph.Offsets[n+1] - Graph.Offsets[n];
+    }
+    return Counts;
+}
 
+/* Writes the edges of the local block of the grain graph in COO format, both
+directions of each pair, with the shared interface area and the
+misorientation angle (radians, optionally the cubic disorientation) of the
+two grains as edge features */
+void WriteGraphEdges(const PhaseField& Phase, const int tStep,
+                     const MicrostructureAnalysis::GrainGraph_t& Graph,
+                     H5Interface& H5, const bool CubicSymmetry)
+{
+    const size_t Nedges = Graph.Neighbours.size();
+    vector<double> EdgeIndexRow(Nedges);
+    vector<double> EdgeIndexCol(Nedges);
+    vector<double> EdgeArea(Graph.Areas);
+    vector<double> EdgeMisorientation(Nedges, 0.0);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for(size_t n = 0; n < Graph.size(); n++)
+    {
+        const size_t Grain = Graph.First + n;
+        for(size_t m = Graph.Offsets[n]; m < Graph.Offsets[n+1]; m++)
+        {
+            const size_t Neighbour = Graph.Neighbours[m];
+            EdgeIndexRow[m] = Grain;
+            EdgeIndexCol[m] = Neighbour;
+            if(Grain >= Phase.FieldsProperties.size() or
+               Neighbour >= Phase.FieldsProperties.size()) continue;
+
+            const Quaternion& QA = Phase.FieldsProperties[Grain].Orientation;
+            const Quaternion& QB = Phase.FieldsProperties[Neighbour].Orientation;
+            if(CubicSymmetry)
+            {
+                EdgeMisorientation[m] = Phase.FieldsProperties.Misorientation(Grain, Neighbour).Angle;
+            }
+            else
+            {
+                double Dot = 0.0;
+                for(int i = 0; i < 4; i++) Dot += QA[i]*QB[i];
+                EdgeMisorientation[m] = 2.0*acos(min(fabs(Dot), 1.0));
+            }
+        }
+    }
+    H5.WriteCheckPoint(tStep, "EdgeIndex", EdgeIndexRow, "row");
+    H5.WriteCheckPoint(tStep, "EdgeIndex", EdgeIndexCol, "col");
+    H5.WriteCheckPoint(tStep, "EdgeFeatures", EdgeArea, "area");
+    H5.WriteCheckPoint(tStep, "EdgeFeatures", EdgeMisorientation, "misorientation");
+}
+
+/* Writes the text files of WriteGrainsStatistics() on rank 0, returns the
+gathered neighbour counts and lists of all grains there */
+void WriteGrainsText(const PhaseField& Phase, const int tStep,
+                     const MicrostructureAnalysis::GrainGraph_t& Graph,
+                     vector<size_t>& Counts, vector<size_t>& Neighbours)
+{
+    size_t Present = count_if(Graph.Volumes.begin(), Graph.Volumes.end(), [](double V){return V > 0.0;});
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &Present, 1, OP_MPI_UNSIGNED_LONG_LONG, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+#endif
+    Counts     = GatherBlocks(NeighbourCounts(Graph));
+    Neighbours = GatherBlocks(Graph.Neighbours);
+#ifdef MPI_PARALLEL
+    if(MPI_RANK != 0) return;
+#endif
+    const size_t nPFs = Phase.FieldsProperties.size();
+    const double AveSize = double(Phase.Grid.TotalNumberOfCells())/max(Present, size_t(1));
+    const ios::openmode Mode = tStep ? ios::app : ios::out;
+
+    ofstream Fl1(DefaultTextDir + "SizeAveInfo.dat", Mode);      // Average grain size
+    ofstream Fl2(DefaultTextDir + "SizeDetails.dat", Mode);      // Grain volumes
+    ofstream Fl3(DefaultTextDir + "NeighboInfo.dat", Mode);      // Number of neighbours
+    ofstream Fl4(DefaultTextDir + "GrainConnections.dat", Mode); // Neighbour lists
+    Fl1.precision(10);
+    Fl2.precision(10);
+
+    Fl1 << tStep << " " << Present << " " << AveSize << " " << AveSize*Phase.Grid.CellVolume() << endl;
+
+    Fl2 << tStep << " " << nPFs << " ";
+    for(size_t i = 0; i < nPFs; i++)
+    {
+        Fl2 << Phase.FieldsProperties[i].Volume << " ";
+    }
+    Fl2 << endl;
+
+    Fl3 << tStep << " " << nPFs << " ";
+    for(size_t i = 0; i < Counts.size(); i++)
+    {
+        Fl3 << Counts[i] << " ";
+    }
+    Fl3 << endl;
+
+    Fl4 << "# TimeStep: " << tStep << endl;
+    for(size_t i = 0, n = 0; i < Counts.size(); n += Counts[i], i++)
+    if(Counts[i])
+    {
+        Fl4 << i << ": ";
+        for(size_t m = n; m < n + Counts[i]; m++) Fl4 << Neighbours[m] << " ";
+        Fl4 << endl;
+    }
+}
+}// namespace
+
+MicrostructureAnalysis::GrainGraph_t MicrostructureAnalysis::GrainGraph(const PhaseField& Phase)
+{
+    int Nthreads = 1;
     #ifdef _OPENMP
     Nthreads = omp_get_max_threads();
     #endif
-    const size_t size = Phase.FieldsProperties.size();
-    vector<vector<double>> ThreadsSurfaceVolume(Nthreads);
-    for(int t = 0; t < Nthreads; t++)
+    int Rank   = 0;
+    int Nranks = 1;
+    #ifdef MPI_PARALLEL
+    Rank   = MPI_RANK;
+    Nranks = MPI_SIZE;
+    #endif
+
+    GrainGraph_t Graph;
+    Graph.Ngrains = Phase.FieldsProperties.size();
+    #ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &Graph.Ngrains, 1, OP_MPI_UNSIGNED_LONG_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    #endif
+    const size_t Ngrains = Graph.Ngrains;
+    Graph.First = BlockBegin(Ngrains, Rank, Nranks);
+    const size_t Nlocal = BlockBegin(Ngrains, Rank + 1, Nranks) - Graph.First;
+    Graph.Volumes.assign(Nlocal, 0.0);
+    Graph.Offsets.assign(Nlocal + 1, 0);
+    if(Ngrains == 0) return Graph;
+
+    /* Sparse per-thread accumulators, they hold only the grains and pairs
+    found in the cells of the thread */
+    vector<unordered_map<size_t, double>> ThreadVolumes(Nthreads);
+    vector<unordered_map<size_t, double>> ThreadPairs(Nthreads);
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
+    {
+        int thread = 0;
+        #ifdef _OPENMP
+        thread = omp_get_thread_num();
+        #endif
+
+        const NodePF& locPF = Phase.Fields(i,j,k);
+        for(auto it = locPF.cbegin(); it != locPF.cend(); ++it)
+        {
+            ThreadVolumes[thread][it->index] += it->value;
+        }
+        if(locPF.interface() and locPF.size() == 2)
+        {
+            const size_t idx1 = locPF.cbegin()->index;
+            const size_t idx2 = (locPF.cbegin() + 1)->index;
+            ThreadPairs[thread][min(idx1, idx2)*Ngrains + max(idx1, idx2)] += 1.0;
+        }
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+
+    for(int t = 1; t < Nthreads; t++)
+    {
+        for(const auto& [index, volume] : ThreadVolumes[t]) ThreadVolumes[0][index] += volume;
+        for(const auto& [Key, cells] : ThreadPairs[t]) ThreadPairs[0][Key] += cells;
+        ThreadVolumes[t] = unordered_map<size_t, double>();
+        ThreadPairs[t]   = unordered_map<size_t, double>();
+    }
+
+    /* Volumes and both directions of each pair go to the owners of the grains */
+    vector<vector<size_t>> SendIndices(Nranks);
+    vector<vector<double>> SendVolumes(Nranks);
+    vector<vector<size_t>> SendPairs(Nranks);
+    vector<vector<double>> SendCells(Nranks);
+    for(const auto& [index, volume] : ThreadVolumes[0])
     {
-        ThreadsSurfaceVolume[t].resize(size, 0.0);
+        const int Owner = BlockOwner(index, Ngrains, Nranks);
+        SendIndices[Owner].push_back(index);
+        SendVolumes[Owner].push_back(volume);
     }
-    // Calculate surface volumes in each OpenMP chunk
+    for(const auto& [Key, cells] : ThreadPairs[0])
+    {
+        const size_t idx1 = Key/Ngrains;
+        const size_t idx2 = Key%Ngrains;
+        const int Owner1 = BlockOwner(idx1, Ngrains, Nranks);
+        SendPairs[Owner1].push_back(idx1);
+        SendPairs[Owner1].push_back(idx2);
+        SendCells[Owner1].push_back(cells);
+        const int Owner2 = BlockOwner(idx2, Ngrains, Nranks);
+        SendPairs[Owner2].push_back(idx2);
+        SendPairs[Owner2].push_back(idx1);
+        SendCells[Owner2].push_back(cells);
+    }
+    ThreadVolumes.clear();
+    ThreadPairs.clear();
+
+    const vector<size_t> RecvIndices = ExchangeBuckets(SendIndices);
+    const vector<double> RecvVolumes = ExchangeBuckets(SendVolumes);
+    for(size_t n = 0; n < RecvIndices.size(); n++)
+    {
+        Graph.Volumes[RecvIndices[n] - Graph.First] += RecvVolumes[n];
+    }
+
+    /* A pair found on several ranks is merged, its interface cells summed */
+    const vector<size_t> RecvPairs = ExchangeBuckets(SendPairs);
+    const vector<double> RecvCells = ExchangeBuckets(SendCells);
+    vector<pair<pair<size_t, size_t>, double>> Pairs(RecvCells.size());
+    for(size_t n = 0; n < Pairs.size(); n++)
+    {
+        Pairs[n] = {{RecvPairs[2*n], RecvPairs[2*n+1]}, RecvCells[n]};
+    }
+    sort(Pairs.begin(), Pairs.end());
+
+    Graph.Neighbours.reserve(Pairs.size());
+    Graph.Areas.reserve(Pairs.size());
+    for(size_t n = 0; n < Pairs.size(); n++)
+    {
+        if(n > 0 and Pairs[n].first == Pairs[n-1].first)
+        {
+            Graph.Areas.back() += Pairs[n].second/Phase.Grid.iWidth;
+            continue;
+        }
+        Graph.Offsets[Pairs[n].first.first - Graph.First + 1]++;
+        Graph.Neighbours.push_back(Pairs[n].first.second);
+        Graph.Areas.push_back(Pairs[n].second/Phase.Grid.iWidth);
+    }
+    partial_sum(Graph.Offsets.begin(), Graph.Offsets.end(), Graph.Offsets.begin());
+    return Graph;
+}
+
+vector<double> MicrostructureAnalysis::GrainsSurfaceArea(const PhaseField& Phase)
+{
+    int Nthreads = 1;
+
+    #ifdef _OPENMP
+    Nthreads = omp_get_max_threads();
+    #endif
+    size_t size = Phase.FieldsProperties.size();
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &size, 1, OP_MPI_UNSIGNED_LONG_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    // Sparse surface volumes of each OpenMP thread
+    vector<unordered_map<size_t, double>> ThreadsSurfaceVolume(Nthreads);
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
     {
         int thread = 0;
@@ -72,40 +368,139 @@ void MicrostructureAnalysis::GrainsSurfaceArea(const PhaseField& Phase)
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 
-    vector<double> SurfaceVolume(size);
-
-    // Add surface volumes from different OpenMP chunks
-    for(size_t idx = 0; idx < size; idx++)
+    // Add surface volumes from different OpenMP threads
+    vector<double> SurfaceVolume(size, 0.0);
+    for(int t = 0; t < Nthreads; t++)
+    for(const auto& [index, volume] : ThreadsSurfaceVolume[t])
     {
-        for(int t = 0; t < Nthreads; t++)
-        {
-            SurfaceVolume[idx] += ThreadsSurfaceVolume[t][idx];
-        }
+        SurfaceVolume[index] += volume;
     }
 
     // Update SurfaceVolume across MPI domains
 #ifdef MPI_PARALLEL
-    size_t loc_size = size;
-    size_t max_size = size;
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, SurfaceVolume.data(), size, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+#endif
 
-    OP_MPI_Allreduce(&loc_size, &max_size, 1, OP_MPI_UNSIGNED_LONG_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
-    if (max_size > loc_size)
+    // Calculate surface area from surface volume
+    for(size_t idx = 0; idx < SurfaceVolume.size(); idx++)
     {
-        SurfaceVolume.resize(max_size);
+        SurfaceVolume[idx] /= Phase.Grid.iWidth;
     }
+    return SurfaceVolume;
+}
 
-    for(size_t idx = 0; idx < SurfaceVolume.size(); idx++)
+void MicrostructureAnalysis::GrainSizeDistribution(const PhaseField& Phase, const int tStep, const size_t Nbins)
+{
+    const GrainGraph_t Graph = GrainGraph(Phase);
+
+    double Sums[2] = {0.0, 0.0};  // number of present grains, total volume
+    for(const double Volume : Graph.Volumes)
+    if(Volume > 0.0)
     {
-        double loc_surface_volume = SurfaceVolume[idx];
-        OP_MPI_Allreduce(&loc_surface_volume, &(SurfaceVolume[idx]), 1, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        Sums[0] += 1.0;
+        Sums[1] += Volume;
     }
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, Sums, 2, OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
 #endif
+    const double MeanVolume = (Sums[0] > 0.0) ? Sums[1]/Sums[0] : 1.0;
+    const double BinWidth = 3.0/max(Nbins, size_t(1));
 
-    // Calculate surface area from surface volume
-    for(size_t idx = 0; idx < SurfaceVolume.size(); idx++)
+    vector<double> Histogram(max(Nbins, size_t(1)), 0.0);
+    for(const double Volume : Graph.Volumes)
+    if(Volume > 0.0)
     {
-        SurfaceVolume[idx] /= Phase.Grid.iWidth;
+        Histogram[min(size_t(Volume/MeanVolume/BinWidth), Histogram.size() - 1)] += 1.0;
+    }
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, Histogram.data(), Histogram.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    if(MPI_RANK != 0) return;
+#endif
+    ofstream out(DefaultTextDir + "GrainSizeDistribution.dat", tStep ? ios::app : ios::out);
+    out.precision(10);
+    out << tStep << " " << Sums[0] << " " << MeanVolume*Phase.Grid.CellVolume();
+    for(const double Count : Histogram) out << " " << Count;
+    out << endl;
+}
+
+void MicrostructureAnalysis::GrainConnectivityStatistics(const PhaseField& Phase, const BoundaryConditions& BC, const int tStep)
+{
+    Storage3D<size_t,0> Labels;
+    const vector<ConnectedComponents::Component_t> Components =
+        ConnectedComponents::Label(Phase.Grid, BC, ConnectedComponents::GrainKey(Phase), Labels);
+
+    vector<size_t> Parts(Phase.FieldsProperties.size(), 0);
+    for(const auto& Component : Components) Parts[Component.Key]++;
+    const size_t Ngrains = count_if(Parts.begin(), Parts.end(), [](size_t n){return n > 0;});
+    const size_t Ndisconnected = count_if(Parts.begin(), Parts.end(), [](size_t n){return n > 1;});
+#ifdef MPI_PARALLEL
+    if(MPI_RANK != 0) return;
+#endif
+    ofstream out(DefaultTextDir + "GrainConnectivity.dat", tStep ? ios::app : ios::out);
+    out << tStep << " " << Ngrains << " " << Components.size() << " " << Ndisconnected << endl;
+}
+
+void MicrostructureAnalysis::GrainTopologyStatistics(const PhaseField& Phase, const int tStep)
+{
+    if(Phase.IncrementalGrainsTopology and Phase.Topology.Valid())
+    {
+        /* The global graph is replicated on all ranks, only the topological
+        changes since the last call are exchanged.*/
+        Phase.Topology.Synchronize();
+#ifdef MPI_PARALLEL
+        if(MPI_RANK != 0) return;
+#endif
+        vector<double> Histogram;
+        for(size_t idx = 0; idx < Phase.FieldsProperties.size(); idx++)
+        if(Phase.FieldsProperties[idx].Volume > 0.0)
+        {
+            const size_t Count = Phase.Topology.NumberOfNeighbours(idx);
+            if(Histogram.size() <= Count) Histogram.resize(Count + 1, 0.0);
+            Histogram[Count] += 1.0;
+        }
+        WriteGrainTopology(Histogram, tStep);
+        return;
+    }
+
+    const GrainGraph_t Graph = GrainGraph(Phase);
+    const vector<size_t> Counts = NeighbourCounts(Graph);
+
+    size_t MaxCount = 0;
+    for(size_t n = 0; n < Graph.size(); n++)
+    if(Graph.Volumes[n] > 0.0)
+    {
+        MaxCount = max(MaxCount, Counts[n]);
     }
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &MaxCount, 1, OP_MPI_UNSIGNED_LONG_LONG, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+#endif
+    vector<double> Histogram(MaxCount + 1, 0.0);
+    for(size_t n = 0; n < Graph.size(); n++)
+    if(Graph.Volumes[n] > 0.0)
+    {
+        Histogram[Counts[n]] += 1.0;
+    }
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, Histogram.data(), Histogram.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+    if(MPI_RANK != 0) return;
+#endif
+    WriteGrainTopology(Histogram, tStep);
+}
+
+void MicrostructureAnalysis::WriteGrainTopology(const vector<double>& Histogram, const int tStep)
+{
+    double Grains = 0.0;
+    double Faces  = 0.0;
+    for(size_t n = 0; n < Histogram.size(); n++)
+    {
+        Grains += Histogram[n];
+        Faces  += Histogram[n]*n;
+    }
+    ofstream out(DefaultTextDir + "GrainTopology.dat", tStep ? ios::app : ios::out);
+    out.precision(10);
+    out << tStep << " " << Grains << " " << ((Grains > 0.0) ? Faces/Grains : 0.0);
+    for(const double Count : Histogram) out << " " << Count;
+    out << endl;
 }
 
 double MicrostructureAnalysis::GrainBoundaryStatistics(PhaseField& Phase, std::vector<dVector3> Facets, double DegreeTolerance)
@@ -155,189 +550,295 @@ double MicrostructureAnalysis::GrainBoundaryStatistics(PhaseField& Phase, std::v
     }
 }
 
-void MicrostructureAnalysis::WriteEBSDDataQuaternions(const PhaseField& Phase, const int tStep, double scale)
+Quaternion MicrostructureAnalysis::MajorityOrientation(const PhaseField& Phase,
+        const SymmetryVariants* SV, const long int i, const long int j,
+        const long int k, size_t& pIndex, double& value)
 {
-    stringstream outbuffer;
-    outbuffer << "Index\t"
-              << "Phase\t"
-              << "X\t"
-              << "Y\t"
-              << "Z\t"
-              << "Quat_real\t"
-              << "Quat_i\t"
-              << "Quat_j\t"
-              << "Quat_k\t" << endl;
-
-    int index = 1;
-    STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0)
+    Quaternion tempQuat;
+    pIndex = 0;
+    value  = 0.0;
+    // selecting the quaternion of the majority phase field.
+    for(auto alpha = Phase.Fields(i, j, k).cbegin();
+             alpha != Phase.Fields(i, j, k).cend(); ++alpha)
+    if(alpha->value > value)
     {
-        Quaternion  tempQuat;
-
-        size_t pIndex = 0;
-        // selecting the quaternion of the majority phase field.
-        double value = 0.0;
-        for(auto alpha = Phase.Fields(i, j, k).cbegin();
-                 alpha != Phase.Fields(i, j, k).cend(); ++alpha)
-        if(alpha->value > value)
+        pIndex = Phase.FieldsProperties[alpha->index].Phase;
+        tempQuat = Phase.FieldsProperties[alpha->index].Orientation;
+        if(SV != nullptr)
         {
-            tempQuat = Phase.FieldsProperties[alpha->index].Orientation;
-            value = alpha->value;
-            pIndex = Phase.FieldsProperties[alpha->index].Phase;
+            size_t variant = Phase.FieldsProperties[alpha->index].Variant;
+            Quaternion locQ;
+            dMatrix3x3 locRM = (*SV)(pIndex,variant);
+            locQ.set(locRM);
+            tempQuat = tempQuat + locQ;
         }
-
-        tempQuat.normalize();
-        outbuffer << index       << "\t"
-                  << pIndex + 1  << "\t"
-                  << i*scale     << "\t"
-                  << j*scale     << "\t"
-                  << k*scale     << "\t"
-                  << tempQuat[0] << "\t"
-                  << tempQuat[1] << "\t"
-                  << tempQuat[2] << "\t"
-                  << tempQuat[3] << endl;
-        index++;
+        value = alpha->value;
     }
-    STORAGE_LOOP_END
-
-    string FileName = FileInterface::MakeFileName(DefaultRawDataDir, "EBSD_", tStep, ".dat");
-
-    ofstream ebsd_file(FileName.c_str());
-    ebsd_file << outbuffer.rdbuf();
-    ebsd_file.close();
+    tempQuat.normalize();
+    return tempQuat;
 }
 
-void MicrostructureAnalysis::WriteEBSDDataQuaternionsSlice(const PhaseField& Phase, const int tStep,
-                            const char Axis, const int Position, double scale)
+void MicrostructureAnalysis::WriteEBSDText(const PhaseField& Phase,
+        const SymmetryVariants* SV, const int tStep, const char Axis,
+        const int Position, const double scale)
 {
-    stringstream outbuffer;
-    outbuffer << "Index\t"
-              << "Phase\t";
+    /* Axis == 0 writes the entire (local) domain, otherwise the slice
+     * normal to Axis at the local grid position Position. Row n is mapped
+     * onto the grid cell directly, so the rows can be formatted in parallel
+     * while keeping the order of the former serial storage loop. */
+
+    const long int Nx = Phase.Fields.sizeX();
+    const long int Ny = Phase.Fields.sizeY();
+    const long int Nz = Phase.Fields.sizeZ();
+
+    stringstream header;
+    header << "Index\t"
+           << "Phase\t";
     if(Axis != 'X')
     {
-        outbuffer << "X\t";
+        header << "X\t";
     }
     if(Axis != 'Y')
     {
-        outbuffer << "Y\t";
+        header << "Y\t";
     }
     if(Axis != 'Z')
     {
-        outbuffer << "Z\t";
+        header << "Z\t";
     }
+    header << "Quat_real\t"
+           << "Quat_i\t"
+           << "Quat_j\t"
+           << "Quat_k\t" << endl;
 
-    outbuffer << "Quat_real\t"
-              << "Quat_i\t"
-              << "Quat_j\t"
-              << "Quat_k\t" << endl;
+    size_t Nrows = 0;
+    switch(Axis)
+    {
+        case 0:   Nrows = Nx*Ny*Nz; break;
+        case 'X': Nrows = (Position >= 0 and Position < Nx) ? Ny*Nz : 0; break;
+        case 'Y': Nrows = (Position >= 0 and Position < Ny) ? Nx*Nz : 0; break;
+        case 'Z': Nrows = (Position >= 0 and Position < Nz) ? Nx*Ny : 0; break;
+        default:  break;
+    }
 
-    int index = 1;
-    STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0)
+    string NameBase = "EBSD_";
+    if(Axis != 0)
     {
-        if((Axis == 'X' and i == Position) or
-           (Axis == 'Y' and j == Position) or
-           (Axis == 'Z' and k == Position))
+        stringstream sliceInd;
+        sliceInd << Axis << "-" << Position << "_";
+        NameBase += sliceInd.str();
+    }
+    string FileName = FileInterface::MakeFileName(DefaultRawDataDir, NameBase, tStep, ".dat");
+
+    FileInterface::WriteRows(FileName, header.str(), Nrows,
+                             [&](ostream& out, const size_t n)
+    {
+        const long int m = n;
+        long int i = 0;
+        long int j = 0;
+        long int k = 0;
+        switch(Axis)
         {
-            Quaternion  tempQuat;
-            size_t pIndex = 0;
-
-            // selecting the quaternion of the majority phase field.
-            double value = 0.0;
-            for(auto alpha = Phase.Fields(i, j, k).cbegin();
-                     alpha != Phase.Fields(i, j, k).cend(); ++alpha)
-            if(alpha->value > value)
-            {
-                pIndex = Phase.FieldsProperties[alpha->index].Phase;
-                tempQuat = Phase.FieldsProperties[alpha->index].Orientation;
-                value = alpha->value;
-            }
+            case 'X': i = Position; j = m/Nz;      k = m%Nz;     break;
+            case 'Y': i = m/Nz;     j = Position;  k = m%Nz;     break;
+            case 'Z': i = m/Ny;     j = m%Ny;      k = Position; break;
+            default:  i = m/(Ny*Nz); j = (m/Nz)%Ny; k = m%Nz;    break;
+        }
 
-            tempQuat.normalize();
+        size_t pIndex = 0;
+        double value  = 0.0;
+        Quaternion tempQuat = MajorityOrientation(Phase, SV, i, j, k, pIndex, value);
 
-            outbuffer << index       << "\t"
-                      << pIndex + 1  << "\t";
-            if(Axis != 'X')
-            {
-                outbuffer << i*scale << "\t";
-            }
-            if(Axis != 'Y')
-            {
-                outbuffer << j*scale << "\t";
-            }
-            if(Axis != 'Z')
-            {
-                outbuffer << k*scale << "\t";
-            }
-            outbuffer << tempQuat[0] << "\t"
-                      << tempQuat[1] << "\t"
-                      << tempQuat[2] << "\t"
-                      << tempQuat[3] << endl;
-            index++;
+        out << n + 1       << "\t"
+            << pIndex + 1  << "\t";
+        if(Axis != 'X')
+        {
+            out << i*scale << "\t";
         }
-    }
-    STORAGE_LOOP_END
-    stringstream sliceInd;
-    sliceInd << Axis << "-" << Position << "_";
-    string FileName = FileInterface::MakeFileName(DefaultRawDataDir, "EBSD_" + sliceInd.str(), tStep, ".dat");
+        if(Axis != 'Y')
+        {
+            out << j*scale << "\t";
+        }
+        if(Axis != 'Z')
+        {
+            out << k*scale << "\t";
+        }
+        out << tempQuat[0] << "\t"
+            << tempQuat[1] << "\t"
+            << tempQuat[2] << "\t"
+            << tempQuat[3] << "\n";
+    });
+}
+
+void MicrostructureAnalysis::WriteEBSDDataQuaternions(const PhaseField& Phase, const int tStep, double scale)
+{
+    WriteEBSDText(Phase, nullptr, tStep, 0, 0, scale);
+}
 
-    ofstream ebsd_file(FileName.c_str());
-    ebsd_file << outbuffer.rdbuf();
-    ebsd_file.close();
+void MicrostructureAnalysis::WriteEBSDDataQuaternionsSlice(const PhaseField& Phase, const int tStep,
+                            const char Axis, const int Position, double scale)
+{
+    WriteEBSDText(Phase, nullptr, tStep, Axis, Position, scale);
 }
 
 void MicrostructureAnalysis::WriteEBSDDataQuaternions(const PhaseField& Phase, const SymmetryVariants& SV, const int tStep, double scale)
 {
-    stringstream outbuffer;
-    outbuffer << "Index\t"
-              << "Phase\t"
-              << "X\t"
-              << "Y\t"
-              << "Z\t"
-              << "Quat_real\t"
-              << "Quat_i\t"
-              << "Quat_j\t"
-              << "Quat_k\t" << endl;
-
-    int index = 1;
-    STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0)
+    WriteEBSDText(Phase, &SV, tStep, 0, 0, scale);
+}
+
+void MicrostructureAnalysis::WriteEBSDDataQuaternionsSlice(const PhaseField& Phase, const SymmetryVariants& SV, const int tStep,
+                            const char Axis, const int Position, double scale)
+{
+    WriteEBSDText(Phase, &SV, tStep, Axis, Position, scale);
+}
+
+vector<array<float,5>> MicrostructureAnalysis::EBSDPoints(const PhaseField& Phase,
+                                                          const SymmetryVariants* SV)
+{
+    const long int Ny = Phase.Fields.sizeY();
+    const long int Nz = Phase.Fields.sizeZ();
+
+    vector<array<float,5>> Points(Phase.Fields.sizeX()*Ny*Nz);
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0,)
     {
-        Quaternion  tempQuat;
-        int pIndex = 0;
+        size_t pIndex = 0;
+        double value  = 0.0;
+        Quaternion tempQuat = MajorityOrientation(Phase, SV, i, j, k, pIndex, value);
 
-        // selecting the quaternion of the majority phase field.
-        double value = 0.0;
-        for(auto alpha = Phase.Fields(i, j, k).cbegin();
-                 alpha != Phase.Fields(i, j, k).cend(); ++alpha)
-        if(alpha->value > value)
-        {
-            pIndex = Phase.FieldsProperties[alpha->index].Phase;
-            int variant = Phase.FieldsProperties[alpha->index].Variant;
-            Quaternion locQ;
-            dMatrix3x3 locRM = SV(pIndex,variant);
-            locQ.set(locRM);
-            tempQuat = Phase.FieldsProperties[alpha->index].Orientation + locQ;
-            value = alpha->value;
-        }
+        Points[(i*Ny + j)*Nz + k] = {float(pIndex + 1),
+                                     float(tempQuat[0]), float(tempQuat[1]),
+                                     float(tempQuat[2]), float(tempQuat[3])};
+    }
+    OMP_PARALLEL_STORAGE_LOOP_END
+    return Points;
+}
+
+void MicrostructureAnalysis::WriteEBSDH5(const PhaseField& Phase, H5Interface& H5,
+                                         const int tStep, const SymmetryVariants* SV)
+{
+    const long int Nx = Phase.Fields.sizeX();
+    const long int Ny = Phase.Fields.sizeY();
+    const long int Nz = Phase.Fields.sizeZ();
+
+    const vector<array<float,5>> Points = EBSDPoints(Phase, SV);
 
-        tempQuat.normalize();
+    H5.ForEach(tStep, "EBSD", Nx, Ny, Nz, [&](int i, int j, int k)
+    {
+        return Points[(i*Ny + j)*Nz + k];
+    });
+}
+
+void MicrostructureAnalysis::WriteEBSDNpy(const PhaseField& Phase, const int tStep,
+                                          const SymmetryVariants* SV)
+{
+    const vector<array<float,5>> Points = EBSDPoints(Phase, SV);
+
+    stringstream Dictionary;
+    Dictionary << "{'descr': '<f4', 'fortran_order': False, 'shape': ("
+               << Phase.Fields.sizeX() << ", "
+               << Phase.Fields.sizeY() << ", "
+               << Phase.Fields.sizeZ() << ", 5), }";
+    string Header = Dictionary.str();
+
+    /* The magic string, the format version, the header length and the
+     * newline terminated header are padded to a multiple of 64 bytes. The
+     * data are written in the native byte order, little endian is assumed. */
+    const size_t Preamble = 10;
+    Header.append((64 - (Preamble + Header.size() + 1) % 64) % 64, ' ');
+    Header += '\n';
+
+    string Extension = ".npy";
+    #ifdef MPI_PARALLEL
+    Extension = "_" + to_string(MPI_RANK) + Extension;
+    #endif
+    string FileName = FileInterface::MakeFileName(DefaultRawDataDir, "EBSD_", tStep, Extension);
 
-        outbuffer << index       << "\t"
-                  << pIndex + 1  << "\t"
-                  << i*scale     << "\t"
-                  << j*scale     << "\t"
-                  << k*scale     << "\t"
-                  << tempQuat[0] << "\t"
-                  << tempQuat[1] << "\t"
-                  << tempQuat[2] << "\t"
-                  << tempQuat[3] << endl;
-        index++;
+    ofstream out(FileName, ios::out | ios::binary);
+    if(!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be created",
+                                    "MicrostructureAnalysis", "WriteEBSDNpy()");
+        return;
     }
-    STORAGE_LOOP_END
+    const uint16_t HeaderSize = Header.size();
+    out.write("\x93NUMPY", 6);
+    out.put(1);
+    out.put(0);
+    out.put(char(HeaderSize & 0xff));
+    out.put(char(HeaderSize >> 8));
+    out << Header;
+    out.write(reinterpret_cast<const char*>(Points.data()),
+              Points.size()*sizeof(array<float,5>));
+    out.close();
+}
+
+void MicrostructureAnalysis::WriteEBSDANG(const PhaseField& Phase, const int tStep,
+                                          const int Position, const double Step,
+                                          const SymmetryVariants* SV)
+{
+    /* TSL OIM map of the slice normal to Z at the global grid position
+     * Position. Each rank writes the part of the map it holds, the x and y
+     * coordinates are global. The confidence index column holds the value
+     * of the majority phase field, so the interfaces are distinguishable. */
+
+    const long int k = Position - Phase.Grid.OffsetZ;
+    if(k < 0 or k >= Phase.Fields.sizeZ()) return;
+
+    const long int Nx = Phase.Fields.sizeX();
+    const long int Ny = Phase.Fields.sizeY();
+    const long int OffsetX = Phase.Grid.OffsetX;
+    const long int OffsetY = Phase.Grid.OffsetY;
+
+    stringstream header;
+    header << "# TEM_PIXperUM          1.000000\n";
+    for(size_t n = 0; n < Phase.PhaseNames.size(); n++)
+    {
+        header << "# Phase " << n + 1 << "\n"
+               << "# MaterialName  \t" << Phase.PhaseNames[n] << "\n"
+               << "#\n";
+    }
+    header << "# GRID: SqrGrid\n"
+           << "# XSTEP: " << Step << "\n"
+           << "# YSTEP: " << Step << "\n"
+           << "# NCOLS_ODD: " << Nx << "\n"
+           << "# NCOLS_EVEN: " << Nx << "\n"
+           << "# NROWS: " << Ny << "\n"
+           << "#\n"
+           << "# OPERATOR: \tOpenPhase\n"
+           << "#\n"
+           << "# SCANID: \tEBSD_Z-" << Position << "_" << tStep << "\n"
+           << "#\n";
+
+    string Extension = ".ang";
+    #ifdef MPI_PARALLEL
+    Extension = "_" + to_string(MPI_RANK) + Extension;
+    #endif
+    stringstream sliceInd;
+    sliceInd << "EBSD_Z-" << Position << "_";
+    string FileName = FileInterface::MakeFileName(DefaultRawDataDir, sliceInd.str(), tStep, Extension);
+
+    FileInterface::WriteRows(FileName, header.str(), Nx*Ny,
+                             [&](ostream& out, const size_t n)
+    {
+        const long int i = n%Nx;
+        const long int j = n/Nx;
 
-    string FileName = FileInterface::MakeFileName(DefaultRawDataDir, "EBSD_", tStep, ".dat");
+        size_t pIndex = 0;
+        double value  = 0.0;
+        Quaternion tempQuat = MajorityOrientation(Phase, SV, i, j, k, pIndex, value);
 
-    ofstream ebsd_file(FileName.c_str());
-    ebsd_file << outbuffer.rdbuf();
-    ebsd_file.close();
+        EulerAngles tempAng;
+        tempAng.set(tempQuat, ZXZ, false);
+        const double phi1 = fmod(tempAng.Q[0] + 2.0*Pi, 2.0*Pi);
+        const double phi2 = fmod(tempAng.Q[2] + 2.0*Pi, 2.0*Pi);
+
+        out << fixed << setprecision(5)
+            << phi1 << " " << tempAng.Q[1] << " " << phi2 << " "
+            << (i + OffsetX)*Step << " " << (j + OffsetY)*Step << " "
+            << setprecision(1) << 0.0 << " "
+            << setprecision(3) << value << " "
+            << pIndex + 1 << " 0 " << 0.0 << "\n";
+    });
 }
 
 void MicrostructureAnalysis::WriteGlobalFeatures(PhaseField& Phase, const DoubleObstacle& DO, H5Interface& H5, const RunTimeControl& RTC, const InterfaceProperties& IP)
@@ -393,88 +894,6 @@ void MicrostructureAnalysis::WriteGlobalFeatures(PhaseField& Phase, const Double
     }
 }
 
-void MicrostructureAnalysis::WriteEBSDDataQuaternionsSlice(const PhaseField& Phase, const SymmetryVariants& SV, const int tStep,
-                            const char Axis, const int Position, double scale)
-{
-    stringstream outbuffer;
-    outbuffer << "Index\t"
-              << "Phase\t";
-    if(Axis != 'X')
-    {
-        outbuffer << "X\t";
-    }
-    if(Axis != 'Y')
-    {
-        outbuffer << "Y\t";
-    }
-    if(Axis != 'Z')
-    {
-        outbuffer << "Z\t";
-    }
-
-    outbuffer << "Quat_real\t"
-              << "Quat_i\t"
-              << "Quat_j\t"
-              << "Quat_k\t" << endl;
-
-    int index = 1;
-    STORAGE_LOOP_BEGIN(i,j,k,Phase.Fields,0)
-    {
-        if((Axis == 'X' and i == Position) or
-           (Axis == 'Y' and j == Position) or
-           (Axis == 'Z' and k == Position))
-        {
-            Quaternion  tempQuat;
-            size_t pIndex = 0;
-
-            // selecting the quaternion of the majority phase field.
-            double value = 0.0;
-            for(auto alpha = Phase.Fields(i, j, k).cbegin();
-                     alpha != Phase.Fields(i, j, k).cend(); ++alpha)
-            if(alpha->value > value)
-            {
-                pIndex = Phase.FieldsProperties[alpha->index].Phase;
-                size_t variant = Phase.FieldsProperties[alpha->index].Variant;
-                Quaternion locQ;
-                dMatrix3x3 locRM = SV(pIndex,variant);
-                locQ.set(locRM);
-                tempQuat = Phase.FieldsProperties[alpha->index].Orientation + locQ;
-                value = alpha->value;
-            }
-
-            tempQuat.normalize();
-
-            outbuffer << index       << "\t"
-                      << pIndex + 1  << "\t";
-            if(Axis != 'X')
-            {
-                outbuffer << i*scale << "\t";
-            }
-            if(Axis != 'Y')
-            {
-                outbuffer << j*scale << "\t";
-            }
-            if(Axis != 'Z')
-            {
-                outbuffer << k*scale << "\t";
-            }
-            outbuffer << tempQuat[0] << "\t"
-                      << tempQuat[1] << "\t"
-                      << tempQuat[2] << "\t"
-                      << tempQuat[3] << endl;
-            index++;
-        }
-    }
-    STORAGE_LOOP_END
-    stringstream sliceInd;
-    sliceInd << Axis << "-" << Position << "_";
-    string FileName = FileInterface::MakeFileName(DefaultRawDataDir, "EBSD_" + sliceInd.str(), tStep, ".dat");
-
-    ofstream ebsd_file(FileName.c_str());
-    ebsd_file << outbuffer.rdbuf();
-    ebsd_file.close();
-}
-
 // Reference sample direction (sd) input as an integer between 1 and 3. Options are [100], [010], and [001], respectively.
 void MicrostructureAnalysis::WriteEBSDVTK(PhaseField& Phase, Crystallography& CR, const Settings& locSettings, EulerConvention locConvention, const int sd, const int tStep)
 {
@@ -709,149 +1128,49 @@ void MicrostructureAnalysis::WriteSymmetryVariantsStatistics(size_t pIndex, cons
 
 void MicrostructureAnalysis::WriteGrainsStatistics(const PhaseField& Phase, const int tStep, const std::string& h5FileName)
 {
-/// ++++++++++++++++++++++++++++++++++++++++++++
-    size_t nPFs = Phase.FieldsProperties.size();
-
-    map<size_t, size_t> AllGrains;
-    map <size_t,size_t> pairs;
-
-    pairs.clear();
-    AllGrains.clear();
-
-    for (int i = 1; i < Phase.Grid.Nx+1; ++i)
-    for (int j = 1; j < Phase.Grid.Ny+1; ++j)
-    for (int k = 1; k < Phase.Grid.Nz+1; ++k)
-    {
-      if (Phase.Fields(i, j, k).interface() && Phase.Fields(i, j, k).size() == 2)
-      {
-        int idx1 = Phase.Fields(i, j, k).cbegin()->index;
-        int idx2 = (Phase.Fields(i, j, k).cbegin()+1)->index;
-        pairs[nPFs*idx1 + idx2] = 1;
-        pairs[nPFs*idx2 + idx1] = 1;
-      }
-      for(auto n = Phase.Fields(i, j, k).cbegin(); n < Phase.Fields(i, j, k).cend();++n)
-      {
-          AllGrains[n->index] += n->value;
-      }
-    }
-
-    double AveSize = double(Phase.Grid.LocalNumberOfCells())/AllGrains.size();
-/// ++++++++++++++++++++++++++++++++++++++++++++ ///
-
-    ofstream Fl1;  /// 添加晶粒尺寸信息
-    ofstream Fl2;  /// 添加晶粒体积信息
-    ofstream Fl3;  /// 添加晶粒邻接数量信息
-    ofstream Fl4; /// 添加晶粒之间具体的连接信息
-    if(tStep)
-    {
-        Fl1.open( DefaultTextDir + "SizeAveInfo.dat", ios::app);
-        Fl2.open( DefaultTextDir + "SizeDetails.dat", ios::app);
-        Fl3.open( DefaultTextDir + "NeighboInfo.dat", ios::app);
-        Fl4.open( DefaultTextDir + "GrainConnections.dat", ios::app);
-    }
-    else
-    {
-        Fl1.open( DefaultTextDir + "SizeAveInfo.dat", ios::out);
-        Fl2.open( DefaultTextDir + "SizeDetails.dat", ios::out);
-        Fl3.open( DefaultTextDir + "NeighboInfo.dat", ios::out);
-        Fl4.open( DefaultTextDir + "GrainConnections.dat", ios::out);
-    }
-    Fl1.precision(10);
-    Fl2.precision(10);
-    /// ++++++++++++++++++++++++++++++++++++++++++++
-    Fl1 << tStep << " " << AllGrains.size() << " " << AveSize << " " << AveSize*Phase.Grid.CellVolume() << endl;
-    Fl1.close();
-    /// ++++++++++++++++++++++++++++++++++++++++++++
-    Fl2 << tStep << " " << Phase.FieldsProperties.size() << " ";
-    for (size_t i = 0; i < nPFs; i++)
-    {
-        Fl2 << Phase.FieldsProperties[i].Volume << " ";
-    }
-    Fl2 << endl;
-    Fl2.close();
-    /// ++++++++++++++++++++++++++++++++++++++++++++
-    Fl3 << tStep << " " << Phase.FieldsProperties.size() << " ";
-    vector<size_t> sumpairs(nPFs);
-    sumpairs.assign(nPFs, 0);
-    for(size_t i = 0; i < nPFs; ++i)
-    {
-        for(size_t j = 0; j < nPFs; ++j)
-        {
-            if ((i != j) && (pairs.find(i*nPFs+j) != pairs.end())) sumpairs[i] += pairs.find(i*nPFs+j)->second;
-        }
-        Fl3 << sumpairs[i] << " ";
-    }
-    Fl3 << endl;
-    Fl3.close();
+    const GrainGraph_t Graph = GrainGraph(Phase);
+    vector<size_t> Counts;
+    vector<size_t> Neighbours;
+    WriteGrainsText(Phase, tStep, Graph, Counts, Neighbours);
 
-    /// ++++++++++++++++++++++++++++++++++++++++++++添加晶粒之间的连接信息
-
-    Fl4 << "# TimeStep: " << tStep << endl;
-    for (size_t i = 0; i < nPFs; ++i)
-    {
-        vector<size_t> neighbors;
-        for (size_t j = 0; j < nPFs; ++j)
-        {
-            if ((i != j) && (pairs.find(i * nPFs + j) != pairs.end()))
-                neighbors.push_back(j);
-        }
-        if (!neighbors.empty())
-        {
-            Fl4 << i << ": ";
-            for (auto n : neighbors)
-                Fl4 << n << " ";
-            Fl4 << endl;
-        }
-    }
-    Fl4.close();
-
-    /// ++++++++++++++++++++++++++++++++++++++++++++
     /// Write grain statistics to HDF5 file (if available)
     #ifdef H5OP
+    #ifdef MPI_PARALLEL
+    if(MPI_RANK != 0) return;
+    #endif
     if (!h5FileName.empty())
     {
         try {
-            // Collect grain volumes
-            std::vector<double> GrainVolumes;
-            std::vector<double> GrainNeighbors;
+            const size_t nPFs = Counts.size();
+            std::vector<double> GrainVolumes(nPFs);
+            std::vector<double> GrainNeighbors(nPFs);
             std::vector<double> GrainConnections;
-            
+
             // Build edge_index (row, col) format for ML/GNN
             std::vector<double> EdgeIndexRow;
             std::vector<double> EdgeIndexCol;
-            
-            for (size_t i = 0; i < nPFs; i++)
+
+            for (size_t i = 0, n = 0; i < nPFs; n += Counts[i], i++)
             {
-                GrainVolumes.push_back(Phase.FieldsProperties[i].Volume);
-                
-                // Count neighbors for this grain
-                std::vector<size_t> neighbors;
-                for(size_t j = 0; j < nPFs; ++j)
-                {
-                    if ((i != j) && (pairs.find(i*nPFs+j) != pairs.end()))
-                        neighbors.push_back(j);
-                }
-                GrainNeighbors.push_back((double)neighbors.size());
-                
+                GrainVolumes[i] = (i < Phase.FieldsProperties.size()) ? Phase.FieldsProperties[i].Volume : 0.0;
+                GrainNeighbors[i] = Counts[i];
+
                 // Flatten grain connections for HDF5 storage
                 // Format: [grain_id, neighbor_count, neighbor1, neighbor2, ...]
-                GrainConnections.push_back((double)i);  // grain ID
-                GrainConnections.push_back((double)neighbors.size());  // number of neighbors
-                for (const auto& neighbor : neighbors)
+                GrainConnections.push_back(i);
+                GrainConnections.push_back(Counts[i]);
+                for (size_t m = n; m < n + Counts[i]; m++)
                 {
-                    GrainConnections.push_back((double)neighbor);  // neighbor IDs
-                }
-                
-                // Build edge_index (row, col) for ML/GNN
-                // For undirected graph, we include both (i, j) and (j, i)
-                for (const auto& neighbor : neighbors)
-                {
-                    EdgeIndexRow.push_back((double)i);  // source node
-                    EdgeIndexCol.push_back((double)neighbor);  // target node
+                    GrainConnections.push_back(Neighbours[m]);
+                    // For undirected graph, we include both (i, j) and (j, i)
+                    EdgeIndexRow.push_back(i);
+                    EdgeIndexCol.push_back(Neighbours[m]);
                 }
             }
-            
-            // Write to HDF5 file
+
+            // Write to HDF5 file, pending background output has to be
+            // finished first since HDF5 calls are not thread safe
+            AsyncOutput::Flush();
             H5Easy::File file(h5FileName, H5Easy::File::OpenOrCreate);
             
             // Create CheckPoints group if not exists
@@ -911,7 +1230,44 @@ void MicrostructureAnalysis::WriteGrainsStatistics(const PhaseField& Phase, cons
         }
     }
     #endif
-    /// ++++++++++++++++++++++++++++++++++++++++++++
+}
+
+void MicrostructureAnalysis::WriteGrainsStatistics(const PhaseField& Phase, const int tStep, H5Interface& H5)
+{
+    const GrainGraph_t Graph = GrainGraph(Phase);
+    vector<size_t> Counts;
+    vector<size_t> Neighbours;
+    WriteGrainsText(Phase, tStep, Graph, Counts, Neighbours);
+
+    /* Every rank writes the block of its grains, WriteCheckPoint() stores
+    the blocks consecutively in rank order, i.e. in grain order */
+    vector<double> GrainVolumes(Graph.size());
+    vector<double> GrainNeighbors(Graph.size());
+    vector<double> GrainConnections;
+    for(size_t n = 0; n < Graph.size(); n++)
+    {
+        const size_t Grain = Graph.First + n;
+        GrainVolumes[n] = (Grain < Phase.FieldsProperties.size()) ? Phase.FieldsProperties[Grain].Volume : 0.0;
+        GrainNeighbors[n] = Graph.Offsets[n+1] - Graph.Offsets[n];
+
+        GrainConnections.push_back(Grain);
+        GrainConnections.push_back(GrainNeighbors[n]);
+        for(size_t m = Graph.Offsets[n]; m < Graph.Offsets[n+1]; m++)
+        {
+            GrainConnections.push_back(Graph.Neighbours[m]);
+        }
+    }
+    H5.WriteCheckPoint(tStep, "GrainVolumes", GrainVolumes);
+    H5.WriteCheckPoint(tStep, "GrainNeighbors", GrainNeighbors);
+    H5.WriteCheckPoint(tStep, "GrainConnections", GrainConnections);
+    WriteGraphEdges(Phase, tStep, Graph, H5, false);
+}
+
+void MicrostructureAnalysis::WriteGrainGraph(const PhaseField& Phase, const int tStep,
+                                             H5Interface& H5, const bool CubicSymmetry)
+{
+    const GrainGraph_t Graph = GrainGraph(Phase);
+    WriteGraphEdges(Phase, tStep, Graph, H5, CubicSymmetry);
 }
 
 dVector3 MicrostructureAnalysis::FindValuePosition(PhaseField& Phi, size_t index, double value, dVector3 start_position, dVector3 direction, double tolerance)
@@ -0,0 +1,93 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "Tools/MisorientationCache.h"
+#include "Tools.h"
+
+namespace openphase
+{
+
+using namespace std;
+
+static array<double,4> Components(const Quaternion& Q)
+{
+    return {Q[0], Q[1], Q[2], Q[3]};
+}
+
+MisorientationCache::MisorientationCache(void)
+{
+    Tables.resize(max(omp_get_max_threads(), 1));
+}
+
+MisorientationCache::Entry MisorientationCache::Get(
+        const size_t indexA, const Quaternion& OrientationA,
+        const size_t indexB, const Quaternion& OrientationB) const
+{
+    /* The disorientation is symmetric in A and B (the inverse rotation has
+    the same angle and, after reduction to the standard triangle, the same
+    axis), the pair is stored under the ordered index. */
+    const bool swapped = (indexA > indexB);
+    const Quaternion& QA = swapped ? OrientationB : OrientationA;
+    const Quaternion& QB = swapped ? OrientationA : OrientationB;
+    const array<double,4> A = Components(QA);
+    const array<double,4> B = Components(QB);
+
+    const size_t thread = omp_get_thread_num();
+    if(thread >= Tables.size())
+    {
+        Entry Value;
+        Value.Angle = Tools::getDisorientationCubic(QA, QB, Value.Axis);
+        return Value;
+    }
+
+    auto& Table = Tables[thread];
+    const uint64_t key = (uint64_t(min(indexA, indexB)) << 32) ^ uint64_t(max(indexA, indexB));
+    auto it = Table.find(key);
+    if(it != Table.end() and it->second.OrientationA == A and it->second.OrientationB == B)
+    {
+        return it->second.Value;
+    }
+
+    if(it == Table.end() and Table.size() >= MaxEntries)
+    {
+        Table.clear();
+    }
+    Record& Rec = Table[key];
+    Rec.OrientationA = A;
+    Rec.OrientationB = B;
+    Rec.Value.Angle = Tools::getDisorientationCubic(QA, QB, Rec.Value.Axis);
+    return Rec.Value;
+}
+
+void MisorientationCache::Clear(void)
+{
+    for(auto& Table : Tables)
+    {
+        Table.clear();
+    }
+}
+
+}// namespace openphase
@@ -0,0 +1,181 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2025
+ *   Main contributors :   Oleg Shchyglo
+ *
+ */
+
+#include "Tools/PerformanceCounters.h"
+#ifdef PAPI
+#include <papi.h>
+#include <pthread.h>
+#endif
+
+namespace openphase
+{
+
+using namespace std;
+
+#ifdef PAPI
+static bool CountersRunning = false;
+static array<int, PerformanceCounters::Nevents> EventSlots;                     ///< Position of each event in the event sets, -1 if not counted
+static vector<int> EventSets;                                                   ///< PAPI event set of each thread
+static vector<PerformanceCounters::Values_t> ThreadValues;                      ///< Per thread buffer of Read()
+static const int PresetEvents[PerformanceCounters::Nevents] =
+    {PAPI_TOT_CYC, PAPI_TOT_INS, PAPI_DP_OPS, PAPI_L3_TCM};                     ///< PAPI presets of the counted events
+
+static bool StartThreadCounters(const int Thread)
+{
+    EventSets[Thread] = PAPI_NULL;
+    if(PAPI_create_eventset(&EventSets[Thread]) != PAPI_OK) return false;
+    for(int n = 0; n < PerformanceCounters::Nevents; n++)
+    if(EventSlots[n] >= 0)
+    {
+        if(PAPI_add_event(EventSets[Thread], PresetEvents[n]) != PAPI_OK) return false;
+    }
+    return PAPI_start(EventSets[Thread]) == PAPI_OK;
+}
+
+static void ReadThreadCounters(const int Thread)
+{
+    if(Thread >= int(EventSets.size()) or EventSets[Thread] == PAPI_NULL) return;
+
+    PerformanceCounters::Values_t& Values = ThreadValues[Thread];
+
+    long long Counts[PerformanceCounters::Nevents];
+    if(PAPI_read(EventSets[Thread], Counts) != PAPI_OK) return;
+    for(int n = 0; n < PerformanceCounters::Nevents; n++)
+    if(EventSlots[n] >= 0)
+    {
+        Values[n] = Counts[EventSlots[n]];
+    }
+}
+#endif
+
+bool PerformanceCounters::Start(void)
+{
+#ifdef PAPI
+    if(CountersRunning) return true;
+
+    if(PAPI_library_init(PAPI_VER_CURRENT) != PAPI_VER_CURRENT or
+       PAPI_thread_init(pthread_self) != PAPI_OK)
+    {
+        ConsoleOutput::WriteWarning("PAPI could not be initialized, hardware counters are disabled",
+                                    thisclassname, "Start()");
+        return false;
+    }
+
+    /* The events which can be counted together are selected once, every
+    thread then counts the same set */
+    int Probe = PAPI_NULL;
+    PAPI_create_eventset(&Probe);
+    int Nslots = 0;
+    for(int n = 0; n < Nevents; n++)
+    {
+        EventSlots[n] = -1;
+        if(PAPI_query_event(PresetEvents[n]) == PAPI_OK and
+           PAPI_add_event(Probe, PresetEvents[n]) == PAPI_OK)
+        {
+            EventSlots[n] = Nslots++;
+        }
+        else
+        {
+            ConsoleOutput::WriteWarning(string("Event \"") + EventNames[n] + "\" is not available",
+                                        thisclassname, "Start()");
+        }
+    }
+    PAPI_cleanup_eventset(Probe);
+    PAPI_destroy_eventset(&Probe);
+    if(Nslots == 0) return false;
+
+    const int Nthreads = omp_get_max_threads();
+    EventSets.assign(Nthreads, PAPI_NULL);
+    ThreadValues.assign(Nthreads, Values_t{});
+    int Failed = 0;
+    #pragma omp parallel reduction(+:Failed)
+    {
+        if(not StartThreadCounters(omp_get_thread_num())) Failed++;
+    }
+    if(Failed)
+    {
+        ConsoleOutput::WriteWarning("Hardware counters could not be started on "
+                                    + to_string(Failed) + " threads, their counts are missing",
+                                    thisclassname, "Start()");
+    }
+    CountersRunning = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool PerformanceCounters::Enabled(void)
+{
+#ifdef PAPI
+    return CountersRunning;
+#else
+    return false;
+#endif
+}
+
+bool PerformanceCounters::Available(const Events Event)
+{
+#ifdef PAPI
+    return CountersRunning and EventSlots[Event] >= 0;
+#else
+    return false;
+#endif
+}
+
+PerformanceCounters::Values_t PerformanceCounters::Read(void)
+{
+    Values_t Result{};
+#ifdef PAPI
+    if(not CountersRunning) return Result;
+
+    /* Inside a parallel region the other threads cannot be read */
+#ifdef _OPENMP
+    if(omp_in_parallel())
+    {
+        const int Thread = omp_get_thread_num();
+        if(Thread >= int(EventSets.size())) return Result;
+        ThreadValues[Thread].fill(0);
+        ReadThreadCounters(Thread);
+        return ThreadValues[Thread];
+    }
+#endif
+    const int Nthreads = EventSets.size();
+    for(auto& Values : ThreadValues) Values.fill(0);
+    #pragma omp parallel num_threads(Nthreads)
+    {
+        ReadThreadCounters(omp_get_thread_num());
+    }
+    for(int t = 0; t < Nthreads; t++)
+    for(int n = 0; n < Nevents; n++)
+    {
+        Result[n] += ThreadValues[t][n];
+    }
+#endif
+    return Result;
+}
+
+}// namespace openphase
@@ -0,0 +1,200 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Tools/ReductionBatch.h"
+
+namespace openphase
+{
+
+using namespace std;
+
+ReductionBatch::~ReductionBatch()
+{
+    if(Started) Finish();
+}
+
+void ReductionBatch::Sum(double* values, const size_t count)
+{
+    for(size_t n = 0; n < count; n++)
+    {
+        SumValues.push_back(values + n);
+    }
+}
+
+void ReductionBatch::Sum(ReproducibleSum* values, const size_t count)
+{
+    for(size_t n = 0; n < count; n++)
+    {
+        ExactValues.push_back(values + n);
+    }
+}
+
+void ReductionBatch::Max(double* values, const size_t count)
+{
+    for(size_t n = 0; n < count; n++)
+    {
+        MaxValues.push_back(values + n);
+        Negated.push_back(false);
+    }
+}
+
+void ReductionBatch::Min(double* values, const size_t count)
+{
+    for(size_t n = 0; n < count; n++)
+    {
+        MaxValues.push_back(values + n);
+        Negated.push_back(true);
+    }
+}
+
+void ReductionBatch::Start(void)
+{
+    if(Started)
+    {
+        ConsoleOutput::WriteExit("Reductions already started", "ReductionBatch", "Start()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    Started = true;
+#ifdef MPI_PARALLEL
+    Converted.clear();
+#ifdef DETERMINISTIC_REDUCTIONS
+    /* The double sums are reduced as exact accumulators as well, the result
+    does not depend on the order in which MPI combines the ranks */
+    for(double* value : SumValues)
+    {
+        Converted.emplace_back(*value);
+    }
+    const size_t nDoubles = 0;
+#else
+    const size_t nDoubles = SumValues.size();
+#endif
+    const size_t nExact = ExactValues.size() + Converted.size();
+    const size_t nDigits = ReproducibleSum::NumDigits;
+
+    /* The digits of the accumulators are summed as integers, their fallbacks
+    are summed together with the double values */
+    SumBuffer.resize(nDoubles + nExact);
+    for(size_t n = 0; n < nDoubles; n++)
+    {
+        SumBuffer[n] = *SumValues[n];
+    }
+    DigitBuffer.resize(nExact*nDigits);
+    for(size_t n = 0; n < nExact; n++)
+    {
+        ReproducibleSum& Accumulator = Exact(n);
+        Accumulator.Normalize();
+        for(size_t d = 0; d < nDigits; d++)
+        {
+            DigitBuffer[n*nDigits + d] = Accumulator.Digits[d];
+        }
+        SumBuffer[nDoubles + n] = Accumulator.Fallback;
+    }
+    MaxBuffer.resize(MaxValues.size());
+    for(size_t n = 0; n < MaxValues.size(); n++)
+    {
+        MaxBuffer[n] = Negated[n] ? -*MaxValues[n] : *MaxValues[n];
+    }
+    if(not SumBuffer.empty())
+    {
+        SumRequest = create_request();
+        OP_MPI_Iallreduce(OP_MPI_IN_PLACE, SumBuffer.data(), SumBuffer.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD, SumRequest);
+    }
+    if(not MaxBuffer.empty())
+    {
+        MaxRequest = create_request();
+        OP_MPI_Iallreduce(OP_MPI_IN_PLACE, MaxBuffer.data(), MaxBuffer.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD, MaxRequest);
+    }
+    if(not DigitBuffer.empty())
+    {
+        DigitRequest = create_request();
+        OP_MPI_Iallreduce(OP_MPI_IN_PLACE, DigitBuffer.data(), DigitBuffer.size(), OP_MPI_LONG_LONG, OP_MPI_SUM, OP_MPI_COMM_WORLD, DigitRequest);
+    }
+#endif
+}
+
+void ReductionBatch::Finish(void)
+{
+    if(not Started)
+    {
+        ConsoleOutput::WriteExit("Reductions not started", "ReductionBatch", "Finish()");
+        OP_Exit(EXIT_FAILURE);
+    }
+#ifdef MPI_PARALLEL
+    const size_t nExact = ExactValues.size() + Converted.size();
+    const size_t nDigits = ReproducibleSum::NumDigits;
+    if(SumRequest)
+    {
+        OP_MPI_Wait(SumRequest, OP_MPI_STATUS_IGNORE);
+        free_request(SumRequest);
+        SumRequest = nullptr;
+        const size_t nDoubles = SumBuffer.size() - nExact;
+        for(size_t n = 0; n < nDoubles; n++)
+        {
+            *SumValues[n] = SumBuffer[n];
+        }
+        for(size_t n = 0; n < nExact; n++)
+        {
+            Exact(n).Fallback = SumBuffer[nDoubles + n];
+        }
+    }
+    if(DigitRequest)
+    {
+        OP_MPI_Wait(DigitRequest, OP_MPI_STATUS_IGNORE);
+        free_request(DigitRequest);
+        DigitRequest = nullptr;
+        for(size_t n = 0; n < nExact; n++)
+        {
+            ReproducibleSum& Accumulator = Exact(n);
+            for(size_t d = 0; d < nDigits; d++)
+            {
+                Accumulator.Digits[d] = DigitBuffer[n*nDigits + d];
+            }
+            Accumulator.Normalize();
+        }
+    }
+#ifdef DETERMINISTIC_REDUCTIONS
+    for(size_t n = 0; n < SumValues.size(); n++)
+    {
+        *SumValues[n] = double(Converted[n]);
+    }
+#endif
+    if(MaxRequest)
+    {
+        OP_MPI_Wait(MaxRequest, OP_MPI_STATUS_IGNORE);
+        free_request(MaxRequest);
+        MaxRequest = nullptr;
+        for(size_t n = 0; n < MaxValues.size(); n++)
+        {
+            *MaxValues[n] = Negated[n] ? -MaxBuffer[n] : MaxBuffer[n];
+        }
+    }
+#endif
+    SumValues.clear();
+    ExactValues.clear();
+    Converted.clear();
+    MaxValues.clear();
+    Negated.clear();
+    Started = false;
+}
+
+}// namespace openphase
@@ -0,0 +1,135 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Tools/StatusMonitor.h"
+#include "Tools/MemoryMonitor.h"
+#include "Tools/TimeInfo.h"
+
+namespace openphase
+{
+
+using namespace std;
+
+/* Text as a quoted JSON string */
+static string Quoted(const string& Text)
+{
+    string Result = "\"";
+    for(char c : Text)
+    {
+        if(c == '"' or c == '\\') Result += '\\';
+        Result += c;
+    }
+    return Result + "\"";
+}
+
+void StatusMonitor::Initialize(const string locFileName, const string locTitle,
+                               const int locInterval, const int locWindow,
+                               const string locCommand)
+{
+    FileName = locFileName;
+    Title    = locTitle;
+    Interval = max(locInterval, 0);
+    Window   = max(locWindow, 1);
+    Command  = locCommand;
+    Samples.clear();
+    StartTime = -1.0;
+}
+
+void StatusMonitor::Update(const int tStep, const int nSteps, const double SimulationTime,
+                           const double dt, const bool Stopping)
+{
+    const double Now = chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+    double Memory = MemoryMonitor::ResidentMemory();
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &Memory, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    if(MPI_RANK != 0) return;
+#endif
+    if(StartTime < 0.0)
+    {
+        StartTime = Now;
+        StartStep = tStep;
+    }
+    Samples.emplace_back(Now, tStep);
+    if(Samples.size() > size_t(Window) + 1) Samples.erase(Samples.begin());
+
+    /* The step rate is averaged over the last Window updates, the estimate
+    of the remaining time assumes it stays constant */
+    double StepsPerSecond = 0.0;
+    if(Samples.back().first > Samples.front().first)
+    {
+        StepsPerSecond = (Samples.back().second - Samples.front().second)/
+                         (Samples.back().first - Samples.front().first);
+    }
+    const double Remaining = (StepsPerSecond > 0.0) ? max(nSteps - tStep, 0)/StepsPerSecond : -1.0;
+
+    const string Temporary = FileName + ".tmp";
+    {
+        ofstream out(Temporary);
+        if(!out)
+        {
+            ConsoleOutput::WriteWarning("File \"" + Temporary + "\" could not be created", "StatusMonitor", "Update()");
+            return;
+        }
+        out << setprecision(9);
+        out << "{\n  \"schema\": \"openphase-status/1\",\n"
+            << "  \"title\": " << Quoted(Title) << ",\n"
+            << "  \"state\": \"" << ((Stopping) ? "stopping" : "running") << "\",\n"
+            << "  \"updated_unix\": " << time(nullptr) << ",\n"
+            << "  \"time_step\": " << tStep << ",\n"
+            << "  \"max_time_step\": " << nSteps << ",\n"
+            << "  \"simulation_time\": " << SimulationTime << ",\n"
+            << "  \"dt\": " << dt << ",\n"
+            << "  \"wall_time_s\": " << Now - StartTime << ",\n"
+            << "  \"steps_per_s\": " << StepsPerSecond << ",\n"
+            << "  \"eta_s\": ";
+        if(Remaining >= 0.0) out << Remaining;
+        else out << "null";
+        out << ",\n  \"memory_rss_mb\": ";
+        if(Memory >= 0.0) out << Memory;
+        else out << "null";
+        out << ",\n  \"modules\": {";
+        const vector<pair<string, double>> Sections = TimeInfo::ActiveSections();
+        for(size_t n = 0; n < Sections.size(); n++)
+        {
+            out << ((n) ? ", " : "") << Quoted(Sections[n].first) << ": " << Sections[n].second;
+        }
+        out << "}\n}\n";
+    }
+    error_code Error;
+    filesystem::rename(Temporary, FileName, Error);
+    if(Error)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be replaced: " + Error.message(), "StatusMonitor", "Update()");
+        return;
+    }
+    if(not Command.empty())
+    {
+        const int Result = system((Command + " \"" + FileName + "\"").c_str());
+        if(Result != 0)
+        {
+            ConsoleOutput::WriteWarning("Status command \"" + Command + "\" failed", "StatusMonitor", "Update()");
+        }
+    }
+}
+
+}// namespace openphase
@@ -0,0 +1,294 @@
+/*
+ *   This file is part of the OpenPhase (R) software library.
+ *  
+ *  Copyright (c) 2009-2025 Ruhr-Universitaet Bochum,
+ *                Universitaetsstrasse 150, D-44801 Bochum, Germany
+ *            AND 2018-2025 OpenPhase Solutions GmbH,
+ *                Universitaetsstrasse 136, D-44799 Bochum, Germany.
+ *  
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *     
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ *   File created :   2026
+ *   Main contributors :   OpenPhase development team
+ *
+ */
+
+#include "Tools/StepScheduler.h"
+#include "Tools/TimeInfo.h"
+
+namespace openphase
+{
+using namespace std;
+
+namespace
+{
+bool Shared(const vector<const void*>& A, const vector<const void*>& B)
+{
+    for(const void* a : A)
+    {
+        if(find(B.begin(), B.end(), a) != B.end()) return true;
+    }
+    return false;
+}
+}// namespace
+
+size_t StepScheduler::AddStage(const string& Name, Stage_t Body,
+                               const vector<const void*>& Reads,
+                               const vector<const void*>& Writes,
+                               const double Weight)
+{
+    if(not Body)
+    {
+        ConsoleOutput::WriteExit("Stage \"" + Name + "\" has no body", thisclassname, "AddStage()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    Stage locStage;
+    locStage.Name   = Name;
+    locStage.Body   = std::move(Body);
+    locStage.Reads  = Reads;
+    locStage.Writes = Writes;
+    locStage.Weight = max(Weight, 0.0);
+    Stages.push_back(std::move(locStage));
+    Built = false;
+    return Stages.size() - 1;
+}
+
+size_t StepScheduler::AddBoundaryConditions(const string& Name, Stage_t Body,
+                                            const void* Object)
+{
+    const size_t stage = AddStage(Name, std::move(Body), {Object}, {Object});
+    Stages[stage].Boundary = Object;
+    return stage;
+}
+
+void StepScheduler::StencilReads(const size_t stage, const vector<const void*>& Objects)
+{
+    Stage& locStage = Stages.at(stage);
+    for(const void* Object : Objects)
+    {
+        if(find(locStage.Reads.begin(), locStage.Reads.end(), Object) == locStage.Reads.end())
+        {
+            locStage.Reads.push_back(Object);
+        }
+        if(find(locStage.Stencil.begin(), locStage.Stencil.end(), Object) == locStage.Stencil.end())
+        {
+            locStage.Stencil.push_back(Object);
+        }
+    }
+    Built = false;
+}
+
+void StepScheduler::Clear(void)
+{
+    Stages.clear();
+    Levels.clear();
+    Built = false;
+}
+
+void StepScheduler::Build(void)
+{
+    int locThreads = 1;
+#ifdef _OPENMP
+    locThreads = omp_get_max_threads();
+#endif
+    if(Built and locThreads == Threads and Skipping == SkipRedundantBoundaryConditions) return;
+    Threads = locThreads;
+    Skipping = SkipRedundantBoundaryConditions;
+
+    /* A boundary stage is redundant if the object was not written since the
+    previous boundary stage of the same object within the step */
+    map<const void*, bool> Modified;
+    for(Stage& locStage : Stages)
+    {
+        locStage.Redundant = false;
+        if(locStage.Boundary)
+        {
+            auto it = Modified.find(locStage.Boundary);
+            locStage.Redundant = (it != Modified.end() and not it->second);
+            Modified[locStage.Boundary] = false;
+        }
+        else for(const void* Object : locStage.Writes)
+        {
+            auto it = Modified.find(Object);
+            if(it != Modified.end()) it->second = true;
+        }
+    }
+
+    /* Read after write, write after write and write after read conflicts
+    keep the declaration order, all other stages may run concurrently */
+    Levels.clear();
+    for(size_t s = 0; s < Stages.size(); s++)
+    {
+        Stage& locStage = Stages[s];
+        locStage.Level = 0;
+        if(Skipped(locStage)) continue;
+        for(size_t p = 0; p < s; p++)
+        {
+            const Stage& prev = Stages[p];
+            if(Skipped(prev)) continue;
+            if(Shared(prev.Writes, locStage.Reads) or
+               Shared(prev.Writes, locStage.Writes) or
+               Shared(prev.Reads, locStage.Writes))
+            {
+                locStage.Level = max(locStage.Level, prev.Level + 1);
+            }
+        }
+        if(Levels.size() <= locStage.Level) Levels.resize(locStage.Level + 1);
+        Levels[locStage.Level].push_back(s);
+    }
+
+    for(const auto& Level : Levels)
+    {
+        double Weights = 0.0;
+        for(const size_t s : Level) Weights += Stages[s].Weight;
+        for(const size_t s : Level)
+        {
+            int TeamSize = Threads;
+            if(Level.size() > 1)
+            {
+                TeamSize = (Weights > 0.0) ? int(Threads*Stages[s].Weight/Weights)
+                                           : Threads/int(Level.size());
+            }
+            Stages[s].TeamSize = max(TeamSize, 1);
+        }
+    }
+    Built = true;
+}
+
+void StepScheduler::RunStage(Stage& locStage)
+{
+    TimeInfo::Region Guard(locStage.Name);
+    const auto start = chrono::steady_clock::now();
+    locStage.Body();
+    locStage.WallTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    locStage.Calls++;
+}
+
+void StepScheduler::Run(void)
+{
+    Build();
+
+    /* In the MPI build the stages exchange halos and reduce across the ranks,
+    concurrent stages would have to issue these calls in the same order on all
+    ranks, they are therefore executed sequentially */
+    bool Concurrent = not Sequential;
+#ifdef MPI_PARALLEL
+    Concurrent = false;
+#endif
+    if(not Concurrent)
+    {
+        for(Stage& locStage : Stages)
+        {
+            if(not Skipped(locStage)) RunStage(locStage);
+        }
+        return;
+    }
+
+#ifdef _OPENMP
+    const int ActiveLevels = omp_get_max_active_levels();
+    omp_set_max_active_levels(max(ActiveLevels, 2));
+#endif
+    for(const auto& Level : Levels)
+    {
+        if(Level.size() == 1)
+        {
+            RunStage(Stages[Level[0]]);
+            continue;
+        }
+
+        const long int nStages = Level.size();
+        vector<exception_ptr> Errors(nStages);
+        #pragma omp parallel for schedule(static,1) num_threads(min<int>(nStages, Threads))
+        for(long int n = 0; n < nStages; n++)
+        {
+            Stage& locStage = Stages[Level[n]];
+            try
+            {
+#ifdef _OPENMP
+                omp_set_num_threads(locStage.TeamSize);
+#endif
+                RunStage(locStage);
+            }
+            catch(...)
+            {
+                Errors[n] = current_exception();
+            }
+        }
+        for(const exception_ptr& Error : Errors)
+        if(Error)
+        {
+#ifdef _OPENMP
+            omp_set_max_active_levels(ActiveLevels);
+#endif
+            rethrow_exception(Error);
+        }
+    }
+#ifdef _OPENMP
+    omp_set_max_active_levels(ActiveLevels);
+#endif
+}
+
+vector<pair<size_t,size_t>> StepScheduler::FusionCandidates(void) const
+{
+    vector<pair<size_t,size_t>> Candidates;
+    size_t prev = Stages.size();
+    for(size_t s = 0; s < Stages.size(); s++)
+    {
+        const Stage& locStage = Stages[s];
+        if(Skipped(locStage)) continue;
+        if(prev < s and not locStage.Boundary and not Stages[prev].Boundary)
+        {
+            const Stage& first = Stages[prev];
+            const bool Related = Shared(first.Writes, locStage.Reads) or
+                                 Shared(first.Reads,  locStage.Reads) or
+                                 Shared(first.Writes, locStage.Writes);
+            if(Related and
+               not Shared(first.Writes, locStage.Stencil) and
+               not Shared(first.Stencil, locStage.Writes))
+            {
+                Candidates.emplace_back(prev, s);
+            }
+        }
+        prev = s;
+    }
+    return Candidates;
+}
+
+void StepScheduler::Report(void)
+{
+    Build();
+    ConsoleOutput::WriteLineInsert("Step scheduler");
+    for(const Stage& locStage : Stages)
+    {
+        stringstream value;
+        if(Skipped(locStage))
+        {
+            value << "skipped (redundant boundary conditions)";
+        }
+        else
+        {
+            value << "level " << locStage.Level
+                  << ", threads " << locStage.TeamSize
+                  << ", " << locStage.WallTime/max<size_t>(locStage.Calls, 1) << " s/call";
+        }
+        ConsoleOutput::WriteStandard(locStage.Name, value.str());
+    }
+    for(const auto& [first, second] : FusionCandidates())
+    {
+        ConsoleOutput::WriteStandard("Fusion candidate", Stages[first].Name + " + " + Stages[second].Name);
+    }
+    ConsoleOutput::WriteLine();
+}
+
+}// namespace openphase
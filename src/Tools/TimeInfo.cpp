@@ -26,12 +26,76 @@
 
 #include "Tools/TimeInfo.h"
 #include "Settings.h"
+#include "Tools/MemoryMonitor.h"
 
 namespace openphase
 {
 
 using namespace std;
 
+/* Derived hardware counter metrics of Counters accumulated in Time: the
+instructions per cycle, GFLOP/s and GB/s, negative if not available */
+static array<double, 3> CounterRates(const array<double, PerformanceCounters::Nevents>& Counters,
+                                     const double Time)
+{
+    typedef PerformanceCounters PC;
+    array<double, 3> Rates = {-1.0, -1.0, -1.0};
+    if(PC::Available(PC::Cycles) and PC::Available(PC::Instructions) and Counters[PC::Cycles] > 0)
+    {
+        Rates[0] = Counters[PC::Instructions]/Counters[PC::Cycles];
+    }
+    if(Time > 0.0)
+    {
+        if(PC::Available(PC::FLOPs)) Rates[1] = Counters[PC::FLOPs]/Time*1.0e-9;
+        if(PC::Available(PC::CacheMisses)) Rates[2] = Counters[PC::CacheMisses]*PC::CacheLineSize/Time*1.0e-9;
+    }
+    return Rates;
+}
+
+static string CounterValue(const double Value, const string Missing)
+{
+    if(Value < 0.0) return Missing;
+    stringstream out;
+    out << setprecision(9) << Value;
+    return out.str();
+}
+
+/* Adds the iterations counted since Start to Sum */
+static void AddIterations(vector<size_t>& Sum, const vector<size_t>& Now, const vector<size_t>& Start)
+{
+    if(Sum.size() < Now.size()) Sum.resize(Now.size(), 0);
+    for(size_t n = 0; n < Now.size(); n++)
+    {
+        Sum[n] += Now[n] - ((n < Start.size()) ? Start[n] : 0);
+    }
+}
+
+/* Ratio of the maximum to the mean iteration count of the threads, 0 if no
+iterations were counted */
+static double ThreadImbalanceFactor(const vector<size_t>& Iterations)
+{
+    size_t Sum = 0;
+    size_t Max = 0;
+    for(const size_t Count : Iterations)
+    {
+        Sum += Count;
+        Max = max(Max, Count);
+    }
+    return (Sum) ? double(Max)*Iterations.size()/double(Sum) : 0.0;
+}
+
+/* Text as a quoted JSON string */
+static string Quoted(const string& Text)
+{
+    string Result = "\"";
+    for(char c : Text)
+    {
+        if(c == '"' or c == '\\') Result += '\\';
+        Result += c;
+    }
+    return Result + "\"";
+}
+
 TimeInfo::TimeInfo(const Settings& locSettings, const std::string Name, bool verbose_in)
 {
     Initialize(locSettings, Name, verbose_in);
@@ -39,6 +103,7 @@ TimeInfo::TimeInfo(const Settings& locSettings, const std::string Name, bool ver
 
 TimeInfo::~TimeInfo(void)
 {
+    if(ActiveTimer == this) ActiveTimer = nullptr;
     ConsoleOutput::WriteStandard(thisclassname, "Exited normally");
 }
 
@@ -46,27 +111,63 @@ void TimeInfo::Initialize(const Settings& locSettings, const std::string Name, b
 {
     thisclassname = "TimeInfo";
     counter = 0;
+    CPUcounter = 0;
     ClockStart = 0;
+    CPUClockStart = 0;
+    WaitStart = WaitTime();
+    IterationsStart = IterationCounts();
     TimerName = Name;
     verbose = verbose_in;
+    ActiveTimer = this;
+    PerformanceCounters::Start();
 }
 void TimeInfo::Reset(void)
 {
     counter = 0;
+    CPUcounter = 0;
     ClockStart = 0;
+    CPUClockStart = 0;
 }
 
 void TimeInfo::SetStart(void)
 {
     counter++;
+    CPUcounter++;
     ClockStart = GetTime();
+    CPUClockStart = GetCPUTime();
+    WaitStart = WaitTime();
+    IterationsStart = IterationCounts();
+}
+
+vector<size_t> TimeInfo::IterationCounts(void)
+{
+    vector<size_t> Counts(min(omp_get_max_threads(), int(MaxThreads)));
+    for(size_t n = 0; n < Counts.size(); n++) Counts[n] = ThreadIterations[n].Count;
+    return Counts;
 }
 
 void TimeInfo::SetTimeStamp(const string Message)
 {
     const double CurrentTime = GetTime();
-    TimeMap[Message] += CurrentTime - ClockStart;
+    const double CurrentCPUTime = GetCPUTime();
+    const double CurrentWait = WaitTime();
+    const vector<size_t> CurrentIterations = IterationCounts();
+    Section& locSection = TimeMap[Message];
+    locSection.Wall    += CurrentTime - ClockStart;
+    locSection.RunWall += CurrentTime - ClockStart;
+    locSection.CPU     += CurrentCPUTime - CPUClockStart;
+    locSection.RunCPU  += CurrentCPUTime - CPUClockStart;
+    locSection.RunWait += CurrentWait - WaitStart;
+    locSection.IntervalWall += CurrentTime - ClockStart;
+    locSection.IntervalWait += CurrentWait - WaitStart;
+    AddIterations(locSection.RunIterations, CurrentIterations, IterationsStart);
+    AddIterations(locSection.IntervalIterations, CurrentIterations, IterationsStart);
+    locSection.Calls++;
+    if(TraceEnabled) Trace('S', Message.c_str(), ClockStart, CurrentTime);
     ClockStart = CurrentTime;
+    CPUClockStart = CurrentCPUTime;
+    WaitStart = CurrentWait;
+    IterationsStart = CurrentIterations;
     if(verbose)
     {
         ConsoleOutput::WriteSimple(Message);
@@ -76,8 +177,13 @@ void TimeInfo::SetTimeStamp(const string Message)
 void TimeInfo::SkipToHere(void)
 {
     const double CurrentTime = GetTime();
-    TimeMap["#"] += CurrentTime - ClockStart;
+    const double CurrentCPUTime = GetCPUTime();
+    TimeMap["#"].Wall += CurrentTime - ClockStart;
+    TimeMap["#"].CPU  += CurrentCPUTime - CPUClockStart;
     ClockStart = CurrentTime;
+    CPUClockStart = CurrentCPUTime;
+    WaitStart = WaitTime();
+    IterationsStart = IterationCounts();
 }
 
 void TimeInfo::PrintWallClockSummary(void)
@@ -88,9 +194,10 @@ void TimeInfo::PrintWallClockSummary(void)
         ConsoleOutput::WriteSimple(TimerName);
         ConsoleOutput::WriteLine("-");
         double TotalTime = 0;
-        for (auto const& [message,time] : TimeMap) TotalTime += time;
+        for (auto const& [message,section] : TimeMap) TotalTime += section.Wall;
         double TotalConsumedTime = TotalTime/double(counter);
-        std::vector<std::pair<std::string, double>> tmp(TimeMap.begin(), TimeMap.end());
+        std::vector<std::pair<std::string, double>> tmp;
+        for (auto const& [message,section] : TimeMap) tmp.emplace_back(message, section.Wall);
         std::sort(tmp.begin(), tmp.end(), [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) { return a.second > b.second; });
         for (auto const& [message,time] : tmp)
         {
@@ -106,11 +213,628 @@ void TimeInfo::PrintWallClockSummary(void)
             }
         }
         counter = 0;
-        for (auto & [message,time] : TimeMap) time = 0;
+        for (auto & [message,section] : TimeMap) section.Wall = 0;
         ConsoleOutput::WriteLine("-");
         ConsoleOutput::WriteStandard("Total time per time step [s]", TotalConsumedTime);
         ConsoleOutput::WriteLine("=");
     }
 }
 
+void TimeInfo::PrintCPUClockSummary(void)
+{
+    if(CPUcounter)
+    {
+        ConsoleOutput::WriteLine("=");
+        ConsoleOutput::WriteSimple(TimerName + " (CPU time)");
+        ConsoleOutput::WriteLine("-");
+        double TotalTime = 0;
+        for (auto const& [message,section] : TimeMap) TotalTime += section.CPU;
+        double TotalConsumedTime = TotalTime/double(CPUcounter);
+        std::vector<std::pair<std::string, double>> tmp;
+        for (auto const& [message,section] : TimeMap) tmp.emplace_back(message, section.CPU);
+        std::sort(tmp.begin(), tmp.end(), [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) { return a.second > b.second; });
+        for (auto const& [message,time] : tmp)
+        {
+            if (message != "#")
+            {
+                std::stringstream showtime;
+
+                double SectionConsumedTime = time/double(CPUcounter);
+                showtime << std::fixed << std::setprecision(2) << std::scientific << SectionConsumedTime << "  "
+                         << std::fixed << std::setprecision(2) << ((SectionConsumedTime/TotalConsumedTime)*100.0) << " %";
+
+                ConsoleOutput::WriteStandard(message, showtime.str());
+            }
+        }
+        CPUcounter = 0;
+        for (auto & [message,section] : TimeMap) section.CPU = 0;
+        ConsoleOutput::WriteLine("-");
+        ConsoleOutput::WriteStandard("Total CPU time per time step [s]", TotalConsumedTime);
+        ConsoleOutput::WriteLine("=");
+    }
+}
+
+std::vector<TimeInfo::Statistics> TimeInfo::RunStatistics(void) const
+{
+    std::vector<Statistics> Entries;
+    for (auto const& [message,section] : TimeMap)
+    if (message != "#")
+    {
+        Entries.push_back({"section", message, section.Calls, section.RunWall, section.RunCPU,
+                           0.0, 0.0, 0.0, 0.0, 0.0, {}, 0.0,
+                           section.RunWait, 0.0, 0.0, 0.0, section.RunIterations});
+    }
+    /* Regions are listed depth first, each region followed by the regions
+    nested in it */
+    std::vector<std::string> RegionNames;
+    for (auto const& [name,region] : Regions) RegionNames.push_back(name);
+    std::sort(RegionNames.begin(), RegionNames.end(), [](const std::string& a, const std::string& b)
+    {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+            [](const char x, const char y) { return (x == '/' ? '\0' : x) < (y == '/' ? '\0' : y); });
+    });
+    for (auto const& name : RegionNames)
+    {
+        const RegionStatistics& region = Regions.at(name);
+        Entries.push_back({"region", name, region.Calls, region.Total, 0.0,
+                           region.Min, region.Max, 0.0, 0.0, 0.0, {}, 0.0,
+                           region.Wait, 0.0, 0.0, 0.0, region.Iterations});
+        for (int n = 0; n < PerformanceCounters::Nevents; n++)
+        {
+            Entries.back().Counters[n] = region.Counters[n];
+        }
+    }
+    for (auto const& [name,communication] : Communications)
+    {
+        Entries.push_back({"communication", name, communication.Calls, communication.Total, 0.0,
+                           0.0, 0.0, 0.0, 0.0, 0.0, {}, communication.Bytes,
+                           0.0, 0.0, 0.0, 0.0, {}});
+    }
+
+    int Nranks = 1;
+#ifdef MPI_PARALLEL
+    Nranks = MPI_SIZE;
+    /* The entries of rank 0 are broadcast, the other ranks contribute their
+    times of the entries with the same kind and name */
+    std::string Names;
+    for (auto const& Entry : Entries) Names += Entry.Kind + "\t" + Entry.Name + "\n";
+    int Length = Names.size();
+    OP_MPI_Bcast(&Length, 1, OP_MPI_INT, 0, OP_MPI_COMM_WORLD);
+    Names.resize(Length);
+    OP_MPI_Bcast(Names.data(), Length, OP_MPI_CHAR, 0, OP_MPI_COMM_WORLD);
+
+    std::map<std::pair<std::string, std::string>, const Statistics*> Local;
+    for (auto const& Entry : Entries) Local[{Entry.Kind, Entry.Name}] = &Entry;
+
+    std::vector<Statistics> RootEntries;
+    std::stringstream NamesStream(Names);
+    std::string Line;
+    while (std::getline(NamesStream, Line))
+    {
+        const size_t Tab = Line.find('\t');
+        Statistics Entry{Line.substr(0, Tab), Line.substr(Tab + 1), 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, {}, 0.0,
+                         0.0, 0.0, 0.0, 0.0, {}};
+        auto it = Local.find({Entry.Kind, Entry.Name});
+        if (it != Local.end()) Entry = *it->second;
+        RootEntries.push_back(Entry);
+    }
+    Entries = RootEntries;
+#endif
+    std::vector<double> RankMin(Entries.size());
+    std::vector<double> RankMax(Entries.size());
+    std::vector<double> RankSum(Entries.size());
+    std::vector<double> CounterSum(Entries.size()*PerformanceCounters::Nevents);
+    std::vector<double> BytesSum(Entries.size());
+    std::vector<double> WaitSum(Entries.size());
+    std::vector<double> BusySum(Entries.size());
+    std::vector<double> BusyMax(Entries.size());
+    std::vector<double> ThreadImbalance(Entries.size());
+    for (size_t n = 0; n < Entries.size(); n++)
+    {
+        RankMin[n] = RankMax[n] = RankSum[n] = Entries[n].Total;
+        BytesSum[n] = Entries[n].Bytes;
+        WaitSum[n] = Entries[n].Wait;
+        BusySum[n] = BusyMax[n] = Entries[n].Total - Entries[n].Wait;
+        ThreadImbalance[n] = ThreadImbalanceFactor(Entries[n].Iterations);
+        for (int e = 0; e < PerformanceCounters::Nevents; e++)
+        {
+            CounterSum[n*PerformanceCounters::Nevents + e] = Entries[n].Counters[e];
+        }
+    }
+#ifdef MPI_PARALLEL
+    if (!Entries.empty())
+    {
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, RankMin.data(), RankMin.size(), OP_MPI_DOUBLE, OP_MPI_MIN, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, RankMax.data(), RankMax.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, RankSum.data(), RankSum.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, CounterSum.data(), CounterSum.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, BytesSum.data(), BytesSum.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, WaitSum.data(), WaitSum.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, BusySum.data(), BusySum.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, BusyMax.data(), BusyMax.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, ThreadImbalance.data(), ThreadImbalance.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    }
+#endif
+    for (size_t n = 0; n < Entries.size(); n++)
+    {
+        Entries[n].RankMin  = RankMin[n];
+        Entries[n].RankMax  = RankMax[n];
+        Entries[n].RankMean = RankSum[n]/Nranks;
+        Entries[n].Bytes    = BytesSum[n];
+        Entries[n].Wait     = WaitSum[n]/Nranks;
+        Entries[n].BusyMean = BusySum[n]/Nranks;
+        Entries[n].BusyMax  = BusyMax[n];
+        Entries[n].ThreadImbalance = ThreadImbalance[n];
+        for (int e = 0; e < PerformanceCounters::Nevents; e++)
+        {
+            Entries[n].Counters[e] = CounterSum[n*PerformanceCounters::Nevents + e];
+        }
+    }
+    return Entries;
+}
+
+void TimeInfo::PrintFullSummary(void)
+{
+    std::vector<Statistics> Entries = RunStatistics();
+
+    ConsoleOutput::WriteLine("=");
+    ConsoleOutput::WriteSimple(TimerName + " (whole run, time over ranks: min / mean / max [s])");
+    ConsoleOutput::WriteLine("-");
+    for (auto const& Entry : Entries)
+    {
+        std::stringstream showtime;
+        showtime << std::scientific << std::setprecision(2)
+                 << Entry.RankMin << " / " << Entry.RankMean << " / " << Entry.RankMax
+                 << "  x" << Entry.Calls;
+        if (Entry.Kind == "section")
+        {
+            ConsoleOutput::WriteStandard(Entry.Name, showtime.str());
+        }
+        else if (Entry.Kind == "communication")
+        {
+            showtime << "  " << Entry.Bytes*1.0e-9 << " GB";
+            ConsoleOutput::WriteStandard("[C] " + Entry.Name, showtime.str());
+        }
+        else
+        {
+            /* Nested regions are indented by their depth */
+            const size_t Depth = std::count(Entry.Name.begin(), Entry.Name.end(), '/');
+            const size_t Slash = Entry.Name.find_last_of('/');
+            const std::string Short = (Slash == std::string::npos) ? Entry.Name : Entry.Name.substr(Slash + 1);
+            ConsoleOutput::WriteStandard("[R] " + std::string(2*Depth, ' ') + Short, showtime.str());
+        }
+    }
+    ConsoleOutput::WriteLine("-");
+    ConsoleOutput::WriteSimple("Load balance: rank imbalance (busy time max/mean) / mean MPI wait [s] / thread imbalance");
+    ConsoleOutput::WriteLine("-");
+    for (auto const& Entry : Entries)
+    if (Entry.Kind != "communication")
+    {
+        std::stringstream showbalance;
+        showbalance << std::fixed << std::setprecision(2) << Entry.RankImbalance() << " / "
+                    << std::scientific << Entry.Wait << " / ";
+        if (Entry.ThreadImbalance > 0.0) showbalance << std::fixed << Entry.ThreadImbalance;
+        else showbalance << "n/a";
+        ConsoleOutput::WriteStandard(((Entry.Kind == "region") ? "[R] " : "") + Entry.Name, showbalance.str());
+    }
+    if (PerformanceCounters::Enabled())
+    {
+        ConsoleOutput::WriteLine("-");
+        ConsoleOutput::WriteSimple("Hardware counters (sum over ranks): IPC / GFLOP/s / GB/s / cache misses");
+        ConsoleOutput::WriteLine("-");
+        for (auto const& Entry : Entries)
+        if (Entry.Kind == "region")
+        {
+            const std::array<double, 3> Rates = CounterRates(Entry.Counters, Entry.RankMax);
+            std::stringstream showcounters;
+            showcounters << CounterValue(Rates[0], "n/a") << " / " << CounterValue(Rates[1], "n/a")
+                         << " / " << CounterValue(Rates[2], "n/a") << " / "
+                         << CounterValue(PerformanceCounters::Available(PerformanceCounters::CacheMisses) ?
+                                         Entry.Counters[PerformanceCounters::CacheMisses] : -1.0, "n/a");
+            ConsoleOutput::WriteStandard("[R] " + Entry.Name, showcounters.str());
+        }
+    }
+    ConsoleOutput::WriteLine("=");
+}
+
+void TimeInfo::WriteCSV(const std::string FileName) const
+{
+    std::vector<Statistics> Entries = RunStatistics();
+#ifdef MPI_PARALLEL
+    if (MPI_RANK != 0) return;
+#endif
+    std::ofstream out(FileName);
+    if (!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be created", thisclassname, "WriteCSV()");
+        return;
+    }
+    out << "kind,name,calls,total_s,cpu_s,min_call_s,max_call_s,rank_min_s,rank_mean_s,rank_max_s";
+    for (auto const& Name : PerformanceCounters::EventNames) out << "," << Name;
+    out << ",ipc,gflop_per_s,gbyte_per_s,bytes,wait_mean_s,busy_mean_s,busy_max_s,rank_imbalance,thread_imbalance\n";
+    out << std::setprecision(9);
+    for (auto const& Entry : Entries)
+    {
+        out << Entry.Kind << ",\"" << Entry.Name << "\"," << Entry.Calls << ","
+            << Entry.Total << "," << Entry.CPU << ","
+            << ((Entry.Calls) ? Entry.Min : 0.0) << "," << Entry.Max << ","
+            << Entry.RankMin << "," << Entry.RankMean << "," << Entry.RankMax;
+        /* Missing counters are left empty */
+        const bool Counted = (Entry.Kind == "region");
+        for (int e = 0; e < PerformanceCounters::Nevents; e++)
+        {
+            const bool Valid = Counted and PerformanceCounters::Available(PerformanceCounters::Events(e));
+            out << "," << CounterValue(Valid ? Entry.Counters[e] : -1.0, "");
+        }
+        const std::array<double, 3> Rates = CounterRates(Entry.Counters, Entry.RankMax);
+        for (const double Rate : Rates) out << "," << CounterValue(Counted ? Rate : -1.0, "");
+        out << "," << CounterValue((Entry.Kind == "communication") ? Entry.Bytes : -1.0, "");
+        if (Entry.Kind != "communication")
+        {
+            out << "," << Entry.Wait << "," << Entry.BusyMean << "," << Entry.BusyMax
+                << "," << Entry.RankImbalance() << "," << CounterValue((Entry.ThreadImbalance > 0.0) ? Entry.ThreadImbalance : -1.0, "");
+        }
+        else
+        {
+            out << ",,,,,";
+        }
+        out << "\n";
+    }
+}
+
+void TimeInfo::WriteJSON(const std::string FileName) const
+{
+    std::vector<Statistics> Entries = RunStatistics();
+    int Nranks = 1;
+#ifdef MPI_PARALLEL
+    Nranks = MPI_SIZE;
+    if (MPI_RANK != 0) return;
+#endif
+    std::ofstream out(FileName);
+    if (!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be created", thisclassname, "WriteJSON()");
+        return;
+    }
+    out << std::setprecision(9);
+    out << "{\n  \"timer\": " << Quoted(TimerName) << ",\n  \"ranks\": " << Nranks
+        << ",\n  \"threads\": " << omp_get_max_threads()
+        << ",\n  \"counters\": " << ((PerformanceCounters::Enabled()) ? "true" : "false")
+        << ",\n  \"entries\": [";
+    for (size_t n = 0; n < Entries.size(); n++)
+    {
+        const Statistics& Entry = Entries[n];
+        out << ((n) ? ",\n" : "\n")
+            << "    {\"kind\": " << Quoted(Entry.Kind) << ", \"name\": " << Quoted(Entry.Name)
+            << ", \"calls\": " << Entry.Calls << ", \"total\": " << Entry.Total
+            << ", \"cpu\": " << Entry.CPU << ", \"min_call\": " << ((Entry.Calls) ? Entry.Min : 0.0)
+            << ", \"max_call\": " << Entry.Max << ", \"rank_min\": " << Entry.RankMin
+            << ", \"rank_mean\": " << Entry.RankMean << ", \"rank_max\": " << Entry.RankMax;
+        if (Entry.Kind == "region" and PerformanceCounters::Enabled())
+        {
+            for (int e = 0; e < PerformanceCounters::Nevents; e++)
+            {
+                const bool Valid = PerformanceCounters::Available(PerformanceCounters::Events(e));
+                out << ", \"" << PerformanceCounters::EventNames[e] << "\": "
+                    << CounterValue(Valid ? Entry.Counters[e] : -1.0, "null");
+            }
+            const std::array<double, 3> Rates = CounterRates(Entry.Counters, Entry.RankMax);
+            out << ", \"ipc\": " << CounterValue(Rates[0], "null")
+                << ", \"gflop_per_s\": " << CounterValue(Rates[1], "null")
+                << ", \"gbyte_per_s\": " << CounterValue(Rates[2], "null");
+        }
+        if (Entry.Kind == "communication")
+        {
+            out << ", \"bytes\": " << Entry.Bytes;
+        }
+        else
+        {
+            out << ", \"wait_mean\": " << Entry.Wait << ", \"busy_mean\": " << Entry.BusyMean
+                << ", \"busy_max\": " << Entry.BusyMax << ", \"rank_imbalance\": " << Entry.RankImbalance()
+                << ", \"thread_imbalance\": " << CounterValue((Entry.ThreadImbalance > 0.0) ? Entry.ThreadImbalance : -1.0, "null");
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void TimeInfo::WritePerformance(const std::string FileName, const long int Cells) const
+{
+    /* The time loop is given by the sections: its time is the sum of their
+    slowest rank totals and its length the largest number of calls */
+    std::vector<Statistics> Entries = RunStatistics();
+    double LoopTime = 0.0;
+    size_t LoopSteps = 0;
+    for (auto const& Entry : Entries)
+    if (Entry.Kind == "section")
+    {
+        LoopTime += Entry.RankMax;
+        LoopSteps = std::max(LoopSteps, Entry.Calls);
+    }
+    double PeakMemory = MemoryMonitor::PeakResidentMemory();
+    int Nranks = 1;
+#ifdef MPI_PARALLEL
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, &PeakMemory, 1, OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    Nranks = MPI_SIZE;
+    if (MPI_RANK != 0) return;
+#endif
+    std::ofstream out(FileName);
+    if (!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be created", thisclassname, "WritePerformance()");
+        return;
+    }
+    out << "# Performance metrics of " << TimerName << ", one \"metric value\" pair per line\n";
+    out << std::setprecision(9);
+    out << "ranks " << Nranks << "\n"
+        << "threads " << omp_get_max_threads() << "\n"
+        << "cells " << Cells << "\n"
+        << "steps " << LoopSteps << "\n"
+        << "loop_s " << LoopTime << "\n";
+    if (LoopTime > 0.0 and LoopSteps > 0)
+    {
+        out << "time_per_step_s " << LoopTime/LoopSteps << "\n"
+            << "steps_per_s " << LoopSteps/LoopTime << "\n"
+            << "cell_updates_per_s " << double(Cells)*LoopSteps/LoopTime << "\n";
+    }
+    if (PeakMemory > 0.0)
+    {
+        out << "peak_rss_mb " << PeakMemory << "\n";
+    }
+}
+
+void TimeInfo::WriteLoadImbalance(const std::string FileName, const int tStep)
+{
+    /* The sections are the same on all ranks, as they are stamped by the
+    main loop of the application */
+    std::vector<std::string> Names;
+    std::vector<double> BusySum;
+    std::vector<double> BusyMax;
+    std::vector<double> ThreadImbalance;
+    for (auto& [message,section] : TimeMap)
+    if (message != "#")
+    {
+        Names.push_back(message);
+        BusySum.push_back(section.IntervalWall - section.IntervalWait);
+        ThreadImbalance.push_back(ThreadImbalanceFactor(section.IntervalIterations));
+        section.IntervalWall = 0.0;
+        section.IntervalWait = 0.0;
+        section.IntervalIterations.clear();
+    }
+    BusyMax = BusySum;
+    int Nranks = 1;
+#ifdef MPI_PARALLEL
+    Nranks = MPI_SIZE;
+    int Nsections[2] = {int(Names.size()), -int(Names.size())};
+    OP_MPI_Allreduce(OP_MPI_IN_PLACE, Nsections, 2, OP_MPI_INT, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    if (Nsections[0] != -Nsections[1])
+    {
+        ConsoleOutput::WriteWarning("Different sections on the MPI ranks, no output", thisclassname, "WriteLoadImbalance()");
+        return;
+    }
+    if (!Names.empty())
+    {
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, BusySum.data(), BusySum.size(), OP_MPI_DOUBLE, OP_MPI_SUM, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, BusyMax.data(), BusyMax.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+        OP_MPI_Allreduce(OP_MPI_IN_PLACE, ThreadImbalance.data(), ThreadImbalance.size(), OP_MPI_DOUBLE, OP_MPI_MAX, OP_MPI_COMM_WORLD);
+    }
+#endif
+    ImbalanceRecords++;
+#ifdef MPI_PARALLEL
+    if (MPI_RANK != 0) return;
+#endif
+    std::ofstream out(FileName, (ImbalanceRecords == 1) ? std::ios::out : std::ios::app);
+    if (!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be opened", thisclassname, "WriteLoadImbalance()");
+        return;
+    }
+    if (ImbalanceRecords == 1)
+    {
+        /* Each section has a rank imbalance (busy time max/mean over the
+        ranks) and a thread imbalance (iterations max/mean over the threads,
+        0 if the section does not count iterations) column */
+        out << "tStep";
+        for (std::string Name : Names)
+        {
+            std::replace(Name.begin(), Name.end(), ' ', '_');
+            out << " " << Name << ":ranks " << Name << ":threads";
+        }
+        out << "\n";
+    }
+    out << tStep << std::fixed << std::setprecision(3);
+    for (size_t n = 0; n < Names.size(); n++)
+    {
+        const double BusyMean = BusySum[n]/Nranks;
+        out << " " << ((BusyMean > 0.0) ? BusyMax[n]/BusyMean : 1.0) << " " << ThreadImbalance[n];
+    }
+    out << "\n";
+}
+
+TimeInfo::Region::Region(const std::string& Name)
+{
+    Active = (omp_get_thread_num() == 0);
+    Traced = (not Active) and TraceEnabled;
+    Start = 0.0;
+    StartWait = 0.0;
+    StartCounters.fill(0);
+    if (Traced)
+    {
+        this->Name = Name;
+        Start = GetTime();
+    }
+    if (Active)
+    {
+        RegionStack.push_back(RegionStack.empty() ? Name : RegionStack.back() + "/" + Name);
+        if (PerformanceCounters::Enabled()) StartCounters = PerformanceCounters::Read();
+        StartIterations = IterationCounts();
+        StartWait = WaitTime();
+        Start = GetTime();
+    }
+}
+
+TimeInfo::Region::~Region()
+{
+    if (Active)
+    {
+        const double Time = GetTime() - Start;
+        RegionStatistics& locRegion = Regions[RegionStack.back()];
+        if (PerformanceCounters::Enabled())
+        {
+            const PerformanceCounters::Values_t Counters = PerformanceCounters::Read();
+            for (int n = 0; n < PerformanceCounters::Nevents; n++)
+            {
+                locRegion.Counters[n] += Counters[n] - StartCounters[n];
+            }
+        }
+        locRegion.Calls++;
+        locRegion.Total += Time;
+        locRegion.Wait += WaitTime() - StartWait;
+        AddIterations(locRegion.Iterations, IterationCounts(), StartIterations);
+        locRegion.Min = std::min(locRegion.Min, Time);
+        locRegion.Max = std::max(locRegion.Max, Time);
+        if (TraceEnabled)
+        {
+            const size_t Slash = RegionStack.back().find_last_of('/');
+            Trace('R', RegionStack.back().c_str() + ((Slash == std::string::npos) ? 0 : Slash + 1), Start, Start + Time);
+        }
+        RegionStack.pop_back();
+    }
+    if (Traced)
+    {
+        Trace('R', Name.c_str(), Start, GetTime());
+    }
+}
+
+TimeInfo::Communication::Communication(const char* locName)
+{
+    Name = locName;
+    Active = (omp_get_thread_num() == 0);
+    Start = (Active) ? GetTime() : 0.0;
+}
+
+TimeInfo::Communication::~Communication()
+{
+    if (Active)
+    {
+        const double End = GetTime();
+        CommStatistics& locCommunication = Communications[Name];
+        locCommunication.Calls++;
+        locCommunication.Total += End - Start;
+        locCommunication.Bytes += Bytes;
+        if (TraceEnabled) Trace('C', Name, Start, End);
+    }
+}
+
+vector<pair<string, double>> TimeInfo::ActiveSections(void)
+{
+    vector<pair<string, double>> Fractions;
+    if(ActiveTimer == nullptr) return Fractions;
+    double Total = 0.0;
+    for(auto const& [message,section] : ActiveTimer->TimeMap)
+    if(message != "#")
+    {
+        Fractions.emplace_back(message, section.RunWall);
+        Total += section.RunWall;
+    }
+    for(auto& Fraction : Fractions) Fraction.second = (Total > 0.0) ? Fraction.second/Total : 0.0;
+    return Fractions;
+}
+
+void TimeInfo::ResetRegions(void)
+{
+    Regions.clear();
+    Communications.clear();
+}
+
+void TimeInfo::StartTrace(const size_t Capacity, const std::string FileName)
+{
+    if (Capacity == 0 or TraceEnabled) return;
+    for (auto& Buffer : TraceBuffers)
+    {
+        Buffer.Events.clear();
+        Buffer.Recorded = 0;
+    }
+    /* The buffers of the threads are allocated up front, recording only
+    writes into them */
+    for (int n = 0; n < std::min(omp_get_max_threads(), int(MaxThreads)); n++)
+    {
+        TraceBuffers[n].Events.resize(Capacity);
+    }
+    TraceFile = FileName;
+#ifdef MPI_PARALLEL
+    /* One file per rank, the origin is taken after a barrier */
+    const size_t Dot = FileName.find_last_of('.');
+    const std::string Rank = "_" + std::to_string(MPI_RANK);
+    TraceFile = (Dot == std::string::npos) ? FileName + Rank : FileName.substr(0, Dot) + Rank + FileName.substr(Dot);
+    OP_MPI_Barrier(OP_MPI_COMM_WORLD);
+#endif
+    TraceOrigin = GetTime();
+    TraceEnabled = true;
+    std::atexit([](){ if (TraceEnabled) WriteTrace(TraceFile); });
+}
+
+void TimeInfo::Trace(const char Kind, const char* Name, const double Begin, const double End)
+{
+    const int Thread = omp_get_thread_num();
+    if (Thread >= MaxThreads or TraceBuffers[Thread].Events.empty()) return;
+    TraceBuffer& Buffer = TraceBuffers[Thread];
+    TraceEvent& Event = Buffer.Events[Buffer.Recorded % Buffer.Events.size()];
+    Event.Begin = Begin;
+    Event.End = End;
+    Event.Kind = Kind;
+    std::strncpy(Event.Name, Name, TraceNameLength);
+    Event.Name[TraceNameLength] = '\0';
+    Buffer.Recorded++;
+}
+
+void TimeInfo::WriteTrace(const std::string FileName)
+{
+    if (not TraceEnabled) return;
+    int Rank = 0;
+#ifdef MPI_PARALLEL
+    Rank = MPI_RANK;
+#endif
+    std::ofstream out(FileName);
+    if (!out)
+    {
+        ConsoleOutput::WriteWarning("File \"" + FileName + "\" could not be created", "TimeInfo", "WriteTrace()");
+        return;
+    }
+    /* Chrome trace format: complete events ("ph": "X") with the begin and
+    the duration in microseconds, the rank as process and the OpenMP thread
+    as thread */
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    out << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << Rank
+        << ", \"args\": {\"name\": \"Rank " << Rank << "\"}}";
+    size_t Dropped = 0;
+    for (int Thread = 0; Thread < MaxThreads; Thread++)
+    {
+        const TraceBuffer& Buffer = TraceBuffers[Thread];
+        if (Buffer.Recorded == 0) continue;
+        out << ",\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << Rank
+            << ", \"tid\": " << Thread << ", \"args\": {\"name\": \"Thread " << Thread << "\"}}";
+        /* The oldest events of a full ring buffer have been overwritten */
+        const size_t Size = Buffer.Events.size();
+        const size_t Kept = std::min(Buffer.Recorded, Size);
+        Dropped += Buffer.Recorded - Kept;
+        for (size_t n = Buffer.Recorded - Kept; n < Buffer.Recorded; n++)
+        {
+            const TraceEvent& Event = Buffer.Events[n % Size];
+            const char* Category = (Event.Kind == 'S') ? "section" : (Event.Kind == 'C') ? "communication" : "region";
+            out << ",\n  {\"name\": " << Quoted(Event.Name) << ", \"cat\": \"" << Category
+                << "\", \"ph\": \"X\", \"ts\": " << (Event.Begin - TraceOrigin)*1.0e6
+                << ", \"dur\": " << (Event.End - Event.Begin)*1.0e6
+                << ", \"pid\": " << Rank << ", \"tid\": " << Thread << "}";
+        }
+    }
+    out << "\n]}\n";
+    if (Dropped)
+    {
+        ConsoleOutput::WriteWarning(std::to_string(Dropped) + " oldest events were overwritten, "
+                                    "increase the trace capacity to keep them", "TimeInfo", "WriteTrace()");
+    }
+}
+
 }// namespace openphase
@@ -56,6 +56,8 @@ void UserDrivingForce::Initialize(Settings& locSettings, std::string ObjectNameS
     Component.Allocate(Nphases,Nphases);
     LatentHeat.Allocate(Nphases,Nphases);
 
+    BatchTileCells = 256;
+
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
 }
@@ -65,7 +67,7 @@ void UserDrivingForce::ReadInput(std::string InputFileName)
     ConsoleOutput::WriteLineInsert("UserDrivingForce input");
     ConsoleOutput::WriteStandard("Source", InputFileName);
 
-    fstream inp(InputFileName.c_str(), ios::in | ios_base::binary);
+    stringstream inp = FileInterface::OpenInput(InputFileName);
 
     if (!inp)
     {
@@ -77,13 +79,14 @@ void UserDrivingForce::ReadInput(std::string InputFileName)
     data << inp.rdbuf();
     ReadInput(data);
 
-    inp.close();
 }
 
 void UserDrivingForce::ReadInput(std::stringstream& inp)
 {
     int moduleLocation = FileInterface::FindModuleLocation(inp, thisclassname);
 
+    BatchTileCells = max(1, FileInterface::ReadParameterI(inp, moduleLocation, string("BatchTileCells"), false, 256));
+
     // Reading driving force modes and parameters for each phase pair
     for (size_t n = 0; n < Nphases; n++)
     for (size_t m = n; m < Nphases; m++)
@@ -262,6 +265,83 @@ void UserDrivingForce::SetDrivingForce(PhaseField& Phase,
     OMP_PARALLEL_STORAGE_LOOP_END
 }
 
+void UserDrivingForce::SetDrivingForceBatched(PhaseField& Phase, DrivingForce& dGab,
+                                              const Temperature* Tx,
+                                              const Composition* Cx)
+{
+    if(not BatchKernel)
+    {
+        ConsoleOutput::WriteExit("No batched driving force kernel registered", thisclassname, "SetDrivingForceBatched()");
+        OP_Exit(EXIT_FAILURE);
+    }
+    SetDrivingForceBatched(Phase, dGab, Tx, Cx, BatchKernel);
+}
+
+size_t UserDrivingForce::NumberOfTiles(const PhaseField& Phase) const
+{
+    return (Phase.InterfaceCells.size() + BatchTileCells - 1)/BatchTileCells;
+}
+
+void UserDrivingForce::GatherTile(const PhaseField& Phase, const Temperature* Tx,
+                                  const Composition* Cx, const size_t Tile,
+                                  UserDrivingForceTile& locTile) const
+{
+    locTile.clear();
+    locTile.Ncomp = (Cx != nullptr) ? Cx->Ncomp : 0;
+
+    const size_t Begin = Tile*BatchTileCells;
+    const size_t End   = min(Begin + BatchTileCells, Phase.InterfaceCells.size());
+    for(size_t n = Begin; n < End; n++)
+    {
+        /* The cell list includes halo cells, the driving force is set in the
+        interior only, as in SetDrivingForce() */
+        const iVector3& Cell = Phase.InterfaceCells[n];
+        if(Cell[0] < 0 or Cell[0] >= Phase.Grid.Nx or
+           Cell[1] < 0 or Cell[1] >= Phase.Grid.Ny or
+           Cell[2] < 0 or Cell[2] >= Phase.Grid.Nz) continue;
+
+        const NodePF& locPF = Phase.Fields(Cell[0],Cell[1],Cell[2]);
+        if(not locPF.interface()) continue;
+
+        for(auto alpha = locPF.cbegin(); alpha != locPF.cend() - 1; ++alpha)
+        for(auto  beta = alpha + 1;       beta != locPF.cend();     ++beta)
+        {
+            locTile.Position.push_back(Cell);
+            locTile.IndexA.push_back(alpha->index);
+            locTile.IndexB.push_back( beta->index);
+            locTile.PhaseA.push_back(Phase.FieldsProperties[alpha->index].Phase);
+            locTile.PhaseB.push_back(Phase.FieldsProperties[ beta->index].Phase);
+            locTile.FractionA.push_back(alpha->value);
+            locTile.FractionB.push_back( beta->value);
+            if(Tx != nullptr) locTile.T.push_back((*Tx)(Cell[0],Cell[1],Cell[2]));
+        }
+    }
+    locTile.Size = locTile.IndexA.size();
+    locTile.dG.assign(locTile.Size, 0.0);
+
+    if(locTile.Ncomp)
+    {
+        locTile.MoleFractionsA.resize(locTile.Ncomp*locTile.Size);
+        locTile.MoleFractionsB.resize(locTile.Ncomp*locTile.Size);
+        for(size_t comp = 0; comp < locTile.Ncomp; comp++)
+        for(size_t n = 0; n < locTile.Size; n++)
+        {
+            const iVector3& Cell = locTile.Position[n];
+            locTile.MoleFractionsA[comp*locTile.Size + n] = Cx->MoleFractions(Cell[0],Cell[1],Cell[2],{locTile.PhaseA[n],comp});
+            locTile.MoleFractionsB[comp*locTile.Size + n] = Cx->MoleFractions(Cell[0],Cell[1],Cell[2],{locTile.PhaseB[n],comp});
+        }
+    }
+}
+
+void UserDrivingForce::ScatterTile(DrivingForce& dGab, const UserDrivingForceTile& locTile)
+{
+    for(size_t n = 0; n < locTile.Size; n++)
+    {
+        const iVector3& Cell = locTile.Position[n];
+        dGab.Force(Cell[0],Cell[1],Cell[2]).add_raw(locTile.IndexA[n], locTile.IndexB[n], locTile.dG[n]);
+    }
+}
+
 void UserDrivingForce::SetDrivingForce(PhaseField& Phase, DrivingForce& dGab,
                                        int indexA, int indexB, double dGvalue)
 {
@@ -26,7 +26,11 @@
  */
 
 #include "VTK.h"
+#include "AsyncOutput.h"
+#include "Embedded.h"
 #include "Settings.h"
+#include "ConsoleOutput.h"
+#include "OutputRegion.h"
 #include "../external/WinBase64/base64.h"
 #include "../external/miniz.h"
 namespace openphase
@@ -72,6 +76,93 @@ char* VTK::compress_data(size_t* csize, const char* data, size_t size)
     return comp;
 }
 
+/* Multi block zlib format of the VTK XML files: a header {nblocks,
+blocksize, lastblocksize, csize_0, ..., csize_n-1} of the file's header type
+followed by the compressed blocks. The blocks are compressed concurrently. */
+template<class header_t>
+static void CompressBlocks(const char* data, const size_t size,
+                           vector<header_t>& header, vector<unsigned char>& compressed)
+{
+    const size_t BlockSize = VTK::CompressionBlockSize;
+    const size_t nblocks = (size + BlockSize - 1)/BlockSize;
+    vector<vector<unsigned char>> blocks(nblocks);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t b = 0; b < nblocks; b++)
+    {
+        const size_t offset = b*BlockSize;
+        const size_t bsize  = min(BlockSize, size - offset);
+        mz_ulong csize = compressBound(bsize);
+        blocks[b].resize(csize);
+        const int stat = compress2(blocks[b].data(), &csize,
+                                   (const unsigned char*)data + offset, bsize, VTK::CompressionLevel);
+        if(stat != Z_OK)
+        {
+            ConsoleOutput::WriteWarning("Compression of the VTK data failed", "VTK", "CompressBlocks()");
+        }
+        blocks[b].resize(csize);
+    }
+
+    header.assign(3 + nblocks, 0);
+    header[0] = nblocks;
+    header[1] = BlockSize;
+    header[2] = (nblocks > 0) ? size - (nblocks - 1)*BlockSize : 0;
+    vector<size_t> offsets(nblocks + 1, 0);
+    for(size_t b = 0; b < nblocks; b++)
+    {
+        header[3 + b] = blocks[b].size();
+        offsets[b + 1] = offsets[b] + blocks[b].size();
+    }
+    compressed.resize(offsets[nblocks]);
+    #pragma omp parallel for schedule(static)
+    for(size_t b = 0; b < nblocks; b++)
+    {
+        memcpy(compressed.data() + offsets[b], blocks[b].data(), blocks[b].size());
+    }
+}
+
+string VTK::CompressEncode(const char* data, const size_t size)
+{
+    /* The header (UInt32) and the compressed blocks are base64 encoded
+    separately, the encoding is split into chunks of a multiple of 3 bytes
+    which are encoded independently. */
+    vector<uint32_t> header;
+    vector<unsigned char> compressed;
+    CompressBlocks(data, size, header, compressed);
+
+    const size_t chunk  = 3*CompressionBlockSize;
+    const size_t nchunks = (compressed.size() + chunk - 1)/chunk;
+    string result = base64_encode((const unsigned char*)header.data(),
+                                  static_cast<unsigned int>(header.size()*sizeof(uint32_t)));
+    const size_t start = result.size();
+    result.resize(start + 4*((compressed.size() + 2)/3));
+
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t c = 0; c < nchunks; c++)
+    {
+        const size_t offset = c*chunk;
+        const size_t csize  = min(chunk, compressed.size() - offset);
+        const string encoded = base64_encode(compressed.data() + offset,
+                                             static_cast<unsigned int>(csize));
+        memcpy(&result[start + 4*(offset/3)], encoded.data(), encoded.size());
+    }
+    return result;
+}
+
+static bool WriteRegions(const string& Filename, const Settings& locSettings,
+                         const vector<VTK::Field_t>& ListOfFields,
+                         const bool Compressed, const int resolution);
+
+bool VTK::WriteEmbedded(const string& Filename, const Settings& locSettings,
+                        const vector<Field_t>& ListOfFields,
+                        const int resolution)
+{
+    return Embedded::WriteFields(Filename, ListOfFields,
+                                 get_Nx(resolution, locSettings),
+                                 get_Ny(resolution, locSettings),
+                                 get_Nz(resolution, locSettings));
+}
+
 void VTK::Write(
     const std::string Filename,
     const Settings& locSettings,
@@ -79,10 +170,28 @@ void VTK::Write(
     const int precision,
     const int resolution)
 {
+    if(WriteEmbedded(Filename, locSettings, ListOfFields, resolution)) return;
+    if(WriteRegions(Filename, locSettings, ListOfFields, false, resolution)) return;
+
 	const long int Nx = get_Nx(resolution, locSettings);
     const long int Ny = get_Ny(resolution, locSettings);
     const long int Nz = get_Nz(resolution, locSettings);
 
+#ifndef MPI_PARALLEL
+    if(AsyncOutput::Active())
+    {
+        size_t Bytes = 0;
+        if(AsyncOutput::Snapshot(ListOfFields, Nx, Ny, Nz, Bytes))
+        {
+            AsyncOutput::Submit([Filename, locSettings, ListOfFields, precision, resolution]()
+            {
+                Write(Filename, locSettings, ListOfFields, precision, resolution);
+            }, Bytes);
+            return;
+        }
+    }
+#endif
+
 #ifndef MPI_PARALLEL
     ofstream vtk_file(Filename.c_str());
     VTK::WriteHeader(vtk_file, Nx, Ny, Nz);
@@ -134,10 +243,28 @@ void VTK::WriteCompressed(
         std::vector<Field_t> ListOfFields,
         const int precision, const int resolution)
 {
+    if(WriteEmbedded(Filename, locSettings, ListOfFields, resolution)) return;
+    if(WriteRegions(Filename, locSettings, ListOfFields, true, resolution)) return;
+
     const long int Nx = get_Nx(resolution, locSettings);
     const long int Ny = get_Ny(resolution, locSettings);
     const long int Nz = get_Nz(resolution, locSettings);
 
+#ifndef MPI_PARALLEL
+    if(AsyncOutput::Active())
+    {
+        size_t Bytes = 0;
+        if(AsyncOutput::Snapshot(ListOfFields, Nx, Ny, Nz, Bytes))
+        {
+            AsyncOutput::Submit([Filename, locSettings, ListOfFields, precision, resolution]()
+            {
+                WriteCompressed(Filename, locSettings, ListOfFields, precision, resolution);
+            }, Bytes);
+            return;
+        }
+    }
+#endif
+
 #ifndef MPI_PARALLEL
     ofstream vtk_file(Filename.c_str());
     VTK::WriteHeaderCompressed(vtk_file, Nx, Ny, Nz);
@@ -183,6 +310,336 @@ void VTK::WriteCompressed(
  #endif
 }
 
+/* Data array of the appended data section, Data holds the array's header
+and (compressed) values as they are written to the file */
+struct AppendedArray
+{
+    string Name;
+    string Type;
+    size_t NComponents;
+    vector<char> Data;
+};
+
+template<class T>
+static void SetAppendedData(AppendedArray& Array, const vector<T>& Values, const bool Compressed)
+{
+    const char*  data = (const char*)Values.data();
+    const size_t size = Values.size()*sizeof(T);
+    if(Compressed)
+    {
+        vector<uint64_t> header;
+        vector<unsigned char> compressed;
+        CompressBlocks(data, size, header, compressed);
+        Array.Data.resize(header.size()*sizeof(uint64_t) + compressed.size());
+        memcpy(Array.Data.data(), header.data(), header.size()*sizeof(uint64_t));
+        memcpy(Array.Data.data() + header.size()*sizeof(uint64_t), compressed.data(), compressed.size());
+    }
+    else
+    {
+        const uint64_t header = size;
+        Array.Data.resize(sizeof(uint64_t) + size);
+        memcpy(Array.Data.data(), &header, sizeof(uint64_t));
+        memcpy(Array.Data.data() + sizeof(uint64_t), data, size);
+    }
+}
+
+template<class T>
+static bool AppendedScalars(const VTK::Field_t& Field, const string& Type,
+                            const long int Nx, const long int Ny, const long int Nz,
+                            const bool Compressed, vector<AppendedArray>& Arrays)
+{
+    if(Field.ValueType() != typeid(T)) return false;
+
+    AppendedArray Array{Field.Name, Type, 1, {}};
+    SetAppendedData(Array, Field.template Values<T>(Nx, Ny, Nz), Compressed);
+    Arrays.push_back(std::move(Array));
+    return true;
+}
+
+template<class T>
+static bool AppendedVectors(const VTK::Field_t& Field,
+                            const long int Nx, const long int Ny, const long int Nz,
+                            const bool Compressed, vector<AppendedArray>& Arrays)
+{
+    if(Field.ValueType() != typeid(T)) return false;
+
+    const vector<T> Values = Field.template Values<T>(Nx, Ny, Nz);
+    const size_t NComponents = T().writeBinary().size();
+    vector<double> Components(Values.size()*NComponents);
+    #pragma omp parallel for schedule(static)
+    for(size_t idx = 0; idx < Values.size(); idx++)
+    {
+        const vector<double> Value = Values[idx].writeBinary();
+        copy(Value.begin(), Value.end(), Components.begin() + idx*NComponents);
+    }
+    AppendedArray Array{Field.Name, "Float64", NComponents, {}};
+    SetAppendedData(Array, Components, Compressed);
+    Arrays.push_back(std::move(Array));
+    return true;
+}
+
+static string Extent(const long int extent[6])
+{
+    stringstream result;
+    result << extent[0] << " " << extent[1] << " "
+           << extent[2] << " " << extent[3] << " "
+           << extent[4] << " " << extent[5];
+    return result.str();
+}
+
+static void WriteAppendedPiece(const string& Filename, const long int WholeExtent[6],
+                               const long int PieceExtent[6],
+                               const vector<AppendedArray>& Arrays,
+                               const AppendedArray& Points, const bool Compressed)
+{
+    ofstream vtk_file(Filename.c_str(), ios::out | ios::binary);
+    if(!vtk_file)
+    {
+        ConsoleOutput::WriteWarning("File \"" + Filename + "\" could not be opened", "VTK", "WriteAppended()");
+        return;
+    }
+    vtk_file << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+    vtk_file << "<VTKFile type=\"StructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\"";
+    if(Compressed) vtk_file << " compressor=\"vtkZLibDataCompressor\"";
+    vtk_file << ">\n";
+    vtk_file << "<StructuredGrid WholeExtent=\"" << Extent(WholeExtent) << "\">\n";
+    vtk_file << "<Piece Extent=\"" << Extent(PieceExtent) << "\">\n";
+    vtk_file << "<PointData>\n";
+    size_t offset = 0;
+    for(auto& Array : Arrays)
+    {
+        vtk_file << "<DataArray type=\"" << Array.Type << "\" Name=\"" << Array.Name
+                 << "\" NumberOfComponents=\"" << Array.NComponents
+                 << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+        offset += Array.Data.size();
+    }
+    vtk_file << "</PointData>\n";
+    vtk_file << "<Points>\n";
+    vtk_file << "<DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+    vtk_file << "</Points>\n";
+    vtk_file << "</Piece>\n";
+    vtk_file << "</StructuredGrid>\n";
+    vtk_file << "<AppendedData encoding=\"raw\">\n_";
+    for(auto& Array : Arrays)
+    {
+        vtk_file.write(Array.Data.data(), Array.Data.size());
+    }
+    vtk_file.write(Points.Data.data(), Points.Data.size());
+    vtk_file << "\n</AppendedData>\n";
+    vtk_file << "</VTKFile>\n";
+}
+
+/* Writes the local part of a structured grid with N points in the appended
+format. Offset is the position of the local part in the global grid of Total
+points, the point (i,j,k) is placed at Origin + (Offset + (i,j,k))*Spacing.
+In MPI runs ranks without points write no piece. */
+static void WriteAppendedGrid(const string& Filename,
+                              const vector<VTK::Field_t>& ListOfFields,
+                              const bool Compressed, const long int N[3],
+                              const long int Offset[3], const long int Total[3],
+                              const double Origin[3], const double Spacing[3])
+{
+    const long int Nx = N[0];
+    const long int Ny = N[1];
+    const long int Nz = N[2];
+
+    vector<AppendedArray> Arrays;
+    for(auto& Field : ListOfFields)
+    {
+        if(not (AppendedScalars<int>       (Field, "Int32",   Nx, Ny, Nz, Compressed, Arrays) or
+                AppendedScalars<size_t>    (Field, "UInt64",  Nx, Ny, Nz, Compressed, Arrays) or
+                AppendedScalars<double>    (Field, "Float64", Nx, Ny, Nz, Compressed, Arrays) or
+                AppendedVectors<dVector3>  (Field, Nx, Ny, Nz, Compressed, Arrays) or
+                AppendedVectors<dVector6>  (Field, Nx, Ny, Nz, Compressed, Arrays) or
+                AppendedVectors<vStrain>   (Field, Nx, Ny, Nz, Compressed, Arrays) or
+                AppendedVectors<vStress>   (Field, Nx, Ny, Nz, Compressed, Arrays) or
+                AppendedVectors<dMatrix3x3>(Field, Nx, Ny, Nz, Compressed, Arrays) or
+                AppendedVectors<dMatrix6x6>(Field, Nx, Ny, Nz, Compressed, Arrays)))
+        {
+            ConsoleOutput::WriteWarning("Field \"" + Field.Name + "\" has an unsupported type and is skipped",
+                                        "VTK", "WriteAppended()");
+        }
+    }
+
+    vector<double> points(Nx*Ny*Nz*3);
+    #pragma omp parallel for collapse(2) schedule(static)
+    for(long int k = 0; k < Nz; ++k)
+    for(long int j = 0; j < Ny; ++j)
+    for(long int i = 0; i < Nx; ++i)
+    {
+        const size_t it = ((k*Ny + j)*Nx + i)*3;
+        points[it    ] = Origin[0] + (i + Offset[0])*Spacing[0];
+        points[it + 1] = Origin[1] + (j + Offset[1])*Spacing[1];
+        points[it + 2] = Origin[2] + (k + Offset[2])*Spacing[2];
+    }
+    AppendedArray Points{"Points", "Float64", 3, {}};
+    SetAppendedData(Points, points, Compressed);
+
+    const long int WholeExtent[6] = {0, Total[0]-1, 0, Total[1]-1, 0, Total[2]-1};
+    const long int PieceExtent[6] = {Offset[0], Offset[0] + Nx-1,
+                                     Offset[1], Offset[1] + Ny-1,
+                                     Offset[2], Offset[2] + Nz-1};
+#ifndef MPI_PARALLEL
+    WriteAppendedPiece(Filename, WholeExtent, PieceExtent, Arrays, Points, Compressed);
+#else
+    /* Each rank writes its own piece "<name>_<rank>.vts", rank 0 writes the
+    index "<name>.pvts" referencing all pieces */
+    const size_t dot = Filename.find_last_of('.');
+    const size_t sep = Filename.find_last_of("/\\");
+    const string Stem = (dot != string::npos and (sep == string::npos or dot > sep)) ?
+                        Filename.substr(0, dot) : Filename;
+    const bool Empty = (Nx == 0 or Ny == 0 or Nz == 0);
+    if(not Empty)
+    {
+        const string PieceName = Stem + "_" + to_string(MPI_RANK) + ".vts";
+        WriteAppendedPiece(PieceName, WholeExtent, PieceExtent, Arrays, Points, Compressed);
+    }
+
+    vector<long int> Extents(6*MPI_SIZE);
+    OP_MPI_Allgather(PieceExtent, 6, OP_MPI_LONG, Extents.data(), 6, OP_MPI_LONG, OP_MPI_COMM_WORLD);
+    if(MPI_RANK == 0)
+    {
+        const string BaseName = (sep == string::npos) ? Stem : Stem.substr(sep + 1);
+        ofstream pvts_file((Stem + ".pvts").c_str());
+        pvts_file << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+        pvts_file << "<VTKFile type=\"PStructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+        pvts_file << "<PStructuredGrid WholeExtent=\"" << Extent(WholeExtent) << "\" GhostLevel=\"0\">\n";
+        pvts_file << "<PPointData>\n";
+        for(auto& Array : Arrays)
+        {
+            pvts_file << "<PDataArray type=\"" << Array.Type << "\" Name=\"" << Array.Name
+                      << "\" NumberOfComponents=\"" << Array.NComponents << "\"/>\n";
+        }
+        pvts_file << "</PPointData>\n";
+        pvts_file << "<PPoints>\n";
+        pvts_file << "<PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n";
+        pvts_file << "</PPoints>\n";
+        for(int rank = 0; rank < MPI_SIZE; rank++)
+        {
+            const long int* RankExtent = &Extents[6*rank];
+            if(RankExtent[1] < RankExtent[0] or RankExtent[3] < RankExtent[2] or
+               RankExtent[5] < RankExtent[4]) continue;
+            pvts_file << "<Piece Extent=\"" << Extent(RankExtent)
+                      << "\" Source=\"" << BaseName << "_" << rank << ".vts\"/>\n";
+        }
+        pvts_file << "</PStructuredGrid>\n";
+        pvts_file << "</VTKFile>\n";
+    }
+#endif
+}
+
+/* Writes each of the output regions instead of the whole domain, returns
+false if no regions are set */
+static bool WriteRegions(const string& Filename, const Settings& locSettings,
+                         const vector<VTK::Field_t>& ListOfFields,
+                         const bool Compressed, const int resolution)
+{
+    if(locSettings.OutputRegions.empty()) return false;
+    for(const OutputRegion& Region : locSettings.OutputRegions)
+    {
+        VTK::WriteRegion(Region.FileName(Filename), locSettings, ListOfFields,
+                         Region, Compressed, resolution);
+    }
+    return true;
+}
+
+/* Coordinate spacing of the output points in grid units */
+static void PointSpacing(const Settings& locSettings, const int resolution, double Spacing[3])
+{
+    Spacing[0] = Spacing[1] = Spacing[2] = 1.0;
+    if(resolution == 2)
+    {
+        const long int TotalNx = (locSettings.Grid.dNx + 1)*locSettings.Grid.TotalNx;
+        const long int TotalNy = (locSettings.Grid.dNy + 1)*locSettings.Grid.TotalNy;
+        const long int TotalNz = (locSettings.Grid.dNz + 1)*locSettings.Grid.TotalNz;
+        Spacing[0] = locSettings.Grid.dNx ? 0.5*(TotalNx-1)/TotalNx : 0;
+        Spacing[1] = locSettings.Grid.dNy ? 0.5*(TotalNy-1)/TotalNy : 0;
+        Spacing[2] = locSettings.Grid.dNz ? 0.5*(TotalNz-1)/TotalNz : 0;
+    }
+}
+
+void VTK::WriteAppended(
+        const std::string Filename,
+        const Settings& locSettings,
+        std::vector<Field_t> ListOfFields,
+        const bool Compressed,
+        const int resolution)
+{
+    if(WriteEmbedded(Filename, locSettings, ListOfFields, resolution)) return;
+    if(WriteRegions(Filename, locSettings, ListOfFields, Compressed, resolution)) return;
+
+    const long int Nx = get_Nx(resolution, locSettings);
+    const long int Ny = get_Ny(resolution, locSettings);
+    const long int Nz = get_Nz(resolution, locSettings);
+
+#ifndef MPI_PARALLEL
+    if(AsyncOutput::Active())
+    {
+        size_t Bytes = 0;
+        if(AsyncOutput::Snapshot(ListOfFields, Nx, Ny, Nz, Bytes))
+        {
+            AsyncOutput::Submit([Filename, locSettings, ListOfFields, Compressed, resolution]()
+            {
+                WriteAppended(Filename, locSettings, ListOfFields, Compressed, resolution);
+            }, Bytes);
+            return;
+        }
+    }
+#endif
+
+    const long int N[3]      = {Nx, Ny, Nz};
+    const long int Offset[3] = {get_OffsetX(resolution, locSettings),
+                                get_OffsetY(resolution, locSettings),
+                                get_OffsetZ(resolution, locSettings)};
+    const long int Total[3]  = {get_TotalNx(resolution, locSettings),
+                                get_TotalNy(resolution, locSettings),
+                                get_TotalNz(resolution, locSettings)};
+    const double Origin[3] = {0.0, 0.0, 0.0};
+    double Spacing[3];
+    PointSpacing(locSettings, resolution, Spacing);
+    WriteAppendedGrid(Filename, ListOfFields, Compressed, N, Offset, Total, Origin, Spacing);
+}
+
+void VTK::WriteRegion(
+        const std::string Filename,
+        const Settings& locSettings,
+        std::vector<Field_t> ListOfFields,
+        const OutputRegion& Region,
+        const bool Compressed,
+        const int resolution)
+{
+    const OutputRegion::View_t View = Region.Local(locSettings, resolution);
+    if(View.Total[0] == 0 or View.Total[1] == 0 or View.Total[2] == 0)
+    {
+        ConsoleOutput::WriteWarning("Output region \"" + Region.Name + "\" is outside of the domain",
+                                    "VTK", "WriteRegion()");
+        return;
+    }
+    std::vector<Field_t> RegionFields = Region.Restrict(ListOfFields, View);
+
+    double Spacing[3];
+    PointSpacing(locSettings, resolution, Spacing);
+    const double Origin[3] = {View.Begin[0]*Spacing[0], View.Begin[1]*Spacing[1], View.Begin[2]*Spacing[2]};
+    for(int d = 0; d < 3; d++) Spacing[d] *= View.Stride[d];
+
+#ifndef MPI_PARALLEL
+    if(AsyncOutput::Active())
+    {
+        size_t Bytes = 0;
+        if(AsyncOutput::Snapshot(RegionFields, View.N[0], View.N[1], View.N[2], Bytes))
+        {
+            AsyncOutput::Submit([Filename, RegionFields, Compressed, View, Origin, Spacing]()
+            {
+                WriteAppendedGrid(Filename, RegionFields, Compressed, View.N, View.Offset,
+                                  View.Total, Origin, Spacing);
+            }, Bytes);
+            return;
+        }
+    }
+#endif
+    WriteAppendedGrid(Filename, RegionFields, Compressed, View.N, View.Offset, View.Total, Origin, Spacing);
+}
+
 void VTK::WriteDistorted(
     const std::string Filename,
     const Settings& locSettings,
@@ -191,6 +648,8 @@ void VTK::WriteDistorted(
     const int precision,
     const int resolution)
 {
+    if(WriteEmbedded(Filename, locSettings, ListOfFields, resolution)) return;
+
     const long int Nx = get_Nx(resolution, locSettings);
     const long int Ny = get_Ny(resolution, locSettings);
     const long int Nz = get_Nz(resolution, locSettings);
@@ -248,6 +707,8 @@ void VTK::WriteDistortedCompressed(
     const int precision,
     const int resolution)
 {
+    if(WriteEmbedded(Filename, locSettings, ListOfFields, resolution)) return;
+
     const long int Nx = get_Nx(resolution, locSettings);
     const long int Ny = get_Ny(resolution, locSettings);
     const long int Nz = get_Nz(resolution, locSettings);
@@ -31,6 +31,8 @@
 #include "VTK.h"
 #include "ElasticProperties.h"
 #include "RunTimeControl.h"
+#include "LoadBalancer.h"
+#include "TimeSeriesOutput.h"
 
 namespace openphase
 {
@@ -60,6 +62,7 @@ void Velocities::Initialize(Settings& locSettings, std::string ObjectNameSuffix)
 
     locSettings.AddForAdvection(*this);
     locSettings.AddForRemeshing(*this);
+    repartitionable = true;
 
     initialized = true;
     ConsoleOutput::WriteStandard(thisclassname, "Initialized");
@@ -81,10 +84,7 @@ void Velocities::Clear()
     OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Average,Average.Bcells(),)
     {
         Average(i,j,k).set_to_zero();
-        for(size_t alpha = 0; alpha < Nphases; ++alpha)
-        {
-            Phase(i, j, k, {alpha}).set_to_zero();
-        }
+        Phase(i,j,k).clear();
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 }
@@ -119,10 +119,20 @@ void Velocities::SetAllPhases(dVector3& value)
 
 void Velocities::PrescribePhaseVelocities(PhaseField& Phi)
 {
-    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase,Phase.Bcells(),)
-    for(size_t alpha = 0; alpha < Nphases; ++alpha)
+    /* Only the phases present in a cell get a velocity, the entries of
+    phases which have left the cell are dropped */
+    std::vector<size_t> Present;
+    OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase,Phase.Bcells(), private(Present))
     {
-        Phase(i, j, k,{alpha}) = Average(i,j,k);
+        Present.clear();
+        for(auto alpha = Phi.Fields(i,j,k).cbegin();
+                 alpha != Phi.Fields(i,j,k).cend(); ++alpha)
+        {
+            const size_t pIndex = Phi.FieldsProperties[alpha->index].Phase;
+            Phase(i,j,k,{pIndex}) = Average(i,j,k);
+            Present.push_back(pIndex);
+        }
+        Phase.erase_absent(i,j,k,Present);
     }
     OMP_PARALLEL_STORAGE_LOOP_END
 }
@@ -142,14 +152,14 @@ void Velocities::CalculateAverage(const PhaseField& Phi)
             {
                 size_t locPindex = Phi.FieldsProperties[alpha->index].Phase;
                 locDensity += Phi.FieldsProperties[alpha->index].Density*alpha->value;
-                locMomentumDensity += Phase(i,j,k,{locPindex})*Phi.FieldsProperties[alpha->index].Density*alpha->value;
+                locMomentumDensity += Phase.get(i,j,k,locPindex)*Phi.FieldsProperties[alpha->index].Density*alpha->value;
             }
             Average(i,j,k) += locMomentumDensity/locDensity;
         }
         else
         {
             size_t pInd = Phi.FieldsProperties[Phi.Fields(i,j,k).front().index].Phase;
-            Average(i,j,k) = Phase(i,j,k,{pInd});
+            Average(i,j,k) = Phase.get(i,j,k,pInd);
         }
     }
     OMP_PARALLEL_STORAGE_LOOP_END
@@ -163,11 +173,18 @@ void Velocities::WriteVTK(Settings& locSettings, int tStep) const
 
     for (size_t n = 0; n < Nphases; n++)
     {
-        ListOfFields.push_back((VTK::Field_t){"VelocityPhase_" + std::to_string(n), [n,this](int i,int j,int k){return Phase(i,j,k,{n});}});
+        ListOfFields.push_back((VTK::Field_t){"VelocityPhase_" + std::to_string(n), [n,this](int i,int j,int k){return Phase.get(i,j,k,n);}});
     }
     VTK::Write(Filename, locSettings, ListOfFields);
 }
 
+size_t Velocities::AllocatedMemory(void) const
+{
+    return Average.AllocatedMemory() +
+           AverageDot.AllocatedMemory() +
+           Phase.AllocatedMemory();
+}
+
 void Velocities::Remesh(int newNx, int newNy, int newNz, const BoundaryConditions& BC)
 {
     SetBoundaryConditions(BC);
@@ -182,29 +199,28 @@ void Velocities::Remesh(int newNx, int newNy, int newNz, const BoundaryCondition
     ConsoleOutput::WriteStandard(thisclassname, "Remeshed");
 }
 
-void Velocities::MoveFrame(int dx, int dy, int dz, const BoundaryConditions& BC)
+void Velocities::Repartition(const BoundaryConditions& BC)
 {
-    int xBeg = (dx >= 0) + (dx < 0)*(Grid.Nx) - 1;
-    int xEnd = (dx >= 0)*(Grid.Nx) + (dx < 0) - 1;
-    int xInc = 1 - 2*(dx < 0);
-
-    int yBeg = (dy >= 0) + (dy < 0)*(Grid.Ny) - 1;
-    int yEnd = (dy >= 0)*(Grid.Ny) + (dy < 0) - 1;
-    int yInc = 1 - 2*(dy < 0);
+    const GridParameters OldGrid = Grid;
+    Grid.ApplyCutPlanes();
 
-    int zBeg = (dz >= 0) + (dz < 0)*(Grid.Nz) - 1;
-    int zEnd = (dz >= 0)*(Grid.Nz) + (dz < 0) - 1;
-    int zInc = 1 - 2*(dz < 0);
+    LoadBalancer::Migrate(Phase, OldGrid, Grid);
+    LoadBalancer::Migrate(Average, OldGrid, Grid);
 
-    for(int i = xBeg; ((dx >= 0) and (i <= xEnd)) or ((dx < 0) and (i >= xEnd)); i += xInc)
-    for(int j = yBeg; ((dy >= 0) and (j <= yEnd)) or ((dy < 0) and (j >= yEnd)); j += yInc)
-    for(int k = zBeg; ((dz >= 0) and (k <= zEnd)) or ((dz < 0) and (k >= zEnd)); k += zInc)
+    if(AverageDot.IsAllocated())
     {
-        Phase(i, j, k) = Phase(i + dx, j + dy, k + dz);
-        Average(i, j, k) = Average(i + dx, j + dy, k + dz);
+        AverageDot.Reallocate(Grid.Nx, Grid.Ny, Grid.Nz);
     }
 
     SetBoundaryConditions(BC);
+}
+
+void Velocities::MoveFrame(int dx, int dy, int dz, const BoundaryConditions& BC)
+{
+    Phase.Shift(dx, dy, dz);
+    Average.Shift(dx, dy, dz);
+
+    SetBoundaryConditions(BC);
 
     ConsoleOutput::WriteStandard(thisclassname, "Frame moved");
 
@@ -216,7 +232,7 @@ void Velocities::PrintPointStatistics(int x, int y, int z)
     for (size_t PhaseIdx = 0; PhaseIdx < Nphases;  ++PhaseIdx)
     {
         std::string vname = "Phase Velocity "+PhaseNames[PhaseIdx];
-        ConsoleOutput::WriteStandard(vname, Phase(x,y,z,{PhaseIdx}),3);
+        ConsoleOutput::WriteStandard(vname, Phase.get(x,y,z,PhaseIdx),3);
     }
     ConsoleOutput::WriteStandard("Average Velocity", Average(x,y,z),3);
     ConsoleOutput::WriteBlankLine();
@@ -243,18 +259,13 @@ void Velocities::WriteStatistics(RunTimeControl& RTC)
 {
     double MAXVelocity = GetMaxVelocity();
 
-    ofstream output_file;
-    if (RTC.TimeStep == 0)
-    {
-        output_file.open("VelocityStatistics.txt", ios::out);
-        output_file << "tStep" << "\t\t\t" << "sim_time" << "\t\t\t"
-                    << "max velocity" << endl;
-        output_file.close();
-    }
+    stringstream header;
+    header << "tStep" << "\t\t\t" << "sim_time" << "\t\t\t"
+           << "max velocity" << "\n";
 
-    output_file.open("VelocityStatistics.txt", ios::app);
-    output_file << RTC.TimeStep << "\t\t\t" << RTC.SimulationTime << "\t\t\t" << MAXVelocity << endl;
-    output_file.close();
+    stringstream line;
+    line << RTC.TimeStep << "\t\t\t" << RTC.SimulationTime << "\t\t\t" << MAXVelocity << "\n";
+    TimeSeriesOutput::Append("VelocityStatistics.txt", header.str(), line.str(), RTC.TimeStep == 0);
 }
 
 Velocities& Velocities::operator= (const Velocities& rhs)
@@ -269,7 +280,7 @@ Velocities& Velocities::operator= (const Velocities& rhs)
 
         if (Phase.IsNotAllocated())
         {
-            Phase.Allocate(Grid, {Nphases}, rhs.Phase.Bcells());
+            Phase.Allocate(Grid, rhs.Phase.Bcells());
             Average.Allocate(Grid, rhs.Average.Bcells());
         }
         else if (not Phase.IsSize(rhs.Grid.Nx, rhs.Grid.Ny, rhs.Grid.Nz))
@@ -281,10 +292,7 @@ Velocities& Velocities::operator= (const Velocities& rhs)
         OMP_PARALLEL_STORAGE_LOOP_BEGIN(i,j,k,Phase,Phase.Bcells(),)
         {
             Average(i,j,k) = rhs.Average(i,j,k);
-            for(size_t alpha = 0; alpha < Nphases; ++alpha)
-            {
-                Phase(i,j,k, {alpha}) = rhs.Phase(i,j,k, {alpha});
-            }
+            Phase(i,j,k) = rhs.Phase(i,j,k);
         }
         OMP_PARALLEL_STORAGE_LOOP_END
     }
@@ -377,12 +385,13 @@ bool Velocities::Write(const Settings& OPSettings, const int tStep) const
     }
     STORAGE_LOOP_END
 
+    /* The file keeps the dense layout, absent phases are written as zero */
     STORAGE_LOOP_BEGIN(i,j,k,Phase,0)
     for(size_t n = 0; n < Nphases; n++)
     {
-        out.write(reinterpret_cast<const char*>(&Phase(i,j,k,{n})[0]), sizeof(double));
-        out.write(reinterpret_cast<const char*>(&Phase(i,j,k,{n})[1]), sizeof(double));
-        out.write(reinterpret_cast<const char*>(&Phase(i,j,k,{n})[2]), sizeof(double));
+        out.write(reinterpret_cast<const char*>(&Phase.get(i,j,k,n)[0]), sizeof(double));
+        out.write(reinterpret_cast<const char*>(&Phase.get(i,j,k,n)[1]), sizeof(double));
+        out.write(reinterpret_cast<const char*>(&Phase.get(i,j,k,n)[2]), sizeof(double));
     }
     STORAGE_LOOP_END
 
@@ -435,11 +444,19 @@ bool Velocities::Read(const Settings& OPSettings, const BoundaryConditions& BC,
     STORAGE_LOOP_END
 
     STORAGE_LOOP_BEGIN(i,j,k,Phase,0)
-    for(size_t n = 0; n < Nphases; n++)
     {
-        inp.read(reinterpret_cast<char*>(&Phase(i,j,k,{n})[0]), sizeof(double));
-        inp.read(reinterpret_cast<char*>(&Phase(i,j,k,{n})[1]), sizeof(double));
-        inp.read(reinterpret_cast<char*>(&Phase(i,j,k,{n})[2]), sizeof(double));
+        Phase(i,j,k).clear();
+        for(size_t n = 0; n < Nphases; n++)
+        {
+            dVector3 locVelocity;
+            inp.read(reinterpret_cast<char*>(&locVelocity[0]), sizeof(double));
+            inp.read(reinterpret_cast<char*>(&locVelocity[1]), sizeof(double));
+            inp.read(reinterpret_cast<char*>(&locVelocity[2]), sizeof(double));
+            if(locVelocity.abs() != 0.0)
+            {
+                Phase(i,j,k,{n}) = locVelocity;
+            }
+        }
     }
     STORAGE_LOOP_END
 